@@ -0,0 +1,83 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Benchmark.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the micro-benchmarks of the signal processing and
+  *          linear algebra kernels for the host build ('make bench').
+  ******************************************************************************
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include <benchmarks/kernels.hpp>
+
+namespace benchmarks{
+
+    /** @brief  Sink of the results, the compiler can't remove the measured kernels */
+    volatile float s_sink;
+
+   /**
+    * @brief Measurement of the host, it prints the mean execution time of one sample measured by the steady clock.
+    */
+    struct CHostMeasure
+    {
+        /** @brief  Number of the measured samples of each kernel */
+        static const uint32_t s_samples = 1000000;
+
+        /** \brief  Measure the kernel.
+         *
+         *  @param f_name          name of the kernel
+         *  @param f_kernel        kernel, it's applied with the input sample and it returns the output sample
+         */
+        template <class F>
+        void operator()(const char* f_name, F f_kernel)
+        {
+            const float* l_input = input();
+            float l_acc = 0;
+            for (uint32_t i = 0; i < s_samples / 10; ++i)                  // Warm up the caches and the branch predictors
+            {
+                l_acc += f_kernel(l_input[i & (s_inputSize - 1)]);
+            }
+            std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < s_samples; ++i)
+            {
+                l_acc += f_kernel(l_input[i & (s_inputSize - 1)]);
+            }
+            std::chrono::steady_clock::time_point l_stop = std::chrono::steady_clock::now();
+            s_sink = l_acc;
+            double l_ns = std::chrono::duration<double, std::nano>(l_stop - l_start).count() / s_samples;
+            printf("%-40s %10.2f ns/sample\n", f_name, l_ns);
+        }
+    };
+
+}; // namespace benchmarks
+
+/**
+ * @brief Main function of the host benchmarks.
+ * 
+ * @return int 0
+ */
+int main()
+{
+    benchmarks::CHostMeasure l_measure;
+    benchmarks::measureAll(l_measure);
+    return 0;
+}
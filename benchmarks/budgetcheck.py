@@ -0,0 +1,69 @@
+"""Check of the cycle budgets on the board ('make budget PORT=<port>').
+
+The benchmark firmware ('make APP=benchmark') prints the table of the kernels after the reset, the kernels above their
+budget (benchmarks/budgets.hpp) are marked and counted in the last line ('@BNCH:done;<exceeded>;;'). The script resets
+the board by the break of the serial port, it prints the table and it exits with error, when a budget was exceeded or
+the table wasn't received. The full control tick is checked on the application firmware by the '--app' option: the
+control loop counts the ticks above its deadline and the skipped periods ('SHED' key), both of them have to be zero
+after the given run time.
+
+Usage: python budgetcheck.py <port> [--baud 256000] [--timeout 30] [--app SECONDS]
+"""
+import argparse
+import sys
+import time
+
+import serial
+
+
+def checkKernels(f_port, f_timeout):
+    f_port.send_break(0.1)
+    l_end = time.time() + f_timeout
+    while time.time() < l_end:
+        l_line = f_port.readline().decode('ascii', 'replace').rstrip()
+        if not l_line:
+            continue
+        print(l_line)
+        if l_line.startswith('@BNCH:done;'):
+            l_exceeded = int(l_line[len('@BNCH:done;'):].split(';')[0] or 0)
+            print('%d exceeded budget(s)' % l_exceeded)
+            return l_exceeded == 0
+    print('the table of the benchmark firmware wasn\'t received')
+    return False
+
+
+def checkControlTick(f_port, f_seconds):
+    time.sleep(f_seconds)
+    f_port.reset_input_buffer()
+    f_port.write(b'#SHED:;;\r\n')
+    l_end = time.time() + 1.0
+    while time.time() < l_end:
+        l_line = f_port.readline().decode('ascii', 'replace').strip()
+        if l_line.startswith('@SHED:') and l_line.count(';') >= 5:
+            l_fields = [int(v) for v in l_line[len('@SHED:'):].split(';') if v]
+            l_misses, l_overruns = l_fields[2], l_fields[3]
+            print('control tick: %d missed deadlines, %d skipped periods, %d disabled stages' % (l_misses, l_overruns, l_fields[1]))
+            return l_misses == 0 and l_overruns == 0
+    print('no response for the SHED key')
+    return False
+
+
+def main():
+    l_parser = argparse.ArgumentParser(description='Cycle budget check')
+    l_parser.add_argument('port')
+    l_parser.add_argument('--baud', type=int, default=256000)
+    l_parser.add_argument('--timeout', type=float, default=30.0)
+    l_parser.add_argument('--app', type=float, metavar='SECONDS', help='check the deadline of the control tick on the application firmware')
+    l_args = l_parser.parse_args()
+    with serial.Serial(l_args.port, l_args.baud, timeout=0.5) as l_port:
+        l_port.reset_input_buffer()
+        if l_args.app is not None:
+            l_passed = checkControlTick(l_port, l_args.app)
+        else:
+            l_passed = checkKernels(l_port, l_args.timeout)
+    print('PASSED' if l_passed else 'FAILED')
+    sys.exit(0 if l_passed else 1)
+
+
+if __name__ == '__main__':
+    main()
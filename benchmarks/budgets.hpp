@@ -0,0 +1,78 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Budgets.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the cycle budgets of the hot kernels, they are 
+  *          checked by the benchmark firmware.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef BENCHMARK_BUDGETS_HPP
+#define BENCHMARK_BUDGETS_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+namespace benchmarks{
+
+    /** @brief  Cycle budget of a kernel */
+    struct SBudget
+    {
+        /** @brief  name of the kernel in the measurement */
+        const char* m_name;
+        /** @brief  maximum mean cycles of one call on the Cortex-M4 at 84 MHz */
+        uint32_t m_cycles;
+    };
+
+    /** @brief  Budgets of the kernels of the control tick and of the command path. The kernels of the 1 kHz loop share its 84000 cycles 
+     *  with the other stages, so a kernel above its budget is a regression, even if the loop still meets its deadline. A budget is 
+     *  changed only together with the change of the kernel, which needs it, and the reason is given in the commit. 
+     */
+    const SBudget s_budgets[] = {
+        {"CIIRFilter<2,3>",                      120},
+        {"CBiquadBank<6,1>",                     400},
+        {"CPidController<float>",                200},
+        {"CGainScheduledPidController<2>",       400},
+        {"CConverterSpline<2,1>",                200},
+        {"CConverterLookupTable<37>",            120},
+        {"control step (.ramfunc)",              100},
+        {"control tick kernels",                 600},
+        {"COBS frame decode and dispatch",      2500}
+    };
+
+    /** \brief  Budget of a kernel
+     *
+     *  @param f_name          name of the kernel
+     *  \return               maximum mean cycles, zero when the kernel hasn't a budget
+     */
+    inline uint32_t budget(const char* f_name)
+    {
+        for (const SBudget& l_budget : s_budgets)
+        {
+            if (0 == strcmp(l_budget.m_name, f_name))
+            {
+                return l_budget.m_cycles;
+            }
+        }
+        return 0;
+    }
+
+}; // namespace benchmarks
+
+#endif // BENCHMARK_BUDGETS_HPP
@@ -0,0 +1,40 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    mbed.h
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the minimal replacement of the mbed header for 
+  *          the host build of the platform independent modules.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef HOST_MBED_H
+#define HOST_MBED_H
+
+#include <cstdio>
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+
+/** @brief  The host build has single context, the critical sections are empty */
+inline void core_util_critical_section_enter() {}
+inline void core_util_critical_section_exit() {}
+/** @brief  Memory barrier of the double buffered values, it keeps only the order of the compiler */
+inline void __DMB() { __asm__ __volatile__("" ::: "memory"); }
+
+#endif // HOST_MBED_H
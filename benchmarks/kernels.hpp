@@ -0,0 +1,223 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Kernels.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the list of the measured kernels, it's common 
+  *          for the host benchmarks and for the benchmark firmware.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef BENCHMARK_KERNELS_HPP
+#define BENCHMARK_KERNELS_HPP
+
+#include <cstdio>
+#include <stdint.h>
+
+#include <utils/linalg/linalg.h>
+#include <signal/filter/filter.hpp>
+#include <signal/filter/filterbank.hpp>
+#include <signal/filter/multirate.hpp>
+#include <signal/controllers/sisocontrollers.hpp>
+#include <signal/controllers/converters.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace benchmarks{
+
+    /** @brief  Length of the input signal, it has to be power of two */
+    const uint32_t s_inputSize = 1024;
+
+    /** \brief  Input signal of the kernels, a deterministic pseudo-random signal in [-4,4]. It's generated by the first call.
+     */
+    inline const float* input()
+    {
+        static float s_input[s_inputSize];
+        static bool s_isGenerated = false;
+        if (!s_isGenerated)
+        {
+            uint32_t l_seed = 12345;
+            for (uint32_t i = 0; i < s_inputSize; ++i)
+            {
+                l_seed = l_seed * 1664525u + 1013904223u;
+                s_input[i] = (l_seed >> 8) * (8.0f / 16777216.0f) - 4.0f;
+            }
+            s_isGenerated = true;
+        }
+        return s_input;
+    }
+
+    /** \brief  Measure the matrix kernels of the given size: product, LU and Cholesky solution of a linear system.
+     *
+     *  @param f_measure       measurement, it's applied with the name and the kernel, the kernel maps an input sample to an output sample
+     */
+    template <uint32_t N, class TMeasure>
+    void measureMatrix(TMeasure& f_measure)
+    {
+        utils::linalg::CMatrix<float,N,N> l_A;
+        utils::linalg::CMatrix<float,N,N> l_B;
+        utils::linalg::CMatrix<float,N,N> l_C;
+        utils::linalg::CColVector<float,N> l_x;
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            for (uint32_t j = 0; j < N; ++j)
+            {
+                l_A[i][j] = (i == j) ? N + 1.0f : 1.0f / (1.0f + i + j);   // Symmetric, diagonally dominant
+                l_B[i][j] = input()[i * N + j];
+            }
+        }
+        char l_name[64];
+        sprintf(l_name, "CMatrix<%lu,%lu> operator*", static_cast<unsigned long>(N), static_cast<unsigned long>(N));
+        f_measure(l_name, [&](float f_u){ l_B[0][0] = f_u; l_C = l_A * l_B; return l_C[N-1][N-1]; });
+        sprintf(l_name, "CMatrix<%lu,%lu> multiply", static_cast<unsigned long>(N), static_cast<unsigned long>(N));
+        f_measure(l_name, [&](float f_u){ l_B[0][0] = f_u; utils::linalg::multiply(l_C, l_A, l_B); return l_C[N-1][N-1]; });
+        sprintf(l_name, "CLUDecomposition<%lu> solve", static_cast<unsigned long>(N));
+        f_measure(l_name, [&](float f_u){ l_A[0][0] = N + 1.0f + f_u; l_x[0][0] = f_u; return utils::linalg::CLUDecomposition<float,N>(l_A).solve(l_x)[N-1][0]; });
+        sprintf(l_name, "CCholeskyDecomposition<%lu> solve", static_cast<unsigned long>(N));
+        f_measure(l_name, [&](float f_u){ l_A[0][0] = N + 1.0f + f_u; l_x[0][0] = f_u; return utils::linalg::CCholeskyDecomposition<float,N>(l_A).solve(l_x)[N-1][0]; });
+    }
+
+    /** \brief  Measure the filters, the controllers and the converters with the configuration of the platform.
+     *
+     *  @param f_measure       measurement, it's applied with the name and the kernel, the kernel maps an input sample to an output sample
+     */
+    template <class TMeasure>
+    void measureSignal(TMeasure& f_measure)
+    {
+        utils::linalg::CRowVector<float,2> l_A;                           // Second order Butterworth low-pass filter
+        utils::linalg::CRowVector<float,3> l_B;
+        l_A[0][0] = -1.5610f; l_A[0][1] = 0.6414f;
+        l_B[0][0] = 0.0201f;  l_B[0][1] = 0.0402f; l_B[0][2] = 0.0201f;
+        signal::filter::lti::siso::CIIRFilter<float,2,3> l_iir(l_A,l_B);
+        f_measure("CIIRFilter<2,3>", [&](float f_u){ return l_iir(f_u); });
+        utils::linalg::CMatrix<float,1,5> l_section;                      // The same low-pass filter as a biquad
+        l_section[0][0] = 0.0201f; l_section[0][1] = 0.0402f; l_section[0][2] = 0.0201f; l_section[0][3] = -1.5610f; l_section[0][4] = 0.6414f;
+        signal::filter::lti::siso::CBiquadCascadeFilter<float,1> l_biquads[6] = {l_section, l_section, l_section, l_section, l_section, l_section};
+        f_measure("CBiquadCascadeFilter<1> x6 channels", [&](float f_u){ float l_sum = 0; for (auto& l_biquad : l_biquads) { l_sum += l_biquad(f_u); } return l_sum; });
+        signal::filter::lti::mimo::CBiquadBank<float,6,1> l_biquadBank(l_section);
+        f_measure("CBiquadBank<6,1>", [&](float f_u){ auto l_y = l_biquadBank({f_u, f_u, f_u, f_u, f_u, f_u}); return l_y[0] + l_y[5]; });
+        signal::filter::lti::mimo::CFirBankQ15<6,8> l_firBank(std::array<int16_t,8>({{4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096}}));
+        f_measure("CFirBankQ15<6,8>", [&](float f_u){ int16_t l_q = static_cast<int16_t>(f_u * 4096.0f); auto l_y = l_firBank({l_q, l_q, l_q, l_q, l_q, l_q}); return static_cast<float>(l_y[0] + l_y[5]); });
+        signal::filter::lti::siso::CFirDecimator<float,16,4> l_firDecimator(std::array<float,16>({{0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f}}));
+        f_measure("CFirDecimator<16,4> per input", [&](float f_u){ float l_y = 0; l_firDecimator(f_u, l_y); return l_y; });
+        signal::filter::lti::siso::CCicDecimator<3,4> l_cicDecimator;
+        f_measure("CCicDecimator<3,4> per input", [&](float f_u){ float l_y = 0; l_cicDecimator(static_cast<int32_t>(f_u * 4096.0f), l_y); return l_y; });
+        signal::filter::nlti::siso::CMedianFilter<float,5> l_median5;
+        f_measure("CMedianFilter<5>", [&](float f_u){ return l_median5(f_u); });
+        signal::filter::nlti::siso::CMedianFilter<float,15> l_median15;
+        f_measure("CMedianFilter<15>", [&](float f_u){ return l_median15(f_u); });
+        signal::controllers::siso::CPidController<float> l_pid(0.1150f,0.81000f,0.000222f,0.04f,0.001f);
+        f_measure("CPidController<float>", [&](float f_u){ return l_pid.calculateControl(f_u); });
+        signal::controllers::siso::CPidController<double> l_pidDouble(0.1150,0.81000,0.000222,0.04,0.001);
+        f_measure("CPidController<double>", [&](float f_u){ return static_cast<float>(l_pidDouble.calculateControl(f_u)); });
+        signal::controllers::siso::CGainScheduledPidController<float,2> l_scheduled({0.0f,225.0f},{{{0.1150f,0.81000f,0.000222f,0.04f},{0.1150f,0.81000f,0.000222f,0.04f}}},0.001f);
+        f_measure("CGainScheduledPidController<2>", [&](float f_u){ l_scheduled.setSchedulingVariable(f_u * 50.0f + 200.0f); return l_scheduled.calculateControl(f_u); });
+        signal::controllers::CConverterSpline<2,1> l_spline({-0.22166f,0.22166f},{std::array<float,2>({0.1041568f,-0.0895276f}),std::array<float,2>({0.50805f,0.0f}),std::array<float,2>({0.1041568f,0.0895276f})});
+        f_measure("CConverterSpline<2,1>", [&](float f_u){ return l_spline(f_u); });
+        signal::controllers::CConverterLookupTable<37> l_table(l_spline, -18*0.22166f, 18*0.22166f);
+        f_measure("CConverterLookupTable<37>", [&](float f_u){ return l_table(f_u); });
+    }
+
+    /** @brief  State of the control step of the placement measurement */
+    struct SControlStep
+    {
+        float m_x1;         // Memory of the low-pass filter (direct form II transposed)
+        float m_x2;
+        float m_integral;   // Integral part of the PI controller
+    };
+
+    /** \brief  Control step without external calls: second order low-pass filter, PI controller and saturation. It's 
+     *  inlined into the flash and the SRAM variant, so they differ only by the place of the code.
+     *
+     *  @param f_state         state of the step
+     *  @param f_u             input sample
+     *  \return               control value
+     */
+    inline __attribute__((always_inline)) float controlStep(SControlStep& f_state, float f_u)
+    {
+        float l_y = 0.0201f * f_u + f_state.m_x1;
+        f_state.m_x1 = 0.0402f * f_u + 1.5610f * l_y + f_state.m_x2;
+        f_state.m_x2 = 0.0201f * f_u - 0.6414f * l_y;
+        f_state.m_integral += 0.00081f * l_y;
+        float l_out = 0.115f * l_y + f_state.m_integral;
+        return l_out > 1.0f ? 1.0f : (l_out < -1.0f ? -1.0f : l_out);
+    }
+
+    /** \brief  Control step executed from the flash (through the ART accelerator). */
+    inline __attribute__((noinline)) float controlStepFlash(SControlStep& f_state, float f_u)
+    {
+        return controlStep(f_state, f_u);
+    }
+
+    /** \brief  Control step executed from the SRAM, it's placed as the control tick of the platform. */
+    CONTROL_RAMFUNC inline __attribute__((noinline)) float controlStepRam(SControlStep& f_state, float f_u)
+    {
+        return controlStep(f_state, f_u);
+    }
+
+    /** \brief  Measure the same control step in the flash and in the SRAM. On the host the two variants are the same.
+     *
+     *  @param f_measure       measurement
+     */
+    template <class TMeasure>
+    void measurePlacement(TMeasure& f_measure)
+    {
+        SControlStep l_flash = {0.0f, 0.0f, 0.0f};
+        f_measure("control step (flash)", [&](float f_u){ return controlStepFlash(l_flash, f_u); });
+        SControlStep l_ram = {0.0f, 0.0f, 0.0f};
+        f_measure("control step (.ramfunc)", [&](float f_u){ return controlStepRam(l_ram, f_u); });
+    }
+
+    /** \brief  Measure the kernels of the control tick chained like in the pipeline: low-pass filter of the measured speed, PID controller 
+     *  and volt to pwm converter.
+     *
+     *  @param f_measure       measurement
+     */
+    template <class TMeasure>
+    void measureControlTick(TMeasure& f_measure)
+    {
+        utils::linalg::CRowVector<float,2> l_A;
+        utils::linalg::CRowVector<float,3> l_B;
+        l_A[0][0] = -1.5610f; l_A[0][1] = 0.6414f;
+        l_B[0][0] = 0.0201f;  l_B[0][1] = 0.0402f; l_B[0][2] = 0.0201f;
+        signal::filter::lti::siso::CIIRFilter<float,2,3> l_filter(l_A,l_B);
+        signal::controllers::siso::CPidController<float> l_pid(0.1150f,0.81000f,0.000222f,0.04f,0.001f);
+        signal::controllers::CConverterSpline<2,1> l_spline({-0.22166f,0.22166f},{std::array<float,2>({0.1041568f,-0.0895276f}),std::array<float,2>({0.50805f,0.0f}),std::array<float,2>({0.1041568f,0.0895276f})});
+        signal::controllers::CConverterLookupTable<37> l_converter(l_spline, -18*0.22166f, 18*0.22166f);
+        f_measure("control tick kernels", [&](float f_u){ return l_converter(l_pid.calculateControl(1.0f - l_filter(f_u))); });
+    }
+
+    /** \brief  Measure all kernels.
+     *
+     *  @param f_measure       measurement
+     */
+    template <class TMeasure>
+    void measureAll(TMeasure& f_measure)
+    {
+        measureSignal(f_measure);
+        measurePlacement(f_measure);
+        measureControlTick(f_measure);
+        measureMatrix<2>(f_measure);
+        measureMatrix<4>(f_measure);
+        measureMatrix<6>(f_measure);
+        measureMatrix<8>(f_measure);
+        measureMatrix<12>(f_measure);
+    }
+
+}; // namespace benchmarks
+
+#endif // BENCHMARK_KERNELS_HPP
@@ -0,0 +1,112 @@
+"""Latency and throughput benchmark of the serial link ('BNCH' key of the board).
+
+The latency mode sends echo requests with actuation stamp and reports the percentiles of the round trip and of the
+segments measured by the board: receive interrupt -> end of parsing -> dispatch -> response, dispatch -> actuation.
+The flood mode sends sequence numbered frames without response as fast as the link allows, then it reads the
+counters of the board: received and lost frames, dropped bytes and the received frame rate.
+
+Usage: python linkbench.py <port> [--baud 256000] [--count 1000] [--flood]
+"""
+import argparse
+import time
+
+import serial
+
+
+def percentiles(f_values, f_points=(50, 90, 99, 100)):
+    l_sorted = sorted(f_values)
+    if not l_sorted:
+        return {}
+    return {p: l_sorted[min(len(l_sorted) - 1, int(round(p / 100.0 * (len(l_sorted) - 1))))] for p in f_points}
+
+
+def report(f_name, f_values):
+    l_points = percentiles(f_values)
+    print('%-20s ' % f_name + '  '.join('p%d=%8.1f us' % (p, v) for p, v in sorted(l_points.items())))
+
+
+def readLine(f_port, f_prefix, f_timeout=1.0):
+    l_end = time.time() + f_timeout
+    while time.time() < l_end:
+        l_line = f_port.readline().decode('ascii', 'replace').strip()
+        if l_line.startswith(f_prefix):
+            return l_line[len(f_prefix):].split('|')[0]
+    return None
+
+
+def latency(f_port, f_count):
+    l_rtt, l_parse, l_dispatch, l_response, l_actuation = [], [], [], [], []
+    for l_seq in range(f_count):
+        l_sent = time.perf_counter()
+        f_port.write(('#BNCH:2;%d;;\r\n' % l_seq).encode('ascii'))
+        l_echo = readLine(f_port, '@BNCH:ack;;')
+        l_received = time.perf_counter()
+        l_act = readLine(f_port, '@BNCH:act;')
+        if l_echo is None:
+            continue
+        l_fields = [int(v) for v in l_echo.split(';') if v]
+        if len(l_fields) < 5 or l_fields[0] != l_seq:
+            continue
+        l_rx, l_parsed, l_dispatched, l_responded = l_fields[1:5]
+        l_rtt.append((l_received - l_sent) * 1e6)
+        l_parse.append((l_parsed - l_rx) & 0xFFFFFFFF)
+        l_dispatch.append((l_dispatched - l_parsed) & 0xFFFFFFFF)
+        l_response.append((l_responded - l_dispatched) & 0xFFFFFFFF)
+        if l_act is not None:
+            l_actFields = [int(v) for v in l_act.rstrip(';').split(';')]
+            if l_actFields[0] == l_seq:
+                l_actuation.append((l_actFields[1] - l_dispatched) & 0xFFFFFFFF)
+    print('%d of %d echoes' % (len(l_rtt), f_count))
+    report('round trip (host)', l_rtt)
+    report('rx -> parsed', l_parse)
+    report('parsed -> dispatch', l_dispatch)
+    report('dispatch -> response', l_response)
+    report('dispatch -> actuation', l_actuation)
+
+
+def flood(f_port, f_count):
+    f_port.write(b'#BNCH:4;;\r\n')
+    readLine(f_port, '@BNCH:')
+    l_start = time.perf_counter()
+    for l_seq in range(f_count):
+        f_port.write(('#BNCH:3;%d;;\r\n' % l_seq).encode('ascii'))
+    f_port.flush()
+    l_elapsed = time.perf_counter() - l_start
+    time.sleep(0.2)
+    f_port.reset_input_buffer()
+    f_port.write(b'#BNCH:0;;\r\n')
+    l_stats = readLine(f_port, '@BNCH:')
+    print('sent %d frames in %.3f s (%.1f frames/s)' % (f_count, l_elapsed, f_count / l_elapsed))
+    if l_stats is None:
+        print('no statistics')
+        return
+    l_names = ['frames', 'invalid', 'rx dropped bytes', 'parse dropped bytes', 'flood frames', 'lost', 'board frames/s']
+    for l_name, l_value in zip(l_names, l_stats.rstrip(';').split(';')):
+        print('%-20s %s' % (l_name, l_value))
+    f_port.write(b'#BNCH:5;;\r\n')
+    l_errors = readLine(f_port, '@BNCH:')
+    if l_errors is None:
+        return
+    l_names = ['rx high-water', 'parse high-water', 'uart overruns', 'framing errors', 'noise errors', 'buffer overflows',
+               'overflow lost bytes', 'throttlings', 'flow control', 'superseded frames', 'emergency stops']
+    for l_name, l_value in zip(l_names, l_errors.rstrip(';').split(';')):
+        print('%-20s %s' % (l_name, l_value))
+
+
+def main():
+    l_parser = argparse.ArgumentParser(description='Serial link benchmark')
+    l_parser.add_argument('port')
+    l_parser.add_argument('--baud', type=int, default=256000)
+    l_parser.add_argument('--count', type=int, default=1000)
+    l_parser.add_argument('--flood', action='store_true')
+    l_args = l_parser.parse_args()
+    with serial.Serial(l_args.port, l_args.baud, timeout=0.5) as l_port:
+        l_port.reset_input_buffer()
+        if l_args.flood:
+            flood(l_port, l_args.count)
+        else:
+            latency(l_port, l_args.count)
+
+
+if __name__ == '__main__':
+    main()
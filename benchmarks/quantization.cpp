@@ -0,0 +1,593 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Quantization.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the analysis of the coefficient quantization of
+  *          the second order stages for the host build ('make quant').
+  ******************************************************************************
+ */
+
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include <utils/fixedpoint/fixedpoint.hpp>
+#include <utils/config/vehicleprofile.hpp>
+#include <signal/systemmodels/systemmodels.hpp>
+#include <signal/systemmodels/discretization.hpp>
+#include <signal/controllers/sisocontrollers.hpp>
+
+namespace benchmarks{
+
+    /** @brief  Number of the coefficients of a stage, the stages are second order like the filters and the pid of the platform */
+    const uint32_t s_coefficients = 3;
+    /** @brief  Length of the test signal */
+    const uint32_t s_testLength = 20000;
+    /** @brief  Length of the zero input after the test signal, the output of its last part is checked for limit cycles */
+    const uint32_t s_zeroLength = 8192;
+    /** @brief  Length of the checked last part of the zero input */
+    const uint32_t s_cycleWindow = 1024;
+    /** @brief  Length of the impulse response of the noise gain and of the peak gain */
+    const uint32_t s_impulseLength = 1 << 16;
+    /** @brief  Distance from the unit circle, within it a pole is an integrator */
+    const double s_unitTolerance = 1e-9;
+
+   /**
+    * @brief Second order stage z-domain coefficients, the coefficient of z^-k is at the index k, the first denominator
+    * coefficient is one.
+    */
+    struct SQuantStage
+    {
+        /** @brief Name of the stage */
+        char m_name[96];
+        /** @brief Coefficients of the numerator */
+        double m_num[s_coefficients];
+        /** @brief Coefficients of the denominator */
+        double m_den[s_coefficients];
+    };
+
+   /**
+    * @brief Acceptance limits of a format, the limit cycles and the dead band are compared to the peak of the output by the same ratio.
+    */
+    struct SQuantLimits
+    {
+        /** @brief Minimum ratio of the output and of its deviation from the double reference in dB */
+        double m_minSnr;
+    };
+
+   /**
+    * @brief Result of a format on a stage.
+    */
+    struct SQuantResult
+    {
+        /** @brief A coefficient is saturated */
+        bool m_overflow;
+        /** @brief Largest radius of the quantized poles */
+        double m_radius;
+        /** @brief Largest distance of a quantized pole from the original pole */
+        double m_poleShift;
+        /** @brief The pole on the unit circle (integrator) remains exactly one */
+        bool m_exactIntegrator;
+        /** @brief Relative error of the static gain, of the integral gain (sum of the numerator) for an integrator */
+        double m_gainError;
+        /** @brief Sum of the squared impulse response of the quantized denominator, the rounding noise to the output */
+        double m_noiseGain;
+        /** @brief Amplitude of the output oscillation with zero input in LSB, the change per sample for an integrator */
+        double m_cycle;
+        /** @brief Constant deviation of the held output (integrator) with zero input in LSB */
+        double m_hold;
+        /** @brief Ratio of the output and of its deviation from the double reference in dB */
+        double m_snr;
+        /** @brief The format satisfies the limits */
+        bool m_pass;
+    };
+
+   /**
+    * @brief Properties of the signal type of the formats.
+    *
+    * @tparam T    type of the signal and of the memory
+    */
+    template <class T>
+    struct SFormatTraits
+    {
+        /** @brief Value of the least significant bit, the ulp of one half for float */
+        static double lsb() { return std::ldexp(1.0, -std::numeric_limits<T>::digits); }
+    };
+
+   /**
+    * @brief Properties of the fixed-point signal types.
+    */
+    template <class TBase, class TWide, uint8_t NFrac>
+    struct SFormatTraits<utils::fixedpoint::CFixedPoint<TBase,TWide,NFrac>>
+    {
+        /** @brief Value of the least significant bit */
+        static double lsb() { return std::ldexp(1.0, -NFrac); }
+    };
+
+    /** \brief  Poles of the second order denominator, the missing poles of a lower order stage are zero.
+     *
+     *  @param f_den           coefficients of the denominator, the first one is one
+     *  @param f_poles         roots of z^2 + a1*z + a2
+     */
+    inline void poles(const double (&f_den)[s_coefficients], std::complex<double> (&f_poles)[2])
+    {
+        std::complex<double> l_root = std::sqrt(std::complex<double>(f_den[1] * f_den[1] - 4.0 * f_den[2], 0.0));
+        f_poles[0] = 0.5 * (-f_den[1] + l_root);
+        f_poles[1] = 0.5 * (-f_den[1] - l_root);
+    }
+
+    /** \brief  Largest radius of the poles */
+    inline double radius(const std::complex<double> (&f_poles)[2])
+    {
+        return std::max(std::abs(f_poles[0]), std::abs(f_poles[1]));
+    }
+
+    /** \brief  Largest distance of the quantized poles from the original poles, the closer pairing is applied.
+     *
+     *  @param f_orig          original poles
+     *  @param f_quant         quantized poles
+     */
+    inline double poleShift(const std::complex<double> (&f_orig)[2], const std::complex<double> (&f_quant)[2])
+    {
+        double l_direct = std::max(std::abs(f_orig[0] - f_quant[0]), std::abs(f_orig[1] - f_quant[1]));
+        double l_crossed = std::max(std::abs(f_orig[0] - f_quant[1]), std::abs(f_orig[1] - f_quant[0]));
+        return std::min(l_direct, l_crossed);
+    }
+
+    /** \brief  Sum of the squared and of the absolute impulse response of the stage, they are infinite for a pole on the unit circle.
+     *
+     *  @param f_num           coefficients of the numerator, {1,0,0} gives the response of the denominator only
+     *  @param f_den           coefficients of the denominator
+     *  @param f_l2            sum of the squared response, the gain of a white noise
+     *  @param f_l1            sum of the absolute response, the peak gain of a bounded input
+     */
+    inline void impulseGains(const double (&f_num)[s_coefficients], const double (&f_den)[s_coefficients], double& f_l2, double& f_l1)
+    {
+        std::complex<double> l_poles[2];
+        poles(f_den, l_poles);
+        if (radius(l_poles) > 1.0 - s_unitTolerance)
+        {
+            f_l2 = f_l1 = std::numeric_limits<double>::infinity();
+            return;
+        }
+        double l_y[2] = {0.0, 0.0};
+        f_l2 = f_l1 = 0.0;
+        for (uint32_t n = 0; n < s_impulseLength; ++n)
+        {
+            double l_out = (n < s_coefficients) ? f_num[n] : 0.0;
+            l_out -= f_den[1] * l_y[0] + f_den[2] * l_y[1];
+            l_y[1] = l_y[0];
+            l_y[0] = l_out;
+            f_l2 += l_out * l_out;
+            f_l1 += std::fabs(l_out);
+        }
+    }
+
+    /** \brief  Test signal: steps of the half range, a slow sine and uniform noise, it's zero mean, so an integrator returns.
+     *
+     *  @param f_signal        samples of the signal in [-1,1]
+     */
+    inline void testSignal(double (&f_signal)[s_testLength])
+    {
+        uint32_t l_seed = 12345U;
+        for (uint32_t n = 0; n < s_testLength; ++n)
+        {
+            l_seed = l_seed * 1664525U + 1013904223U;
+            double l_noise = (static_cast<double>(l_seed >> 8) / 8388608.0 - 1.0);
+            double l_step = ((n / 2500) % 2 == 0) ? 0.5 : -0.5;
+            f_signal[n] = 0.6 * l_step + 0.3 * std::sin(2.0 * M_PI * n / 1777.0) + 0.1 * l_noise;
+        }
+    }
+
+   /**
+    * @brief Analysis of the stages by the same transfer function template as on the board, the double instantiation is the
+    * reference of the float and of the fixed-point instantiations with 64-bit sum.
+    */
+    class CQuantAnalysis
+    {
+    public:
+        /** \brief  Constructor, the input is scaled for each stage, so the peak of the reference output is the half of the range.
+         *
+         *  @param f_stage         stage under analysis
+         *  @param f_limits        acceptance limits
+         */
+        CQuantAnalysis(const SQuantStage& f_stage, const SQuantLimits& f_limits)
+            :m_stage(f_stage)
+            ,m_limits(f_limits)
+            ,m_scale(1.0)
+        {
+            poles(m_stage.m_den, m_poles);
+            testSignal(m_input);
+            double l_peak = std::max(1.0, reference());
+            m_scale = 0.5 / l_peak;
+            for (uint32_t n = 0; n < s_testLength; ++n)
+            {
+                m_input[n] *= m_scale;
+            }
+            reference();
+        }
+
+        /** \brief  The stage has a pole on the unit circle */
+        bool isIntegrator() const
+        {
+            return radius(m_poles) > 1.0 - s_unitTolerance;
+        }
+
+        /** \brief  Print the properties of the unquantized stage: poles, gains and limit cycle bound. */
+        void printStage() const
+        {
+            double l_l2, l_l1;
+            impulseGains(m_stage.m_num, m_stage.m_den, l_l2, l_l1);
+            printf("%s\n", m_stage.m_name);
+            printf("  num %.9g %.9g %.9g  den %.9g %.9g %.9g\n", m_stage.m_num[0], m_stage.m_num[1], m_stage.m_num[2],
+                   m_stage.m_den[0], m_stage.m_den[1], m_stage.m_den[2]);
+            printf("  poles %.9g%+.9gi %.9g%+.9gi  radius %.9g\n", m_poles[0].real(), m_poles[0].imag(), m_poles[1].real(),
+                   m_poles[1].imag(), radius(m_poles));
+            if (std::isinf(l_l1))
+            {
+                printf("  integrator: the headroom of the memory is given by the output limit of the stage\n");
+            }
+            else
+            {
+                printf("  peak gain %.4g, %d integer bits for a full range input\n", l_l1, std::max(0, static_cast<int>(std::ceil(std::log2(l_l1)))));
+            }
+            // Bounds of the zero input limit cycles of the rounded sum: the dead band of the constant and of the alternating output 
+            // (half LSB over the denominator at z = 1 and z = -1), and Jackson's bound of the oscillation by the last coefficient
+            double l_dc = std::fabs(m_stage.m_den[0] + m_stage.m_den[1] + m_stage.m_den[2]);
+            double l_nyquist = std::fabs(m_stage.m_den[0] - m_stage.m_den[1] + m_stage.m_den[2]);
+            double l_feedback = std::fabs(m_stage.m_den[2]);
+            if (!std::isinf(l_l1))
+            {
+                printf("  limit cycle bound %.2f LSB (dead band %.2f, alternating %.2f, oscillation %.2f)\n",
+                       std::max(0.5 / l_dc, std::max(0.5 / l_nyquist, 0.5 / (1.0 - l_feedback))), 0.5 / l_dc, 0.5 / l_nyquist,
+                       0.5 / (1.0 - l_feedback));
+            }
+            else
+            {
+                printf("  the integrator is kept by the pinned rounding of the denominator (+pin): a1 = -(1 + a2)\n");
+            }
+            printf("  input scale %.4g (the peak of the test output is the half range)\n", m_scale);
+            printf("  %-22s %3s %12s %11s %10s %12s %8s %8s %8s %s\n", "format", "ovf", "radius", "pole shift", "gain err", "noise gain",
+                   "cycle", "hold", "snr dB", "result");
+        }
+
+        /** \brief  Analyse a format, the coefficients are quantized by the conversion of the coefficient type. The cycle and the hold
+         *  are the amplitude and the mean of the output after the zero input relative to the reference in LSB of the memory, the 
+         *  cycle of an integrator is the largest change per sample (ramp).
+         *
+         *  @tparam T              type of the signal and of the memory
+         *  @tparam TCoef          type of the coefficients
+         *  @tparam TAcc           type of the sum of the products
+         *  @param f_name          name of the format
+         *  @param f_pin           the middle denominator coefficient is derived from the quantized others, so the sum of the
+         *                         denominator remains zero and the integrator pole stays at one
+         *  @return                result of the format
+         */
+        template <class T, class TCoef, class TAcc>
+        SQuantResult analyse(const char* f_name, bool f_pin = false) const
+        {
+            SQuantResult l_result;
+            typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,3,3,TCoef,TAcc>::CNumType l_num;
+            typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,3,3,TCoef,TAcc>::CDenType l_den;
+            double l_numQ[s_coefficients], l_denQ[s_coefficients];
+            l_result.m_overflow = false;
+            for (uint32_t i = 0; i < s_coefficients; ++i)
+            {
+                l_num[i][0] = TCoef(m_stage.m_num[i]);
+                l_den[i][0] = TCoef(m_stage.m_den[i]);
+                l_numQ[i] = static_cast<double>(l_num[i][0]);
+                l_denQ[i] = static_cast<double>(l_den[i][0]);
+                // A saturated coefficient is farther than a half LSB from the value
+                double l_lsb = SFormatTraits<TCoef>::lsb();
+                l_result.m_overflow |= std::fabs(l_numQ[i] - m_stage.m_num[i]) > l_lsb || std::fabs(l_denQ[i] - m_stage.m_den[i]) > l_lsb;
+            }
+            if (f_pin)
+            {
+                l_den[1][0] = TCoef(-(l_denQ[0] + l_denQ[2]));
+                l_denQ[1] = static_cast<double>(l_den[1][0]);
+            }
+            std::complex<double> l_poles[2];
+            poles(l_denQ, l_poles);
+            l_result.m_radius = radius(l_poles);
+            l_result.m_poleShift = poleShift(m_poles, l_poles);
+            // The integrator pole is kept, when the sum of the quantized denominator is exactly zero
+            l_result.m_exactIntegrator = (0.0 == l_denQ[0] + l_denQ[1] + l_denQ[2]);
+            bool l_integrator = isIntegrator();
+            double l_gain = m_stage.m_num[0] + m_stage.m_num[1] + m_stage.m_num[2];
+            double l_gainQ = l_numQ[0] + l_numQ[1] + l_numQ[2];
+            if (!l_integrator)
+            {
+                l_gain /= m_stage.m_den[0] + m_stage.m_den[1] + m_stage.m_den[2];
+                l_gainQ /= l_denQ[0] + l_denQ[1] + l_denQ[2];
+            }
+            l_result.m_gainError = (0.0 != l_gain) ? std::fabs(l_gainQ / l_gain - 1.0) : std::fabs(l_gainQ);
+            double l_unit[s_coefficients] = {1.0, 0.0, 0.0};
+            double l_l1;
+            impulseGains(l_unit, l_denQ, l_result.m_noiseGain, l_l1);
+
+            signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,3,3,TCoef,TAcc> l_stage(l_num, l_den);
+            double l_lsb = SFormatTraits<T>::lsb();
+            double l_errorSum = 0.0, l_outputSum = 0.0;
+            for (uint32_t n = 0; n < s_testLength; ++n)
+            {
+                double l_error = static_cast<double>(l_stage(T(m_input[n]))) - m_output[n];
+                l_errorSum += l_error * l_error;
+                l_outputSum += m_output[n] * m_output[n];
+            }
+            l_result.m_snr = (l_errorSum > 0.0) ? 10.0 * std::log10(l_outputSum / l_errorSum) : std::numeric_limits<double>::infinity();
+            double l_min = std::numeric_limits<double>::max(), l_max = -l_min;
+            double l_ramp = 0.0, l_previous = 0.0;
+            for (uint32_t n = 0; n < s_zeroLength; ++n)
+            {
+                double l_value = static_cast<double>(l_stage(T(0.0))) - m_hold;
+                if (n >= s_zeroLength - s_cycleWindow)
+                {
+                    l_min = std::min(l_min, l_value);
+                    l_max = std::max(l_max, l_value);
+                    l_ramp = std::max(l_ramp, std::fabs(l_value - l_previous));
+                }
+                l_previous = l_value;
+            }
+            // The dead band of the other pole can keep a constant difference on the integrator, so its output ramps
+            l_result.m_cycle = l_integrator ? l_ramp / l_lsb : 0.5 * (l_max - l_min) / l_lsb;
+            l_result.m_hold = 0.5 * (l_max + l_min) / l_lsb;
+
+            // The limit cycle, the dead band and the ramp in the length of the test are relative to the peak of the output, the half range
+            double l_cycle = l_integrator ? l_result.m_cycle * s_testLength : l_result.m_cycle;
+            double l_cycleRatio = l_lsb * std::max(l_cycle, std::fabs(l_result.m_hold)) / 0.5;
+            bool l_stable = l_integrator ? (l_result.m_exactIntegrator && l_result.m_radius < 1.0 + s_unitTolerance) : (l_result.m_radius < 1.0);
+            l_result.m_pass = !l_result.m_overflow && l_stable && l_result.m_snr >= m_limits.m_minSnr
+                              && l_cycleRatio <= std::pow(10.0, -m_limits.m_minSnr / 20.0);
+            const char* l_verdict = l_result.m_pass ? "ok" : "fail";
+            l_verdict = l_stable ? l_verdict : (l_integrator ? "integrator lost" : "unstable");
+            printf("  %-22s %3s %12.9f %11.3e %10.3e %12.5g %8.2f %8.2f %8.1f %s\n", f_name, l_result.m_overflow ? "yes" : "no", 
+                   l_result.m_radius, l_result.m_poleShift, l_result.m_gainError, l_result.m_noiseGain, l_result.m_cycle, l_result.m_hold, 
+                   l_result.m_snr, l_verdict);
+            return l_result;
+        }
+
+    private:
+        /** \brief  Reference output of the double instantiation, the held value after the zero input is stored.
+         *
+         *  @return                peak of the absolute output
+         */
+        double reference()
+        {
+            typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<double,3,3>::CNumType l_num;
+            typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<double,3,3>::CDenType l_den;
+            for (uint32_t i = 0; i < s_coefficients; ++i)
+            {
+                l_num[i][0] = m_stage.m_num[i];
+                l_den[i][0] = m_stage.m_den[i];
+            }
+            signal::systemmodels::lti::siso::CDiscreteTransferFunction<double,3,3> l_stage(l_num, l_den);
+            double l_peak = 0.0;
+            for (uint32_t n = 0; n < s_testLength; ++n)
+            {
+                m_output[n] = l_stage(m_input[n]);
+                l_peak = std::max(l_peak, std::fabs(m_output[n]));
+            }
+            for (uint32_t n = 0; n < s_zeroLength; ++n)
+            {
+                m_hold = l_stage(0.0);
+            }
+            return l_peak;
+        }
+
+        /** @brief  Stage under analysis */
+        const SQuantStage& m_stage;
+        /** @brief  Acceptance limits */
+        const SQuantLimits& m_limits;
+        /** @brief  Poles of the unquantized stage */
+        std::complex<double> m_poles[2];
+        /** @brief  Scale of the test signal */
+        double m_scale;
+        /** @brief  Scaled test signal */
+        double m_input[s_testLength];
+        /** @brief  Reference output */
+        double m_output[s_testLength];
+        /** @brief  Held reference output after the zero input, zero without integrator */
+        double m_hold;
+    };
+
+    /** @brief  Q1.14 coefficients, the range is [-2,2) */
+    using CQ1_14 = utils::fixedpoint::CFixedPoint<int16_t,int32_t,14>;
+    /** @brief  Q2.13 coefficients, the range is [-4,4) */
+    using CQ2_13 = utils::fixedpoint::CFixedPoint<int16_t,int32_t,13>;
+    /** @brief  Q4.11 coefficients, the range is [-16,16) */
+    using CQ4_11 = utils::fixedpoint::CFixedPoint<int16_t,int32_t,11>;
+    /** @brief  Q1.30 coefficients, the range is [-2,2) */
+    using CQ1_30 = utils::fixedpoint::CFixedPoint<int32_t,int64_t,30>;
+    /** @brief  Q2.29 coefficients, the range is [-4,4) */
+    using CQ2_29 = utils::fixedpoint::CFixedPoint<int32_t,int64_t,29>;
+    /** @brief  Q4.27 coefficients, the range is [-16,16) */
+    using CQ4_27 = utils::fixedpoint::CFixedPoint<int32_t,int64_t,27>;
+
+    /** @brief  Names of the fixed-point formats from the cheapest one, memory x coefficients */
+    const char* const s_formatNames[6] = {"Q15 x Q1.14", "Q15 x Q2.13", "Q15 x Q4.11", "Q31 x Q1.30", "Q31 x Q2.29", "Q31 x Q4.27"};
+
+    /** \brief  Analyse a fixed-point format with 64-bit sum, when the rounding of the coefficients moves the integrator pole of the 
+     *  stage from one, the format is analysed also with the pinned rounding.
+     *
+     *  @tparam T              type of the signal and of the memory
+     *  @tparam TCoef          type of the coefficients
+     *  @param f_analysis      analysis of the stage
+     *  @param f_name          name of the format
+     *  @param f_pinned        the pinned rounding is analysed
+     *  @return                true, when the format satisfies the limits
+     */
+    template <class T, class TCoef>
+    bool analyseFormat(const CQuantAnalysis& f_analysis, const char* f_name, bool& f_pinned)
+    {
+        SQuantResult l_result = f_analysis.analyse<T,TCoef,int64_t>(f_name);
+        f_pinned = f_analysis.isIntegrator() && !l_result.m_exactIntegrator;
+        if (f_pinned)
+        {
+            char l_name[32];
+            snprintf(l_name, sizeof(l_name), "%s +pin", f_name);
+            l_result = f_analysis.analyse<T,TCoef,int64_t>(l_name, true);
+        }
+        return l_result.m_pass;
+    }
+
+    /** \brief  Analyse a stage in the formats from the cheapest one and print the recommended format, it's the first one, which
+     *  satisfies the limits. The float instantiation isn't recommended, it's the current type of the platform.      *
+     *  @param f_stage         stage under analysis
+     *  @param f_limits        acceptance limits
+     *  @return                true, when a fixed-point format satisfies the limits
+     */
+    inline bool analyseStage(const SQuantStage& f_stage, const SQuantLimits& f_limits)
+    {
+        using utils::fixedpoint::CQ15;
+        using utils::fixedpoint::CQ31;
+        CQuantAnalysis* l_analysis = new CQuantAnalysis(f_stage, f_limits);
+        l_analysis->printStage();
+        bool l_pass[6], l_pinned[6];
+        l_pass[0] = analyseFormat<CQ15,CQ1_14>(*l_analysis, s_formatNames[0], l_pinned[0]);
+        l_pass[1] = analyseFormat<CQ15,CQ2_13>(*l_analysis, s_formatNames[1], l_pinned[1]);
+        l_pass[2] = analyseFormat<CQ15,CQ4_11>(*l_analysis, s_formatNames[2], l_pinned[2]);
+        l_pass[3] = analyseFormat<CQ31,CQ1_30>(*l_analysis, s_formatNames[3], l_pinned[3]);
+        l_pass[4] = analyseFormat<CQ31,CQ2_29>(*l_analysis, s_formatNames[4], l_pinned[4]);
+        l_pass[5] = analyseFormat<CQ31,CQ4_27>(*l_analysis, s_formatNames[5], l_pinned[5]);
+        l_analysis->analyse<float,float,float>("float");
+        delete l_analysis;
+        for (uint32_t i = 0; i < 6; ++i)
+        {
+            if (l_pass[i])
+            {
+                printf("  recommended: %s%s (memory x coefficients, 64-bit sum)\n\n", s_formatNames[i], l_pinned[i] ? " +pin" : "");
+                return true;
+            }
+        }
+        printf("  recommended: float, no fixed-point format satisfies the limits\n\n");
+        return false;
+    }
+
+    /** \brief  Normalize the stage, so the first denominator coefficient is one, like in the transfer function.
+     *
+     *  @param f_stage         stage
+     *  @return                false, when the first denominator coefficient is zero
+     */
+    inline bool normalize(SQuantStage& f_stage)
+    {
+        double l_den = f_stage.m_den[0];
+        if (0.0 == l_den) return false;
+        for (uint32_t i = 0; i < s_coefficients; ++i)
+        {
+            f_stage.m_num[i] /= l_den;
+            f_stage.m_den[i] /= l_den;
+        }
+        return true;
+    }
+
+    /** \brief  Stage of the pid controller, it's discretized like the CPidController.
+     *
+     *  @param f_stage         created stage
+     *  @param f_gains         kp, ki, kd and tf
+     *  @param f_dt            period of the controller in second
+     */
+    inline void pidStage(SQuantStage& f_stage, const double (&f_gains)[4], double f_dt)
+    {
+        signal::systemmodels::lti::SDiscreteCoefficients<3> l_discrete = signal::systemmodels::lti::discretize(
+            signal::controllers::siso::CPidController<double>::continuousModel(f_gains[0], f_gains[1], f_gains[2], f_gains[3]),
+            f_dt, signal::systemmodels::lti::FORWARD_EULER);
+        snprintf(f_stage.m_name, sizeof(f_stage.m_name), "pid %g,%g,%g,%g at %g s", f_gains[0], f_gains[1], f_gains[2], f_gains[3], f_dt);
+        for (uint32_t i = 0; i < s_coefficients; ++i)
+        {
+            f_stage.m_num[i] = l_discrete.m_num[i];
+            f_stage.m_den[i] = l_discrete.m_den[i];
+        }
+    }
+
+}; // namespace benchmarks
+
+/**
+ * @brief Main function of the analysis. Usage: quantization [-s snr] [-T period] [-p kp,ki,kd,tf] [-t b0,b1,b2 a0,a1,a2]
+ * Without stage the stages of the platform are analysed: the second order Butterworth low-pass of the speed (CIIRFilter<2,3>) and
+ * the speed pid with the tuned gains of the main at the control period of the vehicle profile. '-p' adds a pid stage at the period
+ * of '-T', '-t' adds a transfer function by its z^-1 coefficients. The limit is the minimum ratio of the output and of its error
+ * in dB (60), the limit cycles and the dead band are compared to the peak of the output by the same ratio.
+ *
+ * @return int 0, 1 when a stage has no fixed-point format or the arguments are invalid
+ */
+int main(int argc, char** argv)
+{
+    benchmarks::SQuantLimits l_limits = {60.0};
+    double l_period = utils::config::s_vehicle.m_controlPeriod;
+    benchmarks::SQuantStage l_stages[8];
+    uint32_t l_stageCount = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "-s") && i + 1 < argc)
+        {
+            l_limits.m_minSnr = strtod(argv[++i], NULL);
+        }
+        else if (0 == strcmp(argv[i], "-T") && i + 1 < argc)
+        {
+            l_period = strtod(argv[++i], NULL);
+        }
+        else if (0 == strcmp(argv[i], "-p") && i + 1 < argc && l_stageCount < 8)
+        {
+            double l_gains[4];
+            if (4 != sscanf(argv[++i], "%lf,%lf,%lf,%lf", &l_gains[0], &l_gains[1], &l_gains[2], &l_gains[3]))
+            {
+                fprintf(stderr, "-p: four gains are expected\n");
+                return 1;
+            }
+            benchmarks::pidStage(l_stages[l_stageCount++], l_gains, l_period);
+        }
+        else if (0 == strcmp(argv[i], "-t") && i + 2 < argc && l_stageCount < 8)
+        {
+            benchmarks::SQuantStage& l_stage = l_stages[l_stageCount];
+            memset(&l_stage, 0, sizeof(l_stage));
+            snprintf(l_stage.m_name, sizeof(l_stage.m_name), "tf %s / %s", argv[i + 1], argv[i + 2]);
+            double* n = l_stage.m_num;
+            double* d = l_stage.m_den;
+            if (1 > sscanf(argv[++i], "%lf,%lf,%lf", &n[0], &n[1], &n[2]) || 1 > sscanf(argv[++i], "%lf,%lf,%lf", &d[0], &d[1], &d[2])
+                || !benchmarks::normalize(l_stage))
+            {
+                fprintf(stderr, "-t: numerator and denominator coefficients are expected, the first denominator coefficient isn't zero\n");
+                return 1;
+            }
+            ++l_stageCount;
+        }
+        else
+        {
+            fprintf(stderr, "%s: unknown option\n", argv[i]);
+            return 1;
+        }
+    }
+    if (0 == l_stageCount)
+    {
+        l_stages[0] = {"speed low-pass CIIRFilter<2,3>", {0.0201, 0.0402, 0.0201}, {1.0, -1.5610, 0.6414}};
+        const double l_gains[4] = {0.1150, 0.81000, 0.000222, 0.04};
+        benchmarks::pidStage(l_stages[1], l_gains, l_period);
+        l_stageCount = 2;
+    }
+    int l_result = 0;
+    for (uint32_t i = 0; i < l_stageCount; ++i)
+    {
+        l_result = benchmarks::analyseStage(l_stages[i], l_limits) ? l_result : 1;
+    }
+    return l_result;
+}
@@ -0,0 +1,319 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Replay.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the replay of the recorded logs through the filter
+  *          variants for the host build ('make replay').
+  ******************************************************************************
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include <utils/linalg/linalg.h>
+#include <signal/filter/filter.hpp>
+#include <signal/filter/kalmanfilter.hpp>
+
+namespace benchmarks{
+
+   /**
+    * @brief One recorded sample of the log, the missing columns are zero.
+    */
+    struct SReplaySample
+    {
+        /** @brief Counted impulses in the period */
+        float m_count;
+        /** @brief Recorded speed in rps */
+        float m_speed;
+        /** @brief Recorded pwm command */
+        float m_pwm;
+        /** @brief Recorded motor current in ampere */
+        float m_current;
+        /** @brief Reference speed of the comparison in rps */
+        float m_reference;
+        /** @brief The count is recorded */
+        bool m_hasCount;
+    };
+
+   /**
+    * @brief Configuration of the replay: sample period, encoder resolution, columns of the rows and output mode.
+    */
+    struct SReplayConfig
+    {
+        /** @brief Period of the samples in second */
+        float m_period;
+        /** @brief Resolution of the encoder */
+        float m_resolution;
+        /** @brief Column index of the count, speed, pwm, current and reference, -1 when it isn't recorded */
+        int m_columns[5];
+        /** @brief Print the output of the variants for each sample */
+        bool m_dump;
+    };
+
+    /** @brief  Number of the filter variants */
+    const uint32_t s_variantCount = 4;
+    /** @brief  Names of the filter variants */
+    const char* const s_variantNames[s_variantCount] = {"raw", "CIIRFilter<2,3>", "CMedianFilter<5>", "CKalmanFilter<3,2,1>"};
+
+   /**
+    * @brief Filter variants under evaluation. They are the same templates as on the board, each log is replayed by a new object,
+    * so the filters start from zero state like after the reset.
+    */
+    class CReplayVariants
+    {
+    public:
+        /** @brief Type of the Kalman filter: position, speed and acceleration disturbance, like the speed observer with the zero motor model */
+        using CKalmanFilterType = signal::filter::lti::mimo::CKalmanFilter<float,3,2,1,utils::linalg::CBandMatrix<float,3,0,1>>;
+
+        /** \brief  Constructor, the coefficients are the configuration of the platform.
+         *
+         *  @param f_config        configuration of the replay
+         */
+        CReplayVariants(const SReplayConfig& f_config)
+            :m_config(f_config)
+            ,m_iir(iirA(), iirB())
+            ,m_median()
+            ,m_kalman(kalmanModel(f_config.m_period), kalmanNoise(), CKalmanFilterType::CMeasurementCovarianceType({1.41e-4f*1.41e-4f}), kalmanNoise())
+            ,m_position(0)
+        {
+        }
+
+        /** \brief  Apply the variants on the sample.
+         *
+         *  @param f_sample        recorded sample
+         *  @param f_outputs       estimated speed of each variant in rps
+         */
+        void operator()(const SReplaySample& f_sample, float (&f_outputs)[s_variantCount])
+        {
+            // Speed of the period by the count, or the recorded speed when the count isn't recorded
+            float l_raw = f_sample.m_hasCount ? f_sample.m_count / m_config.m_resolution / m_config.m_period : f_sample.m_speed;
+            f_outputs[0] = l_raw;
+            f_outputs[1] = m_iir(l_raw);
+            f_outputs[2] = m_median(l_raw);
+
+            // The position is integrated from the speed, when the count isn't recorded; it's kept near zero like in the speed observer
+            m_position += l_raw * m_config.m_period;
+            CKalmanFilterType::CControlType l_u({f_sample.m_pwm, f_sample.m_current});
+            CKalmanFilterType::CMeasurementType l_y({m_position});
+            m_kalman(l_u, l_y);
+            CKalmanFilterType::CStateType& l_x = m_kalman.state();
+            float l_shift = std::floor(l_x[0][0] + 0.5f);
+            m_position -= l_shift;
+            l_x[0][0] -= l_shift;
+            f_outputs[3] = l_x[1][0];
+        }
+
+    private:
+        /** @brief  Feedback coefficients of the second order Butterworth low-pass filter */
+        static utils::linalg::CRowVector<float,2> iirA()
+        {
+            utils::linalg::CRowVector<float,2> l_A;
+            l_A[0][0] = -1.5610f; l_A[0][1] = 0.6414f;
+            return l_A;
+        }
+        /** @brief  Feedforward coefficients of the second order Butterworth low-pass filter */
+        static utils::linalg::CRowVector<float,3> iirB()
+        {
+            utils::linalg::CRowVector<float,3> l_B;
+            l_B[0][0] = 0.0201f; l_B[0][1] = 0.0402f; l_B[0][2] = 0.0201f;
+            return l_B;
+        }
+        /** @brief  Discrete constant acceleration model, it's the model of the speed observer with zero coefficients */
+        static CKalmanFilterType::CSystemModelType kalmanModel(float f_period)
+        {
+            CKalmanFilterType::CSystemModelType::CStateTransitionType l_A({
+                1.0f, f_period, 0.0f,
+                0.0f, 1.0f,     f_period,
+                0.0f, 0.0f,     1.0f });
+            CKalmanFilterType::CSystemModelType::CInputMatrixType l_B(CKalmanFilterType::CSystemModelType::CInputMatrixType::zeros());
+            CKalmanFilterType::CSystemModelType::CMeasurementMatrixType l_C({1.0f, 0.0f, 0.0f});
+            return CKalmanFilterType::CSystemModelType(l_A, l_B, l_C);
+        }
+        /** @brief  Process noise covariance, the noises of the speed observer in the main */
+        static CKalmanFilterType::CStateCovarianceType kalmanNoise()
+        {
+            CKalmanFilterType::CStateCovarianceType l_Q(CKalmanFilterType::CStateCovarianceType::zeros());
+            l_Q[0][0] = 1e-5f * 1e-5f;
+            l_Q[1][1] = 1e-2f * 1e-2f;
+            l_Q[2][2] = 1.0f;
+            return l_Q;
+        }
+
+        /** @brief  Configuration of the replay */
+        const SReplayConfig& m_config;
+        /** @brief  Low-pass filter */
+        signal::filter::lti::siso::CIIRFilter<float,2,3> m_iir;
+        /** @brief  Median filter */
+        signal::filter::nlti::siso::CMedianFilter<float,5> m_median;
+        /** @brief  Kalman filter */
+        CKalmanFilterType m_kalman;
+        /** @brief  Measured position relative to the position state in rotation */
+        float m_position;
+    };
+
+    /** \brief  Parse one line of the log. The '@ENPB:speed;;' messages give the speed, the other lines are rows of
+     *  numbers separated by ';', ',', space or tab, like the decoded telemetry batches.
+     *
+     *  @param f_line          line of the log
+     *  @param f_config        configuration of the replay
+     *  @param f_sample        parsed sample
+     *  @return                true, when the line contains a sample
+     */
+    inline bool parseLine(const char* f_line, const SReplayConfig& f_config, SReplaySample& f_sample)
+    {
+        memset(&f_sample, 0, sizeof(f_sample));
+        if (f_line[0] == '@')
+        {
+            if (1 != sscanf(f_line, "@ENPB:%f;;", &f_sample.m_speed)) return false;
+            f_sample.m_reference = f_sample.m_speed;
+            return true;
+        }
+        float l_values[16];
+        int l_count = 0;
+        const char* l_pos = f_line;
+        while (l_count < 16)
+        {
+            l_pos += strspn(l_pos, ";, \t");
+            char* l_end;
+            float l_value = strtof(l_pos, &l_end);
+            if (l_end == l_pos) break;
+            l_values[l_count++] = l_value;
+            l_pos = l_end;
+        }
+        float* l_fields[5] = {&f_sample.m_count, &f_sample.m_speed, &f_sample.m_pwm, &f_sample.m_current, &f_sample.m_reference};
+        bool l_valid = l_count > 0;
+        for (int i = 0; i < 5; ++i)
+        {
+            if (f_config.m_columns[i] >= l_count)
+            {
+                l_valid = false;
+            }
+            else if (f_config.m_columns[i] >= 0)
+            {
+                *l_fields[i] = l_values[f_config.m_columns[i]];
+            }
+        }
+        f_sample.m_hasCount = f_config.m_columns[0] >= 0;
+        return l_valid;
+    }
+
+    /** \brief  Replay one log through the variants and print the deviation of each variant from the reference speed.
+     *
+     *  @param f_fileName      name of the log
+     *  @param f_config        configuration of the replay
+     *  @return                number of the replayed samples, -1 when the file can't be opened
+     */
+    inline long replayFile(const char* f_fileName, const SReplayConfig& f_config)
+    {
+        FILE* l_file = fopen(f_fileName, "r");
+        if (NULL == l_file)
+        {
+            fprintf(stderr, "%s: can't open\n", f_fileName);
+            return -1;
+        }
+        CReplayVariants l_variants(f_config);
+        double l_squareSum[s_variantCount] = {0};
+        double l_maxError[s_variantCount] = {0};
+        long l_samples = 0;
+        char l_line[256];
+        SReplaySample l_sample;
+        float l_outputs[s_variantCount];
+        while (NULL != fgets(l_line, sizeof(l_line), l_file))
+        {
+            if (!parseLine(l_line, f_config, l_sample)) continue;
+            l_variants(l_sample, l_outputs);
+            if (f_config.m_dump)
+            {
+                printf("%ld;%.6g;%.6g;%.6g;%.6g;%.6g\n", l_samples, l_sample.m_reference, l_outputs[0], l_outputs[1], l_outputs[2], l_outputs[3]);
+            }
+            for (uint32_t i = 0; i < s_variantCount; ++i)
+            {
+                double l_error = std::fabs(l_outputs[i] - l_sample.m_reference);
+                l_squareSum[i] += l_error * l_error;
+                l_maxError[i] = (l_error > l_maxError[i]) ? l_error : l_maxError[i];
+            }
+            ++l_samples;
+        }
+        fclose(l_file);
+        if (!f_config.m_dump)
+        {
+            printf("%s: %ld samples\n", f_fileName, l_samples);
+            for (uint32_t i = 0; i < s_variantCount && l_samples > 0; ++i)
+            {
+                printf("  %-24s rms %10.4f rps  max %10.4f rps\n", s_variantNames[i], std::sqrt(l_squareSum[i] / l_samples), l_maxError[i]);
+            }
+        }
+        return l_samples;
+    }
+
+}; // namespace benchmarks
+
+/**
+ * @brief Main function of the replay. Usage: replay [-p period] [-r resolution] [-c count,speed,pwm,current,reference] [-d] files...
+ * The columns are zero based, -1 means the column isn't recorded. The defaults are the telemetry signals of the main (count,
+ * encoder speed, pid error, control, current, observer speed) at 1 ms with the 2048 impulses encoder, the reference is the observer speed.
+ * With '-d' the outputs of the variants are printed for each sample instead of the summary.
+ *
+ * @return int 0, 1 when a file can't be opened
+ */
+int main(int argc, char** argv)
+{
+    benchmarks::SReplayConfig l_config = {0.001f, 2048.0f, {0, 1, 3, 4, 5}, false};
+    std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+    long l_samples = 0;
+    int l_result = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "-p") && i + 1 < argc)
+        {
+            l_config.m_period = strtof(argv[++i], NULL);
+        }
+        else if (0 == strcmp(argv[i], "-r") && i + 1 < argc)
+        {
+            l_config.m_resolution = strtof(argv[++i], NULL);
+        }
+        else if (0 == strcmp(argv[i], "-c") && i + 1 < argc)
+        {
+            int* c = l_config.m_columns;
+            if (5 != sscanf(argv[++i], "%d,%d,%d,%d,%d", &c[0], &c[1], &c[2], &c[3], &c[4]))
+            {
+                fprintf(stderr, "-c: five columns are expected\n");
+                return 1;
+            }
+        }
+        else if (0 == strcmp(argv[i], "-d"))
+        {
+            l_config.m_dump = true;
+        }
+        else
+        {
+            long l_fileSamples = benchmarks::replayFile(argv[i], l_config);
+            l_result = (l_fileSamples < 0) ? 1 : l_result;
+            l_samples += (l_fileSamples > 0) ? l_fileSamples : 0;
+        }
+    }
+    double l_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - l_start).count();
+    fprintf(stderr, "%ld samples (%.1f s of log) in %.3f s, %.0fx real time\n", l_samples, l_samples * l_config.m_period, l_seconds,
+            l_seconds > 0 ? l_samples * l_config.m_period / l_seconds : 0.0);
+    return l_result;
+}
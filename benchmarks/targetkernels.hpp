@@ -0,0 +1,87 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    TargetKernels.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the kernels of the command path, they are measured 
+  *          only by the benchmark firmware, which links the serial modules.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef BENCHMARK_TARGET_KERNELS_HPP
+#define BENCHMARK_TARGET_KERNELS_HPP
+
+#include <string.h>
+
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/serial/dispatchtable.hpp>
+#include <utils/serial/protocolmessages.hpp>
+
+namespace benchmarks{
+
+    /** @brief  Receiver of the measured move commands */
+    struct SMoveSink
+    {
+        /** @brief  last received speed */
+        float m_speed;
+        /** @brief  Callback of the move command */
+        uint8_t move(const utils::serial::SMovePayload& f_payload)
+        {
+            m_speed = f_payload.m_speed;
+            return utils::serial::BIN_ACK;
+        }
+    };
+
+    /** \brief  Measure the decode of a COBS move frame and its dispatch with the steps of CSerialMonitor::dispatchCobs: unstuffing, 
+     *  length and checksum check, lookup in the binary dispatch table, range check of the payload and the callback.
+     *
+     *  @param f_measure       measurement
+     */
+    template <class TMeasure>
+    void measureFrames(TMeasure& f_measure)
+    {
+        typedef utils::serial::CDispatchTable<utils::serial::CBinaryProtocol::FBinaryCallback> CBinaryTable;
+        SMoveSink l_sink = {0.0f};
+        CBinaryTable::SEntry l_entries[] = {
+            {utils::serial::BIN_BRAKE, utils::serial::CBinaryProtocol::FBinaryCallback()},
+            {utils::serial::BIN_MOVE, utils::serial::CBinaryProtocol::bind<SMoveSink,utils::serial::SMovePayload,&SMoveSink::move>(&l_sink)},
+            {utils::serial::BIN_PID_ACTIVATION, utils::serial::CBinaryProtocol::FBinaryCallback()},
+            {utils::serial::BIN_TELEMETRY_SUBSCRIBE, utils::serial::CBinaryProtocol::FBinaryCallback()}
+        };
+        CBinaryTable l_table(l_entries);
+        utils::serial::SMovePayload l_payload = {0.2f, 10.0f};
+        uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+        uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_MOVE, &l_payload, sizeof(l_payload), l_frame, utils::serial::CBinaryProtocol::FRAMING_COBS);
+        f_measure("COBS frame decode and dispatch", [&](float f_u){
+            uint8_t l_buffer[utils::serial::CBinaryProtocol::s_maxFrameSize];
+            memcpy(l_buffer, l_frame + 1, l_size - 2);
+            uint32_t l_length = utils::serial::CBinaryProtocol::cobsDecode(l_buffer, l_size - 2, l_buffer);
+            uint16_t l_crc = utils::serial::CBinaryProtocol::crc16(l_buffer, l_length - 2);
+            if (l_buffer[1] != l_length - 4 || l_crc != (l_buffer[l_length - 2] | (static_cast<uint16_t>(l_buffer[l_length - 1]) << 8)))
+            {
+                return 0.0f;
+            }
+            const utils::serial::CBinaryProtocol::FBinaryCallback* l_callback = l_table.find(l_buffer[0]);
+            uint8_t l_status = (l_callback != NULL) ? (*l_callback)(l_buffer + 2, l_buffer[1]) : 0xFF;
+            return l_sink.m_speed + l_status + f_u;
+        });
+    }
+
+}; // namespace benchmarks
+
+#endif // BENCHMARK_TARGET_KERNELS_HPP
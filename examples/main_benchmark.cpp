@@ -0,0 +1,153 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    main_benchmark.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   Entry point of the benchmark firmware ('make APP=benchmark'), it measures
+  *          the kernels by the cycle counter, it prints the table on the serial port and
+  *          it checks the cycle budgets of the hot kernels ('make budget').
+  ******************************************************************************
+ */
+
+/* The mbed library */
+#include <mbed.h>
+/* List of the measured kernels */
+#include <benchmarks/kernels.hpp>
+#include <benchmarks/targetkernels.hpp>
+/* Cycle budgets of the hot kernels */
+#include <benchmarks/budgets.hpp>
+
+/// Serial interface with the another device (like single board computer), the same as the interface of the platform.
+Serial          g_rpi(USBTX, USBRX);
+
+/// Sink of the results, the compiler can't remove the measured kernels.
+volatile float  g_sink;
+
+/**
+ * @brief Measurement of the target, it measures each call of the kernel by the DWT cycle counter in critical section. 
+ * 
+ * The cycles of the empty measurement are subtracted, so the table contains the cycles of the kernel with the FPU, the flash 
+ * wait states and the software double arithmetic of the Cortex-M4. The mean cycles of the kernels with budget (benchmarks/budgets.hpp) 
+ * are compared to the budget, the exceeded budgets are marked in the table and counted.
+ */
+class CCycleMeasure
+{
+public:
+    /** @brief  Number of the measured calls of each kernel */
+    static const uint32_t s_calls = 2000;
+
+    /** \brief  Constructor, it starts the cycle counter and it measures the overhead of the measurement.
+     */
+    CCycleMeasure()
+        : m_overhead(0)
+        , m_failures(0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        uint32_t l_min, l_mean, l_max;
+        run([](float f_u){ return f_u; }, l_min, l_mean, l_max);
+        m_overhead = l_min;
+    }
+
+    /** \brief  Measure the kernel and print the minimum, the mean and the maximum cycles of one call.
+     *
+     *  @param f_name          name of the kernel
+     *  @param f_kernel        kernel, it's applied with the input sample and it returns the output sample
+     */
+    template <class F>
+    void operator()(const char* f_name, F f_kernel)
+    {
+        uint32_t l_min, l_mean, l_max;
+        run(f_kernel, l_min, l_mean, l_max);
+        uint32_t l_budget = benchmarks::budget(f_name);
+        bool l_isExceeded = (l_budget != 0) && (l_mean > l_budget);
+        if (l_isExceeded)
+        {
+            m_failures++;
+        }
+        g_rpi.printf("%-36s %8lu %8lu %8lu %8.2f %8lu%s\r\n", f_name
+                                                      , static_cast<unsigned long>(l_min)
+                                                      , static_cast<unsigned long>(l_mean)
+                                                      , static_cast<unsigned long>(l_max)
+                                                      , l_mean * 1000000.0f / SystemCoreClock
+                                                      , static_cast<unsigned long>(l_budget)
+                                                      , l_isExceeded ? " EXCEEDED" : "");
+    }
+
+    /** @brief  Number of the exceeded budgets */
+    uint32_t getFailures() const
+    {
+        return m_failures;
+    }
+
+private:
+    /** \brief  Apply the kernel with the input signal and measure the cycles without the overhead.
+     */
+    template <class F>
+    void run(F f_kernel, uint32_t& f_min, uint32_t& f_mean, uint32_t& f_max)
+    {
+        const float* l_input = benchmarks::input();
+        float l_acc = 0;
+        uint64_t l_sum = 0;
+        f_min = 0xFFFFFFFF;
+        f_max = 0;
+        for (uint32_t i = 0; i < s_calls; ++i)
+        {
+            float l_u = l_input[i & (benchmarks::s_inputSize - 1)];
+            core_util_critical_section_enter();
+            uint32_t l_start = DWT->CYCCNT;
+            l_acc += f_kernel(l_u);
+            uint32_t l_cycles = DWT->CYCCNT - l_start;
+            core_util_critical_section_exit();
+            l_cycles = (l_cycles > m_overhead) ? l_cycles - m_overhead : 0;
+            l_sum += l_cycles;
+            f_min = (l_cycles < f_min) ? l_cycles : f_min;
+            f_max = (l_cycles > f_max) ? l_cycles : f_max;
+        }
+        f_mean = static_cast<uint32_t>(l_sum / s_calls);
+        g_sink = l_acc;
+    }
+
+    /** @brief  Cycles of the empty measurement */
+    uint32_t m_overhead;
+    /** @brief  Number of the exceeded budgets */
+    uint32_t m_failures;
+};
+
+/**
+ * @brief Main function of the benchmark firmware, it prints the table once after the reset. The last line contains the number 
+ * of the exceeded budgets, it's checked by 'benchmarks/budgetcheck.py'.
+ * 
+ * @return int 0
+ */
+int main() 
+{
+    g_rpi.baud(256000);
+    g_rpi.printf("\r\n@BNCH:cycles per call at %lu Hz;;\r\n", static_cast<unsigned long>(SystemCoreClock));
+    g_rpi.printf("%-36s %8s %8s %8s %8s %8s\r\n", "kernel", "min", "mean", "max", "mean_us", "budget");
+    CCycleMeasure l_measure;
+    benchmarks::measureAll(l_measure);
+    benchmarks::measureFrames(l_measure);
+    g_rpi.printf("@BNCH:done;%lu;;\r\n", static_cast<unsigned long>(l_measure.getFailures()));
+    while (true)
+    {
+        wait(1.0);
+    }
+    return 0;
+}
@@ -109,7 +109,7 @@ uint32_t setup()
     g_rpi.printf("#################\r\n");
     g_rpi.printf("\r\n");
     /// Start the Rtos timer for the motion controller
-    g_motionController.startRtosTimer();
+    g_motionController.startTimer(g_taskManager.getTimerWheel());
     return 0;    
 }
 
@@ -46,8 +46,9 @@ float           g_period_Encoder = 0.001;
 
 /// Create a filter object for filtrating the noise appeared on the rotary encoder.
 //! [Create encoder filter]
-signal::filter::lti::siso::CIIRFilter<float,1,2> g_encoderFilter(utils::linalg::CRowVector<float,1>({ -0.77777778})
+constexpr signal::filter::lti::siso::SIIRCoefficients<float,1,2> g_encoderFilterCoeffs(utils::linalg::CRowVector<float,1>({ -0.77777778})
                                                         ,utils::linalg::CRowVector<float,2>({0.11111111,0.11111111}));
+signal::filter::lti::siso::CConstIIRFilter<float,1,2> g_encoderFilter(g_encoderFilterCoeffs);
 //! [Create encoder filter]
 
 /// Create a quadrature encoder object with a filter. It periodically measueres the rotary speed of the motor and applies the given filter. 
@@ -58,7 +59,8 @@ examples::sensors::CEncoderSender         g_encoderPublisher(0.01/g_baseTick,g_q
 
 
 /// Create a splines based converter object to convert the volt signal to pwm signal
-signal::controllers::CConverterSpline<2,1> l_volt2pwmConverter({-0.0007836798991808444,0.0007836798991808444},{std::array<float,2>({0.043799873976055455,-0.050627}),std::array<float,2>({0.30029741650913677,0.0}),std::array<float,2>({0.043799873976055455,0.050627})});
+constexpr signal::controllers::SSplineCoefficients<2,1> l_volt2pwmCoeffs({-0.0007836798991808444,0.0007836798991808444},{std::array<float,2>({0.043799873976055455,-0.050627}),std::array<float,2>({0.30029741650913677,0.0}),std::array<float,2>({0.043799873976055455,0.050627})});
+signal::controllers::CConstConverterSpline<2,1> l_volt2pwmConverter(l_volt2pwmCoeffs);
 //Create the controller transfer function for the motor
 /// Create a discrete transfer function, which respresents a discrete PID controller.
 
@@ -113,9 +115,9 @@ uint32_t setup()
     g_rpi.printf("#################\r\n");
     g_rpi.printf("\r\n");
     /// Start the Rtos timer for the quadrature encoder    
-    g_quadratureEncoderTask.startTimer();
+    g_quadratureEncoderTask.startTimer(g_taskManager.getTimerWheel());
     /// Start the Rtos timer for the motion controller
-    g_motionController.startRtosTimer();
+    g_motionController.startTimer(g_taskManager.getTimerWheel());
     return 0;    
 }
 
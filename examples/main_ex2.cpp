@@ -85,8 +85,9 @@ CSafetyStopFunction g_safetyStop(g_ir_sensor1, g_ir_sensor2, g_ir_sensor3, g_ir_
 float           g_period_Encoder = 0.001;
 
 /// Create a filter object for filtrating the noise appeared on the rotary encoder.
-signal::filter::lti::siso::CIIRFilter<float,1,2> g_encoderFilter(utils::linalg::CRowVector<float,1>({ -0.77777778})
+constexpr signal::filter::lti::siso::SIIRCoefficients<float,1,2> g_encoderFilterCoeffs(utils::linalg::CRowVector<float,1>({ -0.77777778})
                                                         ,utils::linalg::CRowVector<float,2>({0.11111111,0.11111111}));
+signal::filter::lti::siso::CConstIIRFilter<float,1,2> g_encoderFilter(g_encoderFilterCoeffs);
 /// Create a quadrature encoder object with a filter. It periodically measueres the rotary speed of the motor and applies the given filter. 
 hardware::encoders::CQuadratureEncoderWithFilterTask g_quadratureEncoderTask(g_period_Encoder,hardware::encoders::CQuadratureEncoder_TIM4::Instance(),2048,g_encoderFilter);
 
@@ -95,7 +96,8 @@ examples::sensors::CEncoderSender         g_encoderPublisher(0.01/g_baseTick,g_q
 
 //Create an object to convert volt to pwm for motor driver
 /// Create a splines based converter object to convert the volt signal to pwm signal
-signal::controllers::CConverterSpline<2,1> l_volt2pwmConverter({-0.22166,0.22166},{std::array<float,2>({0.1041568079746662,-0.08952760561569219}),std::array<float,2>({0.50805,0.0}),std::array<float,2>({0.1041568079746662,0.08952760561569219})});
+constexpr signal::controllers::SSplineCoefficients<2,1> l_volt2pwmCoeffs({-0.22166,0.22166},{std::array<float,2>({0.1041568079746662,-0.08952760561569219}),std::array<float,2>({0.50805,0.0}),std::array<float,2>({0.1041568079746662,0.08952760561569219})});
+signal::controllers::CConstConverterSpline<2,1> l_volt2pwmConverter(l_volt2pwmCoeffs);
 //  signal::controllers::siso::CMotorController<double> l_pidController(g_motorPIDTF,g_period_Encoder);
 signal::controllers::siso::CMotorController<double> l_pidController( 0.1150,0.81000,0.000222,0.04,g_period_Encoder);
 /// Create a controller object based on the predefined PID controller and the quadrature encoder
@@ -144,9 +146,9 @@ uint32_t setup()
     g_rpi.printf("#################\r\n");
     g_rpi.printf("\r\n");
     /// Start the Rtos timer for the quadrature encoder    
-    g_quadratureEncoderTask.startTimer();
+    g_quadratureEncoderTask.startTimer(g_taskManager.getTimerWheel());
     /// Start the Rtos timer for the motion controller
-    g_motionController.startRtosTimer();
+    g_motionController.startTimer(g_taskManager.getTimerWheel());
     return 0;    
 }
 
@@ -0,0 +1,362 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    main_schedbench.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   Entry point of the scheduler benchmark firmware ('make APP=schedbench'),
+  *          it applies the same task set by each task manager backend and it prints
+  *          the comparison table on the serial port.
+  ******************************************************************************
+ */
+
+/* The mbed library */
+#include <mbed.h>
+#include <rtos.h>
+#include <algorithm>
+/* Task manager backends */
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/ticklesstaskmanager.hpp>
+#include <utils/taskmanager/statictaskmanager.hpp>
+/* Tasks of the platform */
+#include <examples/blinker.hpp>
+#include <utils/serial/serialmonitor.hpp>
+#include <examples/sensors/encoderpublisher.hpp>
+/* Base tick of the platform */
+#include <utils/config/vehicleprofile.hpp>
+
+/* Periods of the dummy tasks in base ticks ('make APP=schedbench SCHEDBENCH_PERIODS=10,20,50,100') */
+#ifndef SCHEDBENCH_PERIODS
+#define SCHEDBENCH_PERIODS 10,20,50,100
+#endif
+/* Busy cycles of a dummy task's run ('SCHEDBENCH_LOAD=<cycles>') */
+#ifndef SCHEDBENCH_LOAD
+#define SCHEDBENCH_LOAD 2000
+#endif
+/* Duration of the measurement of a backend in second ('SCHEDBENCH_SECONDS=<seconds>') */
+#ifndef SCHEDBENCH_SECONDS
+#define SCHEDBENCH_SECONDS 5
+#endif
+
+/// Serial interface with the another device (like single board computer), the same as the interface of the platform.
+Serial          g_rpi(USBTX, USBRX);
+/// Transmitter of the serial monitor's responses and of the encoder publisher.
+utils::serial::CSerialTransmitter g_rpiTransmitter(g_rpi);
+/// Base tick of the platform in seconds.
+constexpr float g_baseTick = utils::config::s_vehicle.m_baseTick;
+
+/**
+ * @brief Synthetic encoder of the encoder publisher, the benchmark doesn't need the quadrature counter.
+ */
+class CSyntheticEncoder: public hardware::encoders::IEncoderGetter
+{
+public:
+    /** @brief  Counted impulse in the last period */
+    virtual int16_t getCount()
+    {
+        return 0;
+    }
+    /** @brief  Rotation speed in rps */
+    virtual float getSpeedRps()
+    {
+        return 0.0f;
+    }
+    /** @brief  The encoder is directional */
+    virtual bool isAbs()
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief Dummy task of the synthetic load, each run is a busy wait of the given cycles. It records the cycle counter at the start
+ * of its first s_samples runs, so the start jitter and the dispatch latency are measured in the task and not by the scheduler's trigger
+ * time (the cyclic executive triggers the periodic tasks in the dispatch).
+ */
+class CDummyTask: public utils::task::CTask
+{
+public:
+    /** @brief  Number of the recorded starts */
+    static const uint32_t s_samples = 512;
+
+    /** @brief  Constructor, the period is in base ticks */
+    CDummyTask(uint32_t f_period, uint32_t f_load)
+        : utils::task::CTask(f_period)
+        , m_load(f_load)
+        , m_count(0)
+        , m_starts()
+    {
+    }
+    /** @brief  Start a new measurement */
+    void reset()
+    {
+        m_count = 0;
+    }
+    /** @brief  Number of the recorded starts */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+    /** @brief  Cycle counter at the recorded starts */
+    const uint32_t* getStarts() const
+    {
+        return m_starts;
+    }
+private:
+    /** @brief  Record the start and wait the load */
+    void _run()
+    {
+        uint32_t l_start = DWT->CYCCNT;
+        if (m_count < s_samples)
+        {
+            m_starts[m_count++] = l_start;
+        }
+        while (DWT->CYCCNT - l_start < m_load)
+        {
+        }
+    }
+
+    /** @brief  Busy cycles of a run */
+    const uint32_t m_load;
+    /** @brief  Number of the recorded starts */
+    volatile uint32_t m_count;
+    /** @brief  Cycle counter at the starts */
+    uint32_t m_starts[s_samples];
+};
+
+/**
+ * @brief Set of the dummy tasks, one task for each period, so the same periods are the template arguments of the cyclic executive.
+ */
+template <uint32_t... Periods>
+class CDummyTasks
+{
+public:
+    /** @brief  Number of the dummy tasks */
+    static constexpr uint32_t s_count = sizeof...(Periods);
+    /** @brief  Constructor */
+    CDummyTasks(uint32_t f_load)
+        : m_tasks{CDummyTask(Periods, f_load)...}
+    {
+    }
+    /** @brief  Dummy task with the given index */
+    CDummyTask& operator[](uint32_t f_idx)
+    {
+        return m_tasks[f_idx];
+    }
+private:
+    /** @brief  Dummy tasks */
+    CDummyTask m_tasks[s_count];
+};
+
+/// Synthetic encoder of the encoder publisher.
+CSyntheticEncoder g_encoder;
+/// Period of the blinker in base ticks.
+constexpr uint32_t g_blinkerPeriod = utils::config::s_vehicle.ticks(0.5f);
+/// Period of the encoder publisher in base ticks.
+constexpr uint32_t g_publisherPeriod = utils::config::s_vehicle.ticks(0.01f);
+/// Blinker of the platform.
+examples::CBlinker g_blinker(g_blinkerPeriod, LED1);
+/// Serial monitor of the platform without subscribers, it's triggered by the received bytes.
+utils::serial::CSerialMonitor g_serialMonitor(g_rpi, g_rpiTransmitter, utils::serial::CSerialMonitor::CSerialSubscriberMap());
+/// Encoder publisher of the platform, it's activated, so it writes its message in each run.
+examples::sensors::CEncoderPublisher g_encoderPublisher(g_publisherPeriod, g_encoder, g_rpiTransmitter);
+/// Dummy tasks of the synthetic load.
+CDummyTasks<SCHEDBENCH_PERIODS> g_dummies(SCHEDBENCH_LOAD);
+/// Number of the tasks of the platform, the dummy tasks follow them in the task list.
+const uint32_t g_platformTaskCount = 3;
+/// Number of the tasks.
+constexpr uint32_t g_taskCount = g_platformTaskCount + decltype(g_dummies)::s_count;
+/// List of the tasks, it's filled in the main function.
+utils::task::CTask* g_taskList[g_taskCount];
+/// Statistics of the tasks' execution.
+utils::task::CTaskStatistics g_taskStatistics[g_taskCount];
+/// Periods of the dummy tasks in base ticks.
+const uint32_t g_dummyPeriods[] = {SCHEDBENCH_PERIODS};
+
+/// Idle cycles counted by the idle thread.
+volatile uint32_t g_idleCycles = 0;
+/// Idle thread, it runs below the task managers' thread, so it counts the cycles, which aren't used by the tasks, the interrupts and the dispatch.
+Thread g_idleThread(osPriorityLow);
+/// Longest iteration of the idle loop in cycles, a longer gap was a preemption.
+const uint32_t g_idleGap = 200;
+/// Deviations of the starts of the dummy tasks, the samples of the percentiles.
+uint32_t g_deviations[decltype(g_dummies)::s_count * CDummyTask::s_samples];
+
+/**
+ * @brief Loop of the idle thread, the short gaps between two readings of the cycle counter are idle cycles.
+ */
+void idleLoop()
+{
+    uint32_t l_last = DWT->CYCCNT;
+    while (true)
+    {
+        uint32_t l_now = DWT->CYCCNT;
+        uint32_t l_gap = l_now - l_last;
+        l_last = l_now;
+        if (l_gap < g_idleGap)
+        {
+            g_idleCycles += l_gap;
+        }
+    }
+}
+
+/**
+ * @brief Percentile of the sorted samples.
+ *
+ * @param f_samples         sorted samples
+ * @param f_count           number of the samples
+ * @param f_percent         percentile in percent
+ * @return                  value of the percentile
+ */
+uint32_t percentile(const uint32_t* f_samples, uint32_t f_count, uint32_t f_percent)
+{
+    return (0 == f_count) ? 0 : f_samples[(f_count - 1) * f_percent / 100];
+}
+
+/**
+ * @brief Apply the task set by a backend for the measurement duration and print its row of the table.
+ *
+ * The idle time is counted by the idle thread, the overhead is the rest of the busy time after the execution time of the tasks:
+ * the interrupts of the ticker, the dispatch and the thread switches. The polling backend doesn't leave idle time, its overhead is
+ * the polling itself. The dispatch latency of a dummy task is the delay of its start from its period grid, counted from its earliest
+ * start, and the jitter is the deviation of the interval between two starts from the period. The percentiles pool all dummy tasks.
+ *
+ * @param f_name            name of the backend
+ * @param f_scheduler       backend, constructed with the task list
+ */
+void measure(const char* f_name, utils::task::CTaskScheduler& f_scheduler)
+{
+    for (uint32_t i = 0; i < g_taskCount; ++i)
+    {
+        g_taskStatistics[i].reset();
+    }
+    for (uint32_t i = 0; i < decltype(g_dummies)::s_count; ++i)
+    {
+        g_dummies[i].reset();
+    }
+    uint32_t l_startIdle = g_idleCycles;
+    uint32_t l_startCycles = DWT->CYCCNT;
+    uint32_t l_start = us_ticker_read();
+    while (us_ticker_read() - l_start < SCHEDBENCH_SECONDS * 1000000U)
+    {
+        f_scheduler.mainCallback();
+    }
+    uint32_t l_totalCycles = DWT->CYCCNT - l_startCycles;
+    uint32_t l_idleCycles = g_idleCycles - l_startIdle;
+    // The next backend registers itself, until it the notifications of the event sources don't reach the destroyed one
+    for (uint32_t i = 0; i < g_taskCount; ++i)
+    {
+        g_taskList[i]->registerScheduler(NULL, i, 0);
+    }
+
+    uint64_t l_taskCycles = 0;
+    uint32_t l_missed = 0;
+    for (uint32_t i = 0; i < g_taskCount; ++i)
+    {
+        l_taskCycles += static_cast<uint64_t>(g_taskStatistics[i].getMeanExecution()) * g_taskStatistics[i].getCount();
+        l_missed += g_taskStatistics[i].getMissed();
+    }
+    uint32_t l_deviationCount = 0;
+    uint32_t l_maxLatency = 0;
+    for (uint32_t i = 0; i < decltype(g_dummies)::s_count; ++i)
+    {
+        const uint32_t* l_starts = g_dummies[i].getStarts();
+        uint32_t l_count = g_dummies[i].getCount();
+        uint32_t l_period = static_cast<uint32_t>(g_dummyPeriods[i] * g_baseTick * SystemCoreClock + 0.5f);
+        // Offsets of the starts from the period grid of the first start, the earliest one is the latency free start
+        int32_t l_earliest = 0;
+        int32_t l_latest = 0;
+        for (uint32_t k = 1; k < l_count; ++k)
+        {
+            int32_t l_offset = static_cast<int32_t>(l_starts[k] - l_starts[0] - k * l_period);
+            l_earliest = (l_offset < l_earliest) ? l_offset : l_earliest;
+            l_latest = (l_offset > l_latest) ? l_offset : l_latest;
+            int32_t l_deviation = static_cast<int32_t>(l_starts[k] - l_starts[k - 1] - l_period);
+            g_deviations[l_deviationCount++] = static_cast<uint32_t>((l_deviation < 0) ? -l_deviation : l_deviation);
+        }
+        uint32_t l_latency = static_cast<uint32_t>(l_latest - l_earliest);
+        l_maxLatency = (l_latency > l_maxLatency) ? l_latency : l_maxLatency;
+    }
+    std::sort(g_deviations, g_deviations + l_deviationCount);
+
+    float l_cyclesPerUs = SystemCoreClock / 1000000.0f;
+    float l_idle = 100.0f * l_idleCycles / l_totalCycles;
+    float l_tasks = 100.0f * static_cast<float>(l_taskCycles) / l_totalCycles;
+    float l_overhead = 100.0f - l_idle - l_tasks;
+    g_rpi.printf("%-12s %8.2f %8.2f %8.2f %10.1f %8.1f %8.1f %8.1f %8lu\r\n", f_name
+                                                  , l_idle
+                                                  , l_tasks
+                                                  , (l_overhead > 0.0f) ? l_overhead : 0.0f
+                                                  , l_maxLatency / l_cyclesPerUs
+                                                  , percentile(g_deviations, l_deviationCount, 50) / l_cyclesPerUs
+                                                  , percentile(g_deviations, l_deviationCount, 90) / l_cyclesPerUs
+                                                  , percentile(g_deviations, l_deviationCount, 99) / l_cyclesPerUs
+                                                  , static_cast<unsigned long>(l_missed));
+}
+
+/**
+ * @brief Main function of the scheduler benchmark firmware, it measures the backends one after the other with the same task set and
+ * it prints the table once after the reset. Each backend is constructed in its own scope, its destructor stops its interrupt.
+ *
+ * @return int 0
+ */
+int main()
+{
+    g_rpi.baud(256000);
+    utils::task::CTaskStatistics::enableCycleCounter();
+    g_taskList[0] = &g_blinker;
+    g_taskList[1] = &g_serialMonitor;
+    g_taskList[2] = &g_encoderPublisher;
+    for (uint32_t i = 0; i < decltype(g_dummies)::s_count; ++i)
+    {
+        g_taskList[g_platformTaskCount + i] = &g_dummies[i];
+    }
+    for (uint32_t i = 0; i < g_taskCount; ++i)
+    {
+        g_taskList[i]->attachStatistics(&g_taskStatistics[i]);
+    }
+    char l_response[utils::serial::CSerialTransmitter::s_maxMessageLength];
+    g_encoderPublisher.serialCallback("1", l_response);
+    g_idleThread.start(idleLoop);
+
+    g_rpi.printf("\r\n@SBNC:%lu tasks, %lu s per backend at %lu Hz;;\r\n", static_cast<unsigned long>(g_taskCount)
+                                                                       , static_cast<unsigned long>(SCHEDBENCH_SECONDS)
+                                                                       , static_cast<unsigned long>(SystemCoreClock));
+    g_rpi.printf("%-12s %8s %8s %8s %10s %8s %8s %8s %8s\r\n", "backend", "idle_%", "tasks_%", "ovh_%", "lat_max_us", "jit_p50", "jit_p90", "jit_p99", "missed");
+    {
+        utils::task::CTaskManager l_polling(g_taskList, g_taskCount, g_baseTick, utils::task::CTaskManager::POLLING);
+        measure("polling", l_polling);
+    }
+    {
+        utils::task::CTaskManager l_eventDriven(g_taskList, g_taskCount, g_baseTick, utils::task::CTaskManager::EVENT_DRIVEN);
+        measure("event", l_eventDriven);
+    }
+    {
+        utils::task::CTicklessTaskManager l_tickless(g_taskList, g_taskCount, g_baseTick);
+        measure("tickless", l_tickless);
+    }
+    {
+        utils::task::CStaticTaskManager<g_blinkerPeriod, 0, g_publisherPeriod, SCHEDBENCH_PERIODS> l_cyclic(g_taskList, g_baseTick);
+        measure("cyclic", l_cyclic);
+    }
+    g_rpi.printf("@SBNC:done;;\r\n");
+    while (true)
+    {
+        wait(1.0);
+    }
+    return 0;
+}
@@ -0,0 +1,618 @@
+"""Host client of the board protocol with pipelined commands.
+
+The client owns the serial port and a reader thread. The commands are written without waiting for the previous response,
+each command gets a host sequence number and a future, which is resolved by its response. The board answers the commands
+of a link in order on the response lane, so the responses are matched to the oldest pending command of the same key
+(text) or of the same message identifier (binary), the sequence numbers show the order in the logs.
+
+The identifiers and the payloads are generated from protocol/protocol.json (protocolmessages.py), the frames follow
+include/utils/serial/binaryprotocol.hpp: sync byte (0xA5), identifier, length, payload, CRC16-CCITT, or
+the same fields COBS stuffed between zero delimiters. The telemetry batches are decoded to numpy arrays without copy, when
+numpy is available, otherwise to lists of tuples.
+
+Usage:
+    with CBoardClient('/dev/ttyACM0', 256000) as l_board:
+        l_acks = [l_board.sendText('MCTL', '0.2;5.0'), l_board.sendBinary(BIN_BRAKE, SBrakePayload(0.0).pack())]
+        print([l_ack.result(0.5) for l_ack in l_acks])
+        l_board.onTelemetry(lambda f_batch: print(f_batch.m_values.mean(axis=0)))
+        l_board.sendText('TELS', '3;10').result(0.5)
+"""
+import collections
+import struct
+import threading
+from concurrent.futures import Future
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+from protocolmessages import *
+
+SYNC = 0xA5
+DELIMITER = 0x00
+RESPONSE_FLAG = 0x80
+STAMP_FLAG = 0x20
+MAX_PAYLOAD = 250
+# Flow control characters of CSerialMonitor
+XOFF = 0x13
+XON = 0x11
+# Longest pause of the sending after XOFF in second
+FLOW_TIMEOUT = 0.5
+
+def crc16(f_data, f_crc=0xFFFF):
+    """CRC16-CCITT (polynomial 0x1021) like CBinaryProtocol::crc16."""
+    for l_byte in f_data:
+        f_crc ^= l_byte << 8
+        for _ in range(8):
+            f_crc = ((f_crc << 1) ^ 0x1021) & 0xFFFF if f_crc & 0x8000 else (f_crc << 1) & 0xFFFF
+    return f_crc
+
+
+def cobsEncode(f_data):
+    """Stuff the bytes by COBS, the result doesn't contain zero bytes."""
+    l_out = bytearray(b'\x00')
+    l_code = 0
+    for l_byte in f_data:
+        if l_byte != 0:
+            l_out.append(l_byte)
+        if l_byte == 0 or len(l_out) - l_code == 0xFF:
+            l_out[l_code] = len(l_out) - l_code
+            l_code = len(l_out)
+            l_out.append(0)
+    l_out[l_code] = len(l_out) - l_code
+    return bytes(l_out)
+
+
+def cobsDecode(f_data):
+    """Restore the COBS stuffed bytes, it returns None, when the bytes are invalid."""
+    l_out = bytearray()
+    i = 0
+    while i < len(f_data):
+        l_code = f_data[i]
+        if l_code == 0 or i + l_code > len(f_data):
+            return None
+        l_out += f_data[i + 1:i + l_code]
+        i += l_code
+        if l_code != 0xFF and i < len(f_data):
+            l_out.append(0)
+    return bytes(l_out)
+
+
+def encodeFrame(f_id, f_payload, f_cobs=False):
+    """Encode a binary frame with sync byte or in COBS framing."""
+    if len(f_payload) > MAX_PAYLOAD:
+        raise ValueError('payload longer than %d bytes' % MAX_PAYLOAD)
+    l_body = bytes([f_id, len(f_payload)]) + bytes(f_payload)
+    l_body += struct.pack('<H', crc16(l_body))
+    if f_cobs:
+        return b'\x00' + cobsEncode(l_body) + b'\x00'
+    return bytes([SYNC]) + l_body
+
+
+def lz4Compress(f_data):
+    """Greedy LZ4 block compression (the sequences without the frame format), like CFirmwareUpdate::decompress expects it. The
+    last five bytes are literals and the last match starts at least twelve bytes before the end, like in the reference encoder."""
+    l_out = bytearray()
+    l_table = {}
+    l_anchor = 0
+    i = 0
+    while i < len(f_data) - 12:
+        l_key = bytes(f_data[i:i + 4])
+        l_candidate = l_table.get(l_key)
+        l_table[l_key] = i
+        if l_candidate is None or i - l_candidate > 0xFFFF:
+            i += 1
+            continue
+        l_match = 4
+        while i + l_match < len(f_data) - 5 and f_data[l_candidate + l_match] == f_data[i + l_match]:
+            l_match += 1
+        _lz4Sequence(l_out, f_data[l_anchor:i], i - l_candidate, l_match)
+        i += l_match
+        l_anchor = i
+    _lz4Sequence(l_out, f_data[l_anchor:], 0, 0)
+    return bytes(l_out)
+
+
+def _lz4Length(f_out, f_length):
+    """Extra bytes of a length above 15."""
+    while f_length >= 255:
+        f_out.append(255)
+        f_length -= 255
+    f_out.append(f_length)
+
+
+def _lz4Sequence(f_out, f_literals, f_offset, f_match):
+    """Append a sequence, the last sequence has only literals (zero match)."""
+    l_extra = f_match - 4 if f_match else 0
+    f_out.append((min(len(f_literals), 15) << 4) | min(l_extra, 15))
+    if len(f_literals) >= 15:
+        _lz4Length(f_out, len(f_literals) - 15)
+    f_out += f_literals
+    if f_match:
+        f_out += struct.pack('<H', f_offset)
+        if l_extra >= 15:
+            _lz4Length(f_out, l_extra - 15)
+
+
+class CFrameParser:
+    """Incremental parser of the received stream, it mirrors the resynchronization of CSerialMonitor::parseFrames.
+
+    The text lines ('@KEY:content\\r\\n') are returned as ('text', key, content, stamp), the binary frames as
+    ('binary', identifier, payload, stamp), where the payload is a memoryview of the received bytes and the stamp is the
+    board time in microsecond or None. The XON/XOFF characters of the flow control are sent by the board between the
+    frames, they are returned as ('flow', stopped).
+    """
+
+    def __init__(self):
+        self.m_buffer = bytearray()
+        self.m_invalid = 0
+
+    @staticmethod
+    def _flow(f_frames, f_gap):
+        for l_byte in f_gap:
+            if l_byte == XOFF or l_byte == XON:
+                f_frames.append(('flow', l_byte == XOFF))
+
+    def feed(self, f_data):
+        self.m_buffer += f_data
+        l_frames = []
+        l_begin = 0
+        l_buffer = self.m_buffer
+        while l_begin < len(l_buffer):
+            l_start = self._findStart(l_buffer, l_begin)
+            if l_start < 0:
+                self._flow(l_frames, l_buffer[l_begin:])
+                l_begin = len(l_buffer)
+                break
+            self._flow(l_frames, l_buffer[l_begin:l_start])
+            l_byte = l_buffer[l_start]
+            if l_byte == DELIMITER:
+                l_stop = l_buffer.find(b'\x00', l_start + 1)
+                if l_stop < 0:
+                    l_begin = l_start
+                    break
+                l_begin = l_stop
+                if l_stop == l_start + 1:
+                    continue
+                l_body = cobsDecode(bytes(l_buffer[l_start + 1:l_stop]))
+                if l_body is None or len(l_body) < 4 or l_body[1] != len(l_body) - 4 \
+                        or crc16(l_body[:-2]) != struct.unpack_from('<H', l_body, len(l_body) - 2)[0]:
+                    self.m_invalid += 1
+                    continue
+                l_frames.append(self._binary(l_body[0], memoryview(l_body)[2:-2]))
+                l_begin = l_stop + 1
+            elif l_byte == SYNC:
+                if len(l_buffer) - l_start < 3:
+                    l_begin = l_start
+                    break
+                l_length = l_buffer[l_start + 2]
+                l_size = 3 + l_length + 2
+                if l_length > MAX_PAYLOAD + 4:
+                    self.m_invalid += 1
+                    l_begin = l_start + 1
+                    continue
+                if len(l_buffer) - l_start < l_size:
+                    l_begin = l_start
+                    break
+                l_body = bytes(l_buffer[l_start + 1:l_start + l_size])
+                if crc16(l_body[:-2]) != struct.unpack_from('<H', l_body, len(l_body) - 2)[0]:
+                    self.m_invalid += 1
+                    l_begin = l_start + 1
+                    continue
+                l_frames.append(self._binary(l_body[0], memoryview(l_body)[2:-2]))
+                l_begin = l_start + l_size
+            else:
+                l_stop = l_buffer.find(b'\n', l_start)
+                if l_stop < 0:
+                    l_begin = l_start
+                    break
+                l_line = bytes(l_buffer[l_start:l_stop]).decode('ascii', 'replace').rstrip('\r')
+                l_begin = l_stop + 1
+                if len(l_line) < 6 or l_line[5] != ':':
+                    self.m_invalid += 1
+                    continue
+                l_content, l_stamp = l_line[6:], None
+                if '|' in l_content and l_content.rsplit('|', 1)[1].isdigit():
+                    l_content, l_stamp = l_content.rsplit('|', 1)
+                    l_stamp = int(l_stamp)
+                l_frames.append(('text', l_line[1:5], l_content, l_stamp))
+        del self.m_buffer[:l_begin]
+        return l_frames
+
+    @staticmethod
+    def _findStart(f_buffer, f_begin):
+        l_found = [i for i in (f_buffer.find(b'@', f_begin), f_buffer.find(bytes([SYNC]), f_begin),
+                               f_buffer.find(b'\x00', f_begin)) if i >= 0]
+        return min(l_found) if l_found else -1
+
+    @staticmethod
+    def _binary(f_id, f_payload):
+        if f_id & STAMP_FLAG and len(f_payload) >= 4:
+            return ('binary', f_id & ~STAMP_FLAG, f_payload[:-4], struct.unpack_from('<I', f_payload, len(f_payload) - 4)[0])
+        return ('binary', f_id, f_payload, None)
+
+
+def decodeEvents(f_payload):
+    """Decode a batch of the event log (BIN_EVENT_LOG), it returns the number of the dropped events and the formatted events, each
+    one is a tuple of its board time (us) and its text line (e.g. '@PIDA:Encoder error;;'), the unknown identifiers are shown by
+    their number."""
+    l_header = SEventLogHeader.unpack(f_payload)
+    l_offset = SEventLogHeader.s_struct.size
+    l_events = []
+    for _ in range(l_header.m_count):
+        l_record = SEventRecord.unpack(f_payload, l_offset)
+        l_offset += SEventRecord.s_struct.size
+        l_arguments = bytes(f_payload[l_offset:l_offset + l_record.m_length])
+        l_offset += l_record.m_length
+        l_event = LOG_EVENTS.get(l_record.m_id)
+        if l_event is None or l_event[3].size != len(l_arguments):
+            l_events.append((l_record.m_timestamp, '@LOGE:%d;%s;;' % (l_record.m_id, l_arguments.hex())))
+            continue
+        _, l_format, l_names, l_layout = l_event
+        l_events.append((l_record.m_timestamp, l_format.format(**dict(zip(l_names, l_layout.unpack(l_arguments))))))
+    return l_header.m_dropped, l_events
+
+
+class CTelemetryBatch:
+    """Decoded telemetry batch, 'm_values' has a row for each sample and a column for each subscribed signal."""
+
+    def __init__(self, f_payload, f_packed):
+        (self.m_sequence, self.m_timestamp, self.m_interval, self.m_signalCount, self.m_signalMask,
+         self.m_sampleCount) = STelemetryHeader.unpack(f_payload)
+        l_data = f_payload[STelemetryHeader.s_struct.size:]
+        if not f_packed:
+            l_count = self.m_sampleCount * self.m_signalCount
+            if numpy is not None:
+                self.m_values = numpy.frombuffer(l_data, dtype='<f4', count=l_count).reshape(self.m_sampleCount, self.m_signalCount)
+            else:
+                l_floats = l_data[:4 * l_count].cast('f')
+                self.m_values = [tuple(l_floats[i:i + self.m_signalCount]) for i in range(0, l_count, self.m_signalCount)]
+            return
+        self.m_values = self._unpack(l_data)
+
+    def _unpack(self, f_data):
+        """Decode the delta encoded batch (BIN_TELEMETRY_PACKED)."""
+        l_codes = bytes(f_data[:self.m_signalCount])
+        l_previous = [0] * self.m_signalCount
+        l_rows = []
+        i = self.m_signalCount
+        for _ in range(self.m_sampleCount):
+            l_row = []
+            for l_signal, l_code in enumerate(l_codes):
+                if l_code >> 4 == 0:
+                    l_row.append(struct.unpack_from('<f', f_data, i)[0])
+                    i += 4
+                    continue
+                l_zigzag, l_shift = 0, 0
+                while True:
+                    l_byte = f_data[i]
+                    i += 1
+                    l_zigzag |= (l_byte & 0x7F) << l_shift
+                    l_shift += 7
+                    if not l_byte & 0x80:
+                        break
+                l_previous[l_signal] += (l_zigzag >> 1) ^ -(l_zigzag & 1)
+                l_row.append(l_previous[l_signal] / 10.0 ** (l_code & 0x0F))
+            l_rows.append(tuple(l_row))
+        if numpy is not None:
+            return numpy.array(l_rows, dtype='<f4').reshape(self.m_sampleCount, self.m_signalCount)
+        return l_rows
+
+    def timestamps(self):
+        """Board time of each sample in microsecond."""
+        return [(self.m_timestamp + i * self.m_interval) & 0xFFFFFFFF for i in range(self.m_sampleCount)]
+
+
+class CBoardClient:
+    """Pipelined client of a board link.
+
+    'sendText' and 'sendBinary' return a future immediately, the reader thread resolves it with the content of the text
+    response or with the status of the binary response. The published frames are passed to the registered listeners in
+    the reader thread. The commands, whose response is suppressed by the board, are sent with 'f_response=False'.
+    """
+
+    def __init__(self, f_port, f_baud=256000, f_cobs=False):
+        import serial
+        self.m_port = serial.Serial(f_port, f_baud, timeout=0.05)
+        self.m_cobs = f_cobs
+        self.m_parser = CFrameParser()
+        self.m_lock = threading.Lock()
+        self.m_writeLock = threading.Lock()
+        self.m_resumed = threading.Event()
+        self.m_resumed.set()
+        self.m_pending = collections.defaultdict(collections.deque)
+        self.m_sequence = 0
+        self.m_textListeners = collections.defaultdict(list)
+        self.m_binaryListeners = collections.defaultdict(list)
+        self.m_droppedEvents = 0
+        self.m_running = True
+        self.m_reader = threading.Thread(target=self._read, name='board reader', daemon=True)
+        self.m_reader.start()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *f_args):
+        self.close()
+
+    def close(self):
+        self.m_running = False
+        self.m_reader.join()
+        self.m_port.close()
+        with self.m_lock:
+            for l_queue in self.m_pending.values():
+                for _, l_future in l_queue:
+                    l_future.cancel()
+            self.m_pending.clear()
+
+    def sendText(self, f_key, f_content, f_response=True):
+        """Send '#KEY:content;;' and return the future of the response content (without the ';;' ending)."""
+        return self._send(('text', f_key), ('#%s:%s;;\r\n' % (f_key, f_content)).encode('ascii'), f_response)
+
+    def sendBinary(self, f_id, f_payload, f_response=True):
+        """Send a binary frame and return the future of the status code of the response."""
+        return self._send(('binary', f_id), encodeFrame(f_id, f_payload, self.m_cobs), f_response)
+
+    def emergencyStop(self):
+        """Send the emergency stop frame, it's always sent with sync byte, so the board brakes from its receive interrupt."""
+        return self._send(('binary', BIN_EMERGENCY_STOP), encodeFrame(BIN_EMERGENCY_STOP, b'', False), True)
+
+    def move(self, f_speed, f_angle):
+        return self.sendBinary(BIN_MOVE, SMovePayload(f_speed, f_angle).pack())
+
+    def brake(self, f_angle):
+        return self.sendBinary(BIN_BRAKE, SBrakePayload(f_angle).pack())
+
+    def subscribeTelemetry(self, f_mask, f_decimation, f_aggregation=0):
+        return self.sendBinary(BIN_TELEMETRY_SUBSCRIBE, STelemetrySubscribePayload(f_mask, f_decimation, f_aggregation).pack())
+
+    def readRegisters(self, f_address, f_count):
+        """Read a register range, the future gives the raw 32-bit words of the BIN_REGISTER_DATA frame."""
+        l_result = Future()
+        l_words = []
+
+        def onData(f_payload, f_stamp):
+            l_header = SRegisterHeader.unpack(f_payload)
+            l_size = SRegisterHeader.s_struct.size
+            if l_header.m_address == f_address and not l_words:
+                l_words.append(bytes(f_payload[l_size:l_size + 4 * l_header.m_count]))
+                self.m_binaryListeners[BIN_REGISTER_DATA].remove(onData)
+
+        def onStatus(f_status):
+            if f_status.result() != 0 or not l_words:
+                l_result.set_exception(IOError(STATUS_NAMES.get(f_status.result(), 'error')))
+            else:
+                l_result.set_result(l_words[0])
+
+        self.m_binaryListeners[BIN_REGISTER_DATA].append(onData)
+        self.sendBinary(BIN_REGISTER_READ, SRegisterHeader(f_address, f_count).pack()).add_done_callback(onStatus)
+        return l_result
+
+    def readCommandRecord(self):
+        """Dump the log of the command recorder ('CREC' key), the future gives the (timestamp, kind, frame) entries in time order."""
+        l_result = Future()
+        l_entries = []
+
+        def onData(f_payload, f_stamp):
+            l_header = SCommandRecordHeader.unpack(f_payload)
+            l_offset = SCommandRecordHeader.s_struct.size
+            for _ in range(l_header.m_count):
+                l_entry = SCommandEntry.unpack(f_payload[l_offset:])
+                l_offset += SCommandEntry.s_struct.size
+                l_entries.append((l_entry.m_timestamp, l_entry.m_kind, bytes(f_payload[l_offset:l_offset + l_entry.m_length])))
+                l_offset += l_entry.m_length
+            if len(l_entries) >= l_header.m_total:
+                self.m_binaryListeners[BIN_COMMAND_RECORD].remove(onData)
+                l_result.set_result(l_entries)
+
+        self.m_binaryListeners[BIN_COMMAND_RECORD].append(onData)
+        self.sendText('CREC', '4')
+        return l_result
+
+    def readScope(self):
+        """Dump the frozen capture of the signal scope ('SCOP' key), the future gives the header of the capture and the frames in
+        time order, each frame is a tuple of the raw values of the captured channels. The key is served on the bulk interface."""
+        l_result = Future()
+        l_frames = []
+
+        def onData(f_payload, f_stamp):
+            l_header = SScopeHeader.unpack(f_payload)
+            l_offset = SScopeHeader.s_struct.size
+            l_channels = bin(l_header.m_channels).count('1')
+            l_frame = struct.Struct('<%dh' % l_channels)
+            for _ in range(l_header.m_count):
+                l_frames.append(l_frame.unpack_from(f_payload, l_offset))
+                l_offset += l_frame.size
+            if len(l_frames) >= l_header.m_total:
+                self.m_binaryListeners[BIN_SCOPE_CAPTURE].remove(onData)
+                l_result.set_result((l_header, l_frames))
+
+        self.m_binaryListeners[BIN_SCOPE_CAPTURE].append(onData)
+        self.sendText('SCOP', '4')
+        return l_result
+
+    def replayCommands(self, f_entries, f_speed=1.0):
+        """Send the recorded entries with their original spacing (divided by f_speed), it blocks until the last one. The responses
+        aren't matched, they are passed to the listeners."""
+        import time
+        if not f_entries:
+            return
+        l_first = f_entries[0][0]
+        l_start = time.monotonic()
+        for l_timestamp, l_kind, l_data in f_entries:
+            l_delay = ((l_timestamp - l_first) & 0xFFFFFFFF) / 1.0e6 / f_speed - (time.monotonic() - l_start)
+            if l_delay > 0:
+                time.sleep(l_delay)
+            if l_kind == 0:
+                l_frame = l_data + b'\n'
+            else:
+                l_frame = encodeFrame(l_data[0], l_data[2:], l_kind == 2)
+            with self.m_lock:
+                self.m_port.write(l_frame)
+
+    def flashFirmware(self, f_image, f_apply=True, f_timeout=5.0, f_retries=500):
+        """Update the firmware (the bytes of the .bin image) by the update messages, it blocks until the end and it returns the number
+        of the sent blocks. Each block is the longest part of the image (a multiple of four bytes, at most 1024), whose LZ4
+        compression fits in a frame. The refused blocks (busy buffers or staging sector, corrupted block) are sent again. With
+        f_apply the board installs the image and it resets, the link has to be opened again."""
+        import time
+        import zlib
+        l_size = SUpdateBlockHeader.s_struct.size
+
+        def request(f_id, f_payload):
+            for _ in range(f_retries):
+                l_status = self.sendBinary(f_id, f_payload).result(f_timeout)
+                if l_status not in (BIN_QUEUE_FULL, BIN_SYNTAX_ERROR):
+                    return l_status
+                time.sleep(0.005)
+            raise IOError('firmware update: no progress')
+
+        def check(f_status, f_what):
+            if f_status != BIN_ACK:
+                raise IOError('firmware update: %s refused (%s)' % (f_what, STATUS_NAMES.get(f_status, 'error')))
+
+        check(request(BIN_UPDATE_BEGIN, SUpdateBeginPayload(len(f_image), zlib.crc32(f_image) & 0xFFFFFFFF).pack()), 'begin')
+        l_offset = 0
+        l_blocks = 0
+        while l_offset < len(f_image):
+            l_remaining = len(f_image) - l_offset
+            # The longest block, whose compression fits; the compressed length grows almost monotonically with the block
+            l_low, l_high = 1, 256
+            l_best = None
+            while l_low <= l_high:
+                l_length = min(4 * ((l_low + l_high) // 2), l_remaining)
+                l_packed = lz4Compress(f_image[l_offset:l_offset + l_length])
+                if len(l_packed) + l_size <= MAX_PAYLOAD:
+                    l_best = (l_length, l_packed)
+                    if l_length == l_remaining:
+                        break
+                    l_low = (l_low + l_high) // 2 + 1
+                else:
+                    l_high = (l_low + l_high) // 2 - 1
+            l_length, l_packed = l_best
+            l_data = f_image[l_offset:l_offset + l_length]
+            l_header = SUpdateBlockHeader(l_offset, l_length, crc16(l_data)).pack()
+            check(request(BIN_UPDATE_BLOCK, l_header + l_packed), 'block at %d' % l_offset)
+            l_offset += l_length
+            l_blocks += 1
+        check(request(BIN_UPDATE_END, SUpdateEndPayload(1 if f_apply else 0).pack()), 'end')
+        return l_blocks
+
+    def stepExperiment(self, f_base, f_amplitude, f_duration, f_count):
+        """Score the speed controller by a step experiment ('EXPS' key), the robot has to move with the activated pid controller. The
+        future gives the '@EXPR' record as a dict (iae, ise, rise, overshoot, settling, steady, steps, unsettled)."""
+        return self._experiment('EXPS', '%g;%g;%g;%d' % (f_base, f_amplitude, f_duration, f_count))
+
+    def sweepExperiment(self, f_base, f_amplitude, f_duration, f_startFrequency, f_endFrequency):
+        """Score the speed controller by a sine sweep ('EXPW' key), only iae and ise of the record are valid."""
+        return self._experiment('EXPW', '%g;%g;%g;%g;%g' % (f_base, f_amplitude, f_duration, f_startFrequency, f_endFrequency))
+
+    def _experiment(self, f_key, f_content):
+        l_result = Future()
+        l_names = ('iae', 'ise', 'rise', 'overshoot', 'settling', 'steady', 'steps', 'unsettled')
+
+        def onRecord(f_content, f_stamp):
+            self.m_textListeners['EXPR'].remove(onRecord)
+            l_fields = [l_field for l_field in f_content.split(';') if l_field]
+            if len(l_fields) != len(l_names):
+                l_result.set_exception(IOError('experiment %s' % f_content.rstrip(';')))
+            else:
+                l_result.set_result({l_name: float(l_value) for l_name, l_value in zip(l_names, l_fields)})
+
+        def onAck(f_response):
+            if f_response.result() != 'ack':
+                self.m_textListeners['EXPR'].remove(onRecord)
+                l_result.set_exception(IOError('experiment refused: %s' % f_response.result()))
+
+        self.m_textListeners['EXPR'].append(onRecord)
+        self.sendText(f_key, f_content).add_done_callback(onAck)
+        return l_result
+
+    def setFlowControl(self, f_mode):
+        """Set the flow control of the board receiver ('BNCH' key): 0 none, 1 RTS, 2 XON/XOFF. The XON/XOFF characters are
+        always honoured by the client."""
+        return self.sendText('BNCH', '6;%d' % f_mode)
+
+    def linkErrors(self):
+        """Future of the link errors of the board receiver as a dict."""
+        l_names = ('rxHigh', 'parseHigh', 'overruns', 'framing', 'noise', 'overflows', 'lost', 'throttled', 'flow', 'superseded', 'estops')
+        l_result = Future()
+
+        def onResponse(f_response):
+            l_fields = [l_field for l_field in f_response.result().split(';') if l_field]
+            if len(l_fields) != len(l_names):
+                l_result.set_exception(IOError('link errors %s' % f_response.result()))
+            else:
+                l_result.set_result({l_name: int(l_value) for l_name, l_value in zip(l_names, l_fields)})
+
+        self.sendText('BNCH', '5').add_done_callback(onResponse)
+        return l_result
+
+    def onText(self, f_key, f_listener):
+        """Listener of the unsolicited text lines of a key, f_listener(content, stamp). The events of the event log are formatted
+        and passed to the listeners of their key with the board time of the event as stamp."""
+        self.m_textListeners[f_key].append(f_listener)
+
+    def onBinary(self, f_id, f_listener):
+        """Listener of the published binary frames, f_listener(payload, stamp), the payload is valid only in the call."""
+        self.m_binaryListeners[f_id].append(f_listener)
+
+    def onTelemetry(self, f_listener):
+        """Listener of the decoded telemetry batches (CTelemetryBatch)."""
+        self.onBinary(BIN_TELEMETRY, lambda f_payload, f_stamp: f_listener(CTelemetryBatch(f_payload, False)))
+        self.onBinary(BIN_TELEMETRY_PACKED, lambda f_payload, f_stamp: f_listener(CTelemetryBatch(f_payload, True)))
+
+    def _send(self, f_match, f_frame, f_response):
+        l_future = Future()
+        with self.m_writeLock:
+            # A lost XON doesn't block the link, the sending resumes after the timeout
+            self.m_resumed.wait(FLOW_TIMEOUT)
+            with self.m_lock:
+                self.m_sequence += 1
+                if f_response:
+                    self.m_pending[f_match].append((self.m_sequence, l_future))
+                else:
+                    l_future.set_result(None)
+                self.m_port.write(f_frame)
+        return l_future
+
+    def _resolve(self, f_match, f_value):
+        with self.m_lock:
+            l_queue = self.m_pending.get(f_match)
+            if not l_queue:
+                return False
+            _, l_future = l_queue.popleft()
+        l_future.set_result(f_value)
+        return True
+
+    def _read(self):
+        while self.m_running:
+            l_data = self.m_port.read(max(1, self.m_port.in_waiting))
+            if not l_data:
+                continue
+            for l_frame in self.m_parser.feed(l_data):
+                if l_frame[0] == 'flow':
+                    if l_frame[1]:
+                        self.m_resumed.clear()
+                    else:
+                        self.m_resumed.set()
+                    continue
+                if l_frame[0] == 'text':
+                    _, l_key, l_content, l_stamp = l_frame
+                    if not self._resolve(('text', l_key), l_content[:-2] if l_content.endswith(';;') else l_content):
+                        for l_listener in self.m_textListeners[l_key]:
+                            l_listener(l_content, l_stamp)
+                    continue
+                _, l_id, l_payload, l_stamp = l_frame
+                if l_id & RESPONSE_FLAG:
+                    self._resolve(('binary', l_id & ~RESPONSE_FLAG), l_payload[0] if len(l_payload) else None)
+                    continue
+                if l_id == BIN_EVENT_LOG:
+                    l_dropped, l_events = decodeEvents(l_payload)
+                    self.m_droppedEvents += l_dropped
+                    for l_time, l_line in l_events:
+                        for l_listener in self.m_textListeners[l_line[1:5]]:
+                            l_listener(l_line[6:], l_time)
+                for l_listener in list(self.m_binaryListeners[l_id]):
+                    l_listener(l_payload, l_stamp)
@@ -0,0 +1,260 @@
+"""Identifiers, status codes and payload codecs of the board protocol.
+
+It's generated by protocolGenerator.py from protocol/protocol.json, don't edit it.
+"""
+import collections
+import struct
+
+
+class CPayload(object):
+    """Common methods of the payloads, the fields follow the packed little-endian layout of the board."""
+    __slots__ = ()
+
+    def pack(self):
+        return self.s_struct.pack(*self)
+
+    @classmethod
+    def unpack(cls, f_data, f_offset=0):
+        return cls._make(cls.s_struct.unpack_from(f_data, f_offset))
+
+    def validate(self):
+        """One-based index of the first field out of its range, zero, when all fields are valid."""
+        for i, l_name in enumerate(self._fields):
+            l_range = self.s_ranges.get(l_name)
+            if l_range is not None and not l_range[0] <= getattr(self, l_name) <= l_range[1]:
+                return i + 1
+        return 0
+
+
+# Identifiers of the binary messages. The responses have the same identifier with the highest bit set.
+BIN_MOVE = 0x01
+BIN_BRAKE = 0x02
+BIN_PID_ACTIVATION = 0x03
+BIN_ENCODER_PUBLISH = 0x04
+BIN_TELEMETRY_SUBSCRIBE = 0x05
+BIN_ODOMETRY_PUBLISH = 0x06
+BIN_PUBLISHER_SUBSCRIBE = 0x07
+BIN_REGISTER_READ = 0x08
+BIN_REGISTER_WRITE = 0x09
+BIN_UPDATE_BEGIN = 0x0A
+BIN_UPDATE_BLOCK = 0x0B
+BIN_UPDATE_END = 0x0C
+BIN_EMERGENCY_STOP = 0x0D
+BIN_ENCODER_SPEED = 0x40
+BIN_TELEMETRY = 0x41
+BIN_ODOMETRY = 0x42
+BIN_PUBLISH = 0x43
+BIN_FLIGHT_RECORD = 0x44
+BIN_PROFILE = 0x45
+BIN_REGISTER_DATA = 0x46
+BIN_TELEMETRY_PACKED = 0x47
+BIN_COMMAND_RECORD = 0x48
+BIN_SCOPE_CAPTURE = 0x49
+BIN_EVENT_LOG = 0x4A
+
+# Status codes of the binary responses
+BIN_ACK = 0
+BIN_SYNTAX_ERROR = 1
+BIN_SPEED_RANGE = 2
+BIN_REFERENCE_RANGE = 3
+BIN_ANGLE_RANGE = 4
+BIN_NOT_AVAILABLE = 5
+BIN_VALUE_RANGE = 6
+BIN_QUEUE_FULL = 7
+BIN_UPDATE_FAILED = 8
+BIN_SUPERSEDED = 9
+
+
+class SMovePayload(CPayload, collections.namedtuple('SMovePayload', ['m_speed', 'm_angle'])):
+    """Payload of the move command"""
+    __slots__ = ()
+    s_struct = struct.Struct('<ff')
+    s_ranges = {'m_speed': (-100.0, 100.0), 'm_angle': (-90.0, 90.0)}
+
+
+class SBrakePayload(CPayload, collections.namedtuple('SBrakePayload', ['m_angle'])):
+    """Payload of the brake command"""
+    __slots__ = ()
+    s_struct = struct.Struct('<f')
+    s_ranges = {'m_angle': (-90.0, 90.0)}
+
+
+class SActivationPayload(CPayload, collections.namedtuple('SActivationPayload', ['m_activate'])):
+    """Payload of the activation commands"""
+    __slots__ = ()
+    s_struct = struct.Struct('<B')
+    s_ranges = {}
+
+
+class SEncoderSpeedPayload(CPayload, collections.namedtuple('SEncoderSpeedPayload', ['m_rps'])):
+    """Payload of the published encoder speed"""
+    __slots__ = ()
+    s_struct = struct.Struct('<f')
+    s_ranges = {}
+
+
+class SOdometryPayload(CPayload, collections.namedtuple('SOdometryPayload', ['m_timestamp', 'm_x', 'm_y', 'm_yaw', 'm_speed'])):
+    """Payload of the published odometry pose"""
+    __slots__ = ()
+    s_struct = struct.Struct('<Iffff')
+    s_ranges = {}
+
+
+class SPublisherSubscribePayload(CPayload, collections.namedtuple('SPublisherSubscribePayload', ['m_mask'])):
+    """Payload of the publisher group subscription command"""
+    __slots__ = ()
+    s_struct = struct.Struct('<I')
+    s_ranges = {}
+
+
+class SRegisterHeader(CPayload, collections.namedtuple('SRegisterHeader', ['m_address', 'm_count'])):
+    """Header of the register range, in the write and data frames it's followed by 'm_count' 32-bit little-endian values"""
+    __slots__ = ()
+    s_struct = struct.Struct('<HB')
+    s_ranges = {}
+
+
+class STelemetrySubscribePayload(CPayload, collections.namedtuple('STelemetrySubscribePayload', ['m_signalMask', 'm_decimation', 'm_aggregation'])):
+    """Payload of the telemetry subscription command"""
+    __slots__ = ()
+    s_struct = struct.Struct('<BHH')
+    s_ranges = {}
+
+
+class STelemetryHeader(CPayload, collections.namedtuple('STelemetryHeader', ['m_sequence', 'm_timestamp', 'm_interval', 'm_signalCount', 'm_signalMask', 'm_sampleCount'])):
+    """Header of the telemetry batch, it's followed by 'm_sampleCount' samples, each sample contains 'm_signalCount' float values. In the BIN_TELEMETRY_PACKED batch the header is followed by an encoding code of each signal (mode in the upper, decimals in the lower nibble), then by the samples, where the delta encoded values are zigzag varints."""
+    __slots__ = ()
+    s_struct = struct.Struct('<HIHBBB')
+    s_ranges = {}
+
+
+class SFlightRecord(CPayload, collections.namedtuple('SFlightRecord', ['m_timestamp', 'm_reference', 'm_speed', 'm_error', 'm_pwm', 'm_steering', 'm_state', 'm_flags'])):
+    """Record of the flight recorder, the values of one control tick in fixed point"""
+    __slots__ = ()
+    s_struct = struct.Struct('<IhhhhhBB')
+    s_ranges = {}
+
+
+class SFlightRecordHeader(CPayload, collections.namedtuple('SFlightRecordHeader', ['m_first', 'm_total', 'm_trigger', 'm_count'])):
+    """Header of the dumped records, it's followed by 'm_count' records in time order."""
+    __slots__ = ()
+    s_struct = struct.Struct('<HHBB')
+    s_ranges = {}
+
+
+class SCommandEntry(CPayload, collections.namedtuple('SCommandEntry', ['m_timestamp', 'm_kind', 'm_length'])):
+    """Header of an entry of the command recorder, it's followed by 'm_length' bytes of the frame: the text frame from '#' without '\n', or the identifier, the length and the payload of a binary frame."""
+    __slots__ = ()
+    s_struct = struct.Struct('<IBB')
+    s_ranges = {}
+
+
+class SCommandRecordHeader(CPayload, collections.namedtuple('SCommandRecordHeader', ['m_first', 'm_total', 'm_count'])):
+    """Header of the dumped command entries, it's followed by 'm_count' entries (SCommandEntry and its bytes) in time order."""
+    __slots__ = ()
+    s_struct = struct.Struct('<HHB')
+    s_ranges = {}
+
+
+class SScopeHeader(CPayload, collections.namedtuple('SScopeHeader', ['m_first', 'm_total', 'm_trigger', 'm_frequency', 'm_cause', 'm_channels', 'm_count'])):
+    """Header of the dumped scope capture, it's followed by 'm_count' frames in time order, each frame contains 'm_channels' int16_t samples."""
+    __slots__ = ()
+    s_struct = struct.Struct('<HHHIBBB')
+    s_ranges = {}
+
+
+class SProfileHeader(CPayload, collections.namedtuple('SProfileHeader', ['m_base', 'm_samples', 'm_outside', 'm_first', 'm_total', 'm_shift', 'm_count'])):
+    """Header of the dumped profile, it's followed by 'm_count' counters (uint32_t) of the consecutive buckets."""
+    __slots__ = ()
+    s_struct = struct.Struct('<IIIHHBB')
+    s_ranges = {}
+
+
+class SUpdateBeginPayload(CPayload, collections.namedtuple('SUpdateBeginPayload', ['m_size', 'm_crc'])):
+    """Payload of the start of the firmware update"""
+    __slots__ = ()
+    s_struct = struct.Struct('<II')
+    s_ranges = {}
+
+
+class SUpdateBlockHeader(CPayload, collections.namedtuple('SUpdateBlockHeader', ['m_offset', 'm_length', 'm_crc'])):
+    """Header of the firmware block, it's followed by the LZ4 compressed block (without frame) of 'm_length' bytes. The length is a multiple of four except the last block."""
+    __slots__ = ()
+    s_struct = struct.Struct('<IHH')
+    s_ranges = {}
+
+
+class SUpdateEndPayload(CPayload, collections.namedtuple('SUpdateEndPayload', ['m_apply'])):
+    """Payload of the end of the firmware update"""
+    __slots__ = ()
+    s_struct = struct.Struct('<B')
+    s_ranges = {}
+
+
+class SEventLogHeader(CPayload, collections.namedtuple('SEventLogHeader', ['m_dropped', 'm_count'])):
+    """Header of a batch of logged events, it's followed by 'm_count' records in time order."""
+    __slots__ = ()
+    s_struct = struct.Struct('<HB')
+    s_ranges = {}
+
+
+class SEventRecord(CPayload, collections.namedtuple('SEventRecord', ['m_timestamp', 'm_id', 'm_length'])):
+    """Header of a logged event, it's followed by 'm_length' bytes of the raw arguments in the order of the event definition."""
+    __slots__ = ()
+    s_struct = struct.Struct('<IHB')
+    s_ranges = {}
+
+
+# Payload of each message identifier
+PAYLOADS = {
+    BIN_MOVE: SMovePayload,
+    BIN_BRAKE: SBrakePayload,
+    BIN_PID_ACTIVATION: SActivationPayload,
+    BIN_ENCODER_PUBLISH: SActivationPayload,
+    BIN_TELEMETRY_SUBSCRIBE: STelemetrySubscribePayload,
+    BIN_ODOMETRY_PUBLISH: SActivationPayload,
+    BIN_PUBLISHER_SUBSCRIBE: SPublisherSubscribePayload,
+    BIN_REGISTER_READ: SRegisterHeader,
+    BIN_REGISTER_WRITE: SRegisterHeader,
+    BIN_UPDATE_BEGIN: SUpdateBeginPayload,
+    BIN_UPDATE_BLOCK: SUpdateBlockHeader,
+    BIN_UPDATE_END: SUpdateEndPayload,
+    BIN_ENCODER_SPEED: SEncoderSpeedPayload,
+    BIN_TELEMETRY: STelemetryHeader,
+    BIN_ODOMETRY: SOdometryPayload,
+    BIN_FLIGHT_RECORD: SFlightRecordHeader,
+    BIN_PROFILE: SProfileHeader,
+    BIN_REGISTER_DATA: SRegisterHeader,
+    BIN_TELEMETRY_PACKED: STelemetryHeader,
+    BIN_COMMAND_RECORD: SCommandRecordHeader,
+    BIN_SCOPE_CAPTURE: SScopeHeader,
+    BIN_EVENT_LOG: SEventLogHeader,
+}
+
+# Names of the status codes
+STATUS_NAMES = {
+    BIN_ACK: 'ack',
+    BIN_SYNTAX_ERROR: 'syntax error',
+    BIN_SPEED_RANGE: 'speed range',
+    BIN_REFERENCE_RANGE: 'reference range',
+    BIN_ANGLE_RANGE: 'angle range',
+    BIN_NOT_AVAILABLE: 'not available',
+    BIN_VALUE_RANGE: 'value range',
+    BIN_QUEUE_FULL: 'queue full',
+    BIN_UPDATE_FAILED: 'update failed',
+    BIN_SUPERSEDED: 'superseded',
+}
+
+
+# Log events: identifier -> (name, format string, names of the arguments, layout of the arguments)
+LOG_EVENTS = {
+    1: ('LOG_EMERGENCY_STOP', '@ESTP:stop;;', (), struct.Struct('<')),
+    2: ('LOG_AUTOTUNE_RESULT', '@ATUN:{kp:.5f};{ki:.5f};{kd:.6f};{tf:.5f};;', ('kp', 'ki', 'kd', 'tf'), struct.Struct('<ffff')),
+    3: ('LOG_AUTOTUNE_FAILED', '@ATUN:failed;;', (), struct.Struct('<')),
+    4: ('LOG_EXPERIMENT_ABORTED', '@EXPR:aborted;;', (), struct.Struct('<')),
+    5: ('LOG_PATH_REACHED', '@PATH:reached;;', (), struct.Struct('<')),
+    6: ('LOG_DISTANCE_REACHED', '@DIST:reached;;', (), struct.Struct('<')),
+    7: ('LOG_HIGH_SPEED', '@PIDA:Too high speed and the encoder working;;', (), struct.Struct('<')),
+    8: ('LOG_ENCODER_ERROR', '@PIDA:Encoder error;;', (), struct.Struct('<')),
+    9: ('LOG_SCHEDULE_REJECTED', '@SCHD:rejected;{time};;', ('time',), struct.Struct('<I')),
+}
@@ -0,0 +1,148 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ControlLoop.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the control loop driven by hardware timer.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CONTROL_LOOP_HPP
+#define CONTROL_LOOP_HPP
+
+#include <mbed.h>
+#include <rtos.h>
+#include <hardware/drivers/controltimer.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace brain{
+
+   /**
+    * @brief Hard real-time control loop, it's applied by the update interrupt of a hardware timer. 
+    * 
+    * In each period it applies one tick of the pipeline: it samples the encoder and applies its filter, then it applies the state machine 
+    * (pid controller, converter and pwm output) and at the end it samples the telemetry signals, in one deterministic sequence with fixed phase. 
+    * It replaces the own timers of the encoder and of the state machine, so their periods have to be equal to the period of the loop. 
+    * 
+    * In the thread mode the interrupt only wakes up a dedicated thread with the highest RTOS priority by a signal, and the tick is applied 
+    * by the thread. So the pipeline preempts all threads (serial monitor, task classes, main), but the interrupts of the peripherals 
+    * (serial DMA, ADC watchdog) aren't blocked during the tick. A period, in which the thread didn't finish the previous tick, is counted 
+    * as an overrun and it's skipped.
+    * 
+    * A tick, whose duration exceeds the deadline (a part of the period, the whole period by default), is counted as a missed deadline, 
+    * so the overload is detected before the periods are skipped. The counters are used by the load shedding (CLoadShedder).
+    */
+    class CControlLoop
+    {
+    public:
+        /** @brief  Context of the ticks */
+        enum EMode{
+            /** @brief  The tick is applied by the interrupt of the timer */
+            INTERRUPT,
+            /** @brief  The tick is applied by the control thread, the interrupt wakes it up */
+            THREAD
+        };
+        /* Constructor */
+        CControlLoop(hardware::drivers::CControlTimer_TIM10&    f_timer
+                    ,float                                     f_period_sec
+                    ,utils::pipeline::IPipeline&               f_pipeline
+                    ,EMode                                     f_mode = INTERRUPT
+                    ,uint32_t                                  f_stackSize = s_defaultStackSize
+                    ,unsigned char*                            f_stackMemory = NULL);
+        /* Start the control loop */
+        bool start();
+        /* Stop the control loop */
+        void stop();
+        /* Cycles spent in the loop since the previous call */
+        uint32_t takeBusyCycles();
+        /** @brief  Maximum cycles of one period */
+        uint32_t getMaxCycles()
+        {
+            return m_maxCycles;
+        }
+        /** @brief  Number of the skipped periods in the thread mode */
+        uint32_t getOverruns()
+        {
+            return m_overruns;
+        }
+        /* Set the deadline of the tick */
+        void setDeadline(float f_ratio);
+        /** @brief  Deadline of the tick in cpu cycles */
+        uint32_t getDeadlineCycles() const
+        {
+            return m_deadlineCycles;
+        }
+        /** @brief  Number of the ticks, which exceeded the deadline */
+        uint32_t getDeadlineMisses() const
+        {
+            return m_deadlineMisses;
+        }
+        /** @brief  Cycles of the last tick */
+        uint32_t getLastCycles() const
+        {
+            return m_lastCycles;
+        }
+        /** @brief  Control thread, it's used by the memory report */
+        Thread* getThread()
+        {
+            return &m_thread;
+        }
+        /** @brief  Default stack size of the control thread in bytes */
+        static const uint32_t s_defaultStackSize = 2048;
+    private:
+        /* One period of the control loop, it's applied from interrupt or from the control thread */
+        void step();
+        /* Interrupt of the thread mode, it wakes up the control thread */
+        void wakeUp();
+        /* Function of the control thread */
+        static void controlThread(CControlLoop* f_loop);
+
+        /** @brief  Signal of the period */
+        static const int32_t s_tickSignal = 0x1;
+
+        /** @brief  Hardware timer */
+        hardware::drivers::CControlTimer_TIM10& m_timer;
+        /** @brief  Period in second */
+        const float m_period_sec;
+        /** @brief  Pipeline of the stages */
+        utils::pipeline::IPipeline& m_pipeline;
+        /** @brief  Cycles spent in the loop since the last query */
+        volatile uint32_t m_busyCycles;
+        /** @brief  Maximum cycles of one period */
+        volatile uint32_t m_maxCycles;
+        /** @brief  Context of the ticks */
+        const EMode m_mode;
+        /** @brief  Control thread of the thread mode */
+        Thread m_thread;
+        /** @brief  Identifier of the control thread, NULL until it's running */
+        osThreadId volatile m_threadId;
+        /** @brief  The control thread applies a tick */
+        volatile bool m_isBusy;
+        /** @brief  Number of the skipped periods */
+        volatile uint32_t m_overruns;
+        /** @brief  Deadline of the tick in cpu cycles */
+        uint32_t m_deadlineCycles;
+        /** @brief  Number of the ticks, which exceeded the deadline */
+        volatile uint32_t m_deadlineMisses;
+        /** @brief  Cycles of the last tick */
+        volatile uint32_t m_lastCycles;
+    };
+
+}; // namespace brain
+
+#endif // CONTROL_LOOP_HPP
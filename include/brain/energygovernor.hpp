@@ -0,0 +1,145 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    EnergyGovernor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the energy-aware
+  *          limits of the speed and of the acceleration (eco driving).
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ENERGY_GOVERNOR_HPP
+#define ENERGY_GOVERNOR_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <hardware/sampling/batterymonitor.hpp>
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <signal/systemmodels/recursiveleastsquares.hpp>
+
+namespace brain{
+
+   /**
+    * @brief Energy governor of the eco driving, it limits the reference speed and the acceleration of the move state, so the remaining
+    * energy of the battery lasts for the remaining time of the run.
+    *
+    * The power drawn from the battery is learned online by a recursive least squares estimator of the model
+    *  P = theta0 + theta1*v + theta2*v^2 + theta3*v*a+ (a+ is the positive acceleration),
+    * the constant term contains the consumption of the electronics, the linear and the quadratic terms the rolling and the drag losses,
+    * the last term the kinetic power. The allowed mean power is the usable energy (state of charge above the reserve, times the nominal
+    * energy of the pack) divided by the remaining time of the run given by the host. The speed cap is the speed of the model at the
+    * allowed power at constant speed, the acceleration cap uses the peak factor of the allowed power over the consumption at the current
+    * speed. When the measured power is above the peak, the acceleration is limited at its minimum. The caps aren't applied, until the
+    * model has enough updates.
+    *
+    * Commands of the 'ECOD' key: '0' state ('active;speed cap m/s;accel cap m/s2;allowed power W;remaining s;updates;;'),
+    * '1;active', '2;remaining time s;reserve'.
+    */
+    class CEnergyGovernor: public utils::task::CTask
+    {
+    public:
+        /* Constructor */
+        CEnergyGovernor(uint32_t                                f_period
+                       ,float                                   f_period_sec
+                       ,const hardware::sampling::CBatteryMonitor& f_battery
+                       ,hardware::encoders::IEncoderGetter&     f_encoder
+                       ,float                                   f_metersPerRotation
+                       ,uint8_t                                 f_cells
+                       ,float                                   f_capacity
+                       ,float                                   f_maxSpeed
+                       ,float                                   f_maxAcceleration);
+        /* Activate or deactivate the limits */
+        void setActive(bool f_active);
+        /* Set the remaining time of the run and the reserve of the state of charge */
+        void setBudget(float f_remaining, float f_reserve);
+        /** @brief  The limits are applied */
+        bool isActive() const
+        {
+            return m_isActive && m_isValid;
+        }
+        /** @brief  Cap of the reference speed in meter per second */
+        float getSpeedCap() const
+        {
+            return m_speedCap;
+        }
+        /** @brief  Cap of the acceleration in meter per square second */
+        float getAccelerationCap() const
+        {
+            return m_accelerationCap;
+        }
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, it updates the model and the limits */
+        virtual void _run();
+
+        /** @brief  Estimator of the power model */
+        typedef signal::systemmodels::CRecursiveLeastSquares<float,4> CEstimator;
+
+        /** @brief  Nominal voltage of a cell in volt */
+        static constexpr float s_cellVoltage = 3.7f;
+        /** @brief  Updates of the model, before the limits are applied */
+        static const uint32_t s_minUpdates = 200;
+        /** @brief  Minimum speed of the acceleration cap in meter per second */
+        static constexpr float s_minSpeed = 0.2f;
+        /** @brief  Minimum acceleration cap in meter per square second */
+        static constexpr float s_minAcceleration = 0.1f;
+        /** @brief  Peak of the power relative to the allowed mean power */
+        static constexpr float s_peakFactor = 2.0f;
+        /** @brief  Filter coefficient of the acceleration */
+        static constexpr float s_accelerationFilter = 0.2f;
+
+        /** @brief  Period in second */
+        const float m_period;
+        /** @brief  Battery monitor */
+        const hardware::sampling::CBatteryMonitor& m_battery;
+        /** @brief  Encoder of the motor */
+        hardware::encoders::IEncoderGetter& m_encoder;
+        /** @brief  Meters per rotation of the encoder */
+        const float m_metersPerRotation;
+        /** @brief  Nominal energy of the full pack in watt hour */
+        const float m_nominalEnergy;
+        /** @brief  Maximum speed in meter per second */
+        const float m_maxSpeed;
+        /** @brief  Maximum acceleration in meter per square second */
+        const float m_maxAcceleration;
+        /** @brief  Estimator of the power model */
+        CEstimator m_estimator;
+        /** @brief  The limits are activated */
+        volatile bool m_isActive;
+        /** @brief  The model has enough updates */
+        volatile bool m_isValid;
+        /** @brief  Remaining time of the run in second */
+        float m_remaining;
+        /** @brief  Reserve of the state of charge in interval [0,1] */
+        float m_reserve;
+        /** @brief  Speed of the previous period */
+        float m_lastSpeed;
+        /** @brief  Filtered acceleration */
+        float m_acceleration;
+        /** @brief  Allowed mean power in watt */
+        float m_allowedPower;
+        /** @brief  Cap of the speed */
+        volatile float m_speedCap;
+        /** @brief  Cap of the acceleration */
+        volatile float m_accelerationCap;
+    };
+
+}; // namespace brain
+
+#endif // ENERGY_GOVERNOR_HPP
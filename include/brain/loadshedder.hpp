@@ -0,0 +1,121 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    LoadShedder.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the load shedding of the control pipeline.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef LOAD_SHEDDER_HPP
+#define LOAD_SHEDDER_HPP
+
+#include <mbed.h>
+#include <brain/controlloop.hpp>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+
+namespace brain{
+
+   /**
+    * @brief Load shedding of the control pipeline, the optional stages are disabled on repeated overload and enabled again, when the load drops.
+    *
+    * The stage counts the missed deadlines and the skipped periods of the control loop in windows of ticks. A window with at least
+    * the given number of misses disables the next optional stage in the order of the list (the first one is the least important),
+    * each window can disable one stage. When the windows are free of misses and the longest tick is below the restore ratio of the
+    * deadline for a number of consecutive windows, the last disabled stage is enabled again. So the stages aren't switched in each window
+    * at the border of the overload. The stage is applied at the end of the pipeline, the task reports the transitions ('@SHED:level;stage;;').
+    */
+    class CLoadShedder: public utils::pipeline::IPipelineStage, public utils::task::CTask
+    {
+    public:
+        /** @brief  Optional stage */
+        struct SStage{
+            /** @brief name of the stage in the reports */
+            const char* m_name;
+            /** @brief switch of the stage */
+            utils::pipeline::IStageGate* m_gate;
+        };
+
+        /* Constructor */
+        CLoadShedder(uint32_t                              f_period
+                    ,CControlLoop&                         f_loop
+                    ,const SStage*                         f_stages
+                    ,uint8_t                               f_stageCount
+                    ,utils::serial::CSerialTransmitter&    f_serial
+                    ,uint32_t                              f_windowTicks
+                    ,uint32_t                              f_shedMisses
+                    ,float                                 f_restoreRatio
+                    ,uint32_t                              f_restoreWindows);
+        /* Pipeline stage, it evaluates the windows */
+        virtual void process(uint32_t f_timestamp);
+        /* Enable or disable the shedding */
+        void setEnabled(bool f_enabled);
+        /** @brief  Number of the disabled stages */
+        uint8_t getLevel() const
+        {
+            return m_level;
+        }
+        /* Serial callback of the shedding */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, it reports the transitions */
+        void _run();
+
+        /** @brief  Control loop */
+        CControlLoop& m_loop;
+        /** @brief  Optional stages, the first one is disabled first */
+        const SStage* m_stages;
+        /** @brief  Number of the optional stages */
+        const uint8_t m_stageCount;
+        /** @brief  Transmitter of the reports */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Number of the ticks in a window */
+        const uint32_t m_windowTicks;
+        /** @brief  Number of the misses in a window, which disables a stage */
+        const uint32_t m_shedMisses;
+        /** @brief  The longest tick of a calm window is below this ratio of the deadline */
+        const float m_restoreRatio;
+        /** @brief  Number of the calm windows, which enable a stage */
+        const uint32_t m_restoreWindows;
+        /** @brief  The shedding is enabled */
+        volatile bool m_enabled;
+        /** @brief  Number of the disabled stages */
+        volatile uint8_t m_level;
+        /** @brief  Misses of the loop at the previous tick */
+        uint32_t m_lastMisses;
+        /** @brief  Ticks of the current window */
+        uint32_t m_ticks;
+        /** @brief  Misses of the current window */
+        uint32_t m_misses;
+        /** @brief  Longest tick of the current window in cpu cycles */
+        uint32_t m_maxCycles;
+        /** @brief  Number of the consecutive calm windows */
+        uint32_t m_calmWindows;
+        /** @brief  Number of the transitions */
+        volatile uint32_t m_transitions;
+        /** @brief  Number of the reported transitions */
+        uint32_t m_reported;
+        /** @brief  Index of the stage of the last transition */
+        volatile uint8_t m_lastStage;
+    };
+
+}; // namespace brain
+
+#endif // LOAD_SHEDDER_HPP
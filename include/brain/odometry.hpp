@@ -0,0 +1,167 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Odometry.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the on-board odometry.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ODOMETRY_HPP
+#define ODOMETRY_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <signal/systemmodels/systemmodels.hpp>
+#include <signal/systemmodels/steeringgeometry.hpp>
+#include <hardware/imu/mpu6050.hpp>
+#include <signal/filter/attitude.hpp>
+#include <utils/sync/latest.hpp>
+
+namespace brain{
+
+   /**
+    * @brief On-board odometry, it integrates the pose of the robot by the kinematic bicycle model in each tick of the control loop.
+    * 
+    * The travelled distance is derived from the accumulated position of the encoder, so the lost or filtered samples don't cause drift, 
+    * and the steering angle is the last angle applied to the servo motor. The pipeline stage integrates the pose [x, y, yaw] at the 
+    * control rate, the task publishes the last pose at its own period, in text ("@ODOM:x;y;yaw;v;;") or in binary frames (utils::serial::BIN_ODOMETRY).
+    * When an inertial sensor is attached, the yaw is integrated by the angular rate of its samples (z axis upward) instead of the steering model, and the 
+    * bias of the gyroscope and of the longitudinal acceleration (x axis forward) is estimated while the encoder doesn't move. The samples arrive in batches, so the yaw follows with the latency of a batch.
+    * With an attitude filter the batches are processed in blocks by the filter and the change of its tilt compensated heading is added to the yaw.
+    * The reference point is the rear axle, the yaw is counter-clockwise and it's wrapped in [-pi, pi], the curvature of the steering angle is given by the shared steering geometry.
+    * The pose and the reset request are exchanged between the control loop and the serial threads by double buffered latest values, so the publisher 
+    * and the control loop don't block each other.
+    */
+    class COdometry: public utils::task::CTask, public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Getter of the accumulated position of the encoder in impulses */
+        typedef mbed::Callback<int64_t()> FPositionGetter;
+        /** @brief  Getter of the applied steering angle in degree */
+        typedef mbed::Callback<float()> FAngleGetter;
+        /** @brief  Reader of the inertial samples, it returns false, when the queue is empty */
+        typedef mbed::Callback<bool(hardware::imu::SImuSample&)> FImuReader;
+        /** @brief  Kinematic model of the integration */
+        typedef signal::systemmodels::nlti::mimo::CKinematicBicycleModel<float> CModelType;
+
+        /* Constructor */
+        COdometry(uint32_t                              f_period
+                 ,float                                 f_dt
+                 ,FPositionGetter                       f_position
+                 ,FAngleGetter                          f_angle
+                 ,float                                 f_meterPerImpulse
+                 ,const signal::systemmodels::CSteeringGeometry& f_geometry
+                 ,utils::serial::CSerialTransmitter&    f_serial);
+        /* Pipeline stage, it integrates the pose */
+        virtual void process(uint32_t f_timestamp);
+        /* Attach the reader of the inertial samples */
+        void setImu(FImuReader f_imu);
+        /* Attach the attitude filter of the inertial samples */
+        void setAttitude(signal::filter::IAttitudeFilter* f_attitude);
+        /* Reset the pose */
+        void reset(float f_x, float f_y, float f_yaw);
+        /* Get the last pose */
+        utils::serial::SOdometryPayload getPose();
+        /** @brief  Longitudinal acceleration of the last inertial batch in meter per square second, zero without inertial sensor */
+        float getAcceleration() const
+        {
+            return m_acceleration;
+        }
+        /** @brief  Yaw rate of the last inertial batch without the bias in radian per second (counter-clockwise), zero without inertial sensor */
+        float getYawRate() const
+        {
+            return m_yawRate;
+        }
+        /* Serial callback method to activate the publisher */
+        void serialCallback(char const * a, char * b);
+        /* Serial callback method to reset the pose */
+        void serialCallbackReset(char const * a, char * b);
+        /* Binary callback method to activate the publisher */
+        uint8_t binaryCallback(const utils::serial::SActivationPayload& f_payload);
+    private:
+        /** @brief  Requested pose of a reset */
+        struct SPose{
+            /** @brief  position in meter */
+            float m_x;
+            /** @brief  position in meter */
+            float m_y;
+            /** @brief  orientation in radian */
+            float m_yaw;
+        };
+        /* Run method, it publishes the pose */
+        virtual void _run();
+
+        /** @brief  Getter of the encoder position */
+        FPositionGetter m_position;
+        /** @brief  Getter of the steering angle */
+        FAngleGetter m_angle;
+        /** @brief  Travelled distance of an encoder impulse in meter */
+        const float m_meterPerImpulse;
+        /** @brief  Period of the integration in second */
+        const float m_dt;
+        /** @brief  Steering geometry, it converts the steering angle to the curvature */
+        const signal::systemmodels::CSteeringGeometry& m_geometry;
+        /** @brief  Kinematic bicycle model, its states are the pose */
+        CModelType m_model;
+        /** @brief  Encoder position at the last integration */
+        int64_t m_lastPosition;
+        /** @brief  The first integration initializes the encoder position */
+        bool m_initialized;
+        /** @brief  Reader of the inertial samples, the yaw is integrated by the model without it */
+        FImuReader m_imu;
+        /** @brief  Timestamp of the last inertial sample */
+        uint32_t m_imuTimestamp;
+        /** @brief  Estimated bias of the yaw rate in radian per second */
+        float m_gyroBias;
+        /** @brief  Estimated bias of the longitudinal acceleration in meter per square second */
+        float m_accelBias;
+        /** @brief  Mean longitudinal acceleration of the last inertial batch without the bias */
+        volatile float m_acceleration;
+        /** @brief  Mean yaw rate of the last inertial batch without the bias */
+        volatile float m_yawRate;
+        /** @brief  Attitude filter of the inertial batches, NULL without it */
+        signal::filter::IAttitudeFilter* m_attitude;
+        /** @brief  Heading of the attitude filter at the last batch */
+        float m_heading;
+        /** @brief  The heading of the attitude filter was taken */
+        bool m_hasHeading;
+        /** @brief  Number of the inertial samples processed in a block */
+        static const uint32_t s_blockSize = 8;
+        /** @brief  Smoothing factor of the bias estimation for each standing sample */
+        static constexpr float s_biasFactor = 0.002f;
+        /** @brief  Last integrated pose, it's written by the control loop */
+        utils::sync::CLatest<utils::serial::SOdometryPayload> m_pose;
+        /** @brief  Last reset request, it's written by the serial callback */
+        utils::sync::CLatest<SPose> m_resetRequest;
+        /** @brief  Sequence of the last applied reset request */
+        uint32_t m_resetSequence;
+        /** @brief  Active state of the publisher */
+        bool m_isActive;
+        /** @brief  Binary publishing */
+        bool m_isBinary;
+        /** @brief  Serial transmitter */
+        utils::serial::CSerialTransmitter& m_serial;
+    };
+
+}; // namespace brain
+
+#endif // ODOMETRY_HPP
@@ -0,0 +1,172 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    PathFollower.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the on-board path follower.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef PATH_FOLLOWER_HPP
+#define PATH_FOLLOWER_HPP
+
+#include <mbed.h>
+#include <utils/queue/ringbuffer.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <signal/controllers/profiler.hpp>
+#include <signal/systemmodels/steeringgeometry.hpp>
+
+namespace brain{
+
+   /**
+    * @brief On-board lateral controller, it follows the path segment uploaded by the host with the pure pursuit method at the control rate.
+    * 
+    * The host appends the waypoints [x, y] in the frame of the odometry by the serial commands, they are stored in a compact ring buffer. 
+    * In each tick of the move state the follower takes the last pose of the odometry (rear axle), it drops the passed waypoints and it 
+    * intersects the lookahead circle with the current segment. The lookahead distance grows with the speed, the curvature of the arc to 
+    * the goal point is converted to the steering angle by the steering geometry. After the last waypoint the following is finished, 
+    * the state machine brakes and it reports the end by the "@PATH:reached;;" message. The following is forward only.
+    * The serial threads push the waypoints and the control loop consumes them, the clearing request is applied by the control loop like 
+    * the clearing of the scheduled commands, so the buffer has a single producer and a single consumer.
+    *
+    * With a maximum speed the follower plans also the speed along the uploaded path, so the host doesn't stream the speed commands. 
+    * Each waypoint gets a speed limit, when its successor arrives: the curvature of the circle through its neighbours limits the lateral 
+    * acceleration and the change of the steering angle has to fit in the rate limit of the steering profile over the next segment. 
+    * A backward pass over the pending waypoints keeps the limits reachable with the deceleration of the speed profile and the path ends 
+    * at rest on the last waypoint. The limits and the pass are recomputed only, when a waypoint is pushed or dropped. The lookahead drops 
+    * the waypoints before the robot reaches them, so the plan keeps them until the robot passes them, the step applies the braking 
+    * distance to each waypoint ahead, it's shortened by the build-up time of the deceleration under the jerk limit. The 
+    * planned speed is the target of the speed profile of the state machine, so its acceleration and jerk limits shape the reference.
+    */
+    class CPathFollower
+    {
+    public:
+        /** @brief  Getter of the last pose of the odometry */
+        typedef mbed::Callback<utils::serial::SOdometryPayload()> FPoseGetter;
+        /** @brief  Result of a control step */
+        enum EStatus{
+            STATUS_IDLE = 0,        /** the following isn't active, the steering is commanded by the host */
+            STATUS_FOLLOWING = 1,   /** the steering angle is given by the follower */
+            STATUS_REACHED = 2      /** the last waypoint is reached in this step, the following is finished */
+        };
+        /** @brief  Waypoint of the path in meter */
+        struct SWaypoint{
+            float m_x;
+            float m_y;
+        };
+        /** @brief  Maximum number of the waypoints in a serial command */
+        static const uint8_t s_maxUpload = 4;
+        /** @brief  Minimum planned speed in meter per second, the last waypoint is approached with it until the state machine brakes */
+        static constexpr float s_minSpeed = 0.05f;
+
+        /* Constructor */
+        CPathFollower(FPoseGetter f_pose, const signal::systemmodels::CSteeringGeometry& f_geometry, float f_maxAngle);
+        /* Control step, it returns the status (EStatus), the steering angle in degree and the planned speed in meter per second */
+        uint8_t control(float& f_angle, float& f_speed);
+        /* Stop the following and clear the path */
+        void stop();
+        /** @brief  Active state of the following */
+        bool isActive() const
+        {
+            return m_isActive;
+        }
+        /* Set the parameters of the lookahead */
+        bool setParameters(float f_minLookahead, float f_lookaheadGain, float f_tolerance);
+        /* Set the limits of the speed planning */
+        bool setSpeedLimits(float f_maxSpeed, float f_lateralAcceleration);
+        /** @brief  The speed is planned along the path */
+        bool isPlanning() const
+        {
+            return m_maxSpeed > 0.0f;
+        }
+        /** @brief  Set the speed and the steering profile of the state machine, their limits are applied by the planning */
+        void setProfiles(const signal::controllers::CSetpointProfiler* f_speedProfile, const signal::controllers::CSetpointProfiler* f_angleProfile)
+        {
+            m_speedProfile = f_speedProfile;
+            m_angleProfile = f_angleProfile;
+        }
+        /* Serial callback method of the path commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Number of the waypoints, which were pushed after the last clearing request */
+        uint32_t getPending() const;
+        /* Update the speed limits of the waypoints and the backward pass */
+        void plan(utils::CRingBuffer<SWaypoint,32>::SSpan (&f_spans)[2], uint32_t f_count);
+        /* Speed of the step by the braking distances to the waypoints ahead */
+        float planSpeed(const utils::serial::SOdometryPayload& f_pose);
+        /* Deceleration of the planning */
+        float getDeceleration() const;
+        /** @brief  Pending waypoint by its position, the spans are returned by the ring buffer */
+        static const SWaypoint& at(utils::CRingBuffer<SWaypoint,32>::SSpan (&f_spans)[2], uint32_t f_idx)
+        {
+            return (f_idx < f_spans[0].m_length) ? f_spans[0].m_data[f_idx] : f_spans[1].m_data[f_idx - f_spans[0].m_length];
+        }
+
+        /** @brief  Getter of the pose */
+        FPoseGetter m_pose;
+        /** @brief  Steering geometry, it converts the curvature to the steering angle */
+        const signal::systemmodels::CSteeringGeometry& m_geometry;
+        /** @brief  Limit of the steering angle in degree */
+        const float m_maxAngle;
+        /** @brief  Minimum lookahead distance in meter */
+        float m_minLookahead;
+        /** @brief  Growth of the lookahead distance with the speed in second */
+        float m_lookaheadGain;
+        /** @brief  Distance of the last waypoint, where the following is finished, in meter */
+        float m_tolerance;
+        /** @brief  Waypoints of the path, the serial threads push and the control loop pops */
+        utils::CRingBuffer<SWaypoint,32> m_path;
+        /** @brief  Start point of the current segment, it's the last passed waypoint */
+        SWaypoint m_origin;
+        /** @brief  The first step of the following takes the current position as start point */
+        bool m_hasOrigin;
+        /** @brief  Number of the pushed and of the popped waypoints */
+        volatile uint32_t m_pushed;
+        volatile uint32_t m_popped;
+        /** @brief  The waypoints pushed before this count are cleared by the control loop */
+        volatile uint32_t m_clearUntil;
+        /** @brief  Active state of the following */
+        volatile bool m_isActive;
+        /** @brief  Maximum speed of the planning in meter per second, zero without planning */
+        float m_maxSpeed;
+        /** @brief  Maximum lateral acceleration in the curves in meter per square second */
+        float m_lateralAcceleration;
+        /** @brief  Speed profile of the state machine, its rate and jerk limits */
+        const signal::controllers::CSetpointProfiler* m_speedProfile;
+        /** @brief  Steering profile of the state machine, its rate limit */
+        const signal::controllers::CSetpointProfiler* m_angleProfile;
+        /** @brief  Squared speed limit at the waypoints, the slot is the count of the waypoint modulo the capacity */
+        float m_limit2[32];
+        /** @brief  Length of the segment after the waypoints */
+        float m_length[32];
+        /** @brief  Squared planned speed at the waypoints by the backward pass */
+        float m_speed2[32];
+        /** @brief  Waypoints of the plan, they are kept after the lookahead dropped them, until the robot passes them */
+        SWaypoint m_planned[32];
+        /** @brief  Count of the first waypoint, which the robot didn't pass */
+        uint32_t m_aheadFrom;
+        /** @brief  Count of the waypoints with speed limit */
+        uint32_t m_plannedUntil;
+        /** @brief  Counts of the pushed and of the popped waypoints by the last planning */
+        uint32_t m_planPushed;
+        uint32_t m_planPopped;
+    };
+
+}; // namespace brain
+
+#endif // PATH_FOLLOWER_HPP
@@ -31,10 +31,22 @@ limitations under the License.
 #include <rtos.h>
 
 #include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/sequencetask.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/log/eventlog.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/serial/commandschema.hpp>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/queue/ringbuffer.hpp>
+#include <utils/statemachine/statemachine.hpp>
 #include <hardware/drivers/dcmotor.hpp>
 #include <hardware/drivers/steeringmotor.hpp>
+#include <hardware/distance/distancesensor.hpp>
 
 #include <signal/controllers/motorcontroller.hpp>
+#include <signal/controllers/profiler.hpp>
+#include <brain/pathfollower.hpp>
+#include <brain/energygovernor.hpp>
 
 
 namespace brain{
@@ -46,21 +58,63 @@ namespace brain{
      *  movement of robot and provide the interfaces to control functionality, like braking and moving.
      *  The state of robot can change by external signal received from a higher level controller.   
      * 
+     *  The text commands are parsed and validated by their schemas (utils::serial::CCommandSchema), the rejected commands are answered 
+     *  by 'err;status;field;;' with the status codes of the binary responses.
+     * 
+     *  The obstacle reflex reads the snapshots of the forward distance sensors in each control tick of the move state. When the gap to 
+     *  an obstacle, reduced by the travel since the measurement, is below the minimum distance or its time-to-collision by the measured 
+     *  speed is below the limit, the closed-loop hard braking is started in the same tick and the host is notified ('@OBST:sensor;gap;ttc;;').
      */
-    class CRobotStateMachine 
+    class CRobotStateMachine: public utils::pipeline::IPipelineStage
     {
     public:
+        /** @brief States of the robot */
+        enum ERobotState{
+            STATE_HARD_BRAKE = 0,   /** default state, it doesn't apply any control signal, the hard braking is applied by entering */
+            STATE_MOVE = 1,         /** it controls the motor and the steering */
+            STATE_BRAKE = 2,        /** dynamic braking of the motor */
+            STATE_COUNT
+        };
+        /** @brief Events of the state machine */
+        enum ERobotEvent{
+            EVENT_MOVE = 0,             /** move or distance command */
+            EVENT_BRAKE = 1,            /** brake command or finished distance command */
+            EVENT_HARD_BRAKE = 2,       /** hard brake command */
+            EVENT_HARD_BRAKE_END = 3,   /** timeout of the hard braking */
+            EVENT_FAULT = 4,            /** error of the motor controller */
+            EVENT_COUNT
+        };
+        /** @brief Faults of the motor controller, they are passed to the fault callback */
+        enum EFault{
+            FAULT_HIGH_SPEED = 1,   /** too high speed, the encoder is working */
+            FAULT_ENCODER = 2       /** high control signal without measured speed */
+        };
+        /** @brief Type of the scheduled commands */
+        enum EScheduledType{
+            SCHEDULED_MOVE = 0,
+            SCHEDULED_BRAKE = 1
+        };
+        /** @brief Command applied at the given board time */
+        struct SScheduledCommand{
+            uint32_t m_time;    /** board time of the application (us) */
+            uint8_t  m_type;    /** type of the command (EScheduledType) */
+            float    m_speed;   /** speed of the move command */
+            float    m_angle;   /** steering angle */
+        };
 
         CRobotStateMachine(
             float f_period_sec, 
-            Serial& f_serialPort, 
+            utils::serial::CSerialTransmitter& f_serialPort, 
+            utils::log::CEventLog&                            f_eventLog,
             hardware::drivers::IMotorCommand&                 f_motorControl,
             hardware::drivers::ISteeringCommand&              f_steeringControl,
             signal::controllers::CMotorController*           f_control = NULL);
         
 
-        /* Start the Rtos timer for applying "_run" method  */
-        void startRtosTimer();
+        /* Start the timer of the timer wheel for applying "_run" method  */
+        void startTimer(utils::task::CTimerWheel& f_wheel);
+        /* Pipeline stage, it applies one step of the state machine */
+        virtual void process(uint32_t f_timestamp);
 
         /* Serial callback method for moving */ 
         void serialCallbackMove(char const * a, char * b);
@@ -68,6 +122,38 @@ namespace brain{
         void serialCallbackBrake(char const * a, char * b);
         /* Serial callback method for activating pid */
         void serialCallbackPID(char const * a, char * b);
+        /* Serial callback method for driving a distance */
+        void serialCallbackDistance(char const * a, char * b);
+        /* Serial callback method for the limits of the setpoint profiles */
+        void serialCallbackProfile(char const * a, char * b);
+        /* Serial callback method for scheduling a command */
+        void serialCallbackSchedule(char const * a, char * b);
+        /* Serial callback method for clearing the scheduled commands */
+        void serialCallbackClearSchedule(char const * a, char * b);
+        /* Serial callback method for the heartbeat of the host */
+        void serialCallbackHeartbeat(char const * a, char * b);
+        /* Serial callback method for reading the board time */
+        void serialCallbackTime(char const * a, char * b);
+        /* Serial callback method for autotuning the speed controller */
+        void serialCallbackAutotune(char const * a, char * b);
+        /* Serial callback method for the step experiment of the speed controller */
+        void serialCallbackStepExperiment(char const * a, char * b);
+        /* Serial callback method for the sweep experiment of the speed controller */
+        void serialCallbackSweepExperiment(char const * a, char * b);
+        /* Serial callback for a hard braking */
+        void serialCallbackHardBrake(char const * a, char * b);
+        /* Serial callback method for the duty cycle of the braking */
+        void serialCallbackBrakeDuty(char const * a, char * b);
+        /* Serial callback method for the parameters of the obstacle reflex */
+        void serialCallbackObstacle(char const * a, char * b);
+        /* Binary callback method for moving */
+        uint8_t binaryCallbackMove(const utils::serial::SMovePayload& f_payload);
+        /* Binary callback method for braking */
+        uint8_t binaryCallbackBrake(const utils::serial::SBrakePayload& f_payload);
+        /* Binary callback method for activating pid */
+        uint8_t binaryCallbackPID(const utils::serial::SActivationPayload& f_payload);
+        /* Binary callback method for the emergency stop */
+        uint8_t binaryCallbackEmergencyStop(const uint8_t* f_payload, uint8_t f_length);
 
         /* Reset method */
         void reset();
@@ -75,16 +161,98 @@ namespace brain{
         float getSpeed();
         /* Get angle method */
         float getAngle();
-        /* Callback for changing the state to brake.*/
+        /* Post the end of the hard braking */
         void BrakeCallback();
-        /* Set state method */
-        void setState(int f_state);
+        /* Get state method */
+        uint8_t getState();
+        /* Failsafe braking */
+        void failsafe();
+        /* Emergency stop from interrupt context */
+        void emergencyStop();
+        /** @brief  Set the callback of the faults, it's applied in the control tick with the code of the fault (EFault) */
+        void setFaultCallback(mbed::Callback<void(uint8_t)> f_callback)
+        {
+            m_faultCallback = f_callback;
+        }
+        /** @brief  Set the lateral controller, during its following the steering angle of the move state is given by it, with the speed 
+         *  planning also the speed, its plan applies the limits of the profiles */
+        void setPathFollower(CPathFollower* f_pathFollower)
+        {
+            m_pathFollower = f_pathFollower;
+            if (m_pathFollower != NULL)
+            {
+                m_pathFollower->setProfiles(&m_speedProfile, &m_angleProfile);
+            }
+        }
+        /** @brief  Set the energy governor, while it's active its caps limit the target and the rate of the speed profile in the move state */
+        void setEnergyGovernor(CEnergyGovernor* f_energyGovernor)
+        {
+            m_energyGovernor = f_energyGovernor;
+        }
+        /** @brief  Set the deceleration profile of the closed-loop hard braking in rotation per square second and its gain in duty cycle per rps */
+        void setHardBrakeProfile(float f_deceleration, float f_gain)
+        {
+            m_hardBrakeDeceleration = f_deceleration;
+            m_hardBrakeGain = f_gain;
+        }
+        /** @brief  Duty cycle of the dynamic braking, zero coasts */
+        float getBrakeDuty() const
+        {
+            return m_brakeDuty;
+        }
+        /** @brief  Set the duty cycle of the dynamic braking, it's between zero and one */
+        void setBrakeDuty(float f_duty)
+        {
+            m_brakeDuty = f_duty;
+        }
+        /** @brief  Set the forward distance sensors of the obstacle reflex, the snapshots are read in the control tick */
+        void setObstacleSensors(const hardware::distance::CDistanceSnapshot* const* f_sensors, uint8_t f_count)
+        {
+            m_obstacleSensors = f_sensors;
+            m_obstacleSensorCount = f_count;
+        }
+        /** @brief  Number of the brakings of the obstacle reflex */
+        uint32_t getReflexCount() const
+        {
+            return m_reflexCount;
+        }
+        /** @brief  Board time of the last valid command or heartbeat (us) */
+        uint32_t getLastCommandTime() const
+        {
+            return m_lastCommand;
+        }
     private:
         /* Contains the state machine, which control the lower level drivers (motor and steering) based the current state. */
         virtual void _run();
-        
-        /* Serial callback for a hard braking */
-        void serialCallbackHardBrake(char const * a, char * b);
+        /* Run action of the move state */
+        void runMove();
+        /* Apply the caps of the energy governor on the speed profile */
+        void applyEnergyCaps();
+        /* Entry action of the brake state */
+        void enterBrake();
+        /* Run action of the brake state */
+        void runBrake();
+        /* Entry action of the hard braking state */
+        void enterHardBrake();
+        /* Run action of the hard braking state */
+        void runHardBrake();
+        /* Sequence of the hard braking */
+        void hardBrakeSequence();
+        /* Control step of the closed-loop hard braking */
+        bool controlHardBrake();
+        /* Check the distance sensors by the obstacle reflex */
+        void checkObstacle(uint32_t f_time);
+
+        /* Verify and apply a move command */
+        uint8_t move(float f_speed, float f_angle);
+        /* Verify and apply a distance command */
+        uint8_t distance(float f_distance, float f_speed, float f_angle);
+        /* Verify and apply a brake command */
+        uint8_t brake(float f_angle, bool f_clearSchedule = true);
+        /* Apply the due scheduled commands */
+        void applySchedule(uint32_t f_time);
+        /* Activate or deactivate the pid controller */
+        uint8_t activatePid(bool f_activate);
         
         
         
@@ -92,8 +260,10 @@ namespace brain{
         static float Mps2Rps(float f_vel_cmps);
 
     private:
-        /* reference to Serial object */
-        Serial& m_serialPort;
+        /* reference to the serial transmitter */
+        utils::serial::CSerialTransmitter& m_serialPort;
+        /* event log of the reports in the control tick */
+        utils::log::CEventLog& m_eventLog;
         /* Motor control interface */
         hardware::drivers::IMotorCommand&                 m_motorControl;
         /* Steering wheel control interface */
@@ -104,20 +274,89 @@ namespace brain{
         float m_angle;
         /* PEriod i nseconds */
         float   m_period_sec;
-        /* State machine state */
-        uint8_t m_state;
         /* PID activation state */
         bool    m_ispidActivated;
-        // 0-none
-        // 1-normal
-        // 2-brake regeneration
-        
-        /* Timeout for a hard braking with deactivated pid.  */
-        Timeout                                 m_hbTimeOut;
+        /* Profile of the speed command, the speed is the target of the profile */
+        signal::controllers::CSetpointProfiler  m_speedProfile;
+        /* Ramp of the steering angle, the angle is the target of the ramp */
+        signal::controllers::CSetpointProfiler  m_angleProfile;
+        /* Scheduled commands in order of their time, the serial callbacks push and the state machine pops */
+        utils::CRingBuffer<SScheduledCommand,32> m_schedule;
+        /* Time of the last scheduled command */
+        uint32_t m_lastScheduled;
+        /* Number of the pushed and of the popped commands */
+        uint32_t m_pushed;
+        uint32_t m_popped;
+        /* The commands pushed before this count are cleared by the state machine */
+        volatile uint32_t m_clearUntil;
+        /* Autotuning state, the result is reported at the end */
+        bool    m_isAutotuning;
+        /* Experiment state, the result record is reported at the end */
+        bool    m_isExperimenting;
+        /* The emergency stop waits for the braking of the state machine */
+        volatile bool m_isEmergencyStop;
+        /* Board time of the last valid command (us) */
+        volatile uint32_t m_lastCommand;
+        /* Value of the inverse direction during the hard braking */
+        float m_hardBrake;
+        /* Resume state of the hard braking sequence */
+        utils::task::CSequence m_hardBrakeSequence;
+        /* Remaining steps of the closed-loop hard braking, it's the limit of the braking */
+        uint32_t                                m_hardBrakeSteps;
+        /* Direction of the move at the start of the closed-loop hard braking (1 or -1), zero for the fixed pulse */
+        float m_hardBrakeDirection;
+        /* Speed profile of the closed-loop hard braking (rps), it decreases to zero by the deceleration */
+        float m_hardBrakeRef;
+        /* Deceleration of the profile (rps/s) */
+        float m_hardBrakeDeceleration;
+        /* Gain of the speed error above the profile (duty cycle per rps) */
+        float m_hardBrakeGain;
+        /* Duration of the fixed hard braking pulse in seconds, it's the margin of the closed-loop braking */
+        static constexpr float s_hardBrakeDuration = 0.04f;
+        /* Speed of the release of the reverse torque (rps) */
+        static constexpr float s_hardBrakeStopSpeed = 0.5f;
+        /* Forward distance sensors of the obstacle reflex */
+        const hardware::distance::CDistanceSnapshot* const* m_obstacleSensors;
+        /* Number of the distance sensors */
+        uint8_t m_obstacleSensorCount;
+        /* The obstacle reflex is enabled */
+        volatile bool m_reflexEnabled;
+        /* Time-to-collision limit of the reflex (s) */
+        volatile float m_reflexTtc;
+        /* Minimum gap of the reflex (m) */
+        volatile float m_reflexGap;
+        /* Maximum duty cycle of the reverse torque of the reflex braking */
+        volatile float m_reflexBrake;
+        /* Number of the reflex brakings */
+        uint32_t m_reflexCount;
+        /* Minimum forward speed of the reflex (m/s), the standing robot isn't braked */
+        static constexpr float s_reflexMinSpeed = 0.05f;
+        /* Maximum age of a distance snapshot (us), an older measurement is ignored */
+        static const uint32_t s_reflexMaxAge = 100000;
+        /* Duty cycle of the proportional dynamic braking in the braking state */
+        volatile float m_brakeDuty;
         /* Speed Control for dc motor */
         signal::controllers::CMotorController*           m_control;
-        /* Rtos  timer for periodically applying */
-        RtosTimer                               m_timer;
+        /* Callback of the faults */
+        mbed::Callback<void(uint8_t)>                    m_faultCallback;
+        /* Lateral controller of the path following */
+        CPathFollower*                                   m_pathFollower;
+        /* Energy governor of the eco driving */
+        CEnergyGovernor*                                 m_energyGovernor;
+        /* Expiry callback of the timer */
+        static void expireTimer(utils::task::CTimerWheel::CTimer& f_timer);
+        /* Timer of the timer wheel for periodically applying */
+        utils::task::CTimerWheel::CTimer         m_timer;
+        /* Engine of the state machine */
+        typedef utils::CStateMachine<CRobotStateMachine,STATE_COUNT,EVENT_COUNT> CEngine;
+        /* Mark of the missing transition */
+        static const uint8_t s_none = CEngine::s_noTransition;
+        /* Actions of the states */
+        static const CEngine::CStateTable s_states;
+        /* Transitions of the states */
+        static const CEngine::CTransitionTable s_transitions;
+        /* State machine, the events are dispatched in the control tick */
+        CEngine m_engine;
     }; // class CRobotStateMachine
 }; // namespace brain
 
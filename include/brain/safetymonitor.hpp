@@ -0,0 +1,70 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    SafetyMonitor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the command timeout monitor and the watchdog.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SAFETY_MONITOR_HPP
+#define SAFETY_MONITOR_HPP
+
+#include <mbed.h>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <hardware/drivers/watchdog.hpp>
+#include <brain/robotstatemachine.hpp>
+
+namespace brain{
+
+   /**
+    * @brief Safety monitor stage of the control pipeline, it brakes the robot, when the host doesn't send valid command or heartbeat in 
+    * the timeout, and it refreshes the independent watchdog. 
+    * 
+    * It's applied in each tick of the control loop before the state machine, so the failsafe braking is applied in the same tick and 
+    * it can't be delayed by the serial tasks. The check takes constant time. When the control loop stops, the watchdog resets the 
+    * microcontroller.
+    */
+    class CSafetyMonitor: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /* Constructor */
+        CSafetyMonitor(CRobotStateMachine&                  f_robot
+                      ,utils::serial::CSerialTransmitter&   f_serialPort
+                      ,float                                f_timeout_sec);
+        /* Start the independent watchdog */
+        bool startWatchdog(float f_timeout_sec);
+        /* Pipeline stage, it checks the command timeout */
+        virtual void process(uint32_t f_timestamp);
+        /* Serial callback method for the command timeout */
+        void serialCallbackTimeout(char const * a, char * b);
+    private:
+        /** @brief  Supervised state machine */
+        CRobotStateMachine& m_robot;
+        /** @brief  Serial transmitter for reporting the failsafe braking */
+        utils::serial::CSerialTransmitter& m_serialPort;
+        /** @brief  Command timeout in microsecond, zero disables the check */
+        volatile uint32_t m_timeout;
+        /** @brief  The watchdog is started */
+        bool m_isWatchdogActive;
+    };
+
+}; // namespace brain
+
+#endif // SAFETY_MONITOR_HPP
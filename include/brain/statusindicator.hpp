@@ -0,0 +1,112 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    StatusIndicator.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the blink codes of the robot status.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef STATUS_INDICATOR_HPP
+#define STATUS_INDICATOR_HPP
+
+#include <mbed.h>
+#include <utils/pipeline/pipeline.hpp>
+#include <hardware/drivers/statusled.hpp>
+#include <brain/robotstatemachine.hpp>
+
+namespace brain{
+
+   /**
+    * @brief Blink codes of the robot status on the status led, for the diagnostics beside the track.
+    * 
+    * The status is evaluated in each 100th tick, the pattern of the led is rewritten only, when the status changes; the blinking 
+    * itself doesn't need cpu. The codes in order of priority:
+    *  - fault (encoder degraded, bridge tripped or a fault of the state machine in the hold time): continuous fast blinking
+    *  - overload (control loop overrun or missed task deadline in the hold time): 3 flashes per 3.2 s
+    *  - link lost (no command in the link timeout, also before the first command): 2 flashes per 3.2 s
+    *  - ok: 1 flash per 3.2 s (heartbeat)
+    */
+    class CStatusIndicator: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Status codes, the value is the number of the flashes */
+        enum EStatus
+        {
+            STATUS_OK = 1,
+            STATUS_LINK = 2,
+            STATUS_OVERLOAD = 3,
+            STATUS_FAULT = 4
+        };
+        /** @brief  Getter of the present fault conditions */
+        typedef mbed::Callback<bool()> FFaultGetter;
+        /** @brief  Getter of the monotonic number of the overload events */
+        typedef mbed::Callback<uint32_t()> FOverloadCounter;
+        /** @brief  Number of the ticks between two evaluations */
+        static const uint32_t s_divider = 100;
+        /** @brief  Pattern of the fault code */
+        static const uint32_t s_faultPattern = 0x55555555;
+        /* Constructor */
+        CStatusIndicator(hardware::drivers::CStatusLed_TIM1& f_led
+                        ,CRobotStateMachine&                  f_robot
+                        ,float                                f_linkTimeout_sec
+                        ,float                                f_hold_sec);
+        /* Set the sources of the fault and overload conditions */
+        void setSources(FFaultGetter f_fault, FOverloadCounter f_overloads);
+        /* Latch a fault event */
+        void latchFault();
+        /* Pipeline stage, it evaluates the status */
+        virtual void process(uint32_t f_timestamp);
+        /** @brief  Last evaluated status */
+        EStatus getStatus() const
+        {
+            return m_status;
+        }
+    private:
+        /** @brief  Status led */
+        hardware::drivers::CStatusLed_TIM1& m_led;
+        /** @brief  State machine, the time of its last command is the link status */
+        CRobotStateMachine& m_robot;
+        /** @brief  Link timeout in microsecond */
+        const uint32_t m_linkTimeout;
+        /** @brief  Hold time of the fault and overload events in microsecond */
+        const uint32_t m_hold;
+        /** @brief  Present fault conditions */
+        FFaultGetter m_fault;
+        /** @brief  Number of the overload events */
+        FOverloadCounter m_overloads;
+        /** @brief  Number of the overload events at the previous evaluation */
+        uint32_t m_prevOverloads;
+        /** @brief  A fault event was latched since the previous evaluation */
+        volatile bool m_faultEvent;
+        /** @brief  End of the hold time of the fault events */
+        uint32_t m_faultUntil;
+        /** @brief  End of the hold time of the overload events */
+        uint32_t m_overloadUntil;
+        /** @brief  The hold times are running */
+        bool m_faultHeld;
+        bool m_overloadHeld;
+        /** @brief  Counter of the ticks */
+        uint32_t m_tick;
+        /** @brief  Last evaluated status */
+        EStatus m_status;
+    };
+
+}; // namespace brain
+
+#endif // STATUS_INDICATOR_HPP
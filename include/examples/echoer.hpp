@@ -30,6 +30,7 @@ Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
 /* The mbed library */
 #include <mbed.h>
 #include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
 
 
 namespace examples{
@@ -41,13 +42,13 @@ namespace examples{
     {
         public:
             /* Construnctor */
-            CEchoer(uint32_t f_period, Serial& f_serialPort);
+            CEchoer(uint32_t f_period, utils::serial::CSerialTransmitter& f_serialPort);
         private:
             /* Run method */
             virtual void _run();
 
-            /* Serial communication member*/
-            Serial& m_serialPort; 
+            /* Serial transmitter member*/
+            utils::serial::CSerialTransmitter& m_serialPort; 
     };
 
 }; // namespace examples
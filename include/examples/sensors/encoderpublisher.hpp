@@ -32,10 +32,13 @@ Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
 #include<utils/taskmanager/taskmanager.hpp>
 #include <hardware/drivers/dcmotor.hpp>
 #include <utils/serial/serialmonitor.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
 #include <signal/controllers/motorcontroller.hpp>
 #include <signal/systemmodels/systemmodels.hpp>
 
 #include <hardware/encoders/encoderinterfaces.hpp>
+#include <hardware/sampling/samplehandoff.hpp>
 
 namespace examples
 {
@@ -45,6 +48,8 @@ namespace examples
        /**
         * @brief CEncoderPublisher class is subclass of utils::task::CTask, a class to publish periodically the encoder values. 
         * 
+        * With a sample handoff the publisher takes the speed from the sample blocks of the control loop instead of the getter, the 
+        * notifier of the handoff triggers the task, when a block is passed, so the published speed is the sample of one tick.
         */
         class CEncoderPublisher:public utils::task::CTask
         {
@@ -52,9 +57,16 @@ namespace examples
                 /* Constructor */
                 CEncoderPublisher(uint32_t            f_period
                             ,hardware::encoders::IEncoderGetter&    f_encoder
-                            ,Serial&            f_serial);
+                            ,utils::serial::CSerialTransmitter&            f_serial);
                 /* Serial callback implementation */
                 void serialCallback(char const * a, char * b);
+                /* Binary callback implementation */
+                uint8_t binaryCallback(const utils::serial::SActivationPayload& f_payload);
+                /** @brief Set the handoff of the sample blocks, the blocks are consumed by the task */
+                void setHandoff(hardware::sampling::CSampleMail* f_handoff)
+                {
+                    m_handoff = f_handoff;
+                }
             private:
                 
                 /* Run method */
@@ -62,10 +74,14 @@ namespace examples
 
                 /** @brief Active flag  */
                 bool                m_isActive;
+                /** @brief Binary protocol flag, it's set, when the publisher was activated by a binary message  */
+                bool                m_isBinary;
                 /** @brief Encoder getter interface  */
                 hardware::encoders::IEncoderGetter&     m_encoder;
-                /** @brief Serial communication obj.  */
-                Serial&             m_serial;
+                /** @brief Serial transmitter obj.  */
+                utils::serial::CSerialTransmitter&             m_serial;
+                /** @brief Handoff of the sample blocks, NULL without handoff  */
+                hardware::sampling::CSampleMail*              m_handoff;
         };
     }; // namespace sensors
 }; // namespace examples
@@ -0,0 +1,121 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Mcp2515.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the driver of the 
+  *          MCP2515 CAN controller.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef MCP2515_HPP
+#define MCP2515_HPP
+
+#include <mbed.h>
+#include <utils/can/cancontroller.hpp>
+
+namespace hardware::can{
+
+   /**
+    * @brief Driver of the MCP2515 stand-alone CAN controller on SPI, the STM32F401 doesn't have a CAN peripheral.
+    * 
+    * The acceptance filters of the controller are applied: the first mask and the first two filters belong to the first receive 
+    * buffer, the second mask and the other four filters to the second buffer, a frame accepted by the full first buffer rolls over to the 
+    * second one. The three transmit buffers are the mailboxes, their priority is set by the two highest bits of the identifier, so 
+    * the lower identifiers leave the controller first, as on the bus. The interrupt output signals the received frames, the freed 
+    * mailboxes and the errors, the attached callback is applied from its falling edge, the buffers are read by the thread of the user.
+    * 
+    * The filters and the masks are stored, they are written in the configuration mode by 'start'. The zero masks accept all 
+    * standard frames. The SPI transfers are blocking, so the methods mustn't be applied from interrupt context.
+    */
+    class CMcp2515: public utils::can::ICanController
+    {
+    public:
+        /** @brief  Operation modes */
+        enum EMode{
+            NORMAL      = 0x00,
+            LOOPBACK    = 0x40,
+            LISTEN_ONLY = 0x60
+        };
+        /* Constructor */
+        CMcp2515(SPI& f_bus, PinName f_chipSelect, PinName f_interrupt);
+        /* Set an acceptance mask */
+        void setMask(uint8_t f_index, uint32_t f_mask, bool f_extended = false);
+        /* Set an acceptance filter */
+        void setFilter(uint8_t f_index, uint32_t f_id, bool f_extended = false);
+        /* Reset and configure the controller */
+        bool start(uint32_t f_bitrate, uint32_t f_oscillator, EMode f_mode = NORMAL);
+        /* Load the frame in a free transmit buffer */
+        virtual bool send(const utils::can::SCanFrame& f_frame);
+        /* Read a received frame */
+        virtual bool receive(utils::can::SCanFrame& f_frame);
+        /* Clear the transmit and error flags of the interrupt */
+        virtual uint32_t acknowledge();
+        /** @brief  The interrupt output is still active (low level) */
+        virtual bool isPending()
+        {
+            return m_interrupt.read() == 0;
+        }
+        /* Read the error state */
+        virtual void getErrors(utils::can::SCanErrors& f_errors);
+        /* Attach the callback of the interrupt */
+        virtual void attach(mbed::Callback<void()> f_callback);
+
+        /** @brief  Number of the acceptance masks */
+        static const uint8_t s_maskCount = 2;
+        /** @brief  Number of the acceptance filters */
+        static const uint8_t s_filterCount = 6;
+        /** @brief  Number of the transmit buffers */
+        static const uint8_t s_mailboxCount = 3;
+    private:
+        /* Reset the controller */
+        void reset();
+        /* Read a register */
+        uint8_t readRegister(uint8_t f_address);
+        /* Write consecutive registers */
+        void writeRegisters(uint8_t f_address, const uint8_t* f_values, uint8_t f_length);
+        /* Write a register */
+        void writeRegister(uint8_t f_address, uint8_t f_value);
+        /* Modify the masked bits of a register */
+        void modifyRegister(uint8_t f_address, uint8_t f_mask, uint8_t f_value);
+        /* Read the status of the buffers */
+        uint8_t readStatus();
+        /* Set the operation mode */
+        bool setMode(uint8_t f_mode);
+        /* Encode an identifier in the four identifier registers */
+        static void encodeId(uint32_t f_id, bool f_extended, uint8_t* f_registers);
+        /* Set the bit timing */
+        bool setBitTiming(uint32_t f_bitrate, uint32_t f_oscillator);
+
+        /** @brief  SPI interface */
+        SPI& m_bus;
+        /** @brief  Chip select output */
+        DigitalOut m_chipSelect;
+        /** @brief  Interrupt input */
+        InterruptIn m_interrupt;
+        /** @brief  Identifier registers of the masks */
+        uint8_t m_masks[s_maskCount][4];
+        /** @brief  Identifier registers of the filters */
+        uint8_t m_filters[s_filterCount][4];
+        /** @brief  Number of the frames lost by receive overflow */
+        uint32_t m_overflows;
+    };
+
+}; // namespace hardware::can
+
+#endif // MCP2515_HPP
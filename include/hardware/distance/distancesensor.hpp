@@ -0,0 +1,56 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    DistanceSensor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the declaration of the distance measurement shared by the distance sensors.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef DISTANCE_SENSOR_HPP
+#define DISTANCE_SENSOR_HPP
+
+#include <mbed.h>
+#include <utils/sync/latest.hpp>
+
+namespace hardware::distance{
+
+    /** @brief Status of a distance measurement */
+    enum EDistanceStatus{
+        DISTANCE_NONE    = 0,                                           /**< no measurement since the start */
+        DISTANCE_VALID   = 1,                                           /**< the distance is measured */
+        DISTANCE_NO_ECHO = 2,                                           /**< no obstacle in the range, the distance is the range */
+        DISTANCE_ERROR   = 3                                            /**< the sensor didn't answer or its signal is unreliable */
+    };
+
+    /** @brief Distance measurement of a sensor */
+    struct SDistance{
+        /** @brief Timestamp of the measurement in microsecond */
+        uint32_t m_timestamp;
+        /** @brief Distance of the obstacle in meter */
+        float m_distance;
+        /** @brief Status of the measurement (EDistanceStatus) */
+        uint8_t m_status;
+    };
+
+    /** @brief Latest measurement of a sensor, it's written by the driver and read by the control loop without critical section */
+    typedef utils::sync::CLatest<SDistance> CDistanceSnapshot;
+
+}; // namespace hardware::distance
+
+#endif // DISTANCE_SENSOR_HPP
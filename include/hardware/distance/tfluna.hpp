@@ -0,0 +1,102 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    TfLuna.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the time-of-flight distance sensor on the I2C bus.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TF_LUNA_HPP
+#define TF_LUNA_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <hardware/drivers/busqueue.hpp>
+#include <hardware/distance/distancesensor.hpp>
+
+namespace hardware::distance{
+
+   /**
+    * @brief Driver of the TF-Luna time-of-flight distance sensor in I2C mode on the transaction queue of the I2C bus.
+    *
+    * The sensor measures continuously (100 Hz by default), the task submits the burst read of the distance, the signal strength and
+    * the temperature registers in each period, the bytes are copied by DMA and the measurement is decoded and published by the
+    * callback from interrupt context. The bus is shared with the inertial sensor: the reading has normal priority, so it waits in
+    * the queue behind the FIFO transfers of the inertial sensor. A weak or saturated signal is published with the error status.
+    */
+    class CTfLuna: public utils::task::CTask
+    {
+    public:
+        /* Constructor */
+        CTfLuna(uint32_t                                f_period
+               ,hardware::drivers::CI2cBus_I2C1&        f_bus
+               ,CDistanceSnapshot&                      f_output
+               ,uint8_t                                 f_address = 0x10);
+        /* Serial callback */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Signal strength of the last measurement */
+        uint16_t getAmplitude() const
+        {
+            return m_amplitude;
+        }
+        /** @brief  Number of the failed or stuck transfers */
+        uint32_t getErrors() const
+        {
+            return m_errors;
+        }
+    private:
+        /** @brief  Register of the low byte of the distance, the strength and the temperature follow it */
+        static const uint8_t REG_DIST_LOW = 0x00;
+        /** @brief  Number of the read bytes */
+        static const uint16_t s_frameSize = 6;
+        /** @brief  Minimum signal strength of a valid distance */
+        static const uint16_t s_minAmplitude = 100;
+        /** @brief  Signal strength of the saturated receiver */
+        static const uint16_t s_saturated = 0xFFFF;
+        /** @brief  Number of the periods, after which an unfinished transfer is aborted */
+        static const uint8_t s_stuckPeriods = 4;
+
+        /* Run method */
+        void _run();
+        /* Callback of the burst reading */
+        void readCallback(bool f_success);
+
+        /** @brief  Transaction queue of the I2C bus */
+        hardware::drivers::CI2cBus_I2C1& m_bus;
+        /** @brief  Published measurement */
+        CDistanceSnapshot& m_output;
+        /** @brief  7-bit device address */
+        const uint8_t m_address;
+        /** @brief  Buffer of the transfer */
+        uint8_t m_buffer[s_frameSize];
+        /** @brief  A transfer of the sensor is queued or active */
+        volatile bool m_pending;
+        /** @brief  Periods of the active transfer */
+        uint8_t m_pendingPeriods;
+        /** @brief  Signal strength of the last measurement */
+        volatile uint16_t m_amplitude;
+        /** @brief  Number of the measurements */
+        volatile uint32_t m_count;
+        /** @brief  Number of the failed or stuck transfers */
+        volatile uint32_t m_errors;
+    };
+
+}; // namespace hardware::distance
+
+#endif // TF_LUNA_HPP
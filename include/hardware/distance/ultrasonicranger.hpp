@@ -0,0 +1,94 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    UltrasonicRanger.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the ultrasonic distance sensor.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ULTRASONIC_RANGER_HPP
+#define ULTRASONIC_RANGER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <hardware/drivers/echocapture.hpp>
+#include <hardware/distance/distancesensor.hpp>
+
+namespace hardware::distance{
+
+   /**
+    * @brief Ultrasonic distance sensor with trigger input and echo output (HC-SR04 and compatibles).
+    *
+    * Each cycle the task arms the echo capture and it gives the 10 us trigger pulse, the width of the echo is latched by the timer
+    * and copied by DMA, so the edges don't have interrupt and the control loop doesn't get jitter from them. The task polls the
+    * capture in its next periods: the captured width is known modulo the period of the timer, the number of the whole periods is
+    * resolved by the time elapsed from the trigger until the poll, so the period of the task has to be well below the period of
+    * the timer. A longer echo than the range or no echo in the timeout publishes the range with the 'no echo' status.
+    */
+    class CUltrasonicRanger: public utils::task::CTask
+    {
+    public:
+        /* Constructor */
+        CUltrasonicRanger(uint32_t                              f_period
+                         ,hardware::drivers::CEchoCapture_TIM3& f_capture
+                         ,PinName                               f_trigger
+                         ,CDistanceSnapshot&                    f_output
+                         ,float                                 f_range
+                         ,float                                 f_cycle_sec);
+        /* Serial callback */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Number of the cycles without echo */
+        uint32_t getMisses() const
+        {
+            return m_misses;
+        }
+    private:
+        /** @brief  Speed of the sound in meter per second, the half of it converts the echo width to distance */
+        static constexpr float s_soundSpeed = 343.0f;
+        /** @brief  Maximum width of the echo of the sensor without obstacle in microsecond */
+        static const uint32_t s_echoTimeout = 40000;
+
+        /* Run method */
+        void _run();
+        /* Publish a measurement */
+        void publish(uint32_t f_timestamp, float f_distance, EDistanceStatus f_status);
+
+        /** @brief  Capture of the echo */
+        hardware::drivers::CEchoCapture_TIM3& m_capture;
+        /** @brief  Trigger output */
+        DigitalOut m_trigger;
+        /** @brief  Published measurement */
+        CDistanceSnapshot& m_output;
+        /** @brief  Range of the sensor in meter */
+        const float m_range;
+        /** @brief  Period of the measurement cycles in microsecond, the echoes of the previous cycle decay in it */
+        const uint32_t m_cycle;
+        /** @brief  Time of the last trigger pulse */
+        uint32_t m_triggerTime;
+        /** @brief  The echo of the last trigger is polled */
+        bool m_waiting;
+        /** @brief  Number of the measurements */
+        uint32_t m_count;
+        /** @brief  Number of the cycles without echo */
+        uint32_t m_misses;
+    };
+
+}; // namespace hardware::distance
+
+#endif // ULTRASONIC_RANGER_HPP
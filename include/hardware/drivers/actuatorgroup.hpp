@@ -0,0 +1,177 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ActuatorGroup.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the synchronized group of the motor bridges.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef ACTUATOR_GROUP_HPP
+#define ACTUATOR_GROUP_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/fastio.hpp>
+#include <hardware/drivers/dcmotor.hpp>
+#include <hardware/drivers/steeringmotor.hpp>
+#include <signal/systemmodels/steeringgeometry.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Group of motor bridges on the channels of the timer TIM2, all outputs of a command are applied by the same update event.
+    *
+    * It's the motor command of the multi-motor variants (dual-motor, 4WD). A command computes the output of each channel first, then it
+    * commits the frame: the compare registers are written with preload while the update events are disabled (UDIS), so the next update
+    * event loads all channels together. When a channel changes its direction, the reversing channels get a zero period and the complete
+    * frame is applied by the update interrupt after it, like in CBridgeUpdate_TIM2, so all wheels change their torque in the same period.
+    * The group and CBridgeUpdate_TIM2 use the same interrupt, only one of them can be started.
+    *
+    * The drive command is distributed by an electronic differential: the speed of each wheel is proportional to its distance from the
+    * instantaneous center of rotation given by the steering angle and the steering geometry, the reference is the center of the rear axle. The
+    * steering angle reaches the group through the steering tap ('steering'), which forwards it to the servo.
+    */
+    class CActuatorGroup_TIM2: public IMotorCommand
+    {
+    public:
+       /**
+        * @brief Steering command of the state machine, it forwards the angle to the servo and it updates the differential of the group.
+        */
+        class CSteeringTap: public ISteeringCommand
+        {
+        public:
+            /** @brief  Constructor */
+            CSteeringTap(CActuatorGroup_TIM2& f_group, ISteeringCommand& f_servo)
+                : m_group(f_group)
+                , m_servo(f_servo)
+            {
+            }
+            /* Set the steering angle */
+            void setAngle(float f_angle);
+            /** @brief  Check the range of the servo */
+            bool inRange(float f_angle)
+            {
+                return m_servo.inRange(f_angle);
+            }
+        private:
+            /** @brief  Group of the differential */
+            CActuatorGroup_TIM2& m_group;
+            /** @brief  Steering servo */
+            ISteeringCommand& m_servo;
+        };
+
+        /** @brief  Maximum number of the channels, one per compare channel of the timer */
+        static const uint8_t s_maxChannels = 4;
+
+        /* Constructor */
+        CActuatorGroup_TIM2(ISteeringCommand& f_servo, const signal::systemmodels::CSteeringGeometry& f_geometry, float f_infLimit, float f_supLimit);
+        /* Add a bridge to the group */
+        bool addChannel(CFastPwmOut& f_pwm, CFastDigitalOut& f_ina, CFastDigitalOut& f_inb, float f_x, float f_y);
+        /* Start the synchronized update */
+        bool start();
+        /* Stop the synchronized update */
+        void stop();
+        /* Drive the wheels through the differential */
+        void setSpeed(float f_pwm);
+        /* Brake */
+        void brake();
+        /* Inverse the direction of the wheels */
+        void inverseDirection(float f_pwm);
+        /* Check the allowed range */
+        bool inRange(float f_pwm);
+        /* Coast */
+        void coast();
+        /* Proportional dynamic braking of the wheels */
+        void dynamicBrake(float f_duty);
+        /* Set the steering angle of the differential */
+        void setAngle(float f_angle);
+        /** @brief  Steering command of the state machine */
+        ISteeringCommand& steering()
+        {
+            return m_steering;
+        }
+        /** @brief  Speed ratio of a channel from the differential, one for the straight move */
+        float getRatio(uint8_t f_channel) const
+        {
+            return (f_channel < m_count) ? m_channels[f_channel].m_ratio : 0.0f;
+        }
+        /** @brief  Synchronized update state */
+        bool isStarted() const
+        {
+            return m_started;
+        }
+    private:
+        /** @brief  Bridge of a channel */
+        struct SChannel{
+            /** @brief  PWM output, it's generated by the TIM2 */
+            CFastPwmOut* m_pwm;
+            /** @brief  Direction pin A */
+            CFastDigitalOut* m_ina;
+            /** @brief  Direction pin B */
+            CFastDigitalOut* m_inb;
+            /** @brief  Longitudinal position of the wheel from the rear axle (m) */
+            float m_x;
+            /** @brief  Lateral position of the wheel, positive to left (m) */
+            float m_y;
+            /** @brief  Speed ratio of the wheel from the differential */
+            float m_ratio;
+            /** @brief  Duty cycle of the frame */
+            float m_duty;
+            /** @brief  Direction pin A of the frame */
+            bool m_frameA;
+            /** @brief  Direction pin B of the frame */
+            bool m_frameB;
+            /** @brief  Applied state of the direction pin A */
+            bool m_stateA;
+            /** @brief  Applied state of the direction pin B */
+            bool m_stateB;
+        };
+        /* Commit the frame to the outputs */
+        void commit();
+        /* Apply the frame immediately */
+        void apply();
+        /* TIM2 interrupt handler */
+        static void timerIrqHandler();
+
+        /** @brief  The active object */
+        static CActuatorGroup_TIM2* s_instance;
+        /** @brief  Steering tap of the state machine */
+        CSteeringTap m_steering;
+        /** @brief  Steering geometry */
+        const signal::systemmodels::CSteeringGeometry& m_geometry;
+        /** @brief  Lower limit of the command */
+        const float m_infLimit;
+        /** @brief  Upper limit of the command */
+        const float m_supLimit;
+        /** @brief  Channels of the group */
+        SChannel m_channels[s_maxChannels];
+        /** @brief  Number of the channels */
+        uint8_t m_count;
+        /** @brief  Last drive command, it's distributed again at the change of the steering angle */
+        float m_drive;
+        /** @brief  The last command is a drive command */
+        bool m_driving;
+        /** @brief  The frame waits for the update interrupt */
+        volatile bool m_pending;
+        /** @brief  Synchronized update state */
+        bool m_started;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // ACTUATOR_GROUP_HPP
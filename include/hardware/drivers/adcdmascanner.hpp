@@ -0,0 +1,122 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    AdcDmaScanner.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the DMA based scan of the analog inputs.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ADC_DMA_SCANNER_HPP
+#define ADC_DMA_SCANNER_HPP
+
+#include <mbed.h>
+#include <pinmap.h>
+#include <PeripheralPins.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief DMA based scan of several analog inputs on ADC1.
+    * 
+    * A trigger converts all channels of the sequence once, the stream 0 of DMA2 (channel 0) copies the results in the buffer without 
+    * interrupt. The conversion of the sequence takes a few microseconds, so the results are waited by polling. After the start the ADC1 
+    * is configured for the scan, the AnalogIn objects on the same ADC mustn't be read. The sequence has up to 12 channels (the third and
+    * the second sequence register), with 56 cycles sampling time it takes about 40 us.
+    * 
+    * In the synchronized mode the sequence is triggered by the channel 3 of the motor pwm timer TIM2 (internal compare without output) 
+    * in each pwm period, at the phase given by 'setPhase'. The DMA writes the sequences circularly in a buffer of several sequences, 
+    * the software trigger isn't applied, 'getValue' returns the last complete sequence and 'getSample' the older ones. 
+    * 
+    * The analog watchdog compares each conversion of a channel with a high threshold in hardware, its interrupt applies the attached 
+    * callback within microseconds (e.g. overcurrent trip), independently of the control loop. The interrupt is disarmed after it, so 
+    * a persisting fault doesn't block the processor. The ADC interrupt is shared with CAdcInjected_ADC1, its handler is chained, when 
+    * the injected conversion is started before the watchdog.
+    */
+    class CAdcDmaScanner_ADC1
+    {
+    public:
+        /* Constructor */
+        CAdcDmaScanner_ADC1(const PinName* f_pins, uint8_t f_count);
+        /* Configure the ADC and the DMA */
+        void start();
+        /* Select the synchronized mode */
+        void setSynchronized(uint8_t f_depth, float f_phase);
+        /* Set the sampling point in the pwm period */
+        void setPhase(float f_phase);
+        /* Configure the analog watchdog */
+        void setWatchdog(uint8_t f_index, uint16_t f_high, mbed::Callback<void()> f_callback);
+        /* Enable the interrupt of the analog watchdog */
+        void armWatchdog();
+        /* Start the conversion of the sequence */
+        void trigger();
+        /* Wait the end of the conversion */
+        bool wait();
+        /** @brief  Number of the channels */
+        uint8_t getCount() const
+        {
+            return m_count;
+        }
+        /* Raw 12-bit result of a channel of the last sequence */
+        uint16_t getValue(uint8_t f_index) const;
+        /* Number of the complete sequences in the synchronized mode */
+        uint8_t getPosition() const;
+        /** @brief  Number of the sequences in the buffer */
+        uint8_t getDepth() const
+        {
+            return m_depth;
+        }
+        /** @brief  Raw 12-bit result of a channel in a slot of the buffer */
+        uint16_t getSample(uint8_t f_slot, uint8_t f_index) const
+        {
+            return m_buffer[f_slot * m_count + f_index];
+        }
+        /** @brief  Maximum number of the channels */
+        static const uint8_t s_maxChannels = 12;
+        /** @brief  Full scale of the raw results */
+        static const uint16_t s_fullScale = 4095;
+        /** @brief  Maximum number of the polling cycles */
+        static const uint32_t s_timeout = 2000;
+        /** @brief  Maximum number of the sequences in the buffer */
+        static const uint8_t s_maxDepth = 8;
+    private:
+        /* ADC interrupt handler */
+        static void adcIrqHandler();
+        /** @brief  The object of the analog watchdog */
+        static CAdcDmaScanner_ADC1* s_instance;
+        /** @brief  Chained handler of the ADC interrupt */
+        static uint32_t s_chainedHandler;
+        /** @brief  Pins of the channels */
+        PinName m_pins[s_maxChannels];
+        /** @brief  ADC channel numbers */
+        uint8_t m_channels[s_maxChannels];
+        /** @brief  Number of the channels */
+        uint8_t m_count;
+        /** @brief  Number of the sequences in the buffer, one without synchronization */
+        uint8_t m_depth;
+        /** @brief  Triggered by the pwm timer */
+        bool m_isSynchronized;
+        /** @brief  Callback of the analog watchdog */
+        mbed::Callback<void()> m_watchdogCallback;
+        /** @brief  Results of the sequences, it's written by DMA */
+        volatile uint16_t m_buffer[s_maxChannels * s_maxDepth];
+    };
+
+}; // namespace hardware::drivers
+
+#endif // ADC_DMA_SCANNER_HPP
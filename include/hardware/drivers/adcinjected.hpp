@@ -0,0 +1,86 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    AdcInjected.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the pwm triggered injected conversion of an analog input.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ADC_INJECTED_HPP
+#define ADC_INJECTED_HPP
+
+#include <mbed.h>
+#include <pinmap.h>
+#include <PeripheralPins.h>
+#include <hardware/drivers/dcmotor.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Injected conversion of an analog input on ADC1, it's triggered by the motor pwm timer TIM2 in each pwm period.
+    * 
+    * The channel 1 of TIM2 works as an internal compare (without output), its falling reference edge at the given phase of the period 
+    * triggers the injected conversion, so the current is sampled at the same point of each pwm period. The injected conversion 
+    * interrupts the regular sequence of CAdcDmaScanner_ADC1, which is resumed after it. The end of the conversion interrupt applies 
+    * the attached callback, so a fast control loop (e.g. current controller) can run with the rate of the pwm. The interrupt has the 
+    * highest priority, the control timer has to have a lower priority to be preempted. 
+    */
+    class CAdcInjected_ADC1: public ICurrentGetter
+    {
+    public:
+        /* Constructor */
+        CAdcInjected_ADC1(PinName f_pin, float f_scale);
+        /* Configure the trigger, the ADC and the interrupt */
+        void start(float f_phase);
+        /* Stop the triggered conversions */
+        void stop();
+        /* Set the sampling point in the pwm period */
+        void setPhase(float f_phase);
+        /* Attach the end of conversion callback */
+        void attach(mbed::Callback<void()> f_callback);
+        /* Get current */
+        virtual float getCurrent();
+        /** @brief  Raw 12-bit result of the last conversion */
+        uint16_t getValue() const
+        {
+            return m_value;
+        }
+        /** @brief  Full scale of the raw results */
+        static const uint16_t s_fullScale = 4095;
+    private:
+        /* ADC interrupt handler */
+        static void adcIrqHandler();
+        /** @brief  The active object */
+        static CAdcInjected_ADC1* s_instance;
+        /** @brief  Pin of the channel */
+        PinName m_pin;
+        /** @brief  ADC channel number */
+        uint8_t m_channel;
+        /** @brief  Current in ampere at full scale */
+        const float m_scale;
+        /** @brief  Result of the last conversion */
+        volatile uint16_t m_value;
+        /** @brief  End of conversion callback */
+        mbed::Callback<void()> m_callback;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // ADC_INJECTED_HPP
@@ -0,0 +1,90 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    BridgeUpdate.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the synchronized update of the bridge outputs.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef BRIDGE_UPDATE_HPP
+#define BRIDGE_UPDATE_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/fastio.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Synchronized update of the duty cycle and of the direction pins of a bridge driven by the timer TIM2.
+    * 
+    * The duty cycle is written into the preload register, so the timer applies it only at the update event. When the direction pins 
+    * change, the preload is set to zero and the new command is kept pending. The update interrupt of the first zero period 
+    * changes the direction pins, while the output is low, and it writes the pending duty cycle into the preload register. So each 
+    * period is generated with one consistent command and the bridge doesn't see a driven output with the old direction. 
+    * 
+    * A DMA burst isn't used, because the update request of TIM2 is served by the DMA1, which doesn't access the GPIO ports on AHB1.
+    */
+    class CBridgeUpdate_TIM2
+    {
+    public:
+        /* Constructor */
+        CBridgeUpdate_TIM2(CFastPwmOut& f_pwm, CFastDigitalOut& f_ina, CFastDigitalOut& f_inb);
+        /* Start the synchronized update */
+        bool start();
+        /* Stop the synchronized update */
+        void stop();
+        /* Set the command of the bridge */
+        void write(float f_duty, bool f_ina, bool f_inb);
+        /** @brief  Synchronized update state */
+        bool isStarted() const
+        {
+            return m_started;
+        }
+    private:
+        /* TIM2 interrupt handler */
+        static void timerIrqHandler();
+        /* Apply the pending command */
+        void update();
+        /** @brief  The active object */
+        static CBridgeUpdate_TIM2* s_instance;
+        /** @brief  PWM output of the bridge */
+        CFastPwmOut& m_pwm;
+        /** @brief  Direction pin A */
+        CFastDigitalOut& m_ina;
+        /** @brief  Direction pin B */
+        CFastDigitalOut& m_inb;
+        /** @brief  Applied state of the direction pin A */
+        bool m_stateA;
+        /** @brief  Applied state of the direction pin B */
+        bool m_stateB;
+        /** @brief  Pending duty cycle */
+        float m_pendingDuty;
+        /** @brief  Pending state of the direction pin A */
+        bool m_pendingA;
+        /** @brief  Pending state of the direction pin B */
+        bool m_pendingB;
+        /** @brief  A command waits for the update event */
+        volatile bool m_pending;
+        /** @brief  Synchronized update state */
+        bool m_started;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // BRIDGE_UPDATE_HPP
@@ -0,0 +1,150 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    BusQueue.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the shared transaction
+  *          queue of a non-blocking bus master.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef BUS_QUEUE_HPP
+#define BUS_QUEUE_HPP
+
+#include <mbed.h>
+#include <utils/fmt/format.hpp>
+#include <hardware/drivers/i2cdmamaster.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Shared transaction queue of a non-blocking bus master, the drivers of the devices on the bus submit their register
+    * transfers to it instead of applying the master directly.
+    *
+    * The transactions wait in a fixed-capacity queue, the next one is started from the completion interrupt of the previous one, so
+    * the transfers of several devices follow each other back-to-back and no driver polls the bus. The transaction of the highest
+    * priority is started first, in the same priority the transactions keep their order. The callback of the transaction is applied
+    * from interrupt context after the transfer, a follow-up transfer submitted by it (e.g. the burst after a counter reading) starts
+    * before the waiting transactions of lower priority. A full queue rejects the transaction. The transactions of a device can be
+    * cancelled by its owner handle (stuck transfer), the callback of a cancelled transaction isn't applied.
+    *
+    * The master has the 'read', 'write' and 'abort' methods of the non-blocking masters (CI2cDmaMaster_I2C1), its 'read' and 'write'
+    * return false, when the transfer can't be started.
+    *
+    * @tparam TMaster      type of the bus master
+    * @tparam NCapacity    maximum number of the waiting transactions
+    */
+    template <class TMaster, uint8_t NCapacity>
+    class CBusQueue
+    {
+    public:
+        /** @brief  Callback of the finished transaction, the parameter is true, when the transaction succeeded. */
+        typedef typename TMaster::FDoneCallback FDoneCallback;
+        /** @brief  Priorities of the transactions */
+        enum EPriority{
+            PRIORITY_HIGH = 0,                                          /**< time critical transfers (sensor FIFO) */
+            PRIORITY_NORMAL = 1,                                        /**< periodic measurements */
+            PRIORITY_LOW = 2                                            /**< configuration and diagnosis */
+        };
+
+        /* Constructor */
+        CBusQueue(TMaster& f_master);
+        /* Submit the reading of consecutive registers */
+        bool read(const void* f_owner, EPriority f_priority, uint8_t f_address, uint8_t f_register, uint8_t* f_data, uint16_t f_length, FDoneCallback f_done);
+        /* Submit the writing of consecutive registers */
+        bool write(const void* f_owner, EPriority f_priority, uint8_t f_address, uint8_t f_register, const uint8_t* f_data, uint16_t f_length, FDoneCallback f_done);
+        /* Cancel the waiting and the active transactions of an owner */
+        void cancel(const void* f_owner);
+        /** @brief  A transaction is active */
+        bool isBusy() const
+        {
+            return m_active;
+        }
+        /** @brief  Number of the waiting transactions */
+        uint8_t getQueued() const
+        {
+            return m_count;
+        }
+        /** @brief  Number of the rejected transactions (full queue) */
+        uint32_t getRejected() const
+        {
+            return m_rejected;
+        }
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Transaction of the queue */
+        struct STransaction{
+            /** @brief owner handle of the submitting driver */
+            const void* m_owner;
+            /** @brief buffer of the data, it remains valid until the callback */
+            uint8_t* m_data;
+            /** @brief callback of the finished transaction */
+            FDoneCallback m_done;
+            /** @brief order of the submission */
+            uint32_t m_order;
+            /** @brief number of the data bytes */
+            uint16_t m_length;
+            /** @brief 7-bit device address */
+            uint8_t m_address;
+            /** @brief address of the first register */
+            uint8_t m_register;
+            /** @brief priority (EPriority) */
+            uint8_t m_priority;
+            /** @brief reading transaction */
+            bool m_read;
+        };
+
+        /* Insert a transaction in the queue */
+        bool submit(const STransaction& f_transaction);
+        /* Start the next waiting transaction, when the bus is free */
+        void startNext();
+        /* Completion callback of the master */
+        void done(bool f_success);
+
+        /** @brief  Bus master */
+        TMaster& m_master;
+        /** @brief  Waiting transactions, unordered */
+        STransaction m_slots[NCapacity];
+        /** @brief  Number of the waiting transactions */
+        volatile uint8_t m_count;
+        /** @brief  Active transaction */
+        STransaction m_current;
+        /** @brief  A transaction is active */
+        volatile bool m_active;
+        /** @brief  Order of the next submission */
+        uint32_t m_order;
+        /** @brief  Maximum number of the waiting transactions */
+        uint8_t m_maxCount;
+        /** @brief  Number of the finished transactions */
+        volatile uint32_t m_completed;
+        /** @brief  Number of the failed, cancelled or not started transactions */
+        volatile uint32_t m_failed;
+        /** @brief  Number of the rejected transactions */
+        volatile uint32_t m_rejected;
+    };
+
+    /** @brief  Transaction queue of the I2C1 interface, it's shared by the inertial and the time-of-flight sensors */
+    typedef CBusQueue<CI2cDmaMaster_I2C1,8> CI2cBus_I2C1;
+
+}; // namespace hardware::drivers
+
+#include "busqueue.tpp"
+
+#endif // BUS_QUEUE_HPP
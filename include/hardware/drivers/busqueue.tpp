@@ -0,0 +1,247 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    BusQueue.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the shared transaction
+  *          queue of a non-blocking bus master.
+  ******************************************************************************
+ */
+
+#ifndef BUS_QUEUE_TPP
+#define BUS_QUEUE_TPP
+
+#ifndef BUS_QUEUE_HPP
+#error __FILE__ should only be included from busqueue.hpp.
+#endif // BUS_QUEUE_HPP
+
+namespace hardware::drivers{
+
+    /** \brief  CBusQueue class constructor, the queue is empty.
+     *
+     *  @param f_master        non-blocking bus master, it's started by its owner
+     */
+    template <class TMaster, uint8_t NCapacity>
+    CBusQueue<TMaster,NCapacity>::CBusQueue(TMaster& f_master)
+        : m_master(f_master)
+        , m_slots()
+        , m_count(0)
+        , m_current()
+        , m_active(false)
+        , m_order(0)
+        , m_maxCount(0)
+        , m_completed(0)
+        , m_failed(0)
+        , m_rejected(0)
+    {
+    }
+
+    /** \brief  Submit the reading of consecutive registers
+     *
+     *  @param f_owner         owner handle of the driver, it's applied by the cancellation
+     *  @param f_priority      priority of the transaction
+     *  @param f_address       7-bit device address
+     *  @param f_register      address of the first register
+     *  @param f_data          destination buffer, it has to remain valid until the callback is applied
+     *  @param f_length        number of bytes
+     *  @param f_done          callback of the finished transaction
+     *  @return                true, when the transaction is queued or started, false, when the queue is full
+     */
+    template <class TMaster, uint8_t NCapacity>
+    bool CBusQueue<TMaster,NCapacity>::read(const void* f_owner, EPriority f_priority, uint8_t f_address, uint8_t f_register, uint8_t* f_data, uint16_t f_length, FDoneCallback f_done)
+    {
+        STransaction l_transaction;
+        l_transaction.m_owner = f_owner;
+        l_transaction.m_data = f_data;
+        l_transaction.m_done = f_done;
+        l_transaction.m_length = f_length;
+        l_transaction.m_address = f_address;
+        l_transaction.m_register = f_register;
+        l_transaction.m_priority = f_priority;
+        l_transaction.m_read = true;
+        return submit(l_transaction);
+    }
+
+    /** \brief  Submit the writing of consecutive registers
+     *
+     *  @param f_owner         owner handle of the driver, it's applied by the cancellation
+     *  @param f_priority      priority of the transaction
+     *  @param f_address       7-bit device address
+     *  @param f_register      address of the first register
+     *  @param f_data          source buffer, it has to remain valid until the callback is applied
+     *  @param f_length        number of bytes
+     *  @param f_done          callback of the finished transaction
+     *  @return                true, when the transaction is queued or started, false, when the queue is full
+     */
+    template <class TMaster, uint8_t NCapacity>
+    bool CBusQueue<TMaster,NCapacity>::write(const void* f_owner, EPriority f_priority, uint8_t f_address, uint8_t f_register, const uint8_t* f_data, uint16_t f_length, FDoneCallback f_done)
+    {
+        STransaction l_transaction;
+        l_transaction.m_owner = f_owner;
+        l_transaction.m_data = const_cast<uint8_t*>(f_data);
+        l_transaction.m_done = f_done;
+        l_transaction.m_length = f_length;
+        l_transaction.m_address = f_address;
+        l_transaction.m_register = f_register;
+        l_transaction.m_priority = f_priority;
+        l_transaction.m_read = false;
+        return submit(l_transaction);
+    }
+
+    /** \brief  Cancel the transactions of an owner. The waiting ones are removed, the active one is aborted by the master, then the
+     *  next transaction starts. The callbacks of the cancelled transactions aren't applied.
+     *
+     *  @param f_owner         owner handle of the driver
+     */
+    template <class TMaster, uint8_t NCapacity>
+    void CBusQueue<TMaster,NCapacity>::cancel(const void* f_owner)
+    {
+        core_util_critical_section_enter();
+        for (uint8_t l_idx = 0; l_idx < m_count;)
+        {
+            if (m_slots[l_idx].m_owner == f_owner)
+            {
+                m_slots[l_idx] = m_slots[--m_count];
+                m_failed++;
+            }
+            else
+            {
+                ++l_idx;
+            }
+        }
+        if (m_active && m_current.m_owner == f_owner)
+        {
+            m_master.abort();
+            m_active = false;
+            m_failed++;
+        }
+        core_util_critical_section_exit();
+        startNext();
+    }
+
+    /** \brief  Insert a transaction in the queue, it's started at once, when the bus is free.
+     *
+     *  @param f_transaction   transaction without order
+     *  @return                true, when the transaction is queued
+     */
+    template <class TMaster, uint8_t NCapacity>
+    bool CBusQueue<TMaster,NCapacity>::submit(const STransaction& f_transaction)
+    {
+        core_util_critical_section_enter();
+        if (m_count >= NCapacity)
+        {
+            m_rejected++;
+            core_util_critical_section_exit();
+            return false;
+        }
+        m_slots[m_count] = f_transaction;
+        m_slots[m_count].m_order = m_order++;
+        if (++m_count > m_maxCount)
+        {
+            m_maxCount = m_count;
+        }
+        core_util_critical_section_exit();
+        startNext();
+        return true;
+    }
+
+    /** \brief  Start the next waiting transaction, when the bus is free. The transaction of the highest priority and of the lowest order
+     *  is started, the transaction, which the master can't start, fails and the next one is tried.
+     */
+    template <class TMaster, uint8_t NCapacity>
+    void CBusQueue<TMaster,NCapacity>::startNext()
+    {
+        for (;;)
+        {
+            core_util_critical_section_enter();
+            if (m_active || 0 == m_count)
+            {
+                core_util_critical_section_exit();
+                return;
+            }
+            uint8_t l_best = 0;
+            for (uint8_t l_idx = 1; l_idx < m_count; ++l_idx)
+            {
+                const STransaction& l_slot = m_slots[l_idx];
+                if (l_slot.m_priority < m_slots[l_best].m_priority
+                    || (l_slot.m_priority == m_slots[l_best].m_priority && static_cast<int32_t>(l_slot.m_order - m_slots[l_best].m_order) < 0))
+                {
+                    l_best = l_idx;
+                }
+            }
+            m_current = m_slots[l_best];
+            m_slots[l_best] = m_slots[--m_count];
+            m_active = true;
+            bool l_started = m_current.m_read
+                ? m_master.read(m_current.m_address, m_current.m_register, m_current.m_data, m_current.m_length, mbed::callback(this,&CBusQueue::done))
+                : m_master.write(m_current.m_address, m_current.m_register, m_current.m_data, m_current.m_length, mbed::callback(this,&CBusQueue::done));
+            if (l_started)
+            {
+                core_util_critical_section_exit();
+                return;
+            }
+            m_active = false;
+            m_failed++;
+            FDoneCallback l_done = m_current.m_done;
+            core_util_critical_section_exit();
+            if (l_done)
+            {
+                l_done(false);
+            }
+        }
+    }
+
+    /** \brief  Completion callback of the master, it's applied from interrupt context. The callback of the transaction is applied,
+     *  then the next transaction is started.
+     *
+     *  @param f_success       result of the transfer
+     */
+    template <class TMaster, uint8_t NCapacity>
+    void CBusQueue<TMaster,NCapacity>::done(bool f_success)
+    {
+        FDoneCallback l_done = m_current.m_done;
+        m_active = false;
+        if (f_success)
+        {
+            m_completed++;
+        }
+        else
+        {
+            m_failed++;
+        }
+        if (l_done)
+        {
+            l_done(f_success);
+        }
+        startNext();
+    }
+
+    /** \brief  Serial callback method, it responses 'queued;maximum queued;completed;failed;rejected;;'.
+     *
+     *  @param a               input received string
+     *  @param b               output reponse message
+     */
+    template <class TMaster, uint8_t NCapacity>
+    void CBusQueue<TMaster,NCapacity>::serialCallback(char const * a, char * b)
+    {
+        utils::fmt::CWriter(b).udec(m_count).udec(m_maxCount).udec(m_completed).udec(m_failed).udec(m_rejected).chr(';');
+    }
+
+}; // namespace hardware::drivers
+
+#endif // BUS_QUEUE_TPP
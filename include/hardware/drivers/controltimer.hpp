@@ -0,0 +1,105 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ControlTimer.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the hardware timer of the control loop.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CONTROL_TIMER_HPP
+#define CONTROL_TIMER_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Periodic interrupt source based on the timer TIM10, it drives the control loop with fixed phase and without scheduler jitter. 
+    * 
+    * The update interrupt of the timer applies the attached callback from interrupt context. The TIM2, TIM3 and TIM4 timers are used by 
+    * the PWM outputs of the motors and by the quadrature counter, the TIM5 by the microsecond ticker of mbed, so the free TIM10 is used. 
+    * Its update interrupt is shared with the TIM1, which isn't used.
+    * 
+    * The period can be trimmed by fractions of a timer count (setTrim), the fraction is dithered over the periods, and a single period can
+    * be stretched or shortened (step), so the tick can be disciplined to an external reference (utils::can::CTickSync). The cycle counter
+    * is read at each update event, it's the time of the last tick.
+    */
+    class CControlTimer_TIM10
+    {
+    public:
+        /* Constructor */
+        CControlTimer_TIM10();
+        /* Attach the callback */
+        void attach(mbed::Callback<void()> f_callback);
+        /* Start the periodic interrupt */
+        bool start(float f_period);
+        /* Stop the periodic interrupt */
+        void stop();
+        /* Trim the period by timer counts */
+        void setTrim(float f_counts);
+        /* Stretch or shorten the next period once */
+        void step(int32_t f_counts);
+        /** @brief  Trim of the period in timer counts */
+        float getTrim() const
+        {
+            return m_trim + m_trimFraction / 65536.0f;
+        }
+        /** @brief  Duration of a timer count in second, zero before the start */
+        float getCountPeriod() const
+        {
+            return m_countPeriod;
+        }
+        /** @brief  Cycle counter at the last update event */
+        uint32_t getTickCycles() const
+        {
+            return m_tickCycles;
+        }
+        /** @brief  Number of the periods, when the callback was still running at the next update event */
+        uint32_t getOverruns() const
+        {
+            return m_overruns;
+        }
+    private:
+        /* TIM10 update interrupt handler */
+        static void timerIrqHandler();
+        /** @brief  The active timer object */
+        static CControlTimer_TIM10* s_instance;
+        /** @brief  Callback applied in each period */
+        mbed::Callback<void()> m_callback;
+        /** @brief  Number of the overruns */
+        volatile uint32_t m_overruns;
+        /** @brief  Auto-reload value of the untrimmed period */
+        uint32_t m_reload;
+        /** @brief  Duration of a timer count in second */
+        float m_countPeriod;
+        /** @brief  Integer part of the trim */
+        volatile int32_t m_trim;
+        /** @brief  Fractional part of the trim in 1/65536 count */
+        volatile uint32_t m_trimFraction;
+        /** @brief  Accumulated fraction of the dithering */
+        uint32_t m_trimAccumulator;
+        /** @brief  One-shot change of the next period */
+        volatile int32_t m_step;
+        /** @brief  Cycle counter at the last update event */
+        volatile uint32_t m_tickCycles;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // CONTROL_TIMER_HPP
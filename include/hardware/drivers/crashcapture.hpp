@@ -0,0 +1,120 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  ******************************************************************************
+  * @file    CrashCapture.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the crash capture.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CRASH_CAPTURE_HPP
+#define CRASH_CAPTURE_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Crash capture, it stores a record of the HardFault, of the fatal errors (mbed 'error', RTX stack overflow) and of the 
+    * 'mbed_die' in the '.noinit' section and it resets the microcontroller immediately, so the platform doesn't wait for the watchdog. 
+    * 
+    * The HardFault handler saves the stacked registers, the fault status and address registers, the running task of each priority 
+    * class and a short stack trace: the words above the exception frame, which can be return addresses into the code (flash or 
+    * '.ramfunc'). The configurable faults (MemManage, BusFault, UsageFault) aren't enabled, so they are escalated to HardFault. 
+    * After the reset the record is validated and it's reported once ('@CRSH' message), it's kept for the 'CRSH' key until the next crash.
+    */
+    class CCrashCapture
+    {
+    public:
+        /** @brief  Causes of the crash */
+        enum ECause
+        {
+            CAUSE_NONE = 0,                                             /**< no crash was captured */
+            CAUSE_HARD_FAULT,                                           /**< HardFault exception */
+            CAUSE_ERROR,                                                /**< fatal error of mbed or of the RTX (stack overflow) */
+            CAUSE_DIE                                                   /**< mbed_die */
+        };
+        /** @brief  Number of the words of the stack trace */
+        static const uint32_t s_traceDepth = 8;
+        /** @brief  Number of the searched words above the exception frame */
+        static const uint32_t s_traceSearch = 64;
+        /** @brief  Length of the stored error message */
+        static const uint32_t s_messageLength = 40;
+        /** @brief  Record of the crash, it has to be placed in the '.noinit' section without initializer */
+        struct SRecord
+        {
+            /** @brief identifier of the valid record */
+            uint32_t m_magic;
+            /** @brief number of the crashes since the power on */
+            uint32_t m_count;
+            /** @brief the record was reported after the reset */
+            uint32_t m_isReported;
+            /** @brief cause of the crash (ECause) */
+            uint32_t m_cause;
+            /** @brief stacked registers: r0, r1, r2, r3, r12, lr, pc, xpsr */
+            uint32_t m_frame[8];
+            /** @brief link register of the exception (EXC_RETURN) */
+            uint32_t m_excReturn;
+            /** @brief stack pointer before the exception */
+            uint32_t m_sp;
+            /** @brief fault status and address registers: CFSR, HFSR, MMFAR, BFAR */
+            uint32_t m_status[4];
+            /** @brief index of the running task in each priority class, -1 when no task runs */
+            int32_t m_tasks[utils::task::g_priorityClassCount];
+            /** @brief possible return addresses from the stack, zero for the unused words */
+            uint32_t m_trace[s_traceDepth];
+            /** @brief error message */
+            char m_message[s_messageLength];
+            /** @brief check value of the record */
+            uint32_t m_check;
+        };
+
+        /* Attach the memory of the record and validate it */
+        static bool attach(SRecord& f_record);
+        /* A new crash record was found after the reset */
+        static bool isPending();
+        /* Mark the record as reported */
+        static void acknowledge();
+        /* Format the record */
+        static void format(char* f_buffer, uint32_t f_size);
+        /* Serial callback of the last record */
+        static void serialCallback(char const * a, char * b);
+        /* Capture the HardFault and reset */
+        static void captureFault(const uint32_t* f_frame, uint32_t f_excReturn);
+        /* Capture a fatal error and reset */
+        static void captureError(ECause f_cause, const char* f_message, uint32_t f_pc, uint32_t f_sp);
+    private:
+        /** @brief  Identifier of the valid record */
+        static const uint32_t s_magic = 0x43525348;
+        /* Start a new record */
+        static void begin(ECause f_cause);
+        /* Search the return addresses on the stack */
+        static void trace(uint32_t f_sp);
+        /* Close the record and reset */
+        static void finish();
+        /* Check value of the record */
+        static uint32_t check(const SRecord& f_record);
+        /** @brief  Memory of the record, NULL before the attach */
+        static SRecord* s_record;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // CRASH_CAPTURE_HPP
@@ -30,6 +30,8 @@ limitations under the License.
 
 /* The mbed library */
 #include <mbed.h>
+#include <hardware/drivers/fastio.hpp>
+#include <hardware/drivers/bridgeupdate.hpp>
 /* Functions to compute common mathematical operations and transformations */
 #include <cmath>
 
@@ -46,6 +48,8 @@ namespace hardware::drivers{
     /**
      * @brief Command setter interface.
      * 
+     * Besides the drive commands the bridge can coast (the motor is disconnected and it freewheels) and it can brake proportionally 
+     * (the motor is shorted for the given part of the pwm period), the full braking is the proportional braking with one duty cycle.
      */
     class IMotorCommand{
         public:
@@ -53,6 +57,8 @@ namespace hardware::drivers{
             virtual void brake() = 0;
             virtual void inverseDirection(float f_pwm) = 0;
             virtual bool inRange(float f_pwm) =0;
+            virtual void coast() = 0;
+            virtual void dynamicBrake(float f_duty) = 0;
     };
 
     /**
@@ -64,6 +70,21 @@ namespace hardware::drivers{
      * similary negative values represent the backward move. The magnitude of values gives the motor speed. So generally, 
      * the input signal can vary between [-1,1]. We reduce this interval to avoid the robot high speed.  
      * 
+     * With the fast path the outputs are written directly to the compare register of the timer and to the bit set/reset registers 
+     * of the direction pins, without HAL computation and critical sections. In the synchronized mode the duty cycle and the 
+     * direction are applied together at the update event of the timer, see CBridgeUpdate_TIM2.
+     * 
+     * The 'trip' method forces the pwm output inactive without waiting the update event, it's applied from the overcurrent interrupt. 
+     * The commands are still written, but the bridge isn't driven until the 'release'.
+     * 
+     * The pwm input of the VNH modulates the low side switches. With both direction inputs low the low sides short the motor during 
+     * the active part of the period (brake to ground) and all switches are off during the rest, so the duty cycle of this state is the 
+     * proportional dynamic braking and the zero duty cycle is the coasting. The recirculation of the drive is fixed by the device.
+     * 
+     * The pwm starts at 5 kHz, 'setPwmFrequency' changes it up to the 20 kHz limit of the VNH5019 without the prescaler of the timer, 
+     * so the duty cycle keeps the resolution of the timer clock (4200 steps at 20 kHz). The higher frequency lowers the current ripple 
+     * and the audible noise, but the switching losses of the bridge grow with it.
+     * 
      */
     class CMotorDriverVnh:public ICurrentGetter, public IMotorCommand
     {
@@ -80,23 +101,62 @@ namespace hardware::drivers{
         void brake();
         /* Inverse */
         void inverseDirection(float f_pwm);
+        /* Coast */
+        void coast();
+        /* Proportional dynamic braking */
+        void dynamicBrake(float f_duty);
         /* Get current */
         float getCurrent();
         /* Check the allowed range */
         bool inRange(float f_pwm);
+        /* Enable the direct register access of the outputs */
+        void setFastPath(bool f_enable);
+        /* Enable the update of the outputs at the update event of the timer */
+        bool setSynchronized(bool f_enable);
+        /* Change the frequency of the pwm */
+        bool setPwmFrequency(float f_frequency);
+        /** @brief Frequency of the pwm in Hz */
+        float getPwmFrequency() const
+        {
+            return m_pwm.getFrequency();
+        }
+        /* Switch off the bridge immediately */
+        void trip();
+        /* Release the bridge after a trip */
+        void release();
+        /** @brief The bridge is switched off by a trip */
+        bool isTripped() const
+        {
+            return m_tripped;
+        }
+        /** @brief Duty cycle of the pwm output in interval [0,1] */
+        float getDuty() const
+        {
+            return m_pwm.readFast();
+        }
+        /** @brief Lowest frequency of the pwm in Hz */
+        static constexpr float s_minPwmFrequency = 1000.0f;
+        /** @brief Highest frequency of the pwm in Hz, the limit of the VNH5019 */
+        static constexpr float s_maxPwmFrequency = 20000.0f;
         
     private:
         /** @brief PWM output pin */
-        PwmOut      m_pwm;
+        CFastPwmOut      m_pwm;
         /** @brief pin A for direction */
-        DigitalOut  m_ina;
+        CFastDigitalOut  m_ina;
         /** @brief pin B for direction */
-        DigitalOut  m_inb;
+        CFastDigitalOut  m_inb;
+        /** @brief Synchronized update of the outputs */
+        CBridgeUpdate_TIM2 m_bridge;
         /** @brief Measured current value by driver */
         AnalogIn    m_current_in;
 
         const float m_inf_limit;
         const float m_sup_limit;
+        /** @brief Direct register access of the outputs */
+        bool m_fastPath;
+        /** @brief The pwm output is forced inactive by a trip */
+        volatile bool m_tripped;
     };
 
 
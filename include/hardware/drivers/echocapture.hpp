@@ -0,0 +1,81 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  * @file    EchoCapture.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the DMA based pulse width capture of an ultrasonic echo.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ECHO_CAPTURE_HPP
+#define ECHO_CAPTURE_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Capture of the echo pulse of an ultrasonic sensor on PA6 (D12) by the input capture of TIM3 channel 1.
+    *
+    * Both edges latch the counter into CCR1 and the DMA1 stream 4 (channel 5) copies the two values into a buffer, so the echo
+    * doesn't have interrupt. The TIM3 generates the pwm of the steering servo on channel 2 (D9), its prescaler and period are kept,
+    * only the channel 1 is configured: the resolution is one counter tick (1 us by the 50 Hz servo pwm) and the captured values
+    * wrap with the period of the servo. The whole periods of a longer pulse are resolved by the caller from the elapsed time.
+    *
+    * The servo pwm has to be configured before the start of the capture.
+    */
+    class CEchoCapture_TIM3
+    {
+    public:
+        /* Constructor */
+        CEchoCapture_TIM3();
+        /* Configure the channel and the DMA */
+        void start();
+        /* Prepare the capture of the next pulse */
+        void arm();
+        /* Get the width of the captured pulse */
+        bool read(uint32_t& f_ticks) const;
+        /** @brief  Number of the captured edges since the arming */
+        uint8_t getEdges() const
+        {
+            return static_cast<uint8_t>(2 - DMA1_Stream4->NDTR);
+        }
+        /** @brief  Frequency of the counter in Hz, the APB1 timer clock is the core clock */
+        static uint32_t getFrequency()
+        {
+            return SystemCoreClock / (TIM3->PSC + 1);
+        }
+        /** @brief  Number of the counter ticks in a period of the timer */
+        static uint32_t getPeriodTicks()
+        {
+            return TIM3->ARR + 1;
+        }
+        /** @brief  The capture was started */
+        bool isStarted() const
+        {
+            return m_started;
+        }
+    private:
+        /** @brief  Counter values of the rising and the falling edge, they are written by the DMA */
+        volatile uint16_t m_edges[2];
+        /** @brief  The capture was started */
+        bool m_started;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // ECHO_CAPTURE_HPP
@@ -0,0 +1,72 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  * @file    EdgeCaptureDma.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the DMA based edge timestamp capture of a single channel sensor.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef EDGE_CAPTURE_DMA_HPP
+#define EDGE_CAPTURE_DMA_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Timestamp capture of the rising edges of a single channel wheel sensor on PA8 (D7) by the input capture of TIM1 channel 1.
+    * 
+    * The timer counts with 100 kHz, each edge latches the counter into CCR1 and the DMA2 stream 3 copies it into a circular 
+    * buffer, so the edges don't have interrupt. The reader gets the number of the new edges from the position of the DMA and 
+    * the timestamp of the last one. The buffer has to be read before it wraps, at 1 kHz reading up to 31 kHz edge rate.
+    */
+    class CEdgeCaptureDma_TIM1
+    {
+    public:
+        /** @brief  Frequency of the timestamps in Hz */
+        static const uint32_t s_frequency = 100000;
+        /** @brief  Size of the circular buffer of the timestamps */
+        static const uint16_t s_bufferSize = 32;
+        /* Constructor */
+        CEdgeCaptureDma_TIM1();
+        /* Start the capture */
+        void start();
+        /* Get the new edges since the previous reading */
+        uint16_t read(uint16_t& f_last);
+        /** @brief  Current value of the timestamp counter */
+        static uint16_t now()
+        {
+            return static_cast<uint16_t>(TIM1->CNT);
+        }
+        /** @brief  The capture was started */
+        bool isStarted() const
+        {
+            return m_started;
+        }
+    private:
+        /** @brief  Circular buffer of the captured timestamps, it's written by the DMA */
+        volatile uint16_t m_buffer[s_bufferSize];
+        /** @brief  Index of the next unread timestamp */
+        uint16_t m_readIndex;
+        /** @brief  The capture was started */
+        bool m_started;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // EDGE_CAPTURE_DMA_HPP
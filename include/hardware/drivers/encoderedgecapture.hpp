@@ -0,0 +1,89 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    EncoderEdgeCapture.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the edge timestamp capture of the quadrature encoder.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ENCODER_EDGE_CAPTURE_HPP
+#define ENCODER_EDGE_CAPTURE_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+    /** @brief Timestamp and position of an encoder edge */
+    struct SEncoderEdge{
+        /** @brief timestamp in cpu cycles (DWT cycle counter) */
+        uint32_t m_cycles;
+        /** @brief raw value of the TIM4 counter at the edge */
+        uint16_t m_position;
+        /** @brief number of the captured edges, it shows the new edges */
+        uint32_t m_edgeCount;
+    };
+
+   /**
+    * @brief Timestamp capture of the rising edges of the encoder channel A (PB6) for the period measurement at low speed.
+    * 
+    * The pins of the encoder are routed only to the TIM4, which decodes the quadrature signal, so the edges are captured by the 
+    * EXTI line 6 without changing the alternate function of the pin. The interrupt stamps the edge with the cycle counter and 
+    * with the position of TIM4. It's enabled only at low speed, so the interrupt rate stays bounded.
+    */
+    class CEncoderEdgeCapture_TIM4
+    {
+    public:
+        /* Constructor */
+        CEncoderEdgeCapture_TIM4();
+        /* Enable the capture */
+        void enable();
+        /* Disable the capture */
+        void disable();
+        /** @brief  State of the capture */
+        bool isEnabled() const
+        {
+            return m_enabled;
+        }
+        /* Get the last captured edge */
+        SEncoderEdge getLastEdge();
+        /** @brief  Current timestamp in cpu cycles */
+        static uint32_t cycles()
+        {
+            return DWT->CYCCNT;
+        }
+        /** @brief  Number of the captured edges between two quadrature positions, the rising edges of a channel are four impulses away */
+        static const uint8_t s_edgeDistance = 4;
+    private:
+        /* EXTI line 9..5 interrupt handler */
+        static void extiIrqHandler();
+        /** @brief  The active capture object */
+        static CEncoderEdgeCapture_TIM4* s_instance;
+        /** @brief  Previous handler of the shared interrupt */
+        static uint32_t s_prevExtiHandler;
+        /** @brief  Last captured edge */
+        SEncoderEdge m_lastEdge;
+        /** @brief  Flag to notice the configured state of the EXTI line */
+        bool m_initialized;
+        /** @brief  State of the capture */
+        volatile bool m_enabled;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // ENCODER_EDGE_CAPTURE_HPP
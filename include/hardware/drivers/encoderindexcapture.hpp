@@ -0,0 +1,77 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  * @file    EncoderIndexCapture.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the capture of the index pulse of the quadrature encoder.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef ENCODER_INDEX_CAPTURE_HPP
+#define ENCODER_INDEX_CAPTURE_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+    /** @brief Position of the last index pulse */
+    struct SEncoderIndex{
+        /** @brief raw value of the TIM4 counter at the index pulse */
+        uint16_t m_position;
+        /** @brief number of the captured index pulses, it shows the new pulses */
+        uint32_t m_indexCount;
+    };
+
+   /**
+    * @brief Capture of the index (Z) pulse of the encoder on PB4 (D5), it latches the position of TIM4 once per revolution.
+    * 
+    * The channels 3 and 4 of TIM4 (PB8, PB9) are applied by the I2C bus, so the index pulse cannot be captured by the timer. 
+    * The rising edge triggers the EXTI line 4, which has its own interrupt, and the handler reads the TIM4 counter as its first 
+    * access. The latency of the interrupt is below one impulse up to some hundred rps. 
+    */
+    class CEncoderIndexCapture_TIM4
+    {
+    public:
+        /* Constructor */
+        CEncoderIndexCapture_TIM4();
+        /* Enable the capture */
+        void enable();
+        /* Disable the capture */
+        void disable();
+        /** @brief  State of the capture */
+        bool isEnabled() const
+        {
+            return m_enabled;
+        }
+        /* Get the last captured index pulse */
+        SEncoderIndex getLastIndex();
+    private:
+        /* EXTI line 4 interrupt handler */
+        static void extiIrqHandler();
+        /** @brief  The active capture object */
+        static CEncoderIndexCapture_TIM4* s_instance;
+        /** @brief  Last captured index pulse */
+        SEncoderIndex m_lastIndex;
+        /** @brief  Flag to notice the configured state of the EXTI line */
+        bool m_initialized;
+        /** @brief  State of the capture */
+        volatile bool m_enabled;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // ENCODER_INDEX_CAPTURE_HPP
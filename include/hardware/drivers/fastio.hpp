@@ -0,0 +1,128 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    FastIO.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the direct register access of the pwm and digital outputs.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef FAST_IO_HPP
+#define FAST_IO_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief PWM output with direct register access.
+    * 
+    * The mbed object configures the pin and the timer, then the 'latch' method saves the compare register of the channel and the 
+    * scale of the duty cycle from the auto-reload register. The 'writeFast' method writes only the compare register, without HAL 
+    * computation and critical section. The 'latch' has to be applied after each change of the period.
+    */
+    class CFastPwmOut: public PwmOut
+    {
+    public:
+        /* Constructor */
+        CFastPwmOut(PinName f_pin);
+        /* Keep the duty cycle assignment of the base class */
+        using PwmOut::operator=;
+        /* Save the registers of the channel */
+        void latch();
+        /* Enable the preload of the compare and the auto-reload registers */
+        void setPreload(bool f_enable);
+        /* Change the frequency of the timer, the duty cycle is kept */
+        bool setFrequency(float f_frequency);
+        /** @brief  Frequency of the timer in Hz */
+        float getFrequency() const
+        {
+            return static_cast<float>(timerClock()) / (static_cast<float>(m_timer->PSC + 1) * m_scale);
+        }
+        /** @brief  Set the duty cycle in interval [0,1] by writing the compare register */
+        void writeFast(float f_duty)
+        {
+            f_duty = (f_duty < 0.0f) ? 0.0f : ((f_duty > 1.0f) ? 1.0f : f_duty);
+            *m_ccr = static_cast<uint32_t>(f_duty * m_scale);
+        }
+        /** @brief  Duty cycle of the compare register, it can differ from the active one with preload */
+        float readFast() const
+        {
+            return static_cast<float>(*m_ccr) / m_scale;
+        }
+        /* Force the output inactive immediately */
+        void setForcedInactive(bool f_enable);
+        /** @brief  Timer of the output */
+        TIM_TypeDef* getTimer() const
+        {
+            return m_timer;
+        }
+        /** @brief  Compare register of the output */
+        volatile uint32_t* getCompareRegister() const
+        {
+            return m_ccr;
+        }
+    private:
+        /* Clock of the timer */
+        uint32_t timerClock() const;
+
+        /** @brief  Timer of the output */
+        TIM_TypeDef* m_timer;
+        /** @brief  Compare register of the channel */
+        volatile uint32_t* m_ccr;
+        /** @brief  Channel of the timer (1..4) */
+        uint8_t m_channel;
+        /** @brief  Number of the timer ticks in a period */
+        float m_scale;
+    };
+
+   /**
+    * @brief Digital output with direct register access, the 'writeFast' method writes only the bit set/reset register.
+    */
+    class CFastDigitalOut: public DigitalOut
+    {
+    public:
+        /* Constructor */
+        CFastDigitalOut(PinName f_pin);
+        /* Keep the state assignment of the base class */
+        using DigitalOut::operator=;
+        /** @brief  Set the output state by the bit set/reset register */
+        void writeFast(bool f_value)
+        {
+            *m_bsrr = f_value ? m_mask : (m_mask << 16);
+        }
+        /** @brief  Bit set/reset register of the port */
+        volatile uint32_t* getBsrr() const
+        {
+            return m_bsrr;
+        }
+        /** @brief  Set mask of the pin in the bit set/reset register, the reset mask is shifted by 16 */
+        uint32_t getMask() const
+        {
+            return m_mask;
+        }
+    private:
+        /** @brief  Bit set/reset register of the port */
+        volatile uint32_t* m_bsrr;
+        /** @brief  Mask of the pin */
+        uint32_t m_mask;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // FAST_IO_HPP
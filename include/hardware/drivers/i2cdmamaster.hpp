@@ -0,0 +1,124 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    I2cDmaMaster.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the non-blocking I2C master.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef I2C_DMA_MASTER_HPP
+#define I2C_DMA_MASTER_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Non-blocking register access master of the I2C1 interface (PB_8 SCL, PB_9 SDA). 
+    * 
+    * The transactions are driven by the event and the error interrupts of the peripheral, the read data are copied by the stream 0 
+    * of DMA1 (channel 1), so a burst read of a sensor FIFO doesn't load the processor. The end of the transaction is signaled by the 
+    * callback from interrupt context, only one transaction can be active.
+    * 
+    * The pins and the clock are configured by the mbed I2C object, it can be applied for the blocking configuration of the devices. 
+    * After the 'start' method the mbed object mustn't be used.
+    */
+    class CI2cDmaMaster_I2C1
+    {
+    public:
+        /** @brief  Callback of the finished transaction, the parameter is true, when the transaction succeeded. */
+        typedef mbed::Callback<void(bool)> FDoneCallback;
+
+        /* Constructor */
+        CI2cDmaMaster_I2C1();
+        /* Install the interrupt handlers */
+        void start();
+        /* Start the reading of consecutive registers */
+        bool read(uint8_t f_address, uint8_t f_register, uint8_t* f_data, uint16_t f_length, FDoneCallback f_done);
+        /* Start the writing of consecutive registers */
+        bool write(uint8_t f_address, uint8_t f_register, const uint8_t* f_data, uint16_t f_length, FDoneCallback f_done);
+        /* Abort the active transaction */
+        void abort();
+        /** @brief  The interrupt handlers are installed */
+        bool isStarted() const
+        {
+            return s_instance == this;
+        }
+        /** @brief  A transaction is active */
+        bool isBusy() const
+        {
+            return m_state != IDLE;
+        }
+        /** @brief  Number of the failed transactions */
+        uint32_t getErrors() const
+        {
+            return m_errors;
+        }
+    private:
+        /** @brief  States of the transaction */
+        enum EState{
+            IDLE,                                                       /**< no active transaction */
+            START,                                                      /**< start condition for the register address */
+            ADDRESS,                                                    /**< device address for the register write */
+            WRITE,                                                      /**< register address and data bytes */
+            RESTART,                                                    /**< repeated start condition for the reading */
+            READ_ADDRESS,                                               /**< device address for the reading */
+            READ_SINGLE,                                                /**< single byte reading without DMA */
+            READ_DMA                                                    /**< reading by DMA */
+        };
+
+        /* Start the transaction */
+        bool begin(uint8_t f_address, uint8_t f_register, uint8_t* f_data, uint16_t f_length, bool f_read, FDoneCallback f_done);
+        /* Finish the transaction and apply the callback */
+        void finish(bool f_success);
+        /* I2C1 event interrupt handler */
+        static void eventIrqHandler();
+        /* I2C1 error interrupt handler */
+        static void errorIrqHandler();
+        /* DMA1 stream 0 interrupt handler */
+        static void dmaIrqHandler();
+        /** @brief  Maximum number of polling of the previous stop condition (about 20 us at 84 MHz) */
+        static const uint32_t s_stopWaitLoops = 400;
+        /** @brief  The active master object */
+        static CI2cDmaMaster_I2C1* s_instance;
+
+        /** @brief  State of the transaction */
+        volatile EState m_state;
+        /** @brief  Reading transaction */
+        bool m_read;
+        /** @brief  7-bit device address */
+        uint8_t m_address;
+        /** @brief  Register address */
+        uint8_t m_register;
+        /** @brief  Data buffer of the transaction */
+        uint8_t* m_data;
+        /** @brief  Number of the data bytes */
+        uint16_t m_length;
+        /** @brief  Number of the written data bytes */
+        uint16_t m_written;
+        /** @brief  Callback of the finished transaction */
+        FDoneCallback m_done;
+        /** @brief  Number of the failed transactions */
+        volatile uint32_t m_errors;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // I2C_DMA_MASTER_HPP
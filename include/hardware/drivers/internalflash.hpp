@@ -0,0 +1,73 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  ******************************************************************************
+  * @file    InternalFlash.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the internal flash memory.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef INTERNAL_FLASH_HPP
+#define INTERNAL_FLASH_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Erase and programming of the internal flash memory by the registers of the flash interface.
+    * 
+    * The memory has a single bank, so the code and the interrupts executed from the flash are stalled during the operations: 
+    * a word is programmed in about 16 us, a 128 KByte sector is erased in 1-2 s. The programming uses 32-bit parallelism, 
+    * it requires a supply voltage above 2.7 V. The erased state of the memory is 0xFF.
+    */
+    class CInternalFlash
+    {
+    public:
+        /** @brief  Description of a sector */
+        struct SSector
+        {
+            /** @brief  Number of the sector in the flash interface */
+            uint8_t m_number;
+            /** @brief  Start address */
+            uint32_t m_address;
+            /** @brief  Size in byte */
+            uint32_t m_size;
+        };
+        /* Erase a sector */
+        static bool erase(const SSector& f_sector);
+        /* Program words */
+        static bool program(uint32_t f_address, const uint32_t* f_data, uint32_t f_count);
+        /* The area isn't used by the program image */
+        static bool isFree(uint32_t f_address);
+
+        /** @brief  Value of an erased word */
+        static const uint32_t s_erased = 0xFFFFFFFF;
+    private:
+        /* Unlock the control register */
+        static void unlock();
+        /* Wait the end of the operation and clear the flags */
+        static bool wait();
+        /* Reset the caches of the flash interface */
+        static void flushCaches();
+    };
+
+}; // namespace hardware::drivers
+
+#endif // INTERNAL_FLASH_HPP
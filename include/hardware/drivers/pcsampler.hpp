@@ -0,0 +1,68 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    PcSampler.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the program counter sampler
+  *          of the statistical profiler.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef PC_SAMPLER_HPP
+#define PC_SAMPLER_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Periodic sampler of the interrupted program counter based on the timer TIM11.
+    * 
+    * The update interrupt handler reads the return address from the exception frame of the interrupted context (process stack for 
+    * the threads, main stack for the interrupts) and it applies the attached function with it. The interrupt has the highest priority, 
+    * so the other interrupt handlers are also sampled, except the ones on the same priority (ADC). The SysTick drives the RTOS, so the 
+    * free TIM11 is used, its interrupt is shared with the TIM1 trigger, which isn't used.
+    */
+    class CPcSampler_TIM11
+    {
+    public:
+        /** @brief  Function applied with the sampled address from interrupt context */
+        typedef void (*FSampleHook)(uint32_t f_pc);
+        /* Attach the hook */
+        static void attach(FSampleHook f_hook);
+        /* Start the sampling */
+        static bool start(float f_frequency);
+        /* Stop the sampling */
+        static void stop();
+        /** @brief  The sampling is running */
+        static bool isRunning()
+        {
+            return (TIM11->CR1 & TIM_CR1_CEN) != 0;
+        }
+        /* Apply the sampled address, it's applied by the interrupt handler */
+        static void sample(uint32_t f_pc);
+    private:
+        /* TIM11 update interrupt handler */
+        static void timerIrqHandler();
+        /** @brief  The attached hook */
+        static FSampleHook s_hook;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // PC_SAMPLER_HPP
@@ -0,0 +1,70 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ScopeTimer.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the sampling timer
+  *          of the signal scope.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SCOPE_TIMER_HPP
+#define SCOPE_TIMER_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Sampling timer of the signal scope based on the timer TIM9.
+    * 
+    * The update interrupt applies the attached hook in each period, up to a few ten kilohertz. The TIM9 is free on the BFMC wiring, 
+    * its interrupt is shared with the TIM1 break, which isn't used. The interrupt has the highest priority like the program counter 
+    * sampler, so a sample is delayed only by the handlers on the same priority (control timer, ADC), it's lost, when such a handler 
+    * takes longer than a period.
+    */
+    class CScopeTimer_TIM9
+    {
+    public:
+        /** @brief  Function applied in each period from interrupt context */
+        typedef void (*FSampleHook)();
+        /* Attach the hook */
+        static void attach(FSampleHook f_hook);
+        /* Start the sampling */
+        static bool start(float f_frequency);
+        /* Stop the sampling */
+        static void stop();
+        /** @brief  The sampling is running */
+        static bool isRunning()
+        {
+            return (TIM9->CR1 & TIM_CR1_CEN) != 0;
+        }
+        /* Realized sampling frequency in Hz */
+        static float getFrequency();
+    private:
+        /* Clock of the timer */
+        static uint32_t timerClock();
+        /* TIM9 update interrupt handler */
+        static void timerIrqHandler();
+        /** @brief  The attached hook */
+        static FSampleHook s_hook;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // SCOPE_TIMER_HPP
@@ -0,0 +1,87 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  * @file    SdCardSpi.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the SD card in SPI mode with DMA sector writes.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SD_CARD_SPI_HPP
+#define SD_CARD_SPI_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/fastio.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief SD card on SPI3 (PC10 SCK, PC11 MISO, PC12 MOSI) in SPI mode, the sectors are written by the multiple block write.
+    *
+    * The initialization and the commands exchange single bytes by polling. The data of a sector is transmitted by the stream 7 of
+    * DMA1 (channel 0), the cpu only starts it and checks its end. The writing is split in non-blocking steps: 'startSector' sends the
+    * start token and starts the DMA, 'finishSector' sends the CRC after the DMA and checks the data response, 'isReady' checks the
+    * busy state of the card, while it programs the flash. So the caller (a task) doesn't wait for the card between the steps.
+    *
+    * The SDHC/SDXC cards are addressed by sectors, the SDSC cards by bytes, the difference is hidden by the sector address.
+    */
+    class CSdCardSpi_SPI3
+    {
+    public:
+        /** @brief  Size of a sector in byte */
+        static const uint32_t s_sectorSize = 512;
+        /* Constructor */
+        CSdCardSpi_SPI3(PinName f_chipSelect);
+        /* Initialize the card */
+        bool initialize();
+        /** @brief  The card is initialized */
+        bool isInitialized() const
+        {
+            return m_initialized;
+        }
+        /* Start the multiple block write from a sector */
+        bool startWrite(uint32_t f_sector);
+        /* Start the DMA transfer of a sector */
+        bool startSector(const uint8_t* f_data);
+        /* It returns true, when the DMA transfer of the sector is finished */
+        bool isTransferred() const;
+        /* Finish the sector after the DMA transfer */
+        bool finishSector();
+        /* It returns true, when the card isn't busy */
+        bool isReady();
+        /* Stop the multiple block write */
+        bool stopWrite();
+    private:
+        /* Exchange a byte */
+        uint8_t exchange(uint8_t f_byte);
+        /* Send a command and read the first response byte */
+        uint8_t command(uint8_t f_index, uint32_t f_argument);
+        /* Wait the end of the busy state */
+        bool waitReady(uint32_t f_timeout);
+        /* Set the clock divider of the SPI */
+        void setPrescaler(uint32_t f_prescaler);
+        /** @brief  Chip select of the card, active low */
+        CFastDigitalOut m_chipSelect;
+        /** @brief  The card is initialized */
+        bool m_initialized;
+        /** @brief  The card is addressed by sectors (SDHC/SDXC) */
+        bool m_blockAddressing;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // SD_CARD_SPI_HPP
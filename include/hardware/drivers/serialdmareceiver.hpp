@@ -0,0 +1,173 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SerialDmaReceiver.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the DMA based serial receiver.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SERIAL_DMA_RECEIVER_HPP
+#define SERIAL_DMA_RECEIVER_HPP
+
+#include <mbed.h>
+#include <utils/serial/serialreceiver.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief DMA based receiver for the USART2 (USBTX, USBRX) interface. 
+    * 
+    * The stream 5 of DMA1 (channel 4) copies the received bytes in a circular buffer, without processor intervention. 
+    * The half transfer, the transfer complete and the UART idle-line interrupts signal the attached callback, 
+    * so a whole frame is signaled once, after the last byte was received. 
+    * 
+    * The USART2 interrupt vector is shared with the mbed serial object, the previous handler is applied after the idle-line handling, 
+    * so the transmission interrupts of the serial object keep working. The 'start' method has to be applied after the serial object's interrupts were attached.
+    * 
+    * The DMA doesn't stop on a full buffer, it overwrites the unread bytes. The half and complete transfer interrupts count the written 
+    * halves, so the reading finds the overwritten bytes: the unread bytes are discarded and counted, the parser of the monitor resynchronizes 
+    * on the next frame. The overrun, framing and noise errors of the UART are counted by its error interrupt.
+    */
+    class CSerialDmaReceiver_USART2: public utils::serial::ISerialReceiver
+    {
+    public:
+        /* Constructor */
+        CSerialDmaReceiver_USART2();
+        /* Start the DMA transfer and the interrupts */
+        void start();
+        /* Read the available bytes */
+        virtual uint32_t read(char* f_buffer, uint32_t f_length);
+        /* Attach the callback */
+        virtual void attach(mbed::Callback<void()> f_callback);
+        /* Attach the scanner of the received bytes */
+        virtual void attachScanner(utils::serial::ISerialReceiver::FScanner f_scanner);
+        /* Number of the received, unread bytes */
+        virtual uint32_t getLevel() const;
+        /** @brief  Size of the circular buffer */
+        virtual uint32_t getCapacity() const
+        {
+            return s_bufferSize;
+        }
+        /** @brief  Error counters */
+        virtual const utils::serial::ISerialReceiver::SErrors& getErrors() const
+        {
+            return m_errors;
+        }
+        /** @brief  Size of the circular buffer */
+        static const uint32_t s_bufferSize = 256;
+    private:
+        /* Number of the bytes written by DMA since the start */
+        uint32_t written() const;
+        /* Pass the new bytes to the scanner */
+        void scan();
+        /* USART2 interrupt handler */
+        static void usartIrqHandler();
+        /* DMA1 stream 5 interrupt handler */
+        static void dmaIrqHandler();
+        /** @brief  The active receiver object */
+        static CSerialDmaReceiver_USART2* s_instance;
+        /** @brief  The previous USART2 interrupt handler */
+        static uint32_t s_prevUsartHandler;
+        /** @brief  Circular buffer written by DMA */
+        volatile char m_buffer[s_bufferSize];
+        /** @brief  Read index in the circular buffer */
+        uint32_t m_readIdx;
+        /** @brief  Number of the bytes read since the start */
+        uint32_t m_readTotal;
+        /** @brief  Number of the half buffers written by DMA, counted by the transfer interrupts */
+        volatile uint32_t m_halves;
+        /** @brief  Error counters */
+        utils::serial::ISerialReceiver::SErrors m_errors;
+        /** @brief  Callback applied, when new bytes are available */
+        mbed::Callback<void()> m_callback;
+        /** @brief  Scanner of the received bytes */
+        utils::serial::ISerialReceiver::FScanner m_scanner;
+        /** @brief  Number of the bytes passed to the scanner since the start */
+        uint32_t m_scanTotal;
+    };
+
+   /**
+    * @brief DMA based receiver for the USART6 (PA_11, PA_12) interface. 
+    * 
+    * The stream 1 of DMA2 (channel 5) copies the received bytes in a circular buffer, the stream 0 of DMA2 remains free for the ADC scanner. 
+    * It works like the USART2 receiver, so the second link of the serial monitor has its own buffer, interrupts and error counters. 
+    * The 'start' method has to be applied after the serial object's interrupts were attached.
+    */
+    class CSerialDmaReceiver_USART6: public utils::serial::ISerialReceiver
+    {
+    public:
+        /* Constructor */
+        CSerialDmaReceiver_USART6();
+        /* Start the DMA transfer and the interrupts */
+        void start();
+        /* Read the available bytes */
+        virtual uint32_t read(char* f_buffer, uint32_t f_length);
+        /* Attach the callback */
+        virtual void attach(mbed::Callback<void()> f_callback);
+        /* Attach the scanner of the received bytes */
+        virtual void attachScanner(utils::serial::ISerialReceiver::FScanner f_scanner);
+        /* Number of the received, unread bytes */
+        virtual uint32_t getLevel() const;
+        /** @brief  Size of the circular buffer */
+        virtual uint32_t getCapacity() const
+        {
+            return s_bufferSize;
+        }
+        /** @brief  Error counters */
+        virtual const utils::serial::ISerialReceiver::SErrors& getErrors() const
+        {
+            return m_errors;
+        }
+        /** @brief  Size of the circular buffer */
+        static const uint32_t s_bufferSize = 256;
+    private:
+        /* Number of the bytes written by DMA since the start */
+        uint32_t written() const;
+        /* Pass the new bytes to the scanner */
+        void scan();
+        /* USART6 interrupt handler */
+        static void usartIrqHandler();
+        /* DMA2 stream 1 interrupt handler */
+        static void dmaIrqHandler();
+        /** @brief  The active receiver object */
+        static CSerialDmaReceiver_USART6* s_instance;
+        /** @brief  The previous USART6 interrupt handler */
+        static uint32_t s_prevUsartHandler;
+        /** @brief  Circular buffer written by DMA */
+        volatile char m_buffer[s_bufferSize];
+        /** @brief  Read index in the circular buffer */
+        uint32_t m_readIdx;
+        /** @brief  Number of the bytes read since the start */
+        uint32_t m_readTotal;
+        /** @brief  Number of the half buffers written by DMA, counted by the transfer interrupts */
+        volatile uint32_t m_halves;
+        /** @brief  Error counters */
+        utils::serial::ISerialReceiver::SErrors m_errors;
+        /** @brief  Callback applied, when new bytes are available */
+        mbed::Callback<void()> m_callback;
+        /** @brief  Scanner of the received bytes */
+        utils::serial::ISerialReceiver::FScanner m_scanner;
+        /** @brief  Number of the bytes passed to the scanner since the start */
+        uint32_t m_scanTotal;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // SERIAL_DMA_RECEIVER_HPP
@@ -0,0 +1,87 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SerialDmaSender.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the DMA based serial sender.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SERIAL_DMA_SENDER_HPP
+#define SERIAL_DMA_SENDER_HPP
+
+#include <mbed.h>
+#include <utils/serial/serialsender.hpp>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief DMA based sender for the USART2 (USBTX, USBRX) interface. 
+    * 
+    * The stream 6 of DMA1 (channel 4) copies a block of bytes to the transmitter, the transfer complete interrupt signals the attached callback. 
+    * It doesn't use the USART2 interrupt, so it can be applied together with the DMA based receiver.
+    */
+    class CSerialDmaSender_USART2: public utils::serial::ISerialSender
+    {
+    public:
+        /* Constructor */
+        CSerialDmaSender_USART2();
+        /* Start the transmission of a block */
+        virtual void send(const char* f_data, uint32_t f_length);
+        /* Attach the callback */
+        virtual void attach(mbed::Callback<void()> f_callback);
+    private:
+        /* DMA1 stream 6 interrupt handler */
+        static void dmaIrqHandler();
+        /** @brief  The active sender object */
+        static CSerialDmaSender_USART2* s_instance;
+        /** @brief  Flag to notice the configured state of the stream */
+        bool m_initialized;
+        /** @brief  Callback applied, when the block was transmitted */
+        mbed::Callback<void()> m_callback;
+    };
+
+   /**
+    * @brief DMA based sender for the USART6 (PA_11, PA_12) interface. 
+    * 
+    * The stream 6 of DMA2 (channel 5) copies a block of bytes to the transmitter, the transfer complete interrupt signals the attached callback. 
+    */
+    class CSerialDmaSender_USART6: public utils::serial::ISerialSender
+    {
+    public:
+        /* Constructor */
+        CSerialDmaSender_USART6();
+        /* Start the transmission of a block */
+        virtual void send(const char* f_data, uint32_t f_length);
+        /* Attach the callback */
+        virtual void attach(mbed::Callback<void()> f_callback);
+    private:
+        /* DMA2 stream 6 interrupt handler */
+        static void dmaIrqHandler();
+        /** @brief  The active sender object */
+        static CSerialDmaSender_USART6* s_instance;
+        /** @brief  Flag to notice the configured state of the stream */
+        bool m_initialized;
+        /** @brief  Callback applied, when the block was transmitted */
+        mbed::Callback<void()> m_callback;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // SERIAL_DMA_SENDER_HPP
@@ -0,0 +1,68 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  * @file    StatusLed.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the DMA driven blink patterns of the status led.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef STATUS_LED_HPP
+#define STATUS_LED_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Blink patterns of the built-in led (LED1, PA5) without cpu.
+    * 
+    * The led pin can be driven only by TIM2, which generates the motor pwm, so the pattern is written by the DMA: the update event 
+    * of TIM1 (10 Hz) requests the DMA2 stream 5, which copies the next word of a circular buffer of 32 set/reset values into the 
+    * BSRR of the port. A pattern lasts 3.2 s, the cpu rewrites the buffer only, when the pattern changes. In the wheel sensor 
+    * build the TIM1 captures the sensor, so this driver isn't available there.
+    */
+    class CStatusLed_TIM1
+    {
+    public:
+        /** @brief  Number of the steps of a pattern, a bit of the pattern for each step */
+        static const uint8_t s_steps = 32;
+        /** @brief  Frequency of the steps in Hz */
+        static const uint32_t s_stepFrequency = 10;
+        /* Constructor */
+        CStatusLed_TIM1();
+        /* Start the pattern output */
+        void start();
+        /* Set the pattern */
+        void setPattern(uint32_t f_pattern);
+        /** @brief  Current pattern, the bit i is the state of the led in the step i */
+        uint32_t getPattern() const
+        {
+            return m_pattern;
+        }
+        /* Pattern of short flashes */
+        static uint32_t flashes(uint8_t f_count);
+    private:
+        /** @brief  Values of the BSRR register for each step, it's read by the DMA */
+        volatile uint32_t m_buffer[s_steps];
+        /** @brief  Current pattern */
+        uint32_t m_pattern;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // STATUS_LED_HPP
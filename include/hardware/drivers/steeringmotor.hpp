@@ -28,6 +28,8 @@ limitations under the License.
 #define STEERINGMOTOR_HPP
 
 #include <mbed.h>
+#include <array>
+#include <hardware/drivers/fastio.hpp>
 
 
 namespace hardware::drivers{
@@ -47,7 +49,14 @@ namespace hardware::drivers{
      * @brief Steering servo motor driver
      * 
      * It is used to control the servo motor, which is connected to the steering wheels. The steering angle can be accessed through 'setAngle' method. 
+     * The angle is converted to duty cycle by a linear formula or by a calibration table of measured points with linear interpolation. The output 
+     * can be limited by a slew rate, then the angle approaches the command in the consecutive calls of 'setAngle'. The compare register 
+     * is written only, when the duty cycle changes, so the repeated commands don't cost register writes.
      * 
+     * The conversion gives the duty cycle of the analog servo frame (20 ms), so it defines the pulse width. A digital servo can be driven 
+     * with a shorter frame (setFrame, e.g. 3-5 ms), then the pulse width is kept, it's limited to the pulse range of the servo and the 
+     * compare register is preloaded, so a new command is applied at the start of the next frame and a pulse is never cut. The timer of the 
+     * output mustn't drive other outputs, its period is changed.
      */
     class CSteeringMotor: public ISteeringCommand
     {
@@ -61,16 +70,59 @@ namespace hardware::drivers{
         /* Set angle */
         void setAngle(float f_angle); 
         bool inRange(float f_angle);
+        /* Enable the direct register access of the output */
+        void setFastPath(bool f_enable);
+        /* Set the conversion from angle to duty cycle */
+        void setConversion(float f_slope, float f_offset);
+        /* Set the calibration table */
+        bool setCalibration(const float* f_angles, const float* f_duties, uint8_t f_count);
+        /* Set the slew rate limit */
+        void setSlewRate(float f_rate, float f_period);
+        /* Set the frame period and the pulse range of the servo */
+        bool setFrame(float f_period, float f_minPulse, float f_maxPulse);
+        /** @brief Period of the analog servo frame in microsecond, the conversion gives its duty cycle */
+        static constexpr float s_analogFrame = 20000.0f;
+        /** @brief Maximum number of the calibration points */
+        static const uint8_t s_maxPoints = 9;
+        /** @brief Get the last applied angle in degree */
+        float getAngle() const
+        {
+            return m_angle;
+        }
     private:
         /* convert angle degree to duty cycle for pwm signal */
         float conversion(float f_angle); //angle to duty cycle
         /** @brief PWM output pin */
-        PwmOut m_pwm;
+        CFastPwmOut m_pwm;
 
         /** @brief Inferior limit */
         const float m_inf_limit;
         /** @brief Superior limit */
         const float m_sup_limit;
+        /** @brief Duty cycle per degree */
+        float m_slope;
+        /** @brief Duty cycle of the zero position */
+        float m_offset;
+        /** @brief Angles of the calibration points in increasing order */
+        std::array<float,s_maxPoints> m_lutAngles;
+        /** @brief Duty cycles of the calibration points */
+        std::array<float,s_maxPoints> m_lutDuties;
+        /** @brief Number of the calibration points, zero for the linear conversion */
+        uint8_t m_lutCount;
+        /** @brief Maximum change of the angle in a call, zero without limit */
+        float m_maxStep;
+        /** @brief Last written duty cycle, negative after a change of the conversion */
+        float m_duty;
+        /** @brief Direct register access of the output */
+        bool m_fastPath;
+        /** @brief Frame period in microsecond */
+        float m_frame;
+        /** @brief Shortest pulse of the servo in microsecond */
+        float m_minPulse;
+        /** @brief Longest pulse of the servo in microsecond */
+        float m_maxPulse;
+        /** @brief Last applied angle in degree, after the slew rate limit */
+        volatile float m_angle;
     };
 }; // namespace hardware::drivers
 
@@ -0,0 +1,57 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    UartBaudRate.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the baud rate setting
+  *          of the running UART interfaces.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef UART_BAUD_RATE_HPP
+#define UART_BAUD_RATE_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Baud rate setting of a running UART interface, the DMA based receivers and senders keep working.
+    * 
+    * The rate of the mbed serial object is changed by the reinitialization of the interface, it resets the idle-line interrupt 
+    * of the DMA receivers, so the baud rate register is written directly. The oversampling by 8 is selected above the clock / 16 
+    * rate, so the USART1 and USART6 on APB2 reach 10.5 Mbaud and the USART2 on APB1 5.25 Mbaud (the ST-Link VCP is limited 
+    * to 2 Mbaud).
+    */
+    class CUartBaudRate
+    {
+    public:
+        /* Set the baud rate */
+        static bool set(USART_TypeDef* f_uart, uint32_t f_baud);
+        /* Get the realized baud rate */
+        static uint32_t get(USART_TypeDef* f_uart);
+    private:
+        /* Clock of the interface */
+        static uint32_t clock(USART_TypeDef* f_uart);
+        /** @brief  Maximum error of the realized rate in per mille */
+        static const uint32_t s_maxError = 20;
+    };
+
+}; // namespace hardware::drivers
+
+#endif // UART_BAUD_RATE_HPP
@@ -0,0 +1,52 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Watchdog.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the independent watchdog.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef WATCHDOG_HPP
+#define WATCHDOG_HPP
+
+#include <mbed.h>
+
+namespace hardware::drivers{
+
+   /**
+    * @brief Independent watchdog (IWDG), it resets the microcontroller, when it isn't refreshed in the timeout. 
+    * 
+    * The watchdog is clocked by the internal low speed oscillator (about 32 kHz), so it works independently from the system clock. 
+    * After the start it can't be stopped, only by a reset. It's frozen, while the core is halted by the debugger.
+    */
+    class CWatchdog_IWDG
+    {
+    public:
+        /* Start the watchdog */
+        static bool start(float f_timeout);
+        /* Refresh the watchdog */
+        static void kick();
+        /* The last reset was caused by the watchdog */
+        static bool wasReset();
+    };
+
+}; // namespace hardware::drivers
+
+#endif // WATCHDOG_HPP
@@ -28,6 +28,23 @@ limitations under the License.
 
 #include <stdint.h>
 namespace hardware::encoders{
+    /**
+     * @brief Timestamped sample of the encoder, it's published at the end of each measurement.
+     * 
+     */
+    struct SEncoderSample{
+        /** @brief Timestamp of the measurement in microsecond */
+        uint32_t m_timestamp;
+        /** @brief Counted impulses in the period */
+        int16_t  m_count;
+        /** @brief Rotation speed in rotation per second */
+        float    m_speedRps;
+        /** @brief Accumulated position in impulses since the start */
+        int64_t  m_position;
+        /** @brief Shaft angle in impulses from the index pulse, in the range [0, resolution), it's -1 before the first index pulse */
+        int32_t  m_angle;
+    };
+
     /**
      * @brief Rotary speed encoder interface class.
      *
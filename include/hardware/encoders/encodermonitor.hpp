@@ -0,0 +1,131 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ 
+ * @file encodermonitor.hpp
+ * @author  RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ */
+#ifndef ENCODER_MONITOR_HPP
+#define ENCODER_MONITOR_HPP
+
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+#include <mbed.h>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Health monitor of the encoder, it checks the counted impulses of each tick against the motor model.
+ * 
+ * The speed of the motor is estimated from the back-EMF: the applied voltage (signed pwm times the supply) minus the resistive 
+ * drop of the current over the back-EMF constant. While this speed is above the activity threshold the encoder has to count in 
+ * its direction and near its value; the stuck channels count nothing, the noisy channels change the sign of the count. The count 
+ * cannot change faster than the jump limit in any state. Each faulty tick decreases the health score, each plausible tick 
+ * recovers it slowly; below the degraded threshold the callback switches the control to open loop, above the recovery threshold 
+ * it switches back. The checks are a few float operations, so it runs in each tick as a pipeline stage after the encoder.
+ */
+class CEncoderMonitor:public utils::pipeline::IPipelineStage{
+  public:
+      /** @brief Fault flags of the checks */
+      enum EFault{
+        /** @brief no count, while the motor is turning */
+        FAULT_STUCK = 1,
+        /** @brief the count has the opposite direction of the motor */
+        FAULT_DIRECTION = 2,
+        /** @brief the count differs from the speed of the motor */
+        FAULT_MISMATCH = 4,
+        /** @brief the count changed more than the jump limit */
+        FAULT_JUMP = 8,
+        /** @brief the sign of the count alternates, while the motor is turning */
+        FAULT_NOISE = 16
+      };
+      /** @brief Parameters of the motor model and of the checks */
+      struct SParams{
+        /** @brief Supply voltage of the bridge (V) */
+        float m_supply;
+        /** @brief Resistance of the winding (Ohm) */
+        float m_resistance;
+        /** @brief Back-EMF constant (V/rps) */
+        float m_backEmf;
+        /** @brief Below this estimated speed only the jump is checked (rps) */
+        float m_activeRps;
+        /** @brief Relative tolerance of the measured speed to the estimated speed */
+        float m_tolerance;
+        /** @brief Limit of the change of the count between two ticks (impulse) */
+        int16_t m_maxJump;
+      };
+      /** @brief Callback of the degraded state, its parameter is true at degradation and false at recovery */
+      typedef mbed::Callback<void(bool)> FDegradedCallback;
+      /** @brief Consecutive active ticks without count for the stuck fault */
+      static const uint8_t s_stuckTicks = 3;
+      /** @brief Decrease of the health by a faulty tick */
+      static constexpr float s_penalty = 0.2f;
+      /** @brief Increase of the health by a plausible tick */
+      static constexpr float s_recovery = 0.001f;
+      /** @brief Below this health the encoder is degraded */
+      static constexpr float s_degradedHealth = 0.5f;
+      /** @brief Above this health the degraded encoder is recovered */
+      static constexpr float s_recoveredHealth = 0.9f;
+      /* Constructor */
+      CEncoderMonitor(float f_period, IEncoderGetter& f_encoder, uint16_t f_resolution, const SParams& f_params);
+      /* Set the inputs of the motor model */
+      void setInputs(mbed::Callback<float()> f_pwm, mbed::Callback<float()> f_current);
+      /* Set the callback of the degraded state */
+      void setCallback(FDegradedCallback f_callback);
+      /* Pipeline stage */
+      virtual void process(uint32_t f_timestamp);
+      /** @brief Health score in interval [0,1] */
+      float getHealth() const {return m_health;}
+      /** @brief The encoder is degraded, the control is in open loop */
+      bool isDegraded() const {return m_degraded;}
+      /* Serial callback of the health */
+      void serialCallback(char const * a, char * b);
+  private:
+      uint32_t check(int16_t f_count, float f_modelRps);
+      /** @brief Monitored encoder */
+      IEncoderGetter& m_encoder;
+      /** @brief Impulses per rotation per tick to rps */
+      const float m_countToRps;
+      /** @brief Parameters */
+      const SParams m_params;
+      /** @brief Commanded pwm */
+      mbed::Callback<float()> m_pwm;
+      /** @brief Current of the motor */
+      mbed::Callback<float()> m_current;
+      /** @brief Callback of the degraded state */
+      FDegradedCallback m_callback;
+      /** @brief Count of the previous tick */
+      int16_t m_prevCount;
+      /** @brief Last non zero count, the reference of the sign changes */
+      int16_t m_lastNonZero;
+      /** @brief Consecutive active ticks without count */
+      uint8_t m_zeroTicks;
+      /** @brief Health score */
+      float m_health;
+      /** @brief Degraded state */
+      bool m_degraded;
+      /** @brief Faults since the last reading of the serial callback */
+      volatile uint32_t m_faults;
+      /** @brief Number of the degradations */
+      uint32_t m_degradations;
+};
+
+}; // namespace hardware::encoders
+
+#endif
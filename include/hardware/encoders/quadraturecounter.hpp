@@ -25,6 +25,8 @@ limitations under the License.
 #define QUADRATURE_COUNTER__HPP
 
 #include <mbed.h>
+#include <pinmap.h>
+#include <utils/memory/staticpool.hpp>
 
 namespace hardware::drivers{
   /**
@@ -35,6 +37,10 @@ namespace hardware::drivers{
       public:
         virtual int16_t getCount() = 0;
         virtual void reset() = 0;
+        /** @brief Get the raw value of the counter, the 16-bit counters are extended with zero. */
+        virtual uint32_t getRawCount(){ return static_cast<uint16_t>(getCount()); }
+        /** @brief Width of the counter, it's true for the 32-bit counters (TIM2, TIM5). */
+        virtual bool is32Bit(){ return false; }
   }; // class IQuadratureCounter_TIMX
 
   /**
@@ -70,10 +76,33 @@ namespace hardware::drivers{
     
     private:
       void initialize();
+      static utils::memory::CStaticPool<CQuadratureCounter_TIM4,1>& pool();
       static CQuadratureCounter_TIM4* m_instance;
       static CQuadratureCounter_TIM4_Destroyer m_destroyer;
   }; //class CQuadratureCounter_TIM4
 
+  /**
+   * @brief A generic driver for quadrature encoder, it's parameterized by the timer instance and the pins. 
+   * 
+   * Several objects can be created on different timers (TIM1..TIM5), so several encoders can be sampled in the same control tick. 
+   * On TIM2 and TIM5 the counter has 32 bits, the encoder can read it by method 'getRawCount' to compute wrapped differences without 16-bit overflow. 
+   * The timer and the pins have to be free, on this board the TIM2, TIM3 and TIM4 are used by the PWM outputs and by the motor encoder.
+   */
+  class CQuadratureCounter:public IQuadratureCounter_TIMX{
+    public:
+      CQuadratureCounter(TIM_TypeDef* f_timer, PinName f_channelA, PinName f_channelB, uint8_t f_alternate);
+      int16_t getCount();
+      void reset();
+      uint32_t getRawCount();
+      bool is32Bit();
+    private:
+      void enableClock();
+      /** @brief Timer instance */
+      TIM_TypeDef* const m_timer;
+      /** @brief Width of the counter */
+      const bool m_is32Bit;
+  }; //class CQuadratureCounter
+
 };// namespace hardware::drivers
 
 
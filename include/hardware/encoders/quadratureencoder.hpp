@@ -25,25 +25,74 @@ limitations under the License.
 
 #include <hardware/encoders/encoderinterfaces.hpp>
 #include <hardware/encoders/quadraturecounter.hpp>
+#include <hardware/drivers/encoderedgecapture.hpp>
+#include <hardware/drivers/encoderindexcapture.hpp>
 #include <signal/filter/filter.hpp>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/taskmanager/timerwheel.hpp>
+#include <utils/sync/topic.hpp>
 
 #include <rtos.h>
 
 namespace hardware::encoders{
 
+/** @brief Topic of the encoder samples, the consumers subscribe to it or read it by reference */
+typedef utils::sync::CTopic<SEncoderSample> CEncoderTopic;
+
 /**
  * @brief It implements a periodic task, which get the value from the counter and reset it to zero.
  * 
+ * It can be applied by its own timer of the timer wheel or as the first stage of a pipeline, in this case the measurement has the timestamp of the pipeline tick. 
+ * The timestamped sample is published on the topic of the encoder, so the consumers of other threads (controller, telemetry, logging, 
+ * safety) read it consistently without a reference in the constructor of the encoder.
+ * 
+ * Each period the travelled impulses (without the index corrections) are written in a history ring of the last s_historySize periods, 
+ * the speeds of the short, medium and long windows and the acceleration are the differences of its entries, so each of them costs 
+ * O(1) and they belong to the same position stream. A short window has low latency and high quantization noise, a long one the 
+ * opposite, the consumers choose it by CWindowedSpeed. The windowed values are read by the following stages of the same pipeline.
  */
-class CQuadratureEncoder:public IEncoderGetter{
+class CQuadratureEncoder:public IEncoderGetter, public utils::pipeline::IPipelineStage{
   public:
-      CQuadratureEncoder(float,hardware::drivers::IQuadratureCounter_TIMX*,uint16_t);
-      void startTimer();
+      /** @brief Counting modes of the encoder */
+      enum ECountingMode{
+        /** @brief the counter is read and reset in each period */
+        RESET_COUNTER,
+        /** @brief the counter runs freely, the count of the period is the wrapped difference from the previous value, no impulse is lost */
+        FREE_RUNNING
+      };
+      /** @brief Windows of the speed estimation, their lengths are s_windowLength periods */
+      enum EWindow{
+        WINDOW_SHORT = 0,
+        WINDOW_MEDIUM = 1,
+        WINDOW_LONG = 2
+      };
+      CQuadratureEncoder(float,hardware::drivers::IQuadratureCounter_TIMX*,uint16_t,ECountingMode f_mode = RESET_COUNTER);
+      void startTimer(utils::task::CTimerWheel& f_wheel);
     virtual void _run();
+    virtual void process(uint32_t f_timestamp);
+    SEncoderSample getSample();
+    /** @brief Topic of the published samples */
+    CEncoderTopic& getTopic(){return m_topic;}
+    int64_t getPosition();
     virtual int16_t getCount();
     virtual float getSpeedRps();
     virtual bool isAbs(){return false;}
+    void setIndexCapture(hardware::drivers::CEncoderIndexCapture_TIM4* f_index);
+    float getShaftAngle();
+    void serialCallbackIndex(char const * a, char * b);
+    float getWindowSpeedRps(EWindow f_window) const;
+    float getAccelerationRps2() const;
+    /** @brief Number of the periods in the history ring, power of two */
+    static const uint8_t s_historySize = 64;
+    /** @brief Lengths of the windows in periods, the acceleration applies two medium windows */
+    static const uint8_t s_windowLength[3];
+    /** @brief Deviation of the index position above resolution/s_indexTolerance is a disturbance of the index input, it's rejected */
+    static const uint8_t s_indexTolerance = 8;
   protected:
+      void acquire(uint32_t f_timestamp);
+      void correctByIndex(uint32_t f_raw);
+      void publish();
+      static void expireTimer(utils::task::CTimerWheel::CTimer& f_timer);
       /** @brief Counter interface */
       ::hardware::drivers::IQuadratureCounter_TIMX *m_quadraturecounter;
       /** @brief Last counted value */
@@ -52,8 +101,63 @@ class CQuadratureEncoder:public IEncoderGetter{
       const float       m_taskperiod_s;
       /** @brief Resolution of encoder */
       const uint16_t    m_resolution;
-      /** @brief Rtos Timer for periodically applying */
-      RtosTimer m_timer;
+      /** @brief Speed of one impulse in a period (rotation per second), the getters multiply by it instead of dividing */
+      const float       m_speedScale;
+      /** @brief Counting mode */
+      const ECountingMode m_mode;
+      /** @brief Previous raw value of the counter in free running mode */
+      uint32_t          m_lastRaw;
+      /** @brief Accumulated position in impulses */
+      int64_t           m_position;
+      /** @brief Capture of the index pulse, it's NULL without index input */
+      hardware::drivers::CEncoderIndexCapture_TIM4* m_index;
+      /** @brief Number of the last processed index pulse */
+      uint32_t          m_indexCount;
+      /** @brief The position of the index is known, so the shaft angle is valid */
+      bool              m_indexed;
+      /** @brief Position of the last accepted index pulse in impulses */
+      int64_t           m_indexPosition;
+      /** @brief Deviation of the last accepted index pulse from the whole revolutions, it's removed from the position */
+      int32_t           m_indexError;
+      /** @brief Number of the corrected revolutions */
+      uint32_t          m_indexCorrections;
+      /** @brief Number of the rejected index pulses */
+      uint32_t          m_indexRejected;
+      /** @brief Timer of the timer wheel for periodically applying */
+      utils::task::CTimerWheel::CTimer m_timer;
+      /** @brief Timestamp of the last measurement */
+      uint32_t          m_timestamp;
+      /** @brief Topic of the published samples */
+      CEncoderTopic     m_topic;
+      /** @brief Travelled impulses since the start without the index corrections */
+      int64_t           m_travel;
+      /** @brief History ring of the travelled impulses of the last periods */
+      int64_t           m_history[s_historySize];
+      /** @brief Number of the recorded periods, the newest entry is at (m_historyCount - 1) modulo the size */
+      uint32_t          m_historyCount;
+};
+
+/**
+ * @brief Speed getter of a window of the encoder, it's passed to the consumers, which need a different tradeoff of latency and noise.
+ */
+class CWindowedSpeed: public IEncoderGetter{
+    public:
+      /** @brief Constructor */
+      CWindowedSpeed(CQuadratureEncoder& f_encoder, CQuadratureEncoder::EWindow f_window)
+        : m_encoder(f_encoder)
+        , m_window(f_window)
+      {
+      }
+      /** @brief Counted impulses of the last period */
+      virtual int16_t getCount(){return m_encoder.getCount();}
+      /** @brief Speed of the window in rps */
+      virtual float getSpeedRps(){return m_encoder.getWindowSpeedRps(m_window);}
+      virtual bool isAbs(){return false;}
+    private:
+      /** @brief Encoder */
+      CQuadratureEncoder& m_encoder;
+      /** @brief Window of the speed */
+      const CQuadratureEncoder::EWindow m_window;
 };
 
 /**
@@ -62,14 +166,13 @@ class CQuadratureEncoder:public IEncoderGetter{
  */
 class CQuadratureEncoderWithFilter: public CQuadratureEncoder, public IEncoderNonFilteredGetter{
     public:
-      CQuadratureEncoderWithFilter(float,hardware::drivers::IQuadratureCounter_TIMX *, uint16_t,signal::filter::IFilter<float>&);
+      CQuadratureEncoderWithFilter(float,hardware::drivers::IQuadratureCounter_TIMX *, uint16_t,signal::filter::IFilter<float>&,ECountingMode f_mode = RESET_COUNTER);
       
       virtual int16_t getCount();
       virtual float getSpeedRps();
       virtual int16_t  getNonFilteredCount();
       virtual float getNonFilteredSpeedRps();
-    protected:
-      virtual void _run();
+      virtual void process(uint32_t f_timestamp);
       /** @brief Last filtered counted value */
       double m_encoderCntFiltered;
       /** @brief Filter interface */
@@ -77,6 +180,36 @@ class CQuadratureEncoderWithFilter: public CQuadratureEncoder, public IEncoderNo
 
 };
 
+/**
+ * @brief It implements the same functionality than CQuadratureEncoder class, but the speed is estimated by the M/T method. 
+ * 
+ * At high speed the speed is computed from the count of the period (M method), at low speed from the time between the captured 
+ * edges (T method), between the two thresholds the two estimations are blended linearly. The period measurement gives fine 
+ * resolution at low speed without a filter and without its phase lag. The edge capture is enabled only below the high threshold.
+ */
+class CQuadratureEncoderMT: public CQuadratureEncoder{
+    public:
+      CQuadratureEncoderMT(float,hardware::drivers::IQuadratureCounter_TIMX *, uint16_t,hardware::drivers::CEncoderEdgeCapture_TIM4&,float f_lowSpeedRps,float f_highSpeedRps,ECountingMode f_mode = FREE_RUNNING);
+      virtual float getSpeedRps();
+      virtual void process(uint32_t f_timestamp);
+    protected:
+      float estimatePeriodSpeed();
+      /** @brief Edge capture */
+      hardware::drivers::CEncoderEdgeCapture_TIM4& m_capture;
+      /** @brief Below this speed only the period measurement is used */
+      const float m_lowSpeedRps;
+      /** @brief Above this speed only the count measurement is used */
+      const float m_highSpeedRps;
+      /** @brief Previous edge of the period measurement */
+      hardware::drivers::SEncoderEdge m_prevEdge;
+      /** @brief The previous edge is valid */
+      bool m_prevEdgeValid;
+      /** @brief Last speed of the period measurement */
+      float m_periodSpeedRps;
+      /** @brief Last estimated speed */
+      float m_speedRps;
+};
+
 }; // namespace hardware::encoders
 
 #endif
\ No newline at end of file
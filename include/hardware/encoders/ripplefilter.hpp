@@ -0,0 +1,97 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ 
+ * @file ripplefilter.hpp
+ * @author  RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ */
+#ifndef RIPPLE_FILTER_HPP
+#define RIPPLE_FILTER_HPP
+
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <hardware/encoders/quadratureencoder.hpp>
+#include <signal/filter/filter.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Rejection of the speed-proportional ripple of the drivetrain (motor cogging, gear mesh, wheel eccentricity) on the measured speed.
+ * 
+ * The frequency of the ripple is the order (ripple periods per rotation of the encoder) multiplied by the rotation speed. The first and 
+ * the second harmonic are removed by tunable notch filters, which are retuned in each period by the filtered speed, and by an LMS 
+ * canceller, which uses the cosine and the sine of the ripple phase integrated from the counted impulses. The rest of the band isn't 
+ * low-pass filtered, so the speed controller gets the measurement with a small delay. Below the minimal ripple frequency both are 
+ * bypassed and the adaptation is frozen. It has to be applied in the pipeline after the encoder stage.
+ */
+class CRippleFilter:public IEncoderGetter, public IEncoderNonFilteredGetter, public utils::pipeline::IPipelineStage{
+  public:
+      /** @brief Applied filters, the flags can be combined */
+      enum EMode{
+        /** @brief the measured speed is forwarded */
+        BYPASS = 0,
+        /** @brief notch filters at the harmonics of the ripple frequency */
+        NOTCH = 1,
+        /** @brief LMS canceller locked to the ripple phase */
+        ADAPTIVE = 2
+      };
+      /** @brief Number of the rejected harmonics */
+      static const uint32_t s_harmonics = 2;
+      /* Constructor */
+      CRippleFilter(float f_period, CQuadratureEncoder& f_encoder, uint16_t f_resolution, float f_order, float f_quality, float f_stepSize, uint32_t f_mode);
+      /* Pipeline stage */
+      virtual void process(uint32_t f_timestamp);
+      /* Counted impulses of the encoder in the last period */
+      virtual int16_t getCount();
+      /* Filtered rotation speed */
+      virtual float getSpeedRps();
+      /* Counted impulses of the encoder in the last period */
+      virtual int16_t getNonFilteredCount();
+      /* Measured rotation speed */
+      virtual float getNonFilteredSpeedRps();
+      virtual bool isAbs(){return false;}
+      /* Serial callback of the configuration */
+      void serialCallback(char const * a, char * b);
+  private:
+      /** @brief Type of the LMS canceller, a cosine and sine weight for each harmonic */
+      using CCancellerType = signal::filter::nlti::siso::CLmsFilter<float,2*s_harmonics>;
+      /** @brief Encoder of the speed and the position */
+      CQuadratureEncoder& m_encoder;
+      /** @brief Resolution of the encoder */
+      const float m_resolution;
+      /** @brief Ripple periods per rotation */
+      volatile float m_order;
+      /** @brief Applied filters */
+      volatile uint32_t m_mode;
+      /** @brief Mode of the last period, the filters are cleared, when it changes */
+      uint32_t m_appliedMode;
+      /** @brief Notch filters of the harmonics */
+      signal::filter::lti::siso::CNotchFilter<float> m_notches[s_harmonics];
+      /** @brief LMS canceller */
+      CCancellerType m_canceller;
+      /** @brief Phase of the ripple in radian, in interval [0, 2*pi) */
+      float m_phase;
+      /** @brief Measured speed */
+      float m_rawSpeed;
+      /** @brief Filtered speed */
+      volatile float m_speed;
+};
+
+}; // namespace hardware::encoders
+
+#endif // RIPPLE_FILTER_HPP
@@ -0,0 +1,88 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ 
+ * @file singlechannelencoder.hpp
+ * @author  RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ */
+#ifndef SINGLE_CHANNEL_ENCODER_HPP
+#define SINGLE_CHANNEL_ENCODER_HPP
+
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <hardware/drivers/edgecapturedma.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Speed of a single channel sensor (magnetic wheel sensor, hall sensor), which gives the edges without direction.
+ * 
+ * The speed is measured from the period of the edges captured by the timer and the DMA, the edges of the tick are averaged. 
+ * Without new edge the speed cannot be higher than one edge over the time since the last edge, so it decays to zero, when the 
+ * wheel stops, and after the timeout it's zero. The direction is inferred from the sign of the commanded pwm; it changes only 
+ * below the reversal speed, so the braking before a reversal keeps the direction of the rotation. The measured speed is signed, 
+ * so the controller doesn't need the absolute encoder handling.
+ */
+class CSingleChannelEncoder:public IEncoderGetter, public utils::pipeline::IPipelineStage{
+  public:
+      /** @brief Commands below this pwm don't change the direction */
+      static constexpr float s_deadband = 0.02f;
+      /* Constructor */
+      CSingleChannelEncoder(float f_period, hardware::drivers::CEdgeCaptureDma_TIM1& f_capture, uint16_t f_edgesPerRev, float f_timeout, float f_reverseRps);
+      /* Set the commanded pwm */
+      void setCommand(mbed::Callback<float()> f_pwm);
+      /* Pipeline stage */
+      virtual void process(uint32_t f_timestamp);
+      /* Signed edges in the last period */
+      virtual int16_t getCount();
+      /* Signed rotation speed */
+      virtual float getSpeedRps();
+      virtual bool isAbs(){return false;}
+      /* Accumulated position */
+      int64_t getPosition();
+  private:
+      void updateDirection();
+      /** @brief Edge capture of the sensor */
+      hardware::drivers::CEdgeCaptureDma_TIM1& m_capture;
+      /** @brief Period of the tick in second */
+      const float m_period;
+      /** @brief Edges in a rotation */
+      const float m_edgesPerRev;
+      /** @brief Without edge over this time the speed is zero, it's shorter than the wrap of the timestamps */
+      const float m_timeout;
+      /** @brief Below this speed the direction follows the command */
+      const float m_reverseRps;
+      /** @brief Commanded pwm */
+      mbed::Callback<float()> m_pwm;
+      /** @brief Inferred direction, 1 or -1 */
+      int8_t m_direction;
+      /** @brief The last edge is the reference of the period measurement */
+      bool m_edgeValid;
+      /** @brief Timestamp of the last edge */
+      uint16_t m_lastEdge;
+      /** @brief Signed edges in the last period */
+      int16_t m_count;
+      /** @brief Last measured speed */
+      float m_speedRps;
+      /** @brief Accumulated signed edges */
+      int64_t m_position;
+};
+
+}; // namespace hardware::encoders
+
+#endif
@@ -0,0 +1,111 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ 
+ * @file speedobserver.hpp
+ * @author  RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ */
+#ifndef SPEED_OBSERVER_HPP
+#define SPEED_OBSERVER_HPP
+
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <hardware/encoders/quadratureencoder.hpp>
+#include <signal/filter/kalmanfilter.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+#include <mbed.h>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Speed observer based on a Kalman filter, it fuses the position of the encoder with the commanded pwm and the motor current.
+ * 
+ * The states are the position (rotation), the speed (rps) and an acceleration disturbance (rps^2), the motor is modelled by 
+ * the equation speed' = a*speed + b_pwm*pwm + b_i*current + disturbance, discretized by the Euler method. With zero model 
+ * coefficients it becomes a constant acceleration model. The measurement is the accumulated position of the encoder, the position 
+ * state is kept near zero to avoid the loss of precision. It has to be applied in the pipeline after the encoder stage.
+ */
+class CSpeedObserver:public IEncoderGetter, public utils::pipeline::IPipelineStage{
+  public:
+      /** @brief Coefficients of the motor model */
+      struct SMotorModel{
+        /** @brief Speed feedback (a), it's negative inverse of the mechanical time constant */
+        float m_speedFeedback;
+        /** @brief Acceleration per unit of the pwm command (b_pwm) */
+        float m_pwmGain;
+        /** @brief Acceleration per ampere of the motor current (b_i) */
+        float m_currentGain;
+      };
+      /** @brief Standard deviations of the noises */
+      struct SNoise{
+        /** @brief Process noise of the position per period (rotation) */
+        float m_position;
+        /** @brief Process noise of the speed per period (rps) */
+        float m_speed;
+        /** @brief Process noise of the acceleration disturbance per period (rps^2) */
+        float m_acceleration;
+        /** @brief Measurement noise of the position (rotation) */
+        float m_measurement;
+      };
+      /* Constructor */
+      CSpeedObserver(float f_period, CQuadratureEncoder& f_encoder, uint16_t f_resolution, const SMotorModel& f_model, const SNoise& f_noise);
+      /* Set the getters of the inputs */
+      void setInputs(mbed::Callback<float()> f_pwm, mbed::Callback<float()> f_current);
+      /* Pipeline stage */
+      virtual void process(uint32_t f_timestamp);
+      /* Counted impulses of the encoder in the last period */
+      virtual int16_t getCount();
+      /* Estimated rotation speed */
+      virtual float getSpeedRps();
+      /* Estimated acceleration */
+      float getAccelerationRps2();
+      virtual bool isAbs(){return false;}
+  private:
+      /** @brief Type of the Kalman filter: 3 states, 2 inputs (pwm, current), 1 measurement (position), the state transition is upper bidiagonal */
+      using CKalmanFilterType = signal::filter::lti::mimo::CKalmanFilter<float,3,2,1,utils::linalg::CBandMatrix<float,3,0,1>>;
+      /* Create the discrete system model */
+      static CKalmanFilterType::CSystemModelType systemModel(float f_period, const SMotorModel& f_model);
+      /* Create the process noise covariance */
+      static CKalmanFilterType::CStateCovarianceType processNoise(const SNoise& f_noise);
+      /** @brief Encoder of the position */
+      CQuadratureEncoder& m_encoder;
+      /** @brief Resolution of the encoder */
+      const float m_resolution;
+      /** @brief Coefficients of the motor model */
+      const SMotorModel m_model;
+      /** @brief Kalman filter */
+      CKalmanFilterType m_kalman;
+      /** @brief Getter of the pwm command */
+      mbed::Callback<float()> m_pwm;
+      /** @brief Getter of the motor current */
+      mbed::Callback<float()> m_current;
+      /** @brief Position of the encoder, which corresponds to the zero position state */
+      int64_t m_basePosition;
+      /** @brief The base position was initialized */
+      bool m_initialized;
+      /** @brief Counted impulses in the last period */
+      int16_t m_count;
+      /** @brief Estimated speed */
+      volatile float m_speed;
+      /** @brief Estimated acceleration */
+      volatile float m_acceleration;
+};
+
+}; // namespace hardware::encoders
+
+#endif // SPEED_OBSERVER_HPP
@@ -0,0 +1,152 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Mpu6050.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the MPU-6050 inertial sensor.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef MPU6050_HPP
+#define MPU6050_HPP
+
+#include <mbed.h>
+#include <utils/queue/ringbuffer.hpp>
+#include <hardware/drivers/busqueue.hpp>
+
+namespace hardware::imu{
+
+    /** @brief Sample of the inertial sensor */
+    struct SImuSample{
+        /** @brief Timestamp of the sample in microsecond */
+        uint32_t m_timestamp;
+        /** @brief Acceleration [x, y, z] in meter per square second */
+        float m_accel[3];
+        /** @brief Angular rate [x, y, z] in radian per second */
+        float m_gyro[3];
+    };
+
+   /**
+    * @brief Driver of the MPU-6050 (and register compatible MPU-6500) inertial sensor on the transaction queue of the I2C bus.
+    * 
+    * The sensor writes the accelerometer and the gyroscope samples in its FIFO at the configured rate and it signals each sample 
+    * on the data-ready pin. After each 'f_batch' signal the driver reads the FIFO counter, then the stored samples in a single burst 
+    * transfer by DMA, so the processor isn't blocked during the I2C transfers. The transfers have high priority in the queue, the burst 
+    * follows the counter reading before the waiting transfers of the other devices. The decoded samples are pushed in a lock-free queue 
+    * from interrupt context, the consumer (e.g. the odometry stage of the control loop) pops them. When the sensor FIFO overflows, it's 
+    * reset and the lost samples are counted.
+    * 
+    * The blocking configuration applies the mbed I2C object, it has to be applied before the start of the I2C master.
+    */
+    class CMpu6050
+    {
+    public:
+        /** @brief  Full scale ranges of the gyroscope */
+        enum EGyroRange{
+            GYRO_250DPS = 0,
+            GYRO_500DPS = 1,
+            GYRO_1000DPS = 2,
+            GYRO_2000DPS = 3
+        };
+        /** @brief  Full scale ranges of the accelerometer */
+        enum EAccelRange{
+            ACCEL_2G = 0,
+            ACCEL_4G = 1,
+            ACCEL_8G = 2,
+            ACCEL_16G = 3
+        };
+        /** @brief  Queue of the decoded samples, the interrupt is the producer */
+        typedef utils::CRingBuffer<SImuSample,64> CSampleQueue;
+
+        /* Constructor */
+        CMpu6050(I2C& f_bus, hardware::drivers::CI2cBus_I2C1& f_busQueue, PinName f_dataReady, uint8_t f_address = 0x68);
+        /* Configure the sensor by blocking transfers */
+        bool configure(uint16_t f_rate_hz, uint8_t f_dlpf, EGyroRange f_gyroRange, EAccelRange f_accelRange);
+        /* Start the reading of the FIFO */
+        void start(uint8_t f_batch);
+        /* Pop the oldest sample, consumer side */
+        bool pop(SImuSample& f_sample);
+        /** @brief  Number of the lost samples (sensor FIFO overflow or full queue) */
+        uint32_t getOverruns() const
+        {
+            return m_overruns;
+        }
+        /** @brief  Number of the failed or stuck transfers */
+        uint32_t getErrors() const
+        {
+            return m_errors;
+        }
+
+        /** @brief  Maximum number of samples read in a burst */
+        static const uint32_t s_maxBurstSamples = 32;
+        /** @brief  Size of a sample in the FIFO (accelerometer and gyroscope) */
+        static const uint32_t s_sampleSize = 12;
+    private:
+        /* Write a register by blocking transfer */
+        bool writeRegister(uint8_t f_register, uint8_t f_value);
+        /* Data-ready interrupt callback */
+        void dataReadyCallback();
+        /* Callback of the FIFO counter reading */
+        void countCallback(bool f_success);
+        /* Callback of the burst reading */
+        void burstCallback(bool f_success);
+        /* Callback of the FIFO reset */
+        void resetCallback(bool f_success);
+
+        /** @brief  mbed I2C object for the configuration */
+        I2C& m_bus;
+        /** @brief  Transaction queue of the I2C bus */
+        hardware::drivers::CI2cBus_I2C1& m_busQueue;
+        /** @brief  Data-ready interrupt input */
+        InterruptIn m_dataReady;
+        /** @brief  7-bit device address */
+        const uint8_t m_address;
+        /** @brief  Sample period in microsecond */
+        uint32_t m_period_us;
+        /** @brief  Scale of the accelerometer */
+        float m_accelScale;
+        /** @brief  Scale of the gyroscope */
+        float m_gyroScale;
+        /** @brief  Number of the data-ready signals between the readings */
+        uint8_t m_batch;
+        /** @brief  Data-ready signals since the last reading */
+        volatile uint32_t m_ready;
+        /** @brief  Timestamp of the last data-ready signal */
+        volatile uint32_t m_readyTimestamp;
+        /** @brief  A reading of the FIFO is queued or active */
+        volatile bool m_pending;
+        /** @brief  Timestamp of the newest sample under reading */
+        uint32_t m_burstTimestamp;
+        /** @brief  Number of the samples in the FIFO at the counter reading */
+        uint32_t m_fifoSamples;
+        /** @brief  Number of the samples under reading */
+        uint32_t m_burstSamples;
+        /** @brief  Buffer of the I2C transfers */
+        uint8_t m_buffer[s_maxBurstSamples * s_sampleSize];
+        /** @brief  Decoded samples */
+        CSampleQueue m_queue;
+        /** @brief  Number of the lost samples */
+        volatile uint32_t m_overruns;
+        /** @brief  Number of the failed transfers */
+        volatile uint32_t m_errors;
+    };
+
+}; // namespace hardware::imu
+
+#endif // MPU6050_HPP
@@ -0,0 +1,140 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    BatteryMonitor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the battery monitor with energy accounting.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef BATTERY_MONITOR_HPP
+#define BATTERY_MONITOR_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/dcmotor.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace hardware::sampling{
+
+   /**
+    * @brief Battery monitor with power and energy accounting, a stage of the control pipeline after the current monitor.
+    *
+    * The pack voltage and the motor current are the results of the DMA scan of the tick, so the monitor doesn't start conversions.
+    * The current sense of the bridge measures the motor current in the on-time of the pwm, the battery gives it only in the on-time,
+    * so the battery current is the motor current scaled by the duty cycle. The power, the drained charge and the energy are integrated
+    * in each tick by compensated (Kahan) sums, so the small increments of the period aren't lost in the single precision total.
+    *
+    * The state of charge starts from the open-circuit voltage of the lithium-polymer cells, when the filtered voltage settled after the
+    * start (the vehicle stands still), then it's counted from the drained charge and the capacity. The open-circuit estimate can be
+    * repeated at rest by '#BMON:2;;' and the state can be set after a charge by '#BMON:1;percent;;'. The request '#BMON:0;;' returns
+    * 'voltage;current;power;energy;soc;;' (V, A, W, Wh, %).
+    */
+    class CBatteryMonitor: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Getter of a measured value */
+        typedef mbed::Callback<float()> FValueGetter;
+
+        /* Constructor */
+        CBatteryMonitor(float                                   f_period
+                       ,FValueGetter                            f_voltage
+                       ,hardware::drivers::ICurrentGetter&      f_current
+                       ,FValueGetter                            f_duty
+                       ,uint8_t                                 f_cells
+                       ,float                                   f_capacity
+                       ,float                                   f_timeConstant);
+        /* Pipeline stage, it integrates the power of the tick */
+        virtual void process(uint32_t f_timestamp);
+        /** @brief  Filtered pack voltage in volt */
+        float getVoltage() const
+        {
+            return m_voltage;
+        }
+        /** @brief  Battery current in ampere */
+        float getCurrent() const
+        {
+            return m_current;
+        }
+        /** @brief  Instantaneous power in watt */
+        float getPower() const
+        {
+            return m_power;
+        }
+        /** @brief  Drained energy since the start in joule */
+        float getEnergy() const
+        {
+            return m_energy;
+        }
+        /** @brief  State of charge in interval [0,1] */
+        float getStateOfCharge() const
+        {
+            return m_stateOfCharge;
+        }
+        /* Set the state of charge */
+        void setStateOfCharge(float f_stateOfCharge);
+        /* Estimate the state of charge from the open-circuit voltage */
+        void estimateStateOfCharge();
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* State of charge of a cell by the open-circuit voltage */
+        static float openCircuitCharge(float f_cellVoltage);
+        /* Compensated accumulation */
+        static void accumulate(float& f_sum, float& f_compensation, float f_value);
+
+        /** @brief  Period of the pipeline in second */
+        const float m_period;
+        /** @brief  Getter of the pack voltage */
+        FValueGetter m_voltageGetter;
+        /** @brief  Getter of the motor current */
+        hardware::drivers::ICurrentGetter& m_currentGetter;
+        /** @brief  Getter of the duty cycle of the bridge */
+        FValueGetter m_dutyGetter;
+        /** @brief  Number of the cells in series */
+        const uint8_t m_cells;
+        /** @brief  Capacity in coulomb */
+        const float m_capacity;
+        /** @brief  Factor of the low-pass filter of the voltage */
+        const float m_alpha;
+        /** @brief  Number of the ticks until the open-circuit estimate at the start */
+        uint32_t m_settleTicks;
+        /** @brief  Filtered pack voltage */
+        volatile float m_voltage;
+        /** @brief  Battery current */
+        volatile float m_current;
+        /** @brief  Instantaneous power */
+        volatile float m_power;
+        /** @brief  Drained energy */
+        volatile float m_energy;
+        /** @brief  Compensation of the energy sum */
+        float m_energyCompensation;
+        /** @brief  Drained charge since the last estimate of the state of charge in coulomb */
+        float m_charge;
+        /** @brief  Compensation of the charge sum */
+        float m_chargeCompensation;
+        /** @brief  State of charge at the last estimate */
+        float m_initialCharge;
+        /** @brief  State of charge */
+        volatile float m_stateOfCharge;
+        /** @brief  A new estimate from the open-circuit voltage is requested */
+        volatile bool m_estimateRequest;
+    };
+
+}; // namespace hardware::sampling
+
+#endif // BATTERY_MONITOR_HPP
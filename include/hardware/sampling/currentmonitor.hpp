@@ -0,0 +1,105 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    CurrentMonitor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the motor current monitor with overcurrent trip.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CURRENT_MONITOR_HPP
+#define CURRENT_MONITOR_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/adcdmascanner.hpp>
+#include <hardware/drivers/dcmotor.hpp>
+#include <signal/filter/filter.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace hardware::sampling{
+
+   /**
+    * @brief Continuous monitor of the motor current with overcurrent trip, a stage of the control pipeline.
+    * 
+    * The analog scanner samples the current in each pwm period in the synchronized mode. The stage moves the sampling point to the 
+    * middle of the on-time of the pwm (half of the duty cycle), so the samples give the mean current of the period, and it filters 
+    * all samples of the tick. The overcurrent is detected by the analog watchdog of the ADC, its interrupt switches off the bridge 
+    * within microseconds, without waiting the control loop. The stage reports the trip by the callback in the next tick (e.g. failsafe 
+    * braking) and it releases the bridge, when the filtered current decreased below the release level.
+    */
+    class CCurrentMonitor: public utils::pipeline::IPipelineStage, public hardware::drivers::ICurrentGetter
+    {
+    public:
+        /** @brief  Callback of the trip, it's applied from the control loop */
+        typedef mbed::Callback<void()> FTripCallback;
+
+        /* Constructor */
+        CCurrentMonitor(hardware::drivers::CAdcDmaScanner_ADC1&       f_adc
+                       ,uint8_t                                       f_index
+                       ,float                                         f_scale
+                       ,signal::filter::IFilter<float>&               f_filter
+                       ,hardware::drivers::CMotorDriverVnh&           f_driver);
+        /* Configure and arm the overcurrent trip */
+        void start(float f_tripCurrent, float f_releaseCurrent, FTripCallback f_callback);
+        /* Pipeline stage, it filters the samples of the tick */
+        virtual void process(uint32_t f_timestamp);
+        /** @brief  Filtered current in ampere */
+        virtual float getCurrent()
+        {
+            return m_current;
+        }
+        /** @brief  Number of the trips since the start */
+        uint32_t getTripCount() const
+        {
+            return m_tripCount;
+        }
+        /* Serial callback of the state */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Interrupt of the analog watchdog */
+        void tripCallback();
+
+        /** @brief  Analog scanner */
+        hardware::drivers::CAdcDmaScanner_ADC1& m_adc;
+        /** @brief  Index of the current in the sequence */
+        const uint8_t m_index;
+        /** @brief  Current in ampere at full scale */
+        const float m_scale;
+        /** @brief  Filter of the samples */
+        signal::filter::IFilter<float>& m_filter;
+        /** @brief  Motor driver */
+        hardware::drivers::CMotorDriverVnh& m_driver;
+        /** @brief  Callback of the trip */
+        FTripCallback m_callback;
+        /** @brief  Release level of the bridge in ampere */
+        float m_releaseCurrent;
+        /** @brief  Slot of the next unprocessed sample */
+        uint8_t m_slot;
+        /** @brief  Filtered current */
+        volatile float m_current;
+        /** @brief  Number of the trips */
+        volatile uint32_t m_tripCount;
+        /** @brief  Number of the reported trips */
+        uint32_t m_reportedCount;
+        /** @brief  The trip is armed */
+        bool m_isStarted;
+    };
+
+}; // namespace hardware::sampling
+
+#endif // CURRENT_MONITOR_HPP
@@ -0,0 +1,118 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    LineSensor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the reflective infrared line array.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef LINE_SENSOR_HPP
+#define LINE_SENSOR_HPP
+
+#include <mbed.h>
+#include <hardware/sampling/sampler.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace hardware::sampling{
+
+    /** @brief Maximum number of the elements of the line array */
+    const uint8_t g_maxLineChannels = 8;
+
+    /** @brief Reading of the line array in a tick */
+    struct SLineReading{
+        /** @brief timestamp of the tick in microsecond */
+        uint32_t m_timestamp;
+        /** @brief calibrated readings, 0 is the background and 1 is the line */
+        float    m_values[g_maxLineChannels];
+        /** @brief lateral position of the line in meter, zero at the middle of the array, positive towards the last element */
+        float    m_position;
+        /** @brief difference between the peak and the mean of the readings */
+        float    m_contrast;
+        /** @brief the line is detected, otherwise the position is the last detected one */
+        bool     m_valid;
+    };
+
+   /**
+    * @brief Reflective infrared line array, a stage of the control pipeline after the sampler.
+    *
+    * The elements are the consecutive analog inputs of the sampler snapshot, so they are converted by the DMA scan of the ADC together
+    * with the other analog inputs, without blocking reads. Each reading is normalized by the calibrated range of its element, the
+    * normalization, the peak search and the mean are calculated in one pass over the elements. The position of the line is refined
+    * between the elements by the parabola through the peak and its neighbours, so the resolution is a fraction of the pitch. The line
+    * is detected, when the peak exceeds the mean by the minimal contrast. The reading of the tick is published consistently for the
+    * readers of other threads.
+    *
+    * The calibration is started by '#LINE:1;;', the array has to be moved over the line and the background, the minimum and the maximum
+    * of each element are recorded, then '#LINE:2;;' applies the new ranges ('ack;;') or it keeps the previous ones, when an element
+    * doesn't have enough range ('calibration error;;'). '#LINE:0;;' returns 'valid;position;contrast;;' with the position in millimeter.
+    */
+    class CLineSensor: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /* Constructor */
+        CLineSensor(CSampler& f_sampler, uint8_t f_first, uint8_t f_count, float f_pitch, bool f_darkLine);
+        /* Pipeline stage, it processes the readings of the snapshot */
+        virtual void process(uint32_t f_timestamp);
+        /** @brief  Reading of the current tick, it can be read by the stages of the pipeline */
+        const SLineReading& current() const
+        {
+            return m_reading;
+        }
+        /* Get a consistent copy of the last reading from other threads */
+        SLineReading getReading();
+        /* Start the recording of the ranges */
+        void startCalibration();
+        /* Apply the recorded ranges */
+        bool finishCalibration();
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Minimal difference between the peak and the mean of the normalized readings */
+        static constexpr float s_minContrast = 0.25f;
+        /** @brief  Minimal calibrated range of an element in raw units */
+        static const uint16_t s_minRange = 200;
+    private:
+        /** @brief  Sampler */
+        CSampler& m_sampler;
+        /** @brief  Index of the first element in the snapshot */
+        const uint8_t m_first;
+        /** @brief  Number of the elements */
+        const uint8_t m_count;
+        /** @brief  Distance of the elements in meter */
+        const float m_pitch;
+        /** @brief  The line reflects less than the background */
+        const bool m_darkLine;
+        /** @brief  Calibrated minimum of the elements */
+        uint16_t m_min[g_maxLineChannels];
+        /** @brief  Inverse of the calibrated range of the elements */
+        float m_scale[g_maxLineChannels];
+        /** @brief  Recorded minimum of the calibration */
+        uint16_t m_recordedMin[g_maxLineChannels];
+        /** @brief  Recorded maximum of the calibration */
+        uint16_t m_recordedMax[g_maxLineChannels];
+        /** @brief  The ranges are recorded */
+        volatile bool m_isCalibrating;
+        /** @brief  Last reading */
+        SLineReading m_reading;
+        /** @brief  Sequence counter of the reading, it's odd during the update */
+        volatile uint32_t m_sequence;
+    };
+
+}; // namespace hardware::sampling
+
+#endif // LINE_SENSOR_HPP
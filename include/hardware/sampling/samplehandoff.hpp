@@ -0,0 +1,86 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    SampleHandoff.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the handoff of the
+  *          sensor samples to the consumer threads.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SAMPLE_HANDOFF_HPP
+#define SAMPLE_HANDOFF_HPP
+
+#include <mbed.h>
+#include <hardware/sampling/sampler.hpp>
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/queue/mailhandoff.hpp>
+
+namespace hardware::sampling{
+
+    /** @brief Sample block of a tick, it's filled once by the control loop and it's owned by the consumer after the handoff */
+    struct SSampleBlock{
+        /** @brief timestamp of the tick in microsecond */
+        uint32_t m_timestamp;
+        /** @brief counted impulses of the encoder in the period */
+        int16_t  m_count;
+        /** @brief rotation speed of the encoder in rotation per second */
+        float    m_speedRps;
+        /** @brief raw 12-bit results of the analog inputs */
+        uint16_t m_analog[hardware::drivers::CAdcDmaScanner_ADC1::s_maxChannels];
+        /** @brief the analog conversion finished in time */
+        bool     m_analogValid;
+    };
+
+    /** @brief Handoff of the sample blocks, four blocks can be held by the consumer */
+    typedef utils::CMailHandoff<SSampleBlock,4> CSampleMail;
+
+   /**
+    * @brief Handoff of the sensor samples to a consumer outside of the control loop, a stage of the pipeline after the encoder.
+    *
+    * The consumers of the other threads read the sensors by the getters, each call computes the value from the current state again and
+    * they can observe the state of different ticks. The stage passes the samples of the tick instead: each decimated tick it claims a
+    * block of the mail pool, it writes the analog results of the snapshot and the speed of the encoder once in the block and it passes
+    * the block to the consumer, the consumer owns it until the release, so the block isn't copied again and it isn't overwritten while
+    * it's read. The consumer takes the blocks without polling: its thread waits on the mail or its task is triggered by the notifier.
+    * When the consumer holds all blocks, the sample of the tick is dropped, the control loop doesn't wait.
+    */
+    class CSampleHandoff: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /* Constructor */
+        CSampleHandoff(CSampler& f_sampler, hardware::encoders::IEncoderGetter& f_encoder, CSampleMail& f_mail, uint32_t f_decimation);
+        /* Pipeline stage, it passes the sample of the tick */
+        virtual void process(uint32_t f_timestamp);
+    private:
+        /** @brief  Sampler */
+        CSampler& m_sampler;
+        /** @brief  Speed encoder */
+        hardware::encoders::IEncoderGetter& m_encoder;
+        /** @brief  Mail of the blocks */
+        CSampleMail& m_mail;
+        /** @brief  Number of the ticks per sample */
+        const uint32_t m_decimation;
+        /** @brief  Ticks since the last sample */
+        uint32_t m_ticks;
+    };
+
+}; // namespace hardware::sampling
+
+#endif // SAMPLE_HANDOFF_HPP
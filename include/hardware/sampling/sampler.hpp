@@ -0,0 +1,150 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Sampler.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the batched sampling of the sensors.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SAMPLER_HPP
+#define SAMPLER_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/adcdmascanner.hpp>
+#include <hardware/drivers/dcmotor.hpp>
+#include <hardware/encoders/quadraturecounter.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace hardware::sampling{
+
+    /** @brief Maximum number of the latched counters */
+    const uint8_t g_maxCounters = 4;
+
+    /** @brief Coherent snapshot of the sensors in a tick */
+    struct SSnapshot{
+        /** @brief timestamp of the tick in microsecond */
+        uint32_t m_timestamp;
+        /** @brief raw values of the counters latched at the same instant */
+        uint32_t m_counters[g_maxCounters];
+        /** @brief raw 12-bit results of the analog inputs */
+        uint16_t m_analog[hardware::drivers::CAdcDmaScanner_ADC1::s_maxChannels];
+        /** @brief the analog conversion finished in time */
+        bool     m_analogValid;
+    };
+
+   /**
+    * @brief Sampling service, the first stage of the control pipeline.
+    * 
+    * It triggers the conversion of the analog inputs, it latches the encoder counters at the same instant and it waits the results 
+    * of the conversion, so the following stages (controllers, telemetry) read one coherent snapshot of the tick. The snapshot is also 
+    * published consistently for the readers of other threads.
+    */
+    class CSampler: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /* Constructor */
+        CSampler(hardware::drivers::CAdcDmaScanner_ADC1& f_adc, hardware::drivers::IQuadratureCounter_TIMX** f_counters, uint8_t f_counterCount);
+        /* Start the analog scanner */
+        void start();
+        /* Pipeline stage, it takes the snapshot of the tick */
+        virtual void process(uint32_t f_timestamp);
+        /** @brief  Snapshot of the current tick, it can be read by the stages of the pipeline */
+        const SSnapshot& current() const
+        {
+            return m_snapshot;
+        }
+        /* Get a consistent copy of the last snapshot from other threads */
+        SSnapshot getSnapshot();
+    private:
+        /** @brief  Analog scanner */
+        hardware::drivers::CAdcDmaScanner_ADC1& m_adc;
+        /** @brief  Latched counters */
+        hardware::drivers::IQuadratureCounter_TIMX** m_counters;
+        /** @brief  Number of the latched counters */
+        const uint8_t m_counterCount;
+        /** @brief  Last snapshot */
+        SSnapshot m_snapshot;
+        /** @brief  Sequence counter of the snapshot, it's odd during the update */
+        volatile uint32_t m_sequence;
+    };
+
+   /**
+    * @brief Counter interface of a latched counter, it returns the value of the snapshot, so the encoder uses the value latched together with the other sensors.
+    * 
+    * The encoder has to be applied in free running mode, the reset is forwarded to the underlying counter.
+    */
+    class CLatchedCounter: public hardware::drivers::IQuadratureCounter_TIMX
+    {
+    public:
+        /* Constructor */
+        CLatchedCounter(CSampler& f_sampler, hardware::drivers::IQuadratureCounter_TIMX& f_counter, uint8_t f_index);
+        virtual int16_t getCount();
+        virtual void reset();
+        virtual uint32_t getRawCount();
+        virtual bool is32Bit();
+    private:
+        /** @brief  Sampler */
+        CSampler& m_sampler;
+        /** @brief  Underlying counter */
+        hardware::drivers::IQuadratureCounter_TIMX& m_counter;
+        /** @brief  Index of the counter in the snapshot */
+        const uint8_t m_index;
+    };
+
+   /**
+    * @brief Current getter based on an analog input of the snapshot, it doesn't start a blocking conversion.
+    */
+    class CSampledCurrent: public hardware::drivers::ICurrentGetter
+    {
+    public:
+        /* Constructor */
+        CSampledCurrent(CSampler& f_sampler, uint8_t f_index, float f_scale);
+        /* Get current */
+        virtual float getCurrent();
+    private:
+        /** @brief  Sampler */
+        CSampler& m_sampler;
+        /** @brief  Index of the analog input in the snapshot */
+        const uint8_t m_index;
+        /** @brief  Current in ampere at full scale */
+        const float m_scale;
+    };
+
+   /**
+    * @brief Voltage getter based on an analog input of the snapshot (e.g. the battery voltage over a resistor divider).
+    */
+    class CSampledVoltage
+    {
+    public:
+        /* Constructor */
+        CSampledVoltage(CSampler& f_sampler, uint8_t f_index, float f_scale);
+        /* Get voltage */
+        float getVoltage();
+    private:
+        /** @brief  Sampler */
+        CSampler& m_sampler;
+        /** @brief  Index of the analog input in the snapshot */
+        const uint8_t m_index;
+        /** @brief  Voltage in volt at full scale */
+        const float m_scale;
+    };
+
+}; // namespace hardware::sampling
+
+#endif // SAMPLER_HPP
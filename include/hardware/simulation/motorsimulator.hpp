@@ -0,0 +1,128 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+ * @file motorsimulator.hpp
+ * @author RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-12-02
+ * 
+ */
+#ifndef MOTOR_SIMULATOR_HPP
+#define MOTOR_SIMULATOR_HPP
+
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <hardware/drivers/dcmotor.hpp>
+#include <signal/systemmodels/systemmodels.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+#include <mbed.h>
+
+namespace hardware::simulation{
+
+/**
+ * @brief Simulated plant of the dc motor with the bridge driver and the encoder, it replaces the hardware for the closed-loop tests.
+ * 
+ * The states are the position (rotation), the speed (rps) and the current (A), the inputs are the bridge voltage and the load 
+ * torque, the model is the armature circuit L*i' = u - R*i - Ke*speed and the rotor 2*pi*J*speed' = Kt*i - b*speed - load with Kt = Ke/(2*pi). 
+ * It's discretized by the Euler method in substeps of the period, so the electrical time constant may be shorter than the period. 
+ * The commands follow the VNH driver: the sign of the pwm is the direction, the brake shorts the motor. The encoder counts the 
+ * impulses of the simulated position, the position state is kept below one impulse to avoid the loss of precision. It has to be 
+ * applied in the pipeline before the stages, which read the encoder.
+ */
+class CMotorSimulator:public hardware::encoders::IEncoderGetter, public hardware::drivers::IMotorCommand, public hardware::drivers::ICurrentGetter, public utils::pipeline::IPipelineStage{
+  public:
+      /** @brief Parameters of the motor model */
+      struct SMotorModel{
+        /** @brief Armature resistance (Ohm) */
+        float m_resistance;
+        /** @brief Armature inductance (H) */
+        float m_inductance;
+        /** @brief Back electromotive force constant (V/rps) */
+        float m_backEmf;
+        /** @brief Moment of inertia of the rotor and the reduced load (kg*m^2) */
+        float m_inertia;
+        /** @brief Viscous friction (N*m/rps) */
+        float m_friction;
+        /** @brief Supply voltage of the bridge (V) */
+        float m_supply;
+      };
+      /* Constructor */
+      CMotorSimulator(float f_period, uint16_t f_resolution, const SMotorModel& f_model, uint8_t f_substeps = 10, float f_inf_limit = -1.0, float f_sup_limit = 1.0);
+      /* Pipeline stage */
+      virtual void process(uint32_t f_timestamp);
+      /* Run */
+      virtual void setSpeed(float f_pwm);
+      /* Brake */
+      virtual void brake();
+      /* Inverse */
+      virtual void inverseDirection(float f_pwm);
+      /* Coast */
+      virtual void coast();
+      /* Proportional dynamic braking */
+      virtual void dynamicBrake(float f_duty);
+      /* Check the allowed range */
+      virtual bool inRange(float f_pwm);
+      /* Simulated current */
+      virtual float getCurrent();
+      /* Counted impulses of the encoder in the last period */
+      virtual int16_t getCount();
+      /* Measured rotation speed */
+      virtual float getSpeedRps();
+      virtual bool isAbs(){return false;}
+      /** @brief Accumulated position of the encoder in impulses since the start */
+      int64_t getPosition(){return m_position;}
+      /* Set the load torque */
+      void setLoad(float f_torque);
+      /* Simulated rotation speed */
+      float getModelSpeedRps();
+  private:
+      /** @brief Type of the model: 3 states, 2 inputs (voltage, load), 2 outputs (speed, current) */
+      using CModelType = signal::systemmodels::lti::mimo::CSSModel<float,3,2,2>;
+      /* Create the discrete system model */
+      static CModelType systemModel(float f_period, const SMotorModel& f_model, uint8_t f_substeps);
+      /** @brief Resolution of the encoder */
+      const float m_resolution;
+      /** @brief Period in second */
+      const float m_period;
+      /** @brief Supply voltage of the bridge */
+      const float m_supply;
+      /** @brief Back electromotive force constant (V/rps) */
+      const float m_backEmf;
+      /** @brief Inferior limit of the pwm */
+      const float m_inf_limit;
+      /** @brief Superior limit of the pwm */
+      const float m_sup_limit;
+      /** @brief Discrete model of the motor */
+      CModelType m_model;
+      /** @brief Direction of the bridge: 1 forward, -1 backward, 0 brake (the duty cycle is the part of the shorted period) */
+      volatile int8_t m_direction;
+      /** @brief Duty cycle of the bridge */
+      volatile float m_duty;
+      /** @brief Load torque */
+      volatile float m_load;
+      /** @brief Counted impulses in the last period */
+      int16_t m_count;
+      /** @brief Accumulated impulses since the start */
+      int64_t m_position;
+      /** @brief Simulated speed */
+      volatile float m_speed;
+      /** @brief Simulated current */
+      volatile float m_current;
+};
+
+}; // namespace hardware::simulation
+
+#endif // MOTOR_SIMULATOR_HPP
@@ -0,0 +1,130 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Autotuner.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the relay feedback
+  *          autotuning of the pid controller.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef AUTOTUNER_HPP
+#define AUTOTUNER_HPP
+
+#include <cmath>
+#include <stdint.h>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Relay feedback experiment to identify the critical point of the plant and to calculate the pid parameters (Astrom-Hagglund).
+    * 
+    * During the experiment the controller is replaced by a relay with hysteresis around the bias of the control signal, so the closed 
+    * loop oscillates with the critical period. The first cycles are skipped as transient, the period and the amplitude of the error are 
+    * averaged over the given number of cycles. The critical gain is Ku = 4*d/(pi*a), where d is the amplitude of the relay and a is the 
+    * amplitude of the oscillation. The parameters are calculated by the Ziegler-Nichols or by the more robust Tyreus-Luyben rule, the 
+    * time constant of the derivative filter is the tenth of the derivative time, but at least four sampling periods.
+    */
+    class CRelayAutotuner
+    {
+        public:
+            /** @brief Tuning rules */
+            enum ERule{
+                ZIEGLER_NICHOLS = 0,
+                TYREUS_LUYBEN = 1
+            };
+            /** @brief State of the experiment */
+            enum EState{
+                IDLE = 0,
+                RUNNING = 1,
+                FINISHED = 2,
+                FAILED = 3
+            };
+            /** @brief Result of the experiment */
+            struct SResult{
+                float m_ku;     /** critical gain */
+                float m_tu;     /** critical period (s) */
+                float m_kp;     /** proportional factor */
+                float m_ki;     /** integral factor */
+                float m_kd;     /** derivative factor */
+                float m_tf;     /** derivative time filter constant */
+            };
+
+            /* Constructor */
+            CRelayAutotuner(float f_dt, ERule f_rule = TYREUS_LUYBEN, uint8_t f_skipCycles = 2, uint8_t f_cycles = 4, float f_timeout = 3.0f);
+            /* Start the experiment */
+            void start(float f_bias, float f_amplitude, float f_hysteresis);
+            /* Stop the experiment */
+            void stop();
+            /* Apply one step of the experiment */
+            float step(float f_error);
+            /** @brief State of the experiment */
+            EState getState() const
+            {
+                return m_state;
+            }
+            /** @brief Result of the finished experiment */
+            const SResult& getResult() const
+            {
+                return m_result;
+            }
+
+        private:
+            /* Calculate the parameters by the measured critical point */
+            void calculate();
+
+            /* Sampling time */
+            const float                             m_dt;
+            /* Tuning rule */
+            const ERule                             m_rule;
+            /* Number of the skipped transient cycles */
+            const uint8_t                           m_skipCycles;
+            /* Number of the measured cycles */
+            const uint8_t                           m_cycles;
+            /* Maximum number of the periods without switching of the relay */
+            const uint32_t                          m_timeout;
+            /* Bias of the control signal */
+            float                                   m_bias;
+            /* Amplitude of the relay */
+            float                                   m_amplitude;
+            /* Hysteresis of the relay */
+            float                                   m_hysteresis;
+            /* Relay output is high */
+            bool                                    m_isHigh;
+            /* Number of the periods in the current cycle */
+            uint32_t                                m_tick;
+            /* Number of the finished cycles */
+            uint8_t                                 m_cycle;
+            /* Extremes of the error in the current cycle */
+            float                                   m_max;
+            float                                   m_min;
+            /* Sums of the measured periods and amplitudes */
+            uint32_t                                m_sumTicks;
+            float                                   m_sumAmplitude;
+            /* State of the experiment */
+            EState                                  m_state;
+            /* Result of the experiment */
+            SResult                                 m_result;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // AUTOTUNER_HPP
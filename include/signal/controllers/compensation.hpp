@@ -0,0 +1,283 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Compensation.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the nonlinear
+  *          compensation stages of the actuators.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef COMPENSATION_HPP
+#define COMPENSATION_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <stdint.h>
+#include <signal/controllers/converters.hpp>
+#include <hardware/drivers/steeringmotor.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Inverse of a symmetric deadband, the output jumps over the deadband of the actuator.
+    *
+    * Above the threshold the deadband is added with the sign of the input, below it the added part is ramped linearly from zero, so
+    * the small inputs around zero don't chatter between the two edges of the deadband.
+    */
+    class CDeadbandInverse
+    {
+        public:
+            /** @brief Constructor, the deadband and the threshold are in the unit of the output */
+            constexpr CDeadbandInverse(float f_deadband, float f_threshold)
+                : m_deadband(f_deadband)
+                , m_slope((f_threshold > 0.0f) ? f_deadband / f_threshold : 0.0f)
+                , m_threshold(f_threshold)
+            {
+            }
+            /** @brief Compensated value */
+            CONTROL_RAMFUNC float operator()(float f_input)
+            {
+                float l_abs = (f_input < 0.0f) ? -f_input : f_input;
+                float l_added = (l_abs >= m_threshold) ? m_deadband : m_slope * l_abs;
+                return (f_input < 0.0f) ? f_input - l_added : ((f_input > 0.0f) ? f_input + l_added : 0.0f);
+            }
+            /** @brief The deadband doesn't have state */
+            void reset()
+            {
+            }
+        private:
+            /** @brief Half width of the deadband */
+            const float m_deadband;
+            /** @brief Slope of the ramp below the threshold */
+            const float m_slope;
+            /** @brief Input of the full compensation */
+            const float m_threshold;
+    };
+
+   /**
+    * @brief Inverse of a backlash (e.g. the gears of the steering servo), the output is shifted by the half width toward the actual
+    * direction of the move.
+    *
+    * The direction changes, when the input returns more than the hysteresis from its last extreme, so the noise of the command doesn't
+    * switch the shift. The first direction is taken by the first move over the hysteresis, until it the input is forwarded without
+    * shift. The width can be changed at runtime (e.g. by the measured backlash of the calibration), zero forwards the input.
+    */
+    class CBacklashInverse
+    {
+        public:
+            /** @brief Constructor, the width and the hysteresis are in the unit of the input */
+            constexpr CBacklashInverse(float f_width, float f_hysteresis)
+                : m_halfWidth(0.5f * f_width)
+                , m_hysteresis(f_hysteresis)
+                , m_extreme(0.0f)
+                , m_direction(0)
+                , m_started(false)
+            {
+            }
+            /** @brief Compensated value */
+            CONTROL_RAMFUNC float operator()(float f_input)
+            {
+                if (!m_started)
+                {
+                    m_started = true;
+                    m_extreme = f_input;
+                }
+                else if ((m_direction > 0 && f_input > m_extreme) || (m_direction < 0 && f_input < m_extreme))
+                {
+                    m_extreme = f_input;
+                }
+                else if (m_direction >= 0 && f_input < m_extreme - m_hysteresis)
+                {
+                    m_extreme = f_input;
+                    m_direction = -1;
+                }
+                else if (m_direction <= 0 && f_input > m_extreme + m_hysteresis)
+                {
+                    m_extreme = f_input;
+                    m_direction = 1;
+                }
+                return f_input + static_cast<float>(m_direction) * m_halfWidth;
+            }
+            /** @brief Forget the direction, the next input starts without shift */
+            void reset()
+            {
+                m_started = false;
+                m_direction = 0;
+            }
+            /** @brief Set the width of the backlash, negative values aren't applied */
+            void setWidth(float f_width)
+            {
+                m_halfWidth = (f_width > 0.0f) ? 0.5f * f_width : 0.0f;
+            }
+        private:
+            /** @brief Half width of the backlash */
+            float m_halfWidth;
+            /** @brief Return of the input, which changes the direction */
+            const float m_hysteresis;
+            /** @brief Extreme of the input in the actual direction */
+            float m_extreme;
+            /** @brief Direction of the move: 1 increasing, -1 decreasing, 0 before the first move */
+            int8_t m_direction;
+            /** @brief The first input was applied */
+            bool m_started;
+    };
+
+   /**
+    * @brief Slew rate limiter, the output approaches the input by at most the rate multiplied by the period in each call.
+    */
+    class CSlewLimiter
+    {
+        public:
+            /** @brief Constructor, the rate is in the unit of the input per second, the period in second */
+            constexpr CSlewLimiter(float f_rate, float f_period)
+                : m_maxStep(f_rate * f_period)
+                , m_output(0.0f)
+                , m_started(false)
+            {
+            }
+            /** @brief Limited value */
+            CONTROL_RAMFUNC float operator()(float f_input)
+            {
+                if (!m_started)
+                {
+                    m_started = true;
+                    m_output = f_input;
+                }
+                else if (f_input > m_output + m_maxStep)
+                {
+                    m_output += m_maxStep;
+                }
+                else if (f_input < m_output - m_maxStep)
+                {
+                    m_output -= m_maxStep;
+                }
+                else
+                {
+                    m_output = f_input;
+                }
+                return m_output;
+            }
+            /** @brief The next input is applied without limit */
+            void reset()
+            {
+                m_started = false;
+            }
+        private:
+            /** @brief Maximum change in a call */
+            const float m_maxStep;
+            /** @brief Last output */
+            float m_output;
+            /** @brief The first input was applied */
+            bool m_started;
+    };
+
+   /**
+    * @brief Chain of compensation stages wired at compile time, it's a converter, so it can be placed before the converter of a
+    * controller or it can be applied by a decorator of an actuator (CCompensatedSteering).
+    *
+    * The stages are held by value and applied by qualified calls in order, like the stages of the CStaticPipeline, so the chain is
+    * constructed in the constant initialization and the conversion doesn't have indirect calls between the stages.
+    *
+    * @tparam TStages   types of the stages in order of application, each of them has a 'float operator()(float)' and a 'reset()' method
+    */
+    template <class... TStages>
+    class CCompensationChain: public IConverter
+    {
+        public:
+            /** @brief Constructor */
+            constexpr CCompensationChain(TStages... f_stages)
+                : m_stages(f_stages...)
+            {
+            }
+            /* Apply the stages */
+            float operator()(float f_input);
+            /* Reset the state of the stages */
+            void reset();
+            /** @brief Stage with the given index */
+            template <uint32_t I>
+            typename std::tuple_element<I, std::tuple<TStages...>>::type& stage()
+            {
+                return std::get<I>(m_stages);
+            }
+        private:
+            /* Apply the stage with the given index and the next ones */
+            template <uint32_t I>
+            typename std::enable_if<(I < sizeof...(TStages)), float>::type apply(float f_input);
+            /** @brief  End of the stages */
+            template <uint32_t I>
+            typename std::enable_if<(I == sizeof...(TStages)), float>::type apply(float f_input)
+            {
+                return f_input;
+            }
+            /* Reset the stage with the given index and the next ones */
+            template <uint32_t I>
+            typename std::enable_if<(I < sizeof...(TStages))>::type resetFrom();
+            /** @brief  End of the stages */
+            template <uint32_t I>
+            typename std::enable_if<(I == sizeof...(TStages))>::type resetFrom()
+            {
+            }
+
+            /** @brief Stages in order of application */
+            std::tuple<TStages...> m_stages;
+    };
+
+   /**
+    * @brief Decorator of the steering servo, the angle command is compensated by the chain before the servo.
+    *
+    * The angle of the servo driver is the compensated one, the range is checked on the command.
+    *
+    * @tparam TChain    type of the compensation chain
+    */
+    template <class TChain>
+    class CCompensatedSteering: public hardware::drivers::ISteeringCommand
+    {
+        public:
+            /** @brief Constructor */
+            CCompensatedSteering(hardware::drivers::ISteeringCommand& f_servo, TChain& f_chain)
+                : m_servo(f_servo)
+                , m_chain(f_chain)
+            {
+            }
+            /** @brief Set the compensated angle */
+            void setAngle(float f_angle)
+            {
+                m_servo.setAngle(m_chain.TChain::operator()(f_angle));
+            }
+            /** @brief Check the range of the command */
+            bool inRange(float f_angle)
+            {
+                return m_servo.inRange(f_angle);
+            }
+        private:
+            /** @brief Steering servo */
+            hardware::drivers::ISteeringCommand& m_servo;
+            /** @brief Compensation chain */
+            TChain& m_chain;
+    };
+
+    #include "compensation.tpp"
+}; // namespace controllers
+}; // namespace signal
+
+#endif // COMPENSATION_HPP
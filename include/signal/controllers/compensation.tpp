@@ -0,0 +1,75 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Compensation.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the chain of the
+  *          nonlinear compensation stages.
+  ******************************************************************************
+ */
+
+#ifndef COMPENSATION_TPP
+#define COMPENSATION_TPP
+
+#ifndef COMPENSATION_HPP
+#error __FILE__ should only be included from compensation.hpp.
+#endif // COMPENSATION_HPP
+
+/** \brief  Apply the stages in order
+ *
+ *  @param f_input         input of the first stage
+ *  @return                output of the last stage
+ */
+template <class... TStages>
+CONTROL_RAMFUNC float CCompensationChain<TStages...>::operator()(float f_input)
+{
+    return apply<0>(f_input);
+}
+
+/** \brief  Reset the state of the stages, e.g. after a change of the actuator
+ */
+template <class... TStages>
+void CCompensationChain<TStages...>::reset()
+{
+    resetFrom<0>();
+}
+
+/** \brief  Apply the stage with the given index and the next ones, the call is qualified by the type of the stage
+ *
+ *  @param f_input         input of the stage
+ *  @return                output of the last stage
+ */
+template <class... TStages>
+template <uint32_t I>
+CONTROL_RAMFUNC typename std::enable_if<(I < sizeof...(TStages)), float>::type CCompensationChain<TStages...>::apply(float f_input)
+{
+    using TStage = typename std::tuple_element<I, std::tuple<TStages...>>::type;
+    return apply<I + 1>(std::get<I>(m_stages).TStage::operator()(f_input));
+}
+
+/** \brief  Reset the stage with the given index and the next ones
+ */
+template <class... TStages>
+template <uint32_t I>
+typename std::enable_if<(I < sizeof...(TStages))>::type CCompensationChain<TStages...>::resetFrom()
+{
+    std::get<I>(m_stages).reset();
+    resetFrom<I + 1>();
+}
+
+#endif // COMPENSATION_TPP
@@ -29,6 +29,8 @@ limitations under the License.
 #include<cmath>
 #include<stdint.h>
 #include<array>
+#include<algorithm>
+#include<utils/memory/sections.hpp>
 
 namespace signal{
   namespace controllers{
@@ -58,15 +60,15 @@ namespace signal{
       };
 
       /**
-       * @brief A converter based on the set of break point and the multiple polynomial function.
+       * @brief Break points and polynomial functions of the spline converter, it's a literal type, so the coefficients of a constexpr 
+       * object are placed in flash.
        * 
        * @tparam NrBreak Number of the break.
        * @tparam NOrd    Degree of the polynomial converter. 
        */
       template<uint8_t NrBreak,uint8_t NOrd>
-      class CConverterSpline:public IConverter
+      struct SSplineCoefficients
       {
-        public:
           /** @brief Coefficient container types */
           using CCoeffContainerType = std::array<float,NOrd+1>;
           /** @brief Splines container type */
@@ -74,16 +76,83 @@ namespace signal{
           /** @brief Breaks container type */
           using CBreakContainerType = std::array<float,NrBreak>;
 
+          /** @brief Constructor */
+          constexpr SSplineCoefficients(const CBreakContainerType& f_breaks,const CSplineContainerType& f_splines)
+            : m_breaks(f_breaks), m_splines(f_splines) {}
+          /** @brief Break points */
+          CBreakContainerType     m_breaks;
+          /** @brief Polynomial functions, from the highest degree */
+          CSplineContainerType    m_splines;
+      };
+
+      /**
+       * @brief A converter based on the set of break point and the multiple polynomial function.
+       * 
+       * The coefficients are stored by the TCoeffs type: by default the converter owns a copy, which can be set again (e.g. calibration), 
+       * with a constant reference (CConstConverterSpline) it refers to a constexpr SSplineCoefficients object in flash.
+       * 
+       * @tparam NrBreak Number of the break.
+       * @tparam NOrd    Degree of the polynomial converter. 
+       * @tparam TCoeffs Storage of the coefficients, SSplineCoefficients or its constant reference
+       */
+      template<uint8_t NrBreak,uint8_t NOrd,class TCoeffs = SSplineCoefficients<NrBreak,NOrd>>
+      class CConverterSpline:public IConverter
+      {
+        public:
+          /** @brief Coefficient container types */
+          using CCoeffContainerType = typename SSplineCoefficients<NrBreak,NOrd>::CCoeffContainerType;
+          /** @brief Splines container type */
+          using CSplineContainerType = typename SSplineCoefficients<NrBreak,NOrd>::CSplineContainerType;
+          /** @brief Breaks container type */
+          using CBreakContainerType = typename SSplineCoefficients<NrBreak,NOrd>::CBreakContainerType;
+
           CConverterSpline(CBreakContainerType f_breaks,CSplineContainerType f_splines);
+          /** @brief Constructor from the coefficients, they are copied or referred by the storage */
+          constexpr CConverterSpline(const SSplineCoefficients<NrBreak,NOrd>& f_coeffs) : m_coeffs(f_coeffs) {}
+          void set(const CBreakContainerType& f_breaks,const CSplineContainerType& f_splines);
           float operator()(float);
         private:
-          float splineValue( CCoeffContainerType,float);
+          float splineValue(const CCoeffContainerType&,float);
 
-          CBreakContainerType     m_breaks;
-          CSplineContainerType    m_splines;
+          TCoeffs                 m_coeffs;
           
       };
 
+      /** @brief Spline converter with constant coefficients, it refers to a constexpr SSplineCoefficients object */
+      template<uint8_t NrBreak,uint8_t NOrd>
+      using CConstConverterSpline = CConverterSpline<NrBreak,NOrd,const SSplineCoefficients<NrBreak,NOrd>&>;
+
+      /**
+       * @brief A converter based on a uniformly spaced lookup table with linear interpolation.
+       * 
+       * The table is generated at construction time by sampling the source converter in the given range. Outside of the 
+       * range the first and the last segments are extrapolated. When the break points of a piecewise linear source fall 
+       * on the grid points, the table reproduces the source exactly. 
+       * 
+       * @tparam NSize Number of the points in the table.
+       */
+      template<uint32_t NSize>
+      class CConverterLookupTable:public IConverter
+      {
+        static_assert(NSize >= 2, "The lookup table needs at least two points.");
+        public:
+          /** @brief Table container type */
+          using CTableContainerType = std::array<float,NSize>;
+
+          CConverterLookupTable(IConverter& f_source,float f_min,float f_max);
+          void sample(IConverter& f_source);
+          float operator()(float);
+        private:
+          /** @brief Sampled values of the source converter */
+          CTableContainerType     m_table;
+          /** @brief Start of the range */
+          float                   m_min;
+          /** @brief Distance between two points */
+          float                   m_step;
+          /** @brief Inverse of the distance between two points */
+          float                   m_invStep;
+      };
+
       #include "converters.tpp"
   }; //namespace controllers
 
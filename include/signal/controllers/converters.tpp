@@ -42,9 +42,10 @@ CConverterPolynom<NOrd>::CConverterPolynom(std::array<float,NOrd+1> f_coeff)
  */
 template<uint8_t NOrd>
 float CConverterPolynom<NOrd>::operator()(float f_v){
-    float l_res = m_coeff[NOrd];
-    for (uint8_t i = 0;i<NOrd;++i){
-        l_res += std::pow(f_v, NOrd-i)*m_coeff[i];
+    // Horner's scheme, the coefficients are ordered from the highest degree
+    float l_res = m_coeff[0];
+    for (uint8_t i = 1;i<=NOrd;++i){
+        l_res = l_res*f_v + m_coeff[i];
     }
     return l_res;
 }
@@ -58,30 +59,34 @@ float CConverterPolynom<NOrd>::operator()(float f_v){
  * @param f_breaks The list of the break points.
  * @param f_splines The list of the polynomial function.
  */
-template <uint8_t NrBreak, uint8_t NOrd>
-CConverterSpline<NrBreak, NOrd>::CConverterSpline(CConverterSpline<NrBreak, NOrd>::CBreakContainerType f_breaks,CConverterSpline<NrBreak, NOrd>::CSplineContainerType f_splines)
-:m_breaks(f_breaks)
-,m_splines(f_splines)
+template <uint8_t NrBreak, uint8_t NOrd, class TCoeffs>
+CConverterSpline<NrBreak, NOrd, TCoeffs>::CConverterSpline(CBreakContainerType f_breaks,CSplineContainerType f_splines)
+:m_coeffs(f_breaks, f_splines)
 {
 }
 
+/**
+ * @brief Set the break points and the polynomial functions (e.g. calibration loaded at the startup).
+ * 
+ * @param f_breaks The list of the break points.
+ * @param f_splines The list of the polynomial function.
+ */
+template <uint8_t NrBreak, uint8_t NOrd, class TCoeffs>
+void CConverterSpline<NrBreak, NOrd, TCoeffs>::set(const CBreakContainerType& f_breaks,const CSplineContainerType& f_splines)
+{
+    m_coeffs.m_breaks = f_breaks;
+    m_coeffs.m_splines = f_splines;
+}
+
 /**
  * @brief Convert the input value.
  * 
  */
-template <uint8_t NrBreak, uint8_t NOrd>
-float CConverterSpline<NrBreak, NOrd>::operator()(float f_value){
-    typename CConverterSpline<NrBreak, NOrd>::CBreakContainerType::iterator it_breaks0=NULL,it_breaks1=NULL;
-    typename CConverterSpline<NrBreak, NOrd>::CSplineContainerType::iterator it_spline = m_splines.begin();
-    for (it_breaks1 = m_breaks.begin();it_breaks1 != m_breaks.end();){
-        if((it_breaks0==NULL || (it_breaks0!=NULL && (*it_breaks0)<f_value)) && f_value<=(*it_breaks1)){
-            break;
-        }
-        it_breaks0 = it_breaks1;
-        ++it_breaks1;
-        ++it_spline;
-    }
-    return this->splineValue(*it_spline, f_value);
+template <uint8_t NrBreak, uint8_t NOrd, class TCoeffs>
+float CConverterSpline<NrBreak, NOrd, TCoeffs>::operator()(float f_value){
+    // The first break point, which isn't smaller than the value, selects the polynomial (binary search).
+    uint32_t l_idx = std::lower_bound(m_coeffs.m_breaks.begin(), m_coeffs.m_breaks.end(), f_value) - m_coeffs.m_breaks.begin();
+    return this->splineValue(m_coeffs.m_splines[l_idx], f_value);
 }
 
 /**
@@ -90,14 +95,62 @@ float CConverterSpline<NrBreak, NOrd>::operator()(float f_value){
  * @param f_coeff The coeffiences of the polynom
  * @param f_value The input value.
  */
-template <uint8_t NrBreak, uint8_t NOrd>
-float CConverterSpline<NrBreak, NOrd>::splineValue( CCoeffContainerType f_coeff,float f_value){
-    float l_res = f_coeff[NOrd];
-    for (uint8_t i = 0;i<NOrd;++i)
+template <uint8_t NrBreak, uint8_t NOrd, class TCoeffs>
+float CConverterSpline<NrBreak, NOrd, TCoeffs>::splineValue(const CCoeffContainerType& f_coeff,float f_value){
+    // Horner's scheme, the coefficients are ordered from the highest degree
+    float l_res = f_coeff[0];
+    for (uint8_t i = 1;i<=NOrd;++i)
     {
-        l_res+=std::pow(f_value,NOrd-i)*f_coeff[i];
+        l_res = l_res*f_value + f_coeff[i];
     }
     return l_res;
 }
 
+/**
+ * @brief Construct a new CConverterLookupTable<NSize>::CConverterLookupTable object
+ * 
+ * @param f_source The converter, which is sampled in the table.
+ * @param f_min The start of the range.
+ * @param f_max The end of the range.
+ */
+template <uint32_t NSize>
+CConverterLookupTable<NSize>::CConverterLookupTable(IConverter& f_source,float f_min,float f_max)
+:m_table()
+,m_min(f_min)
+,m_step((f_max-f_min)/static_cast<float>(NSize-1))
+,m_invStep(static_cast<float>(NSize-1)/(f_max-f_min))
+{
+    sample(f_source);
+}
+
+/**
+ * @brief Sample the source converter again in the range of the table, after the modification of the source.
+ * 
+ * @param f_source The converter, which is sampled in the table.
+ */
+template <uint32_t NSize>
+void CConverterLookupTable<NSize>::sample(IConverter& f_source)
+{
+    for (uint32_t i = 0;i<NSize;++i){
+        m_table[i] = f_source(m_min + m_step*static_cast<float>(i));
+    }
+}
+
+/**
+ * @brief Convert the input value by the linear interpolation between the nearest points.
+ * 
+ */
+template <uint32_t NSize>
+CONTROL_RAMFUNC float CConverterLookupTable<NSize>::operator()(float f_value){
+    float l_pos = (f_value-m_min)*m_invStep;
+    int32_t l_idx = static_cast<int32_t>(l_pos);
+    if (l_idx < 0){
+        l_idx = 0;
+    } else if (l_idx > static_cast<int32_t>(NSize)-2){
+        l_idx = NSize-2;
+    }
+    float l_frac = l_pos - static_cast<float>(l_idx);
+    return m_table[l_idx] + l_frac*(m_table[l_idx+1]-m_table[l_idx]);
+}
+
 #endif 
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    CurrentController.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the inner current
+  *          control loop.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef CURRENT_CONTROLLER_HPP
+#define CURRENT_CONTROLLER_HPP
+
+#include <signal/controllers/sisocontrollers.hpp>
+#include <hardware/drivers/dcmotor.hpp>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Inner current control loop of the cascaded motor control, it's applied with a higher rate than the speed controller.
+    * 
+    * The speed controller (CMotorController) sets the current reference in each period, the step method is applied by the 
+    * end of conversion interrupt of the current measurement (e.g. CAdcInjected_ADC1 triggered by the pwm timer), the controller 
+    * calculates the pwm duty cycle and writes it to the motor driver. The controller is armed by the reference, it stops to write 
+    * the motor driver, when it's disarmed or the reference isn't refreshed during the timeout. 
+    * 
+    * The current sense of the bridge measures only the magnitude, so the sign of the measured current is taken from the sign of 
+    * the last applied duty cycle. 
+    */
+    class CCurrentController
+    {
+        public:
+            /* Constructor */
+            CCurrentController(siso::IController<float>&            f_pid
+                              ,hardware::drivers::ICurrentGetter&   f_current
+                              ,hardware::drivers::IMotorCommand&    f_motor
+                              ,float                                f_limit
+                              ,uint32_t                             f_divider = 1
+                              ,uint32_t                             f_timeout = 20);
+            /* Set the current reference and arm the controller */
+            void setReference(float f_current);
+            /* Disarm the controller */
+            void disarm();
+            /* Apply one step of the controller, it's applied from interrupt */
+            void step();
+            /** @brief  Last applied duty cycle */
+            float get() const
+            {
+                return m_u;
+            }
+            /** @brief  Saturation of the last duty cycle (1 upper limit, -1 lower limit, 0 none) */
+            int8_t getSaturation() const
+            {
+                return m_saturation;
+            }
+            /** @brief  The controller writes the motor driver */
+            bool isArmed() const
+            {
+                return m_armed;
+            }
+
+        private:
+            /* Current controller */
+            siso::IController<float>&               m_pid;
+            /* Current measurement */
+            hardware::drivers::ICurrentGetter&      m_current;
+            /* Motor driver */
+            hardware::drivers::IMotorCommand&       m_motor;
+            /* Absolute limit of the duty cycle */
+            const float                             m_limit;
+            /* Number of the measurements per controller step */
+            const uint32_t                          m_divider;
+            /* Number of the controller steps without new reference before disarming */
+            const uint32_t                          m_timeout;
+            /* Current reference */
+            volatile float                          m_reference;
+            /* Counter of the measurements */
+            uint32_t                                m_tick;
+            /* Counter of the steps since the last reference */
+            volatile uint32_t                       m_age;
+            /* Last applied duty cycle */
+            float                                   m_u;
+            /* Saturation of the last duty cycle */
+            int8_t                                  m_saturation;
+            /* Arming state */
+            volatile bool                           m_armed;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // CURRENT_CONTROLLER_HPP
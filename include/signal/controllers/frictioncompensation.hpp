@@ -0,0 +1,115 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    FrictionCompensation.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the position indexed
+  *          compensation of the friction and of the cogging.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef FRICTION_COMPENSATION_HPP
+#define FRICTION_COMPENSATION_HPP
+
+#include <mbed.h>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Learned compensation of the static friction and of the cogging of the drivetrain, indexed by the shaft angle and by the
+    * direction of the move.
+    *
+    * The table has s_bins equal sectors of the revolution for both directions, each entry is the magnitude of the voltage, which holds the
+    * motor moving in the sector at low speed. The motor controller replaces the constant friction offset of the feed-forward by the entry
+    * of the sector, so the compensation is a single lookup per tick. The shaft angle is absolute only after the first index pulse, before
+    * it and for the direction without valid table the constant offset remains.
+    *
+    * In the calibration the motor crawls with a low constant reference (e.g. 2 rps, a few revolutions in both directions), the motor
+    * controller records the static part of its voltage (the output of the speed controller with the applied compensation, without the
+    * speed term of the feed-forward) in the sector of the shaft. The first calibration gives mainly the friction, the speed controller
+    * is slow against the sectors; the applied table is part of the recorded voltage, so the repeated calibrations add the remaining
+    * correction of the controller to each sector and the cogging is learned iteratively. At the end a direction is applied, when each
+    * of its sectors has s_minSamples samples; the samples above s_maxVoltage (e.g. blocked wheel) are rejected.
+    *
+    * With a valid table the motor controller isn't inactivated below its standing limit of the reference, the references from s_minSpeed
+    * up are controlled, so the car can crawl in the parking manoeuvres.
+    *
+    * Commands of the 'FRIC' key: '0' state ('calibrating;forward valid;backward valid;least samples;;'), '1' start the calibration,
+    * '2' apply the calibration, '3;sector' entries of a sector ('forward;backward;;' in V), '4' clear the table.
+    */
+    class CFrictionCompensation
+    {
+        public:
+            /** @brief Getter of the shaft angle in revolution [0,1), negative while it isn't absolute */
+            typedef mbed::Callback<float()> FAngleGetter;
+            /** @brief Direction of the move */
+            enum EDirection{
+                FORWARD = 0,
+                BACKWARD = 1
+            };
+            /** @brief Number of the sectors of a revolution */
+            static const uint8_t s_bins = 64;
+            /** @brief Number of the samples of a valid sector */
+            static const uint16_t s_minSamples = 8;
+            /** @brief Lowest reference of the controlled crawling (rps) */
+            static constexpr float s_minSpeed = 1.0f;
+
+            /* Constructor */
+            CFrictionCompensation(FAngleGetter f_angle);
+            /* Voltage of the compensation */
+            bool lookup(EDirection f_direction, float& f_voltage);
+            /* Record a sample of the calibration */
+            void learn(EDirection f_direction, float f_voltage);
+            /* Start the calibration */
+            void startCalibration();
+            /* Apply the calibration */
+            bool finishCalibration();
+            /* Clear the table */
+            void clear();
+            /** @brief The calibration records the samples */
+            bool isCalibrating() const {return m_isCalibrating;}
+            /** @brief The table of the direction is applied */
+            bool isValid(EDirection f_direction) const {return m_valid[f_direction];}
+            /* Serial callback method */
+            void serialCallback(char const * a, char * b);
+        private:
+            /* Sector of the shaft angle */
+            bool sector(uint8_t& f_bin);
+
+            /* Getter of the shaft angle */
+            FAngleGetter                            m_angle;
+            /* Voltage magnitudes of the sectors (V) */
+            float                                   m_table[2][s_bins];
+            /* Sums of the calibration samples */
+            float                                   m_sums[2][s_bins];
+            /* Numbers of the calibration samples */
+            uint16_t                                m_counts[2][s_bins];
+            /* The table of the direction is applied */
+            volatile bool                           m_valid[2];
+            /* The calibration records the samples */
+            volatile bool                           m_isCalibrating;
+            /* Upper limit of a calibration sample (V) */
+            static constexpr float s_maxVoltage = 3.0f;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // FRICTION_COMPENSATION_HPP
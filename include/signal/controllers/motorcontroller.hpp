@@ -33,6 +33,13 @@ limitations under the License.
 
 #include <hardware/encoders/encoderinterfaces.hpp>
 #include <signal/controllers/converters.hpp>
+#include <signal/controllers/currentcontroller.hpp>
+#include <signal/controllers/autotuner.hpp>
+#include <signal/controllers/stepexperiment.hpp>
+#include <signal/controllers/predictivecontroller.hpp>
+#include <signal/controllers/frictioncompensation.hpp>
+#include <signal/systemmodels/thermalmodel.hpp>
+#include <signal/systemmodels/motoridentifier.hpp>
 
 #include <mbed.h>
 
@@ -44,6 +51,24 @@ namespace controllers
    /**
     * @brief It implements a controller with a single input and a single output. It needs an encoder getter interface to get the measured values, a controller to calculate the control signal. It can be completed with a converter to convert the measaurment unit of the control signal. 
     * 
+    * A static feed-forward term (u_ff = gain*ref + offset*sign(ref)) is added to the output of the controller. The saturation of the 
+    * converted control signal is fed back to the controller, so the controllers with anti-windup stop the integration. With the 
+    * friction compensation (CFrictionCompensation) the offset is the learned voltage of the shaft sector and the low references 
+    * are controlled down to its crawling limit, during its calibration the static part of the voltage is recorded in each step. 
+    * 
+    * It's the middle loop of an optional cascade: an outer position controller can give the reference speed to drive a distance 
+    * and an inner current controller (CCurrentController) can realize the output of the speed controller as a current reference. 
+    * 
+    * During the autotuning the speed controller is replaced by the relay of the autotuner (CRelayAutotuner), at the end the calculated 
+    * parameters are applied to the speed controller. 
+    * 
+    * During an experiment (CStepExperiment) the reference is given by its script instead of the state machine and the control-quality 
+    * metrics are accumulated in each control step, so the parameters can be scored on the car without streaming the samples. 
+    * 
+    * Without the current loop an active predictive controller (IPredictiveSpeedController) replaces the speed controller and the 
+    * feed-forward, it respects the voltage and the acceleration limits over its horizon, so the clamping of the converter is only 
+    * the last protection.
+    * 
     */
     class CMotorController
     {
@@ -54,49 +79,167 @@ namespace controllers
         public:
             /* Construnctor */
             CMotorController(hardware::encoders::IEncoderGetter&               f_encoder
-                            ,ControllerType<double>&                f_pid
+                            ,ControllerType<float>&                 f_pid
                             ,signal::controllers::IConverter*               f_converter=NULL
                             ,float                                  f_inf_ref = -225
                             ,float                                  f_sup_ref = 225);
             /* Set controller reference value */
-            void setRef(double                       f_RefRps);
+            void setRef(float                        f_RefRps);
             /* Get controller reference value */
-            double getRef();
+            float getRef();
             /* Get control value */
-            double get();
+            float get();
             /* Get error */
-            double getError();
+            float getError();
+            /** @brief Measured speed of the encoder (rps) */
+            float getMeasuredSpeed() {return m_encoder.getSpeedRps();}
             /* Clear PID parameters */
             void clear();
             /* Control action */
             int8_t control();
 
-            bool inRange(double f_RefRps);
+            bool inRange(float f_RefRps);
+            /* Attach the inner current loop */
+            void setCurrentController(CCurrentController* f_current, float f_maxCurrent);
+            /* Attach the outer position loop */
+            void setPositionController(ControllerType<float>* f_pid, float f_resolution, uint32_t f_divider, float f_tolerance);
+            /* Start the position control */
+            bool setPositionTarget(float f_rotations, float f_maxRps);
+            /* Stop the position control */
+            void stopPositionControl();
+            /** @brief The reference speed is given by the position controller */
+            bool isPositionControlled() const {return m_positionActive;}
+            /* Get position error */
+            float getPositionError();
+            /* Check the position target */
+            bool isPositionReached();
+            /* Attach the thermal model of the motor for the derating of the limits */
+            void setThermalModel(signal::systemmodels::CMotorThermalModel* f_thermal, float f_maxPwm);
+            /** @brief Derating factor of the limits in the last control step */
+            float getDerating() const {return m_derating;}
+            /* Attach the relay autotuner */
+            void setAutotuner(CRelayAutotuner* f_autotuner);
+            /** @brief Attach the position indexed friction compensation, NULL for the constant offset */
+            void setFrictionCompensation(CFrictionCompensation* f_friction) {m_friction = f_friction;}
+            /** @brief Attach the predictive speed controller, it's applied while it's active */
+            void setPredictiveController(IPredictiveSpeedController* f_predictive) {m_predictive = f_predictive;}
+            /* Start the autotuning at the current operating point */
+            bool startAutotune(float f_amplitude, float f_hysteresis);
+            /* Abort a running autotuning */
+            void stopAutotune();
+            /* Get the state of the autotuning */
+            CRelayAutotuner::EState getAutotuneState();
+            /* Get the result of the autotuning */
+            const CRelayAutotuner::SResult& getAutotuneResult();
+            /* Attach the reference experiment */
+            void setExperiment(CStepExperiment* f_experiment);
+            /* Start a step experiment */
+            bool startStepExperiment(float f_base, float f_amplitude, float f_duration, uint16_t f_count);
+            /* Start a sweep experiment */
+            bool startSweepExperiment(float f_base, float f_amplitude, float f_duration, float f_startFrequency, float f_endFrequency);
+            /* Abort a running experiment */
+            void stopExperiment();
+            /* Get the state of the experiment */
+            CStepExperiment::EState getExperimentState();
+            /* Get the result of the experiment */
+            const CStepExperiment::SResult& getExperimentResult();
+            /* Set the feed-forward parameters */
+            void setFeedForward(float f_gain, float f_offset);
+            /* Serial callback for setting the feed-forward parameters */
+            void serialCallbackFeedForward(char const * a, char * b);
+            /** @brief Signed voltage of the speed controller in the last control step, zero, while the motor isn't driven by it */
+            float getControlVoltage() {return m_appliedVoltage;}
+            /** @brief Attach the online identification of the motor model */
+            void setIdentifier(const signal::systemmodels::CMotorIdentifier* f_identifier) {m_identifier = f_identifier;}
+            /* Apply the feed-forward and the speed controller parameters of a first order model */
+            bool applyModel(const signal::systemmodels::CMotorIdentifier::SModel& f_model, float f_closedLoopTime);
+            /* Serial callback for applying the identified model */
+            void serialCallbackIdentified(char const * a, char * b);
+            /* Switch to the open-loop control, while the encoder isn't healthy */
+            void setOpenLoop(bool f_openLoop);
+            /** @brief The pwm is given by the feed-forward without the speed feedback */
+            bool isOpenLoop() const {return m_openLoop;}
 
         private:
             /* PWM onverter */
-            double converter(double f_u);
+            float converter(float f_u);
+            /* Current reference limits */
+            float currentLimit(float f_current);
+            /* Disarm the inner current loop */
+            void disarmCurrentController();
+            /* Update the limits by the thermal model */
+            void updateLimits();
+            /* Open-loop control step */
+            int8_t openLoopControl();
 
             /* Enconder object reference */
             hardware::encoders::IEncoderGetter&               m_encoder;
             /* PID object reference */
-            ControllerType<double>&                 m_pid;
+            ControllerType<float>&                  m_pid;
             /* Controller reference */
-            double                                  m_RefRps;
+            float                                   m_RefRps;
             /* Control value */
-            double                                  m_u;
+            float                                   m_u;
             /* Error */
-            double                                  m_error;
+            float                                   m_error;
+            /* Feed-forward gain from the reference (V/rps) */
+            float                                   m_ffGain;
+            /* Feed-forward offset by the sign of the reference, compensates the static friction (V) */
+            float                                   m_ffOffset;
             /* Converter */
             signal::controllers::IConverter*                m_converter;
+            /* Output of the controller in its own unit (V or A), before the conversion */
+            float                                   m_controllerOutput;
+            /* Signed voltage of the speed controller, which was applied in the last control step */
+            float                                   m_appliedVoltage;
+            /* Online identification of the motor model, NULL without identification */
+            const signal::systemmodels::CMotorIdentifier* m_identifier;
+            /* Relay autotuner, NULL without autotuning */
+            CRelayAutotuner*                        m_autotuner;
+            /* Reference experiment, NULL without experiments */
+            CStepExperiment*                        m_experiment;
+            /* Friction compensation, NULL with the constant offset */
+            CFrictionCompensation*                  m_friction;
+            /* Predictive speed controller, NULL without predictive control */
+            IPredictiveSpeedController*             m_predictive;
+            /* Inner current loop, NULL without cascaded control */
+            CCurrentController*                     m_currentController;
+            /* Absolute limit of the current reference */
+            float                                   m_maxCurrent;
+            /* Thermal model of the motor, NULL with the static limits */
+            signal::systemmodels::CMotorThermalModel* m_thermalModel;
+            /* Absolute limit of the pwm of the cold motor */
+            float                                   m_maxPwm;
+            /* Derating factor of the pwm and current limits */
+            float                                   m_derating;
+            /* Outer position controller, NULL without position control */
+            ControllerType<float>*                  m_positionPid;
+            /* Resolution of the encoder */
+            float                                   m_resolution;
+            /* Number of the periods per position controller step */
+            uint32_t                                m_positionDivider;
+            /* Counter of the periods */
+            uint32_t                                m_positionTick;
+            /* Position tolerance of the target */
+            float                                   m_positionTolerance;
+            /* Position moved since the start of the position control (impulse) */
+            int32_t                                 m_position;
+            /* Target of the position control (impulse) */
+            float                                   m_positionTarget;
+            /* Absolute limit of the reference speed by the position control */
+            float                                   m_maxPositionRps;
+            /* Position control state */
+            bool                                    m_positionActive;
+            /* Open-loop control without the encoder */
+            volatile bool                           m_openLoop;
             uint8_t                                 m_nrHighPwm;
             /* Maximum High PWM Signal */
             const uint8_t                           m_maxNrHighPwm;
 
 
-            /* Scaled PWM control signal limits */
-            const float                                     m_control_sup;
-            const float                                     m_control_inf;
+            /* Scaled PWM control signal limits, they are derated by the thermal model */
+            float                                           m_control_sup;
+            float                                           m_control_inf;
             /* Absolute inferior limit of  reference to inactivate the controller in the case low reference and observation value. */
             const float                                     m_ref_abs_inf;
             /* Absolute inferior limits of measured speed to inactivate the controller in the case low reference and observation value. */
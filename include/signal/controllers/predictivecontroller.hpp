@@ -0,0 +1,163 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    PredictiveController.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the model predictive
+  *          speed controller with voltage and acceleration constraints.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef PREDICTIVE_CONTROLLER_HPP
+#define PREDICTIVE_CONTROLLER_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <utils/linalg/linalg.h>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Interface of the predictive speed controller of the motor controller, it calculates the voltage by the reference and the 
+    * measured speed and it respects the limits by itself.
+    */
+    class IPredictiveSpeedController
+    {
+        public:
+            /* Calculate the voltage of the next period */
+            virtual float control(float f_reference, float f_speed, float f_derating) = 0;
+            /* Clear the memory of the controller */
+            virtual void clear() = 0;
+            /* The controller is active */
+            virtual bool isActive() const = 0;
+    }; // class IPredictiveSpeedController
+
+   /**
+    * @brief Model predictive speed controller, the voltage and the acceleration limits are respected over the horizon instead of 
+    * clamping the output of the speed controller.
+    * 
+    * The speed is predicted by the first order model x[k+1] = a*x[k] + b*u[k] + d (a = exp(-dt/tau), b = K*(1-a)), where the 
+    * disturbance d is estimated from the prediction error of the last period, so the tracking is offset-free also with an inexact 
+    * model (friction, load). The cost is the sum of the squared speed errors and the weighted squared changes of the voltage over the 
+    * horizon. The condensed quadratic program of the NHorizon voltages with the voltage (|u| <= derating*umax) and acceleration 
+    * (|x[k+1]-x[k]| <= amax*dt) constraints is solved by NIterations steps of the alternating direction method of multipliers 
+    * (ADMM). The matrix of the linear system doesn't depend on the constraints, so its inverse is calculated by the design and a 
+    * step is only a few matrix-vector products; the solution and the multipliers of the previous period are shifted as warm start. 
+    * So the runtime is fixed (about 2*NHorizon^2*NIterations multiply-accumulates), it doesn't depend on the active constraints.
+    * The first voltage is clamped to the voltage and to the acceleration limit of the first period, so it's admissible also 
+    * after the last iteration.
+    * 
+    * The speed is scaled by the static gain (K) and the input factor (b) inside the controller, so the speed errors and changes are 
+    * measured by the voltage of the same effect and the fixed penalty parameter of the ADMM suits every motor and sampling time. The weights and the limits are changed only while it's inactive, the 
+    * design runs in the context of the caller.
+    * 
+    * @tparam NHorizon      number of the predicted periods
+    * @tparam NIterations   number of the ADMM iterations in a period
+    */
+    template <uint32_t NHorizon, uint32_t NIterations = 16>
+    class CSpeedPredictiveController:public IPredictiveSpeedController
+    {
+        public:
+            /* Constructor */
+            CSpeedPredictiveController(float    f_dt
+                                      ,float    f_gain
+                                      ,float    f_timeConstant
+                                      ,float    f_maxVoltage
+                                      ,float    f_maxAcceleration
+                                      ,float    f_changeWeight = 0.1f);
+            /* Set the weight and the limits, it recalculates the design */
+            bool setParameters(float f_changeWeight, float f_maxVoltage, float f_maxAcceleration);
+            /* Calculate the voltage of the next period */
+            float control(float f_reference, float f_speed, float f_derating);
+            /* Clear the warm start and the disturbance */
+            void clear();
+            /** @brief Activate the controller, it replaces the speed controller of the motor controller */
+            void setActive(bool f_active) {m_isActive = false; clear(); m_isActive = f_active;}
+            /** @brief The controller is active */
+            bool isActive() const {return m_isActive;}
+            /** @brief Estimated disturbance in rps per period */
+            float getDisturbance() const {return m_disturbance * m_gain;}
+            /* Serial callback */
+            void serialCallback(char const * a, char * b);
+
+        private:
+            using CSquareType = utils::linalg::CMatrix<float,NHorizon,NHorizon>;
+            using CVectorType = utils::linalg::CColVector<float,NHorizon>;
+            /* Calculate the matrices of the quadratic program */
+            void design();
+
+            /** @brief Penalty parameter of the constraints */
+            static constexpr float s_rho = 100.0f;
+            /** @brief Proximal term of the voltages */
+            static constexpr float s_sigma = 1e-4f;
+            /** @brief Step of the disturbance estimation */
+            static constexpr float s_disturbanceStep = 0.2f;
+
+            /* sampling time */
+            const float             m_dt;
+            /* static gain (rps per V) */
+            const float             m_gain;
+            /* pole of the model */
+            const float             m_a;
+            /* normalized input factor of the model (1-a) */
+            const float             m_b;
+            /* weight of the voltage changes */
+            float                   m_changeWeight;
+            /* absolute limit of the voltage */
+            float                   m_maxVoltage;
+            /* limit of the scaled speed change in a period */
+            float                   m_maxStep;
+            /* inverse of the matrix of the ADMM linear system */
+            CSquareType             m_solve;
+            /* speed changes by the voltages (rows of the acceleration constraints) */
+            CSquareType             m_step;
+            /* linear cost by the speed, the reference and the disturbance */
+            CVectorType             m_stateCost;
+            CVectorType             m_referenceCost;
+            CVectorType             m_disturbanceCost;
+            /* speed changes by the speed and the disturbance */
+            CVectorType             m_stateStep;
+            CVectorType             m_disturbanceStep;
+            /* warm start: voltages, constraint values and multipliers of the voltage and the acceleration rows */
+            CVectorType             m_voltages;
+            CVectorType             m_voltageZ;
+            CVectorType             m_voltageY;
+            CVectorType             m_stepZ;
+            CVectorType             m_stepY;
+            /* applied voltage of the last period */
+            float                   m_lastVoltage;
+            /* predicted normalized speed of the current period */
+            float                   m_prediction;
+            /* estimated normalized disturbance */
+            float                   m_disturbance;
+            /* the prediction is valid */
+            bool                    m_isPredicted;
+            /* active state */
+            volatile bool           m_isActive;
+    };
+
+    #include "predictivecontroller.tpp"
+}; // namespace controllers
+}; // namespace signal
+
+#endif // PREDICTIVE_CONTROLLER_HPP
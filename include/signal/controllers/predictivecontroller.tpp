@@ -0,0 +1,327 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    PredictiveController.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the model predictive
+  *          speed controller with voltage and acceleration constraints.
+  ******************************************************************************
+ */
+
+#ifndef PREDICTIVE_CONTROLLER_TPP
+#define PREDICTIVE_CONTROLLER_TPP
+
+#ifndef PREDICTIVE_CONTROLLER_HPP
+#error __FILE__ should only be included from predictivecontroller.hpp.
+#endif // PREDICTIVE_CONTROLLER_HPP
+
+/** @brief  CSpeedPredictiveController class constructor, the controller is inactive.
+  *
+  * @param f_dt                sampling time in second
+  * @param f_gain              static gain of the motor in rps per V
+  * @param f_timeConstant      time constant of the speed in second
+  * @param f_maxVoltage        absolute limit of the voltage of the cold motor
+  * @param f_maxAcceleration   absolute limit of the acceleration in rps per second
+  * @param f_changeWeight      weight of the squared voltage changes relative to the squared speed errors (scaled to V)
+  */
+template <uint32_t NHorizon, uint32_t NIterations>
+CSpeedPredictiveController<NHorizon,NIterations>::CSpeedPredictiveController(float    f_dt
+                                                                            ,float    f_gain
+                                                                            ,float    f_timeConstant
+                                                                            ,float    f_maxVoltage
+                                                                            ,float    f_maxAcceleration
+                                                                            ,float    f_changeWeight)
+    :m_dt(f_dt)
+    ,m_gain(f_gain)
+    ,m_a(std::exp(-f_dt/f_timeConstant))
+    ,m_b(1.0f - std::exp(-f_dt/f_timeConstant))
+    ,m_changeWeight(f_changeWeight)
+    ,m_maxVoltage(f_maxVoltage)
+    ,m_maxStep(f_maxAcceleration*f_dt/(f_gain*(1.0f - std::exp(-f_dt/f_timeConstant))))
+    ,m_solve()
+    ,m_step()
+    ,m_stateCost()
+    ,m_referenceCost()
+    ,m_disturbanceCost()
+    ,m_stateStep()
+    ,m_disturbanceStep()
+    ,m_voltages()
+    ,m_voltageZ()
+    ,m_voltageY()
+    ,m_stepZ()
+    ,m_stepY()
+    ,m_lastVoltage(0.0f)
+    ,m_prediction(0.0f)
+    ,m_disturbance(0.0f)
+    ,m_isPredicted(false)
+    ,m_isActive(false)
+{
+    design();
+}
+
+/** @brief  Set the weight and the limits, they are applied only while the controller is inactive.
+  *
+  * @param f_changeWeight      weight of the squared voltage changes
+  * @param f_maxVoltage        absolute limit of the voltage
+  * @param f_maxAcceleration   absolute limit of the acceleration in rps per second
+  * @return                    false, when the controller is active or a parameter isn't positive
+  */
+template <uint32_t NHorizon, uint32_t NIterations>
+bool CSpeedPredictiveController<NHorizon,NIterations>::setParameters(float f_changeWeight, float f_maxVoltage, float f_maxAcceleration)
+{
+    if (m_isActive || !(f_changeWeight > 0.0f) || !(f_maxVoltage > 0.0f) || !(f_maxAcceleration > 0.0f))
+    {
+        return false;
+    }
+    m_changeWeight = f_changeWeight;
+    m_maxVoltage = f_maxVoltage;
+    m_maxStep = f_maxAcceleration*m_dt/(m_gain*m_b);
+    design();
+    return true;
+}
+
+/** @brief  Calculate the matrices of the condensed quadratic program. The predicted normalized speeds are X = F*x + G*U + E*d, 
+  * the cost is |X - r|^2/b^2 + w*|D*U - u[-1]|^2 and the ADMM solves (H + sigma*I + rho*A^T*A)*U = rhs by the inverse matrix, 
+  * where A contains the identity (voltage rows) and the speed changes by the voltages (acceleration rows). The speed errors and 
+  * changes are divided by b, so they are measured by the voltage of the same effect in a period and the problem is well scaled.
+  */
+template <uint32_t NHorizon, uint32_t NIterations>
+void CSpeedPredictiveController<NHorizon,NIterations>::design()
+{
+    CSquareType l_G;
+    CVectorType l_F, l_E;
+    float l_power = 1.0f;                   // a^k
+    float l_sum = 0.0f;                     // 1 + a + ... + a^k
+    for (uint32_t k = 0; k < NHorizon; ++k)
+    {
+        l_sum += l_power;
+        l_power *= m_a;
+        l_F[k][0] = l_power;
+        l_E[k][0] = l_sum;
+        for (uint32_t j = 0; j <= k; ++j)
+        {
+            l_G[k][j] = (j == k) ? m_b : m_a * l_G[k-1][j];
+        }
+    }
+    // Changes of the predicted speed in each period
+    for (uint32_t k = 0; k < NHorizon; ++k)
+    {
+        for (uint32_t j = 0; j < NHorizon; ++j)
+        {
+            m_step[k][j] = (l_G[k][j] - ((k > 0) ? l_G[k-1][j] : 0.0f)) / m_b;
+        }
+        m_stateStep[k][0] = (l_F[k][0] - ((k > 0) ? l_F[k-1][0] : 1.0f)) / m_b;
+        m_disturbanceStep[k][0] = (l_E[k][0] - ((k > 0) ? l_E[k-1][0] : 0.0f)) / m_b;
+    }
+    // Linear cost: G^T*(F*x + E*d - r)/b^2
+    for (uint32_t k = 0; k < NHorizon; ++k)
+    {
+        for (uint32_t j = 0; j < NHorizon; ++j)
+        {
+            l_G[k][j] /= m_b;
+        }
+        l_F[k][0] /= m_b;
+        l_E[k][0] /= m_b;
+    }
+    CSquareType l_Gt;
+    utils::linalg::transpose(l_Gt, l_G);
+    CVectorType l_ones;
+    for (uint32_t k = 0; k < NHorizon; ++k)
+    {
+        l_ones[k][0] = -1.0f / m_b;
+    }
+    utils::linalg::multiply(m_stateCost, l_Gt, l_F);
+    utils::linalg::multiply(m_disturbanceCost, l_Gt, l_E);
+    utils::linalg::multiply(m_referenceCost, l_Gt, l_ones);
+    // H + sigma*I + rho*A^T*A = G^T*G/b^2 + w*D^T*D + (sigma + rho)*I + rho*S^T*S
+    CSquareType l_M;
+    utils::linalg::multiply(l_M, l_Gt, l_G);
+    CSquareType l_St, l_StS;
+    utils::linalg::transpose(l_St, m_step);
+    utils::linalg::multiply(l_StS, l_St, m_step);
+    for (uint32_t k = 0; k < NHorizon; ++k)
+    {
+        for (uint32_t j = 0; j < NHorizon; ++j)
+        {
+            l_M[k][j] += s_rho * l_StS[k][j];
+        }
+        l_M[k][k] += m_changeWeight * ((k + 1 < NHorizon) ? 2.0f : 1.0f) + s_sigma + s_rho;
+        if (k > 0)
+        {
+            l_M[k][k-1] -= m_changeWeight;
+            l_M[k-1][k] -= m_changeWeight;
+        }
+    }
+    m_solve = utils::linalg::CCholeskyDecomposition<float,NHorizon>(l_M).inv();
+    clear();
+}
+
+/** @brief  Clear the warm start and the estimated disturbance
+  *
+  */
+template <uint32_t NHorizon, uint32_t NIterations>
+void CSpeedPredictiveController<NHorizon,NIterations>::clear()
+{
+    m_voltages = CVectorType();
+    m_voltageZ = CVectorType();
+    m_voltageY = CVectorType();
+    m_stepZ = CVectorType();
+    m_stepY = CVectorType();
+    m_lastVoltage = 0.0f;
+    m_disturbance = 0.0f;
+    m_isPredicted = false;
+}
+
+/** @brief  Calculate the voltage of the next period by the fixed number of the ADMM iterations
+  *
+  * @param f_reference         reference speed in rps
+  * @param f_speed             measured speed in rps
+  * @param f_derating          derating factor of the voltage limit
+  * @return                    voltage of the next period
+  */
+template <uint32_t NHorizon, uint32_t NIterations>
+CONTROL_RAMFUNC float CSpeedPredictiveController<NHorizon,NIterations>::control(float f_reference, float f_speed, float f_derating)
+{
+    const float l_speed = f_speed / m_gain;
+    const float l_reference = f_reference / m_gain;
+    if (m_isPredicted)
+    {
+        m_disturbance += s_disturbanceStep * (l_speed - m_prediction);
+    }
+    // Linear cost and bounds of this period
+    CVectorType l_cost;
+    CVectorType l_lower, l_upper;
+    for (uint32_t k = 0; k < NHorizon; ++k)
+    {
+        l_cost[k][0] = m_stateCost[k][0]*l_speed + m_referenceCost[k][0]*l_reference + m_disturbanceCost[k][0]*m_disturbance;
+        float l_offset = m_stateStep[k][0]*l_speed + m_disturbanceStep[k][0]*m_disturbance;
+        l_lower[k][0] = -m_maxStep - l_offset;
+        l_upper[k][0] = m_maxStep - l_offset;
+    }
+    l_cost[0][0] -= m_changeWeight * m_lastVoltage;
+    const float l_maxVoltage = f_derating * m_maxVoltage;
+    // Warm start by the solution of the last period shifted with one period
+    for (uint32_t k = 0; k + 1 < NHorizon; ++k)
+    {
+        m_voltages[k][0] = m_voltages[k+1][0];
+        m_voltageZ[k][0] = m_voltageZ[k+1][0];
+        m_voltageY[k][0] = m_voltageY[k+1][0];
+        m_stepZ[k][0] = m_stepZ[k+1][0];
+        m_stepY[k][0] = m_stepY[k+1][0];
+    }
+    CVectorType l_rhs, l_w, l_steps;
+    for (uint32_t l_iteration = 0; l_iteration < NIterations; ++l_iteration)
+    {
+        // U = M^-1 * (sigma*U - f + A^T*(rho*z - y))
+        for (uint32_t k = 0; k < NHorizon; ++k)
+        {
+            l_rhs[k][0] = s_sigma*m_voltages[k][0] - l_cost[k][0] + s_rho*m_voltageZ[k][0] - m_voltageY[k][0];
+            l_w[k][0] = s_rho*m_stepZ[k][0] - m_stepY[k][0];
+        }
+        for (uint32_t j = 0; j < NHorizon; ++j)
+        {
+            for (uint32_t k = j; k < NHorizon; ++k)
+            {
+                l_rhs[j][0] += m_step[k][j] * l_w[k][0];
+            }
+        }
+        utils::linalg::multiply(m_voltages, m_solve, l_rhs);
+        // z = clip(A*U + y/rho), y = y + rho*(A*U - z)
+        utils::linalg::multiply(l_steps, m_step, m_voltages);
+        for (uint32_t k = 0; k < NHorizon; ++k)
+        {
+            float l_z = m_voltages[k][0] + m_voltageY[k][0] / s_rho;
+            l_z = (l_z > l_maxVoltage) ? l_maxVoltage : ((l_z < -l_maxVoltage) ? -l_maxVoltage : l_z);
+            m_voltageY[k][0] += s_rho * (m_voltages[k][0] - l_z);
+            m_voltageZ[k][0] = l_z;
+            l_z = l_steps[k][0] + m_stepY[k][0] / s_rho;
+            l_z = (l_z > l_upper[k][0]) ? l_upper[k][0] : ((l_z < l_lower[k][0]) ? l_lower[k][0] : l_z);
+            m_stepY[k][0] += s_rho * (l_steps[k][0] - l_z);
+            m_stepZ[k][0] = l_z;
+        }
+    }
+    // The first voltage is clamped to the acceleration limit of the first period (its row is U[0] + offset) and to the voltage 
+    // limit, which has the priority, so it's admissible independently of the convergence
+    float l_voltage = m_voltages[0][0];
+    l_voltage = (l_voltage > l_upper[0][0]) ? l_upper[0][0] : ((l_voltage < l_lower[0][0]) ? l_lower[0][0] : l_voltage);
+    l_voltage = (l_voltage > l_maxVoltage) ? l_maxVoltage : ((l_voltage < -l_maxVoltage) ? -l_maxVoltage : l_voltage);
+    m_lastVoltage = l_voltage;
+    m_prediction = m_a * l_speed + m_b * l_voltage + m_disturbance;
+    m_isPredicted = true;
+    return l_voltage;
+}
+
+/** @brief  Serial callback of the predictive controller:
+  *     '0' - status: 'ack;;active;weight;voltage;acceleration;disturbance;'
+  *     '1;active' - activate (1) or deactivate (0) the controller,
+  *     '2;weight;voltage;acceleration' - set the weight of the voltage changes and the limits, only while it's inactive.
+  *
+  * @param a                   string to read data from
+  * @param b                   string to write data to
+  */
+template <uint32_t NHorizon, uint32_t NIterations>
+void CSpeedPredictiveController<NHorizon,NIterations>::serialCallback(char const * a, char * b)
+{
+    const char* l_text = a;
+    uint32_t l_command;
+    if (!utils::fmt::parseUint(l_text, l_command))
+    {
+        sprintf(b,"sintax error;;");
+        return;
+    }
+    if (0 == l_command)
+    {
+        utils::fmt::CWriter(b).text("ack;;").udec(m_isActive ? 1 : 0).fixed(m_changeWeight,3).fixed(m_maxVoltage,3)
+                              .fixed(m_maxStep*m_gain*m_b/m_dt,1).fixed(getDisturbance(),3);
+    }
+    else if (1 == l_command && ';' == *l_text++)
+    {
+        uint32_t l_active;
+        if (utils::fmt::parseUint(l_text, l_active) && l_active <= 1)
+        {
+            setActive(1 == l_active);
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+    else if (2 == l_command && ';' == *l_text++)
+    {
+        float l_values[3];
+        if (3 != utils::fmt::parseFloats(l_text, l_values, 3))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (m_isActive)
+        {
+            sprintf(b,"busy;;");
+        }
+        else
+        {
+            sprintf(b, setParameters(l_values[0], l_values[1], l_values[2]) ? "ack;;" : "invalid parameters;;");
+        }
+    }
+    else
+    {
+        sprintf(b,"sintax error;;");
+    }
+}
+
+#endif // PREDICTIVE_CONTROLLER_TPP
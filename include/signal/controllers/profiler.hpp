@@ -0,0 +1,103 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Profiler.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the setpoint profile
+  *          generator.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cmath>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Online setpoint profile generator, it moves the output towards the target with limited rate and limited change of the rate (jerk). 
+    * 
+    * With a jerk limit the profile is an S-curve: the rate is ramped down early enough to reach the target without overshoot. Without a 
+    * jerk limit the profile is trapezoidal and it's a simple rate limiter. Without a rate limit the output follows the target directly. 
+    * The target can be changed at each step, the profile continues from the current output and rate.
+    */
+    class CSetpointProfiler
+    {
+        public:
+            /* Constructor */
+            CSetpointProfiler(float f_dt, float f_maxRate = 0.0f, float f_maxJerk = 0.0f);
+            /* Set the limits */
+            void setLimits(float f_maxRate, float f_maxJerk);
+            /* Set the cap of the rate */
+            void setRateCap(float f_rateCap);
+            /* Set the target */
+            void setTarget(float f_target);
+            /* Set the output and the target directly */
+            void reset(float f_value);
+            /* Apply one step of the profile */
+            float step();
+            /** @brief Current output of the profile */
+            float getValue() const
+            {
+                return m_value;
+            }
+            /** @brief Target of the profile */
+            float getTarget() const
+            {
+                return m_target;
+            }
+            /** @brief Maximum rate of the output, zero without limit */
+            float getMaxRate() const
+            {
+                return m_maxRate;
+            }
+            /** @brief Maximum jerk of the output, zero without limit */
+            float getMaxJerk() const
+            {
+                return m_maxJerk;
+            }
+            /** @brief The output reached the target */
+            bool isReached() const
+            {
+                return m_value == m_target && m_rate == 0.0f;
+            }
+
+        private:
+            /* Sampling time */
+            const float                             m_dt;
+            /* Maximum rate of the output (unit per second), zero without limit */
+            float                                   m_maxRate;
+            /* Maximum jerk of the output (unit per square second), zero without limit */
+            float                                   m_maxJerk;
+            /* Target of the profile */
+            float                                   m_target;
+            /* Current output */
+            float                                   m_value;
+            /* Current rate of the output */
+            float                                   m_rate;
+            /* Cap of the rate (unit per second), zero without cap */
+            float                                   m_rateCap;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // PROFILER_HPP
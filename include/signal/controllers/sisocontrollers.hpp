@@ -25,8 +25,14 @@ limitations under the License.
 #define SISO_CONTROLLERS_H
 
 #include <cstdio>
+#include <array>
+#include <algorithm>
 #include <utils/linalg/linalg.h>
 #include <signal/systemmodels/systemmodels.hpp>
+#include <signal/systemmodels/discretization.hpp>
+#include <utils/sync/latest.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
 #include <mbed.h>
 
 namespace signal{
@@ -38,19 +44,34 @@ namespace controllers
         /**
          * @brief General interface class for the controller with single input and single output
          * 
-         * @tparam T type of the variables (float, double)
+         * @tparam T type of the variables (float, double, utils::fixedpoint::CFixedPoint)
          */
         template<class T>
         class IController{
             public:
                 virtual T calculateControl(const T&)=0;
                 virtual void clear()=0;
+                /** @brief Set the variable of the operating point (e.g. reference speed), it's applied only by scheduled controllers. */
+                virtual void setSchedulingVariable(const T&){}
+                /** @brief Set the saturation of the applied control signal (1 upper limit, -1 lower limit, 0 none), it's applied only by controllers with anti-windup. */
+                virtual void setSaturation(int8_t){}
+                /** @brief Set the pid parameters (e.g. by autotuning), it returns false, when the controller doesn't support it. */
+                virtual bool setParameters(const T&, const T&, const T&, const T&){return false;}
         };
 
         /**
-         * @brief It generates a discrete transferfunction for realizing a proportional–integral–derivative controller, which is discretized by the Euler’s method.
+         * @brief It generates a discrete transferfunction for realizing a proportional–integral–derivative controller, which is discretized by the forward Euler’s method (signal::systemmodels::lti::discretize).
          * 
-         * @tparam T type of the variables (float, double) 
+         * On the Cortex-M4F only the single precision is calculated by the FPU, so the float type is preferred to the double. A fixed-point 
+         * type with saturation arithmetic can be applied also, its range has to contain the coefficients of the denominator (about -2) and 
+         * the control signal, so instead of the Q15 and Q31 formats a format with integer bits is required (e.g. CFixedPoint<int32_t,int64_t,24>).
+         * 
+         * The change of the parameters is staged: the coefficients are calculated in the context of the caller (e.g. serial callback) 
+         * and they are published by a double buffered latest value, the control step only copies them at the next sample. So the 
+         * parameters can be changed at high rate during the tuning without the recalculation in the control loop. The parameters have 
+         * to be changed from a single context.
+         * 
+         * @tparam T type of the variables (float, double, utils::fixedpoint::CFixedPoint) 
          */
         template<class T>
         class CPidController:public IController<T>
@@ -68,6 +89,7 @@ namespace controllers
                               ,T              f_tf
                               ,T              f_dt);
                 CPidController(CPidSystemmodelType f_pid,T f_dt);
+                CPidController(const signal::systemmodels::lti::SDiscreteCoefficients<3>& f_discrete,T f_dt);
 
                 /* Calculate the control signal based the input error. */
                 T calculateControl(const T& f_input);
@@ -76,21 +98,217 @@ namespace controllers
 
                 /* Set to zero the previous values in the transferfunction  */
                 void clear();
+                /* Set the pid parameters */
+                bool setParameters(const T& f_kp, const T& f_ki, const T& f_kd, const T& f_tf);
+                /* Continuous transfer function of the pid parameters */
+                static constexpr signal::systemmodels::lti::SContinuousTransferFunction<3> continuousModel(double f_kp, double f_ki, double f_kd, double f_tf);
+                /* Discrete coefficients of the pid parameters */
+                static constexpr signal::systemmodels::lti::SDiscreteCoefficients<3> discreteModel(double f_kp, double f_ki, double f_kd, double f_tf, double f_dt);
             private:
+                /** @brief Staged coefficients of the discrete transferfunction */
+                struct SCoefficients{
+                    T m_num[3];     /** numerator coefficients */
+                    T m_den[3];     /** denominator coefficients */
+                };
                 /* Set the controller's parameters. */
-                void setController(T              f_kp
-                                  ,T              f_ki
-                                  ,T              f_kd
-                                  ,T              f_tf);
+                void setController(double         f_kp
+                                  ,double         f_ki
+                                  ,double         f_kd
+                                  ,double         f_tf);
+                /* Apply the staged coefficients */
+                void applyStaged();
 
                 /* Discrete transferfunction */
                 CPidSystemmodelType     m_pidTf;
+                /* Coefficients of the last parameter change */
+                utils::sync::CLatest<SCoefficients> m_staged;
+                /* Sequence of the applied coefficients */
+                uint32_t                m_appliedSequence;
 
 
                 /* Sampling time */
                 T                 m_dt;
 
         };
+        /**
+         * @brief Gain-scheduled proportional–integral–derivative controller with several operating points.
+         * 
+         * The parameters of each operating point are discretized at construction time by the same Euler's method as the 
+         * CPidController, but the controller is realized in parallel form with explicit integral and filtered derivative states:
+         *  I[k] = I[k-1] + ki*dt*e[k-1], F[k] = (tf-dt)/tf*F[k-1] + (e[k]-e[k-1])/tf, u[k] = kp*e[k] + I[k] + kd*F[k]
+         * In each period the coefficients are selected (or linearly interpolated) by the scheduling variable between the operating 
+         * points. When the coefficients change, the integral state absorbs the difference of the proportional and derivative parts, 
+         * so the control signal is continuous (bumpless transfer).
+         * 
+         * The integral state is protected against the windup by conditional integration: when the applied control signal was 
+         * saturated, the error, which would drive the control signal further into the saturation, isn't integrated.
+         * 
+         * The coefficients of the operating points are staged as by the CPidController, the control step takes the last published 
+         * set at the next sample, so a change of the parameters from the serial interface doesn't tear the applied coefficients.
+         * 
+         * @tparam T        type of the variables (float, double)
+         * @tparam NPoints  number of the operating points
+         */
+        template<class T, uint32_t NPoints>
+        class CGainScheduledPidController:public IController<T>
+        {
+            static_assert(NPoints >= 1, "The controller needs at least one operating point.");
+            public:
+                /** @brief Parameters of the pid controller in an operating point */
+                struct SGains{
+                    T m_kp;     /** proportional factor */
+                    T m_ki;     /** integral factor */
+                    T m_kd;     /** derivative factor */
+                    T m_tf;     /** derivative time filter constant */
+                };
+                /** @brief Scheduling variable values of the operating points, in increasing order */
+                using CPointsType = std::array<T,NPoints>;
+                /** @brief Parameters of the operating points */
+                using CGainsType = std::array<SGains,NPoints>;
+
+                /* Constructor */
+                CGainScheduledPidController(const CPointsType&  f_points
+                                           ,const CGainsType&   f_gains
+                                           ,T                   f_dt
+                                           ,bool                f_interpolate = true);
+
+                /* Set the variable of the operating point */
+                void setSchedulingVariable(const T& f_value);
+                /* Set the saturation of the applied control signal */
+                void setSaturation(int8_t f_saturation);
+                /* Calculate the control signal based the input error. */
+                T calculateControl(const T& f_input);
+                /* Set to zero the states of the controller */
+                void clear();
+                /* Set the parameters of an operating point */
+                bool setGains(uint32_t f_idx, const SGains& f_gains);
+                /* Set the parameters of the nearest operating point */
+                bool setParameters(const T& f_kp, const T& f_ki, const T& f_kd, const T& f_tf);
+                /* Serial callback implementation */
+                void serialCallback(char const * a, char * b);
+
+            private:
+                /** @brief Discrete coefficients of an operating point */
+                struct SCoefficients{
+                    T m_kp;     /** proportional factor */
+                    T m_kiDt;   /** integral factor multiplied by the sampling time */
+                    T m_kd;     /** derivative factor */
+                    T m_pole;   /** pole of the derivative filter */
+                    T m_invTf;  /** inverse of the derivative time filter constant */
+                };
+                /** @brief Coefficients of all operating points */
+                using CCoefficientsType = std::array<SCoefficients,NPoints>;
+                /* Select the coefficients by the scheduling variable */
+                SCoefficients schedule() const;
+
+                /* Scheduling variable values of the operating points */
+                CPointsType                             m_points;
+                /* Precalculated coefficients of the operating points, they are applied by the control step */
+                CCoefficientsType                       m_coefficients;
+                /* Coefficients of the last parameter change, they are modified by the writer context */
+                CCoefficientsType                       m_stagingCoefficients;
+                /* Published coefficients of the last parameter change */
+                utils::sync::CLatest<CCoefficientsType> m_staged;
+                /* Sequence of the applied coefficients */
+                uint32_t                                m_appliedSequence;
+                /* Sampling time */
+                T                                       m_dt;
+                /* Interpolation between the operating points, otherwise the lower operating point is applied */
+                bool                                    m_interpolate;
+                /* Current value of the scheduling variable */
+                T                                       m_scheduling;
+                /* Integral state */
+                T                                       m_integral;
+                /* Filtered derivative state */
+                T                                       m_derivative;
+                /* Previous error */
+                T                                       m_errorPrev;
+                /* Proportional and derivative factors applied in the previous period */
+                T                                       m_kpPrev;
+                T                                       m_kdPrev;
+                /* Saturation of the applied control signal in the previous period */
+                int8_t                                  m_saturation;
+                /* The states are initialized */
+                bool                                    m_isInitialized;
+        };
+
+        /**
+         * @brief Smith predictor around a controller, it compensates the dead time of the loop (sampling of the encoder, update of 
+         * the pwm, lag of the filters), so the parameters of the wrapped controller can be tuned for the plant without delay.
+         * 
+         * The output of the controller drives the model of the plant without delay (e.g. the discretized or the identified model of 
+         * the drive, CDiscreteTransferFunction), the same model output is delayed by the given number of periods in a ring. The 
+         * controller gets the error corrected by the difference of them: e' = e - (y_model[k] - y_model[k-d]), so with an exact model 
+         * the delayed feedback is replaced by the predicted one. The model is updated after the control step, the correction is applied 
+         * in the next period. With zero delay the correction is zero and the controller is applied unchanged.
+         * 
+         * The model sees only the output of the wrapped controller, the feed-forward of the motor controller stays out of the loop, 
+         * so its share of the speed isn't predicted. The saturation, the scheduling variable and the parameters are forwarded to the 
+         * wrapped controller. The model and the delay can be changed from the serial context, the change clears the prediction.
+         * 
+         * @tparam T            type of the variables (float, double)
+         * @tparam NModel       number of the coefficients of the model
+         * @tparam NMaxDelay    maximum delay in periods
+         */
+        template<class T, uint32_t NModel, uint32_t NMaxDelay>
+        class CSmithPredictor:public IController<T>
+        {
+            static_assert(NMaxDelay >= 1, "The predictor needs at least one period of delay.");
+            public:
+                /** @brief Type of the model of the plant without delay */
+                using CModelType = signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NModel,NModel>;
+
+                /* Constructor */
+                CSmithPredictor(IController<T>& f_controller, const CModelType& f_model, uint32_t f_delay = 0);
+                /* Calculate the control signal based the corrected error */
+                T calculateControl(const T& f_input);
+                /* Clear the states of the controller and of the prediction */
+                void clear();
+                /** @brief Set the variable of the operating point of the wrapped controller */
+                void setSchedulingVariable(const T& f_value)
+                {
+                    m_controller.setSchedulingVariable(f_value);
+                }
+                /** @brief Set the saturation of the applied control signal of the wrapped controller */
+                void setSaturation(int8_t f_saturation)
+                {
+                    m_controller.setSaturation(f_saturation);
+                }
+                /** @brief Set the parameters of the wrapped controller */
+                bool setParameters(const T& f_kp, const T& f_ki, const T& f_kd, const T& f_tf)
+                {
+                    return m_controller.setParameters(f_kp,f_ki,f_kd,f_tf);
+                }
+                /* Set the delay */
+                bool setDelay(uint32_t f_delay);
+                /** @brief Delay in periods */
+                uint32_t getDelay() const
+                {
+                    return m_delay;
+                }
+                /* Set the model of the plant */
+                void setModel(const typename CModelType::CNumType& f_num, const typename CModelType::CDenType& f_den);
+                /* Serial callback implementation */
+                void serialCallback(char const * a, char * b);
+
+            private:
+                /* Clear the prediction */
+                void clearPrediction();
+
+                /* Wrapped controller */
+                IController<T>&                         m_controller;
+                /* Model of the plant without delay */
+                CModelType                              m_model;
+                /* Delayed outputs of the model */
+                std::array<T,NMaxDelay>                 m_delayLine;
+                /* Index of the oldest output in the delay line */
+                uint32_t                                m_idx;
+                /* Delay in periods */
+                volatile uint32_t                       m_delay;
+                /* Correction of the next error */
+                T                                       m_correction;
+        };
+
         /* Include function definitions */
         #include "sisocontrollers.tpp"
     }; // namespace siso
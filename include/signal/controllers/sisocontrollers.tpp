@@ -47,13 +47,12 @@ CPidController<T>::CPidController( T              f_kp
                                   ,T              f_tf
                                   ,T              f_dt)
     :m_pidTf()
+    ,m_staged()
+    ,m_appliedSequence(0)
+    ,m_dt(f_dt)
 {    
-    // Calculate the coefficients for the discrete transferfunction based an Euler backward discretisation method. 
-    utils::linalg::CMatrix<T,1,3> l_numPid({ (f_kd+f_tf*f_kp)/f_tf , (f_tf*f_dt*f_ki+f_dt*f_kp-2*f_tf*f_kp-2*f_kd)/f_tf , (f_kd+f_tf*f_kp+f_dt*f_dt*f_ki-f_dt*f_tf*f_ki-f_dt*f_kp)/f_tf});
-    utils::linalg::CMatrix<T,1,3> l_denPid({ 1.0,-(2*f_tf-f_dt)/f_tf,(f_tf-f_dt)/f_tf });
-
-    m_pidTf.setNum(l_numPid.transpose());
-    m_pidTf.setDen(l_denPid.transpose());
+    setController(static_cast<double>(f_kp),static_cast<double>(f_ki),static_cast<double>(f_kd),static_cast<double>(f_tf));
+    applyStaged();
 }
 
 
@@ -69,23 +68,68 @@ template<class T>
 CPidController<T>::CPidController(  CPidSystemmodelType             f_pid
                                     ,T                              f_dt)
                                     :m_pidTf(f_pid)
+                                    ,m_staged()
+                                    ,m_appliedSequence(0)
+                                    ,m_dt(f_dt){
+}
+
+/**
+ * @brief CPidController class constructor
+ * 
+ * Construct a new discrete pid controller based the given discrete coefficients. With the coefficients of a constexpr 
+ * discreteModel the discretization is calculated by the compiler, the constructor only copies them.
+ *  
+ * @param f_discrete          discrete coefficients (e.g. discreteModel)
+ * @param f_dt                sampling time
+ */
+template<class T>
+CPidController<T>::CPidController(  const signal::systemmodels::lti::SDiscreteCoefficients<3>&  f_discrete
+                                    ,T                                                          f_dt)
+                                    :m_pidTf(signal::systemmodels::lti::toTransferFunction<T,3>(f_discrete))
+                                    ,m_staged()
+                                    ,m_appliedSequence(0)
                                     ,m_dt(f_dt){
 }
 
 
 /** @brief  Control signal generator
   *
-  *   It calculate the control signal based on the given input error. It has to be applied in each period. 
+  *   It calculate the control signal based on the given input error. It has to be applied in each period. The staged coefficients 
+  *   of a parameter change are taken before the calculation.
   * 
   * @param f_input             input error
   * \return                    control value
   */
 template<class T>
-T CPidController<T>::calculateControl(const T& f_input)
+CONTROL_RAMFUNC T CPidController<T>::calculateControl(const T& f_input)
 {
+    if (m_staged.getSequence() != m_appliedSequence)
+    {
+        applyStaged();
+    }
     return m_pidTf(f_input);
 }
 
+/** @brief  Apply the last published coefficients, only the coefficients are copied, the memory of the transferfunction is kept.
+  *
+  */
+template<class T>
+void CPidController<T>::applyStaged()
+{
+    uint32_t l_sequence;
+    SCoefficients l_coeff = m_staged.read(l_sequence);
+    typename CPidSystemmodelType::CNumType l_num;
+    typename CPidSystemmodelType::CDenType l_den;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        l_num[i][0] = l_coeff.m_num[i];
+        l_den[i][0] = l_coeff.m_den[i];
+    }
+    m_pidTf.setNum(l_num);
+    m_pidTf.setDen(l_den);
+    m_appliedSequence = l_sequence;
+}
+
 /** @brief  Reset to zero all memory of the controller.
   *
   */
@@ -95,8 +139,26 @@ void CPidController<T>::clear()
     m_pidTf.clearMemmory();
 }
 
+/** @brief  Set the pid parameters, the coefficients of the transferfunction are recalculated and staged for the next sample. 
+  *
+  * @param f_kp                proportional factor
+  * @param f_ki                integral factor
+  * @param f_kd                derivative factor
+  * @param f_tf                derivative time filter constant
+  * \return                    true
+  */
+template<class T>
+bool CPidController<T>::setParameters(const T& f_kp, const T& f_ki, const T& f_kd, const T& f_tf)
+{
+    setController(static_cast<double>(f_kp),static_cast<double>(f_ki),static_cast<double>(f_kd),static_cast<double>(f_tf));
+    return true;
+}
+
 /** @brief  Set the parameter of the controller
   *
+  * The coefficients of the discrete transferfunction are calculated in double precision and they are converted to the type of 
+  * the controller, so the same parameters can be applied for the floating point and for the fixed-point controllers. They are 
+  * published for the next sample, the control step doesn't recalculate them.
   *
   * @param f_kp                proportional factor
   * @param f_ki                integral factor
@@ -105,16 +167,52 @@ void CPidController<T>::clear()
   */
 template<class T>
 void CPidController<T>::setController(
-    T              f_kp,
-    T              f_ki,
-    T              f_kd,
-    T              f_tf)
+    double         f_kp,
+    double         f_ki,
+    double         f_kd,
+    double         f_tf)
+{
+    // Calculate the coefficients for the discrete transferfunction based the forward Euler discretisation method. 
+    const signal::systemmodels::lti::SDiscreteCoefficients<3> l_discrete = signal::systemmodels::lti::discretize(
+        continuousModel(f_kp,f_ki,f_kd,f_tf), static_cast<double>(m_dt), signal::systemmodels::lti::FORWARD_EULER);
+    SCoefficients l_coeff;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        l_coeff.m_num[i] = T(l_discrete.m_num[i]);
+        l_coeff.m_den[i] = T(l_discrete.m_den[i]);
+    }
+    m_staged.write(l_coeff);
+}
+
+/** @brief  Continuous transfer function of the controller, kp + ki/s + kd*s/(tf*s+1), with common denominator s*(tf*s+1). 
+  * It's constexpr, so a constant controller can be discretized by the compiler (signal::systemmodels::lti::discretize).
+  *
+  * @param f_kp                proportional factor
+  * @param f_ki                integral factor
+  * @param f_kd                derivative factor
+  * @param f_tf                derivative time filter constant
+  * \return                    coefficients of the polynomials of s
+  */
+template<class T>
+constexpr signal::systemmodels::lti::SContinuousTransferFunction<3> CPidController<T>::continuousModel(double f_kp, double f_ki, double f_kd, double f_tf)
+{
+    return {{f_ki, f_kp+f_ki*f_tf, f_kp*f_tf+f_kd}, {0.0, 1.0, f_tf}};
+}
+
+/** @brief  Discrete coefficients of the controller by the forward Euler's method, like the coefficients of the parameter change. 
+  * It's constexpr, so the coefficients of a constant controller are calculated by the compiler.
+  *
+  * @param f_kp                proportional factor
+  * @param f_ki                integral factor
+  * @param f_kd                derivative factor
+  * @param f_tf                derivative time filter constant
+  * @param f_dt                sampling time
+  * \return                    coefficients of the polynomials of z^-1
+  */
+template<class T>
+constexpr signal::systemmodels::lti::SDiscreteCoefficients<3> CPidController<T>::discreteModel(double f_kp, double f_ki, double f_kd, double f_tf, double f_dt)
 {
-    utils::linalg::CMatrix<T,1,3> l_numPid({ (f_kd+f_tf*f_kp)/f_tf , (f_tf*m_dt*f_ki+m_dt*f_kp-2*f_tf*f_kp-2*f_kd)/f_tf , (f_kd+f_tf*f_kp+m_dt*m_dt*f_ki-m_dt*f_tf*f_ki-m_dt*f_kp)/f_tf });
-    utils::linalg::CMatrix<T,1,3> l_denPid({ 1,-(2*f_tf-m_dt)/f_tf,(f_tf-m_dt)/f_tf });
-    
-    m_pidTf.setNum(l_numPid.transpose());
-    m_pidTf.setDen(l_denPid.transpose());
+    return signal::systemmodels::lti::discretize(continuousModel(f_kp,f_ki,f_kd,f_tf), f_dt, signal::systemmodels::lti::FORWARD_EULER);
 }
 
 /** @brief  Serial callback method  for setting controller to values received. The first string has to contains the parameters 
@@ -127,12 +225,389 @@ void CPidController<T>::setController(
 template<class T>
 void CPidController<T>::serialCallback(char const * a, char * b)
 {
-    float l_kp,l_ki,l_kd,l_tf;
-    uint32_t l_res = sscanf(a,"%f;%f;%f;%f;",&l_kp,&l_ki,&l_kd,&l_tf);
+    float l_gains[4];
+    uint32_t l_res = utils::fmt::parseFloats(a,l_gains,4);
     if (4 == l_res)
     {
-        setController(l_kp,l_ki,l_kd,l_tf);
-        sprintf(b,"ack;;%2.5f;%2.5f;%2.5f;%2.5f;",l_kp,l_ki,l_kd,l_tf);
+        setController(l_gains[0],l_gains[1],l_gains[2],l_gains[3]);
+        utils::fmt::CWriter(b).text("ack;;").fixed(l_gains[0],5).fixed(l_gains[1],5).fixed(l_gains[2],5).fixed(l_gains[3],5);
+    }
+    else
+    {
+        sprintf(b,"sintax error;;");
+    }
+}
+
+/** @brief CGainScheduledPidController class constructor
+  *
+  * It calculates the discrete coefficients of all operating points.
+  *
+  * @param f_points            scheduling variable values of the operating points, in increasing order
+  * @param f_gains             pid parameters of the operating points
+  * @param f_dt                sampling time
+  * @param f_interpolate       linear interpolation between the operating points
+  */
+template<class T, uint32_t NPoints>
+CGainScheduledPidController<T,NPoints>::CGainScheduledPidController(const CPointsType&  f_points
+                                                                   ,const CGainsType&   f_gains
+                                                                   ,T                   f_dt
+                                                                   ,bool                f_interpolate)
+    :m_points(f_points)
+    ,m_coefficients()
+    ,m_stagingCoefficients()
+    ,m_staged()
+    ,m_appliedSequence(0)
+    ,m_dt(f_dt)
+    ,m_interpolate(f_interpolate)
+    ,m_scheduling(0)
+    ,m_integral(0)
+    ,m_derivative(0)
+    ,m_errorPrev(0)
+    ,m_kpPrev(0)
+    ,m_kdPrev(0)
+    ,m_saturation(0)
+    ,m_isInitialized(false)
+{
+    for (uint32_t l_idx = 0; l_idx < NPoints; ++l_idx)
+    {
+        setGains(l_idx, f_gains[l_idx]);
+    }
+    m_coefficients = m_staged.read(m_appliedSequence);
+}
+
+/** @brief  Set the variable of the operating point, the next control signal is calculated by the corresponding coefficients.
+  *
+  * @param f_value             scheduling variable (e.g. absolute reference speed)
+  */
+template<class T, uint32_t NPoints>
+void CGainScheduledPidController<T,NPoints>::setSchedulingVariable(const T& f_value)
+{
+    m_scheduling = f_value;
+}
+
+/** @brief  Set the saturation of the applied control signal, it's considered by the integration in the next period.
+  *
+  * @param f_saturation        1 - the upper limit is applied, -1 - the lower limit is applied, 0 - not saturated
+  */
+template<class T, uint32_t NPoints>
+void CGainScheduledPidController<T,NPoints>::setSaturation(int8_t f_saturation)
+{
+    m_saturation = f_saturation;
+}
+
+/** @brief  Control signal generator
+  *
+  * It calculate the control signal based on the given input error. It has to be applied in each period. The staged coefficients 
+  * of a parameter change are taken before the calculation, the bumpless transfer smooths their step.
+  * 
+  * @param f_input             input error
+  * \return                    control value
+  */
+template<class T, uint32_t NPoints>
+CONTROL_RAMFUNC T CGainScheduledPidController<T,NPoints>::calculateControl(const T& f_input)
+{
+    if (m_staged.getSequence() != m_appliedSequence)
+    {
+        m_coefficients = m_staged.read(m_appliedSequence);
+    }
+    SCoefficients l_coeff = schedule();
+    if (!m_isInitialized)
+    {
+        m_kpPrev = l_coeff.m_kp;
+        m_kdPrev = l_coeff.m_kd;
+        m_isInitialized = true;
+    }
+    // Conditional integration: the error isn't integrated, when it drives the saturated control signal further
+    if (!((m_saturation > 0 && m_errorPrev > T(0)) || (m_saturation < 0 && m_errorPrev < T(0))))
+    {
+        m_integral += l_coeff.m_kiDt * m_errorPrev;
+    }
+    m_derivative = l_coeff.m_pole * m_derivative + (f_input - m_errorPrev) * l_coeff.m_invTf;
+    // Bumpless transfer: the output of the previous coefficients is kept by the integral state
+    m_integral += (m_kpPrev - l_coeff.m_kp) * f_input + (m_kdPrev - l_coeff.m_kd) * m_derivative;
+    m_kpPrev = l_coeff.m_kp;
+    m_kdPrev = l_coeff.m_kd;
+    m_errorPrev = f_input;
+    return l_coeff.m_kp * f_input + m_integral + l_coeff.m_kd * m_derivative;
+}
+
+/** @brief  Reset to zero all states of the controller.
+  *
+  */
+template<class T, uint32_t NPoints>
+void CGainScheduledPidController<T,NPoints>::clear()
+{
+    m_integral = 0;
+    m_derivative = 0;
+    m_errorPrev = 0;
+    m_saturation = 0;
+    m_isInitialized = false;
+}
+
+/** @brief  Set the parameters of an operating point
+  *
+  * The coefficients are calculated in double precision and they are converted to the type of the controller. The coefficients 
+  * of all operating points are published for the next sample.
+  *
+  * @param f_idx               index of the operating point
+  * @param f_gains             pid parameters
+  * \return                    false, when the index or the time filter constant is invalid
+  */
+template<class T, uint32_t NPoints>
+bool CGainScheduledPidController<T,NPoints>::setGains(uint32_t f_idx, const SGains& f_gains)
+{
+    double l_tf = static_cast<double>(f_gains.m_tf);
+    if (f_idx >= NPoints || l_tf <= 0.0)
+    {
+        return false;
+    }
+    double l_dt = static_cast<double>(m_dt);
+    SCoefficients& l_coeff = m_stagingCoefficients[f_idx];
+    l_coeff.m_kp = f_gains.m_kp;
+    l_coeff.m_kiDt = T(static_cast<double>(f_gains.m_ki) * l_dt);
+    l_coeff.m_kd = f_gains.m_kd;
+    l_coeff.m_pole = T((l_tf - l_dt) / l_tf);
+    l_coeff.m_invTf = T(1.0 / l_tf);
+    m_staged.write(m_stagingCoefficients);
+    return true;
+}
+
+/** @brief  Set the parameters of the operating point, which is the nearest to the current scheduling variable (e.g. after the autotuning at 
+  * this operating point).
+  *
+  * @param f_kp                proportional factor
+  * @param f_ki                integral factor
+  * @param f_kd                derivative factor
+  * @param f_tf                derivative time filter constant
+  * \return                    false, when the time filter constant is invalid
+  */
+template<class T, uint32_t NPoints>
+bool CGainScheduledPidController<T,NPoints>::setParameters(const T& f_kp, const T& f_ki, const T& f_kd, const T& f_tf)
+{
+    uint32_t l_idx = 0;
+    for (uint32_t i = 1; i < NPoints; ++i)
+    {
+        if (std::abs(m_points[i] - m_scheduling) < std::abs(m_points[l_idx] - m_scheduling))
+        {
+            l_idx = i;
+        }
+    }
+    SGains l_gains = {f_kp, f_ki, f_kd, f_tf};
+    return setGains(l_idx, l_gains);
+}
+
+/** @brief  Select the coefficients by the scheduling variable
+  *
+  * Outside of the operating points the first or the last one is applied. 
+  *
+  * \return                    coefficients of the current period
+  */
+template<class T, uint32_t NPoints>
+CONTROL_RAMFUNC typename CGainScheduledPidController<T,NPoints>::SCoefficients CGainScheduledPidController<T,NPoints>::schedule() const
+{
+    // Index of the first operating point above the scheduling variable
+    uint32_t l_idx = std::upper_bound(m_points.begin(), m_points.end(), m_scheduling) - m_points.begin();
+    if (l_idx == 0)
+    {
+        return m_coefficients[0];
+    }
+    if (l_idx == NPoints || !m_interpolate)
+    {
+        return m_coefficients[l_idx-1];
+    }
+    const SCoefficients& l_low = m_coefficients[l_idx-1];
+    const SCoefficients& l_high = m_coefficients[l_idx];
+    T l_weight = (m_scheduling - m_points[l_idx-1]) / (m_points[l_idx] - m_points[l_idx-1]);
+    SCoefficients l_coeff;
+    l_coeff.m_kp = l_low.m_kp + l_weight * (l_high.m_kp - l_low.m_kp);
+    l_coeff.m_kiDt = l_low.m_kiDt + l_weight * (l_high.m_kiDt - l_low.m_kiDt);
+    l_coeff.m_kd = l_low.m_kd + l_weight * (l_high.m_kd - l_low.m_kd);
+    l_coeff.m_pole = l_low.m_pole + l_weight * (l_high.m_pole - l_low.m_pole);
+    l_coeff.m_invTf = l_low.m_invTf + l_weight * (l_high.m_invTf - l_low.m_invTf);
+    return l_coeff;
+}
+
+/** @brief  Serial callback method for setting the parameters of an operating point. The first string has to contains the index 
+ * and the parameters (in order index, proportional, integral, derivative, time filter constant).
+  *
+  * @param  a                   string to read data from
+  * @param b                    string to write data to
+  */
+template<class T, uint32_t NPoints>
+void CGainScheduledPidController<T,NPoints>::serialCallback(char const * a, char * b)
+{
+    uint32_t l_idx;
+    float l_values[4];
+    const char* l_text = a;
+    if (utils::fmt::parseUint(l_text,l_idx) && ';' == *l_text++ && 4 == utils::fmt::parseFloats(l_text,l_values,4))
+    {
+        SGains l_gains = {T(l_values[0]),T(l_values[1]),T(l_values[2]),T(l_values[3])};
+        if (setGains(l_idx,l_gains))
+        {
+            utils::fmt::CWriter(b).text("ack;;").udec(l_idx).fixed(l_values[0],5).fixed(l_values[1],5).fixed(l_values[2],5).fixed(l_values[3],5);
+        }
+        else
+        {
+            sprintf(b,"invalid parameters;;");
+        }
+    }
+    else
+    {
+        sprintf(b,"sintax error;;");
+    }
+}
+
+/** @brief CSmithPredictor class constructor
+  *
+  * @param f_controller        wrapped controller, it's tuned for the plant without delay
+  * @param f_model             model of the plant without delay, its input is the control signal
+  * @param f_delay             delay in periods, zero disables the correction
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+CSmithPredictor<T,NModel,NMaxDelay>::CSmithPredictor(IController<T>& f_controller, const CModelType& f_model, uint32_t f_delay)
+    :m_controller(f_controller)
+    ,m_model(f_model)
+    ,m_delayLine()
+    ,m_idx(0)
+    ,m_delay((f_delay <= NMaxDelay) ? f_delay : 0)
+    ,m_correction(0)
+{
+    clearPrediction();
+}
+
+/** @brief  Calculate the control signal by the wrapped controller from the error corrected by the prediction, then update the 
+  * model and the delay line by the control signal.
+  *
+  * @param f_input             error of the feedback
+  * @return                    control signal
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+CONTROL_RAMFUNC T CSmithPredictor<T,NModel,NMaxDelay>::calculateControl(const T& f_input)
+{
+    T l_error = f_input - m_correction;
+    T l_control = m_controller.calculateControl(l_error);
+    uint32_t l_delay = m_delay;
+    if (0 == l_delay)
+    {
+        m_correction = T(0);
+        return l_control;
+    }
+    T l_free = m_model(l_control);
+    T l_delayed = m_delayLine[m_idx];
+    m_delayLine[m_idx] = l_free;
+    m_idx = (m_idx + 1 < l_delay) ? (m_idx + 1) : 0;
+    m_correction = l_free - l_delayed;
+    return l_control;
+}
+
+/** @brief  Clear the states of the wrapped controller and of the prediction
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+void CSmithPredictor<T,NModel,NMaxDelay>::clear()
+{
+    m_controller.clear();
+    clearPrediction();
+}
+
+/** @brief  Clear the memory of the model and the delay line, so the next control step isn't corrected.
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+void CSmithPredictor<T,NModel,NMaxDelay>::clearPrediction()
+{
+    m_model.clearMemmory();
+    m_delayLine.fill(T(0));
+    m_idx = 0;
+    m_correction = T(0);
+}
+
+/** @brief  Set the delay, the prediction is cleared.
+  *
+  * @param f_delay             delay in periods, zero disables the correction
+  * @return                    false, when the delay is above the maximum
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+bool CSmithPredictor<T,NModel,NMaxDelay>::setDelay(uint32_t f_delay)
+{
+    if (f_delay > NMaxDelay)
+    {
+        return false;
+    }
+    core_util_critical_section_enter();
+    m_delay = f_delay;
+    clearPrediction();
+    core_util_critical_section_exit();
+    return true;
+}
+
+/** @brief  Set the model of the plant without delay (e.g. by the identified model of the drive), the prediction is cleared.
+  *
+  * @param f_num               coefficients of the numerator of z^-1
+  * @param f_den               coefficients of the denominator of z^-1, the first one mustn't be zero
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+void CSmithPredictor<T,NModel,NMaxDelay>::setModel(const typename CModelType::CNumType& f_num, const typename CModelType::CDenType& f_den)
+{
+    core_util_critical_section_enter();
+    m_model.setNum(f_num);
+    m_model.setDen(f_den);
+    clearPrediction();
+    core_util_critical_section_exit();
+}
+
+/** @brief  Serial callback method to get and set the delay ('0' state: 'delay;maximum;;', '1;delay') or the model ('2;num0;...;den0;...', 
+  * NModel coefficients of the numerator and of the denominator of z^-1).
+  *
+  * @param  a                   string to read data from
+  * @param b                    string to write data to
+  */
+template<class T, uint32_t NModel, uint32_t NMaxDelay>
+void CSmithPredictor<T,NModel,NMaxDelay>::serialCallback(char const * a, char * b)
+{
+    const char* l_text = a;
+    uint32_t l_command;
+    if (!utils::fmt::parseUint(l_text,l_command))
+    {
+        sprintf(b,"sintax error;;");
+    }
+    else if (0 == l_command)
+    {
+        utils::fmt::CWriter(b).udec(m_delay).udec(NMaxDelay).chr(';');
+    }
+    else if (1 == l_command && ';' == *l_text++)
+    {
+        uint32_t l_delay;
+        if (!utils::fmt::parseUint(l_text,l_delay))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else
+        {
+            sprintf(b, setDelay(l_delay) ? "ack;;" : "invalid parameters;;");
+        }
+    }
+    else if (2 == l_command && ';' == *l_text++)
+    {
+        float l_values[2 * NModel];
+        if (2 * NModel != utils::fmt::parseFloats(l_text,l_values,2 * NModel))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0.0f == l_values[NModel])
+        {
+            sprintf(b,"invalid parameters;;");
+        }
+        else
+        {
+            typename CModelType::CNumType l_num;
+            typename CModelType::CDenType l_den;
+            for (uint32_t i = 0; i < NModel; ++i)
+            {
+                l_num[i][0] = T(l_values[i]);
+                l_den[i][0] = T(l_values[NModel + i]);
+            }
+            setModel(l_num,l_den);
+            sprintf(b,"ack;;");
+        }
     }
     else
     {
@@ -140,4 +615,4 @@ void CPidController<T>::serialCallback(char const * a, char * b)
     }
 }
 
-#endif
\ No newline at end of file
+#endif
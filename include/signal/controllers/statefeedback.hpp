@@ -0,0 +1,132 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StateFeedback.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the state feedback
+  *          (linear quadratic regulator) controller functionality.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef STATE_FEEDBACK_HPP
+#define STATE_FEEDBACK_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <utils/linalg/linalg.h>
+#include <signal/systemmodels/systemmodels.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace signal::controllers::mimo
+{
+   /**
+    * @brief Interface of the state observer of the state feedback controller (e.g. an adapter of the Kalman filter).
+    * 
+    * @tparam T        type of the variables
+    * @tparam NA       number of states variable
+    * @tparam NB       number of control variable
+    */
+    template <class T, uint32_t NA, uint32_t NB>
+    class IStateObserver
+    {
+        public:
+            /* Estimated state applied by the next control */
+            virtual const utils::linalg::CColVector<T,NA>& estimate() = 0;
+            /* Control signal of the last control, the observer predicts the next state with it */
+            virtual void apply(const utils::linalg::CColVector<T,NB>& f_control) = 0;
+    }; // class IStateObserver
+
+   /**
+    * @brief State feedback controller with fixed size based on the state space model: u = Nr*r - K*x.
+    * 
+    * The gain (K) is given by offline design or it's calculated on board as linear quadratic regulator by iterating the discrete 
+    * algebraic Riccati equation (P = Q + A^T*P*A - A^T*P*B*(R + B^T*P*B)^-1*B^T*P*A) until the convergence. The reference gain 
+    * (Nr) inverts the static gain of the closed loop, so the outputs follow the references without steady state error on the 
+    * nominal model (it's the least squares inverse, when there are more outputs than inputs). The design runs in the context of 
+    * the caller, a control step is two matrix-vector products by the fused kernels of the linalg.
+    * 
+    * The state is given by the caller (measured states) or it's read from the observer, which is informed about the applied control.
+    * 
+    * @tparam T        type of the variables
+    * @tparam NA       number of states variable
+    * @tparam NB       number of control variable
+    * @tparam NC       number of observation variable
+    */
+    template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+    class CStateFeedbackController
+    {
+        public:
+            using CSystemModelType = signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>;
+            using CStateType = typename CSystemModelType::CStateType;
+            using CControlType = typename CSystemModelType::CControlType;
+            using CMeasurementType = typename CSystemModelType::CMeasurementType;
+            using CGainType = utils::linalg::CMatrix<T,NB,NA>;                    // K - state feedback gain type
+            using CReferenceGainType = utils::linalg::CMatrix<T,NB,NC>;           // Nr - reference gain type
+            using CStateWeightType = utils::linalg::CMatrix<T,NA,NA>;             // Q - weight of the states
+            using CControlWeightType = utils::linalg::CMatrix<T,NB,NB>;           // R - weight of the control signals
+            using CObserverType = IStateObserver<T,NA,NB>;
+
+            /* Constructor with offline gains */
+            CStateFeedbackController(
+                const CGainType& f_gain,
+                const CReferenceGainType& f_referenceGain,
+                CObserverType* f_observer = NULL);
+            /* Constructor with linear quadratic regulator design */
+            CStateFeedbackController(
+                const CSystemModelType& f_model,
+                const CStateWeightType& f_stateWeight,
+                const CControlWeightType& f_controlWeight,
+                CObserverType* f_observer = NULL);
+            /* Linear quadratic regulator design */
+            bool design(
+                const CSystemModelType& f_model,
+                const CStateWeightType& f_stateWeight,
+                const CControlWeightType& f_controlWeight,
+                uint32_t f_iterations = 500,
+                T f_tolerance = T(1e-6));
+            /* Control by the given state */
+            CControlType operator()(const CStateType& f_state, const CMeasurementType& f_reference);
+            /* Control by the state of the observer */
+            CControlType operator()(const CMeasurementType& f_reference);
+
+            /** @brief Set the observer, NULL for the control by the given state */
+            void setObserver(CObserverType* f_observer) {m_observer = f_observer;}
+            /** @brief Set the gains of an offline design */
+            void setGains(const CGainType& f_gain, const CReferenceGainType& f_referenceGain) {m_gain = f_gain; m_referenceGain = f_referenceGain;}
+            /** @brief State feedback gain */
+            const CGainType& getGain() const {return m_gain;}
+            /** @brief Reference gain */
+            const CReferenceGainType& getReferenceGain() const {return m_referenceGain;}
+
+        private:
+            /* Reference gain of the closed loop */
+            bool designReferenceGain(const CSystemModelType& f_model);
+            /* state feedback gain */
+            CGainType m_gain;
+            /* reference gain */
+            CReferenceGainType m_referenceGain;
+            /* state observer */
+            CObserverType* m_observer;
+    }; // class CStateFeedbackController
+}; // namespace signal::controllers::mimo
+
+#include "statefeedback.tpp"
+
+#endif // STATE_FEEDBACK_HPP
@@ -0,0 +1,216 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StateFeedback.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the state feedback
+  *          (linear quadratic regulator) controller functionality.
+  ******************************************************************************
+ */
+
+#ifndef STATE_FEEDBACK_TPP
+#define STATE_FEEDBACK_TPP
+
+#ifndef STATE_FEEDBACK_HPP
+#error __FILE__ should only be included from statefeedback.hpp.
+#endif // STATE_FEEDBACK_HPP
+
+/** @brief  CStateFeedbackController class constructor with the gains of an offline design
+ *
+ *  @param f_gain                   state feedback gain (K)
+ *  @param f_referenceGain          reference gain (Nr)
+ *  @param f_observer               state observer, NULL for the control by the given state
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::CStateFeedbackController(
+        const CGainType& f_gain,
+        const CReferenceGainType& f_referenceGain,
+        CObserverType* f_observer)
+    : m_gain(f_gain)
+    , m_referenceGain(f_referenceGain)
+    , m_observer(f_observer)
+{
+}
+
+/** @brief  CStateFeedbackController class constructor, the gains are calculated by the linear quadratic regulator design. 
+ *  The gains remain zero, when the design fails.
+ *
+ *  @param f_model                  discrete system model
+ *  @param f_stateWeight            weight of the states (Q), symmetric positive semi-definite
+ *  @param f_controlWeight          weight of the control signals (R), symmetric positive definite
+ *  @param f_observer               state observer, NULL for the control by the given state
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::CStateFeedbackController(
+        const CSystemModelType& f_model,
+        const CStateWeightType& f_stateWeight,
+        const CControlWeightType& f_controlWeight,
+        CObserverType* f_observer)
+    : m_gain()
+    , m_referenceGain()
+    , m_observer(f_observer)
+{
+    design(f_model, f_stateWeight, f_controlWeight);
+}
+
+/** @brief  Linear quadratic regulator design by the iteration of the discrete algebraic Riccati equation, it starts from P = Q. 
+ *  The gains are changed only by a successful design.
+ *
+ *  @param f_model                  discrete system model
+ *  @param f_stateWeight            weight of the states (Q), symmetric positive semi-definite
+ *  @param f_controlWeight          weight of the control signals (R), symmetric positive definite
+ *  @param f_iterations             maximum number of the iterations
+ *  @param f_tolerance              relative change of P, where the iteration stops
+ *  @return                         false, when the iteration doesn't converge or the closed loop static gain can't be inverted
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+bool signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::design(
+        const CSystemModelType& f_model,
+        const CStateWeightType& f_stateWeight,
+        const CControlWeightType& f_controlWeight,
+        uint32_t f_iterations,
+        T f_tolerance)
+{
+    const utils::linalg::CMatrix<T,NA,NA>& l_A = f_model.getStateTransitionMatrix();
+    const utils::linalg::CMatrix<T,NA,NB>& l_B = f_model.getInputMatrix();
+    utils::linalg::CMatrix<T,NA,NA> l_At;
+    utils::linalg::CMatrix<T,NB,NA> l_Bt;
+    utils::linalg::transpose(l_At, l_A);
+    utils::linalg::transpose(l_Bt, l_B);
+    CStateWeightType l_P(f_stateWeight);
+    const CGainType l_gain(m_gain);
+    for (uint32_t l_iteration = 0; l_iteration < f_iterations; ++l_iteration)
+    {
+        // S = R + B^T*P*B
+        utils::linalg::CMatrix<T,NA,NA> l_PA;
+        utils::linalg::CMatrix<T,NA,NB> l_PB;
+        utils::linalg::multiply(l_PA, l_P, l_A);
+        utils::linalg::multiply(l_PB, l_P, l_B);
+        CControlWeightType l_S(f_controlWeight);
+        utils::linalg::multiplyAdd(l_S, l_Bt, l_PB);
+        utils::linalg::CCholeskyDecomposition<T,NB> l_decomposition(l_S);
+        if (!l_decomposition.isPositiveDefinite())
+        {
+            return false;
+        }
+        // K = S^-1 * B^T*P*A
+        utils::linalg::multiply(m_gain, l_Bt, l_PA);
+        utils::linalg::CMatrix<T,NA,NB> l_AtPB;
+        utils::linalg::transpose(l_AtPB, m_gain);
+        l_decomposition.solveInPlace(m_gain);
+        // P = Q + A^T*P*A - A^T*P*B * K
+        CStateWeightType l_next(f_stateWeight);
+        utils::linalg::multiplyAdd(l_next, l_At, l_PA);
+        utils::linalg::multiplySubtract(l_next, l_AtPB, m_gain);
+        // The rounding errors break the symmetry of P, it's restored as by the covariance of the Kalman filter
+        T l_change = T(0), l_norm = T(0);
+        for (uint32_t i = 0; i < NA; ++i)
+        {
+            for (uint32_t j = 0; j < i; ++j)
+            {
+                l_next[i][j] = l_next[j][i] = (l_next[i][j] + l_next[j][i]) * static_cast<T>(0.5);
+            }
+            for (uint32_t j = 0; j < NA; ++j)
+            {
+                T l_diff = l_next[i][j] - l_P[i][j];
+                l_change = std::max(l_change, (l_diff < T(0)) ? -l_diff : l_diff);
+                l_norm = std::max(l_norm, (l_next[i][j] < T(0)) ? -l_next[i][j] : l_next[i][j]);
+            }
+        }
+        l_P = l_next;
+        if (l_change <= f_tolerance * l_norm)
+        {
+            if (designReferenceGain(f_model))
+            {
+                return true;
+            }
+            break;
+        }
+    }
+    m_gain = l_gain;
+    return false;
+}
+
+/** @brief  Reference gain of the closed loop by the applied state feedback gain: Nr = G^+, where G = C*(I - A + B*K)^-1*B is the 
+ *  static gain from the reference input to the outputs and G^+ = (G^T*G)^-1*G^T is its least squares inverse.
+ *
+ *  @param f_model                  discrete system model
+ *  @return                         false, when the closed loop or the static gain is singular
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+bool signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::designReferenceGain(const CSystemModelType& f_model)
+{
+    // M = I - A + B*K
+    utils::linalg::CMatrix<T,NA,NA> l_M(utils::linalg::CMatrix<T,NA,NA>::eye());
+    l_M -= f_model.getStateTransitionMatrix();
+    utils::linalg::multiplyAdd(l_M, f_model.getInputMatrix(), m_gain);
+    utils::linalg::CLUDecomposition<T,NA> l_loop(l_M);
+    if (l_loop.isSingular())
+    {
+        return false;
+    }
+    utils::linalg::CMatrix<T,NA,NB> l_X(f_model.getInputMatrix());
+    l_loop.solveInPlace(l_X);
+    utils::linalg::CMatrix<T,NC,NB> l_G;
+    utils::linalg::multiply(l_G, f_model.getMeasurementMatrix(), l_X);
+    utils::linalg::CMatrix<T,NB,NC> l_Gt;
+    utils::linalg::transpose(l_Gt, l_G);
+    utils::linalg::CMatrix<T,NB,NB> l_GtG;
+    utils::linalg::multiply(l_GtG, l_Gt, l_G);
+    utils::linalg::CCholeskyDecomposition<T,NB> l_decomposition(l_GtG);
+    if (!l_decomposition.isPositiveDefinite())
+    {
+        return false;
+    }
+    l_decomposition.solveInPlace(l_Gt);
+    m_referenceGain = l_Gt;
+    return true;
+}
+
+/** @brief  Control by the given state: u = Nr*r - K*x
+ *
+ *  @param f_state                  measured or estimated state
+ *  @param f_reference              reference of the outputs
+ *  @return                         control signal
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+CONTROL_RAMFUNC typename signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::CControlType 
+signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::operator()(const CStateType& f_state, const CMeasurementType& f_reference)
+{
+    CControlType l_control;
+    utils::linalg::multiply(l_control, m_referenceGain, f_reference);
+    utils::linalg::multiplySubtract(l_control, m_gain, f_state);
+    return l_control;
+}
+
+/** @brief  Control by the state of the observer, the applied control is given to the observer for the next prediction. 
+ *  The observer has to be set.
+ *
+ *  @param f_reference              reference of the outputs
+ *  @return                         control signal
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+CONTROL_RAMFUNC typename signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::CControlType 
+signal::controllers::mimo::CStateFeedbackController<T,NA,NB,NC>::operator()(const CMeasurementType& f_reference)
+{
+    CControlType l_control = (*this)(m_observer->estimate(), f_reference);
+    m_observer->apply(l_control);
+    return l_control;
+}
+
+#endif // STATE_FEEDBACK_TPP
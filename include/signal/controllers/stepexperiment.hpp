@@ -0,0 +1,157 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StepExperiment.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the scripted reference
+  *          experiments with the control-quality metrics.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef STEP_EXPERIMENT_HPP
+#define STEP_EXPERIMENT_HPP
+
+#include <cmath>
+#include <stdint.h>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Scripted reference experiment of the speed loop, it scores the closed loop by the control-quality metrics at the control rate.
+    *
+    * The step experiment alternates the reference between the base and the base plus the amplitude, each level is held for the given
+    * duration; the sweep experiment is a sine around the base, whose frequency grows linearly over the duration. The first segment holds
+    * the base and it isn't scored, so the loop starts from a steady state. The metrics are accumulated in each control step with constant
+    * memory:
+    *  - IAE and ISE are the integrals of the absolute and of the squared error over the scored segments,
+    *  - rise time is the mean time from 10% to 90% of the steps,
+    *  - overshoot is the largest peak above the step in percent of the step,
+    *  - settling time is the longest time until the measured value stays in the 2% band of the step,
+    *  - steady-state error is the mean absolute error over the last quarter of the steps.
+    * The sweep experiment gives only the integrals. The reference and the errors are in the unit of the speed loop (rps).
+    */
+    class CStepExperiment
+    {
+        public:
+            /** @brief Reference scripts */
+            enum EMode{
+                STEPS = 0,
+                SWEEP = 1
+            };
+            /** @brief State of the experiment */
+            enum EState{
+                IDLE = 0,
+                RUNNING = 1,
+                FINISHED = 2,
+                FAILED = 3
+            };
+            /** @brief Result record of the experiment */
+            struct SResult{
+                float m_iae;            /** integral of the absolute error (rps*s) */
+                float m_ise;            /** integral of the squared error (rps^2*s) */
+                float m_riseTime;       /** mean 10-90% rise time (s) */
+                float m_overshoot;      /** largest overshoot (%) */
+                float m_settling;       /** longest 2% settling time (s) */
+                float m_steadyError;    /** mean absolute steady-state error (rps) */
+                uint16_t m_steps;       /** number of the scored steps */
+                uint16_t m_unsettled;   /** number of the steps, which didn't settle in their segment */
+            };
+
+            /* Constructor */
+            CStepExperiment(float f_dt);
+            /* Start a step experiment */
+            bool startSteps(float f_base, float f_amplitude, float f_duration, uint16_t f_count);
+            /* Start a sweep experiment */
+            bool startSweep(float f_base, float f_amplitude, float f_duration, float f_startFrequency, float f_endFrequency);
+            /* Abort the experiment */
+            void stop();
+            /* Apply one control step */
+            float step(float f_measured);
+            /** @brief State of the experiment */
+            EState getState() const
+            {
+                return m_state;
+            }
+            /** @brief Result of the finished experiment */
+            const SResult& getResult() const
+            {
+                return m_result;
+            }
+
+        private:
+            /* Start the segment of a new level */
+            void beginSegment(float f_reference);
+            /* Score the finished step segment */
+            void endSegment();
+            /* Finish the experiment and calculate the means */
+            void finish();
+
+            /** @brief Relative band of the settling */
+            static const float s_settlingBand;
+
+            /* Sampling time */
+            const float                             m_dt;
+            /* Reference script */
+            EMode                                   m_mode;
+            /* Base of the reference */
+            float                                   m_base;
+            /* Amplitude of the steps or of the sweep */
+            float                                   m_amplitude;
+            /* Number of the periods of a segment */
+            uint32_t                                m_segmentTicks;
+            /* Number of the periods of the lead-in at the base */
+            uint32_t                                m_leadTicks;
+            /* Number of the scored segments */
+            uint16_t                                m_segments;
+            /* Index of the current segment, zero is the lead-in */
+            uint16_t                                m_segment;
+            /* Period in the current segment */
+            uint32_t                                m_tick;
+            /* Reference of the current segment, the value before the step */
+            float                                   m_to;
+            float                                   m_from;
+            /* Periods of reaching the 10% and the 90% of the step, zero before it */
+            uint32_t                                m_tick10;
+            uint32_t                                m_tick90;
+            /* Largest relative progress of the step */
+            float                                   m_peak;
+            /* Period after the last sample outside of the settling band */
+            uint32_t                                m_settledTick;
+            /* Sum of the errors over the last quarter of the segment */
+            float                                   m_steadySum;
+            /* Start frequency and frequency rate of the sweep (Hz, Hz/s) */
+            float                                   m_frequency;
+            float                                   m_chirp;
+            /* Phase of the sweep */
+            float                                   m_phase;
+            /* Sums of the rise times and of the steady-state errors, number of the risen steps */
+            float                                   m_riseSum;
+            float                                   m_steadyAbsSum;
+            uint16_t                                m_risen;
+            /* State of the experiment */
+            volatile EState                         m_state;
+            /* Result of the experiment */
+            SResult                                 m_result;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // STEP_EXPERIMENT_HPP
@@ -0,0 +1,98 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SupplyCompensation.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the compensation of the
+  *          supply voltage in the volt to pwm conversion.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef SUPPLY_COMPENSATION_HPP
+#define SUPPLY_COMPENSATION_HPP
+
+#include <mbed.h>
+#include <signal/controllers/converters.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Volt to pwm converter, which corrects the calibrated converter by the measured supply voltage, and a stage of the control pipeline.
+    *
+    * The calibrated converter was measured at the nominal supply voltage. The voltage on the motor is the pwm multiplied by the supply, so
+    * the pwm of the calibration is scaled by the ratio of the nominal and the measured supply voltage; with the drained battery the same
+    * control voltage gives the same speed and the speed controller stays in the linear region of the calibration. The stage filters the
+    * measured supply voltage (the pwm ripple and the current peaks) by a first order low-pass filter and it updates the scale in each tick,
+    * the conversion costs only one multiplication more. The scale is limited, below the valid voltage (e.g. the divider isn't connected)
+    * the calibrated converter is applied without correction.
+    */
+    class CSupplyCompensation: public IConverter, public utils::pipeline::IPipelineStage
+    {
+        public:
+            /** @brief Getter of the supply voltage in volt */
+            typedef mbed::Callback<float()> FVoltageGetter;
+            /** @brief Limit of the scale of the pwm */
+            static constexpr float s_maxScale = 1.5f;
+
+            /* Constructor */
+            CSupplyCompensation(float           f_period
+                               ,IConverter&     f_source
+                               ,float           f_nominal
+                               ,float           f_minValid
+                               ,float           f_timeConstant);
+            /* Set the getter of the supply voltage */
+            void setInput(FVoltageGetter f_voltage);
+            /* Pipeline stage */
+            virtual void process(uint32_t f_timestamp);
+            /* Convert the control voltage to pwm */
+            virtual float operator()(float f_voltage);
+            /** @brief Filtered supply voltage (V) */
+            float getVoltage() const {return m_voltage;}
+            /** @brief Applied scale of the pwm */
+            float getScale() const {return m_scale;}
+            /* Enable or disable the compensation */
+            void setEnabled(bool f_enabled);
+            /* Serial callback of the compensation */
+            void serialCallback(char const * a, char * b);
+
+        private:
+            /* Calibrated converter */
+            IConverter&                 m_source;
+            /* Getter of the supply voltage */
+            FVoltageGetter              m_input;
+            /* Supply voltage of the calibration */
+            const float                 m_nominal;
+            /* Minimum valid measured voltage */
+            const float                 m_minValid;
+            /* Factor of the low-pass filter */
+            const float                 m_alpha;
+            /* Filtered supply voltage */
+            float                       m_voltage;
+            /* Scale of the pwm */
+            volatile float              m_scale;
+            /* The compensation is enabled */
+            volatile bool               m_enabled;
+    }; // class CSupplyCompensation
+}; // namespace controllers
+}; // namespace signal
+
+#endif // SUPPLY_COMPENSATION_HPP
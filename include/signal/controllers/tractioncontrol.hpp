@@ -0,0 +1,131 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    TractionControl.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the traction control
+  *          of the motor command.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef TRACTION_CONTROL_HPP
+#define TRACTION_CONTROL_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/dcmotor.hpp>
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Traction control of the drive, it's placed between the controllers and the motor driver and it reduces the pwm, when the wheels slip.
+    * 
+    * The pipeline stage estimates the speed of the body in each tick. With the longitudinal acceleration of the inertial sensor the body speed 
+    * is integrated and it's corrected toward the wheel speed, while the wheels grip. Without the sensor the body speed follows the wheel speed 
+    * with the acceleration limit of the grip. The slip ratio is the excess of the wheel speed over the body speed in the direction of the 
+    * move, relative to the body speed. Above the threshold the gain of the pwm is decreased in the same tick by the ratio of the threshold 
+    * and the slip, then it recovers with a limited rate after the grip is regained. So the launches are limited to the acceleration, which 
+    * the surface can transfer. The braking commands are forwarded without change.
+    */
+    class CTractionControl: public hardware::drivers::IMotorCommand, public utils::pipeline::IPipelineStage
+    {
+        public:
+            /** @brief  Getter of the longitudinal acceleration of the body in meter per square second */
+            typedef mbed::Callback<float()> FAccelerationGetter;
+
+            /* Constructor */
+            CTractionControl(float                                 f_period
+                            ,hardware::encoders::IEncoderGetter&   f_encoder
+                            ,hardware::drivers::IMotorCommand&     f_motor
+                            ,float                                 f_meterPerRotation
+                            ,float                                 f_maxAcceleration
+                            ,float                                 f_threshold = 0.2f);
+            /* Pipeline stage, it estimates the slip and the gain of the pwm */
+            virtual void process(uint32_t f_timestamp);
+            /* Set the pwm through the gain of the traction control */
+            void setSpeed(float f_pwm);
+            /* Brake the motor */
+            void brake();
+            /* Inverse direction braking */
+            void inverseDirection(float f_pwm);
+            /* Coast the motor */
+            void coast();
+            /* Proportional dynamic braking */
+            void dynamicBrake(float f_duty);
+            /* Check the range of the pwm */
+            bool inRange(float f_pwm);
+            /* Attach the getter of the longitudinal acceleration */
+            void setAccelerationGetter(FAccelerationGetter f_acceleration);
+            /* Set the parameters of the slip detection */
+            bool setParameters(float f_threshold, float f_maxAcceleration);
+            /** @brief  Gain of the pwm, one without slip */
+            float getGain() const
+            {
+                return m_gain;
+            }
+            /** @brief  Last slip ratio */
+            float getSlip() const
+            {
+                return m_slip;
+            }
+            /* Serial callback method of the traction control */
+            void serialCallback(char const * a, char * b);
+        private:
+            /* Speed feedback of the wheels */
+            hardware::encoders::IEncoderGetter&     m_encoder;
+            /* Motor driver */
+            hardware::drivers::IMotorCommand&       m_motor;
+            /* Period of the estimation in second */
+            const float                             m_dt;
+            /* Travelled distance of a motor rotation in meter */
+            const float                             m_meterPerRotation;
+            /* Acceleration limit of the grip in meter per square second */
+            float                                   m_maxAcceleration;
+            /* Slip ratio of the detection */
+            float                                   m_threshold;
+            /* Getter of the longitudinal acceleration, the acceleration limit is applied without it */
+            FAccelerationGetter                     m_acceleration;
+            /* Estimated speed of the body in meter per second */
+            float                                   m_bodySpeed;
+            /* Last slip ratio */
+            volatile float                          m_slip;
+            /* Gain of the pwm */
+            volatile float                          m_gain;
+            /* Number of the detected slips */
+            volatile uint32_t                       m_events;
+            /* Slip state of the last tick */
+            bool                                    m_isSlipping;
+            /* Activation of the pwm reduction, the estimation runs also without it */
+            volatile bool                           m_isActive;
+            /* Minimum gain of the pwm */
+            static constexpr float s_minGain = 0.2f;
+            /* Recovery rate of the gain per second */
+            static constexpr float s_recovery = 2.0f;
+            /* Correction factor of the integrated body speed toward the wheel speed per tick */
+            static constexpr float s_correction = 0.05f;
+            /* Lower bound of the body speed in the slip ratio (m/s), so the slip ratio is limited at the launch */
+            static constexpr float s_minSpeed = 0.1f;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // TRACTION_CONTROL_HPP
@@ -0,0 +1,130 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    YawRateSteering.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the closed-loop
+  *          yaw rate control of the steering.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef YAW_RATE_STEERING_HPP
+#define YAW_RATE_STEERING_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/steeringmotor.hpp>
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <signal/controllers/sisocontrollers.hpp>
+#include <signal/systemmodels/steeringgeometry.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace signal
+{
+namespace controllers
+{
+   /**
+    * @brief Yaw rate control of the steering, it's placed between the robot state machine and the steering servo.
+    * 
+    * In the angle mode the commands are forwarded to the servo without change. In the yaw rate mode the command of the steering (MCTL) 
+    * is the reference yaw rate in degree per second, positive to right as the steering angle. The servo angle is the feedforward of the 
+    * kinematic bicycle model (atan(r * L / v), by the lookup tables of the steering geometry) and the output of the controller, whose input is the error of the yaw rate measured by the 
+    * gyroscope, so the nonlinearity of the servo and the slip of the tires are compensated in the tick of the command. The sign of the 
+    * correction follows the direction of the move. Below the minimal speed the yaw rate isn't observable, the feedforward of the minimal 
+    * speed is applied and the controller is cleared. The saturated angle is signalled to the controller for the anti-windup.
+    * 
+    * The pipeline stage takes the speed of the wheels and the yaw rate at the start of the tick, it has to be applied before the robot 
+    * state machine. The controller is cleared, when the state machine doesn't steer in a tick or the mode is changed. The on-board path 
+    * follower gives servo angles, it's applied in the angle mode.
+    */
+    class CYawRateSteering: public hardware::drivers::ISteeringCommand, public utils::pipeline::IPipelineStage
+    {
+        public:
+            /** @brief  Getter of the yaw rate in radian per second, counter-clockwise */
+            typedef mbed::Callback<float()> FRateGetter;
+            /** @brief  Interpretation of the steering commands */
+            enum EMode{
+                /** @brief The command is the servo angle in degree. */
+                MODE_ANGLE = 0,
+                /** @brief The command is the yaw rate in degree per second. */
+                MODE_YAW_RATE = 1
+            };
+
+            /* Constructor */
+            CYawRateSteering(hardware::encoders::IEncoderGetter&     f_encoder
+                            ,hardware::drivers::ISteeringCommand&    f_steering
+                            ,siso::IController<float>&               f_controller
+                            ,float                                   f_meterPerRotation
+                            ,const systemmodels::CSteeringGeometry&  f_geometry
+                            ,float                                   f_maxAngle
+                            ,float                                   f_maxRate = 120.0f);
+            /* Pipeline stage, it takes the speed and the yaw rate */
+            virtual void process(uint32_t f_timestamp);
+            /* Set the steering command */
+            void setAngle(float f_value);
+            /* Check the range of the steering command */
+            bool inRange(float f_value);
+            /* Attach the getter of the yaw rate */
+            void setRateGetter(FRateGetter f_rate);
+            /* Change the mode */
+            bool setMode(EMode f_mode);
+            /** @brief  Mode of the steering commands */
+            EMode getMode() const
+            {
+                return m_mode;
+            }
+            /* Serial callback method of the yaw rate control */
+            void serialCallback(char const * a, char * b);
+        private:
+            /* Speed feedback of the wheels */
+            hardware::encoders::IEncoderGetter&     m_encoder;
+            /* Steering servo */
+            hardware::drivers::ISteeringCommand&    m_steering;
+            /* Controller of the yaw rate error */
+            siso::IController<float>&               m_controller;
+            /* Travelled distance of a motor rotation in meter */
+            const float                             m_meterPerRotation;
+            /* Steering geometry of the feedforward */
+            const systemmodels::CSteeringGeometry&  m_geometry;
+            /* Limit of the steering angle in degree */
+            const float                             m_maxAngle;
+            /* Limit of the reference yaw rate in degree per second */
+            const float                             m_maxRate;
+            /* Getter of the yaw rate, the yaw rate mode isn't available without it */
+            FRateGetter                             m_rate;
+            /* Mode of the commands */
+            volatile EMode                          m_mode;
+            /* The controller has to be cleared in the control loop */
+            volatile bool                           m_clearRequest;
+            /* The state machine steered in the last tick */
+            bool                                    m_isSteered;
+            /* Speed of the wheels of the tick in meter per second */
+            volatile float                          m_speed;
+            /* Measured yaw rate of the tick in degree per second, positive to right */
+            volatile float                          m_measured;
+            /* Last reference yaw rate in degree per second */
+            volatile float                          m_reference;
+            /* Last servo angle in degree */
+            volatile float                          m_angle;
+            /* Lower bound of the speed in the feedforward (m/s), the yaw rate isn't controlled below it */
+            static constexpr float s_minSpeed = 0.1f;
+    };
+}; // namespace controllers
+}; // namespace signal
+
+#endif // YAW_RATE_STEERING_HPP
@@ -0,0 +1,149 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    attitude.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the complementary
+  *          attitude estimation of the inertial samples.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef ATTITUDE_HPP
+#define ATTITUDE_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cmath>
+#include <limits>
+#include <utils/fixedpoint/fixedpoint.hpp>
+#include <utils/linalg/rotation.hpp>
+#include <utils/fmt/format.hpp>
+#include <hardware/imu/mpu6050.hpp>
+
+namespace signal::filter
+{
+    /**
+     * @brief Interface of the attitude estimators, they process the batches of the inertial FIFO and they give the Euler angles.
+     */
+    class IAttitudeFilter
+    {
+        public:
+            /* Apply a batch of inertial samples */
+            virtual void process(const hardware::imu::SImuSample* f_samples, size_t f_n) = 0;
+            /* Restart the estimation */
+            virtual void reset() = 0;
+            /** @brief Roll of the last batch in radian */
+            virtual float getRoll() const = 0;
+            /** @brief Pitch of the last batch in radian */
+            virtual float getPitch() const = 0;
+            /** @brief Heading (yaw) of the last batch in radian, counter-clockwise in [-pi, pi] */
+            virtual float getYaw() const = 0;
+    }; // class IAttitudeFilter
+
+}; // namespace signal::filter
+
+namespace utils::linalg
+{
+    /**
+     * @brief Inverse square root of the fixed-point type for the normalizations of the rotation types, it's computed from the stored
+     * integer by an integer square root, so the normalizations don't need the floating point unit.
+     */
+    template <class TBase, class TWide, uint8_t NFrac>
+    struct SInvSqrt<utils::fixedpoint::CFixedPoint<TBase,TWide,NFrac>>
+    {
+        /** @brief The fixed-point type */
+        using CType = utils::fixedpoint::CFixedPoint<TBase,TWide,NFrac>;
+        /* Inverse square root of a positive value, it saturates to the range of the type */
+        static CType apply(const CType& f_value);
+        /* Integer square root */
+        static uint64_t isqrt(uint64_t f_value);
+    };
+}; // namespace utils::linalg
+
+namespace signal::filter
+{
+    /**
+     * @brief Mahony complementary filter of the attitude with quaternion state.
+     *
+     * The quaternion is propagated by the angular rate of the gyroscope, the rate is corrected by the proportional and the integral
+     * feedback of the cross product between the measured and the estimated direction of the gravity, so the roll and the pitch track
+     * the accelerometer and the integral term learns the bias of the gyroscope around the horizontal axes. The samples with acceleration
+     * far from the gravity (0.5g - 1.5g) aren't corrected. The heading isn't observed by the gravity, it's the tilt compensated
+     * integral of the angular rate, so on a banked surface it's more accurate than the integral of the z axis. An update is about
+     * 40 multiplications and one inverse square root, a fraction of the extended Kalman filter.
+     *
+     * The batch is processed by one call (block-processing), the time steps are taken from the timestamps of the samples, the first sample
+     * initializes the quaternion from the accelerometer. The Euler angles are computed after each batch and they are stored as single
+     * floats, so they can be read by other threads.
+     *
+     * @tparam T    The type of the calculation (float or fixed-point with integer bits, e.g. utils::fixedpoint::CFixedPoint<int32_t,int64_t,24>)
+     */
+    template <class T>
+    class CMahonyFilter: public IAttitudeFilter
+    {
+        public:
+            /* Constructor */
+            CMahonyFilter(float f_kp, float f_ki);
+            /* Apply a batch of inertial samples */
+            void process(const hardware::imu::SImuSample* f_samples, size_t f_n);
+            /* Restart the estimation */
+            void reset();
+            /* Set the feedback gains */
+            void setGains(float f_kp, float f_ki);
+            /** @brief Roll of the last batch in radian */
+            float getRoll() const {return m_roll;}
+            /** @brief Pitch of the last batch in radian */
+            float getPitch() const {return m_pitch;}
+            /** @brief Heading (yaw) of the last batch in radian */
+            float getYaw() const {return m_yaw;}
+            /* Serial callback method */
+            void serialCallback(char const * a, char * b);
+        private:
+            /* Apply a sample */
+            void update(const hardware::imu::SImuSample& f_sample, const T& f_dt);
+            /* Initialize the quaternion from the gravity */
+            void initialize(const hardware::imu::SImuSample& f_sample);
+            /** @brief Gravity in meter per square second, the acceleration is scaled to g */
+            static constexpr float s_gravity = 9.80665f;
+            /** @brief Proportional gain of the feedback */
+            T m_kp;
+            /** @brief Integral gain of the feedback */
+            T m_ki;
+            /** @brief Quaternion of the rotation from the sensor frame to the earth frame */
+            utils::linalg::CQuaternion<T> m_q;
+            /** @brief Integral of the feedback, the estimated bias of the angular rate in radian per second with negative sign */
+            utils::linalg::CVector3<T> m_integral;
+            /** @brief Timestamp of the last sample, zero before the first sample */
+            uint32_t m_timestamp;
+            /** @brief Roll of the last batch */
+            volatile float m_roll;
+            /** @brief Pitch of the last batch */
+            volatile float m_pitch;
+            /** @brief Heading of the last batch */
+            volatile float m_yaw;
+    }; // class CMahonyFilter
+
+    /** @brief Fixed-point Mahony filter with 7 integer bits, the range contains the angular rates of the 500 dps range and the 4g accelerations */
+    using CMahonyFilterQ24 = CMahonyFilter<utils::fixedpoint::CFixedPoint<int32_t,int64_t,24>>;
+
+}; // namespace signal::filter
+
+#include "attitude.tpp"
+
+#endif // ATTITUDE_HPP
@@ -0,0 +1,214 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    attitude.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the complementary
+  *          attitude estimation of the inertial samples.
+  ******************************************************************************
+ */
+
+#ifndef ATTITUDE_TPP
+#define ATTITUDE_TPP
+
+#ifndef ATTITUDE_HPP
+#error __FILE__ should only be included from attitude.hpp.
+#endif // ATTITUDE_HPP
+
+namespace utils::linalg
+{
+    /******************************************************************************/
+    /** @brief  Inverse square root of the fixed-point value
+     *
+     *  The stored integer r represents r / 2^NFrac, so the result is 2^(2*NFrac) / sqrt(r * 2^NFrac) in stored units.
+     *
+     *  @param f_value             positive value, zero and negative values give the maximum
+     *  @return                    inverse square root
+     */
+    template <class TBase, class TWide, uint8_t NFrac>
+    typename SInvSqrt<utils::fixedpoint::CFixedPoint<TBase,TWide,NFrac>>::CType SInvSqrt<utils::fixedpoint::CFixedPoint<TBase,TWide,NFrac>>::apply(const CType& f_value)
+    {
+        const uint64_t l_max = static_cast<uint64_t>(std::numeric_limits<TBase>::max());
+        if (f_value.raw() <= 0)
+        {
+            return CType::fromRaw(static_cast<TBase>(l_max));
+        }
+        uint64_t l_root = isqrt(static_cast<uint64_t>(f_value.raw()) << NFrac);
+        uint64_t l_result = (l_root > 0) ? ((1ULL << (2 * NFrac)) / l_root) : l_max;
+        return CType::fromRaw(static_cast<TBase>((l_result < l_max) ? l_result : l_max));
+    }
+
+    /** @brief  Integer square root by the digit-by-digit method
+     *
+     *  @param f_value             value
+     *  @return                    largest integer, whose square isn't greater than the value
+     */
+    template <class TBase, class TWide, uint8_t NFrac>
+    uint64_t SInvSqrt<utils::fixedpoint::CFixedPoint<TBase,TWide,NFrac>>::isqrt(uint64_t f_value)
+    {
+        uint64_t l_root = 0;
+        uint64_t l_bit = 1ULL << 62;
+        while (l_bit > f_value)
+        {
+            l_bit >>= 2;
+        }
+        while (l_bit != 0)
+        {
+            if (f_value >= l_root + l_bit)
+            {
+                f_value -= l_root + l_bit;
+                l_root = (l_root >> 1) + l_bit;
+            }
+            else
+            {
+                l_root >>= 1;
+            }
+            l_bit >>= 2;
+        }
+        return l_root;
+    }
+}; // namespace utils::linalg
+
+namespace signal::filter
+{
+    /******************************************************************************/
+    /** @brief  CMahonyFilter Class constructor
+     *
+     * @param f_kp                 proportional gain of the gravity feedback (rad/s per unit error)
+     * @param f_ki                 integral gain of the gravity feedback
+     */
+    template <class T>
+    CMahonyFilter<T>::CMahonyFilter(float f_kp, float f_ki)
+        : m_kp(f_kp)
+        , m_ki(f_ki)
+    {
+        reset();
+    }
+
+    /** @brief  Restart the estimation, the next sample initializes the quaternion. It has to be applied from the context of the processing.
+     */
+    template <class T>
+    void CMahonyFilter<T>::reset()
+    {
+        m_q = utils::linalg::CQuaternion<T>();
+        m_integral = utils::linalg::CVector3<T>();
+        m_timestamp = 0;
+        m_roll = m_pitch = m_yaw = 0.0f;
+    }
+
+    /** @brief  Set the feedback gains, they are applied at the next sample.
+     *
+     * @param f_kp                 proportional gain
+     * @param f_ki                 integral gain, zero disables the bias estimation
+     */
+    template <class T>
+    void CMahonyFilter<T>::setGains(float f_kp, float f_ki)
+    {
+        m_kp = T(f_kp);
+        m_ki = T(f_ki);
+    }
+
+    /** @brief  Apply a batch of inertial samples and update the Euler angles. The longer gaps than 0.1 s (lost samples) aren't integrated.
+     *
+     * @param f_samples            samples in the order of their timestamps
+     * @param f_n                  number of the samples
+     */
+    template <class T>
+    void CMahonyFilter<T>::process(const hardware::imu::SImuSample* f_samples, size_t f_n)
+    {
+        for (size_t i = 0; i < f_n; ++i)
+        {
+            const hardware::imu::SImuSample& l_sample = f_samples[i];
+            if (0 == m_timestamp)
+            {
+                initialize(l_sample);
+            }
+            else
+            {
+                float l_dt = static_cast<float>(l_sample.m_timestamp - m_timestamp) * 1e-6f;
+                if (l_dt > 0.0f && l_dt < 0.1f)
+                {
+                    update(l_sample, T(l_dt));
+                }
+            }
+            m_timestamp = (l_sample.m_timestamp != 0) ? l_sample.m_timestamp : 1;
+        }
+        if (f_n > 0)
+        {
+            m_roll = m_q.roll();
+            m_pitch = m_q.pitch();
+            m_yaw = m_q.yaw();
+        }
+    }
+
+    /** @brief  Apply a sample: the gravity feedback corrects the angular rate, the quaternion is integrated and normalized.
+     *
+     * @param f_sample             inertial sample
+     * @param f_dt                 time step in second
+     */
+    template <class T>
+    void CMahonyFilter<T>::update(const hardware::imu::SImuSample& f_sample, const T& f_dt)
+    {
+        const T l_two(2.0f);
+        utils::linalg::CVector3<T> l_rate(T(f_sample.m_gyro[0]), T(f_sample.m_gyro[1]), T(f_sample.m_gyro[2]));
+        utils::linalg::CVector3<T> l_accel(T(f_sample.m_accel[0] / s_gravity), T(f_sample.m_accel[1] / s_gravity), T(f_sample.m_accel[2] / s_gravity));
+        T l_norm = l_accel.norm2();
+        if (l_norm > T(0.25f) && l_norm < T(2.25f))
+        {
+            l_accel *= utils::linalg::invSqrt(l_norm);
+            // Direction of the gravity in the sensor frame by the estimated quaternion (third row of the rotation matrix)
+            utils::linalg::CVector3<T> l_gravity(l_two * (m_q[1] * m_q[3] - m_q[0] * m_q[2])
+                                               , l_two * (m_q[0] * m_q[1] + m_q[2] * m_q[3])
+                                               , m_q[0] * m_q[0] - m_q[1] * m_q[1] - m_q[2] * m_q[2] + m_q[3] * m_q[3]);
+            // Error between the measured and the estimated direction
+            utils::linalg::CVector3<T> l_error = l_accel.cross(l_gravity);
+            m_integral.axpy(m_ki * f_dt, l_error);
+            l_rate.axpy(m_kp, l_error);
+            l_rate += m_integral;
+        }
+        m_q.integrate(l_rate, f_dt);
+    }
+
+    /** @brief  Initialize the quaternion from the direction of the gravity with zero heading, so the roll and the pitch don't have to
+     *  converge by the feedback.
+     *
+     * @param f_sample             first inertial sample
+     */
+    template <class T>
+    void CMahonyFilter<T>::initialize(const hardware::imu::SImuSample& f_sample)
+    {
+        float l_roll = std::atan2(f_sample.m_accel[1], f_sample.m_accel[2]);
+        float l_pitch = std::atan2(-f_sample.m_accel[0], std::sqrt(f_sample.m_accel[1] * f_sample.m_accel[1] + f_sample.m_accel[2] * f_sample.m_accel[2]));
+        m_q = utils::linalg::CQuaternion<T>::fromEuler(l_roll, l_pitch, 0.0f);
+    }
+
+    /** @brief  Serial callback method, it responses the Euler angles of the last batch in degree: 'roll;pitch;yaw;;'.
+     *
+     * @param a                    input received string
+     * @param b                    output reponse message
+     */
+    template <class T>
+    void CMahonyFilter<T>::serialCallback(char const * a, char * b)
+    {
+        const float l_deg = 180.0f / static_cast<float>(M_PI);
+        utils::fmt::CWriter(b).fixed(m_roll * l_deg,2).fixed(m_pitch * l_deg,2).fixed(m_yaw * l_deg,2).chr(';');
+    }
+
+}; // namespace signal::filter
+
+#endif // ATTITUDE_TPP
@@ -28,6 +28,7 @@ limitations under the License.
 
 #include <utils/linalg/linalg.h>
 #include <signal/systemmodels/systemmodels.hpp>
+#include <utils/memory/sections.hpp>
 
 namespace signal::filter
 {
@@ -41,6 +42,15 @@ namespace signal::filter
     {
         public:
             virtual T operator()(T&)=0;
+            /** @brief Filter a block of samples (DMA buffer) by one call, the filters with small state override it and keep the state in registers */
+            virtual void process(const T* f_in, T* f_out, size_t f_n)
+            {
+                for (size_t i = 0; i < f_n; ++i)
+                {
+                    T l_u = f_in[i];
+                    f_out[i] = (*this)(l_u);
+                }
+            }
     }; // Class IFilter
 
     namespace lti
@@ -49,57 +59,124 @@ namespace signal::filter
         {
 
             /**
-             * @brief Infinite impulse response (IIR) discrete-time filter template class
+             * @brief Coefficients of the IIR filter, it's a literal type, so the coefficients of a constexpr object are placed in flash.
              * 
-             * @tparam T    The type of the input and output signal
+             * @tparam T    The type of the coefficients
              * @tparam NA   Number of coefficients for feedback filter
              * @tparam NB   Number of coefficients for feedforward filter
              */
             template <class T, uint32_t NA, uint32_t NB>
+            struct SIIRCoefficients
+            {
+                /** @brief Constructor */
+                constexpr SIIRCoefficients(const utils::linalg::CRowVector<T,NA>& f_A,const utils::linalg::CRowVector<T,NB>& f_B)
+                    : m_A(f_A), m_B(f_B) {}
+                /** @brief Polynomial coefficient for feedback filter  */
+                utils::linalg::CRowVector<T,NA> m_A;
+                /** @brief Polynomial coefficient for feedforward filter */
+                utils::linalg::CRowVector<T,NB> m_B;
+            };
+
+            /**
+             * @brief Infinite impulse response (IIR) discrete-time filter template class
+             * 
+             * The previous inputs and outputs are stored in mirrored circular buffers like the FIR filter, the last values are viewed 
+             * as column vectors from the indexes, so the memories aren't shifted.
+             * 
+             * The coefficients are stored by the TCoeffs type: by default the filter owns a copy, with a constant reference (CConstIIRFilter) 
+             * the filter refers to a constexpr SIIRCoefficients object in flash and only its memory is in RAM. The constructor is 
+             * constexpr, so the filter is initialized without static constructor.
+             * 
+             * @tparam T        The type of the input and output signal
+             * @tparam NA       Number of coefficients for feedback filter
+             * @tparam NB       Number of coefficients for feedforward filter
+             * @tparam TCoeffs  Storage of the coefficients, SIIRCoefficients or its constant reference
+             */
+            template <class T, uint32_t NA, uint32_t NB, class TCoeffs = SIIRCoefficients<T,NA,NB>>
             class CIIRFilter:public IFilter<T>
             {
                 public:
                     /* Constructor */
                     CIIRFilter(const utils::linalg::CRowVector<T,NA>& f_A,const utils::linalg::CRowVector<T,NB>& f_B);
+                    /** @brief Constructor from the coefficients, they are copied or referred by the storage */
+                    constexpr CIIRFilter(const SIIRCoefficients<T,NA,NB>& f_coeffs)
+                        : m_coeffs(f_coeffs), m_Y(), m_U(), m_yIdx(0), m_uIdx(0) {}
                     /* Operator */
                     T operator()(T& f_u);
                 private:
                     CIIRFilter(){}
-                    /** @brief Polynomial coefficient for feedback filter  */
-                    utils::linalg::CRowVector<T,NA> m_A;
-                    /** @brief Polynomial coefficient for feedforward filter */
-                    utils::linalg::CRowVector<T,NB> m_B;
-                    /** @brief Memory for feedback filter  */
-                    utils::linalg::CColVector<T,NA> m_Y;
-                    /** @brief Memory for feedback filter  */
-                    utils::linalg::CColVector<T,NB> m_U;
+                    /** @brief Polynomial coefficients of the filter */
+                    TCoeffs m_coeffs;
+                    /** @brief Mirrored memory of the outputs for feedback filter */
+                    std::array<T,2*NA> m_Y;
+                    /** @brief Mirrored memory of the inputs for feedforward filter */
+                    std::array<T,2*NB> m_U;
+                    /** @brief Index of the last output */
+                    uint32_t m_yIdx;
+                    /** @brief Index of the last input */
+                    uint32_t m_uIdx;
             }; // class CIIRFilter
 
+            /** @brief IIR filter with constant coefficients, it refers to a constexpr SIIRCoefficients object */
+            template <class T, uint32_t NA, uint32_t NB>
+            using CConstIIRFilter = CIIRFilter<T,NA,NB,const SIIRCoefficients<T,NA,NB>&>;
+
             /**
-             * @brief Finite impulse response (FIR) discrete-time filter.
+             * @brief Coefficients of the FIR filter, it's a literal type, so the coefficients of a constexpr object are placed in flash.
              * 
-             * @tparam T    The type of the input and output signal
+             * @tparam T    The type of the coefficients
              * @tparam NB   Number of coefficients for feedforward filter
              */
             template <class T, uint32_t NB>
+            struct SFIRCoefficients
+            {
+                /** @brief Constructor */
+                constexpr SFIRCoefficients(const utils::linalg::CRowVector<T,NB>& f_B) : m_B(f_B) {}
+                /** @brief Polynomial coefficient for feedforward filter */
+                utils::linalg::CRowVector<T,NB> m_B;
+            };
+
+            /**
+             * @brief Finite impulse response (FIR) discrete-time filter.
+             * 
+             * The previous inputs are stored in a mirrored circular buffer, each value is written at the index and at the index plus NB, 
+             * so the last NB values are contiguous from the index and the memory isn't shifted. The coefficients are stored like by 
+             * the IIR filter, CConstFIRFilter refers to a constexpr SFIRCoefficients object in flash.
+             * 
+             * @tparam T        The type of the input and output signal
+             * @tparam NB       Number of coefficients for feedforward filter
+             * @tparam TCoeffs  Storage of the coefficients, SFIRCoefficients or its constant reference
+             */
+            template <class T, uint32_t NB, class TCoeffs = SFIRCoefficients<T,NB>>
             class CFIRFilter:public IFilter<T>
             {
                 public:
                     /* Constructor */
                     CFIRFilter(const utils::linalg::CRowVector<T,NB>& f_B);
+                    /** @brief Constructor from the coefficients, they are copied or referred by the storage */
+                    constexpr CFIRFilter(const SFIRCoefficients<T,NB>& f_coeffs)
+                        : m_coeffs(f_coeffs), m_U(), m_idx(0) {}
                     /* Operator */
                     T operator()(T& f_u);
                 private:
                     CFIRFilter() {}
-                    /** @brief Polynomial coefficient for feedforward filter */
-                    utils::linalg::CRowVector<T,NB> m_B;
-                    /** @brief Memory for feedback filter  */
-                    utils::linalg::CColVector<T,NB> m_U;
+                    /** @brief Polynomial coefficients of the filter */
+                    TCoeffs m_coeffs;
+                    /** @brief Mirrored memory of the inputs */
+                    std::array<T,2*NB> m_U;
+                    /** @brief Index of the last input */
+                    uint32_t m_idx;
             }; // class CFIRFilter
 
+            /** @brief FIR filter with constant coefficients, it refers to a constexpr SFIRCoefficients object */
+            template <class T, uint32_t NB>
+            using CConstFIRFilter = CFIRFilter<T,NB,const SFIRCoefficients<T,NB>&>;
+
             /**
              * @brief Mean filter or average filter
              * 
+             * The previous inputs are stored in a circular buffer, only the oldest value is overwritten.
+             * 
              * @tparam T    The type of the input and output signal
              * @tparam NB   Number of memorized values for calculating mean value
              */
@@ -113,8 +190,126 @@ namespace signal::filter
                     virtual T operator()(T& f_u);
                 private:
                     T m_B;
-                    utils::linalg::CColVector<T,NB> m_U;
+                    /** @brief Circular memory of the inputs */
+                    std::array<T,NB> m_U;
+                    /** @brief Index of the oldest input */
+                    uint32_t m_idx;
             }; // class CMeanFilter
+
+            /**
+             * @brief Moving average filter with running sum, its cost per sample doesn't depend on the window length.
+             * 
+             * The sum is updated by the new and the oldest values of the circular buffer. To avoid the drift of the floating point 
+             * sum, a second sum collects the inputs of the current pass over the buffer and it replaces the running sum at the end 
+             * of each pass, so the error doesn't accumulate over more than NB samples. With integer type the sum is exact.
+             * 
+             * @tparam T    The type of the input and output signal
+             * @tparam NB   Length of the window
+             */
+            template <class T, uint32_t NB>
+            class CMovingAverageFilter:public IFilter<T>
+            {
+                public:
+                    /* Constructor */
+                    CMovingAverageFilter();
+                    /* Operator */
+                    T operator()(T& f_u);
+                    /* Filter a block of samples */
+                    virtual void process(const T* f_in, T* f_out, size_t f_n);
+                    /* Clear the memory */
+                    void clear();
+                private:
+                    /** @brief Circular memory of the inputs */
+                    std::array<T,NB> m_U;
+                    /** @brief Index of the oldest input */
+                    uint32_t m_idx;
+                    /** @brief Running sum of the window */
+                    T m_sum;
+                    /** @brief Sum of the inputs in the current pass over the buffer */
+                    T m_passSum;
+            }; // class CMovingAverageFilter
+
+            /**
+             * @brief Cascade of second order sections (biquads) in transposed direct form II, like the arm_biquad_cascade_df2T_f32 
+             * function of the CMSIS-DSP library.
+             * 
+             * Each section has two state variables, so the memory isn't shifted and no temporary matrix is created. The coefficients 
+             * of a section are given in a row of the matrix in the order b0, b1, b2, a1, a2, where the first denominator coefficient 
+             * is normalized to 1. The feedback coefficients are subtracted like in the CIIRFilter (y = b0*x + b1*x[-1] + b2*x[-2] - a1*y[-1] - a2*y[-2]).
+             * 
+             * @tparam T        The type of the input and output signal
+             * @tparam NStages  Number of the second order sections
+             */
+            template <class T, uint32_t NStages>
+            class CBiquadCascadeFilter:public IFilter<T>
+            {
+                public:
+                    /** @brief Type of the coefficients, a row for each section */
+                    using CCoeffType = utils::linalg::CMatrix<T,NStages,5>;
+                    /* Constructor */
+                    CBiquadCascadeFilter(const CCoeffType& f_coeffs);
+                    /* Operator */
+                    T operator()(T& f_u);
+                    /* Filter a block of samples */
+                    virtual void process(const T* f_in, T* f_out, size_t f_n);
+                    /* Change the coefficients, the state is kept */
+                    void setCoeffs(const CCoeffType& f_coeffs);
+                    /* Clear the state of the sections */
+                    void clear();
+                private:
+                    CBiquadCascadeFilter() {}
+                    /** @brief Coefficients of the sections */
+                    CCoeffType m_coeffs;
+                    /** @brief State variables of the sections */
+                    utils::linalg::CMatrix<T,NStages,2> m_state;
+            }; // class CBiquadCascadeFilter
+
+            /**
+             * @brief Tunable second order notch filter, the notch frequency can be changed in each period, for example by the rotation speed.
+             * 
+             * It's a biquad section with the coefficients of the Audio EQ Cookbook: zeros on the unit circle at the notch frequency and poles 
+             * at the same angle, the quality factor gives the ratio of the frequency and the -3 dB bandwidth. The state is kept, when the 
+             * frequency changes, so the retuning doesn't cause a jump. A frequency above the half of the sampling frequency is folded 
+             * to its alias, because the sampled ripple appears there. Below the minimal frequency the filter is bypassed, so it doesn't 
+             * remove the low frequency part of the signal, when the source of the disturbance stops.
+             * 
+             * @tparam T        The type of the input and output signal
+             */
+            template <class T>
+            class CNotchFilter:public IFilter<T>
+            {
+                public:
+                    /* Constructor */
+                    CNotchFilter(T f_samplingFrequency, T f_quality, T f_minFrequency);
+                    /* Set the notch frequency, it returns false, when the filter is bypassed */
+                    bool setFrequency(T f_frequency);
+                    /* Set the quality factor */
+                    void setQuality(T f_quality);
+                    /* Operator */
+                    T operator()(T& f_u);
+                    /* Clear the state */
+                    void clear();
+                    /** @brief The filter isn't bypassed */
+                    bool isActive() const
+                    {
+                        return m_isActive;
+                    }
+                private:
+                    /** @brief Type of the section */
+                    using CBiquadType = CBiquadCascadeFilter<T,1>;
+                    /** @brief Sampling frequency */
+                    const T m_samplingFrequency;
+                    /** @brief Minimal notch frequency */
+                    const T m_minFrequency;
+                    /** @brief Quality factor */
+                    T m_quality;
+                    /** @brief Folded notch frequency */
+                    T m_frequency;
+                    /** @brief The filter isn't bypassed */
+                    bool m_isActive;
+                    /** @brief Second order section */
+                    CBiquadType m_biquad;
+            }; // class CNotchFilter
         }; // namespace siso
     }; // namespace linear
 
@@ -156,6 +351,291 @@ namespace signal::filter
 
                 my_structure m_queue[N];
             }; // class CMedianFilter
+
+            /**
+             * @brief  Comparator pairs of the sorting networks for small windows
+             * 
+             * @tparam N        size of the window
+             */
+            template <uint32_t N>
+            struct SSortingNetwork;
+
+            /**
+             * @brief  Percentile filter - It results the value with the given rank in the sorted window of the last N inputs.
+             * 
+             * The window is stored in two indexed heaps around the selected value: a max-heap with the smaller values and a 
+             * min-heap with the greater values. The new input replaces the oldest one in its heap position and it's moved up or 
+             * down, so the update costs O(log N) and the percentile is read in O(1). The median is the 0.5 percentile. 
+             * For windows with at most five values the partial specialization sorts a copy of the window by a sorting network.
+             * 
+             * @tparam T        type of the values
+             * @tparam N        size of the window
+             * @tparam NSmall   selection of the sorting network implementation
+             */
+            template <class T, uint32_t N, bool NSmall = (N <= 5)>
+            class CPercentileFilter:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CPercentileFilter(float f_percentile = 0.5f);
+                /* Operator */
+                T operator()(T& f_u);
+                /** @brief Value with the selected rank in the window */
+                T get() const
+                {
+                    return m_data[m_heap[m_rank]];
+                }
+            private:
+                /* Compare two heap positions */
+                bool less(int32_t f_i, int32_t f_j) const;
+                /* Exchange two heap positions, if the first value is smaller */
+                bool compareExchange(int32_t f_i, int32_t f_j);
+                /* Restore the min-heap below the position */
+                void minSortDown(int32_t f_i);
+                /* Restore the max-heap below the position */
+                void maxSortDown(int32_t f_i);
+                /* Restore the min-heap above the position */
+                bool minSortUp(int32_t f_i);
+                /* Restore the max-heap above the position */
+                bool maxSortUp(int32_t f_i);
+
+                /** @brief Circular memory of the inputs */
+                std::array<T,N> m_data;
+                /** @brief Heap of the input indexes, the position p is stored at p+m_rank, the selected value is at zero */
+                std::array<uint32_t,N> m_heap;
+                /** @brief Heap position of each input */
+                std::array<int32_t,N> m_pos;
+                /** @brief Index of the oldest input */
+                uint32_t m_idx;
+                /** @brief Rank of the selected value, it's the number of the values in the max-heap */
+                int32_t m_rank;
+                /** @brief Number of the values in the min-heap */
+                int32_t m_minCount;
+            }; // class CPercentileFilter
+
+            /**
+             * @brief  Percentile filter for small windows, it sorts a copy of the window by the sorting network of the size.
+             * 
+             * @tparam T        type of the values
+             * @tparam N        size of the window
+             */
+            template <class T, uint32_t N>
+            class CPercentileFilter<T,N,true>:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CPercentileFilter(float f_percentile = 0.5f);
+                /* Operator */
+                T operator()(T& f_u);
+                /** @brief Value with the selected rank in the window */
+                T get() const
+                {
+                    return m_value;
+                }
+            private:
+                /** @brief Circular memory of the inputs */
+                std::array<T,N> m_data;
+                /** @brief Index of the oldest input */
+                uint32_t m_idx;
+                /** @brief Rank of the selected value */
+                uint32_t m_rank;
+                /** @brief Last selected value */
+                T m_value;
+            }; // class CPercentileFilter
+
+            /**
+             * @brief  Adaptive FIR filter updated by the normalized least mean squares (NLMS) algorithm, it's applied as a noise canceller.
+             * 
+             * The filter estimates the part of the primary signal, which is correlated with the reference inputs, and it returns the 
+             * error, the primary signal without the estimated part. The references can be the delayed samples of a noise signal or, 
+             * for a periodic disturbance, the cosine and sine of its phase; in the second case a pair of weights is an adaptive notch 
+             * locked to the phase. The step size is normalized by the power of the references, it has to be in interval (0,2), 
+             * a smaller step gives narrower notch and slower convergence.
+             * 
+             * @tparam T        type of the values
+             * @tparam NTaps    number of the weights
+             */
+            template <class T, uint32_t NTaps>
+            class CLmsFilter
+            {
+            public:
+                /** @brief Type of the reference inputs */
+                using CRegressorType = std::array<T,NTaps>;
+                /* Constructor */
+                CLmsFilter(T f_stepSize, T f_regularization);
+                /* Cancel the correlated part of the primary input by the references */
+                T operator()(const T& f_primary, const CRegressorType& f_reference);
+                /* Cancel the correlated part of the primary input by the delayed samples of the reference signal */
+                T operator()(const T& f_primary, const T& f_reference);
+                /* Estimate without update */
+                T estimate(const CRegressorType& f_reference) const;
+                /* Set the step size */
+                void setStepSize(T f_stepSize);
+                /* Clear the weights and the delay line */
+                void clear();
+                /** @brief Adapted weights */
+                const CRegressorType& getWeights() const
+                {
+                    return m_weights;
+                }
+            private:
+                /** @brief Normalized step size */
+                T m_stepSize;
+                /** @brief Regularization of the normalization, it limits the step at small references */
+                const T m_regularization;
+                /** @brief Weights */
+                CRegressorType m_weights;
+                /** @brief Delay line of the reference signal, the newest sample is the first */
+                CRegressorType m_delayLine;
+            }; // class CLmsFilter
+
+            /**
+             * @brief  Slew rate limiter - The output follows the input by at most the given step per sample.
+             * 
+             * The first input is passed without limit. The block method keeps the last output in a register.
+             * 
+             * @tparam T        type of the values
+             */
+            template <class T>
+            class CSlewRateFilter:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CSlewRateFilter(T f_maxStep);
+                /* Operator */
+                T operator()(T& f_u);
+                /* Filter a block of samples */
+                void process(const T* f_in, T* f_out, size_t f_n);
+                /* Restart from the next input */
+                void reset();
+            private:
+                /** @brief Maximum change of the output per sample */
+                const T m_maxStep;
+                /** @brief Last output */
+                T m_y;
+                /** @brief The first input was applied */
+                bool m_started;
+            }; // class CSlewRateFilter
+
+            /**
+             * @brief  Hysteresis (Schmitt) comparator - The output is one above the upper threshold, zero below the lower threshold 
+             * and it's kept between them.
+             * 
+             * @tparam T        type of the values
+             */
+            template <class T>
+            class CHysteresisFilter:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CHysteresisFilter(T f_low, T f_high, bool f_initial = false);
+                /* Operator */
+                T operator()(T& f_u);
+                /* Filter a block of samples */
+                void process(const T* f_in, T* f_out, size_t f_n);
+                /** @brief State of the comparator */
+                bool get() const
+                {
+                    return m_state;
+                }
+            private:
+                /** @brief Lower threshold */
+                const T m_low;
+                /** @brief Upper threshold */
+                const T m_high;
+                /** @brief State of the comparator */
+                bool m_state;
+            }; // class CHysteresisFilter
+
+            /**
+             * @brief  Deadzone - The inputs in the symmetric band around zero give zero, outside of the band the width is subtracted, 
+             * so the output is continuous.
+             * 
+             * @tparam T        type of the values
+             */
+            template <class T>
+            class CDeadzoneFilter:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CDeadzoneFilter(T f_width);
+                /* Operator */
+                T operator()(T& f_u);
+                /* Filter a block of samples */
+                void process(const T* f_in, T* f_out, size_t f_n);
+            private:
+                /** @brief Half width of the band */
+                const T m_width;
+            }; // class CDeadzoneFilter
+
+            /**
+             * @brief  Rate of change - The backward difference of the inputs divided by the sampling period.
+             * 
+             * The first input gives zero rate.
+             * 
+             * @tparam T        type of the values
+             */
+            template <class T>
+            class CRateFilter:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CRateFilter(T f_period);
+                /* Operator */
+                T operator()(T& f_u);
+                /* Filter a block of samples */
+                void process(const T* f_in, T* f_out, size_t f_n);
+                /* Restart from the next input */
+                void reset();
+            private:
+                /** @brief Inverse of the sampling period */
+                const T m_invPeriod;
+                /** @brief Last input */
+                T m_u;
+                /** @brief The first input was applied */
+                bool m_started;
+            }; // class CRateFilter
+
+            /**
+             * @brief  Hampel outlier gate - The input is replaced by the median of the window, when it deviates from the median more 
+             * than the given number of scaled median absolute deviations.
+             * 
+             * The median and the deviation are order statistics of the CPercentileFilter, so an update costs O(log N). The median absolute 
+             * deviation is the running median of the deviations of the inputs from the median at their arrival, it's the streaming 
+             * approximation of the deviation from the actual median. It's scaled by 1.4826, so it estimates the standard deviation 
+             * for normal noise. The gate is causal, the input is compared with the median of the window ending with it and only the 
+             * outliers are changed, so the signal isn't delayed. The inputs are forwarded, until both windows are filled.
+             * 
+             * @tparam T        type of the values
+             * @tparam N        size of the window
+             */
+            template <class T, uint32_t N>
+            class CHampelFilter:public IFilter<T>
+            {
+            public:
+                /* Constructor */
+                CHampelFilter(T f_threshold = 3, T f_minDeviation = 0);
+                /* Operator */
+                T operator()(T& f_u);
+                /** @brief Number of the replaced inputs */
+                uint32_t getOutliers() const
+                {
+                    return m_outliers;
+                }
+            private:
+                /** @brief Median of the inputs */
+                CPercentileFilter<T,N> m_median;
+                /** @brief Median of the absolute deviations */
+                CPercentileFilter<T,N> m_deviation;
+                /** @brief Threshold in scaled absolute deviations */
+                const T m_threshold;
+                /** @brief Lower limit of the scaled deviation, so the constant inputs don't mark the noise as outlier */
+                const T m_minDeviation;
+                /** @brief Number of the replaced inputs */
+                uint32_t m_outliers;
+                /** @brief Number of the inputs in the windows, saturated at 2N */
+                uint32_t m_filled;
+            }; // class CHampelFilter
         }; // namespace siso
     }; // namespace nonlinear 
 }; // namespace singal::filter
@@ -30,6 +30,8 @@ limitations under the License.
 #error __FILE__ should only be included from filter.hpp.
 #endif // FILTER_HPP
 
+#include <cmath>
+
 template <class T, uint32_t NC>
 using CMeasurementType = utils::linalg::CColVector<T,NC>;
 
@@ -40,12 +42,13 @@ using CMeasurementType = utils::linalg::CColVector<T,NC>;
  *  @param f_A   the feedback filter coefficients 
  *  @param f_B   the feedforward filter coefficients
  */
-template <class T, uint32_t NA, uint32_t NB>
-signal::filter::lti::siso::CIIRFilter<T,NA,NB>::CIIRFilter(const utils::linalg::CRowVector<T,NA>& f_A,const utils::linalg::CRowVector<T,NB>& f_B) 
-    : m_A(f_A)
-    , m_B(f_B)
+template <class T, uint32_t NA, uint32_t NB, class TCoeffs>
+signal::filter::lti::siso::CIIRFilter<T,NA,NB,TCoeffs>::CIIRFilter(const utils::linalg::CRowVector<T,NA>& f_A,const utils::linalg::CRowVector<T,NB>& f_B) 
+    : m_coeffs(f_A, f_B)
     , m_Y()
     , m_U() 
+    , m_yIdx(0)
+    , m_uIdx(0)
 {
 }
 
@@ -54,25 +57,23 @@ signal::filter::lti::siso::CIIRFilter<T,NA,NB>::CIIRFilter(const utils::linalg::
   * @param f_u                 the input data
   * @return                    the filtered output data
   */
-template <class T, uint32_t NA, uint32_t NB>
-T signal::filter::lti::siso::CIIRFilter<T,NA,NB>::operator()(T& f_u)
+template <class T, uint32_t NA, uint32_t NB, class TCoeffs>
+T signal::filter::lti::siso::CIIRFilter<T,NA,NB,TCoeffs>::operator()(T& f_u)
 {
-    for (uint32_t l_idx = NB-1; l_idx > 0; --l_idx)
-    {
-        m_U[l_idx] = m_U[l_idx-1];
-    }
-    m_U[0][0] = f_u;
+    // The new input is placed before the previous values
+    m_uIdx = (m_uIdx == 0) ? (NB - 1) : (m_uIdx - 1);
+    m_U[m_uIdx] = f_u;
+    m_U[m_uIdx + NB] = f_u;
 
-    utils::linalg::CMatrix<T,1,1> l_y = m_B*m_U - m_A*m_Y;
-    // T l_y = m_B*m_U - m_A*m_Y;
+    const utils::linalg::CMatrixView<const T,NB,1> l_inputs(&m_U[m_uIdx], 1);
+    const utils::linalg::CMatrixView<const T,NA,1> l_outputs(&m_Y[m_yIdx], 1);
+    T l_y = utils::linalg::dot(m_coeffs.m_B.view(),l_inputs) - utils::linalg::dot(m_coeffs.m_A.view(),l_outputs);
 
-    for (uint32_t l_idx = NA-1; l_idx > 0 ; --l_idx)
-    {
-        m_Y[l_idx] = m_Y[l_idx-1];
-    }
-    m_Y[0][0] = l_y[0][0];
+    m_yIdx = (m_yIdx == 0) ? (NA - 1) : (m_yIdx - 1);
+    m_Y[m_yIdx] = l_y;
+    m_Y[m_yIdx + NA] = l_y;
 
-    return m_Y[0][0];
+    return l_y;
 }
 
 /******************************************************************************/
@@ -81,9 +82,9 @@ T signal::filter::lti::siso::CIIRFilter<T,NA,NB>::operator()(T& f_u)
  *
  *  @param f_B   the feedforward filter coefficients
  */
-template <class T, uint32_t NB>
-signal::filter::lti::siso::CFIRFilter<T,NB>::CFIRFilter(const utils::linalg::CRowVector<T,NB>& f_B) 
-    : m_B(f_B), m_U() 
+template <class T, uint32_t NB, class TCoeffs>
+signal::filter::lti::siso::CFIRFilter<T,NB,TCoeffs>::CFIRFilter(const utils::linalg::CRowVector<T,NB>& f_B) 
+    : m_coeffs(f_B), m_U(), m_idx(0) 
 {
 }
 
@@ -92,18 +93,20 @@ signal::filter::lti::siso::CFIRFilter<T,NB>::CFIRFilter(const utils::linalg::CRo
   * @param f_u                 the input data
   * @return                    the filtered output data
   */
-template <class T, uint32_t NB>
-T signal::filter::lti::siso::CFIRFilter<T,NB>::operator()(T& f_u)
+template <class T, uint32_t NB, class TCoeffs>
+T signal::filter::lti::siso::CFIRFilter<T,NB,TCoeffs>::operator()(T& f_u)
 {
-    for (uint32_t l_idx = NB-1; l_idx > 0; --l_idx)
+    // The new input is placed before the previous values
+    m_idx = (m_idx == 0) ? (NB - 1) : (m_idx - 1);
+    m_U[m_idx] = f_u;
+    m_U[m_idx + NB] = f_u;
+
+    T l_y = 0;
+    for (uint32_t l_idx = 0; l_idx < NB; ++l_idx)
     {
-        m_U[l_idx] = m_U[l_idx-1];
+        l_y += m_coeffs.m_B[0][l_idx] * m_U[m_idx + l_idx];
     }
-    m_U[0] = f_u;
-
-    utils::linalg::CMatrix<T,1,1> l_y = m_B*m_U;
-
-    return l_y[0][0];
+    return l_y;
 }
 
 /******************************************************************************/
@@ -114,7 +117,8 @@ T signal::filter::lti::siso::CFIRFilter<T,NB>::operator()(T& f_u)
 template <class T, uint32_t NB> 
 signal::filter::lti::siso::CMeanFilter<T,NB>::CMeanFilter() 
     : m_B(1./NB)
-    , m_U() 
+    , m_U()
+    , m_idx(0) 
 {
 }
 
@@ -126,20 +130,265 @@ signal::filter::lti::siso::CMeanFilter<T,NB>::CMeanFilter()
 template <class T, uint32_t NB> 
 T signal::filter::lti::siso::CMeanFilter<T,NB>::operator()(T& f_u)
 {
+    m_U[m_idx] = f_u;
+    m_idx = (m_idx + 1 == NB) ? 0 : (m_idx + 1);
+
     T l_y =0;
+    for (uint32_t l_idx = 0; l_idx < NB; ++l_idx)
+    {
+        l_y += m_U[l_idx];
+    }
+    return m_B*l_y;
+}
+
 
-    for (uint32_t l_idx = 1; l_idx < NB; ++l_idx)
+
+/******************************************************************************/
+/** @brief  CMovingAverageFilter Class constructor
+ *
+ *  
+ */
+template <class T, uint32_t NB> 
+signal::filter::lti::siso::CMovingAverageFilter<T,NB>::CMovingAverageFilter() 
+    : m_U()
+    , m_idx(0)
+    , m_sum(0)
+    , m_passSum(0)
+{
+}
+
+/** @brief  Operator to apply the filtering
+  *
+  * @param f_u                 the input data
+  * @return                    the mean value of the last NB inputs
+  */
+template <class T, uint32_t NB> 
+CONTROL_RAMFUNC T signal::filter::lti::siso::CMovingAverageFilter<T,NB>::operator()(T& f_u)
+{
+    m_sum += f_u - m_U[m_idx];
+    m_passSum += f_u;
+    m_U[m_idx] = f_u;
+    if (++m_idx == NB)
     {
-        m_U[l_idx][0] = m_U[l_idx-1][0];
-        l_y += m_U[l_idx][0];
+        // The buffer was overwritten completely, the pass sum contains the exact sum of the window
+        m_idx = 0;
+        m_sum = m_passSum;
+        m_passSum = 0;
     }
-    m_U[0][0] = f_u;
-    l_y += m_U[0][0];
+    return m_sum / static_cast<T>(NB);
+}
 
-    return m_B*l_y;
+/** @brief  Filter a block of samples, the running sums and the index are kept in local variables during the block.
+  *
+  * @param f_in                input samples
+  * @param f_out               mean values, it can be the same buffer as the input
+  * @param f_n                 number of the samples
+  */
+template <class T, uint32_t NB> 
+CONTROL_RAMFUNC void signal::filter::lti::siso::CMovingAverageFilter<T,NB>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    T l_sum = m_sum;
+    T l_passSum = m_passSum;
+    uint32_t l_idx = m_idx;
+    for (size_t i = 0; i < f_n; ++i)
+    {
+        T l_u = f_in[i];
+        l_sum += l_u - m_U[l_idx];
+        l_passSum += l_u;
+        m_U[l_idx] = l_u;
+        if (++l_idx == NB)
+        {
+            l_idx = 0;
+            l_sum = l_passSum;
+            l_passSum = 0;
+        }
+        f_out[i] = l_sum / static_cast<T>(NB);
+    }
+    m_sum = l_sum;
+    m_passSum = l_passSum;
+    m_idx = l_idx;
+}
+
+/** @brief  Clear the memory of the filter
+  */
+template <class T, uint32_t NB> 
+void signal::filter::lti::siso::CMovingAverageFilter<T,NB>::clear()
+{
+    m_U.fill(T(0));
+    m_idx = 0;
+    m_sum = 0;
+    m_passSum = 0;
+}
+
+/******************************************************************************/
+/** @brief  CBiquadCascadeFilter Class constructor
+ *
+ *  @param f_coeffs   the coefficients of the sections (b0, b1, b2, a1, a2 in each row)
+ */
+template <class T, uint32_t NStages>
+signal::filter::lti::siso::CBiquadCascadeFilter<T,NStages>::CBiquadCascadeFilter(const CCoeffType& f_coeffs)
+    : m_coeffs(f_coeffs)
+    , m_state(utils::linalg::CMatrix<T,NStages,2>::zeros())
+{
+}
+
+/** @brief  Operator to apply the filtering, the output of each section is the input of the next one.
+  *
+  * @param f_u                 the input data
+  * @return                    the filtered output data
+  */
+template <class T, uint32_t NStages>
+T signal::filter::lti::siso::CBiquadCascadeFilter<T,NStages>::operator()(T& f_u)
+{
+    T l_x = f_u;
+    for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+    {
+        const std::array<T,5>& l_c = m_coeffs[l_stage];
+        std::array<T,2>& l_d = m_state[l_stage];
+        T l_y = l_c[0] * l_x + l_d[0];
+        l_d[0] = l_c[1] * l_x - l_c[3] * l_y + l_d[1];
+        l_d[1] = l_c[2] * l_x - l_c[4] * l_y;
+        l_x = l_y;
+    }
+    return l_x;
+}
+
+/** @brief  Filter a block of samples section by section, the state variables of a section are kept in registers during the block.
+  *
+  * @param f_in                input samples
+  * @param f_out               filtered samples, it can be the same buffer as the input
+  * @param f_n                 number of the samples
+  */
+template <class T, uint32_t NStages>
+void signal::filter::lti::siso::CBiquadCascadeFilter<T,NStages>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    const T* l_in = f_in;
+    for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+    {
+        const std::array<T,5>& l_c = m_coeffs[l_stage];
+        const T l_b0 = l_c[0], l_b1 = l_c[1], l_b2 = l_c[2], l_a1 = l_c[3], l_a2 = l_c[4];
+        T l_d0 = m_state[l_stage][0];
+        T l_d1 = m_state[l_stage][1];
+        for (size_t i = 0; i < f_n; ++i)
+        {
+            T l_x = l_in[i];
+            T l_y = l_b0 * l_x + l_d0;
+            l_d0 = l_b1 * l_x - l_a1 * l_y + l_d1;
+            l_d1 = l_b2 * l_x - l_a2 * l_y;
+            f_out[i] = l_y;
+        }
+        m_state[l_stage][0] = l_d0;
+        m_state[l_stage][1] = l_d1;
+        l_in = f_out;          // The next section filters the output of this one in place
+    }
+    if (NStages == 0 && f_in != f_out)
+    {
+        for (size_t i = 0; i < f_n; ++i)
+        {
+            f_out[i] = f_in[i];
+        }
+    }
+}
+
+/** @brief  Change the coefficients of the sections, the state variables are kept, so the output doesn't jump.
+  *
+  * @param f_coeffs            the coefficients of the sections (b0, b1, b2, a1, a2 in each row)
+  */
+template <class T, uint32_t NStages>
+void signal::filter::lti::siso::CBiquadCascadeFilter<T,NStages>::setCoeffs(const CCoeffType& f_coeffs)
+{
+    m_coeffs = f_coeffs;
+}
+
+/** @brief  Clear the state of the sections
+  */
+template <class T, uint32_t NStages>
+void signal::filter::lti::siso::CBiquadCascadeFilter<T,NStages>::clear()
+{
+    m_state = utils::linalg::CMatrix<T,NStages,2>::zeros();
+}
+
+/******************************************************************************/
+/** @brief  CNotchFilter Class constructor, initially the filter is bypassed.
+ *
+ *  @param f_samplingFrequency  sampling frequency in Hz
+ *  @param f_quality            quality factor, ratio of the notch frequency and the bandwidth
+ *  @param f_minFrequency       below this folded frequency the filter is bypassed
+ */
+template <class T>
+signal::filter::lti::siso::CNotchFilter<T>::CNotchFilter(T f_samplingFrequency, T f_quality, T f_minFrequency)
+    : m_samplingFrequency(f_samplingFrequency)
+    , m_minFrequency(f_minFrequency)
+    , m_quality(f_quality)
+    , m_frequency(0)
+    , m_isActive(false)
+    , m_biquad(typename CBiquadType::CCoeffType({1, 0, 0, 0, 0}))
+{
+}
+
+/** @brief  Set the notch frequency, the coefficients are calculated only, when the frequency changed.
+ *
+ *  @param f_frequency          notch frequency in Hz, it's folded into the interval [0, fs/2]
+ *  @return                     false, when the filter is bypassed
+ */
+template <class T>
+bool signal::filter::lti::siso::CNotchFilter<T>::setFrequency(T f_frequency)
+{
+    T l_frequency = std::fmod(std::fabs(f_frequency), m_samplingFrequency);
+    if (l_frequency > m_samplingFrequency / 2)
+    {
+        l_frequency = m_samplingFrequency - l_frequency;
+    }
+    bool l_isActive = l_frequency >= m_minFrequency;
+    if (l_frequency == m_frequency && l_isActive == m_isActive)
+    {
+        return m_isActive;
+    }
+    m_frequency = l_frequency;
+    m_isActive = l_isActive;
+    if (!m_isActive)
+    {
+        m_biquad.setCoeffs(typename CBiquadType::CCoeffType({1, 0, 0, 0, 0}));
+        return false;
+    }
+    T l_w0 = 2 * static_cast<T>(M_PI) * m_frequency / m_samplingFrequency;
+    T l_alpha = std::sin(l_w0) / (2 * m_quality);
+    T l_a0 = 1 + l_alpha;
+    T l_b0 = 1 / l_a0;
+    T l_b1 = -2 * std::cos(l_w0) / l_a0;
+    m_biquad.setCoeffs(typename CBiquadType::CCoeffType({l_b0, l_b1, l_b0, l_b1, (1 - l_alpha) / l_a0}));
+    return true;
 }
 
+/** @brief  Set the quality factor, it's applied by the next change of the frequency.
+ *
+ *  @param f_quality            quality factor
+ */
+template <class T>
+void signal::filter::lti::siso::CNotchFilter<T>::setQuality(T f_quality)
+{
+    m_quality = f_quality;
+    m_frequency = -1;
+}
 
+/** @brief  Operator to apply the filtering
+  *
+  * @param f_u                 the input data
+  * @return                    the filtered output data
+  */
+template <class T>
+T signal::filter::lti::siso::CNotchFilter<T>::operator()(T& f_u)
+{
+    return m_biquad(f_u);
+}
+
+/** @brief  Clear the state of the section
+  */
+template <class T>
+void signal::filter::lti::siso::CNotchFilter<T>::clear()
+{
+    m_biquad.clear();
+}
 
 /******************************************************************************/
 /** @brief  CMedianFilter Class constructor
@@ -224,7 +473,7 @@ T signal::filter::nlti::siso::CMedianFilter<T,N>::operator()(T& f_val)
 
     //varianta ineficienta pentru aflarea medianului  cand filtrul are dimensiuni mari
     m_median=m_smallest;
-    for(uint8_t iddx=0; iddx < m_size/2; ++iddx)
+    for(uint32_t iddx=0; iddx < m_size/2; ++iddx)
     {
         m_median=m_median->next;
     }
@@ -253,4 +502,591 @@ T signal::filter::nlti::siso::CMedianFilter<T, N>::getMedian()
     return ret_val;
 }
 
-#endif
\ No newline at end of file
+/******************************************************************************/
+/** @brief  Comparator pairs of the optimal sorting networks */
+template <>
+struct signal::filter::nlti::siso::SSortingNetwork<1>
+{
+    static constexpr uint32_t s_size = 0;
+    static constexpr uint8_t s_pairs[1][2] = {{0,0}};
+};
+template <>
+struct signal::filter::nlti::siso::SSortingNetwork<2>
+{
+    static constexpr uint32_t s_size = 1;
+    static constexpr uint8_t s_pairs[1][2] = {{0,1}};
+};
+template <>
+struct signal::filter::nlti::siso::SSortingNetwork<3>
+{
+    static constexpr uint32_t s_size = 3;
+    static constexpr uint8_t s_pairs[3][2] = {{0,2},{0,1},{1,2}};
+};
+template <>
+struct signal::filter::nlti::siso::SSortingNetwork<4>
+{
+    static constexpr uint32_t s_size = 5;
+    static constexpr uint8_t s_pairs[5][2] = {{0,1},{2,3},{0,2},{1,3},{1,2}};
+};
+template <>
+struct signal::filter::nlti::siso::SSortingNetwork<5>
+{
+    static constexpr uint32_t s_size = 9;
+    static constexpr uint8_t s_pairs[9][2] = {{0,1},{3,4},{2,4},{2,3},{0,3},{0,2},{1,4},{1,3},{1,2}};
+};
+
+/** @brief  CPercentileFilter class constructor
+ *
+ *  The window is initialized with zero values.
+ *
+ *  @param f_percentile      percentile of the result in interval [0,1]
+ */
+template <class T, uint32_t N, bool NSmall>
+signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::CPercentileFilter(float f_percentile)
+    : m_data()
+    , m_heap()
+    , m_pos()
+    , m_idx(0)
+    , m_rank(0)
+    , m_minCount(0)
+{
+    f_percentile = (f_percentile < 0.0f) ? 0.0f : ((f_percentile > 1.0f) ? 1.0f : f_percentile);
+    m_rank = static_cast<int32_t>(f_percentile * (N - 1) + 0.5f);
+    m_minCount = N - 1 - m_rank;
+    // All values are equal, so any order satisfies the heaps: the first input at zero, then the max-heap and the min-heap
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        int32_t l_pos = (static_cast<int32_t>(l_idx) <= m_rank) ? -static_cast<int32_t>(l_idx) : static_cast<int32_t>(l_idx) - m_rank;
+        m_pos[l_idx] = l_pos;
+        m_heap[l_pos + m_rank] = l_idx;
+    }
+}
+
+/** @brief  Filtering the values
+ *
+ *  @param f_u               the input data
+ *  @return                  the value with the selected rank in the window
+ */
+template <class T, uint32_t N, bool NSmall>
+T signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::operator()(T& f_u)
+{
+    int32_t l_pos = m_pos[m_idx];
+    T l_old = m_data[m_idx];
+    m_data[m_idx] = f_u;
+    m_idx = (m_idx + 1 == N) ? 0 : (m_idx + 1);
+
+    if (l_pos > 0)          // The new value is in the min-heap
+    {
+        if (l_old < f_u)
+        {
+            minSortDown(l_pos * 2);
+        }
+        else if (minSortUp(l_pos))
+        {
+            maxSortDown(-1);
+        }
+    }
+    else if (l_pos < 0)     // The new value is in the max-heap
+    {
+        if (f_u < l_old)
+        {
+            maxSortDown(l_pos * 2);
+        }
+        else if (maxSortUp(l_pos))
+        {
+            minSortDown(1);
+        }
+    }
+    else                    // The new value is the selected one
+    {
+        if (m_rank > 0 && maxSortUp(-1))
+        {
+            maxSortDown(-2);
+        }
+        if (m_minCount > 0 && minSortUp(1))
+        {
+            minSortDown(2);
+        }
+    }
+    return get();
+}
+
+/** @brief  It returns true, when the value at the first position is smaller
+ */
+template <class T, uint32_t N, bool NSmall>
+bool signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::less(int32_t f_i, int32_t f_j) const
+{
+    return m_data[m_heap[f_i + m_rank]] < m_data[m_heap[f_j + m_rank]];
+}
+
+/** @brief  It exchanges the two positions, when the value at the first position is smaller, and it returns true after the exchange
+ */
+template <class T, uint32_t N, bool NSmall>
+bool signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::compareExchange(int32_t f_i, int32_t f_j)
+{
+    if (!less(f_i, f_j))
+    {
+        return false;
+    }
+    uint32_t l_tmp = m_heap[f_i + m_rank];
+    m_heap[f_i + m_rank] = m_heap[f_j + m_rank];
+    m_heap[f_j + m_rank] = l_tmp;
+    m_pos[m_heap[f_i + m_rank]] = f_i;
+    m_pos[m_heap[f_j + m_rank]] = f_j;
+    return true;
+}
+
+/** @brief  It restores the min-heap from the child position downward, the parent of the position p is p/2, 
+ *  so the value at the position p is moved down by applying the method for 2p
+ */
+template <class T, uint32_t N, bool NSmall>
+void signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::minSortDown(int32_t f_i)
+{
+    for (; f_i <= m_minCount; f_i *= 2)
+    {
+        if (f_i > 1 && f_i < m_minCount && less(f_i + 1, f_i))
+        {
+            ++f_i;
+        }
+        if (!compareExchange(f_i, f_i / 2))
+        {
+            break;
+        }
+    }
+}
+
+/** @brief  It restores the max-heap from the child position downward, the parent of the position p is p/2, 
+ *  so the value at the position p is moved down by applying the method for 2p
+ */
+template <class T, uint32_t N, bool NSmall>
+void signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::maxSortDown(int32_t f_i)
+{
+    for (; f_i >= -m_rank; f_i *= 2)
+    {
+        if (f_i < -1 && f_i > -m_rank && less(f_i, f_i - 1))
+        {
+            --f_i;
+        }
+        if (!compareExchange(f_i / 2, f_i))
+        {
+            break;
+        }
+    }
+}
+
+/** @brief  It restores the min-heap from the position upward, it returns true, when the value reached the selected position
+ */
+template <class T, uint32_t N, bool NSmall>
+bool signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::minSortUp(int32_t f_i)
+{
+    while (f_i > 0 && compareExchange(f_i, f_i / 2))
+    {
+        f_i /= 2;
+    }
+    return f_i == 0;
+}
+
+/** @brief  It restores the max-heap from the position upward, it returns true, when the value reached the selected position
+ */
+template <class T, uint32_t N, bool NSmall>
+bool signal::filter::nlti::siso::CPercentileFilter<T,N,NSmall>::maxSortUp(int32_t f_i)
+{
+    while (f_i < 0 && compareExchange(f_i / 2, f_i))
+    {
+        f_i /= 2;
+    }
+    return f_i == 0;
+}
+
+/** @brief  CPercentileFilter class constructor for small windows
+ *
+ *  @param f_percentile      percentile of the result in interval [0,1]
+ */
+template <class T, uint32_t N>
+signal::filter::nlti::siso::CPercentileFilter<T,N,true>::CPercentileFilter(float f_percentile)
+    : m_data()
+    , m_idx(0)
+    , m_rank(0)
+    , m_value()
+{
+    f_percentile = (f_percentile < 0.0f) ? 0.0f : ((f_percentile > 1.0f) ? 1.0f : f_percentile);
+    m_rank = static_cast<uint32_t>(f_percentile * (N - 1) + 0.5f);
+}
+
+/** @brief  Filtering the values by sorting a copy of the window
+ *
+ *  @param f_u               the input data
+ *  @return                  the value with the selected rank in the window
+ */
+template <class T, uint32_t N>
+T signal::filter::nlti::siso::CPercentileFilter<T,N,true>::operator()(T& f_u)
+{
+    using CNetwork = SSortingNetwork<N>;
+    m_data[m_idx] = f_u;
+    m_idx = (m_idx + 1 == N) ? 0 : (m_idx + 1);
+    std::array<T,N> l_sorted = m_data;
+    for (uint32_t l_idx = 0; l_idx < CNetwork::s_size; ++l_idx)
+    {
+        T& l_a = l_sorted[CNetwork::s_pairs[l_idx][0]];
+        T& l_b = l_sorted[CNetwork::s_pairs[l_idx][1]];
+        if (l_b < l_a)
+        {
+            T l_tmp = l_a;
+            l_a = l_b;
+            l_b = l_tmp;
+        }
+    }
+    m_value = l_sorted[m_rank];
+    return m_value;
+}
+
+/******************************************************************************/
+/** @brief  CLmsFilter class constructor
+ *
+ *  @param f_stepSize        normalized step size in interval (0,2)
+ *  @param f_regularization  it's added to the power of the references
+ */
+template <class T, uint32_t NTaps>
+signal::filter::nlti::siso::CLmsFilter<T,NTaps>::CLmsFilter(T f_stepSize, T f_regularization)
+    : m_stepSize(f_stepSize)
+    , m_regularization(f_regularization)
+    , m_weights()
+    , m_delayLine()
+{
+}
+
+/** @brief  Estimate the correlated part of the primary input, subtract it and update the weights by the error.
+ *
+ *  @param f_primary         the primary input
+ *  @param f_reference       the reference inputs
+ *  @return                  the error, the primary input without the estimated part
+ */
+template <class T, uint32_t NTaps>
+T signal::filter::nlti::siso::CLmsFilter<T,NTaps>::operator()(const T& f_primary, const CRegressorType& f_reference)
+{
+    T l_estimate = 0;
+    T l_power = m_regularization;
+    for (uint32_t l_idx = 0; l_idx < NTaps; ++l_idx)
+    {
+        l_estimate += m_weights[l_idx] * f_reference[l_idx];
+        l_power += f_reference[l_idx] * f_reference[l_idx];
+    }
+    T l_error = f_primary - l_estimate;
+    T l_gain = m_stepSize * l_error / l_power;
+    for (uint32_t l_idx = 0; l_idx < NTaps; ++l_idx)
+    {
+        m_weights[l_idx] += l_gain * f_reference[l_idx];
+    }
+    return l_error;
+}
+
+/** @brief  Store the reference sample in the delay line and apply the delayed samples as the references.
+ *
+ *  @param f_primary         the primary input
+ *  @param f_reference       the new sample of the reference signal
+ *  @return                  the error, the primary input without the estimated part
+ */
+template <class T, uint32_t NTaps>
+T signal::filter::nlti::siso::CLmsFilter<T,NTaps>::operator()(const T& f_primary, const T& f_reference)
+{
+    for (uint32_t l_idx = NTaps - 1; l_idx > 0; --l_idx)
+    {
+        m_delayLine[l_idx] = m_delayLine[l_idx - 1];
+    }
+    m_delayLine[0] = f_reference;
+    return operator()(f_primary, m_delayLine);
+}
+
+/** @brief  Estimate the correlated part by the current weights without update.
+ *
+ *  @param f_reference       the reference inputs
+ *  @return                  the estimated part
+ */
+template <class T, uint32_t NTaps>
+T signal::filter::nlti::siso::CLmsFilter<T,NTaps>::estimate(const CRegressorType& f_reference) const
+{
+    T l_estimate = 0;
+    for (uint32_t l_idx = 0; l_idx < NTaps; ++l_idx)
+    {
+        l_estimate += m_weights[l_idx] * f_reference[l_idx];
+    }
+    return l_estimate;
+}
+
+/** @brief  Set the normalized step size
+ *
+ *  @param f_stepSize        normalized step size in interval (0,2)
+ */
+template <class T, uint32_t NTaps>
+void signal::filter::nlti::siso::CLmsFilter<T,NTaps>::setStepSize(T f_stepSize)
+{
+    m_stepSize = f_stepSize;
+}
+
+/** @brief  Clear the weights and the delay line
+ */
+template <class T, uint32_t NTaps>
+void signal::filter::nlti::siso::CLmsFilter<T,NTaps>::clear()
+{
+    m_weights.fill(0);
+    m_delayLine.fill(0);
+}
+
+/******************************************************************************/
+/** @brief  CSlewRateFilter class constructor
+ *
+ *  @param f_maxStep         maximum change of the output per sample, non-negative
+ */
+template <class T>
+signal::filter::nlti::siso::CSlewRateFilter<T>::CSlewRateFilter(T f_maxStep)
+    : m_maxStep(f_maxStep)
+    , m_y(0)
+    , m_started(false)
+{
+}
+
+/** @brief  Limit the change of the input
+ *
+ *  @param f_u               the input
+ *  @return                  the limited output
+ */
+template <class T>
+CONTROL_RAMFUNC T signal::filter::nlti::siso::CSlewRateFilter<T>::operator()(T& f_u)
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_y = f_u;
+    }
+    else
+    {
+        T l_step = f_u - m_y;
+        l_step = (l_step > m_maxStep) ? m_maxStep : ((l_step < -m_maxStep) ? -m_maxStep : l_step);
+        m_y += l_step;
+    }
+    return m_y;
+}
+
+/** @brief  Filter a block of samples, the last output is kept in a local variable during the block.
+  *
+  * @param f_in                input samples
+  * @param f_out               limited values, it can be the same buffer as the input
+  * @param f_n                 number of the samples
+  */
+template <class T>
+CONTROL_RAMFUNC void signal::filter::nlti::siso::CSlewRateFilter<T>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    if (0 == f_n)
+    {
+        return;
+    }
+    T l_y = m_started ? m_y : f_in[0];
+    for (size_t i = 0; i < f_n; ++i)
+    {
+        T l_step = f_in[i] - l_y;
+        l_step = (l_step > m_maxStep) ? m_maxStep : ((l_step < -m_maxStep) ? -m_maxStep : l_step);
+        l_y += l_step;
+        f_out[i] = l_y;
+    }
+    m_y = l_y;
+    m_started = true;
+}
+
+/** @brief  The next input is applied without limit
+ */
+template <class T>
+void signal::filter::nlti::siso::CSlewRateFilter<T>::reset()
+{
+    m_started = false;
+}
+
+/******************************************************************************/
+/** @brief  CHysteresisFilter class constructor
+ *
+ *  @param f_low             lower threshold, the output switches to zero below it
+ *  @param f_high            upper threshold, the output switches to one above it
+ *  @param f_initial         initial state
+ */
+template <class T>
+signal::filter::nlti::siso::CHysteresisFilter<T>::CHysteresisFilter(T f_low, T f_high, bool f_initial)
+    : m_low(f_low)
+    , m_high(f_high)
+    , m_state(f_initial)
+{
+}
+
+/** @brief  Compare the input with the thresholds
+ *
+ *  @param f_u               the input
+ *  @return                  one or zero by the state of the comparator
+ */
+template <class T>
+CONTROL_RAMFUNC T signal::filter::nlti::siso::CHysteresisFilter<T>::operator()(T& f_u)
+{
+    m_state = (f_u > m_high) || (m_state && !(f_u < m_low));
+    return m_state ? static_cast<T>(1) : static_cast<T>(0);
+}
+
+/** @brief  Filter a block of samples, the state is kept in a local variable during the block.
+  *
+  * @param f_in                input samples
+  * @param f_out               states, it can be the same buffer as the input
+  * @param f_n                 number of the samples
+  */
+template <class T>
+CONTROL_RAMFUNC void signal::filter::nlti::siso::CHysteresisFilter<T>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    bool l_state = m_state;
+    for (size_t i = 0; i < f_n; ++i)
+    {
+        l_state = (f_in[i] > m_high) || (l_state && !(f_in[i] < m_low));
+        f_out[i] = l_state ? static_cast<T>(1) : static_cast<T>(0);
+    }
+    m_state = l_state;
+}
+
+/******************************************************************************/
+/** @brief  CDeadzoneFilter class constructor
+ *
+ *  @param f_width           half width of the band, non-negative
+ */
+template <class T>
+signal::filter::nlti::siso::CDeadzoneFilter<T>::CDeadzoneFilter(T f_width)
+    : m_width(f_width)
+{
+}
+
+/** @brief  Remove the band around zero
+ *
+ *  @param f_u               the input
+ *  @return                  zero in the band, the input shifted toward zero by the width outside of it
+ */
+template <class T>
+CONTROL_RAMFUNC T signal::filter::nlti::siso::CDeadzoneFilter<T>::operator()(T& f_u)
+{
+    return (f_u > m_width) ? f_u - m_width : ((f_u < -m_width) ? f_u + m_width : static_cast<T>(0));
+}
+
+/** @brief  Filter a block of samples, the filter doesn't have state.
+  *
+  * @param f_in                input samples
+  * @param f_out               output values, it can be the same buffer as the input
+  * @param f_n                 number of the samples
+  */
+template <class T>
+CONTROL_RAMFUNC void signal::filter::nlti::siso::CDeadzoneFilter<T>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    const T l_width = m_width;
+    for (size_t i = 0; i < f_n; ++i)
+    {
+        T l_u = f_in[i];
+        f_out[i] = (l_u > l_width) ? l_u - l_width : ((l_u < -l_width) ? l_u + l_width : static_cast<T>(0));
+    }
+}
+
+/******************************************************************************/
+/** @brief  CRateFilter class constructor
+ *
+ *  @param f_period          sampling period, positive
+ */
+template <class T>
+signal::filter::nlti::siso::CRateFilter<T>::CRateFilter(T f_period)
+    : m_invPeriod(static_cast<T>(1) / f_period)
+    , m_u(0)
+    , m_started(false)
+{
+}
+
+/** @brief  Rate of change of the input
+ *
+ *  @param f_u               the input
+ *  @return                  the backward difference divided by the period, zero for the first input
+ */
+template <class T>
+CONTROL_RAMFUNC T signal::filter::nlti::siso::CRateFilter<T>::operator()(T& f_u)
+{
+    T l_rate = m_started ? (f_u - m_u) * m_invPeriod : static_cast<T>(0);
+    m_u = f_u;
+    m_started = true;
+    return l_rate;
+}
+
+/** @brief  Filter a block of samples, the last input is kept in a local variable during the block.
+  *
+  * @param f_in                input samples
+  * @param f_out               rates, it can be the same buffer as the input
+  * @param f_n                 number of the samples
+  */
+template <class T>
+CONTROL_RAMFUNC void signal::filter::nlti::siso::CRateFilter<T>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    if (0 == f_n)
+    {
+        return;
+    }
+    T l_prev = m_started ? m_u : f_in[0];
+    for (size_t i = 0; i < f_n; ++i)
+    {
+        T l_u = f_in[i];
+        f_out[i] = (l_u - l_prev) * m_invPeriod;
+        l_prev = l_u;
+    }
+    m_u = l_prev;
+    m_started = true;
+}
+
+/** @brief  The next input gives zero rate
+ */
+template <class T>
+void signal::filter::nlti::siso::CRateFilter<T>::reset()
+{
+    m_started = false;
+}
+
+/******************************************************************************/
+/** @brief  CHampelFilter class constructor
+ *
+ *  @param f_threshold       threshold in scaled median absolute deviations
+ *  @param f_minDeviation    lower limit of the scaled deviation, in the unit of the input
+ */
+template <class T, uint32_t N>
+signal::filter::nlti::siso::CHampelFilter<T,N>::CHampelFilter(T f_threshold, T f_minDeviation)
+    : m_median()
+    , m_deviation()
+    , m_threshold(f_threshold)
+    , m_minDeviation(f_minDeviation)
+    , m_outliers(0)
+    , m_filled(0)
+{
+}
+
+/** @brief  Gate the outliers
+ *
+ *  @param f_u               the input
+ *  @return                  the input or the median of the window, when the input is an outlier
+ */
+template <class T, uint32_t N>
+T signal::filter::nlti::siso::CHampelFilter<T,N>::operator()(T& f_u)
+{
+    T l_median = m_median(f_u);
+    if (m_filled < N)
+    {
+        ++m_filled;
+        return f_u;
+    }
+    T l_abs = (f_u > l_median) ? f_u - l_median : l_median - f_u;
+    T l_scaled = static_cast<T>(1.4826) * m_deviation(l_abs);
+    l_scaled = (l_scaled < m_minDeviation) ? m_minDeviation : l_scaled;
+    if (m_filled < 2 * N)
+    {
+        ++m_filled;
+    }
+    else if (l_abs > m_threshold * l_scaled)
+    {
+        ++m_outliers;
+        return l_median;
+    }
+    return f_u;
+}
+
+#endif
@@ -0,0 +1,111 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    FilterBank.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the multi-channel 
+  *          filter banks.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef FILTER_BANK_HPP
+#define FILTER_BANK_HPP
+
+#include <mbed.h>
+#include <array>
+#include <utils/linalg/linalg.h>
+
+namespace signal::filter::lti::mimo
+{
+    /**
+     * @brief Bank of biquad cascades, the same filter is applied on N independent channels (encoders, current, IMU axes).
+     * 
+     * The coefficients are common, they are given in the format of the CBiquadCascadeFilter (b0, b1, b2, a1, a2 in a row of each 
+     * section). The state is kept in structure-of-arrays layout, the inner loop runs over the channels, so its iterations are 
+     * independent and the FPU pipeline isn't stalled by the dependency of the recursion. The coefficients are loaded once per 
+     * section and not once per channel.
+     * 
+     * @tparam T            The type of the input and output signal
+     * @tparam NChannels    Number of the channels
+     * @tparam NStages      Number of the second order sections
+     */
+    template <class T, uint32_t NChannels, uint32_t NStages>
+    class CBiquadBank
+    {
+        public:
+            /** @brief Type of the coefficients, a row for each section */
+            using CCoeffType = utils::linalg::CMatrix<T,NStages,5>;
+            /** @brief Samples of the channels */
+            using CChannelType = std::array<T,NChannels>;
+            /* Constructor */
+            CBiquadBank(const CCoeffType& f_coeffs);
+            /* Filter one sample of each channel */
+            CChannelType operator()(const CChannelType& f_u);
+            /* Clear the state of the sections */
+            void clear();
+        private:
+            /** @brief Coefficients of the sections */
+            CCoeffType m_coeffs;
+            /** @brief First state variable of the sections, by channels */
+            T m_d0[NStages][NChannels];
+            /** @brief Second state variable of the sections, by channels */
+            T m_d1[NStages][NChannels];
+    }; // class CBiquadBank
+
+    /**
+     * @brief Bank of FIR filters with Q15 fixed-point samples and coefficients, the same filter is applied on N channels.
+     * 
+     * The history of a channel is a doubled delay line, each sample is written twice (at idx and at idx + NTaps), so the last NTaps 
+     * samples are always contiguous. On the Cortex-M4 two taps are accumulated by a single dual 16-bit multiply-accumulate (__SMLAD) 
+     * instruction, the output is rounded and saturated to Q15 (__SSAT). The accumulator is 32 bits wide, the sum of the absolute values 
+     * of the coefficients has to be below 2 (Q15 range doubled), so it doesn't overflow. On the host the same arithmetic is applied 
+     * by a portable loop.
+     * 
+     * @tparam NChannels    Number of the channels
+     * @tparam NTaps        Number of the coefficients, it has to be even
+     */
+    template <uint32_t NChannels, uint32_t NTaps>
+    class CFirBankQ15
+    {
+        static_assert(NTaps % 2 == 0, "The taps are processed in pairs, their number has to be even.");
+        public:
+            /** @brief Coefficients in Q15 format, the first one multiplies the newest sample */
+            using CCoeffType = std::array<int16_t,NTaps>;
+            /** @brief Samples of the channels in Q15 format */
+            using CChannelType = std::array<int16_t,NChannels>;
+            /* Constructor */
+            CFirBankQ15(const CCoeffType& f_coeffs);
+            /* Filter one sample of each channel */
+            CChannelType operator()(const CChannelType& f_u);
+            /* Clear the history */
+            void clear();
+        private:
+            /** @brief Coefficients in reversed order (the last one multiplies the newest sample), they're read with the history in pairs */
+            int16_t m_coeffs[NTaps];
+            /** @brief Doubled delay lines of the channels */
+            int16_t m_history[NChannels][2 * NTaps];
+            /** @brief Index of the oldest sample in the delay lines */
+            uint32_t m_idx;
+    }; // class CFirBankQ15
+
+}; // namespace signal::filter::lti::mimo
+
+#include "filterbank.tpp"
+
+#endif // FILTER_BANK_HPP
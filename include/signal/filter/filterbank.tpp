@@ -0,0 +1,159 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    filterbank.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the multi-channel 
+  *          filter banks.
+  ******************************************************************************
+ */
+
+#ifndef FILTER_BANK_TPP
+#define FILTER_BANK_TPP
+
+#ifndef FILTER_BANK_HPP
+#error __FILE__ should only be included from filterbank.hpp.
+#endif // FILTER_BANK_HPP
+
+#include <cstring>
+
+namespace signal::filter::lti::mimo
+{
+    /******************************************************************************/
+    /** @brief  CBiquadBank Class constructor
+     *
+     * @param f_coeffs             coefficients of the sections (b0, b1, b2, a1, a2)
+     */
+    template <class T, uint32_t NChannels, uint32_t NStages>
+    CBiquadBank<T,NChannels,NStages>::CBiquadBank(const CCoeffType& f_coeffs)
+        : m_coeffs(f_coeffs)
+        , m_d0()
+        , m_d1()
+    {
+    }
+
+    /** @brief  Filter one sample of each channel, the sections are applied in order, the channels are processed in the inner loop.
+     *
+     * @param f_u                  input samples
+     * @return                     filtered samples
+     */
+    template <class T, uint32_t NChannels, uint32_t NStages>
+    typename CBiquadBank<T,NChannels,NStages>::CChannelType CBiquadBank<T,NChannels,NStages>::operator()(const CChannelType& f_u)
+    {
+        CChannelType l_x = f_u;
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            const T l_b0 = m_coeffs[l_stage][0];
+            const T l_b1 = m_coeffs[l_stage][1];
+            const T l_b2 = m_coeffs[l_stage][2];
+            const T l_a1 = m_coeffs[l_stage][3];
+            const T l_a2 = m_coeffs[l_stage][4];
+            T* l_d0 = m_d0[l_stage];
+            T* l_d1 = m_d1[l_stage];
+            for (uint32_t l_ch = 0; l_ch < NChannels; ++l_ch)
+            {
+                T l_in = l_x[l_ch];
+                T l_y = l_b0 * l_in + l_d0[l_ch];
+                l_d0[l_ch] = l_b1 * l_in - l_a1 * l_y + l_d1[l_ch];
+                l_d1[l_ch] = l_b2 * l_in - l_a2 * l_y;
+                l_x[l_ch] = l_y;
+            }
+        }
+        return l_x;
+    }
+
+    /** @brief  Clear the state of the sections
+     */
+    template <class T, uint32_t NChannels, uint32_t NStages>
+    void CBiquadBank<T,NChannels,NStages>::clear()
+    {
+        memset(m_d0, 0, sizeof(m_d0));
+        memset(m_d1, 0, sizeof(m_d1));
+    }
+
+    /******************************************************************************/
+    /** @brief  CFirBankQ15 Class constructor
+     *
+     * @param f_coeffs             coefficients in Q15 format, the first one multiplies the newest sample
+     */
+    template <uint32_t NChannels, uint32_t NTaps>
+    CFirBankQ15<NChannels,NTaps>::CFirBankQ15(const CCoeffType& f_coeffs)
+        : m_coeffs()
+        , m_history()
+        , m_idx(0)
+    {
+        for (uint32_t i = 0; i < NTaps; ++i)
+        {
+            m_coeffs[i] = f_coeffs[NTaps - 1 - i];
+        }
+    }
+
+    /** @brief  Filter one sample of each channel. 
+     *
+     *  The new sample replaces the oldest one in both halves of the delay line, then the window of the last NTaps samples 
+     *  (oldest first) is multiplied with the reversed coefficients, two taps at once.
+     *
+     * @param f_u                  input samples in Q15 format
+     * @return                     filtered samples in Q15 format
+     */
+    template <uint32_t NChannels, uint32_t NTaps>
+    typename CFirBankQ15<NChannels,NTaps>::CChannelType CFirBankQ15<NChannels,NTaps>::operator()(const CChannelType& f_u)
+    {
+        uint32_t l_idx = m_idx;
+        m_idx = (l_idx + 1 == NTaps) ? 0 : l_idx + 1;
+        CChannelType l_y;
+        for (uint32_t l_ch = 0; l_ch < NChannels; ++l_ch)
+        {
+            int16_t* l_line = m_history[l_ch];
+            l_line[l_idx] = f_u[l_ch];
+            l_line[l_idx + NTaps] = f_u[l_ch];
+            const int16_t* l_window = l_line + m_idx;
+            int32_t l_acc = 1 << 14;                            // Rounding of the Q30 accumulator to Q15
+#if defined(TARGET_STM32F4)
+            for (uint32_t k = 0; k < NTaps; k += 2)
+            {
+                uint32_t l_samples, l_coeffs;
+                memcpy(&l_samples, l_window + k, sizeof(l_samples));    // Unaligned word access is allowed on the Cortex-M4
+                memcpy(&l_coeffs, m_coeffs + k, sizeof(l_coeffs));
+                l_acc = static_cast<int32_t>(__SMLAD(l_samples, l_coeffs, static_cast<uint32_t>(l_acc)));
+            }
+            l_y[l_ch] = static_cast<int16_t>(__SSAT(l_acc >> 15, 16));
+#else
+            for (uint32_t k = 0; k < NTaps; ++k)
+            {
+                l_acc += static_cast<int32_t>(l_window[k]) * m_coeffs[k];
+            }
+            l_acc >>= 15;
+            l_y[l_ch] = static_cast<int16_t>(l_acc > 32767 ? 32767 : (l_acc < -32768 ? -32768 : l_acc));
+#endif
+        }
+        return l_y;
+    }
+
+    /** @brief  Clear the history
+     */
+    template <uint32_t NChannels, uint32_t NTaps>
+    void CFirBankQ15<NChannels,NTaps>::clear()
+    {
+        memset(m_history, 0, sizeof(m_history));
+        m_idx = 0;
+    }
+
+}; // namespace signal::filter::lti::mimo
+
+#endif // FILTER_BANK_TPP
@@ -0,0 +1,185 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    KalmanFilter.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the linear Kalman filter
+  *          and the extended Kalman filter functionality.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef KALMAN_FILTER_HPP
+#define KALMAN_FILTER_HPP
+
+#include <cmath>
+#include <limits>
+#include <utils/linalg/linalg.h>
+#include <signal/systemmodels/systemmodels.hpp>
+
+namespace signal::filter
+{
+    /* Sequential correction by the uncorrelated scalar measurements */
+    template <class T, uint32_t NS, uint32_t NM>
+    bool sequentialCorrection(
+        utils::linalg::CColVector<T,NS>& f_state,
+        utils::linalg::CMatrix<T,NS,NS>& f_covariance,
+        const utils::linalg::CMatrix<T,NM,NS>& f_observation,
+        utils::linalg::CColVector<T,NM> f_innovation,
+        const utils::linalg::CMatrix<T,NM,NM>& f_measurementNoise);
+}; // namespace signal::filter
+
+namespace signal::filter::lti::mimo
+{
+   /**
+    * @brief Linear Kalman filter with fixed size based on the state space model.
+    * 
+    * The prediction applies the state transition of the model with the control input and it propagates the covariance 
+    * (P = A*P*A^T + Q). The correction calculates the gain from the innovation covariance (S = C*P*C^T + R) by the LDL^T 
+    * decomposition, without inverse matrix, and it corrects the state of the model with the measured values. When the measurement 
+    * noises are uncorrelated (diagonal R), the sequential correction processes the measurements one by one as scalars: the 
+    * innovation covariance is a number, so there isn't decomposition, the cost is O(NA^2) per measurement and the covariance is 
+    * updated in the Joseph form, which keeps it symmetric and positive semi-definite in single precision.
+    * 
+    * @tparam T        type of the variables
+    * @tparam NA       number of states variable
+    * @tparam NB       number of control variable
+    * @tparam NC       number of observation variable
+    * @tparam TA       type of the state transition matrix of the model, it can be a structured matrix
+    */
+    template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA = utils::linalg::CMatrix<T,NA,NA>>
+    class CKalmanFilter
+    {
+        public:
+            using CSystemModelType = signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>;
+            using CStateType = typename CSystemModelType::CStateType;
+            using CControlType = typename CSystemModelType::CControlType;
+            using CMeasurementType = typename CSystemModelType::CMeasurementType;
+            using CStateCovarianceType = utils::linalg::CMatrix<T,NA,NA>;          // P, Q - state and process noise covariance type
+            using CMeasurementCovarianceType = utils::linalg::CMatrix<T,NC,NC>;    // R - measurement noise covariance type
+
+            /* Constructor */
+            CKalmanFilter(
+                const CSystemModelType& f_model,
+                const CStateCovarianceType& f_processNoise,
+                const CMeasurementCovarianceType& f_measurementNoise,
+                const CStateCovarianceType& f_covariance);
+            /* Prediction step */
+            void predict(const CControlType& f_input);
+            /* Correction step */
+            bool update(const CControlType& f_input, const CMeasurementType& f_measurement);
+            /* Correction step by the scalar measurements */
+            bool updateSequential(const CControlType& f_input, const CMeasurementType& f_measurement);
+            /* Prediction and correction */
+            bool operator()(const CControlType& f_input, const CMeasurementType& f_measurement);
+
+            /** @brief Estimated state */
+            const CStateType& state() const {return m_model.state();}
+            CStateType& state() {return m_model.state();}
+            /** @brief Covariance of the estimated state */
+            const CStateCovarianceType& covariance() const {return m_covariance;}
+            CStateCovarianceType& covariance() {return m_covariance;}
+
+        private:
+            /* system model */
+            CSystemModelType m_model;
+            /* process noise covariance */
+            CStateCovarianceType m_processNoise;
+            /* measurement noise covariance */
+            CMeasurementCovarianceType m_measurementNoise;
+            /* state covariance */
+            CStateCovarianceType m_covariance;
+    }; // class CKalmanFilter
+}; // namespace signal::filter::lti::mimo
+
+namespace signal::filter::nlti::mimo
+{
+   /**
+    * @brief Extended Kalman filter with fixed size based on the non-linear discrete time model.
+    * 
+    * The filter doesn't own the model, it uses the states of the model as the estimated state. The model is linearized 
+    * around the current state by the Jacobian interface, when it's given, otherwise by forward finite differences. The 
+    * finite differences call the state transition and observation models with perturbed states (NB+1 evaluations), 
+    * so these methods must only depend on the states and the input. The sequential correction processes the uncorrelated 
+    * measurements one by one with the Jacobian of the predicted state, like the linear filter.
+    * 
+    * @tparam T        type of the variables
+    * @tparam NA       number of control
+    * @tparam NB       number of states
+    * @tparam NC       number of outputs
+    */
+    template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+    class CExtendedKalmanFilter
+    {
+        public:
+            using CSystemModelType = signal::systemmodels::nlti::mimo::CDiscreteTimeSystemModel<T,NA,NB,NC>;
+            using CJacobianType = signal::systemmodels::nlti::mimo::IJacobianMatrices<T,NA,NB,NC>;
+            using CStatesType = typename CSystemModelType::CStatesType;
+            using CControlType = typename CSystemModelType::CControlType;
+            using CObservationType = typename CSystemModelType::CObservationType;
+            using CStateJacobianType = typename CJacobianType::CStateJacobianType;
+            using COutputJacobianType = typename CJacobianType::COutputJacobianType;
+            using CStateCovarianceType = utils::linalg::CMatrix<T,NB,NB>;          // P, Q - state and process noise covariance type
+            using CObservationCovarianceType = utils::linalg::CMatrix<T,NC,NC>;    // R - measurement noise covariance type
+
+            /* Constructor */
+            CExtendedKalmanFilter(
+                CSystemModelType& f_model,
+                const CStateCovarianceType& f_processNoise,
+                const CObservationCovarianceType& f_measurementNoise,
+                const CStateCovarianceType& f_covariance,
+                CJacobianType* f_jacobian = NULL);
+            /* Prediction step */
+            void predict(const CControlType& f_input);
+            /* Correction step */
+            bool update(const CControlType& f_input, const CObservationType& f_measurement);
+            /* Correction step by the scalar measurements */
+            bool updateSequential(const CControlType& f_input, const CObservationType& f_measurement);
+            /* Prediction and correction */
+            bool operator()(const CControlType& f_input, const CObservationType& f_measurement);
+
+            /** @brief Estimated state */
+            CStatesType state() {return m_model.getStates();}
+            /** @brief Covariance of the estimated state */
+            const CStateCovarianceType& covariance() const {return m_covariance;}
+            CStateCovarianceType& covariance() {return m_covariance;}
+
+        private:
+            /* Jacobian of the state transition model by finite differences */
+            CStateJacobianType stateJacobian(const CStatesType& f_states, const CControlType& f_input);
+            /* Jacobian of the state observation model by finite differences */
+            COutputJacobianType outputJacobian(const CStatesType& f_states, const CControlType& f_input);
+            /* Perturbation of a state for the finite differences */
+            static T perturbation(const T& f_value);
+
+            /* system model */
+            CSystemModelType& m_model;
+            /* Jacobian matrices of the model, NULL for finite differences */
+            CJacobianType* m_jacobian;
+            /* process noise covariance */
+            CStateCovarianceType m_processNoise;
+            /* measurement noise covariance */
+            CObservationCovarianceType m_measurementNoise;
+            /* state covariance */
+            CStateCovarianceType m_covariance;
+    }; // class CExtendedKalmanFilter
+}; // namespace signal::filter::nlti::mimo
+
+#include "kalmanfilter.tpp"
+
+#endif // KALMAN_FILTER_HPP
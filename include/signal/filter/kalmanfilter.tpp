@@ -0,0 +1,432 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    KalmanFilter.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the linear Kalman
+  *          and the extended Kalman filter functionality.
+  ******************************************************************************
+ */
+
+#ifndef KALMAN_FILTER_TPP
+#define KALMAN_FILTER_TPP
+
+#ifndef KALMAN_FILTER_HPP
+#error __FILE__ should only be included from kalmanfilter.hpp.
+#endif // KALMAN_FILTER_HPP
+
+/** @brief  Sequential correction by the uncorrelated scalar measurements, only the diagonal of the measurement noise is applied.
+ *
+ *  For each measurement i with the observation row h: s = h*P*h^T + r, K = P*h^T / s, x = x + K*e_i, and the covariance is 
+ *  updated in the Joseph form P = (I - K*h)*P*(I - K*h)^T + r*K*K^T. The form is evaluated in O(NS^2) without matrix products: 
+ *  M = P - K*(P*h^T)^T, then P = M - (M*h^T)*K^T + r*K*K^T, only the upper triangle is calculated and mirrored. The remaining 
+ *  innovations are corrected by the linearized change of the state (e_j -= h_j*K*e_i), so the result equals the batch correction.
+ *  A measurement with not positive innovation variance is skipped.
+ *
+ *  @param f_state                  state, it's corrected
+ *  @param f_covariance             symmetric covariance of the state, it's corrected
+ *  @param f_observation            observation matrix (or Jacobian) at the predicted state
+ *  @param f_innovation             innovation of the measurements at the predicted state
+ *  @param f_measurementNoise       covariance of the measurement noise, the elements outside of the diagonal are ignored
+ *  @return                         false, when a measurement was skipped
+ */
+template <class T, uint32_t NS, uint32_t NM>
+bool signal::filter::sequentialCorrection(
+        utils::linalg::CColVector<T,NS>& f_state,
+        utils::linalg::CMatrix<T,NS,NS>& f_covariance,
+        const utils::linalg::CMatrix<T,NM,NS>& f_observation,
+        utils::linalg::CColVector<T,NM> f_innovation,
+        const utils::linalg::CMatrix<T,NM,NM>& f_measurementNoise)
+{
+    bool l_valid = true;
+    for (uint32_t i = 0; i < NM; ++i)
+    {
+        const std::array<T,NS>& l_h = f_observation[i];
+        // P*h^T and the innovation variance
+        std::array<T,NS> l_Ph;
+        T l_s = f_measurementNoise[i][i];
+        for (uint32_t a = 0; a < NS; ++a)
+        {
+            T l_sum = T(0);
+            for (uint32_t b = 0; b < NS; ++b)
+            {
+                l_sum += f_covariance[a][b] * l_h[b];
+            }
+            l_Ph[a] = l_sum;
+            l_s += l_h[a] * l_sum;
+        }
+        if (!(l_s > T(0)))
+        {
+            l_valid = false;
+            continue;
+        }
+        const T l_inv = T(1) / l_s;
+        const T l_nu = f_innovation[i][0];
+        std::array<T,NS> l_K;
+        for (uint32_t a = 0; a < NS; ++a)
+        {
+            l_K[a] = l_Ph[a] * l_inv;
+            f_state[a][0] += l_K[a] * l_nu;
+        }
+        for (uint32_t j = i + 1; j < NM; ++j)
+        {
+            T l_hK = T(0);
+            for (uint32_t a = 0; a < NS; ++a)
+            {
+                l_hK += f_observation[j][a] * l_K[a];
+            }
+            f_innovation[j][0] -= l_hK * l_nu;
+        }
+        // Joseph form: M = (I - K*h)*P, then M*(I - K*h)^T + r*K*K^T
+        for (uint32_t a = 0; a < NS; ++a)
+        {
+            for (uint32_t b = 0; b < NS; ++b)
+            {
+                f_covariance[a][b] -= l_K[a] * l_Ph[b];
+            }
+        }
+        std::array<T,NS> l_Mh;
+        for (uint32_t a = 0; a < NS; ++a)
+        {
+            T l_sum = T(0);
+            for (uint32_t b = 0; b < NS; ++b)
+            {
+                l_sum += f_covariance[a][b] * l_h[b];
+            }
+            l_Mh[a] = l_sum;
+        }
+        const T l_r = f_measurementNoise[i][i];
+        for (uint32_t a = 0; a < NS; ++a)
+        {
+            for (uint32_t b = a; b < NS; ++b)
+            {
+                f_covariance[a][b] += (l_r * l_K[a] - l_Mh[a]) * l_K[b];
+                f_covariance[b][a] = f_covariance[a][b];
+            }
+        }
+    }
+    return l_valid;
+}
+
+/** @brief  CKalmanFilter class constructor
+ *
+ *  @param f_model                  system model with the initial state
+ *  @param f_processNoise           covariance of the process noise (Q)
+ *  @param f_measurementNoise       covariance of the measurement noise (R)
+ *  @param f_covariance             initial covariance of the state (P)
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+signal::filter::lti::mimo::CKalmanFilter<T,NA,NB,NC,TA>::CKalmanFilter(
+        const CSystemModelType& f_model,
+        const CStateCovarianceType& f_processNoise,
+        const CMeasurementCovarianceType& f_measurementNoise,
+        const CStateCovarianceType& f_covariance)
+    : m_model(f_model)
+    , m_processNoise(f_processNoise)
+    , m_measurementNoise(f_measurementNoise)
+    , m_covariance(f_covariance)
+{
+}
+
+/** @brief  Prediction step, it propagates the state and its covariance
+ *
+ *  @param f_input                  control values
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+void signal::filter::lti::mimo::CKalmanFilter<T,NA,NB,NC,TA>::predict(const CControlType& f_input)
+{
+    const typename CSystemModelType::CStateTransitionType& l_A = m_model.getStateTransitionMatrix();
+    m_model.updateState(f_input);
+    // P = A*P*A^T + Q = A*(A*P)^T + Q, because P is symmetric, so A is only applied from the left
+    CStateCovarianceType l_AP;
+    CStateCovarianceType l_PAt;
+    utils::linalg::multiply(l_AP, l_A, m_covariance);
+    utils::linalg::transpose(l_PAt, l_AP);
+    m_covariance = m_processNoise;
+    utils::linalg::multiplyAdd(m_covariance, l_A, l_PAt);
+}
+
+/** @brief  Correction step, it corrects the state and its covariance by the measured values
+ *
+ *  @param f_input                  control values of the prediction
+ *  @param f_measurement            measured values
+ *  @return                         false, when the innovation covariance isn't positive-definite and the correction is skipped
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+bool signal::filter::lti::mimo::CKalmanFilter<T,NA,NB,NC,TA>::update(const CControlType& f_input, const CMeasurementType& f_measurement)
+{
+    const utils::linalg::CMatrix<T,NC,NA>& l_C = m_model.getMeasurementMatrix();
+    // P*C^T
+    utils::linalg::CMatrix<T,NA,NC> l_Ct;
+    utils::linalg::CMatrix<T,NA,NC> l_PCt;
+    utils::linalg::transpose(l_Ct, l_C);
+    utils::linalg::multiply(l_PCt, m_covariance, l_Ct);
+    // S = C*P*C^T + R
+    CMeasurementCovarianceType l_S(m_measurementNoise);
+    utils::linalg::multiplyAdd(l_S, l_C, l_PCt);
+    utils::linalg::CCholeskyDecomposition<T,NC> l_decomposition(l_S);
+    if (!l_decomposition.isPositiveDefinite())
+    {
+        return false;
+    }
+    // K^T = S^-1 * (P*C^T)^T, the S and P matrices are symmetric
+    utils::linalg::CMatrix<T,NC,NA> l_Kt;
+    utils::linalg::transpose(l_Kt, l_PCt);
+    l_decomposition.solveInPlace(l_Kt);
+    utils::linalg::CMatrix<T,NA,NC> l_K;
+    utils::linalg::transpose(l_K, l_Kt);
+    // x = x + K*(y - C*x - D*u)
+    CMeasurementType l_innovation(f_measurement);
+    l_innovation -= m_model.getOutput(f_input);
+    utils::linalg::multiplyAdd(m_model.state(), l_K, l_innovation);
+    // P = P - K*C*P = P - K*(P*C^T)^T
+    utils::linalg::CMatrix<T,NC,NA> l_CP;
+    utils::linalg::transpose(l_CP, l_PCt);
+    utils::linalg::multiplySubtract(m_covariance, l_K, l_CP);
+    // The rounding errors of the subtraction break the symmetry of P, it's restored to keep P positive-definite in single precision
+    for (uint32_t i = 0; i < NA; ++i)
+    {
+        for (uint32_t j = i + 1; j < NA; ++j)
+        {
+            m_covariance[i][j] = m_covariance[j][i] = (m_covariance[i][j] + m_covariance[j][i]) * static_cast<T>(0.5);
+        }
+    }
+    return true;
+}
+
+/** @brief  Correction step by the scalar measurements, the noises of the measurements have to be uncorrelated (diagonal R)
+ *
+ *  @param f_input                  control values of the prediction
+ *  @param f_measurement            measured values
+ *  @return                         false, when a measurement with not positive innovation variance is skipped
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+bool signal::filter::lti::mimo::CKalmanFilter<T,NA,NB,NC,TA>::updateSequential(const CControlType& f_input, const CMeasurementType& f_measurement)
+{
+    CMeasurementType l_innovation(f_measurement);
+    l_innovation -= m_model.getOutput(f_input);
+    return signal::filter::sequentialCorrection(m_model.state(), m_covariance, m_model.getMeasurementMatrix(), l_innovation, m_measurementNoise);
+}
+
+/** @brief  Prediction and correction in one step
+ *
+ *  @param f_input                  control values
+ *  @param f_measurement            measured values
+ *  @return                         false, when the correction is skipped
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+bool signal::filter::lti::mimo::CKalmanFilter<T,NA,NB,NC,TA>::operator()(const CControlType& f_input, const CMeasurementType& f_measurement)
+{
+    predict(f_input);
+    return update(f_input, f_measurement);
+}
+
+/** @brief  CExtendedKalmanFilter class constructor
+ *
+ *  @param f_model                  system model with the initial state
+ *  @param f_processNoise           covariance of the process noise (Q)
+ *  @param f_measurementNoise       covariance of the measurement noise (R)
+ *  @param f_covariance             initial covariance of the state (P)
+ *  @param f_jacobian               Jacobian matrices of the model, NULL to use finite differences
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::CExtendedKalmanFilter(
+        CSystemModelType& f_model,
+        const CStateCovarianceType& f_processNoise,
+        const CObservationCovarianceType& f_measurementNoise,
+        const CStateCovarianceType& f_covariance,
+        CJacobianType* f_jacobian)
+    : m_model(f_model)
+    , m_jacobian(f_jacobian)
+    , m_processNoise(f_processNoise)
+    , m_measurementNoise(f_measurementNoise)
+    , m_covariance(f_covariance)
+{
+}
+
+/** @brief  Prediction step, it propagates the state by the model and the covariance by the linearized model
+ *
+ *  @param f_input                  control values
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+void signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::predict(const CControlType& f_input)
+{
+    CStatesType l_states = m_model.getStates();
+    CStateJacobianType l_F = (m_jacobian != NULL) ? m_jacobian->getStateJacobian(l_states, f_input) : stateJacobian(l_states, f_input);
+    m_model.update(f_input);
+    // P = F*P*F^T + Q
+    CStateCovarianceType l_FP;
+    CStateCovarianceType l_Ft;
+    utils::linalg::multiply(l_FP, l_F, m_covariance);
+    utils::linalg::transpose(l_Ft, l_F);
+    m_covariance = m_processNoise;
+    utils::linalg::multiplyAdd(m_covariance, l_FP, l_Ft);
+}
+
+/** @brief  Correction step, it corrects the states of the model and the covariance by the measured values
+ *
+ *  @param f_input                  control values of the prediction
+ *  @param f_measurement            measured values
+ *  @return                         false, when the innovation covariance isn't positive-definite and the correction is skipped
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+bool signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::update(const CControlType& f_input, const CObservationType& f_measurement)
+{
+    CStatesType l_states = m_model.getStates();
+    COutputJacobianType l_H = (m_jacobian != NULL) ? m_jacobian->getOutputJacobian(l_states, f_input) : outputJacobian(l_states, f_input);
+    // P*H^T
+    utils::linalg::CMatrix<T,NB,NC> l_Ht;
+    utils::linalg::CMatrix<T,NB,NC> l_PHt;
+    utils::linalg::transpose(l_Ht, l_H);
+    utils::linalg::multiply(l_PHt, m_covariance, l_Ht);
+    // S = H*P*H^T + R
+    CObservationCovarianceType l_S(m_measurementNoise);
+    utils::linalg::multiplyAdd(l_S, l_H, l_PHt);
+    utils::linalg::CCholeskyDecomposition<T,NC> l_decomposition(l_S);
+    if (!l_decomposition.isPositiveDefinite())
+    {
+        return false;
+    }
+    // K^T = S^-1 * (P*H^T)^T
+    utils::linalg::CMatrix<T,NC,NB> l_Kt;
+    utils::linalg::transpose(l_Kt, l_PHt);
+    l_decomposition.solveInPlace(l_Kt);
+    utils::linalg::CMatrix<T,NB,NC> l_K;
+    utils::linalg::transpose(l_K, l_Kt);
+    // x = x + K*(y - h(x,u))
+    CObservationType l_innovation(f_measurement);
+    l_innovation -= m_model.calculateOutput(f_input);
+    utils::linalg::multiplyAdd(l_states, l_K, l_innovation);
+    m_model.setStates(l_states);
+    // P = P - K*H*P = P - K*(P*H^T)^T
+    utils::linalg::CMatrix<T,NC,NB> l_HP;
+    utils::linalg::transpose(l_HP, l_PHt);
+    utils::linalg::multiplySubtract(m_covariance, l_K, l_HP);
+    // The rounding errors of the subtraction break the symmetry of P, it's restored to keep P positive-definite in single precision
+    for (uint32_t i = 0; i < NA; ++i)
+    {
+        for (uint32_t j = i + 1; j < NA; ++j)
+        {
+            m_covariance[i][j] = m_covariance[j][i] = (m_covariance[i][j] + m_covariance[j][i]) * static_cast<T>(0.5);
+        }
+    }
+    return true;
+}
+
+/** @brief  Correction step by the scalar measurements, the noises of the measurements have to be uncorrelated (diagonal R).
+ *  The model is linearized once at the predicted state.
+ *
+ *  @param f_input                  control values of the prediction
+ *  @param f_measurement            measured values
+ *  @return                         false, when a measurement with not positive innovation variance is skipped
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+bool signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::updateSequential(const CControlType& f_input, const CObservationType& f_measurement)
+{
+    CStatesType l_states = m_model.getStates();
+    COutputJacobianType l_H = (m_jacobian != NULL) ? m_jacobian->getOutputJacobian(l_states, f_input) : outputJacobian(l_states, f_input);
+    CObservationType l_innovation(f_measurement);
+    l_innovation -= m_model.calculateOutput(f_input);
+    bool l_valid = signal::filter::sequentialCorrection(l_states, m_covariance, l_H, l_innovation, m_measurementNoise);
+    m_model.setStates(l_states);
+    return l_valid;
+}
+
+/** @brief  Prediction and correction in one step
+ *
+ *  @param f_input                  control values
+ *  @param f_measurement            measured values
+ *  @return                         false, when the correction is skipped
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+bool signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::operator()(const CControlType& f_input, const CObservationType& f_measurement)
+{
+    predict(f_input);
+    return update(f_input, f_measurement);
+}
+
+/** @brief  Jacobian of the state transition model by forward finite differences. The states of the model are restored.
+ *
+ *  @param f_states                 states of the linearization
+ *  @param f_input                  control values
+ *  @return                         derivative of the state transition by the states
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+typename signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::CStateJacobianType 
+signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::stateJacobian(const CStatesType& f_states, const CControlType& f_input)
+{
+    CStateJacobianType l_F;
+    const CStatesType l_nominal = m_model.update(f_input);
+    for (uint32_t l_col = 0; l_col < NB; ++l_col)
+    {
+        CStatesType l_perturbed(f_states);
+        const T l_step = perturbation(f_states[l_col][0]);
+        l_perturbed[l_col][0] += l_step;
+        m_model.setStates(l_perturbed);
+        const CStatesType l_value = m_model.update(f_input);
+        for (uint32_t l_row = 0; l_row < NB; ++l_row)
+        {
+            l_F[l_row][l_col] = (l_value[l_row][0] - l_nominal[l_row][0]) / l_step;
+        }
+    }
+    m_model.setStates(f_states);
+    return l_F;
+}
+
+/** @brief  Jacobian of the state observation model by forward finite differences. The states of the model are restored.
+ *
+ *  @param f_states                 states of the linearization
+ *  @param f_input                  control values
+ *  @return                         derivative of the observation by the states
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+typename signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::COutputJacobianType 
+signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::outputJacobian(const CStatesType& f_states, const CControlType& f_input)
+{
+    COutputJacobianType l_H;
+    const CObservationType l_nominal = m_model.calculateOutput(f_input);
+    for (uint32_t l_col = 0; l_col < NB; ++l_col)
+    {
+        CStatesType l_perturbed(f_states);
+        const T l_step = perturbation(f_states[l_col][0]);
+        l_perturbed[l_col][0] += l_step;
+        m_model.setStates(l_perturbed);
+        const CObservationType l_value = m_model.calculateOutput(f_input);
+        for (uint32_t l_row = 0; l_row < NC; ++l_row)
+        {
+            l_H[l_row][l_col] = (l_value[l_row][0] - l_nominal[l_row][0]) / l_step;
+        }
+    }
+    m_model.setStates(f_states);
+    return l_H;
+}
+
+/** @brief  Perturbation of a state for the finite differences, it's the square root of the machine epsilon scaled by the value
+ *
+ *  @param f_value                  value of the state
+ *  @return                         step of the finite differences
+ */
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+T signal::filter::nlti::mimo::CExtendedKalmanFilter<T,NA,NB,NC>::perturbation(const T& f_value)
+{
+    const T l_scale = std::sqrt(std::numeric_limits<T>::epsilon());
+    const T l_abs = std::fabs(f_value);
+    return l_scale * ((l_abs > T(1)) ? l_abs : T(1));
+}
+
+#endif // KALMAN_FILTER_TPP
@@ -0,0 +1,178 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    multirate.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the decimating and 
+  *          interpolating filter stages.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef MULTIRATE_HPP
+#define MULTIRATE_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+
+namespace signal::filter::lti::siso
+{
+    /**
+     * @brief Polyphase FIR decimator, it keeps every NFactor-th output of the anti-aliasing filter.
+     * 
+     * The inputs are written in a doubled delay line and the convolution is computed only for the kept outputs, so a tap costs one 
+     * multiply-accumulate per output and not per input. The downstream stages run at the output rate. The coefficients have to 
+     * give the anti-aliasing low-pass filter below the half of the output rate, the first one multiplies the newest input.
+     * 
+     * @tparam T        The type of the input and output signal
+     * @tparam NTaps    Number of the coefficients
+     * @tparam NFactor  Decimation factor
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    class CFirDecimator
+    {
+        static_assert(NFactor > 0, "The decimation factor has to be positive.");
+        public:
+            /** @brief Type of the coefficients */
+            using CCoeffType = std::array<T,NTaps>;
+            /* Constructor */
+            CFirDecimator(const CCoeffType& f_coeffs);
+            /* Apply an input, it returns true, when a new output was computed */
+            bool operator()(const T& f_u, T& f_y);
+            /* Apply a block of inputs, it returns the number of the outputs */
+            size_t process(const T* f_in, size_t f_n, T* f_out);
+            /* Clear the memory */
+            void clear();
+        private:
+            /** @brief Coefficients */
+            CCoeffType m_coeffs;
+            /** @brief Doubled delay line, the newest input is at m_idx */
+            T m_history[2 * NTaps];
+            /** @brief Index of the newest input */
+            uint32_t m_idx;
+            /** @brief Number of the inputs since the last output */
+            uint32_t m_phase;
+    }; // class CFirDecimator
+
+    /**
+     * @brief Polyphase FIR interpolator, it produces NFactor outputs for each input.
+     * 
+     * The zero-stuffed input isn't computed, the output with phase p applies only the coefficients p, p+NFactor, p+2*NFactor,... 
+     * on the previous inputs, so each output costs NTaps/NFactor multiply-accumulates. The coefficients give the image-rejection 
+     * low-pass filter at the output rate, their DC gain has to be NFactor to keep the amplitude.
+     * 
+     * @tparam T        The type of the input and output signal
+     * @tparam NTaps    Number of the coefficients, multiple of the factor
+     * @tparam NFactor  Interpolation factor
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    class CFirInterpolator
+    {
+        static_assert(NFactor > 0 && NTaps % NFactor == 0, "The number of the coefficients has to be a multiple of the interpolation factor.");
+        public:
+            /** @brief Type of the coefficients */
+            using CCoeffType = std::array<T,NTaps>;
+            /** @brief Outputs of an input */
+            using COutputType = std::array<T,NFactor>;
+            /* Constructor */
+            CFirInterpolator(const CCoeffType& f_coeffs);
+            /* Apply an input, it computes the outputs of its period */
+            COutputType operator()(const T& f_u);
+            /* Clear the memory */
+            void clear();
+        private:
+            /** @brief Number of the coefficients of a phase */
+            static const uint32_t s_phaseTaps = NTaps / NFactor;
+            /** @brief Coefficients */
+            CCoeffType m_coeffs;
+            /** @brief Doubled delay line of the inputs, the newest input is at m_idx */
+            T m_history[2 * s_phaseTaps];
+            /** @brief Index of the newest input */
+            uint32_t m_idx;
+    }; // class CFirInterpolator
+
+    /**
+     * @brief Cascaded integrator-comb (CIC) decimator without multiplication, for the high rate integer samples (ADC, encoder counts).
+     * 
+     * The integrators run at the input rate, the combs (differential delay one) at the output rate. The integer arithmetic wraps around 
+     * in modulo 2^32, the result is exact, while the gain NFactor^NStages multiplied by the input range fits in 32 bits. The output is 
+     * normalized by the gain. The response has nulls at the multiples of the output rate, the droop in the passband can be corrected 
+     * by a short FIR filter at the output rate.
+     * 
+     * @tparam NStages  Number of the integrator and comb stages
+     * @tparam NFactor  Decimation factor
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    class CCicDecimator
+    {
+        static_assert(NStages > 0 && NFactor > 0, "The number of the stages and the factor have to be positive.");
+        public:
+            /* Constructor */
+            CCicDecimator();
+            /* Apply an input, it returns true, when a new output was computed */
+            bool operator()(int32_t f_u, float& f_y);
+            /* Clear the state */
+            void clear();
+            /* Gain of the filter */
+            static constexpr float gain();
+        private:
+            /** @brief State of the integrators */
+            uint32_t m_integrators[NStages];
+            /** @brief Previous inputs of the combs */
+            uint32_t m_combs[NStages];
+            /** @brief Number of the inputs since the last output */
+            uint32_t m_phase;
+    }; // class CCicDecimator
+
+    /**
+     * @brief Cascaded integrator-comb (CIC) interpolator without multiplication.
+     * 
+     * The combs run at the input rate, the integrators at the output rate on the zero-stuffed signal. The outputs are normalized by 
+     * the gain NFactor^(NStages-1), so a constant input gives the same constant output.
+     * 
+     * @tparam NStages  Number of the integrator and comb stages
+     * @tparam NFactor  Interpolation factor
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    class CCicInterpolator
+    {
+        static_assert(NStages > 0 && NFactor > 0, "The number of the stages and the factor have to be positive.");
+        public:
+            /** @brief Outputs of an input */
+            using COutputType = std::array<float,NFactor>;
+            /* Constructor */
+            CCicInterpolator();
+            /* Apply an input, it computes the outputs of its period */
+            COutputType operator()(int32_t f_u);
+            /* Clear the state */
+            void clear();
+            /* Gain of the filter */
+            static constexpr float gain();
+        private:
+            /** @brief Previous inputs of the combs */
+            uint32_t m_combs[NStages];
+            /** @brief State of the integrators */
+            uint32_t m_integrators[NStages];
+    }; // class CCicInterpolator
+
+}; // namespace signal::filter::lti::siso
+
+#include "multirate.tpp"
+
+#endif // MULTIRATE_HPP
@@ -0,0 +1,297 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    multirate.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the decimating and 
+  *          interpolating filter stages.
+  ******************************************************************************
+ */
+
+#ifndef MULTIRATE_TPP
+#define MULTIRATE_TPP
+
+#ifndef MULTIRATE_HPP
+#error __FILE__ should only be included from multirate.hpp.
+#endif // MULTIRATE_HPP
+
+namespace signal::filter::lti::siso
+{
+    /******************************************************************************/
+    /** @brief  CFirDecimator Class constructor
+     *
+     * @param f_coeffs             coefficients of the anti-aliasing filter, the first one multiplies the newest input
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    CFirDecimator<T,NTaps,NFactor>::CFirDecimator(const CCoeffType& f_coeffs)
+        : m_coeffs(f_coeffs)
+        , m_history()
+        , m_idx(0)
+        , m_phase(0)
+    {
+    }
+
+    /** @brief  Store an input in the delay line and compute the output after each NFactor-th input.
+     *
+     * @param f_u                  input sample
+     * @param f_y                  output sample, it's written only, when the function returns true
+     * @return                     true, when a new output was computed
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    bool CFirDecimator<T,NTaps,NFactor>::operator()(const T& f_u, T& f_y)
+    {
+        m_idx = (0 == m_idx) ? NTaps - 1 : m_idx - 1;
+        m_history[m_idx] = f_u;
+        m_history[m_idx + NTaps] = f_u;
+        if (++m_phase < NFactor)
+        {
+            return false;
+        }
+        m_phase = 0;
+        const T* l_x = m_history + m_idx;
+        T l_y = 0;
+        for (uint32_t l_tap = 0; l_tap < NTaps; ++l_tap)
+        {
+            l_y += m_coeffs[l_tap] * l_x[l_tap];
+        }
+        f_y = l_y;
+        return true;
+    }
+
+    /** @brief  Apply a block of inputs, the outputs are written consecutively.
+     *
+     * @param f_in                 input samples
+     * @param f_n                  number of the input samples
+     * @param f_out                output samples, it has to have place for f_n / NFactor + 1 values
+     * @return                     number of the computed outputs
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    size_t CFirDecimator<T,NTaps,NFactor>::process(const T* f_in, size_t f_n, T* f_out)
+    {
+        size_t l_count = 0;
+        for (size_t l_idx = 0; l_idx < f_n; ++l_idx)
+        {
+            if (operator()(f_in[l_idx], f_out[l_count]))
+            {
+                ++l_count;
+            }
+        }
+        return l_count;
+    }
+
+    /** @brief  Clear the delay line and restart the decimation phase
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    void CFirDecimator<T,NTaps,NFactor>::clear()
+    {
+        for (uint32_t l_idx = 0; l_idx < 2 * NTaps; ++l_idx)
+        {
+            m_history[l_idx] = 0;
+        }
+        m_idx = 0;
+        m_phase = 0;
+    }
+
+    /******************************************************************************/
+    /** @brief  CFirInterpolator Class constructor
+     *
+     * @param f_coeffs             coefficients of the image-rejection filter at the output rate
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    CFirInterpolator<T,NTaps,NFactor>::CFirInterpolator(const CCoeffType& f_coeffs)
+        : m_coeffs(f_coeffs)
+        , m_history()
+        , m_idx(0)
+    {
+    }
+
+    /** @brief  Store an input and compute the outputs of its period, each phase applies its own subset of the coefficients.
+     *
+     * @param f_u                  input sample
+     * @return                     NFactor output samples in time order
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    typename CFirInterpolator<T,NTaps,NFactor>::COutputType CFirInterpolator<T,NTaps,NFactor>::operator()(const T& f_u)
+    {
+        m_idx = (0 == m_idx) ? s_phaseTaps - 1 : m_idx - 1;
+        m_history[m_idx] = f_u;
+        m_history[m_idx + s_phaseTaps] = f_u;
+        const T* l_x = m_history + m_idx;
+        COutputType l_y;
+        for (uint32_t l_phase = 0; l_phase < NFactor; ++l_phase)
+        {
+            T l_acc = 0;
+            for (uint32_t l_tap = 0; l_tap < s_phaseTaps; ++l_tap)
+            {
+                l_acc += m_coeffs[l_tap * NFactor + l_phase] * l_x[l_tap];
+            }
+            l_y[l_phase] = l_acc;
+        }
+        return l_y;
+    }
+
+    /** @brief  Clear the delay line
+     */
+    template <class T, uint32_t NTaps, uint32_t NFactor>
+    void CFirInterpolator<T,NTaps,NFactor>::clear()
+    {
+        for (uint32_t l_idx = 0; l_idx < 2 * s_phaseTaps; ++l_idx)
+        {
+            m_history[l_idx] = 0;
+        }
+        m_idx = 0;
+    }
+
+    /******************************************************************************/
+    /** @brief  CCicDecimator Class constructor
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    CCicDecimator<NStages,NFactor>::CCicDecimator()
+        : m_integrators()
+        , m_combs()
+        , m_phase(0)
+    {
+    }
+
+    /** @brief  Integrate an input and apply the combs after each NFactor-th input.
+     *
+     * @param f_u                  input sample
+     * @param f_y                  output sample normalized by the gain, it's written only, when the function returns true
+     * @return                     true, when a new output was computed
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    bool CCicDecimator<NStages,NFactor>::operator()(int32_t f_u, float& f_y)
+    {
+        uint32_t l_x = static_cast<uint32_t>(f_u);
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            m_integrators[l_stage] += l_x;
+            l_x = m_integrators[l_stage];
+        }
+        if (++m_phase < NFactor)
+        {
+            return false;
+        }
+        m_phase = 0;
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            uint32_t l_diff = l_x - m_combs[l_stage];
+            m_combs[l_stage] = l_x;
+            l_x = l_diff;
+        }
+        f_y = static_cast<float>(static_cast<int32_t>(l_x)) / gain();
+        return true;
+    }
+
+    /** @brief  Clear the integrators and the combs
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    void CCicDecimator<NStages,NFactor>::clear()
+    {
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            m_integrators[l_stage] = 0;
+            m_combs[l_stage] = 0;
+        }
+        m_phase = 0;
+    }
+
+    /** @brief  Gain of the filter at DC
+     *
+     * @return                     NFactor^NStages
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    constexpr float CCicDecimator<NStages,NFactor>::gain()
+    {
+        float l_gain = 1.0f;
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            l_gain *= NFactor;
+        }
+        return l_gain;
+    }
+
+    /******************************************************************************/
+    /** @brief  CCicInterpolator Class constructor
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    CCicInterpolator<NStages,NFactor>::CCicInterpolator()
+        : m_combs()
+        , m_integrators()
+    {
+    }
+
+    /** @brief  Apply the combs on an input, then integrate the zero-stuffed period at the output rate.
+     *
+     * @param f_u                  input sample
+     * @return                     NFactor output samples normalized by the gain
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    typename CCicInterpolator<NStages,NFactor>::COutputType CCicInterpolator<NStages,NFactor>::operator()(int32_t f_u)
+    {
+        uint32_t l_x = static_cast<uint32_t>(f_u);
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            uint32_t l_diff = l_x - m_combs[l_stage];
+            m_combs[l_stage] = l_x;
+            l_x = l_diff;
+        }
+        COutputType l_y;
+        for (uint32_t l_phase = 0; l_phase < NFactor; ++l_phase)
+        {
+            uint32_t l_v = (0 == l_phase) ? l_x : 0;
+            for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+            {
+                m_integrators[l_stage] += l_v;
+                l_v = m_integrators[l_stage];
+            }
+            l_y[l_phase] = static_cast<float>(static_cast<int32_t>(l_v)) / gain();
+        }
+        return l_y;
+    }
+
+    /** @brief  Clear the combs and the integrators
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    void CCicInterpolator<NStages,NFactor>::clear()
+    {
+        for (uint32_t l_stage = 0; l_stage < NStages; ++l_stage)
+        {
+            m_combs[l_stage] = 0;
+            m_integrators[l_stage] = 0;
+        }
+    }
+
+    /** @brief  Gain of the filter at DC
+     *
+     * @return                     NFactor^(NStages-1)
+     */
+    template <uint32_t NStages, uint32_t NFactor>
+    constexpr float CCicInterpolator<NStages,NFactor>::gain()
+    {
+        float l_gain = 1.0f;
+        for (uint32_t l_stage = 1; l_stage < NStages; ++l_stage)
+        {
+            l_gain *= NFactor;
+        }
+        return l_gain;
+    }
+
+}; // namespace signal::filter::lti::siso
+
+#endif // MULTIRATE_TPP
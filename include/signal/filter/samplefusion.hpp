@@ -0,0 +1,130 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    samplefusion.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the alignment of the
+  *          multi-rate timestamped samples to the control tick.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef SAMPLE_FUSION_HPP
+#define SAMPLE_FUSION_HPP
+
+#include <mbed.h>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace signal::filter
+{
+    /** @brief Timestamped sample of a fused source */
+    struct SFusionSample{
+        /** @brief Timestamp of the sample in microsecond, the time base of the board clock */
+        uint32_t m_timestamp;
+        /** @brief Value of the sample */
+        float m_value;
+    };
+
+    /** @brief Status of an aligned value */
+    enum EFusionStatus{
+        FUSION_NONE         = 0,                            /**< no sample since the start, the value is zero */
+        FUSION_INTERPOLATED = 1,                            /**< the timestamp is between two samples */
+        FUSION_EXTRAPOLATED = 2,                            /**< the timestamp is after the newest sample, inside the horizon */
+        FUSION_STALE        = 3                             /**< the newest (or the oldest) sample is held, it's outside the horizon */
+    };
+
+    /**
+     * @brief Fusion buffer of the sensor samples of different rates and clocks, it gives the values of all sources at the timestamp
+     * of the control tick, so the estimators of the tick see time-coherent inputs.
+     *
+     * Each source keeps its last NDepth timestamped samples in a ring with a sequence counter, like the slots of the topics: the
+     * single writer of the source (interrupt, driver task or a subscriber callback) fills the next slot and it increments the sequence,
+     * the reader checks the sequence after the copy. The sources can be pushed by 'write' or polled at the tick by their callback.
+     * The value at a timestamp is the linear interpolation of the neighbouring samples or the extrapolation by the slope of the two
+     * newest samples, the search goes back at most NDepth slots from the newest one, so the alignment costs O(1). The extrapolation
+     * is limited by the horizon of the source, after it the newest value is held and it's marked as stale.
+     *
+     * As a stage of the pipeline it polls the sources and it aligns all of them to the tick, the following stages read the cached
+     * values. The 'FUSE' key responses 'value;status;age us;' of each source.
+     *
+     * @tparam NSources Number of the sources
+     * @tparam NDepth   Number of the slots of a source, a power of two, the newest NDepth-1 samples are readable
+     */
+    template <uint8_t NSources, uint8_t NDepth = 4>
+    class CSampleFusion
+    {
+        static_assert(NDepth >= 4 && (NDepth & (NDepth - 1)) == 0, "The depth has to be a power of two, at least four.");
+        public:
+            /** @brief Poll of a source, it gives the newest sample and it returns true, when it wasn't given yet */
+            typedef mbed::Callback<bool(SFusionSample&)> FPoll;
+
+            /** @brief Configuration of a source */
+            struct SSource{
+                /** @brief Polled at the tick, NULL for the pushed sources */
+                FPoll m_poll;
+                /** @brief Maximum extrapolation after the newest sample in microsecond */
+                uint32_t m_horizon;
+            };
+
+            /* Constructor */
+            CSampleFusion(const SSource (&f_sources)[NSources]);
+            /* Push a sample of a source, only from the writer context of the source */
+            void write(uint8_t f_source, const SFusionSample& f_sample);
+            /* Value of a source at a timestamp */
+            EFusionStatus align(uint8_t f_source, uint32_t f_timestamp, float& f_value) const;
+            /* Pipeline stage, it polls the sources and it aligns them to the tick */
+            void process(uint32_t f_timestamp);
+            /** @brief Value of a source aligned to the last tick */
+            float get(uint8_t f_source) const {return m_values[f_source];}
+            /** @brief Status of the aligned value of a source */
+            EFusionStatus getStatus(uint8_t f_source) const {return static_cast<EFusionStatus>(m_status[f_source]);}
+            /** @brief The aligned value of a source is interpolated or extrapolated inside the horizon */
+            bool isFresh(uint8_t f_source) const {return FUSION_INTERPOLATED == m_status[f_source] || FUSION_EXTRAPOLATED == m_status[f_source];}
+            /* Age of the newest sample of a source at the last tick */
+            int32_t getAge(uint8_t f_source) const;
+            /* Serial callback method */
+            void serialCallback(char const * a, char * b);
+        private:
+            /** @brief Samples of a source */
+            struct SRing{
+                /** @brief Slots, the sample of sequence 's' is in the slot 's mod NDepth' */
+                SFusionSample m_samples[NDepth];
+                /** @brief Number of the written samples */
+                volatile uint32_t m_sequence;
+            };
+            /** @brief Mask of the slot index */
+            static const uint32_t s_mask = NDepth - 1U;
+
+            /** @brief Configuration of the sources */
+            const SSource (&m_sources)[NSources];
+            /** @brief Samples of the sources */
+            SRing m_rings[NSources];
+            /** @brief Values aligned to the last tick */
+            float m_values[NSources];
+            /** @brief Status of the aligned values (EFusionStatus) */
+            uint8_t m_status[NSources];
+            /** @brief Timestamp of the last tick */
+            uint32_t m_timestamp;
+    }; // class CSampleFusion
+
+}; // namespace signal::filter
+
+#include "samplefusion.tpp"
+
+#endif // SAMPLE_FUSION_HPP
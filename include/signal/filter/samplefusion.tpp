@@ -0,0 +1,175 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    samplefusion.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the alignment of the
+  *          multi-rate timestamped samples to the control tick.
+  ******************************************************************************
+ */
+
+#ifndef SAMPLE_FUSION_TPP
+#define SAMPLE_FUSION_TPP
+
+#ifndef SAMPLE_FUSION_HPP
+#error __FILE__ should only be included from samplefusion.hpp.
+#endif // SAMPLE_FUSION_HPP
+
+namespace signal::filter
+{
+    /** @brief  CSampleFusion class constructor, the sources don't have samples.
+     *
+     * @param f_sources            configuration of the sources, it's referred, so it's a static array
+     */
+    template <uint8_t NSources, uint8_t NDepth>
+    CSampleFusion<NSources,NDepth>::CSampleFusion(const SSource (&f_sources)[NSources])
+        : m_sources(f_sources)
+        , m_rings()
+        , m_values()
+        , m_status()
+        , m_timestamp(0)
+    {
+    }
+
+    /** @brief  Push a sample of a source. The next slot is filled, then the sequence is incremented, the barrier keeps the order.
+     *
+     * @param f_source             index of the source
+     * @param f_sample             timestamped sample
+     */
+    template <uint8_t NSources, uint8_t NDepth>
+    CONTROL_RAMFUNC void CSampleFusion<NSources,NDepth>::write(uint8_t f_source, const SFusionSample& f_sample)
+    {
+        SRing& l_ring = m_rings[f_source];
+        uint32_t l_sequence = l_ring.m_sequence + 1U;
+        l_ring.m_samples[l_sequence & s_mask] = f_sample;
+        __DMB();
+        l_ring.m_sequence = l_sequence;
+    }
+
+    /** @brief  Value of a source at a timestamp. The pair of samples around the timestamp is searched from the newest one, the value
+     *  is on the line of the pair. The copy is repeated, when the writer reached the copied slots meanwhile.
+     *
+     * @param f_source             index of the source
+     * @param f_timestamp          timestamp in microsecond
+     * @param f_value              aligned value
+     * @return                     status of the value
+     */
+    template <uint8_t NSources, uint8_t NDepth>
+    CONTROL_RAMFUNC EFusionStatus CSampleFusion<NSources,NDepth>::align(uint8_t f_source, uint32_t f_timestamp, float& f_value) const
+    {
+        const SRing& l_ring = m_rings[f_source];
+        uint32_t l_sequence;
+        SFusionSample l_newer;
+        SFusionSample l_older;
+        uint32_t l_count;
+        do
+        {
+            l_sequence = l_ring.m_sequence;
+            __DMB();
+            l_count = (l_sequence < NDepth - 1U) ? l_sequence : NDepth - 1U;
+            if (0 == l_count)
+            {
+                f_value = 0.0f;
+                return FUSION_NONE;
+            }
+            l_newer = l_ring.m_samples[l_sequence & s_mask];
+            l_older = l_newer;
+            for (uint32_t l_idx = 1; l_idx < l_count; ++l_idx)
+            {
+                l_older = l_ring.m_samples[(l_sequence - l_idx) & s_mask];
+                if (static_cast<int32_t>(f_timestamp - l_older.m_timestamp) >= 0 || l_idx + 1U == l_count)
+                {
+                    break;
+                }
+                l_newer = l_older;
+            }
+            __DMB();
+        } while (l_ring.m_sequence - l_sequence + 2U > NDepth);
+
+        int32_t l_age = static_cast<int32_t>(f_timestamp - l_newer.m_timestamp);
+        int32_t l_span = static_cast<int32_t>(l_newer.m_timestamp - l_older.m_timestamp);
+        if (static_cast<int32_t>(f_timestamp - l_older.m_timestamp) < 0)
+        {
+            // Older than the readable samples
+            f_value = l_older.m_value;
+            return FUSION_STALE;
+        }
+        if (l_age > static_cast<int32_t>(m_sources[f_source].m_horizon) || l_span <= 0)
+        {
+            f_value = l_newer.m_value;
+            return (l_age > static_cast<int32_t>(m_sources[f_source].m_horizon)) ? FUSION_STALE : FUSION_EXTRAPOLATED;
+        }
+        f_value = l_newer.m_value + (l_newer.m_value - l_older.m_value) * (static_cast<float>(l_age) / l_span);
+        return (l_age > 0) ? FUSION_EXTRAPOLATED : FUSION_INTERPOLATED;
+    }
+
+    /** @brief  Pipeline stage, the polled sources write their new samples, then all sources are aligned to the tick.
+     *
+     * @param f_timestamp          timestamp of the tick in microsecond
+     */
+    template <uint8_t NSources, uint8_t NDepth>
+    CONTROL_RAMFUNC void CSampleFusion<NSources,NDepth>::process(uint32_t f_timestamp)
+    {
+        m_timestamp = f_timestamp;
+        for (uint8_t l_idx = 0; l_idx < NSources; ++l_idx)
+        {
+            SFusionSample l_sample;
+            if (m_sources[l_idx].m_poll && m_sources[l_idx].m_poll(l_sample))
+            {
+                write(l_idx, l_sample);
+            }
+            m_status[l_idx] = align(l_idx, f_timestamp, m_values[l_idx]);
+        }
+    }
+
+    /** @brief  Age of the newest sample of a source at the last tick
+     *
+     * @param f_source             index of the source
+     * @return                     age in microsecond, zero without sample
+     */
+    template <uint8_t NSources, uint8_t NDepth>
+    int32_t CSampleFusion<NSources,NDepth>::getAge(uint8_t f_source) const
+    {
+        const SRing& l_ring = m_rings[f_source];
+        uint32_t l_sequence = l_ring.m_sequence;
+        if (0 == l_sequence)
+        {
+            return 0;
+        }
+        return static_cast<int32_t>(m_timestamp - l_ring.m_samples[l_sequence & s_mask].m_timestamp);
+    }
+
+    /** @brief  Serial callback method, it responses the aligned values of the last tick: 'value;status;age us;' of each source.
+     *
+     * @param a                    input received string
+     * @param b                    output reponse message
+     */
+    template <uint8_t NSources, uint8_t NDepth>
+    void CSampleFusion<NSources,NDepth>::serialCallback(char const * a, char * b)
+    {
+        utils::fmt::CWriter l_writer(b);
+        for (uint8_t l_idx = 0; l_idx < NSources; ++l_idx)
+        {
+            l_writer.fixed(m_values[l_idx],3).udec(m_status[l_idx]).dec(getAge(l_idx));
+        }
+        l_writer.chr(';');
+    }
+
+}; // namespace signal::filter
+
+#endif // SAMPLE_FUSION_TPP
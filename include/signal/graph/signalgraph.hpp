@@ -0,0 +1,168 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SignalGraph.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the signal graph
+  *          instantiated from a binary configuration.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef SIGNAL_GRAPH_HPP
+#define SIGNAL_GRAPH_HPP
+
+#include <mbed.h>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/config/blobstore.hpp>
+
+namespace signal::graph{
+
+   /**
+    * @brief Graph of signal stages (filters, controllers, converters, observers) described by a compact binary configuration, it's
+    * instantiated at the boot and it's a stage of the control pipeline.
+    *
+    * The signals of the graph are the sources (getters bound at compile time, e.g. the encoder speed, the motor current) and the outputs
+    * of the nodes, the signal with index i < sources is a source, above it the output of the node i - sources. The configuration:
+    *  node count (u8), output count (u8), for each node: kind (u8), first input (u8), second input (u8, 0xFF unused), number
+    *  of the parameters (u8), parameters (float, little-endian), then the signal index of each output (u8).
+    * The nodes are constructed by placement in a static arena in topological order of their connections, the cycles are refused. Each
+    * tick reads the sources and applies the flat array of the nodes, so a node costs one indirect call, the wrapped filter or controller
+    * is applied by a qualified call. The nodes aren't destroyed, the graph is constructed once before the control loop.
+    *
+    * The kinds and their parameters:
+    *  NODE_GAIN (a, b, c): a*x0 + b*x1 + c, the unused second input is zero;
+    *  NODE_BIQUAD (b0, b1, b2, a1, a2): second order IIR filter (lti::siso::CIIRFilter);
+    *  NODE_MEDIAN: median of 5 samples (nlti::siso::CMedianFilter);
+    *  NODE_PID (kp, ki, kd, tf): pid controller of the error x0 (controllers::siso::CPidController);
+    *  NODE_SPLINE (2 breaks, 3 x 2 coefficients): piecewise linear converter (controllers::CConverterSpline);
+    *  NODE_SLEW (step), NODE_DEADZONE (width), NODE_HYSTERESIS (low, high): nonlinear filters of nlti::siso;
+    *  NODE_RATE: rate of change per second, the observer of the derivative (nlti::siso::CRateFilter).
+    *
+    * The configuration is persisted by the blob store, it's uploaded in hexadecimal chunks, checked by a dry instantiation (kinds,
+    * parameters, connections, arena) and saved, it's applied at the next reset. The outputs are read by the serial interface.
+    *
+    * Commands of the 'SGRF' key: '0' state ('loaded;nodes;arena bytes;stored bytes;;'), '1;output' value of an output, '2;offset;hex'
+    * upload a chunk, '3;length' check and save the uploaded configuration.
+    */
+    class CSignalGraph: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief Getter of a source signal */
+        typedef mbed::Callback<float()> FSourceGetter;
+        /** @brief Kinds of the nodes */
+        enum ENodeKind{
+            NODE_GAIN       = 1,
+            NODE_BIQUAD     = 2,
+            NODE_MEDIAN     = 3,
+            NODE_PID        = 4,
+            NODE_SPLINE     = 5,
+            NODE_SLEW       = 6,
+            NODE_DEADZONE   = 7,
+            NODE_HYSTERESIS = 8,
+            NODE_RATE       = 9
+        };
+        /**
+         * @brief Node of the graph, it reads its inputs and writes its output in the signal array of the graph.
+         */
+        class INode
+        {
+        public:
+            /* Apply the node */
+            virtual void step() = 0;
+            /** @brief Inputs of the node */
+            const float*    m_inputs[2];
+            /** @brief Output of the node */
+            float*          m_output;
+        };
+        /** @brief Maximum number of the sources */
+        static const uint8_t s_maxSources = 8;
+        /** @brief Maximum number of the nodes */
+        static const uint8_t s_maxNodes = 16;
+        /** @brief Maximum number of the outputs */
+        static const uint8_t s_maxOutputs = 4;
+        /** @brief Size of the arena of the nodes in byte */
+        static const uint32_t s_arenaSize = 2048;
+        /** @brief Index of the unused input */
+        static const uint8_t s_unused = 0xFF;
+
+        /* Constructor */
+        CSignalGraph(float f_period, const FSourceGetter* f_sources, uint8_t f_sourceCount, utils::config::CBlobStore& f_store);
+        /* Instantiate the stored configuration */
+        bool load();
+        /* Instantiate a configuration */
+        bool load(const uint8_t* f_blob, uint32_t f_length);
+        /* Check a configuration without instantiation */
+        bool check(const uint8_t* f_blob, uint32_t f_length) const;
+        /* Pipeline stage, it applies the nodes */
+        virtual void process(uint32_t f_timestamp);
+        /* Value of an output */
+        float getOutput(uint8_t f_idx) const;
+        /** @brief The graph is instantiated */
+        bool isLoaded() const
+        {
+            return m_isLoaded;
+        }
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief Parsed description of a node */
+        struct SNode{
+            uint8_t         m_kind;         /** kind of the node */
+            uint8_t         m_inputs[2];    /** signal indices of the inputs */
+            const uint8_t*  m_params;       /** parameters in the configuration */
+        };
+        /* Parse the configuration and sort the nodes */
+        bool parse(const uint8_t* f_blob, uint32_t f_length, SNode* f_nodes, uint8_t* f_order, uint8_t& f_nodeCount
+                  ,const uint8_t*& f_outputs, uint8_t& f_outputCount, uint32_t& f_arena) const;
+        /* Construct a node in the arena */
+        INode* create(const SNode& f_node);
+
+        /** @brief Sampling period */
+        const float                     m_period;
+        /** @brief Getters of the sources */
+        const FSourceGetter*            m_sources;
+        /** @brief Number of the sources */
+        const uint8_t                   m_sourceCount;
+        /** @brief Store of the configuration */
+        utils::config::CBlobStore&      m_store;
+        /** @brief Nodes in order of application */
+        INode*                          m_nodes[s_maxNodes];
+        /** @brief Number of the nodes */
+        uint8_t                         m_nodeCount;
+        /** @brief Signals of the sources, then the outputs of the nodes */
+        float                           m_signals[s_maxSources + s_maxNodes];
+        /** @brief Zero value of the unused inputs */
+        float                           m_zero;
+        /** @brief Signal indices of the outputs */
+        uint8_t                         m_outputs[s_maxOutputs];
+        /** @brief Number of the outputs */
+        uint8_t                         m_outputCount;
+        /** @brief Used bytes of the arena */
+        uint32_t                        m_arenaUsed;
+        /** @brief The graph is instantiated */
+        bool                            m_isLoaded;
+        /** @brief Uploaded configuration */
+        uint8_t                         m_upload[utils::config::CBlobStore::s_maxLength];
+        /** @brief Arena of the nodes */
+        alignas(8) uint8_t              m_arena[s_arenaSize];
+    };
+
+}; // namespace signal::graph
+
+#endif // SIGNAL_GRAPH_HPP
@@ -0,0 +1,113 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    discretization.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the declaration of the compile-time discretization 
+  *          of the continuous transfer functions and state space models.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef DISCRETIZATION_HPP
+#define DISCRETIZATION_HPP
+
+#include <stdint.h>
+#include <signal/systemmodels/systemmodels.hpp>
+
+namespace signal::systemmodels::lti
+{
+    /** @brief Substitution of the Laplace variable by the discretization of a transfer function */
+    enum EDiscretization
+    {
+        FORWARD_EULER,          /**< s = (z-1)/dt */
+        BACKWARD_EULER,         /**< s = (z-1)/(z*dt) */
+        TUSTIN,                 /**< s = 2/dt*(z-1)/(z+1) */
+        PREWARPED_TUSTIN        /**< s = w/tan(w*dt/2)*(z-1)/(z+1), the response is exact at the frequency w */
+    };
+
+    /**
+     * @brief Continuous transfer function, ratio of two polynomials of s.
+     * 
+     * The coefficient of s^k is at the index k (e.g. 1/(tau*s+1) is {{1,0},{1,tau}}), the lower order polynomial is padded by zeros.
+     * 
+     * @tparam N        number of the coefficients, the order of the transfer function plus one
+     */
+    template <uint32_t N>
+    struct SContinuousTransferFunction
+    {
+        /** @brief Coefficients of the numerator */
+        double m_num[N];
+        /** @brief Coefficients of the denominator */
+        double m_den[N];
+    };
+
+    /**
+     * @brief Coefficients of the discrete transfer function of z^-1, the coefficient of z^-k is at the index k and the first 
+     * coefficient of the denominator is normalized to one, as applied by siso::CDiscreteTransferFunction.
+     * 
+     * @tparam N        number of the coefficients
+     */
+    template <uint32_t N>
+    struct SDiscreteCoefficients
+    {
+        /** @brief Coefficients of the numerator */
+        double m_num[N];
+        /** @brief Coefficients of the denominator */
+        double m_den[N];
+    };
+
+    /**
+     * @brief Matrices of a state space model, dx/dt = A*x + B*u for the continuous and x[k+1] = A*x[k] + B*u[k] for the discrete model.
+     * The output equation doesn't depend on the discretization.
+     * 
+     * @tparam NA       number of the states
+     * @tparam NB       number of the inputs
+     */
+    template <uint32_t NA, uint32_t NB>
+    struct SStateSpace
+    {
+        /** @brief State transition matrix */
+        double m_a[NA][NA];
+        /** @brief Input matrix */
+        double m_b[NA][NB];
+    };
+
+    /* Discretize a continuous transfer function */
+    template <uint32_t N>
+    constexpr SDiscreteCoefficients<N> discretize(const SContinuousTransferFunction<N>& f_continuous, double f_dt, 
+                                                  EDiscretization f_method, double f_frequency = 0.0);
+    /* Discretize a continuous state space model by zero order hold */
+    template <uint32_t NA, uint32_t NB>
+    constexpr SStateSpace<NA,NB> zeroOrderHold(const SStateSpace<NA,NB>& f_continuous, double f_dt);
+
+    /* Create the transfer function by the discrete coefficients */
+    template <class T, uint32_t N>
+    constexpr siso::CDiscreteTransferFunction<T,N,N> toTransferFunction(const SDiscreteCoefficients<N>& f_discrete);
+    /* State transition matrix of a discrete model */
+    template <class T, uint32_t NA, uint32_t NB>
+    utils::linalg::CMatrix<T,NA,NA> toStateTransition(const SStateSpace<NA,NB>& f_discrete);
+    /* Input matrix of a discrete model */
+    template <class T, uint32_t NA, uint32_t NB>
+    utils::linalg::CMatrix<T,NA,NB> toInputMatrix(const SStateSpace<NA,NB>& f_discrete);
+
+}; // namespace signal::systemmodels::lti
+
+#include "discretization.tpp"
+
+#endif // DISCRETIZATION_HPP
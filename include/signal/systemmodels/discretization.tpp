@@ -0,0 +1,340 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    discretization.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the implementation of the compile-time discretization 
+  *          of the continuous transfer functions and state space models.
+  ******************************************************************************
+ */
+
+#ifndef DISCRETIZATION_TPP
+#define DISCRETIZATION_TPP
+
+#ifndef DISCRETIZATION_HPP
+#error __FILE__ should only be included from discretization.hpp.
+#endif // DISCRETIZATION_HPP
+
+namespace signal::systemmodels::lti
+{
+    /** @brief  Multiply a polynomial of z^-1 by the factor (a + b*z^-1), the highest coefficient is dropped
+     *
+     * @param f_poly               coefficients of the polynomial
+     * @param f_a                  coefficient of z^0 of the factor
+     * @param f_b                  coefficient of z^-1 of the factor
+     */
+    template <uint32_t N>
+    constexpr void multiplyFactor(double (&f_poly)[N], double f_a, double f_b)
+    {
+        for (uint32_t l_idx = N - 1; l_idx > 0; --l_idx)
+        {
+            f_poly[l_idx] = f_a * f_poly[l_idx] + f_b * f_poly[l_idx - 1];
+        }
+        f_poly[0] = f_a * f_poly[0];
+    }
+
+    /** @brief  Tangent by the series of the sine and the cosine, the argument has to be in the range (-pi/2, pi/2)
+     *
+     * @param f_x                  argument in radian
+     * @return                     tangent of the argument
+     */
+    constexpr double tangent(double f_x)
+    {
+        double l_sin = 0.0, l_cos = 0.0, l_term = 1.0;
+        for (uint32_t l_k = 0; l_k < 28; ++l_k)
+        {
+            switch (l_k % 4)
+            {
+                case 0: l_cos += l_term; break;
+                case 1: l_sin += l_term; break;
+                case 2: l_cos -= l_term; break;
+                default: l_sin -= l_term; break;
+            }
+            l_term *= f_x / (l_k + 1);
+        }
+        return l_sin / l_cos;
+    }
+
+    /** @brief  Substitute the Laplace variable in a polynomial of s, the result is multiplied by the denominator of the 
+     * substitution on the power of the order, so it's a polynomial of z^-1.
+     *
+     * @param f_s                  coefficients of s^k
+     * @param f_dt                 sampling time
+     * @param f_method             substitution
+     * @param f_gain               gain of the bilinear substitution (2/dt or w/tan(w*dt/2))
+     * @param f_z                  coefficients of z^-k
+     */
+    template <uint32_t N>
+    constexpr void substitute(const double (&f_s)[N], double f_dt, EDiscretization f_method, double f_gain, double (&f_z)[N])
+    {
+        for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+        {
+            f_z[l_idx] = 0.0;
+        }
+        for (uint32_t l_power = 0; l_power < N; ++l_power)
+        {
+            double l_term[N] = {};
+            l_term[0] = f_s[l_power];
+            for (uint32_t l_k = 0; l_k < l_power; ++l_k)
+            {
+                multiplyFactor(l_term, 1.0, -1.0);
+            }
+            for (uint32_t l_k = l_power + 1; l_k < N; ++l_k)
+            {
+                switch (f_method)
+                {
+                    case FORWARD_EULER: multiplyFactor(l_term, 0.0, f_dt); break;
+                    case BACKWARD_EULER: multiplyFactor(l_term, f_dt, 0.0); break;
+                    default: multiplyFactor(l_term, 1.0, 1.0); break;
+                }
+            }
+            if (TUSTIN == f_method || PREWARPED_TUSTIN == f_method)
+            {
+                for (uint32_t l_k = 0; l_k < l_power; ++l_k)
+                {
+                    multiplyFactor(l_term, f_gain, 0.0);
+                }
+            }
+            for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+            {
+                f_z[l_idx] += l_term[l_idx];
+            }
+        }
+    }
+
+    /** @brief  Discretize a continuous transfer function. It's constexpr, so the coefficients of a constant model are computed 
+     * by the compiler, and a change of the sampling time needs no hand derivation.
+     *
+     * The numerator and the denominator are substituted and they are normalized by the first coefficient of the denominator, 
+     * it mustn't be zero (e.g. a pure derivative isn't causal by the forward Euler's method).
+     *
+     * @param f_continuous         continuous transfer function
+     * @param f_dt                 sampling time in second
+     * @param f_method             discretization method
+     * @param f_frequency          frequency of the prewarping in rad/s, below the Nyquist frequency (pi/dt)
+     * @return                     coefficients of the discrete transfer function
+     */
+    template <uint32_t N>
+    constexpr SDiscreteCoefficients<N> discretize(const SContinuousTransferFunction<N>& f_continuous, double f_dt, 
+                                                  EDiscretization f_method, double f_frequency)
+    {
+        double l_gain = 2.0 / f_dt;
+        if (PREWARPED_TUSTIN == f_method && f_frequency > 0.0)
+        {
+            l_gain = f_frequency / tangent(f_frequency * f_dt / 2.0);
+        }
+        SDiscreteCoefficients<N> l_discrete = {};
+        substitute(f_continuous.m_num, f_dt, f_method, l_gain, l_discrete.m_num);
+        substitute(f_continuous.m_den, f_dt, f_method, l_gain, l_discrete.m_den);
+        const double l_norm = l_discrete.m_den[0];
+        for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+        {
+            l_discrete.m_num[l_idx] /= l_norm;
+            l_discrete.m_den[l_idx] /= l_norm;
+        }
+        return l_discrete;
+    }
+
+    /** @brief  Product of two square matrices
+     *
+     * @param f_a                  left matrix
+     * @param f_b                  right matrix
+     * @param f_result             product, it can't be the same as the operands
+     */
+    template <uint32_t N>
+    constexpr void multiplyMatrix(const double (&f_a)[N][N], const double (&f_b)[N][N], double (&f_result)[N][N])
+    {
+        for (uint32_t l_row = 0; l_row < N; ++l_row)
+        {
+            for (uint32_t l_col = 0; l_col < N; ++l_col)
+            {
+                double l_sum = 0.0;
+                for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+                {
+                    l_sum += f_a[l_row][l_idx] * f_b[l_idx][l_col];
+                }
+                f_result[l_row][l_col] = l_sum;
+            }
+        }
+    }
+
+    /** @brief  Matrix exponential by scaling and squaring: the matrix is scaled below 0.5 norm, the exponential of the scaled 
+     * matrix is calculated by the Taylor series (error below 1e-14) and it's squared back.
+     *
+     * @param f_matrix             matrix
+     * @param f_result             exponential of the matrix
+     */
+    template <uint32_t N>
+    constexpr void exponential(const double (&f_matrix)[N][N], double (&f_result)[N][N])
+    {
+        double l_norm = 0.0;
+        for (uint32_t l_row = 0; l_row < N; ++l_row)
+        {
+            double l_sum = 0.0;
+            for (uint32_t l_col = 0; l_col < N; ++l_col)
+            {
+                l_sum += (f_matrix[l_row][l_col] < 0.0) ? -f_matrix[l_row][l_col] : f_matrix[l_row][l_col];
+            }
+            l_norm = (l_sum > l_norm) ? l_sum : l_norm;
+        }
+        uint32_t l_squarings = 0;
+        double l_scale = 1.0;
+        while (l_norm * l_scale > 0.5)
+        {
+            l_scale /= 2.0;
+            ++l_squarings;
+        }
+        double l_term[N][N] = {};
+        double l_next[N][N] = {};
+        for (uint32_t l_row = 0; l_row < N; ++l_row)
+        {
+            for (uint32_t l_col = 0; l_col < N; ++l_col)
+            {
+                l_term[l_row][l_col] = (l_row == l_col) ? 1.0 : 0.0;
+                f_result[l_row][l_col] = l_term[l_row][l_col];
+            }
+        }
+        for (uint32_t l_k = 1; l_k <= 12; ++l_k)
+        {
+            multiplyMatrix(l_term, f_matrix, l_next);
+            for (uint32_t l_row = 0; l_row < N; ++l_row)
+            {
+                for (uint32_t l_col = 0; l_col < N; ++l_col)
+                {
+                    l_term[l_row][l_col] = l_next[l_row][l_col] * l_scale / l_k;
+                    f_result[l_row][l_col] += l_term[l_row][l_col];
+                }
+            }
+        }
+        for (uint32_t l_idx = 0; l_idx < l_squarings; ++l_idx)
+        {
+            multiplyMatrix(f_result, f_result, l_next);
+            for (uint32_t l_row = 0; l_row < N; ++l_row)
+            {
+                for (uint32_t l_col = 0; l_col < N; ++l_col)
+                {
+                    f_result[l_row][l_col] = l_next[l_row][l_col];
+                }
+            }
+        }
+    }
+
+    /** @brief  Discretize a continuous state space model by zero order hold of the input, the discrete model is exact for the 
+     * piecewise constant inputs. The exponential of the augmented matrix dt*[A B; 0 0] gives [Ad Bd; 0 I].
+     *
+     * @param f_continuous         continuous model
+     * @param f_dt                 sampling time in second
+     * @return                     discrete model
+     */
+    template <uint32_t NA, uint32_t NB>
+    constexpr SStateSpace<NA,NB> zeroOrderHold(const SStateSpace<NA,NB>& f_continuous, double f_dt)
+    {
+        double l_augmented[NA+NB][NA+NB] = {};
+        for (uint32_t l_row = 0; l_row < NA; ++l_row)
+        {
+            for (uint32_t l_col = 0; l_col < NA; ++l_col)
+            {
+                l_augmented[l_row][l_col] = f_continuous.m_a[l_row][l_col] * f_dt;
+            }
+            for (uint32_t l_col = 0; l_col < NB; ++l_col)
+            {
+                l_augmented[l_row][NA + l_col] = f_continuous.m_b[l_row][l_col] * f_dt;
+            }
+        }
+        double l_exponential[NA+NB][NA+NB] = {};
+        exponential(l_augmented, l_exponential);
+        SStateSpace<NA,NB> l_discrete = {};
+        for (uint32_t l_row = 0; l_row < NA; ++l_row)
+        {
+            for (uint32_t l_col = 0; l_col < NA; ++l_col)
+            {
+                l_discrete.m_a[l_row][l_col] = l_exponential[l_row][l_col];
+            }
+            for (uint32_t l_col = 0; l_col < NB; ++l_col)
+            {
+                l_discrete.m_b[l_row][l_col] = l_exponential[l_row][NA + l_col];
+            }
+        }
+        return l_discrete;
+    }
+
+    /** @brief  Column vector of the coefficients converted to the type of the variables
+     *
+     * @param f_coefficients       coefficients
+     * @return                     column vector
+     */
+    template <class T, uint32_t N, size_t... I>
+    constexpr utils::linalg::CMatrix<T,N,1> toColumn(const double (&f_coefficients)[N], std::index_sequence<I...>)
+    {
+        return utils::linalg::CMatrix<T,N,1>(typename utils::linalg::CMatrix<T,N,1>::CContainerType{{std::array<T,1>{{T(f_coefficients[I])}}...}});
+    }
+
+    /** @brief  Create the transfer function by the discrete coefficients, they are converted to the type of the variables. It's 
+     * constexpr, so the transfer function of constant coefficients is calculated by the compiler.
+     *
+     * @param f_discrete           coefficients of the discrete transfer function
+     * @return                     transfer function
+     */
+    template <class T, uint32_t N>
+    constexpr siso::CDiscreteTransferFunction<T,N,N> toTransferFunction(const SDiscreteCoefficients<N>& f_discrete)
+    {
+        return siso::CDiscreteTransferFunction<T,N,N>(toColumn<T,N>(f_discrete.m_num, std::make_index_sequence<N>())
+                                                     ,toColumn<T,N>(f_discrete.m_den, std::make_index_sequence<N>()));
+    }
+
+    /** @brief  State transition matrix of a discrete model, converted to the type of the variables
+     *
+     * @param f_discrete           discrete model
+     * @return                     state transition matrix
+     */
+    template <class T, uint32_t NA, uint32_t NB>
+    utils::linalg::CMatrix<T,NA,NA> toStateTransition(const SStateSpace<NA,NB>& f_discrete)
+    {
+        utils::linalg::CMatrix<T,NA,NA> l_matrix;
+        for (uint32_t l_row = 0; l_row < NA; ++l_row)
+        {
+            for (uint32_t l_col = 0; l_col < NA; ++l_col)
+            {
+                l_matrix[l_row][l_col] = T(f_discrete.m_a[l_row][l_col]);
+            }
+        }
+        return l_matrix;
+    }
+
+    /** @brief  Input matrix of a discrete model, converted to the type of the variables
+     *
+     * @param f_discrete           discrete model
+     * @return                     input matrix
+     */
+    template <class T, uint32_t NA, uint32_t NB>
+    utils::linalg::CMatrix<T,NA,NB> toInputMatrix(const SStateSpace<NA,NB>& f_discrete)
+    {
+        utils::linalg::CMatrix<T,NA,NB> l_matrix;
+        for (uint32_t l_row = 0; l_row < NA; ++l_row)
+        {
+            for (uint32_t l_col = 0; l_col < NB; ++l_col)
+            {
+                l_matrix[l_row][l_col] = T(f_discrete.m_b[l_row][l_col]);
+            }
+        }
+        return l_matrix;
+    }
+
+}; // namespace signal::systemmodels::lti
+
+#endif // DISCRETIZATION_TPP
@@ -0,0 +1,127 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    MotorIdentifier.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the online identification
+  *          of the motor model.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef MOTOR_IDENTIFIER_HPP
+#define MOTOR_IDENTIFIER_HPP
+
+#include <mbed.h>
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <signal/systemmodels/recursiveleastsquares.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace signal::systemmodels{
+
+   /**
+    * @brief Online identification of the first order model of the drive from the control voltage and the measured speed, a stage of
+    * the control pipeline.
+    *
+    * The discrete model of a sample is w[k] = a*w[k-1] + b*u[k-1] + c*sign(w[k-1]), where u is the mean control voltage of the
+    * sample and the constant c is the voltage lost by the friction. The parameters are estimated by the recursive least squares
+    * with forgetting, so they follow the drift of the battery voltage and of the temperature. The speed is scaled by the nominal
+    * static gain, so the regressors have the same magnitude. A sample is applied only, when the motor was driven in all its ticks
+    * by the voltage of the speed controller (not in open loop, not with the current loop).
+    *
+    * The estimated model is given by the static gain (rps/V), the time constant (s) and the friction voltage (V). It's valid,
+    * when the parameters are stable and positive and the trace of the covariance is small (the samples excited the model), so the
+    * feed-forward and the gains of the speed controller can be calculated from it.
+    */
+    class CMotorIdentifier: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief Continuous first order model of the drive */
+        struct SModel{
+            /** @brief Static gain (rps/V) */
+            float m_gain;
+            /** @brief Time constant (s) */
+            float m_timeConstant;
+            /** @brief Voltage of the friction, the static offset of the feed-forward (V) */
+            float m_offset;
+        };
+        /** @brief Number of the applied samples before a valid model */
+        static const uint32_t s_minUpdates = 100;
+        /** @brief Limit of the trace of the covariance of a valid model */
+        static constexpr float s_validTrace = 0.5f;
+        /** @brief Initial diagonal value of the covariance */
+        static constexpr float s_initialCovariance = 10.0f;
+        /** @brief Minimum absolute mean voltage of an applied sample (V) */
+        static constexpr float s_minVoltage = 0.05f;
+
+        /* Constructor */
+        CMotorIdentifier(float                                  f_period
+                        ,hardware::encoders::IEncoderGetter&    f_encoder
+                        ,uint32_t                               f_divider
+                        ,float                                  f_forgetting
+                        ,const SModel&                          f_nominal);
+        /* Set the getter of the control voltage */
+        void setInput(mbed::Callback<float()> f_voltage);
+        /* Pipeline stage */
+        virtual void process(uint32_t f_timestamp);
+        /* Get the estimated model, it returns false, when it isn't valid */
+        bool getModel(SModel& f_model) const;
+        /* Restart the estimation from the nominal model */
+        void reset();
+        /* Serial callback of the estimated model */
+        void serialCallback(char const * a, char * b);
+
+    private:
+        using CEstimatorType = CRecursiveLeastSquares<float,3>;
+        /* Discrete parameters of a model */
+        CEstimatorType::CParametersType parameters(const SModel& f_model) const;
+        /* Publish the continuous model of the estimated parameters */
+        void publish();
+
+        /* Encoder of the motor */
+        hardware::encoders::IEncoderGetter&     m_encoder;
+        /* Control voltage of the last tick */
+        mbed::Callback<float()>                 m_voltage;
+        /* Sampling time of the model (s) */
+        const float                             m_dt;
+        /* Number of the ticks per sample */
+        const uint32_t                          m_divider;
+        /* Nominal model, the initial parameters */
+        const SModel                            m_nominal;
+        /* Estimator of the discrete parameters */
+        CEstimatorType                          m_estimator;
+        /* Counter of the ticks of the sample */
+        uint32_t                                m_tick;
+        /* Sum of the voltages of the sample */
+        float                                   m_voltageSum;
+        /* All ticks of the sample were driven */
+        bool                                    m_isDriven;
+        /* Scaled speed at the start of the sample */
+        float                                   m_prevSpeed;
+        /* The speed of the previous sample is known */
+        bool                                    m_hasPrev;
+        /* Estimated continuous model */
+        SModel                                  m_model;
+        /* The estimated model is valid */
+        bool                                    m_isValid;
+        /* Restart requested by the serial callback, it's applied in the next tick */
+        volatile bool                           m_resetRequest;
+    }; // class CMotorIdentifier
+}; // namespace signal::systemmodels
+
+#endif // MOTOR_IDENTIFIER_HPP
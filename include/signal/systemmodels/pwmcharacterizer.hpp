@@ -0,0 +1,182 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    PwmCharacterizer.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the characterization
+  *          of the drive over the pwm frequency and the duty cycle.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef PWM_CHARACTERIZER_HPP
+#define PWM_CHARACTERIZER_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/dcmotor.hpp>
+#include <hardware/encoders/encoderinterfaces.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace signal::systemmodels{
+
+   /**
+    * @brief Characterization of the drive over a grid of pwm frequencies and duty cycles, it's placed between the controllers and the
+    * motor driver and it's a stage of the control pipeline.
+    *
+    * The sweep drives the motor in open loop: for each frequency the duty cycles are applied in increasing order, each point is held
+    * for the settling time, then the speed, the motor current and the battery power are averaged over the measuring time. The result
+    * of a point is the mean speed, the mean current, the standard deviation of the current over the ticks (the ripple seen by the
+    * control loop, the ripple inside the pwm period is filtered by the sampling), the mean power, the speed per ampere and the speed per
+    * watt. With a constant load the torque follows the speed, so the speed per ampere is the proxy of the torque per ampere and the
+    * frequency with the highest mean of it over the duty cycles is the best one. At the end the original frequency is restored and the
+    * motor is braked, the best frequency is applied only by request.
+    *
+    * The sweep starts only, while the guard allows it (the robot is in the hard brake state, the bridge isn't tripped), the wheels have
+    * to be lifted. Any command of the controllers, a trip or the leave of the guard stops it in the same tick, the command is forwarded.
+    *
+    * Commands of the 'PWMC' key: '0' state ('state;point;points;best frequency;;'), '1;fmin;fmax;nf;dmin;dmax;nd' start (frequencies in
+    * Hz, duty cycles in percent, at most s_maxFrequencies x s_maxDuties points), '2;index' result of a point ('frequency;duty;speed;current;
+    * ripple;power;speed per ampere;speed per watt;;'), '3' apply the best frequency, '4' stop.
+    */
+    class CPwmCharacterizer: public hardware::drivers::IMotorCommand, public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief Getter of a measured value */
+        typedef mbed::Callback<float()> FValueGetter;
+        /** @brief Setter of the pwm frequency, false when the frequency isn't applied */
+        typedef mbed::Callback<bool(float)> FFrequencySetter;
+        /** @brief Guard of the sweep, true when the drive can be characterized */
+        typedef mbed::Callback<bool()> FGuard;
+        /** @brief State of the sweep */
+        enum EState{
+            IDLE = 0,
+            RUNNING = 1,
+            FINISHED = 2,
+            FAILED = 3
+        };
+        /** @brief Result of a point of the grid */
+        struct SPoint{
+            float m_frequency;      /** pwm frequency (Hz) */
+            float m_duty;           /** duty cycle in interval [0,1] */
+            float m_speed;          /** mean speed (rps) */
+            float m_current;        /** mean motor current (A) */
+            float m_ripple;         /** standard deviation of the current (A) */
+            float m_power;          /** mean battery power (W) */
+        };
+        /** @brief Maximum number of the frequencies */
+        static const uint8_t s_maxFrequencies = 8;
+        /** @brief Maximum number of the duty cycles */
+        static const uint8_t s_maxDuties = 4;
+
+        /* Constructor */
+        CPwmCharacterizer(float                                 f_period
+                         ,hardware::encoders::IEncoderGetter&   f_encoder
+                         ,hardware::drivers::ICurrentGetter&    f_current
+                         ,hardware::drivers::IMotorCommand&     f_motor
+                         ,float                                 f_settleTime = 0.5f
+                         ,float                                 f_measureTime = 1.0f);
+        /* Attach the power getter, the frequency interface and the guard */
+        void setInputs(FValueGetter f_power, FValueGetter f_frequency, FFrequencySetter f_setFrequency, FGuard f_guard);
+        /* Pipeline stage, it steps the sweep */
+        virtual void process(uint32_t f_timestamp);
+        /* Start the sweep */
+        bool start(float f_minFrequency, float f_maxFrequency, uint8_t f_frequencies, float f_minDuty, float f_maxDuty, uint8_t f_duties);
+        /* Stop the sweep */
+        void stop();
+        /* Apply the best frequency of the last sweep */
+        bool applyBest();
+        /** @brief State of the sweep */
+        EState getState() const
+        {
+            return m_state;
+        }
+        /** @brief Best frequency of the last sweep in Hz, zero without result */
+        float getBestFrequency() const
+        {
+            return m_bestFrequency;
+        }
+        /* Set the pwm, the sweep is stopped */
+        void setSpeed(float f_pwm);
+        /* Brake the motor, the sweep is stopped */
+        void brake();
+        /* Inverse direction, the sweep is stopped */
+        void inverseDirection(float f_pwm);
+        /* Coast the motor, the sweep is stopped */
+        void coast();
+        /* Proportional dynamic braking, the sweep is stopped */
+        void dynamicBrake(float f_duty);
+        /* Check the range of the pwm */
+        bool inRange(float f_pwm);
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Finish the sweep */
+        void finish(EState f_state);
+        /* Apply the next point of the grid */
+        bool applyPoint();
+        /* Select the best frequency */
+        void evaluate();
+
+        /** @brief Speed feedback of the motor */
+        hardware::encoders::IEncoderGetter&     m_encoder;
+        /** @brief Current of the motor */
+        hardware::drivers::ICurrentGetter&      m_current;
+        /** @brief Motor driver */
+        hardware::drivers::IMotorCommand&       m_motor;
+        /** @brief Getter of the battery power */
+        FValueGetter                            m_power;
+        /** @brief Getter of the pwm frequency */
+        FValueGetter                            m_frequency;
+        /** @brief Setter of the pwm frequency */
+        FFrequencySetter                        m_setFrequency;
+        /** @brief Guard of the sweep */
+        FGuard                                  m_guard;
+        /** @brief Number of the settling ticks of a point */
+        const uint32_t                          m_settleTicks;
+        /** @brief Number of the measuring ticks of a point */
+        const uint32_t                          m_measureTicks;
+        /** @brief Results of the grid */
+        SPoint                                  m_points[s_maxFrequencies * s_maxDuties];
+        /** @brief Number of the frequencies of the grid */
+        uint8_t                                 m_frequencies;
+        /** @brief Number of the duty cycles of the grid */
+        uint8_t                                 m_duties;
+        /** @brief Index of the active point */
+        volatile uint8_t                        m_point;
+        /** @brief Ticks of the active point */
+        uint32_t                                m_ticks;
+        /** @brief Sums of the measuring ticks */
+        float                                   m_sumSpeed;
+        float                                   m_sumCurrent;
+        float                                   m_sumSquare;
+        float                                   m_sumPower;
+        /** @brief Frequency before the sweep */
+        float                                   m_originalFrequency;
+        /** @brief Best frequency of the last sweep */
+        volatile float                          m_bestFrequency;
+        /** @brief State of the sweep */
+        volatile EState                         m_state;
+        /** @brief The stop is requested, it's applied by the next tick */
+        volatile bool                           m_stopRequest;
+        /** @brief Lowest mean current of a scored point (A), below it the speed per ampere isn't meaningful */
+        static constexpr float s_minCurrent = 0.05f;
+    };
+
+}; // namespace signal::systemmodels
+
+#endif // PWM_CHARACTERIZER_HPP
@@ -0,0 +1,93 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    RecursiveLeastSquares.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the recursive least
+  *          squares estimator with forgetting factor.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef RECURSIVE_LEAST_SQUARES_HPP
+#define RECURSIVE_LEAST_SQUARES_HPP
+
+#include <cmath>
+#include <utils/linalg/linalg.h>
+
+namespace signal::systemmodels
+{
+   /**
+    * @brief Recursive least squares estimator of a linear regression (y = phi^T * theta) with exponential forgetting.
+    *
+    * Each update applies one regressor and one measured value, the gain is calculated from the covariance without inverse matrix:
+    *  k = P*phi / (lambda + phi^T*P*phi), theta += k*(y - phi^T*theta), P = (P - k*(P*phi)^T) / lambda
+    * The covariance is symmetric, so only the product P*phi is calculated and the update costs O(N^2) operations. The upper
+    * triangle is calculated and mirrored, so the rounding errors don't make it asymmetric.
+    *
+    * Without excitation the forgetting divides the covariance in each update (windup), so the regressors of the next change
+    * would produce great steps. The forgetting is suspended, while the trace of the covariance is above its limit.
+    *
+    * @tparam T        type of the variables
+    * @tparam N        number of the parameters
+    */
+    template <class T, uint32_t N>
+    class CRecursiveLeastSquares
+    {
+        public:
+            using CParametersType = utils::linalg::CColVector<T,N>;
+            using CRegressorType = utils::linalg::CColVector<T,N>;
+            using CCovarianceType = utils::linalg::CMatrix<T,N,N>;
+
+            /* Constructor */
+            CRecursiveLeastSquares(const CParametersType& f_parameters, T f_covariance, T f_forgetting, T f_maxTrace);
+            /* Update by a regressor and a measured value */
+            T update(const CRegressorType& f_regressor, const T& f_measurement);
+            /* Restart from the given parameters with the initial covariance */
+            void reset(const CParametersType& f_parameters);
+            /* Predicted value of a regressor */
+            T predict(const CRegressorType& f_regressor) const;
+
+            /** @brief Estimated parameters */
+            const CParametersType& parameters() const {return m_parameters;}
+            /** @brief Covariance of the estimated parameters (scaled by the variance of the noise) */
+            const CCovarianceType& covariance() const {return m_covariance;}
+            /** @brief Trace of the covariance, it's small, when the parameters are well excited */
+            T trace() const;
+            /** @brief Number of the updates since the last reset */
+            uint32_t updates() const {return m_updates;}
+
+        private:
+            /* estimated parameters */
+            CParametersType m_parameters;
+            /* covariance of the parameters */
+            CCovarianceType m_covariance;
+            /* initial diagonal value of the covariance */
+            const T m_initialCovariance;
+            /* forgetting factor (lambda), 1 without forgetting */
+            const T m_forgetting;
+            /* trace limit of the forgetting */
+            const T m_maxTrace;
+            /* number of the updates */
+            uint32_t m_updates;
+    }; // class CRecursiveLeastSquares
+}; // namespace signal::systemmodels
+
+#include "recursiveleastsquares.tpp"
+
+#endif // RECURSIVE_LEAST_SQUARES_HPP
@@ -0,0 +1,132 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    RecursiveLeastSquares.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the recursive least
+  *          squares estimator with forgetting factor.
+  ******************************************************************************
+ */
+
+#ifndef RECURSIVE_LEAST_SQUARES_TPP
+#define RECURSIVE_LEAST_SQUARES_TPP
+
+#ifndef RECURSIVE_LEAST_SQUARES_HPP
+#error __FILE__ should only be included from recursiveleastsquares.hpp.
+#endif // RECURSIVE_LEAST_SQUARES_HPP
+
+/** @brief  CRecursiveLeastSquares class constructor
+ *
+ *  @param f_parameters             initial parameters
+ *  @param f_covariance             initial diagonal value of the covariance, the great values trust less the initial parameters
+ *  @param f_forgetting             forgetting factor in interval (0,1], the memory is about 1/(1-lambda) updates
+ *  @param f_maxTrace               above this trace of the covariance the forgetting is suspended
+ */
+template <class T, uint32_t N>
+signal::systemmodels::CRecursiveLeastSquares<T,N>::CRecursiveLeastSquares(const CParametersType& f_parameters, T f_covariance, T f_forgetting, T f_maxTrace)
+    : m_parameters(f_parameters)
+    , m_covariance()
+    , m_initialCovariance(f_covariance)
+    , m_forgetting(f_forgetting)
+    , m_maxTrace(f_maxTrace)
+    , m_updates(0)
+{
+    reset(f_parameters);
+}
+
+/** @brief  Restart the estimation from the given parameters, the covariance is set to the initial diagonal matrix
+ *
+ *  @param f_parameters             initial parameters
+ */
+template <class T, uint32_t N>
+void signal::systemmodels::CRecursiveLeastSquares<T,N>::reset(const CParametersType& f_parameters)
+{
+    m_parameters = f_parameters;
+    m_covariance = CCovarianceType::eye();
+    m_covariance *= m_initialCovariance;
+    m_updates = 0;
+}
+
+/** @brief  Update step by a regressor and the measured value
+ *
+ *  @param f_regressor              regressor (phi) of the measurement
+ *  @param f_measurement            measured value (y)
+ *  @return                         prediction error of the parameters before the update
+ */
+template <class T, uint32_t N>
+T signal::systemmodels::CRecursiveLeastSquares<T,N>::update(const CRegressorType& f_regressor, const T& f_measurement)
+{
+    T l_error = f_measurement - predict(f_regressor);
+    // P*phi, it's also the transposed phi^T*P
+    CRegressorType l_Pphi;
+    utils::linalg::gemv(l_Pphi, m_covariance, f_regressor);
+    T l_denominator = m_forgetting;
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        l_denominator += f_regressor[i][0] * l_Pphi[i][0];
+    }
+    T l_invDenominator = T(1) / l_denominator;
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        m_parameters[i][0] += l_Pphi[i][0] * l_invDenominator * l_error;
+    }
+    // The forgetting is suspended at the trace limit against the covariance windup
+    T l_scale = (trace() < m_maxTrace) ? T(1) / m_forgetting : T(1);
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        for (uint32_t j = i; j < N; ++j)
+        {
+            T l_value = (m_covariance[i][j] - l_Pphi[i][0] * l_Pphi[j][0] * l_invDenominator) * l_scale;
+            m_covariance[i][j] = l_value;
+            m_covariance[j][i] = l_value;
+        }
+    }
+    ++m_updates;
+    return l_error;
+}
+
+/** @brief  Predicted value of a regressor by the estimated parameters
+ *
+ *  @param f_regressor              regressor (phi)
+ *  @return                         phi^T*theta
+ */
+template <class T, uint32_t N>
+T signal::systemmodels::CRecursiveLeastSquares<T,N>::predict(const CRegressorType& f_regressor) const
+{
+    T l_sum = T(0);
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        l_sum += f_regressor[i][0] * m_parameters[i][0];
+    }
+    return l_sum;
+}
+
+/** @brief  Trace of the covariance
+ */
+template <class T, uint32_t N>
+T signal::systemmodels::CRecursiveLeastSquares<T,N>::trace() const
+{
+    T l_sum = T(0);
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        l_sum += m_covariance[i][i];
+    }
+    return l_sum;
+}
+
+#endif // RECURSIVE_LEAST_SQUARES_TPP
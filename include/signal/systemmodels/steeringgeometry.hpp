@@ -0,0 +1,90 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    SteeringGeometry.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the Ackermann steering
+  *          geometry by precomputed lookup tables.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef STEERING_GEOMETRY_HPP
+#define STEERING_GEOMETRY_HPP
+
+#include <mbed.h>
+
+namespace signal::systemmodels{
+
+   /**
+    * @brief Steering geometry of the kinematic bicycle model, it converts the servo angle to the curvature of the path and back, it's
+    * shared by the kinematic consumers (odometry, electronic differential, path follower, yaw rate steering).
+    *
+    * The tangent of the wheel angle and the arc tangent of the normalized curvature (wheelbase times curvature) are sampled in
+    * two tables over the range of the steering servo (0..23 degree, odd symmetry), the tables are generated by the compiler and they
+    * are placed in the flash. A lookup is a linear interpolation of two entries, the relative error is below 1e-4. Outside the
+    * range the libm functions are applied.
+    *
+    * The calibration maps the servo command to the effective wheel angle (wheel angle = gain * command + offset), so the consumers
+    * work with the commanded angles. The angles are in degree, positive to right like the servo commands, the curvature is in 1/m,
+    * positive to left (counter-clockwise turn) like the yaw of the odometry.
+    *
+    * Commands of the 'STGM' key: '0' calibration ('gain;offset;wheelbase;;'), '1;gain;offset'.
+    */
+    class CSteeringGeometry
+    {
+    public:
+        /** @brief  Range of the tables in degree, the range of the steering servo */
+        static constexpr float s_maxAngle = 23.0f;
+        /** @brief  Number of the entries of a table, 0.5 degree steps */
+        static const uint32_t s_points = 47;
+
+        /** @brief  Constructor, the calibration is neutral */
+        constexpr CSteeringGeometry(float f_wheelbase)
+            : m_wheelbase(f_wheelbase)
+            , m_invWheelbase(1.0f / f_wheelbase)
+            , m_gain(1.0f)
+            , m_offset(0.0f)
+        {
+        }
+        /* Curvature of the path of a servo angle */
+        float curvature(float f_angle) const;
+        /* Servo angle of a curvature of the path */
+        float angle(float f_curvature) const;
+        /* Set the calibration of the servo */
+        bool setCalibration(float f_gain, float f_offset);
+        /** @brief  Wheelbase in meter */
+        float getWheelbase() const
+        {
+            return m_wheelbase;
+        }
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Distance between the front and the rear axle in meter */
+        const float m_wheelbase;
+        /** @brief  Inverse of the wheelbase */
+        const float m_invWheelbase;
+        /** @brief  Gain of the servo command */
+        volatile float m_gain;
+        /** @brief  Offset of the wheel angle in degree */
+        volatile float m_offset;
+    };
+
+}; // namespace signal::systemmodels
+
+#endif // STEERING_GEOMETRY_HPP
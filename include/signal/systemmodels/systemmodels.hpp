@@ -27,43 +27,119 @@ limitations under the License.
 #ifndef SYSTEM_MODELS_HPP
 #define SYSTEM_MODELS_HPP
 
+#include <cmath>
+#include <utility>
 #include <utils/linalg/linalg.h>
+#include <utils/linalg/structured.hpp>
+#include <utils/fixedpoint/fixedpoint.hpp>
 
 // Discrete System Models
 namespace signal::systemmodels{
     //Linear time variant models
     namespace lti{
         namespace siso{
+           /**
+            * @brief Multiply-accumulate operations of the transfer function. 
+            * 
+            * The coefficient and the previous value are converted to the accumulator type before the product, the output is the sum 
+            * divided by the first denominator coefficient and converted to the type of the memory. So the float coefficients and memory 
+            * can be summed in double, the conversions are applied only once per product.
+            * 
+            * @tparam TCoef Type of the coefficients
+            * @tparam TState Type of the memory
+            * @tparam TAcc Type of the sum
+            */
+            template <class TCoef, class TState, class TAcc>
+            struct SMultiplyAccumulate{
+                /** @brief Product of a coefficient and a previous value */
+                static TAcc multiply(const TCoef& f_coef, const TState& f_value)
+                {
+                    return static_cast<TAcc>(f_coef) * static_cast<TAcc>(f_value);
+                }
+                /** @brief Output from the sum */
+                static TState output(const TAcc& f_sum, const TCoef& f_den)
+                {
+                    return static_cast<TState>(f_sum / static_cast<TAcc>(f_den));
+                }
+            };
+
+           /**
+            * @brief Multiply-accumulate operations of the fixed-point coefficients and memory with 64-bit sum of the raw products. 
+            * 
+            * The products are exact, they have NFracC + NFracS fractional bits, and they aren't saturated until the output, so the 
+            * intermediate sums can leave the range of the memory. The output is rounded and saturated, when the first denominator 
+            * coefficient is one, it's only shifted, otherwise divided. The coefficients need integer bits for the denominator (about -2), 
+            * e.g. Q31 memory with CFixedPoint<int32_t,int64_t,29> coefficients keeps the sum within 8.
+            */
+            template <class TBaseC, class TWideC, uint8_t NFracC, class TBaseS, class TWideS, uint8_t NFracS>
+            struct SMultiplyAccumulate<utils::fixedpoint::CFixedPoint<TBaseC,TWideC,NFracC>,utils::fixedpoint::CFixedPoint<TBaseS,TWideS,NFracS>,int64_t>{
+                static_assert(NFracC > 0, "The coefficients need fractional bits.");
+                /** @brief Type of the coefficients */
+                using CCoefType = utils::fixedpoint::CFixedPoint<TBaseC,TWideC,NFracC>;
+                /** @brief Type of the memory */
+                using CStateType = utils::fixedpoint::CFixedPoint<TBaseS,TWideS,NFracS>;
+                /** @brief Raw product of a coefficient and a previous value */
+                static int64_t multiply(const CCoefType& f_coef, const CStateType& f_value)
+                {
+                    return static_cast<int64_t>(f_coef.raw()) * static_cast<int64_t>(f_value.raw());
+                }
+                /** @brief Rounded and saturated output from the raw sum */
+                static CStateType output(int64_t f_sum, const CCoefType& f_den)
+                {
+                    int64_t l_raw;
+                    if (static_cast<int64_t>(f_den.raw()) == (static_cast<int64_t>(1) << NFracC))
+                    {
+                        l_raw = (f_sum + (static_cast<int64_t>(1) << (NFracC - 1))) >> NFracC;
+                    }
+                    else
+                    {
+                        l_raw = f_sum / f_den.raw();
+                    }
+                    l_raw = (l_raw > std::numeric_limits<TBaseS>::max()) ? std::numeric_limits<TBaseS>::max() : l_raw;
+                    l_raw = (l_raw < std::numeric_limits<TBaseS>::min()) ? std::numeric_limits<TBaseS>::min() : l_raw;
+                    return CStateType::fromRaw(static_cast<TBaseS>(l_raw));
+                }
+            };
+
            /**
             * @brief Transfer function in z-domain. 
             * 
             * The transfer function express by z^{-1} and is represented by ratio of two polynomials. 
             * 
-            * @tparam T The type of the coefficients
+            * The previous values are stored in mirrored circular buffers: each value is written at the index and at the index plus 
+            * the size of the memory, so the last values are always contiguous from the index and the memory isn't shifted.
+            * 
+            * The coefficients, the memory and the sum of the products can have different types, so the precision is paid only where 
+            * it's needed: e.g. float coefficients and memory with double sum for a filter with poles near the unit circle, or Q31 
+            * memory with 64-bit sum (SMultiplyAccumulate). By default all of them are T.
+            * 
+            * @tparam T The type of the signal and of the memory
             * @tparam NNum The order of the polynomial in nominator 
             * @tparam NDen The order of the polynomial in denominator
+            * @tparam TCoef The type of the coefficients
+            * @tparam TAcc The type of the sum of the products
             */
-            template <class T,uint32_t NNum,uint32_t NDen>
+            template <class T,uint32_t NNum,uint32_t NDen,class TCoef = T,class TAcc = T>
             class CDiscreteTransferFunction{
                 public:
-                    using CDenType          =   utils::linalg::CMatrix<T,NDen,1>; // Type of the full denominator coefficients
-                    using CDenModType       =   utils::linalg::CMatrix<T,NDen-1,1>; // Type of the denominator coefficients without the first coefficient
-                    using CNumType          =   utils::linalg::CMatrix<T,NNum,1>; // Type of the full nominator coefficients
+                    using CDenType          =   utils::linalg::CMatrix<TCoef,NDen,1>; // Type of the full denominator coefficients
+                    using CDenModType       =   utils::linalg::CMatrix<TCoef,NDen-1,1>; // Type of the denominator coefficients without the first coefficient
+                    using CNumType          =   utils::linalg::CMatrix<TCoef,NNum,1>; // Type of the full nominator coefficients
+                    using CMac              =   SMultiplyAccumulate<TCoef,T,TAcc>; // Multiply-accumulate operations
                     
-                    using CInputMem         =   utils::linalg::CMatrix<T,1,NNum>; // Type of previous input value memory
-                    using COutputMem        =   utils::linalg::CMatrix<T,1,NDen-1>; // Type of previous output value memory
+                    using CInputMem         =   std::array<T,2*NNum>; // Type of previous input value memory (mirrored)
+                    using COutputMem        =   std::array<T,2*(NDen-1)>; // Type of previous output value memory (mirrored)
                     /* Constructor */
                     CDiscreteTransferFunction();
 
-                    CDiscreteTransferFunction(const CNumType& f_num,const CDenType& f_den);
+                    constexpr CDiscreteTransferFunction(const CNumType& f_num,const CDenType& f_den);
 
                     /* Clear memory */
                     void clearMemmory();
-                    /* Shift memory */
-                    template<uint32_t N>
-                    void shiftMemory(utils::linalg::CMatrix<T,1,N>& f_mem);
                     /* Applying the transfer function on the next signal value */
                     T operator()(const T& f_input);
+                    /* Applying the transfer function on a block of signal values */
+                    void process(const T* f_in, T* f_out, size_t f_n);
                     /* Setting the nominator coefficients */
                     void setNum(const CNumType& f_num);
                     /* Setting the denominator coefficients */
@@ -74,20 +150,30 @@ namespace signal::systemmodels{
                     /* Getting the denominator coefficients without the first coefficient*/
                     const CDenModType& getDen();
                     /* Getting the first denominator coefficients. General normalized to 1 */
-                    float getDenCurrent();
+                    TCoef getDenCurrent();
                     /* Getting the last calculated output */
                     T getOutput();
 
                 private:
+                    /* Denominator coefficients without the first coefficient, it's constexpr for the constant initialization */
+                    template <size_t... I>
+                    static constexpr CDenModType denominator(const CDenType& f_den, std::index_sequence<I...>)
+                    {
+                        return CDenModType(typename CDenModType::CContainerType{{std::array<TCoef,1>{{f_den[I+1][0]}}...}});
+                    }
                     /* nominator coefficients */
                     CNumType    m_num;
                     /* denominator coefficients */
                     CDenModType    m_den;
-                    T              m_denCoef; // The first coefficient in polynomials, it mustn't be zero value. 
+                    TCoef          m_denCoef; // The first coefficient in polynomials, it mustn't be zero value. 
                     /* input memory */
                     CInputMem      m_memInput;
                     /* output memory */
                     COutputMem     m_memOutput;
+                    /* index of the last input in the memory */
+                    uint32_t       m_idxInput;
+                    /* index of the last output in the memory */
+                    uint32_t       m_idxOutput;
             }; // class CDiscreteTransferFunction
         }; // namespace siso
         namespace mimo{
@@ -98,13 +184,15 @@ namespace signal::systemmodels{
              * @tparam NA       number of states variable
              * @tparam NB       number of control variable
              * @tparam NC       number of observation variable  
+             * @tparam TA       type of the state transition matrix, a structured matrix (for example utils::linalg::CBandMatrix) 
+             *                  can be given, when the most of the elements are zero, the state update multiplies only the structure
              */
-            template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
+            template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA = utils::linalg::CMatrix<T,NA,NA>>
             class CSSModel
             {
                 public:
                     using CStateType = utils::linalg::CColVector<T,NA>; // X - state variable type
-                    using CStateTransitionType = utils::linalg::CMatrix<T,NA,NA>; // A state-state trans. model type
+                    using CStateTransitionType = TA; // A state-state trans. model type
                     using CControlType = utils::linalg::CColVector<T,NB>; // U - control variable type
                     using CMeasurementType = utils::linalg::CColVector<T,NC>; // Y - observation (measurement) variable type
                     using CInputMatrixType = utils::linalg::CMatrix<T,NA,NB>; // B - control-state trans. model type
@@ -133,6 +221,12 @@ namespace signal::systemmodels{
                     const CStateType& state() const {return m_stateVector;} 
                     CStateType& state() {return m_stateVector;} 
 
+                    /* Get model matrices */
+                    const CStateTransitionType& getStateTransitionMatrix() const {return m_stateTransitionMatrix;}
+                    const CInputMatrixType& getInputMatrix() const {return m_inputMatrix;}
+                    const CMeasurementMatrixType& getMeasurementMatrix() const {return m_measurementMatrix;}
+                    const CDirectTransferMatrixType& getDirectTransferMatrix() const {return m_directTransferMatrix;}
+
                     /* Operator */
                     CMeasurementType operator()(const CControlType& f_inputVector);
                     /* Update state */
@@ -219,6 +313,72 @@ namespace signal::systemmodels{
                 private:        
             }; // class CDiscreteTimeSystemModel
 
+            /**
+             * @brief Interface to get the Jacobian matrices of a non-linear discrete time model.
+             * 
+             * It's used by the extended Kalman filter to linearize the model around the current state. A model without 
+             * this interface is linearized by finite differences.
+             * 
+             * @tparam T        variable type
+             * @tparam NA       number of control
+             * @tparam NB       number of states
+             * @tparam NC       number of outputs
+             */
+            template <class T,uint32_t NA, uint32_t NB,uint32_t NC>
+            class IJacobianMatrices{
+                public:
+                    using CStatesType           =   utils::linalg::CMatrix<T,NB,1>;
+                    using CControlType          =   utils::linalg::CMatrix<T,NA,1>;
+                    using CStateJacobianType    =   utils::linalg::CMatrix<T,NB,NB>; // F - derivative of the state transition by the states
+                    using COutputJacobianType   =   utils::linalg::CMatrix<T,NC,NB>; // H - derivative of the observation by the states
+
+                    /* Jacobian of the state transition model */
+                    virtual CStateJacobianType getStateJacobian(const CStatesType& f_states, const CControlType& f_input) = 0;
+                    /* Jacobian of the state observation model */
+                    virtual COutputJacobianType getOutputJacobian(const CStatesType& f_states, const CControlType& f_input) = 0;
+            }; // class IJacobianMatrices
+
+            /**
+             * @brief Kinematic bicycle model of the vehicle with the analytic Jacobian matrices.
+             * 
+             * The states are the position and the orientation [x, y, yaw], the inputs are the longitudinal speed and the 
+             * steering angle [v, delta] and the outputs are the position [x, y]. The rear axle is the reference point:
+             *  x = x + v*dt*cos(yaw), y = y + v*dt*sin(yaw), yaw = yaw + v*dt*tan(delta)/L
+             * 
+             * @tparam T        variable type
+             */
+            template <class T>
+            class CKinematicBicycleModel
+                : public CDiscreteTimeSystemModel<T,2,3,2>
+                , public IJacobianMatrices<T,2,3,2>
+            {
+                public:
+                    using CSystemModelType      =   CDiscreteTimeSystemModel<T,2,3,2>;
+                    using CJacobianType         =   IJacobianMatrices<T,2,3,2>;
+                    using CStatesType           =   typename CSystemModelType::CStatesType;
+                    using CControlType          =   typename CSystemModelType::CControlType;
+                    using CObservationType      =   typename CSystemModelType::CObservationType;
+                    using CStateJacobianType    =   typename CJacobianType::CStateJacobianType;
+                    using COutputJacobianType   =   typename CJacobianType::COutputJacobianType;
+
+                    /* Constructor */
+                    CKinematicBicycleModel(const double f_dt, const T f_wheelbase);
+                    /* State transition model */
+                    virtual CStatesType update(const CControlType& f_input);
+                    /* Integrate the pose by the speed and the curvature of the path */
+                    CStatesType integrate(const T f_speed, const T f_curvature);
+                    /* State observation model */
+                    virtual CObservationType calculateOutput(const CControlType& f_input);
+                    /* Jacobian of the state transition model */
+                    virtual CStateJacobianType getStateJacobian(const CStatesType& f_states, const CControlType& f_input);
+                    /* Jacobian of the state observation model */
+                    virtual COutputJacobianType getOutputJacobian(const CStatesType& f_states, const CControlType& f_input);
+
+                private:
+                    // Distance between the front and the rear axle
+                    const T                             m_wheelbase;
+            }; // class CKinematicBicycleModel
+
         }; //namespace mimo
     }; //namespace nlti
 }; // namespace signal::systemmodels
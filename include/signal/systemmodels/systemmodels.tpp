@@ -34,17 +34,21 @@ limitations under the License.
 /**
  * @brief Construct a new CDiscreteTransferFunction object without input, it initializes the coefficients with zero, only the first coefficient with 1 value. 
  * 
- * @tparam T        Type of the variables
+ * @tparam T        Type of the signal and of the memory
  * @tparam NNum     Order of the nominator polynomial 
  * @tparam NDen     Order of the denominator polynomial 
+ * @tparam TCoef    Type of the coefficients
+ * @tparam TAcc     Type of the sum of the products
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::CDiscreteTransferFunction()
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::CDiscreteTransferFunction()
     :m_num(CNumType::zeros())
     ,m_den(CDenModType::zeros())
     ,m_denCoef(1)
     ,m_memInput()
     ,m_memOutput()
+    ,m_idxInput(0)
+    ,m_idxOutput(0)
 {
 }
 
@@ -52,22 +56,26 @@ signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::CDiscre
 /**
  * @brief Construct a new CDiscreteTransferFunction object with input polynomials 
  * 
- * @tparam T        Type of the variables
+ * @tparam T        Type of the signal and of the memory
  * @tparam NNum     Order of the nominator polynomial 
  * @tparam NDen     Order of the denominator polynomial
+ * @tparam TCoef    Type of the coefficients
+ * @tparam TAcc     Type of the sum of the products
+ * The constructor is constexpr, so a transfer function with constant coefficients is initialized without static constructor.
+ * 
  * @param f_num     Nominator polynomial coefficients
  * @param f_den     Denominator polynomial coefficients
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::CDiscreteTransferFunction(const CNumType& f_num,const CDenType& f_den)
-    :m_num(CNumType::zeros())
-    ,m_den(CDenModType::zeros())
-    ,m_denCoef(1)
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+constexpr signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::CDiscreteTransferFunction(const CNumType& f_num,const CDenType& f_den)
+    :m_num(f_num)
+    ,m_den(denominator(f_den, std::make_index_sequence<NDen-1>()))
+    ,m_denCoef(f_den[0][0])
     ,m_memInput()
     ,m_memOutput()
+    ,m_idxInput(0)
+    ,m_idxOutput(0)
 {
-    this->setNum(f_num);
-    this->setDen(f_den);
 }
 
 
@@ -76,36 +84,70 @@ signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::CDiscre
  *  Set all memories to zero.  
  *  
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::clearMemmory()
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::clearMemmory()
 {
-    m_memInput=CInputMem::zeros();
-    m_memOutput=COutputMem::zeros();
+    m_memInput.fill(T(0));
+    m_memOutput.fill(T(0));
+    m_idxInput=0;
+    m_idxOutput=0;
 }
 
-/** \brief  Applying the transfer function on the input signal value
+/** \brief  Applying the transfer function on the input signal value, the products are summed in the accumulator type 
+ *  (SMultiplyAccumulate), only the output is converted back to the type of the memory.
  *
  *  @param f_input  next input signal value
  *  @return  the calculated next output value. 
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-T signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::operator()(const T& f_input)
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+T signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::operator()(const T& f_input)
 {
-    shiftMemory<NNum>(m_memInput);
-    m_memInput[0][0]=f_input;
-    T l_output=((m_memInput*m_num-m_memOutput*m_den)[0][0])/m_denCoef;
-    shiftMemory<NDen-1>(m_memOutput);
-    m_memOutput[0][0]=l_output;
+    // The new input is placed before the previous values
+    m_idxInput = (m_idxInput == 0) ? (NNum - 1) : (m_idxInput - 1);
+    m_memInput[m_idxInput] = f_input;
+    m_memInput[m_idxInput + NNum] = f_input;
+    TAcc l_sum = TAcc(0);
+    for(uint32_t i=0;i<NNum;++i)
+    {
+        l_sum += CMac::multiply(m_num[i][0], m_memInput[m_idxInput + i]);
+    }
+    for(uint32_t i=0;i+1<NDen;++i)
+    {
+        l_sum -= CMac::multiply(m_den[i][0], m_memOutput[m_idxOutput + i]);
+    }
+    T l_output = CMac::output(l_sum, m_denCoef);
+    if (NDen > 1)
+    {
+        m_idxOutput = (m_idxOutput == 0) ? (NDen - 2) : (m_idxOutput - 1);
+        m_memOutput[m_idxOutput] = l_output;
+        m_memOutput[m_idxOutput + NDen - 1] = l_output;
+    }
     return l_output;
 }
 
+/** \brief  Applying the transfer function on a block of input signal values, the operator is inlined in the loop, so there 
+ *  is no call per value.
+ *
+ *  @param f_in     input signal values
+ *  @param f_out    output values, it can be the same buffer as the input
+ *  @param f_n      number of the values
+ */
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::process(const T* f_in, T* f_out, size_t f_n)
+{
+    for(size_t i=0;i<f_n;++i)
+    {
+        f_out[i] = (*this)(f_in[i]);
+    }
+}
+
 /** \brief  Setting nominator coefficients
  *
  *  @param f_num    nominator coefficients
  *  
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::setNum(const CNumType& f_num)
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::setNum(const CNumType& f_num)
 {
     for(uint32_t i=0;i<NNum;++i)
     {
@@ -118,8 +160,8 @@ void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::se
  *  @param f_den    denominator coefficients
  *  
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::setDen(const CDenType& f_den)
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::setDen(const CDenType& f_den)
 {
     for(uint32_t i=1;i<NDen;++i)
     {
@@ -133,33 +175,18 @@ void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::se
  *  
  *  @return last output value
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-T signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::getOutput()
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+T signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::getOutput()
 {
-    return m_memOutput[0][0];
-}
-
-/** \brief  Shift the memorized values. After the shifting the first element in the memory can be placed with a new one.
- *
- *  @param f_mem           memory matrix.
- *  @return   none
- */
-template <class T,uint32_t NNum,uint32_t NDen>
-template<uint32_t N>
-void signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::shiftMemory(utils::linalg::CMatrix<T,1,N>& f_mem)
-{
-    for(uint32_t i=N-1;i>0;--i)
-    {
-        f_mem[0][i]=f_mem[0][i-1];
-    }
+    return (NDen > 1) ? m_memOutput[m_idxOutput] : T(0);
 }
 
 /** \brief  Getter nominator 
  *
  *  @return the coefficients of the nominator 
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-const typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::CNumType& signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::getNum(){
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+const typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::CNumType& signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::getNum(){
     return m_num;
 }
 
@@ -168,8 +195,8 @@ const typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum
  * 
  *  @return  the coefficients of denominator
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-const typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::CDenModType& signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::getDen(){
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+const typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::CDenModType& signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::getDen(){
     return m_den;
 }  
 
@@ -177,8 +204,8 @@ const typename signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum
  *
  *  @return   value of the denomitor first coefficeint
  */
-template <class T,uint32_t NNum,uint32_t NDen>
-float signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::getDenCurrent(){
+template <class T,uint32_t NNum,uint32_t NDen,class TCoef,class TAcc>
+TCoef signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen,TCoef,TAcc>::getDenCurrent(){
     return m_denCoef;
 }
 
@@ -193,8 +220,8 @@ float signal::systemmodels::lti::siso::CDiscreteTransferFunction<T,NNum,NDen>::g
  *  @param f_inputMatrix            control-state transition model
  *  @param f_measurementMatrix      state-observation transition model
  */
-template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
-signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::CSSModel(
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>::CSSModel(
         const CStateTransitionType& f_stateTransitionMatrix,
         const CInputMatrixType& f_inputMatrix,
         const CMeasurementMatrixType& f_measurementMatrix) 
@@ -216,8 +243,8 @@ signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::CSSModel(
  *  @param f_measurementMatrix      state-observation transition model
  *  @param f_directTransferMatrix   control-observation transition model
  */
-template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
-signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::CSSModel(
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>::CSSModel(
         const CStateTransitionType& f_stateTransitionMatrix,
         const CInputMatrixType& f_inputMatrix,
         const CMeasurementMatrixType& f_measurementMatrix,
@@ -240,8 +267,8 @@ signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::CSSModel(
  *  @param f_directTransferMatrix   control-observation transition model
  *  @param f_state                  initial state of the system model
  */
-template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
-signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::CSSModel(
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>::CSSModel(
         const CStateTransitionType& f_stateTransitionMatrix,
         const CInputMatrixType& f_inputMatrix,
         const CMeasurementMatrixType& f_measurementMatrix,
@@ -260,8 +287,8 @@ signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::CSSModel(
   * @param f_inputVector        control values
   * @return                     observation values
   */
-template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
-utils::linalg::CColVector<T,NC> signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::operator()(const CControlType& f_inputVector)
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+utils::linalg::CColVector<T,NC> signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>::operator()(const CControlType& f_inputVector)
 {
     updateState(f_inputVector);
     return getOutput(f_inputVector);
@@ -271,10 +298,13 @@ utils::linalg::CColVector<T,NC> signal::systemmodels::lti::mimo::CSSModel<T,NA,N
   *
   * @param f_inputVector        control values
   */
-template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
-void signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::updateState(const CControlType& f_inputVector)
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+void signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>::updateState(const CControlType& f_inputVector)
 {
-    m_stateVector = m_stateTransitionMatrix * m_stateVector + m_inputMatrix * f_inputVector;
+    CStateType l_state;
+    utils::linalg::multiply(l_state, m_stateTransitionMatrix, m_stateVector);
+    utils::linalg::multiplyAdd(l_state, m_inputMatrix, f_inputVector);
+    m_stateVector = l_state;
 }
 
 /** @brief  Calculate and return the observation values based on the control value and the state of the system.
@@ -282,10 +312,13 @@ void signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::updateState(const CC
   * @param f_inputVector        control values
   * @return                     observation values
   */
-template <class T, uint32_t NA, uint32_t NB, uint32_t NC>
-utils::linalg::CColVector<T,NC> signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC>::getOutput(const CControlType& f_inputVector)
+template <class T, uint32_t NA, uint32_t NB, uint32_t NC, class TA>
+utils::linalg::CColVector<T,NC> signal::systemmodels::lti::mimo::CSSModel<T,NA,NB,NC,TA>::getOutput(const CControlType& f_inputVector)
 {
-    return m_measurementMatrix * m_stateVector + m_directTransferMatrix * f_inputVector;
+    CMeasurementType l_output;
+    utils::linalg::multiply(l_output, m_measurementMatrix, m_stateVector);
+    utils::linalg::multiplyAdd(l_output, m_directTransferMatrix, f_inputVector);
+    return l_output;
 }
 
 
@@ -317,8 +350,100 @@ signal::systemmodels::nlti::mimo::CDiscreteTimeSystemModel<T,NA,NB,NC>::CDiscret
 {
 }
 
+/** \brief  CKinematicBicycleModel class constructor
+ *
+ *  @param f_dt          Sampling time
+ *  @param f_wheelbase   Distance between the front and the rear axle
+ */
+template <class T>
+signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::CKinematicBicycleModel(
+        const double           f_dt
+       ,const T                f_wheelbase)
+    : CSystemModelType(f_dt)
+    , m_wheelbase(f_wheelbase)
+{
+}
+
+/** \brief  State transition model, it integrates the pose by the speed and the steering angle
+ *
+ *  @param f_input       Input control vector [v, delta]
+ *  @return              State vector [x, y, yaw]
+ */
+template <class T>
+typename signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::CStatesType 
+signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::update(const CControlType& f_input)
+{
+    return integrate(f_input[0][0], std::tan(f_input[1][0]) / m_wheelbase);
+}
+
+/** \brief  State transition by the curvature of the path, the steering geometry of the curvature is given by the caller
+ *  (e.g. CSteeringGeometry lookup tables).
+ *
+ *  @param f_speed       Longitudinal speed
+ *  @param f_curvature   Curvature of the path, positive to left
+ *  @return              State vector [x, y, yaw]
+ */
+template <class T>
+typename signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::CStatesType 
+signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::integrate(const T f_speed, const T f_curvature)
+{
+    const T l_ds = f_speed * static_cast<T>(this->m_dt);
+    const T l_yaw = this->m_states[2][0];
+    this->m_states[0][0] += l_ds * std::cos(l_yaw);
+    this->m_states[1][0] += l_ds * std::sin(l_yaw);
+    this->m_states[2][0] += l_ds * f_curvature;
+    return this->m_states;
+}
 
+/** \brief  State observation model, it returns the position
+ *
+ *  @param f_input       Input control vector [v, delta]
+ *  @return              Observation vector [x, y]
+ */
+template <class T>
+typename signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::CObservationType 
+signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::calculateOutput(const CControlType& f_input)
+{
+    this->m_outputs[0][0] = this->m_states[0][0];
+    this->m_outputs[1][0] = this->m_states[1][0];
+    return this->m_outputs;
+}
 
+/** \brief  Jacobian of the state transition model
+ *
+ *  @param f_states      State vector [x, y, yaw] of the linearization
+ *  @param f_input       Input control vector [v, delta]
+ *  @return              Derivative of the state transition by the states
+ */
+template <class T>
+typename signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::CStateJacobianType 
+signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::getStateJacobian(const CStatesType& f_states, const CControlType& f_input)
+{
+    const T l_ds = f_input[0][0] * static_cast<T>(this->m_dt);
+    CStateJacobianType l_F;
+    l_F[0][0] = 1;
+    l_F[1][1] = 1;
+    l_F[2][2] = 1;
+    l_F[0][2] = -l_ds * std::sin(f_states[2][0]);
+    l_F[1][2] = l_ds * std::cos(f_states[2][0]);
+    return l_F;
+}
+
+/** \brief  Jacobian of the state observation model
+ *
+ *  @param f_states      State vector [x, y, yaw] of the linearization
+ *  @param f_input       Input control vector [v, delta]
+ *  @return              Derivative of the observation by the states
+ */
+template <class T>
+typename signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::COutputJacobianType 
+signal::systemmodels::nlti::mimo::CKinematicBicycleModel<T>::getOutputJacobian(const CStatesType& f_states, const CControlType& f_input)
+{
+    COutputJacobianType l_H;
+    l_H[0][0] = 1;
+    l_H[1][1] = 1;
+    return l_H;
+}
 
 #endif // SYSTEM_MODELS_TPP
 
@@ -0,0 +1,110 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ThermalModel.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the thermal model of the motor winding.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef THERMAL_MODEL_HPP
+#define THERMAL_MODEL_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/dcmotor.hpp>
+#include <signal/systemmodels/systemmodels.hpp>
+#include <signal/systemmodels/discretization.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace signal::systemmodels{
+
+   /**
+    * @brief Estimated temperature of the motor winding by the squared current (I²t), a stage of the control pipeline.
+    * 
+    * The model has two thermal capacities, the winding and the housing, with the resistances between the winding and the housing 
+    * and between the housing and the ambient. The states are the temperature rises above the ambient, the input is the squared 
+    * current, the heating is the copper loss R*I^2 of the winding. It's discretized by zero order hold of the current (exact matrix 
+    * exponential), so the period isn't limited by the time constant of the winding. The model is updated also when the motor is stopped, so it follows the cooling.
+    * 
+    * The derating factor decreases linearly from one at the start temperature to the floor at the limit temperature, the motor 
+    * controller multiplies the limits of the pwm and of the current reference with it.
+    */
+    class CMotorThermalModel: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief Parameters of the thermal model */
+        struct SThermalParameters{
+            /** @brief Resistance of the winding (Ohm) */
+            float m_resistance;
+            /** @brief Thermal capacity of the winding (J/K) */
+            float m_windingCapacity;
+            /** @brief Thermal capacity of the housing (J/K) */
+            float m_housingCapacity;
+            /** @brief Thermal resistance between the winding and the housing (K/W) */
+            float m_windingResistance;
+            /** @brief Thermal resistance between the housing and the ambient (K/W) */
+            float m_housingResistance;
+        };
+
+        /* Constructor */
+        CMotorThermalModel(float                                   f_period
+                          ,hardware::drivers::ICurrentGetter&      f_current
+                          ,const SThermalParameters&               f_parameters
+                          ,float                                   f_ambient = 25.0f);
+        /* Pipeline stage, it updates the model */
+        virtual void process(uint32_t f_timestamp);
+        /* Set the temperatures of the derating */
+        void setDerating(float f_start, float f_limit, float f_floor);
+        /* Estimated temperature of the winding */
+        float getTemperature();
+        /* Estimated temperature of the housing */
+        float getHousingTemperature();
+        /** @brief  Derating factor of the limits, between the floor and one */
+        float getDerating() const
+        {
+            return m_derating;
+        }
+        /* Serial callback of the state */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief Type of the model: 2 states (winding, housing), 1 input (squared current), 1 output (winding) */
+        using CModelType = signal::systemmodels::lti::mimo::CSSModel<float,2,1,1>;
+        /* Create the discrete system model */
+        static CModelType systemModel(float f_period, const SThermalParameters& f_parameters);
+
+        /** @brief  Current getter */
+        hardware::drivers::ICurrentGetter& m_current;
+        /** @brief  Discrete model of the temperature rises */
+        CModelType m_model;
+        /** @brief  Ambient temperature (°C) */
+        const float m_ambient;
+        /** @brief  Temperature of the winding, where the derating starts (°C) */
+        float m_deratingStart;
+        /** @brief  Temperature of the winding, where the derating reaches the floor (°C) */
+        float m_deratingLimit;
+        /** @brief  Minimum of the derating factor */
+        float m_deratingFloor;
+        /** @brief  Estimated temperature rise of the winding */
+        volatile float m_rise;
+        /** @brief  Derating factor */
+        volatile float m_derating;
+    };
+
+}; // namespace signal::systemmodels
+
+#endif // THERMAL_MODEL_HPP
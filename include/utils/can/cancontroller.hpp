@@ -0,0 +1,89 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    CanController.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the interface of the CAN controllers.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CAN_CONTROLLER_HPP
+#define CAN_CONTROLLER_HPP
+
+#include <mbed.h>
+
+namespace utils::can{
+
+    /** @brief  CAN frame */
+    struct SCanFrame{
+        /** @brief  identifier, 11 bits or 29 bits for the extended frames */
+        uint32_t m_id;
+        /** @brief  number of the data bytes (0..8) */
+        uint8_t m_length;
+        /** @brief  extended identifier */
+        bool m_extended;
+        /** @brief  remote transmission request */
+        bool m_remote;
+        /** @brief  data bytes */
+        uint8_t m_data[8];
+    };
+
+    /** @brief  Error state of a CAN controller */
+    struct SCanErrors{
+        /** @brief  transmit error counter */
+        uint8_t m_transmit;
+        /** @brief  receive error counter */
+        uint8_t m_receive;
+        /** @brief  the controller is in bus-off state */
+        bool m_busOff;
+        /** @brief  number of the frames lost by receive overflow */
+        uint32_t m_overflows;
+    };
+
+    /** @brief  Events of the controller, they are returned by the acknowledgment of its interrupt */
+    enum ECanEvent{
+        CAN_TRANSMITTED = 0x01,                                             /**< a transmit mailbox was freed */
+        CAN_ERROR       = 0x02                                              /**< the error state or the overflow flags changed */
+    };
+
+   /**
+    * @brief Interface to access a CAN controller with hardware acceptance filters and transmit mailboxes.
+    * 
+    * The attached callback is applied from interrupt context, when the controller signals a received frame, a freed mailbox or an error, 
+    * the other methods are applied from a single thread (the transport task), for example the controllers on SPI are blocking.
+    */
+    class ICanController
+    {
+    public:
+        /* Load the frame in a free transmit mailbox, it returns false, when all mailboxes are busy */
+        virtual bool send(const SCanFrame& f_frame) = 0;
+        /* Read a received frame, it returns false, when there isn't a frame */
+        virtual bool receive(SCanFrame& f_frame) = 0;
+        /* Clear the transmit and error flags of the interrupt, it returns the events (ECanEvent) */
+        virtual uint32_t acknowledge() = 0;
+        /* The interrupt of the controller is still active */
+        virtual bool isPending() = 0;
+        /* Read the error state */
+        virtual void getErrors(SCanErrors& f_errors) = 0;
+        /* Attach the callback of the interrupt */
+        virtual void attach(mbed::Callback<void()> f_callback) = 0;
+    };
+
+}; // namespace utils::can
+
+#endif // CAN_CONTROLLER_HPP
@@ -0,0 +1,77 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    CanPublisher.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the publishing of the 
+  *          sensor values on the CAN bus.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CAN_PUBLISHER_HPP
+#define CAN_PUBLISHER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/publisher/publisher.hpp>
+#include <utils/can/cantransport.hpp>
+
+namespace utils::can{
+
+   /**
+    * @brief Publisher of the sensor values on the CAN bus, it applies the published values of the serial publisher group.
+    * 
+    * Each subscribed value is sent in its own standard frame, the identifier is 'base + index' and the data is the binary format of 
+    * the value (the little-endian float or integer), so the other boards filter the values in hardware and they don't parse a combined 
+    * frame. The dividers of the values are applied as in utils::publisher::CPublisherGroup. The 'CANP' key sets the hexadecimal mask 
+    * of the values, zero stops the publishing.
+    */
+    class CCanPublisher: public utils::task::CTask
+    {
+    public:
+        /* Constructor */
+        CCanPublisher(uint32_t                              f_period
+                     ,utils::publisher::IPublishedValue**   f_values
+                     ,uint8_t                               f_valueCount
+                     ,CCanTransport&                        f_transport
+                     ,uint16_t                              f_baseId);
+        /* Subscribe the published values */
+        bool subscribe(uint32_t f_mask);
+        /* Serial callback of the subscription */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method */
+        virtual void _run();
+
+        /** @brief  List of the values */
+        utils::publisher::IPublishedValue** m_values;
+        /** @brief  Number of the values */
+        uint8_t m_valueCount;
+        /** @brief  CAN transport */
+        CCanTransport& m_transport;
+        /** @brief  Identifier of the first value */
+        const uint16_t m_baseId;
+        /** @brief  Mask of the subscribed values */
+        volatile uint32_t m_mask;
+        /** @brief  Number of the applied periods */
+        uint32_t m_tick;
+    };
+
+}; // namespace utils::can
+
+#endif // CAN_PUBLISHER_HPP
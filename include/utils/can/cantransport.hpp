@@ -0,0 +1,153 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    CanTransport.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the CAN transport of the 
+  *          binary messages.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CAN_TRANSPORT_HPP
+#define CAN_TRANSPORT_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/queue/ringbuffer.hpp>
+#include <utils/serial/dispatchtable.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/can/cancontroller.hpp>
+
+namespace utils::can{
+
+   /**
+    * @brief Transport of the binary messages on a CAN bus, the boards of the vehicle network reach the same subscribers as the serial link.
+    * 
+    * The node owns a range of 256 standard identifiers from its base: the identifier 'base + id' carries the binary message 'id' with 
+    * the payload of the frame (at most 8 bytes, e.g. utils::serial::SMovePayload), the callbacks are found in the dispatch table of the 
+    * serial monitor and the status code is answered by the identifier 'base + (id | s_responseFlag)'. The other identifiers are 
+    * rejected by the hardware filters of the controller, they are configured by the user.
+    * 
+    * The transmitted frames (responses and 'publish') are pushed in a software queue, it's drained in the free mailboxes of the 
+    * controller, when the controller signals a freed mailbox. The task has zero period, it's notified by the interrupt of the 
+    * controller and by the publishing, so the controller is accessed only by the thread of the task.
+    * 
+    * A stamped identifier (setStamped) bypasses the dispatch table, its frames are passed with the cycle counter of the interrupt to 
+    * the receive callback and the freed mailbox after its transmission is reported with the same stamp, so a protocol can measure the 
+    * times on the bus (e.g. the tick synchronization, utils::can::CTickSync). The stamp is valid, when the interrupt can belong only to 
+    * the given event: the frame is the first one of a fresh interrupt, or the transmission was the only event of it.
+    * 
+    * Commands of the 'CANB' key: '0' statistics ('received;transmitted;dropped;rejected;errors;tec;rec;busoff;overflows'), 
+    * '1;id;hex data' transmits a frame.
+    */
+    class CCanTransport: public utils::task::CTask
+    {
+    public:
+        /** @brief  Dispatch table of the binary messages, it's shared with the serial monitor */
+        typedef utils::serial::CDispatchTable<utils::serial::CBinaryProtocol::FBinaryCallback> CBinarySubscriberMap;
+        /** @brief  Callback of a received stamped frame: frame, cycle counter of the interrupt, validity of the stamp */
+        typedef mbed::Callback<void(const SCanFrame&, uint32_t, bool)> FStampedReceive;
+        /** @brief  Callback of a transmitted stamped frame: cycle counter of the interrupt, validity of the stamp */
+        typedef mbed::Callback<void(uint32_t, bool)> FStampedTransmit;
+        /** @brief  Statistics of the transport */
+        struct SStatistics{
+            /** @brief  number of the received frames */
+            uint32_t m_received;
+            /** @brief  number of the frames loaded in the mailboxes */
+            uint32_t m_transmitted;
+            /** @brief  number of the frames dropped by the full transmit queue */
+            uint32_t m_dropped;
+            /** @brief  number of the received frames without subscriber */
+            uint32_t m_rejected;
+            /** @brief  number of the error interrupts */
+            uint32_t m_errors;
+        };
+
+        /* Constructor */
+        CCanTransport(ICanController& f_controller, CBinarySubscriberMap f_subscribers, uint16_t f_baseId);
+        /* Start the transport, it attaches the interrupt of the controller */
+        void start();
+        /* Queue a standard frame, it can be applied from any thread */
+        bool publish(uint16_t f_id, const void* f_data, uint8_t f_length);
+        /* Set the stamped identifier and its callbacks */
+        void setStamped(uint16_t f_id, FStampedReceive f_received, FStampedTransmit f_transmitted);
+        /** @brief  The transmit queue is empty, a queued frame is loaded without waiting for the other frames */
+        bool isIdle() const
+        {
+            return m_queue.isEmpty() && !m_hasPending;
+        }
+        /** @brief  Statistics of the transport */
+        const SStatistics& getStatistics() const
+        {
+            return m_statistics;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Number of the identifiers of the node, the responses have the upper half */
+        static const uint16_t s_idRange = 256;
+        /** @brief  Maximum number of the interrupt servicing rounds in a run */
+        static const uint32_t s_maxRounds = 8;
+        /** @brief  Maximum number of the received frames in a run, a failed controller doesn't block the thread */
+        static const uint32_t s_maxFrames = 32;
+    private:
+        /* Run method, it reads the received frames and it drains the transmit queue */
+        virtual void _run();
+        /* Interrupt callback of the controller */
+        void interruptCallback();
+        /* Apply the subscriber of a received frame */
+        void dispatch(const SCanFrame& f_frame, uint32_t f_stamp, bool f_isStampValid);
+        /* Load the queued frames in the free mailboxes */
+        void flush();
+
+        /** @brief  CAN controller */
+        ICanController& m_controller;
+        /** @brief  Subscribers of the binary messages */
+        CBinarySubscriberMap m_subscribers;
+        /** @brief  First identifier of the node */
+        const uint16_t m_baseId;
+        /** @brief  Queue of the transmitted frames */
+        utils::CRingBuffer<SCanFrame,16> m_queue;
+        /** @brief  Frame taken from the queue, it waits for a free mailbox */
+        SCanFrame m_pending;
+        /** @brief  The pending frame is valid */
+        bool m_hasPending;
+        /** @brief  The transport is started, the controller is available */
+        volatile bool m_isStarted;
+        /** @brief  Statistics */
+        SStatistics m_statistics;
+        /** @brief  Error state read after the last error interrupt */
+        SCanErrors m_errors;
+        /** @brief  Stamped identifier, an invalid identifier without stamped protocol */
+        uint16_t m_stampedId;
+        /** @brief  Callback of the received stamped frames */
+        FStampedReceive m_stampedReceive;
+        /** @brief  Callback of the transmitted stamped frames */
+        FStampedTransmit m_stampedTransmit;
+        /** @brief  Cycle counter of the last interrupt */
+        volatile uint32_t m_irqCycles;
+        /** @brief  The interrupt wasn't serviced yet */
+        volatile bool m_isIrqFresh;
+        /** @brief  A stamped frame was loaded in a mailbox, its transmission isn't reported yet */
+        bool m_isStampPending;
+        /** @brief  Invalid standard identifier */
+        static const uint16_t s_invalidId = 0xFFFF;
+    };
+
+}; // namespace utils::can
+
+#endif // CAN_TRANSPORT_HPP
@@ -0,0 +1,162 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    TickSync.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the synchronization
+  *          of the control ticks of the boards on the CAN bus.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TICK_SYNC_HPP
+#define TICK_SYNC_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/can/cantransport.hpp>
+#include <hardware/drivers/controltimer.hpp>
+
+namespace utils::can{
+
+   /**
+    * @brief Time-triggered synchronization of the control ticks of the boards on the CAN bus, the control loops of the boards run
+    * like a single synchronous loop.
+    *
+    * The sync master broadcasts a sync frame (type 0, sequence) on the common identifier in each period, the transport stamps the
+    * interrupt of its freed mailbox and the master sends the phase of the transmission after its last control tick in a follow-up
+    * frame (type 1, sequence, phase in ns, little-endian). The slaves stamp the interrupt of the received sync frame, so the phase of
+    * the master's tick in the local clock is the receive stamp minus the master's phase and the latency (the difference of the two
+    * interrupt paths, both interrupts follow the end of the same frame). The phase error of the local tick drives a PI loop, which
+    * trims the period of the control timer: the proportional part removes the phase error in one sync period, the integral part
+    * tracks the drift of the crystals. A large error before the lock is removed by a single stretched or shortened period.
+    *
+    * The master and the slaves have the same sync period. The samples with invalid stamps (coalesced interrupts) aren't applied, the
+    * locked slave rejects the outliers, the slave without samples keeps its trim (holdover) and it isn't locked after the timeout.
+    *
+    * Commands of the 'TSYN' key: '0' state ('role;locked;error ns;trim counts;samples;outliers'), '1;role' (0 off, 1 master, 2 slave),
+    * '2;latency ns'.
+    */
+    class CTickSync: public utils::task::CTask
+    {
+    public:
+        /** @brief  Roles of the board */
+        enum ERole{
+            ROLE_OFF    = 0,                                                /**< the tick isn't synchronized */
+            ROLE_MASTER = 1,                                                /**< the board broadcasts its tick */
+            ROLE_SLAVE  = 2                                                 /**< the board disciplines its tick */
+        };
+
+        /* Constructor */
+        CTickSync(uint32_t f_period, float f_syncPeriod, float f_controlPeriod, CCanTransport& f_transport, hardware::drivers::CControlTimer_TIM10& f_timer, uint16_t f_syncId);
+        /* Set the role, it resets the trim and the state of the discipline */
+        void setRole(ERole f_role);
+        /** @brief  Role of the board */
+        ERole getRole() const
+        {
+            return m_role;
+        }
+        /* Set the latency of the receive stamp relative to the transmit stamp */
+        void setLatency(int32_t f_latency_ns);
+        /** @brief  The tick is locked to the master's tick */
+        bool isLocked() const
+        {
+            return m_isLocked;
+        }
+        /** @brief  Last phase error in ns, positive when the local tick is earlier */
+        int32_t getError() const
+        {
+            return m_error_ns;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, the master broadcasts, the slave supervises the age of the samples */
+        virtual void _run();
+        /* Callback of the received frames */
+        void received(const SCanFrame& f_frame, uint32_t f_cycles, bool f_isValid);
+        /* Callback of the transmitted sync frame */
+        void transmitted(uint32_t f_cycles, bool f_isValid);
+        /* Apply a phase error on the trim */
+        void discipline(int32_t f_error);
+        /* Phase of a cycle counter value after the last control tick */
+        int32_t phase(uint32_t f_cycles) const;
+        /* Wrap a phase difference in the half periods */
+        int32_t wrap(int32_t f_cycles) const;
+
+        /** @brief  Type of the sync frame */
+        static const uint8_t s_sync = 0;
+        /** @brief  Type of the follow-up frame */
+        static const uint8_t s_followUp = 1;
+        /** @brief  Proportional gain, the phase error is removed in one sync period */
+        static constexpr float s_kp = 1.0f;
+        /** @brief  Integral gain, with the proportional gain the loop is critically damped */
+        static constexpr float s_ki = 0.25f;
+        /** @brief  Error of the locked tick in ns */
+        static const int32_t s_lockError = 5000;
+        /** @brief  Consecutive samples within the lock error, which lock the tick */
+        static const uint32_t s_lockSamples = 4;
+        /** @brief  Error of an outlier of the locked tick in ns */
+        static const int32_t s_outlierError = 50000;
+        /** @brief  Consecutive outliers, which unlock the tick */
+        static const uint32_t s_maxOutliers = 3;
+        /** @brief  Sync periods without sample, which unlock the tick */
+        static const uint32_t s_timeoutPeriods = 10;
+        /** @brief  Maximum trim relative to the period */
+        static constexpr float s_maxTrim = 2e-3f;
+
+        /** @brief  Transport of the frames */
+        CCanTransport& m_transport;
+        /** @brief  Control timer */
+        hardware::drivers::CControlTimer_TIM10& m_timer;
+        /** @brief  Common identifier of the sync frames */
+        const uint16_t m_syncId;
+        /** @brief  Period of the control ticks in second */
+        const float m_controlPeriod;
+        /** @brief  Control ticks in a sync period */
+        const float m_ticksPerSync;
+        /** @brief  Role of the board */
+        ERole m_role;
+        /** @brief  Latency of the receive stamp in ns */
+        int32_t m_latency_ns;
+        /** @brief  Sequence number of the last sync frame */
+        uint8_t m_sequence;
+        /** @brief  Phase of the last received sync frame in cycles */
+        int32_t m_rxPhase;
+        /** @brief  The last received sync frame has a valid stamp */
+        bool m_isRxValid;
+        /** @brief  Integral part of the trim in timer counts */
+        float m_integral;
+        /** @brief  Last phase error in ns */
+        int32_t m_error_ns;
+        /** @brief  The tick is locked */
+        volatile bool m_isLocked;
+        /** @brief  Consecutive samples within the lock error */
+        uint32_t m_lockCount;
+        /** @brief  Consecutive outliers */
+        uint32_t m_outlierCount;
+        /** @brief  Sync periods since the last sample */
+        uint32_t m_age;
+        /** @brief  Number of the applied samples */
+        uint32_t m_samples;
+        /** @brief  Number of the rejected outliers */
+        uint32_t m_outliers;
+    };
+
+}; // namespace utils::can
+
+#endif // TICK_SYNC_HPP
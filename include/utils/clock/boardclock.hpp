@@ -0,0 +1,72 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    BoardClock.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the monotonic 
+  *          microsecond clock of the board.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef BOARD_CLOCK_HPP
+#define BOARD_CLOCK_HPP
+
+#include <mbed.h>
+
+namespace utils::clock{
+
+   /**
+    * @brief Monotonic microsecond clock of the board, it's the time base of all timestamps (control tick, scheduled commands, 
+    * telemetry, stamped frames).
+    * 
+    * The 32-bit microsecond ticker of mbed (TIM5) wraps in each 71 minutes, the 64-bit time is extended by counting the wraps, 
+    * so 'now' has to be applied at least once in each wrap period (the clock synchronization task applies it). The optional 
+    * stamping adds the 32-bit time of the transmission to the outbound text messages and binary frames.
+    */
+    class CBoardClock
+    {
+    public:
+        /* Extended 64-bit time */
+        static uint64_t now();
+        /** @brief  32-bit time in microsecond, it wraps in each 71 minutes */
+        static uint32_t now32()
+        {
+            return us_ticker_read();
+        }
+        /** @brief  Enable the stamping of the outbound messages */
+        static void setStamping(bool f_isStamping)
+        {
+            s_isStamping = f_isStamping;
+        }
+        /** @brief  The outbound messages are stamped */
+        static bool isStamping()
+        {
+            return s_isStamping;
+        }
+    private:
+        /** @brief  Ticker value at the last extension */
+        static uint32_t s_last;
+        /** @brief  Number of the wraps */
+        static uint32_t s_wraps;
+        /** @brief  State of the stamping */
+        static volatile bool s_isStamping;
+    };
+
+}; // namespace utils::clock
+
+#endif // BOARD_CLOCK_HPP
@@ -0,0 +1,105 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ClockSync.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the clock synchronization 
+  *          with the host.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CLOCK_SYNC_HPP
+#define CLOCK_SYNC_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/clock/boardclock.hpp>
+
+namespace utils::clock{
+
+   /**
+    * @brief Two-way synchronization of the board clock with the clock of the host, it estimates the offset and the drift like NTP.
+    * 
+    * The host sends pings with its transmit time (t1), the board responds with the receive and transmit times (t2, t3) in its own 
+    * clock, the next ping carries the receive time of the previous response (t4). From the four times the round trip delay is 
+    * d = (t4 - t1) - (t3 - t2) and the offset is (t2 - t1) - d / 2, both clocks are 32-bit microsecond counters, so the offset is 
+    * computed modulo 2^32. The samples with much longer delay than the minimum are rejected (queued responses), the accepted ones 
+    * update an alpha-beta filter of the offset and of the drift. The host can compute the same estimate from the responses.
+    * 
+    * Commands of the 'SYNC' key: '0' state ('synchronized;offset;drift ppm;delay;samples'), '1;t1;t4' ping (t4 is zero for the first one, 
+    * the response is 'ack;;t1;t2;t3;'), '2;enable' stamping of the outbound messages (utils::clock::CBoardClock).
+    */
+    class CClockSync: public utils::task::CTask
+    {
+    public:
+        /* Constructor */
+        CClockSync(uint32_t f_period);
+        /* Apply a ping of the host */
+        void ping(uint32_t f_t1, uint32_t f_t4, uint32_t& f_t2, uint32_t& f_t3);
+        /* Convert a board time to host time */
+        uint32_t toHost(uint32_t f_board) const;
+        /** @brief  The estimate is valid and it was updated recently */
+        bool isSynchronized() const
+        {
+            return m_isSynchronized;
+        }
+        /** @brief  Drift of the board clock relative to the host clock in ppm */
+        float getDrift() const
+        {
+            return m_drift * 1e6f;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, it extends the board clock and it checks the age of the estimate */
+        virtual void _run();
+        /* Update the estimate with a complete exchange */
+        void update(uint32_t f_t1, uint32_t f_t2, uint32_t f_t3, uint32_t f_t4);
+
+        /** @brief  Gain of the offset correction */
+        static constexpr float s_alpha = 0.25f;
+        /** @brief  Gain of the drift correction */
+        static constexpr float s_beta = 0.035f;
+        /** @brief  Accepted excess of the delay over the minimum in microsecond */
+        static const uint32_t s_delayMargin = 2000;
+        /** @brief  Maximum age of the estimate in microsecond */
+        static const uint32_t s_timeout = 10000000;
+
+        /** @brief  Offset of the board clock relative to the host clock at the reference time, modulo 2^32 */
+        uint32_t m_offset;
+        /** @brief  Board time of the last accepted sample */
+        uint32_t m_reference;
+        /** @brief  Drift, the change of the offset in one microsecond */
+        float m_drift;
+        /** @brief  Tracked minimum of the round trip delay in microsecond */
+        uint32_t m_minDelay;
+        /** @brief  Round trip delay of the last exchange in microsecond */
+        uint32_t m_delay;
+        /** @brief  Number of the accepted samples */
+        uint32_t m_samples;
+        /** @brief  Times of the previous ping, the exchange is completed by its t4 */
+        uint32_t m_pending[3];
+        /** @brief  The previous ping can be completed */
+        bool m_hasPending;
+        /** @brief  The estimate is valid */
+        volatile bool m_isSynchronized;
+    };
+
+}; // namespace utils::clock
+
+#endif // CLOCK_SYNC_HPP
@@ -0,0 +1,113 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    BlobStore.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the persisted store
+  *          of a binary configuration.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef BLOB_STORE_HPP
+#define BLOB_STORE_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/internalflash.hpp>
+
+namespace utils::config{
+
+   /**
+    * @brief Store of a binary configuration (e.g. the description of the signal graph) in an area at the end of a flash sector.
+    *
+    * The area is divided in slots of fixed size, each record has the layout of the CConfigStore: magic, length in byte, sequence number,
+    * the bytes completed to words by the erased value, checksum. A new record is appended to the first free slot, the load at the boot
+    * applies the last valid one. When all slots are used, the load copies the last record, it erases the sector and it programs the copy
+    * in the first slot, so the erase stalls only the startup, before the watchdog and the control loop. The rest of the sector can be used
+    * by an other owner, which erases the sector (e.g. the staging of the firmware update), the stored configuration is lost by it.
+    */
+    class CBlobStore
+    {
+    public:
+        /** @brief  Query, whether the flash can be written. */
+        typedef mbed::Callback<bool()> FWriteGuard;
+        /** @brief  Maximum length of the configuration in byte */
+        static const uint32_t s_maxLength = 512;
+
+        /* Constructor */
+        CBlobStore(const hardware::drivers::CInternalFlash::SSector& f_sector, uint32_t f_offset);
+        /* Load the last record */
+        bool load();
+        /* Save the configuration in a new record */
+        bool save(const uint8_t* f_blob, uint32_t f_length);
+        /* Set the write guard */
+        void setWriteGuard(FWriteGuard f_guard);
+        /** @brief  Bytes of the last record in the flash, NULL without valid record */
+        const uint8_t* getBlob() const
+        {
+            return m_blob;
+        }
+        /** @brief  Length of the last record in byte */
+        uint32_t getLength() const
+        {
+            return m_length;
+        }
+    private:
+        /* Validate a slot */
+        bool isValid(const uint32_t* f_record) const;
+        /* Checksum of a record */
+        uint32_t checksum(const uint32_t* f_record) const;
+        /* Program the record buffer in the next slot */
+        bool program();
+        /** @brief  Address of a slot */
+        uint32_t slotAddress(uint32_t f_slot) const
+        {
+            return m_sector.m_address + m_offset + f_slot * s_slotWords * 4;
+        }
+
+        /** @brief  Magic word of the records */
+        static const uint32_t s_magic = 0x42424642;         // "BFBB"
+        /** @brief  Words of the record header (magic, length, sequence) */
+        static const uint32_t s_headerWords = 3;
+        /** @brief  Words of a slot */
+        static const uint32_t s_slotWords = s_headerWords + s_maxLength / 4 + 1;
+
+        /** @brief  Sector of the area */
+        hardware::drivers::CInternalFlash::SSector m_sector;
+        /** @brief  Offset of the area in the sector */
+        uint32_t m_offset;
+        /** @brief  Slots in the area */
+        uint32_t m_slotCount;
+        /** @brief  First free slot */
+        uint32_t m_free;
+        /** @brief  Sequence number of the last record */
+        uint32_t m_sequence;
+        /** @brief  Bytes of the last record */
+        const uint8_t* m_blob;
+        /** @brief  Length of the last record */
+        uint32_t m_length;
+        /** @brief  The area is outside of the program image */
+        bool m_isEnabled;
+        /** @brief  Write guard */
+        FWriteGuard m_guard;
+        /** @brief  Record in preparation, it isn't placed on the stack of the callers */
+        uint32_t m_record[s_slotWords];
+    };
+
+}; // namespace utils::config
+
+#endif // BLOB_STORE_HPP
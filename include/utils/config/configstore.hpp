@@ -0,0 +1,161 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    ConfigStore.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the persisted configuration store.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef CONFIG_STORE_HPP
+#define CONFIG_STORE_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/internalflash.hpp>
+#include <utils/taskmanager/workqueue.hpp>
+
+namespace utils::config{
+
+   /**
+    * @brief Store of the calibration parameters in two sectors of the internal flash.
+    * 
+    * The parameters are float values with a name, their values are kept in an array owned by the user, in the order of the parameter table. 
+    * The array is saved in records with versioned binary layout: magic, version and length, sequence number, values, checksum. The records 
+    * are appended to the active sector, so the sector is erased only after filling it with records. When the active sector is full, the 
+    * next record is written in the other sector, the previous sector is erased at the next reset. The load at the boot scans the headers 
+    * and it copies the values of the last valid record with a single memcpy. The records with different version or length are ignored, the 
+    * values in the parameter table are applied.
+    * 
+    * The erase of a sector stalls the execution for 1-2 s, it's applied only by the load, before the start of the watchdog and of the control loop. 
+    * The writing of a record stalls the execution for about 16 us/word, it's applied only while the write guard allows it (e.g. the robot doesn't move). 
+    * The sectors mustn't overlap the program image, the store is disabled otherwise. With a work queue the saving requested by the serial 
+    * callback is applied by the queue, the callback acknowledges the request and the result is sent later with the same key.
+    */
+    class CConfigStore
+    {
+    public:
+        /** @brief  Parameter of the store */
+        struct SParameter
+        {
+            /** @brief  Name of the parameter, at most 15 characters */
+            const char* m_key;
+            /** @brief  Default value */
+            float m_default;
+        };
+        /** @brief  Query, whether the flash can be written. */
+        typedef mbed::Callback<bool()> FWriteGuard;
+
+        /* Constructor */
+        CConfigStore(const hardware::drivers::CInternalFlash::SSector&  f_first
+                    ,const hardware::drivers::CInternalFlash::SSector&  f_second
+                    ,const SParameter*                                  f_parameters
+                    ,float*                                             f_values
+                    ,uint8_t                                            f_count
+                    ,uint16_t                                           f_version);
+        /* Load the values from the flash */
+        bool load();
+        /* Save the values in the flash */
+        bool save();
+        /* Index of a parameter */
+        int32_t find(const char* f_key) const;
+        /* Set the value of a parameter */
+        bool set(const char* f_key, float f_value);
+        /* Restore the default values */
+        void restoreDefaults();
+        /* Set the write guard */
+        void setWriteGuard(FWriteGuard f_guard);
+        /* Set the work queue of the saving */
+        void setWorkQueue(utils::task::CWorkQueue* f_workQueue);
+        /** @brief  Get the value of a parameter by its index */
+        float get(uint8_t f_idx) const
+        {
+            return m_values[f_idx];
+        }
+        /** @brief  The values are loaded from the flash, not from the parameter table */
+        bool isLoaded() const
+        {
+            return m_isLoaded;
+        }
+        /* Serial callback to set a value */
+        void serialCallbackSet(char const * a, char * b);
+        /* Serial callback to get a value */
+        void serialCallbackGet(char const * a, char * b);
+        /* Serial callback to save the values */
+        void serialCallbackSave(char const * a, char * b);
+        /* Serial callback to restore the default values */
+        void serialCallbackDefault(char const * a, char * b);
+
+        /** @brief  Maximum number of the parameters */
+        static const uint8_t s_maxParameters = 64;
+        /** @brief  Maximum length of the names */
+        static const uint8_t s_maxKeyLength = 15;
+    private:
+        /* Save the values and write the result message */
+        void saveWork(char* f_result);
+        /* Scan the records of a sector */
+        void scan(uint8_t f_sector, const uint32_t*& f_last, uint32_t& f_sequence);
+        /* Checksum of a record */
+        uint32_t checksum(const uint32_t* f_record) const;
+        /* The sector is erased */
+        bool isBlank(uint8_t f_sector) const;
+        /** @brief  Address of a slot */
+        uint32_t slotAddress(uint8_t f_sector, uint32_t f_slot) const
+        {
+            return m_sectors[f_sector].m_address + f_slot * m_slotWords * 4;
+        }
+
+        /** @brief  Magic word of the records */
+        static const uint32_t s_magic = 0x53434642;         // "BFCS"
+        /** @brief  Words of the record header (magic, version and length, sequence) */
+        static const uint32_t s_headerWords = 3;
+
+        /** @brief  Sectors of the store */
+        hardware::drivers::CInternalFlash::SSector m_sectors[2];
+        /** @brief  Table of the parameters */
+        const SParameter* m_parameters;
+        /** @brief  Values of the parameters */
+        float* m_values;
+        /** @brief  Number of the parameters */
+        uint8_t m_count;
+        /** @brief  Version of the layout */
+        uint16_t m_version;
+        /** @brief  Words of a record */
+        uint32_t m_slotWords;
+        /** @brief  Records in a sector */
+        uint32_t m_slotCount;
+        /** @brief  Index of the active sector */
+        uint8_t m_active;
+        /** @brief  First free slot of the active sector */
+        uint32_t m_free;
+        /** @brief  Sequence number of the last record */
+        uint32_t m_sequence;
+        /** @brief  The other sector is erased */
+        bool m_isSpareBlank;
+        /** @brief  The sectors are outside of the program image */
+        bool m_isEnabled;
+        /** @brief  The values are loaded from the flash */
+        bool m_isLoaded;
+        /** @brief  Write guard */
+        FWriteGuard m_guard;
+        /** @brief  Work queue of the saving, NULL when the saving is applied by the serial callback */
+        utils::task::CWorkQueue* m_workQueue;
+    };
+
+}; // namespace utils::config
+
+#endif // CONFIG_STORE_HPP
@@ -0,0 +1,100 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    VehicleProfile.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the compile-time profiles of the vehicle variants.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef VEHICLE_PROFILE_HPP
+#define VEHICLE_PROFILE_HPP
+
+#include <stdint.h>
+
+namespace utils::config{
+
+   /**
+    * @brief Constant parameters of a vehicle variant, the rates, the geometry and the motor model of the objects are derived from them.
+    * 
+    * The profiles are constexpr, so the rate dependent expressions of the initializers are folded by the compiler. A variant is 
+    * selected at build time by its name ('make VEHICLE=<name>' gives VEHICLE_PROFILE=s_<name>), each firmware target has one 
+    * profile. The calibration values of the configuration store (controller gains, steering table) are stored per car in the flash.
+    */
+    struct SVehicleProfile
+    {
+        /** @brief  Base tick of the task manager (s) */
+        float m_baseTick;
+        /** @brief  Period of the control loop (s) */
+        float m_controlPeriod;
+        /** @brief  Resolution of the motor encoder (impulse per rotation) */
+        uint16_t m_encoderResolution;
+        /** @brief  Rising edges of the wheel sensor per rotation */
+        uint16_t m_wheelSensorEdges;
+        /** @brief  Motor rotations per meter of the car */
+        float m_rotationsPerMeter;
+        /** @brief  Wheelbase (m) */
+        float m_wheelbase;
+        /** @brief  Limit of the steering angle (degree) */
+        float m_maxSteering;
+        /** @brief  Grip limit of the longitudinal acceleration (m/s^2) */
+        float m_gripLimit;
+        /** @brief  Supply voltage of the bridge (V) */
+        float m_supply;
+        /** @brief  Resistance of the winding (Ohm) */
+        float m_resistance;
+        /** @brief  Inductance of the winding (H) */
+        float m_inductance;
+        /** @brief  Back-EMF constant (V/rps) */
+        float m_backEmf;
+        /** @brief  Inertia of the drivetrain on the motor shaft (kg*m^2) */
+        float m_inertia;
+        /** @brief  Viscous friction (N*m/rps) */
+        float m_friction;
+        /** @brief  Number of the lithium-polymer cells of the battery in series */
+        uint8_t m_batteryCells;
+        /** @brief  Capacity of the battery (Ah) */
+        float m_batteryCapacity;
+
+        /** @brief  Period of a task in base ticks, it's rounded, so the periods don't lose a tick by the float division */
+        constexpr uint32_t ticks(float f_period) const
+        {
+            return static_cast<uint32_t>(f_period / m_baseTick + 0.5f);
+        }
+        /** @brief  Distance of an encoder impulse (m) */
+        constexpr float metersPerImpulse() const
+        {
+            return 1.0f / (m_rotationsPerMeter * m_encoderResolution);
+        }
+    };
+
+    /** @brief  Profile of the BFMC 2020 car: 2048 impulse encoder on the motor, 150 rotation/m, 0.26 m wheelbase, 7.2 V (2S, 5 Ah) battery */
+    constexpr SVehicleProfile s_bfmc2020 = {0.0001f, 0.001f, 2048, 8, 150.0f, 0.26f, 23.0f, 3.0f, 7.2f, 1.0f, 2e-4f, 0.0288f, 1.05e-6f, 1e-5f, 2, 5.0f};
+
+#ifndef VEHICLE_PROFILE
+#define VEHICLE_PROFILE s_bfmc2020
+#endif
+
+    /** @brief  Profile of the built vehicle */
+    constexpr const SVehicleProfile& s_vehicle = VEHICLE_PROFILE;
+
+    static_assert(s_vehicle.m_controlPeriod >= s_vehicle.m_baseTick && s_vehicle.m_encoderResolution > 0, "Invalid vehicle profile.");
+
+}; // namespace utils::config
+
+#endif // VEHICLE_PROFILE_HPP
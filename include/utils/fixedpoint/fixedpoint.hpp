@@ -0,0 +1,105 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    FixedPoint.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the fixed-point numbers
+  *          with saturation arithmetic.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <stdint.h>
+#include <limits>
+
+namespace utils::fixedpoint
+{
+   /**
+    * @brief Signed fixed-point number with saturation arithmetic, like the q15_t and q31_t types of the CMSIS-DSP library. 
+    * 
+    * The value is stored in the TBase integer with NFrac fractional bits, the intermediate results are calculated in the TWide 
+    * integer and they are saturated to the range of the TBase. The multiplication is rounded to the nearest value. It can be 
+    * applied as the type of the variables in the CMatrix, CDiscreteTransferFunction, CIIRFilter and CPidController templates.
+    * 
+    * @tparam TBase    type of the stored integer (int16_t, int32_t)
+    * @tparam TWide    type of the intermediate results, it has to have double width (int32_t, int64_t)
+    * @tparam NFrac    number of the fractional bits
+    */
+    template <class TBase, class TWide, uint8_t NFrac>
+    class CFixedPoint
+    {
+    public:
+        using CThisType = CFixedPoint<TBase,TWide,NFrac>;
+
+        /* Constructors */
+        CFixedPoint();
+        CFixedPoint(int f_value);
+        CFixedPoint(float f_value);
+        CFixedPoint(double f_value);
+        /* Create from the stored integer */
+        static CThisType fromRaw(TBase f_raw);
+        /** @brief  Stored integer */
+        TBase raw() const
+        {
+            return m_raw;
+        }
+        /* Conversion to floating point */
+        explicit operator float() const;
+        explicit operator double() const;
+
+        /* Saturated arithmetic operators */
+        CThisType operator+(const CThisType& f_val) const;
+        CThisType operator-(const CThisType& f_val) const;
+        CThisType operator*(const CThisType& f_val) const;
+        CThisType operator/(const CThisType& f_val) const;
+        CThisType operator-() const;
+        CThisType& operator+=(const CThisType& f_val);
+        CThisType& operator-=(const CThisType& f_val);
+        CThisType& operator*=(const CThisType& f_val);
+        CThisType& operator/=(const CThisType& f_val);
+
+        /** @brief  Comparison operators */
+        bool operator==(const CThisType& f_val) const { return m_raw == f_val.m_raw; }
+        bool operator!=(const CThisType& f_val) const { return m_raw != f_val.m_raw; }
+        bool operator<(const CThisType& f_val) const { return m_raw < f_val.m_raw; }
+        bool operator>(const CThisType& f_val) const { return m_raw > f_val.m_raw; }
+        bool operator<=(const CThisType& f_val) const { return m_raw <= f_val.m_raw; }
+        bool operator>=(const CThisType& f_val) const { return m_raw >= f_val.m_raw; }
+
+    private:
+        /* Saturate the intermediate result */
+        static TBase saturate(TWide f_value);
+        /* Convert and saturate the floating point value */
+        static TBase fromFloating(double f_value);
+        /** @brief  Stored integer */
+        TBase m_raw;
+    };
+
+    /** @brief  Q15 type, the range is [-1,1) */
+    using CQ15 = CFixedPoint<int16_t,int32_t,15>;
+    /** @brief  Q31 type, the range is [-1,1) */
+    using CQ31 = CFixedPoint<int32_t,int64_t,31>;
+
+}; // namespace utils::fixedpoint
+
+#include "fixedpoint.tpp"
+
+#endif // FIXED_POINT_HPP
@@ -0,0 +1,224 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    FixedPoint.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the fixed-point 
+  *          numbers with saturation arithmetic.
+  ******************************************************************************
+ */
+
+#ifndef FIXED_POINT_TPP
+#define FIXED_POINT_TPP
+
+#ifndef FIXED_POINT_HPP
+#error __FILE__ should only be included from fixedpoint.hpp.
+#endif // FIXED_POINT_HPP
+
+namespace utils::fixedpoint{
+
+/** @brief  CFixedPoint class constructor, the value is zero
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>::CFixedPoint()
+    : m_raw(0)
+{
+}
+
+/** @brief  CFixedPoint class constructor
+ *
+ *  @param f_value         integer value, it's saturated to the range of the type
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>::CFixedPoint(int f_value)
+    : m_raw(saturate(static_cast<TWide>(f_value) * (static_cast<TWide>(1) << NFrac)))
+{
+}
+
+/** @brief  CFixedPoint class constructor
+ *
+ *  @param f_value         floating point value, it's rounded and saturated to the range of the type
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>::CFixedPoint(float f_value)
+    : m_raw(fromFloating(f_value))
+{
+}
+
+/** @brief  CFixedPoint class constructor
+ *
+ *  @param f_value         floating point value, it's rounded and saturated to the range of the type
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>::CFixedPoint(double f_value)
+    : m_raw(fromFloating(f_value))
+{
+}
+
+/** @brief  Create a number from the stored integer
+ *
+ *  @param f_raw           stored integer
+ *  @return                fixed-point number
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac> CFixedPoint<TBase,TWide,NFrac>::fromRaw(TBase f_raw)
+{
+    CThisType l_res;
+    l_res.m_raw = f_raw;
+    return l_res;
+}
+
+/** @brief  Conversion to float
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>::operator float() const
+{
+    return static_cast<float>(m_raw) / static_cast<float>(static_cast<TWide>(1) << NFrac);
+}
+
+/** @brief  Conversion to double
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>::operator double() const
+{
+    return static_cast<double>(m_raw) / static_cast<double>(static_cast<TWide>(1) << NFrac);
+}
+
+/** @brief  Saturated addition
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac> CFixedPoint<TBase,TWide,NFrac>::operator+(const CThisType& f_val) const
+{
+    return fromRaw(saturate(static_cast<TWide>(m_raw) + f_val.m_raw));
+}
+
+/** @brief  Saturated subtraction
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac> CFixedPoint<TBase,TWide,NFrac>::operator-(const CThisType& f_val) const
+{
+    return fromRaw(saturate(static_cast<TWide>(m_raw) - f_val.m_raw));
+}
+
+/** @brief  Saturated and rounded multiplication
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac> CFixedPoint<TBase,TWide,NFrac>::operator*(const CThisType& f_val) const
+{
+    TWide l_prod = static_cast<TWide>(m_raw) * f_val.m_raw;
+    return fromRaw(saturate((l_prod + (static_cast<TWide>(1) << (NFrac - 1))) >> NFrac));
+}
+
+/** @brief  Saturated division, the division by zero results the limit of the range with the sign of the dividend
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac> CFixedPoint<TBase,TWide,NFrac>::operator/(const CThisType& f_val) const
+{
+    if (f_val.m_raw == 0)
+    {
+        return fromRaw(m_raw < 0 ? std::numeric_limits<TBase>::min() : std::numeric_limits<TBase>::max());
+    }
+    return fromRaw(saturate(static_cast<TWide>(m_raw) * (static_cast<TWide>(1) << NFrac) / f_val.m_raw));
+}
+
+/** @brief  Saturated negation
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac> CFixedPoint<TBase,TWide,NFrac>::operator-() const
+{
+    return fromRaw(saturate(-static_cast<TWide>(m_raw)));
+}
+
+/** @brief  Saturated addition assignment
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>& CFixedPoint<TBase,TWide,NFrac>::operator+=(const CThisType& f_val)
+{
+    *this = *this + f_val;
+    return *this;
+}
+
+/** @brief  Saturated subtraction assignment
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>& CFixedPoint<TBase,TWide,NFrac>::operator-=(const CThisType& f_val)
+{
+    *this = *this - f_val;
+    return *this;
+}
+
+/** @brief  Saturated multiplication assignment
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>& CFixedPoint<TBase,TWide,NFrac>::operator*=(const CThisType& f_val)
+{
+    *this = *this * f_val;
+    return *this;
+}
+
+/** @brief  Saturated division assignment
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+CFixedPoint<TBase,TWide,NFrac>& CFixedPoint<TBase,TWide,NFrac>::operator/=(const CThisType& f_val)
+{
+    *this = *this / f_val;
+    return *this;
+}
+
+/** @brief  Saturate the intermediate result to the range of the stored integer
+ *
+ *  @param f_value         intermediate result
+ *  @return                saturated value
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+TBase CFixedPoint<TBase,TWide,NFrac>::saturate(TWide f_value)
+{
+    if (f_value > static_cast<TWide>(std::numeric_limits<TBase>::max()))
+    {
+        return std::numeric_limits<TBase>::max();
+    }
+    if (f_value < static_cast<TWide>(std::numeric_limits<TBase>::min()))
+    {
+        return std::numeric_limits<TBase>::min();
+    }
+    return static_cast<TBase>(f_value);
+}
+
+/** @brief  Convert the floating point value to the stored integer
+ *
+ *  @param f_value         floating point value
+ *  @return                rounded and saturated integer
+ */
+template <class TBase, class TWide, uint8_t NFrac>
+TBase CFixedPoint<TBase,TWide,NFrac>::fromFloating(double f_value)
+{
+    double l_scaled = f_value * static_cast<double>(static_cast<TWide>(1) << NFrac);
+    if (l_scaled >= static_cast<double>(std::numeric_limits<TBase>::max()))
+    {
+        return std::numeric_limits<TBase>::max();
+    }
+    if (l_scaled <= static_cast<double>(std::numeric_limits<TBase>::min()))
+    {
+        return std::numeric_limits<TBase>::min();
+    }
+    return static_cast<TBase>(l_scaled < 0 ? l_scaled - 0.5 : l_scaled + 0.5);
+}
+
+}; // namespace utils::fixedpoint
+
+#endif // FIXED_POINT_TPP
@@ -0,0 +1,135 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Format.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the declaration of the number formatting and 
+  *          parsing routines of the text protocol.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef FORMAT_HPP
+#define FORMAT_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief Number conversions of the text protocol without the printf and scanf family.
+ * 
+ * The floats are formatted with a fixed number of decimals by integer arithmetic (at most s_maxDecimals, the rounding is half away 
+ * from zero) and they are parsed with optional fraction and exponent, the integers are formatted and parsed in decimal with overflow 
+ * check. The parsers skip the leading spaces and they move the text pointer after the number, so a frame is parsed in a single pass.
+ */
+namespace utils::fmt{
+
+    /** @brief  Maximum number of the decimals */
+    const uint8_t s_maxDecimals = 9;
+    /** @brief  Largest magnitude of the formatted floats, the larger values are written as 'inf' */
+    const float s_maxFloat = 4294967040.0f;
+    /** @brief  Size of the buffer of the longest formatted float with the terminating character ('-4294967040.' and the decimals) */
+    const uint8_t s_floatSize = 13 + s_maxDecimals;
+    /** @brief  Size of the buffer of the longest formatted integer with the terminating character */
+    const uint8_t s_intSize = 12;
+
+    /* Format an unsigned integer, it returns the number of the written characters */
+    uint32_t formatUint(char* f_buffer, uint32_t f_value);
+    /* Format a signed integer */
+    uint32_t formatInt(char* f_buffer, int32_t f_value);
+    /* Format an unsigned integer in hexadecimal */
+    uint32_t formatHex(char* f_buffer, uint32_t f_value);
+    /* Format a float with fixed number of decimals */
+    uint32_t formatFloat(char* f_buffer, float f_value, uint8_t f_decimals);
+    /* Parse an unsigned integer */
+    bool parseUint(const char*& f_text, uint32_t& f_value);
+    /* Parse a signed integer */
+    bool parseInt(const char*& f_text, int32_t& f_value);
+    /* Parse a float */
+    bool parseFloat(const char*& f_text, float& f_value);
+    /* Parse the floats separated by ';', it returns the number of the parsed values as sscanf */
+    uint8_t parseFloats(const char* f_text, float* f_values, uint8_t f_count);
+
+   /**
+    * @brief Writer of a text in a buffer, the text is kept null terminated after each call as by sprintf.
+    * 
+    * The capacity isn't verified, the buffer has to hold the longest text (the responses of the serial callbacks have 256 bytes).
+    */
+    class CWriter
+    {
+    public:
+        /** @brief  Constructor, it starts an empty text */
+        explicit CWriter(char* f_buffer)
+            : m_buffer(f_buffer)
+            , m_end(f_buffer)
+        {
+            *m_end = '\0';
+        }
+        /** @brief  Append a string */
+        CWriter& text(const char* f_text)
+        {
+            while (*f_text != '\0')
+            {
+                *m_end++ = *f_text++;
+            }
+            *m_end = '\0';
+            return *this;
+        }
+        /** @brief  Append a character */
+        CWriter& chr(char f_char)
+        {
+            *m_end++ = f_char;
+            *m_end = '\0';
+            return *this;
+        }
+        /** @brief  Append a float with fixed number of decimals and the separator */
+        CWriter& fixed(float f_value, uint8_t f_decimals, char f_separator = ';')
+        {
+            m_end += formatFloat(m_end, f_value, f_decimals);
+            return chr(f_separator);
+        }
+        /** @brief  Append a signed integer and the separator */
+        CWriter& dec(int32_t f_value, char f_separator = ';')
+        {
+            m_end += formatInt(m_end, f_value);
+            return chr(f_separator);
+        }
+        /** @brief  Append an unsigned integer and the separator */
+        CWriter& udec(uint32_t f_value, char f_separator = ';')
+        {
+            m_end += formatUint(m_end, f_value);
+            return chr(f_separator);
+        }
+        /** @brief  Length of the text */
+        uint32_t length() const
+        {
+            return m_end - m_buffer;
+        }
+        /** @brief  Beginning of the text */
+        const char* data() const
+        {
+            return m_buffer;
+        }
+    private:
+        /** @brief  Beginning of the buffer */
+        char* m_buffer;
+        /** @brief  Terminating character of the text */
+        char* m_end;
+    };
+
+}; // namespace utils::fmt
+
+#endif // FORMAT_HPP
@@ -0,0 +1,124 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Delegate.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the statically 
+  *          bound delegate.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef DELEGATE_HPP
+#define DELEGATE_HPP
+
+#include <stddef.h>
+
+namespace utils::function{
+
+    template <class TSignature>
+    class CDelegate;
+
+   /**
+    * @brief Delegate of a function or of a member function, which is bound at compile time.
+    * 
+    * The function is a template parameter of the 'bind' method, so the delegate stores only the object and a pointer to a stub, 
+    * which is generated for the bound function. The call is one indirect call of the stub and the bound function is called directly 
+    * (inlined) in it. It needs two words without heap, there is no table of operations as by mbed::Callback. The 'bind' is constexpr, 
+    * so a static table of delegates is initialized without constructors.
+    * 
+    * Usage: CDelegate<void(char const*, char*)>::bind<CClass, &CClass::method>(&object)
+    * 
+    * @tparam R              return type
+    * @tparam Args           types of the parameters
+    */
+    template <class R, class... Args>
+    class CDelegate<R(Args...)>
+    {
+    public:
+        /** @brief  Empty delegate, it mustn't be called */
+        constexpr CDelegate()
+            : m_object(NULL)
+            , m_stub(NULL)
+        {
+        }
+        /** @brief  Bind a member function to an object */
+        template <class C, R (C::*TMethod)(Args...)>
+        static constexpr CDelegate bind(C* f_object)
+        {
+            return CDelegate(f_object, &memberStub<C, TMethod>);
+        }
+        /** @brief  Bind a const member function to an object */
+        template <class C, R (C::*TMethod)(Args...) const>
+        static constexpr CDelegate bind(const C* f_object)
+        {
+            return CDelegate(const_cast<C*>(f_object), &constMemberStub<C, TMethod>);
+        }
+        /** @brief  Bind a free function */
+        template <R (*TFunction)(Args...)>
+        static constexpr CDelegate bind()
+        {
+            return CDelegate(NULL, &functionStub<TFunction>);
+        }
+        /** @brief  Call the bound function */
+        R operator()(Args... f_args) const
+        {
+            return m_stub(m_object, f_args...);
+        }
+        /** @brief  A function is bound */
+        explicit operator bool() const
+        {
+            return m_stub != NULL;
+        }
+    private:
+        /** @brief  Stub of the bound function */
+        typedef R (*FStub)(void*, Args...);
+        /** @brief  Constructor of a bound delegate */
+        constexpr CDelegate(void* f_object, FStub f_stub)
+            : m_object(f_object)
+            , m_stub(f_stub)
+        {
+        }
+        /** @brief  Stub of a member function */
+        template <class C, R (C::*TMethod)(Args...)>
+        static R memberStub(void* f_object, Args... f_args)
+        {
+            return (static_cast<C*>(f_object)->*TMethod)(f_args...);
+        }
+        /** @brief  Stub of a const member function */
+        template <class C, R (C::*TMethod)(Args...) const>
+        static R constMemberStub(void* f_object, Args... f_args)
+        {
+            return (static_cast<const C*>(f_object)->*TMethod)(f_args...);
+        }
+        /** @brief  Stub of a free function */
+        template <R (*TFunction)(Args...)>
+        static R functionStub(void* f_object, Args... f_args)
+        {
+            return TFunction(f_args...);
+        }
+
+        /** @brief  Bound object, NULL for the free functions */
+        void* m_object;
+        /** @brief  Stub of the bound function */
+        FStub m_stub;
+    };
+
+}; // namespace utils::function
+
+#endif // DELEGATE_HPP
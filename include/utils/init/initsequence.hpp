@@ -0,0 +1,94 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    InitSequence.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the prioritized 
+  *          initialization sequence of the platform.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef INIT_SEQUENCE_HPP
+#define INIT_SEQUENCE_HPP
+
+#include <mbed.h>
+#include <utils/serial/serialtransmitter.hpp>
+
+namespace utils::init{
+
+    /** @brief  Phases of the initialization, they are applied in this order */
+    enum EPhase{
+        HARDWARE = 0,       /**< peripherals and actuators in safe state, sensors */
+        COMMUNICATION,      /**< serial receivers and task threads */
+        CONTROL,            /**< watchdog and control loop, the motion commands are accepted after it */
+        REPORT,             /**< banner and reports, they aren't needed for the motion */
+        PHASE_COUNT
+    };
+
+   /**
+    * @brief It applies the initialization stages of the platform phase by phase and it measures their duration.
+    * 
+    * The stages are given by a static list, inside of a phase they are applied in the order of the list. A failed stage doesn't stop 
+    * the sequence, it's reported together with the durations. The times are measured by the microsecond ticker from the start of 
+    * the sequence, the static initialization before the main function isn't included.
+    * 
+    * The request '#BOOT:;;' returns 'total;ready;failed;name0:us0;name1:us1;...;;', the time of the sequence and the time until the 
+    * end of the control phase in microseconds, the number of the failed stages and the durations of the stages.
+    */
+    class CInitSequence
+    {
+    public:
+        /** @brief  Initialization function of a stage, it returns false, when the stage failed */
+        typedef mbed::Callback<bool()> FInit;
+        /** @brief  Stage of the sequence */
+        struct SStage
+        {
+            const char* m_name;     /**< name of the stage in the reports */
+            EPhase      m_phase;    /**< phase of the stage */
+            FInit       m_init;     /**< initialization function */
+            uint32_t    m_duration; /**< measured duration in microseconds */
+            bool        m_isFailed; /**< the stage failed */
+        };
+
+        /* Constructor */
+        CInitSequence(SStage* f_stages, uint32_t f_nrStages);
+        /* Apply the stages */
+        bool run();
+        /* Send the summary of the boot */
+        void report(utils::serial::CSerialTransmitter& f_transmitter) const;
+        /* Time from the start of the sequence to the end of the control phase */
+        uint32_t getReadyTime() const;
+        /* Serial callback */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  List of the stages */
+        SStage* const m_stages;
+        /** @brief  Number of the stages */
+        const uint32_t m_nrStages;
+        /** @brief  Duration of the sequence in microseconds */
+        uint32_t m_total;
+        /** @brief  Time until the end of the control phase in microseconds */
+        uint32_t m_ready;
+        /** @brief  Number of the failed stages */
+        uint32_t m_failed;
+    };
+
+}; // namespace utils::init
+
+#endif // INIT_SEQUENCE_HPP
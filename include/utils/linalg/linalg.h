@@ -28,10 +28,201 @@ limitations under the License.
 // #include <mbed.h>
 #include <stdint.h>
 #include <array>
+#include <utility>
+#include <type_traits>
 
 namespace utils::linalg
 {   
 
+    /**
+     * @brief Compile-time unrolled loop for the small dimensions. The functor is applied with the indexes 0..N-1, after the inlining 
+     * the indexes are constant, so the elements can be kept in registers. Above the limit a normal loop is generated.
+     * 
+     * @tparam N        number of the iterations
+     * @tparam NUnroll  selection of the unrolled implementation
+     */
+    template <uint32_t N, bool NUnroll = (N <= 8)>
+    struct SUnroll
+    {
+        template <class F>
+        static inline void apply(F&& f_func)
+        {
+            SUnroll<N-1>::apply(f_func);
+            f_func(N-1);
+        }
+    };
+
+    /** @brief End of the unrolled loop */
+    template <>
+    struct SUnroll<0,true>
+    {
+        template <class F>
+        static inline void apply(F&&)
+        {
+        }
+    };
+
+    /** @brief Normal loop for the great dimensions */
+    template <uint32_t N>
+    struct SUnroll<N,false>
+    {
+        template <class F>
+        static inline void apply(F&& f_func)
+        {
+            for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+            {
+                f_func(l_idx);
+            }
+        }
+    };
+
+    template <class T, uint32_t M, uint32_t N>
+    class CMatrix;
+
+    /* Matrix product: f_res = f_A * f_B */
+    template <class T, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiply(CMatrix<T,M,P>& f_res, const CMatrix<T,M,N>& f_A, const CMatrix<T,N,P>& f_B);
+
+    /**
+     * @brief Non-owning view of a (M x N) block of matrix elements with row and column strides. 
+     * 
+     * The view refers to the elements of a matrix or of a plain buffer, so the blocks, the rows, the columns and the transposed matrix are 
+     * accessed without copying. The assignments and the compound operators write the viewed elements, the view itself can't be rebound. 
+     * The view with const type is read only, the view of a temporary matrix mustn't be kept. The source of an assignment mustn't overlap 
+     * the target, except it's the same view.
+     * 
+     * @tparam T        type of the elements, it can be const
+     * @tparam M        number of rows
+     * @tparam N        number of columns
+     */
+    template <class T, uint32_t M, uint32_t N>
+    class CMatrixView
+    {
+    public:
+        using CThisType = CMatrixView<T,M,N>;
+        using CDataType = T;
+        using CValueType = typename std::remove_const<T>::type;
+        using CMatrixType = CMatrix<CValueType,M,N>;
+        using CTransposeType = CMatrixView<T,N,M>;
+
+        /** @brief  View of the elements from the pointer, the element (i,j) is f_data[i*f_rowStride + j*f_colStride] */
+        CMatrixView(T* f_data, uint32_t f_rowStride, uint32_t f_colStride = 1)
+            : m_data(f_data), m_rowStride(f_rowStride), m_colStride(f_colStride) {}
+        CMatrixView(const CThisType& f_view) = default;
+        /** @brief  Read only view of a writable view */
+        template <class U, class = typename std::enable_if<std::is_convertible<U*,T*>::value>::type>
+        CMatrixView(const CMatrixView<U,M,N>& f_view)
+            : m_data(f_view.data()), m_rowStride(f_view.rowStride()), m_colStride(f_view.colStride()) {}
+
+        /** @brief  Copy the elements of the view of same size */
+        CThisType& operator=(const CThisType& f_view)
+        {
+            if (f_view.m_data != m_data)
+            {
+                apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) = f_view(l_row,l_col); });
+            }
+            return *this;
+        }
+        /** @brief  Copy the elements of the view of same size */
+        template <class U>
+        CThisType& operator=(const CMatrixView<U,M,N>& f_view)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) = f_view(l_row,l_col); });
+            return *this;
+        }
+        /** @brief  Copy the elements of the matrix of same size */
+        CThisType& operator=(const CMatrixType& f_matrix)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) = f_matrix[l_row][l_col]; });
+            return *this;
+        }
+        template <class U>
+        CThisType& operator+=(const CMatrixView<U,M,N>& f_view)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) += f_view(l_row,l_col); });
+            return *this;
+        }
+        CThisType& operator+=(const CMatrixType& f_matrix)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) += f_matrix[l_row][l_col]; });
+            return *this;
+        }
+        template <class U>
+        CThisType& operator-=(const CMatrixView<U,M,N>& f_view)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) -= f_view(l_row,l_col); });
+            return *this;
+        }
+        CThisType& operator-=(const CMatrixType& f_matrix)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) -= f_matrix[l_row][l_col]; });
+            return *this;
+        }
+        CThisType& operator*=(const CValueType& f_val)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) *= f_val; });
+            return *this;
+        }
+        /** @brief  Set all elements to the value */
+        void fill(const CValueType& f_val)
+        {
+            apply([&](uint32_t l_row, uint32_t l_col){ (*this)(l_row,l_col) = f_val; });
+        }
+
+        T& operator()(uint32_t f_row, uint32_t f_col) const
+        {
+            return m_data[f_row * m_rowStride + f_col * m_colStride];
+        }
+        /** @brief  View of the (R x C) block from the given element */
+        template <uint32_t R, uint32_t C>
+        CMatrixView<T,R,C> block(uint32_t f_row, uint32_t f_col) const
+        {
+            return CMatrixView<T,R,C>(&(*this)(f_row,f_col), m_rowStride, m_colStride);
+        }
+        CMatrixView<T,1,N> row(uint32_t f_row) const
+        {
+            return block<1,N>(f_row, 0);
+        }
+        CMatrixView<T,M,1> col(uint32_t f_col) const
+        {
+            return block<M,1>(0, f_col);
+        }
+        /** @brief  View of the transposed matrix, the strides are swapped */
+        CTransposeType transposed() const
+        {
+            return CTransposeType(m_data, m_colStride, m_rowStride);
+        }
+        /** @brief  Copy of the viewed elements into a matrix */
+        CMatrixType toMatrix() const
+        {
+            CMatrixType l_matrix;
+            apply([&](uint32_t l_row, uint32_t l_col){ l_matrix[l_row][l_col] = (*this)(l_row,l_col); });
+            return l_matrix;
+        }
+
+        T* data() const {return m_data;}
+        uint32_t rowStride() const {return m_rowStride;}
+        uint32_t colStride() const {return m_colStride;}
+
+    private:
+        /** @brief  Apply the functor with the indexes of all elements */
+        template <class F>
+        void apply(F&& f_func) const
+        {
+            SUnroll<M>::apply([&](uint32_t l_row){
+                SUnroll<N>::apply([&](uint32_t l_col){
+                    f_func(l_row, l_col);
+                });
+            });
+        }
+        /** @brief  First element */
+        T* const m_data;
+        /** @brief  Distance of the rows in elements */
+        const uint32_t m_rowStride;
+        /** @brief  Distance of the columns in elements */
+        const uint32_t m_colStride;
+    };
+
     /**
      * @brief CMatrix has aim to implement matrix's functionality. It's a templated class, where the templates defines the type and the size of the matrix. 
      * For the (m x n) -dimensions matrix the row and colum index starts with 0 value and ends with m and n, respectively. 
@@ -63,11 +254,12 @@ namespace utils::linalg
 
         friend class CMatrix<T,N,M>; 
 
-        CMatrix() : m_data() {}
-        CMatrix(const CThisType& f_matrix) : m_data(f_matrix.m_data) {}
-        CMatrix(const CThisType&& f_matrix) : m_data(f_matrix.m_data) {}
-        CMatrix(const CContainerType& f_data) : m_data(f_data) {}
-        CMatrix(const CContainerType&& f_data) : m_data(f_data) {}
+        // The constructors are constexpr, so a matrix of constant coefficients is a literal and it's placed in flash
+        constexpr CMatrix() : m_data() {}
+        constexpr CMatrix(const CThisType& f_matrix) : m_data(f_matrix.m_data) {}
+        constexpr CMatrix(const CThisType&& f_matrix) : m_data(f_matrix.m_data) {}
+        constexpr CMatrix(const CContainerType& f_data) : m_data(f_data) {}
+        constexpr CMatrix(const CContainerType&& f_data) : m_data(f_data) {}
 
         CThisType& operator=(const CThisType& f_matrix)
         {
@@ -102,12 +294,12 @@ namespace utils::linalg
             return m_data[f_row][f_col];
         }
 
-        const std::array<T,N>& operator[](uint32_t f_row) const
+        constexpr const std::array<T,N>& operator[](uint32_t f_row) const
         {
             return m_data[f_row];
         }
 
-        const CDataType& operator()(uint32_t f_row, uint32_t f_col) const
+        constexpr const CDataType& operator()(uint32_t f_row, uint32_t f_col) const
         {
             return m_data[f_row][f_col];
         }
@@ -235,11 +427,22 @@ namespace utils::linalg
             }
             return *this;
         }
+        /** @brief  In-place product of square matrices, each row is replaced by its product with the operand through a row buffer */
         CThisType& operator*=(const CThisType& f_val)
         {
-            CThisType& l_thisRef(*this);
-            l_thisRef = l_thisRef * f_val;
-            return l_thisRef;
+            static_assert(M == N, "The in-place product needs square matrix.");
+            for (uint32_t l_row = 0; l_row < M; ++l_row)
+            {
+                std::array<T,N> l_buffer(m_data[l_row]);
+                SUnroll<N>::apply([&](uint32_t l_col){
+                    T l_sum = l_buffer[0] * f_val.m_data[0][l_col];
+                    SUnroll<N-1>::apply([&](uint32_t l_idx){
+                        l_sum += l_buffer[l_idx+1] * f_val.m_data[l_idx+1][l_col];
+                    });
+                    m_data[l_row][l_col] = l_sum;
+                });
+            }
+            return *this;
         }
         CThisType& operator/=(const CDataType& f_val)
         {
@@ -268,17 +471,7 @@ namespace utils::linalg
         CRightMultiplicationResultType<P> operator*(const CRightMultipliableType<P>& f_matrix)
         {
             CRightMultiplicationResultType<P> l_matrix;
-            for (uint32_t l_row = 0; l_row < M; ++l_row)
-            {
-                for (uint32_t l_col = 0; l_col < P; ++l_col)
-                {
-                    l_matrix[l_row][l_col] = 0;
-                    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
-                    {
-                        l_matrix[l_row][l_col] += this->m_data[l_row][l_idx] * f_matrix[l_idx][l_col];
-                    }
-                }
-            }
+            multiply(l_matrix, *this, f_matrix);
             return l_matrix;
         }
         CThisType inv();
@@ -299,10 +492,25 @@ namespace utils::linalg
         }
 
         template <uint32_t P>
-        CRightMultiplicationResultType<P> solve(const CRightMultipliableType<P>& f_B)
-        {
-            return CLUDecomposition(*this).solve();
-        }
+        CRightMultiplicationResultType<P> solve(const CRightMultipliableType<P>& f_B);
+
+        /** @brief  View of the whole matrix */
+        CMatrixView<T,M,N> view() {return CMatrixView<T,M,N>(&m_data[0][0], N);}
+        CMatrixView<const T,M,N> view() const {return CMatrixView<const T,M,N>(&m_data[0][0], N);}
+        /** @brief  View of the (R x C) block from the given element */
+        template <uint32_t R, uint32_t C>
+        CMatrixView<T,R,C> block(uint32_t f_row, uint32_t f_col) {return view().template block<R,C>(f_row, f_col);}
+        template <uint32_t R, uint32_t C>
+        CMatrixView<const T,R,C> block(uint32_t f_row, uint32_t f_col) const {return view().template block<R,C>(f_row, f_col);}
+        /** @brief  View of a row */
+        CMatrixView<T,1,N> row(uint32_t f_row) {return view().row(f_row);}
+        CMatrixView<const T,1,N> row(uint32_t f_row) const {return view().row(f_row);}
+        /** @brief  View of a column */
+        CMatrixView<T,M,1> col(uint32_t f_col) {return view().col(f_col);}
+        CMatrixView<const T,M,1> col(uint32_t f_col) const {return view().col(f_col);}
+        /** @brief  View of the transposed matrix without copy */
+        CMatrixView<T,N,M> transposed() {return view().transposed();}
+        CMatrixView<const T,N,M> transposed() const {return view().transposed();}
 
         static CThisType zeros()
         {
@@ -351,6 +559,13 @@ namespace utils::linalg
         std::array<std::array<T,N>,M> m_data;
     };
 
+    /**
+     * @brief LU decomposition with partial pivoting (P*A = L*U). The L and U factors are stored in place in one matrix, the unit 
+     * diagonal of L isn't stored. The linear systems are solved by forward and backward substitution, without forming the inverses.
+     * 
+     * @tparam T        type of the elements
+     * @tparam N        size of the square matrix
+     */
     template<class T, uint32_t N>
     class CLUDecomposition
     {
@@ -359,145 +574,309 @@ namespace utils::linalg
         using COriginalType = CMatrix<T,N,N>;
         using CDataType =T;
 
-        template <uint32_t P>
-        using CLeftMultipliableType = CMatrix<T,P,N>;
-
         template <uint32_t P>
         using CRightMultipliableType = CMatrix<T,N,P>;
 
-        template <uint32_t P>
-        using CLeftMultiplicationResultType = CMatrix<T,P,N>;
-
         template <uint32_t P>
         using CRightMultiplicationResultType = CMatrix<T,N,P>;
 
-        CLUDecomposition(const CThisType& f_decomposition) : m_L(f_decomposition.m_L), m_U(f_decomposition.m_U), m_P(f_decomposition.m_P) {}
-        CLUDecomposition(const CThisType&& f_decomposition) : m_L(f_decomposition.m_L), m_U(f_decomposition.m_U), m_P(f_decomposition.m_P) {}
-        CLUDecomposition(const COriginalType& f_matrix) : m_L(), m_U(), m_P() {decompose(f_matrix);}
-        CLUDecomposition(const COriginalType&& f_matrix) : m_L(), m_U(), m_P() {decompose(f_matrix);}
-
-        operator COriginalType()
-        {
-            return m_L * m_U;
-        }
+        CLUDecomposition(const CThisType& f_decomposition) : m_LU(f_decomposition.m_LU), m_P(f_decomposition.m_P), m_singular(f_decomposition.m_singular) {}
+        CLUDecomposition(const COriginalType& f_matrix) : m_LU(f_matrix), m_P(), m_singular(false) {decompose();}
 
-        COriginalType inv()
+        /* Reconstruct the original matrix */
+        operator COriginalType() const;
+        /* Inverse matrix */
+        COriginalType inv() const;
+        /* Solve the system A*X = B */
+        template <uint32_t P>
+        CRightMultiplicationResultType<P> solve(const CRightMultipliableType<P>& f_B) const;
+        /* Solve the system A*X = B, the right-hand side is overwritten by the solution */
+        template <uint32_t P>
+        void solveInPlace(CRightMultipliableType<P>& f_B) const;
+        /** @brief  It returns true, when a zero pivot was found */
+        bool isSingular() const
         {
-            return triUInv() * triLInv();
+            return m_singular;
         }
 
-        COriginalType triLInv()
-        {
-            COriginalType l_invL(m_L);
-
-            for (uint32_t l_jdx = 0; l_jdx < N; ++l_jdx)
-            {
-                l_invL[l_jdx][l_jdx] = 1/l_invL[l_jdx][l_jdx];
-
-                for (uint32_t l_idx = l_jdx+1; l_idx < N; ++l_idx)
-                {
-                    l_invL[l_idx][l_jdx] = 0;
+    private:
+        /* In-place decomposition */
+        void decompose();
+        /** @brief  L factor under the diagonal and U factor on and over the diagonal */
+        CMatrix<T,N,N> m_LU;
+        /** @brief  Row permutation, the i-th row of P*A is the m_P[i]-th row of A */
+        std::array<uint32_t,N> m_P;
+        /** @brief  Zero pivot was found */
+        bool m_singular;
+    };
 
-                    for (uint32_t l_kdx = l_jdx; l_kdx < l_idx; ++l_kdx)
-                    {
-                        l_invL[l_idx][l_jdx] -= m_L[l_idx][l_kdx]*l_invL[l_kdx][l_jdx];
-                    }
+    /**
+     * @brief LDL^T decomposition (square-root free Cholesky decomposition) of a symmetric positive-definite matrix (A = L*D*L^T), 
+     * for example a covariance matrix. Only the lower triangle of the matrix is read. The unit lower triangular L and 
+     * the diagonal D are stored in one matrix.
+     * 
+     * @tparam T        type of the elements
+     * @tparam N        size of the square matrix
+     */
+    template<class T, uint32_t N>
+    class CCholeskyDecomposition
+    {
+    public:
+        using CThisType = CCholeskyDecomposition<T,N>;
+        using COriginalType = CMatrix<T,N,N>;
 
-                    l_invL[l_idx][l_jdx] /= l_invL[l_idx][l_idx];
-                }
-            }
+        template <uint32_t P>
+        using CRightMultipliableType = CMatrix<T,N,P>;
 
-            return l_invL;
-        }
+        CCholeskyDecomposition(const COriginalType& f_matrix) : m_LD(f_matrix), m_positiveDefinite(true) {decompose();}
 
-        COriginalType triUInv()
+        /* Inverse matrix */
+        COriginalType inv() const;
+        /* Solve the system A*X = B */
+        template <uint32_t P>
+        CRightMultipliableType<P> solve(const CRightMultipliableType<P>& f_B) const;
+        /* Solve the system A*X = B, the right-hand side is overwritten by the solution */
+        template <uint32_t P>
+        void solveInPlace(CRightMultipliableType<P>& f_B) const;
+        /** @brief  It returns false, when a not positive diagonal value was found */
+        bool isPositiveDefinite() const
         {
-            COriginalType l_invU(m_U);
+            return m_positiveDefinite;
+        }
 
-            for (int32_t l_jdx = (N-1); l_jdx >= 0; --l_jdx)
-            {
-                l_invU[l_jdx][l_jdx] = 1/l_invU[l_jdx][l_jdx];
+    private:
+        /* In-place decomposition */
+        void decompose();
+        /** @brief  L factor under the diagonal and D on the diagonal */
+        CMatrix<T,N,N> m_LD;
+        /** @brief  All diagonal values of D are positive */
+        bool m_positiveDefinite;
+    };
 
-                for (int32_t l_idx = (l_jdx-1); l_idx >= 0; --l_idx)
-                {
-                    l_invU[l_idx][l_jdx] = 0;
+    template <class T, uint32_t N>
+    using CColVector = CMatrix<T,N,1>;
 
-                    for (int32_t l_kdx = (l_idx+1); l_kdx < (l_jdx+1); ++l_kdx)
-                    {
-                        l_invU[l_idx][l_jdx] -= m_U[l_idx][l_kdx]*l_invU[l_kdx][l_jdx];
-                    }
+    template <class T, uint32_t N>
+    using CVector = CColVector<T,N>;
 
-                    l_invU[l_idx][l_jdx] /= l_invU[l_idx][l_idx];
-                }
-            }
+    template <class T, uint32_t N>
+    using CRowVector = CMatrix<T,1,N>;
 
-            return l_invU;
-        }
+    /**
+     * @brief Fused kernels without temporary matrices, the result is written into the given reference. The loops are unrolled 
+     * for the small dimensions. The result mustn't be the same object as the operands.
+     */
 
-        template <uint32_t P>
-        CRightMultiplicationResultType<P> solve(const CRightMultipliableType<P>& f_B)
-        {
-            CRightMultipliableType<P> l_B;
+    /** @brief  Dot product of a row and a column vector */
+    template <class T, uint32_t N>
+    inline T dot(const CRowVector<T,N>& f_a, const CColVector<T,N>& f_b)
+    {
+        T l_sum = f_a[0][0] * f_b[0][0];
+        SUnroll<N-1>::apply([&](uint32_t l_idx){
+            l_sum += f_a[0][l_idx+1] * f_b[l_idx+1][0];
+        });
+        return l_sum;
+    }
 
-            for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
-            {
-                for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
-                {
-                    l_B[l_idx][l_jdx] = f_B[m_P[l_idx]][l_jdx];
-                }
-            }
+    /**
+     * @brief Selection of the product kernel by the size at compile time. Up to the 4x4 matrices (and for the narrow results) 
+     * the fully unrolled kernel is inlined, above it the blocked kernel is used, which calculates four columns of the 
+     * result together: each element of the left operand is loaded once for the four accumulators and the loop overhead 
+     * is shared, like by the CMSIS-DSP kernels.
+     */
+    template <uint32_t M, uint32_t N, uint32_t P>
+    struct SBlockedProduct
+    {
+        static const bool value = (P >= 4) && (M * N * P > 64);
+    };
 
-            return sTriL(sTriU(l_B));
-        }
+    /** @brief  Combination of the result and the calculated product: assignment (0), addition (1) or subtraction (-1) */
+    template <int NMode>
+    struct SProductStore
+    {
+        template <class T>
+        static inline void apply(T& f_dst, const T& f_val) {f_dst = f_val;}
+    };
+    template <>
+    struct SProductStore<1>
+    {
+        template <class T>
+        static inline void apply(T& f_dst, const T& f_val) {f_dst += f_val;}
+    };
+    template <>
+    struct SProductStore<-1>
+    {
+        template <class T>
+        static inline void apply(T& f_dst, const T& f_val) {f_dst -= f_val;}
+    };
 
-        template <uint32_t P>
-        CRightMultiplicationResultType<P> sTriU(const CRightMultipliableType<P>& f_B)
-        {
-            return triUInv()*f_B;
+    /** @brief  Fully unrolled product kernel of the small matrices */
+    template <bool NBlocked>
+    struct SProductKernel
+    {
+        template <int NMode, class T, uint32_t M, uint32_t N, uint32_t P>
+        static inline void apply(CMatrix<T,M,P>& f_res, const CMatrix<T,M,N>& f_A, const CMatrix<T,N,P>& f_B)
+        {
+            SUnroll<M>::apply([&](uint32_t l_row){
+                SUnroll<P>::apply([&](uint32_t l_col){
+                    T l_sum = f_A[l_row][0] * f_B[0][l_col];
+                    SUnroll<N-1>::apply([&](uint32_t l_idx){
+                        l_sum += f_A[l_row][l_idx+1] * f_B[l_idx+1][l_col];
+                    });
+                    SProductStore<NMode>::apply(f_res[l_row][l_col], l_sum);
+                });
+            });
         }
+    };
 
-        template <uint32_t P>
-        CRightMultiplicationResultType<P> sTriL(const CRightMultipliableType<P>& f_B)
+    /** @brief  Blocked product kernel of the great matrices, four columns of a row are accumulated in registers */
+    template <>
+    struct SProductKernel<true>
+    {
+        template <int NMode, class T, uint32_t M, uint32_t N, uint32_t P>
+        static inline void apply(CMatrix<T,M,P>& f_res, const CMatrix<T,M,N>& f_A, const CMatrix<T,N,P>& f_B)
         {
-            // return triLInv()*f_B;
-        }
-
-
-    // private:
-        void decompose(const CMatrix<T,N,N>& f_matrix)
-                {
-            m_U = f_matrix;
-            for (uint32_t l_kdx = 0; l_kdx < (N-1); ++l_kdx)
+            for (uint32_t l_row = 0; l_row < M; ++l_row)
             {
-                m_L[l_kdx][l_kdx] = 1;
-                m_P[l_kdx] = l_kdx;
-
-                for(uint32_t l_idx = l_kdx+1; l_idx < N; ++l_idx)
+                const std::array<T,N>& l_a = f_A[l_row];
+                std::array<T,P>& l_res = f_res[l_row];
+                uint32_t l_col = 0;
+                for (; l_col + 4 <= P; l_col += 4)
                 {
-                    m_L[l_idx][l_kdx] = m_U[l_idx][l_kdx]/m_U[l_kdx][l_kdx];
-                    m_U[l_idx][l_kdx] = 0;
-                    for(uint32_t l_jdx = l_kdx+1; l_jdx < N; ++l_jdx)
+                    T l_sum0 = T(0), l_sum1 = T(0), l_sum2 = T(0), l_sum3 = T(0);
+                    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
                     {
-                        m_U[l_idx][l_jdx] = m_U[l_idx][l_jdx] - m_L[l_idx][l_kdx]*m_U[l_kdx][l_jdx];
+                        const T l_val = l_a[l_idx];
+                        const std::array<T,P>& l_b = f_B[l_idx];
+                        l_sum0 += l_val * l_b[l_col];
+                        l_sum1 += l_val * l_b[l_col+1];
+                        l_sum2 += l_val * l_b[l_col+2];
+                        l_sum3 += l_val * l_b[l_col+3];
                     }
+                    SProductStore<NMode>::apply(l_res[l_col], l_sum0);
+                    SProductStore<NMode>::apply(l_res[l_col+1], l_sum1);
+                    SProductStore<NMode>::apply(l_res[l_col+2], l_sum2);
+                    SProductStore<NMode>::apply(l_res[l_col+3], l_sum3);
+                }
+                // Remaining (P mod 4) columns
+                for (; l_col < P; ++l_col)
+                {
+                    T l_sum = T(0);
+                    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+                    {
+                        l_sum += l_a[l_idx] * f_B[l_idx][l_col];
+                    }
+                    SProductStore<NMode>::apply(l_res[l_col], l_sum);
                 }
             }
-            m_L[N-1][N-1] = 1;
-            m_P[N-1] = N-1;
         }
-        CMatrix<T,N,N> m_L;
-        CMatrix<T,N,N> m_U;
-        std::array<uint32_t,N> m_P;
     };
 
-    template <class T, uint32_t N>
-    using CColVector = CMatrix<T,N,1>;
+    /** @brief  Matrix product: f_res = f_A * f_B */
+    template <class T, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiply(CMatrix<T,M,P>& f_res, const CMatrix<T,M,N>& f_A, const CMatrix<T,N,P>& f_B)
+    {
+        SProductKernel<SBlockedProduct<M,N,P>::value>::template apply<0>(f_res, f_A, f_B);
+    }
 
-    template <class T, uint32_t N>
-    using CVector = CColVector<T,N>;
+    /** @brief  Accumulated matrix product: f_res += f_A * f_B */
+    template <class T, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiplyAdd(CMatrix<T,M,P>& f_res, const CMatrix<T,M,N>& f_A, const CMatrix<T,N,P>& f_B)
+    {
+        SProductKernel<SBlockedProduct<M,N,P>::value>::template apply<1>(f_res, f_A, f_B);
+    }
 
-    template <class T, uint32_t N>
-    using CRowVector = CMatrix<T,1,N>;
+    /** @brief  Subtracted matrix product: f_res -= f_A * f_B */
+    template <class T, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiplySubtract(CMatrix<T,M,P>& f_res, const CMatrix<T,M,N>& f_A, const CMatrix<T,N,P>& f_B)
+    {
+        SProductKernel<SBlockedProduct<M,N,P>::value>::template apply<-1>(f_res, f_A, f_B);
+    }
+
+    /** @brief  Matrix-vector product: f_y = f_A * f_x */
+    template <class T, uint32_t M, uint32_t N>
+    inline void gemv(CColVector<T,M>& f_y, const CMatrix<T,M,N>& f_A, const CColVector<T,N>& f_x)
+    {
+        multiply(f_y, f_A, f_x);
+    }
+
+    /** @brief  Scaled addition: f_y += f_a * f_x */
+    template <class T, uint32_t M, uint32_t N>
+    inline void axpy(CMatrix<T,M,N>& f_y, const T& f_a, const CMatrix<T,M,N>& f_x)
+    {
+        SUnroll<M>::apply([&](uint32_t l_row){
+            SUnroll<N>::apply([&](uint32_t l_col){
+                f_y[l_row][l_col] += f_a * f_x[l_row][l_col];
+            });
+        });
+    }
+
+    /** @brief  Dot product of a row and a column view */
+    template <class TA, class TB, uint32_t N>
+    inline typename std::remove_const<TA>::type dot(const CMatrixView<TA,1,N>& f_a, const CMatrixView<TB,N,1>& f_b)
+    {
+        typename std::remove_const<TA>::type l_sum = f_a(0,0) * f_b(0,0);
+        SUnroll<N-1>::apply([&](uint32_t l_idx){
+            l_sum += f_a(0,l_idx+1) * f_b(l_idx+1,0);
+        });
+        return l_sum;
+    }
+
+    /** @brief  Matrix product of views: f_res = f_A * f_B, the result can be a block of a greater matrix */
+    template <class TR, class TA, class TB, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiply(const CMatrixView<TR,M,P>& f_res, const CMatrixView<TA,M,N>& f_A, const CMatrixView<TB,N,P>& f_B)
+    {
+        SUnroll<M>::apply([&](uint32_t l_row){
+            SUnroll<P>::apply([&](uint32_t l_col){
+                TR l_sum = f_A(l_row,0) * f_B(0,l_col);
+                SUnroll<N-1>::apply([&](uint32_t l_idx){
+                    l_sum += f_A(l_row,l_idx+1) * f_B(l_idx+1,l_col);
+                });
+                f_res(l_row,l_col) = l_sum;
+            });
+        });
+    }
+
+    /** @brief  Accumulated matrix product of views: f_res += f_A * f_B */
+    template <class TR, class TA, class TB, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiplyAdd(const CMatrixView<TR,M,P>& f_res, const CMatrixView<TA,M,N>& f_A, const CMatrixView<TB,N,P>& f_B)
+    {
+        SUnroll<M>::apply([&](uint32_t l_row){
+            SUnroll<P>::apply([&](uint32_t l_col){
+                TR l_sum = f_res(l_row,l_col);
+                SUnroll<N>::apply([&](uint32_t l_idx){
+                    l_sum += f_A(l_row,l_idx) * f_B(l_idx,l_col);
+                });
+                f_res(l_row,l_col) = l_sum;
+            });
+        });
+    }
+
+    /** @brief  Subtracted matrix product of views: f_res -= f_A * f_B */
+    template <class TR, class TA, class TB, uint32_t M, uint32_t N, uint32_t P>
+    inline void multiplySubtract(const CMatrixView<TR,M,P>& f_res, const CMatrixView<TA,M,N>& f_A, const CMatrixView<TB,N,P>& f_B)
+    {
+        SUnroll<M>::apply([&](uint32_t l_row){
+            SUnroll<P>::apply([&](uint32_t l_col){
+                TR l_sum = f_res(l_row,l_col);
+                SUnroll<N>::apply([&](uint32_t l_idx){
+                    l_sum -= f_A(l_row,l_idx) * f_B(l_idx,l_col);
+                });
+                f_res(l_row,l_col) = l_sum;
+            });
+        });
+    }
+
+    /** @brief  Transpose into the given matrix: f_res = f_A^T */
+    template <class T, uint32_t M, uint32_t N>
+    inline void transpose(CMatrix<T,N,M>& f_res, const CMatrix<T,M,N>& f_A)
+    {
+        SUnroll<M>::apply([&](uint32_t l_row){
+            SUnroll<N>::apply([&](uint32_t l_col){
+                f_res[l_col][l_row] = f_A[l_row][l_col];
+            });
+        });
+    }
 }; // namespace utils::linalg
 
 #include "linalg.tpp"
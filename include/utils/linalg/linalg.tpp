@@ -27,4 +27,247 @@ typename utils::linalg::CMatrix<T,N,M>::CThisType utils::linalg::CMatrix<T,N,M>:
     return l_inv;
 }
 
+/** @brief  Solve the linear system (this * X = B) by LU decomposition with partial pivoting
+ *
+ *  @param f_B             right-hand side
+ *  @return                solution
+ */
+template<class T, uint32_t N,uint32_t M>
+template<uint32_t P>
+typename utils::linalg::CMatrix<T,N,M>::template CRightMultiplicationResultType<P> utils::linalg::CMatrix<T,N,M>::solve(const CRightMultipliableType<P>& f_B)
+{
+    return utils::linalg::CLUDecomposition<T,N>(*this).solve(f_B);
+}
+
+/** @brief  In-place decomposition with partial pivoting, the row with the greatest absolute value is selected as pivot
+ */
+template<class T, uint32_t N>
+void utils::linalg::CLUDecomposition<T,N>::decompose()
+{
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        m_P[l_idx] = l_idx;
+    }
+    for (uint32_t l_kdx = 0; l_kdx < N; ++l_kdx)
+    {
+        // Select the pivot
+        uint32_t l_pivot = l_kdx;
+        T l_max = (m_LU[l_kdx][l_kdx] < T(0)) ? -m_LU[l_kdx][l_kdx] : m_LU[l_kdx][l_kdx];
+        for (uint32_t l_idx = l_kdx+1; l_idx < N; ++l_idx)
+        {
+            T l_abs = (m_LU[l_idx][l_kdx] < T(0)) ? -m_LU[l_idx][l_kdx] : m_LU[l_idx][l_kdx];
+            if (l_max < l_abs)
+            {
+                l_max = l_abs;
+                l_pivot = l_idx;
+            }
+        }
+        if (l_max == T(0))
+        {
+            m_singular = true;
+            continue;
+        }
+        if (l_pivot != l_kdx)
+        {
+            std::swap(m_LU[l_pivot], m_LU[l_kdx]);
+            std::swap(m_P[l_pivot], m_P[l_kdx]);
+        }
+        // Eliminate the column under the pivot
+        for (uint32_t l_idx = l_kdx+1; l_idx < N; ++l_idx)
+        {
+            T l_factor = m_LU[l_idx][l_kdx] / m_LU[l_kdx][l_kdx];
+            m_LU[l_idx][l_kdx] = l_factor;
+            for (uint32_t l_jdx = l_kdx+1; l_jdx < N; ++l_jdx)
+            {
+                m_LU[l_idx][l_jdx] -= l_factor * m_LU[l_kdx][l_jdx];
+            }
+        }
+    }
+}
+
+/** @brief  Reconstruct the original matrix from the factors
+ */
+template<class T, uint32_t N>
+utils::linalg::CLUDecomposition<T,N>::operator COriginalType() const
+{
+    COriginalType l_res;
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        for (uint32_t l_jdx = 0; l_jdx < N; ++l_jdx)
+        {
+            T l_sum = 0;
+            uint32_t l_end = (l_idx < l_jdx) ? l_idx : l_jdx;
+            for (uint32_t l_kdx = 0; l_kdx < l_end; ++l_kdx)
+            {
+                l_sum += m_LU[l_idx][l_kdx] * m_LU[l_kdx][l_jdx];
+            }
+            // Unit diagonal of the L factor
+            l_sum += (l_idx <= l_jdx) ? m_LU[l_idx][l_jdx] : m_LU[l_idx][l_jdx] * m_LU[l_jdx][l_jdx];
+            l_res[m_P[l_idx]][l_jdx] = l_sum;
+        }
+    }
+    return l_res;
+}
+
+/** @brief  Inverse matrix, it's calculated by solving the system with the identity matrix
+ */
+template<class T, uint32_t N>
+typename utils::linalg::CLUDecomposition<T,N>::COriginalType utils::linalg::CLUDecomposition<T,N>::inv() const
+{
+    COriginalType l_inv(COriginalType::eye());
+    solveInPlace(l_inv);
+    return l_inv;
+}
+
+/** @brief  Solve the linear system A*X = B
+ *
+ *  @param f_B             right-hand side
+ *  @return                solution
+ */
+template<class T, uint32_t N>
+template<uint32_t P>
+typename utils::linalg::CLUDecomposition<T,N>::template CRightMultiplicationResultType<P> utils::linalg::CLUDecomposition<T,N>::solve(const CRightMultipliableType<P>& f_B) const
+{
+    CRightMultipliableType<P> l_X(f_B);
+    solveInPlace(l_X);
+    return l_X;
+}
+
+/** @brief  Solve the linear system A*X = B by forward and backward substitution
+ *
+ *  @param f_B             right-hand side, it's overwritten by the solution
+ */
+template<class T, uint32_t N>
+template<uint32_t P>
+void utils::linalg::CLUDecomposition<T,N>::solveInPlace(CRightMultipliableType<P>& f_B) const
+{
+    // Apply the permutation
+    CRightMultipliableType<P> l_B(f_B);
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        f_B[l_idx] = l_B[m_P[l_idx]];
+    }
+    // L*Y = P*B
+    for (uint32_t l_idx = 1; l_idx < N; ++l_idx)
+    {
+        for (uint32_t l_kdx = 0; l_kdx < l_idx; ++l_kdx)
+        {
+            for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
+            {
+                f_B[l_idx][l_jdx] -= m_LU[l_idx][l_kdx] * f_B[l_kdx][l_jdx];
+            }
+        }
+    }
+    // U*X = Y
+    for (int32_t l_idx = N-1; l_idx >= 0; --l_idx)
+    {
+        for (uint32_t l_kdx = l_idx+1; l_kdx < N; ++l_kdx)
+        {
+            for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
+            {
+                f_B[l_idx][l_jdx] -= m_LU[l_idx][l_kdx] * f_B[l_kdx][l_jdx];
+            }
+        }
+        for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
+        {
+            f_B[l_idx][l_jdx] /= m_LU[l_idx][l_idx];
+        }
+    }
+}
+
+/** @brief  In-place LDL^T decomposition, the upper triangle isn't used
+ */
+template<class T, uint32_t N>
+void utils::linalg::CCholeskyDecomposition<T,N>::decompose()
+{
+    for (uint32_t l_jdx = 0; l_jdx < N; ++l_jdx)
+    {
+        // D[j] = A[j][j] - sum L[j][k]^2 * D[k]
+        T l_d = m_LD[l_jdx][l_jdx];
+        for (uint32_t l_kdx = 0; l_kdx < l_jdx; ++l_kdx)
+        {
+            l_d -= m_LD[l_jdx][l_kdx] * m_LD[l_jdx][l_kdx] * m_LD[l_kdx][l_kdx];
+        }
+        if (!(T(0) < l_d))
+        {
+            m_positiveDefinite = false;
+        }
+        m_LD[l_jdx][l_jdx] = l_d;
+        // L[i][j] = (A[i][j] - sum L[i][k] * L[j][k] * D[k]) / D[j]
+        for (uint32_t l_idx = l_jdx+1; l_idx < N; ++l_idx)
+        {
+            T l_sum = m_LD[l_idx][l_jdx];
+            for (uint32_t l_kdx = 0; l_kdx < l_jdx; ++l_kdx)
+            {
+                l_sum -= m_LD[l_idx][l_kdx] * m_LD[l_jdx][l_kdx] * m_LD[l_kdx][l_kdx];
+            }
+            m_LD[l_idx][l_jdx] = l_sum / l_d;
+        }
+    }
+}
+
+/** @brief  Inverse matrix, it's calculated by solving the system with the identity matrix
+ */
+template<class T, uint32_t N>
+typename utils::linalg::CCholeskyDecomposition<T,N>::COriginalType utils::linalg::CCholeskyDecomposition<T,N>::inv() const
+{
+    COriginalType l_inv(COriginalType::eye());
+    solveInPlace(l_inv);
+    return l_inv;
+}
+
+/** @brief  Solve the linear system A*X = B
+ *
+ *  @param f_B             right-hand side
+ *  @return                solution
+ */
+template<class T, uint32_t N>
+template<uint32_t P>
+typename utils::linalg::CCholeskyDecomposition<T,N>::template CRightMultipliableType<P> utils::linalg::CCholeskyDecomposition<T,N>::solve(const CRightMultipliableType<P>& f_B) const
+{
+    CRightMultipliableType<P> l_X(f_B);
+    solveInPlace(l_X);
+    return l_X;
+}
+
+/** @brief  Solve the linear system L*D*L^T*X = B by forward substitution, diagonal scaling and backward substitution
+ *
+ *  @param f_B             right-hand side, it's overwritten by the solution
+ */
+template<class T, uint32_t N>
+template<uint32_t P>
+void utils::linalg::CCholeskyDecomposition<T,N>::solveInPlace(CRightMultipliableType<P>& f_B) const
+{
+    // L*Z = B
+    for (uint32_t l_idx = 1; l_idx < N; ++l_idx)
+    {
+        for (uint32_t l_kdx = 0; l_kdx < l_idx; ++l_kdx)
+        {
+            for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
+            {
+                f_B[l_idx][l_jdx] -= m_LD[l_idx][l_kdx] * f_B[l_kdx][l_jdx];
+            }
+        }
+    }
+    // D*Y = Z
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
+        {
+            f_B[l_idx][l_jdx] /= m_LD[l_idx][l_idx];
+        }
+    }
+    // L^T*X = Y
+    for (int32_t l_idx = N-2; l_idx >= 0; --l_idx)
+    {
+        for (uint32_t l_kdx = l_idx+1; l_kdx < N; ++l_kdx)
+        {
+            for (uint32_t l_jdx = 0; l_jdx < P; ++l_jdx)
+            {
+                f_B[l_idx][l_jdx] -= m_LD[l_kdx][l_idx] * f_B[l_kdx][l_jdx];
+            }
+        }
+    }
+}
+
 #endif //LINALG_TPP
\ No newline at end of file
@@ -0,0 +1,220 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+ * @file rotation.hpp
+ * @author RBRO/PJ-IU
+ * @brief Three dimensional vector and quaternion types for the rotations of the inertial fusion, the operations are written
+ * element by element without temporary matrices
+ * @version 0.1
+ * @date 2019-11-07
+ *
+ *
+ */
+#ifndef ROTATION_HPP
+#define ROTATION_HPP
+
+#include <cmath>
+#include <cstring>
+#include <utils/linalg/linalg.h>
+
+namespace utils::linalg
+{
+    /**
+     * @brief Inverse square root of a positive value, the generic version applies the library functions. The types without
+     * floating point unit support (for example the fixed-point types) can specialize it.
+     *
+     * @tparam T        type of the value
+     */
+    template <class T>
+    struct SInvSqrt
+    {
+        static inline T apply(const T& f_value) {return T(1) / T(std::sqrt(f_value));}
+    };
+
+    /**
+     * @brief Fast inverse square root of the single floats: the initial guess is taken from the exponent bits and it's refined by
+     * two Newton steps (relative error below 5e-6), so a normalization needs only multiplications instead of a square root and
+     * a division.
+     */
+    template <>
+    struct SInvSqrt<float>
+    {
+        static inline float apply(float f_value)
+        {
+            uint32_t l_bits;
+            std::memcpy(&l_bits, &f_value, sizeof(l_bits));
+            l_bits = 0x5F375A86UL - (l_bits >> 1);
+            float l_res;
+            std::memcpy(&l_res, &l_bits, sizeof(l_res));
+            const float l_half = 0.5f * f_value;
+            l_res = l_res * (1.5f - l_half * l_res * l_res);
+            l_res = l_res * (1.5f - l_half * l_res * l_res);
+            return l_res;
+        }
+    };
+
+    /** @brief  Inverse square root by the selected implementation of the type */
+    template <class T>
+    inline T invSqrt(const T& f_value)
+    {
+        return SInvSqrt<T>::apply(f_value);
+    }
+
+    /**
+     * @brief Three dimensional vector with the arithmetic of the rotations. The elements are stored in an array like by CMatrix,
+     * it can be converted to and from the column vector, so the results can be used with the matrix kernels.
+     *
+     * @tparam T        type of the elements
+     */
+    template <class T>
+    class CVector3
+    {
+    public:
+        using CThisType = CVector3<T>;
+        using CDataType = T;
+        using COriginalType = CColVector<T,3>;
+
+        CVector3() : m_data() {}
+        CVector3(const T& f_x, const T& f_y, const T& f_z) : m_data{{f_x, f_y, f_z}} {}
+        /** @brief  Copy of the column vector */
+        explicit CVector3(const COriginalType& f_vector) : m_data{{f_vector[0][0], f_vector[1][0], f_vector[2][0]}} {}
+
+        T& operator[](uint32_t f_idx) {return m_data[f_idx];}
+        const T& operator[](uint32_t f_idx) const {return m_data[f_idx];}
+        T& x() {return m_data[0];}
+        T& y() {return m_data[1];}
+        T& z() {return m_data[2];}
+        const T& x() const {return m_data[0];}
+        const T& y() const {return m_data[1];}
+        const T& z() const {return m_data[2];}
+
+        CThisType operator+(const CThisType& f_b) const {return CThisType(m_data[0] + f_b[0], m_data[1] + f_b[1], m_data[2] + f_b[2]);}
+        CThisType operator-(const CThisType& f_b) const {return CThisType(m_data[0] - f_b[0], m_data[1] - f_b[1], m_data[2] - f_b[2]);}
+        CThisType operator-() const {return CThisType(-m_data[0], -m_data[1], -m_data[2]);}
+        CThisType operator*(const T& f_scale) const {return CThisType(m_data[0] * f_scale, m_data[1] * f_scale, m_data[2] * f_scale);}
+        CThisType& operator+=(const CThisType& f_b) {m_data[0] += f_b[0]; m_data[1] += f_b[1]; m_data[2] += f_b[2]; return *this;}
+        CThisType& operator-=(const CThisType& f_b) {m_data[0] -= f_b[0]; m_data[1] -= f_b[1]; m_data[2] -= f_b[2]; return *this;}
+        CThisType& operator*=(const T& f_scale) {m_data[0] *= f_scale; m_data[1] *= f_scale; m_data[2] *= f_scale; return *this;}
+
+        /** @brief  Dot product */
+        T dot(const CThisType& f_b) const {return m_data[0] * f_b[0] + m_data[1] * f_b[1] + m_data[2] * f_b[2];}
+        /** @brief  Cross product: this x f_b */
+        CThisType cross(const CThisType& f_b) const
+        {
+            return CThisType(m_data[1] * f_b[2] - m_data[2] * f_b[1], m_data[2] * f_b[0] - m_data[0] * f_b[2], m_data[0] * f_b[1] - m_data[1] * f_b[0]);
+        }
+        /** @brief  Square of the length */
+        T norm2() const {return dot(*this);}
+        /** @brief  Length */
+        T norm() const {return T(std::sqrt(norm2()));}
+        /* Scale to unit length */
+        bool normalize();
+        /** @brief  Scaled addition: this += f_a * f_x */
+        CThisType& axpy(const T& f_a, const CThisType& f_x) {m_data[0] += f_a * f_x[0]; m_data[1] += f_a * f_x[1]; m_data[2] += f_a * f_x[2]; return *this;}
+
+        /** @brief  Column vector with the same elements */
+        COriginalType toMatrix() const {return COriginalType({{{m_data[0]}, {m_data[1]}, {m_data[2]}}});}
+
+    private:
+        /** @brief  Elements [x, y, z] */
+        std::array<T,3> m_data;
+    };
+
+    /**
+     * @brief Unit quaternion [w, x, y, z] of a rotation, the Hamilton convention is applied: the product p*q rotates first by q,
+     * then by p, and the vector v of the body frame is rotated into the reference frame by q*v*q'. The rotation of a vector
+     * costs 15 multiplications (instead of 27 by the rotation matrix and its 36 of construction), the composition 16 and the
+     * integration of an angular rate 16 and one normalization. The expressions are sums of products, so the compiler can
+     * contract them into fused multiply-add instructions (-ffp-contract=fast).
+     *
+     * @tparam T        type of the elements
+     */
+    template <class T>
+    class CQuaternion
+    {
+    public:
+        using CThisType = CQuaternion<T>;
+        using CDataType = T;
+        using CVectorType = CVector3<T>;
+        using CRotationMatrixType = CMatrix<T,3,3>;
+
+        /** @brief  Identity rotation */
+        CQuaternion() : m_data{{T(1), T(0), T(0), T(0)}} {}
+        CQuaternion(const T& f_w, const T& f_x, const T& f_y, const T& f_z) : m_data{{f_w, f_x, f_y, f_z}} {}
+        /** @brief  Quaternion from the scalar and the vector part */
+        CQuaternion(const T& f_w, const CVectorType& f_v) : m_data{{f_w, f_v[0], f_v[1], f_v[2]}} {}
+
+        /* Rotation around the unit axis by the angle in radian */
+        static CThisType fromAxisAngle(const CVectorType& f_axis, float f_angle);
+        /* Rotation of the Euler angles (roll around x, pitch around y, yaw around z, applied in z-y-x order) */
+        static CThisType fromEuler(float f_roll, float f_pitch, float f_yaw);
+        /* Rotation of the dense rotation matrix */
+        static CThisType fromMatrix(const CRotationMatrixType& f_matrix);
+
+        T& operator[](uint32_t f_idx) {return m_data[f_idx];}
+        const T& operator[](uint32_t f_idx) const {return m_data[f_idx];}
+        const T& w() const {return m_data[0];}
+        const T& x() const {return m_data[1];}
+        const T& y() const {return m_data[2];}
+        const T& z() const {return m_data[3];}
+        /** @brief  Vector part */
+        CVectorType vec() const {return CVectorType(m_data[1], m_data[2], m_data[3]);}
+
+        /** @brief  Conjugate, the inverse rotation of a unit quaternion */
+        CThisType conjugate() const {return CThisType(m_data[0], -m_data[1], -m_data[2], -m_data[3]);}
+        /* Composition (Hamilton product) */
+        CThisType operator*(const CThisType& f_b) const;
+        /** @brief  Composition in place: this = this * f_b */
+        CThisType& operator*=(const CThisType& f_b) {*this = *this * f_b; return *this;}
+        /** @brief  Square of the norm */
+        T norm2() const {return m_data[0] * m_data[0] + m_data[1] * m_data[1] + m_data[2] * m_data[2] + m_data[3] * m_data[3];}
+        /* Scale to unit norm */
+        bool normalize();
+
+        /* Rotate a vector: q*v*q' */
+        CVectorType rotate(const CVectorType& f_v) const;
+        /* Rotate a vector by the inverse rotation: q'*v*q */
+        CVectorType rotateInverse(const CVectorType& f_v) const;
+        /* Integrate the angular rate of the body frame */
+        void integrate(const CVectorType& f_rate, const T& f_dt);
+
+        /* Dense rotation matrix */
+        CRotationMatrixType toMatrix() const;
+        /* Roll angle in radian */
+        float roll() const;
+        /* Pitch angle in radian */
+        float pitch() const;
+        /* Yaw angle in radian */
+        float yaw() const;
+
+    private:
+        /** @brief  Elements [w, x, y, z] */
+        std::array<T,4> m_data;
+    };
+
+    /** @brief  Product of the dense 3x3 matrix and the vector without temporary matrices */
+    template <class T>
+    inline CVector3<T> multiply(const CMatrix<T,3,3>& f_A, const CVector3<T>& f_v)
+    {
+        return CVector3<T>(f_A[0][0] * f_v[0] + f_A[0][1] * f_v[1] + f_A[0][2] * f_v[2]
+                         , f_A[1][0] * f_v[0] + f_A[1][1] * f_v[1] + f_A[1][2] * f_v[2]
+                         , f_A[2][0] * f_v[0] + f_A[2][1] * f_v[1] + f_A[2][2] * f_v[2]);
+    }
+}; // namespace utils::linalg
+
+#include "rotation.tpp"
+
+#endif // ROTATION_HPP
@@ -0,0 +1,261 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+#ifndef ROTATION_TPP
+#define ROTATION_TPP
+
+#ifndef ROTATION_HPP
+#error __FILE__ should only be included from rotation.hpp .
+#endif // ROTATION_HPP
+
+/******************************************************************************/
+/** @brief  Scale the vector to unit length
+ *
+ *  @return                false for the zero vector, it isn't changed
+ */
+template <class T>
+inline bool utils::linalg::CVector3<T>::normalize()
+{
+    const T l_norm2 = norm2();
+    if (!(l_norm2 > T(0)))
+    {
+        return false;
+    }
+    *this *= invSqrt(l_norm2);
+    return true;
+}
+
+/******************************************************************************/
+/** @brief  Rotation around an axis
+ *
+ *  @param f_axis          unit axis
+ *  @param f_angle         angle in radian, counter-clockwise around the axis
+ *  @return                unit quaternion
+ */
+template <class T>
+inline utils::linalg::CQuaternion<T> utils::linalg::CQuaternion<T>::fromAxisAngle(const CVectorType& f_axis, float f_angle)
+{
+    const T l_sin(std::sin(0.5f * f_angle));
+    return CThisType(T(std::cos(0.5f * f_angle)), f_axis * l_sin);
+}
+
+/** @brief  Rotation of the Euler angles, the yaw is applied first, then the pitch and the roll (R = Rz * Ry * Rx)
+ *
+ *  @param f_roll          rotation around the x axis in radian
+ *  @param f_pitch         rotation around the y axis in radian
+ *  @param f_yaw           rotation around the z axis in radian
+ *  @return                unit quaternion
+ */
+template <class T>
+inline utils::linalg::CQuaternion<T> utils::linalg::CQuaternion<T>::fromEuler(float f_roll, float f_pitch, float f_yaw)
+{
+    const float l_cr = std::cos(0.5f * f_roll), l_sr = std::sin(0.5f * f_roll);
+    const float l_cp = std::cos(0.5f * f_pitch), l_sp = std::sin(0.5f * f_pitch);
+    const float l_cy = std::cos(0.5f * f_yaw), l_sy = std::sin(0.5f * f_yaw);
+    return CThisType(T(l_cr * l_cp * l_cy + l_sr * l_sp * l_sy)
+                   , T(l_sr * l_cp * l_cy - l_cr * l_sp * l_sy)
+                   , T(l_cr * l_sp * l_cy + l_sr * l_cp * l_sy)
+                   , T(l_cr * l_cp * l_sy - l_sr * l_sp * l_cy));
+}
+
+/** @brief  Rotation of the dense rotation matrix by the Shepperd method, the greatest of the four diagonal combinations is
+ *  taken for the square root, so the result is accurate for all angles.
+ *
+ *  @param f_matrix        orthonormal matrix, it rotates the body frame into the reference frame
+ *  @return                unit quaternion with non-negative scalar part
+ */
+template <class T>
+inline utils::linalg::CQuaternion<T> utils::linalg::CQuaternion<T>::fromMatrix(const CRotationMatrixType& f_matrix)
+{
+    const float l_m00 = static_cast<float>(f_matrix[0][0]), l_m11 = static_cast<float>(f_matrix[1][1]), l_m22 = static_cast<float>(f_matrix[2][2]);
+    const float l_trace = l_m00 + l_m11 + l_m22;
+    float l_q[4];
+    if (l_trace > l_m00 && l_trace > l_m11 && l_trace > l_m22)
+    {
+        const float l_s = 2.0f * std::sqrt(1.0f + l_trace);
+        l_q[0] = 0.25f * l_s;
+        l_q[1] = static_cast<float>(f_matrix[2][1] - f_matrix[1][2]) / l_s;
+        l_q[2] = static_cast<float>(f_matrix[0][2] - f_matrix[2][0]) / l_s;
+        l_q[3] = static_cast<float>(f_matrix[1][0] - f_matrix[0][1]) / l_s;
+    }
+    else if (l_m00 > l_m11 && l_m00 > l_m22)
+    {
+        const float l_s = 2.0f * std::sqrt(1.0f + l_m00 - l_m11 - l_m22);
+        l_q[0] = static_cast<float>(f_matrix[2][1] - f_matrix[1][2]) / l_s;
+        l_q[1] = 0.25f * l_s;
+        l_q[2] = static_cast<float>(f_matrix[0][1] + f_matrix[1][0]) / l_s;
+        l_q[3] = static_cast<float>(f_matrix[0][2] + f_matrix[2][0]) / l_s;
+    }
+    else if (l_m11 > l_m22)
+    {
+        const float l_s = 2.0f * std::sqrt(1.0f + l_m11 - l_m00 - l_m22);
+        l_q[0] = static_cast<float>(f_matrix[0][2] - f_matrix[2][0]) / l_s;
+        l_q[1] = static_cast<float>(f_matrix[0][1] + f_matrix[1][0]) / l_s;
+        l_q[2] = 0.25f * l_s;
+        l_q[3] = static_cast<float>(f_matrix[1][2] + f_matrix[2][1]) / l_s;
+    }
+    else
+    {
+        const float l_s = 2.0f * std::sqrt(1.0f + l_m22 - l_m00 - l_m11);
+        l_q[0] = static_cast<float>(f_matrix[1][0] - f_matrix[0][1]) / l_s;
+        l_q[1] = static_cast<float>(f_matrix[0][2] + f_matrix[2][0]) / l_s;
+        l_q[2] = static_cast<float>(f_matrix[1][2] + f_matrix[2][1]) / l_s;
+        l_q[3] = 0.25f * l_s;
+    }
+    const float l_sign = (l_q[0] < 0.0f) ? -1.0f : 1.0f;
+    return CThisType(T(l_sign * l_q[0]), T(l_sign * l_q[1]), T(l_sign * l_q[2]), T(l_sign * l_q[3]));
+}
+
+/** @brief  Composition of the rotations (Hamilton product), the result rotates first by the right operand
+ *
+ *  @param f_b             right operand
+ *  @return                product this * f_b
+ */
+template <class T>
+inline utils::linalg::CQuaternion<T> utils::linalg::CQuaternion<T>::operator*(const CThisType& f_b) const
+{
+    const std::array<T,4>& a = m_data;
+    return CThisType(a[0] * f_b[0] - a[1] * f_b[1] - a[2] * f_b[2] - a[3] * f_b[3]
+                   , a[0] * f_b[1] + a[1] * f_b[0] + a[2] * f_b[3] - a[3] * f_b[2]
+                   , a[0] * f_b[2] - a[1] * f_b[3] + a[2] * f_b[0] + a[3] * f_b[1]
+                   , a[0] * f_b[3] + a[1] * f_b[2] - a[2] * f_b[1] + a[3] * f_b[0]);
+}
+
+/** @brief  Scale the quaternion to unit norm by the inverse square root of the type
+ *
+ *  @return                false for the zero quaternion, it's reset to the identity
+ */
+template <class T>
+inline bool utils::linalg::CQuaternion<T>::normalize()
+{
+    const T l_norm2 = norm2();
+    if (!(l_norm2 > T(0)))
+    {
+        *this = CThisType();
+        return false;
+    }
+    const T l_scale = invSqrt(l_norm2);
+    SUnroll<4>::apply([&](uint32_t l_idx){
+        m_data[l_idx] *= l_scale;
+    });
+    return true;
+}
+
+/** @brief  Rotate a vector of the body frame into the reference frame by v' = v + w*t + u x t with t = 2 * u x v, where u is the
+ *  vector part. It's equivalent to q*v*q' for unit quaternions.
+ *
+ *  @param f_v             vector of the body frame
+ *  @return                vector of the reference frame
+ */
+template <class T>
+inline utils::linalg::CVector3<T> utils::linalg::CQuaternion<T>::rotate(const CVectorType& f_v) const
+{
+    const CVectorType l_u = vec();
+    const CVectorType l_t = l_u.cross(f_v) * T(2);
+    return f_v + l_t * m_data[0] + l_u.cross(l_t);
+}
+
+/** @brief  Rotate a vector of the reference frame into the body frame, the same formula with the conjugated quaternion
+ *
+ *  @param f_v             vector of the reference frame
+ *  @return                vector of the body frame
+ */
+template <class T>
+inline utils::linalg::CVector3<T> utils::linalg::CQuaternion<T>::rotateInverse(const CVectorType& f_v) const
+{
+    const CVectorType l_u = -vec();
+    const CVectorType l_t = l_u.cross(f_v) * T(2);
+    return f_v + l_t * m_data[0] + l_u.cross(l_t);
+}
+
+/** @brief  Integrate the angular rate of the body frame by the first-order step q += 0.5 * dt * q * [0, rate] and normalize the
+ *  result. For the rates and steps of the inertial sensor (rate * dt << 1) the error is below the noise of the gyroscope.
+ *
+ *  @param f_rate          angular rate in radian per second in the body frame
+ *  @param f_dt            time step in second
+ */
+template <class T>
+inline void utils::linalg::CQuaternion<T>::integrate(const CVectorType& f_rate, const T& f_dt)
+{
+    const T l_step = T(0.5f) * f_dt;
+    const T l_hx = f_rate[0] * l_step, l_hy = f_rate[1] * l_step, l_hz = f_rate[2] * l_step;
+    const T l_q0 = m_data[0], l_q1 = m_data[1], l_q2 = m_data[2], l_q3 = m_data[3];
+    m_data[0] = l_q0 - l_q1 * l_hx - l_q2 * l_hy - l_q3 * l_hz;
+    m_data[1] = l_q1 + l_q0 * l_hx + l_q2 * l_hz - l_q3 * l_hy;
+    m_data[2] = l_q2 + l_q0 * l_hy - l_q1 * l_hz + l_q3 * l_hx;
+    m_data[3] = l_q3 + l_q0 * l_hz + l_q1 * l_hy - l_q2 * l_hx;
+    normalize();
+}
+
+/** @brief  Dense rotation matrix of the unit quaternion, it can be applied by the matrix kernels
+ *
+ *  @return                orthonormal matrix, it rotates the body frame into the reference frame
+ */
+template <class T>
+inline typename utils::linalg::CQuaternion<T>::CRotationMatrixType utils::linalg::CQuaternion<T>::toMatrix() const
+{
+    const T l_one(1), l_two(2);
+    const T l_xx = m_data[1] * m_data[1], l_yy = m_data[2] * m_data[2], l_zz = m_data[3] * m_data[3];
+    const T l_xy = m_data[1] * m_data[2], l_xz = m_data[1] * m_data[3], l_yz = m_data[2] * m_data[3];
+    const T l_wx = m_data[0] * m_data[1], l_wy = m_data[0] * m_data[2], l_wz = m_data[0] * m_data[3];
+    CRotationMatrixType l_matrix;
+    l_matrix[0][0] = l_one - l_two * (l_yy + l_zz);
+    l_matrix[0][1] = l_two * (l_xy - l_wz);
+    l_matrix[0][2] = l_two * (l_xz + l_wy);
+    l_matrix[1][0] = l_two * (l_xy + l_wz);
+    l_matrix[1][1] = l_one - l_two * (l_xx + l_zz);
+    l_matrix[1][2] = l_two * (l_yz - l_wx);
+    l_matrix[2][0] = l_two * (l_xz - l_wy);
+    l_matrix[2][1] = l_two * (l_yz + l_wx);
+    l_matrix[2][2] = l_one - l_two * (l_xx + l_yy);
+    return l_matrix;
+}
+
+/** @brief  Roll angle of the z-y-x Euler angles
+ *
+ *  @return                rotation around the x axis in radian, in [-pi, pi]
+ */
+template <class T>
+inline float utils::linalg::CQuaternion<T>::roll() const
+{
+    const float l_q0 = static_cast<float>(m_data[0]), l_q1 = static_cast<float>(m_data[1]);
+    const float l_q2 = static_cast<float>(m_data[2]), l_q3 = static_cast<float>(m_data[3]);
+    return std::atan2(2.0f * (l_q0 * l_q1 + l_q2 * l_q3), 1.0f - 2.0f * (l_q1 * l_q1 + l_q2 * l_q2));
+}
+
+/** @brief  Pitch angle of the z-y-x Euler angles
+ *
+ *  @return                rotation around the y axis in radian, in [-pi/2, pi/2]
+ */
+template <class T>
+inline float utils::linalg::CQuaternion<T>::pitch() const
+{
+    const float l_sin = 2.0f * static_cast<float>(m_data[0] * m_data[2] - m_data[3] * m_data[1]);
+    return std::asin((l_sin > 1.0f) ? 1.0f : ((l_sin < -1.0f) ? -1.0f : l_sin));
+}
+
+/** @brief  Yaw angle (heading) of the z-y-x Euler angles
+ *
+ *  @return                rotation around the z axis in radian, in [-pi, pi]
+ */
+template <class T>
+inline float utils::linalg::CQuaternion<T>::yaw() const
+{
+    const float l_q0 = static_cast<float>(m_data[0]), l_q1 = static_cast<float>(m_data[1]);
+    const float l_q2 = static_cast<float>(m_data[2]), l_q3 = static_cast<float>(m_data[3]);
+    return std::atan2(2.0f * (l_q0 * l_q3 + l_q1 * l_q2), 1.0f - 2.0f * (l_q2 * l_q2 + l_q3 * l_q3));
+}
+
+#endif // ROTATION_TPP
@@ -0,0 +1,266 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+ * @file structured.hpp
+ * @author RBRO/PJ-IU
+ * @brief Matrices with a known structure (diagonal, band, triangular and symmetric), stored without the zero or the 
+ * repeated elements
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ * 
+ */
+#ifndef STRUCTURED_HPP
+#define STRUCTURED_HPP
+
+#include <utils/linalg/linalg.h>
+
+namespace utils::linalg
+{
+    /**
+     * @brief Diagonal matrix, only the N diagonal elements are stored. The product costs N*P multiplications instead of N*N*P.
+     * 
+     * @tparam T        type of the elements
+     * @tparam N        size of the square matrix
+     */
+    template <class T, uint32_t N>
+    class CDiagonalMatrix
+    {
+    public:
+        using CThisType = CDiagonalMatrix<T,N>;
+        using CDataType = T;
+        using COriginalType = CMatrix<T,N,N>;
+
+        template <uint32_t P>
+        using CRightMultipliableType = CMatrix<T,N,P>;
+
+        CDiagonalMatrix() : m_data() {}
+        CDiagonalMatrix(const std::array<T,N>& f_diagonal) : m_data(f_diagonal) {}
+        /** @brief  The diagonal of the dense matrix is taken, the other elements are dropped */
+        explicit CDiagonalMatrix(const COriginalType& f_matrix);
+
+        /** @brief  Element of the matrix, it's zero outside of the structure */
+        T operator()(uint32_t f_row, uint32_t f_col) const {return (f_row == f_col) ? m_data[f_row] : T(0);}
+        T& diagonal(uint32_t f_idx) {return m_data[f_idx];}
+        const T& diagonal(uint32_t f_idx) const {return m_data[f_idx];}
+
+        /* Dense copy of the matrix */
+        COriginalType toMatrix() const;
+        /* Product with a dense matrix, the functor combines the result and the calculated value */
+        template <uint32_t P, class F>
+        void product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const;
+        /* Solve the system A*X = B, the right-hand side is overwritten by the solution */
+        template <uint32_t P>
+        void solveInPlace(CRightMultipliableType<P>& f_B) const;
+        /* Solve the system A*X = B */
+        template <uint32_t P>
+        CRightMultipliableType<P> solve(const CRightMultipliableType<P>& f_B) const;
+        /* It returns true, when a zero is on the diagonal */
+        bool isSingular() const;
+
+    private:
+        /** @brief  Diagonal elements */
+        std::array<T,N> m_data;
+    };
+
+    /**
+     * @brief Band matrix with KL sub-diagonals and KU super-diagonals. Each row stores the (KL + KU + 1) elements of the band, 
+     * the element (i,j) is on the position (j - i + KL) of the i-th row, the positions outside of the matrix are zero.
+     * The linear systems can be solved only for the triangular bands (KL or KU is zero) by substitution, the general band 
+     * needs the LU decomposition of the dense matrix.
+     * 
+     * @tparam T        type of the elements
+     * @tparam N        size of the square matrix
+     * @tparam KL       number of the sub-diagonals
+     * @tparam KU       number of the super-diagonals
+     */
+    template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+    class CBandMatrix
+    {
+    public:
+        using CThisType = CBandMatrix<T,N,KL,KU>;
+        using CDataType = T;
+        using COriginalType = CMatrix<T,N,N>;
+
+        template <uint32_t P>
+        using CRightMultipliableType = CMatrix<T,N,P>;
+
+        static_assert(KL < N && KU < N, "The band has to be narrower than the matrix.");
+
+        CBandMatrix() : m_data() {}
+        /** @brief  The band of the dense matrix is taken, the other elements are dropped */
+        explicit CBandMatrix(const COriginalType& f_matrix);
+        /** @brief  Dense initializer list (row-major N*N values) like by CMatrix, the elements outside of the band are dropped */
+        CBandMatrix(const std::array<std::array<T,N>,N>& f_data) : CBandMatrix(COriginalType(f_data)) {}
+
+        /** @brief  Element of the matrix, it's zero outside of the structure */
+        T operator()(uint32_t f_row, uint32_t f_col) const
+        {
+            return (f_col + KL >= f_row && f_col <= f_row + KU) ? m_data[f_row][f_col + KL - f_row] : T(0);
+        }
+        /** @brief  Element of the band, the (j - i) offset has to be in the range [-KL, KU] */
+        T& band(uint32_t f_row, uint32_t f_col) {return m_data[f_row][f_col + KL - f_row];}
+
+        /* Dense copy of the matrix */
+        COriginalType toMatrix() const;
+        /* Product with a dense matrix, the functor combines the result and the calculated value */
+        template <uint32_t P, class F>
+        void product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const;
+        /* Solve the system A*X = B, the right-hand side is overwritten by the solution */
+        template <uint32_t P>
+        void solveInPlace(CRightMultipliableType<P>& f_B) const;
+        /* Solve the system A*X = B */
+        template <uint32_t P>
+        CRightMultipliableType<P> solve(const CRightMultipliableType<P>& f_B) const;
+        /* It returns true, when a zero is on the diagonal */
+        bool isSingular() const;
+
+    private:
+        /** @brief  Elements of the band, row by row */
+        std::array<std::array<T,KL+KU+1>,N> m_data;
+    };
+
+    /**
+     * @brief Triangular matrix in packed storage, the N*(N+1)/2 elements of the triangle are stored. The lower matrix is 
+     * packed row by row, the upper matrix column by column, so the element (i,j) of the triangle is on 
+     * max(i,j)*(max(i,j)+1)/2 + min(i,j) in both cases.
+     * 
+     * @tparam T        type of the elements
+     * @tparam N        size of the square matrix
+     * @tparam NLower   lower (true) or upper (false) triangular matrix
+     */
+    template <class T, uint32_t N, bool NLower = true>
+    class CTriangularMatrix
+    {
+    public:
+        using CThisType = CTriangularMatrix<T,N,NLower>;
+        using CDataType = T;
+        using COriginalType = CMatrix<T,N,N>;
+
+        template <uint32_t P>
+        using CRightMultipliableType = CMatrix<T,N,P>;
+
+        CTriangularMatrix() : m_data() {}
+        /** @brief  The triangle of the dense matrix is taken, the other elements are dropped */
+        explicit CTriangularMatrix(const COriginalType& f_matrix);
+        /** @brief  Dense initializer list (row-major N*N values) like by CMatrix, the elements outside of the triangle are dropped */
+        CTriangularMatrix(const std::array<std::array<T,N>,N>& f_data) : CTriangularMatrix(COriginalType(f_data)) {}
+
+        /** @brief  It returns true, when the element is in the stored triangle */
+        static bool isStored(uint32_t f_row, uint32_t f_col) {return NLower ? (f_col <= f_row) : (f_row <= f_col);}
+        /** @brief  Element of the matrix, it's zero outside of the structure */
+        T operator()(uint32_t f_row, uint32_t f_col) const {return isStored(f_row,f_col) ? m_data[index(f_row,f_col)] : T(0);}
+        /** @brief  Element of the triangle */
+        T& element(uint32_t f_row, uint32_t f_col) {return m_data[index(f_row,f_col)];}
+
+        /* Dense copy of the matrix */
+        COriginalType toMatrix() const;
+        /* Product with a dense matrix, the functor combines the result and the calculated value */
+        template <uint32_t P, class F>
+        void product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const;
+        /* Solve the system A*X = B by substitution, the right-hand side is overwritten by the solution */
+        template <uint32_t P>
+        void solveInPlace(CRightMultipliableType<P>& f_B) const;
+        /* Solve the system A*X = B */
+        template <uint32_t P>
+        CRightMultipliableType<P> solve(const CRightMultipliableType<P>& f_B) const;
+        /* It returns true, when a zero is on the diagonal */
+        bool isSingular() const;
+
+    private:
+        /** @brief  Position of the element of the triangle in the packed storage */
+        static constexpr uint32_t index(uint32_t f_row, uint32_t f_col)
+        {
+            return (f_row >= f_col) ? (f_row * (f_row + 1) / 2 + f_col) : (f_col * (f_col + 1) / 2 + f_row);
+        }
+        /** @brief  Packed elements of the triangle */
+        std::array<T,N*(N+1)/2> m_data;
+    };
+
+    /**
+     * @brief Symmetric matrix in packed storage (for example a covariance matrix), only the lower triangle is stored row by row. 
+     * The element (i,j) and (j,i) are the same stored value.
+     * 
+     * @tparam T        type of the elements
+     * @tparam N        size of the square matrix
+     */
+    template <class T, uint32_t N>
+    class CSymmetricPackedMatrix
+    {
+    public:
+        using CThisType = CSymmetricPackedMatrix<T,N>;
+        using CDataType = T;
+        using COriginalType = CMatrix<T,N,N>;
+
+        template <uint32_t P>
+        using CRightMultipliableType = CMatrix<T,N,P>;
+
+        CSymmetricPackedMatrix() : m_data() {}
+        /** @brief  Only the lower triangle of the dense matrix is read */
+        explicit CSymmetricPackedMatrix(const COriginalType& f_matrix);
+
+        /** @brief  Element of the matrix */
+        T operator()(uint32_t f_row, uint32_t f_col) const {return m_data[index(f_row,f_col)];}
+        /** @brief  Element of the matrix, it changes the mirrored element too */
+        T& element(uint32_t f_row, uint32_t f_col) {return m_data[index(f_row,f_col)];}
+
+        /* Dense copy of the matrix */
+        COriginalType toMatrix() const;
+        /* Product with a dense matrix, the functor combines the result and the calculated value */
+        template <uint32_t P, class F>
+        void product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const;
+
+    private:
+        /** @brief  Position of the element in the packed lower triangle */
+        static constexpr uint32_t index(uint32_t f_row, uint32_t f_col)
+        {
+            return (f_row >= f_col) ? (f_row * (f_row + 1) / 2 + f_col) : (f_col * (f_col + 1) / 2 + f_row);
+        }
+        /** @brief  Packed elements of the lower triangle */
+        std::array<T,N*(N+1)/2> m_data;
+    };
+
+    /**
+     * @brief Fused kernels of the structured matrices with the same interface like the dense kernels, so the templates written 
+     * for CMatrix (for example CSSModel) can use the structured type without modification. Only the elements of the 
+     * structure are multiplied. The result mustn't be the same object as the operands.
+     */
+
+    /** @brief  Structured matrix product: f_res = f_A * f_B */
+    template <class TA, class T, uint32_t N, uint32_t P>
+    inline auto multiply(CMatrix<T,N,P>& f_res, const TA& f_A, const CMatrix<T,N,P>& f_B) -> decltype(f_A.product(f_res, f_B, 0), void())
+    {
+        f_A.product(f_res, f_B, [](T& f_dst, const T& f_val){ f_dst = f_val; });
+    }
+
+    /** @brief  Accumulated structured matrix product: f_res += f_A * f_B */
+    template <class TA, class T, uint32_t N, uint32_t P>
+    inline auto multiplyAdd(CMatrix<T,N,P>& f_res, const TA& f_A, const CMatrix<T,N,P>& f_B) -> decltype(f_A.product(f_res, f_B, 0), void())
+    {
+        f_A.product(f_res, f_B, [](T& f_dst, const T& f_val){ f_dst += f_val; });
+    }
+
+    /** @brief  Subtracted structured matrix product: f_res -= f_A * f_B */
+    template <class TA, class T, uint32_t N, uint32_t P>
+    inline auto multiplySubtract(CMatrix<T,N,P>& f_res, const TA& f_A, const CMatrix<T,N,P>& f_B) -> decltype(f_A.product(f_res, f_B, 0), void())
+    {
+        f_A.product(f_res, f_B, [](T& f_dst, const T& f_val){ f_dst -= f_val; });
+    }
+}; // namespace utils::linalg
+
+#include "structured.tpp"
+
+#endif // STRUCTURED_HPP
@@ -0,0 +1,402 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+#ifndef STRUCTURED_TPP
+#define STRUCTURED_TPP
+
+#ifndef STRUCTURED_HPP
+#error __FILE__ should only be included from structured.hpp .
+#endif // STRUCTURED_HPP
+
+/******************************************************************************/
+/** @brief  Constructor from the diagonal of a dense matrix
+ *
+ *  @param f_matrix        dense matrix
+ */
+template <class T, uint32_t N>
+utils::linalg::CDiagonalMatrix<T,N>::CDiagonalMatrix(const COriginalType& f_matrix)
+    : m_data()
+{
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        m_data[l_idx] = f_matrix[l_idx][l_idx];
+    }
+}
+
+/** @brief  Dense copy of the matrix
+ *
+ *  @return                dense matrix with zeros outside of the diagonal
+ */
+template <class T, uint32_t N>
+typename utils::linalg::CDiagonalMatrix<T,N>::COriginalType utils::linalg::CDiagonalMatrix<T,N>::toMatrix() const
+{
+    COriginalType l_matrix;
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        l_matrix[l_idx][l_idx] = m_data[l_idx];
+    }
+    return l_matrix;
+}
+
+/** @brief  Product with a dense matrix, each row of the right operand is scaled by the diagonal element
+ *
+ *  @param f_res           result, the functor combines it with the calculated elements
+ *  @param f_B             right operand
+ *  @param f_op            functor (destination, value), for example assignment or accumulation
+ */
+template <class T, uint32_t N>
+template <uint32_t P, class F>
+void utils::linalg::CDiagonalMatrix<T,N>::product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const
+{
+    SUnroll<N>::apply([&](uint32_t l_row){
+        SUnroll<P>::apply([&](uint32_t l_col){
+            f_op(f_res[l_row][l_col], m_data[l_row] * f_B[l_row][l_col]);
+        });
+    });
+}
+
+/** @brief  Solve the system A*X = B by division with the diagonal elements
+ *
+ *  @param f_B             right-hand side, it's overwritten by the solution
+ */
+template <class T, uint32_t N>
+template <uint32_t P>
+void utils::linalg::CDiagonalMatrix<T,N>::solveInPlace(CRightMultipliableType<P>& f_B) const
+{
+    SUnroll<N>::apply([&](uint32_t l_row){
+        const T l_inv = T(1) / m_data[l_row];
+        SUnroll<P>::apply([&](uint32_t l_col){
+            f_B[l_row][l_col] *= l_inv;
+        });
+    });
+}
+
+/** @brief  Solve the system A*X = B
+ *
+ *  @param f_B             right-hand side
+ *  @return                solution
+ */
+template <class T, uint32_t N>
+template <uint32_t P>
+typename utils::linalg::CDiagonalMatrix<T,N>::template CRightMultipliableType<P> utils::linalg::CDiagonalMatrix<T,N>::solve(const CRightMultipliableType<P>& f_B) const
+{
+    CRightMultipliableType<P> l_X(f_B);
+    solveInPlace(l_X);
+    return l_X;
+}
+
+/** @brief  It returns true, when a zero is on the diagonal */
+template <class T, uint32_t N>
+bool utils::linalg::CDiagonalMatrix<T,N>::isSingular() const
+{
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        if (m_data[l_idx] == T(0)) return true;
+    }
+    return false;
+}
+
+/******************************************************************************/
+/** @brief  Constructor from the band of a dense matrix
+ *
+ *  @param f_matrix        dense matrix
+ */
+template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+utils::linalg::CBandMatrix<T,N,KL,KU>::CBandMatrix(const COriginalType& f_matrix)
+    : m_data()
+{
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        const uint32_t l_first = (l_row > KL) ? (l_row - KL) : 0;
+        const uint32_t l_last = (l_row + KU < N) ? (l_row + KU) : (N - 1);
+        for (uint32_t l_col = l_first; l_col <= l_last; ++l_col)
+        {
+            band(l_row, l_col) = f_matrix[l_row][l_col];
+        }
+    }
+}
+
+/** @brief  Dense copy of the matrix
+ *
+ *  @return                dense matrix with zeros outside of the band
+ */
+template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+typename utils::linalg::CBandMatrix<T,N,KL,KU>::COriginalType utils::linalg::CBandMatrix<T,N,KL,KU>::toMatrix() const
+{
+    COriginalType l_matrix;
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        for (uint32_t l_col = 0; l_col < N; ++l_col)
+        {
+            l_matrix[l_row][l_col] = (*this)(l_row, l_col);
+        }
+    }
+    return l_matrix;
+}
+
+/** @brief  Product with a dense matrix, only the (KL + KU + 1) elements of the band are multiplied in each row
+ *
+ *  @param f_res           result, the functor combines it with the calculated elements
+ *  @param f_B             right operand
+ *  @param f_op            functor (destination, value), for example assignment or accumulation
+ */
+template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+template <uint32_t P, class F>
+void utils::linalg::CBandMatrix<T,N,KL,KU>::product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const
+{
+    SUnroll<N>::apply([&](uint32_t l_row){
+        SUnroll<P>::apply([&](uint32_t l_col){
+            T l_sum = T(0);
+            SUnroll<KL+KU+1>::apply([&](uint32_t l_idx){
+                // The positions of the band outside of the matrix are skipped
+                if (l_row + l_idx >= KL && l_row + l_idx < N + KL)
+                {
+                    l_sum += m_data[l_row][l_idx] * f_B[l_row + l_idx - KL][l_col];
+                }
+            });
+            f_op(f_res[l_row][l_col], l_sum);
+        });
+    });
+}
+
+/** @brief  Solve the system A*X = B by forward (KU = 0) or backward (KL = 0) substitution inside of the band
+ *
+ *  @param f_B             right-hand side, it's overwritten by the solution
+ */
+template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+template <uint32_t P>
+void utils::linalg::CBandMatrix<T,N,KL,KU>::solveInPlace(CRightMultipliableType<P>& f_B) const
+{
+    static_assert(KL == 0 || KU == 0, "Only the triangular band matrices can be solved by substitution.");
+    for (uint32_t l_step = 0; l_step < N; ++l_step)
+    {
+        const uint32_t l_row = (KU == 0) ? l_step : (N - 1 - l_step);
+        for (uint32_t l_idx = 1; l_idx <= KL + KU; ++l_idx)
+        {
+            // Solved rows of the band: the previous ones for the lower and the next ones for the upper matrix
+            const bool l_inside = (KU == 0) ? (l_row >= l_idx) : (l_row + l_idx < N);
+            if (!l_inside) break;
+            const uint32_t l_col = (KU == 0) ? (l_row - l_idx) : (l_row + l_idx);
+            const T l_coef = m_data[l_row][l_col + KL - l_row];
+            for (uint32_t l_rhs = 0; l_rhs < P; ++l_rhs)
+            {
+                f_B[l_row][l_rhs] -= l_coef * f_B[l_col][l_rhs];
+            }
+        }
+        const T l_inv = T(1) / m_data[l_row][KL];
+        for (uint32_t l_rhs = 0; l_rhs < P; ++l_rhs)
+        {
+            f_B[l_row][l_rhs] *= l_inv;
+        }
+    }
+}
+
+/** @brief  Solve the system A*X = B
+ *
+ *  @param f_B             right-hand side
+ *  @return                solution
+ */
+template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+template <uint32_t P>
+typename utils::linalg::CBandMatrix<T,N,KL,KU>::template CRightMultipliableType<P> utils::linalg::CBandMatrix<T,N,KL,KU>::solve(const CRightMultipliableType<P>& f_B) const
+{
+    CRightMultipliableType<P> l_X(f_B);
+    solveInPlace(l_X);
+    return l_X;
+}
+
+/** @brief  It returns true, when a zero is on the diagonal */
+template <class T, uint32_t N, uint32_t KL, uint32_t KU>
+bool utils::linalg::CBandMatrix<T,N,KL,KU>::isSingular() const
+{
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        if (m_data[l_row][KL] == T(0)) return true;
+    }
+    return false;
+}
+
+/******************************************************************************/
+/** @brief  Constructor from the triangle of a dense matrix
+ *
+ *  @param f_matrix        dense matrix
+ */
+template <class T, uint32_t N, bool NLower>
+utils::linalg::CTriangularMatrix<T,N,NLower>::CTriangularMatrix(const COriginalType& f_matrix)
+    : m_data()
+{
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        for (uint32_t l_col = 0; l_col < N; ++l_col)
+        {
+            if (isStored(l_row, l_col)) m_data[index(l_row, l_col)] = f_matrix[l_row][l_col];
+        }
+    }
+}
+
+/** @brief  Dense copy of the matrix
+ *
+ *  @return                dense matrix with zeros outside of the triangle
+ */
+template <class T, uint32_t N, bool NLower>
+typename utils::linalg::CTriangularMatrix<T,N,NLower>::COriginalType utils::linalg::CTriangularMatrix<T,N,NLower>::toMatrix() const
+{
+    COriginalType l_matrix;
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        for (uint32_t l_col = 0; l_col < N; ++l_col)
+        {
+            l_matrix[l_row][l_col] = (*this)(l_row, l_col);
+        }
+    }
+    return l_matrix;
+}
+
+/** @brief  Product with a dense matrix, only the elements of the triangle are multiplied (N*(N+1)/2 per column)
+ *
+ *  @param f_res           result, the functor combines it with the calculated elements
+ *  @param f_B             right operand
+ *  @param f_op            functor (destination, value), for example assignment or accumulation
+ */
+template <class T, uint32_t N, bool NLower>
+template <uint32_t P, class F>
+void utils::linalg::CTriangularMatrix<T,N,NLower>::product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const
+{
+    SUnroll<N>::apply([&](uint32_t l_row){
+        const uint32_t l_first = NLower ? 0 : l_row;
+        const uint32_t l_last = NLower ? l_row : (N - 1);
+        SUnroll<P>::apply([&](uint32_t l_col){
+            T l_sum = T(0);
+            for (uint32_t l_idx = l_first; l_idx <= l_last; ++l_idx)
+            {
+                l_sum += m_data[index(l_row, l_idx)] * f_B[l_idx][l_col];
+            }
+            f_op(f_res[l_row][l_col], l_sum);
+        });
+    });
+}
+
+/** @brief  Solve the system A*X = B by forward (lower) or backward (upper) substitution
+ *
+ *  @param f_B             right-hand side, it's overwritten by the solution
+ */
+template <class T, uint32_t N, bool NLower>
+template <uint32_t P>
+void utils::linalg::CTriangularMatrix<T,N,NLower>::solveInPlace(CRightMultipliableType<P>& f_B) const
+{
+    for (uint32_t l_step = 0; l_step < N; ++l_step)
+    {
+        const uint32_t l_row = NLower ? l_step : (N - 1 - l_step);
+        const uint32_t l_first = NLower ? 0 : (l_row + 1);
+        const uint32_t l_last = NLower ? l_row : N;
+        for (uint32_t l_idx = l_first; l_idx < l_last; ++l_idx)
+        {
+            const T l_coef = m_data[index(l_row, l_idx)];
+            for (uint32_t l_rhs = 0; l_rhs < P; ++l_rhs)
+            {
+                f_B[l_row][l_rhs] -= l_coef * f_B[l_idx][l_rhs];
+            }
+        }
+        const T l_inv = T(1) / m_data[index(l_row, l_row)];
+        for (uint32_t l_rhs = 0; l_rhs < P; ++l_rhs)
+        {
+            f_B[l_row][l_rhs] *= l_inv;
+        }
+    }
+}
+
+/** @brief  Solve the system A*X = B
+ *
+ *  @param f_B             right-hand side
+ *  @return                solution
+ */
+template <class T, uint32_t N, bool NLower>
+template <uint32_t P>
+typename utils::linalg::CTriangularMatrix<T,N,NLower>::template CRightMultipliableType<P> utils::linalg::CTriangularMatrix<T,N,NLower>::solve(const CRightMultipliableType<P>& f_B) const
+{
+    CRightMultipliableType<P> l_X(f_B);
+    solveInPlace(l_X);
+    return l_X;
+}
+
+/** @brief  It returns true, when a zero is on the diagonal */
+template <class T, uint32_t N, bool NLower>
+bool utils::linalg::CTriangularMatrix<T,N,NLower>::isSingular() const
+{
+    for (uint32_t l_idx = 0; l_idx < N; ++l_idx)
+    {
+        if (m_data[index(l_idx, l_idx)] == T(0)) return true;
+    }
+    return false;
+}
+
+/******************************************************************************/
+/** @brief  Constructor from the lower triangle of a dense matrix
+ *
+ *  @param f_matrix        dense symmetric matrix
+ */
+template <class T, uint32_t N>
+utils::linalg::CSymmetricPackedMatrix<T,N>::CSymmetricPackedMatrix(const COriginalType& f_matrix)
+    : m_data()
+{
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        for (uint32_t l_col = 0; l_col <= l_row; ++l_col)
+        {
+            m_data[index(l_row, l_col)] = f_matrix[l_row][l_col];
+        }
+    }
+}
+
+/** @brief  Dense copy of the matrix
+ *
+ *  @return                dense symmetric matrix
+ */
+template <class T, uint32_t N>
+typename utils::linalg::CSymmetricPackedMatrix<T,N>::COriginalType utils::linalg::CSymmetricPackedMatrix<T,N>::toMatrix() const
+{
+    COriginalType l_matrix;
+    for (uint32_t l_row = 0; l_row < N; ++l_row)
+    {
+        for (uint32_t l_col = 0; l_col < N; ++l_col)
+        {
+            l_matrix[l_row][l_col] = (*this)(l_row, l_col);
+        }
+    }
+    return l_matrix;
+}
+
+/** @brief  Product with a dense matrix, the upper triangle is read from the mirrored positions
+ *
+ *  @param f_res           result, the functor combines it with the calculated elements
+ *  @param f_B             right operand
+ *  @param f_op            functor (destination, value), for example assignment or accumulation
+ */
+template <class T, uint32_t N>
+template <uint32_t P, class F>
+void utils::linalg::CSymmetricPackedMatrix<T,N>::product(CRightMultipliableType<P>& f_res, const CRightMultipliableType<P>& f_B, F&& f_op) const
+{
+    SUnroll<N>::apply([&](uint32_t l_row){
+        SUnroll<P>::apply([&](uint32_t l_col){
+            T l_sum = T(0);
+            SUnroll<N>::apply([&](uint32_t l_idx){
+                l_sum += m_data[index(l_row, l_idx)] * f_B[l_idx][l_col];
+            });
+            f_op(f_res[l_row][l_col], l_sum);
+        });
+    });
+}
+
+#endif // STRUCTURED_TPP
@@ -0,0 +1,144 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    EventLog.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the deferred-format
+  *          binary event log.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include <mbed.h>
+#include <atomic>
+#include <type_traits>
+#include <string.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/log/logevents.hpp>
+
+namespace utils::log{
+
+   /**
+    * @brief Deferred-format event log, the call sites store the identifier of the event, the board time and the raw bytes of the
+    * arguments, the text is formatted on the host by the string table generated from protocol/protocol.json.
+    *
+    * The events are written in the slots of a lock-free multi-producer ring: a producer reserves the next slot by a compare-and-swap
+    * of the head index, it fills the slot and publishes it by the sequence number of the slot, so the control interrupt, the other
+    * interrupts and the threads can log without masking the interrupts and without formatting. The full log drops the event and
+    * counts it. The task is the single consumer, it packs the published slots in BIN_EVENT_LOG messages (SEventLogHeader, then an
+    * SEventRecord and the arguments of each event) on the safety lane, the slots are released, when the message is queued.
+    *
+    * The identifier is a template argument, so the size of the arguments is checked at compile time against the definition of the event.
+    */
+    class CEventLog: public utils::task::CTask
+    {
+    public:
+        /** @brief Maximum size of the arguments of an event in byte */
+        static const uint8_t s_maxArguments = 16;
+        /** @brief Number of the slots, power of two */
+        static const uint32_t s_slots = 32;
+
+        /* Constructor */
+        CEventLog(uint32_t f_period, utils::serial::CSerialTransmitter& f_serial);
+        /** @brief  Log an event, the arguments are copied in their order, the strings and the pointers aren't allowed */
+        template<ELogEvent ID, class... TArgs>
+        void log(TArgs... f_args)
+        {
+            static_assert(ID < s_logEventCount, "Unknown log event.");
+            static_assert(argumentSize<TArgs...>() == s_logArgumentSizes[ID], "The arguments don't match the definition of the log event.");
+            static_assert(argumentSize<TArgs...>() <= s_maxArguments, "The arguments of the log event are too long.");
+            uint8_t l_arguments[argumentSize<TArgs...>() + 1];
+            pack(l_arguments, f_args...);
+            write(ID, l_arguments, argumentSize<TArgs...>());
+        }
+        /** @brief  Number of the dropped events since the start */
+        uint32_t getDropped() const
+        {
+            return m_totalDropped;
+        }
+    private:
+        /** @brief  Slot of an event */
+        struct SSlot{
+            /** @brief sequence number, the slot is free for the head index equal to it and published for the index plus one */
+            std::atomic<uint32_t> m_sequence;
+            /** @brief board time of the event in microsecond */
+            uint32_t m_timestamp;
+            /** @brief identifier of the event */
+            uint16_t m_id;
+            /** @brief size of the arguments */
+            uint8_t m_length;
+            /** @brief raw arguments */
+            uint8_t m_arguments[s_maxArguments];
+        };
+
+        /** @brief  Size of the arguments */
+        template<class... TArgs>
+        static constexpr uint32_t argumentSize()
+        {
+            return sumSizes(sizeof(TArgs)...);
+        }
+        /** @brief  Sum of the sizes */
+        static constexpr uint32_t sumSizes()
+        {
+            return 0;
+        }
+        /** @brief  Sum of the sizes */
+        template<class... TSizes>
+        static constexpr uint32_t sumSizes(uint32_t f_size, TSizes... f_sizes)
+        {
+            return f_size + sumSizes(f_sizes...);
+        }
+        /** @brief  Copy the arguments in their order */
+        static void pack(uint8_t*)
+        {
+        }
+        /** @brief  Copy the arguments in their order */
+        template<class TArg, class... TArgs>
+        static void pack(uint8_t* f_data, TArg f_arg, TArgs... f_args)
+        {
+            static_assert(std::is_arithmetic<TArg>::value || std::is_enum<TArg>::value, "The arguments of the log events are numbers.");
+            memcpy(f_data, &f_arg, sizeof(f_arg));
+            pack(f_data + sizeof(f_arg), f_args...);
+        }
+        /* Write an event in the next free slot */
+        void write(uint16_t f_id, const uint8_t* f_arguments, uint8_t f_length);
+        /* Run method, it sends the published events */
+        virtual void _run();
+
+        /** @brief  Mask of the indices */
+        static const uint32_t s_mask = s_slots - 1;
+        /** @brief  Serial transmitter of the messages */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Slots of the events */
+        SSlot m_slots[s_slots];
+        /** @brief  Index of the next reserved slot, modified by the producers */
+        std::atomic<uint32_t> m_head;
+        /** @brief  Index of the next sent slot, modified only by the task */
+        uint32_t m_tail;
+        /** @brief  Dropped events since the last message */
+        std::atomic<uint32_t> m_dropped;
+        /** @brief  Dropped events since the start */
+        uint32_t m_totalDropped;
+    };
+
+}; // namespace utils::log
+
+#endif // EVENT_LOG_HPP
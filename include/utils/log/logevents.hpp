@@ -0,0 +1,64 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    LogEvents.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the identifiers and the argument sizes of the deferred-format log events.
+  *          It's generated by protocolGenerator.py from protocol/protocol.json, don't edit it.
+  ******************************************************************************
+ */
+
+
+/* Inclusion guard */
+#ifndef LOG_EVENTS_HPP
+#define LOG_EVENTS_HPP
+
+#include <stdint.h>
+
+namespace utils::log{
+
+    /** @brief Identifiers of the log events, the host formats them by the string table of protocolmessages.py */
+    enum ELogEvent{
+        /** @brief The emergency stop was applied by the state machine: '@ESTP:stop;;' */
+        LOG_EMERGENCY_STOP     = 1,
+        /** @brief Parameters of the finished relay autotuning: '@ATUN:{kp:.5f};{ki:.5f};{kd:.6f};{tf:.5f};;' */
+        LOG_AUTOTUNE_RESULT    = 2,
+        /** @brief The relay autotuning failed: '@ATUN:failed;;' */
+        LOG_AUTOTUNE_FAILED    = 3,
+        /** @brief The step experiment was aborted: '@EXPR:aborted;;' */
+        LOG_EXPERIMENT_ABORTED = 4,
+        /** @brief The end of the path was reached: '@PATH:reached;;' */
+        LOG_PATH_REACHED       = 5,
+        /** @brief The distance of the command was reached: '@DIST:reached;;' */
+        LOG_DISTANCE_REACHED   = 6,
+        /** @brief The controller saturated with measured speed: '@PIDA:Too high speed and the encoder working;;' */
+        LOG_HIGH_SPEED         = 7,
+        /** @brief The controller saturated without measured speed: '@PIDA:Encoder error;;' */
+        LOG_ENCODER_ERROR      = 8,
+        /** @brief The scheduled command was rejected at its time: '@SCHD:rejected;{time};;' */
+        LOG_SCHEDULE_REJECTED  = 9
+    };
+
+    /** @brief Number of the identifiers of the log events */
+    static const uint16_t s_logEventCount = 10;
+    /** @brief Size of the arguments of each event in byte, indexed by the identifier */
+    static constexpr uint8_t s_logArgumentSizes[s_logEventCount] = {0, 0, 16, 0, 0, 0, 0, 0, 0, 4};
+
+}; // namespace utils::log
+
+#endif // LOG_EVENTS_HPP
@@ -0,0 +1,89 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    MemoryReport.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the report of the 
+  *          static memory, heap and stack usage.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef MEMORY_REPORT_HPP
+#define MEMORY_REPORT_HPP
+
+#include <mbed.h>
+#include <rtos.h>
+
+namespace utils::memory{
+
+/**
+ * @brief Report of the RAM usage, it's printed at the boot and it's sent for the 'MEMR' key.
+ * 
+ * The static memory (data and bss) is given by the linker symbols, the size of the subsystems by the sizes of their objects, 
+ * which are listed by the application. The heap usage is read from the allocator of the C library, the used stack of the 
+ * threads is measured by the RTOS from the fill pattern of the stacks. With the static pools and the static stacks the heap 
+ * stays empty after the startup, the report proves it.
+ */
+class CMemoryReport
+{
+public:
+    /** @brief Static memory of a subsystem */
+    struct SObject{
+        /** @brief name of the subsystem */
+        const char* m_name;
+        /** @brief size in bytes */
+        uint32_t m_size;
+    };
+    /** @brief Stack of a thread */
+    struct SStack{
+        /** @brief name of the thread */
+        const char* m_name;
+        /** @brief thread */
+        Thread* m_thread;
+    };
+    /* Constructor */
+    CMemoryReport(const SObject* f_objects, uint32_t f_objectCount, const SStack* f_stacks, uint32_t f_stackCount);
+    /* Print the full report */
+    void print(Serial& f_serial);
+    /* Serial callback of the summary */
+    void serialCallback(char const * a, char * b);
+    /** @brief Number of the threads */
+    uint32_t getStackCount() const {return m_stackCount;}
+    /** @brief Thread with the given index */
+    Thread* getThread(uint32_t f_idx) const {return f_idx < m_stackCount ? m_stacks[f_idx].m_thread : NULL;}
+    /* Size of the static memory (data, bss and noinit) */
+    static uint32_t getStaticSize();
+    /* Size of the heap in use */
+    static uint32_t getHeapUsed();
+    /* Size of the heap obtained from the system */
+    static uint32_t getHeapReserved();
+private:
+    /** @brief Subsystems */
+    const SObject* m_objects;
+    /** @brief Number of the subsystems */
+    const uint32_t m_objectCount;
+    /** @brief Stacks of the threads */
+    const SStack* m_stacks;
+    /** @brief Number of the threads */
+    const uint32_t m_stackCount;
+};
+
+}; // namespace utils::memory
+
+#endif // MEMORY_REPORT_HPP
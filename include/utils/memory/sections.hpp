@@ -0,0 +1,55 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Sections.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the attributes of the memory sections of the 
+  *          control path.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef SECTIONS_HPP
+#define SECTIONS_HPP
+
+/**
+ * The functions of the control tick are placed in the '.ramfunc' section, the linker script of the project (linker/STM32F401XE.ld) 
+ * copies it to the SRAM together with the initialized data, so the tick doesn't wait for the flash (two wait states at 84 MHz) 
+ * and it doesn't depend on the hits of the ART accelerator. The calls from the flash to the SRAM are realized by the veneers of 
+ * the linker, the calls inside the section are direct.
+ * 
+ * The objects of the control tick are placed in the '.data.control' section after the code, so the state of the tick is one 
+ * contiguous block (__control_start__, __control_end__) and it's not mixed with the serial buffers and the stacks. The section 
+ * belongs to the initialized data, so the compiler can use a static or a dynamic initialization for the objects.
+ * 
+ * The objects of the '.noinit' section aren't initialized by the startup code, so their content survives the soft resets (watchdog, 
+ * reset pin, software reset). Only trivial types without initializer can be placed there, the user has to validate the content.
+ * 
+ * On the host (benchmarks, replay) the attributes are empty.
+ */
+#if defined(TARGET_STM32F4)
+#define CONTROL_RAMFUNC __attribute__((section(".ramfunc")))
+#define CONTROL_STATE __attribute__((section(".data.control")))
+#define NOINIT_STATE __attribute__((section(".noinit")))
+#else
+#define CONTROL_RAMFUNC
+#define CONTROL_STATE
+#define NOINIT_STATE
+#endif
+
+#endif // SECTIONS_HPP
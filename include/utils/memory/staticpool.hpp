@@ -0,0 +1,91 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StaticPool.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the fixed size block 
+  *          pool in static memory.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef STATIC_POOL_HPP
+#define STATIC_POOL_HPP
+
+#include <mbed.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace utils::memory{
+
+/**
+ * @brief Pool of fixed size blocks in static memory, it replaces the heap allocation of the objects with bounded count.
+ * 
+ * The blocks are linked in a free list, the allocation and the release take constant time in a critical section, so they can 
+ * be applied from interrupt too. The pool doesn't fragment and its size is known at the link time. The peak of the used 
+ * blocks is recorded for the memory report.
+ * 
+ * @tparam T The type of the objects
+ * @tparam N The number of the blocks
+ */
+template <class T, uint32_t N>
+class CStaticPool
+{
+    static_assert(N > 0, "The pool has to contain at least one block.");
+public:
+    /* Constructor */
+    CStaticPool();
+    /* Allocate a raw block */
+    void* allocate();
+    /* Release a raw block */
+    void deallocate(void* f_block);
+    /* Allocate a block and construct the object in it */
+    template <class... TArgs>
+    T* create(TArgs&&... f_args);
+    /* Destroy the object and release its block */
+    void destroy(T* f_object);
+    /** @brief Number of the used blocks */
+    uint32_t getUsed() const {return m_used;}
+    /** @brief Peak of the used blocks */
+    uint32_t getMaxUsed() const {return m_maxUsed;}
+    /** @brief Number of the blocks */
+    static constexpr uint32_t getCapacity() {return N;}
+private:
+    /** @brief Block of the pool, it holds the object or the link of the free list */
+    union UBlock{
+        /** @brief next free block */
+        UBlock* m_next;
+        /** @brief storage of the object */
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+    };
+    /** @brief Blocks of the pool */
+    UBlock m_blocks[N];
+    /** @brief First free block */
+    UBlock* m_free;
+    /** @brief Number of the used blocks */
+    uint32_t m_used;
+    /** @brief Peak of the used blocks */
+    uint32_t m_maxUsed;
+};
+
+}; // namespace utils::memory
+
+#include "staticpool.tpp"
+
+#endif // STATIC_POOL_HPP
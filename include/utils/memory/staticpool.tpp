@@ -0,0 +1,112 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StaticPool.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the fixed size block 
+  *          pool in static memory.
+  ******************************************************************************
+ */
+
+#ifndef STATIC_POOL_TPP
+#define STATIC_POOL_TPP
+
+#ifndef STATIC_POOL_HPP
+#error __FILE__ should only be included from staticpool.hpp.
+#endif // STATIC_POOL_HPP
+
+namespace utils::memory{
+
+/** @brief  CStaticPool class constructor, it links all blocks in the free list.
+ */
+template <class T, uint32_t N>
+CStaticPool<T,N>::CStaticPool()
+    : m_free(m_blocks)
+    , m_used(0)
+    , m_maxUsed(0)
+{
+    for (uint32_t i = 0; i + 1 < N; ++i)
+    {
+        m_blocks[i].m_next = &m_blocks[i + 1];
+    }
+    m_blocks[N - 1].m_next = NULL;
+}
+
+/** @brief  Allocate a raw block
+ *
+ *  @return                 address of the block, NULL when the pool is exhausted
+ */
+template <class T, uint32_t N>
+void* CStaticPool<T,N>::allocate()
+{
+    core_util_critical_section_enter();
+    UBlock* l_block = m_free;
+    if (NULL != l_block)
+    {
+        m_free = l_block->m_next;
+        ++m_used;
+        m_maxUsed = (m_used > m_maxUsed) ? m_used : m_maxUsed;
+    }
+    core_util_critical_section_exit();
+    return l_block;
+}
+
+/** @brief  Release a raw block, it has to be allocated from this pool
+ *
+ *  @param f_block          address of the block, NULL is ignored
+ */
+template <class T, uint32_t N>
+void CStaticPool<T,N>::deallocate(void* f_block)
+{
+    if (NULL == f_block) return;
+    UBlock* l_block = static_cast<UBlock*>(f_block);
+    core_util_critical_section_enter();
+    l_block->m_next = m_free;
+    m_free = l_block;
+    --m_used;
+    core_util_critical_section_exit();
+}
+
+/** @brief  Allocate a block and construct the object in it
+ *
+ *  @param f_args           arguments of the constructor
+ *  @return                 address of the object, NULL when the pool is exhausted
+ */
+template <class T, uint32_t N>
+template <class... TArgs>
+T* CStaticPool<T,N>::create(TArgs&&... f_args)
+{
+    void* l_block = allocate();
+    return (NULL != l_block) ? new (l_block) T(std::forward<TArgs>(f_args)...) : NULL;
+}
+
+/** @brief  Destroy the object and release its block
+ *
+ *  @param f_object         address of the object, NULL is ignored
+ */
+template <class T, uint32_t N>
+void CStaticPool<T,N>::destroy(T* f_object)
+{
+    if (NULL == f_object) return;
+    f_object->~T();
+    deallocate(f_object);
+}
+
+}; // namespace utils::memory
+
+#endif // STATIC_POOL_TPP
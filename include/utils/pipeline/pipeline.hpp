@@ -0,0 +1,179 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Pipeline.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the sensor-to-actuator pipeline.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <mbed.h>
+#include <tuple>
+#include <type_traits>
+#include <utils/memory/sections.hpp>
+
+namespace utils::pipeline{
+
+   /**
+    * @brief Interface of a pipeline stage, the stages are applied in the same tick in the order of the pipeline.
+    */
+    class IPipelineStage
+    {
+    public:
+        /* Process the tick, the timestamp is common for all stages of the tick */
+        virtual void process(uint32_t f_timestamp) = 0;
+    };
+
+   /**
+    * @brief Interface of a pipeline, it's applied by the control loop in each period.
+    */
+    class IPipeline
+    {
+    public:
+        /* Apply the stages */
+        virtual void tick() = 0;
+        /* Timestamp of the last tick in microsecond */
+        virtual uint32_t getTimestamp() const = 0;
+    };
+
+   /**
+    * @brief Interface of the switch of an optional stage, the disabled stage isn't applied in the tick.
+    */
+    class IStageGate
+    {
+    public:
+        /* Enable or disable the stage */
+        virtual void setEnabled(bool f_enabled) = 0;
+        /* The stage is applied */
+        virtual bool isEnabled() const = 0;
+    };
+
+   /**
+    * @brief Optional stage of the static pipeline, it applies the wrapped stage only when it's enabled. It's used by the load shedding, 
+    * so only the stages, whose outputs aren't needed by the control (sampling, identification, observers), can be wrapped.
+    * 
+    * @tparam TStage    type of the wrapped stage, it has a 'process(uint32_t)' method
+    */
+    template <class TStage>
+    class CGatedStage: public IStageGate
+    {
+    public:
+        /** @brief  Constructor, the stage is enabled */
+        CGatedStage(TStage& f_stage)
+            : m_stage(f_stage)
+            , m_enabled(true)
+        {
+        }
+        /** @brief  Apply the wrapped stage, when it's enabled */
+        void process(uint32_t f_timestamp)
+        {
+            if (m_enabled)
+            {
+                m_stage.TStage::process(f_timestamp);
+            }
+        }
+        /** @brief  Enable or disable the stage, it's applied from the next tick */
+        virtual void setEnabled(bool f_enabled)
+        {
+            m_enabled = f_enabled;
+        }
+        /** @brief  The stage is applied */
+        virtual bool isEnabled() const
+        {
+            return m_enabled;
+        }
+    private:
+        /** @brief  Wrapped stage */
+        TStage& m_stage;
+        /** @brief  The stage is applied */
+        volatile bool m_enabled;
+    };
+
+   /**
+    * @brief Ordered list of stages applied in a single tick (sensor sampling, filter, controller, actuator, monitoring).
+    * 
+    * Each stage reads the outputs published by the previous stages in the same tick, so the measurement isn't stale and 
+    * it's never read during its update. 
+    */
+    class CPipeline: public IPipeline
+    {
+    public:
+        /* Constructor */
+        CPipeline(IPipelineStage** f_stages, uint8_t f_stageCount);
+        /* Apply the stages */
+        virtual void tick();
+        /** @brief  Timestamp of the last tick in microsecond */
+        virtual uint32_t getTimestamp() const
+        {
+            return m_timestamp;
+        }
+    private:
+        /** @brief  Stages in order of application */
+        IPipelineStage** m_stages;
+        /** @brief  Number of the stages */
+        const uint8_t m_stageCount;
+        /** @brief  Timestamp of the last tick */
+        volatile uint32_t m_timestamp;
+    };
+
+   /**
+    * @brief Pipeline with the stages wired at compile time, it's the static variant of the CPipeline.
+    * 
+    * The stages are held by their concrete types and their process methods are applied by qualified calls, so there is 
+    * no indirect call between the stages and the compiler can inline the whole tick into the interrupt of the control loop. 
+    * The stage list is fixed at compile time, the CPipeline remains available for the configurable wiring.
+    * 
+    * @tparam TStages   types of the stages in order of application, each of them has a 'process(uint32_t)' method
+    */
+    template <class... TStages>
+    class CStaticPipeline: public IPipeline
+    {
+    public:
+        /* Constructor */
+        CStaticPipeline(TStages&... f_stages);
+        /* Apply the stages */
+        virtual void tick();
+        /** @brief  Timestamp of the last tick in microsecond */
+        virtual uint32_t getTimestamp() const
+        {
+            return m_timestamp;
+        }
+    private:
+        /* Apply the stage with the given index and the next ones */
+        template <uint32_t I>
+        typename std::enable_if<(I < sizeof...(TStages))>::type apply(uint32_t f_timestamp);
+        /** @brief  End of the stages */
+        template <uint32_t I>
+        typename std::enable_if<(I == sizeof...(TStages))>::type apply(uint32_t)
+        {
+        }
+
+        /** @brief  Stages in order of application */
+        std::tuple<TStages&...> m_stages;
+        /** @brief  Timestamp of the last tick */
+        volatile uint32_t m_timestamp;
+    };
+
+}; // namespace utils::pipeline
+
+#include "pipeline.tpp"
+
+#endif // PIPELINE_HPP
@@ -0,0 +1,72 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Pipeline.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the statically wired pipeline.
+  ******************************************************************************
+ */
+
+#ifndef PIPELINE_TPP
+#define PIPELINE_TPP
+
+#ifndef PIPELINE_HPP
+#error __FILE__ should only be included from pipeline.hpp.
+#endif // PIPELINE_HPP
+
+namespace utils::pipeline{
+
+    /** \brief  CStaticPipeline class constructor
+     *
+     *  @param f_stages        stages in order of application
+     */
+    template <class... TStages>
+    CStaticPipeline<TStages...>::CStaticPipeline(TStages&... f_stages)
+        : m_stages(f_stages...)
+        , m_timestamp(0)
+    {
+    }
+
+    /** \brief  Apply the stages
+     *
+     *  It takes the timestamp of the tick and it applies the stages in order.
+     */
+    template <class... TStages>
+    CONTROL_RAMFUNC void CStaticPipeline<TStages...>::tick()
+    {
+        uint32_t l_timestamp = us_ticker_read();
+        m_timestamp = l_timestamp;
+        apply<0>(l_timestamp);
+    }
+
+    /** \brief  Apply the stage with the given index and the next ones. The call is qualified by the type of the stage, 
+     *  so it isn't dispatched by the virtual table.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    template <class... TStages>
+    template <uint32_t I>
+    CONTROL_RAMFUNC typename std::enable_if<(I < sizeof...(TStages))>::type CStaticPipeline<TStages...>::apply(uint32_t f_timestamp)
+    {
+        using TStage = typename std::tuple_element<I, std::tuple<TStages...>>::type;
+        std::get<I>(m_stages).TStage::process(f_timestamp);
+        apply<I + 1>(f_timestamp);
+    }
+
+}; // namespace utils::pipeline
+
+#endif // PIPELINE_TPP
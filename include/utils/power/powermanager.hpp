@@ -0,0 +1,85 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    PowerManager.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the low-power mode of 
+  *          the parked car.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef POWER_MANAGER_HPP
+#define POWER_MANAGER_HPP
+
+#include <mbed.h>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/loadmonitor.hpp>
+
+namespace utils::power{
+
+   /**
+    * @brief Low-power mode of the parked car, it's a stage of the control pipeline.
+    * 
+    * The idle thread puts the core in sleep mode (utils::task::CLoadMonitor::setSleep) while the manager is enabled, any interrupt 
+    * (serial reception, encoder edge, timer) wakes it up in a few cycles. After the car is parked for the hold time (the getter, e.g. 
+    * braking state and zero speed), the tick of the task manager is scaled, so its interrupt is applied less often and the periodic tasks 
+    * run with a coarser resolution. The first tick without the parked condition (new command, motion of the encoder) restores the base 
+    * tick in the same control period, the tasks of the serial links are notified by their interrupts in both modes. The clock of the 
+    * core isn't changed, the timers and the baud rates of the serial links depend on it.
+    * 
+    * Commands of the 'POWR' key: '0' state ('enabled;parked;scale'), '1;enable' enables or disables the low-power mode.
+    */
+    class CPowerManager: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Getter of the parked condition */
+        typedef mbed::Callback<bool()> FParkedGetter;
+        /* Constructor */
+        CPowerManager(utils::task::CTaskManager& f_taskManager, FParkedGetter f_isParked, uint32_t f_tickScale, uint32_t f_holdTime);
+        /* Enable the low-power mode */
+        void enable(bool f_enable);
+        /* Process the tick of the control loop */
+        virtual void process(uint32_t f_timestamp);
+        /** @brief  The car is parked, the tick is scaled */
+        bool isParked() const
+        {
+            return m_isParked;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Task manager */
+        utils::task::CTaskManager& m_taskManager;
+        /** @brief  Getter of the parked condition */
+        FParkedGetter m_isParkedGetter;
+        /** @brief  Scale of the tick in the parked mode */
+        const uint32_t m_tickScale;
+        /** @brief  Time of the parked condition before the low-power mode in microsecond */
+        const uint32_t m_holdTime;
+        /** @brief  The low-power mode is enabled */
+        volatile bool m_isEnabled;
+        /** @brief  The tick is scaled */
+        volatile bool m_isParked;
+        /** @brief  Time of the last tick without the parked condition */
+        uint32_t m_activeTime;
+    };
+
+}; // namespace utils::power
+
+#endif // POWER_MANAGER_HPP
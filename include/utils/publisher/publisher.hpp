@@ -0,0 +1,175 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Publisher.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the generic sensor publisher.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef PUBLISHER_HPP
+#define PUBLISHER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+
+namespace utils::publisher{
+
+   /**
+    * @brief Interface of a published value, it reads and serializes the value of a sensor.
+    */
+    class IPublishedValue
+    {
+    public:
+        /* Serialize the current value as text */
+        virtual int32_t text(char* f_buffer, uint32_t f_size) = 0;
+        /* Serialize the current value in binary format */
+        virtual int32_t binary(uint8_t* f_buffer, uint32_t f_size) = 0;
+        /** @brief  Key of the value in the text frame, four characters */
+        virtual const char* getKey() const = 0;
+        /** @brief  The value is published after each 'getDivider' period of the publisher */
+        virtual uint16_t getDivider() const = 0;
+    };
+
+   /**
+    * @brief Serializer of the float values, the text has the given number of decimals, the binary format is the little-endian float.
+    * 
+    * @tparam NDecimals      number of decimals in text format
+    */
+    template <uint8_t NDecimals>
+    struct CFloatSerializer
+    {
+        /** @brief  Type of the serialized value */
+        typedef float TValue;
+        /* Text format */
+        static int32_t text(char* f_buffer, uint32_t f_size, float f_value);
+        /* Binary format */
+        static int32_t binary(uint8_t* f_buffer, uint32_t f_size, float f_value);
+    };
+
+   /**
+    * @brief Serializer of the integer values, the binary format is the little-endian 32-bit integer.
+    */
+    struct CIntSerializer
+    {
+        /** @brief  Type of the serialized value */
+        typedef int32_t TValue;
+        /* Text format */
+        static int32_t text(char* f_buffer, uint32_t f_size, int32_t f_value);
+        /* Binary format */
+        static int32_t binary(uint8_t* f_buffer, uint32_t f_size, int32_t f_value);
+    };
+
+   /**
+    * @brief Published value with a getter and a serializer.
+    * 
+    * The getter is applied from the thread of the publisher, so it has to be thread safe (e.g. atomic read of a word). 
+    * The serializer provides the static 'text' and 'binary' functions and the type of the value, so new formats can be added without virtual calls.
+    * 
+    * @tparam TSerializer    serializer of the value (CFloatSerializer, CIntSerializer)
+    * @tparam TGetter        any callable type without parameters and with return type convertible to the value type (function pointer, mbed::Callback)
+    */
+    template <class TSerializer, class TGetter>
+    class CPublishedValue: public IPublishedValue
+    {
+    public:
+        /* Constructor */
+        CPublishedValue(const char* f_key, uint16_t f_divider, TGetter f_getter);
+        /* Serialize the current value as text */
+        virtual int32_t text(char* f_buffer, uint32_t f_size);
+        /* Serialize the current value in binary format */
+        virtual int32_t binary(uint8_t* f_buffer, uint32_t f_size);
+        /** @brief  Key of the value in the text frame */
+        virtual const char* getKey() const
+        {
+            return m_key;
+        }
+        /** @brief  Divider of the publishing period */
+        virtual uint16_t getDivider() const
+        {
+            return m_divider;
+        }
+    private:
+        /** @brief  Key of the value */
+        const char* m_key;
+        /** @brief  Divider of the publishing period */
+        const uint16_t m_divider;
+        /** @brief  Getter of the value */
+        TGetter m_getter;
+    };
+
+    /** @brief  Create a published value, the type of the getter is deduced. */
+    template <class TSerializer, class TGetter>
+    CPublishedValue<TSerializer,TGetter> makePublishedValue(const char* f_key, uint16_t f_divider, TGetter f_getter)
+    {
+        return CPublishedValue<TSerializer,TGetter>(f_key, f_divider, f_getter);
+    }
+
+   /**
+    * @brief Publisher of a group of sensor values in a single task.
+    * 
+    * The values are registered in a static list owned by the user, the subscribed values are sampled in the same period 
+    * and they are transmitted in a single combined frame, so the overhead doesn't grow with the number of sensors. Each value is 
+    * published after each divider period. The text frame contains the key and value pairs ("@PUBS:ENCS=1.23;CURR=0.51;;"), the binary 
+    * frame (utils::serial::BIN_PUBLISH) contains the timestamp and the index, the length and the bytes of each value.
+    */
+    class CPublisherGroup: public utils::task::CTask
+    {
+    public:
+        /* Constructor */
+        CPublisherGroup(uint32_t                            f_period
+                       ,IPublishedValue**                   f_values
+                       ,uint8_t                             f_valueCount
+                       ,utils::serial::CSerialTransmitter&  f_serial);
+        /* Subscribe the published values */
+        bool subscribe(uint32_t f_mask, bool f_binary);
+        /* Serial callback of the subscription */
+        void serialCallback(char const * a, char * b);
+        /* Binary callback of the subscription */
+        uint8_t binaryCallback(const utils::serial::SPublisherSubscribePayload& f_payload);
+        /** @brief  Maximum number of the values */
+        static const uint8_t s_maxValues = 32;
+    private:
+        /* Run method */
+        virtual void _run();
+        /* Transmit the values in a text frame */
+        void publishText(uint32_t f_mask);
+        /* Transmit the values in a binary frame */
+        void publishBinary(uint32_t f_mask);
+
+        /** @brief  List of the values */
+        IPublishedValue** m_values;
+        /** @brief  Number of the values */
+        uint8_t m_valueCount;
+        /** @brief  Mask of the subscribed values */
+        volatile uint32_t m_mask;
+        /** @brief  Binary frames */
+        volatile bool m_isBinary;
+        /** @brief  Number of the applied periods */
+        uint32_t m_tick;
+        /** @brief  Serial transmitter */
+        utils::serial::CSerialTransmitter& m_serial;
+    };
+
+}; // namespace utils::publisher
+
+#include "publisher.tpp"
+
+#endif // PUBLISHER_HPP
@@ -0,0 +1,115 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Publisher.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the published values.
+  ******************************************************************************
+ */
+
+#ifndef PUBLISHER_TPP
+#define PUBLISHER_TPP
+
+#ifndef PUBLISHER_HPP
+#error __FILE__ should only be included from publisher.hpp.
+#endif // PUBLISHER_HPP
+
+#include <cstdio>
+#include <cstring>
+#include <utils/fmt/format.hpp>
+
+namespace utils::publisher{
+
+    /** \brief  Text format of the float value
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_size          size of the buffer
+     *  @param f_value         value
+     *  @return                number of the written characters, negative when the buffer is too small
+     */
+    template <uint8_t NDecimals>
+    int32_t CFloatSerializer<NDecimals>::text(char* f_buffer, uint32_t f_size, float f_value)
+    {
+        char l_text[utils::fmt::s_floatSize];
+        uint32_t l_length = utils::fmt::formatFloat(l_text, f_value, NDecimals);
+        if (l_length >= f_size)
+        {
+            return -1;
+        }
+        memcpy(f_buffer, l_text, l_length + 1);
+        return l_length;
+    }
+
+    /** \brief  Binary format of the float value
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_size          size of the buffer
+     *  @param f_value         value
+     *  @return                number of the written bytes, negative when the buffer is too small
+     */
+    template <uint8_t NDecimals>
+    int32_t CFloatSerializer<NDecimals>::binary(uint8_t* f_buffer, uint32_t f_size, float f_value)
+    {
+        if (f_size < sizeof(f_value))
+        {
+            return -1;
+        }
+        memcpy(f_buffer, &f_value, sizeof(f_value));
+        return sizeof(f_value);
+    }
+
+    /** \brief  CPublishedValue class constructor
+     *
+     *  @param f_key           key of four characters, it has to remain valid
+     *  @param f_divider       the value is published after each divider period of the publisher
+     *  @param f_getter        getter of the value
+     */
+    template <class TSerializer, class TGetter>
+    CPublishedValue<TSerializer,TGetter>::CPublishedValue(const char* f_key, uint16_t f_divider, TGetter f_getter)
+        : m_key(f_key)
+        , m_divider(f_divider > 0 ? f_divider : 1)
+        , m_getter(f_getter)
+    {
+    }
+
+    /** \brief  Serialize the current value as text
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_size          size of the buffer
+     *  @return                number of the written characters, negative when the buffer is too small
+     */
+    template <class TSerializer, class TGetter>
+    int32_t CPublishedValue<TSerializer,TGetter>::text(char* f_buffer, uint32_t f_size)
+    {
+        return TSerializer::text(f_buffer, f_size, static_cast<typename TSerializer::TValue>(m_getter()));
+    }
+
+    /** \brief  Serialize the current value in binary format
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_size          size of the buffer
+     *  @return                number of the written bytes, negative when the buffer is too small
+     */
+    template <class TSerializer, class TGetter>
+    int32_t CPublishedValue<TSerializer,TGetter>::binary(uint8_t* f_buffer, uint32_t f_size)
+    {
+        return TSerializer::binary(f_buffer, f_size, static_cast<typename TSerializer::TValue>(m_getter()));
+    }
+
+}; // namespace utils::publisher
+
+#endif // PUBLISHER_TPP
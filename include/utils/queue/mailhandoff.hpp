@@ -0,0 +1,85 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    MailHandoff.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the handoff of 
+  *          the sample blocks between the contexts by the RTOS mail.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef MAIL_HANDOFF_HPP
+#define MAIL_HANDOFF_HPP
+
+#include <mbed.h>
+#include <rtos.h>
+
+namespace utils{
+
+/**
+ * @brief Handoff of fixed blocks between the contexts, the ownership of a block is passed instead of its copy.
+ * 
+ * The blocks are allocated from the memory pool of the RTOS mail, the producer claims a free block, it fills the block once in place 
+ * and it publishes it, then the block belongs to the consumer until it's released back to the pool. The producer doesn't wait: when 
+ * the consumer holds all blocks, the sample is dropped and counted. The consumer thread can wait on the next block or the notifier 
+ * triggers the consuming task, which takes the blocks without waiting. Claim and publish can be applied from the interrupts.
+ * 
+ * @tparam T The type of the blocks.
+ * @tparam N The number of the blocks in the pool.
+ */
+template <class T, uint32_t N>
+class CMailHandoff
+{
+public:
+    /* Constructor */
+    CMailHandoff();
+    /** @brief  Set the notifier of the consumer, it's applied after each publish in the producer context (e.g. mbed::callback(&task, &CTask::Notify)) */
+    void setNotifier(mbed::Callback<void()> f_notifier)
+    {
+        m_notifier = f_notifier;
+    }
+    /* Claim a free block */
+    inline T* claim();
+    /* Pass the filled block to the consumer */
+    inline void publish(T* f_block);
+    /* Take the next block */
+    inline T* receive(uint32_t f_timeout = 0);
+    /* Give back a consumed block */
+    inline void release(T* f_block);
+    /** @brief  Number of the dropped samples, the pool didn't have a free block */
+    uint32_t getDropped() const
+    {
+        return m_dropped;
+    }
+    /** @brief  Number of the blocks */
+    static const uint32_t s_capacity = N;
+private:
+    /** @brief  Mail queue and memory pool of the blocks */
+    rtos::Mail<T,N> m_mail;
+    /** @brief  Notifier of the consumer */
+    mbed::Callback<void()> m_notifier;
+    /** @brief  Number of the dropped samples */
+    volatile uint32_t m_dropped;
+};
+
+}; // namespace utils
+
+#include "mailhandoff.tpp"
+
+#endif // MAIL_HANDOFF_HPP
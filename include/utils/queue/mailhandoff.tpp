@@ -0,0 +1,99 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    MailHandoff.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the handoff of 
+  *          the sample blocks between the contexts by the RTOS mail.
+  ******************************************************************************
+ */
+
+#ifndef MAIL_HANDOFF_TPP
+#define MAIL_HANDOFF_TPP
+
+#ifndef MAIL_HANDOFF_HPP
+#error __FILE__ should only be included from mailhandoff.hpp.
+#endif // MAIL_HANDOFF_HPP
+
+namespace utils{
+
+/** @brief  Mail handoff class constructor
+ *
+ */
+template <class T, uint32_t N>
+CMailHandoff<T,N>::CMailHandoff()
+    : m_mail()
+    , m_notifier()
+    , m_dropped(0)
+{
+}
+
+/** @brief  Claim a free block of the pool without waiting
+ *
+ *  @return                    the block, NULL when the consumer holds all blocks
+ */
+template <class T, uint32_t N>
+inline T* CMailHandoff<T,N>::claim()
+{
+    T* l_block = m_mail.alloc(0);
+    if (NULL == l_block)
+    {
+        m_dropped = m_dropped + 1;
+    }
+    return l_block;
+}
+
+/** @brief  Pass the filled block to the consumer and notify it
+ *
+ *  @param f_block             claimed block, it mustn't be accessed by the producer after it
+ */
+template <class T, uint32_t N>
+inline void CMailHandoff<T,N>::publish(T* f_block)
+{
+    m_mail.put(f_block);
+    if (m_notifier)
+    {
+        m_notifier();
+    }
+}
+
+/** @brief  Take the next block in order of publishing
+ *
+ *  @param f_timeout           waiting time in millisecond, zero doesn't wait (the tasks and the interrupts), osWaitForever waits
+ *  @return                    the block, NULL without block in the timeout
+ */
+template <class T, uint32_t N>
+inline T* CMailHandoff<T,N>::receive(uint32_t f_timeout)
+{
+    osEvent l_event = m_mail.get(f_timeout);
+    return (osEventMail == l_event.status) ? static_cast<T*>(l_event.value.p) : NULL;
+}
+
+/** @brief  Give back a consumed block to the pool
+ *
+ *  @param f_block             received block
+ */
+template <class T, uint32_t N>
+inline void CMailHandoff<T,N>::release(T* f_block)
+{
+    m_mail.free(f_block);
+}
+
+}; // namespace utils
+
+#endif // MAIL_HANDOFF_TPP
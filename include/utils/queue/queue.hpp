@@ -41,6 +41,13 @@ template <class T, unsigned int N>
 class CQueue
 {
 public:
+    /** @brief Contiguous region of the buffer */
+    struct SSpan{
+        /** @brief pointer to the first element */
+        T* m_data;
+        /** @brief number of elements */
+        unsigned int m_length;
+    };
     /* Constructor */
     CQueue();
     /* Destructor */
@@ -61,6 +68,14 @@ public:
     inline void push(T *f_char, unsigned int f_len);
     /* Empty queue */ 
     inline void empty();
+    /* Readable regions */
+    inline unsigned int getReadable(SSpan (&f_spans)[2]);
+    /* Writable regions */
+    inline unsigned int getWritable(SSpan (&f_spans)[2]);
+    /* Commit the elements written in the writable regions */
+    inline void commit(unsigned int f_len);
+    /* Consume the elements read from the readable regions */
+    inline void consume(unsigned int f_len);
 private:
     /* buffer */
     volatile T m_buffer[N];
@@ -175,4 +175,73 @@ inline void CQueue<T,N>::empty()
     m_size = 0;
 }
 
+/** @brief  Readable regions method
+ *
+ *  It exposes the readable elements in place as one or two contiguous regions, the second region is empty, when the elements don't wrap. 
+ *  The elements are released by the 'consume' method.
+ *
+ *  @param f_spans   destination of the regions
+ *  @return    Number of readable elements
+ */
+template <class T, unsigned int N>
+inline unsigned int CQueue<T,N>::getReadable(SSpan (&f_spans)[2])
+{
+    unsigned int l_size = m_size;
+    unsigned int l_read = (m_end + 1) % N;
+    unsigned int l_first = (l_size < N - l_read) ? l_size : N - l_read;
+    f_spans[0].m_data = const_cast<T*>(&m_buffer[l_read]);
+    f_spans[0].m_length = l_first;
+    f_spans[1].m_data = const_cast<T*>(&m_buffer[0]);
+    f_spans[1].m_length = l_size - l_first;
+    return l_size;
+}
+
+/** @brief  Writable regions method
+ *
+ *  It exposes the free places in place as one or two contiguous regions. The written elements are added to the queue by the 'commit' method.
+ *
+ *  @param f_spans   destination of the regions
+ *  @return    Number of writable elements
+ */
+template <class T, unsigned int N>
+inline unsigned int CQueue<T,N>::getWritable(SSpan (&f_spans)[2])
+{
+    unsigned int l_free = (N - 2) - m_size;
+    unsigned int l_write = m_start;
+    unsigned int l_first = (l_free < N - l_write) ? l_free : N - l_write;
+    f_spans[0].m_data = const_cast<T*>(&m_buffer[l_write]);
+    f_spans[0].m_length = l_first;
+    f_spans[1].m_data = const_cast<T*>(&m_buffer[0]);
+    f_spans[1].m_length = l_free - l_first;
+    return l_free;
+}
+
+/** @brief  Commit method
+ *
+ *  It adds the elements written in the writable regions to the queue.
+ *
+ *  @param f_len     number of written elements
+ *  @return    None
+ */
+template <class T, unsigned int N>
+inline void CQueue<T,N>::commit(unsigned int f_len)
+{
+    m_start = (m_start + f_len) % N;
+    m_size += f_len;
+}
+
+/** @brief  Consume method
+ *
+ *  It removes the elements read from the readable regions.
+ *
+ *  @param f_len     number of read elements
+ *  @return    None
+ */
+template <class T, unsigned int N>
+inline void CQueue<T,N>::consume(unsigned int f_len)
+{
+    m_end = (m_end + f_len) % N;
+    m_size -= f_len;
+}
+
 #endif // QUEUE_TPP
\ No newline at end of file
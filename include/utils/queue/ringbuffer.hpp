@@ -0,0 +1,102 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    RingBuffer.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the lock-free 
+  *          single-producer single-consumer ring buffer.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+namespace utils{
+
+/**
+ * @brief Lock-free single-producer single-consumer ring buffer.
+ * 
+ * The producer writes only the head index, the consumer writes only the tail index, the indices are free-running and they are 
+ * masked with the power of two capacity. The indices are published with release ordering and they are read with acquire ordering, 
+ * so an interrupt and a thread can exchange data without masking the interrupts. The bulk methods copy the contiguous regions by memcpy.
+ * 
+ * @tparam T The type of the elements, it has to be trivially copyable.
+ * @tparam N The capacity of the buffer, it has to be power of two.
+ */
+template <class T, uint32_t N>
+class CRingBuffer
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "The capacity of the ring buffer has to be power of two.");
+public:
+    /** @brief Contiguous region of the buffer */
+    struct SSpan{
+        /** @brief pointer to the first element */
+        T* m_data;
+        /** @brief number of elements */
+        uint32_t m_length;
+    };
+
+    /* Constructor */
+    CRingBuffer();
+    /* Is full method */
+    inline bool isFull() const;
+    /* Is empty method */
+    inline bool isEmpty() const;
+    /* Number of readable elements */
+    inline uint32_t getSize() const;
+    /* Number of writable elements */
+    inline uint32_t getFree() const;
+    /* Push single element, producer side */
+    inline bool push(const T& f_elem);
+    /* Pop single element, consumer side */
+    inline bool pop(T& f_elem);
+    /* Push multiple elements, producer side */
+    inline uint32_t push(const T* f_elems, uint32_t f_length);
+    /* Pop multiple elements, consumer side */
+    inline uint32_t pop(T* f_elems, uint32_t f_length);
+    /* Readable regions, consumer side */
+    inline uint32_t getReadable(SSpan (&f_spans)[2]);
+    /* Writable regions, producer side */
+    inline uint32_t getWritable(SSpan (&f_spans)[2]);
+    /* Commit the elements written in the writable regions, producer side */
+    inline void commit(uint32_t f_length);
+    /* Consume the elements read from the readable regions, consumer side */
+    inline void consume(uint32_t f_length);
+    /** @brief  Capacity of the buffer */
+    static const uint32_t s_capacity = N;
+private:
+    /** @brief  Mask of the indices */
+    static const uint32_t s_mask = N - 1;
+    /** @brief  buffer */
+    T m_buffer[N];
+    /** @brief  write index, modified only by the producer */
+    std::atomic<uint32_t> m_head;
+    /** @brief  read index, modified only by the consumer */
+    std::atomic<uint32_t> m_tail;
+};
+
+}; // namespace utils
+
+#include "ringbuffer.tpp"
+
+#endif // RING_BUFFER_HPP
@@ -0,0 +1,231 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    RingBuffer.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the lock-free 
+  *          single-producer single-consumer ring buffer.
+  ******************************************************************************
+ */
+
+#ifndef RING_BUFFER_TPP
+#define RING_BUFFER_TPP
+
+#ifndef RING_BUFFER_HPP
+#error __FILE__ should only be included from ringbuffer.hpp.
+#endif // RING_BUFFER_HPP
+
+namespace utils{
+
+/** @brief  Ring buffer class constructor
+ *
+ */
+template <class T, uint32_t N>
+CRingBuffer<T,N>::CRingBuffer()
+    : m_buffer()
+    , m_head(0)
+    , m_tail(0)
+{
+}
+
+/** @brief  Is full method
+ *
+ *  @return    True if the buffer is full
+ */
+template <class T, uint32_t N>
+bool CRingBuffer<T,N>::isFull() const
+{
+    return getSize() == N;
+}
+
+/** @brief  Is empty method
+ *
+ *  @return    True if the buffer is empty
+ */
+template <class T, uint32_t N>
+bool CRingBuffer<T,N>::isEmpty() const
+{
+    return getSize() == 0;
+}
+
+/** @brief  Number of readable elements
+ *
+ *  @return    number of elements
+ */
+template <class T, uint32_t N>
+uint32_t CRingBuffer<T,N>::getSize() const
+{
+    return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+}
+
+/** @brief  Number of writable elements
+ *
+ *  @return    number of free places
+ */
+template <class T, uint32_t N>
+uint32_t CRingBuffer<T,N>::getFree() const
+{
+    return N - getSize();
+}
+
+/** @brief  Push single element
+ *
+ *  @param f_elem    element to be added
+ *  @return          false, when the buffer is full
+ */
+template <class T, uint32_t N>
+bool CRingBuffer<T,N>::push(const T& f_elem)
+{
+    uint32_t l_head = m_head.load(std::memory_order_relaxed);
+    if (l_head - m_tail.load(std::memory_order_acquire) == N)
+    {
+        return false;
+    }
+    m_buffer[l_head & s_mask] = f_elem;
+    m_head.store(l_head + 1, std::memory_order_release);
+    return true;
+}
+
+/** @brief  Pop single element
+ *
+ *  @param f_elem    destination of the element
+ *  @return          false, when the buffer is empty
+ */
+template <class T, uint32_t N>
+bool CRingBuffer<T,N>::pop(T& f_elem)
+{
+    uint32_t l_tail = m_tail.load(std::memory_order_relaxed);
+    if (m_head.load(std::memory_order_acquire) == l_tail)
+    {
+        return false;
+    }
+    f_elem = m_buffer[l_tail & s_mask];
+    m_tail.store(l_tail + 1, std::memory_order_release);
+    return true;
+}
+
+/** @brief  Push multiple elements
+ *
+ *  It copies as many elements as there is free place, in at most two contiguous regions.
+ *
+ *  @param f_elems   pointer to the elements
+ *  @param f_length  number of elements
+ *  @return          number of added elements
+ */
+template <class T, uint32_t N>
+uint32_t CRingBuffer<T,N>::push(const T* f_elems, uint32_t f_length)
+{
+    uint32_t l_head = m_head.load(std::memory_order_relaxed);
+    uint32_t l_free = N - (l_head - m_tail.load(std::memory_order_acquire));
+    uint32_t l_count = (f_length < l_free) ? f_length : l_free;
+    uint32_t l_start = l_head & s_mask;
+    uint32_t l_first = (l_count < N - l_start) ? l_count : N - l_start;
+    memcpy(&m_buffer[l_start], f_elems, l_first * sizeof(T));
+    memcpy(&m_buffer[0], f_elems + l_first, (l_count - l_first) * sizeof(T));
+    m_head.store(l_head + l_count, std::memory_order_release);
+    return l_count;
+}
+
+/** @brief  Pop multiple elements
+ *
+ *  It copies as many elements as available, in at most two contiguous regions.
+ *
+ *  @param f_elems   destination of the elements
+ *  @param f_length  size of the destination
+ *  @return          number of removed elements
+ */
+template <class T, uint32_t N>
+uint32_t CRingBuffer<T,N>::pop(T* f_elems, uint32_t f_length)
+{
+    uint32_t l_tail = m_tail.load(std::memory_order_relaxed);
+    uint32_t l_size = m_head.load(std::memory_order_acquire) - l_tail;
+    uint32_t l_count = (f_length < l_size) ? f_length : l_size;
+    uint32_t l_start = l_tail & s_mask;
+    uint32_t l_first = (l_count < N - l_start) ? l_count : N - l_start;
+    memcpy(f_elems, &m_buffer[l_start], l_first * sizeof(T));
+    memcpy(f_elems + l_first, &m_buffer[0], (l_count - l_first) * sizeof(T));
+    m_tail.store(l_tail + l_count, std::memory_order_release);
+    return l_count;
+}
+
+/** @brief  Readable regions
+ *
+ *  It exposes the readable elements in place as one or two contiguous regions, the second region is empty, when the elements don't wrap. 
+ *  The elements are released by the 'consume' method.
+ *
+ *  @param f_spans   destination of the regions
+ *  @return          number of readable elements
+ */
+template <class T, uint32_t N>
+uint32_t CRingBuffer<T,N>::getReadable(SSpan (&f_spans)[2])
+{
+    uint32_t l_tail = m_tail.load(std::memory_order_relaxed);
+    uint32_t l_size = m_head.load(std::memory_order_acquire) - l_tail;
+    uint32_t l_start = l_tail & s_mask;
+    uint32_t l_first = (l_size < N - l_start) ? l_size : N - l_start;
+    f_spans[0].m_data = &m_buffer[l_start];
+    f_spans[0].m_length = l_first;
+    f_spans[1].m_data = &m_buffer[0];
+    f_spans[1].m_length = l_size - l_first;
+    return l_size;
+}
+
+/** @brief  Writable regions
+ *
+ *  It exposes the free places in place as one or two contiguous regions. The written elements are published by the 'commit' method.
+ *
+ *  @param f_spans   destination of the regions
+ *  @return          number of writable elements
+ */
+template <class T, uint32_t N>
+uint32_t CRingBuffer<T,N>::getWritable(SSpan (&f_spans)[2])
+{
+    uint32_t l_head = m_head.load(std::memory_order_relaxed);
+    uint32_t l_free = N - (l_head - m_tail.load(std::memory_order_acquire));
+    uint32_t l_start = l_head & s_mask;
+    uint32_t l_first = (l_free < N - l_start) ? l_free : N - l_start;
+    f_spans[0].m_data = &m_buffer[l_start];
+    f_spans[0].m_length = l_first;
+    f_spans[1].m_data = &m_buffer[0];
+    f_spans[1].m_length = l_free - l_first;
+    return l_free;
+}
+
+/** @brief  Commit the elements written in the writable regions
+ *
+ *  @param f_length  number of written elements
+ */
+template <class T, uint32_t N>
+void CRingBuffer<T,N>::commit(uint32_t f_length)
+{
+    m_head.store(m_head.load(std::memory_order_relaxed) + f_length, std::memory_order_release);
+}
+
+/** @brief  Consume the elements read from the readable regions
+ *
+ *  @param f_length  number of read elements
+ */
+template <class T, uint32_t N>
+void CRingBuffer<T,N>::consume(uint32_t f_length)
+{
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + f_length, std::memory_order_release);
+}
+
+}; // namespace utils
+
+#endif // RING_BUFFER_TPP
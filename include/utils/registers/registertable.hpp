@@ -0,0 +1,312 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    RegisterTable.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the register table of 
+  *          the parameters and the live signals.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef REGISTER_TABLE_HPP
+#define REGISTER_TABLE_HPP
+
+#include <mbed.h>
+#include <string.h>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+
+namespace utils::registers{
+
+    /** @brief  Types of the register values, each register is a 32-bit word */
+    enum ERegisterType{
+        REG_FLOAT       = 0,                                            /**< little-endian float */
+        REG_INT32       = 1,                                            /**< signed 32-bit integer */
+        REG_UINT32      = 2                                             /**< unsigned 32-bit integer */
+    };
+
+   /**
+    * @brief Conversion between the value types and the raw words of the registers.
+    * 
+    * @tparam V              type of the value (float, int32_t, uint32_t)
+    */
+    template <class V>
+    struct SRegisterValue;
+
+    template <>
+    struct SRegisterValue<float>
+    {
+        static const uint8_t s_type = REG_FLOAT;
+    };
+
+    template <>
+    struct SRegisterValue<int32_t>
+    {
+        static const uint8_t s_type = REG_INT32;
+    };
+
+    template <>
+    struct SRegisterValue<uint32_t>
+    {
+        static const uint8_t s_type = REG_UINT32;
+    };
+
+    /** @brief  Raw word of a value */
+    template <class V>
+    uint32_t toWord(V f_value)
+    {
+        uint32_t l_word;
+        memcpy(&l_word, &f_value, sizeof(l_word));
+        return l_word;
+    }
+
+    /** @brief  Value of a raw word */
+    template <class V>
+    V fromWord(uint32_t f_word)
+    {
+        V l_value;
+        memcpy(&l_value, &f_word, sizeof(l_value));
+        return l_value;
+    }
+
+   /**
+    * @brief Interface of a block of registers on consecutive addresses, a single value or an array of values with the same type.
+    */
+    class IRegister
+    {
+    public:
+        /* Address of the first register */
+        virtual uint16_t getAddress() const = 0;
+        /* Number of the registers of the block */
+        virtual uint16_t getCount() const = 0;
+        /* Type of the values (ERegisterType) */
+        virtual uint8_t getType() const = 0;
+        /* The registers can be written */
+        virtual bool isWritable() const = 0;
+        /* Raw word of a register of the block */
+        virtual uint32_t read(uint16_t f_offset) = 0;
+        /* It returns true, when the raw word can be written in the register */
+        virtual bool check(uint16_t f_offset, uint32_t f_word) const = 0;
+        /* Write the raw word in a register of the block */
+        virtual void write(uint16_t f_offset, uint32_t f_word) = 0;
+    };
+
+   /**
+    * @brief Setter of the read-only registers, the write is rejected by the range check.
+    */
+    struct SReadOnly
+    {
+        template <class V>
+        void operator()(V) const {}
+    };
+
+   /**
+    * @brief Register of a single value with a getter and an optional setter.
+    * 
+    * The getter and the setter are applied from the thread of the serial monitor in a critical section, so they have to be short 
+    * (e.g. atomic access of a word). The written values are verified against the closed range before the setter is applied.
+    * 
+    * @tparam V              type of the value (float, int32_t, uint32_t)
+    * @tparam TGetter        any callable type without parameters and with return type convertible to V (function pointer, mbed::Callback)
+    * @tparam TSetter        any callable type with a V parameter, SReadOnly for the read-only registers
+    */
+    template <class V, class TGetter, class TSetter = SReadOnly>
+    class CRegister: public IRegister
+    {
+    public:
+        /* Constructor of a read-only register */
+        CRegister(uint16_t f_address, TGetter f_getter);
+        /* Constructor of a writable register */
+        CRegister(uint16_t f_address, TGetter f_getter, TSetter f_setter, V f_min, V f_max);
+        /** @brief  Address of the register */
+        virtual uint16_t getAddress() const
+        {
+            return m_address;
+        }
+        /** @brief  Single register */
+        virtual uint16_t getCount() const
+        {
+            return 1;
+        }
+        /** @brief  Type of the value */
+        virtual uint8_t getType() const
+        {
+            return SRegisterValue<V>::s_type;
+        }
+        /** @brief  The register has a setter */
+        virtual bool isWritable() const
+        {
+            return m_isWritable;
+        }
+        /* Raw word of the value */
+        virtual uint32_t read(uint16_t f_offset);
+        /* Verify the range of the written value */
+        virtual bool check(uint16_t f_offset, uint32_t f_word) const;
+        /* Apply the setter with the written value */
+        virtual void write(uint16_t f_offset, uint32_t f_word);
+    private:
+        /** @brief  Address of the register */
+        const uint16_t m_address;
+        /** @brief  The setter is given */
+        const bool m_isWritable;
+        /** @brief  Getter of the value */
+        TGetter m_getter;
+        /** @brief  Setter of the value */
+        TSetter m_setter;
+        /** @brief  Minimum of the written value */
+        const V m_min;
+        /** @brief  Maximum of the written value */
+        const V m_max;
+    };
+
+    /** @brief  Create a read-only register, the type of the getter is deduced. */
+    template <class V, class TGetter>
+    CRegister<V,TGetter> makeRegister(uint16_t f_address, TGetter f_getter)
+    {
+        return CRegister<V,TGetter>(f_address, f_getter);
+    }
+
+    /** @brief  Create a writable register with the range of the value, the types of the getter and the setter are deduced. */
+    template <class V, class TGetter, class TSetter>
+    CRegister<V,TGetter,TSetter> makeRegister(uint16_t f_address, TGetter f_getter, TSetter f_setter, V f_min, V f_max)
+    {
+        return CRegister<V,TGetter,TSetter>(f_address, f_getter, f_setter, f_min, f_max);
+    }
+
+   /**
+    * @brief Block of registers over an array of values owned by the user (e.g. the values of the configuration store).
+    * 
+    * @tparam V              type of the values (float, int32_t, uint32_t)
+    */
+    template <class V>
+    class CArrayRegisters: public IRegister
+    {
+    public:
+        /* Constructor */
+        CArrayRegisters(uint16_t f_address, V* f_values, uint16_t f_count, bool f_isWritable, V f_min, V f_max);
+        /** @brief  Address of the first value */
+        virtual uint16_t getAddress() const
+        {
+            return m_address;
+        }
+        /** @brief  Number of the values */
+        virtual uint16_t getCount() const
+        {
+            return m_count;
+        }
+        /** @brief  Type of the values */
+        virtual uint8_t getType() const
+        {
+            return SRegisterValue<V>::s_type;
+        }
+        /** @brief  The values can be written */
+        virtual bool isWritable() const
+        {
+            return m_isWritable;
+        }
+        /* Raw word of a value */
+        virtual uint32_t read(uint16_t f_offset);
+        /* Verify the range of the written value */
+        virtual bool check(uint16_t f_offset, uint32_t f_word) const;
+        /* Write a value of the array */
+        virtual void write(uint16_t f_offset, uint32_t f_word);
+    private:
+        /** @brief  Address of the first value */
+        const uint16_t m_address;
+        /** @brief  Values */
+        volatile V* m_values;
+        /** @brief  Number of the values */
+        const uint16_t m_count;
+        /** @brief  The values can be written */
+        const bool m_isWritable;
+        /** @brief  Minimum of the written values */
+        const V m_min;
+        /** @brief  Maximum of the written values */
+        const V m_max;
+    };
+
+   /**
+    * @brief Register table of the tunable parameters and the live signals.
+    * 
+    * Each value has a numeric address and a type, the blocks of registers are kept in a static list owned by the user, the table 
+    * sorts them once by address at construction, so a register is found by binary search. The host reads or writes a contiguous range 
+    * of addresses in one frame, so a dashboard polls dozens of values without per-value parsing. The range is read in a critical section, 
+    * so its values belong to the same control tick. The write is verified completely (address, access and range of each value) before 
+    * the first value is applied, then all values are applied in a critical section, so a rejected write doesn't change anything.
+    * 
+    * Binary messages: BIN_REGISTER_READ with SRegisterHeader, the values are sent in a BIN_REGISTER_DATA frame before the status response; 
+    * BIN_REGISTER_WRITE with SRegisterHeader followed by the values. The text command ('REGS' key):
+    *   - "0" : number of the registers, lowest and highest address
+    *   - "1;address;count" : values of the range, at most s_maxTextRegisters
+    *   - "2;address;value[;value...]" : write the values on consecutive addresses
+    *   - "3;address;count" : type (ERegisterType) and access (1 - writable) of each register of the range
+    */
+    class CRegisterTable
+    {
+    public:
+        /* Constructor */
+        CRegisterTable(IRegister**                           f_registers
+                      ,uint8_t                               f_count
+                      ,utils::serial::CSerialTransmitter&    f_serial);
+        /* Find the block of an address */
+        IRegister* find(uint16_t f_address, uint16_t& f_offset) const;
+        /* Read a range of registers */
+        uint8_t read(uint16_t f_address, uint8_t f_count, uint32_t* f_words) const;
+        /* Write a range of registers */
+        uint8_t write(uint16_t f_address, uint8_t f_count, const uint32_t* f_words, uint8_t& f_rejected);
+        /* Serial callback of the register access */
+        void serialCallback(char const * a, char * b);
+        /* Binary callback of the range read */
+        uint8_t binaryCallbackRead(const uint8_t* f_payload, uint8_t f_length);
+        /* Binary callback of the range write */
+        uint8_t binaryCallbackWrite(const uint8_t* f_payload, uint8_t f_length);
+        /** @brief  Number of the registers */
+        uint32_t size() const
+        {
+            return m_size;
+        }
+
+        /** @brief  Maximum number of the registers in a binary frame */
+        static const uint8_t s_maxRegisters = (utils::serial::CBinaryProtocol::s_maxPayloadSize - sizeof(utils::serial::SRegisterHeader)) / 4;
+        /** @brief  Maximum number of the registers in a text response */
+        static const uint8_t s_maxTextRegisters = 12;
+    private:
+        /* Read a range without critical section */
+        uint8_t readRange(uint16_t f_address, uint8_t f_count, uint32_t* f_words) const;
+        /* Format the values of a range */
+        void formatRange(char* f_response, uint16_t f_address, uint8_t f_count) const;
+        /* Format the types and the access of a range */
+        void describeRange(char* f_response, uint16_t f_address, uint8_t f_count) const;
+        /* Parse and write the values of a text command */
+        void writeText(char const * f_text, char * f_response);
+
+        /** @brief  Blocks of the registers, sorted by the addresses */
+        IRegister** m_registers;
+        /** @brief  Number of the blocks */
+        uint8_t m_count;
+        /** @brief  Number of the registers */
+        uint32_t m_size;
+        /** @brief  Serial transmitter of the data frames */
+        utils::serial::CSerialTransmitter& m_serial;
+    };
+
+}; // namespace utils::registers
+
+#include "registertable.tpp"
+
+#endif // REGISTER_TABLE_HPP
@@ -0,0 +1,160 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    RegisterTable.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the registers.
+  ******************************************************************************
+ */
+
+#ifndef REGISTER_TABLE_TPP
+#define REGISTER_TABLE_TPP
+
+#ifndef REGISTER_TABLE_HPP
+#error __FILE__ should only be included from registertable.hpp.
+#endif // REGISTER_TABLE_HPP
+
+namespace utils::registers{
+
+    /** \brief  CRegister class constructor of a read-only register
+     *
+     *  @param f_address       address of the register
+     *  @param f_getter        getter of the value
+     */
+    template <class V, class TGetter, class TSetter>
+    CRegister<V,TGetter,TSetter>::CRegister(uint16_t f_address, TGetter f_getter)
+        : m_address(f_address)
+        , m_isWritable(false)
+        , m_getter(f_getter)
+        , m_setter()
+        , m_min(0)
+        , m_max(0)
+    {
+    }
+
+    /** \brief  CRegister class constructor of a writable register
+     *
+     *  @param f_address       address of the register
+     *  @param f_getter        getter of the value
+     *  @param f_setter        setter of the value
+     *  @param f_min           minimum of the written value
+     *  @param f_max           maximum of the written value
+     */
+    template <class V, class TGetter, class TSetter>
+    CRegister<V,TGetter,TSetter>::CRegister(uint16_t f_address, TGetter f_getter, TSetter f_setter, V f_min, V f_max)
+        : m_address(f_address)
+        , m_isWritable(true)
+        , m_getter(f_getter)
+        , m_setter(f_setter)
+        , m_min(f_min)
+        , m_max(f_max)
+    {
+    }
+
+    /** \brief  Raw word of the value
+     *
+     *  @param f_offset        offset in the block, it's zero
+     *  @return                raw word
+     */
+    template <class V, class TGetter, class TSetter>
+    uint32_t CRegister<V,TGetter,TSetter>::read(uint16_t f_offset)
+    {
+        return toWord<V>(static_cast<V>(m_getter()));
+    }
+
+    /** \brief  Verify the access and the range of the written value, the not-a-number floats are rejected.
+     *
+     *  @param f_offset        offset in the block, it's zero
+     *  @param f_word          raw word of the value
+     *  @return                true, when the value can be written
+     */
+    template <class V, class TGetter, class TSetter>
+    bool CRegister<V,TGetter,TSetter>::check(uint16_t f_offset, uint32_t f_word) const
+    {
+        V l_value = fromWord<V>(f_word);
+        return m_isWritable && m_min <= l_value && l_value <= m_max;
+    }
+
+    /** \brief  Apply the setter with the written value
+     *
+     *  @param f_offset        offset in the block, it's zero
+     *  @param f_word          raw word of the value
+     */
+    template <class V, class TGetter, class TSetter>
+    void CRegister<V,TGetter,TSetter>::write(uint16_t f_offset, uint32_t f_word)
+    {
+        m_setter(fromWord<V>(f_word));
+    }
+
+    /** \brief  CArrayRegisters class constructor
+     *
+     *  @param f_address       address of the first value
+     *  @param f_values        values, the array is owned by the user
+     *  @param f_count         number of the values
+     *  @param f_isWritable    the values can be written
+     *  @param f_min           minimum of the written values
+     *  @param f_max           maximum of the written values
+     */
+    template <class V>
+    CArrayRegisters<V>::CArrayRegisters(uint16_t f_address, V* f_values, uint16_t f_count, bool f_isWritable, V f_min, V f_max)
+        : m_address(f_address)
+        , m_values(f_values)
+        , m_count(f_count)
+        , m_isWritable(f_isWritable)
+        , m_min(f_min)
+        , m_max(f_max)
+    {
+    }
+
+    /** \brief  Raw word of a value
+     *
+     *  @param f_offset        index of the value
+     *  @return                raw word
+     */
+    template <class V>
+    uint32_t CArrayRegisters<V>::read(uint16_t f_offset)
+    {
+        return toWord<V>(m_values[f_offset]);
+    }
+
+    /** \brief  Verify the access and the range of the written value, the not-a-number floats are rejected.
+     *
+     *  @param f_offset        index of the value
+     *  @param f_word          raw word of the value
+     *  @return                true, when the value can be written
+     */
+    template <class V>
+    bool CArrayRegisters<V>::check(uint16_t f_offset, uint32_t f_word) const
+    {
+        V l_value = fromWord<V>(f_word);
+        return m_isWritable && m_min <= l_value && l_value <= m_max;
+    }
+
+    /** \brief  Write a value of the array
+     *
+     *  @param f_offset        index of the value
+     *  @param f_word          raw word of the value
+     */
+    template <class V>
+    void CArrayRegisters<V>::write(uint16_t f_offset, uint32_t f_word)
+    {
+        m_values[f_offset] = fromWord<V>(f_word);
+    }
+
+}; // namespace utils::registers
+
+#endif // REGISTER_TABLE_TPP
@@ -0,0 +1,103 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    BaudNegotiator.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the baud rate negotiation 
+  *          of the serial links.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef BAUD_NEGOTIATOR_HPP
+#define BAUD_NEGOTIATOR_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialmonitor.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+
+namespace utils::serial{
+
+   /**
+    * @brief Negotiation of a faster baud rate on a running serial link, the monitor, the transmitter and the subscribers aren't changed.
+    * 
+    * The link starts with the default rate. The host requests a new rate, the response is sent with the old rate, then the rate 
+    * is changed by the attached setter (for example hardware::drivers::CUartBaudRate). The host has to send a valid frame with the 
+    * new rate in s_confirmTimeout, otherwise the previous rate is restored, so a rate, which isn't supported by the host adapter, 
+    * doesn't lose the link. The result is reported by '@BAUD:confirmed;rate;;' or '@BAUD:reverted;rate;;'.
+    * 
+    * Commands of the 'BAUD' key: '0' state ('rate;maximum;negotiating'), '1;rate' request of a new rate.
+    */
+    class CBaudNegotiator: public utils::task::CTask
+    {
+    public:
+        /** @brief  Setter of the baud rate, it returns false, when the rate can't be realized */
+        typedef mbed::Callback<bool(uint32_t)> FBaudSetter;
+        /* Constructor */
+        CBaudNegotiator(CSerialMonitor& f_monitor, CSerialTransmitter& f_serial, FBaudSetter f_setter, uint32_t f_baud, uint32_t f_maxBaud, uint32_t f_pollPeriod);
+        /** @brief  Current baud rate */
+        uint32_t getBaud() const
+        {
+            return m_baud;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Time to confirm the new rate in microsecond */
+        static const uint32_t s_confirmTimeout = 2000000;
+        /** @brief  Minimum baud rate */
+        static const uint32_t s_minBaud = 9600;
+    private:
+        /** @brief  States of the negotiation */
+        enum EState
+        {
+            IDLE,                                                       /**< the rate is confirmed */
+            SWITCHING,                                                  /**< the response is sent with the old rate */
+            CONFIRMING                                                  /**< the rate is changed, it waits for a frame of the host */
+        };
+        /* Run method, it changes and confirms the rate */
+        virtual void _run();
+        /* Finish the negotiation and report the result */
+        void finish(const char* f_result);
+
+        /** @brief  Monitor of the link, its frame counter confirms the rate */
+        CSerialMonitor& m_monitor;
+        /** @brief  Transmitter of the link */
+        CSerialTransmitter& m_serial;
+        /** @brief  Setter of the baud rate */
+        FBaudSetter m_setter;
+        /** @brief  Current baud rate */
+        uint32_t m_baud;
+        /** @brief  Baud rate before the change */
+        uint32_t m_previous;
+        /** @brief  Requested baud rate */
+        uint32_t m_requested;
+        /** @brief  Maximum baud rate of the link */
+        const uint32_t m_maxBaud;
+        /** @brief  Period of the task during the negotiation in base ticks */
+        const uint32_t m_pollPeriod;
+        /** @brief  State of the negotiation */
+        volatile EState m_state;
+        /** @brief  Number of the frames at the change */
+        uint32_t m_frames;
+        /** @brief  Time of the change in microsecond */
+        uint32_t m_switchTime;
+    };
+
+}; // namespace utils::serial
+
+#endif // BAUD_NEGOTIATOR_HPP
@@ -0,0 +1,152 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    BinaryProtocol.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the declaration of the binary framed protocol.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef BINARY_PROTOCOL_HPP
+#define BINARY_PROTOCOL_HPP
+
+#include <mbed.h>
+#include <string.h>
+/* Identifiers and payloads of the messages, generated from protocol/protocol.json */
+#include <utils/serial/protocolmessages.hpp>
+
+namespace utils::serial{
+
+   /**
+    * @brief Binary framed protocol
+    * 
+    * Frame structure: sync byte (0xA5), message identifier, payload length, payload (packed little-endian), CRC16-CCITT (little-endian) 
+    * computed over the identifier, the length and the payload. 
+    * 
+    * When the stamping of the board clock is enabled (utils::clock::CBoardClock), the encoded frames carry the 32-bit board time 
+    * in microsecond after the payload, it's counted in the length and the identifier is marked by s_stampFlag.
+    * 
+    * In the COBS framing the frame without the sync byte is stuffed by Consistent Overhead Byte Stuffing, so it doesn't contain 
+    * zero bytes, and it's delimited by a zero byte at both sides: 0x00, COBS(identifier, length, payload, CRC), 0x00. The receiver 
+    * resynchronizes at the next delimiter, a corrupted frame is dropped after reading it once, a corrupted length can't make the 
+    * receiver wait for a long frame. The received frames are accepted in both framings, the responses have the framing of the 
+    * request, the published frames have the selected framing ('COBS' key).
+    */
+    class CBinaryProtocol
+    {
+    public:
+        /** @brief  Framing of the encoded frames */
+        enum EFraming{
+            /** @brief frame started by the sync byte and delimited by its length */
+            FRAMING_SYNC = 0,
+            /** @brief COBS stuffed frame delimited by zero bytes */
+            FRAMING_COBS = 1
+        };
+
+        /** @brief  Callback of a binary message, it receives the payload and returns the status code of the response. */
+        typedef mbed::Callback<uint8_t(const uint8_t*, uint8_t)> FBinaryCallback;
+
+        /* Compute the CRC16-CCITT checksum */
+        static uint16_t crc16(const uint8_t* f_data, uint32_t f_length, uint16_t f_crc = 0xFFFF);
+        /* Encode a frame in the selected framing */
+        static uint32_t encode(uint8_t f_id, const void* f_payload, uint8_t f_length, uint8_t* f_frame);
+        /* Encode a frame in the given framing */
+        static uint32_t encode(uint8_t f_id, const void* f_payload, uint8_t f_length, uint8_t* f_frame, EFraming f_framing);
+        /* Stuff the bytes by COBS */
+        static uint32_t cobsEncode(const uint8_t* f_data, uint32_t f_length, uint8_t* f_dest);
+        /* Restore the COBS stuffed bytes */
+        static uint32_t cobsDecode(const uint8_t* f_data, uint32_t f_length, uint8_t* f_dest);
+        /* Serial callback of the framing of the published frames */
+        static void serialCallbackFraming(char const * a, char * b);
+        /** @brief  Select the framing of the published frames */
+        static void setFraming(EFraming f_framing)
+        {
+            s_framing = f_framing;
+        }
+        /** @brief  Framing of the published frames */
+        static EFraming getFraming()
+        {
+            return s_framing;
+        }
+        /* Adapter between the raw callback and a method with typed payload */
+        template<class T, class TPayload, uint8_t (T::*Method)(const TPayload&)>
+        static uint8_t typedCallback(T* f_obj, const uint8_t* f_payload, uint8_t f_length);
+        /** @brief  Create a raw callback from a method with typed payload. */
+        template<class T, class TPayload, uint8_t (T::*Method)(const TPayload&)>
+        static FBinaryCallback bind(T* f_obj)
+        {
+            return FBinaryCallback(&CBinaryProtocol::typedCallback<T,TPayload,Method>, f_obj);
+        }
+
+        /** @brief  Synchronization byte */
+        static const uint8_t s_sync = 0xA5;
+        /** @brief  Size of the header (sync, identifier, length) */
+        static const uint32_t s_headerSize = 3;
+        /** @brief  Size of the checksum */
+        static const uint32_t s_crcSize = 2;
+        /** @brief  Maximum size of the payload, the longest frame fits in the 256 byte buffer of the serial monitor. */
+        static const uint32_t s_maxPayloadSize = 250;
+        /** @brief  Size of the optional timestamp */
+        static const uint32_t s_stampSize = 4;
+        /** @brief  Delimiter of the COBS frames */
+        static const uint8_t s_delimiter = 0x00;
+        /** @brief  Maximum size of a frame in the sync framing */
+        static const uint32_t s_maxSyncFrameSize = s_headerSize + s_maxPayloadSize + s_stampSize + s_crcSize;
+        /** @brief  Maximum size of a frame in both framing, the COBS frame loses the sync byte, but it has a code byte in each 254 bytes and two delimiters */
+        static const uint32_t s_maxFrameSize = s_maxSyncFrameSize + (s_maxSyncFrameSize - 1) / 254 + 2;
+        /** @brief  Flag of the response identifiers */
+        static const uint8_t s_responseFlag = 0x80;
+        /** @brief  Flag of the identifiers of the frames with timestamp */
+        static const uint8_t s_stampFlag = 0x20;
+    private:
+        /** @brief  Framing of the published frames */
+        static volatile EFraming s_framing;
+    };
+
+    /** @brief  Adapter between the raw callback and a method with typed payload.
+     *
+     *  It verifies the length of the payload, it copies the payload in the structure and it verifies the ranges of the fields 
+     *  given by the protocol definition (SPayloadTraits), so the binary command is validated like its text pair.
+     *
+     *  @param f_obj           object of the method
+     *  @param f_payload       received payload
+     *  @param f_length        length of the payload
+     *  @return                status code of the response
+     */
+    template<class T, class TPayload, uint8_t (T::*Method)(const TPayload&)>
+    uint8_t CBinaryProtocol::typedCallback(T* f_obj, const uint8_t* f_payload, uint8_t f_length)
+    {
+        if (f_length != sizeof(TPayload))
+        {
+            return BIN_SYNTAX_ERROR;
+        }
+        TPayload l_payload;
+        memcpy(&l_payload, f_payload, sizeof(TPayload));
+        uint8_t l_field;
+        uint8_t l_status = SPayloadTraits<TPayload>::validate(l_payload, l_field);
+        if (l_status != BIN_ACK)
+        {
+            return l_status;
+        }
+        return (f_obj->*Method)(l_payload);
+    }
+
+}; // namespace utils::serial
+
+#endif // BINARY_PROTOCOL_HPP
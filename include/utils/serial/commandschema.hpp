@@ -0,0 +1,103 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    CommandSchema.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the parsing and the 
+  *          validation of the text commands.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef COMMAND_SCHEMA_HPP
+#define COMMAND_SCHEMA_HPP
+
+#include <mbed.h>
+#include <utils/serial/binaryprotocol.hpp>
+
+namespace utils::serial{
+
+    /** @brief  Types of the fields of a text command */
+    enum EFieldType{
+        FIELD_FLOAT,                                                    /**< decimal number with optional fraction and exponent */
+        FIELD_INT,                                                      /**< signed 32-bit integer */
+        FIELD_UINT                                                      /**< unsigned 32-bit integer */
+    };
+
+    /** @brief  Description of a field: type, closed range and unit */
+    struct SField{
+        /** @brief  type of the field */
+        EFieldType m_type;
+        /** @brief  minimum value */
+        float m_min;
+        /** @brief  maximum value */
+        float m_max;
+        /** @brief  unit of the value, it's only documentation */
+        const char* m_unit;
+    };
+
+    /** @brief  Parsed value of a field */
+    union UFieldValue{
+        /** @brief  value of the float field */
+        float m_float;
+        /** @brief  value of the signed integer field */
+        int32_t m_int;
+        /** @brief  value of the unsigned integer field */
+        uint32_t m_uint;
+    };
+
+   /**
+    * @brief Declarative schema of a text command, the fields are parsed and validated in a single pass without sscanf.
+    * 
+    * The schema is a static array of the fields (type, range, unit), the content of the frame has to contain the fields separated 
+    * by ';' and it's ended by the ";;" of the frame. A malformed field is rejected at its first invalid character, the number, which 
+    * is out of the range of its field, is rejected before the callback applies it. The response of the rejected commands is the 
+    * compact 'err;status;field;;', the status is the code of the binary responses (EBinaryStatus) and the field is the one-based index 
+    * of the rejected field (zero, when the rejection isn't caused by a field), the accepted commands get 'ack;;'.
+    */
+    class CCommandSchema
+    {
+    public:
+        /* Constructor */
+        CCommandSchema(const SField* f_fields, uint8_t f_count);
+        /** @brief  Constructor from an array of fields */
+        template<uint8_t N>
+        CCommandSchema(const SField (&f_fields)[N])
+            : CCommandSchema(f_fields, N)
+        {
+        }
+        /* Parse and validate the content of a command */
+        uint8_t parse(const char* f_text, UFieldValue* f_values, uint8_t& f_field) const;
+        /* Parse the content and write the response of the rejected command */
+        bool parse(const char* f_text, UFieldValue* f_values, char* f_response) const;
+        /* Write the response of the status code */
+        static void respond(char* f_response, uint8_t f_status, uint8_t f_field = 0);
+        /** @brief  Number of the fields */
+        uint8_t size() const
+        {
+            return m_count;
+        }
+    private:
+        /** @brief  Fields of the command */
+        const SField* m_fields;
+        /** @brief  Number of the fields */
+        const uint8_t m_count;
+    };
+
+}; // namespace utils::serial
+
+#endif // COMMAND_SCHEMA_HPP
@@ -0,0 +1,107 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    DispatchTable.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the command dispatch table.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef DISPATCH_TABLE_HPP
+#define DISPATCH_TABLE_HPP
+
+#include <mbed.h>
+
+namespace utils::serial{
+
+    /** @brief  Dispatch policy of a key */
+    enum EDispatchPolicy
+    {
+        POLICY_ORDERED = 0,                                             /**< each frame is applied in the order of the reception */
+        POLICY_LATEST = 1                                               /**< only the newest pending frame is applied, the older ones are superseded */
+    };
+
+   /**
+    * @brief Dispatch table of the commands keyed by an integer identifier. 
+    * 
+    * The entries are kept in a statically allocated array owned by the user, the table sorts them once at construction and 
+    * it finds the callbacks by binary search, so the lookup is a few integer comparisons without heap allocation. 
+    * Copying the table doesn't copy the entries. The text keys of four characters are packed in an integer by the 'key' function.
+    * The policy of an entry tells the dispatcher, whether the pending frames of the key can be coalesced (POLICY_LATEST for the 
+    * idempotent setpoints), the omitted policy is POLICY_ORDERED.
+    * 
+    * @tparam TCallback      type of the callback functions
+    */
+    template<class TCallback>
+    class CDispatchTable
+    {
+    public:
+        /** @brief  Entry of the table */
+        struct SEntry{
+            /** @brief  identifier of the command */
+            uint32_t m_key;
+            /** @brief  callback function */
+            TCallback m_callback;
+            /** @brief  dispatch policy */
+            EDispatchPolicy m_policy;
+        };
+
+        /* Constructor of an empty table */
+        CDispatchTable();
+        /* Constructor */
+        CDispatchTable(SEntry* f_entries, uint32_t f_count);
+        /** @brief  Constructor from an array of entries */
+        template<uint32_t N>
+        CDispatchTable(SEntry (&f_entries)[N])
+            : CDispatchTable(f_entries, N)
+        {
+        }
+        /* Find the entry of a key */
+        const SEntry* findEntry(uint32_t f_key) const;
+        /** @brief  Find the callback of a key, NULL, when the key isn't in the table */
+        const TCallback* find(uint32_t f_key) const
+        {
+            const SEntry* l_entry = findEntry(f_key);
+            return (l_entry != NULL) ? &l_entry->m_callback : NULL;
+        }
+        /** @brief  Number of entries */
+        uint32_t size() const
+        {
+            return m_count;
+        }
+        /** @brief  Pack a key of four characters in an integer, the first character is the lowest byte. */
+        static constexpr uint32_t key(const char* f_id)
+        {
+            return static_cast<uint32_t>(static_cast<uint8_t>(f_id[0]))
+                | (static_cast<uint32_t>(static_cast<uint8_t>(f_id[1])) << 8)
+                | (static_cast<uint32_t>(static_cast<uint8_t>(f_id[2])) << 16)
+                | (static_cast<uint32_t>(static_cast<uint8_t>(f_id[3])) << 24);
+        }
+    private:
+        /** @brief  Entries of the table, sorted by the keys */
+        SEntry* m_entries;
+        /** @brief  Number of entries */
+        uint32_t m_count;
+    };
+
+}; // namespace utils::serial
+
+#include "dispatchtable.tpp"
+
+#endif // DISPATCH_TABLE_HPP
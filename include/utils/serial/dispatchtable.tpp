@@ -0,0 +1,100 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    DispatchTable.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the command dispatch table.
+  ******************************************************************************
+ */
+
+#ifndef DISPATCH_TABLE_TPP
+#define DISPATCH_TABLE_TPP
+
+#ifndef DISPATCH_TABLE_HPP
+#error __FILE__ should only be included from dispatchtable.hpp.
+#endif // DISPATCH_TABLE_HPP
+
+namespace utils::serial{
+
+    /** \brief  Constructor of an empty table
+     *
+     */
+    template<class TCallback>
+    CDispatchTable<TCallback>::CDispatchTable()
+        : m_entries(NULL)
+        , m_count(0)
+    {
+    }
+
+    /** \brief  Constructor
+     *
+     *  It sorts the entries by their keys (insertion sort, the tables are small and they are sorted only once).
+     *
+     *  @param f_entries       array of the entries
+     *  @param f_count         number of the entries
+     */
+    template<class TCallback>
+    CDispatchTable<TCallback>::CDispatchTable(SEntry* f_entries, uint32_t f_count)
+        : m_entries(f_entries)
+        , m_count(f_count)
+    {
+        for (uint32_t i = 1; i < m_count; i++)
+        {
+            SEntry l_entry = m_entries[i];
+            uint32_t j = i;
+            while (j > 0 && m_entries[j - 1].m_key > l_entry.m_key)
+            {
+                m_entries[j] = m_entries[j - 1];
+                j--;
+            }
+            m_entries[j] = l_entry;
+        }
+    }
+
+    /** \brief  Find the entry of a key by binary search
+     *
+     *  @param f_key           identifier of the command
+     *  @return                pointer to the entry, NULL, when the key isn't in the table
+     */
+    template<class TCallback>
+    const typename CDispatchTable<TCallback>::SEntry* CDispatchTable<TCallback>::findEntry(uint32_t f_key) const
+    {
+        uint32_t l_low = 0;
+        uint32_t l_high = m_count;
+        while (l_low < l_high)
+        {
+            uint32_t l_mid = (l_low + l_high) / 2;
+            if (m_entries[l_mid].m_key < f_key)
+            {
+                l_low = l_mid + 1;
+            }
+            else
+            {
+                l_high = l_mid;
+            }
+        }
+        if (l_low < m_count && m_entries[l_low].m_key == f_key)
+        {
+            return &m_entries[l_low];
+        }
+        return NULL;
+    }
+
+}; // namespace utils::serial
+
+#endif // DISPATCH_TABLE_TPP
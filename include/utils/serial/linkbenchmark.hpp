@@ -0,0 +1,93 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    LinkBenchmark.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the latency and throughput 
+  *          benchmark of the serial link.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef LINK_BENCHMARK_HPP
+#define LINK_BENCHMARK_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/serial/serialmonitor.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+
+namespace utils::serial{
+
+   /**
+    * @brief Loopback benchmark of the serial link, it measures the latency of a command from the receive interrupt to the actuation 
+    * and the sustained command rate (benchmarks/linkbench.py on the host).
+    * 
+    * The echo response contains the board times of the receive interrupt, of the end of the parsing (CSerialMonitor), of the 
+    * dispatch and of the response. The echo with actuation is also stamped by the first control tick after the dispatch, the stage 
+    * follows the state machine in the pipeline, so the time is after the write of the new duty cycle (it's applied by the PWM timer 
+    * at its next update event). The flood frames aren't answered, the benchmark counts them and the gaps of their sequence numbers, 
+    * the dropped bytes of the monitor show, where the frames were lost.
+    * 
+    * Commands of the 'BNCH' key: '0' statistics ('frames;invalid;rxDropped;parseDropped;flood;lost;frames/s'), '1;seq' echo 
+    * ('ack;;seq;rx;parse;dispatch;response;'), '2;seq' echo with actuation (followed by '@BNCH:act;seq;time;;'), '3;seq' flood frame 
+    * without response, '4' reset of the flood counters, '5' link errors ('rxHigh;parseHigh;overruns;framing;noise;overflows;lost;
+    * throttled;flow;superseded;estops'), '6;mode' flow control of the received stream (0 none, 1 RTS, 2 XON/XOFF).
+    */
+    class CLinkBenchmark: public utils::task::CTask, public utils::pipeline::IPipelineStage
+    {
+    public:
+        /* Constructor */
+        CLinkBenchmark(CSerialMonitor& f_monitor, CSerialTransmitter& f_serial);
+        /* Pipeline stage, it stamps the pending actuation */
+        virtual void process(uint32_t f_timestamp);
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, it sends the stamped actuation */
+        virtual void _run();
+        /* Count a flood frame */
+        void flood(uint32_t f_sequence);
+
+        /** @brief  Monitor of the benchmarked link */
+        CSerialMonitor& m_monitor;
+        /** @brief  Serial transmitter of the actuation message */
+        CSerialTransmitter& m_serial;
+        /** @brief  Sequence number of the echo with actuation */
+        uint32_t m_actuationSequence;
+        /** @brief  Time of the actuation */
+        volatile uint32_t m_actuationTime;
+        /** @brief  The actuation waits for the next control tick */
+        volatile bool m_isActuationPending;
+        /** @brief  The actuation was stamped, it waits for the transmission */
+        volatile bool m_isActuationReady;
+        /** @brief  Number of the flood frames */
+        uint32_t m_floodCount;
+        /** @brief  Number of the missing sequence numbers */
+        uint32_t m_floodLost;
+        /** @brief  Expected next sequence number */
+        uint32_t m_floodNext;
+        /** @brief  Receive time of the first flood frame */
+        uint32_t m_floodFirst;
+        /** @brief  Receive time of the last flood frame */
+        uint32_t m_floodLast;
+    };
+
+}; // namespace utils::serial
+
+#endif // LINK_BENCHMARK_HPP
@@ -0,0 +1,582 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    ProtocolMessages.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the identifiers, the status codes and the payloads of the binary protocol.
+  *          It's generated by protocolGenerator.py from protocol/protocol.json, don't edit it.
+  ******************************************************************************
+ */
+
+
+/* Inclusion guard */
+#ifndef PROTOCOL_MESSAGES_HPP
+#define PROTOCOL_MESSAGES_HPP
+
+#include <stdint.h>
+
+namespace utils::serial{
+
+    /** @brief Identifiers of the binary messages. The responses have the same identifier with the highest bit set. */
+    enum EBinaryMessageId{
+        /** @brief Move command (SMovePayload), pair of the 'MCTL' key */
+        BIN_MOVE                = 0x01,
+        /** @brief Brake command (SBrakePayload), pair of the 'BRAK' key */
+        BIN_BRAKE               = 0x02,
+        /** @brief Pid activation command (SActivationPayload), pair of the 'PIDA' key */
+        BIN_PID_ACTIVATION      = 0x03,
+        /** @brief Encoder publisher activation command (SActivationPayload), pair of the 'ENPB' key */
+        BIN_ENCODER_PUBLISH     = 0x04,
+        /** @brief Telemetry subscription command (STelemetrySubscribePayload), pair of the 'TELS' and 'TELA' keys */
+        BIN_TELEMETRY_SUBSCRIBE = 0x05,
+        /** @brief Odometry publisher activation command (SActivationPayload), pair of the 'ODOM' key */
+        BIN_ODOMETRY_PUBLISH    = 0x06,
+        /** @brief Publisher group subscription command (SPublisherSubscribePayload), pair of the 'PUBS' key */
+        BIN_PUBLISHER_SUBSCRIBE = 0x07,
+        /** @brief Read of a register range (SRegisterHeader), the values are sent in a BIN_REGISTER_DATA frame before the response */
+        BIN_REGISTER_READ       = 0x08,
+        /** @brief Write of a register range (SRegisterHeader followed by the 32-bit values) */
+        BIN_REGISTER_WRITE      = 0x09,
+        /** @brief Start of a firmware update, the staging sector is erased */
+        BIN_UPDATE_BEGIN        = 0x0A,
+        /** @brief Block of the firmware image (SUpdateBlockHeader followed by the LZ4 compressed block) */
+        BIN_UPDATE_BLOCK        = 0x0B,
+        /** @brief End of the firmware update, the staged image is verified and optionally installed */
+        BIN_UPDATE_END          = 0x0C,
+        /** @brief Emergency stop without payload, the frame with sync byte is recognized by the receive interrupt and the motor is braked immediately */
+        BIN_EMERGENCY_STOP      = 0x0D,
+        /** @brief Published encoder speed (SEncoderSpeedPayload) */
+        BIN_ENCODER_SPEED       = 0x40,
+        /** @brief Published telemetry batch (STelemetryHeader followed by the samples) */
+        BIN_TELEMETRY           = 0x41,
+        /** @brief Published odometry pose (SOdometryPayload) */
+        BIN_ODOMETRY            = 0x42,
+        /** @brief Published values of the publisher group (timestamp followed by index, length and bytes of each value) */
+        BIN_PUBLISH             = 0x43,
+        /** @brief Dumped records of the flight recorder (SFlightRecordHeader followed by the records) */
+        BIN_FLIGHT_RECORD       = 0x44,
+        /** @brief Dumped histogram of the sampling profiler (SProfileHeader followed by the counters of the buckets) */
+        BIN_PROFILE             = 0x45,
+        /** @brief Values of a register range (SRegisterHeader followed by the 32-bit values) */
+        BIN_REGISTER_DATA       = 0x46,
+        /** @brief Published telemetry batch with delta encoded signals (STelemetryHeader, encoding code of each signal, encoded samples) */
+        BIN_TELEMETRY_PACKED    = 0x47,
+        /** @brief Dumped entries of the command recorder (SCommandRecordHeader followed by the entries) */
+        BIN_COMMAND_RECORD      = 0x48,
+        /** @brief Dumped frames of the signal scope (SScopeHeader followed by the int16_t samples of the channels) */
+        BIN_SCOPE_CAPTURE       = 0x49,
+        /** @brief Batch of the logged events (SEventLogHeader followed by the records, each SEventRecord followed by its raw arguments) */
+        BIN_EVENT_LOG           = 0x4A
+    };
+
+    /** @brief Status codes of the binary responses */
+    enum EBinaryStatus{
+        /** @brief The command was accepted */
+        BIN_ACK             = 0,
+        /** @brief The payload has wrong length or content */
+        BIN_SYNTAX_ERROR    = 1,
+        /** @brief The speed command is out of range */
+        BIN_SPEED_RANGE     = 2,
+        /** @brief The speed reference is out of range */
+        BIN_REFERENCE_RANGE = 3,
+        /** @brief The steering angle is out of range */
+        BIN_ANGLE_RANGE     = 4,
+        /** @brief The functionality isn't available */
+        BIN_NOT_AVAILABLE   = 5,
+        /** @brief A field is out of the range of the command schema */
+        BIN_VALUE_RANGE     = 6,
+        /** @brief The queue of the commands is full */
+        BIN_QUEUE_FULL      = 7,
+        /** @brief The firmware update failed, the staged image is erased, programmed or verified with error */
+        BIN_UPDATE_FAILED   = 8,
+        /** @brief The command was superseded by a newer command of the same identifier before its dispatch, it wasn't applied */
+        BIN_SUPERSEDED      = 9
+    };
+
+    /** @brief Payload of the move command */
+    struct SMovePayload{
+        /** @brief speed in ratio of pwm or reference speed in meter per second, range [-100, 100] m/s or % */
+        float m_speed;
+        /** @brief steering angle in degree, range [-90, 90] deg */
+        float m_angle;
+    } __attribute__((packed));
+    static_assert(sizeof(SMovePayload) == 8, "The layout of SMovePayload differs from the protocol definition.");
+
+    /** @brief Payload of the brake command */
+    struct SBrakePayload{
+        /** @brief steering angle in degree, range [-90, 90] deg */
+        float m_angle;
+    } __attribute__((packed));
+    static_assert(sizeof(SBrakePayload) == 4, "The layout of SBrakePayload differs from the protocol definition.");
+
+    /** @brief Payload of the activation commands */
+    struct SActivationPayload{
+        /** @brief non zero value activates the functionality */
+        uint8_t m_activate;
+    } __attribute__((packed));
+    static_assert(sizeof(SActivationPayload) == 1, "The layout of SActivationPayload differs from the protocol definition.");
+
+    /** @brief Payload of the published encoder speed */
+    struct SEncoderSpeedPayload{
+        /** @brief rotation speed in rotation per second */
+        float m_rps;
+    } __attribute__((packed));
+    static_assert(sizeof(SEncoderSpeedPayload) == 4, "The layout of SEncoderSpeedPayload differs from the protocol definition.");
+
+    /** @brief Payload of the published odometry pose */
+    struct SOdometryPayload{
+        /** @brief timestamp of the integration in microsecond */
+        uint32_t m_timestamp;
+        /** @brief position in meter */
+        float m_x;
+        /** @brief position in meter */
+        float m_y;
+        /** @brief orientation in radian */
+        float m_yaw;
+        /** @brief longitudinal speed in meter per second */
+        float m_speed;
+    } __attribute__((packed));
+    static_assert(sizeof(SOdometryPayload) == 20, "The layout of SOdometryPayload differs from the protocol definition.");
+
+    /** @brief Payload of the publisher group subscription command */
+    struct SPublisherSubscribePayload{
+        /** @brief mask of the published values, zero stops the publishing */
+        uint32_t m_mask;
+    } __attribute__((packed));
+    static_assert(sizeof(SPublisherSubscribePayload) == 4, "The layout of SPublisherSubscribePayload differs from the protocol definition.");
+
+    /** @brief Header of the register range, in the write and data frames it's followed by 'm_count' 32-bit little-endian values */
+    struct SRegisterHeader{
+        /** @brief address of the first register */
+        uint16_t m_address;
+        /** @brief number of the registers */
+        uint8_t m_count;
+    } __attribute__((packed));
+    static_assert(sizeof(SRegisterHeader) == 3, "The layout of SRegisterHeader differs from the protocol definition.");
+
+    /** @brief Payload of the telemetry subscription command */
+    struct STelemetrySubscribePayload{
+        /** @brief mask of the subscribed signals, zero stops the publishing */
+        uint8_t m_signalMask;
+        /** @brief decimation factor, a sample is published after each 'm_decimation' sampling */
+        uint16_t m_decimation;
+        /** @brief aggregation modes over the decimation window (utils::telemetry::EAggregation), two bits for each signal */
+        uint16_t m_aggregation;
+    } __attribute__((packed));
+    static_assert(sizeof(STelemetrySubscribePayload) == 5, "The layout of STelemetrySubscribePayload differs from the protocol definition.");
+
+    /** @brief Header of the telemetry batch, it's followed by 'm_sampleCount' samples, each sample contains 'm_signalCount' float values. In the BIN_TELEMETRY_PACKED batch the header is followed by an encoding code of each signal (mode in the upper, decimals in the lower nibble), then by the samples, where the delta encoded values are zigzag varints. */
+    struct STelemetryHeader{
+        /** @brief sequence number of the batch, a gap shows lost batches */
+        uint16_t m_sequence;
+        /** @brief timestamp of the first sample in microsecond */
+        uint32_t m_timestamp;
+        /** @brief mean interval between the samples in microsecond */
+        uint16_t m_interval;
+        /** @brief number of the signals in each sample */
+        uint8_t m_signalCount;
+        /** @brief mask of the signals in each sample, the values follow the order of the signal indexes */
+        uint8_t m_signalMask;
+        /** @brief number of the samples */
+        uint8_t m_sampleCount;
+    } __attribute__((packed));
+    static_assert(sizeof(STelemetryHeader) == 11, "The layout of STelemetryHeader differs from the protocol definition.");
+
+    /** @brief Record of the flight recorder, the values of one control tick in fixed point */
+    struct SFlightRecord{
+        /** @brief timestamp of the tick in microsecond */
+        uint32_t m_timestamp;
+        /** @brief speed reference in 0.01 rotation per second */
+        int16_t m_reference;
+        /** @brief measured speed in 0.01 rotation per second */
+        int16_t m_speed;
+        /** @brief error of the speed controller in 0.01 rotation per second */
+        int16_t m_error;
+        /** @brief pwm command in 0.0001 ratio */
+        int16_t m_pwm;
+        /** @brief steering angle in 0.01 degree */
+        int16_t m_steering;
+        /** @brief state of the robot state machine */
+        uint8_t m_state;
+        /** @brief status flags of the tick */
+        uint8_t m_flags;
+    } __attribute__((packed));
+    static_assert(sizeof(SFlightRecord) == 16, "The layout of SFlightRecord differs from the protocol definition.");
+
+    /** @brief Header of the dumped records, it's followed by 'm_count' records in time order. */
+    struct SFlightRecordHeader{
+        /** @brief index of the first record in the frame, zero is the oldest record */
+        uint16_t m_first;
+        /** @brief number of the frozen records */
+        uint16_t m_total;
+        /** @brief trigger of the freezing */
+        uint8_t m_trigger;
+        /** @brief number of the records in the frame */
+        uint8_t m_count;
+    } __attribute__((packed));
+    static_assert(sizeof(SFlightRecordHeader) == 6, "The layout of SFlightRecordHeader differs from the protocol definition.");
+
+    /** @brief Header of an entry of the command recorder, it's followed by 'm_length' bytes of the frame: the text frame from '#' without '\n', or the identifier, the length and the payload of a binary frame. */
+    struct SCommandEntry{
+        /** @brief arrival time of the frame in microsecond */
+        uint32_t m_timestamp;
+        /** @brief kind of the frame (0 - text, 1 - binary with sync byte, 2 - binary in COBS framing) */
+        uint8_t m_kind;
+        /** @brief number of the bytes of the frame */
+        uint8_t m_length;
+    } __attribute__((packed));
+    static_assert(sizeof(SCommandEntry) == 6, "The layout of SCommandEntry differs from the protocol definition.");
+
+    /** @brief Header of the dumped command entries, it's followed by 'm_count' entries (SCommandEntry and its bytes) in time order. */
+    struct SCommandRecordHeader{
+        /** @brief index of the first entry in the frame */
+        uint16_t m_first;
+        /** @brief number of the recorded entries */
+        uint16_t m_total;
+        /** @brief number of the entries in the frame */
+        uint8_t m_count;
+    } __attribute__((packed));
+    static_assert(sizeof(SCommandRecordHeader) == 5, "The layout of SCommandRecordHeader differs from the protocol definition.");
+
+    /** @brief Header of the dumped scope capture, it's followed by 'm_count' frames in time order, each frame contains 'm_channels' int16_t samples. */
+    struct SScopeHeader{
+        /** @brief index of the first frame in the message, zero is the oldest frame */
+        uint16_t m_first;
+        /** @brief number of the captured frames */
+        uint16_t m_total;
+        /** @brief index of the trigger frame */
+        uint16_t m_trigger;
+        /** @brief sampling frequency in Hz */
+        uint32_t m_frequency;
+        /** @brief cause of the trigger */
+        uint8_t m_cause;
+        /** @brief mask of the captured channels */
+        uint8_t m_channels;
+        /** @brief number of the frames in the message */
+        uint8_t m_count;
+    } __attribute__((packed));
+    static_assert(sizeof(SScopeHeader) == 13, "The layout of SScopeHeader differs from the protocol definition.");
+
+    /** @brief Header of the dumped profile, it's followed by 'm_count' counters (uint32_t) of the consecutive buckets. */
+    struct SProfileHeader{
+        /** @brief start address of the first bucket of the histogram */
+        uint32_t m_base;
+        /** @brief number of the samples */
+        uint32_t m_samples;
+        /** @brief number of the samples outside of the histogram */
+        uint32_t m_outside;
+        /** @brief index of the first bucket in the frame */
+        uint16_t m_first;
+        /** @brief number of the buckets */
+        uint16_t m_total;
+        /** @brief the size of a bucket is 2^m_shift bytes */
+        uint8_t m_shift;
+        /** @brief number of the buckets in the frame */
+        uint8_t m_count;
+    } __attribute__((packed));
+    static_assert(sizeof(SProfileHeader) == 18, "The layout of SProfileHeader differs from the protocol definition.");
+
+    /** @brief Payload of the start of the firmware update */
+    struct SUpdateBeginPayload{
+        /** @brief size of the image in bytes */
+        uint32_t m_size;
+        /** @brief CRC32 (zlib) of the image */
+        uint32_t m_crc;
+    } __attribute__((packed));
+    static_assert(sizeof(SUpdateBeginPayload) == 8, "The layout of SUpdateBeginPayload differs from the protocol definition.");
+
+    /** @brief Header of the firmware block, it's followed by the LZ4 compressed block (without frame) of 'm_length' bytes. The length is a multiple of four except the last block. */
+    struct SUpdateBlockHeader{
+        /** @brief offset of the block in the image */
+        uint32_t m_offset;
+        /** @brief length of the decompressed block */
+        uint16_t m_length;
+        /** @brief CRC16-CCITT of the decompressed block */
+        uint16_t m_crc;
+    } __attribute__((packed));
+    static_assert(sizeof(SUpdateBlockHeader) == 8, "The layout of SUpdateBlockHeader differs from the protocol definition.");
+
+    /** @brief Payload of the end of the firmware update */
+    struct SUpdateEndPayload{
+        /** @brief non-zero installs the verified image and resets the board */
+        uint8_t m_apply;
+    } __attribute__((packed));
+    static_assert(sizeof(SUpdateEndPayload) == 1, "The layout of SUpdateEndPayload differs from the protocol definition.");
+
+    /** @brief Header of a batch of logged events, it's followed by 'm_count' records in time order. */
+    struct SEventLogHeader{
+        /** @brief number of the events dropped by the full log since the previous batch */
+        uint16_t m_dropped;
+        /** @brief number of the records in the batch */
+        uint8_t m_count;
+    } __attribute__((packed));
+    static_assert(sizeof(SEventLogHeader) == 3, "The layout of SEventLogHeader differs from the protocol definition.");
+
+    /** @brief Header of a logged event, it's followed by 'm_length' bytes of the raw arguments in the order of the event definition. */
+    struct SEventRecord{
+        /** @brief board time of the event in microsecond */
+        uint32_t m_timestamp;
+        /** @brief identifier of the event (ELogEvent) */
+        uint16_t m_id;
+        /** @brief number of the bytes of the arguments */
+        uint8_t m_length;
+    } __attribute__((packed));
+    static_assert(sizeof(SEventRecord) == 7, "The layout of SEventRecord differs from the protocol definition.");
+
+    /** @brief  Range check of the payloads, it's applied to the received payload before its callback */
+    template<class TPayload>
+    struct SPayloadTraits;
+
+    /** @brief  Range check of SMovePayload */
+    template<>
+    struct SPayloadTraits<SMovePayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SMovePayload& f_payload, uint8_t& f_field)
+        {
+            if (!(f_payload.m_speed >= -100.0f && f_payload.m_speed <= 100.0f))
+            {
+                f_field = 1;
+                return BIN_VALUE_RANGE;
+            }
+            if (!(f_payload.m_angle >= -90.0f && f_payload.m_angle <= 90.0f))
+            {
+                f_field = 2;
+                return BIN_VALUE_RANGE;
+            }
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SBrakePayload */
+    template<>
+    struct SPayloadTraits<SBrakePayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SBrakePayload& f_payload, uint8_t& f_field)
+        {
+            if (!(f_payload.m_angle >= -90.0f && f_payload.m_angle <= 90.0f))
+            {
+                f_field = 1;
+                return BIN_VALUE_RANGE;
+            }
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SActivationPayload */
+    template<>
+    struct SPayloadTraits<SActivationPayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SActivationPayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SEncoderSpeedPayload */
+    template<>
+    struct SPayloadTraits<SEncoderSpeedPayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SEncoderSpeedPayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SOdometryPayload */
+    template<>
+    struct SPayloadTraits<SOdometryPayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SOdometryPayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SPublisherSubscribePayload */
+    template<>
+    struct SPayloadTraits<SPublisherSubscribePayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SPublisherSubscribePayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SRegisterHeader */
+    template<>
+    struct SPayloadTraits<SRegisterHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SRegisterHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of STelemetrySubscribePayload */
+    template<>
+    struct SPayloadTraits<STelemetrySubscribePayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const STelemetrySubscribePayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of STelemetryHeader */
+    template<>
+    struct SPayloadTraits<STelemetryHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const STelemetryHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SFlightRecord */
+    template<>
+    struct SPayloadTraits<SFlightRecord>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SFlightRecord&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SFlightRecordHeader */
+    template<>
+    struct SPayloadTraits<SFlightRecordHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SFlightRecordHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SCommandEntry */
+    template<>
+    struct SPayloadTraits<SCommandEntry>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SCommandEntry&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SCommandRecordHeader */
+    template<>
+    struct SPayloadTraits<SCommandRecordHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SCommandRecordHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SScopeHeader */
+    template<>
+    struct SPayloadTraits<SScopeHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SScopeHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SProfileHeader */
+    template<>
+    struct SPayloadTraits<SProfileHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SProfileHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SUpdateBeginPayload */
+    template<>
+    struct SPayloadTraits<SUpdateBeginPayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SUpdateBeginPayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SUpdateBlockHeader */
+    template<>
+    struct SPayloadTraits<SUpdateBlockHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SUpdateBlockHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SUpdateEndPayload */
+    template<>
+    struct SPayloadTraits<SUpdateEndPayload>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SUpdateEndPayload&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SEventLogHeader */
+    template<>
+    struct SPayloadTraits<SEventLogHeader>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SEventLogHeader&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+    /** @brief  Range check of SEventRecord */
+    template<>
+    struct SPayloadTraits<SEventRecord>{
+        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */
+        static uint8_t validate(const SEventRecord&, uint8_t& f_field)
+        {
+            f_field = 0;
+            return BIN_ACK;
+        }
+    };
+
+}; // namespace utils::serial
+
+#endif // PROTOCOL_MESSAGES_HPP
@@ -0,0 +1,49 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    ProtocolSchemas.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the schemas of the text commands, which have the fields of a binary payload.
+  *          It's generated by protocolGenerator.py from protocol/protocol.json, don't edit it.
+  ******************************************************************************
+ */
+
+
+/* Inclusion guard */
+#ifndef PROTOCOL_SCHEMAS_HPP
+#define PROTOCOL_SCHEMAS_HPP
+
+#include <utils/serial/commandschema.hpp>
+
+namespace utils::serial::schema{
+
+    /** @brief  Field of SMovePayload::m_speed, speed in ratio of pwm or reference speed in meter per second */
+    static const SField s_moveSpeedField = {FIELD_FLOAT, -100.0f, 100.0f, "m/s or %"};
+    /** @brief  Field of SMovePayload::m_angle, steering angle in degree */
+    static const SField s_moveAngleField = {FIELD_FLOAT, -90.0f, 90.0f, "deg"};
+    /** @brief  Fields of the text command with SMovePayload */
+    static const SField s_moveFields[] = {s_moveSpeedField, s_moveAngleField};
+
+    /** @brief  Field of SBrakePayload::m_angle, steering angle in degree */
+    static const SField s_brakeAngleField = {FIELD_FLOAT, -90.0f, 90.0f, "deg"};
+    /** @brief  Fields of the text command with SBrakePayload */
+    static const SField s_brakeFields[] = {s_brakeAngleField};
+
+}; // namespace utils::serial::schema
+
+#endif // PROTOCOL_SCHEMAS_HPP
@@ -29,16 +29,39 @@ limitations under the License.
 
 /* The mbed library */
 #include <mbed.h>
-#include <map>
 #include <array>
 /* Function objects */
 #include <functional>
 #include<utils/taskmanager/taskmanager.hpp>
-#include <utils/queue/queue.hpp>
+#include <utils/queue/ringbuffer.hpp>
+#include <utils/serial/serialreceiver.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/serial/dispatchtable.hpp>
+#include <utils/function/delegate.hpp>
 
 
 namespace utils::serial{
 
+   /**
+    * @brief Interface of the capture of the accepted frames, it's applied by the serial monitor before the dispatch of each frame.
+    */
+    class ICommandCapture
+    {
+    public:
+        /** @brief  Kinds of the captured frames */
+        enum EKind{
+            /** @brief text frame from '#' to '\r' */
+            KIND_TEXT = 0,
+            /** @brief binary frame with sync byte, identifier, length and payload */
+            KIND_SYNC = 1,
+            /** @brief binary frame in COBS framing, identifier, length and payload */
+            KIND_COBS = 2
+        };
+        /** @brief  Capture a frame, the content is valid only during the call */
+        virtual void capture(uint32_t f_timestamp, EKind f_kind, const uint8_t* f_data, uint32_t f_size) = 0;
+    };
+
    /**
     * @brief Class Serial Monitor
     * 
@@ -51,37 +74,243 @@ namespace utils::serial{
     * 
     *   "@KEY1:RESPONSECONTANT;;\r\n"
     * 
-    * The key differs for each functionalities, so for each callback function.
+    * The key differs for each functionalities, so for each callback function. The keys are packed in integers and the callback functions 
+    * are found in a sorted dispatch table, the entries are defined by the user in a static array (CDispatchTable).
+    * 
+    * Beside the text messages, the monitor decodes the frames of the binary protocol (CBinaryProtocol). The binary messages are redirected 
+    * to the callback functions of the binary subscriber map based on the message identifier, the response frame contains the returned status code. 
+    * The binary frames are accepted both with sync byte and in COBS framing, the response has the framing of the request.
+    * 
+    * The "BTCH" key is decoded by the monitor itself, its content is a list of sub-commands separated by '|' character. The sub-commands are applied 
+    * in a critical section, so the control loop observes all of them in the same tick, and they are answered by a single aggregated response:
+    * 
+    *   "#BTCH:MCTL:0.5;10.0|ENPB:1|PIDA:1;;\r\n"
+    * 
+    *   "@BTCH:MCTL:ack|ENPB:ack|PIDA:ack;;\r\n"
+    * 
+    * A callback can suppress its response by an empty string. The monitor counts the dispatched, invalid and dropped frames and it 
+    * timestamps the reception of the frame under dispatch (receive interrupt and end of the parsing), they are used by the link benchmark.
+    * 
+    * The accepted frames are passed with their arrival time to the optional capture (ICommandCapture) before their dispatch, a captured 
+    * frame can be dispatched again by the replay method, so a recorded command stream can be applied with its original timing.
+    * 
+    * The keys and identifiers with POLICY_LATEST in the dispatch tables (idempotent setpoints) are coalesced: their frames wait, 
+    * until the received bytes are drained or an ordered frame arrives, and a newer frame of the same key supersedes the waiting one, 
+    * which is answered by "superseded" (BIN_SUPERSEDED) without its dispatch. So only the newest setpoint of a backlog is applied, 
+    * the age of the applied command is bounded by one run of the monitor, and a later ordered command (e.g. brake) isn't overtaken.
+    * 
+    * The emergency stop frame (BIN_EMERGENCY_STOP with sync byte and without payload) is recognized by the receive interrupt: the 
+    * receiver passes the new bytes to the scanner of the monitor, which applies the emergency stop callback immediately, so the 
+    * braking doesn't wait for the parsing of the queued frames. The frame is also dispatched in order like the other frames.
+    * 
+    * The flow control throttles the sender, when the received bytes wait in the Rx buffer (or in the buffer of the receiver) for the 
+    * monitor: at half of the buffer the receive interrupt deasserts the RTS output or it sends the XOFF character on the safety lane, 
+    * after the draining of the buffer by the run method the RTS is asserted or XON is sent. The XON/XOFF characters are sent between 
+    * the frames, so the host recognizes them outside of the frames also on the links with binary frames.
     */
     class CSerialMonitor : public utils::task::CTask
     {
     public:
-        typedef mbed::Callback<void(char const *, char *)> FCallback;
-        typedef std::map<string,FCallback> CSerialSubscriberMap;
+        /** @brief  Callback of the text messages, it's bound at compile time, so the dispatch is a direct call of the subscriber */
+        typedef utils::function::CDelegate<void(char const *, char *)> FCallback;
+        typedef CDispatchTable<FCallback> CSerialSubscriberMap;
+        typedef CDispatchTable<CBinaryProtocol::FBinaryCallback> CBinarySubscriberMap;
+
+        /** @brief  Pack a key of four characters for the subscriber map */
+        static constexpr uint32_t key(const char* f_id)
+        {
+            return CSerialSubscriberMap::key(f_id);
+        }
+
+        /** @brief  Counters of the received frames */
+        struct SStatistics
+        {
+            /** @brief  Number of the dispatched frames */
+            uint32_t m_frames;
+            /** @brief  Number of the frames with invalid ending, header or checksum */
+            uint32_t m_invalid;
+            /** @brief  Number of the bytes dropped by the full Rx buffer in receive interrupt mode */
+            uint32_t m_rxDropped;
+            /** @brief  Number of the bytes dropped by the full parse buffer without a complete frame */
+            uint32_t m_parseDropped;
+            /** @brief  Largest number of the unread bytes of the Rx buffer or of the receiver */
+            uint32_t m_rxHighWater;
+            /** @brief  Largest number of the bytes in the parse buffer */
+            uint32_t m_parseHighWater;
+            /** @brief  Number of the throttlings of the sender by the flow control */
+            uint32_t m_throttled;
+            /** @brief  Number of the frames superseded by a newer frame of the same key */
+            uint32_t m_superseded;
+            /** @brief  Number of the emergency stops recognized by the receive interrupt */
+            uint32_t m_emergencyStops;
+        };
+
+        /** @brief  Flow control of the received stream */
+        enum EFlowControl
+        {
+            FLOW_NONE = 0,                                              /**< without flow control */
+            FLOW_RTS = 1,                                               /**< the RTS output is high, while the sender is throttled */
+            FLOW_XONXOFF = 2                                            /**< XOFF and XON characters are sent to the sender */
+        };
+        /** @brief  Character stopping the sender */
+        static const char s_xoff = 0x13;
+        /** @brief  Character resuming the sender */
+        static const char s_xon = 0x11;
 
         /* Constructor */
         CSerialMonitor(Serial& f_serialPort
-                    ,CSerialSubscriberMap f_serialSubscriberMap);
+                    ,CSerialTransmitter& f_transmitter
+                    ,CSerialSubscriberMap f_serialSubscriberMap
+                    ,CBinarySubscriberMap f_binarySubscriberMap = CBinarySubscriberMap());
+        /* Constructor with block based receiver */
+        CSerialMonitor(ISerialReceiver& f_receiver
+                    ,CSerialTransmitter& f_transmitter
+                    ,CSerialSubscriberMap f_serialSubscriberMap
+                    ,CBinarySubscriberMap f_binarySubscriberMap = CBinarySubscriberMap());
+        /** @brief  Counters of the received frames */
+        const SStatistics& getStatistics() const
+        {
+            return m_statistics;
+        }
+        /** @brief  Time of the last receive interrupt before the parsing of the frame under dispatch in microsecond */
+        uint32_t getRxTimestamp() const
+        {
+            return m_frameRxTimestamp;
+        }
+        /** @brief  Time of the end of the parsing of the frame under dispatch in microsecond */
+        uint32_t getParseTimestamp() const
+        {
+            return m_parseTimestamp;
+        }
+        /** @brief  Set the capture of the accepted frames, NULL disables it */
+        void setCapture(ICommandCapture* f_capture)
+        {
+            m_capture = f_capture;
+        }
+        /* Dispatch a captured frame */
+        bool replay(ICommandCapture::EKind f_kind, uint8_t* f_data, uint32_t f_size);
+        /** @brief  Set the RTS output of the flow control, it's driven by software, NULL removes it */
+        void setRtsPin(DigitalOut* f_rts)
+        {
+            m_rts = f_rts;
+        }
+        /* Set the flow control */
+        bool setFlowControl(EFlowControl f_mode);
+        /** @brief  Flow control */
+        EFlowControl getFlowControl() const
+        {
+            return m_flow;
+        }
+        /* Error counters of the receiver */
+        ISerialReceiver::SErrors getReceiverErrors() const;
+        /** @brief  Set the emergency stop callback, it's applied from interrupt context */
+        void setEmergencyStop(mbed::Callback<void()> f_callback)
+        {
+            m_emergencyStop = f_callback;
+        }
     private:
         /* Rx callback actions */
         void serialRxCallback();
-        /* Tx callback actions */
-        void serialTxCallback();
+        /* Receiver callback actions */
+        void receiverCallback();
         /* Run method */
         virtual void _run();
+        /* Fill the parse buffer with the received bytes */
+        uint32_t fill();
+        /* Search and decode the complete frames of the parse buffer */
+        void parseFrames();
+        /* Decode a frame and apply its callback function */
+        void dispatch(char* f_frame);
+        /* Apply the sub-commands of a batch frame */
+        void dispatchBatch(char* f_content, char* f_resp);
+        /* Apply the callback function of a binary frame */
+        void dispatchBinary(uint8_t f_id, const uint8_t* f_payload, uint8_t f_length, CBinaryProtocol::EFraming f_framing);
+        /* Decode a COBS frame and apply its callback function */
+        bool dispatchCobs(char* f_start, char* f_stop);
+        /* Search the first starting character of a text or binary frame */
+        static char* findStart(char* f_begin, char* f_end);
+        /* Dispatch a received text frame by the policy of its key */
+        void submit(char* f_frame);
+        /* Dispatch a received binary frame by the policy of its identifier */
+        void submitBinary(uint8_t f_id, const uint8_t* f_payload, uint8_t f_length, CBinaryProtocol::EFraming f_framing);
+        /* Hold a coalesced frame, the waiting frame of the same key is superseded */
+        void hold(uint32_t f_key, bool f_binary, const char* f_data, uint32_t f_length, CBinaryProtocol::EFraming f_framing);
+        /* Dispatch the held frames */
+        void flushHeld();
+        /* Search the emergency stop frame in the received bytes, it's applied by the receive interrupts */
+        void scan(const char* f_data, uint32_t f_length);
+        /* Measure the received bytes and throttle the sender, it's applied by the receive interrupts */
+        void checkLevel();
+        /* Throttle or resume the sender */
+        void throttle(bool f_stop);
+
+        /** @brief  Maximum number of sub-commands in a batch frame */
+        static const uint32_t s_maxBatchCommands = 8;
+        /** @brief  Maximum number of the held frames */
+        static const uint32_t s_maxHeld = 4;
+        /** @brief  Maximum size of a held frame, the longer frames are dispatched in order */
+        static const uint32_t s_heldSize = 48;
+
+        /** @brief  Size of the emergency stop frame */
+        static const uint32_t s_emergencySize = CBinaryProtocol::s_headerSize + CBinaryProtocol::s_crcSize;
+
+        /** @brief  Coalesced frame waiting for its dispatch */
+        struct SHeld
+        {
+            /** @brief  Packed key or binary identifier */
+            uint32_t m_key;
+            /** @brief  The frame is binary */
+            bool m_binary;
+            /** @brief  Framing of the binary frame */
+            CBinaryProtocol::EFraming m_framing;
+            /** @brief  Length of the held content */
+            uint8_t m_length;
+            /** @brief  Null terminated text frame or binary payload */
+            char m_data[s_heldSize];
+        };
 
-        /** @brief Serial communication port */
-        Serial& m_serialPort;
-        /** @brief Rx buffer */
-        utils::CQueue<char,255> m_RxBuffer;
-        /** @brief Tx buffer */
-        utils::CQueue<char,255> m_TxBuffer;
+        /** @brief Serial communication port, NULL when the block based receiver is used */
+        Serial* m_serialPort;
+        /** @brief Block based receiver, NULL when the receive interrupt of the serial is used */
+        ISerialReceiver* m_receiver;
+        /** @brief Transmitter of the responses */
+        CSerialTransmitter& m_transmitter;
+        /** @brief Rx buffer, the receive interrupt is the producer and the run method is the consumer */
+        utils::CRingBuffer<char,256> m_RxBuffer;
         /** @brief Data buffer */
         array<char,256> m_parseBuffer;
-        /** @brief Parse iterator */
-        array<char,256>::iterator m_parseIt;
+        /** @brief Number of bytes in the parse buffer */
+        uint32_t m_parseLength;
         /** @brief Serial subscriber */
         CSerialSubscriberMap m_serialSubscriberMap;
+        /** @brief Binary subscriber */
+        CBinarySubscriberMap m_binarySubscriberMap;
+        /** @brief Counters of the received frames */
+        SStatistics m_statistics;
+        /** @brief Time of the last receive interrupt */
+        volatile uint32_t m_rxTimestamp;
+        /** @brief Time of the receive interrupt before the last filling of the parse buffer */
+        uint32_t m_frameRxTimestamp;
+        /** @brief Time of the end of the parsing of the frame under dispatch */
+        uint32_t m_parseTimestamp;
+        /** @brief Capture of the accepted frames, it can be NULL */
+        ICommandCapture* m_capture;
+        /** @brief Flow control */
+        EFlowControl m_flow;
+        /** @brief RTS output of the flow control, it can be NULL */
+        DigitalOut* m_rts;
+        /** @brief The sender is throttled */
+        volatile bool m_isThrottled;
+        /** @brief Held frames in the order of their reception */
+        SHeld m_held[s_maxHeld];
+        /** @brief Number of the held frames */
+        uint32_t m_heldCount;
+        /** @brief Emergency stop frame */
+        uint8_t m_emergencyFrame[s_emergencySize];
+        /** @brief Number of the matched bytes of the emergency stop frame */
+        uint8_t m_emergencyMatch;
+        /** @brief Emergency stop callback */
+        mbed::Callback<void()> m_emergencyStop;
     };
 
 }; // namespace utils::serial
@@ -0,0 +1,78 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SerialReceiver.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the interface declaration for the block based serial receivers.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SERIAL_RECEIVER_HPP
+#define SERIAL_RECEIVER_HPP
+
+#include <mbed.h>
+
+namespace utils::serial{
+
+   /**
+    * @brief Interface to access a serial receiver, which collects the received bytes in its own buffer (for example by DMA).
+    * 
+    * The attached callback is applied from interrupt context, when new bytes are available. The level of the unread bytes is 
+    * used by the flow control of the serial monitor, the error counters are reported by the link statistics. The attached scanner 
+    * gets the new bytes in the receive interrupt before the callback, without reading them, so the monitor recognizes the urgent 
+    * frames independently of the parsing.
+    */
+    class ISerialReceiver
+    {
+    public:
+        /** @brief  Error counters of the receiver */
+        struct SErrors
+        {
+            /** @brief  Number of the overrun errors of the UART, a byte wasn't read before the next one */
+            uint32_t m_overruns;
+            /** @brief  Number of the framing errors, a stop bit was missing */
+            uint32_t m_framing;
+            /** @brief  Number of the noise errors */
+            uint32_t m_noise;
+            /** @brief  Number of the overflows of the buffer, the unread bytes were overwritten */
+            uint32_t m_overflows;
+            /** @brief  Number of the bytes discarded by the overflows */
+            uint32_t m_lost;
+        };
+
+        /** @brief  Scanner of the received bytes, it's applied from interrupt context */
+        typedef mbed::Callback<void(const char*, uint32_t)> FScanner;
+
+        /* Read the available bytes, it returns the number of copied bytes */
+        virtual uint32_t read(char* f_buffer, uint32_t f_length) = 0;
+        /* Attach the callback, which is applied, when new bytes are received */
+        virtual void attach(mbed::Callback<void()> f_callback) = 0;
+        /* Attach the scanner of the received bytes */
+        virtual void attachScanner(FScanner f_scanner) = 0;
+        /* Number of the received, unread bytes */
+        virtual uint32_t getLevel() const = 0;
+        /* Size of the buffer of the receiver */
+        virtual uint32_t getCapacity() const = 0;
+        /* Error counters */
+        virtual const SErrors& getErrors() const = 0;
+    };
+
+}; // namespace utils::serial
+
+#endif // SERIAL_RECEIVER_HPP
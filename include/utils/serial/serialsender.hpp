@@ -0,0 +1,49 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SerialSender.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the interface declaration for the block based serial senders.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SERIAL_SENDER_HPP
+#define SERIAL_SENDER_HPP
+
+#include <mbed.h>
+
+namespace utils::serial{
+
+   /**
+    * @brief Interface to access a serial sender, which transmits a block of bytes in background (for example by DMA).
+    * 
+    * The attached callback is applied from interrupt context, when the transmission of the block is finished.
+    */
+    class ISerialSender
+    {
+    public:
+        /* Start the transmission of a block, the block has to remain valid until the transmission is finished */
+        virtual void send(const char* f_data, uint32_t f_length) = 0;
+        /* Attach the callback, which is applied, when the block was transmitted */
+        virtual void attach(mbed::Callback<void()> f_callback) = 0;
+    };
+
+}; // namespace utils::serial
+
+#endif // SERIAL_SENDER_HPP
@@ -0,0 +1,151 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SerialTransmitter.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the buffered serial transmitter.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SERIAL_TRANSMITTER_HPP
+#define SERIAL_TRANSMITTER_HPP
+
+#include <mbed.h>
+#include <cstdarg>
+#include <utils/serial/serialsender.hpp>
+#include <utils/queue/ringbuffer.hpp>
+
+namespace utils::serial{
+
+   /**
+    * @brief Non-blocking buffered transmitter shared by all message producers (serial monitor, publishers, state machine).
+    * 
+    * The producers copy the messages in the circular buffer of a priority lane and return immediately, the lanes are drained in background by the 
+    * transmit interrupt of the serial object or by a block based sender (DMA). A message is written entirely or it's dropped, 
+    * when there isn't enough free space in its lane, so the messages are never interleaved. The methods can be applied from any thread.
+    * 
+    * The scheduler selects the next message at the frame boundaries from the lane with the highest priority (safety alarms, command responses, 
+    * telemetry, debug), so a safety alarm waits at most for the end of the message under transmission, independently of the queued stream data. 
+    * The lanes can be rate limited by a token bucket, the lane with exhausted bucket is skipped until its tokens are refilled.
+    */
+    class CSerialTransmitter
+    {
+    public:
+        /** @brief  Priority lanes of the messages, the lower value has the higher priority */
+        enum ELane
+        {
+            LANE_SAFETY = 0,                                            /**< safety alarms */
+            LANE_RESPONSE,                                              /**< responses of the commands */
+            LANE_TELEMETRY,                                             /**< periodic telemetry and publishers */
+            LANE_DEBUG,                                                 /**< debug messages */
+            LANE_COUNT
+        };
+
+        /* Constructor with transmit interrupt */
+        CSerialTransmitter(Serial& f_serialPort);
+        /* Constructor with block based sender */
+        CSerialTransmitter(ISerialSender& f_sender);
+        /* Write a message in the buffer of a lane */
+        bool write(const char* f_data, uint32_t f_length, ELane f_lane = LANE_RESPONSE);
+        /* Format and write a message in the buffer of the response lane */
+        bool printf(const char* f_format, ...);
+        /* Format and write a message in the buffer of a lane */
+        bool printf(ELane f_lane, const char* f_format, ...);
+        /* Set the rate limit of a lane */
+        void setRateLimit(ELane f_lane, float f_bytesPerSecond, float f_burst);
+        /* A lane has queued messages or its message is under transmission */
+        bool isPending(ELane f_lane) const;
+        /** @brief  Number of dropped messages */
+        uint32_t getDropped() const
+        {
+            return m_dropped;
+        }
+        /** @brief  Number of dropped messages of a lane */
+        uint32_t getDropped(ELane f_lane) const
+        {
+            return m_lanes[f_lane].m_dropped;
+        }
+        /** @brief  Size of the circular buffer of a lane, it has to be power of two. */
+        static const uint32_t s_laneBufferSize = 512;
+        /** @brief  Maximum number of queued messages in a lane, it has to be power of two. */
+        static const uint32_t s_laneFrames = 32;
+        /** @brief  Maximum length of a formatted message */
+        static const uint32_t s_maxMessageLength = 256;
+        /** @brief  Additional length of the stamped text messages ('|', ten digits and the null character) */
+        static const uint32_t s_stampLength = 12;
+    private:
+        /** @brief  Queued messages and the token bucket of a lane */
+        struct SLane
+        {
+            /** @brief  Circular buffer, the blocks are sent in place from its readable regions */
+            utils::CRingBuffer<char,s_laneBufferSize> m_buffer;
+            /** @brief  Length of the queued messages */
+            utils::CRingBuffer<uint16_t,s_laneFrames> m_frames;
+            /** @brief  Refill rate of the bucket in bytes per second, zero when the lane isn't limited */
+            float m_rate;
+            /** @brief  Capacity of the bucket in bytes */
+            float m_burst;
+            /** @brief  Available tokens, it's negative after a message longer than the tokens */
+            float m_tokens;
+            /** @brief  Timestamp of the last refill in microseconds */
+            uint32_t m_lastRefill;
+            /** @brief  Number of dropped messages */
+            uint32_t m_dropped;
+        };
+
+        /* Copy a message in the buffer of a lane */
+        bool enqueue(const char* f_data, uint32_t f_length, ELane f_lane);
+        /* Format and write a message */
+        bool vprintf(ELane f_lane, const char* f_format, va_list f_args);
+        /* Select the next message, it has to be applied from critical section */
+        bool select();
+        /* Start the draining of the lanes, it has to be applied from critical section */
+        void kick();
+        /* Transmit interrupt callback */
+        void serialTxCallback();
+        /* Sender callback, applied when a block was transmitted */
+        void senderCallback();
+        /* Timeout callback, applied when the tokens of a limited lane are refilled */
+        void retryCallback();
+
+        /** @brief  Serial object, NULL in sender mode */
+        Serial* m_serialPort;
+        /** @brief  Block based sender, NULL in interrupt mode */
+        ISerialSender* m_sender;
+        /** @brief  Priority lanes */
+        SLane m_lanes[LANE_COUNT];
+        /** @brief  Lane of the message under transmission */
+        uint32_t m_lane;
+        /** @brief  Remaining bytes of the message under transmission */
+        uint32_t m_frameRemaining;
+        /** @brief  Length of the block under transmission in sender mode */
+        volatile uint32_t m_inFlight;
+        /** @brief  State of the transmit interrupt in interrupt mode */
+        volatile bool m_active;
+        /** @brief  Timeout to restart the draining, when only rate limited lanes have messages */
+        Timeout m_retry;
+        /** @brief  State of the retry timeout */
+        bool m_retryPending;
+        /** @brief  Number of dropped messages */
+        volatile uint32_t m_dropped;
+    };
+
+}; // namespace utils::serial
+
+#endif // SERIAL_TRANSMITTER_HPP
@@ -0,0 +1,105 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StateMachine.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the table-driven 
+  *          state machine engine.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef STATE_MACHINE_HPP
+#define STATE_MACHINE_HPP
+
+#include <mbed.h>
+#include <utils/queue/ringbuffer.hpp>
+
+namespace utils{
+
+/**
+ * @brief Table-driven state machine engine with entry, run and exit actions and with an event queue.
+ * 
+ * The events can be posted from any context (thread, interrupt, timer callback), they are queued in critical section. The events 
+ * are drained only by the step method applied in the control tick, so the transitions and the actions run always in the same context. 
+ * The transition table gives the next state for each state and event pair, the events without transition are ignored. A transition 
+ * applies the exit action of the previous state and the entry action of the next state. The events posted by the run action are 
+ * dispatched in the same step.
+ * 
+ * @tparam TOwner   The class of the actions
+ * @tparam NStates  The number of the states
+ * @tparam NEvents  The number of the events
+ * @tparam NQueue   The capacity of the event queue, it has to be power of two.
+ */
+template <class TOwner, uint8_t NStates, uint8_t NEvents, uint32_t NQueue = 16>
+class CStateMachine
+{
+public:
+    /** @brief Action of a state, NULL without action */
+    typedef void (TOwner::*Action)();
+    /** @brief Actions of a state */
+    struct SState{
+        /** @brief applied when the state is entered */
+        Action m_entry;
+        /** @brief applied in each step of the state */
+        Action m_run;
+        /** @brief applied when the state is left */
+        Action m_exit;
+    };
+    /** @brief Table of the actions */
+    typedef SState CStateTable[NStates];
+    /** @brief Table of the transitions, the next state by the current state and the event */
+    typedef uint8_t CTransitionTable[NStates][NEvents];
+    /** @brief Mark of the missing transition in the table */
+    static const uint8_t s_noTransition = 0xFF;
+
+    /* Constructor */
+    CStateMachine(TOwner& f_owner, const CStateTable& f_states, const CTransitionTable& f_transitions, uint8_t f_initial);
+    /* Post an event */
+    bool post(uint8_t f_event);
+    /* Dispatch the events and apply the run action of the current state */
+    void step();
+    /** @brief Current state */
+    uint8_t getState() const
+    {
+        return m_state;
+    }
+
+private:
+    /* Dispatch the queued events */
+    void dispatch();
+    /* Apply an action */
+    inline void apply(Action f_action);
+
+    /** @brief Owner of the actions */
+    TOwner& m_owner;
+    /** @brief Actions of the states */
+    const CStateTable& m_states;
+    /** @brief Transitions */
+    const CTransitionTable& m_transitions;
+    /** @brief Queued events */
+    CRingBuffer<uint8_t,NQueue> m_events;
+    /** @brief Current state, it's written only by the step */
+    volatile uint8_t m_state;
+};
+
+}; // namespace utils
+
+#include "statemachine.tpp"
+
+#endif // STATE_MACHINE_HPP
@@ -0,0 +1,119 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StateMachine.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the table-driven 
+  *          state machine engine.
+  ******************************************************************************
+ */
+
+#ifndef STATE_MACHINE_TPP
+#define STATE_MACHINE_TPP
+
+#ifndef STATE_MACHINE_HPP
+#error __FILE__ should only be included from statemachine.hpp.
+#endif // STATE_MACHINE_HPP
+
+namespace utils{
+
+/** @brief  State machine class constructor
+ *
+ *  The entry action of the initial state isn't applied.
+ *
+ *  @param f_owner         owner of the actions
+ *  @param f_states        actions of the states
+ *  @param f_transitions   transition table
+ *  @param f_initial       initial state
+ */
+template <class TOwner, uint8_t NStates, uint8_t NEvents, uint32_t NQueue>
+CStateMachine<TOwner,NStates,NEvents,NQueue>::CStateMachine(TOwner& f_owner, const CStateTable& f_states, const CTransitionTable& f_transitions, uint8_t f_initial)
+    : m_owner(f_owner)
+    , m_states(f_states)
+    , m_transitions(f_transitions)
+    , m_events()
+    , m_state(f_initial)
+{
+}
+
+/** @brief  Post an event, it can be applied from any context.
+ *
+ *  @param f_event         event
+ *  @return                false, when the event is invalid or the queue is full
+ */
+template <class TOwner, uint8_t NStates, uint8_t NEvents, uint32_t NQueue>
+bool CStateMachine<TOwner,NStates,NEvents,NQueue>::post(uint8_t f_event)
+{
+    if (f_event >= NEvents)
+    {
+        return false;
+    }
+    // The queue has a single producer, the posting contexts are serialized
+    core_util_critical_section_enter();
+    bool l_res = m_events.push(f_event);
+    core_util_critical_section_exit();
+    return l_res;
+}
+
+/** @brief  Dispatch the events and apply the run action of the current state, then dispatch the events posted by the run action.
+ *
+ */
+template <class TOwner, uint8_t NStates, uint8_t NEvents, uint32_t NQueue>
+void CStateMachine<TOwner,NStates,NEvents,NQueue>::step()
+{
+    dispatch();
+    apply(m_states[m_state].m_run);
+    dispatch();
+}
+
+/** @brief  Dispatch the queued events by the transition table
+ *
+ */
+template <class TOwner, uint8_t NStates, uint8_t NEvents, uint32_t NQueue>
+void CStateMachine<TOwner,NStates,NEvents,NQueue>::dispatch()
+{
+    uint8_t l_event;
+    while (m_events.pop(l_event))
+    {
+        uint8_t l_next = m_transitions[m_state][l_event];
+        if (s_noTransition == l_next || l_next >= NStates)
+        {
+            continue;
+        }
+        apply(m_states[m_state].m_exit);
+        m_state = l_next;
+        apply(m_states[m_state].m_entry);
+    }
+}
+
+/** @brief  Apply an action of the owner
+ *
+ *  @param f_action        action, NULL without action
+ */
+template <class TOwner, uint8_t NStates, uint8_t NEvents, uint32_t NQueue>
+void CStateMachine<TOwner,NStates,NEvents,NQueue>::apply(Action f_action)
+{
+    if (NULL != f_action)
+    {
+        (m_owner.*f_action)();
+    }
+}
+
+}; // namespace utils
+
+#endif // STATE_MACHINE_TPP
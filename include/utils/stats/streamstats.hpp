@@ -0,0 +1,258 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StreamStats.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declarations for the streaming
+  *          statistics of the instrumentation.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef STREAM_STATS_HPP
+#define STREAM_STATS_HPP
+
+#include <mbed.h>
+#include <stdint.h>
+#include <cmath>
+
+/**
+ * @brief Streaming statistics of the instrumentation (task timing, jitter, latency, sensor health).
+ *
+ * Each estimator keeps a fixed state, it's updated in constant time by one sample without allocation or locking, so it can be updated
+ * from an interrupt. An estimator has one updating context; a reader in another context takes a consistent copy by 'snapshot', which
+ * copies the state in critical section.
+ */
+namespace utils::stats{
+
+/** @brief Consistent copy of an estimator, which is updated by an other context (e.g. an interrupt). */
+template <class TStat>
+TStat snapshot(const TStat& f_stat)
+{
+    core_util_critical_section_enter();
+    TStat l_copy = f_stat;
+    core_util_critical_section_exit();
+    return l_copy;
+}
+
+/**
+ * @brief Minimum and maximum of the samples.
+ *
+ * @tparam T        The type of the samples
+ */
+template <class T>
+class CMinMax
+{
+public:
+    /* Constructor */
+    CMinMax();
+    /* Add a sample */
+    void add(T f_value);
+    /* Restart the statistics */
+    void reset();
+    /** @brief Number of the samples */
+    uint32_t getCount() const {return m_count;}
+    /** @brief Minimum, zero without samples */
+    T getMin() const {return m_count ? m_min : T();}
+    /** @brief Maximum, zero without samples */
+    T getMax() const {return m_count ? m_max : T();}
+    /** @brief Range of the samples */
+    T getRange() const {return getMax() - getMin();}
+private:
+    /** @brief Number of the samples */
+    uint32_t m_count;
+    /** @brief Minimum */
+    T m_min;
+    /** @brief Maximum */
+    T m_max;
+};
+
+/**
+ * @brief Mean and variance by the Welford algorithm, the mean and the sum of the squared deviations are updated by each sample, so
+ * the variance doesn't lose the precision by the subtraction of two large sums.
+ *
+ * @tparam T        The floating point type of the calculation
+ */
+template <class T = float>
+class CWelford
+{
+public:
+    /* Constructor */
+    CWelford();
+    /* Add a sample */
+    void add(T f_value);
+    /* Restart the statistics */
+    void reset();
+    /** @brief Number of the samples */
+    uint32_t getCount() const {return m_count;}
+    /** @brief Mean, zero without samples */
+    T getMean() const {return m_mean;}
+    /** @brief Sample variance (n-1), zero below two samples */
+    T getVariance() const {return (m_count > 1) ? m_m2 / static_cast<T>(m_count - 1) : T(0);}
+    /** @brief Sample standard deviation */
+    T getStdDev() const {return std::sqrt(getVariance());}
+    /** @brief Minimum and maximum of the samples */
+    const CMinMax<T>& getMinMax() const {return m_minMax;}
+private:
+    /** @brief Number of the samples */
+    uint32_t m_count;
+    /** @brief Running mean */
+    T m_mean;
+    /** @brief Sum of the squared deviations from the mean */
+    T m_m2;
+    /** @brief Extremes */
+    CMinMax<T> m_minMax;
+};
+
+/**
+ * @brief Exponentially weighted moving average and variance, the weight of a sample decays by (1-alpha) with each newer sample. The
+ * first sample initializes the average.
+ *
+ * @tparam T        The floating point type of the calculation
+ */
+template <class T = float>
+class CEwma
+{
+public:
+    /* Constructor */
+    CEwma(T f_alpha);
+    /* Add a sample */
+    void add(T f_value);
+    /* Restart the average */
+    void reset();
+    /** @brief The average is initialized */
+    bool isValid() const {return m_valid;}
+    /** @brief Moving average */
+    T getMean() const {return m_mean;}
+    /** @brief Moving variance */
+    T getVariance() const {return m_variance;}
+    /** @brief Moving standard deviation */
+    T getStdDev() const {return std::sqrt(m_variance);}
+    /** @brief Smoothing factor */
+    T getAlpha() const {return m_alpha;}
+private:
+    /** @brief Smoothing factor in (0,1] */
+    T m_alpha;
+    /** @brief Moving average */
+    T m_mean;
+    /** @brief Moving variance */
+    T m_variance;
+    /** @brief The first sample was added */
+    bool m_valid;
+};
+
+/**
+ * @brief Quantile estimator by the P² algorithm (Jain-Chlamtac), it approximates a quantile with five markers without storing the
+ * samples. The heights of the markers are the estimated minimum, p/2, p, (1+p)/2 quantiles and maximum. After each sample the middle
+ * markers are moved toward their desired positions by one, their heights are adjusted by the piecewise-parabolic (P²) formula, or by
+ * the linear one, when the parabola leaves the neighbouring heights. Below five samples the quantile is taken from the sorted samples.
+ *
+ * @tparam T        The floating point type of the calculation
+ */
+template <class T = float>
+class CP2Quantile
+{
+public:
+    /* Constructor */
+    CP2Quantile(T f_probability);
+    /* Add a sample */
+    void add(T f_value);
+    /* Restart the estimation */
+    void reset();
+    /* Estimated quantile */
+    T get() const;
+    /** @brief Number of the samples */
+    uint32_t getCount() const {return m_count;}
+    /** @brief Probability of the quantile */
+    T getProbability() const {return m_probability;}
+private:
+    /* Parabolic prediction of the height of a marker moved by 'f_step' */
+    T parabolic(uint8_t f_idx, int32_t f_step) const;
+    /* Linear prediction of the height of a marker moved by 'f_step' */
+    T linear(uint8_t f_idx, int32_t f_step) const;
+
+    /** @brief Number of the markers */
+    static const uint8_t s_markers = 5;
+    /** @brief Probability of the quantile */
+    T m_probability;
+    /** @brief Number of the samples */
+    uint32_t m_count;
+    /** @brief Heights of the markers, the first samples before the initialization */
+    T m_heights[s_markers];
+    /** @brief Actual positions of the markers */
+    int32_t m_positions[s_markers];
+    /** @brief Desired positions of the markers */
+    T m_desired[s_markers];
+    /** @brief Increments of the desired positions */
+    T m_increments[s_markers];
+};
+
+/**
+ * @brief Histogram with fixed-width bins over [low, high), the samples outside are counted separately. The bin of a sample is found
+ * by one multiplication, the quantiles are interpolated linearly in their bin.
+ *
+ * @tparam NBins    Number of the bins
+ * @tparam T        The floating point type of the samples
+ */
+template <uint16_t NBins, class T = float>
+class CHistogram
+{
+    static_assert(NBins > 0, "The histogram needs at least one bin.");
+public:
+    /* Constructor */
+    CHistogram(T f_low, T f_high);
+    /* Add a sample */
+    void add(T f_value);
+    /* Restart the histogram */
+    void reset();
+    /* Estimated quantile */
+    T quantile(T f_probability) const;
+    /** @brief Number of the samples in a bin */
+    uint32_t getBin(uint16_t f_bin) const {return (f_bin < NBins) ? m_bins[f_bin] : 0;}
+    /** @brief Lower edge of a bin */
+    T getEdge(uint16_t f_bin) const {return m_low + f_bin * m_width;}
+    /** @brief Number of the samples below the range */
+    uint32_t getUnderflow() const {return m_underflow;}
+    /** @brief Number of the samples above the range */
+    uint32_t getOverflow() const {return m_overflow;}
+    /** @brief Number of all samples */
+    uint32_t getCount() const {return m_count;}
+    /** @brief Number of the bins */
+    static uint16_t getBinCount() {return NBins;}
+private:
+    /** @brief Lower limit of the range */
+    T m_low;
+    /** @brief Width of the bins */
+    T m_width;
+    /** @brief Inverse width of the bins */
+    T m_scale;
+    /** @brief Counters of the bins */
+    uint32_t m_bins[NBins];
+    /** @brief Samples below the range */
+    uint32_t m_underflow;
+    /** @brief Samples above the range */
+    uint32_t m_overflow;
+    /** @brief All samples */
+    uint32_t m_count;
+};
+
+}; // namespace utils::stats
+
+#include "streamstats.tpp"
+
+#endif // STREAM_STATS_HPP
@@ -0,0 +1,385 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StreamStats.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementations for the streaming
+  *          statistics of the instrumentation.
+  ******************************************************************************
+ */
+
+#ifndef STREAM_STATS_TPP
+#define STREAM_STATS_TPP
+
+#ifndef STREAM_STATS_HPP
+#error __FILE__ should only be included from streamstats.hpp.
+#endif // STREAM_STATS_HPP
+
+namespace utils::stats{
+
+/** @brief  CMinMax class constructor, without samples
+ */
+template <class T>
+CMinMax<T>::CMinMax()
+    : m_count(0)
+    , m_min()
+    , m_max()
+{
+}
+
+/** @brief  Add a sample
+ *
+ *  @param f_value         sample
+ */
+template <class T>
+void CMinMax<T>::add(T f_value)
+{
+    if (m_count == 0 || f_value < m_min)
+    {
+        m_min = f_value;
+    }
+    if (m_count == 0 || f_value > m_max)
+    {
+        m_max = f_value;
+    }
+    m_count++;
+}
+
+/** @brief  Restart the statistics
+ */
+template <class T>
+void CMinMax<T>::reset()
+{
+    m_count = 0;
+    m_min = T();
+    m_max = T();
+}
+
+/** @brief  CWelford class constructor, without samples
+ */
+template <class T>
+CWelford<T>::CWelford()
+    : m_count(0)
+    , m_mean(0)
+    , m_m2(0)
+    , m_minMax()
+{
+}
+
+/** @brief  Add a sample, the mean is moved by the deviation divided by the number of the samples, the sum of the squared deviations
+ *  grows by the product of the deviations from the old and from the new mean.
+ *
+ *  @param f_value         sample
+ */
+template <class T>
+void CWelford<T>::add(T f_value)
+{
+    m_count++;
+    T l_delta = f_value - m_mean;
+    m_mean += l_delta / static_cast<T>(m_count);
+    m_m2 += l_delta * (f_value - m_mean);
+    m_minMax.add(f_value);
+}
+
+/** @brief  Restart the statistics
+ */
+template <class T>
+void CWelford<T>::reset()
+{
+    m_count = 0;
+    m_mean = 0;
+    m_m2 = 0;
+    m_minMax.reset();
+}
+
+/** @brief  CEwma class constructor
+ *
+ *  @param f_alpha         smoothing factor in (0,1], the weight of the newest sample
+ */
+template <class T>
+CEwma<T>::CEwma(T f_alpha)
+    : m_alpha(f_alpha)
+    , m_mean(0)
+    , m_variance(0)
+    , m_valid(false)
+{
+}
+
+/** @brief  Add a sample
+ *
+ *  @param f_value         sample
+ */
+template <class T>
+void CEwma<T>::add(T f_value)
+{
+    if (!m_valid)
+    {
+        m_mean = f_value;
+        m_variance = 0;
+        m_valid = true;
+        return;
+    }
+    T l_delta = f_value - m_mean;
+    m_mean += m_alpha * l_delta;
+    m_variance = (1 - m_alpha) * (m_variance + m_alpha * l_delta * l_delta);
+}
+
+/** @brief  Restart the average, the next sample initializes it
+ */
+template <class T>
+void CEwma<T>::reset()
+{
+    m_mean = 0;
+    m_variance = 0;
+    m_valid = false;
+}
+
+/** @brief  CP2Quantile class constructor
+ *
+ *  @param f_probability   probability of the quantile in [0,1], e.g. 0.99 for the 99th percentile
+ */
+template <class T>
+CP2Quantile<T>::CP2Quantile(T f_probability)
+    : m_probability(f_probability)
+{
+    reset();
+}
+
+/** @brief  Restart the estimation
+ */
+template <class T>
+void CP2Quantile<T>::reset()
+{
+    m_count = 0;
+    for (uint8_t i = 0; i < s_markers; i++)
+    {
+        m_heights[i] = 0;
+        m_positions[i] = i;
+    }
+    m_desired[0] = 0;
+    m_desired[1] = 2 * m_probability;
+    m_desired[2] = 4 * m_probability;
+    m_desired[3] = 2 + 2 * m_probability;
+    m_desired[4] = 4;
+    m_increments[0] = 0;
+    m_increments[1] = m_probability / 2;
+    m_increments[2] = m_probability;
+    m_increments[3] = (1 + m_probability) / 2;
+    m_increments[4] = 1;
+}
+
+/** @brief  Add a sample
+ *
+ *  The first five samples are kept sorted as the initial heights. Then the cell of the sample is found, the extreme markers follow
+ *  the new minimum or maximum, the positions above the cell are incremented and each desired position grows by its increment. A
+ *  middle marker, which is at least one position away from its desired position, is moved by one, when it doesn't reach its neighbour.
+ *
+ *  @param f_value         sample
+ */
+template <class T>
+void CP2Quantile<T>::add(T f_value)
+{
+    if (m_count < s_markers)
+    {
+        uint8_t l_idx = static_cast<uint8_t>(m_count);
+        while (l_idx > 0 && m_heights[l_idx - 1] > f_value)
+        {
+            m_heights[l_idx] = m_heights[l_idx - 1];
+            l_idx--;
+        }
+        m_heights[l_idx] = f_value;
+        m_count++;
+        return;
+    }
+    m_count++;
+
+    uint8_t l_cell;
+    if (f_value < m_heights[0])
+    {
+        m_heights[0] = f_value;
+        l_cell = 0;
+    }
+    else if (f_value >= m_heights[s_markers - 1])
+    {
+        m_heights[s_markers - 1] = f_value;
+        l_cell = s_markers - 2;
+    }
+    else
+    {
+        l_cell = 0;
+        while (f_value >= m_heights[l_cell + 1])
+        {
+            l_cell++;
+        }
+    }
+    for (uint8_t i = l_cell + 1; i < s_markers; i++)
+    {
+        m_positions[i]++;
+    }
+    for (uint8_t i = 0; i < s_markers; i++)
+    {
+        m_desired[i] += m_increments[i];
+    }
+
+    for (uint8_t i = 1; i < s_markers - 1; i++)
+    {
+        T l_offset = m_desired[i] - static_cast<T>(m_positions[i]);
+        if ((l_offset >= 1 && m_positions[i + 1] - m_positions[i] > 1) || (l_offset <= -1 && m_positions[i - 1] - m_positions[i] < -1))
+        {
+            int32_t l_step = (l_offset > 0) ? 1 : -1;
+            T l_height = parabolic(i, l_step);
+            if (!(m_heights[i - 1] < l_height && l_height < m_heights[i + 1]))
+            {
+                l_height = linear(i, l_step);
+            }
+            m_heights[i] = l_height;
+            m_positions[i] += l_step;
+        }
+    }
+}
+
+/** @brief  Estimated quantile, below five samples the nearest rank of the sorted samples
+ *
+ *  @return                quantile, zero without samples
+ */
+template <class T>
+T CP2Quantile<T>::get() const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    if (m_count < s_markers)
+    {
+        uint32_t l_rank = static_cast<uint32_t>(m_probability * static_cast<T>(m_count - 1) + static_cast<T>(0.5));
+        return m_heights[(l_rank < m_count) ? l_rank : m_count - 1];
+    }
+    return m_heights[2];
+}
+
+/** @brief  Piecewise-parabolic prediction of the height
+ *
+ *  @param f_idx           index of a middle marker
+ *  @param f_step          direction of the move, +1 or -1
+ *  @return                predicted height
+ */
+template <class T>
+T CP2Quantile<T>::parabolic(uint8_t f_idx, int32_t f_step) const
+{
+    T l_step = static_cast<T>(f_step);
+    T l_below = static_cast<T>(m_positions[f_idx] - m_positions[f_idx - 1]);
+    T l_above = static_cast<T>(m_positions[f_idx + 1] - m_positions[f_idx]);
+    T l_span = static_cast<T>(m_positions[f_idx + 1] - m_positions[f_idx - 1]);
+    return m_heights[f_idx] + l_step / l_span
+        * ((l_below + l_step) * (m_heights[f_idx + 1] - m_heights[f_idx]) / l_above
+         + (l_above - l_step) * (m_heights[f_idx] - m_heights[f_idx - 1]) / l_below);
+}
+
+/** @brief  Linear prediction of the height toward the neighbour in the direction of the move
+ *
+ *  @param f_idx           index of a middle marker
+ *  @param f_step          direction of the move, +1 or -1
+ *  @return                predicted height
+ */
+template <class T>
+T CP2Quantile<T>::linear(uint8_t f_idx, int32_t f_step) const
+{
+    uint8_t l_neighbour = static_cast<uint8_t>(f_idx + f_step);
+    return m_heights[f_idx] + static_cast<T>(f_step) * (m_heights[l_neighbour] - m_heights[f_idx])
+        / static_cast<T>(m_positions[l_neighbour] - m_positions[f_idx]);
+}
+
+/** @brief  CHistogram class constructor
+ *
+ *  @param f_low           lower limit of the range
+ *  @param f_high          upper limit of the range, greater than the lower one
+ */
+template <uint16_t NBins, class T>
+CHistogram<NBins,T>::CHistogram(T f_low, T f_high)
+    : m_low(f_low)
+    , m_width((f_high - f_low) / NBins)
+    , m_scale(NBins / (f_high - f_low))
+{
+    reset();
+}
+
+/** @brief  Add a sample, a NaN is counted as underflow
+ *
+ *  @param f_value         sample
+ */
+template <uint16_t NBins, class T>
+void CHistogram<NBins,T>::add(T f_value)
+{
+    m_count++;
+    if (!(f_value >= m_low))
+    {
+        m_underflow++;
+        return;
+    }
+    T l_position = (f_value - m_low) * m_scale;
+    if (!(l_position < static_cast<T>(NBins)))
+    {
+        m_overflow++;
+        return;
+    }
+    m_bins[static_cast<uint16_t>(l_position)]++;
+}
+
+/** @brief  Restart the histogram
+ */
+template <uint16_t NBins, class T>
+void CHistogram<NBins,T>::reset()
+{
+    for (uint16_t i = 0; i < NBins; i++)
+    {
+        m_bins[i] = 0;
+    }
+    m_underflow = 0;
+    m_overflow = 0;
+    m_count = 0;
+}
+
+/** @brief  Estimated quantile, the rank is interpolated linearly in its bin. The underflow and the overflow are clamped to the limits.
+ *
+ *  @param f_probability   probability of the quantile in [0,1]
+ *  @return                quantile, the lower limit without samples
+ */
+template <uint16_t NBins, class T>
+T CHistogram<NBins,T>::quantile(T f_probability) const
+{
+    T l_rank = f_probability * static_cast<T>(m_count);
+    T l_cumulated = static_cast<T>(m_underflow);
+    if (m_count == 0 || l_rank <= l_cumulated)
+    {
+        return m_low;
+    }
+    for (uint16_t i = 0; i < NBins; i++)
+    {
+        T l_bin = static_cast<T>(m_bins[i]);
+        if (m_bins[i] > 0 && l_cumulated + l_bin >= l_rank)
+        {
+            return getEdge(i) + m_width * (l_rank - l_cumulated) / l_bin;
+        }
+        l_cumulated += l_bin;
+    }
+    return getEdge(NBins);
+}
+
+}; // namespace utils::stats
+
+#endif // STREAM_STATS_TPP
@@ -0,0 +1,75 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Latest.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the double buffered 
+  *          latest value shared between the execution contexts.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef LATEST_HPP
+#define LATEST_HPP
+
+#include <mbed.h>
+#include <type_traits>
+
+namespace utils::sync{
+
+/**
+ * @brief Latest value of a state, which is written in one execution context and read in others (interrupt, control thread, 
+ * serial threads), without critical section.
+ * 
+ * The value is double buffered with a sequence counter (seqlock): the writer fills the inactive buffer, then it increments 
+ * the sequence, so the buffer becomes active. The reader copies the active buffer and it checks the sequence after the copy. 
+ * When the writer preempted the reader and it wrote at most once, the copied buffer wasn't touched, so the reader of a higher 
+ * priority context never waits and the reader of a lower context repeats the copy only, when the writer overwrote the same 
+ * buffer twice during the copy. 
+ * 
+ * There has to be a single writer context, the writers of different priorities would overwrite each other's buffer.
+ * 
+ * @tparam T The type of the value, it's copied by assignment
+ */
+template <class T>
+class CLatest
+{
+    static_assert(std::is_trivially_copyable<T>::value, "The value has to be trivially copyable.");
+public:
+    /* Constructor */
+    CLatest(const T& f_value = T());
+    /* Publish a new value, it's applied only from the writer context */
+    void write(const T& f_value);
+    /* Copy of the latest value */
+    T read() const;
+    /* Copy of the latest value with its sequence */
+    T read(uint32_t& f_sequence) const;
+    /** @brief Sequence of the latest value, it's incremented by each write */
+    uint32_t getSequence() const {return m_sequence;}
+private:
+    /** @brief Buffers of the value, the active one is selected by the last bit of the sequence */
+    T m_buffers[2];
+    /** @brief Number of the writes */
+    volatile uint32_t m_sequence;
+};
+
+}; // namespace utils::sync
+
+#include "latest.tpp"
+
+#endif // LATEST_HPP
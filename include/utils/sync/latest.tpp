@@ -0,0 +1,95 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Latest.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the double buffered 
+  *          latest value shared between the execution contexts.
+  ******************************************************************************
+ */
+
+#ifndef LATEST_TPP
+#define LATEST_TPP
+
+#ifndef LATEST_HPP
+#error __FILE__ should only be included from latest.hpp.
+#endif // LATEST_HPP
+
+namespace utils::sync{
+
+/** @brief  CLatest class constructor
+ *
+ *  @param f_value          initial value, both buffers are initialized with it
+ */
+template <class T>
+CLatest<T>::CLatest(const T& f_value)
+    : m_buffers{f_value, f_value}
+    , m_sequence(0)
+{
+}
+
+/** @brief  Publish a new value. The inactive buffer is filled, then the sequence is incremented, the barriers keep the order 
+ *  of the memory accesses.
+ *
+ *  @param f_value          new value
+ */
+template <class T>
+void CLatest<T>::write(const T& f_value)
+{
+    uint32_t l_sequence = m_sequence + 1;
+    m_buffers[l_sequence & 1U] = f_value;
+    __DMB();
+    m_sequence = l_sequence;
+}
+
+/** @brief  Copy of the latest value
+ *
+ *  @return                 consistent copy of the last written value
+ */
+template <class T>
+T CLatest<T>::read() const
+{
+    uint32_t l_sequence;
+    return read(l_sequence);
+}
+
+/** @brief  Copy of the latest value with its sequence. The copy is repeated, when the writer wrote more than once during it, 
+ *  so the copied buffer could be overwritten.
+ *
+ *  @param f_sequence       sequence of the returned value
+ *  @return                 consistent copy of the last written value
+ */
+template <class T>
+T CLatest<T>::read(uint32_t& f_sequence) const
+{
+    T l_value;
+    uint32_t l_sequence;
+    do
+    {
+        l_sequence = m_sequence;
+        __DMB();
+        l_value = m_buffers[l_sequence & 1U];
+        __DMB();
+    } while (m_sequence - l_sequence > 1U);
+    f_sequence = l_sequence;
+    return l_value;
+}
+
+}; // namespace utils::sync
+
+#endif // LATEST_TPP
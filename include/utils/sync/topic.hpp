@@ -0,0 +1,142 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Topic.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the typed topic of
+  *          the publish/subscribe bus.
+  ******************************************************************************
+ */
+
+/* Include guard */
+#ifndef TOPIC_HPP
+#define TOPIC_HPP
+
+#include <mbed.h>
+#include <type_traits>
+#include <utils/taskmanager/taskmanager.hpp>
+
+namespace utils::sync{
+
+/**
+ * @brief Typed topic of the publish/subscribe bus, a single publisher writes the messages once in place and any number of readers
+ * access them by reference, so the fan-out to the consumers doesn't copy the message.
+ *
+ * The messages are kept in a ring of fixed slots with a sequence counter: the publisher fills the slot of the next message (claim)
+ * and it increments the sequence (publish). A message read by reference stays intact, until the publisher has written 'NSlots - 1'
+ * newer messages, the readers check it after the use (isValid), like the sequence check of CLatest. The consumers don't have to be
+ * known by the publisher, they can poll the topic with their own reader (CReader) or they can subscribe to it. The subscribed tasks
+ * are notified, so they read the message in the context of their own scheduler, the subscribed callbacks are applied synchronously
+ * from the publisher context (e.g. the safety reactions).
+ *
+ * There has to be a single publisher context. The subscriptions have to be made before the publishing starts.
+ *
+ * @tparam T            The type of the message, it's trivially copyable
+ * @tparam NSlots       Number of the message slots, a power of two, at least two
+ * @tparam NSubscribers Maximum number of the subscribed tasks and of the subscribed callbacks
+ */
+template <class T, uint8_t NSlots = 4, uint8_t NSubscribers = 4>
+class CTopic
+{
+    static_assert(std::is_trivially_copyable<T>::value, "The message has to be trivially copyable.");
+    static_assert(NSlots >= 2 && (NSlots & (NSlots - 1)) == 0, "The number of the slots has to be a power of two.");
+public:
+    /** @brief Callback of a subscriber, applied from the publisher context */
+    typedef mbed::Callback<void(const T&)> FSubscriber;
+
+    /**
+     * @brief Reader of a consumer, it follows the messages of the topic and it counts the messages, which it skipped.
+     */
+    class CReader
+    {
+    public:
+        /* Constructor */
+        CReader(const CTopic& f_topic);
+        /* Step to the latest message */
+        bool poll();
+        /** @brief Message of the last poll by reference, before the first message the default value */
+        const T& get() const {return m_topic.slot(m_sequence);}
+        /** @brief The message of the last poll wasn't overwritten yet, it's checked after the use of the reference */
+        bool isValid() const {return m_topic.isValid(m_sequence);}
+        /** @brief Sequence of the message of the last poll */
+        uint32_t getSequence() const {return m_sequence;}
+        /** @brief Number of the messages skipped between the polls */
+        uint32_t getMissed() const {return m_missed;}
+    private:
+        /** @brief Followed topic */
+        const CTopic& m_topic;
+        /** @brief Sequence of the message of the last poll */
+        uint32_t m_sequence;
+        /** @brief Number of the skipped messages */
+        uint32_t m_missed;
+    };
+
+    /* Constructor */
+    CTopic(const T& f_value = T());
+    /** @brief Slot of the next message, it's filled in place by the publisher before 'publish' */
+    T& claim() {return m_slots[(m_sequence + 1U) & s_slotMask];}
+    /* Publish the claimed message and notify the subscribers */
+    void publish();
+    /* Copy the message to the next slot and publish it */
+    void publish(const T& f_value);
+    /* Subscribe a task, it's notified by each message */
+    bool subscribe(utils::task::CTask& f_task);
+    /* Subscribe a callback, it's applied with each message */
+    bool subscribe(FSubscriber f_callback);
+    /* Copy of the latest message */
+    T read() const;
+    /** @brief Latest message by reference with its sequence, it's checked after the use by 'isValid' */
+    const T& latest(uint32_t& f_sequence) const
+    {
+        f_sequence = m_sequence;
+        __DMB();
+        return slot(f_sequence);
+    }
+    /** @brief The message of the sequence wasn't overwritten, the publisher can't be writing its slot */
+    bool isValid(uint32_t f_sequence) const
+    {
+        __DMB();
+        return m_sequence - f_sequence + 2U <= NSlots;
+    }
+    /** @brief Sequence of the latest message, it's incremented by each publishing */
+    uint32_t getSequence() const {return m_sequence;}
+private:
+    /** @brief Mask of the slot index */
+    static const uint32_t s_slotMask = NSlots - 1U;
+    /** @brief Slot of the message with the given sequence */
+    const T& slot(uint32_t f_sequence) const {return m_slots[f_sequence & s_slotMask];}
+
+    /** @brief Slots of the messages, the message of sequence 's' is in the slot 's mod NSlots' */
+    T m_slots[NSlots];
+    /** @brief Number of the published messages */
+    volatile uint32_t m_sequence;
+    /** @brief Subscribed tasks */
+    utils::task::CTask* m_tasks[NSubscribers];
+    /** @brief Number of the subscribed tasks */
+    uint8_t m_taskCount;
+    /** @brief Subscribed callbacks */
+    FSubscriber m_callbacks[NSubscribers];
+    /** @brief Number of the subscribed callbacks */
+    uint8_t m_callbackCount;
+};
+
+}; // namespace utils::sync
+
+#include "topic.tpp"
+
+#endif // TOPIC_HPP
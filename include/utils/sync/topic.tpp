@@ -0,0 +1,163 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Topic.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the typed topic of
+  *          the publish/subscribe bus.
+  ******************************************************************************
+ */
+
+#ifndef TOPIC_TPP
+#define TOPIC_TPP
+
+#ifndef TOPIC_HPP
+#error __FILE__ should only be included from topic.hpp.
+#endif // TOPIC_HPP
+
+namespace utils::sync{
+
+/** @brief  CReader class constructor, the reader starts at the latest message, so the first poll returns only a newer one.
+ *
+ *  @param f_topic          followed topic
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+CTopic<T,NSlots,NSubscribers>::CReader::CReader(const CTopic& f_topic)
+    : m_topic(f_topic)
+    , m_sequence(f_topic.getSequence())
+    , m_missed(0)
+{
+}
+
+/** @brief  Step to the latest message, the messages published since the previous poll except the latest are counted as missed.
+ *
+ *  @return                 true, when a new message was published
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+bool CTopic<T,NSlots,NSubscribers>::CReader::poll()
+{
+    uint32_t l_sequence = m_topic.getSequence();
+    if (l_sequence == m_sequence)
+    {
+        return false;
+    }
+    m_missed += l_sequence - m_sequence - 1U;
+    m_sequence = l_sequence;
+    return true;
+}
+
+/** @brief  CTopic class constructor
+ *
+ *  @param f_value          initial value of the slots, it's read before the first message
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+CTopic<T,NSlots,NSubscribers>::CTopic(const T& f_value)
+    : m_sequence(0)
+    , m_tasks()
+    , m_taskCount(0)
+    , m_callbacks()
+    , m_callbackCount(0)
+{
+    for (uint8_t i = 0; i < NSlots; i++)
+    {
+        m_slots[i] = f_value;
+    }
+}
+
+/** @brief  Publish the claimed message, the barrier keeps the order of the slot writes before the sequence. The subscribed callbacks
+ *  get the message by reference, the subscribed tasks are notified.
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+void CTopic<T,NSlots,NSubscribers>::publish()
+{
+    uint32_t l_sequence = m_sequence + 1U;
+    __DMB();
+    m_sequence = l_sequence;
+    const T& l_message = slot(l_sequence);
+    for (uint8_t i = 0; i < m_callbackCount; i++)
+    {
+        m_callbacks[i](l_message);
+    }
+    for (uint8_t i = 0; i < m_taskCount; i++)
+    {
+        m_tasks[i]->Notify();
+    }
+}
+
+/** @brief  Copy the message to the next slot and publish it, for the publishers, which don't build the message in place.
+ *
+ *  @param f_value          message
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+void CTopic<T,NSlots,NSubscribers>::publish(const T& f_value)
+{
+    claim() = f_value;
+    publish();
+}
+
+/** @brief  Subscribe a task, it's notified by each message and it reads the topic in the context of its scheduler.
+ *
+ *  @param f_task           subscriber task
+ *  @return                 false, when the subscribed tasks are full
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+bool CTopic<T,NSlots,NSubscribers>::subscribe(utils::task::CTask& f_task)
+{
+    if (m_taskCount >= NSubscribers)
+    {
+        return false;
+    }
+    m_tasks[m_taskCount++] = &f_task;
+    return true;
+}
+
+/** @brief  Subscribe a callback, it's applied with each message from the publisher context, so it has to be short.
+ *
+ *  @param f_callback       subscriber callback
+ *  @return                 false, when the subscribed callbacks are full
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+bool CTopic<T,NSlots,NSubscribers>::subscribe(FSubscriber f_callback)
+{
+    if (m_callbackCount >= NSubscribers)
+    {
+        return false;
+    }
+    m_callbacks[m_callbackCount++] = f_callback;
+    return true;
+}
+
+/** @brief  Copy of the latest message, the copy is repeated, when the publisher reached its slot during the copy.
+ *
+ *  @return                 consistent copy of the latest message
+ */
+template <class T, uint8_t NSlots, uint8_t NSubscribers>
+T CTopic<T,NSlots,NSubscribers>::read() const
+{
+    T l_value;
+    uint32_t l_sequence;
+    do
+    {
+        l_value = latest(l_sequence);
+    } while (!isValid(l_sequence));
+    return l_value;
+}
+
+}; // namespace utils::sync
+
+#endif // TOPIC_TPP
@@ -0,0 +1,106 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    LoadMonitor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the CPU load and stack 
+  *          headroom monitor.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef LOAD_MONITOR_HPP
+#define LOAD_MONITOR_HPP
+
+#include <mbed.h>
+#include <rtos.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/taskstatistics.hpp>
+#include <utils/memory/memoryreport.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief It measures the CPU utilization of the idle thread and of the control loop interrupt and the stack headroom of the threads.
+    * 
+    * The idle time is measured by the idle hook of the RTOS with the DWT cycle counter: the gaps between the consecutive calls of the 
+    * hook are summed up, when they are shorter than a threshold, the longer gaps contain the execution of the threads or of the interrupts. 
+    * The hook replaces the sleep of the idle thread, the core is put in sleep mode (WFI) only when it's enabled by 'setSleep', the time 
+    * of the sleep is counted as idle, the waking interrupt is applied after the measurement. The interrupt time 
+    * is given by the cycles of the control loop interrupt, the rest of the interrupts is counted to the threads. The task computes the 
+    * utilization over its period and it samples the free stack of the threads listed in the memory report. 
+    * 
+    * The request '#LOAD:;;' returns 'cpu;isr;isrMax;free0;free1;...;;', the utilization of the last period in percent, the maximum 
+    * execution time of the control loop interrupt in microseconds and the minimum free stack of each thread in bytes.
+    */
+    class CLoadMonitor: public CTask
+    {
+    public:
+        /** @brief  Getter of the cycles spent by the measured interrupt since the previous call */
+        typedef mbed::Callback<uint32_t()> FCycleGetter;
+        /* Constructor */
+        CLoadMonitor(uint32_t f_period, FCycleGetter f_isrCycles, FCycleGetter f_isrMaxCycles, utils::memory::CMemoryReport& f_report);
+        /* Attach the idle hook */
+        void start();
+        /* Enable the sleep of the idle thread */
+        static void setSleep(bool f_enable);
+        /** @brief  The idle thread puts the core in sleep mode */
+        static bool isSleeping()
+        {
+            return s_isSleeping;
+        }
+        /* Serial callback */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Maximum number of the monitored threads */
+        static const uint32_t s_maxStacks = 4;
+    private:
+        /* Run method */
+        virtual void _run();
+        /* Idle hook of the RTOS */
+        static void idleHook();
+
+        /** @brief  Maximum gap between the calls of the idle hook, which is counted as idle time, in cycles */
+        static const uint32_t s_idleGap = 500;
+        /** @brief  Idle cycles since the start */
+        static volatile uint32_t s_idleCycles;
+        /** @brief  Cycle counter at the previous call of the idle hook */
+        static uint32_t s_lastIdle;
+        /** @brief  The idle hook puts the core in sleep mode */
+        static volatile bool s_isSleeping;
+
+        /** @brief  Getter of the interrupt cycles */
+        FCycleGetter m_isrCycles;
+        /** @brief  Getter of the maximum cycles of the interrupt */
+        FCycleGetter m_isrMaxCycles;
+        /** @brief  Memory report with the list of the threads */
+        utils::memory::CMemoryReport& m_report;
+        /** @brief  Cycle counter at the previous period */
+        uint32_t m_lastCycles;
+        /** @brief  Idle cycles at the previous period */
+        uint32_t m_lastIdleCycles;
+        /** @brief  CPU utilization in the last period in percent */
+        volatile float m_cpu;
+        /** @brief  Interrupt utilization in the last period in percent */
+        volatile float m_isr;
+        /** @brief  Minimum free stack of the threads in bytes */
+        volatile uint32_t m_freeStack[s_maxStacks];
+    };
+
+}; // namespace utils::task
+
+#endif
@@ -0,0 +1,82 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    PriorityTaskManager.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the priority task manager.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef PRIORITY_TASK_MANAGER_HPP
+#define PRIORITY_TASK_MANAGER_HPP
+
+#include <mbed.h>
+#include <rtos.h>
+#include <utils/taskmanager/taskmanager.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief It implements a preemptive version of the task manager. 
+    * 
+    * Each priority class has its own ready mask and its own thread. The background tasks are applied by the thread, which calls the main callback, 
+    * the normal and the real-time tasks are applied by two separate threads with higher RTOS priority. So a task of a higher class preempts 
+    * the tasks of the lower classes, when it's triggered. The tasks with the same priority class are applied cooperatively as in the task manager.
+    */
+    class CPriorityTaskManager: public CTaskManager
+    {
+    public:
+        /* Constructor */
+        CPriorityTaskManager(CTask** f_taskList, uint32_t f_taskCount, float f_baseFreq, uint32_t f_stackSize = s_defaultStackSize, unsigned char* f_stackMemory = NULL);
+        /* Destructor */
+        virtual ~CPriorityTaskManager();
+        /* Start the threads of the priority classes */
+        void start();
+        /* The main callback method aims to apply the background tasks' run method. */
+        virtual void mainCallback();
+        /* Mark the tasks in the ready mask and wake up the threads of their priority classes. */
+        virtual void notify(uint32_t f_readyMask);
+        /* Thread of a priority class */
+        Thread* getThread(EPriorityClass f_class);
+        /** @brief  Default stack size of the class' threads in bytes */
+        static const uint32_t s_defaultStackSize = 2048;
+    private:
+        /** @brief  Context of a priority class */
+        struct SPriorityClass{
+            /** @brief  owner task manager */
+            CPriorityTaskManager* m_manager;
+            /** @brief  bits of the class' tasks in the ready mask */
+            uint32_t m_mask;
+            /** @brief  identifier of the thread, which applies the class' tasks */
+            osThreadId volatile m_threadId;
+        };
+        /* Thread function of a priority class */
+        static void classThread(SPriorityClass* f_class);
+
+        /** @brief  Contexts of the priority classes */
+        SPriorityClass m_classes[g_priorityClassCount];
+        /** @brief  Thread of the normal tasks */
+        Thread m_normalThread;
+        /** @brief  Thread of the real-time tasks */
+        Thread m_realtimeThread;
+    };
+
+}; // namespace utils::task
+
+#endif
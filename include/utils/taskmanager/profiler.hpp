@@ -0,0 +1,108 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Profiler.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the statistical 
+  *          sampling profiler.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SAMPLING_PROFILER_HPP
+#define SAMPLING_PROFILER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief Statistical profiler of the whole firmware, it counts the sampled program counters (hardware::drivers::CPcSampler_TIM11) 
+    * in a histogram of address ranges.
+    * 
+    * The histogram has s_bucketCount buckets of 2^shift bytes from the base address, the samples outside of it are counted separately. 
+    * The default covers the full flash with 1 kB buckets, a smaller shift and a base address zoom into a region (for example the 
+    * '.ramfunc' section in RAM). The histogram is dumped in binary frames (utils::serial::BIN_PROFILE), the addresses are mapped 
+    * to the symbols of the elf file by the host. Unlike the task statistics, the interrupt handlers, the library and the idle thread 
+    * are also measured.
+    * 
+    * Commands of the 'PROF' key: '0' state ('running;samples;outside;base;shift'), '1;frequency;shift;base' start with a cleared 
+    * histogram (the parameters are optional, the base is hexadecimal), '2' stop, '3' stop and dump.
+    */
+    class CProfiler: public CTask
+    {
+    public:
+        /** @brief  Number of the buckets of the histogram */
+        static const uint32_t s_bucketCount = 512;
+        /** @brief  Number of the buckets in a dumped frame */
+        static const uint32_t s_frameBuckets = (utils::serial::CBinaryProtocol::s_maxPayloadSize - sizeof(utils::serial::SProfileHeader)) / sizeof(uint32_t);
+        /** @brief  Default sampling frequency in Hz, it isn't a multiple of the control frequency */
+        static constexpr float s_defaultFrequency = 9973.0f;
+        /** @brief  Default size of the buckets, 1 kB */
+        static const uint32_t s_defaultShift = 10;
+
+        /* Constructor */
+        CProfiler(utils::serial::CSerialTransmitter& f_serial, uint32_t f_dumpPeriod);
+        /* Start the sampling */
+        bool start(float f_frequency, uint32_t f_shift, uint32_t f_base);
+        /* Stop the sampling */
+        void stop();
+        /* Stop the sampling and start the dump */
+        bool dump();
+        /** @brief  Number of the samples */
+        uint32_t getSamples() const
+        {
+            return m_samples;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, it sends the frames of the dump */
+        virtual void _run();
+        /* Hook of the sampler */
+        static void sampleHook(uint32_t f_pc);
+
+        /** @brief  The active profiler */
+        static CProfiler* s_instance;
+
+        /** @brief  Serial transmitter */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Period of the task during the dump in base ticks */
+        const uint32_t m_dumpPeriod;
+        /** @brief  Start address of the histogram */
+        uint32_t m_base;
+        /** @brief  Size of the buckets in bits */
+        uint32_t m_shift;
+        /** @brief  Number of the samples */
+        volatile uint32_t m_samples;
+        /** @brief  Number of the samples outside of the histogram */
+        volatile uint32_t m_outside;
+        /** @brief  Counters of the buckets */
+        uint32_t m_buckets[s_bucketCount];
+        /** @brief  The dump is in progress */
+        volatile bool m_isDumping;
+        /** @brief  Index of the next dumped bucket */
+        uint32_t m_dumpIdx;
+    };
+
+}; // namespace utils::task
+
+#endif // SAMPLING_PROFILER_HPP
@@ -0,0 +1,130 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    Schedulability.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the schedulability
+  *          analysis of the task list.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SCHEDULABILITY_HPP
+#define SCHEDULABILITY_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/taskstatistics.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief It checks, whether the task list fits in the CPU with the measured execution times, by the response-time analysis.
+    *
+    * The worst-case execution time of a task is the maximum of its statistics, the deadline is its period, the tasks with zero period
+    * (event driven) are analysed with the given minimal inter-arrival time. The control loop preempts all tasks, the higher priority
+    * classes preempt the lower ones and the tasks of the same class are applied cooperatively, so each task of the same class can delay
+    * the analysed task once in each of its periods. The response time is the fixed point of
+    *   R = C + Cisr * ceil(R / Tisr) + sum_j Cj * ceil(R / Tj),
+    * where j runs over the tasks of the same and of the higher classes, the task is unschedulable, when R exceeds its deadline.
+    * The measured execution includes the preemptions, so the analysis is pessimistic. The total utilization is compared with the
+    * rate-monotonic (Liu-Layland) bound, below the bound the list is schedulable by any priority order.
+    *
+    * The task is triggered once after the warm-up at boot and by the request '#SCHD:-1;;' (answered by 'ack;;'), the result is sent as
+    * '@SCHD:util;bound;failed;;' (utilization and bound in percent, number of unschedulable tasks), each unschedulable task is reported
+    * on the safety lane as '@SCHD:idx;response;deadline;;'. The request '#SCHD:idx;;' returns the last result of a task in microseconds:
+    * 'idx;class;period;wcet;response;state;;', the state is 'ok', 'miss', 'unmeasured' or 'off'.
+    */
+    class CSchedulability: public CTask
+    {
+    public:
+        /** @brief  Getter of the worst-case cycles of the control loop */
+        typedef mbed::Callback<uint32_t()> FCycleGetter;
+        /** @brief  Result of a task */
+        enum EState{
+            /** @brief The task is disabled, it isn't analysed. */
+            STATE_OFF,
+            /** @brief The task wasn't applied yet, its execution time is unknown. */
+            STATE_UNMEASURED,
+            /** @brief The response time is within the deadline. */
+            STATE_OK,
+            /** @brief The response time exceeds the deadline. */
+            STATE_MISS
+        };
+        /* Constructor */
+        CSchedulability(CTask** f_taskList, CTaskStatistics* f_statisticsList, uint32_t f_taskCount, float f_baseTick, uint32_t f_sporadicPeriod
+                       , float f_isrPeriod, FCycleGetter f_isrMaxCycles, utils::serial::CSerialTransmitter& f_transmitter);
+        /* Apply the analysis */
+        uint32_t analyse();
+        /** @brief  All analysed tasks meet their deadline in the last analysis */
+        bool isSchedulable() const
+        {
+            return 0 == m_failed;
+        }
+        /* Serial callback */
+        void serialCallback(char const * a, char * b);
+        /** @brief  Maximum number of the analysed tasks */
+        static const uint32_t s_maxTasks = 32;
+    private:
+        /* Run method */
+        virtual void _run();
+        /* Response time of a task */
+        uint32_t response(uint32_t f_idx) const;
+        /* Convert the cycles to microseconds, rounded up */
+        static uint32_t cycles2us(uint32_t f_cycles);
+
+        /** @brief  Result of the analysis of a task, in microseconds */
+        struct SResult
+        {
+            uint32_t m_period;      /**< period, it's the deadline */
+            uint32_t m_wcet;        /**< worst-case execution time */
+            uint32_t m_response;    /**< worst-case response time */
+            EState   m_state;       /**< result */
+        };
+        /** @brief  List of tasks  */
+        CTask** m_taskList;
+        /** @brief  List of statistics, one for each task  */
+        CTaskStatistics* m_statisticsList;
+        /** @brief  Number of analysed tasks  */
+        uint32_t m_taskCount;
+        /** @brief  Base tick in microseconds */
+        float m_baseTick_us;
+        /** @brief  Minimal inter-arrival time of the event driven tasks in base ticks */
+        uint32_t m_sporadicPeriod;
+        /** @brief  Period of the control loop in microseconds, zero without control loop */
+        uint32_t m_isrPeriod;
+        /** @brief  Getter of the worst-case cycles of the control loop */
+        FCycleGetter m_isrMaxCycles;
+        /** @brief  Transmitter of the results */
+        utils::serial::CSerialTransmitter& m_transmitter;
+        /** @brief  Results of the tasks */
+        SResult m_results[s_maxTasks];
+        /** @brief  Worst-case execution time of the control loop in microseconds */
+        uint32_t m_isrWcet;
+        /** @brief  Total utilization in percent */
+        float m_utilization;
+        /** @brief  Rate-monotonic utilization bound in percent */
+        float m_bound;
+        /** @brief  Number of the unschedulable tasks */
+        volatile uint32_t m_failed;
+    };
+
+}; // namespace utils::task
+
+#endif // SCHEDULABILITY_HPP
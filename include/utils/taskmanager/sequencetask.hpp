@@ -0,0 +1,158 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    SequenceTask.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the stackless
+  *          sequences and the sequence task.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SEQUENCE_TASK_HPP
+#define SEQUENCE_TASK_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief Resume state of a stackless sequence (protothread), a multi-step behaviour is written linearly with waits and it costs
+    * eight bytes instead of the stack of a thread.
+    *
+    * The body of the sequence is a void function between SEQUENCE_BEGIN and SEQUENCE_END, each step of its owner resumes it after the
+    * last wait: SEQUENCE_AWAIT_TICKS waits for steps, SEQUENCE_AWAIT_EVENT for the bits posted from any context (thread, interrupt),
+    * SEQUENCE_AWAIT_UNTIL for a condition. The local variables of the body don't survive a wait, the values kept over a wait are
+    * members of the owner, and a wait can't be placed in the scope of an initialized local variable nor twice on the same line.
+    * A new sequence is idle until it's restarted.
+    */
+    class CSequence
+    {
+    public:
+        /** @brief  Resume point of the idle sequence */
+        static const uint16_t s_idle = 0xFFFF;
+
+        /** @brief  Constructor, the sequence is idle */
+        CSequence()
+            : m_resume(s_idle)
+            , m_waitTicks(0)
+            , m_events(0)
+        {
+        }
+        /** @brief  Start the sequence from its beginning at the next resume, the posted events are dropped */
+        void restart()
+        {
+            m_resume = 0;
+            m_waitTicks = 0;
+            m_events = 0;
+        }
+        /** @brief  Stop the sequence, it's idle until the next restart */
+        void stop()
+        {
+            m_resume = s_idle;
+        }
+        /** @brief  The sequence is started and it didn't reach its end */
+        bool isRunning() const
+        {
+            return s_idle != m_resume;
+        }
+        /** @brief  Count a step of the owner, it's applied before each resume */
+        void tick()
+        {
+            if (m_waitTicks > 0)
+            {
+                --m_waitTicks;
+            }
+        }
+        /* Post events to the sequence */
+        void post(uint32_t f_events);
+        /* Take the posted events of the mask */
+        bool take(uint32_t f_mask);
+
+        /** @brief  Point of the body to resume, it's applied by the macros */
+        uint16_t resumePoint() const
+        {
+            return m_resume;
+        }
+        /** @brief  Suspend the body at the point for the given steps, it's applied by the macros */
+        void suspend(uint16_t f_point, uint16_t f_ticks)
+        {
+            m_resume = f_point;
+            m_waitTicks = f_ticks;
+        }
+        /** @brief  The steps of the last wait didn't elapse, it's applied by the macros */
+        bool isWaiting() const
+        {
+            return m_waitTicks > 0;
+        }
+    private:
+        /** @brief  Line of the last wait in the body, zero at the beginning */
+        uint16_t m_resume;
+        /** @brief  Remaining steps of the last wait */
+        uint16_t m_waitTicks;
+        /** @brief  Posted and not taken events */
+        volatile uint32_t m_events;
+    };
+
+   /**
+    * @brief Task of a stackless sequence, it's scheduled by the task managers like the other tasks, each period of the task is a step
+    * of the sequence. A task with zero period is resumed only by the posted events.
+    */
+    class CSequenceTask: public CTask
+    {
+    public:
+        /* Constructor */
+        CSequenceTask(uint32_t f_period, EPriorityClass f_priorityClass = NORMAL);
+        /* Start the sequence from its beginning */
+        void start();
+        /* Post events to the sequence */
+        void post(uint32_t f_events);
+        /** @brief  The sequence is started and it didn't reach its end */
+        bool isRunning() const
+        {
+            return m_sequence.isRunning();
+        }
+    protected:
+        /** @brief  Body of the sequence between SEQUENCE_BEGIN(m_sequence) and SEQUENCE_END(m_sequence) */
+        virtual void _sequence() = 0;
+        /** @brief  Resume state of the sequence */
+        CSequence m_sequence;
+    private:
+        /* Run method */
+        void _run();
+    };
+
+}; // namespace utils::task
+
+/** @brief  Beginning of the body of the sequence, it jumps to the last wait */
+#define SEQUENCE_BEGIN(seq)                 switch ((seq).resumePoint()) { case 0:
+/** @brief  Wait for the given number of steps, zero doesn't wait */
+#define SEQUENCE_AWAIT_TICKS(seq, ticks)    do { (seq).suspend(__LINE__, (ticks)); case __LINE__: if ((seq).isWaiting()) return; } while (0)
+/** @brief  Wait until the condition is true, it's evaluated in each step */
+#define SEQUENCE_AWAIT_UNTIL(seq, cond)     do { (seq).suspend(__LINE__, 0); case __LINE__: if (!(cond)) return; } while (0)
+/** @brief  Wait for an event of the mask, it's taken */
+#define SEQUENCE_AWAIT_EVENT(seq, events)   SEQUENCE_AWAIT_UNTIL(seq, (seq).take(events))
+/** @brief  Continue in the next step */
+#define SEQUENCE_YIELD(seq)                 SEQUENCE_AWAIT_TICKS(seq, 1)
+/** @brief  Leave the sequence before its end, it's idle */
+#define SEQUENCE_EXIT(seq)                  do { (seq).stop(); return; } while (0)
+/** @brief  End of the body of the sequence, it's idle */
+#define SEQUENCE_END(seq)                   } (seq).stop()
+
+#endif // SEQUENCE_TASK_HPP
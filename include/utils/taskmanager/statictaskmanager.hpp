@@ -0,0 +1,100 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StaticTaskManager.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the static task manager.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef STATIC_TASK_MANAGER_HPP
+#define STATIC_TASK_MANAGER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief It implements a task manager with a compile-time task table. 
+    * 
+    * The periods of the tasks are given as template parameters in base ticks, in the order of the task list. The table is computed 
+    * at compile time: the ticker period is the greatest common divisor of the periods and the table has one bitmask of the due tasks 
+    * for each slot of the hyperperiod (least common multiple of the periods). So the interrupt is a single table lookup and a bitmask OR, 
+    * independently of the number of tasks. The tasks with zero period aren't in the table, they are applied, when they are notified.
+    * 
+    * The table is a cyclic executive: the slots are the minor frames and the phases of the tasks are chosen at compile time, so the 
+    * tasks are spread over the frames with balanced load (e.g. the 5000 tick task doesn't share its frame with the other 5000 tick 
+    * tasks). The set of the tasks in a frame is fixed, so their start jitter is deterministic.
+    * 
+    * Usage: 
+    * \code{.cpp}
+    * utils::task::CStaticTaskManager<5000,0,100> g_taskManager(g_taskList, g_baseTick);
+    * \endcode
+    */
+    template<uint32_t... Periods>
+    class CStaticTaskManager: public CTaskScheduler
+    {
+    public:
+        /** @brief  Number of tasks */
+        static constexpr uint32_t s_taskCount = sizeof...(Periods);
+        static_assert(s_taskCount > 0 && s_taskCount <= 31, "The static task manager supports between 1 and 31 tasks.");
+
+        /* Constructor */
+        CStaticTaskManager(CTask* (&f_taskList)[s_taskCount], float f_baseTick);
+        /* Destructor */
+        virtual ~CStaticTaskManager();
+        /* The main callback method aims to apply the due tasks' run method. */
+        virtual void mainCallback();
+    private:
+        /** @brief  Table of the due tasks, one bitmask for each slot */
+        template<uint32_t N>
+        struct STable{
+            uint32_t m_masks[N];
+        };
+        /* Greatest common divisor */
+        static constexpr uint32_t gcd(uint32_t f_a, uint32_t f_b);
+        /* Greatest common divisor of the non zero periods */
+        static constexpr uint32_t periodGcd();
+        /* Hyperperiod of the non zero periods */
+        static constexpr uint32_t hyperPeriod();
+        /** @brief  Ticker period in base ticks */
+        static constexpr uint32_t s_tickPeriod = periodGcd();
+        /** @brief  Number of slots in the hyperperiod */
+        static constexpr uint32_t s_slotCount = hyperPeriod() / s_tickPeriod;
+        static_assert(s_slotCount <= 4096, "The hyperperiod of the tasks is too long for the static task table.");
+        /* Create the table */
+        static constexpr STable<s_slotCount> createTable();
+        /** @brief  Precomputed table */
+        static constexpr STable<s_slotCount> s_table = createTable();
+
+        /* Timer callback, it marks the tasks of the current slot */
+        void timerCallback();
+
+        /** @brief  Current slot  */
+        uint32_t m_slot;
+        /** @brief  Ticker for periodic applying the timer callback function  */
+        Ticker m_ticker;
+    };
+
+}; // namespace utils::task
+
+#include "statictaskmanager.tpp"
+
+#endif
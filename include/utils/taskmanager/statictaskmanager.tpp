@@ -0,0 +1,209 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    StaticTaskManager.tpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the static task manager.
+  ******************************************************************************
+ */
+
+#ifndef STATIC_TASK_MANAGER_TPP
+#define STATIC_TASK_MANAGER_TPP
+
+#ifndef STATIC_TASK_MANAGER_HPP
+#error __FILE__ should only be included from statictaskmanager.hpp.
+#endif // STATIC_TASK_MANAGER_HPP
+
+namespace utils::task{
+
+    template<uint32_t... Periods>
+    constexpr typename CStaticTaskManager<Periods...>::template STable<CStaticTaskManager<Periods...>::s_slotCount> CStaticTaskManager<Periods...>::s_table;
+
+    /** \brief  Greatest common divisor
+     *
+     *  @param f_a             first value
+     *  @param f_b             second value
+     *  @return                greatest common divisor, zero values are ignored
+     */
+    template<uint32_t... Periods>
+    constexpr uint32_t CStaticTaskManager<Periods...>::gcd(uint32_t f_a, uint32_t f_b)
+    {
+        while (f_b != 0)
+        {
+            uint32_t l_r = f_a % f_b;
+            f_a = f_b;
+            f_b = l_r;
+        }
+        return f_a;
+    }
+
+    /** \brief  Greatest common divisor of the non zero periods, it's one, when all periods are zero.
+     *
+     */
+    template<uint32_t... Periods>
+    constexpr uint32_t CStaticTaskManager<Periods...>::periodGcd()
+    {
+        const uint32_t l_periods[] = {Periods...};
+        uint32_t l_gcd = 0;
+        for(uint32_t i = 0; i < s_taskCount; i++)
+        {
+            l_gcd = gcd(l_gcd, l_periods[i]);
+        }
+        return (l_gcd == 0) ? 1 : l_gcd;
+    }
+
+    /** \brief  Hyperperiod (least common multiple) of the non zero periods, it's one, when all periods are zero.
+     *
+     */
+    template<uint32_t... Periods>
+    constexpr uint32_t CStaticTaskManager<Periods...>::hyperPeriod()
+    {
+        const uint32_t l_periods[] = {Periods...};
+        uint32_t l_lcm = 1;
+        for(uint32_t i = 0; i < s_taskCount; i++)
+        {
+            if (l_periods[i] != 0)
+            {
+                l_lcm = l_lcm / gcd(l_lcm, l_periods[i]) * l_periods[i];
+            }
+        }
+        return l_lcm;
+    }
+
+    /** \brief  Create the table of the due tasks
+     *
+     *  The slot j corresponds to the tick (j+1)*s_tickPeriod. The tasks are laid out from the shortest period, each task gets the phase 
+     *  (in slots), whose slots have the lowest maximal load, the equal maxima are decided by the lower total load. A task with period 
+     *  of p slots and phase o is due in the slots congruent to p-1+o modulo p, so the zero phase gives the multiples of the period.
+     */
+    template<uint32_t... Periods>
+    constexpr typename CStaticTaskManager<Periods...>::template STable<CStaticTaskManager<Periods...>::s_slotCount> CStaticTaskManager<Periods...>::createTable()
+    {
+        const uint32_t l_periods[] = {Periods...};
+        STable<s_slotCount> l_table = {{0}};
+        uint8_t l_load[s_slotCount] = {0};
+        bool l_placed[s_taskCount] = {false};
+        while (true)
+        {
+            uint32_t l_next = s_taskCount;
+            for(uint32_t i = 0; i < s_taskCount; i++)
+            {
+                if (!l_placed[i] && l_periods[i] != 0 && (l_next == s_taskCount || l_periods[i] < l_periods[l_next]))
+                {
+                    l_next = i;
+                }
+            }
+            if (l_next == s_taskCount)
+            {
+                break;
+            }
+            uint32_t l_slots = l_periods[l_next] / s_tickPeriod;
+            uint32_t l_phase = 0;
+            uint32_t l_bestMax = 0xFFFFFFFF;
+            uint32_t l_bestSum = 0xFFFFFFFF;
+            for(uint32_t l_offset = 0; l_offset < l_slots; l_offset++)
+            {
+                uint32_t l_max = 0;
+                uint32_t l_sum = 0;
+                for(uint32_t j = (l_slots - 1 + l_offset) % l_slots; j < s_slotCount; j += l_slots)
+                {
+                    l_max = (l_load[j] > l_max) ? l_load[j] : l_max;
+                    l_sum += l_load[j];
+                }
+                if (l_max < l_bestMax || (l_max == l_bestMax && l_sum < l_bestSum))
+                {
+                    l_bestMax = l_max;
+                    l_bestSum = l_sum;
+                    l_phase = l_offset;
+                }
+            }
+            for(uint32_t j = (l_slots - 1 + l_phase) % l_slots; j < s_slotCount; j += l_slots)
+            {
+                l_load[j]++;
+                l_table.m_masks[j] |= (1UL << l_next);
+            }
+            l_placed[l_next] = true;
+        }
+        return l_table;
+    }
+
+    /** \brief  CStaticTaskManager class constructor
+     *
+     *  @param f_taskList      list of tasks, in the order of the template parameters
+     *  @param f_baseTick      base tick in seconds
+     */
+    template<uint32_t... Periods>
+    CStaticTaskManager<Periods...>::CStaticTaskManager(CTask* (&f_taskList)[s_taskCount], float f_baseTick)
+        : CTaskScheduler(f_taskList, s_taskCount)
+        , m_slot(0)
+    {
+        m_ticker.attach(mbed::callback(this,&CStaticTaskManager<Periods...>::timerCallback), f_baseTick * s_tickPeriod);
+    }
+
+    /** \brief  CStaticTaskManager class destructor
+     *  
+     */
+    template<uint32_t... Periods>
+    CStaticTaskManager<Periods...>::~CStaticTaskManager()
+    {
+        m_ticker.detach();
+    }
+
+    /** \brief  Timer callback
+     *  
+     *  It marks the due tasks of the current slot in the ready mask and it steps to the next slot. 
+     */
+    template<uint32_t... Periods>
+    void CStaticTaskManager<Periods...>::timerCallback()
+    {
+        uint32_t l_mask = s_table.m_masks[m_slot];
+        if (++m_slot == s_slotCount)
+        {
+            m_slot = 0;
+        }
+        if (l_mask)
+        {
+            notify(l_mask);
+        }
+    }
+
+    /** \brief  The main callback method aims to apply the due tasks' run method.
+     *  
+     *  It blocks the calling thread until at least one task is ready, then it triggers and applies only the ready tasks. 
+     *  The periodic tasks are triggered here and not in the interrupt, so the interrupt doesn't depend on the number of tasks. 
+     *  The notified tasks are already triggered by their event source.
+     */
+    template<uint32_t... Periods>
+    void CStaticTaskManager<Periods...>::mainCallback()
+    {
+        uint32_t l_mask = waitReady();
+        while (l_mask)
+        {
+            uint32_t l_idx = __builtin_ctz(l_mask);
+            l_mask &= l_mask - 1;
+            if (m_taskList[l_idx]->getPeriod() != 0)
+            {
+                m_taskList[l_idx]->Trigger();
+            }
+            m_taskList[l_idx]->run();
+        }
+    }
+
+}; // namespace utils::task
+
+#endif // STATIC_TASK_MANAGER_TPP
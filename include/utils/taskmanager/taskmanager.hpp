@@ -27,85 +27,295 @@ limitations under the License.
 #define TASK_MANAGER_HPP
 
 #include <mbed.h>
+#include <rtos.h>
+#include <utils/taskmanager/taskstatistics.hpp>
+#include <utils/taskmanager/timerwheel.hpp>
 
 namespace utils::task{
+
+    class CTaskScheduler;
+
+    /** @brief Priority classes of the tasks. The tasks of a higher class can preempt the tasks of a lower class, when the scheduler applies the classes in separate threads. */
+    enum EPriorityClass{
+        /** @brief Background tasks, like logging and blinking. */
+        BACKGROUND = 0,
+        /** @brief Normal tasks */
+        NORMAL = 1,
+        /** @brief Time critical tasks, like the control traffic. */
+        REALTIME = 2
+    };
+    /** @brief Number of the priority classes */
+    const uint32_t g_priorityClassCount = 3;
+
    /**
     * @brief It aims to the task functionality. The tasks will be applied periodically by the task manager, the period is defined in the contructor. 
     * 
+    * The period can be changed at runtime (setPeriod), for example a sensor task can slow down at standstill. A one-shot task 
+    * (startOneShot) is triggered once after its delay, then its period is cleared, so it replaces a separate timeout. A disabled task 
+    * keeps its place in the scheduler, but it isn't triggered and it isn't applied. The phase shifts the triggers of a periodic task 
+    * from the triggers of the other tasks with common multiple periods, it's applied by the task manager (alignPhases).
     */
     class CTask
     {
     public:
         /* Constructor */
-        CTask(uint32_t f_period);
+        CTask(uint32_t f_period, EPriorityClass f_priorityClass = NORMAL);
         /* Destructor */
         virtual ~CTask();
-        /* Run method */
-        virtual void run();
-         /** @brief  Timer callback */
-        void timerCallback()
+        /* Run method, it isn't virtual, the schedulers reach the task's logic by a single indirect call of '_run' */
+        void run();
+         /** @brief  The period of the task elapsed, it triggers the task and it ends the one-shot task. It returns false, when the task is disabled. */
+        bool elapse()
         {
-            m_ticks++;
-            if (m_ticks >= m_period)
+            if (!m_isEnabled)
+            {
+                return false;
+            }
+            if (m_isOneShot)
             {
-                m_ticks = 0;
-                Trigger();
+                m_isOneShot = false;
+                m_period = 0;
             }
+            Trigger();
+            return true;
         }
          /** @brief  Trigger function to set the flag true state. */
         void Trigger()
         {
+            if (m_statistics != NULL)
+            {
+                if (m_triggered)
+                {
+                    m_statistics->recordMissed();
+                }
+                m_triggerCycle = CTaskStatistics::cycles();
+            }
             m_triggered = true;
         }
+        /* Trigger the task from an event source (interrupt or other thread) and wake up its scheduler */
+        void Notify();
+        /** @brief  Get the period of the task expressed in base ticks. */
+        uint32_t getPeriod() const
+        {
+            return m_period;
+        }
+        /* Change the period of the task */
+        void setPeriod(uint32_t f_period);
+        /** @brief  Get the phase of the task expressed in base ticks. */
+        uint32_t getPhase() const
+        {
+            return m_phase;
+        }
+        /** @brief  Set the phase of the task, the offset of its triggers in base ticks. It's applied by the next alignment of the task manager. */
+        void setPhase(uint32_t f_phase)
+        {
+            m_phase = f_phase;
+        }
+        /* Trigger the task once after the given delay */
+        void startOneShot(uint32_t f_delay);
+        /* Enable the task */
+        void enable();
+        /* Disable the task */
+        void disable();
+        /** @brief  The task is enabled, a disabled task isn't triggered and it isn't applied. */
+        bool isEnabled() const
+        {
+            return m_isEnabled;
+        }
+        /** @brief  Get the priority class of the task. */
+        EPriorityClass getPriorityClass() const
+        {
+            return m_priorityClass;
+        }
+        /** @brief  Set the priority class of the task. It has to be applied before the scheduler is started. */
+        void setPriorityClass(EPriorityClass f_priorityClass)
+        {
+            m_priorityClass = f_priorityClass;
+        }
+        /** @brief  Attach the statistics object, which measures the task's execution. NULL disables the measurement. */
+        void attachStatistics(CTaskStatistics* f_statistics)
+        {
+            m_statistics = f_statistics;
+        }
+        /** @brief  Get the attached statistics object */
+        CTaskStatistics* getStatistics() const
+        {
+            return m_statistics;
+        }
+        /* Register the scheduler, which applies the task */
+        void registerScheduler(CTaskScheduler* f_scheduler, uint32_t f_taskIdx, uint32_t f_readyBit);
+        /** @brief  Index of the task in the list of its scheduler */
+        uint32_t getTaskIdx() const
+        {
+            return m_taskIdx;
+        }
+        /** @brief  Task under execution in a priority class, NULL between the tasks. It's read by the crash capture. */
+        static CTask* getRunning(EPriorityClass f_priorityClass)
+        {
+            return s_running[f_priorityClass];
+        }
     protected:
         /** @brief  main application logic - It's a pure function for application logic and has to override in the derivered class to implement the appl.*/
         virtual void _run() = 0;
-        /** @brief period of the task */
-        const uint32_t m_period;
-        /** @brief  ticks */
-        uint32_t m_ticks;
+        /** @brief period of the task, zero for the tasks triggered only by their event source */
+        volatile uint32_t m_period;
+        /** @brief  phase of the task, offset of the triggers in base ticks */
+        uint32_t m_phase;
         /** @brief  trigger flag */
         bool m_triggered;
+        /** @brief  priority class */
+        EPriorityClass m_priorityClass;
+        /** @brief  scheduler, which applies the task */
+        CTaskScheduler* m_scheduler;
+        /** @brief  index of the task in the list of the scheduler */
+        uint32_t m_taskIdx;
+        /** @brief  bit of the task in the ready mask of the scheduler */
+        uint32_t m_readyBit;
+        /** @brief  the task is enabled */
+        volatile bool m_isEnabled;
+        /** @brief  the task is triggered only once, its period is cleared by the trigger */
+        volatile bool m_isOneShot;
+        /** @brief  statistics of the execution, NULL when it isn't measured */
+        CTaskStatistics* m_statistics;
+        /** @brief  cycle counter value of the last trigger */
+        volatile uint32_t m_triggerCycle;
+    private:
+        /** @brief  task under execution in each priority class */
+        static CTask* volatile s_running[g_priorityClassCount];
+    };
+
+   /**
+    * @brief Common part of the task schedulers. 
+    * 
+    * It holds the list of tasks and a ready bitmask of the triggered tasks. The tasks with an index bigger than 30 share the last bit of the mask.
+    * The triggering side (timer interrupt or event source) marks the tasks through the 'notify' method, which wakes up the thread applying the tasks.
+    */
+    class CTaskScheduler
+    {
+    public:
+        /* Constructor */
+        CTaskScheduler(CTask** f_taskList, uint32_t f_taskCount);
+        /* Destructor */
+        virtual ~CTaskScheduler();
+        /** @brief  The main callback method aims to apply the subtasks' run method. */
+        virtual void mainCallback() = 0;
+        /* Mark the tasks in the ready mask and wake up the main thread. It can be applied from interrupt context. */
+        virtual void notify(uint32_t f_readyMask);
+        /* Apply the new period of a task */
+        virtual void reschedule(uint32_t f_taskIdx);
+        /** @brief  Bit of the ready mask associated to the task with the given index. */
+        static uint32_t readyBit(uint32_t f_idx)
+        {
+            return (f_idx < s_sharedBitIdx) ? (1UL << f_idx) : (1UL << s_sharedBitIdx);
+        }
+    protected:
+        /* Block the calling thread until at least one task is ready and return the ready mask */
+        uint32_t waitReady();
+        /* Take and clear the ready bits selected by the mask */
+        uint32_t takeReady(uint32_t f_mask);
+        /* Apply the tasks marked in the ready mask  */
+        void dispatch(uint32_t f_readyMask);
+
+        /** @brief  Signal flag used to wake up the main thread */
+        static const int32_t s_readySignal = 0x1;
+        /** @brief  Index of the ready mask bit shared by the last tasks */
+        static const uint32_t s_sharedBitIdx = 31;
+        /** @brief  List of tasks  */
+        CTask** m_taskList;
+        /** @brief  number of tasks */
+        uint32_t m_taskCount;
+        /** @brief  Bitmask of the triggered tasks, which weren't applied yet */
+        volatile uint32_t m_readyMask;
+        /** @brief  Identifier of the thread, which applies the main callback. It's NULL until the first blocking main callback. */
+        osThreadId volatile m_mainThreadId;
     };
 
    /**
     * @brief It aims to implement the task manager functionality. It controls and applies periodically each task. 
-    * It has two main part, a ticker and the mainCallback method. The ticker method applies automatically 'timerCallback' method of each tasks, so
-    * numerate separately the ticks from the functionalities of tasks. The mainCallback method aims to apply the application logic for each tasks, 
+    * It has two main part, a ticker and the mainCallback method. The ticker advances a timer wheel, where each periodic task has its own timer, 
+    * so the interrupt touches only the expiring tasks, the ticks are numerated separately from the functionalities of tasks. The mainCallback method aims to apply the application logic for each tasks, 
     * if the task's trigger flag has true state. 
+    * 
+    * In the event driven mode the timer callback collects the triggered tasks in a ready bitmask and it signals the main thread, 
+    * which sleeps in the mainCallback method until at least one task is due. Only the tasks marked in the bitmask are applied. 
+    * 
+    * The tick can be scaled at runtime (setTickScale), the ticker interrupt is applied less often and each interrupt counts several 
+    * base ticks, for example the parked car doesn't need the resolution of the base tick.
+    * 
+    * The tasks with common multiple periods are triggered in the same tick (e.g. 5000 and 100 ticks), the phases (balancePhases) shift 
+    * them in separate ticks, so the peak load of a tick decreases and the start of the tasks doesn't depend on the coinciding tasks.
     */
-    class CTaskManager
+    class CTaskManager: public CTaskScheduler
     {
     public:
+        /** @brief Scheduling modes of the task manager */
+        enum ESchedulingMode{
+            /** @brief The main callback polls continuously all tasks. */
+            POLLING,
+            /** @brief The main callback blocks until a task is triggered and applies only the triggered tasks. */
+            EVENT_DRIVEN
+        };
+
         /* Constructor */
-        CTaskManager(CTask** f_taskList, uint32_t f_taskCount, float f_baseFreq);
+        CTaskManager(CTask** f_taskList, uint32_t f_taskCount, float f_baseFreq, ESchedulingMode f_mode = POLLING);
         /* Destructor */
         virtual ~CTaskManager();
-        /** @brief  The main callback method aims to apply the subtasks' run method. */
-        inline void mainCallback()
+        /* The main callback method aims to apply the subtasks' run method. */
+        virtual void mainCallback();
+        /* Scale the period of the ticker */
+        void setTickScale(uint32_t f_scale);
+        /** @brief  Number of the base ticks counted by an interrupt of the ticker */
+        uint32_t getTickScale() const
         {
-            for(uint32_t i = 0; i < m_taskCount; i++)
-            {
-                m_taskList[i]->run();
-            }
+            return m_tickScale;
+        }
+        /* Apply the new period of a task */
+        virtual void reschedule(uint32_t f_taskIdx);
+        /* Restart the timers of the periodic tasks with their phases */
+        void alignPhases();
+        /* Distribute the phases of the periodic tasks and align them */
+        uint32_t balancePhases();
+        /** @brief  Timer wheel of the ticker, the other software timers can be armed in it, their callbacks are applied from the ticker interrupt. */
+        CTimerWheel& getTimerWheel()
+        {
+            return m_wheel;
         }
-        /** @brief  Timer callback method applies the subtasks' callback function. */
+        /** @brief  Timer callback method, it advances the timer wheel, whose expired task timers trigger the tasks. The cost doesn't depend on the number of tasks. */
         void timerCallback()
         {
-            for(uint32_t i = 0; i < m_taskCount; i++)
+            m_wheel.advance(m_tickScale);
+            uint32_t l_readyMask = m_expiredMask;
+            m_expiredMask = 0;
+            if (l_readyMask && EVENT_DRIVEN == m_mode)
             {
-                m_taskList[i]->timerCallback();
+                notify(l_readyMask);
             }
         }
     private:
-        /** @brief  List of tasks  */
-        CTask** m_taskList;
-        /** @brief  number of tasks */
-        uint32_t m_taskCount;
+        /** @brief  Scheduling mode */
+        const ESchedulingMode m_mode;
         /** @brief  Ticker for periodic applying the timer callback function  */
         Ticker m_ticker;
+        /** @brief  Base period of the ticker in seconds */
+        const float m_baseFreq;
+        /** @brief  Number of the base ticks counted by an interrupt */
+        volatile uint32_t m_tickScale;
+        /** @brief  Maximum number of the tasks with own timer, the further tasks are applied only by their event source */
+        static const uint32_t s_maxTaskCount = 32;
+        /** @brief  Maximum phase tried by the balancing in base ticks */
+        static const uint32_t s_maxPhase = 256;
+        /* Expiry callback of the task timers */
+        static void expireTask(CTimerWheel::CTimer& f_timer);
+        /* Greatest common divisor */
+        static uint32_t gcd(uint32_t f_a, uint32_t f_b);
+        /** @brief  Timer wheel counting the base ticks */
+        CTimerWheel m_wheel;
+        /** @brief  Period timers of the tasks */
+        CTimerWheel::CTimer m_timers[s_maxTaskCount];
+        /** @brief  Ready bits of the tasks triggered in the current interrupt */
+        uint32_t m_expiredMask;
     };
 
 }; // namespace utils::task
 
-#endif
\ No newline at end of file
+#endif
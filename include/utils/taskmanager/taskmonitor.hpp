@@ -0,0 +1,61 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    TaskMonitor.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the task monitor.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TASK_MONITOR_HPP
+#define TASK_MONITOR_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/taskstatistics.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief It attaches the statistics objects to the tasks and it publishes the collected values through the serial monitor.
+    * 
+    * The request '#TSKS:idx;;' returns the values of the task with the given index in microseconds: 
+    * 'idx;count;minExec;maxExec;meanExec;maxJitter;missed;h0,h1,...,h7;;'. The request '#TSKS:-1;;' resets the statistics of all tasks.
+    */
+    class CTaskMonitor
+    {
+    public:
+        /* Constructor */
+        CTaskMonitor(CTask** f_taskList, CTaskStatistics* f_statisticsList, uint32_t f_taskCount);
+        /* Serial callback */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Convert the cycles to microseconds */
+        static uint32_t cycles2us(uint32_t f_cycles);
+        /** @brief  List of tasks  */
+        CTask** m_taskList;
+        /** @brief  List of statistics, one for each task  */
+        CTaskStatistics* m_statisticsList;
+        /** @brief  Number of tasks  */
+        uint32_t m_taskCount;
+    };
+
+}; // namespace utils::task
+
+#endif
@@ -0,0 +1,98 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    TaskStatistics.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the task execution statistics.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TASK_STATISTICS_HPP
+#define TASK_STATISTICS_HPP
+
+#include <mbed.h>
+
+namespace utils::task{
+
+   /**
+    * @brief It collects the execution time, the start jitter and the missed deadlines of a task. 
+    * 
+    * The values are measured with the DWT cycle counter and they are expressed in CPU cycles. The jitter histogram has logarithmic bins 
+    * in microseconds: [0,1), [1,2), [2,4), ..., [64,inf).
+    */
+    class CTaskStatistics
+    {
+    public:
+        /* Constructor */
+        CTaskStatistics();
+        /* Enable the DWT cycle counter */
+        static void enableCycleCounter();
+        /** @brief  Current value of the DWT cycle counter */
+        static uint32_t cycles()
+        {
+            return DWT->CYCCNT;
+        }
+        /* Record the start jitter of an execution */
+        void recordJitter(uint32_t f_cycles);
+        /* Record the duration of an execution */
+        void recordExecution(uint32_t f_cycles);
+        /** @brief  Record a missed deadline, when the task is triggered again before its previous execution. */
+        void recordMissed()
+        {
+            m_missed++;
+        }
+        /* Reset the collected values */
+        void reset();
+        /** @brief  Number of the recorded executions */
+        uint32_t getCount() const {return m_count;}
+        /** @brief  Minimum execution time in cycles */
+        uint32_t getMinExecution() const {return m_count ? m_minExecution : 0;}
+        /** @brief  Maximum execution time in cycles */
+        uint32_t getMaxExecution() const {return m_maxExecution;}
+        /** @brief  Mean execution time in cycles */
+        uint32_t getMeanExecution() const {return m_count ? static_cast<uint32_t>(m_sumExecution / m_count) : 0;}
+        /** @brief  Maximum start jitter in cycles */
+        uint32_t getMaxJitter() const {return m_maxJitter;}
+        /** @brief  Number of the missed deadlines */
+        uint32_t getMissed() const {return m_missed;}
+        /** @brief  Value of a bin of the jitter histogram */
+        uint32_t getHistogram(uint32_t f_bin) const {return f_bin < s_histogramSize ? m_histogram[f_bin] : 0;}
+
+        /** @brief  Number of bins in the jitter histogram */
+        static const uint32_t s_histogramSize = 8;
+    private:
+        /** @brief  number of the recorded executions */
+        uint32_t m_count;
+        /** @brief  minimum execution time */
+        uint32_t m_minExecution;
+        /** @brief  maximum execution time */
+        uint32_t m_maxExecution;
+        /** @brief  sum of the execution times */
+        uint64_t m_sumExecution;
+        /** @brief  maximum start jitter */
+        uint32_t m_maxJitter;
+        /** @brief  number of the missed deadlines */
+        volatile uint32_t m_missed;
+        /** @brief  jitter histogram */
+        uint32_t m_histogram[s_histogramSize];
+    };
+
+}; // namespace utils::task
+
+#endif
@@ -0,0 +1,94 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    TicklessTaskManager.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the tickless task manager.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TICKLESS_TASK_MANAGER_HPP
+#define TICKLESS_TASK_MANAGER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief It implements a tickless task manager. 
+    * 
+    * The periodic tasks are kept in a min-heap ordered by their next deadline and a single timeout is programmed to the nearest deadline, 
+    * so the interrupt is generated only when a task is due and not on every base tick. The due tasks are marked in the ready bitmask and 
+    * the main thread is woken up to apply them.
+    * 
+    * The tasks with zero period aren't inserted in the heap, they are applied only when an event source notifies them (CTask::Notify).
+    * A changed period or a started one-shot reinserts the task with a deadline counted from the change, the elapsed one-shot tasks 
+    * leave the heap, so they don't generate further interrupts.
+    */
+    class CTicklessTaskManager: public CTaskScheduler
+    {
+    public:
+        /* Constructor */
+        CTicklessTaskManager(CTask** f_taskList, uint32_t f_taskCount, float f_baseTick);
+        /* Destructor */
+        virtual ~CTicklessTaskManager();
+        /* The main callback method aims to apply the triggered tasks' run method. */
+        virtual void mainCallback();
+        /* Apply the new period of a task */
+        virtual void reschedule(uint32_t f_taskIdx);
+    private:
+        /** @brief  Entry of the deadline heap */
+        struct SDeadline{
+            /** @brief  deadline in microseconds (us ticker time) */
+            uint32_t m_deadline;
+            /** @brief  index of the task in the task list */
+            uint32_t m_taskIdx;
+        };
+        /* Timeout callback, it triggers the due tasks */
+        void timeoutCallback();
+        /* Program the timeout to the nearest deadline */
+        void arm(uint32_t f_now);
+        /* Insert an entry in the heap */
+        void push(const SDeadline& f_entry);
+        /* Remove the first entry of the heap */
+        SDeadline pop();
+        /* Remove the entry of a task from the heap */
+        void remove(uint32_t f_taskIdx);
+        /** @brief  Wrap safe comparison of two deadline, it returns true, when the first deadline is earlier than the second. */
+        static bool earlier(uint32_t f_a, uint32_t f_b)
+        {
+            return static_cast<int32_t>(f_a - f_b) < 0;
+        }
+
+        /** @brief  Maximum number of periodic tasks */
+        static const uint32_t s_maxTaskCount = 32;
+        /** @brief  Base tick in microseconds */
+        const uint32_t m_baseTick_us;
+        /** @brief  Heap of deadlines */
+        SDeadline m_heap[s_maxTaskCount];
+        /** @brief  Number of entries in the heap */
+        uint32_t m_heapSize;
+        /** @brief  Timeout programmed to the nearest deadline */
+        Timeout m_timeout;
+    };
+
+}; // namespace utils::task
+
+#endif
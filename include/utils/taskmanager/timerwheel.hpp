@@ -0,0 +1,159 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    TimerWheel.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the hierarchical
+  *          timer wheel of the software timers.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <mbed.h>
+
+namespace utils::task{
+
+   /**
+    * @brief Hierarchical timer wheel, it applies any number of software timers (timeouts and periodic triggers) from a single tick.
+    *
+    * The wheel has four levels of 64 slots, the first level resolves single ticks, each further level is 64 times coarser. A timer
+    * is linked in the slot of its expiry on the finest level, which covers it, so the arming and the cancelling cost a constant time.
+    * When the first level wraps around, the current slot of the next level is redistributed to the finer levels (cascading), so a
+    * timer is moved at most three times before it expires. The tick doesn't depend on the number of the armed timers.
+    *
+    * The timers are intrusive nodes owned by the users, the wheel doesn't allocate memory. The expiry callbacks are applied from the
+    * context of the tick (usually an interrupt), they can arm or cancel any timer, including their own.
+    */
+    class CTimerWheel
+    {
+    public:
+        class CTimer;
+        /** @brief  Expiry callback of a timer */
+        typedef void (*FExpire)(CTimer& f_timer);
+
+       /**
+        * @brief Software timer of the wheel, the context pointer identifies the owner in the expiry callback.
+        */
+        class CTimer
+        {
+        public:
+            /** @brief  Constructor, the timer isn't armed */
+            CTimer(FExpire f_expire = NULL, void* f_context = NULL)
+                : m_next(NULL)
+                , m_pprev(NULL)
+                , m_expiry(0)
+                , m_period(0)
+                , m_expire(f_expire)
+                , m_context(f_context)
+            {
+            }
+            /** @brief  Set the expiry callback and its context, it has to be applied while the timer isn't armed */
+            void attach(FExpire f_expire, void* f_context)
+            {
+                m_expire = f_expire;
+                m_context = f_context;
+            }
+            /** @brief  The timer is linked in the wheel */
+            bool isArmed() const
+            {
+                return m_pprev != NULL;
+            }
+            /** @brief  Context of the owner */
+            void* getContext() const
+            {
+                return m_context;
+            }
+            /** @brief  Period of the rearming, zero for the one-shot timer */
+            uint32_t getPeriod() const
+            {
+                return m_period;
+            }
+        private:
+            friend class CTimerWheel;
+            /** @brief  Next timer of the slot */
+            CTimer* m_next;
+            /** @brief  Link, which points to the timer, NULL while the timer isn't armed */
+            CTimer** m_pprev;
+            /** @brief  Tick of the expiry */
+            uint32_t m_expiry;
+            /** @brief  Period of the rearming in ticks */
+            uint32_t m_period;
+            /** @brief  Expiry callback */
+            FExpire m_expire;
+            /** @brief  Context of the owner */
+            void* m_context;
+        };
+
+        /* Constructor */
+        CTimerWheel(float f_tick);
+        /* Arm the timer */
+        void arm(CTimer& f_timer, uint32_t f_delay, uint32_t f_period = 0);
+        /* Cancel the timer */
+        void cancel(CTimer& f_timer);
+        /* Count the ticks and apply the expired timers */
+        void advance(uint32_t f_ticks = 1);
+        /* Remaining ticks of the timer */
+        uint32_t remaining(const CTimer& f_timer) const;
+        /* Convert a time to ticks */
+        uint32_t toTicks(float f_seconds) const;
+        /** @brief  Number of the counted ticks */
+        uint32_t now() const
+        {
+            return m_now;
+        }
+        /** @brief  Period of a tick in seconds */
+        float getTick() const
+        {
+            return m_tick;
+        }
+
+        /** @brief  Number of the bits of a level */
+        static const uint32_t s_levelBits = 6;
+        /** @brief  Number of the slots of a level */
+        static const uint32_t s_slotCount = 1UL << s_levelBits;
+        /** @brief  Number of the levels */
+        static const uint32_t s_levelCount = 4;
+        /** @brief  Longest delay in ticks, a longer delay is clamped */
+        static const uint32_t s_maxDelay = 1UL << (s_levelBits * s_levelCount);
+    private:
+        /** @brief  Mask of the slot index */
+        static const uint32_t s_slotMask = s_slotCount - 1;
+
+        /* Link the timer in the slot of its expiry */
+        void insert(CTimer& f_timer);
+        /* Unlink the timer */
+        static void unlink(CTimer& f_timer);
+        /* Redistribute the current slot of a level */
+        uint32_t cascade(uint32_t f_level);
+        /* Apply the current tick */
+        void step();
+
+        /** @brief  Lists of the timers in the slots of the levels */
+        CTimer* m_slots[s_levelCount][s_slotCount];
+        /** @brief  Next tick to apply */
+        volatile uint32_t m_now;
+        /** @brief  Period of a tick in seconds */
+        const float m_tick;
+    };
+
+}; // namespace utils::task
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,84 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+  ******************************************************************************
+  * @file    WorkQueue.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the deferred work 
+  *          queue of the serial callbacks.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef WORK_QUEUE_HPP
+#define WORK_QUEUE_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+
+namespace utils::task{
+
+   /**
+    * @brief Bounded queue of the deferred works, so a serial callback can answer immediately and the expensive part (flash writing) 
+    * doesn't block the parsing of the next frames.
+    * 
+    * The callback posts a work with the key of its command, the work is applied by the task in its own priority class (background), 
+    * after the serial monitor. The work writes its result in the given buffer, the result is sent as '@KEY:result\r\n' on the response 
+    * lane of the transmitter, an empty result isn't sent. The works are posted by the threads of the serial monitors, the queue is 
+    * protected by critical section, so the posting side can be also an interrupt.
+    */
+    class CWorkQueue: public CTask
+    {
+    public:
+        /** @brief  Deferred work, it writes the result message (ended by ";;") in the buffer of s_resultSize bytes */
+        typedef mbed::Callback<void(char*)> FWork;
+        /* Constructor */
+        CWorkQueue(utils::serial::CSerialTransmitter& f_transmitter);
+        /* Post a work */
+        bool post(const char* f_key, FWork f_work);
+        /* Number of the dropped works */
+        uint32_t getDropped() const;
+        /** @brief  Maximum number of the pending works */
+        static const uint32_t s_queueSize = 8;
+        /** @brief  Size of the result buffer */
+        static const uint32_t s_resultSize = 128;
+    private:
+        /* Run method */
+        virtual void _run();
+
+        /** @brief  Pending work */
+        struct SWork
+        {
+            char  m_key[5];     /**< key of the command, it addresses the result */
+            FWork m_work;       /**< work function */
+        };
+        /** @brief  Transmitter of the results */
+        utils::serial::CSerialTransmitter& m_transmitter;
+        /** @brief  Ring of the pending works */
+        SWork m_works[s_queueSize];
+        /** @brief  Index of the first pending work */
+        uint32_t m_head;
+        /** @brief  Number of the pending works */
+        volatile uint32_t m_count;
+        /** @brief  Number of the works dropped, because the queue was full */
+        volatile uint32_t m_dropped;
+    };
+
+}; // namespace utils::task
+
+#endif // WORK_QUEUE_HPP
@@ -0,0 +1,148 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    commandrecorder.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the recorder and the replay of the received commands.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef COMMAND_RECORDER_HPP
+#define COMMAND_RECORDER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialmonitor.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+
+namespace utils::telemetry{
+
+   /**
+    * @brief Recorder of the commands of a serial monitor, it stores each accepted frame with its arrival time and it replays them
+    *  with the original timing.
+    *
+    * The entries (utils::serial::SCommandEntry followed by the bytes of the frame) are appended to a linear log, the capture stops
+    * adding entries, when the log is full. The log is in the '.noinit' section (NOINIT_STATE) like the history of the flight recorder,
+    * so a stream captured before a soft reset can be replayed or dumped after it. The replay dispatches the entries by the monitor
+    * (CSerialMonitor::replay) at the same offsets from the first entry as they were received, the resolution is the period of the
+    * task. The entries are dumped in binary frames (utils::serial::BIN_COMMAND_RECORD), the host can replay them by its own timing.
+    *
+    * The own commands of the recorder ('CREC' key) aren't captured. The capture, the replay and the serial callback are applied by
+    * the tasks of the monitor's priority class, so the state isn't protected by critical sections.
+    */
+    class CCommandRecorder: public utils::task::CTask, public utils::serial::ICommandCapture
+    {
+    public:
+        /** @brief  States of the recorder */
+        enum EState{
+            /** @brief the log is kept */
+            STATE_IDLE    = 0,
+            /** @brief the accepted frames are appended to the log */
+            STATE_CAPTURE = 1,
+            /** @brief the entries are dispatched */
+            STATE_REPLAY  = 2,
+            /** @brief the entries are sent to the host */
+            STATE_DUMP    = 3
+        };
+
+        /** @brief  Size of the log in byte */
+        static const uint32_t s_capacity = 4096;
+        /** @brief  Maximum size of a captured frame, the entry has to fit in a dumped frame */
+        static const uint32_t s_maxFrameSize = utils::serial::CBinaryProtocol::s_maxPayloadSize - sizeof(utils::serial::SCommandRecordHeader) - sizeof(utils::serial::SCommandEntry);
+
+        /** @brief  Memory of the recorder, it has to be placed in the '.noinit' section without initializer, the content is validated by 'restore' */
+        struct SStorage{
+            /** @brief identifier of the valid content */
+            uint32_t m_magic;
+            /** @brief number of the used bytes of the log */
+            uint32_t m_used;
+            /** @brief number of the entries */
+            uint32_t m_count;
+            /** @brief check value of the fields above */
+            uint32_t m_check;
+            /** @brief entries of the log */
+            uint8_t m_data[s_capacity];
+        };
+
+        /* Constructor */
+        CCommandRecorder(SStorage& f_storage, utils::serial::CSerialMonitor& f_monitor, utils::serial::CSerialTransmitter& f_serial, uint32_t f_period);
+        /* Validate the memory after the reset */
+        bool restore();
+        /* Capture an accepted frame */
+        virtual void capture(uint32_t f_timestamp, EKind f_kind, const uint8_t* f_data, uint32_t f_size);
+        /* Clear the log and start the capture */
+        bool startCapture();
+        /* Start the replay of the log */
+        bool startReplay();
+        /* Start the dump of the log */
+        bool dump();
+        /* Stop the capture, the replay or the dump */
+        void stop();
+        /** @brief  State of the recorder */
+        EState getState() const
+        {
+            return m_state;
+        }
+        /** @brief  Number of the entries */
+        uint32_t getCount() const
+        {
+            return m_storage.m_count;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Identifier of the valid content */
+        static const uint32_t s_magic = 0x43524543;
+
+        /* Run method, it applies the replay and the dump */
+        void _run();
+        /* Dispatch the entries, whose time came */
+        void replayEntries();
+        /* Send the frames of the dump */
+        void dumpEntries();
+        /* Clear the log */
+        void format();
+        /* Check value of the state */
+        uint32_t check() const;
+
+        /** @brief  Memory of the log */
+        SStorage& m_storage;
+        /** @brief  Monitor of the captured frames */
+        utils::serial::CSerialMonitor& m_monitor;
+        /** @brief  Serial transmitter of the dump */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Period of the task during the replay and the dump in base ticks */
+        const uint32_t m_period;
+        /** @brief  State of the recorder */
+        EState m_state;
+        /** @brief  Offset of the next replayed or dumped entry */
+        uint32_t m_offset;
+        /** @brief  Index of the next replayed or dumped entry */
+        uint32_t m_index;
+        /** @brief  Arrival time of the first entry */
+        uint32_t m_firstTimestamp;
+        /** @brief  Start time of the replay */
+        uint32_t m_replayStart;
+        /** @brief  Number of the frames, which weren't captured (long frame, full log) */
+        uint32_t m_skipped;
+    };
+
+}; // namespace utils::telemetry
+
+#endif // COMMAND_RECORDER_HPP
@@ -0,0 +1,165 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    DerivedSignals.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the derived signal
+  *          expressions of the telemetry.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef DERIVED_SIGNALS_HPP
+#define DERIVED_SIGNALS_HPP
+
+#include <mbed.h>
+#include <utils/pipeline/pipeline.hpp>
+#include <utils/telemetry/telemetry.hpp>
+
+namespace utils::telemetry{
+
+   /**
+    * @brief Derived signals of the telemetry, the host uploads small stack programs over the registered signals and the results are
+    * sampled by the telemetry instead of the raw signals, so the host doesn't stream several channels for a difference or a product.
+    *
+    * The derived signals are the slots of the telemetry (subscription mask bits 0..7), the slot without program forwards the source of
+    * the same index, so the telemetry keeps its signals until the first upload. The pipeline stage reads each source once, then it
+    * evaluates the programs in the order of the slots, a program can read the result of a lower slot in the same tick.
+    *
+    * A program is verified at the upload: its length, its indices and its stack depth are bounded, the stack holds a single result at
+    * the end, so the evaluation has a bounded time and it can't fail. The division by zero and the square root of a negative value give
+    * zero. The mean operation is a sliding window of the last ticks, it's allowed once in a program (e.g. the rms: SOURCE, DUP, MUL,
+    * MEAN, SQRT). The verified program is applied by the control loop at the next tick, its window starts empty.
+    *
+    * The binary format of a program: number of the constants (u8), constants (float, little-endian), then the instructions, each is
+    * an opcode (EOpcode, u8) and an argument (u8, index or window length, zero when unused).
+    *
+    * Commands of the 'DSIG' key: '0' number of the instructions of each slot (zero: forwarded source), '1;slot;hex' upload a program,
+    * '2;slot' clear a program, '3;slot' value of the slot.
+    */
+    class CDerivedSignals: public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Getter of a source signal, it's applied by the control loop */
+        typedef mbed::Callback<float()> FSignalGetter;
+        /** @brief  Operations of the programs */
+        enum EOpcode{
+            OP_SOURCE   = 1,    /**< push the source of the argument */
+            OP_CONST    = 2,    /**< push the constant of the argument */
+            OP_SLOT     = 3,    /**< push the result of the lower slot of the argument */
+            OP_DUP      = 4,    /**< push the top again */
+            OP_ADD      = 5,    /**< a + b */
+            OP_SUB      = 6,    /**< a - b */
+            OP_MUL      = 7,    /**< a * b */
+            OP_DIV      = 8,    /**< a / b, zero for zero divisor */
+            OP_MIN      = 9,    /**< minimum of a and b */
+            OP_MAX      = 10,   /**< maximum of a and b */
+            OP_NEG      = 11,   /**< -a */
+            OP_ABS      = 12,   /**< |a| */
+            OP_SQRT     = 13,   /**< square root of a, zero for negative value */
+            OP_MEAN     = 14    /**< mean of a over the last argument ticks */
+        };
+
+        /** @brief  Number of the slots, the signals of the telemetry */
+        static const uint8_t s_slots = CTelemetry::s_maxSignals;
+        /** @brief  Maximum number of the sources */
+        static const uint8_t s_maxSources = 16;
+        /** @brief  Maximum number of the instructions of a program */
+        static const uint8_t s_maxInstructions = 16;
+        /** @brief  Maximum number of the constants of a program */
+        static const uint8_t s_maxConstants = 4;
+        /** @brief  Depth of the evaluation stack */
+        static const uint8_t s_stackDepth = 8;
+        /** @brief  Maximum length of the mean window in tick */
+        static const uint8_t s_maxWindow = 32;
+        /** @brief  Maximum size of a program in byte */
+        static const uint32_t s_maxCodeSize = 1 + s_maxConstants * sizeof(float) + s_maxInstructions * 2;
+
+        /* Constructor */
+        CDerivedSignals(const FSignalGetter* f_sources, uint8_t f_sourceCount);
+        /* Pipeline stage, it evaluates the programs */
+        virtual void process(uint32_t f_timestamp);
+        /* Verify a program and request its application */
+        bool upload(uint8_t f_slot, const uint8_t* f_code, uint32_t f_length);
+        /* Request the clearing of a program */
+        bool clear(uint8_t f_slot);
+        /* Value of a slot in the last tick */
+        float getOutput(uint8_t f_slot) const;
+        /** @brief  Value of a slot in the last tick, the getter of the telemetry signal */
+        template <uint8_t NSlot>
+        float getSlot() const
+        {
+            static_assert(NSlot < s_slots, "Derived signal slot out of range");
+            return m_outputs[NSlot];
+        }
+        /* Serial callback method */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Instruction of a program */
+        struct SInstruction{
+            /** @brief operation (EOpcode) */
+            uint8_t m_opcode;
+            /** @brief index or window length */
+            uint8_t m_argument;
+        };
+        /** @brief  Verified program */
+        struct SProgram{
+            /** @brief instructions */
+            SInstruction m_code[s_maxInstructions];
+            /** @brief constants */
+            float m_constants[s_maxConstants];
+            /** @brief number of the instructions, zero forwards the source of the slot */
+            uint8_t m_length;
+        };
+        /** @brief  Sliding window of the mean operation */
+        struct SWindow{
+            /** @brief last samples */
+            float m_samples[s_maxWindow];
+            /** @brief sum of the valid samples */
+            float m_sum;
+            /** @brief index of the next sample */
+            uint8_t m_index;
+            /** @brief number of the valid samples */
+            uint8_t m_count;
+        };
+
+        /* Verify and decode a program */
+        bool verify(uint8_t f_slot, const uint8_t* f_code, uint32_t f_length, SProgram& f_program) const;
+        /* Evaluate a program */
+        float evaluate(const SProgram& f_program, SWindow& f_window) const;
+
+        /** @brief  Getters of the sources */
+        const FSignalGetter* m_sources;
+        /** @brief  Number of the sources */
+        const uint8_t m_sourceCount;
+        /** @brief  Values of the sources in the last tick */
+        float m_values[s_maxSources];
+        /** @brief  Values of the slots in the last tick */
+        float m_outputs[s_slots];
+        /** @brief  Applied programs */
+        SProgram m_programs[s_slots];
+        /** @brief  Windows of the mean operations */
+        SWindow m_windows[s_slots];
+        /** @brief  Verified program waiting for the control loop */
+        SProgram m_staged;
+        /** @brief  Slot of the waiting program, negative without request */
+        volatile int8_t m_stagedSlot;
+    };
+
+}; // namespace utils::telemetry
+
+#endif // DERIVED_SIGNALS_HPP
@@ -0,0 +1,151 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    flightrecorder.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the flight recorder.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace utils::telemetry{
+
+   /**
+    * @brief Flight recorder, it stores one fixed size record (utils::serial::SFlightRecord) in each control tick in a circular buffer.
+    * 
+    * The buffer is in the '.noinit' section (NOINIT_STATE), so after a soft reset (watchdog, reset pin) the history before the reset 
+    * is kept as post-mortem record. A trigger (fault of the state machine, overcurrent, manual) freezes the buffer after a quarter 
+    * of the capacity, so the history contains the ticks before and after the trigger. The frozen records are dumped in binary frames 
+    * (utils::serial::BIN_FLIGHT_RECORD) by the task, it's periodic only during the dump and it waits, when the lane is full. 
+    * The recording is restarted by the rearm command.
+    */
+    class CFlightRecorder: public utils::task::CTask, public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Triggers of the freezing, the recorded code is sent in the header of the dump */
+        enum ETrigger{
+            /** @brief the recorder is running */
+            TRIGGER_NONE        = 0,
+            /** @brief freezing by command */
+            TRIGGER_MANUAL      = 1,
+            /** @brief the history was found after a reset */
+            TRIGGER_RESET       = 2,
+            /** @brief the bridge was switched off by the current monitor */
+            TRIGGER_OVERCURRENT = 3,
+            /** @brief the speed is too high by the controller */
+            TRIGGER_HIGH_SPEED  = 4,
+            /** @brief the encoder doesn't measure by the controller */
+            TRIGGER_ENCODER     = 5
+        };
+        /** @brief  Fill the record of the tick, it returns the code of the trigger or TRIGGER_NONE */
+        typedef mbed::Callback<uint8_t(utils::serial::SFlightRecord&)> FSampler;
+
+        /** @brief  Number of the records, 16 kB, about one second at 1 kHz */
+        static const uint32_t s_capacity = 1024;
+        /** @brief  Number of the records after the trigger */
+        static const uint32_t s_postTrigger = s_capacity / 4;
+        /** @brief  Number of the records in a dumped frame */
+        static const uint32_t s_frameRecords = (utils::serial::CBinaryProtocol::s_maxPayloadSize - sizeof(utils::serial::SFlightRecordHeader)) / sizeof(utils::serial::SFlightRecord);
+
+        /** @brief  Memory of the recorder, it has to be placed in the '.noinit' section without initializer, the content is validated by 'restore' */
+        struct SStorage{
+            /** @brief identifier of the valid content */
+            uint32_t m_magic;
+            /** @brief index of the next record */
+            uint32_t m_head;
+            /** @brief number of the valid records */
+            uint32_t m_count;
+            /** @brief code of the trigger, it's TRIGGER_NONE while the recorder runs */
+            uint32_t m_trigger;
+            /** @brief remaining records until the freezing */
+            uint32_t m_remaining;
+            /** @brief the records are frozen */
+            uint32_t m_isFrozen;
+            /** @brief check value of the fields above */
+            uint32_t m_check;
+            /** @brief circular buffer of the records */
+            utils::serial::SFlightRecord m_records[s_capacity];
+        };
+
+        /* Constructor */
+        CFlightRecorder(SStorage& f_storage, utils::serial::CSerialTransmitter& f_serial, FSampler f_sampler, uint32_t f_dumpPeriod);
+        /* Validate the memory after the reset */
+        bool restore();
+        /* Pipeline stage, it records the tick */
+        virtual void process(uint32_t f_timestamp);
+        /* Trigger the freezing */
+        void trigger(uint8_t f_trigger);
+        /* Start the dump of the frozen records */
+        bool dump();
+        /* Clear the records and restart the recording */
+        bool rearm();
+        /** @brief  The records are frozen */
+        bool isFrozen() const
+        {
+            return m_storage.m_isFrozen != 0;
+        }
+        /** @brief  Code of the trigger */
+        uint8_t getTrigger() const
+        {
+            return static_cast<uint8_t>(m_storage.m_trigger);
+        }
+        /** @brief  Number of the valid records */
+        uint32_t getCount() const
+        {
+            return m_storage.m_count;
+        }
+        /* Convert a value to fixed point with saturation */
+        static int16_t quantize(float f_value, float f_scale);
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Identifier of the valid content */
+        static const uint32_t s_magic = 0x46524543;
+
+        /* Run method, it sends the frames of the dump */
+        void _run();
+        /* Clear the memory, it has to be applied, when the recording is stopped */
+        void format();
+        /* Check value of the state */
+        uint32_t check() const;
+
+        /** @brief  Memory of the records */
+        SStorage& m_storage;
+        /** @brief  Serial transmitter */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Sampler of the records */
+        FSampler m_sampler;
+        /** @brief  Period of the task during the dump in base ticks */
+        const uint32_t m_dumpPeriod;
+        /** @brief  The dump is in progress */
+        volatile bool m_isDumping;
+        /** @brief  Index of the next dumped record */
+        uint32_t m_dumpIdx;
+    };
+
+}; // namespace utils::telemetry
+
+#endif // FLIGHT_RECORDER_HPP
@@ -0,0 +1,147 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    sdlogsink.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the recorder of the telemetry on the SD card.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SD_LOG_SINK_HPP
+#define SD_LOG_SINK_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/sdcardspi.hpp>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/telemetry/telemetry.hpp>
+
+namespace utils::telemetry{
+
+   /**
+    * @brief Recorder of the telemetry frames on the SD card, the frames are written in a ring of raw sectors without file system.
+    *
+    * The ring is a preallocated contiguous range of sectors (e.g. a partition without file system), so no metadata is updated
+    * during the recording. Each sector starts with a header (magic, session, sequence, used bytes), the encoded frames follow it
+    * continuously over the sector boundaries, the rest of the last sector is zero, which is the delimiter of the frames.
+    * The host reads the sectors of a session in the order of the sequence numbers and it decodes the same frames as from the serial link.
+    * A recording starts at the beginning of the ring, at the end of the ring it continues at the beginning over the oldest sectors.
+    *
+    * The frames are copied in one of two sector buffers by the telemetry task, the full buffer is written by the multiple block write
+    * with DMA, meanwhile the other one is filled. When both buffers are full, the frame is dropped and counted. The task applies the
+    * steps of the writing without waiting the card (DMA transfer, data response, busy state), only the initialization of the card
+    * at the first start blocks its thread (at most 1 s), so it has to be in the background class.
+    */
+    class CSdLogSink: public ITelemetrySink, public utils::task::CTask
+    {
+    public:
+        /** @brief  Header of each sector */
+        struct SSectorHeader{
+            /** @brief identifier of the recorded sector */
+            uint32_t m_magic;
+            /** @brief number of the session given by the start */
+            uint16_t m_session;
+            /** @brief number of the bytes of the frames in the sector */
+            uint16_t m_used;
+            /** @brief sequence number of the sector in the session */
+            uint32_t m_sequence;
+        } __attribute__((packed));
+        /** @brief  Identifier of the recorded sectors ('BFLG') */
+        static const uint32_t s_magic = 0x474C4642;
+        /** @brief  Number of the bytes of the frames in a sector */
+        static const uint32_t s_payloadSize = hardware::drivers::CSdCardSpi_SPI3::s_sectorSize - sizeof(SSectorHeader);
+
+        /* Constructor */
+        CSdLogSink(uint32_t f_period, hardware::drivers::CSdCardSpi_SPI3& f_card, uint32_t f_firstSector, uint32_t f_sectorCount);
+        /* Start a recording session */
+        void start(uint16_t f_session);
+        /* Stop the recording */
+        void stop();
+        /** @brief  The frames are recorded */
+        bool isRecording() const
+        {
+            return m_recording;
+        }
+        /* Record a frame */
+        virtual bool write(const uint8_t* f_frame, uint32_t f_size);
+        /* Serial callback of the recording */
+        void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  States of the writing */
+        enum EState{
+            /** @brief no multiple block write */
+            IDLE,
+            /** @brief the multiple block write waits the next sector */
+            READY,
+            /** @brief the DMA transfers a sector */
+            TRANSFER,
+            /** @brief the card programs the sector */
+            BUSY
+        };
+        /** @brief  Buffer of a sector */
+        struct SSector{
+            /** @brief header of the sector */
+            SSectorHeader m_header;
+            /** @brief frames */
+            uint8_t m_data[s_payloadSize];
+        } __attribute__((packed));
+        /* Run method, it applies the steps of the writing */
+        void _run();
+        /* Hand over the filled sector to the writing, it has to be applied from critical section */
+        void swap();
+        /* Abort the recording after an error of the card */
+        void abort();
+
+        /** @brief  SD card */
+        hardware::drivers::CSdCardSpi_SPI3& m_card;
+        /** @brief  First sector of the ring */
+        const uint32_t m_firstSector;
+        /** @brief  Number of the sectors of the ring */
+        const uint32_t m_sectorCount;
+        /** @brief  Double buffered sectors */
+        SSector m_sectors[2];
+        /** @brief  Index of the sector under filling */
+        volatile uint8_t m_fill;
+        /** @brief  Number of the bytes in the sector under filling */
+        uint32_t m_fillSize;
+        /** @brief  The other sector is full and it's written */
+        volatile bool m_full;
+        /** @brief  State of the writing */
+        EState m_state;
+        /** @brief  Position of the next sector in the ring */
+        uint32_t m_position;
+        /** @brief  Session of the recording */
+        uint16_t m_session;
+        /** @brief  Sequence number of the next filled sector */
+        uint32_t m_sequence;
+        /** @brief  The frames are recorded */
+        volatile bool m_recording;
+        /** @brief  The start was requested */
+        volatile bool m_startRequest;
+        /** @brief  The stop was requested */
+        volatile bool m_stopRequest;
+        /** @brief  Number of the written sectors */
+        uint32_t m_written;
+        /** @brief  Number of the dropped frames */
+        volatile uint32_t m_overruns;
+        /** @brief  Number of the errors of the card */
+        uint32_t m_errors;
+    };
+
+}; // namespace utils::telemetry
+
+#endif // SD_LOG_SINK_HPP
@@ -0,0 +1,193 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    SignalScope.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the on-board signal scope.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef SIGNAL_SCOPE_HPP
+#define SIGNAL_SCOPE_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+
+namespace utils::telemetry{
+
+   /**
+    * @brief On-board signal scope, a triggered capture of the registered probes at a high rate (10-20 kHz), which the serial link
+    * cannot stream.
+    * 
+    * The probes are sampled by the interrupt of the scope timer (hardware::drivers::CScopeTimer_TIM9) in a circular buffer of frames, 
+    * a frame contains one raw int16_t value of each selected channel, so the probes have to be short functions reading a register or 
+    * a latched result (pwm compare, ADC result, encoder counter). The buffer has s_bufferSize values, so less channels give longer 
+    * captures. After the arming the buffer is filled with the pre-trigger part, then the trigger condition is checked in each frame: 
+    * the threshold (above or below) or the edge (rising or falling through the threshold) of a channel, or the fault reported by 
+    * 'fault'. The manual trigger is always accepted. After the post-trigger frames the buffer is frozen and the timer is stopped, 
+    * then the frames are dumped in binary messages (utils::serial::BIN_SCOPE_CAPTURE) by the task on the bulk link, the task is 
+    * periodic only during the dump.
+    * 
+    * Commands of the 'SCOP' key: '0' state ('state;cause;count;frames;frequency;;'), '1;frequency;post;mask' arm (post-trigger 
+    * frames, the optional mask selects the channels, default all), '2;mode;channel;threshold' set the trigger condition (ETriggerMode), 
+    * '3' manual trigger, '4' dump the frozen capture, '5' stop.
+    */
+    class CSignalScope: public utils::task::CTask
+    {
+    public:
+        /** @brief  Probe of a channel, it's applied from the interrupt of the scope timer */
+        typedef int16_t (*FProbe)();
+        /** @brief  States of the capture */
+        enum EState{
+            /** @brief the timer is stopped, the buffer isn't valid */
+            STATE_IDLE      = 0,
+            /** @brief the pre-trigger frames are recorded and the trigger is checked */
+            STATE_ARMED     = 1,
+            /** @brief the post-trigger frames are recorded */
+            STATE_TRIGGERED = 2,
+            /** @brief the capture is complete, it can be dumped */
+            STATE_FROZEN    = 3
+        };
+        /** @brief  Trigger conditions */
+        enum ETriggerMode{
+            /** @brief only the manual trigger */
+            TRIGGER_MANUAL  = 0,
+            /** @brief the channel is at or above the threshold */
+            TRIGGER_ABOVE   = 1,
+            /** @brief the channel is at or below the threshold */
+            TRIGGER_BELOW   = 2,
+            /** @brief the channel crosses the threshold upwards */
+            TRIGGER_RISING  = 3,
+            /** @brief the channel crosses the threshold downwards */
+            TRIGGER_FALLING = 4,
+            /** @brief a fault is reported by 'fault' */
+            TRIGGER_FAULT   = 5
+        };
+        /** @brief  Causes of the trigger, the cause is sent in the header of the dump */
+        enum ECause{
+            CAUSE_NONE      = 0,
+            CAUSE_MANUAL    = 1,
+            CAUSE_CONDITION = 2,
+            CAUSE_FAULT     = 3
+        };
+
+        /** @brief  Maximum number of the channels */
+        static const uint8_t s_maxChannels = 4;
+        /** @brief  Number of the values in the buffer, 8 kB, about 50 ms of four channels at 20 kHz */
+        static const uint32_t s_bufferSize = 4096;
+        /** @brief  Maximum sampling frequency in Hz */
+        static constexpr float s_maxFrequency = 25000.0f;
+
+        /* Constructor */
+        CSignalScope(utils::serial::CSerialTransmitter& f_serial, uint32_t f_dumpPeriod);
+        /* Register a channel */
+        int8_t addChannel(FProbe f_probe);
+        /* Set the trigger condition */
+        bool setTrigger(ETriggerMode f_mode, uint8_t f_channel, int16_t f_threshold);
+        /* Start the capture */
+        bool arm(float f_frequency, uint32_t f_postTrigger, uint8_t f_channelMask);
+        /* Trigger the capture manually */
+        void trigger();
+        /* Report a fault, it triggers the capture in TRIGGER_FAULT mode */
+        void fault();
+        /* Stop the capture */
+        void stop();
+        /* Start the dump of the frozen capture */
+        bool dump();
+        /** @brief  State of the capture */
+        EState getState() const
+        {
+            return m_state;
+        }
+        /** @brief  Number of the recorded frames */
+        uint32_t getCount() const
+        {
+            return m_count;
+        }
+        /* Serial callback of the commands */
+        void serialCallback(char const * a, char * b);
+    private:
+        /* Run method, it sends the frames of the dump */
+        virtual void _run();
+        /* Hook of the scope timer */
+        static void sampleHook();
+        /* Record a frame and check the trigger */
+        void sample();
+        /* Check the trigger condition */
+        bool isTriggered(int16_t f_value) const;
+
+        /** @brief  The armed scope */
+        static CSignalScope* s_instance;
+
+        /** @brief  Serial transmitter */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Period of the task during the dump in base ticks */
+        const uint32_t m_dumpPeriod;
+        /** @brief  Probes of the registered channels */
+        FProbe m_probes[s_maxChannels];
+        /** @brief  Number of the registered channels */
+        uint8_t m_probeCount;
+        /** @brief  Probes of the selected channels */
+        FProbe m_selected[s_maxChannels];
+        /** @brief  Number of the selected channels */
+        uint8_t m_channelCount;
+        /** @brief  Mask of the selected channels */
+        uint8_t m_channelMask;
+        /** @brief  Trigger condition */
+        ETriggerMode m_mode;
+        /** @brief  Registered channel of the trigger condition */
+        uint8_t m_triggerChannel;
+        /** @brief  Position of the trigger channel in the frame */
+        uint8_t m_triggerSlot;
+        /** @brief  Threshold of the trigger condition */
+        int16_t m_threshold;
+        /** @brief  Previous value of the trigger channel */
+        int16_t m_previous;
+        /** @brief  Number of the frames in the buffer */
+        uint32_t m_frames;
+        /** @brief  Number of the frames before the trigger, including the trigger frame */
+        uint32_t m_preTrigger;
+        /** @brief  Number of the frames after the trigger */
+        uint32_t m_postTrigger;
+        /** @brief  Remaining frames until the freezing */
+        uint32_t m_remaining;
+        /** @brief  Index of the next frame */
+        uint32_t m_head;
+        /** @brief  Number of the recorded frames */
+        volatile uint32_t m_count;
+        /** @brief  State of the capture */
+        volatile EState m_state;
+        /** @brief  Pending manual or fault trigger */
+        volatile uint8_t m_request;
+        /** @brief  Cause of the trigger */
+        volatile uint8_t m_cause;
+        /** @brief  Realized sampling frequency in Hz */
+        uint32_t m_frequency;
+        /** @brief  The dump is in progress */
+        volatile bool m_isDumping;
+        /** @brief  Index of the next dumped frame */
+        uint32_t m_dumpIdx;
+        /** @brief  Frames of the capture */
+        int16_t m_buffer[s_bufferSize];
+    };
+
+}; // namespace utils::telemetry
+
+#endif // SIGNAL_SCOPE_HPP
@@ -0,0 +1,217 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    Telemetry.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the telemetry channel.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <mbed.h>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/pipeline/pipeline.hpp>
+
+namespace utils::telemetry{
+
+    /** @brief Aggregation modes of a signal over the decimation window */
+    enum EAggregation{
+        /** @brief the last sampled value */
+        AGGR_NONE   = 0,
+        /** @brief minimum of the window */
+        AGGR_MIN    = 1,
+        /** @brief maximum of the window */
+        AGGR_MAX    = 2,
+        /** @brief mean of the window */
+        AGGR_MEAN   = 3
+    };
+
+    /** @brief Encoding modes of a signal in the batch */
+    enum EEncoding{
+        /** @brief 32-bit float value */
+        ENC_RAW     = 0,
+        /** @brief zigzag varint of the difference from the previous sample, the value is quantized by the decimals of the signal */
+        ENC_DELTA   = 1
+    };
+
+   /**
+    * @brief Sink of the encoded telemetry frames beside the serial link (e.g. a recorder on a storage).
+    */
+    class ITelemetrySink
+    {
+    public:
+        /** @brief  Write an encoded frame, it returns true, when the frame is recorded by the sink, so it isn't transmitted on the serial link. */
+        virtual bool write(const uint8_t* f_frame, uint32_t f_size) = 0;
+    };
+
+   /**
+    * @brief Telemetry channel, it samples the registered signals and it publishes them in binary batches (utils::serial::BIN_TELEMETRY).
+    * 
+    * The samples are collected in a double buffered block by the 'sample' method, which can be applied from interrupt (timer wheel or control loop) 
+    * up to the control rate. When a block is full, it's swapped with the other one and the task is notified to encode and transmit it, 
+    * meanwhile the sampling continues in the other block. When both blocks are full, the current block is discarded and the sequence 
+    * number is incremented, so the receiver detects the lost batch. The task has zero period, it's applied only by notification.
+    * 
+    * The host subscribes the published signals, the decimation factor and the aggregation mode of each signal, the signals aren't 
+    * published until the first subscription. The aggregated values are computed on-board over the decimation window. 
+    * 
+    * The slowly changing signals can be delta encoded: the value is quantized to the configured decimals, and the difference 
+    * from the previous sample of the batch is stored as a zigzag varint, which takes a single byte for small changes. The first 
+    * sample of each batch is relative to zero, so a lost batch doesn't corrupt the next one. The encoding is made in the 'sample' 
+    * method, when at least one subscribed signal is delta encoded, the batch is published as utils::serial::BIN_TELEMETRY_PACKED.
+    * 
+    * The encoded frames are offered to the attached sink first, the frames recorded by the sink aren't transmitted, so a recording 
+    * of each control tick doesn't load the serial link.
+    */
+    class CTelemetry: public utils::task::CTask, public utils::pipeline::IPipelineStage
+    {
+    public:
+        /** @brief  Getter of a signal, it's applied in the sampling context, so it has to be interrupt safe. */
+        typedef mbed::Callback<float()> FSignalGetter;
+
+        /* Constructor */
+        CTelemetry(utils::serial::CSerialTransmitter& f_serial);
+        /* Register a signal */
+        int8_t addSignal(FSignalGetter f_getter);
+        /* Sample the registered signals */
+        void sample();
+        /** @brief  Pipeline stage, it samples the signals at the end of the tick. */
+        virtual void process(uint32_t f_timestamp)
+        {
+            sample();
+        }
+        /* Start the periodic sampling by a timer of the timer wheel */
+        void start(utils::task::CTimerWheel& f_wheel, float f_period);
+        /* Stop the periodic sampling */
+        void stop();
+        /* Subscribe the published signals */
+        bool subscribe(uint8_t f_signalMask, uint16_t f_decimation);
+        /* Set the aggregation mode of a signal */
+        bool setAggregation(uint8_t f_index, EAggregation f_aggregation);
+        /* Set the encoding mode of a signal */
+        bool setEncoding(uint8_t f_index, EEncoding f_encoding, uint8_t f_decimals);
+        /** @brief  Attach the sink of the frames, NULL detaches it */
+        void setSink(ITelemetrySink* f_sink)
+        {
+            m_sink = f_sink;
+        }
+        /* Serial callback of the subscription */
+        void serialCallbackSubscribe(char const * a, char * b);
+        /* Serial callback of the aggregation mode */
+        void serialCallbackAggregate(char const * a, char * b);
+        /* Serial callback of the encoding mode */
+        void serialCallbackEncode(char const * a, char * b);
+        /* Binary callback of the subscription */
+        uint8_t binaryCallbackSubscribe(const utils::serial::STelemetrySubscribePayload& f_payload);
+        /** @brief  Number of the registered signals */
+        uint8_t getSignalCount() const
+        {
+            return m_signalCount;
+        }
+        /** @brief  Number of the discarded batches */
+        uint32_t getOverruns() const
+        {
+            return m_overruns;
+        }
+
+        /** @brief  Maximum number of the signals */
+        static const uint8_t s_maxSignals = 8;
+        /** @brief  Maximum number of the decimals of the delta encoding */
+        static const uint8_t s_maxDecimals = 6;
+        /** @brief  Number of the bytes of the samples in a block */
+        static const uint32_t s_blockBytes = utils::serial::CBinaryProtocol::s_maxPayloadSize - sizeof(utils::serial::STelemetryHeader);
+    private:
+        /** @brief  Block of samples */
+        struct SBlock{
+            /** @brief header of the batch */
+            utils::serial::STelemetryHeader m_header;
+            /** @brief timestamp of the last sample in microsecond */
+            uint32_t m_lastTimestamp;
+            /** @brief number of the encoded bytes */
+            uint32_t m_size;
+            /** @brief the block contains delta encoded signals, the encoding table precedes the samples */
+            bool m_packed;
+            /** @brief encoded samples */
+            uint8_t m_data[s_blockBytes];
+        };
+
+        /* Append the encoded value of a signal to the block */
+        uint8_t* encode(uint8_t f_index, float f_value, uint8_t* f_data);
+
+        /* Run method */
+        void _run();
+        /* Restart the block under sampling and the aggregation window, it has to be applied from critical section */
+        void restart();
+        /* Expiry callback of the sampling timer */
+        static void expireSampling(utils::task::CTimerWheel::CTimer& f_timer);
+
+        /** @brief  Serial transmitter */
+        utils::serial::CSerialTransmitter& m_serial;
+        /** @brief  Sink of the frames, NULL without sink */
+        ITelemetrySink* m_sink;
+        /** @brief  Getters of the signals */
+        FSignalGetter m_signals[s_maxSignals];
+        /** @brief  Number of the registered signals */
+        uint8_t m_signalCount;
+        /** @brief  Aggregation modes of the signals */
+        EAggregation m_aggregation[s_maxSignals];
+        /** @brief  Aggregated values of the current window */
+        float m_aggregated[s_maxSignals];
+        /** @brief  Encoding modes of the signals */
+        EEncoding m_encoding[s_maxSignals];
+        /** @brief  Quantization factors of the delta encoded signals */
+        float m_scale[s_maxSignals];
+        /** @brief  Code of each signal in the encoding table, the encoding mode in the upper and the decimals in the lower nibble */
+        uint8_t m_code[s_maxSignals];
+        /** @brief  Quantized previous values of the delta encoded signals in the current block */
+        int32_t m_previous[s_maxSignals];
+        /** @brief  Some subscribed signals are delta encoded */
+        bool m_packed;
+        /** @brief  Maximum size of an encoded sample in byte */
+        uint8_t m_sampleSize;
+        /** @brief  Mask of the subscribed signals */
+        volatile uint8_t m_signalMask;
+        /** @brief  Number of the subscribed signals */
+        uint8_t m_subscribedCount;
+        /** @brief  Decimation factor */
+        uint16_t m_decimation;
+        /** @brief  Number of the samplings in the current window */
+        uint16_t m_windowCount;
+        /** @brief  Double buffered blocks */
+        SBlock m_blocks[2];
+        /** @brief  Index of the block under sampling */
+        volatile uint8_t m_active;
+        /** @brief  The other block is full and it waits for the transmission */
+        volatile bool m_pending;
+        /** @brief  Sequence number of the next batch */
+        uint16_t m_sequence;
+        /** @brief  Number of the discarded batches */
+        volatile uint32_t m_overruns;
+        /** @brief  Timer wheel of the periodic sampling, NULL until the start */
+        utils::task::CTimerWheel* m_wheel;
+        /** @brief  Timer of the periodic sampling */
+        utils::task::CTimerWheel::CTimer m_timer;
+    };
+
+}; // namespace utils::telemetry
+
+#endif // TELEMETRY_HPP
@@ -0,0 +1,179 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    TraceStream.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the execution trace
+  *          on the debug port.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef TRACE_STREAM_HPP
+#define TRACE_STREAM_HPP
+
+#include <mbed.h>
+
+namespace utils::telemetry{
+
+   /**
+    * @brief Execution trace on the debug port, it doesn't use the serial links.
+    *
+    * The events are encoded as the software source packets of the ITM (a header byte with the stimulus port and the size, then 1, 2
+    * or 4 bytes of payload), so the same decoder reads both backends:
+    *  - ITM: the packets are written to the stimulus ports and sent on the SWO pin (PB3) with the hardware timestamps, the ST-Link
+    *    captures them (e.g. by 'openocd ... -c "tpiu config internal - uart off 84000000 2000000"', orbuculum or pyocd swv). The motor
+    *    pwm occupies PB3 on the BFMC wiring, so the backend isn't started, when the pin has an other alternate function.
+    *  - RTT: the packets are written in a RAM ring buffer with a SEGGER RTT compatible control block, the debugger reads it over SWD
+    *    without stopping the core (e.g. 'rtt setup' of OpenOCD), so it doesn't need a pin. Each event is preceded by the value of the
+    *    cycle counter on the timestamp port.
+    *
+    * The ports: 1 task events (16 bits: kind in the high byte, 1 start and 2 stop, index of the task in the task list in the low byte,
+    * s_controlTick for the tick of the control loop), 2 interrupt events (8 bits: IRQ number, bit 7 set at the exit), 8 + channel the
+    * telemetry samples (32 bit float), 31 the timestamp of the RTT backend. The event hooks cost a load and a branch, while the class of
+    * the event isn't enabled. An event is dropped instead of waiting, when the FIFO of the ITM or the ring buffer is full.
+    *
+    * Commands of the 'TRCE' key: '0' state ('backend;events;dropped;;'), '1;backend;events' start (backend 1: ITM, 2: RTT, events:
+    * mask of tasks 1, interrupts 2, samples 4), '2' stop.
+    */
+    class CTraceStream
+    {
+    public:
+        /** @brief  Output of the packets */
+        enum EBackend{
+            BACKEND_OFF = 0,
+            BACKEND_ITM = 1,
+            BACKEND_RTT = 2
+        };
+        /** @brief  Classes of the events, bits of the event mask */
+        enum EEvents{
+            EVENTS_TASKS   = 0x1,
+            EVENTS_ISR     = 0x2,
+            EVENTS_SAMPLES = 0x4
+        };
+        /** @brief  Stimulus ports of the events */
+        enum EPort{
+            PORT_TASK      = 1,
+            PORT_ISR       = 2,
+            PORT_SAMPLE    = 8,
+            PORT_TIMESTAMP = 31
+        };
+        /** @brief  Number of the telemetry channels */
+        static const uint8_t s_sampleChannels = 16;
+        /** @brief  Task index of the control loop tick */
+        static const uint8_t s_controlTick = 0xFF;
+        /** @brief  Default bit rate of the SWO pin, the maximum of the ST-Link V2-1 */
+        static const uint32_t s_defaultSwoFrequency = 2000000;
+        /** @brief  Size of the RTT ring buffer in bytes */
+        static const uint32_t s_rttSize = 2048;
+
+        /* Start the trace */
+        static bool start(EBackend f_backend, uint32_t f_events, uint32_t f_swoFrequency = s_defaultSwoFrequency);
+        /* Stop the trace */
+        static void stop();
+        /** @brief  Start of a task */
+        static inline void taskStart(uint32_t f_task)
+        {
+            if (s_events & EVENTS_TASKS)
+            {
+                emit(PORT_TASK, 0x100U | (f_task & 0xFFU), 2);
+            }
+        }
+        /** @brief  End of a task */
+        static inline void taskStop(uint32_t f_task)
+        {
+            if (s_events & EVENTS_TASKS)
+            {
+                emit(PORT_TASK, 0x200U | (f_task & 0xFFU), 2);
+            }
+        }
+        /** @brief  Entry of an interrupt handler */
+        static inline void isrEnter(IRQn_Type f_irq)
+        {
+            if (s_events & EVENTS_ISR)
+            {
+                emit(PORT_ISR, static_cast<uint32_t>(f_irq) & 0x7FU, 1);
+            }
+        }
+        /** @brief  Exit of an interrupt handler */
+        static inline void isrExit(IRQn_Type f_irq)
+        {
+            if (s_events & EVENTS_ISR)
+            {
+                emit(PORT_ISR, 0x80U | (static_cast<uint32_t>(f_irq) & 0x7FU), 1);
+            }
+        }
+        /** @brief  Telemetry sample of a channel */
+        static inline void sample(uint8_t f_channel, float f_value)
+        {
+            if ((s_events & EVENTS_SAMPLES) && f_channel < s_sampleChannels)
+            {
+                union {float m_float; uint32_t m_bits;} l_value;
+                l_value.m_float = f_value;
+                emit(PORT_SAMPLE + f_channel, l_value.m_bits, 4);
+            }
+        }
+        /** @brief  Number of the dropped events since the start */
+        static uint32_t getDropped()
+        {
+            return s_dropped;
+        }
+        /* Serial callback of the commands */
+        static void serialCallback(char const * a, char * b);
+    private:
+        /** @brief  Buffer descriptor of the RTT control block */
+        struct SRttBuffer{
+            const char*         m_name;
+            char*               m_buffer;
+            uint32_t            m_size;
+            volatile uint32_t   m_writeOffset;
+            volatile uint32_t   m_readOffset;
+            uint32_t            m_flags;
+        };
+        /** @brief  RTT control block, one up buffer and one unused down buffer, the debugger finds it by the identifier */
+        struct SRttControlBlock{
+            char                m_id[16];
+            int32_t             m_maxUpBuffers;
+            int32_t             m_maxDownBuffers;
+            SRttBuffer          m_up;
+            SRttBuffer          m_down;
+        };
+
+        /* Write a packet by the active backend */
+        static void emit(uint8_t f_port, uint32_t f_value, uint8_t f_size);
+        /* Configure the trace port of the ITM */
+        static bool startItm(uint32_t f_swoFrequency);
+        /* Initialize the RTT control block */
+        static void startRtt();
+        /* Write a packet in the ring buffer */
+        static void writeRtt(uint8_t f_port, uint32_t f_value, uint8_t f_size);
+
+        /** @brief  Enabled classes of the events, zero while the trace isn't active */
+        static volatile uint32_t s_events;
+        /** @brief  Active backend */
+        static volatile EBackend s_backend;
+        /** @brief  Number of the dropped events */
+        static volatile uint32_t s_dropped;
+        /** @brief  RTT control block */
+        static SRttControlBlock s_rtt;
+        /** @brief  Ring buffer of the RTT backend */
+        static char s_rttBuffer[s_rttSize];
+    };
+
+}; // namespace utils::telemetry
+
+#endif // TRACE_STREAM_HPP
@@ -0,0 +1,150 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    FirmwareUpdate.hpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class declaration for the firmware update
+  *          over the serial link.
+  ******************************************************************************
+ */
+
+/* Inclusion guard */
+#ifndef FIRMWARE_UPDATE_HPP
+#define FIRMWARE_UPDATE_HPP
+
+#include <mbed.h>
+#include <hardware/drivers/internalflash.hpp>
+#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/serial/protocolmessages.hpp>
+
+namespace utils::update{
+
+   /**
+    * @brief Firmware update over the binary protocol, the new image is staged in a free sector and installed by a resident routine.
+    *
+    * The host starts the update with the size and the CRC32 of the image (BIN_UPDATE_BEGIN), the staging sector is erased by the task.
+    * The image is sent in consecutive blocks (BIN_UPDATE_BLOCK), each block is LZ4 compressed and checked by the CRC16 of its
+    * decompressed bytes. The blocks are decompressed by the serial callback in one of the two RAM buffers, while the task programs the
+    * other full buffer, so the reception continues during the programming. When both buffers are busy, the block is refused with
+    * BIN_QUEUE_FULL and the host sends it again; a corrupted block is refused with BIN_SYNTAX_ERROR, a repeated block (lost response)
+    * is acknowledged again. After the last block the staged image is verified by its CRC32, the end (BIN_UPDATE_END) is refused with
+    * BIN_QUEUE_FULL until the verification finishes. With 'apply' the verified image is copied over the program sectors by a routine
+    * executed from the RAM with disabled interrupts, then the board is reset into the new image.
+    *
+    * The erasing of the sectors stalls the execution from the flash, it's executed from the RAM with disabled interrupts, while the
+    * watchdog is refreshed, so the control loop stops for 1-2 s. The update is accepted only while the write guard allows it (the robot
+    * doesn't move). The installing can't be interrupted: a power loss during it leaves the board without program, it has to be flashed
+    * by the debugger.
+    */
+    class CFirmwareUpdate: public utils::task::CTask
+    {
+    public:
+        /** @brief  State of the update */
+        enum EState
+        {
+            IDLE,           /**< no update */
+            ERASING,        /**< the staging sector is erased */
+            RECEIVING,      /**< the blocks are received and programmed */
+            VERIFYING,      /**< the staged image is verified */
+            READY,          /**< the staged image is valid */
+            INSTALLING,     /**< the staged image is installed */
+            FAILED          /**< the erasing, the programming or the verification failed */
+        };
+        /** @brief  Query, whether the flash can be written. */
+        typedef mbed::Callback<bool()> FWriteGuard;
+
+        /* Constructor */
+        CFirmwareUpdate(const hardware::drivers::CInternalFlash::SSector& f_staging, const hardware::drivers::CInternalFlash::SSector* f_program, uint8_t f_programCount);
+        /* Set the write guard */
+        void setWriteGuard(FWriteGuard f_guard);
+        /* Binary callback of the start of the update */
+        uint8_t binaryCallbackBegin(const utils::serial::SUpdateBeginPayload& f_payload);
+        /* Binary callback of a block */
+        uint8_t binaryCallbackBlock(const uint8_t* f_payload, uint8_t f_length);
+        /* Binary callback of the end of the update */
+        uint8_t binaryCallbackEnd(const utils::serial::SUpdateEndPayload& f_payload);
+        /** @brief  State of the update */
+        EState getState() const
+        {
+            return m_state;
+        }
+        /* Decompress a LZ4 block */
+        static int32_t decompress(const uint8_t* f_source, uint32_t f_length, uint8_t* f_dest, uint32_t f_capacity);
+        /* Compute the CRC32 checksum */
+        static uint32_t crc32(const uint8_t* f_data, uint32_t f_length, uint32_t f_crc = 0);
+
+        /** @brief  Size of a RAM buffer, a multiple of the maximum block */
+        static const uint32_t s_bufferSize = 2048;
+        /** @brief  Maximum decompressed length of a block */
+        static const uint32_t s_maxBlockLength = 1024;
+        /** @brief  Maximum number of the program sectors */
+        static const uint8_t s_maxProgramSectors = 8;
+    private:
+        /* Run method */
+        virtual void _run();
+        /* Hand the filled buffer to the task */
+        void submit();
+        /* Program the pending buffers */
+        bool programPending();
+        /* The write guard allows the update */
+        bool isAllowed();
+        /* Erase a sector from the RAM */
+        static bool eraseResident(uint8_t f_number);
+        /* Install the staged image from the RAM and reset */
+        static void installResident(const uint8_t* f_sectors, uint8_t f_count, uint32_t f_address, const uint32_t* f_image, uint32_t f_words);
+
+        /** @brief  Staging sector */
+        const hardware::drivers::CInternalFlash::SSector m_staging;
+        /** @brief  Numbers of the program sectors, they are erased by the installing */
+        uint8_t m_programSectors[s_maxProgramSectors];
+        /** @brief  Number of the program sectors */
+        uint8_t m_programCount;
+        /** @brief  Start address of the program */
+        uint32_t m_programAddress;
+        /** @brief  Size of the program sectors */
+        uint32_t m_programSize;
+        /** @brief  Write guard */
+        FWriteGuard m_guard;
+        /** @brief  State of the update */
+        volatile EState m_state;
+        /** @brief  Size of the image */
+        uint32_t m_size;
+        /** @brief  CRC32 of the image */
+        uint32_t m_crc;
+        /** @brief  Received bytes of the image */
+        uint32_t m_received;
+        /** @brief  Programmed bytes of the image */
+        volatile uint32_t m_programmed;
+        /** @brief  RAM buffers, word aligned for the programming */
+        uint32_t m_buffers[2][s_bufferSize / 4];
+        /** @brief  Offset of the buffers in the image */
+        uint32_t m_bases[2];
+        /** @brief  Filled bytes of the buffers */
+        uint32_t m_counts[2];
+        /** @brief  The buffer waits for the programming */
+        volatile bool m_pending[2];
+        /** @brief  Buffer of the reception */
+        uint8_t m_fillIdx;
+        /** @brief  Buffer of the programming */
+        uint8_t m_programIdx;
+        /** @brief  The verified image has to be installed */
+        volatile bool m_install;
+    };
+
+}; // namespace utils::update
+
+#endif // FIRMWARE_UPDATE_HPP
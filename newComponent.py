@@ -1,10 +1,12 @@
 from sys import argv
 import os
+import re
 import argparse
 import datetime
 
-include_dir="include\\"
-source_dir="src\\"
+include_dir="include"
+source_dir="src"
+makefile="Makefile"
 
 
 header_note=('/**\n'+
@@ -17,25 +19,200 @@ header_note=('/**\n'+
 '******************************************************************************\n'+
 '*/\n')
 
+license_note=('/**\n'+
+'Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers\n'+
+'\n'+
+'Licensed under the Apache License, Version 2.0 (the "License");\n'+
+'you may not use this file except in compliance with the License.\n'+
+'You may obtain a copy of the License at\n'+
+'\n'+
+'    http://www.apache.org/licenses/LICENSE-2.0\n'+
+'\n'+
+'Unless required by applicable law or agreed to in writing, software\n'+
+'distributed under the License is distributed on an "AS IS" BASIS,\n'+
+'WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n'+
+'See the License for the specific language governing permissions and\n'+
+'limitations under the License.\n'+
+'  ******************************************************************************\n'+
+'  * @file    %s\n'+
+'  * @author  RBRO/PJ-IU\n'+
+'  * @version V1.0.0\n'+
+'  * @date    %s\n'+
+'  * @brief   This file contains the class %s for the %s.\n'+
+'  ******************************************************************************\n'+
+' */\n')
+
+# Skeleton of a task component, the fields are: guard, include path of the header, namespace, brief, class name
+task_header=('\n'+
+'/* Inclusion guard */\n'+
+'#ifndef {guard}\n'+
+'#define {guard}\n'+
+'\n'+
+'#include <mbed.h>\n'+
+'#include <utils/taskmanager/taskmanager.hpp>\n'+
+'\n'+
+'namespace {namespace}{{\n'+
+'\n'+
+'   /**\n'+
+'    * @brief {brief}\n'+
+'    *\n'+
+'    * The task is instrumented by its entry in the task list of main, the task monitor measures its execution time and jitter\n'+
+'    * (\'TSKS\' key). The output is a telemetry signal, the serial callback is registered in the dispatch table of the monitor.\n'+
+'    */\n'+
+'    class {cls}: public utils::task::CTask\n'+
+'    {{\n'+
+'    public:\n'+
+'        /* Constructor */\n'+
+'        {cls}(uint32_t f_period);\n'+
+'        /** @brief  Output of the component, it\'s sampled by the telemetry */\n'+
+'        float getValue()\n'+
+'        {{\n'+
+'            return m_value;\n'+
+'        }}\n'+
+'        /* Serial callback */\n'+
+'        void serialCallback(char const * a, char * b);\n'+
+'    private:\n'+
+'        /* Run method */\n'+
+'        void _run();\n'+
+'\n'+
+'        /** @brief  Output of the component */\n'+
+'        volatile float m_value;\n'+
+'    }};\n'+
+'\n'+
+'}}; // namespace {namespace}\n'+
+'\n'+
+'#endif // {guard}\n')
+
+task_source=('\n'+
+'#include <{header}>\n'+
+'#include <utils/fmt/format.hpp>\n'+
+'\n'+
+'namespace {namespace}{{\n'+
+'\n'+
+'    /** \\brief  {cls} class constructor\n'+
+'     *\n'+
+'     *  @param f_period        period of the task in base ticks\n'+
+'     */\n'+
+'    {cls}::{cls}(uint32_t f_period)\n'+
+'        : utils::task::CTask(f_period)\n'+
+'        , m_value(0.0f)\n'+
+'    {{\n'+
+'    }}\n'+
+'\n'+
+'    /** \\brief  Run method, it\'s applied by the task manager in each period.\n'+
+'     */\n'+
+'    void {cls}::_run()\n'+
+'    {{\n'+
+'    }}\n'+
+'\n'+
+'    /** \\brief  Serial callback. The optional parameter sets the output, the response contains the output.\n'+
+'     *\n'+
+'     *  @param a               string to read data from\n'+
+'     *  @param b               string to write data to\n'+
+'     */\n'+
+'    void {cls}::serialCallback(char const * a, char * b)\n'+
+'    {{\n'+
+'        float l_value;\n'+
+'        if (1 == utils::fmt::parseFloats(a, &l_value, 1))\n'+
+'        {{\n'+
+'            m_value = l_value;\n'+
+'        }}\n'+
+'        utils::fmt::CWriter(b).fixed(m_value, 3).chr(\';\');\n'+
+'    }}\n'+
+'\n'+
+'}}; // namespace {namespace}\n')
+
+# Wiring of a task component in main.cpp, it's printed, because the sections of main are edited by hand
+task_wiring=('Wiring of the component in src/main.cpp:\n'+
+'\n'+
+'  // includes\n'+
+'  #include <{header}>\n'+
+'\n'+
+'  // globals\n'+
+'  /// Create the {brief_lower}\n'+
+'  {namespace}::{cls} {glob}(g_vehicle.ticks({period}f));\n'+
+'  float {getter}() {{ return {glob}.getValue(); }}\n'+
+'\n'+
+'  // g_serialMonitorSubscribers\n'+
+'  {{utils::serial::CSerialMonitor::key("{key}"),FCommand::bind<{namespace}::{cls},&{namespace}::{cls}::serialCallback>(&{glob})}},\n'+
+'\n'+
+'  // g_taskList, the task statistics are collected for each entry\n'+
+'  &{glob},\n'+
+'\n'+
+'  // initControllers, the telemetry has at most 8 signals\n'+
+'  g_telemetry.addSignal({getter});\n'+
+'\n'+
+'  // main, priority class of the task\n'+
+'  {glob}.setPriorityClass(utils::task::{priority});\n'+
+'\n'+
+'  // g_memoryReport\n'+
+'  + sizeof({glob})\n')
+
 
 def check(compName,subdirectory,newDirectory):
-        
+
     if newDirectory:
-        isNotExist = not os.path.exists(include_dir +subdirectory+compName) and not os.path.exists(source_dir +subdirectory+compName)
+        isNotExist = not os.path.exists(os.path.join(include_dir,subdirectory,compName)) and not os.path.exists(os.path.join(source_dir,subdirectory,compName))
         return isNotExist
     else:
 
         lowcaseName=compName.lower()
-        isNotExist = not os.path.exists(include_dir +subdirectory+lowcaseName+".hpp") and not os.path.exists(include_dir +subdirectory+lowcaseName+".inl") and not os.path.exists(source_dir +subdirectory+lowcaseName+".cpp")
+        isNotExist = not os.path.exists(os.path.join(include_dir,subdirectory,lowcaseName+".hpp")) and not os.path.exists(os.path.join(include_dir,subdirectory,lowcaseName+".inl")) and not os.path.exists(os.path.join(source_dir,subdirectory,lowcaseName+".cpp"))
         return isNotExist
     return False
 
 
+def addObject(objectPath):
+    """Add the object of the new source after the last 'OBJECTS += src/...' line of the Makefile."""
+    if not os.path.exists(makefile):
+        print("Makefile not found, add 'OBJECTS += %s' by hand"%objectPath)
+        return
+    with open(makefile) as f:
+        lines = f.readlines()
+    entry = "OBJECTS += %s\n"%objectPath
+    if entry in lines:
+        return
+    last = None
+    for i, line in enumerate(lines):
+        if line.startswith("OBJECTS += src/") and line.strip() != "OBJECTS += src/main.o":
+            last = i
+    if last is None:
+        print("OBJECTS list not found, add 'OBJECTS += %s' by hand"%objectPath)
+        return
+    lines.insert(last + 1, entry)
+    with open(makefile, 'w') as f:
+        f.writelines(lines)
+    print("Makefile:", entry.strip())
+
+
+def writeTask(name, include_path, source_path, src_include, namespace, key, period, priority, today):
+    lowercaseName = name.lower()
+    cls = "C" + name
+    brief = re.sub(r'(?<!^)(?=[A-Z])', ' ', name).lower()
+    header = src_include + lowercaseName + ".hpp"
+    guard = re.sub(r'(?<!^)(?=[A-Z])', '_', name).upper() + "_HPP"
+    fields = dict(guard=guard, header=header, namespace=namespace, brief="Task of the " + brief + ".", cls=cls)
+    with open(os.path.join(include_path, lowercaseName + ".hpp"), 'w') as f:
+        f.write(license_note%(lowercaseName + ".hpp", today, "declaration", brief))
+        f.write(task_header.format(**fields))
+    with open(os.path.join(source_path, lowercaseName + ".cpp"), 'w') as f:
+        f.write(license_note%(lowercaseName + ".cpp", today, "definition", brief))
+        f.write(task_source.format(**fields))
+    glob = "g_" + name[0].lower() + name[1:]
+    print()
+    print(task_wiring.format(header=header, brief_lower="task of the " + brief, namespace=namespace, cls=cls, glob=glob, period=period
+                            , getter="telemetry" + name, key=key, priority=priority))
+
+
 def main():
     parser = argparse.ArgumentParser(description="This script create a the directories, the source and the include files for the new component.")
     parser.add_argument("-c","--component",help="Get the name of the new component.",required=True,dest="component")
     parser.add_argument("-sb","--subdirectory",help="Get the path in for the components.",dest="subdir")
     parser.add_argument("-n","--newDirectory",help="Make new directory with the component name in the subdirectory.",action='store_true',dest="isCreateDir")
+    parser.add_argument("-t","--task",help="Create a task skeleton with its telemetry signal, serial callback and the wiring in main.",action='store_true',dest="isTask")
+    parser.add_argument("-k","--key",help="Key of the serial callback of the task (4 characters).",dest="key")
+    parser.add_argument("-p","--period",help="Period of the task in second.",default="0.01",dest="period")
+    parser.add_argument("--priority",help="Priority class of the task.",choices=["REALTIME","NORMAL","BACKGROUND"],default="NORMAL",dest="priority")
 
     parser_result=parser.parse_args()
 
@@ -45,43 +222,50 @@ def main():
     print("Create a new directory:",parser_result.isCreateDir)
     if (parser_result.subdir is None):
         parser_result.subdir=""
-    elif (parser_result.subdir[-1]!='\\' or parser_result.subdir[-1]!='/'):
-        parser_result.subdir+='\\'
-    
+    parser_result.subdir=parser_result.subdir.replace('\\','/').strip('/')
+    if parser_result.key is None:
+        parser_result.key=parser_result.component[:4].upper().ljust(4,'X')
+    elif len(parser_result.key)!=4:
+        print("the key has to contain 4 characters")
+        return
+
     isNotExist=check(parser_result.component,parser_result.subdir,parser_result.isCreateDir)
     if isNotExist:
         today = datetime.date.today()
-        source_path = source_dir + parser_result.subdir
-        include_path = include_dir + parser_result.subdir
-        src_include = parser_result.subdir
+        subdir = parser_result.subdir
         if parser_result.isCreateDir:
-            os.makedirs(include_dir + parser_result.subdir + parser_result.component)
-            os.makedirs(source_dir + parser_result.subdir + parser_result.component)
-            source_path = source_dir + parser_result.subdir + parser_result.component+"\\"
-            include_path = include_dir + parser_result.subdir + parser_result.component+"\\"
-            src_include= parser_result.subdir + parser_result.component+"/"
-        if not os.path.exists(include_dir +parser_result.subdir):
-            os.makedirs(include_dir +parser_result.subdir)
-        if not os.path.exists(source_dir +parser_result.subdir):
-            os.makedirs(source_dir +parser_result.subdir)
+            subdir = os.path.join(subdir, parser_result.component).strip('/')
+        source_path = os.path.join(source_dir, subdir)
+        include_path = os.path.join(include_dir, subdir)
+        src_include = subdir + "/" if subdir else ""
+        if not os.path.exists(include_path):
+            os.makedirs(include_path)
+        if not os.path.exists(source_path):
+            os.makedirs(source_path)
         lowercaseName=parser_result.component.lower()
-        file = open(include_path+lowercaseName+".hpp", 'w')
-        # note=header_note%lowercaseName
-        file.writelines(header_note%(lowercaseName+".hpp",today))
-        file.writelines("#ifndef " + lowercaseName.upper() + "_H\n")
-        file.writelines("#define " + lowercaseName.upper() + "_H\n")
-        file.writelines('#include "' + lowercaseName +'.inl"\n')
-        file.writelines("#endif // " + lowercaseName.upper() + "_H\n")
-        file.close()
-        file = open(include_path+lowercaseName + ".inl", 'w')
-        file.writelines("\n")
-        file.close()
-        file = open(source_path+lowercaseName + ".cpp", 'w')
-        file.writelines("#include <" +src_include + lowercaseName +".hpp>\n")
-        file.close()
+        if parser_result.isTask:
+            namespace = "::".join(subdir.split("/")) if subdir else "app"
+            writeTask(parser_result.component, include_path, source_path, src_include, namespace, parser_result.key
+                     , parser_result.period, parser_result.priority, today)
+        else:
+            file = open(os.path.join(include_path,lowercaseName+".hpp"), 'w')
+            # note=header_note%lowercaseName
+            file.writelines(header_note%(lowercaseName+".hpp",today))
+            file.writelines("#ifndef " + lowercaseName.upper() + "_H\n")
+            file.writelines("#define " + lowercaseName.upper() + "_H\n")
+            file.writelines('#include "' + lowercaseName +'.inl"\n')
+            file.writelines("#endif // " + lowercaseName.upper() + "_H\n")
+            file.close()
+            file = open(os.path.join(include_path,lowercaseName + ".inl"), 'w')
+            file.writelines("\n")
+            file.close()
+            file = open(os.path.join(source_path,lowercaseName + ".cpp"), 'w')
+            file.writelines("#include <" +src_include + lowercaseName +".hpp>\n")
+            file.close()
+        addObject(source_dir + "/" + src_include + lowercaseName + ".o")
     else:
         print("component already exists")
 
 
 if __name__=="__main__":
-    main()
\ No newline at end of file
+    main()
@@ -0,0 +1,295 @@
+"""Generator of the protocol codecs from the protocol definition (protocol/protocol.json).
+
+It writes the message identifiers, the status codes and the packed payload structures of the board with their range
+checks (include/utils/serial/protocolmessages.hpp), the field schemas of the text commands with the same payload
+(include/utils/serial/protocolschemas.hpp), the identifiers and the argument sizes of the log events
+(include/utils/log/logevents.hpp) and the host codecs with the format strings of the events (host/protocolmessages.py). The
+generated files are committed, so the build of the board doesn't need python. The '--check' option verifies that they are up to date.
+
+Usage: python protocolGenerator.py [--check]
+"""
+import argparse
+import json
+import os
+import sys
+
+definition_file = os.path.join("protocol", "protocol.json")
+messages_header = os.path.join("include", "utils", "serial", "protocolmessages.hpp")
+schemas_header = os.path.join("include", "utils", "serial", "protocolschemas.hpp")
+events_header = os.path.join("include", "utils", "log", "logevents.hpp")
+host_module = os.path.join("host", "protocolmessages.py")
+
+# C++ type -> (struct format, size, schema type)
+types = {
+    "uint8_t": ("B", 1, "FIELD_UINT"),
+    "int8_t": ("b", 1, "FIELD_INT"),
+    "uint16_t": ("H", 2, "FIELD_UINT"),
+    "int16_t": ("h", 2, "FIELD_INT"),
+    "uint32_t": ("I", 4, "FIELD_UINT"),
+    "int32_t": ("i", 4, "FIELD_INT"),
+    "float": ("f", 4, "FIELD_FLOAT"),
+}
+
+license_note = ('/**\n'
+'Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers \n'
+'\n'
+'Licensed under the Apache License, Version 2.0 (the "License");\n'
+'you may not use this file except in compliance with the License.\n'
+'You may obtain a copy of the License at\n'
+'\n'
+'    http://www.apache.org/licenses/LICENSE-2.0\n'
+'\n'
+'Unless required by applicable law or agreed to in writing, software\n'
+'distributed under the License is distributed on an "AS IS" BASIS,\n'
+'WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n'
+'See the License for the specific language governing permissions and\n'
+'limitations under the License.\n'
+'\n'
+'  ******************************************************************************\n'
+'  * @file    %s\n'
+'  * @author  RBRO/PJ-IU\n'
+'  * @version V1.0.0\n'
+'  * @date    day-month-2019\n'
+'  * @brief   %s\n'
+'  *          It\'s generated by protocolGenerator.py from protocol/protocol.json, don\'t edit it.\n'
+'  ******************************************************************************\n'
+' */\n')
+
+
+def literal(f_field, f_value):
+    if f_field["type"] == "float":
+        return repr(float(f_value)) + "f"
+    return str(int(f_value))
+
+
+def shortName(f_struct):
+    """'SMovePayload' -> 'move', the prefix of the generated schema constants."""
+    l_name = f_struct["name"][1:]
+    if l_name.endswith("Payload"):
+        l_name = l_name[:-len("Payload")]
+    return l_name[0].lower() + l_name[1:]
+
+
+def generateMessages(f_definition):
+    l_lines = [license_note % ("ProtocolMessages.hpp", "This file contains the identifiers, the status codes and the payloads of the binary protocol."),
+               "",
+               "/* Inclusion guard */",
+               "#ifndef PROTOCOL_MESSAGES_HPP",
+               "#define PROTOCOL_MESSAGES_HPP",
+               "",
+               "#include <stdint.h>",
+               "",
+               "namespace utils::serial{",
+               ""]
+    for l_enum in f_definition["enums"]:
+        l_lines.append("    /** @brief %s */" % l_enum["doc"])
+        l_lines.append("    enum %s{" % l_enum["name"])
+        l_width = max(len(v["name"]) for v in l_enum["values"])
+        for i, l_value in enumerate(l_enum["values"]):
+            l_lines.append("        /** @brief %s */" % l_value["doc"])
+            l_lines.append("        %s = %s%s" % (l_value["name"].ljust(l_width), l_value["value"], "," if i + 1 < len(l_enum["values"]) else ""))
+        l_lines.append("    };")
+        l_lines.append("")
+    for l_struct in f_definition["structs"]:
+        l_lines.append("    /** @brief %s */" % l_struct["doc"])
+        l_lines.append("    struct %s{" % l_struct["name"])
+        for l_field in l_struct["fields"]:
+            l_doc = l_field["doc"]
+            if "min" in l_field:
+                l_doc += ", range [%g, %g] %s" % (l_field["min"], l_field["max"], l_field.get("unit", ""))
+            l_lines.append("        /** @brief %s */" % l_doc.rstrip())
+            l_lines.append("        %s %s;" % (l_field["type"], l_field["name"]))
+        l_lines.append("    } __attribute__((packed));")
+        l_lines.append("    static_assert(sizeof(%s) == %d, \"The layout of %s differs from the protocol definition.\");"
+                       % (l_struct["name"], sum(types[f["type"]][1] for f in l_struct["fields"]), l_struct["name"]))
+        l_lines.append("")
+    l_lines += ["    /** @brief  Range check of the payloads, it's applied to the received payload before its callback */",
+                "    template<class TPayload>",
+                "    struct SPayloadTraits;",
+                ""]
+    for l_struct in f_definition["structs"]:
+        l_checked = [(i, f) for i, f in enumerate(l_struct["fields"]) if "min" in f]
+        l_lines.append("    /** @brief  Range check of %s */" % l_struct["name"])
+        l_lines.append("    template<>")
+        l_lines.append("    struct SPayloadTraits<%s>{" % l_struct["name"])
+        l_lines.append("        /** @brief  It returns the status code (BIN_ACK or BIN_VALUE_RANGE) and the one-based index of the rejected field. */")
+        if not l_checked:
+            l_lines.append("        static uint8_t validate(const %s&, uint8_t& f_field)" % l_struct["name"])
+            l_lines.append("        {")
+        else:
+            l_lines.append("        static uint8_t validate(const %s& f_payload, uint8_t& f_field)" % l_struct["name"])
+            l_lines.append("        {")
+            for i, l_field in l_checked:
+                # The negated comparison rejects the NaN values too
+                l_lines.append("            if (!(f_payload.%s >= %s && f_payload.%s <= %s))"
+                               % (l_field["name"], literal(l_field, l_field["min"]), l_field["name"], literal(l_field, l_field["max"])))
+                l_lines.append("            {")
+                l_lines.append("                f_field = %d;" % (i + 1))
+                l_lines.append("                return BIN_VALUE_RANGE;")
+                l_lines.append("            }")
+        l_lines.append("            f_field = 0;")
+        l_lines.append("            return BIN_ACK;")
+        l_lines.append("        }")
+        l_lines.append("    };")
+        l_lines.append("")
+    l_lines += ["}; // namespace utils::serial", "", "#endif // PROTOCOL_MESSAGES_HPP", ""]
+    return "\n".join(l_lines)
+
+
+def generateSchemas(f_definition):
+    l_lines = [license_note % ("ProtocolSchemas.hpp", "This file contains the schemas of the text commands, which have the fields of a binary payload."),
+               "",
+               "/* Inclusion guard */",
+               "#ifndef PROTOCOL_SCHEMAS_HPP",
+               "#define PROTOCOL_SCHEMAS_HPP",
+               "",
+               "#include <utils/serial/commandschema.hpp>",
+               "",
+               "namespace utils::serial::schema{",
+               ""]
+    for l_struct in f_definition["structs"]:
+        if not l_struct.get("text"):
+            continue
+        l_name = shortName(l_struct)
+        l_fields = []
+        for l_field in l_struct["fields"]:
+            l_fieldName = l_name + l_field["name"][2].upper() + l_field["name"][3:] + "Field"
+            l_fields.append("s_" + l_fieldName)
+            l_lines.append("    /** @brief  Field of %s::%s, %s */" % (l_struct["name"], l_field["name"], l_field["doc"]))
+            l_lines.append("    static const SField s_%s = {%s, %s, %s, \"%s\"};"
+                           % (l_fieldName, types[l_field["type"]][2], literal({"type": "float"}, l_field.get("min", -1e9)),
+                              literal({"type": "float"}, l_field.get("max", 1e9)), l_field.get("unit", "")))
+        l_lines.append("    /** @brief  Fields of the text command with %s */" % l_struct["name"])
+        l_lines.append("    static const SField s_%sFields[] = {%s};" % (l_name, ", ".join(l_fields)))
+        l_lines.append("")
+    l_lines += ["}; // namespace utils::serial::schema", "", "#endif // PROTOCOL_SCHEMAS_HPP", ""]
+    return "\n".join(l_lines)
+
+
+def generateEvents(f_definition):
+    l_lines = [license_note % ("LogEvents.hpp", "This file contains the identifiers and the argument sizes of the deferred-format log events."),
+               "",
+               "/* Inclusion guard */",
+               "#ifndef LOG_EVENTS_HPP",
+               "#define LOG_EVENTS_HPP",
+               "",
+               "#include <stdint.h>",
+               "",
+               "namespace utils::log{",
+               "",
+               "    /** @brief Identifiers of the log events, the host formats them by the string table of protocolmessages.py */",
+               "    enum ELogEvent{"]
+    l_events = f_definition.get("events", [])
+    l_width = max([len(e["name"]) for e in l_events] + [1])
+    for i, l_event in enumerate(l_events):
+        l_lines.append("        /** @brief %s: '%s' */" % (l_event["doc"], l_event["format"]))
+        l_lines.append("        %s = %s%s" % (l_event["name"].ljust(l_width), l_event["value"], "," if i + 1 < len(l_events) else ""))
+    l_lines.append("    };")
+    l_lines.append("")
+    l_count = max([int(str(e["value"]), 0) for e in l_events] + [0]) + 1
+    l_sizes = [0] * l_count
+    for l_event in l_events:
+        l_sizes[int(str(l_event["value"]), 0)] = sum(types[a["type"]][1] for a in l_event["args"])
+    l_lines += ["    /** @brief Number of the identifiers of the log events */",
+                "    static const uint16_t s_logEventCount = %d;" % l_count,
+                "    /** @brief Size of the arguments of each event in byte, indexed by the identifier */",
+                "    static constexpr uint8_t s_logArgumentSizes[s_logEventCount] = {%s};" % ", ".join(str(v) for v in l_sizes),
+                "",
+                "}; // namespace utils::log", "", "#endif // LOG_EVENTS_HPP", ""]
+    return "\n".join(l_lines)
+
+
+def generateHost(f_definition):
+    l_lines = ['"""Identifiers, status codes and payload codecs of the board protocol.',
+               '',
+               "It's generated by protocolGenerator.py from protocol/protocol.json, don't edit it.",
+               '"""',
+               'import collections',
+               'import struct',
+               '',
+               '',
+               'class CPayload(object):',
+               '    """Common methods of the payloads, the fields follow the packed little-endian layout of the board."""',
+               '    __slots__ = ()',
+               '',
+               '    def pack(self):',
+               '        return self.s_struct.pack(*self)',
+               '',
+               '    @classmethod',
+               '    def unpack(cls, f_data, f_offset=0):',
+               '        return cls._make(cls.s_struct.unpack_from(f_data, f_offset))',
+               '',
+               '    def validate(self):',
+               '        """One-based index of the first field out of its range, zero, when all fields are valid."""',
+               '        for i, l_name in enumerate(self._fields):',
+               '            l_range = self.s_ranges.get(l_name)',
+               '            if l_range is not None and not l_range[0] <= getattr(self, l_name) <= l_range[1]:',
+               '                return i + 1',
+               '        return 0',
+               '']
+    for l_enum in f_definition["enums"]:
+        l_lines.append('')
+        l_lines.append('# %s' % l_enum["doc"])
+        for l_value in l_enum["values"]:
+            l_lines.append('%s = %s' % (l_value["name"], l_value["value"]))
+    l_lines.append('')
+    for l_struct in f_definition["structs"]:
+        l_names = ", ".join("'%s'" % f["name"] for f in l_struct["fields"])
+        l_ranges = ", ".join("'%s': (%r, %r)" % (f["name"], f["min"], f["max"]) for f in l_struct["fields"] if "min" in f)
+        l_lines += ['',
+                    'class %s(CPayload, collections.namedtuple(\'%s\', [%s])):' % (l_struct["name"], l_struct["name"], l_names),
+                    '    """%s"""' % l_struct["doc"],
+                    '    __slots__ = ()',
+                    "    s_struct = struct.Struct('<%s')" % "".join(types[f["type"]][0] for f in l_struct["fields"]),
+                    '    s_ranges = {%s}' % l_ranges,
+                    '']
+    l_lines += ['', '# Payload of each message identifier', 'PAYLOADS = {']
+    for l_value in f_definition["enums"][0]["values"]:
+        if "payload" in l_value:
+            l_lines.append('    %s: %s,' % (l_value["name"], l_value["payload"]))
+    l_lines += ['}', '', '# Names of the status codes', 'STATUS_NAMES = {']
+    for l_value in f_definition["enums"][1]["values"]:
+        l_lines.append("    %s: '%s'," % (l_value["name"], l_value["name"][4:].lower().replace('_', ' ')))
+    l_lines += ['}', '', '', '# Log events: identifier -> (name, format string, names of the arguments, layout of the arguments)', 'LOG_EVENTS = {']
+    for l_event in f_definition.get("events", []):
+        l_lines.append("    %s: ('%s', %r, %r, struct.Struct('<%s'))," % (l_event["value"], l_event["name"], l_event["format"]
+                       , tuple(a["name"] for a in l_event["args"]), "".join(types[a["type"]][0] for a in l_event["args"])))
+    l_lines += ['}', '']
+    return "\n".join(l_lines)
+
+
+def main():
+    l_parser = argparse.ArgumentParser(description="This script generates the board and host codecs of the protocol definition.")
+    l_parser.add_argument("--check", help="Verify that the generated files are up to date.", action='store_true', dest="check")
+    l_args = l_parser.parse_args()
+
+    with open(definition_file) as l_file:
+        l_definition = json.load(l_file)
+    for l_struct in l_definition["structs"]:
+        for l_field in l_struct["fields"]:
+            if l_field["type"] not in types:
+                sys.exit("Unknown type '%s' of %s::%s" % (l_field["type"], l_struct["name"], l_field["name"]))
+    for l_event in l_definition.get("events", []):
+        for l_argument in l_event["args"]:
+            if l_argument["type"] not in types:
+                sys.exit("Unknown type '%s' of the argument %s of %s" % (l_argument["type"], l_argument["name"], l_event["name"]))
+    l_outputs = {messages_header: generateMessages(l_definition),
+                 schemas_header: generateSchemas(l_definition),
+                 events_header: generateEvents(l_definition),
+                 host_module: generateHost(l_definition)}
+    l_stale = []
+    for l_path, l_content in sorted(l_outputs.items()):
+        l_current = open(l_path).read() if os.path.exists(l_path) else None
+        if l_current == l_content:
+            continue
+        l_stale.append(l_path)
+        if not l_args.check:
+            with open(l_path, 'w') as l_file:
+                l_file.write(l_content)
+            print("Generated:", l_path)
+    if l_args.check and l_stale:
+        sys.exit("Out of date: " + ", ".join(l_stale))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    ControlLoop.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the control loop driven by hardware timer.
+  ******************************************************************************
+ */
+
+#include <brain/controlloop.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/telemetry/tracestream.hpp>
+
+namespace brain{
+
+    /** \brief  CControlLoop class constructor
+     *
+     *  @param f_timer          reference to the hardware timer
+     *  @param f_period_sec     period of the loop in seconds, it has to be equal to the period of the encoder and of the state machine
+     *  @param f_pipeline       reference to the pipeline of the stages
+     *  @param f_mode           context of the ticks, the interrupt of the timer or the control thread
+     *  @param f_stackSize      stack size of the control thread in bytes, the stages are applied on it in the thread mode
+     *  @param f_stackMemory    static memory of the stack (f_stackSize bytes, 8 byte aligned), it's allocated from the heap without it
+     */
+    CControlLoop::CControlLoop(hardware::drivers::CControlTimer_TIM10&    f_timer
+                              ,float                                     f_period_sec
+                              ,utils::pipeline::IPipeline&               f_pipeline
+                              ,EMode                                     f_mode
+                              ,uint32_t                                  f_stackSize
+                              ,unsigned char*                            f_stackMemory)
+        : m_timer(f_timer)
+        , m_period_sec(f_period_sec)
+        , m_pipeline(f_pipeline)
+        , m_busyCycles(0)
+        , m_maxCycles(0)
+        , m_mode(f_mode)
+        , m_thread(osPriorityRealtime, f_stackSize, f_stackMemory)
+        , m_threadId(NULL)
+        , m_isBusy(false)
+        , m_overruns(0)
+        , m_deadlineCycles(0)
+        , m_deadlineMisses(0)
+        , m_lastCycles(0)
+    {
+        setDeadline(1.0f);
+    }
+
+    /** \brief  Start the control loop
+     *
+     *  @return                true, when the period can be realized by the timer
+     */
+    bool CControlLoop::start()
+    {
+        if (m_mode == THREAD)
+        {
+            if (m_threadId == NULL)
+            {
+                m_thread.start(mbed::callback(&CControlLoop::controlThread, this));
+            }
+            m_timer.attach(mbed::callback(this,&CControlLoop::wakeUp));
+        }
+        else
+        {
+            m_timer.attach(mbed::callback(this,&CControlLoop::step));
+        }
+        return m_timer.start(m_period_sec);
+    }
+
+    /** \brief  Stop the control loop
+     */
+    void CControlLoop::stop()
+    {
+        m_timer.stop();
+    }
+
+    /** \brief  Set the deadline of the tick as a part of the period
+     *
+     *  @param f_ratio          deadline per period, a tick longer than it is a missed deadline
+     */
+    void CControlLoop::setDeadline(float f_ratio)
+    {
+        m_deadlineCycles = static_cast<uint32_t>(f_ratio * m_period_sec * SystemCoreClock);
+    }
+
+    /** \brief  Cycles spent in the loop since the previous call, it's used by the load monitor
+     *
+     *  @return                number of the cpu cycles
+     */
+    uint32_t CControlLoop::takeBusyCycles()
+    {
+        core_util_critical_section_enter();
+        uint32_t l_cycles = m_busyCycles;
+        m_busyCycles = 0;
+        core_util_critical_section_exit();
+        return l_cycles;
+    }
+
+    /** \brief  One period of the control loop
+     *
+     *  It applies one tick of the pipeline and it measures its duration by the DWT cycle counter, the duration is compared to the deadline.
+     *  The tick is traced as the task s_controlTick of the trace stream.
+     */
+    CONTROL_RAMFUNC void CControlLoop::step()
+    {
+        utils::telemetry::CTraceStream::taskStart(utils::telemetry::CTraceStream::s_controlTick);
+        uint32_t l_start = DWT->CYCCNT;
+        m_pipeline.tick();
+        uint32_t l_cycles = DWT->CYCCNT - l_start;
+        utils::telemetry::CTraceStream::taskStop(utils::telemetry::CTraceStream::s_controlTick);
+        m_busyCycles += l_cycles;
+        m_lastCycles = l_cycles;
+        if (l_cycles > m_deadlineCycles)
+        {
+            m_deadlineMisses = m_deadlineMisses + 1;
+        }
+        if (l_cycles > m_maxCycles)
+        {
+            m_maxCycles = l_cycles;
+        }
+    }
+
+    /** \brief  Interrupt of the thread mode, it wakes up the control thread. When the thread is still busy with the previous tick, 
+     *  the period is skipped, so the ticks don't accumulate.
+     */
+    CONTROL_RAMFUNC void CControlLoop::wakeUp()
+    {
+        if (m_threadId == NULL)
+        {
+            return;
+        }
+        if (m_isBusy)
+        {
+            m_overruns = m_overruns + 1;
+            return;
+        }
+        m_isBusy = true;
+        osSignalSet(m_threadId, s_tickSignal);
+    }
+
+    /** \brief  Function of the control thread, it applies a tick after each signal of the interrupt.
+     *
+     *  @param f_loop           the control loop
+     */
+    void CControlLoop::controlThread(CControlLoop* f_loop)
+    {
+        f_loop->m_threadId = osThreadGetId();
+        while (true)
+        {
+            osSignalWait(s_tickSignal, osWaitForever);
+            f_loop->step();
+            f_loop->m_isBusy = false;
+        }
+    }
+
+}; // namespace brain
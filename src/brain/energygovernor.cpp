@@ -0,0 +1,234 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    EnergyGovernor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the energy-aware
+  *          limits of the speed and of the acceleration (eco driving).
+  ******************************************************************************
+ */
+#include <brain/energygovernor.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+
+namespace brain{
+
+    /** \brief  Initial parameters of the power model: electronics, rolling and drag losses, kinetic power */
+    static const float s_nominalModel[4] = {3.0f, 4.0f, 2.0f, 2.0f};
+
+    /** \brief  Initial parameters of the estimator
+     *
+     *  @return                    parameters of the nominal power model
+     */
+    static signal::systemmodels::CRecursiveLeastSquares<float,4>::CParametersType nominalParameters()
+    {
+        signal::systemmodels::CRecursiveLeastSquares<float,4>::CParametersType l_parameters;
+        for (uint8_t l_idx = 0; l_idx < 4; ++l_idx)
+        {
+            l_parameters[l_idx][0] = s_nominalModel[l_idx];
+        }
+        return l_parameters;
+    }
+
+    /** \brief  CEnergyGovernor class constructor, the limits are deactivated and the run hasn't budget.
+     *
+     *  @param f_period            period of the task in base ticks
+     *  @param f_period_sec        period of the task in second
+     *  @param f_battery           battery monitor, it gives the power and the state of charge
+     *  @param f_encoder           encoder of the motor
+     *  @param f_metersPerRotation meters per rotation of the encoder
+     *  @param f_cells             number of the cells of the pack
+     *  @param f_capacity          capacity of the pack in ampere hour
+     *  @param f_maxSpeed          maximum speed in meter per second
+     *  @param f_maxAcceleration   maximum acceleration in meter per square second
+     */
+    CEnergyGovernor::CEnergyGovernor(uint32_t                                f_period
+                                    ,float                                   f_period_sec
+                                    ,const hardware::sampling::CBatteryMonitor& f_battery
+                                    ,hardware::encoders::IEncoderGetter&     f_encoder
+                                    ,float                                   f_metersPerRotation
+                                    ,uint8_t                                 f_cells
+                                    ,float                                   f_capacity
+                                    ,float                                   f_maxSpeed
+                                    ,float                                   f_maxAcceleration)
+        : utils::task::CTask(f_period)
+        , m_period(f_period_sec)
+        , m_battery(f_battery)
+        , m_encoder(f_encoder)
+        , m_metersPerRotation(f_metersPerRotation)
+        , m_nominalEnergy(f_cells * s_cellVoltage * f_capacity)
+        , m_maxSpeed(f_maxSpeed)
+        , m_maxAcceleration(f_maxAcceleration)
+        , m_estimator(nominalParameters(), 100.0f, 0.999f, 400.0f)
+        , m_isActive(false)
+        , m_isValid(false)
+        , m_remaining(0.0f)
+        , m_reserve(0.1f)
+        , m_lastSpeed(0.0f)
+        , m_acceleration(0.0f)
+        , m_allowedPower(0.0f)
+        , m_speedCap(f_maxSpeed)
+        , m_accelerationCap(f_maxAcceleration)
+    {
+    }
+
+    /** \brief  Activate or deactivate the limits, the model is learned in both cases.
+     *
+     *  @param f_active            the limits are applied
+     */
+    void CEnergyGovernor::setActive(bool f_active)
+    {
+        m_isActive = f_active;
+    }
+
+    /** \brief  Set the budget of the run, the remaining time is counted down by the task.
+     *
+     *  @param f_remaining         remaining time of the run in second, zero without budget
+     *  @param f_reserve           reserve of the state of charge in interval [0,1]
+     */
+    void CEnergyGovernor::setBudget(float f_remaining, float f_reserve)
+    {
+        m_remaining = (f_remaining > 0.0f) ? f_remaining : 0.0f;
+        m_reserve = (f_reserve < 0.0f) ? 0.0f : ((f_reserve > 1.0f) ? 1.0f : f_reserve);
+    }
+
+    /** \brief  Run method, it updates the power model by the measured power and it calculates the limits from the allowed power.
+     */
+    void CEnergyGovernor::_run()
+    {
+        float l_speed = std::abs(m_encoder.getSpeedRps()) * m_metersPerRotation;
+        m_acceleration += s_accelerationFilter * ((l_speed - m_lastSpeed) / m_period - m_acceleration);
+        m_lastSpeed = l_speed;
+        float l_drive = l_speed * ((m_acceleration > 0.0f) ? m_acceleration : 0.0f);
+        CEstimator::CRegressorType l_regressor;
+        l_regressor[0][0] = 1.0f;
+        l_regressor[1][0] = l_speed;
+        l_regressor[2][0] = l_speed * l_speed;
+        l_regressor[3][0] = l_drive;
+        m_estimator.update(l_regressor, m_battery.getPower());
+        m_isValid = m_estimator.updates() >= s_minUpdates;
+
+        if (m_remaining > m_period)
+        {
+            m_remaining -= m_period;
+        }
+        else
+        {
+            m_remaining = 0.0f;
+        }
+        float l_charge = m_battery.getStateOfCharge() - m_reserve;
+        if (m_remaining <= 0.0f)
+        {
+            m_allowedPower = 0.0f;
+            m_speedCap = m_maxSpeed;
+            m_accelerationCap = m_maxAcceleration;
+            return;
+        }
+        m_allowedPower = ((l_charge > 0.0f) ? l_charge : 0.0f) * m_nominalEnergy * 3600.0f / m_remaining;
+
+        // Speed of the model at the allowed power at constant speed, the largest root of theta2*v^2 + theta1*v + theta0 = P
+        const CEstimator::CParametersType& l_theta = m_estimator.parameters();
+        float l_excess = m_allowedPower - l_theta[0][0];
+        float l_speedCap;
+        if (l_excess <= 0.0f)
+        {
+            l_speedCap = 0.0f;
+        }
+        else if (l_theta[2][0] > 1e-3f)
+        {
+            float l_discriminant = l_theta[1][0] * l_theta[1][0] + 4.0f * l_theta[2][0] * l_excess;
+            l_speedCap = (std::sqrt(l_discriminant) - l_theta[1][0]) / (2.0f * l_theta[2][0]);
+        }
+        else if (l_theta[1][0] > 1e-3f)
+        {
+            l_speedCap = l_excess / l_theta[1][0];
+        }
+        else
+        {
+            l_speedCap = m_maxSpeed;
+        }
+        m_speedCap = (l_speedCap < s_minSpeed) ? s_minSpeed : ((l_speedCap > m_maxSpeed) ? m_maxSpeed : l_speedCap);
+
+        // Acceleration by the peak of the power over the consumption at the current speed
+        float l_peak = s_peakFactor * m_allowedPower;
+        float l_accelerationCap = s_minAcceleration;
+        if (m_battery.getPower() < l_peak && l_theta[3][0] > 1e-3f)
+        {
+            float l_cruise = l_theta[0][0] + (l_theta[1][0] + l_theta[2][0] * l_speed) * l_speed;
+            float l_base = (l_speed > s_minSpeed) ? l_speed : s_minSpeed;
+            l_accelerationCap = (l_peak - l_cruise) / (l_theta[3][0] * l_base);
+        }
+        m_accelerationCap = (l_accelerationCap < s_minAcceleration) ? s_minAcceleration
+                          : ((l_accelerationCap > m_maxAcceleration) ? m_maxAcceleration : l_accelerationCap);
+    }
+
+    /** \brief  Serial callback method
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CEnergyGovernor::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text,l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(isActive() ? 1 : 0).fixed(m_speedCap,2).fixed(m_accelerationCap,2).fixed(m_allowedPower,2)
+                                  .fixed(m_remaining,0).udec(m_estimator.updates()).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_active;
+            if (!utils::fmt::parseUint(l_text,l_active))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else
+            {
+                setActive(0 != l_active);
+                sprintf(b,"ack;;");
+            }
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            float l_values[2];
+            if (2 != utils::fmt::parseFloats(l_text, l_values, 2))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (l_values[0] < 0.0f || l_values[1] < 0.0f || l_values[1] >= 1.0f)
+            {
+                sprintf(b,"invalid parameters;;");
+            }
+            else
+            {
+                setBudget(l_values[0], l_values[1]);
+                sprintf(b,"ack;;");
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace brain
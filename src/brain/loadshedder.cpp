@@ -0,0 +1,180 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    LoadShedder.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the load shedding of the control pipeline.
+  ******************************************************************************
+ */
+
+#include <brain/loadshedder.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace brain{
+
+    /** \brief  CLoadShedder class constructor
+     *
+     *  @param f_period          period of the reporting task in base ticks
+     *  @param f_loop            control loop, its deadline misses and overruns are counted
+     *  @param f_stages          optional stages, the first one is disabled first
+     *  @param f_stageCount      number of the optional stages
+     *  @param f_serial          transmitter of the reports
+     *  @param f_windowTicks     number of the ticks in a window
+     *  @param f_shedMisses      number of the misses in a window, which disables a stage
+     *  @param f_restoreRatio    the longest tick of a calm window is below this ratio of the deadline
+     *  @param f_restoreWindows  number of the consecutive calm windows, which enable a stage
+     */
+    CLoadShedder::CLoadShedder(uint32_t                              f_period
+                              ,CControlLoop&                         f_loop
+                              ,const SStage*                         f_stages
+                              ,uint8_t                               f_stageCount
+                              ,utils::serial::CSerialTransmitter&    f_serial
+                              ,uint32_t                              f_windowTicks
+                              ,uint32_t                              f_shedMisses
+                              ,float                                 f_restoreRatio
+                              ,uint32_t                              f_restoreWindows)
+        : utils::task::CTask(f_period)
+        , m_loop(f_loop)
+        , m_stages(f_stages)
+        , m_stageCount(f_stageCount)
+        , m_serial(f_serial)
+        , m_windowTicks(f_windowTicks)
+        , m_shedMisses(f_shedMisses)
+        , m_restoreRatio(f_restoreRatio)
+        , m_restoreWindows(f_restoreWindows)
+        , m_enabled(true)
+        , m_level(0)
+        , m_lastMisses(0)
+        , m_ticks(0)
+        , m_misses(0)
+        , m_maxCycles(0)
+        , m_calmWindows(0)
+        , m_transitions(0)
+        , m_reported(0)
+        , m_lastStage(0)
+    {
+    }
+
+    /** \brief  Count the misses of the previous tick and evaluate the window at its end. The stages are switched only by the tick,
+     *  so a stage isn't switched during its application. The disabled shedding enables all stages.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CLoadShedder::process(uint32_t)
+    {
+        uint32_t l_misses = m_loop.getDeadlineMisses() + m_loop.getOverruns();
+        m_misses += l_misses - m_lastMisses;
+        m_lastMisses = l_misses;
+        uint32_t l_cycles = m_loop.getLastCycles();
+        if (l_cycles > m_maxCycles)
+        {
+            m_maxCycles = l_cycles;
+        }
+        if (!m_enabled)
+        {
+            if (m_level > 0)
+            {
+                for (uint8_t i = 0; i < m_level; ++i)
+                {
+                    m_stages[i].m_gate->setEnabled(true);
+                }
+                m_level = 0;
+                m_lastStage = 0;
+                m_transitions = m_transitions + 1;
+            }
+            m_ticks = 0;
+            m_misses = 0;
+            m_maxCycles = 0;
+            m_calmWindows = 0;
+            return;
+        }
+        if (++m_ticks < m_windowTicks)
+        {
+            return;
+        }
+        bool l_isCalm = (0 == m_misses) && (m_maxCycles < m_restoreRatio * m_loop.getDeadlineCycles());
+        if (m_misses >= m_shedMisses && m_level < m_stageCount)
+        {
+            // Overload, the next optional stage is disabled
+            m_stages[m_level].m_gate->setEnabled(false);
+            m_lastStage = m_level;
+            m_level = m_level + 1;
+            m_transitions = m_transitions + 1;
+            m_calmWindows = 0;
+        }
+        else if (!l_isCalm)
+        {
+            m_calmWindows = 0;
+        }
+        else if (m_level > 0 && ++m_calmWindows >= m_restoreWindows)
+        {
+            // The load dropped, the last disabled stage is enabled again
+            m_level = m_level - 1;
+            m_lastStage = m_level;
+            m_stages[m_level].m_gate->setEnabled(true);
+            m_transitions = m_transitions + 1;
+            m_calmWindows = 0;
+        }
+        m_ticks = 0;
+        m_misses = 0;
+        m_maxCycles = 0;
+    }
+
+    /** \brief  Enable or disable the shedding, the disabled shedding enables the stages in the next tick.
+     *
+     *  @param f_enabled       true - the stages are shed on overload
+     */
+    void CLoadShedder::setEnabled(bool f_enabled)
+    {
+        m_enabled = f_enabled;
+    }
+
+    /** \brief  Run method, it reports the last transition with the number of the disabled stages and the switched stage
+     *  ('@SHED:level;stage;;'), the stage is 'none', when the disabled shedding enabled all stages.
+     */
+    void CLoadShedder::_run()
+    {
+        uint32_t l_transitions = m_transitions;
+        if (l_transitions == m_reported)
+        {
+            return;
+        }
+        m_reported = l_transitions;
+        uint8_t l_level = m_level;
+        const char* l_name = (m_enabled && m_lastStage < m_stageCount) ? m_stages[m_lastStage].m_name : "none";
+        m_serial.printf("@SHED:%u;%s;;\r\n", l_level, l_name);
+    }
+
+    /** \brief  Serial callback of the shedding. The optional parameter enables (1) or disables (0) the shedding, the response contains
+     *  the state, the number of the disabled stages, the missed deadlines, the skipped periods and the number of the transitions.
+     *
+     *  @param a               string to read data from
+     *  @param b               string to write data to
+     */
+    void CLoadShedder::serialCallback(char const * a, char * b)
+    {
+        float l_value;
+        if (1 == utils::fmt::parseFloats(a, &l_value, 1))
+        {
+            setEnabled(0.0f != l_value);
+        }
+        utils::fmt::CWriter(b).dec(m_enabled ? 1 : 0).udec(m_level).udec(m_loop.getDeadlineMisses()).udec(m_loop.getOverruns()).udec(m_transitions).chr(';');
+    }
+
+}; // namespace brain
@@ -0,0 +1,305 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Odometry.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the on-board odometry.
+  ******************************************************************************
+ */
+
+#include <brain/odometry.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace brain{
+
+    /** \brief  COdometry class constructor
+     *
+     *  The pose starts from the origin, the publisher is initially deactivated.
+     *
+     *  @param f_period            period of the publishing
+     *  @param f_dt                period of the integration (control loop) in second
+     *  @param f_position          getter of the accumulated encoder position
+     *  @param f_angle             getter of the applied steering angle in degree
+     *  @param f_meterPerImpulse   travelled distance of an encoder impulse in meter
+     *  @param f_geometry          steering geometry of the vehicle
+     *  @param f_serial            reference to the serial transmitter
+     */
+    COdometry::COdometry(uint32_t                              f_period
+                        ,float                                 f_dt
+                        ,FPositionGetter                       f_position
+                        ,FAngleGetter                          f_angle
+                        ,float                                 f_meterPerImpulse
+                        ,const signal::systemmodels::CSteeringGeometry& f_geometry
+                        ,utils::serial::CSerialTransmitter&    f_serial)
+        : utils::task::CTask(f_period)
+        , m_position(f_position)
+        , m_angle(f_angle)
+        , m_meterPerImpulse(f_meterPerImpulse)
+        , m_dt(f_dt)
+        , m_geometry(f_geometry)
+        , m_model(f_dt, f_geometry.getWheelbase())
+        , m_lastPosition(0)
+        , m_initialized(false)
+        , m_imu()
+        , m_imuTimestamp(0)
+        , m_gyroBias(0.0f)
+        , m_accelBias(0.0f)
+        , m_acceleration(0.0f)
+        , m_yawRate(0.0f)
+        , m_attitude(NULL)
+        , m_heading(0.0f)
+        , m_hasHeading(false)
+        , m_pose()
+        , m_resetRequest()
+        , m_resetSequence(0)
+        , m_isActive(false)
+        , m_isBinary(false)
+        , m_serial(f_serial)
+    {
+    }
+
+    /** \brief  Pipeline stage, it integrates the pose by the travelled distance and the steering angle of the tick.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    void COdometry::process(uint32_t f_timestamp)
+    {
+        uint32_t l_resetSequence;
+        SPose l_reset = m_resetRequest.read(l_resetSequence);
+        if (l_resetSequence != m_resetSequence)
+        {
+            CModelType::CStatesType l_resetStates;
+            l_resetStates[0][0] = l_reset.m_x;
+            l_resetStates[1][0] = l_reset.m_y;
+            l_resetStates[2][0] = l_reset.m_yaw;
+            m_model.setStates(l_resetStates);
+            m_resetSequence = l_resetSequence;
+        }
+        int64_t l_position = m_position();
+        if (!m_initialized)
+        {
+            m_lastPosition = l_position;
+            m_initialized = true;
+        }
+        bool l_standing = (l_position == m_lastPosition);
+        float l_speed = static_cast<float>(l_position - m_lastPosition) * m_meterPerImpulse / m_dt;
+        m_lastPosition = l_position;
+        float l_yaw = m_model.getStates()[2][0];
+
+        CModelType::CStatesType l_states = m_model.integrate(l_speed, m_geometry.curvature(m_angle()));
+        if (m_imu)
+        {
+            hardware::imu::SImuSample l_block[s_blockSize];
+            float l_accelSum = 0.0f;
+            float l_rateSum = 0.0f;
+            uint32_t l_samples = 0;
+            float l_startYaw = l_yaw;
+            size_t l_count = s_blockSize;
+            while (l_count == s_blockSize)
+            {
+                l_count = 0;
+                while (l_count < s_blockSize && m_imu(l_block[l_count]))
+                {
+                    hardware::imu::SImuSample& l_sample = l_block[l_count++];
+                    float l_rate = l_sample.m_gyro[2];
+                    if (l_standing)
+                    {
+                        m_gyroBias += s_biasFactor * (l_rate - m_gyroBias);
+                        m_accelBias += s_biasFactor * (l_sample.m_accel[0] - m_accelBias);
+                    }
+                    l_accelSum += l_sample.m_accel[0];
+                    l_rateSum += l_rate - m_gyroBias;
+                    ++l_samples;
+                    if (m_imuTimestamp != 0)
+                    {
+                        l_yaw += (l_rate - m_gyroBias) * static_cast<float>(l_sample.m_timestamp - m_imuTimestamp) * 1e-6f;
+                    }
+                    m_imuTimestamp = l_sample.m_timestamp;
+                    l_sample.m_gyro[2] = l_rate - m_gyroBias;
+                }
+                if (m_attitude != NULL && l_count > 0)
+                {
+                    m_attitude->process(l_block, l_count);
+                }
+            }
+            if (l_samples > 0)
+            {
+                m_acceleration = l_accelSum / static_cast<float>(l_samples) - m_accelBias;
+                m_yawRate = l_rateSum / static_cast<float>(l_samples);
+                if (m_attitude != NULL)
+                {
+                    // The heading of the attitude filter replaces the integral of the z axis, its change is added to the pose
+                    float l_heading = m_attitude->getYaw();
+                    float l_change = m_hasHeading ? l_heading - m_heading : 0.0f;
+                    l_change += (l_change > static_cast<float>(M_PI)) ? -2.0f * static_cast<float>(M_PI) : ((l_change < -static_cast<float>(M_PI)) ? 2.0f * static_cast<float>(M_PI) : 0.0f);
+                    l_yaw = l_startYaw + l_change;
+                    m_heading = l_heading;
+                    m_hasHeading = true;
+                }
+            }
+            l_states[2][0] = l_yaw;
+            m_model.setStates(l_states);
+        }
+        if (l_states[2][0] > static_cast<float>(M_PI))
+        {
+            l_states[2][0] -= 2.0f * static_cast<float>(M_PI);
+            m_model.setStates(l_states);
+        }
+        else if (l_states[2][0] < -static_cast<float>(M_PI))
+        {
+            l_states[2][0] += 2.0f * static_cast<float>(M_PI);
+            m_model.setStates(l_states);
+        }
+
+        utils::serial::SOdometryPayload l_pose;
+        l_pose.m_timestamp = f_timestamp;
+        l_pose.m_x = l_states[0][0];
+        l_pose.m_y = l_states[1][0];
+        l_pose.m_yaw = l_states[2][0];
+        l_pose.m_speed = l_speed;
+        m_pose.write(l_pose);
+    }
+
+    /** \brief  Attach the reader of the inertial samples, after it the yaw is integrated by the angular rate (z axis) of the samples.
+     *
+     *  @param f_imu           reader of the inertial samples, it's applied from the control loop interrupt
+     */
+    void COdometry::setImu(FImuReader f_imu)
+    {
+        core_util_critical_section_enter();
+        m_imu = f_imu;
+        m_imuTimestamp = 0;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Attach the attitude filter, the inertial batches are processed by it and its heading gives the yaw of the pose. The 
+     *  gyroscope samples are corrected by the bias of the yaw rate before the filter. It has to be attached before the inertial sensor.
+     *
+     *  @param f_attitude      attitude filter, NULL integrates the yaw rate of the z axis
+     */
+    void COdometry::setAttitude(signal::filter::IAttitudeFilter* f_attitude)
+    {
+        core_util_critical_section_enter();
+        m_attitude = f_attitude;
+        m_hasHeading = false;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Reset the pose, the integration continues from the given pose. The request is applied by the next tick of the 
+     *  control loop, it's written only from one serial thread.
+     *
+     *  @param f_x             position in meter
+     *  @param f_y             position in meter
+     *  @param f_yaw           orientation in radian
+     */
+    void COdometry::reset(float f_x, float f_y, float f_yaw)
+    {
+        SPose l_pose;
+        l_pose.m_x = f_x;
+        l_pose.m_y = f_y;
+        l_pose.m_yaw = f_yaw;
+        m_resetRequest.write(l_pose);
+    }
+
+    /** \brief  Get the last integrated pose, the copy is consistent without blocking the control loop.
+     *
+     *  @return                pose and speed with the timestamp of the integration
+     */
+    utils::serial::SOdometryPayload COdometry::getPose()
+    {
+        return m_pose.read();
+    }
+
+    /** \brief  Serial callback method to activate or deactivate the publisher. 
+     *  When the received integer value is bigger or equal to 1, then the publisher become active and send text messages.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void COdometry::serialCallback(char const * a, char * b)
+    {
+        int l_isActivate = 0;
+        uint32_t l_res = sscanf(a,"%d",&l_isActivate);
+        if (1 == l_res)
+        {
+            m_isActive = (l_isActivate >= 1);
+            m_isBinary = false;
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Serial callback method to reset the pose. The string has to contain the position (m) and the orientation (rad).
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void COdometry::serialCallbackReset(char const * a, char * b)
+    {
+        float l_pose[3];
+        uint32_t l_res = utils::fmt::parseFloats(a,l_pose,3);
+        if (3 == l_res)
+        {
+            reset(l_pose[0], l_pose[1], l_pose[2]);
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Binary callback method to activate or deactivate the publisher. 
+     *  After the activation the pose is published in binary frames (utils::serial::BIN_ODOMETRY).
+     *
+     *  @param f_payload           received payload
+     *  @return                    status code of the response
+     */
+    uint8_t COdometry::binaryCallback(const utils::serial::SActivationPayload& f_payload)
+    {
+        m_isActive = (f_payload.m_activate != 0);
+        m_isBinary = true;
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Run method, it publishes the last pose.
+     */
+    void COdometry::_run()
+    {
+        if (!m_isActive) return;
+        utils::serial::SOdometryPayload l_pose = getPose();
+        if (m_isBinary)
+        {
+            uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+            uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_ODOMETRY, &l_pose, sizeof(l_pose), l_frame);
+            m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+        }
+        else
+        {
+            char l_text[utils::serial::CSerialTransmitter::s_maxMessageLength];
+            utils::fmt::CWriter l_writer(l_text);
+            l_writer.text("@ODOM:").fixed(l_pose.m_x,3).fixed(l_pose.m_y,3).fixed(l_pose.m_yaw,4).fixed(l_pose.m_speed,3).text(";\r\n");
+            m_serial.write(l_writer.data(), l_writer.length(), utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+        }
+    }
+
+}; // namespace brain
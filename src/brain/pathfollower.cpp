@@ -0,0 +1,466 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    PathFollower.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the on-board path follower.
+  ******************************************************************************
+ */
+
+#include <brain/pathfollower.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+#include <math.h>
+
+namespace brain{
+
+    /** \brief  CPathFollower class constructor
+     *
+     *  The path is initially empty and the following is deactivated, the lookahead distance is 0.3 m and it grows with 0.5 s of the speed.
+     *  The speed planning is disabled, its lateral acceleration is 1 m/s^2.
+     *
+     *  @param f_pose              getter of the last pose of the odometry
+     *  @param f_geometry          steering geometry of the vehicle
+     *  @param f_maxAngle          limit of the steering angle in degree
+     */
+    CPathFollower::CPathFollower(FPoseGetter f_pose, const signal::systemmodels::CSteeringGeometry& f_geometry, float f_maxAngle)
+        : m_pose(f_pose)
+        , m_geometry(f_geometry)
+        , m_maxAngle(f_maxAngle)
+        , m_minLookahead(0.3f)
+        , m_lookaheadGain(0.5f)
+        , m_tolerance(0.05f)
+        , m_path()
+        , m_origin()
+        , m_hasOrigin(false)
+        , m_pushed(0)
+        , m_popped(0)
+        , m_clearUntil(0)
+        , m_isActive(false)
+        , m_maxSpeed(0.0f)
+        , m_lateralAcceleration(1.0f)
+        , m_speedProfile(NULL)
+        , m_angleProfile(NULL)
+        , m_limit2()
+        , m_length()
+        , m_speed2()
+        , m_planned()
+        , m_aheadFrom(0)
+        , m_plannedUntil(0)
+        , m_planPushed(0)
+        , m_planPopped(0)
+    {
+    }
+
+    /** \brief  Control step of the move state, it computes the steering angle of the pure pursuit.
+     *
+     *  The waypoints are dropped, when they are inside the lookahead circle or the robot passed them along their segment. 
+     *  The goal point is the far intersection of the lookahead circle and the current segment, the last waypoint is followed directly, 
+     *  when it's inside the circle or the robot is away from the segment. With the speed planning the change of the pending waypoints 
+     *  updates the plan, then the speed is given by the braking distance to the next waypoint.
+     *
+     *  @param f_angle             steering angle in degree (positive to right), it's written only by following
+     *  @param f_speed             planned speed in meter per second, it's written only by following with the speed planning
+     *  @return                    status of the step (EStatus)
+     */
+    CONTROL_RAMFUNC uint8_t CPathFollower::control(float& f_angle, float& f_speed)
+    {
+        SWaypoint l_point;
+        // Drop the waypoints pushed before the clearing request
+        while (static_cast<int32_t>(m_clearUntil - m_popped) > 0 && m_path.pop(l_point))
+        {
+            m_popped = m_popped + 1;
+        }
+        if (!m_isActive)
+        {
+            m_hasOrigin = false;
+            return STATUS_IDLE;
+        }
+        utils::serial::SOdometryPayload l_pose = m_pose();
+        if (!m_hasOrigin)
+        {
+            m_origin.m_x = l_pose.m_x;
+            m_origin.m_y = l_pose.m_y;
+            m_hasOrigin = true;
+            // The first limit depends on the new start point, the whole plan is recomputed
+            m_plannedUntil = m_popped;
+            m_planPopped = m_popped - 1;
+            m_aheadFrom = m_popped;
+        }
+        float l_lookahead = m_minLookahead + m_lookaheadGain * fabsf(l_pose.m_speed);
+        utils::CRingBuffer<SWaypoint,32>::SSpan l_spans[2];
+        uint32_t l_count = m_path.getReadable(l_spans);
+        while (l_count > 0)
+        {
+            const SWaypoint& l_target = l_spans[0].m_data[0];
+            float l_segX = l_target.m_x - m_origin.m_x;
+            float l_segY = l_target.m_y - m_origin.m_y;
+            float l_dx = l_target.m_x - l_pose.m_x;
+            float l_dy = l_target.m_y - l_pose.m_y;
+            float l_distance = l_dx * l_dx + l_dy * l_dy;
+            // The target is passed, when the robot is beyond the normal of the segment at the target
+            bool l_passed = (l_segX * l_dx + l_segY * l_dy) <= 0.0f;
+            bool l_last = (1 == l_count);
+            if (l_last ? (l_passed || l_distance < m_tolerance * m_tolerance) : (l_passed || l_distance < l_lookahead * l_lookahead))
+            {
+                m_origin = l_target;
+                m_path.consume(1);
+                m_popped = m_popped + 1;
+                if (l_last)
+                {
+                    m_isActive = false;
+                    m_hasOrigin = false;
+                    return STATUS_REACHED;
+                }
+                l_count = m_path.getReadable(l_spans);
+                continue;
+            }
+            break;
+        }
+        if (0 == l_count)
+        {
+            m_isActive = false;
+            m_hasOrigin = false;
+            return STATUS_REACHED;
+        }
+        if (isPlanning() && (m_popped + l_count != m_planPushed || m_popped != m_planPopped))
+        {
+            plan(l_spans, l_count);
+        }
+        // Intersection of the lookahead circle and the segment, the goal is the last waypoint without intersection
+        const SWaypoint& l_target = l_spans[0].m_data[0];
+        SWaypoint l_goal = l_target;
+        float l_segX = l_target.m_x - m_origin.m_x;
+        float l_segY = l_target.m_y - m_origin.m_y;
+        float l_offX = m_origin.m_x - l_pose.m_x;
+        float l_offY = m_origin.m_y - l_pose.m_y;
+        float l_a = l_segX * l_segX + l_segY * l_segY;
+        float l_b = 2.0f * (l_offX * l_segX + l_offY * l_segY);
+        float l_c = l_offX * l_offX + l_offY * l_offY - l_lookahead * l_lookahead;
+        float l_discriminant = l_b * l_b - 4.0f * l_a * l_c;
+        if (l_a > 0.0f && l_discriminant >= 0.0f)
+        {
+            float l_t = (-l_b + sqrtf(l_discriminant)) / (2.0f * l_a);
+            if (l_t < 1.0f)
+            {
+                l_t = (l_t > 0.0f) ? l_t : 0.0f;
+                l_goal.m_x = m_origin.m_x + l_t * l_segX;
+                l_goal.m_y = m_origin.m_y + l_t * l_segY;
+            }
+        }
+        // Curvature of the arc from the rear axle to the goal point, the lateral offset is positive to left
+        float l_dx = l_goal.m_x - l_pose.m_x;
+        float l_dy = l_goal.m_y - l_pose.m_y;
+        float l_distance = l_dx * l_dx + l_dy * l_dy;
+        if (l_distance > 0.0f)
+        {
+            float l_lateral = cosf(l_pose.m_yaw) * l_dy - sinf(l_pose.m_yaw) * l_dx;
+            float l_curvature = 2.0f * l_lateral / l_distance;
+            float l_angle = m_geometry.angle(l_curvature);
+            f_angle = (l_angle > m_maxAngle) ? m_maxAngle : ((l_angle < -m_maxAngle) ? -m_maxAngle : l_angle);
+        }
+        if (isPlanning())
+        {
+            f_speed = planSpeed(l_pose);
+        }
+        return STATUS_FOLLOWING;
+    }
+
+    /** \brief  Update the speed limits of the new waypoints and apply the backward pass over the pending waypoints.
+     *
+     *  The limit of a waypoint is computed once, when its successor is pushed: the curvature is the inverse radius of the circle through
+     *  the waypoint and its neighbours (the start point before the first one), it limits the lateral acceleration and the steering angle
+     *  of the curve has to be reached at the rate limit of the steering profile over the shorter neighbour segment. The backward pass 
+     *  starts at rest on the last waypoint and it keeps each speed reachable by the deceleration over the segment after it.
+     *
+     *  @param f_spans             readable spans of the path
+     *  @param f_count             number of the pending waypoints
+     */
+    CONTROL_RAMFUNC void CPathFollower::plan(utils::CRingBuffer<SWaypoint,32>::SSpan (&f_spans)[2], uint32_t f_count)
+    {
+        const uint32_t l_capacity = utils::CRingBuffer<SWaypoint,32>::s_capacity;
+        const float l_maxSpeed2 = m_maxSpeed * m_maxSpeed;
+        const float l_steeringRate = (m_angleProfile != NULL) ? m_angleProfile->getMaxRate() * static_cast<float>(M_PI) / 180.0f : 0.0f;
+        uint32_t l_first = (static_cast<int32_t>(m_plannedUntil - m_popped) > 0) ? m_plannedUntil : m_popped;
+        for (uint32_t l_count = l_first; l_count + 1 < m_popped + f_count; l_count++)
+        {
+            uint32_t l_idx = l_count - m_popped;
+            const SWaypoint& l_previous = (0 == l_idx) ? m_origin : at(f_spans, l_idx - 1);
+            const SWaypoint& l_current = at(f_spans, l_idx);
+            const SWaypoint& l_next = at(f_spans, l_idx + 1);
+            float l_inX = l_current.m_x - l_previous.m_x;
+            float l_inY = l_current.m_y - l_previous.m_y;
+            float l_outX = l_next.m_x - l_current.m_x;
+            float l_outY = l_next.m_y - l_current.m_y;
+            float l_chordX = l_next.m_x - l_previous.m_x;
+            float l_chordY = l_next.m_y - l_previous.m_y;
+            float l_in = sqrtf(l_inX * l_inX + l_inY * l_inY);
+            float l_out = sqrtf(l_outX * l_outX + l_outY * l_outY);
+            float l_denominator = l_in * l_out * sqrtf(l_chordX * l_chordX + l_chordY * l_chordY);
+            float l_curvature = (l_denominator > 0.0f) ? 2.0f * fabsf(l_inX * l_outY - l_inY * l_outX) / l_denominator : 0.0f;
+            float l_limit2 = l_maxSpeed2;
+            if (l_curvature > 0.0f)
+            {
+                float l_lateral2 = m_lateralAcceleration / l_curvature;
+                l_limit2 = (l_lateral2 < l_limit2) ? l_lateral2 : l_limit2;
+                if (l_steeringRate > 0.0f)
+                {
+                    float l_steering = l_steeringRate * ((l_in < l_out) ? l_in : l_out) / (fabsf(m_geometry.angle(l_curvature)) * static_cast<float>(M_PI) / 180.0f);
+                    l_limit2 = (l_steering * l_steering < l_limit2) ? l_steering * l_steering : l_limit2;
+                }
+            }
+            m_limit2[l_count % l_capacity] = l_limit2;
+            m_length[l_count % l_capacity] = l_out;
+            m_plannedUntil = l_count + 1;
+        }
+        const float l_deceleration = getDeceleration();
+        float l_speed2 = 0.0f;
+        for (uint32_t l_idx = f_count; l_idx-- > 0;)
+        {
+            uint32_t l_slot = (m_popped + l_idx) % l_capacity;
+            if (l_idx + 1 < f_count)
+            {
+                float l_reachable = l_speed2 + 2.0f * l_deceleration * m_length[l_slot];
+                l_speed2 = (m_limit2[l_slot] < l_reachable) ? m_limit2[l_slot] : l_reachable;
+            }
+            m_speed2[l_slot] = l_speed2;
+            m_planned[l_slot] = at(f_spans, l_idx);
+        }
+        // The slots of the dropped waypoints are kept, until the new waypoints reuse them
+        if (static_cast<int32_t>(m_popped + f_count - l_capacity - m_aheadFrom) > 0)
+        {
+            m_aheadFrom = m_popped + f_count - l_capacity;
+        }
+        m_planPushed = m_popped + f_count;
+        m_planPopped = m_popped;
+    }
+
+    /** \brief  Speed of the step, which reaches the planned speed of each waypoint ahead by the deceleration. 
+     *
+     *  The waypoints between the robot and the next one of the following were dropped by the lookahead, they are ahead, until the robot
+     *  passes their normal. The deceleration of the jerk limited profile needs time to build up, the distance travelled meanwhile isn't 
+     *  applied for braking.
+     *
+     *  @param f_pose              last pose of the odometry
+     *  @return                    speed in meter per second
+     */
+    CONTROL_RAMFUNC float CPathFollower::planSpeed(const utils::serial::SOdometryPayload& f_pose)
+    {
+        const uint32_t l_capacity = utils::CRingBuffer<SWaypoint,32>::s_capacity;
+        const float l_deceleration = getDeceleration();
+        const float l_headingX = cosf(f_pose.m_yaw);
+        const float l_headingY = sinf(f_pose.m_yaw);
+        float l_jerk = (m_speedProfile != NULL) ? m_speedProfile->getMaxJerk() : 0.0f;
+        float l_buildUp = (l_jerk > 0.0f) ? fabsf(m_speedProfile->getValue()) * l_deceleration / l_jerk : 0.0f;
+        float l_speed2 = m_maxSpeed * m_maxSpeed;
+        for (uint32_t l_count = m_aheadFrom; static_cast<int32_t>(m_popped - l_count) >= 0; l_count++)
+        {
+            const SWaypoint& l_point = m_planned[l_count % l_capacity];
+            float l_dx = l_point.m_x - f_pose.m_x;
+            float l_dy = l_point.m_y - f_pose.m_y;
+            if (l_count != m_popped && l_count == m_aheadFrom && (l_dx * l_headingX + l_dy * l_headingY) <= 0.0f)
+            {
+                m_aheadFrom = l_count + 1;
+                continue;
+            }
+            float l_distance = sqrtf(l_dx * l_dx + l_dy * l_dy) - l_buildUp;
+            float l_reachable = m_speed2[l_count % l_capacity] + 2.0f * l_deceleration * ((l_distance > 0.0f) ? l_distance : 0.0f);
+            l_speed2 = (l_reachable < l_speed2) ? l_reachable : l_speed2;
+        }
+        float l_speed = sqrtf(l_speed2);
+        float l_minSpeed = (s_minSpeed < m_maxSpeed) ? s_minSpeed : m_maxSpeed;
+        return (l_speed > l_minSpeed) ? l_speed : l_minSpeed;
+    }
+
+    /** \brief  Deceleration of the planning, it's the rate limit of the speed profile or the lateral acceleration without limit.
+     *
+     *  @return                    deceleration in meter per square second
+     */
+    float CPathFollower::getDeceleration() const
+    {
+        float l_rate = (m_speedProfile != NULL) ? m_speedProfile->getMaxRate() : 0.0f;
+        return (l_rate > 0.0f) ? l_rate : m_lateralAcceleration;
+    }
+
+    /** \brief  Stop the following and clear the path, the waypoints are dropped by the next control step.
+     */
+    void CPathFollower::stop()
+    {
+        m_isActive = false;
+        m_clearUntil = m_pushed;
+    }
+
+    /** \brief  Number of the waypoints, which were pushed after the last clearing request and they aren't consumed yet.
+     *
+     *  @return                    number of the waypoints
+     */
+    uint32_t CPathFollower::getPending() const
+    {
+        uint32_t l_popped = m_popped;
+        uint32_t l_start = (static_cast<int32_t>(m_clearUntil - l_popped) > 0) ? m_clearUntil : l_popped;
+        return m_pushed - l_start;
+    }
+
+    /** \brief  Set the parameters of the lookahead, they are applied by the next control step.
+     *
+     *  @param f_minLookahead      minimum lookahead distance in meter
+     *  @param f_lookaheadGain     growth of the lookahead distance with the speed in second
+     *  @param f_tolerance         distance of the last waypoint, where the following is finished, in meter
+     *  @return                    false, when the parameters aren't positive or the tolerance isn't shorter than the lookahead
+     */
+    bool CPathFollower::setParameters(float f_minLookahead, float f_lookaheadGain, float f_tolerance)
+    {
+        if (!(f_minLookahead > 0.0f && f_lookaheadGain >= 0.0f && f_tolerance > 0.0f && f_tolerance < f_minLookahead))
+        {
+            return false;
+        }
+        m_minLookahead = f_minLookahead;
+        m_lookaheadGain = f_lookaheadGain;
+        m_tolerance = f_tolerance;
+        return true;
+    }
+
+    /** \brief  Set the limits of the speed planning, they are applied by the next start of the following.
+     *
+     *  @param f_maxSpeed          maximum speed in meter per second, zero disables the planning
+     *  @param f_lateralAcceleration maximum lateral acceleration in the curves in meter per square second
+     *  @return                    false, when the speed is negative or the acceleration isn't positive
+     */
+    bool CPathFollower::setSpeedLimits(float f_maxSpeed, float f_lateralAcceleration)
+    {
+        if (!(f_maxSpeed >= 0.0f && f_lateralAcceleration > 0.0f))
+        {
+            return false;
+        }
+        m_maxSpeed = f_maxSpeed;
+        m_lateralAcceleration = f_lateralAcceleration;
+        return true;
+    }
+
+    /** \brief  Serial callback method of the path commands
+     *
+     *  The first field is the index of the command:
+     *      - '0': status, it responses the active state and the number of the pending waypoints,
+     *      - '1;x;y[;x;y]...': append at most four waypoints in meter, the response is 'busy', when the buffer hasn't enough place,
+     *      - '2;0|1': start or stop the following, the stop clears the path, the start needs at least one waypoint,
+     *      - '3;lookahead;gain;tolerance': set the lookahead parameters, while the following isn't active,
+     *      - '4;speed;acceleration': set the maximum speed and the lateral acceleration of the speed planning, while the following isn't 
+     *        active, the zero speed disables the planning.
+     *  The steering angle of the move commands is ignored during the following, the speed is ignored with the speed planning, the brake 
+     *  commands stop it.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CPathFollower::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(m_isActive ? 1 : 0).udec(getPending()).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            float l_values[2 * s_maxUpload];
+            uint8_t l_res = utils::fmt::parseFloats(l_text, l_values, 2 * s_maxUpload);
+            if (0 == l_res || 0 != (l_res % 2))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (m_path.getFree() < l_res / 2)
+            {
+                sprintf(b,"busy;;");
+            }
+            else
+            {
+                for (uint8_t l_idx = 0; l_idx < l_res; l_idx += 2)
+                {
+                    SWaypoint l_point = {l_values[l_idx], l_values[l_idx + 1]};
+                    m_path.push(l_point);
+                }
+                m_pushed = m_pushed + l_res / 2;
+                sprintf(b,"ack;;");
+            }
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_active;
+            if (!utils::fmt::parseUint(l_text, l_active) || l_active > 1)
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (0 == l_active)
+            {
+                stop();
+                sprintf(b,"ack;;");
+            }
+            else if (0 == getPending())
+            {
+                sprintf(b,"invalid parameters;;");
+            }
+            else
+            {
+                m_isActive = true;
+                sprintf(b,"ack;;");
+            }
+        }
+        else if (3 == l_command && ';' == *l_text++)
+        {
+            float l_values[3];
+            if (3 != utils::fmt::parseFloats(l_text, l_values, 3))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (m_isActive)
+            {
+                sprintf(b,"busy;;");
+            }
+            else
+            {
+                sprintf(b, setParameters(l_values[0], l_values[1], l_values[2]) ? "ack;;" : "invalid parameters;;");
+            }
+        }
+        else if (4 == l_command && ';' == *l_text++)
+        {
+            float l_values[2];
+            if (2 != utils::fmt::parseFloats(l_text, l_values, 2))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (m_isActive)
+            {
+                sprintf(b,"busy;;");
+            }
+            else
+            {
+                sprintf(b, setSpeedLimits(l_values[0], l_values[1]) ? "ack;;" : "invalid parameters;;");
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace brain
@@ -23,34 +23,113 @@ limitations under the License.
   ******************************************************************************
  */
 #include <brain/robotstatemachine.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/serial/protocolschemas.hpp>
+#include <utils/config/vehicleprofile.hpp>
 
 namespace brain{
 
+    /** \brief  Actions of the states (entry, run, exit) */
+    const CRobotStateMachine::CEngine::CStateTable CRobotStateMachine::s_states = {
+        /* STATE_HARD_BRAKE */ {&CRobotStateMachine::enterHardBrake, &CRobotStateMachine::runHardBrake, NULL},
+        /* STATE_MOVE       */ {NULL,                                &CRobotStateMachine::runMove,      NULL},
+        /* STATE_BRAKE      */ {&CRobotStateMachine::enterBrake,     &CRobotStateMachine::runBrake,     NULL}
+    };
+
+    /** \brief  Transitions by the current state and the event (EVENT_MOVE, EVENT_BRAKE, EVENT_HARD_BRAKE, EVENT_HARD_BRAKE_END, EVENT_FAULT) */
+    const CRobotStateMachine::CEngine::CTransitionTable CRobotStateMachine::s_transitions = {
+        /* STATE_HARD_BRAKE */ {STATE_MOVE,    STATE_BRAKE,   s_none,           STATE_BRAKE, STATE_BRAKE},
+        /* STATE_MOVE       */ {s_none,        STATE_BRAKE,   STATE_HARD_BRAKE, s_none,      STATE_BRAKE},
+        /* STATE_BRAKE      */ {STATE_MOVE,    s_none,        STATE_HARD_BRAKE, s_none,      s_none}
+    };
+
+    /** \brief  Schemas of the text commands, the ranges reject the malformed values, the limits of the actuators are verified by the commands. 
+     *  The speed and angle fields come from the protocol definition, so the text and binary commands have the same ranges. */
+    static const utils::serial::SField& s_speedField    = utils::serial::schema::s_moveSpeedField;
+    static const utils::serial::SField& s_angleField    = utils::serial::schema::s_moveAngleField;
+    static const utils::serial::SField (&s_moveFields)[2]   = utils::serial::schema::s_moveFields;
+    static const utils::serial::SField (&s_brakeFields)[1]  = utils::serial::schema::s_brakeFields;
+    static const utils::serial::SField s_hardBrakeFields[]  = {s_speedField, s_angleField};
+    static const utils::serial::SField s_pidFields[]        = {{utils::serial::FIELD_INT, 0.0f, 1.0f, "bool"}};
+    static const utils::serial::SField s_distanceFields[]   = {{utils::serial::FIELD_FLOAT, -1000.0f, 1000.0f, "m"}, s_speedField, s_angleField};
+    static const utils::serial::SField s_profileFields[]    = {{utils::serial::FIELD_FLOAT, 0.0f, 1e6f, "unit/s"}, {utils::serial::FIELD_FLOAT, 0.0f, 1e6f, "unit/s2"}, {utils::serial::FIELD_FLOAT, 0.0f, 1e6f, "deg/s"}};
+    static const utils::serial::SField s_scheduleFields[]   = {{utils::serial::FIELD_UINT, 0.0f, 4294967295.0f, "us"}, {utils::serial::FIELD_UINT, 0.0f, 1.0f, "type"}, s_speedField, s_angleField};
+    static const utils::serial::SField s_autotuneFields[]   = {{utils::serial::FIELD_FLOAT, 0.0f, 100.0f, "V"}, {utils::serial::FIELD_FLOAT, 0.0f, 100.0f, "rps"}};
+    static const utils::serial::SField s_stepExperimentFields[]  = {s_speedField, {utils::serial::FIELD_FLOAT, -10.0f, 10.0f, "m/s"}, {utils::serial::FIELD_FLOAT, 0.01f, 60.0f, "s"}, {utils::serial::FIELD_UINT, 1.0f, 1000.0f, "steps"}};
+    static const utils::serial::SField s_sweepExperimentFields[] = {s_speedField, {utils::serial::FIELD_FLOAT, -10.0f, 10.0f, "m/s"}, {utils::serial::FIELD_FLOAT, 0.01f, 600.0f, "s"}, {utils::serial::FIELD_FLOAT, 0.0f, 1000.0f, "Hz"}, {utils::serial::FIELD_FLOAT, 0.0f, 1000.0f, "Hz"}};
+    static const utils::serial::SField s_brakeDutyFields[]  = {{utils::serial::FIELD_FLOAT, 0.0f, 1.0f, "duty"}};
+    static const utils::serial::SField s_obstacleFields[]   = {{utils::serial::FIELD_INT, 0.0f, 1.0f, "bool"}, {utils::serial::FIELD_FLOAT, 0.0f, 10.0f, "s"}, {utils::serial::FIELD_FLOAT, 0.0f, 5.0f, "m"}, s_speedField};
+    static const utils::serial::CCommandSchema s_moveSchema(s_moveFields);
+    static const utils::serial::CCommandSchema s_brakeSchema(s_brakeFields);
+    static const utils::serial::CCommandSchema s_hardBrakeSchema(s_hardBrakeFields);
+    static const utils::serial::CCommandSchema s_pidSchema(s_pidFields);
+    static const utils::serial::CCommandSchema s_distanceSchema(s_distanceFields);
+    static const utils::serial::CCommandSchema s_profileSchema(s_profileFields);
+    static const utils::serial::CCommandSchema s_scheduleSchema(s_scheduleFields);
+    static const utils::serial::CCommandSchema s_autotuneSchema(s_autotuneFields);
+    static const utils::serial::CCommandSchema s_stepExperimentSchema(s_stepExperimentFields);
+    static const utils::serial::CCommandSchema s_sweepExperimentSchema(s_sweepExperimentFields);
+    static const utils::serial::CCommandSchema s_brakeDutySchema(s_brakeDutyFields);
+    static const utils::serial::CCommandSchema s_obstacleSchema(s_obstacleFields);
+
     /**
      * @brief CRobotStateMachine Class constructor
      * 
      * @param f_period_sec          period for controller execution in seconds
-     * @param f_serialPort          reference to serial communication object
+     * @param f_serialPort          reference to the serial transmitter
+     * @param f_eventLog            event log of the reports in the control tick
      * @param f_motorControl        reference to dc motor control interface
      * @param f_steeringControl     reference to steering motor control interface
      * @param f_control             reference to controller object
      */
     CRobotStateMachine::CRobotStateMachine(
             float f_period_sec,
-            Serial& f_serialPort,
+            utils::serial::CSerialTransmitter& f_serialPort,
+            utils::log::CEventLog&                            f_eventLog,
             hardware::drivers::IMotorCommand&                 f_motorControl,
             hardware::drivers::ISteeringCommand&              f_steeringControl,
             signal::controllers::CMotorController*           f_control) 
         : m_serialPort(f_serialPort)
+        , m_eventLog(f_eventLog)
         , m_motorControl(f_motorControl)
         , m_steeringControl(f_steeringControl)
         , m_speed()
         , m_angle()
         , m_period_sec(f_period_sec)
         , m_ispidActivated(false)
-        , m_hbTimeOut()
+        , m_speedProfile(f_period_sec)
+        , m_angleProfile(f_period_sec)
+        , m_schedule()
+        , m_lastScheduled(0)
+        , m_pushed(0)
+        , m_popped(0)
+        , m_clearUntil(0)
+        , m_isAutotuning(false)
+        , m_isExperimenting(false)
+        , m_isEmergencyStop(false)
+        , m_lastCommand(0)
+        , m_hardBrake(0)
+        , m_hardBrakeSequence()
+        , m_hardBrakeSteps(0)
+        , m_hardBrakeDirection(0)
+        , m_hardBrakeRef(0)
+        , m_hardBrakeDeceleration(750.0f)
+        , m_hardBrakeGain(0.02f)
+        , m_obstacleSensors(NULL)
+        , m_obstacleSensorCount(0)
+        , m_reflexEnabled(true)
+        , m_reflexTtc(0.5f)
+        , m_reflexGap(0.2f)
+        , m_reflexBrake(0.4f)
+        , m_reflexCount(0)
+        , m_brakeDuty(1.0f)
         , m_control(f_control)
-        , m_timer(mbed::callback(this,&CRobotStateMachine::_run))
+        , m_faultCallback()
+        , m_pathFollower(NULL)
+        , m_energyGovernor(NULL)
+        , m_timer(&CRobotStateMachine::expireTimer, this)
+        , m_engine(*this, s_states, s_transitions, STATE_HARD_BRAKE)
     {
     }
 
@@ -61,6 +140,8 @@ namespace brain{
     {   
         m_speed = 0;
         m_angle = 0;
+        m_speedProfile.reset(0);
+        m_angleProfile.reset(0);
     }
 
     /** \brief  Get last speed command
@@ -84,83 +165,469 @@ namespace brain{
 
     /** \brief  BrakeCallback method
      * 
-     *  It changes the controller state to brake from default state. It's applied to deactivated hard braking.
+     *  It posts the end of the hard braking, the state machine changes to brake state from the hard braking state. It's applied at the 
+     *  end of the hard braking sequence, so no separate timeout interrupt is used.
      *  
      */
     void CRobotStateMachine::BrakeCallback(){
-        if( m_state == 0){
-            m_state=2;
-        }
+        m_engine.post(EVENT_HARD_BRAKE_END);
     }
 
-    /** \brief  Set state of the controller
+    /** \brief  Current state of the state machine
      * 
-     *  @param  f_state state of controller express in integer value between 0 and 2
-     *  
+     *  @return  state (ERobotState)
      */
-    void CRobotStateMachine::setState(int f_state){
-        m_state = f_state;
+    uint8_t CRobotStateMachine::getState(){
+        return m_engine.getState();
     }
 
     /** \brief  _Run method contains the main application logic, where it controls the lower lever drivers (dc motor and steering) based the given command and state.
-     * It has three state: 
-     *  - 0 - default state -> it doesn't apply any control signal on the drivers.
-     *  - 1 - move state -> control the motor rotation speed by giving direct a PWM signal or by a pid controller
+     * It applies one step of the table-driven state machine (s_states, s_transitions), the states are: 
+     *  - STATE_HARD_BRAKE - default state -> it doesn't apply any control signal on the drivers, the hard braking is applied by entering.
+     *  - STATE_MOVE - move state -> control the motor rotation speed by giving direct a PWM signal or by a pid controller
      *                   -> and control the steering angle
-     *  - 2 - brake state -> apply a dynamic braking on the motor and control the steering angle.          
+     *  - STATE_BRAKE - brake state -> apply a dynamic braking on the motor and control the steering angle.          
+     * The speed and the steering angle commands are the targets of the setpoint profiles, they are applied through the profiles.
+     * The scheduled commands are applied at the beginning of the step, when their time is reached, then the obstacle reflex is checked, 
+     * so its braking overrides them in the same step.
      */
-    void CRobotStateMachine::_run()
+    CONTROL_RAMFUNC void CRobotStateMachine::_run()
     {   
-        switch(m_state)
+        if(m_isEmergencyStop) // The motor was braked by the interrupt, the state machine brakes before its controller is applied
+        {
+            m_isEmergencyStop = false;
+            failsafe();
+            m_eventLog.log<utils::log::LOG_EMERGENCY_STOP>();
+        }
+        uint32_t l_time = us_ticker_read();
+        applySchedule(l_time);
+        checkObstacle(l_time);
+        if(m_isAutotuning && m_control->getAutotuneState() != signal::controllers::CRelayAutotuner::RUNNING) // Report the end of the autotuning
+        {
+            m_isAutotuning = false;
+            if(m_control->getAutotuneState() == signal::controllers::CRelayAutotuner::FINISHED)
+            {
+                const signal::controllers::CRelayAutotuner::SResult& l_result = m_control->getAutotuneResult();
+                m_eventLog.log<utils::log::LOG_AUTOTUNE_RESULT>(l_result.m_kp, l_result.m_ki, l_result.m_kd, l_result.m_tf);
+            }
+            else
+            {
+                m_eventLog.log<utils::log::LOG_AUTOTUNE_FAILED>();
+            }
+        }
+        if(m_isExperimenting && m_control->getExperimentState() != signal::controllers::CStepExperiment::RUNNING) // Report the result record of the experiment
         {
-            // Move state - control the dc motor rotation speed and the steering angle. 
-            case 1:
-                m_steeringControl.setAngle(m_angle); // control the steering angle 
-                if(m_ispidActivated && m_control!=NULL) // Check the pid controller 
+            m_isExperimenting = false;
+            if(m_control->getExperimentState() == signal::controllers::CStepExperiment::FINISHED)
+            {
+                const signal::controllers::CStepExperiment::SResult& l_result = m_control->getExperimentResult();
+                char l_text[utils::serial::CSerialTransmitter::s_maxMessageLength];
+                utils::fmt::CWriter l_writer(l_text);
+                l_writer.text("@EXPR:").fixed(l_result.m_iae,4).fixed(l_result.m_ise,4).fixed(l_result.m_riseTime,4).fixed(l_result.m_overshoot,2)
+                        .fixed(l_result.m_settling,4).fixed(l_result.m_steadyError,4).udec(l_result.m_steps).udec(l_result.m_unsettled).text(";\r\n");
+                m_serialPort.write(l_writer.data(), l_writer.length());
+            }
+            else
+            {
+                m_eventLog.log<utils::log::LOG_EXPERIMENT_ABORTED>();
+            }
+        }
+        m_engine.step();
+    }
+
+    /** \brief  Run action of the move state, it controls the dc motor rotation speed and the steering angle. 
+     *
+     * The errors of the controller, the end of the distance command and the end of the path following post the events of the braking.
+     */
+    void CRobotStateMachine::runMove()
+    {
+        if(m_pathFollower!=NULL) // The lateral controller gives the steering angle during the path following
+        {
+            float l_speed = m_speed;
+            uint8_t l_status = m_pathFollower->control(m_angle, l_speed);
+            if(CPathFollower::STATUS_REACHED == l_status) // The path is finished, it changes to the braking state.
+            {
+                m_eventLog.log<utils::log::LOG_PATH_REACHED>();
+                m_speed = 0;
+                m_speedProfile.reset(0);
+                m_engine.post(EVENT_BRAKE);
+                return;
+            }
+            if(CPathFollower::STATUS_FOLLOWING == l_status)
+            {
+                m_angleProfile.setTarget(m_angle);
+                if(m_ispidActivated && m_pathFollower->isPlanning()) // The planned speed is the target of the speed profile
                 {
-                    m_control->setRef(CRobotStateMachine::Mps2Rps( m_speed )); // Set the reference of dc motor speed
-                    // Calculate control signal and return the controller state. 
-                    int8_t l_isCorrect = m_control->control(); 
-                    // Check the state of the control method 
-                    if( l_isCorrect == -1 ) // High consecutive control signal 
-                    {
-                        // In this case the encoder is working fine and measures too high speed rotation, than it changes to the braking state.  
-                        m_serialPort.printf("@PIDA:Too high speed and the encoder working;;\r\n");
-                        m_motorControl.brake();
-                        m_control->clear();
-                        m_state = 2;
-                    }
-                    else if (l_isCorrect == -2 ) // High consecutive control signal without observation value. 
-                    {
-                        // In this case the encoder fails and measures 0 rps, but the control signal had a series high values. 
-                        // This part protects the robot to run with high speed, when the encoder doesn't measure correctly or it's broker.
-                        m_serialPort.printf("@PIDA:Encoder error;;\r\n");
-                        m_motorControl.brake();
-                        m_control->clear();
-                        m_state = 2;
-                    }
-                    else // It's all right and can control the robot. 
-                    {
-                        m_motorControl.setSpeed(m_control->get());
-                    }
-                    
+                    m_speed = l_speed;
+                    m_speedProfile.setTarget(l_speed);
                 }
-                else // The pid controller is deactivated and the dc motor is controlled by user control signal by giving duty cycle of PWM. 
+            }
+        }
+        m_steeringControl.setAngle(m_angleProfile.step()); // control the steering angle 
+        if(m_ispidActivated && m_control!=NULL) // Check the pid controller 
+        {
+            if(m_control->isPositionReached()) // The distance command is finished, it changes to the braking state.
+            {
+                m_eventLog.log<utils::log::LOG_DISTANCE_REACHED>();
+                m_control->stopPositionControl();
+                m_engine.post(EVENT_BRAKE);
+                return;
+            }
+            if(!m_control->isPositionControlled()) // The reference is given by the position controller during a distance command
+            {
+                applyEnergyCaps();
+                m_control->setRef(CRobotStateMachine::Mps2Rps( m_speedProfile.step() )); // Set the reference of dc motor speed
+            }
+            // Calculate control signal and return the controller state. 
+            int8_t l_isCorrect = m_control->control(); 
+            // Check the state of the control method 
+            if( l_isCorrect == -1 ) // High consecutive control signal 
+            {
+                // In this case the encoder is working fine and measures too high speed rotation, than it changes to the braking state.  
+                m_eventLog.log<utils::log::LOG_HIGH_SPEED>();
+                if (m_faultCallback)
                 {
-                    m_motorControl.setSpeed(m_speed);
+                    m_faultCallback(FAULT_HIGH_SPEED);
                 }
-                break;
-
-            // Brake state
-            case 2:
-                m_steeringControl.setAngle(m_angle); // Setting the steering angle
-                m_motorControl.brake(); // dc motor dynamic braking. 
-                if( m_control!=NULL){ 
-                    m_control->clear();
+                m_engine.post(EVENT_FAULT);
+            }
+            else if (l_isCorrect == -2 ) // High consecutive control signal without observation value. 
+            {
+                // In this case the encoder fails and measures 0 rps, but the control signal had a series high values. 
+                // This part protects the robot to run with high speed, when the encoder doesn't measure correctly or it's broker.
+                m_eventLog.log<utils::log::LOG_ENCODER_ERROR>();
+                if (m_faultCallback)
+                {
+                    m_faultCallback(FAULT_ENCODER);
                 }
-                break;
+                m_engine.post(EVENT_FAULT);
+            }
+            else // It's all right and can control the robot. 
+            {
+                m_motorControl.setSpeed(m_control->get());
+            }
+        }
+        else // The pid controller is deactivated and the dc motor is controlled by user control signal by giving duty cycle of PWM. 
+        {
+            m_motorControl.setSpeed(m_speedProfile.step());
+        }
+    }
+
+    /** \brief  It applies the caps of the energy governor on the speed profile, the target is limited by the speed cap and the rate by the
+     *  acceleration cap. The removed caps restore the speed of the move command.
+     */
+    void CRobotStateMachine::applyEnergyCaps()
+    {
+        if(m_energyGovernor==NULL)
+        {
+            return;
+        }
+        if(m_energyGovernor->isActive())
+        {
+            float l_cap = m_energyGovernor->getSpeedCap();
+            m_speedProfile.setTarget((m_speed > l_cap) ? l_cap : ((m_speed < -l_cap) ? -l_cap : m_speed));
+            m_speedProfile.setRateCap(m_energyGovernor->getAccelerationCap());
+        }
+        else
+        {
+            m_speedProfile.setRateCap(0.0f);
+            m_speedProfile.setTarget(m_speed);
+        }
+    }
+
+    /** \brief  Entry action of the brake state, it brakes the dc motor without delay and it clears the controller.
+     *
+     */
+    void CRobotStateMachine::enterBrake()
+    {
+        m_motorControl.dynamicBrake(m_brakeDuty);
+        if( m_control!=NULL){ 
+            m_control->clear();
+        }
+    }
+
+    /** \brief  Run action of the brake state, it applies the proportional dynamic braking and it controls the steering angle.
+     *
+     */
+    void CRobotStateMachine::runBrake()
+    {
+        m_steeringControl.setAngle(m_angleProfile.step()); // Setting the steering angle
+        m_motorControl.dynamicBrake(m_brakeDuty); // dc motor dynamic braking, the zero duty cycle coasts
+        if( m_control!=NULL){ 
+            m_control->clear();
+        }
+    }
+
+    /** \brief  Entry action of the hard braking state, it starts the hard braking sequence, its first part is applied without delay.
+     *
+     */
+    void CRobotStateMachine::enterHardBrake()
+    {
+        m_hardBrakeSequence.restart();
+        hardBrakeSequence();
+    }
+
+    /** \brief  Run action of the hard braking state, it resumes the hard braking sequence in each step.
+     *
+     */
+    void CRobotStateMachine::runHardBrake()
+    {
+        m_hardBrakeSequence.tick();
+        hardBrakeSequence();
+    }
+
+    /** \brief  Sequence of the hard braking, it's resumed by the steps of the state machine and it posts the end of the braking.
+     *
+     * With the motor controller the braking is closed-loop: the speed profile starts from the measured speed and it decreases to zero by the 
+     * deceleration, the duration is only the limit of the braking. When the motor stands, it's braked without reverse torque for a step. 
+     * Without the motor controller the inverse direction is a fixed pulse.
+     */
+    void CRobotStateMachine::hardBrakeSequence()
+    {
+        SEQUENCE_BEGIN(m_hardBrakeSequence);
+        m_hardBrakeDirection = 0;
+        if(m_control==NULL) // Fixed pulse
+        {
+            m_motorControl.inverseDirection(m_hardBrake);
+            m_hardBrakeSteps = static_cast<uint32_t>(s_hardBrakeDuration / m_period_sec + 0.5f);
+            SEQUENCE_AWAIT_TICKS(m_hardBrakeSequence, (m_hardBrakeSteps > 0) ? m_hardBrakeSteps : 1);
+        }
+        else if(fabsf(m_control->getMeasuredSpeed()) <= s_hardBrakeStopSpeed) // The motor stands, it doesn't apply reverse torque
+        {
+            m_motorControl.brake();
+            SEQUENCE_YIELD(m_hardBrakeSequence);
+        }
+        else
+        {
+            m_hardBrakeDirection = (m_control->getMeasuredSpeed() > 0) ? 1.0f : -1.0f;
+            m_hardBrakeRef = fabsf(m_control->getMeasuredSpeed());
+            m_hardBrakeSteps = static_cast<uint32_t>((m_hardBrakeRef / m_hardBrakeDeceleration + s_hardBrakeDuration) / m_period_sec + 0.5f);
+            m_motorControl.setSpeed(-m_hardBrakeDirection * fabsf(m_hardBrake));
+            for(;;) // The profile is controlled in each step until the release or the limit of the duration
+            {
+                SEQUENCE_YIELD(m_hardBrakeSequence);
+                if(m_hardBrakeSteps == 0)
+                {
+                    break;
+                }
+                --m_hardBrakeSteps;
+                if(controlHardBrake())
+                {
+                    break;
+                }
+            }
+        }
+        BrakeCallback();
+        SEQUENCE_END(m_hardBrakeSequence);
+    }
+
+    /** \brief  Control step of the closed-loop hard braking, it controls the deceleration by the encoder feedback.
+     *
+     * The reverse torque is proportional to the speed above the profile and it's limited by the duty cycle of the command, it's released 
+     * at zero speed, so the robot doesn't creep backward. After the release the motor is braked dynamically.
+     *
+     * \return true, when the reverse torque is released
+     */
+    bool CRobotStateMachine::controlHardBrake()
+    {
+        float l_speed = m_control->getMeasuredSpeed() * m_hardBrakeDirection;
+        if(l_speed <= s_hardBrakeStopSpeed) // Zero speed, the reverse torque is released
+        {
+            m_motorControl.brake();
+            return true;
+        }
+        m_hardBrakeRef -= m_hardBrakeDeceleration * m_period_sec;
+        m_hardBrakeRef = (m_hardBrakeRef > 0) ? m_hardBrakeRef : 0;
+        float l_pwm = m_hardBrakeGain * (l_speed - m_hardBrakeRef);
+        float l_maxPwm = fabsf(m_hardBrake);
+        l_pwm = (l_pwm > l_maxPwm) ? l_maxPwm : ((l_pwm < 0) ? 0 : l_pwm);
+        if(l_pwm > 0)
+        {
+            m_motorControl.setSpeed(-m_hardBrakeDirection * l_pwm);
+        }
+        else // Below the profile the motor coasts
+        {
+            m_motorControl.coast();
+        }
+        return false;
+    }
+
+    /** \brief  Check the distance sensors by the obstacle reflex, it's applied in each control tick.
+     *
+     * Only the forward move with the measured speed is checked. The gap of a valid and recent measurement is reduced by the travel since 
+     * the measurement, so a slow sensor doesn't delay the reflex. Below the minimum gap or the time-to-collision limit the schedule, the 
+     * path following and the distance command are cancelled and the closed-loop hard braking is posted, it's entered by the step of the 
+     * same tick.
+     *
+     * @param f_time              current board time (us)
+     */
+    CONTROL_RAMFUNC void CRobotStateMachine::checkObstacle(uint32_t f_time)
+    {
+        if(!m_reflexEnabled || m_obstacleSensorCount == 0 || m_control == NULL || getState() != STATE_MOVE)
+        {
+            return;
+        }
+        float l_speed = m_control->getMeasuredSpeed() / utils::config::s_vehicle.m_rotationsPerMeter;
+        if(l_speed < s_reflexMinSpeed)
+        {
+            return;
+        }
+        for(uint8_t i = 0; i < m_obstacleSensorCount; ++i)
+        {
+            hardware::distance::SDistance l_distance = m_obstacleSensors[i]->read();
+            int32_t l_age = static_cast<int32_t>(f_time - l_distance.m_timestamp);
+            l_age = (l_age > 0) ? l_age : 0;
+            if(hardware::distance::DISTANCE_VALID != l_distance.m_status || static_cast<uint32_t>(l_age) > s_reflexMaxAge)
+            {
+                continue;
+            }
+            float l_gap = l_distance.m_distance - l_speed * l_age * 1e-6f;
+            float l_ttc = l_gap / l_speed;
+            if(l_gap >= m_reflexGap && l_ttc >= m_reflexTtc)
+            {
+                continue;
+            }
+            m_speed = 0;
+            m_speedProfile.reset(0);
+            m_clearUntil = m_pushed;
+            if(m_pathFollower != NULL)
+            {
+                m_pathFollower->stop();
+            }
+            m_control->stopPositionControl();
+            m_control->stopAutotune();
+            m_control->stopExperiment();
+            m_hardBrake = m_reflexBrake;
+            m_engine.post(EVENT_HARD_BRAKE);
+            m_reflexCount++;
+            char l_text[utils::serial::CSerialTransmitter::s_maxMessageLength];
+            utils::fmt::CWriter l_writer(l_text);
+            l_writer.text("@OBST:").udec(i).fixed(l_gap,3).fixed(l_ttc,3).text(";\r\n");
+            m_serialPort.write(l_writer.data(), l_writer.length(), utils::serial::CSerialTransmitter::LANE_SAFETY);
+            return;
+        }
+    }
+
+    /** \brief  Verify and apply a move command
+     *
+     * In the case of pid activated,  the dc motor control values has to be express in meter per second, otherwise represent the duty cycle of PWM signal in percent. 
+     * The steering angle has to express in degree, where the positive values marks the right direction and the negative values noticed the left turning direction.
+     *
+     * @param f_speed             speed command or speed reference
+     * @param f_angle             steering angle
+     * @return                    status code (utils::serial::EBinaryStatus)
+     */
+    uint8_t CRobotStateMachine::move(float f_speed, float f_angle)
+    {
+        if( !m_ispidActivated && !m_motorControl.inRange(f_speed)){ // Check the received control value
+            return utils::serial::BIN_SPEED_RANGE;
+        }
+        if( m_ispidActivated && !m_control->inRange(CRobotStateMachine::Mps2Rps(f_speed))){ //Check the received reference value
+            return utils::serial::BIN_REFERENCE_RANGE;
+        }
+        if( !m_steeringControl.inRange(f_angle)){ // Check the received steering angle
+            return utils::serial::BIN_ANGLE_RANGE;
+        }
+
+        if( m_control!=NULL){
+            m_control->stopPositionControl();
+            m_control->stopAutotune();
+            m_control->stopExperiment();
         }
-        
+        m_speed = f_speed;
+        m_angle = f_angle; 
+        m_speedProfile.setTarget(f_speed);
+        m_angleProfile.setTarget(f_angle);
+        m_engine.post(EVENT_MOVE);
+        m_lastCommand = us_ticker_read();
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Verify and apply a distance command
+     *
+     * The pid controller has to be activated, the position controller of the motor controller drives the given distance with the 
+     * limited speed, than the robot brakes. The distance and the speed are expressed in meter and meter per second.
+     *
+     * @param f_distance          distance, the sign gives the direction
+     * @param f_speed             speed limit
+     * @param f_angle             steering angle
+     * @return                    status code (utils::serial::EBinaryStatus)
+     */
+    uint8_t CRobotStateMachine::distance(float f_distance, float f_speed, float f_angle)
+    {
+        if( !m_ispidActivated || m_control==NULL){
+            return utils::serial::BIN_NOT_AVAILABLE;
+        }
+        if( !m_steeringControl.inRange(f_angle)){ // Check the received steering angle
+            return utils::serial::BIN_ANGLE_RANGE;
+        }
+        if( !m_control->setPositionTarget(CRobotStateMachine::Mps2Rps(f_distance), CRobotStateMachine::Mps2Rps(f_speed))){
+            return utils::serial::BIN_REFERENCE_RANGE;
+        }
+        m_speed = 0;
+        m_angle = f_angle;
+        m_speedProfile.reset(0);
+        m_angleProfile.setTarget(f_angle);
+        m_engine.post(EVENT_MOVE);
+        m_lastCommand = us_ticker_read();
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Verify and apply a brake command
+     *
+     * It changes the state of controller to brake and sets the steering angle to the received value. 
+     *
+     * @param f_angle             steering angle
+     * @param f_clearSchedule     [Optional] cancel the scheduled commands
+     * @return                    status code (utils::serial::EBinaryStatus)
+     */
+    uint8_t CRobotStateMachine::brake(float f_angle, bool f_clearSchedule)
+    {
+        if( !m_steeringControl.inRange(f_angle)){
+            return utils::serial::BIN_ANGLE_RANGE;
+        }
+        m_speed = 0;
+        m_angle = f_angle;
+        m_speedProfile.reset(0);
+        m_angleProfile.setTarget(f_angle);
+        // Brake state 
+        m_engine.post(EVENT_BRAKE);
+        m_lastCommand = us_ticker_read();
+        // An immediate braking cancels the scheduled commands
+        if( f_clearSchedule){
+            m_clearUntil = m_pushed;
+        }
+        // The braking finishes the path following
+        if( m_pathFollower!=NULL){
+            m_pathFollower->stop();
+        }
+
+        if( m_control!=NULL){
+            m_control->stopPositionControl();
+            m_control->stopAutotune();
+            m_control->stopExperiment();
+            m_control->setRef(0);
+        }
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Activate or deactivate the pid controller
+     *
+     * @param f_activate          activation state
+     * @return                    status code (utils::serial::EBinaryStatus)
+     */
+    uint8_t CRobotStateMachine::activatePid(bool f_activate)
+    {
+        if(m_control==NULL){
+            return utils::serial::BIN_NOT_AVAILABLE;
+        }
+        m_speed = 0;
+        m_speedProfile.reset(0);
+        m_ispidActivated=f_activate;
+        // Change to brake state
+        m_engine.post(EVENT_BRAKE);
+        m_lastCommand = us_ticker_read();
+        return utils::serial::BIN_ACK;
     }
 
     /** \brief  Serial callback method for move command
@@ -175,32 +642,10 @@ namespace brain{
      */
     void CRobotStateMachine::serialCallbackMove(char const * a, char * b)
     {
-        float l_speed;
-        float l_angle;
-        uint32_t l_res = sscanf(a,"%f;%f",&l_speed,&l_angle);
-        if (2 == l_res)
+        utils::serial::UFieldValue l_values[2];
+        if (s_moveSchema.parse(a, l_values, b))
         {
-            if( !m_ispidActivated && !m_motorControl.inRange(l_speed)){ // Check the received control value
-                sprintf(b,"The speed command is too high;;");
-                return;
-            }
-            if( m_ispidActivated && !m_control->inRange(CRobotStateMachine::Mps2Rps(l_speed))){ //Check the received reference value
-                sprintf(b,"The speed reference is too high;;");
-                return;
-            }
-            if( !m_steeringControl.inRange(l_angle)){ // Check the received steering angle
-                sprintf(b,"The steering angle command is too high;;");
-                return;
-            }
-
-            m_speed = l_speed;
-            m_angle = l_angle; 
-            m_state=1;
-            sprintf(b,"ack;;");
-        }
-        else
-        {
-            sprintf(b,"sintax error;;");
+            utils::serial::CCommandSchema::respond(b, move(l_values[0].m_float, l_values[1].m_float));
         }
     }
 
@@ -214,34 +659,19 @@ namespace brain{
      */
     void CRobotStateMachine::serialCallbackBrake(char const * a, char * b)
     {
-        float l_angle;
-        uint32_t l_res = sscanf(a,"%f",&l_angle);
-        if(1 == l_res)
-        {
-            if( !m_steeringControl.inRange(l_angle)){
-                sprintf(b,"The steering angle command is too high;;");
-                return;
-            }
-            m_speed = 0;
-            m_angle = l_angle;
-            // Brake state 
-            m_state = 2;
-
-            if( m_control!=NULL){
-                m_control->setRef(0);
-            }
-            sprintf(b,"ack;;");           
-        }
-        else
+        utils::serial::UFieldValue l_values[1];
+        if (s_brakeSchema.parse(a, l_values, b))
         {
-            sprintf(b,"sintax error;;");
+            utils::serial::CCommandSchema::respond(b, brake(l_values[0].m_float));
         }
     }
 
     /** \brief  Serial callback actions for hard brake command
      *
-     * It can be used to activate a inverse current braking mechanism, the inverse current applies a short period of time. 
-     * The period is defined through attaching the "BrakeCallback" method. 
+     * It can be used to activate a inverse current braking mechanism. With the motor controller the inverse current follows a 
+     * deceleration profile to zero speed and it's released at zero speed, otherwise it applies a short period of time. 
+     * The period is counted down by the steps of the state machine, its end is posted by the "BrakeCallback" method. The string has to 
+     * contain the maximum duty cycle of the inverse current and the steering angle.
      *
      * @param a                   string to read data 
      * @param b                   string to write data
@@ -249,25 +679,37 @@ namespace brain{
      */
     void CRobotStateMachine::serialCallbackHardBrake(char const * a, char * b)
     {
-        float l_brake,l_angle;
-        uint32_t l_res = sscanf(a,"%f;%f",&l_brake,&l_angle);
-        if(2 == l_res && m_state!=0)
+        utils::serial::UFieldValue l_values[2];
+        if (!s_hardBrakeSchema.parse(a, l_values, b))
         {
-            if( !m_steeringControl.inRange(l_angle)){
-                sprintf(b,"The steering angle command is too high;;");
-                return;
-            }
-            m_speed=0;
-            m_angle = l_angle; 
-            m_motorControl.inverseDirection(l_brake);
-            m_hbTimeOut.attach(callback(this,&CRobotStateMachine::BrakeCallback),0.04); // Attaching a callback function for changing state to brake. 
-            m_state = 0;
-
-            sprintf(b,"ack;;");           
+            return;
+        }
+        float l_brake = l_values[0].m_float;
+        float l_angle = l_values[1].m_float;
+        if (getState() == STATE_HARD_BRAKE)
+        {
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_NOT_AVAILABLE);
+        }
+        else if (!m_steeringControl.inRange(l_angle))
+        {
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ANGLE_RANGE, 2);
         }
         else
         {
-            sprintf(b,"sintax error;;");
+            m_speed=0;
+            m_angle = l_angle; 
+            m_speedProfile.reset(0);
+            m_angleProfile.setTarget(l_angle);
+            m_clearUntil = m_pushed;
+            if (m_pathFollower != NULL)
+            {
+                m_pathFollower->stop();
+            }
+            m_hardBrake = l_brake;
+            m_lastCommand = us_ticker_read();
+            // The inverse direction is applied by the entry action of the hard braking state
+            m_engine.post(EVENT_HARD_BRAKE);
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
         }
     }
 
@@ -282,42 +724,373 @@ namespace brain{
      */
     void CRobotStateMachine::serialCallbackPID(char const * a, char * b)
     {
-        int l_isActivate=0;
-        uint32_t l_res = sscanf(a,"%d",&l_isActivate);
-        if(l_res==1)
-        {   
-            if(m_control==NULL){
-                sprintf(b,"Control object wans't instances. Cannot be activate pid controller;;");
-            }else{
-                m_speed = 0;
-                m_ispidActivated=(l_isActivate>=1);
-                // Change to brake state
-                m_state = 2;
-                sprintf(b,"ack;;");    
+        utils::serial::UFieldValue l_values[1];
+        if (s_pidSchema.parse(a, l_values, b))
+        {
+            utils::serial::CCommandSchema::respond(b, activatePid(l_values[0].m_int == 1));
+        }
+    }
+
+    /** \brief  Serial callback method for distance command
+     *
+     * The string has to contain the distance (m), the speed limit (m/s) and the steering angle (degree).
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackDistance(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[3];
+        if (s_distanceSchema.parse(a, l_values, b))
+        {
+            utils::serial::CCommandSchema::respond(b, distance(l_values[0].m_float, l_values[1].m_float, l_values[2].m_float));
+        }
+    }
+
+    /** \brief  Serial callback method for the duty cycle of the braking state
+     *
+     * The string has to contain the duty cycle of the proportional dynamic braking in interval [0,1], the one is the full braking (default), 
+     * the zero lets the motor coast. It's applied by the braking state and after the closed-loop hard braking.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackBrakeDuty(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[1];
+        if (s_brakeDutySchema.parse(a, l_values, b))
+        {
+            m_brakeDuty = l_values[0].m_float;
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
+        }
+    }
+
+    /** \brief  Serial callback method for the parameters of the obstacle reflex
+     *
+     * The string has to contain the activation of the reflex (0 or 1), the time-to-collision limit (s), the minimum gap (m) and the maximum 
+     * duty cycle of the reverse torque of the hard braking. The response contains the number of the reflex brakings.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackObstacle(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[4];
+        if (!s_obstacleSchema.parse(a, l_values, b))
+        {
+            return;
+        }
+        if (!m_motorControl.inRange(l_values[3].m_float))
+        {
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_SPEED_RANGE, 4);
+            return;
+        }
+        m_reflexEnabled = (1 == l_values[0].m_int);
+        m_reflexTtc = l_values[1].m_float;
+        m_reflexGap = l_values[2].m_float;
+        m_reflexBrake = fabsf(l_values[3].m_float);
+        sprintf(b,"ack;;%lu;",static_cast<unsigned long>(m_reflexCount));
+    }
+
+    /** \brief  Serial callback method for the profile limits
+     *
+     * The string has to contain the maximum acceleration, the maximum jerk of the speed command and the maximum rate of the steering angle. 
+     * The speed limits are expressed in the unit of the speed command (m/s or duty cycle percent) per second and per square second, the 
+     * steering rate in degree per second. A zero limit disables the profile, without jerk limit the speed profile is trapezoidal. 
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackProfile(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[3];
+        if (s_profileSchema.parse(a, l_values, b))
+        {
+            m_speedProfile.setLimits(l_values[0].m_float, l_values[1].m_float);
+            m_angleProfile.setLimits(l_values[2].m_float, 0);
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
+        }
+    }
+
+    /** \brief  Apply the scheduled commands, which time is reached. 
+     *
+     * The commands are in order of their time, so only the first commands are verified. The time comparison handles the overflow 
+     * of the board time.
+     *
+     * @param f_time              current board time (us)
+     */
+    void CRobotStateMachine::applySchedule(uint32_t f_time)
+    {
+        SScheduledCommand l_command;
+        // Drop the commands pushed before the clearing request
+        while(static_cast<int32_t>(m_clearUntil - m_popped) > 0 && m_schedule.pop(l_command))
+        {
+            ++m_popped;
+        }
+        utils::CRingBuffer<SScheduledCommand,32>::SSpan l_spans[2];
+        while(m_schedule.getReadable(l_spans) > 0 && static_cast<int32_t>(f_time - l_spans[0].m_data[0].m_time) >= 0)
+        {
+            m_schedule.pop(l_command);
+            ++m_popped;
+            uint8_t l_status = (SCHEDULED_MOVE == l_command.m_type) ? move(l_command.m_speed, l_command.m_angle) : brake(l_command.m_angle, false);
+            if(utils::serial::BIN_ACK != l_status)
+            {
+                m_eventLog.log<utils::log::LOG_SCHEDULE_REJECTED>(l_command.m_time);
             }
-            
-        }else
+        }
+    }
+
+    /** \brief  Serial callback method for scheduling a command
+     *
+     * The string has to contain the board time of the application (us), the type of the command (0 - move, 1 - brake), the speed and 
+     * the steering angle in the unit of the move command. The time of the commands has to be non-decreasing, the board time can be read 
+     * by the 'TIME' command. An immediate brake command cancels the schedule.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackSchedule(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[4];
+        if (!s_scheduleSchema.parse(a, l_values, b))
+        {
+            return;
+        }
+        SScheduledCommand l_command = {l_values[0].m_uint, static_cast<uint8_t>(l_values[1].m_uint), l_values[2].m_float, l_values[3].m_float};
+        if( !m_steeringControl.inRange(l_command.m_angle)){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ANGLE_RANGE, 4);
+        } else if( m_clearUntil != m_pushed && !m_schedule.isEmpty() && static_cast<int32_t>(l_command.m_time - m_lastScheduled) < 0){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_VALUE_RANGE, 1);
+        } else if( !m_schedule.push(l_command)){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_QUEUE_FULL);
+        } else{
+            ++m_pushed;
+            m_lastCommand = us_ticker_read();
+            m_lastScheduled = l_command.m_time;
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
+        }
+    }
+
+    /** \brief  Serial callback method for clearing the scheduled commands
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackClearSchedule(char const * a, char * b)
+    {
+        m_clearUntil = m_pushed;
+        sprintf(b,"ack;;");
+    }
+
+    /** \brief  Serial callback method for the heartbeat of the host
+     *
+     * It refreshes the time of the last command without changing the commands, so the host can keep the movement alive.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackHeartbeat(char const * a, char * b)
+    {
+        m_lastCommand = us_ticker_read();
+        sprintf(b,"ack;;");
+    }
+
+    /** \brief  Failsafe braking, it's applied by the safety monitor, when the host doesn't send command in the timeout.
+     *
+     * It brakes with the current steering angle and it cancels the distance command and the scheduled commands.
+     */
+    void CRobotStateMachine::failsafe()
+    {
+        brake(m_angle);
+    }
+
+    /** \brief  Emergency stop, it's applied from the receive interrupt by the emergency stop frame.
+     *
+     * The motor is braked immediately, the braking of the state machine (failsafe) follows in the next control tick before the 
+     * controller, so the controller doesn't drive the motor again.
+     */
+    void CRobotStateMachine::emergencyStop()
+    {
+        m_motorControl.brake();
+        m_isEmergencyStop = true;
+    }
+
+    /** \brief  Serial callback method for reading the board time
+     *
+     * It responses the board time in microseconds, the scheduled commands are timestamped in this time base.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackTime(char const * a, char * b)
+    {
+        sprintf(b,"%lu;;",static_cast<unsigned long>(us_ticker_read()));
+    }
+
+    /** \brief  Serial callback method for autotuning command
+     *
+     * The string has to contain the relay amplitude (V) and the hysteresis (rps). The pid controller has to be activated and the robot has to move 
+     * with the speed of the operating point, the result is sent by the "@ATUN" message after the experiment.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackAutotune(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[2];
+        if (!s_autotuneSchema.parse(a, l_values, b))
+        {
+            return;
+        }
+        float l_amplitude = l_values[0].m_float;
+        float l_hysteresis = l_values[1].m_float;
+        if( !m_ispidActivated || m_control==NULL || getState()!=STATE_MOVE || m_speed==0){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_NOT_AVAILABLE);
+        } else if( l_amplitude<=0){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_VALUE_RANGE, 1);
+        } else if( !m_control->startAutotune(l_amplitude, l_hysteresis)){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_NOT_AVAILABLE);
+        } else{
+            m_isAutotuning = true;
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
+        }
+    }
+
+    /** \brief  Serial callback method for the step experiment of the speed controller
+     *
+     * The string has to contain the base speed (m/s), the amplitude of the steps (m/s), the duration of each level (s) and the number of 
+     * the steps. The pid controller has to be activated in the move state, the scripted reference replaces the speed command until the end, 
+     * a new command aborts it. The result record is sent by the "@EXPR" message (IAE, ISE, rise time, overshoot, settling time, steady-state 
+     * error, steps, unsettled steps), the errors are in rps.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackStepExperiment(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[4];
+        if (!s_stepExperimentSchema.parse(a, l_values, b))
         {
-            sprintf(b,"sintax error;;");
+            return;
+        }
+        if( !m_ispidActivated || m_control==NULL || getState()!=STATE_MOVE || m_isAutotuning || m_isExperimenting){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_NOT_AVAILABLE);
+        } else if( !m_control->startStepExperiment(Mps2Rps(l_values[0].m_float), Mps2Rps(l_values[1].m_float), l_values[2].m_float, l_values[3].m_uint)){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_REFERENCE_RANGE);
+        } else{
+            m_isExperimenting = true;
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
         }
     }
 
+    /** \brief  Serial callback method for the sweep experiment of the speed controller
+     *
+     * The string has to contain the base speed (m/s), the amplitude of the sine (m/s), the duration of the sweep (s), the start and the end 
+     * frequency (Hz). The conditions and the "@EXPR" result are the same as of the step experiment, the sweep gives only IAE and ISE.
+     *
+     * @param a                   string to read data 
+     * @param b                   string to write data 
+     */
+    void CRobotStateMachine::serialCallbackSweepExperiment(char const * a, char * b)
+    {
+        utils::serial::UFieldValue l_values[5];
+        if (!s_sweepExperimentSchema.parse(a, l_values, b))
+        {
+            return;
+        }
+        if( !m_ispidActivated || m_control==NULL || getState()!=STATE_MOVE || m_isAutotuning || m_isExperimenting){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_NOT_AVAILABLE);
+        } else if( !m_control->startSweepExperiment(Mps2Rps(l_values[0].m_float), Mps2Rps(l_values[1].m_float), l_values[2].m_float, l_values[3].m_float, l_values[4].m_float)){
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_REFERENCE_RANGE);
+        } else{
+            m_isExperimenting = true;
+            utils::serial::CCommandSchema::respond(b, utils::serial::BIN_ACK);
+        }
+    }
+
+    /** \brief  Binary callback method for move command
+     *
+     * @param f_payload           received payload
+     * @return                    status code of the response
+     */
+    uint8_t CRobotStateMachine::binaryCallbackMove(const utils::serial::SMovePayload& f_payload)
+    {
+        return move(f_payload.m_speed, f_payload.m_angle);
+    }
+
+    /** \brief  Binary callback method for brake command
+     *
+     * @param f_payload           received payload
+     * @return                    status code of the response
+     */
+    uint8_t CRobotStateMachine::binaryCallbackBrake(const utils::serial::SBrakePayload& f_payload)
+    {
+        return brake(f_payload.m_angle);
+    }
+
+    /** \brief  Binary callback method for the emergency stop, the frame is dispatched after its fast path, or without it in COBS framing.
+     *
+     * @param f_payload           received payload, it's empty
+     * @param f_length            length of the payload
+     * @return                    status code of the response
+     */
+    uint8_t CRobotStateMachine::binaryCallbackEmergencyStop(const uint8_t* f_payload, uint8_t f_length)
+    {
+        if(f_length != 0)
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        return brake(m_angle);
+    }
+
+    /** \brief  Binary callback method for pid activation command
+     *
+     * @param f_payload           received payload
+     * @return                    status code of the response
+     */
+    uint8_t CRobotStateMachine::binaryCallbackPID(const utils::serial::SActivationPayload& f_payload)
+    {
+        return activatePid(f_payload.m_activate != 0);
+    }
+
     /**
      * @brief Function to convert from linear velocity ( meter per second ) of robot to angular velocity ( rotation per second ) of motor.
+     * The ratio is the motor rotations per meter of the vehicle profile.
      * 
      * @param f_vel_mps linear velocity of robot
      * @return float angular velocity of motor
      */
     float CRobotStateMachine::Mps2Rps(float f_vel_mps){
-        return f_vel_mps * 150.0;
+        return f_vel_mps * utils::config::s_vehicle.m_rotationsPerMeter;
+    }
+
+    /**
+     * @brief Start the timer in the timer wheel, which periodically apply the run method from the tick of the wheel. The period of the task is defined in the contructor.
+     * 
+     * @param f_wheel timer wheel, for example the wheel of the task manager
+     */
+    void CRobotStateMachine::startTimer(utils::task::CTimerWheel& f_wheel){
+        uint32_t l_period = f_wheel.toTicks(m_period_sec);
+        f_wheel.arm(m_timer, l_period, l_period);
+    }
+
+    /**
+     * @brief Expiry callback of the timer, it applies the run method of the owner.
+     * 
+     * @param f_timer expired timer
+     */
+    void CRobotStateMachine::expireTimer(utils::task::CTimerWheel::CTimer& f_timer){
+        static_cast<CRobotStateMachine*>(f_timer.getContext())->_run();
     }
 
     /**
-     * @brief Start RtosTimer, which periodically apply the run method. The period of the task is defined in the contructor.
+     * @brief Pipeline stage, it applies one step of the state machine. It's used instead of the timer of the timer wheel, when the control loop is driven by a hardware timer, 
+     * in this case the period given in the constructor has to be equal to the period of the control loop.
      * 
+     * @param f_timestamp timestamp of the tick in microsecond
      */
-    void CRobotStateMachine::startRtosTimer(){
-        this->m_timer.start(static_cast<int>(m_period_sec*1000));
+    CONTROL_RAMFUNC void CRobotStateMachine::process(uint32_t f_timestamp){
+        _run();
     }
 
 }; // namespace brain
\ No newline at end of file
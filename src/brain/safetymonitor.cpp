@@ -0,0 +1,107 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    SafetyMonitor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the command timeout monitor and the watchdog.
+  ******************************************************************************
+ */
+
+#include <brain/safetymonitor.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace brain{
+
+    /** \brief  CSafetyMonitor class constructor
+     *
+     *  @param f_robot         supervised state machine
+     *  @param f_serialPort    serial transmitter for reporting
+     *  @param f_timeout_sec   command timeout in second, zero disables the check
+     */
+    CSafetyMonitor::CSafetyMonitor(CRobotStateMachine&                  f_robot
+                                  ,utils::serial::CSerialTransmitter&   f_serialPort
+                                  ,float                                f_timeout_sec)
+        : m_robot(f_robot)
+        , m_serialPort(f_serialPort)
+        , m_timeout(static_cast<uint32_t>(f_timeout_sec * 1000000.0f))
+        , m_isWatchdogActive(false)
+    {
+    }
+
+    /** \brief  Start the independent watchdog, it's refreshed in each tick of the control loop. 
+     *
+     *  It can't be stopped after the start, so it has to be started directly before the control loop.
+     *
+     *  @param f_timeout_sec   timeout of the watchdog in second
+     *  @return                true, when the watchdog is started
+     */
+    bool CSafetyMonitor::startWatchdog(float f_timeout_sec)
+    {
+        m_isWatchdogActive = hardware::drivers::CWatchdog_IWDG::start(f_timeout_sec);
+        return m_isWatchdogActive;
+    }
+
+    /** \brief  Pipeline stage, it refreshes the watchdog and it applies the failsafe braking, when the robot moves and the last 
+     *  command is older than the timeout.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    void CSafetyMonitor::process(uint32_t f_timestamp)
+    {
+        if (m_isWatchdogActive)
+        {
+            hardware::drivers::CWatchdog_IWDG::kick();
+        }
+        uint32_t l_timeout = m_timeout;
+        if (0 == l_timeout || CRobotStateMachine::STATE_MOVE != m_robot.getState())
+        {
+            return;
+        }
+        // The command can be received after the timestamp of the tick, it gives negative age
+        int32_t l_age = static_cast<int32_t>(f_timestamp - m_robot.getLastCommandTime());
+        if (l_age > static_cast<int32_t>(l_timeout))
+        {
+            m_robot.failsafe();
+            m_serialPort.printf(utils::serial::CSerialTransmitter::LANE_SAFETY,"@SAFE:command timeout;;\r\n");
+        }
+    }
+
+    /** \brief  Serial callback method for the command timeout
+     *
+     *  The string has to contain the timeout in second, zero disables the check.
+     *
+     *  @param a               string to read data 
+     *  @param b               string to write data 
+     */
+    void CSafetyMonitor::serialCallbackTimeout(char const * a, char * b)
+    {
+        float l_timeout;
+        uint32_t l_res = utils::fmt::parseFloats(a,&l_timeout,1);
+        if (1 == l_res && l_timeout >= 0 && l_timeout <= 60)
+        {
+            m_timeout = static_cast<uint32_t>(l_timeout * 1000000.0f);
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace brain
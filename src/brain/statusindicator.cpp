@@ -0,0 +1,124 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  * @file    StatusIndicator.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the blink codes of the robot status.
+  ******************************************************************************
+ */
+
+#include <brain/statusindicator.hpp>
+
+namespace brain{
+
+    /** \brief  CStatusIndicator class constructor
+     *
+     *  @param f_led               status led
+     *  @param f_robot             state machine, the time of its last command is the link status
+     *  @param f_linkTimeout_sec   without command over this time the link is lost
+     *  @param f_hold_sec          the fault and overload events are shown during this time
+     */
+    CStatusIndicator::CStatusIndicator(hardware::drivers::CStatusLed_TIM1& f_led
+                                      ,CRobotStateMachine&                  f_robot
+                                      ,float                                f_linkTimeout_sec
+                                      ,float                                f_hold_sec)
+        : m_led(f_led)
+        , m_robot(f_robot)
+        , m_linkTimeout(static_cast<uint32_t>(f_linkTimeout_sec * 1000000.0f))
+        , m_hold(static_cast<uint32_t>(f_hold_sec * 1000000.0f))
+        , m_fault()
+        , m_overloads()
+        , m_prevOverloads(0)
+        , m_faultEvent(false)
+        , m_faultUntil(0)
+        , m_overloadUntil(0)
+        , m_faultHeld(false)
+        , m_overloadHeld(false)
+        , m_tick(0)
+        , m_status(STATUS_LINK)
+    {
+        m_led.setPattern(hardware::drivers::CStatusLed_TIM1::flashes(STATUS_LINK));
+    }
+
+    /** \brief  Set the sources of the fault and overload conditions
+     *
+     *  @param f_fault         getter of the present fault conditions
+     *  @param f_overloads     getter of the monotonic number of the overload events
+     */
+    void CStatusIndicator::setSources(FFaultGetter f_fault, FOverloadCounter f_overloads)
+    {
+        m_fault = f_fault;
+        m_overloads = f_overloads;
+        m_prevOverloads = m_overloads ? m_overloads() : 0;
+    }
+
+    /** \brief  Latch a fault event, it's shown during the hold time. It can be applied from interrupt.
+     */
+    void CStatusIndicator::latchFault()
+    {
+        m_faultEvent = true;
+    }
+
+    /** \brief  Pipeline stage, it evaluates the status in each divider-th tick and it changes the pattern of the led on change.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    void CStatusIndicator::process(uint32_t f_timestamp)
+    {
+        if (++m_tick < s_divider)
+        {
+            return;
+        }
+        m_tick = 0;
+        if (m_faultEvent)
+        {
+            m_faultEvent = false;
+            m_faultUntil = f_timestamp + m_hold;
+            m_faultHeld = true;
+        }
+        uint32_t l_overloads = m_overloads ? m_overloads() : 0;
+        if (l_overloads != m_prevOverloads)
+        {
+            m_prevOverloads = l_overloads;
+            m_overloadUntil = f_timestamp + m_hold;
+            m_overloadHeld = true;
+        }
+        // The hold times are compared by the signed difference, so the wrap of the timestamp doesn't matter
+        m_faultHeld = m_faultHeld && static_cast<int32_t>(f_timestamp - m_faultUntil) < 0;
+        m_overloadHeld = m_overloadHeld && static_cast<int32_t>(f_timestamp - m_overloadUntil) < 0;
+
+        EStatus l_status = STATUS_OK;
+        if (m_faultHeld || (m_fault && m_fault()))
+        {
+            l_status = STATUS_FAULT;
+        }
+        else if (m_overloadHeld)
+        {
+            l_status = STATUS_OVERLOAD;
+        }
+        else if (static_cast<int32_t>(f_timestamp - m_robot.getLastCommandTime()) > static_cast<int32_t>(m_linkTimeout) || 0 == m_robot.getLastCommandTime())
+        {
+            l_status = STATUS_LINK;
+        }
+        if (l_status != m_status)
+        {
+            m_status = l_status;
+            m_led.setPattern(STATUS_FAULT == l_status ? s_faultPattern : hardware::drivers::CStatusLed_TIM1::flashes(l_status));
+        }
+    }
+
+}; // namespace brain
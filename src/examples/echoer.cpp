@@ -30,9 +30,9 @@ namespace examples{
      *  Constructor method
      *
      *  \param f_period       echoer execution period
-     *  \param f_serialPort   Serial communication object
+     *  \param f_serialPort   Serial transmitter object
      */
-    CEchoer::CEchoer(uint32_t f_period, Serial& f_serialPort) 
+    CEchoer::CEchoer(uint32_t f_period, utils::serial::CSerialTransmitter& f_serialPort) 
         : utils::task::CTask(f_period)
         , m_serialPort(f_serialPort)
     {
@@ -43,7 +43,7 @@ namespace examples{
      */
     void CEchoer::_run()
     {
-        m_serialPort.printf(".\n\r");
+        m_serialPort.printf(utils::serial::CSerialTransmitter::LANE_DEBUG,".\n\r");
     }
 
 }; // namespace examples
\ No newline at end of file
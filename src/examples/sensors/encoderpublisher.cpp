@@ -23,6 +23,7 @@ limitations under the License.
   ******************************************************************************
  */
 #include <examples/sensors/encoderpublisher.hpp>
+#include <utils/fmt/format.hpp>
 
 namespace examples
 {
@@ -35,15 +36,17 @@ namespace examples
          *
          *  @param f_period       period value
          *  @param f_encoder      reference to encoder object
-         *  @param f_serial       reference to the serial object
+         *  @param f_serial       reference to the serial transmitter
          */
         CEncoderPublisher::CEncoderPublisher(uint32_t            f_period
                                                 ,hardware::encoders::IEncoderGetter&     f_encoder
-                                                ,Serial&             f_serial)
+                                                ,utils::serial::CSerialTransmitter&             f_serial)
             :utils::task::CTask(f_period)
             ,m_isActive(false)
+            ,m_isBinary(false)
             ,m_encoder(f_encoder)
             ,m_serial(f_serial)
+            ,m_handoff(NULL)
         {
         }
 
@@ -61,19 +64,55 @@ namespace examples
             uint32_t l_res = sscanf(a,"%d",&l_isActivate);
             if(l_res==1){
                 m_isActive=(l_isActivate>=1);
+                m_isBinary=false;
                 sprintf(b,"ack;;");
             }else{
                 sprintf(b,"sintax error;;");
             }
         }
 
+        /** \brief  Binary callback method to activate or deactivate the publisher. 
+         * After the activation the values are published in binary frames (utils::serial::BIN_ENCODER_SPEED).
+         *
+         * @param f_payload           received payload
+         * @return                    status code of the response
+         */
+        uint8_t CEncoderPublisher::binaryCallback(const utils::serial::SActivationPayload& f_payload){
+            m_isActive=(f_payload.m_activate!=0);
+            m_isBinary=true;
+            return utils::serial::BIN_ACK;
+        }
+
         /** \brief It's periodically applied method to send message to other device. 
+         * 
+         * With the handoff all passed blocks are released, the last one is published, the run without new block doesn't publish.
          */
         void CEncoderPublisher::_run()
         {
+            float l_rps=0.0f;
+            if(m_handoff!=NULL){
+                bool l_hasSample=false;
+                for(hardware::sampling::SSampleBlock* l_block=m_handoff->receive(); l_block!=NULL; l_block=m_handoff->receive()){
+                    l_rps=l_block->m_speedRps;
+                    l_hasSample=true;
+                    m_handoff->release(l_block);
+                }
+                if(!l_hasSample) return;
+            }else{
+                l_rps=m_encoder.getSpeedRps();
+            }
             if(!m_isActive) return;
-            float l_rps=m_encoder.getSpeedRps();
-            m_serial.printf("@ENPB:%.2f;;\r\n",l_rps);  
+            if(m_isBinary){
+                utils::serial::SEncoderSpeedPayload l_payload = {l_rps};
+                uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+                uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_ENCODER_SPEED, &l_payload, sizeof(l_payload), l_frame);
+                m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+            }else{
+                char l_text[utils::serial::CSerialTransmitter::s_maxMessageLength];
+                utils::fmt::CWriter l_writer(l_text);
+                l_writer.text("@ENPB:").fixed(l_rps,2).text(";\r\n");
+                m_serial.write(l_writer.data(), l_writer.length(), utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+            }
         }                        
 
     }; // namespace sensors
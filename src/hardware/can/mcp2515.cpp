@@ -0,0 +1,456 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    Mcp2515.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the driver of the 
+  *          MCP2515 CAN controller.
+  ******************************************************************************
+ */
+#include <hardware/can/mcp2515.hpp>
+
+namespace hardware::can{
+
+    /** @brief  SPI instructions */
+    enum EInstruction{
+        INS_WRITE       = 0x02,
+        INS_READ        = 0x03,
+        INS_MODIFY      = 0x05,
+        INS_LOAD_TX     = 0x40,
+        INS_RTS         = 0x80,
+        INS_READ_RX     = 0x90,
+        INS_STATUS      = 0xA0,
+        INS_RESET       = 0xC0
+    };
+
+    /** @brief  Registers of the controller */
+    enum ERegister{
+        REG_CANSTAT     = 0x0E,
+        REG_CANCTRL     = 0x0F,
+        REG_TEC         = 0x1C,
+        REG_REC         = 0x1D,
+        REG_RXM0SIDH    = 0x20,
+        REG_CNF3        = 0x28,
+        REG_CNF2        = 0x29,
+        REG_CNF1        = 0x2A,
+        REG_CANINTE     = 0x2B,
+        REG_CANINTF     = 0x2C,
+        REG_EFLG        = 0x2D,
+        REG_TXB0CTRL    = 0x30,
+        REG_RXB0CTRL    = 0x60,
+        REG_RXB1CTRL    = 0x70
+    };
+
+    /** @brief  Addresses of the filter registers, they aren't contiguous */
+    static const uint8_t s_filterAddresses[CMcp2515::s_filterCount] = {0x00, 0x04, 0x08, 0x10, 0x14, 0x18};
+    /** @brief  Mode bits of the control and status registers */
+    static const uint8_t s_modeMask = 0xE0;
+    /** @brief  Configuration mode */
+    static const uint8_t s_configMode = 0x80;
+    /** @brief  Receive buffer flags of the interrupt and status registers */
+    static const uint8_t s_receiveFlags = 0x03;
+    /** @brief  Transmit buffer flags of the interrupt register */
+    static const uint8_t s_transmitFlags = 0x1C;
+    /** @brief  Error flags of the interrupt register (error and message error) */
+    static const uint8_t s_errorFlags = 0xA0;
+    /** @brief  Overflow flags of the error register */
+    static const uint8_t s_overflowFlags = 0xC0;
+    /** @brief  Bus-off flag of the error register */
+    static const uint8_t s_busOffFlag = 0x20;
+    /** @brief  Extended identifier bit of the identifier registers */
+    static const uint8_t s_extendedFlag = 0x08;
+    /** @brief  Remote request bit of the length register */
+    static const uint8_t s_remoteFlag = 0x40;
+    /** @brief  Enabled interrupts: received frames, freed transmit buffers and errors */
+    static const uint8_t s_interrupts = 0x3F;
+
+    /** \brief  CMcp2515 class constructor
+     *
+     *  @param f_bus           SPI interface of the controller
+     *  @param f_chipSelect    pin of the chip select
+     *  @param f_interrupt     pin of the interrupt output
+     */
+    CMcp2515::CMcp2515(SPI& f_bus, PinName f_chipSelect, PinName f_interrupt)
+        : m_bus(f_bus)
+        , m_chipSelect(f_chipSelect, 1)
+        , m_interrupt(f_interrupt)
+        , m_masks()
+        , m_filters()
+        , m_overflows(0)
+    {
+        m_interrupt.mode(PullUp);
+    }
+
+    /** \brief  Set an acceptance mask, it's applied by the next start.
+     *
+     *  The first mask belongs to the first receive buffer (filters 0 and 1), the second one to the second buffer (filters 2..5). 
+     *  The set bits of the mask are compared with the filters.
+     *
+     *  @param f_index         index of the mask
+     *  @param f_mask          mask of the identifiers
+     *  @param f_extended      the mask is applied on the 29-bit identifiers
+     */
+    void CMcp2515::setMask(uint8_t f_index, uint32_t f_mask, bool f_extended)
+    {
+        if (f_index < s_maskCount)
+        {
+            encodeId(f_mask, f_extended, m_masks[f_index]);
+        }
+    }
+
+    /** \brief  Set an acceptance filter, it's applied by the next start.
+     *
+     *  @param f_index         index of the filter
+     *  @param f_id            identifier of the accepted frames
+     *  @param f_extended      the filter accepts the extended frames instead of the standard ones
+     */
+    void CMcp2515::setFilter(uint8_t f_index, uint32_t f_id, bool f_extended)
+    {
+        if (f_index < s_filterCount)
+        {
+            encodeId(f_id, f_extended, m_filters[f_index]);
+        }
+    }
+
+    /** \brief  Reset and configure the controller
+     *
+     *  It sets the bit timing, the masks and the filters in the configuration mode, it enables the rollover of the receive buffers 
+     *  and the interrupts, then it requests the operation mode.
+     *
+     *  @param f_bitrate       bit rate of the bus in bit per second
+     *  @param f_oscillator    frequency of the oscillator of the controller in hertz
+     *  @param f_mode          operation mode
+     *  @return                true, when the controller answered and the bit rate can be realized
+     */
+    bool CMcp2515::start(uint32_t f_bitrate, uint32_t f_oscillator, EMode f_mode)
+    {
+        m_bus.format(8, 0);
+        m_bus.frequency(10000000);
+        reset();
+        if ((readRegister(REG_CANSTAT) & s_modeMask) != s_configMode || !setBitTiming(f_bitrate, f_oscillator))
+        {
+            return false;
+        }
+        for (uint8_t l_idx = 0; l_idx < s_maskCount; l_idx++)
+        {
+            writeRegisters(REG_RXM0SIDH + 4 * l_idx, m_masks[l_idx], 4);
+        }
+        for (uint8_t l_idx = 0; l_idx < s_filterCount; l_idx++)
+        {
+            writeRegisters(s_filterAddresses[l_idx], m_filters[l_idx], 4);
+        }
+        /// Filters on, rollover from the first buffer to the second one
+        writeRegister(REG_RXB0CTRL, 0x04);
+        writeRegister(REG_RXB1CTRL, 0x00);
+        writeRegister(REG_CANINTF, 0x00);
+        writeRegister(REG_CANINTE, s_interrupts);
+        return setMode(f_mode);
+    }
+
+    /** \brief  Load the frame in a free transmit buffer and request its transmission
+     *
+     *  @param f_frame         frame
+     *  @return                false, when all transmit buffers are busy
+     */
+    bool CMcp2515::send(const utils::can::SCanFrame& f_frame)
+    {
+        uint8_t l_status = readStatus();
+        for (uint8_t l_idx = 0; l_idx < s_mailboxCount; l_idx++)
+        {
+            // The transmit request bits of the buffers are the bits 2, 4 and 6 of the status
+            if ((l_status & (0x04 << (2 * l_idx))) != 0)
+            {
+                continue;
+            }
+            uint8_t l_priority = 3 - ((f_frame.m_extended ? (f_frame.m_id >> 27) : (f_frame.m_id >> 9)) & 0x03);
+            writeRegister(REG_TXB0CTRL + 0x10 * l_idx, l_priority);
+            uint8_t l_length = (f_frame.m_length > 8) ? 8 : f_frame.m_length;
+            uint8_t l_buffer[13];
+            encodeId(f_frame.m_id, f_frame.m_extended, l_buffer);
+            l_buffer[4] = l_length | (f_frame.m_remote ? s_remoteFlag : 0);
+            memcpy(l_buffer + 5, f_frame.m_data, l_length);
+            m_chipSelect = 0;
+            m_bus.write(INS_LOAD_TX | (2 * l_idx));
+            for (uint8_t l_byte = 0; l_byte < 5 + l_length; l_byte++)
+            {
+                m_bus.write(l_buffer[l_byte]);
+            }
+            m_chipSelect = 1;
+            m_chipSelect = 0;
+            m_bus.write(INS_RTS | (1 << l_idx));
+            m_chipSelect = 1;
+            return true;
+        }
+        return false;
+    }
+
+    /** \brief  Read a received frame
+     *
+     *  The first buffer holds the older frame after a rollover, so it's read first. The reading instruction clears the flag of the buffer.
+     *
+     *  @param f_frame         received frame
+     *  @return                false, when both receive buffers are empty
+     */
+    bool CMcp2515::receive(utils::can::SCanFrame& f_frame)
+    {
+        uint8_t l_status = readStatus() & s_receiveFlags;
+        if (l_status == 0)
+        {
+            return false;
+        }
+        uint8_t l_buffer[13];
+        m_chipSelect = 0;
+        m_bus.write(INS_READ_RX | (((l_status & 0x01) != 0) ? 0x00 : 0x04));
+        for (uint8_t l_byte = 0; l_byte < sizeof(l_buffer); l_byte++)
+        {
+            l_buffer[l_byte] = m_bus.write(0x00);
+        }
+        m_chipSelect = 1;
+        f_frame.m_extended = (l_buffer[1] & s_extendedFlag) != 0;
+        if (f_frame.m_extended)
+        {
+            f_frame.m_id = (static_cast<uint32_t>(l_buffer[0]) << 21) | (static_cast<uint32_t>(l_buffer[1] & 0xE0) << 13) 
+                         | (static_cast<uint32_t>(l_buffer[1] & 0x03) << 16) | (static_cast<uint32_t>(l_buffer[2]) << 8) | l_buffer[3];
+            f_frame.m_remote = (l_buffer[4] & s_remoteFlag) != 0;
+        }
+        else
+        {
+            f_frame.m_id = (static_cast<uint32_t>(l_buffer[0]) << 3) | (l_buffer[1] >> 5);
+            f_frame.m_remote = (l_buffer[1] & 0x10) != 0;
+        }
+        f_frame.m_length = l_buffer[4] & 0x0F;
+        if (f_frame.m_length > 8)
+        {
+            f_frame.m_length = 8;
+        }
+        memcpy(f_frame.m_data, l_buffer + 5, f_frame.m_length);
+        return true;
+    }
+
+    /** \brief  Clear the transmit and error flags of the interrupt
+     *
+     *  The flags of the receive buffers are cleared by their reading. The overflows of the receive buffers are counted.
+     *
+     *  @return                events of the interrupt (utils::can::ECanEvent)
+     */
+    uint32_t CMcp2515::acknowledge()
+    {
+        uint8_t l_flags = readRegister(REG_CANINTF) & static_cast<uint8_t>(~s_receiveFlags);
+        uint32_t l_events = 0;
+        if ((l_flags & s_transmitFlags) != 0)
+        {
+            l_events |= utils::can::CAN_TRANSMITTED;
+        }
+        if ((l_flags & s_errorFlags) != 0)
+        {
+            l_events |= utils::can::CAN_ERROR;
+            uint8_t l_errors = readRegister(REG_EFLG);
+            if ((l_errors & s_overflowFlags) != 0)
+            {
+                m_overflows += ((l_errors & 0x80) != 0) + ((l_errors & 0x40) != 0);
+                modifyRegister(REG_EFLG, s_overflowFlags, 0x00);
+            }
+        }
+        if (l_flags != 0)
+        {
+            modifyRegister(REG_CANINTF, l_flags, 0x00);
+        }
+        return l_events;
+    }
+
+    /** \brief  Read the error state
+     *
+     *  @param f_errors        error counters and bus-off state
+     */
+    void CMcp2515::getErrors(utils::can::SCanErrors& f_errors)
+    {
+        f_errors.m_transmit = readRegister(REG_TEC);
+        f_errors.m_receive = readRegister(REG_REC);
+        f_errors.m_busOff = (readRegister(REG_EFLG) & s_busOffFlag) != 0;
+        f_errors.m_overflows = m_overflows;
+    }
+
+    /** \brief  Attach the callback of the interrupt, it's applied from the falling edge of the interrupt output in interrupt context.
+     *
+     *  @param f_callback      callback function
+     */
+    void CMcp2515::attach(mbed::Callback<void()> f_callback)
+    {
+        m_interrupt.fall(f_callback);
+    }
+
+    /** \brief  Reset the controller, it enters in the configuration mode after the start of its oscillator.
+     */
+    void CMcp2515::reset()
+    {
+        m_chipSelect = 0;
+        m_bus.write(INS_RESET);
+        m_chipSelect = 1;
+        wait_us(100);
+    }
+
+    /** \brief  Read a register
+     *
+     *  @param f_address       address of the register
+     *  @return                value of the register
+     */
+    uint8_t CMcp2515::readRegister(uint8_t f_address)
+    {
+        m_chipSelect = 0;
+        m_bus.write(INS_READ);
+        m_bus.write(f_address);
+        uint8_t l_value = m_bus.write(0x00);
+        m_chipSelect = 1;
+        return l_value;
+    }
+
+    /** \brief  Write consecutive registers in a single transfer
+     *
+     *  @param f_address       address of the first register
+     *  @param f_values        values of the registers
+     *  @param f_length        number of the registers
+     */
+    void CMcp2515::writeRegisters(uint8_t f_address, const uint8_t* f_values, uint8_t f_length)
+    {
+        m_chipSelect = 0;
+        m_bus.write(INS_WRITE);
+        m_bus.write(f_address);
+        for (uint8_t l_idx = 0; l_idx < f_length; l_idx++)
+        {
+            m_bus.write(f_values[l_idx]);
+        }
+        m_chipSelect = 1;
+    }
+
+    /** \brief  Write a register
+     *
+     *  @param f_address       address of the register
+     *  @param f_value         value of the register
+     */
+    void CMcp2515::writeRegister(uint8_t f_address, uint8_t f_value)
+    {
+        writeRegisters(f_address, &f_value, 1);
+    }
+
+    /** \brief  Modify the masked bits of a register, only the control, the interrupt and the error registers support it.
+     *
+     *  @param f_address       address of the register
+     *  @param f_mask          mask of the modified bits
+     *  @param f_value         new value of the masked bits
+     */
+    void CMcp2515::modifyRegister(uint8_t f_address, uint8_t f_mask, uint8_t f_value)
+    {
+        m_chipSelect = 0;
+        m_bus.write(INS_MODIFY);
+        m_bus.write(f_address);
+        m_bus.write(f_mask);
+        m_bus.write(f_value);
+        m_chipSelect = 1;
+    }
+
+    /** \brief  Read the status of the buffers: receive flags (bits 0, 1), transmit requests and flags (bits 2..7).
+     *
+     *  @return                status byte
+     */
+    uint8_t CMcp2515::readStatus()
+    {
+        m_chipSelect = 0;
+        m_bus.write(INS_STATUS);
+        uint8_t l_status = m_bus.write(0x00);
+        m_chipSelect = 1;
+        return l_status;
+    }
+
+    /** \brief  Set the operation mode, it waits for the acknowledgment of the controller.
+     *
+     *  @param f_mode          mode bits
+     *  @return                true, when the controller entered the mode
+     */
+    bool CMcp2515::setMode(uint8_t f_mode)
+    {
+        modifyRegister(REG_CANCTRL, s_modeMask, f_mode);
+        for (uint32_t l_try = 0; l_try < 100; l_try++)
+        {
+            if ((readRegister(REG_CANSTAT) & s_modeMask) == f_mode)
+            {
+                return true;
+            }
+            wait_us(10);
+        }
+        return false;
+    }
+
+    /** \brief  Encode an identifier in the identifier registers (SIDH, SIDL, EID8, EID0)
+     *
+     *  @param f_id            identifier
+     *  @param f_extended      29-bit identifier
+     *  @param f_registers     four registers
+     */
+    void CMcp2515::encodeId(uint32_t f_id, bool f_extended, uint8_t* f_registers)
+    {
+        if (f_extended)
+        {
+            f_registers[0] = static_cast<uint8_t>(f_id >> 21);
+            f_registers[1] = static_cast<uint8_t>(((f_id >> 13) & 0xE0) | s_extendedFlag | ((f_id >> 16) & 0x03));
+            f_registers[2] = static_cast<uint8_t>(f_id >> 8);
+            f_registers[3] = static_cast<uint8_t>(f_id);
+        }
+        else
+        {
+            f_registers[0] = static_cast<uint8_t>(f_id >> 3);
+            f_registers[1] = static_cast<uint8_t>((f_id & 0x07) << 5);
+            f_registers[2] = 0;
+            f_registers[3] = 0;
+        }
+    }
+
+    /** \brief  Set the bit timing
+     *
+     *  The most time quanta (16..8) are selected, which divide the oscillator exactly, the sample point is at about 75 % of the bit 
+     *  and the synchronization jump width is one quantum.
+     *
+     *  @param f_bitrate       bit rate in bit per second
+     *  @param f_oscillator    frequency of the oscillator in hertz
+     *  @return                false, when the bit rate can't be realized exactly
+     */
+    bool CMcp2515::setBitTiming(uint32_t f_bitrate, uint32_t f_oscillator)
+    {
+        if (f_bitrate == 0)
+        {
+            return false;
+        }
+        for (uint32_t l_quanta = 16; l_quanta >= 8; l_quanta--)
+        {
+            uint32_t l_divider = 2 * l_quanta * f_bitrate;
+            if (f_oscillator % l_divider != 0 || f_oscillator / l_divider > 64)
+            {
+                continue;
+            }
+            uint8_t l_prescaler = f_oscillator / l_divider - 1;
+            uint8_t l_phase2 = l_quanta / 4;
+            uint8_t l_propagation = (l_quanta - 1 - l_phase2) / 2;
+            uint8_t l_phase1 = l_quanta - 1 - l_phase2 - l_propagation;
+            writeRegister(REG_CNF1, l_prescaler);
+            writeRegister(REG_CNF2, 0x80 | ((l_phase1 - 1) << 3) | (l_propagation - 1));
+            writeRegister(REG_CNF3, l_phase2 - 1);
+            return true;
+        }
+        return false;
+    }
+
+}; // namespace hardware::can
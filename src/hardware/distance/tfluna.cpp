@@ -0,0 +1,126 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    TfLuna.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the time-of-flight distance sensor on the I2C bus.
+  ******************************************************************************
+ */
+
+#include <hardware/distance/tfluna.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace hardware::distance{
+
+    /** \brief  CTfLuna class constructor
+     *
+     *  @param f_period        period of the readings in base ticks
+     *  @param f_bus           transaction queue of the I2C bus
+     *  @param f_output        published measurement
+     *  @param f_address       7-bit address of the sensor
+     */
+    CTfLuna::CTfLuna(uint32_t                                f_period
+                    ,hardware::drivers::CI2cBus_I2C1&        f_bus
+                    ,CDistanceSnapshot&                      f_output
+                    ,uint8_t                                 f_address)
+        : utils::task::CTask(f_period)
+        , m_bus(f_bus)
+        , m_output(f_output)
+        , m_address(f_address)
+        , m_buffer()
+        , m_pending(false)
+        , m_pendingPeriods(0)
+        , m_amplitude(0)
+        , m_count(0)
+        , m_errors(0)
+    {
+    }
+
+    /** \brief  Run method, it submits the burst reading. A transfer of the sensor, which didn't finish in some periods, is cancelled
+     *  in the queue or aborted on the bus.
+     */
+    void CTfLuna::_run()
+    {
+        if (m_pending)
+        {
+            if (++m_pendingPeriods >= s_stuckPeriods)
+            {
+                // The callback mustn't finish between the check and the abort
+                core_util_critical_section_enter();
+                if (m_pending)
+                {
+                    m_bus.cancel(this);
+                    m_errors++;
+                    m_pending = false;
+                }
+                core_util_critical_section_exit();
+            }
+            return;
+        }
+        m_pending = true;
+        m_pendingPeriods = 0;
+        if (!m_bus.read(this, hardware::drivers::CI2cBus_I2C1::PRIORITY_NORMAL, m_address, REG_DIST_LOW, m_buffer, s_frameSize, mbed::callback(this,&CTfLuna::readCallback)))
+        {
+            // The queue of the bus is full
+            m_pending = false;
+            m_errors++;
+        }
+    }
+
+    /** \brief  Callback of the burst reading, it decodes the distance in centimeter and the signal strength, then it publishes them.
+     *
+     *  @param f_success       the transfer succeeded
+     */
+    void CTfLuna::readCallback(bool f_success)
+    {
+        SDistance l_distance;
+        l_distance.m_timestamp = us_ticker_read();                    // The transfer can wait in the queue, it's stamped at its end
+        l_distance.m_distance = 0.0f;
+        l_distance.m_status = DISTANCE_ERROR;
+        if (f_success)
+        {
+            uint16_t l_centimeter = static_cast<uint16_t>(m_buffer[0] | (m_buffer[1] << 8));
+            m_amplitude = static_cast<uint16_t>(m_buffer[2] | (m_buffer[3] << 8));
+            l_distance.m_distance = 0.01f * l_centimeter;
+            if (m_amplitude >= s_minAmplitude && m_amplitude != s_saturated)
+            {
+                l_distance.m_status = DISTANCE_VALID;
+            }
+        }
+        else
+        {
+            m_errors++;
+        }
+        m_output.write(l_distance);
+        m_count++;
+        m_pending = false;
+    }
+
+    /** \brief  Serial callback, the response contains the status and the distance of the latest measurement, the signal strength,
+     *  the number of the measurements and of the failed transfers.
+     *
+     *  @param a               string to read data from
+     *  @param b               string to write data to
+     */
+    void CTfLuna::serialCallback(char const * a, char * b)
+    {
+        SDistance l_distance = m_output.read();
+        utils::fmt::CWriter(b).udec(l_distance.m_status).fixed(l_distance.m_distance, 3).udec(m_amplitude).udec(m_count).udec(m_errors).chr(';');
+    }
+
+}; // namespace hardware::distance
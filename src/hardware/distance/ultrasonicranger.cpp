@@ -0,0 +1,144 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    UltrasonicRanger.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the ultrasonic distance sensor.
+  ******************************************************************************
+ */
+
+#include <hardware/distance/ultrasonicranger.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace hardware::distance{
+
+    /** \brief  CUltrasonicRanger class constructor
+     *
+     *  @param f_period        period of the polling task in base ticks
+     *  @param f_capture       capture of the echo pulse
+     *  @param f_trigger       pin of the trigger input of the sensor
+     *  @param f_output        published measurement
+     *  @param f_range         range of the sensor in meter, a farther obstacle is reported as no echo
+     *  @param f_cycle_sec     period of the measurement cycles in second
+     */
+    CUltrasonicRanger::CUltrasonicRanger(uint32_t                              f_period
+                                        ,hardware::drivers::CEchoCapture_TIM3& f_capture
+                                        ,PinName                               f_trigger
+                                        ,CDistanceSnapshot&                    f_output
+                                        ,float                                 f_range
+                                        ,float                                 f_cycle_sec)
+        : utils::task::CTask(f_period)
+        , m_capture(f_capture)
+        , m_trigger(f_trigger, 0)
+        , m_output(f_output)
+        , m_range(f_range)
+        , m_cycle(static_cast<uint32_t>(f_cycle_sec * 1e6f))
+        , m_triggerTime(0)
+        , m_waiting(false)
+        , m_count(0)
+        , m_misses(0)
+    {
+    }
+
+    /** \brief  Publish a measurement
+     *
+     *  @param f_timestamp     time of the trigger in microsecond
+     *  @param f_distance      distance in meter
+     *  @param f_status        status of the measurement
+     */
+    void CUltrasonicRanger::publish(uint32_t f_timestamp, float f_distance, EDistanceStatus f_status)
+    {
+        SDistance l_distance;
+        l_distance.m_timestamp = f_timestamp;
+        l_distance.m_distance = f_distance;
+        l_distance.m_status = static_cast<uint8_t>(f_status);
+        m_output.write(l_distance);
+        m_count++;
+    }
+
+    /** \brief  Run method, it evaluates the captured echo of the last trigger and it starts the next cycle.
+     *
+     *  The width is captured modulo the period of the timer. The time elapsed from the trigger until this poll is the delay before
+     *  the echo, the whole width and the latency of the poll, so the whole periods of the width are the elapsed ticks after the
+     *  captured part divided by the period, while the delay and the latency are shorter than a period. Without edge in the timeout
+     *  the sensor doesn't answer, with a single edge the echo is longer than the timeout.
+     */
+    void CUltrasonicRanger::_run()
+    {
+        if (!m_capture.isStarted())
+        {
+            return;
+        }
+        uint32_t l_now = us_ticker_read();
+        if (m_waiting)
+        {
+            uint32_t l_elapsed = l_now - m_triggerTime;
+            uint32_t l_ticks;
+            if (m_capture.read(l_ticks))
+            {
+                uint32_t l_frequency = hardware::drivers::CEchoCapture_TIM3::getFrequency();
+                uint32_t l_period = hardware::drivers::CEchoCapture_TIM3::getPeriodTicks();
+                uint32_t l_elapsedTicks = static_cast<uint32_t>(static_cast<uint64_t>(l_elapsed) * l_frequency / 1000000U);
+                uint32_t l_whole = (l_elapsedTicks > l_ticks) ? (l_elapsedTicks - l_ticks) / l_period : 0;
+                float l_distance = 0.5f * s_soundSpeed * (l_ticks + l_whole * l_period) / l_frequency;
+                if (l_distance > m_range)
+                {
+                    publish(m_triggerTime, m_range, DISTANCE_NO_ECHO);
+                }
+                else
+                {
+                    publish(m_triggerTime, l_distance, DISTANCE_VALID);
+                }
+                m_waiting = false;
+            }
+            else if (l_elapsed > s_echoTimeout)
+            {
+                m_misses++;
+                publish(m_triggerTime, m_range, (0 == m_capture.getEdges()) ? DISTANCE_ERROR : DISTANCE_NO_ECHO);
+                m_waiting = false;
+            }
+            else
+            {
+                return;
+            }
+        }
+        if (l_now - m_triggerTime < m_cycle)
+        {
+            return;
+        }
+        m_capture.arm();
+        m_trigger = 1;
+        wait_us(10);
+        m_trigger = 0;
+        m_triggerTime = us_ticker_read();
+        m_waiting = true;
+    }
+
+    /** \brief  Serial callback, the response contains the status and the distance of the latest measurement, the number of the
+     *  measurements and of the cycles without echo.
+     *
+     *  @param a               string to read data from
+     *  @param b               string to write data to
+     */
+    void CUltrasonicRanger::serialCallback(char const * a, char * b)
+    {
+        SDistance l_distance = m_output.read();
+        utils::fmt::CWriter(b).udec(l_distance.m_status).fixed(l_distance.m_distance, 3).udec(m_count).udec(m_misses).chr(';');
+    }
+
+}; // namespace hardware::distance
@@ -0,0 +1,339 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    ActuatorGroup.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the synchronized group of the motor bridges.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/actuatorgroup.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace hardware::drivers{
+
+    CActuatorGroup_TIM2* CActuatorGroup_TIM2::s_instance = NULL;
+
+    /** \brief  Set the steering angle, the servo gets it first, then the differential of the group is updated.
+     *
+     *  @param f_angle         steering angle in degree, positive to right
+     */
+    void CActuatorGroup_TIM2::CSteeringTap::setAngle(float f_angle)
+    {
+        m_servo.setAngle(f_angle);
+        m_group.setAngle(f_angle);
+    }
+
+    /** \brief  CActuatorGroup_TIM2 class constructor
+     *
+     *  @param f_servo         steering servo
+     *  @param f_geometry      steering geometry
+     *  @param f_infLimit      lower limit of the command
+     *  @param f_supLimit      upper limit of the command
+     */
+    CActuatorGroup_TIM2::CActuatorGroup_TIM2(ISteeringCommand& f_servo, const signal::systemmodels::CSteeringGeometry& f_geometry, float f_infLimit, float f_supLimit)
+        : m_steering(*this, f_servo)
+        , m_geometry(f_geometry)
+        , m_infLimit(f_infLimit)
+        , m_supLimit(f_supLimit)
+        , m_channels()
+        , m_count(0)
+        , m_drive(0.0f)
+        , m_driving(false)
+        , m_pending(false)
+        , m_started(false)
+    {
+    }
+
+    /** \brief  Add a bridge to the group, it has to be applied before the start.
+     *
+     *  @param f_pwm           pwm output of the bridge, it has to be generated by the TIM2
+     *  @param f_ina           direction pin A
+     *  @param f_inb           direction pin B
+     *  @param f_x             longitudinal position of the wheel from the rear axle (m)
+     *  @param f_y             lateral position of the wheel, positive to left (m)
+     *  @return                false, when the group is full
+     */
+    bool CActuatorGroup_TIM2::addChannel(CFastPwmOut& f_pwm, CFastDigitalOut& f_ina, CFastDigitalOut& f_inb, float f_x, float f_y)
+    {
+        if (m_count >= s_maxChannels || m_started)
+        {
+            return false;
+        }
+        SChannel& l_channel = m_channels[m_count++];
+        l_channel.m_pwm = &f_pwm;
+        l_channel.m_ina = &f_ina;
+        l_channel.m_inb = &f_inb;
+        l_channel.m_x = f_x;
+        l_channel.m_y = f_y;
+        l_channel.m_ratio = 1.0f;
+        l_channel.m_duty = 0.0f;
+        l_channel.m_frameA = false;
+        l_channel.m_frameB = false;
+        l_channel.m_stateA = f_ina.read();
+        l_channel.m_stateB = f_inb.read();
+        return true;
+    }
+
+    /** \brief  Start the synchronized update
+     *
+     *  It enables the preload of each channel and it installs the update interrupt of the TIM2.
+     *
+     *  @return                true, when all channels are generated by the TIM2
+     */
+    bool CActuatorGroup_TIM2::start()
+    {
+        if (m_count == 0)
+        {
+            return false;
+        }
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            if (m_channels[i].m_pwm->getTimer() != TIM2)
+            {
+                return false;
+            }
+        }
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            m_channels[i].m_stateA = m_channels[i].m_ina->read();
+            m_channels[i].m_stateB = m_channels[i].m_inb->read();
+            m_channels[i].m_pwm->setPreload(true);
+        }
+        m_pending = false;
+        s_instance = this;
+        TIM2->DIER &= ~TIM_DIER_UIE;
+        TIM2->SR = ~TIM_SR_UIF;
+        NVIC_SetVector(TIM2_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CActuatorGroup_TIM2::timerIrqHandler)));
+        NVIC_EnableIRQ(TIM2_IRQn);
+        m_started = true;
+        return true;
+    }
+
+    /** \brief  Stop the synchronized update, the pending frame is applied immediately.
+     */
+    void CActuatorGroup_TIM2::stop()
+    {
+        if (!m_started)
+        {
+            return;
+        }
+        NVIC_DisableIRQ(TIM2_IRQn);
+        TIM2->DIER &= ~TIM_DIER_UIE;
+        if (m_pending)
+        {
+            apply();
+        }
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            m_channels[i].m_pwm->setPreload(false);
+        }
+        m_started = false;
+    }
+
+    /** \brief  Drive the wheels, the command is multiplied by the speed ratio of each wheel and limited to the full duty cycle.
+     *
+     *  @param f_pwm           command of the reference point, positive forward
+     */
+    CONTROL_RAMFUNC void CActuatorGroup_TIM2::setSpeed(float f_pwm)
+    {
+        m_drive = f_pwm;
+        m_driving = true;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            SChannel& l_channel = m_channels[i];
+            float l_duty = std::abs(f_pwm) * l_channel.m_ratio;
+            l_channel.m_duty = (l_duty < 1.0f) ? l_duty : 1.0f;
+            l_channel.m_frameA = f_pwm >= 0;
+            l_channel.m_frameB = f_pwm < 0;
+        }
+        commit();
+    }
+
+    /** \brief  Brake all wheels with the full dynamic braking.
+     */
+    void CActuatorGroup_TIM2::brake()
+    {
+        dynamicBrake(1.0f);
+    }
+
+    /** \brief  Inverse the direction of each wheel with the new command, the direction of the frame is inverted.
+     *
+     *  @param f_pwm           command of the reference point
+     */
+    void CActuatorGroup_TIM2::inverseDirection(float f_pwm)
+    {
+        m_driving = false;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            SChannel& l_channel = m_channels[i];
+            float l_duty = std::abs(f_pwm) * l_channel.m_ratio;
+            l_channel.m_duty = (l_duty < 1.0f) ? l_duty : 1.0f;
+            l_channel.m_frameA = !l_channel.m_frameA;
+            l_channel.m_frameB = !l_channel.m_frameB;
+        }
+        commit();
+    }
+
+    /** \brief  It checks whether the command is in the allowed range
+     *
+     *  @param f_pwm           command
+     *  @return                true, when the value is in the range
+     */
+    bool CActuatorGroup_TIM2::inRange(float f_pwm)
+    {
+        return m_infLimit <= f_pwm && f_pwm <= m_supLimit;
+    }
+
+    /** \brief  Switch off the bridges, the wheels freewheel.
+     */
+    void CActuatorGroup_TIM2::coast()
+    {
+        dynamicBrake(0.0f);
+    }
+
+    /** \brief  Proportional dynamic braking of all wheels with the same duty cycle, the differential isn't applied.
+     *
+     *  @param f_duty          duty cycle of the braking in interval [0,1]
+     */
+    CONTROL_RAMFUNC void CActuatorGroup_TIM2::dynamicBrake(float f_duty)
+    {
+        float l_duty = std::abs(f_duty);
+        l_duty = (l_duty < 1.0f) ? l_duty : 1.0f;
+        m_driving = false;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            m_channels[i].m_duty = l_duty;
+            m_channels[i].m_frameA = false;
+            m_channels[i].m_frameB = false;
+        }
+        commit();
+    }
+
+    /** \brief  Set the steering angle of the differential. The curvature of the path is looked up by the steering geometry, the speed
+     *  ratio of a wheel is the distance of the wheel from the center of rotation divided by the distance of the reference point. The
+     *  last drive command is distributed again with the new ratios.
+     *
+     *  @param f_angle         steering angle in degree, positive to right
+     */
+    CONTROL_RAMFUNC void CActuatorGroup_TIM2::setAngle(float f_angle)
+    {
+        float l_curvature = m_geometry.curvature(f_angle);
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            SChannel& l_channel = m_channels[i];
+            float l_lateral = 1.0f - l_curvature * l_channel.m_y;
+            float l_longitudinal = l_curvature * l_channel.m_x;
+            l_channel.m_ratio = sqrtf(l_lateral * l_lateral + l_longitudinal * l_longitudinal);
+        }
+        if (m_driving)
+        {
+            setSpeed(m_drive);
+        }
+    }
+
+    /** \brief  Commit the frame to the outputs
+     *
+     *  Without reversing channel the compare registers are written while the update events are disabled, so the next update event
+     *  loads the complete frame. Otherwise the reversing channels get the zero duty cycle and the frame is left pending for the update
+     *  interrupt, the other channels keep their duty cycle for this period. A new frame overwrites the pending one.
+     */
+    CONTROL_RAMFUNC void CActuatorGroup_TIM2::commit()
+    {
+        if (!m_started)
+        {
+            apply();
+            return;
+        }
+        core_util_critical_section_enter();
+        bool l_reverse = m_pending;
+        for (uint8_t i = 0; i < m_count && !l_reverse; i++)
+        {
+            l_reverse = m_channels[i].m_frameA != m_channels[i].m_stateA || m_channels[i].m_frameB != m_channels[i].m_stateB;
+        }
+        if (l_reverse)
+        {
+            TIM2->CR1 |= TIM_CR1_UDIS;
+            for (uint8_t i = 0; i < m_count; i++)
+            {
+                SChannel& l_channel = m_channels[i];
+                if (l_channel.m_frameA != l_channel.m_stateA || l_channel.m_frameB != l_channel.m_stateB)
+                {
+                    l_channel.m_pwm->writeFast(0.0f);
+                }
+            }
+            TIM2->CR1 &= ~TIM_CR1_UDIS;
+            if (!m_pending)
+            {
+                m_pending = true;
+                TIM2->SR = ~TIM_SR_UIF;       // The zero duty cycles are loaded by the next update event
+                TIM2->DIER |= TIM_DIER_UIE;
+            }
+        }
+        else
+        {
+            TIM2->CR1 |= TIM_CR1_UDIS;
+            for (uint8_t i = 0; i < m_count; i++)
+            {
+                m_channels[i].m_pwm->writeFast(m_channels[i].m_duty);
+            }
+            TIM2->CR1 &= ~TIM_CR1_UDIS;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Apply the frame, the direction pins are changed, then the duty cycles are written while the update events are disabled.
+     */
+    void CActuatorGroup_TIM2::apply()
+    {
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            SChannel& l_channel = m_channels[i];
+            l_channel.m_ina->writeFast(l_channel.m_frameA);
+            l_channel.m_inb->writeFast(l_channel.m_frameB);
+            l_channel.m_stateA = l_channel.m_frameA;
+            l_channel.m_stateB = l_channel.m_frameB;
+        }
+        TIM2->CR1 |= TIM_CR1_UDIS;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            m_channels[i].m_pwm->writeFast(m_channels[i].m_duty);
+        }
+        TIM2->CR1 &= ~TIM_CR1_UDIS;
+        m_pending = false;
+    }
+
+    /** \brief  TIM2 interrupt handler
+     *
+     *  It applies the pending frame after the update event, which loaded the zero duty cycles, then it disables the update interrupt.
+     */
+    void CActuatorGroup_TIM2::timerIrqHandler()
+    {
+        if ((TIM2->SR & TIM_SR_UIF) == 0)
+        {
+            return;
+        }
+        TIM2->SR = ~TIM_SR_UIF;
+        TIM2->DIER &= ~TIM_DIER_UIE;
+        if (s_instance != NULL && s_instance->m_pending)
+        {
+            s_instance->apply();
+        }
+    }
+
+}; // namespace hardware::drivers
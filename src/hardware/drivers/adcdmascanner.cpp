@@ -0,0 +1,259 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    AdcDmaScanner.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the DMA based scan of the analog inputs.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/adcdmascanner.hpp>
+
+namespace hardware::drivers{
+
+    CAdcDmaScanner_ADC1* CAdcDmaScanner_ADC1::s_instance = NULL;
+    uint32_t CAdcDmaScanner_ADC1::s_chainedHandler = 0;
+
+    /** \brief  CAdcDmaScanner_ADC1 class constructor
+     *
+     *  @param f_pins          list of the analog pins in order of conversion
+     *  @param f_count         number of the pins, maximum s_maxChannels
+     */
+    CAdcDmaScanner_ADC1::CAdcDmaScanner_ADC1(const PinName* f_pins, uint8_t f_count)
+        : m_count(f_count < s_maxChannels ? f_count : s_maxChannels)
+        , m_depth(1)
+        , m_isSynchronized(false)
+        , m_watchdogCallback()
+    {
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            m_pins[i] = f_pins[i];
+            m_channels[i] = static_cast<uint8_t>(STM_PIN_CHANNEL(pinmap_function(f_pins[i], PinMap_ADC)));
+        }
+        for (uint32_t i = 0; i < sizeof(m_buffer)/sizeof(m_buffer[0]); i++)
+        {
+            m_buffer[i] = 0;
+        }
+    }
+
+    /** \brief  Select the synchronized mode, it's applied by the next 'start'. The pwm timer TIM2 has to run already.
+     *
+     *  @param f_depth         number of the sequences in the buffer, from 2 to s_maxDepth
+     *  @param f_phase         sampling point as fraction of the pwm period, in interval (0,1)
+     */
+    void CAdcDmaScanner_ADC1::setSynchronized(uint8_t f_depth, float f_phase)
+    {
+        m_depth = (f_depth < 2) ? 2 : ((f_depth > s_maxDepth) ? s_maxDepth : f_depth);
+        m_isSynchronized = true;
+        // Channel 3 of TIM2: pwm mode 1 without output, its compare event is the trigger
+        TIM2->CCER &= ~TIM_CCER_CC3E;
+        TIM2->CCMR2 = (TIM2->CCMR2 & ~(TIM_CCMR2_CC3S | TIM_CCMR2_OC3M)) | TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 | TIM_CCMR2_OC3PE;
+        setPhase(f_phase);
+    }
+
+    /** \brief  Set the sampling point in the pwm period, the new value is applied from the next period
+     *
+     *  @param f_phase         sampling point as fraction of the pwm period, in interval (0,1)
+     */
+    void CAdcDmaScanner_ADC1::setPhase(float f_phase)
+    {
+        TIM2->CCR3 = static_cast<uint32_t>(f_phase * static_cast<float>(TIM2->ARR + 1));
+    }
+
+    /** \brief  Configure the ADC and the DMA
+     *
+     *  The ADC converts the sequence in scan mode, the DMA stream is circular with the length of the sequence, so each sequence 
+     *  is copied to the beginning of the buffer. In the synchronized mode the stream is circular with the length of all sequences 
+     *  of the buffer and the external trigger is enabled.
+     */
+    void CAdcDmaScanner_ADC1::start()
+    {
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            pin_function(m_pins[i], STM_PIN_DATA(STM_MODE_ANALOG, GPIO_NOPULL, 0));
+        }
+        RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+
+        // The injected configuration (CAdcInjected_ADC1) is kept, only the regular sequence is configured
+        uint32_t l_injectedCR1 = ADC1->CR1 & ADC_CR1_JEOCIE;
+        uint32_t l_injectedCR2 = ADC1->CR2 & (ADC_CR2_JEXTEN | ADC_CR2_JEXTSEL);
+        ADC1->CR2 = 0;
+        ADC->CCR = (ADC->CCR & ~ADC_CCR_ADCPRE) | ADC_CCR_ADCPRE_0;     // PCLK2 / 4
+        uint32_t l_watchdogCR1 = ADC1->CR1 & (ADC_CR1_AWDEN | ADC_CR1_AWDSGL | ADC_CR1_AWDCH | ADC_CR1_AWDIE);
+        ADC1->CR1 = ADC_CR1_SCAN | l_injectedCR1 | l_watchdogCR1;       // 12-bit, scan mode
+        ADC1->SQR1 = static_cast<uint32_t>(m_count - 1) << 20;
+        ADC1->SQR2 = 0;
+        ADC1->SQR3 = 0;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            uint8_t l_channel = m_channels[i];
+            if (l_channel < 10)                                         // 56 cycles sampling time
+            {
+                ADC1->SMPR2 = (ADC1->SMPR2 & ~(0x7U << (3 * l_channel))) | (0x3U << (3 * l_channel));
+            }
+            else
+            {
+                ADC1->SMPR1 = (ADC1->SMPR1 & ~(0x7U << (3 * (l_channel - 10)))) | (0x3U << (3 * (l_channel - 10)));
+            }
+            if (i < 6)
+            {
+                ADC1->SQR3 |= static_cast<uint32_t>(l_channel) << (5 * i);
+            }
+            else
+            {
+                ADC1->SQR2 |= static_cast<uint32_t>(l_channel) << (5 * (i - 6));
+            }
+        }
+
+        DMA2_Stream0->CR &= ~DMA_SxCR_EN;
+        while (DMA2_Stream0->CR & DMA_SxCR_EN);
+        DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+        DMA2_Stream0->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&ADC1->DR));
+        DMA2_Stream0->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_buffer));
+        DMA2_Stream0->NDTR = static_cast<uint32_t>(m_count) * m_depth;
+        DMA2_Stream0->FCR = 0;                                          // Direct mode
+        DMA2_Stream0->CR = DMA_SxCR_PL_1                                // High priority, channel 0 (ADC1)
+                         | DMA_SxCR_MSIZE_0                             // Memory half-word
+                         | DMA_SxCR_PSIZE_0                             // Peripheral half-word
+                         | DMA_SxCR_MINC                                // Memory increment
+                         | DMA_SxCR_CIRC;                               // Circular, peripheral to memory
+        DMA2_Stream0->CR |= DMA_SxCR_EN;
+
+        uint32_t l_trigger = m_isSynchronized ? (ADC_CR2_EXTEN_0 | ADC_CR2_EXTSEL_2) : 0;   // Rising edge of TIM2 CC3 event
+        ADC1->CR2 = ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_ADON | l_injectedCR2 | l_trigger;
+    }
+
+    /** \brief  Configure the analog watchdog on a channel of the sequence, the interrupt is enabled by 'armWatchdog'.
+     *
+     *  @param f_index         index of the channel in the sequence
+     *  @param f_high          high threshold of the raw result
+     *  @param f_callback      callback of the watchdog, it's applied from interrupt
+     */
+    void CAdcDmaScanner_ADC1::setWatchdog(uint8_t f_index, uint16_t f_high, mbed::Callback<void()> f_callback)
+    {
+        RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;
+        m_watchdogCallback = f_callback;
+        s_instance = this;
+        ADC1->CR1 &= ~ADC_CR1_AWDIE;
+        ADC1->HTR = f_high;
+        ADC1->LTR = 0;
+        ADC1->CR1 = (ADC1->CR1 & ~ADC_CR1_AWDCH) | ADC_CR1_AWDEN | ADC_CR1_AWDSGL | m_channels[f_index];
+        uint32_t l_handler = NVIC_GetVector(ADC_IRQn);
+        if (l_handler != static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CAdcDmaScanner_ADC1::adcIrqHandler)))
+        {
+            s_chainedHandler = l_handler;
+        }
+        NVIC_SetVector(ADC_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CAdcDmaScanner_ADC1::adcIrqHandler)));
+        NVIC_SetPriority(ADC_IRQn, 0);
+        NVIC_EnableIRQ(ADC_IRQn);
+    }
+
+    /** \brief  Enable the interrupt of the analog watchdog, the flag of the previous events is cleared.
+     */
+    void CAdcDmaScanner_ADC1::armWatchdog()
+    {
+        ADC1->SR = ~ADC_SR_AWD;
+        ADC1->CR1 |= ADC_CR1_AWDIE;
+    }
+
+    /** \brief  Raw 12-bit result of a channel of the last sequence, in the synchronized mode the last complete sequence of the buffer
+     *
+     *  @param f_index         index of the channel in the sequence
+     *  @return                raw result
+     */
+    uint16_t CAdcDmaScanner_ADC1::getValue(uint8_t f_index) const
+    {
+        if (!m_isSynchronized)
+        {
+            return m_buffer[f_index];
+        }
+        return getSample((getPosition() + m_depth - 1) % m_depth, f_index);
+    }
+
+    /** \brief  Position of the DMA in the buffer, the slot of the sequence, which is written by the next trigger
+     *
+     *  @return                slot in interval [0,depth)
+     */
+    uint8_t CAdcDmaScanner_ADC1::getPosition() const
+    {
+        uint32_t l_written = static_cast<uint32_t>(m_count) * m_depth - DMA2_Stream0->NDTR;
+        return static_cast<uint8_t>((l_written / m_count) % m_depth);
+    }
+
+    /** \brief  ADC interrupt handler
+     *
+     *  It applies the callback of the analog watchdog and it disarms the watchdog, then it applies the chained handler. 
+     */
+    void CAdcDmaScanner_ADC1::adcIrqHandler()
+    {
+        if ((ADC1->CR1 & ADC_CR1_AWDIE) && (ADC1->SR & ADC_SR_AWD))
+        {
+            ADC1->CR1 &= ~ADC_CR1_AWDIE;
+            ADC1->SR = ~ADC_SR_AWD;
+            if (s_instance != NULL && s_instance->m_watchdogCallback)
+            {
+                s_instance->m_watchdogCallback();
+            }
+        }
+        if (s_chainedHandler != 0)
+        {
+            reinterpret_cast<void (*)()>(s_chainedHandler)();
+        }
+    }
+
+    /** \brief  Start the conversion of the sequence, in the synchronized mode the conversions are started by the timer.
+     *
+     *  After an overrun the DMA is restarted, so the results remain aligned to the buffer.
+     */
+    void CAdcDmaScanner_ADC1::trigger()
+    {
+        if (ADC1->SR & ADC_SR_OVR)
+        {
+            start();
+        }
+        if (m_isSynchronized)
+        {
+            return;
+        }
+        DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0;
+        ADC1->CR2 |= ADC_CR2_SWSTART;
+    }
+
+    /** \brief  Wait the end of the conversion, in the synchronized mode the last complete sequence is always available.
+     *
+     *  @return                true, when all results of the sequence were copied to the buffer
+     */
+    bool CAdcDmaScanner_ADC1::wait()
+    {
+        if (m_isSynchronized)
+        {
+            return true;
+        }
+        for (uint32_t i = 0; i < s_timeout; i++)
+        {
+            if (DMA2->LISR & DMA_LISR_TCIF0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    AdcInjected.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the pwm triggered injected conversion of an analog input.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/adcinjected.hpp>
+
+namespace hardware::drivers{
+
+    CAdcInjected_ADC1* CAdcInjected_ADC1::s_instance = NULL;
+
+    /** \brief  CAdcInjected_ADC1 class constructor
+     *
+     *  @param f_pin           analog pin of the ADC1
+     *  @param f_scale         current in ampere at full scale
+     */
+    CAdcInjected_ADC1::CAdcInjected_ADC1(PinName f_pin, float f_scale)
+        : m_pin(f_pin)
+        , m_channel(static_cast<uint8_t>(STM_PIN_CHANNEL(pinmap_function(f_pin, PinMap_ADC))))
+        , m_scale(f_scale)
+        , m_value(0)
+        , m_callback()
+    {
+    }
+
+    /** \brief  Configure the trigger, the ADC and the interrupt
+     *
+     *  The TIM2 has to generate the pwm already. Only the injected part of the ADC1 is configured, the regular sequence isn't changed.
+     *
+     *  @param f_phase         sampling point as fraction of the pwm period, in interval (0,1)
+     */
+    void CAdcInjected_ADC1::start(float f_phase)
+    {
+        pin_function(m_pin, STM_PIN_DATA(STM_MODE_ANALOG, GPIO_NOPULL, 0));
+        RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;
+        s_instance = this;
+
+        // Channel 1 of TIM2: pwm mode 1 without output, its falling reference edge is the trigger
+        TIM2->CCER &= ~TIM_CCER_CC1E;
+        TIM2->CCMR1 = (TIM2->CCMR1 & ~(TIM_CCMR1_CC1S | TIM_CCMR1_OC1M)) | TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE;
+        setPhase(f_phase);
+
+        if (m_channel < 10)                                             // 56 cycles sampling time
+        {
+            ADC1->SMPR2 = (ADC1->SMPR2 & ~(0x7U << (3 * m_channel))) | (0x3U << (3 * m_channel));
+        }
+        else
+        {
+            ADC1->SMPR1 = (ADC1->SMPR1 & ~(0x7U << (3 * (m_channel - 10)))) | (0x3U << (3 * (m_channel - 10)));
+        }
+        ADC1->JSQR = static_cast<uint32_t>(m_channel) << 15;           // One conversion, it's defined by JSQ4
+        ADC1->SR = ~ADC_SR_JEOC;
+        ADC1->CR1 |= ADC_CR1_JEOCIE;
+        ADC1->CR2 = (ADC1->CR2 & ~(ADC_CR2_JEXTEN | ADC_CR2_JEXTSEL))
+                  | ADC_CR2_JEXTEN_1                                    // Falling edge
+                  | ADC_CR2_JEXTSEL_1                                   // TIM2 CC1 event
+                  | ADC_CR2_ADON;
+
+        NVIC_SetVector(ADC_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CAdcInjected_ADC1::adcIrqHandler)));
+        NVIC_SetPriority(ADC_IRQn, 0);
+        NVIC_EnableIRQ(ADC_IRQn);
+    }
+
+    /** \brief  Stop the triggered conversions
+     */
+    void CAdcInjected_ADC1::stop()
+    {
+        ADC1->CR2 &= ~ADC_CR2_JEXTEN;
+        ADC1->CR1 &= ~ADC_CR1_JEOCIE;
+        NVIC_DisableIRQ(ADC_IRQn);
+    }
+
+    /** \brief  Set the sampling point in the pwm period, the new value is applied from the next period
+     *
+     *  @param f_phase         sampling point as fraction of the pwm period, in interval (0,1)
+     */
+    void CAdcInjected_ADC1::setPhase(float f_phase)
+    {
+        TIM2->CCR1 = static_cast<uint32_t>(f_phase * static_cast<float>(TIM2->ARR));
+    }
+
+    /** \brief  Attach the end of conversion callback, it's applied from interrupt
+     *
+     *  @param f_callback      callback function
+     */
+    void CAdcInjected_ADC1::attach(mbed::Callback<void()> f_callback)
+    {
+        m_callback = f_callback;
+    }
+
+    /** \brief  Get current of the last conversion
+     *
+     *  @return                current in ampere
+     */
+    float CAdcInjected_ADC1::getCurrent()
+    {
+        return static_cast<float>(m_value) * m_scale / s_fullScale;
+    }
+
+    /** \brief  ADC interrupt handler
+     *
+     *  It reads the result of the injected conversion and applies the callback. 
+     */
+    void CAdcInjected_ADC1::adcIrqHandler()
+    {
+        if ((ADC1->SR & ADC_SR_JEOC) == 0)
+        {
+            return;
+        }
+        ADC1->SR = ~ADC_SR_JEOC;
+        if (s_instance != NULL)
+        {
+            s_instance->m_value = static_cast<uint16_t>(ADC1->JDR1);
+            if (s_instance->m_callback)
+            {
+                s_instance->m_callback();
+            }
+        }
+    }
+
+}; // namespace hardware::drivers
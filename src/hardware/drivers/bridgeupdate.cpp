@@ -0,0 +1,162 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    BridgeUpdate.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the synchronized update of the bridge outputs.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/bridgeupdate.hpp>
+
+namespace hardware::drivers{
+
+    CBridgeUpdate_TIM2* CBridgeUpdate_TIM2::s_instance = NULL;
+
+    /** \brief  CBridgeUpdate_TIM2 class constructor
+     *
+     *  @param f_pwm           pwm output of the bridge, it has to be generated by the TIM2
+     *  @param f_ina           direction pin A
+     *  @param f_inb           direction pin B
+     */
+    CBridgeUpdate_TIM2::CBridgeUpdate_TIM2(CFastPwmOut& f_pwm, CFastDigitalOut& f_ina, CFastDigitalOut& f_inb)
+        : m_pwm(f_pwm)
+        , m_ina(f_ina)
+        , m_inb(f_inb)
+        , m_stateA(false)
+        , m_stateB(false)
+        , m_pendingDuty(0)
+        , m_pendingA(false)
+        , m_pendingB(false)
+        , m_pending(false)
+        , m_started(false)
+    {
+    }
+
+    /** \brief  Start the synchronized update
+     *
+     *  It enables the preload of the compare register and the update interrupt of the TIM2.
+     *
+     *  @return                true, when the pwm output is generated by the TIM2
+     */
+    bool CBridgeUpdate_TIM2::start()
+    {
+        if (m_pwm.getTimer() != TIM2)
+        {
+            return false;
+        }
+        m_stateA = m_ina.read();
+        m_stateB = m_inb.read();
+        m_pending = false;
+        s_instance = this;
+        m_pwm.setPreload(true);
+        TIM2->DIER &= ~TIM_DIER_UIE;
+        TIM2->SR = ~TIM_SR_UIF;
+        NVIC_SetVector(TIM2_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CBridgeUpdate_TIM2::timerIrqHandler)));
+        NVIC_EnableIRQ(TIM2_IRQn);
+        m_started = true;
+        return true;
+    }
+
+    /** \brief  Stop the synchronized update
+     *
+     *  The pending command is applied immediately.
+     */
+    void CBridgeUpdate_TIM2::stop()
+    {
+        if (!m_started)
+        {
+            return;
+        }
+        NVIC_DisableIRQ(TIM2_IRQn);
+        TIM2->DIER &= ~TIM_DIER_UIE;
+        if (m_pending)
+        {
+            update();
+        }
+        m_pwm.setPreload(false);
+        m_started = false;
+    }
+
+    /** \brief  Set the command of the bridge
+     *
+     *  When the direction pins don't change, only the preload register is written. Otherwise the command is applied by the update 
+     *  interrupt after a period with zero duty cycle. A new command overwrites the pending one.
+     *
+     *  @param f_duty          duty cycle in interval [0,1]
+     *  @param f_ina           state of the direction pin A
+     *  @param f_inb           state of the direction pin B
+     */
+    void CBridgeUpdate_TIM2::write(float f_duty, bool f_ina, bool f_inb)
+    {
+        core_util_critical_section_enter();
+        if (m_pending)
+        {
+            m_pendingDuty = f_duty;
+            m_pendingA = f_ina;
+            m_pendingB = f_inb;
+        }
+        else if (f_ina == m_stateA && f_inb == m_stateB)
+        {
+            m_pwm.writeFast(f_duty);
+        }
+        else
+        {
+            m_pwm.writeFast(0.0f);
+            m_pendingDuty = f_duty;
+            m_pendingA = f_ina;
+            m_pendingB = f_inb;
+            m_pending = true;
+            TIM2->SR = ~TIM_SR_UIF;           // The zero duty cycle is loaded by the next update event
+            TIM2->DIER |= TIM_DIER_UIE;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Apply the pending command
+     */
+    void CBridgeUpdate_TIM2::update()
+    {
+        m_ina.writeFast(m_pendingA);
+        m_inb.writeFast(m_pendingB);
+        m_stateA = m_pendingA;
+        m_stateB = m_pendingB;
+        m_pwm.writeFast(m_pendingDuty);
+        m_pending = false;
+    }
+
+    /** \brief  TIM2 interrupt handler
+     *
+     *  It applies the pending command after the update event, which loaded the zero duty cycle, then it disables the update interrupt.
+     */
+    void CBridgeUpdate_TIM2::timerIrqHandler()
+    {
+        if ((TIM2->SR & TIM_SR_UIF) == 0)
+        {
+            return;
+        }
+        TIM2->SR = ~TIM_SR_UIF;
+        TIM2->DIER &= ~TIM_DIER_UIE;
+        if (s_instance != NULL && s_instance->m_pending)
+        {
+            s_instance->update();
+        }
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    ControlTimer.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the hardware timer of the control loop.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/controltimer.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/telemetry/tracestream.hpp>
+#include <math.h>
+
+namespace hardware::drivers{
+
+    CControlTimer_TIM10* CControlTimer_TIM10::s_instance = NULL;
+
+    /** \brief  CControlTimer_TIM10 class constructor
+     */
+    CControlTimer_TIM10::CControlTimer_TIM10()
+        : m_callback()
+        , m_overruns(0)
+        , m_reload(0)
+        , m_countPeriod(0)
+        , m_trim(0)
+        , m_trimFraction(0)
+        , m_trimAccumulator(0)
+        , m_step(0)
+        , m_tickCycles(0)
+    {
+    }
+
+    /** \brief  Attach the callback, which is applied from interrupt context in each period.
+     *
+     *  @param f_callback      callback function
+     */
+    void CControlTimer_TIM10::attach(mbed::Callback<void()> f_callback)
+    {
+        m_callback = f_callback;
+    }
+
+    /** \brief  Start the periodic interrupt
+     *
+     *  The prescaler and the auto-reload value are calculated from the timer clock to reach the finest resolution of the period.
+     *
+     *  @param f_period        period in second
+     *  @return                true, when the period can be realized by the timer
+     */
+    bool CControlTimer_TIM10::start(float f_period)
+    {
+        uint32_t l_clock = HAL_RCC_GetPCLK2Freq();
+        if ((RCC->CFGR & RCC_CFGR_PPRE2) != 0) // The timer clock is doubled, when the APB2 is prescaled
+        {
+            l_clock *= 2;
+        }
+        uint32_t l_ticks = static_cast<uint32_t>(f_period * l_clock + 0.5f);
+        uint32_t l_prescaler = (l_ticks - 1) >> 16;
+        if (l_ticks == 0 || l_prescaler > 0xFFFF)
+        {
+            return false;
+        }
+        s_instance = this;
+        RCC->APB2ENR |= RCC_APB2ENR_TIM10EN;
+        TIM10->CR1 = 0;
+        TIM10->PSC = l_prescaler;
+        m_reload = l_ticks / (l_prescaler + 1) - 1;
+        m_countPeriod = (l_prescaler + 1) / static_cast<float>(l_clock);
+        TIM10->ARR = m_reload;
+        TIM10->EGR = TIM_EGR_UG;                                            // Load the prescaler
+        TIM10->SR = 0;
+        TIM10->DIER = TIM_DIER_UIE;                                          // Update interrupt
+        NVIC_SetVector(TIM1_UP_TIM10_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CControlTimer_TIM10::timerIrqHandler)));
+        NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+        TIM10->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+        return true;
+    }
+
+    /** \brief  Trim the period, the integer part is added to each period, the fraction is dithered, so the mean period is 
+     *  changed by the given counts. It's applied from the period after the next update event.
+     *
+     *  @param f_counts        trim in timer counts, positive lengthens the period
+     */
+    void CControlTimer_TIM10::setTrim(float f_counts)
+    {
+        int32_t l_trim = static_cast<int32_t>(floorf(f_counts));
+        uint32_t l_fraction = static_cast<uint32_t>((f_counts - l_trim) * 65536.0f) & 0xFFFF;
+        core_util_critical_section_enter();
+        m_trim = l_trim;
+        m_trimFraction = l_fraction;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Stretch or shorten the next period once, it shifts the phase of the ticks without changing the period.
+     *
+     *  @param f_counts        change of the period in timer counts, positive delays the next ticks
+     */
+    void CControlTimer_TIM10::step(int32_t f_counts)
+    {
+        core_util_critical_section_enter();
+        m_step += f_counts;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Stop the periodic interrupt
+     */
+    void CControlTimer_TIM10::stop()
+    {
+        TIM10->CR1 &= ~TIM_CR1_CEN;
+        TIM10->DIER = 0;
+        NVIC_DisableIRQ(TIM1_UP_TIM10_IRQn);
+    }
+
+    /** \brief  TIM10 update interrupt handler
+     *
+     *  It clears the update flag and it applies the callback. When the flag is set again after the callback, the callback was longer than the period.
+     */
+    CONTROL_RAMFUNC void CControlTimer_TIM10::timerIrqHandler()
+    {
+        if ((TIM10->SR & TIM_SR_UIF) == 0)
+        {
+            return;
+        }
+        TIM10->SR = ~TIM_SR_UIF;
+        utils::telemetry::CTraceStream::isrEnter(TIM1_UP_TIM10_IRQn);
+        if (s_instance != NULL)
+        {
+            s_instance->m_tickCycles = DWT->CYCCNT;
+            // The preloaded value is the period after the next update event
+            s_instance->m_trimAccumulator += s_instance->m_trimFraction;
+            int32_t l_reload = static_cast<int32_t>(s_instance->m_reload) + s_instance->m_trim + s_instance->m_step + static_cast<int32_t>(s_instance->m_trimAccumulator >> 16);
+            s_instance->m_trimAccumulator &= 0xFFFF;
+            s_instance->m_step = 0;
+            TIM10->ARR = (l_reload < 1) ? 1 : ((l_reload > 0xFFFF) ? 0xFFFF : l_reload);
+        }
+        if (s_instance != NULL && s_instance->m_callback)
+        {
+            s_instance->m_callback();
+            if (TIM10->SR & TIM_SR_UIF)
+            {
+                s_instance->m_overruns++;
+            }
+        }
+        utils::telemetry::CTraceStream::isrExit(TIM1_UP_TIM10_IRQn);
+    }
+
+}; // namespace hardware::drivers
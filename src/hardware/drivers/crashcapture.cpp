@@ -0,0 +1,306 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    CrashCapture.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the crash capture.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/crashcapture.hpp>
+#include <cstdarg>
+#include <cstdio>
+
+/** @brief  Linker symbols of the valid stack and code regions */
+extern "C" uint32_t __data_start__;
+extern "C" uint32_t __StackTop;
+extern "C" uint32_t __etext;
+extern "C" uint32_t __ramfunc_start__;
+extern "C" uint32_t __ramfunc_end__;
+
+namespace hardware::drivers{
+
+    CCrashCapture::SRecord* CCrashCapture::s_record = NULL;
+
+    /** \brief  Attach the memory of the record, it has to be applied at the beginning of the setup. An invalid record (power on) is cleared.
+     *
+     *  @param f_record        record in the '.noinit' section
+     *  @return                true, when a new crash record was found
+     */
+    bool CCrashCapture::attach(SRecord& f_record)
+    {
+        if (f_record.m_magic != s_magic || f_record.m_check != check(f_record))
+        {
+            memset(&f_record, 0, sizeof(SRecord));
+            f_record.m_magic = s_magic;
+            f_record.m_isReported = 1;
+            f_record.m_check = check(f_record);
+        }
+        s_record = &f_record;
+        return isPending();
+    }
+
+    /** \brief  A new crash record was found after the reset, it wasn't reported yet
+     *
+     *  @return                true, when the record has to be reported
+     */
+    bool CCrashCapture::isPending()
+    {
+        return s_record != NULL && s_record->m_cause != CAUSE_NONE && !s_record->m_isReported;
+    }
+
+    /** \brief  Mark the record as reported, it's kept for the serial callback
+     */
+    void CCrashCapture::acknowledge()
+    {
+        if (s_record != NULL)
+        {
+            s_record->m_isReported = 1;
+            s_record->m_check = check(*s_record);
+        }
+    }
+
+    /** \brief  Format the record: 'cause;count;pc;lr;xpsr;sp;cfsr;hfsr;mmfar;bfar;task0;task1;task2;trace...;message', 
+     *  the registers are in hexadecimal.
+     *
+     *  @param f_buffer        output buffer
+     *  @param f_size          size of the buffer
+     */
+    void CCrashCapture::format(char* f_buffer, uint32_t f_size)
+    {
+        static const char* s_causes[] = {"none", "hardfault", "error", "die"};
+        const SRecord& l_record = *s_record;
+        int l_length = snprintf(f_buffer, f_size, "%s;%lu;%08lx;%08lx;%08lx;%08lx;%08lx;%08lx;%08lx;%08lx;%ld;%ld;%ld;"
+                               , s_causes[l_record.m_cause < 4 ? l_record.m_cause : 0], static_cast<unsigned long>(l_record.m_count)
+                               , static_cast<unsigned long>(l_record.m_frame[6]), static_cast<unsigned long>(l_record.m_frame[5])
+                               , static_cast<unsigned long>(l_record.m_frame[7]), static_cast<unsigned long>(l_record.m_sp)
+                               , static_cast<unsigned long>(l_record.m_status[0]), static_cast<unsigned long>(l_record.m_status[1])
+                               , static_cast<unsigned long>(l_record.m_status[2]), static_cast<unsigned long>(l_record.m_status[3])
+                               , static_cast<long>(l_record.m_tasks[0]), static_cast<long>(l_record.m_tasks[1]), static_cast<long>(l_record.m_tasks[2]));
+        for (uint32_t i = 0; i < s_traceDepth && l_record.m_trace[i] != 0 && l_length > 0 && static_cast<uint32_t>(l_length) < f_size; ++i)
+        {
+            l_length += snprintf(f_buffer + l_length, f_size - l_length, "%08lx;", static_cast<unsigned long>(l_record.m_trace[i]));
+        }
+        if (l_length > 0 && static_cast<uint32_t>(l_length) < f_size)
+        {
+            snprintf(f_buffer + l_length, f_size - l_length, "%.*s", static_cast<int>(s_messageLength - 1), l_record.m_message);
+        }
+    }
+
+    /** \brief  Serial callback of the last crash record, the response is the formatted record or 'none'.
+     *
+     *  @param a               input string, it isn't used
+     *  @param b               output string
+     */
+    void CCrashCapture::serialCallback(char const * a, char * b)
+    {
+        if (s_record == NULL || s_record->m_cause == CAUSE_NONE)
+        {
+            sprintf(b,"none;;");
+            return;
+        }
+        format(b, 240);
+        strcat(b, ";;");
+    }
+
+    /** \brief  Capture the HardFault, it's applied by the handler with the exception frame on the active stack. It doesn't return.
+     *
+     *  @param f_frame         exception frame (r0, r1, r2, r3, r12, lr, pc, xpsr)
+     *  @param f_excReturn     link register of the exception
+     */
+    void CCrashCapture::captureFault(const uint32_t* f_frame, uint32_t f_excReturn)
+    {
+        begin(CAUSE_HARD_FAULT);
+        uintptr_t l_frame = reinterpret_cast<uintptr_t>(f_frame);
+        if (s_record != NULL && l_frame >= reinterpret_cast<uintptr_t>(&__data_start__) && l_frame + 32 <= reinterpret_cast<uintptr_t>(&__StackTop))
+        {
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                s_record->m_frame[i] = f_frame[i];
+            }
+            // The extended frame contains the floating point registers, the aligner word is marked in the stacked xpsr
+            uint32_t l_frameSize = ((f_excReturn & 0x10) == 0) ? 26 * 4 : 8 * 4;
+            l_frameSize += (f_frame[7] & (1U << 9)) ? 4 : 0;
+            s_record->m_excReturn = f_excReturn;
+            s_record->m_sp = l_frame + l_frameSize;
+            trace(s_record->m_sp);
+        }
+        finish();
+    }
+
+    /** \brief  Capture a fatal error, it doesn't return.
+     *
+     *  @param f_cause         cause of the crash
+     *  @param f_message       error message, it can be NULL
+     *  @param f_pc            address of the caller
+     *  @param f_sp            stack pointer of the caller
+     */
+    void CCrashCapture::captureError(ECause f_cause, const char* f_message, uint32_t f_pc, uint32_t f_sp)
+    {
+        begin(f_cause);
+        if (s_record != NULL)
+        {
+            s_record->m_frame[6] = f_pc;
+            s_record->m_frame[7] = __get_xPSR();
+            s_record->m_sp = f_sp;
+            for (uint32_t i = 0; f_message != NULL && f_message[i] != 0 && i + 1 < s_messageLength; ++i)
+            {
+                char l_char = f_message[i];
+                s_record->m_message[i] = (l_char == ';' || l_char == '\r' || l_char == '\n') ? ' ' : l_char;
+            }
+            trace(f_sp);
+        }
+        finish();
+    }
+
+    /** \brief  Start a new record, the counter of the crashes is kept
+     *
+     *  @param f_cause         cause of the crash
+     */
+    void CCrashCapture::begin(ECause f_cause)
+    {
+        if (s_record == NULL)
+        {
+            return;
+        }
+        uint32_t l_count = s_record->m_count + 1;
+        memset(s_record, 0, sizeof(SRecord));
+        s_record->m_magic = s_magic;
+        s_record->m_count = l_count;
+        s_record->m_cause = f_cause;
+        s_record->m_status[0] = SCB->CFSR;
+        s_record->m_status[1] = SCB->HFSR;
+        s_record->m_status[2] = SCB->MMFAR;
+        s_record->m_status[3] = SCB->BFAR;
+        for (uint32_t i = 0; i < utils::task::g_priorityClassCount; ++i)
+        {
+            utils::task::CTask* l_task = utils::task::CTask::getRunning(static_cast<utils::task::EPriorityClass>(i));
+            s_record->m_tasks[i] = (l_task != NULL) ? static_cast<int32_t>(l_task->getTaskIdx()) : -1;
+        }
+    }
+
+    /** \brief  Search the return addresses on the stack: odd words (thumb state) in the code of the flash or of the '.ramfunc' section.
+     *
+     *  @param f_sp            stack pointer, the search starts from it
+     */
+    void CCrashCapture::trace(uint32_t f_sp)
+    {
+        const uintptr_t l_stackTop = reinterpret_cast<uintptr_t>(&__StackTop);
+        if (f_sp < reinterpret_cast<uintptr_t>(&__data_start__) || f_sp >= l_stackTop)
+        {
+            return;
+        }
+        const uint32_t* l_word = reinterpret_cast<const uint32_t*>(f_sp & ~3U);
+        uint32_t l_found = 0;
+        for (uint32_t i = 0; i < s_traceSearch && l_found < s_traceDepth && reinterpret_cast<uintptr_t>(l_word) < l_stackTop; ++i, ++l_word)
+        {
+            uint32_t l_value = *l_word;
+            bool l_isFlash = l_value >= FLASH_BASE && l_value < reinterpret_cast<uintptr_t>(&__etext);
+            bool l_isRam = l_value >= reinterpret_cast<uintptr_t>(&__ramfunc_start__) && l_value < reinterpret_cast<uintptr_t>(&__ramfunc_end__);
+            if ((l_value & 1) && (l_isFlash || l_isRam))
+            {
+                s_record->m_trace[l_found++] = l_value & ~1U;
+            }
+        }
+    }
+
+    /** \brief  Close the record and reset the microcontroller
+     */
+    void CCrashCapture::finish()
+    {
+        if (s_record != NULL)
+        {
+            s_record->m_check = check(*s_record);
+        }
+        NVIC_SystemReset();
+    }
+
+    /** \brief  Check value of the record, the sum of its words without the check value
+     *
+     *  @param f_record        record
+     *  @return                check value
+     */
+    uint32_t CCrashCapture::check(const SRecord& f_record)
+    {
+        const uint32_t* l_words = reinterpret_cast<const uint32_t*>(&f_record);
+        uint32_t l_sum = 0x5A5A5A5A;
+        for (uint32_t i = 0; i < offsetof(SRecord, m_check) / sizeof(uint32_t); ++i)
+        {
+            l_sum += l_words[i] ^ i;
+        }
+        return l_sum;
+    }
+
+}; // namespace hardware::drivers
+
+/** \brief  C part of the HardFault handler
+ *
+ *  @param f_frame         exception frame on the active stack
+ *  @param f_excReturn     link register of the exception
+ */
+extern "C" void crashCaptureHardFault(const uint32_t* f_frame, uint32_t f_excReturn)
+{
+    hardware::drivers::CCrashCapture::captureFault(f_frame, f_excReturn);
+}
+
+/** \brief  HardFault handler, it replaces the weak handler of the startup code (infinite loop). The exception frame is on the 
+ *  process stack (threads) or on the main stack (interrupts, before the start of the RTX), it's selected by the EXC_RETURN.
+ */
+extern "C" __attribute__((naked)) void HardFault_Handler(void)
+{
+    __asm volatile(
+        "tst lr, #4                 \n"
+        "ite eq                     \n"
+        "mrseq r0, msp              \n"
+        "mrsne r0, psp              \n"
+        "mov r1, lr                 \n"
+        "b crashCaptureHardFault    \n");
+}
+
+/** \brief  Fatal error of mbed and of the RTX (os_error: stack overflow, queue overflow), it replaces the weak function of the 
+ *  library (print and halt). The formatted message is stored in the crash record.
+ *
+ *  @param format          format of the message
+ */
+extern "C" void error(const char* format, ...)
+{
+    char l_message[hardware::drivers::CCrashCapture::s_messageLength];
+    va_list l_args;
+    va_start(l_args, format);
+    vsnprintf(l_message, sizeof(l_message), format, l_args);
+    va_end(l_args);
+    uint32_t l_marker = 0;
+    hardware::drivers::CCrashCapture::captureError(hardware::drivers::CCrashCapture::CAUSE_ERROR, l_message
+                                                  , reinterpret_cast<uintptr_t>(__builtin_return_address(0)), reinterpret_cast<uintptr_t>(&l_marker));
+    while (true)
+    {
+    }
+}
+
+/** \brief  It replaces the weak function of the library (blinking of the led), the platform is reset.
+ */
+extern "C" void mbed_die(void)
+{
+    uint32_t l_marker = 0;
+    hardware::drivers::CCrashCapture::captureError(hardware::drivers::CCrashCapture::CAUSE_DIE, NULL
+                                                  , reinterpret_cast<uintptr_t>(__builtin_return_address(0)), reinterpret_cast<uintptr_t>(&l_marker));
+    while (true)
+    {
+    }
+}
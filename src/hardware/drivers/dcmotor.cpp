@@ -24,6 +24,7 @@ limitations under the License.
  */
 
 #include <hardware/drivers/dcmotor.hpp>
+#include <utils/memory/sections.hpp>
 
 
 namespace hardware::drivers{
@@ -43,11 +44,15 @@ namespace hardware::drivers{
         :m_pwm(f_pwmPin)
         ,m_ina(f_inaPin)
         ,m_inb(f_inbPin)
+        ,m_bridge(m_pwm,m_ina,m_inb)
         ,m_current_in(f_currentPin)
         ,m_inf_limit(-0.50)
         ,m_sup_limit(0.50)
+        ,m_fastPath(false)
+        ,m_tripped(false)
     {  
         m_pwm.period_us(200);
+        m_pwm.latch();
     }
 
 
@@ -66,11 +71,15 @@ namespace hardware::drivers{
         :m_pwm(f_pwmPin)
         ,m_ina(f_inaPin)
         ,m_inb(f_inbPin)
+        ,m_bridge(m_pwm,m_ina,m_inb)
         ,m_current_in(f_currentPin)
         ,m_inf_limit(f_inf_limit)
         ,m_sup_limit(f_sup_limit)
+        ,m_fastPath(false)
+        ,m_tripped(false)
     {  
         m_pwm.period_us(200);
+        m_pwm.latch();
     }
 
     /**  @brief  VNH class destructor
@@ -86,8 +95,20 @@ namespace hardware::drivers{
      *  @param f_pwm     duty cycle of generated pwm signal
      *   
      */
-    void CMotorDriverVnh::setSpeed(float f_pwm)
+    CONTROL_RAMFUNC void CMotorDriverVnh::setSpeed(float f_pwm)
     {
+        if (m_bridge.isStarted())
+        {
+            m_bridge.write(std::abs(f_pwm), f_pwm >= 0, f_pwm < 0);
+            return;
+        }
+        if (m_fastPath)
+        {
+            m_ina.writeFast(f_pwm >= 0);
+            m_inb.writeFast(f_pwm < 0);
+            m_pwm.writeFast(std::abs(f_pwm));
+            return;
+        }
         // Setting direction of the motor based on pwm. Positive pwm refers to forward direction and negative pwm to backward. 
         if (f_pwm < 0) //backward
         {
@@ -119,6 +140,11 @@ namespace hardware::drivers{
      */
     void CMotorDriverVnh::inverseDirection(float f_pwm)
     {
+        if (m_bridge.isStarted())
+        {
+            m_bridge.write(std::abs(f_pwm), !m_ina.read(), !m_inb.read());
+            return;
+        }
         m_ina=!m_ina;
         m_inb=!m_inb;
         m_pwm =std::abs(f_pwm);
@@ -129,9 +155,42 @@ namespace hardware::drivers{
      */
     void CMotorDriverVnh::brake()
     {
+        dynamicBrake(1.0f);
+    }
+
+    /**  @brief  It switches off the bridge, the motor isn't driven and it isn't braked, so it freewheels. 
+     *   
+     */
+    void CMotorDriverVnh::coast()
+    {
+        dynamicBrake(0.0f);
+    }
+
+    /**  @brief  Proportional dynamic braking, the low side switches short the motor in the active part of the pwm period and 
+     *   the bridge is off in the rest of the period. So the braking torque is proportional to the duty cycle and to the speed, 
+     *   the braking energy is dissipated in a part of the period instead of the full period.
+     *
+     *  @param f_duty  duty cycle of the braking in interval [0,1]
+     */
+    CONTROL_RAMFUNC void CMotorDriverVnh::dynamicBrake(float f_duty)
+    {
+        float l_duty = std::abs(f_duty);
+        l_duty = (l_duty < 1.0f) ? l_duty : 1.0f;
+        if (m_bridge.isStarted())
+        {
+            m_bridge.write(l_duty, false, false);
+            return;
+        }
+        if (m_fastPath)
+        {
+            m_ina.writeFast(false);
+            m_inb.writeFast(false);
+            m_pwm.writeFast(l_duty);
+            return;
+        }
         m_ina.write(0);
         m_inb.write(0);
-        m_pwm.write(100.0);
+        m_pwm.write(l_duty);
     }
 
     /**
@@ -145,4 +204,62 @@ namespace hardware::drivers{
         return m_inf_limit<=f_pwm && f_pwm <=m_sup_limit;
     }
 
+    /**
+     * @brief It enables the direct register access of the outputs. After the activation the duty cycle read by the PwmOut object isn't updated.
+     * 
+     * @param f_enable activation state
+     */
+    void CMotorDriverVnh::setFastPath(bool f_enable){
+        m_fastPath = f_enable;
+    }
+
+    /**
+     * @brief It enables the synchronized update of the duty cycle and of the direction at the update event of the timer. 
+     * The direction change is delayed by one period with zero duty cycle.
+     * 
+     * @param f_enable activation state
+     * @return true means, that the pwm pin supports the synchronized mode
+     */
+    bool CMotorDriverVnh::setSynchronized(bool f_enable){
+        if (f_enable)
+        {
+            return m_bridge.start();
+        }
+        m_bridge.stop();
+        return true;
+    }
+
+    /**
+     * @brief It changes the frequency of the pwm, the duty cycle is kept. The timer is written directly, so the fast path is enabled, 
+     * the duty cycle of the PwmOut object would be scaled by the old period.
+     * 
+     * @param f_frequency frequency in Hz, in interval [s_minPwmFrequency, s_maxPwmFrequency]
+     * @return true means, that the frequency is applied
+     */
+    bool CMotorDriverVnh::setPwmFrequency(float f_frequency){
+        if (f_frequency < s_minPwmFrequency || f_frequency > s_maxPwmFrequency || !m_pwm.setFrequency(f_frequency))
+        {
+            return false;
+        }
+        m_fastPath = true;
+        return true;
+    }
+
+    /**
+     * @brief It switches off the bridge immediately by forcing the pwm output inactive, the high side switches don't feed the motor. 
+     * It can be applied from interrupt.
+     */
+    void CMotorDriverVnh::trip(){
+        m_pwm.setForcedInactive(true);
+        m_tripped = true;
+    }
+
+    /**
+     * @brief It releases the bridge after a trip, the last written command is applied again.
+     */
+    void CMotorDriverVnh::release(){
+        m_tripped = false;
+        m_pwm.setForcedInactive(false);
+    }
+
 }; // namespace hardware::drivers
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+  * @file    EchoCapture.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the DMA based pulse width capture of an ultrasonic echo.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/echocapture.hpp>
+#include <pinmap.h>
+
+namespace hardware::drivers{
+
+    /** \brief  CEchoCapture_TIM3 class constructor
+     *
+     *  The channel and the DMA are configured by the start.
+     */
+    CEchoCapture_TIM3::CEchoCapture_TIM3()
+        : m_edges()
+        , m_started(false)
+    {
+    }
+
+    /** \brief  Configure the channel and the DMA
+     *
+     *  The PA6 is the TIM3 channel 1 input with pull-down, so a missing sensor doesn't give edges. The input is filtered by 8
+     *  samples of the timer clock. The bits of the channel 2 aren't changed, the counter keeps running.
+     */
+    void CEchoCapture_TIM3::start()
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+        pin_function(PA_6, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLDOWN, GPIO_AF2_TIM3));
+
+        TIM3->CCER &= ~(TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC1NP);
+        TIM3->CCMR1 = (TIM3->CCMR1 & ~(TIM_CCMR1_CC1S | TIM_CCMR1_IC1PSC | TIM_CCMR1_IC1F))
+                    | TIM_CCMR1_CC1S_0                                          // Channel 1 input on TI1
+                    | TIM_CCMR1_IC1F_1 | TIM_CCMR1_IC1F_0;                      // Filter fCK_INT, N=8
+        TIM3->CCER |= TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC1NP;           // Capture on both edges
+        TIM3->DIER |= TIM_DIER_CC1DE;                                           // DMA request on capture
+
+        DMA1_Stream4->CR &= ~DMA_SxCR_EN;
+        while (DMA1_Stream4->CR & DMA_SxCR_EN);
+        DMA1_Stream4->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&TIM3->CCR1));
+        DMA1_Stream4->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_edges));
+        DMA1_Stream4->FCR = 0;                                                  // Direct mode
+        DMA1_Stream4->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_CHSEL_0                  // Channel 5 (TIM3_CH1)
+                         | DMA_SxCR_MSIZE_0                                     // Memory half-word
+                         | DMA_SxCR_PSIZE_0                                     // Peripheral half-word
+                         | DMA_SxCR_MINC;                                       // Memory increment, peripheral to memory
+        m_started = true;
+        arm();
+    }
+
+    /** \brief  Prepare the capture of the next pulse, the next two edges are copied. The input has to be low, so the first edge
+     *  is the rising one, the sensor is armed before its trigger.
+     */
+    void CEchoCapture_TIM3::arm()
+    {
+        DMA1_Stream4->CR &= ~DMA_SxCR_EN;
+        while (DMA1_Stream4->CR & DMA_SxCR_EN);
+        DMA1->HIFCR = DMA_HIFCR_CTCIF4 | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTEIF4 | DMA_HIFCR_CDMEIF4 | DMA_HIFCR_CFEIF4;
+        (void)TIM3->CCR1;                                                       // Clear a pending capture
+        DMA1_Stream4->NDTR = 2;
+        DMA1_Stream4->CR |= DMA_SxCR_EN;
+    }
+
+    /** \brief  Get the width of the captured pulse
+     *
+     *  @param f_ticks         width of the pulse in counter ticks modulo the period of the timer
+     *  @return                true, when both edges were captured
+     */
+    bool CEchoCapture_TIM3::read(uint32_t& f_ticks) const
+    {
+        if (2 != getEdges())
+        {
+            return false;
+        }
+        uint32_t l_period = getPeriodTicks();
+        f_ticks = (m_edges[1] + l_period - m_edges[0]) % l_period;
+        return true;
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+  * @file    EdgeCaptureDma.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the DMA based edge timestamp capture of a single channel sensor.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/edgecapturedma.hpp>
+#include <pinmap.h>
+
+namespace hardware::drivers{
+
+    /** \brief  CEdgeCaptureDma_TIM1 class constructor
+     *
+     *  The timer and the DMA are configured by the start.
+     */
+    CEdgeCaptureDma_TIM1::CEdgeCaptureDma_TIM1()
+        : m_buffer()
+        , m_readIndex(0)
+        , m_started(false)
+    {
+    }
+
+    /** \brief  Start the capture
+     *
+     *  The PA8 is the TIM1 channel 1 input with pull-up for the open drain output of the sensors. The input is filtered 
+     *  by 8 samples of fDTS/32 (about 3 us), so the bouncing of the magnetic sensor doesn't give more edges.
+     */
+    void CEdgeCaptureDma_TIM1::start()
+    {
+        RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+        pin_function(PA_8, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLUP, GPIO_AF1_TIM1));
+
+        TIM1->CR1 = 0;
+        TIM1->PSC = SystemCoreClock / s_frequency - 1;                          // APB2 timer clock is the core clock
+        TIM1->ARR = 0xFFFF;
+        TIM1->CCMR1 = TIM_CCMR1_CC1S_0                                          // Channel 1 input on TI1
+                    | TIM_CCMR1_IC1F;                                           // Filter fDTS/32, N=8
+        TIM1->CCER = TIM_CCER_CC1E;                                             // Capture on rising edge
+        TIM1->EGR = TIM_EGR_UG;                                                 // Load the prescaler
+        TIM1->SR = 0;
+        TIM1->DIER = TIM_DIER_CC1DE;                                            // DMA request on capture
+
+        DMA2_Stream3->CR &= ~DMA_SxCR_EN;
+        while (DMA2_Stream3->CR & DMA_SxCR_EN);
+        DMA2->LIFCR = DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 | DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3;
+        DMA2_Stream3->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&TIM1->CCR1));
+        DMA2_Stream3->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_buffer));
+        DMA2_Stream3->NDTR = s_bufferSize;
+        DMA2_Stream3->FCR = 0;                                                  // Direct mode
+        DMA2_Stream3->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_CHSEL_1                  // Channel 6 (TIM1_CH1)
+                         | DMA_SxCR_MSIZE_0                                     // Memory half-word
+                         | DMA_SxCR_PSIZE_0                                     // Peripheral half-word
+                         | DMA_SxCR_MINC                                        // Memory increment
+                         | DMA_SxCR_CIRC;                                       // Circular, peripheral to memory
+        DMA2_Stream3->CR |= DMA_SxCR_EN;
+
+        m_readIndex = 0;
+        TIM1->CR1 = TIM_CR1_CEN;
+        m_started = true;
+    }
+
+    /** \brief  Get the new edges since the previous reading
+     *
+     *  @param f_last          timestamp of the last new edge, it's unchanged without new edge
+     *  @return                number of the new edges
+     */
+    uint16_t CEdgeCaptureDma_TIM1::read(uint16_t& f_last)
+    {
+        uint16_t l_writeIndex = static_cast<uint16_t>(s_bufferSize - DMA2_Stream3->NDTR) % s_bufferSize;
+        uint16_t l_edges = static_cast<uint16_t>(l_writeIndex + s_bufferSize - m_readIndex) % s_bufferSize;
+        if (l_edges > 0)
+        {
+            f_last = m_buffer[(l_writeIndex + s_bufferSize - 1) % s_bufferSize];
+            m_readIndex = l_writeIndex;
+        }
+        return l_edges;
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    EncoderEdgeCapture.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the edge timestamp capture of the quadrature encoder.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/encoderedgecapture.hpp>
+
+namespace hardware::drivers{
+
+    CEncoderEdgeCapture_TIM4* CEncoderEdgeCapture_TIM4::s_instance = NULL;
+    uint32_t CEncoderEdgeCapture_TIM4::s_prevExtiHandler = 0;
+
+    /** \brief  CEncoderEdgeCapture_TIM4 class constructor
+     *
+     *  The EXTI line is configured at the first activation.
+     */
+    CEncoderEdgeCapture_TIM4::CEncoderEdgeCapture_TIM4()
+        : m_lastEdge()
+        , m_initialized(false)
+        , m_enabled(false)
+    {
+    }
+
+    /** \brief  Enable the capture
+     *
+     *  It routes the PB6 to the EXTI line 6 with rising edge trigger and it starts the cycle counter.
+     */
+    void CEncoderEdgeCapture_TIM4::enable()
+    {
+        if (!m_initialized)
+        {
+            s_instance = this;
+            CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+            RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+            SYSCFG->EXTICR[1] = (SYSCFG->EXTICR[1] & ~SYSCFG_EXTICR2_EXTI6) | SYSCFG_EXTICR2_EXTI6_PB;
+            EXTI->RTSR |= EXTI_RTSR_TR6;
+            EXTI->FTSR &= ~EXTI_FTSR_TR6;
+            s_prevExtiHandler = NVIC_GetVector(EXTI9_5_IRQn);
+            NVIC_SetVector(EXTI9_5_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CEncoderEdgeCapture_TIM4::extiIrqHandler)));
+            NVIC_EnableIRQ(EXTI9_5_IRQn);
+            m_initialized = true;
+        }
+        EXTI->PR = EXTI_PR_PR6;
+        m_enabled = true;
+        EXTI->IMR |= EXTI_IMR_MR6;
+    }
+
+    /** \brief  Disable the capture
+     */
+    void CEncoderEdgeCapture_TIM4::disable()
+    {
+        EXTI->IMR &= ~EXTI_IMR_MR6;
+        m_enabled = false;
+    }
+
+    /** \brief  Get the last captured edge
+     *
+     *  @return                copy of the last edge, it's read in critical section
+     */
+    SEncoderEdge CEncoderEdgeCapture_TIM4::getLastEdge()
+    {
+        core_util_critical_section_enter();
+        SEncoderEdge l_edge = m_lastEdge;
+        core_util_critical_section_exit();
+        return l_edge;
+    }
+
+    /** \brief  EXTI line 9..5 interrupt handler
+     *
+     *  It stamps the edge of the line 6, then it applies the previous handler for the other lines.
+     */
+    void CEncoderEdgeCapture_TIM4::extiIrqHandler()
+    {
+        if (EXTI->PR & EXTI_PR_PR6)
+        {
+            uint32_t l_cycles = DWT->CYCCNT;
+            EXTI->PR = EXTI_PR_PR6;
+            if (s_instance != NULL)
+            {
+                s_instance->m_lastEdge.m_cycles = l_cycles;
+                s_instance->m_lastEdge.m_position = static_cast<uint16_t>(TIM4->CNT);
+                s_instance->m_lastEdge.m_edgeCount++;
+            }
+        }
+        if (s_prevExtiHandler != 0 && (EXTI->PR & (EXTI_PR_PR5 | EXTI_PR_PR7 | EXTI_PR_PR8 | EXTI_PR_PR9)))
+        {
+            reinterpret_cast<void(*)()>(s_prevExtiHandler)();
+        }
+    }
+
+}; // namespace hardware::drivers
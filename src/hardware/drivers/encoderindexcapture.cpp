@@ -0,0 +1,101 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+  * @file    EncoderIndexCapture.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the capture of the index pulse of the quadrature encoder.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/encoderindexcapture.hpp>
+
+namespace hardware::drivers{
+
+    CEncoderIndexCapture_TIM4* CEncoderIndexCapture_TIM4::s_instance = NULL;
+
+    /** \brief  CEncoderIndexCapture_TIM4 class constructor
+     *
+     *  The pin and the EXTI line are configured at the first activation.
+     */
+    CEncoderIndexCapture_TIM4::CEncoderIndexCapture_TIM4()
+        : m_lastIndex()
+        , m_initialized(false)
+        , m_enabled(false)
+    {
+    }
+
+    /** \brief  Enable the capture
+     *
+     *  It configures the PB4 as input with pull-down, so an unconnected index input doesn't trigger, and it routes 
+     *  the pin to the EXTI line 4 with rising edge trigger.
+     */
+    void CEncoderIndexCapture_TIM4::enable()
+    {
+        if (!m_initialized)
+        {
+            s_instance = this;
+            RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;
+            GPIOB->MODER &= ~GPIO_MODER_MODER4;
+            GPIOB->PUPDR = (GPIOB->PUPDR & ~GPIO_PUPDR_PUPDR4) | GPIO_PUPDR_PUPDR4_1;
+            RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+            SYSCFG->EXTICR[1] = (SYSCFG->EXTICR[1] & ~SYSCFG_EXTICR2_EXTI4) | SYSCFG_EXTICR2_EXTI4_PB;
+            EXTI->RTSR |= EXTI_RTSR_TR4;
+            EXTI->FTSR &= ~EXTI_FTSR_TR4;
+            NVIC_SetVector(EXTI4_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CEncoderIndexCapture_TIM4::extiIrqHandler)));
+            NVIC_EnableIRQ(EXTI4_IRQn);
+            m_initialized = true;
+        }
+        EXTI->PR = EXTI_PR_PR4;
+        m_enabled = true;
+        EXTI->IMR |= EXTI_IMR_MR4;
+    }
+
+    /** \brief  Disable the capture
+     */
+    void CEncoderIndexCapture_TIM4::disable()
+    {
+        EXTI->IMR &= ~EXTI_IMR_MR4;
+        m_enabled = false;
+    }
+
+    /** \brief  Get the last captured index pulse
+     *
+     *  @return                copy of the last index pulse, it's read in critical section
+     */
+    SEncoderIndex CEncoderIndexCapture_TIM4::getLastIndex()
+    {
+        core_util_critical_section_enter();
+        SEncoderIndex l_index = m_lastIndex;
+        core_util_critical_section_exit();
+        return l_index;
+    }
+
+    /** \brief  EXTI line 4 interrupt handler
+     *
+     *  It latches the position of TIM4 before clearing the pending flag.
+     */
+    void CEncoderIndexCapture_TIM4::extiIrqHandler()
+    {
+        uint16_t l_position = static_cast<uint16_t>(TIM4->CNT);
+        EXTI->PR = EXTI_PR_PR4;
+        if (s_instance != NULL)
+        {
+            s_instance->m_lastIndex.m_position = l_position;
+            s_instance->m_lastIndex.m_indexCount++;
+        }
+    }
+
+}; // namespace hardware::drivers
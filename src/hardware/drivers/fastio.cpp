@@ -0,0 +1,155 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    FastIO.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the direct register access of the pwm and digital outputs.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/fastio.hpp>
+
+namespace hardware::drivers{
+
+    /** \brief  CFastPwmOut class constructor
+     *
+     *  @param f_pin           pwm pin
+     */
+    CFastPwmOut::CFastPwmOut(PinName f_pin)
+        : PwmOut(f_pin)
+    {
+        latch();
+    }
+
+    /** \brief  Save the registers of the channel
+     *
+     *  It has to be applied after each change of the period.
+     */
+    void CFastPwmOut::latch()
+    {
+        m_timer = reinterpret_cast<TIM_TypeDef*>(_pwm.pwm);
+        m_channel = _pwm.channel;
+        m_ccr = &m_timer->CCR1 + (m_channel - 1);
+        m_scale = static_cast<float>(m_timer->ARR + 1);
+    }
+
+    /** \brief  Enable the preload of the compare and the auto-reload registers
+     *
+     *  With the preload the value written by 'writeFast' is applied by the timer only at the next update event, 
+     *  so each period is generated with one duty cycle.
+     *
+     *  @param f_enable        activation state
+     */
+    void CFastPwmOut::setPreload(bool f_enable)
+    {
+        volatile uint32_t* l_ccmr = (m_channel <= 2) ? &m_timer->CCMR1 : &m_timer->CCMR2;
+        uint32_t l_bit = (m_channel % 2 == 1) ? TIM_CCMR1_OC1PE : TIM_CCMR1_OC2PE;
+        if (f_enable)
+        {
+            *l_ccmr |= l_bit;
+            m_timer->CR1 |= TIM_CR1_ARPE;
+        }
+        else
+        {
+            *l_ccmr &= ~l_bit;
+            m_timer->CR1 &= ~TIM_CR1_ARPE;
+        }
+    }
+
+    /** \brief  Change the frequency of the timer without prescaler, so the resolution of the duty cycle is the highest one
+     *
+     *  The compare register is rescaled, the duty cycle of the output is kept. The update event loads the new period without the 
+     *  update interrupt (URS), so a pending command of the synchronized bridge isn't applied by it. The other channels of the timer 
+     *  (e.g. the trigger of the ADC) keep their compare values in ticks, they have to be updated by their owners.
+     *
+     *  @param f_frequency     frequency in Hz
+     *  @return                false, when the period doesn't fit in the auto-reload register
+     */
+    bool CFastPwmOut::setFrequency(float f_frequency)
+    {
+        if (f_frequency <= 0.0f)
+        {
+            return false;
+        }
+        float l_ticks = static_cast<float>(timerClock()) / f_frequency;
+        uint32_t l_limit = (TIM2 == m_timer || TIM5 == m_timer) ? 0xFFFFFFFFU : 0xFFFFU;
+        if (l_ticks < 2.0f || l_ticks > static_cast<float>(l_limit))
+        {
+            return false;
+        }
+        uint32_t l_period = static_cast<uint32_t>(l_ticks + 0.5f);
+        core_util_critical_section_enter();
+        float l_duty = readFast();
+        m_timer->PSC = 0;
+        m_timer->ARR = l_period - 1;
+        m_scale = static_cast<float>(l_period);
+        *m_ccr = static_cast<uint32_t>(l_duty * m_scale);
+        m_timer->CR1 |= TIM_CR1_URS;
+        m_timer->EGR = TIM_EGR_UG;
+        m_timer->CR1 &= ~TIM_CR1_URS;
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Clock of the timer, the timers are clocked by the doubled bus clock, when the bus is prescaled. TIM1, TIM9, TIM10 
+     *  and TIM11 are on APB2, the others on APB1.
+     *
+     *  @return                clock frequency in Hz
+     */
+    uint32_t CFastPwmOut::timerClock() const
+    {
+        bool l_apb2 = (TIM1 == m_timer || TIM9 == m_timer || TIM10 == m_timer || TIM11 == m_timer);
+        uint32_t l_clock = l_apb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+        uint32_t l_prescaler = l_apb2 ? (RCC->CFGR & RCC_CFGR_PPRE2) : (RCC->CFGR & RCC_CFGR_PPRE1);
+        if (0 != l_prescaler)
+        {
+            l_clock *= 2;
+        }
+        return l_clock;
+    }
+
+    /** \brief  Force the output inactive immediately, independently of the compare register and of its preload. 
+     *
+     *  The output compare mode is changed, so it's safe from interrupt (e.g. overcurrent protection). After the release the 
+     *  pwm mode 1 is restored with the value of the compare register.
+     *
+     *  @param f_enable        forced state
+     */
+    void CFastPwmOut::setForcedInactive(bool f_enable)
+    {
+        volatile uint32_t* l_ccmr = (m_channel <= 2) ? &m_timer->CCMR1 : &m_timer->CCMR2;
+        uint32_t l_shift = (m_channel % 2 == 1) ? 0 : 8;
+        uint32_t l_mode = f_enable ? TIM_CCMR1_OC1M_2 : (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1);
+        core_util_critical_section_enter();
+        *l_ccmr = (*l_ccmr & ~(TIM_CCMR1_OC1M << l_shift)) | (l_mode << l_shift);
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  CFastDigitalOut class constructor
+     *
+     *  @param f_pin           digital pin
+     */
+    CFastDigitalOut::CFastDigitalOut(PinName f_pin)
+        : DigitalOut(f_pin)
+        , m_bsrr(gpio.reg_set)
+        , m_mask(gpio.mask)
+    {
+    }
+
+}; // namespace hardware::drivers
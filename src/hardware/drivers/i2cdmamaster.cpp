@@ -0,0 +1,309 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    I2cDmaMaster.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the non-blocking I2C master.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/i2cdmamaster.hpp>
+
+namespace hardware::drivers{
+
+    CI2cDmaMaster_I2C1* CI2cDmaMaster_I2C1::s_instance = NULL;
+
+    /** \brief  CI2cDmaMaster_I2C1 class constructor
+     *
+     *  The peripheral is configured by the mbed I2C object, the interrupts are installed by the 'start' method.
+     */
+    CI2cDmaMaster_I2C1::CI2cDmaMaster_I2C1()
+        : m_state(IDLE)
+        , m_read(false)
+        , m_address(0)
+        , m_register(0)
+        , m_data(NULL)
+        , m_length(0)
+        , m_written(0)
+        , m_done()
+        , m_errors(0)
+    {
+    }
+
+    /** \brief  Install the interrupt handlers
+     *
+     *  It configures the stream 0 of DMA1 for the receiver and it enables the event and the error interrupts of I2C1. 
+     */
+    void CI2cDmaMaster_I2C1::start()
+    {
+        s_instance = this;
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+        DMA1_Stream0->CR &= ~DMA_SxCR_EN;
+        while (DMA1_Stream0->CR & DMA_SxCR_EN);
+        DMA1->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+        DMA1_Stream0->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&I2C1->DR));
+        DMA1_Stream0->FCR = 0;                                                  // Direct mode
+
+        NVIC_SetVector(DMA1_Stream0_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CI2cDmaMaster_I2C1::dmaIrqHandler)));
+        NVIC_EnableIRQ(DMA1_Stream0_IRQn);
+        NVIC_SetVector(I2C1_EV_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CI2cDmaMaster_I2C1::eventIrqHandler)));
+        NVIC_EnableIRQ(I2C1_EV_IRQn);
+        NVIC_SetVector(I2C1_ER_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CI2cDmaMaster_I2C1::errorIrqHandler)));
+        NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+        I2C1->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+        I2C1->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+    }
+
+    /** \brief  Start the reading of consecutive registers
+     *
+     *  The register address is written, then the data bytes are read after a repeated start condition. 
+     *
+     *  @param f_address       7-bit device address
+     *  @param f_register      address of the first register
+     *  @param f_data          destination buffer, it has to remain valid until the callback is applied
+     *  @param f_length        number of bytes, at least one
+     *  @param f_done          callback of the finished transaction
+     *  @return                true, when the transaction is started, false, when another transaction is active
+     */
+    bool CI2cDmaMaster_I2C1::read(uint8_t f_address, uint8_t f_register, uint8_t* f_data, uint16_t f_length, FDoneCallback f_done)
+    {
+        return begin(f_address, f_register, f_data, f_length, true, f_done);
+    }
+
+    /** \brief  Start the writing of consecutive registers
+     *
+     *  @param f_address       7-bit device address
+     *  @param f_register      address of the first register
+     *  @param f_data          source buffer, it has to remain valid until the callback is applied
+     *  @param f_length        number of bytes
+     *  @param f_done          callback of the finished transaction
+     *  @return                true, when the transaction is started, false, when another transaction is active
+     */
+    bool CI2cDmaMaster_I2C1::write(uint8_t f_address, uint8_t f_register, const uint8_t* f_data, uint16_t f_length, FDoneCallback f_done)
+    {
+        return begin(f_address, f_register, const_cast<uint8_t*>(f_data), f_length, false, f_done);
+    }
+
+    /** \brief  Abort the active transaction
+     *
+     *  It generates a stop condition and it stops the DMA transfer, the callback isn't applied. It can be used to recover from a stuck transaction.
+     */
+    void CI2cDmaMaster_I2C1::abort()
+    {
+        core_util_critical_section_enter();
+        if (m_state != IDLE)
+        {
+            DMA1_Stream0->CR &= ~DMA_SxCR_EN;
+            I2C1->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+            I2C1->CR1 |= I2C_CR1_STOP;
+            m_state = IDLE;
+            m_errors++;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Start the transaction by the start condition
+     *
+     *  The stop condition of the previous transaction takes a few bit times, so the new transaction can be started from the callback 
+     *  of the previous one, it waits a bounded time for the stop condition.
+     *
+     *  @param f_address       7-bit device address
+     *  @param f_register      address of the first register
+     *  @param f_data          data buffer
+     *  @param f_length        number of data bytes
+     *  @param f_read          reading transaction
+     *  @param f_done          callback of the finished transaction
+     *  @return                true, when the transaction is started
+     */
+    bool CI2cDmaMaster_I2C1::begin(uint8_t f_address, uint8_t f_register, uint8_t* f_data, uint16_t f_length, bool f_read, FDoneCallback f_done)
+    {
+        if (f_read && f_length == 0)
+        {
+            return false;
+        }
+        core_util_critical_section_enter();
+        uint32_t l_guard = s_stopWaitLoops;
+        while ((I2C1->CR1 & I2C_CR1_STOP) && --l_guard);
+        if (m_state != IDLE || (I2C1->CR1 & I2C_CR1_STOP))
+        {
+            core_util_critical_section_exit();
+            return false;
+        }
+        m_read = f_read;
+        m_address = f_address;
+        m_register = f_register;
+        m_data = f_data;
+        m_length = f_length;
+        m_written = 0;
+        m_done = f_done;
+        m_state = START;
+        I2C1->CR1 |= I2C_CR1_ACK | I2C_CR1_START;
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Finish the transaction and apply the callback
+     *
+     *  @param f_success       result of the transaction
+     */
+    void CI2cDmaMaster_I2C1::finish(bool f_success)
+    {
+        m_state = IDLE;
+        if (!f_success)
+        {
+            m_errors++;
+        }
+        if (m_done)
+        {
+            m_done(f_success);
+        }
+    }
+
+    /** \brief  I2C1 event interrupt handler
+     *
+     *  It applies the steps of the transaction: the device address after the start conditions, the register address and the data bytes 
+     *  after the transmitted bytes, the configuration of the reception before the address flag is cleared.
+     */
+    void CI2cDmaMaster_I2C1::eventIrqHandler()
+    {
+        CI2cDmaMaster_I2C1* l_this = s_instance;
+        uint32_t l_sr1 = I2C1->SR1;
+        if (l_this == NULL)
+        {
+            return;
+        }
+        switch (l_this->m_state)
+        {
+            case START:
+                if (l_sr1 & I2C_SR1_SB)
+                {
+                    I2C1->DR = l_this->m_address << 1;
+                    l_this->m_state = ADDRESS;
+                }
+                break;
+            case ADDRESS:
+                if (l_sr1 & I2C_SR1_ADDR)
+                {
+                    (void)I2C1->SR2;
+                    I2C1->DR = l_this->m_register;
+                    l_this->m_state = WRITE;
+                }
+                break;
+            case WRITE:
+                if (l_sr1 & I2C_SR1_BTF)
+                {
+                    if (l_this->m_read)
+                    {
+                        I2C1->CR1 |= I2C_CR1_START;
+                        l_this->m_state = RESTART;
+                    }
+                    else if (l_this->m_written < l_this->m_length)
+                    {
+                        I2C1->DR = l_this->m_data[l_this->m_written++];
+                    }
+                    else
+                    {
+                        I2C1->CR1 |= I2C_CR1_STOP;
+                        l_this->finish(true);
+                    }
+                }
+                break;
+            case RESTART:
+                if (l_sr1 & I2C_SR1_SB)
+                {
+                    I2C1->DR = (l_this->m_address << 1) | 1;
+                    l_this->m_state = READ_ADDRESS;
+                }
+                break;
+            case READ_ADDRESS:
+                if (l_sr1 & I2C_SR1_ADDR)
+                {
+                    if (l_this->m_length == 1)
+                    {
+                        I2C1->CR1 &= ~I2C_CR1_ACK;
+                        (void)I2C1->SR2;
+                        I2C1->CR1 |= I2C_CR1_STOP;
+                        I2C1->CR2 |= I2C_CR2_ITBUFEN;
+                        l_this->m_state = READ_SINGLE;
+                    }
+                    else
+                    {
+                        DMA1_Stream0->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(l_this->m_data));
+                        DMA1_Stream0->NDTR = l_this->m_length;
+                        DMA1_Stream0->CR = DMA_SxCR_CHSEL_0                     // Channel 1 (I2C1_RX)
+                                         | DMA_SxCR_PL_0                        // Medium priority
+                                         | DMA_SxCR_MINC                        // Memory increment, peripheral to memory, byte size
+                                         | DMA_SxCR_TCIE | DMA_SxCR_TEIE;       // Transfer complete and error interrupts
+                        DMA1_Stream0->CR |= DMA_SxCR_EN;
+                        I2C1->CR2 |= I2C_CR2_DMAEN | I2C_CR2_LAST;              // Not acknowledge after the last byte
+                        l_this->m_state = READ_DMA;
+                        (void)I2C1->SR2;
+                    }
+                }
+                break;
+            case READ_SINGLE:
+                if (l_sr1 & I2C_SR1_RXNE)
+                {
+                    l_this->m_data[0] = I2C1->DR;
+                    I2C1->CR2 &= ~I2C_CR2_ITBUFEN;
+                    l_this->finish(true);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    /** \brief  I2C1 error interrupt handler
+     *
+     *  It clears the error flags (missing acknowledge, bus error, arbitration lost, overrun), it releases the bus and it signals the failed transaction.
+     */
+    void CI2cDmaMaster_I2C1::errorIrqHandler()
+    {
+        I2C1->SR1 &= ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR | I2C_SR1_TIMEOUT);
+        DMA1_Stream0->CR &= ~DMA_SxCR_EN;
+        I2C1->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+        I2C1->CR1 |= I2C_CR1_STOP;
+        if (s_instance != NULL && s_instance->m_state != IDLE)
+        {
+            s_instance->finish(false);
+        }
+    }
+
+    /** \brief  DMA1 stream 0 interrupt handler
+     *
+     *  It generates the stop condition after the last received byte and it signals the finished reading. 
+     */
+    void CI2cDmaMaster_I2C1::dmaIrqHandler()
+    {
+        uint32_t l_flags = DMA1->LISR & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0);
+        DMA1->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+        if (0 == l_flags)
+        {
+            return;
+        }
+        I2C1->CR1 |= I2C_CR1_STOP;
+        I2C1->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST);
+        if (s_instance != NULL && s_instance->m_state == READ_DMA)
+        {
+            s_instance->finish(0 == (l_flags & DMA_LISR_TEIF0));
+        }
+    }
+
+}; // namespace hardware::drivers
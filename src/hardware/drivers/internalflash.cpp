@@ -0,0 +1,138 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    InternalFlash.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the internal flash memory.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/internalflash.hpp>
+
+/** @brief  Symbols of the linker script, end of the code and bounds of the initialized data */
+extern uint32_t __etext;
+extern uint32_t __data_start__;
+extern uint32_t __data_end__;
+
+namespace hardware::drivers{
+
+    /** @brief  Error flags of the flash interface */
+    static const uint32_t s_errorFlags = FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | FLASH_SR_PGSERR;
+
+    /** \brief  Erase a sector, the memory of the sector is set to 0xFF.
+     *
+     *  @param f_sector        the sector
+     *  @return                true, when the sector is erased without error
+     */
+    bool CInternalFlash::erase(const SSector& f_sector)
+    {
+        if (!isFree(f_sector.m_address))
+        {
+            return false;
+        }
+        unlock();
+        FLASH->SR = s_errorFlags | FLASH_SR_EOP;
+        FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_SER | ((f_sector.m_number * FLASH_CR_SNB_0) & FLASH_CR_SNB);
+        FLASH->CR |= FLASH_CR_STRT;
+        bool l_res = wait();
+        FLASH->CR = FLASH_CR_LOCK;
+        flushCaches();
+        return l_res;
+    }
+
+    /** \brief  Program words, the destination has to be erased and aligned to word. The programmed values are verified.
+     *
+     *  @param f_address       destination address
+     *  @param f_data          words
+     *  @param f_count         number of the words
+     *  @return                true, when the words are programmed without error
+     */
+    bool CInternalFlash::program(uint32_t f_address, const uint32_t* f_data, uint32_t f_count)
+    {
+        if (0 != (f_address & 3) || !isFree(f_address))
+        {
+            return false;
+        }
+        unlock();
+        FLASH->SR = s_errorFlags | FLASH_SR_EOP;
+        FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+        bool l_res = true;
+        volatile uint32_t* l_dest = reinterpret_cast<volatile uint32_t*>(static_cast<uintptr_t>(f_address));
+        for (uint32_t i = 0; i < f_count && l_res; ++i)
+        {
+            l_dest[i] = f_data[i];
+            l_res = wait();
+        }
+        FLASH->CR = FLASH_CR_LOCK;
+        flushCaches();
+        for (uint32_t i = 0; i < f_count && l_res; ++i)
+        {
+            l_res = (l_dest[i] == f_data[i]);
+        }
+        return l_res;
+    }
+
+    /** \brief  The area isn't used by the program image, the code and the initial values of the data are placed before the given address.
+     *
+     *  @param f_address       start address of the area
+     *  @return                true, when the area can be modified
+     */
+    bool CInternalFlash::isFree(uint32_t f_address)
+    {
+        uintptr_t l_imageEnd = reinterpret_cast<uintptr_t>(&__etext) 
+                             + (reinterpret_cast<uintptr_t>(&__data_end__) - reinterpret_cast<uintptr_t>(&__data_start__));
+        return f_address >= l_imageEnd;
+    }
+
+    /** \brief  Unlock the control register by the key sequence.
+     */
+    void CInternalFlash::unlock()
+    {
+        if (FLASH->CR & FLASH_CR_LOCK)
+        {
+            FLASH->KEYR = 0x45670123U;
+            FLASH->KEYR = 0xCDEF89ABU;
+        }
+    }
+
+    /** \brief  Wait the end of the operation and clear the flags.
+     *
+     *  @return                true, when the operation is finished without error
+     */
+    bool CInternalFlash::wait()
+    {
+        while (FLASH->SR & FLASH_SR_BSY)
+        {
+        }
+        uint32_t l_flags = FLASH->SR;
+        FLASH->SR = s_errorFlags | FLASH_SR_EOP;
+        return 0 == (l_flags & s_errorFlags);
+    }
+
+    /** \brief  Reset the caches of the flash interface, they can contain the content before the operation.
+     */
+    void CInternalFlash::flushCaches()
+    {
+        uint32_t l_acr = FLASH->ACR;
+        FLASH->ACR = l_acr & ~(FLASH_ACR_ICEN | FLASH_ACR_DCEN);
+        FLASH->ACR = (l_acr & ~(FLASH_ACR_ICEN | FLASH_ACR_DCEN)) | FLASH_ACR_ICRST | FLASH_ACR_DCRST;
+        FLASH->ACR = l_acr & ~(FLASH_ACR_ICRST | FLASH_ACR_DCRST);
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    PcSampler.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the program counter sampler
+  *          of the statistical profiler.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/pcsampler.hpp>
+
+/* C part of the interrupt handler */
+extern "C" void pcSamplerIrq(uint32_t f_pc);
+
+namespace hardware::drivers{
+
+    CPcSampler_TIM11::FSampleHook CPcSampler_TIM11::s_hook = NULL;
+
+    /** \brief  Attach the hook, which is applied from interrupt context with each sampled address.
+     *
+     *  @param f_hook          hook function
+     */
+    void CPcSampler_TIM11::attach(FSampleHook f_hook)
+    {
+        s_hook = f_hook;
+    }
+
+    /** \brief  Start the sampling
+     *
+     *  The period is calculated from the timer clock like by the control timer. A frequency, which isn't a multiple of the control 
+     *  frequency, avoids the aliasing with the periodic tasks.
+     *
+     *  @param f_frequency     sampling frequency in Hz
+     *  @return                true, when the frequency can be realized by the timer
+     */
+    bool CPcSampler_TIM11::start(float f_frequency)
+    {
+        uint32_t l_clock = HAL_RCC_GetPCLK2Freq();
+        if ((RCC->CFGR & RCC_CFGR_PPRE2) != 0) // The timer clock is doubled, when the APB2 is prescaled
+        {
+            l_clock *= 2;
+        }
+        if (f_frequency <= 0.0f)
+        {
+            return false;
+        }
+        uint32_t l_ticks = static_cast<uint32_t>(l_clock / f_frequency + 0.5f);
+        uint32_t l_prescaler = (l_ticks - 1) >> 16;
+        if (l_ticks < 2 || l_prescaler > 0xFFFF)
+        {
+            return false;
+        }
+        RCC->APB2ENR |= RCC_APB2ENR_TIM11EN;
+        TIM11->CR1 = 0;
+        TIM11->PSC = l_prescaler;
+        TIM11->ARR = l_ticks / (l_prescaler + 1) - 1;
+        TIM11->EGR = TIM_EGR_UG;                                            // Load the prescaler
+        TIM11->SR = 0;
+        TIM11->DIER = TIM_DIER_UIE;                                          // Update interrupt
+        NVIC_SetVector(TIM1_TRG_COM_TIM11_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CPcSampler_TIM11::timerIrqHandler)));
+        NVIC_SetPriority(TIM1_TRG_COM_TIM11_IRQn, 0);
+        NVIC_EnableIRQ(TIM1_TRG_COM_TIM11_IRQn);
+        TIM11->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+        return true;
+    }
+
+    /** \brief  Stop the sampling
+     */
+    void CPcSampler_TIM11::stop()
+    {
+        TIM11->CR1 &= ~TIM_CR1_CEN;
+        TIM11->DIER = 0;
+        NVIC_DisableIRQ(TIM1_TRG_COM_TIM11_IRQn);
+    }
+
+    /** \brief  Apply the sampled address, it clears the update flag and it applies the hook.
+     *
+     *  @param f_pc            return address of the interrupted context
+     */
+    void CPcSampler_TIM11::sample(uint32_t f_pc)
+    {
+        TIM11->SR = ~TIM_SR_UIF;
+        if (s_hook != NULL)
+        {
+            s_hook(f_pc);
+        }
+    }
+
+    /** \brief  TIM11 update interrupt handler
+     *
+     *  The stacked program counter is the seventh word of the exception frame, the stack is selected by the EXC_RETURN value. 
+     *  The handler is naked, so the frame isn't changed by a prologue.
+     */
+    __attribute__((naked)) void CPcSampler_TIM11::timerIrqHandler()
+    {
+        __asm volatile(
+            "tst lr, #4                 \n"
+            "ite eq                     \n"
+            "mrseq r0, msp              \n"
+            "mrsne r0, psp              \n"
+            "ldr r0, [r0, #24]          \n"
+            "b pcSamplerIrq             \n");
+    }
+
+}; // namespace hardware::drivers
+
+/** \brief  C part of the interrupt handler, the tail call of the naked handler returns from the interrupt.
+ *
+ *  @param f_pc            return address of the interrupted context
+ */
+extern "C" void pcSamplerIrq(uint32_t f_pc)
+{
+    hardware::drivers::CPcSampler_TIM11::sample(f_pc);
+}
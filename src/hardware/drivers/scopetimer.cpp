@@ -0,0 +1,119 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    ScopeTimer.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the sampling timer
+  *          of the signal scope.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/scopetimer.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace hardware::drivers{
+
+    CScopeTimer_TIM9::FSampleHook CScopeTimer_TIM9::s_hook = NULL;
+
+    /** \brief  Clock of the timer, the APB2 timers are clocked by the doubled bus clock, when the bus is prescaled
+     *
+     *  @return                clock frequency in Hz
+     */
+    uint32_t CScopeTimer_TIM9::timerClock()
+    {
+        uint32_t l_clock = HAL_RCC_GetPCLK2Freq();
+        if ((RCC->CFGR & RCC_CFGR_PPRE2) != 0)
+        {
+            l_clock *= 2;
+        }
+        return l_clock;
+    }
+
+    /** \brief  Attach the hook, which is applied from interrupt context in each sampling period.
+     *
+     *  @param f_hook          hook function
+     */
+    void CScopeTimer_TIM9::attach(FSampleHook f_hook)
+    {
+        s_hook = f_hook;
+    }
+
+    /** \brief  Start the sampling
+     *
+     *  The period is calculated from the timer clock like by the program counter sampler, the first hook is applied after a period.
+     *
+     *  @param f_frequency     sampling frequency in Hz
+     *  @return                true, when the frequency can be realized by the timer
+     */
+    bool CScopeTimer_TIM9::start(float f_frequency)
+    {
+        if (f_frequency <= 0.0f)
+        {
+            return false;
+        }
+        uint32_t l_ticks = static_cast<uint32_t>(timerClock() / f_frequency + 0.5f);
+        uint32_t l_prescaler = (l_ticks - 1) >> 16;
+        if (l_ticks < 2 || l_prescaler > 0xFFFF)
+        {
+            return false;
+        }
+        RCC->APB2ENR |= RCC_APB2ENR_TIM9EN;
+        TIM9->CR1 = 0;
+        TIM9->PSC = l_prescaler;
+        TIM9->ARR = l_ticks / (l_prescaler + 1) - 1;
+        TIM9->EGR = TIM_EGR_UG;                                             // Load the prescaler
+        TIM9->SR = 0;
+        TIM9->DIER = TIM_DIER_UIE;                                          // Update interrupt
+        NVIC_SetVector(TIM1_BRK_TIM9_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CScopeTimer_TIM9::timerIrqHandler)));
+        NVIC_SetPriority(TIM1_BRK_TIM9_IRQn, 0);
+        NVIC_EnableIRQ(TIM1_BRK_TIM9_IRQn);
+        TIM9->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+        return true;
+    }
+
+    /** \brief  Stop the sampling, it can be applied from the hook.
+     */
+    void CScopeTimer_TIM9::stop()
+    {
+        TIM9->CR1 &= ~TIM_CR1_CEN;
+        TIM9->DIER = 0;
+        NVIC_DisableIRQ(TIM1_BRK_TIM9_IRQn);
+    }
+
+    /** \brief  Realized sampling frequency, the rounding of the period is applied
+     *
+     *  @return                frequency in Hz
+     */
+    float CScopeTimer_TIM9::getFrequency()
+    {
+        return static_cast<float>(timerClock()) / (static_cast<float>(TIM9->PSC + 1) * static_cast<float>(TIM9->ARR + 1));
+    }
+
+    /** \brief  TIM9 update interrupt handler, it clears the update flag and it applies the hook.
+     */
+    CONTROL_RAMFUNC void CScopeTimer_TIM9::timerIrqHandler()
+    {
+        TIM9->SR = ~TIM_SR_UIF;
+        if (s_hook != NULL)
+        {
+            s_hook();
+        }
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,276 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  * @file    SdCardSpi.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the SD card in SPI mode with DMA sector writes.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/sdcardspi.hpp>
+#include <pinmap.h>
+
+namespace hardware::drivers{
+
+    /** @brief  Timeout of the initialization in microsecond */
+    static const uint32_t s_initTimeout = 1000000;
+    /** @brief  Timeout of the busy state in microsecond */
+    static const uint32_t s_busyTimeout = 500000;
+    /** @brief  Prescaler of the initialization, 42 MHz / 128 = 328 kHz (at most 400 kHz) */
+    static const uint32_t s_slowPrescaler = 6;
+    /** @brief  Prescaler of the data transfer, 42 MHz / 2 = 21 MHz (at most 25 MHz) */
+    static const uint32_t s_fastPrescaler = 0;
+    /** @brief  Start token of a block of the multiple block write */
+    static const uint8_t s_writeToken = 0xFC;
+    /** @brief  Stop token of the multiple block write */
+    static const uint8_t s_stopToken = 0xFD;
+
+    /** \brief  CSdCardSpi_SPI3 class constructor
+     *
+     *  @param f_chipSelect    chip select pin of the card
+     */
+    CSdCardSpi_SPI3::CSdCardSpi_SPI3(PinName f_chipSelect)
+        : m_chipSelect(f_chipSelect)
+        , m_initialized(false)
+        , m_blockAddressing(false)
+    {
+        m_chipSelect.writeFast(true);
+    }
+
+    /** \brief  Initialize the card in SPI mode
+     *
+     *  The card gets at least 74 clocks without chip select, then it's reset (CMD0), the voltage range is checked (CMD8) and the
+     *  initialization is started (ACMD41) until the card is ready. The capacity type is read from the OCR (CMD58), the SDSC cards
+     *  get the 512 byte block length (CMD16). After it the clock is increased to 21 MHz.
+     *
+     *  @return                true, when the card is ready for writing
+     */
+    bool CSdCardSpi_SPI3::initialize()
+    {
+        m_initialized = false;
+        RCC->APB1ENR |= RCC_APB1ENR_SPI3EN;
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+        pin_function(PC_10, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_NOPULL, GPIO_AF6_SPI3));
+        pin_function(PC_11, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLUP, GPIO_AF6_SPI3));
+        pin_function(PC_12, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_NOPULL, GPIO_AF6_SPI3));
+        SPI3->CR2 = 0;
+        setPrescaler(s_slowPrescaler);
+
+        m_chipSelect.writeFast(true);
+        for (uint8_t i = 0; i < 10; ++i)
+        {
+            exchange(0xFF);
+        }
+        m_chipSelect.writeFast(false);
+        bool l_success = (0x01 == command(0, 0));
+        bool l_version2 = false;
+        if (l_success && 0x01 == command(8, 0x1AA))
+        {
+            uint8_t l_echo[4];
+            for (uint8_t i = 0; i < 4; ++i)
+            {
+                l_echo[i] = exchange(0xFF);
+            }
+            l_version2 = true;
+            l_success = (0x01 == (l_echo[2] & 0x0F)) && (0xAA == l_echo[3]);
+        }
+        if (l_success)
+        {
+            uint32_t l_start = us_ticker_read();
+            uint8_t l_response;
+            do
+            {
+                command(55, 0);
+                l_response = command(41, l_version2 ? 0x40000000 : 0);
+            } while (0 != l_response && (us_ticker_read() - l_start) < s_initTimeout);
+            l_success = (0 == l_response);
+        }
+        m_blockAddressing = false;
+        if (l_success && l_version2 && 0 == command(58, 0))
+        {
+            uint8_t l_ocr = exchange(0xFF);
+            for (uint8_t i = 0; i < 3; ++i)
+            {
+                exchange(0xFF);
+            }
+            m_blockAddressing = (0 != (l_ocr & 0x40));
+        }
+        if (l_success && !m_blockAddressing)
+        {
+            l_success = (0 == command(16, s_sectorSize));
+        }
+        m_chipSelect.writeFast(true);
+        exchange(0xFF);
+        if (l_success)
+        {
+            setPrescaler(s_fastPrescaler);
+        }
+        m_initialized = l_success;
+        return l_success;
+    }
+
+    /** \brief  Start the multiple block write (CMD25), the chip select is kept active until the stop.
+     *
+     *  @param f_sector        address of the first sector
+     *  @return                true, when the card accepted the command
+     */
+    bool CSdCardSpi_SPI3::startWrite(uint32_t f_sector)
+    {
+        if (!m_initialized)
+        {
+            return false;
+        }
+        m_chipSelect.writeFast(false);
+        if (!waitReady(s_busyTimeout) || 0 != command(25, m_blockAddressing ? f_sector : f_sector * s_sectorSize))
+        {
+            m_chipSelect.writeFast(true);
+            return false;
+        }
+        exchange(0xFF);
+        return true;
+    }
+
+    /** \brief  Send the start token and start the DMA transfer of a sector, the buffer mustn't change until the end of the transfer.
+     *
+     *  @param f_data          data of the sector (512 byte)
+     *  @return                true, when the transfer was started
+     */
+    bool CSdCardSpi_SPI3::startSector(const uint8_t* f_data)
+    {
+        exchange(s_writeToken);
+        DMA1_Stream7->CR &= ~DMA_SxCR_EN;
+        while (DMA1_Stream7->CR & DMA_SxCR_EN);
+        DMA1->HIFCR = DMA_HIFCR_CTCIF7 | DMA_HIFCR_CHTIF7 | DMA_HIFCR_CTEIF7 | DMA_HIFCR_CDMEIF7 | DMA_HIFCR_CFEIF7;
+        DMA1_Stream7->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&SPI3->DR));
+        DMA1_Stream7->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(f_data));
+        DMA1_Stream7->NDTR = s_sectorSize;
+        DMA1_Stream7->FCR = 0;
+        DMA1_Stream7->CR = DMA_SxCR_MINC | DMA_SxCR_DIR_0;                      // Channel 0 (SPI3_TX), memory to peripheral, 8 bit
+        SPI3->CR2 |= SPI_CR2_TXDMAEN;
+        DMA1_Stream7->CR |= DMA_SxCR_EN;
+        return true;
+    }
+
+    /** \brief  It returns true, when the DMA wrote the sector and the last byte left the shift register.
+     */
+    bool CSdCardSpi_SPI3::isTransferred() const
+    {
+        return (0 != (DMA1->HISR & DMA_HISR_TCIF7)) && (0 != (SPI3->SR & SPI_SR_TXE)) && (0 == (SPI3->SR & SPI_SR_BSY));
+    }
+
+    /** \brief  Finish the sector after the DMA transfer: the received bytes of the transfer are dropped (overrun), the CRC is sent and
+     *  the data response is read. After it the card is busy, until it programs the sector.
+     *
+     *  @return                true, when the card accepted the data
+     */
+    bool CSdCardSpi_SPI3::finishSector()
+    {
+        SPI3->CR2 &= ~SPI_CR2_TXDMAEN;
+        (void)SPI3->DR;                                                         // Clear the overrun of the transfer
+        (void)SPI3->SR;
+        exchange(0xFF);
+        exchange(0xFF);
+        return 0x05 == (exchange(0xFF) & 0x1F);
+    }
+
+    /** \brief  It returns true, when the card isn't busy, it exchanges only one byte.
+     */
+    bool CSdCardSpi_SPI3::isReady()
+    {
+        return 0xFF == exchange(0xFF);
+    }
+
+    /** \brief  Stop the multiple block write by the stop token, it waits the end of the programming.
+     *
+     *  @return                true, when the card finished the programming in time
+     */
+    bool CSdCardSpi_SPI3::stopWrite()
+    {
+        waitReady(s_busyTimeout);
+        exchange(s_stopToken);
+        exchange(0xFF);
+        bool l_success = waitReady(s_busyTimeout);
+        m_chipSelect.writeFast(true);
+        exchange(0xFF);
+        return l_success;
+    }
+
+    /** \brief  Exchange a byte by polling
+     *
+     *  @param f_byte          transmitted byte
+     *  @return                received byte
+     */
+    uint8_t CSdCardSpi_SPI3::exchange(uint8_t f_byte)
+    {
+        while (0 == (SPI3->SR & SPI_SR_TXE));
+        *reinterpret_cast<volatile uint8_t*>(&SPI3->DR) = f_byte;
+        while (0 == (SPI3->SR & SPI_SR_RXNE));
+        return static_cast<uint8_t>(SPI3->DR);
+    }
+
+    /** \brief  Send a command and read the first byte of the response (R1). The CRC is needed only by CMD0 and CMD8.
+     *
+     *  @param f_index         index of the command
+     *  @param f_argument      argument of the command
+     *  @return                R1 response, 0xFF without response
+     */
+    uint8_t CSdCardSpi_SPI3::command(uint8_t f_index, uint32_t f_argument)
+    {
+        exchange(0xFF);
+        exchange(0x40 | f_index);
+        exchange(static_cast<uint8_t>(f_argument >> 24));
+        exchange(static_cast<uint8_t>(f_argument >> 16));
+        exchange(static_cast<uint8_t>(f_argument >> 8));
+        exchange(static_cast<uint8_t>(f_argument));
+        exchange((0 == f_index) ? 0x95 : ((8 == f_index) ? 0x87 : 0x01));
+        uint8_t l_response = 0xFF;
+        for (uint8_t i = 0; i < 10 && (l_response & 0x80); ++i)
+        {
+            l_response = exchange(0xFF);
+        }
+        return l_response;
+    }
+
+    /** \brief  Wait the end of the busy state
+     *
+     *  @param f_timeout       timeout in microsecond
+     *  @return                true, when the card is ready
+     */
+    bool CSdCardSpi_SPI3::waitReady(uint32_t f_timeout)
+    {
+        uint32_t l_start = us_ticker_read();
+        while (!isReady())
+        {
+            if ((us_ticker_read() - l_start) > f_timeout)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** \brief  Set the clock divider of the master, the APB1 clock is divided by 2^(f_prescaler+1).
+     *
+     *  @param f_prescaler     value of the baud rate field
+     */
+    void CSdCardSpi_SPI3::setPrescaler(uint32_t f_prescaler)
+    {
+        SPI3->CR1 = 0;
+        SPI3->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | (f_prescaler << 3);  // Mode 0, 8 bit, MSB first
+        SPI3->CR1 |= SPI_CR1_SPE;
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,465 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    SerialDmaReceiver.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the DMA based serial receiver.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/serialdmareceiver.hpp>
+
+namespace hardware::drivers{
+
+    CSerialDmaReceiver_USART2* CSerialDmaReceiver_USART2::s_instance = NULL;
+    uint32_t CSerialDmaReceiver_USART2::s_prevUsartHandler = 0;
+
+    /** \brief  CSerialDmaReceiver_USART2 class constructor
+     *
+     */
+    CSerialDmaReceiver_USART2::CSerialDmaReceiver_USART2()
+        : m_readIdx(0)
+        , m_readTotal(0)
+        , m_halves(0)
+        , m_errors()
+        , m_callback()
+        , m_scanner()
+        , m_scanTotal(0)
+    {
+    }
+
+    /** \brief  Start the DMA transfer and the interrupts
+     *
+     *  It configures the stream 5 of DMA1 in circular mode for the USART2 receiver, it enables the idle-line interrupt 
+     *  and it installs the interrupt handlers. 
+     */
+    void CSerialDmaReceiver_USART2::start()
+    {
+        s_instance = this;
+        m_readIdx = 0;
+        m_readTotal = 0;
+        m_halves = 0;
+        m_scanTotal = 0;
+
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+        DMA1_Stream5->CR &= ~DMA_SxCR_EN;
+        while (DMA1_Stream5->CR & DMA_SxCR_EN);
+        DMA1->HIFCR = DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5;
+
+        DMA1_Stream5->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&USART2->DR));
+        DMA1_Stream5->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_buffer));
+        DMA1_Stream5->NDTR = s_bufferSize;
+        DMA1_Stream5->FCR = 0;                                                  // Direct mode
+        DMA1_Stream5->CR = DMA_SxCR_CHSEL_2                                     // Channel 4 (USART2_RX)
+                         | DMA_SxCR_PL_1                                        // High priority
+                         | DMA_SxCR_MINC                                        // Memory increment, peripheral to memory, byte size
+                         | DMA_SxCR_CIRC                                        // Circular mode
+                         | DMA_SxCR_HTIE | DMA_SxCR_TCIE;                       // Half and complete transfer interrupts
+
+        NVIC_SetVector(DMA1_Stream5_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CSerialDmaReceiver_USART2::dmaIrqHandler)));
+        NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+
+        s_prevUsartHandler = NVIC_GetVector(USART2_IRQn);
+        NVIC_SetVector(USART2_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CSerialDmaReceiver_USART2::usartIrqHandler)));
+
+        DMA1_Stream5->CR |= DMA_SxCR_EN;
+        USART2->CR1 &= ~USART_CR1_RXNEIE;
+        USART2->CR3 |= USART_CR3_DMAR | USART_CR3_EIE;
+        USART2->CR1 |= USART_CR1_IDLEIE;
+        NVIC_EnableIRQ(USART2_IRQn);
+    }
+
+    /** \brief  Read the available bytes
+     *
+     *  It copies the bytes written by DMA since the last reading. When more bytes were written than the size of the buffer, the unread 
+     *  bytes were partly overwritten, they are discarded and counted as lost.
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_length        size of the destination buffer
+     *  @return                number of copied bytes
+     */
+    uint32_t CSerialDmaReceiver_USART2::read(char* f_buffer, uint32_t f_length)
+    {
+        uint32_t l_written = written();
+        uint32_t l_unread = l_written - m_readTotal;
+        if (l_unread > s_bufferSize)
+        {
+            m_errors.m_overflows++;
+            m_errors.m_lost += l_unread;
+            m_readTotal = l_written;
+            m_readIdx = l_written % s_bufferSize;
+            return 0;
+        }
+        uint32_t l_count = 0;
+        while (l_count < l_unread && l_count < f_length)
+        {
+            f_buffer[l_count++] = m_buffer[m_readIdx];
+            m_readIdx = (m_readIdx + 1 == s_bufferSize) ? 0 : m_readIdx + 1;
+        }
+        m_readTotal += l_count;
+        return l_count;
+    }
+
+    /** \brief  Number of the received, unread bytes, it's larger than the buffer after an overflow.
+     *
+     *  @return                number of the unread bytes
+     */
+    uint32_t CSerialDmaReceiver_USART2::getLevel() const
+    {
+        return written() - m_readTotal;
+    }
+
+    /** \brief  Number of the bytes written by DMA since the start
+     *
+     *  The half buffers are counted by the transfer interrupts, the position in the half is derived from the remaining transfer counter. 
+     *  When the position is already in the next half, but its interrupt is pending, the half is added here.
+     *
+     *  @return                number of the written bytes
+     */
+    uint32_t CSerialDmaReceiver_USART2::written() const
+    {
+        const uint32_t l_half = s_bufferSize / 2;
+        core_util_critical_section_enter();
+        uint32_t l_halves = m_halves;
+        uint32_t l_writeIdx = s_bufferSize - DMA1_Stream5->NDTR;
+        core_util_critical_section_exit();
+        if (l_writeIdx >= s_bufferSize)
+        {
+            l_writeIdx = 0;
+        }
+        if ((l_halves & 1) != l_writeIdx / l_half)
+        {
+            l_halves++;
+        }
+        return l_halves * l_half + l_writeIdx % l_half;
+    }
+
+    /** \brief  Attach the callback, which is applied from interrupt context, when new bytes are received.
+     *
+     *  @param f_callback      callback function
+     */
+    void CSerialDmaReceiver_USART2::attach(mbed::Callback<void()> f_callback)
+    {
+        m_callback = f_callback;
+    }
+
+    /** \brief  Attach the scanner of the received bytes, it's applied from interrupt context before the callback.
+     *
+     *  @param f_scanner       scanner, it gets the contiguous regions of the new bytes
+     */
+    void CSerialDmaReceiver_USART2::attachScanner(utils::serial::ISerialReceiver::FScanner f_scanner)
+    {
+        m_scanner = f_scanner;
+    }
+
+    /** \brief  Pass the bytes written since the last scanning to the scanner, in one or in two regions of the circular buffer. After 
+     *  an overflow only the last buffer is scanned.
+     */
+    void CSerialDmaReceiver_USART2::scan()
+    {
+        if (!m_scanner)
+        {
+            return;
+        }
+        uint32_t l_written = written();
+        if (l_written - m_scanTotal > s_bufferSize)
+        {
+            m_scanTotal = l_written - s_bufferSize;
+        }
+        while (m_scanTotal != l_written)
+        {
+            uint32_t l_idx = m_scanTotal % s_bufferSize;
+            uint32_t l_count = l_written - m_scanTotal;
+            l_count = (l_count < s_bufferSize - l_idx) ? l_count : s_bufferSize - l_idx;
+            m_scanner(const_cast<const char*>(m_buffer) + l_idx, l_count);
+            m_scanTotal += l_count;
+        }
+    }
+
+    /** \brief  USART2 interrupt handler
+     *
+     *  It counts and clears the error flags, it clears the idle-line flag (status register read followed by data register read) and it 
+     *  signals the received frame. Then it applies the previous handler of the vector.
+     */
+    void CSerialDmaReceiver_USART2::usartIrqHandler()
+    {
+        uint32_t l_status = USART2->SR;
+        if ((l_status & (USART_SR_ORE | USART_SR_FE | USART_SR_NE)) && s_instance != NULL)
+        {
+            (void)USART2->DR;
+            s_instance->m_errors.m_overruns += (l_status & USART_SR_ORE) ? 1 : 0;
+            s_instance->m_errors.m_framing += (l_status & USART_SR_FE) ? 1 : 0;
+            s_instance->m_errors.m_noise += (l_status & USART_SR_NE) ? 1 : 0;
+        }
+        if ((USART2->CR1 & USART_CR1_IDLEIE) && (l_status & USART_SR_IDLE))
+        {
+            (void)USART2->DR;
+            if (s_instance != NULL)
+            {
+                s_instance->scan();
+                if (s_instance->m_callback)
+                {
+                    s_instance->m_callback();
+                }
+            }
+        }
+        if (s_prevUsartHandler != 0)
+        {
+            reinterpret_cast<void(*)()>(s_prevUsartHandler)();
+        }
+    }
+
+    /** \brief  DMA1 stream 5 interrupt handler
+     *
+     *  It clears the half and complete transfer flags, it counts the written halves and it signals the received bytes, so the buffer is 
+     *  read before it's overwritten. 
+     */
+    void CSerialDmaReceiver_USART2::dmaIrqHandler()
+    {
+        uint32_t l_flags = DMA1->HISR & (DMA_HISR_TCIF5 | DMA_HISR_HTIF5);
+        DMA1->HIFCR = DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5;
+        if (l_flags && s_instance != NULL)
+        {
+            s_instance->m_halves += ((l_flags & DMA_HISR_HTIF5) ? 1 : 0) + ((l_flags & DMA_HISR_TCIF5) ? 1 : 0);
+            s_instance->scan();
+            if (s_instance->m_callback)
+            {
+                s_instance->m_callback();
+            }
+        }
+    }
+
+    CSerialDmaReceiver_USART6* CSerialDmaReceiver_USART6::s_instance = NULL;
+    uint32_t CSerialDmaReceiver_USART6::s_prevUsartHandler = 0;
+
+    /** \brief  CSerialDmaReceiver_USART6 class constructor
+     *
+     */
+    CSerialDmaReceiver_USART6::CSerialDmaReceiver_USART6()
+        : m_readIdx(0)
+        , m_readTotal(0)
+        , m_halves(0)
+        , m_errors()
+        , m_callback()
+        , m_scanner()
+        , m_scanTotal(0)
+    {
+    }
+
+    /** \brief  Start the DMA transfer and the interrupts
+     *
+     *  It configures the stream 1 of DMA2 in circular mode for the USART6 receiver, it enables the idle-line interrupt 
+     *  and it installs the interrupt handlers. 
+     */
+    void CSerialDmaReceiver_USART6::start()
+    {
+        s_instance = this;
+        m_readIdx = 0;
+        m_readTotal = 0;
+        m_halves = 0;
+        m_scanTotal = 0;
+
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+        DMA2_Stream1->CR &= ~DMA_SxCR_EN;
+        while (DMA2_Stream1->CR & DMA_SxCR_EN);
+        DMA2->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+
+        DMA2_Stream1->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&USART6->DR));
+        DMA2_Stream1->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_buffer));
+        DMA2_Stream1->NDTR = s_bufferSize;
+        DMA2_Stream1->FCR = 0;                                                  // Direct mode
+        DMA2_Stream1->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_CHSEL_0                   // Channel 5 (USART6_RX)
+                         | DMA_SxCR_PL_1                                        // High priority
+                         | DMA_SxCR_MINC                                        // Memory increment, peripheral to memory, byte size
+                         | DMA_SxCR_CIRC                                        // Circular mode
+                         | DMA_SxCR_HTIE | DMA_SxCR_TCIE;                       // Half and complete transfer interrupts
+
+        NVIC_SetVector(DMA2_Stream1_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CSerialDmaReceiver_USART6::dmaIrqHandler)));
+        NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+
+        s_prevUsartHandler = NVIC_GetVector(USART6_IRQn);
+        NVIC_SetVector(USART6_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CSerialDmaReceiver_USART6::usartIrqHandler)));
+
+        DMA2_Stream1->CR |= DMA_SxCR_EN;
+        USART6->CR1 &= ~USART_CR1_RXNEIE;
+        USART6->CR3 |= USART_CR3_DMAR | USART_CR3_EIE;
+        USART6->CR1 |= USART_CR1_IDLEIE;
+        NVIC_EnableIRQ(USART6_IRQn);
+    }
+
+    /** \brief  Read the available bytes
+     *
+     *  It copies the bytes written by DMA since the last reading. When more bytes were written than the size of the buffer, the unread 
+     *  bytes were partly overwritten, they are discarded and counted as lost.
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_length        size of the destination buffer
+     *  @return                number of copied bytes
+     */
+    uint32_t CSerialDmaReceiver_USART6::read(char* f_buffer, uint32_t f_length)
+    {
+        uint32_t l_written = written();
+        uint32_t l_unread = l_written - m_readTotal;
+        if (l_unread > s_bufferSize)
+        {
+            m_errors.m_overflows++;
+            m_errors.m_lost += l_unread;
+            m_readTotal = l_written;
+            m_readIdx = l_written % s_bufferSize;
+            return 0;
+        }
+        uint32_t l_count = 0;
+        while (l_count < l_unread && l_count < f_length)
+        {
+            f_buffer[l_count++] = m_buffer[m_readIdx];
+            m_readIdx = (m_readIdx + 1 == s_bufferSize) ? 0 : m_readIdx + 1;
+        }
+        m_readTotal += l_count;
+        return l_count;
+    }
+
+    /** \brief  Number of the received, unread bytes, it's larger than the buffer after an overflow.
+     *
+     *  @return                number of the unread bytes
+     */
+    uint32_t CSerialDmaReceiver_USART6::getLevel() const
+    {
+        return written() - m_readTotal;
+    }
+
+    /** \brief  Number of the bytes written by DMA since the start
+     *
+     *  The half buffers are counted by the transfer interrupts, the position in the half is derived from the remaining transfer counter. 
+     *  When the position is already in the next half, but its interrupt is pending, the half is added here.
+     *
+     *  @return                number of the written bytes
+     */
+    uint32_t CSerialDmaReceiver_USART6::written() const
+    {
+        const uint32_t l_half = s_bufferSize / 2;
+        core_util_critical_section_enter();
+        uint32_t l_halves = m_halves;
+        uint32_t l_writeIdx = s_bufferSize - DMA2_Stream1->NDTR;
+        core_util_critical_section_exit();
+        if (l_writeIdx >= s_bufferSize)
+        {
+            l_writeIdx = 0;
+        }
+        if ((l_halves & 1) != l_writeIdx / l_half)
+        {
+            l_halves++;
+        }
+        return l_halves * l_half + l_writeIdx % l_half;
+    }
+
+    /** \brief  Attach the callback, which is applied from interrupt context, when new bytes are received.
+     *
+     *  @param f_callback      callback function
+     */
+    void CSerialDmaReceiver_USART6::attach(mbed::Callback<void()> f_callback)
+    {
+        m_callback = f_callback;
+    }
+
+    /** \brief  Attach the scanner of the received bytes, it's applied from interrupt context before the callback.
+     *
+     *  @param f_scanner       scanner, it gets the contiguous regions of the new bytes
+     */
+    void CSerialDmaReceiver_USART6::attachScanner(utils::serial::ISerialReceiver::FScanner f_scanner)
+    {
+        m_scanner = f_scanner;
+    }
+
+    /** \brief  Pass the bytes written since the last scanning to the scanner, in one or in two regions of the circular buffer. After 
+     *  an overflow only the last buffer is scanned.
+     */
+    void CSerialDmaReceiver_USART6::scan()
+    {
+        if (!m_scanner)
+        {
+            return;
+        }
+        uint32_t l_written = written();
+        if (l_written - m_scanTotal > s_bufferSize)
+        {
+            m_scanTotal = l_written - s_bufferSize;
+        }
+        while (m_scanTotal != l_written)
+        {
+            uint32_t l_idx = m_scanTotal % s_bufferSize;
+            uint32_t l_count = l_written - m_scanTotal;
+            l_count = (l_count < s_bufferSize - l_idx) ? l_count : s_bufferSize - l_idx;
+            m_scanner(const_cast<const char*>(m_buffer) + l_idx, l_count);
+            m_scanTotal += l_count;
+        }
+    }
+
+    /** \brief  USART6 interrupt handler
+     *
+     *  It counts and clears the error flags, it clears the idle-line flag (status register read followed by data register read) and it 
+     *  signals the received frame. Then it applies the previous handler of the vector.
+     */
+    void CSerialDmaReceiver_USART6::usartIrqHandler()
+    {
+        uint32_t l_status = USART6->SR;
+        if ((l_status & (USART_SR_ORE | USART_SR_FE | USART_SR_NE)) && s_instance != NULL)
+        {
+            (void)USART6->DR;
+            s_instance->m_errors.m_overruns += (l_status & USART_SR_ORE) ? 1 : 0;
+            s_instance->m_errors.m_framing += (l_status & USART_SR_FE) ? 1 : 0;
+            s_instance->m_errors.m_noise += (l_status & USART_SR_NE) ? 1 : 0;
+        }
+        if ((USART6->CR1 & USART_CR1_IDLEIE) && (l_status & USART_SR_IDLE))
+        {
+            (void)USART6->DR;
+            if (s_instance != NULL)
+            {
+                s_instance->scan();
+                if (s_instance->m_callback)
+                {
+                    s_instance->m_callback();
+                }
+            }
+        }
+        if (s_prevUsartHandler != 0)
+        {
+            reinterpret_cast<void(*)()>(s_prevUsartHandler)();
+        }
+    }
+
+    /** \brief  DMA2 stream 1 interrupt handler
+     *
+     *  It clears the half and complete transfer flags, it counts the written halves and it signals the received bytes, so the buffer is 
+     *  read before it's overwritten. 
+     */
+    void CSerialDmaReceiver_USART6::dmaIrqHandler()
+    {
+        uint32_t l_flags = DMA2->LISR & (DMA_LISR_TCIF1 | DMA_LISR_HTIF1);
+        DMA2->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+        if (l_flags && s_instance != NULL)
+        {
+            s_instance->m_halves += ((l_flags & DMA_LISR_HTIF1) ? 1 : 0) + ((l_flags & DMA_LISR_TCIF1) ? 1 : 0);
+            s_instance->scan();
+            if (s_instance->m_callback)
+            {
+                s_instance->m_callback();
+            }
+        }
+    }
+
+}; // namespace hardware::drivers
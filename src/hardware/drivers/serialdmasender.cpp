@@ -0,0 +1,167 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    SerialDmaSender.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the DMA based serial sender.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/serialdmasender.hpp>
+
+namespace hardware::drivers{
+
+    CSerialDmaSender_USART2* CSerialDmaSender_USART2::s_instance = NULL;
+
+    /** \brief  CSerialDmaSender_USART2 class constructor
+     *
+     *  The stream is configured at the first transmission, after the serial object was initialized.
+     */
+    CSerialDmaSender_USART2::CSerialDmaSender_USART2()
+        : m_initialized(false)
+        , m_callback()
+    {
+    }
+
+    /** \brief  Start the transmission of a block
+     *
+     *  The previous transmission has to be finished, the block has to remain valid until the callback is applied. 
+     *
+     *  @param f_data          pointer to the first byte
+     *  @param f_length        number of bytes
+     */
+    void CSerialDmaSender_USART2::send(const char* f_data, uint32_t f_length)
+    {
+        if (!m_initialized)
+        {
+            s_instance = this;
+            RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+            NVIC_SetVector(DMA1_Stream6_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CSerialDmaSender_USART2::dmaIrqHandler)));
+            NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+            USART2->CR3 |= USART_CR3_DMAT;
+            m_initialized = true;
+        }
+        DMA1_Stream6->CR &= ~DMA_SxCR_EN;
+        while (DMA1_Stream6->CR & DMA_SxCR_EN);
+        DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+
+        DMA1_Stream6->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&USART2->DR));
+        DMA1_Stream6->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(f_data));
+        DMA1_Stream6->NDTR = f_length;
+        DMA1_Stream6->FCR = 0;                                                  // Direct mode
+        DMA1_Stream6->CR = DMA_SxCR_CHSEL_2                                     // Channel 4 (USART2_TX)
+                         | DMA_SxCR_PL_1                                        // High priority
+                         | DMA_SxCR_MINC                                        // Memory increment, byte size
+                         | DMA_SxCR_DIR_0                                       // Memory to peripheral
+                         | DMA_SxCR_TCIE;                                       // Transfer complete interrupt
+        DMA1_Stream6->CR |= DMA_SxCR_EN;
+    }
+
+    /** \brief  Attach the callback, which is applied from interrupt context, when the block was transmitted.
+     *
+     *  @param f_callback      callback function
+     */
+    void CSerialDmaSender_USART2::attach(mbed::Callback<void()> f_callback)
+    {
+        m_callback = f_callback;
+    }
+
+    /** \brief  DMA1 stream 6 interrupt handler
+     *
+     *  It clears the flags of the stream and it signals the end of the transmission. 
+     */
+    void CSerialDmaSender_USART2::dmaIrqHandler()
+    {
+        uint32_t l_flags = DMA1->HISR & DMA_HISR_TCIF6;
+        DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+        if (l_flags && s_instance != NULL && s_instance->m_callback)
+        {
+            s_instance->m_callback();
+        }
+    }
+
+    CSerialDmaSender_USART6* CSerialDmaSender_USART6::s_instance = NULL;
+
+    /** \brief  CSerialDmaSender_USART6 class constructor
+     *
+     *  The stream is configured at the first transmission, after the serial object was initialized.
+     */
+    CSerialDmaSender_USART6::CSerialDmaSender_USART6()
+        : m_initialized(false)
+        , m_callback()
+    {
+    }
+
+    /** \brief  Start the transmission of a block
+     *
+     *  The previous transmission has to be finished, the block has to remain valid until the callback is applied. 
+     *
+     *  @param f_data          pointer to the first byte
+     *  @param f_length        number of bytes
+     */
+    void CSerialDmaSender_USART6::send(const char* f_data, uint32_t f_length)
+    {
+        if (!m_initialized)
+        {
+            s_instance = this;
+            RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+            NVIC_SetVector(DMA2_Stream6_IRQn, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&CSerialDmaSender_USART6::dmaIrqHandler)));
+            NVIC_EnableIRQ(DMA2_Stream6_IRQn);
+            USART6->CR3 |= USART_CR3_DMAT;
+            m_initialized = true;
+        }
+        DMA2_Stream6->CR &= ~DMA_SxCR_EN;
+        while (DMA2_Stream6->CR & DMA_SxCR_EN);
+        DMA2->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+
+        DMA2_Stream6->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&USART6->DR));
+        DMA2_Stream6->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(f_data));
+        DMA2_Stream6->NDTR = f_length;
+        DMA2_Stream6->FCR = 0;                                                  // Direct mode
+        DMA2_Stream6->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_CHSEL_0                   // Channel 5 (USART6_TX)
+                         | DMA_SxCR_PL_1                                        // High priority
+                         | DMA_SxCR_MINC                                        // Memory increment, byte size
+                         | DMA_SxCR_DIR_0                                       // Memory to peripheral
+                         | DMA_SxCR_TCIE;                                       // Transfer complete interrupt
+        DMA2_Stream6->CR |= DMA_SxCR_EN;
+    }
+
+    /** \brief  Attach the callback, which is applied from interrupt context, when the block was transmitted.
+     *
+     *  @param f_callback      callback function
+     */
+    void CSerialDmaSender_USART6::attach(mbed::Callback<void()> f_callback)
+    {
+        m_callback = f_callback;
+    }
+
+    /** \brief  DMA2 stream 6 interrupt handler
+     *
+     *  It clears the flags of the stream and it signals the end of the transmission. 
+     */
+    void CSerialDmaSender_USART6::dmaIrqHandler()
+    {
+        uint32_t l_flags = DMA2->HISR & DMA_HISR_TCIF6;
+        DMA2->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+        if (l_flags && s_instance != NULL && s_instance->m_callback)
+        {
+            s_instance->m_callback();
+        }
+    }
+
+}; // namespace hardware::drivers
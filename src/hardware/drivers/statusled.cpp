@@ -0,0 +1,107 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+  * @file    StatusLed.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the DMA driven blink patterns of the status led.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/statusled.hpp>
+#include <pinmap.h>
+
+namespace hardware::drivers{
+
+    /** \brief  CStatusLed_TIM1 class constructor
+     *
+     *  The led is off until the start.
+     */
+    CStatusLed_TIM1::CStatusLed_TIM1()
+        : m_buffer()
+        , m_pattern(0)
+    {
+        setPattern(0);
+    }
+
+    /** \brief  Start the pattern output
+     *
+     *  The TIM1 counts with 10 kHz, its update event requests the DMA in each step. The DMA2 can access the AHB1 port registers, 
+     *  the DMA1 cannot.
+     */
+    void CStatusLed_TIM1::start()
+    {
+        RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+        pin_function(PA_5, STM_PIN_DATA(STM_MODE_OUTPUT_PP, GPIO_NOPULL, 0));
+
+        TIM1->CR1 = 0;
+        TIM1->PSC = SystemCoreClock / 10000 - 1;                                // APB2 timer clock is the core clock
+        TIM1->ARR = 10000 / s_stepFrequency - 1;
+        TIM1->EGR = TIM_EGR_UG;                                                 // Load the prescaler
+        TIM1->SR = 0;
+        TIM1->DIER = TIM_DIER_UDE;                                              // DMA request on update
+
+        DMA2_Stream5->CR &= ~DMA_SxCR_EN;
+        while (DMA2_Stream5->CR & DMA_SxCR_EN);
+        DMA2->HIFCR = DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5;
+        DMA2_Stream5->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&GPIOA->BSRR));
+        DMA2_Stream5->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_buffer));
+        DMA2_Stream5->NDTR = s_steps;
+        DMA2_Stream5->FCR = 0;                                                  // Direct mode
+        DMA2_Stream5->CR = DMA_SxCR_CHSEL_2 | DMA_SxCR_CHSEL_1                  // Channel 6 (TIM1_UP)
+                         | DMA_SxCR_MSIZE_1                                     // Memory word
+                         | DMA_SxCR_PSIZE_1                                     // Peripheral word
+                         | DMA_SxCR_MINC                                        // Memory increment
+                         | DMA_SxCR_CIRC                                        // Circular
+                         | DMA_SxCR_DIR_0;                                      // Memory to peripheral
+        DMA2_Stream5->CR |= DMA_SxCR_EN;
+
+        TIM1->CR1 = TIM_CR1_CEN;
+    }
+
+    /** \brief  Set the pattern
+     *
+     *  The buffer is rewritten, while the DMA reads it, so the cycle of the change can mix the two patterns.
+     *
+     *  @param f_pattern       the bit i is the state of the led in the step i
+     */
+    void CStatusLed_TIM1::setPattern(uint32_t f_pattern)
+    {
+        for (uint8_t i = 0; i < s_steps; ++i)
+        {
+            m_buffer[i] = (f_pattern & (1UL << i)) ? GPIO_BSRR_BS_5 : GPIO_BSRR_BR_5;
+        }
+        m_pattern = f_pattern;
+    }
+
+    /** \brief  Pattern of short flashes
+     *
+     *  Each flash is one step on and two steps off, the rest of the cycle is off, so the flashes are counted easily.
+     *
+     *  @param f_count         number of the flashes, one to ten
+     *  @return                pattern
+     */
+    uint32_t CStatusLed_TIM1::flashes(uint8_t f_count)
+    {
+        uint32_t l_pattern = 0;
+        for (uint8_t i = 0; i < f_count && 3 * i < s_steps; ++i)
+        {
+            l_pattern |= 1UL << (3 * i);
+        }
+        return l_pattern;
+    }
+
+}; // namespace hardware::drivers
@@ -24,6 +24,7 @@ limitations under the License.
  */
 
 #include <hardware/drivers/steeringmotor.hpp>
+#include <utils/memory/sections.hpp>
 
 
 namespace hardware::drivers{
@@ -49,10 +50,23 @@ namespace hardware::drivers{
         :m_pwm(f_pwm)
         ,m_inf_limit(f_inf_limit)
         ,m_sup_limit(f_sup_limit)
+        ,m_slope(0.0009505)
+        ,m_offset(0.07525)
+        ,m_lutAngles()
+        ,m_lutDuties()
+        ,m_lutCount(0)
+        ,m_maxStep(0.0f)
+        ,m_duty(0.07525)
+        ,m_fastPath(false)
+        ,m_frame(s_analogFrame)
+        ,m_minPulse(0.0f)
+        ,m_maxPulse(s_analogFrame)
+        ,m_angle(0.0f)
     {
         m_pwm.period_ms(20); 
+        m_pwm.latch();
         // Set position to zero   
-        m_pwm.write(0.07525);
+        m_pwm.write(m_offset);
     };
 
 
@@ -62,23 +76,56 @@ namespace hardware::drivers{
     {
     };
 
-    /** @brief  It modifies the angle of the servo motor, which controls the steering wheels. 
+    /** @brief  It modifies the angle of the servo motor, which controls the steering wheels. With slew rate limit the applied angle 
+     *  changes with at most the limited step toward the command, so it has to be called periodically. The output is written only, when 
+     *  the duty cycle changes.
      *
      *  @param f_angle      angle degree, where the positive value means right direction and negative value the left direction. 
      */
-    void CSteeringMotor::setAngle(float f_angle)
+    CONTROL_RAMFUNC void CSteeringMotor::setAngle(float f_angle)
     {
-        m_pwm.write(conversion(f_angle));
+        float l_angle = f_angle;
+        if (m_maxStep > 0.0f)
+        {
+            float l_prev = m_angle;
+            l_angle = (f_angle > l_prev + m_maxStep) ? l_prev + m_maxStep : ((f_angle < l_prev - m_maxStep) ? l_prev - m_maxStep : f_angle);
+        }
+        m_angle = l_angle;
+        float l_pulse = conversion(l_angle) * s_analogFrame;
+        l_pulse = (l_pulse < m_minPulse) ? m_minPulse : ((l_pulse > m_maxPulse) ? m_maxPulse : l_pulse);
+        float l_duty = l_pulse / m_frame;
+        if (l_duty == m_duty)
+        {
+            return;
+        }
+        m_duty = l_duty;
+        if (m_fastPath)
+        {
+            m_pwm.writeFast(l_duty);
+            return;
+        }
+        m_pwm.write(l_duty);
     };
 
-    /** @brief  It converts angle degree to duty cycle for pwm signal. 
+    /** @brief  It converts angle degree to duty cycle for pwm signal. The calibration table is interpolated linearly, 
+     *  outside of its range the first and the last segments are extrapolated.
      * 
      *  @param f_angle    angle degree
      *  \return         duty cycle in interval [0,1]
      */
     float CSteeringMotor::conversion(float f_angle)
     {
-        return (0.0009505 * f_angle + 0.07525);
+        if (m_lutCount < 2)
+        {
+            return (m_slope * f_angle + m_offset);
+        }
+        uint8_t l_idx = 1;
+        while (l_idx < m_lutCount - 1 && f_angle > m_lutAngles[l_idx])
+        {
+            ++l_idx;
+        }
+        float l_frac = (f_angle - m_lutAngles[l_idx-1]) / (m_lutAngles[l_idx] - m_lutAngles[l_idx-1]);
+        return m_lutDuties[l_idx-1] + l_frac * (m_lutDuties[l_idx] - m_lutDuties[l_idx-1]);
     };
 
     /**
@@ -91,4 +138,93 @@ namespace hardware::drivers{
     bool CSteeringMotor::inRange(float f_angle){
         return m_inf_limit<=f_angle && f_angle<=m_sup_limit;
     };
+
+    /**
+     * @brief It enables the direct register access of the output. After the activation the duty cycle read by the PwmOut object isn't updated.
+     * 
+     * @param f_enable activation state
+     */
+    void CSteeringMotor::setFastPath(bool f_enable){
+        m_fastPath = f_enable;
+    };
+
+    /**
+     * @brief It sets the linear conversion from angle to duty cycle (calibration of the servo), the last angle is applied with the new conversion.
+     * It has to be applied before the start of the control loop.
+     * 
+     * @param f_slope  duty cycle per degree
+     * @param f_offset duty cycle of the zero position
+     */
+    void CSteeringMotor::setConversion(float f_slope, float f_offset){
+        m_slope = f_slope;
+        m_offset = f_offset;
+        m_lutCount = 0;
+        m_duty = -1.0f;
+        setAngle(m_angle);
+    };
+
+    /**
+     * @brief It sets the calibration table of the servo, the measured duty cycles at the given angles. The last angle is applied with the new conversion. 
+     * It has to be applied before the start of the control loop.
+     * 
+     * @param f_angles  angles in degree, in strictly increasing order
+     * @param f_duties  duty cycles of the angles
+     * @param f_count   number of the points, from 2 to s_maxPoints
+     * @return true     when the table is valid, otherwise the previous conversion remains
+     */
+    bool CSteeringMotor::setCalibration(const float* f_angles, const float* f_duties, uint8_t f_count){
+        if (f_count < 2 || f_count > s_maxPoints){
+            return false;
+        }
+        for (uint8_t i = 1; i < f_count; ++i){
+            if (!(f_angles[i] > f_angles[i-1])){
+                return false;
+            }
+        }
+        for (uint8_t i = 0; i < f_count; ++i){
+            m_lutAngles[i] = f_angles[i];
+            m_lutDuties[i] = f_duties[i];
+        }
+        m_lutCount = f_count;
+        m_duty = -1.0f;
+        setAngle(m_angle);
+        return true;
+    };
+
+    /**
+     * @brief It sets the slew rate limit of the applied angle, the step of a call is the rate multiplied by the period of the calls.
+     * 
+     * @param f_rate    maximum rate in degree per second, zero disables the limit
+     * @param f_period  period of the 'setAngle' calls in second
+     */
+    void CSteeringMotor::setSlewRate(float f_rate, float f_period){
+        m_maxStep = (f_rate > 0.0f) ? f_rate * f_period : 0.0f;
+    };
+
+    /**
+     * @brief It sets the frame period and the pulse range of the servo, for example 3 ms (333 Hz) and 500-2500 us for a digital servo. 
+     * The conversion keeps the pulse widths, the duty cycle is scaled to the frame. With a frame shorter than the analog one the compare 
+     * register is preloaded, so the pulse is changed at the start of the next frame. The last angle is applied with the new frame. 
+     * It has to be applied before the start of the control loop.
+     * 
+     * @param f_period    frame period in second
+     * @param f_minPulse  shortest pulse in microsecond
+     * @param f_maxPulse  longest pulse in microsecond, it has to fit in the frame
+     * @return true       when the range is valid, otherwise the previous frame remains
+     */
+    bool CSteeringMotor::setFrame(float f_period, float f_minPulse, float f_maxPulse){
+        float l_frame = f_period * 1000000.0f;
+        if (!(f_minPulse >= 0.0f && f_minPulse < f_maxPulse && f_maxPulse < l_frame)){
+            return false;
+        }
+        m_frame = l_frame;
+        m_minPulse = f_minPulse;
+        m_maxPulse = f_maxPulse;
+        m_pwm.period_us(static_cast<int>(l_frame + 0.5f));
+        m_pwm.latch();
+        m_pwm.setPreload(l_frame < s_analogFrame);
+        m_duty = -1.0f;
+        setAngle(m_angle);
+        return true;
+    };
 }; // namespace hardware::drivers
\ No newline at end of file
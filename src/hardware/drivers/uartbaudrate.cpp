@@ -0,0 +1,88 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    UartBaudRate.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the baud rate setting
+  *          of the running UART interfaces.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/uartbaudrate.hpp>
+
+namespace hardware::drivers{
+
+    /** \brief  Set the baud rate
+     *
+     *  It waits for the end of the transmitted byte, then it writes the divider with disabled interface. The enabled DMA requests 
+     *  and interrupts aren't changed.
+     *
+     *  @param f_uart          UART instance (USART1, USART2, USART6)
+     *  @param f_baud          baud rate
+     *  @return                false, when the rate can't be realized with 2% error
+     */
+    bool CUartBaudRate::set(USART_TypeDef* f_uart, uint32_t f_baud)
+    {
+        uint32_t l_clock = clock(f_uart);
+        if (f_baud == 0 || l_clock / f_baud < 8)
+        {
+            return false;
+        }
+        bool l_isOver8 = l_clock / f_baud < 16;
+        uint32_t l_divider = (l_clock + f_baud / 2) / f_baud;                  // Divider in 1/16 (or 1/8) bit
+        uint32_t l_brr = l_isOver8 ? (((l_divider >> 3) << 4) | (l_divider & 0x7)) : l_divider;
+        uint32_t l_real = l_clock / l_divider;
+        uint32_t l_error = (l_real > f_baud ? l_real - f_baud : f_baud - l_real) * 1000 / f_baud;
+        if (l_error > s_maxError)
+        {
+            return false;
+        }
+        for (uint32_t l_wait = 0; l_wait < 100000 && !(f_uart->SR & USART_SR_TC); ++l_wait)
+        {
+        }
+        f_uart->CR1 &= ~USART_CR1_UE;
+        f_uart->CR1 = l_isOver8 ? (f_uart->CR1 | USART_CR1_OVER8) : (f_uart->CR1 & ~USART_CR1_OVER8);
+        f_uart->BRR = l_brr;
+        f_uart->CR1 |= USART_CR1_UE;
+        return true;
+    }
+
+    /** \brief  Get the realized baud rate
+     *
+     *  @param f_uart          UART instance
+     *  @return                baud rate
+     */
+    uint32_t CUartBaudRate::get(USART_TypeDef* f_uart)
+    {
+        uint32_t l_brr = f_uart->BRR;
+        uint32_t l_divider = (f_uart->CR1 & USART_CR1_OVER8) ? (((l_brr >> 4) << 3) | (l_brr & 0x7)) : l_brr;
+        return (l_divider > 0) ? clock(f_uart) / l_divider : 0;
+    }
+
+    /** \brief  Clock of the interface, the USART1 and USART6 are on APB2, the USART2 on APB1
+     *
+     *  @param f_uart          UART instance
+     *  @return                clock in Hz
+     */
+    uint32_t CUartBaudRate::clock(USART_TypeDef* f_uart)
+    {
+        return (f_uart == USART1 || f_uart == USART6) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Watchdog.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the independent watchdog.
+  ******************************************************************************
+ */
+
+#include <hardware/drivers/watchdog.hpp>
+
+namespace hardware::drivers{
+
+    /** \brief  Start the watchdog
+     *
+     *  The smallest prescaler is selected, which can realize the timeout with the 12 bit reload value. The timeout is calculated 
+     *  with the nominal frequency of the oscillator (LSI_VALUE), the real frequency can differ, so it has to have margin.
+     *
+     *  @param f_timeout       timeout in second
+     *  @return                true, when the timeout can be realized by the watchdog
+     */
+    bool CWatchdog_IWDG::start(float f_timeout)
+    {
+        uint32_t l_ticks = static_cast<uint32_t>(f_timeout * LSI_VALUE / 4.0f + 0.5f);
+        uint32_t l_prescaler = 0;
+        while (l_ticks > 0x1000 && l_prescaler < 6)
+        {
+            l_ticks = (l_ticks + 1) / 2;
+            l_prescaler++;
+        }
+        if (l_ticks == 0 || l_ticks > 0x1000)
+        {
+            return false;
+        }
+        DBGMCU->APB1FZ |= DBGMCU_APB1_FZ_DBG_IWDG_STOP;                     // Frozen, while the core is halted
+        IWDG->KR = 0xCCCC;                                                  // Start the watchdog
+        IWDG->KR = 0x5555;                                                  // Enable the access of the prescaler and of the reload
+        IWDG->PR = l_prescaler;
+        IWDG->RLR = l_ticks - 1;
+        while (IWDG->SR != 0)                                               // Wait the update of the registers
+        {
+        }
+        IWDG->KR = 0xAAAA;
+        return true;
+    }
+
+    /** \brief  Refresh the watchdog, it reloads the counter.
+     */
+    void CWatchdog_IWDG::kick()
+    {
+        IWDG->KR = 0xAAAA;
+    }
+
+    /** \brief  The last reset was caused by the watchdog, the reset flags are cleared.
+     *
+     *  @return                true after a watchdog reset
+     */
+    bool CWatchdog_IWDG::wasReset()
+    {
+        bool l_res = (RCC->CSR & RCC_CSR_WDGRSTF) != 0;
+        RCC->CSR |= RCC_CSR_RMVF;
+        return l_res;
+    }
+
+}; // namespace hardware::drivers
@@ -0,0 +1,170 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+ * @file encodermonitor.cpp
+ * @author RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#include <hardware/encoders/encodermonitor.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Construct a new CEncoderMonitor object
+ * 
+ * @param f_period      Period of the tick in second
+ * @param f_encoder     Monitored encoder
+ * @param f_resolution  Resolution of the encoder (impulses per rotation)
+ * @param f_params      Parameters of the motor model and of the checks
+ */
+CEncoderMonitor::CEncoderMonitor(float f_period, IEncoderGetter& f_encoder, uint16_t f_resolution, const SParams& f_params)
+    :m_encoder(f_encoder)
+    ,m_countToRps(1.0f / f_resolution / f_period)
+    ,m_params(f_params)
+    ,m_pwm()
+    ,m_current()
+    ,m_callback()
+    ,m_prevCount(0)
+    ,m_lastNonZero(0)
+    ,m_zeroTicks(0)
+    ,m_health(1.0f)
+    ,m_degraded(false)
+    ,m_faults(0)
+    ,m_degradations(0)
+{
+}
+
+/**
+ * @brief Set the inputs of the motor model.
+ * 
+ * @param f_pwm     Getter of the signed commanded pwm
+ * @param f_current Getter of the current magnitude (A), its sign is the sign of the pwm
+ */
+void CEncoderMonitor::setInputs(mbed::Callback<float()> f_pwm, mbed::Callback<float()> f_current){
+    m_pwm = f_pwm;
+    m_current = f_current;
+}
+
+/**
+ * @brief Set the callback of the degraded state, it's applied in the tick.
+ * 
+ * @param f_callback Callback with the new state
+ */
+void CEncoderMonitor::setCallback(FDegradedCallback f_callback){
+    m_callback = f_callback;
+}
+
+/**
+ * @brief Check the count of the tick.
+ * 
+ * @param f_count    Counted impulses of the tick
+ * @param f_modelRps Speed estimated by the back-EMF
+ * @return Fault flags of the tick
+ */
+uint32_t CEncoderMonitor::check(int16_t f_count, float f_modelRps){
+    uint32_t l_faults = 0;
+    int32_t l_jump = static_cast<int32_t>(f_count) - m_prevCount;
+    if(l_jump > m_params.m_maxJump || l_jump < -m_params.m_maxJump){
+        l_faults |= FAULT_JUMP;
+    }
+    if(std::abs(f_modelRps) < m_params.m_activeRps){
+        m_zeroTicks = 0;
+        return l_faults;
+    }
+    if(0 == f_count){
+        if(++m_zeroTicks >= s_stuckTicks){
+            m_zeroTicks = s_stuckTicks;
+            l_faults |= FAULT_STUCK;
+        }
+        return l_faults;
+    }
+    m_zeroTicks = 0;
+    float l_measuredRps = f_count * m_countToRps;
+    if((f_count > 0) != (f_modelRps > 0)){
+        l_faults |= FAULT_DIRECTION;
+    }else if(std::abs(l_measuredRps - f_modelRps) > m_params.m_tolerance * std::abs(f_modelRps)){
+        l_faults |= FAULT_MISMATCH;
+    }
+    if(0 != m_lastNonZero && (f_count > 0) != (m_lastNonZero > 0)){
+        l_faults |= FAULT_NOISE;
+    }
+    return l_faults;
+}
+
+/**
+ * @brief Pipeline stage of the monitor, it has to be applied after the encoder stage and before the controller.
+ * 
+ * @param f_timestamp Timestamp of the tick in microsecond
+ */
+CONTROL_RAMFUNC void CEncoderMonitor::process(uint32_t){
+    float l_pwm = m_pwm ? m_pwm() : 0.0f;
+    float l_current = m_current ? std::abs(m_current()) : 0.0f;
+    float l_voltage = l_pwm * m_params.m_supply;
+    float l_drop = (l_pwm < 0.0f) ? -l_current * m_params.m_resistance : l_current * m_params.m_resistance;
+    float l_modelRps = (l_voltage - l_drop) / m_params.m_backEmf;
+
+    int16_t l_count = m_encoder.getCount();
+    uint32_t l_faults = check(l_count, l_modelRps);
+    m_prevCount = l_count;
+    if(0 != l_count){
+        m_lastNonZero = l_count;
+    }
+
+    if(0 != l_faults){
+        m_faults = m_faults | l_faults;
+        m_health = (m_health > s_penalty) ? m_health - s_penalty : 0.0f;
+    }else{
+        m_health = (m_health < 1.0f - s_recovery) ? m_health + s_recovery : 1.0f;
+    }
+    if(!m_degraded && m_health < s_degradedHealth){
+        m_degraded = true;
+        m_degradations++;
+        if(m_callback){
+            m_callback(true);
+        }
+    }else if(m_degraded && m_health > s_recoveredHealth){
+        m_degraded = false;
+        if(m_callback){
+            m_callback(false);
+        }
+    }
+}
+
+/**
+ * @brief Serial callback of the health, it doesn't have parameter. 
+ * 
+ * The response contains the health score, the degraded state, the fault flags since the previous reading and the number of 
+ * the degradations; the fault flags are cleared by the reading.
+ * 
+ * @param a   input string
+ * @param b   output string
+ */
+void CEncoderMonitor::serialCallback(char const *, char * b){
+    core_util_critical_section_enter();
+    uint32_t l_faults = m_faults;
+    m_faults = 0;
+    core_util_critical_section_exit();
+    utils::fmt::CWriter(b).fixed(m_health,3).dec(m_degraded ? 1 : 0).udec(l_faults).udec(m_degradations).chr(';');
+}
+
+}; // namespace hardware::encoders
@@ -47,20 +47,30 @@ void CQuadratureCounter_TIM4::CQuadratureCounter_TIM4_Destroyer::SetSingleton(CQ
  * 
  */
 CQuadratureCounter_TIM4::CQuadratureCounter_TIM4_Destroyer::~CQuadratureCounter_TIM4_Destroyer(){
-    delete m_singleton;
+    pool().destroy(m_singleton);
+}
+
+/**
+ * @brief Static memory of the singleton object, it's created at the first use, so it's independent of the initialization order.
+ * 
+ * @return The pool of the singleton object
+ */
+utils::memory::CStaticPool<CQuadratureCounter_TIM4,1>& CQuadratureCounter_TIM4::pool(){
+    static utils::memory::CStaticPool<CQuadratureCounter_TIM4,1> s_pool;
+    return s_pool;
 }
 
 
 /**
  * @brief 
- * It verifies the existence of the singleton object. It creates a new instance when it's necessary and return the address of instance.
+ * It verifies the existence of the singleton object. It creates a new instance in the static pool when it's necessary and return the address of instance.
  * It initializes all parameter by appling method 'initialize'.
  * 
  * @return The address of the singleton object
  */
 CQuadratureCounter_TIM4* CQuadratureCounter_TIM4::Instance(){
     if(!CQuadratureCounter_TIM4::m_instance){
-        CQuadratureCounter_TIM4::m_instance = new CQuadratureCounter_TIM4;
+        CQuadratureCounter_TIM4::m_instance = new (pool().allocate()) CQuadratureCounter_TIM4;
         m_instance->initialize();
         CQuadratureCounter_TIM4::m_destroyer.SetSingleton(m_instance);
     }
@@ -122,5 +132,78 @@ void CQuadratureCounter_TIM4::reset(){
     TIM4->CNT = 0;
 }
 
+/**
+ * @brief Construct a new CQuadratureCounter object, it configures the pins and the timer in encoder mode.
+ * 
+ * @param f_timer     timer instance (TIM1..TIM5)
+ * @param f_channelA  pin of the channel 1 of the timer
+ * @param f_channelB  pin of the channel 2 of the timer
+ * @param f_alternate alternate function number of the timer on the pins (GPIO_AF1_TIM2, GPIO_AF2_TIM3, ...)
+ */
+CQuadratureCounter::CQuadratureCounter(TIM_TypeDef* f_timer, PinName f_channelA, PinName f_channelB, uint8_t f_alternate)
+    :m_timer(f_timer)
+    ,m_is32Bit(f_timer == TIM2 || f_timer == TIM5)
+{
+    pin_function(f_channelA, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLDOWN, f_alternate));
+    pin_function(f_channelB, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLDOWN, f_alternate));
+    enableClock();
+
+    m_timer->CR1 = 0x0000;
+    m_timer->SMCR = TIM_ENCODERMODE_TI12;                   // all edges trigger count
+    m_timer->CCMR1 = 0xF1F1;                                // CC1S='01' CC2S='01', filter
+    m_timer->CCMR2 = 0x0000;
+    m_timer->CCER = TIM_CCER_CC1E | TIM_CCER_CC2E;
+    m_timer->PSC = 0x0000;
+    m_timer->ARR = m_is32Bit ? 0xffffffff : 0xffff;         // reload at the full range
+    m_timer->CNT = 0x0000;
+    m_timer->CR1 = 0x0001;                                  // CEN(Counter ENable)='1'
+}
+
+/**
+ * @brief Enable the clock of the timer.
+ */
+void CQuadratureCounter::enableClock(){
+    if(m_timer == TIM1){
+        RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+    }else if(m_timer == TIM2){
+        RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+    }else if(m_timer == TIM3){
+        RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+    }else if(m_timer == TIM4){
+        RCC->APB1ENR |= RCC_APB1ENR_TIM4EN;
+    }else if(m_timer == TIM5){
+        RCC->APB1ENR |= RCC_APB1ENR_TIM5EN;
+    }
+}
+
+/**
+ * @brief Get the position of encoder, the lower 16 bits of the counter.
+ * 
+ */
+int16_t CQuadratureCounter::getCount(){
+    return static_cast<int16_t>(m_timer->CNT);
+}
+
+/**
+ * @brief Reset the value of the counter to zero value.
+ */
+void CQuadratureCounter::reset(){
+    m_timer->CNT = 0;
+}
+
+/**
+ * @brief Get the raw value of the counter with its full width.
+ */
+uint32_t CQuadratureCounter::getRawCount(){
+    return m_timer->CNT;
+}
+
+/**
+ * @brief Width of the counter, it's true on TIM2 and TIM5.
+ */
+bool CQuadratureCounter::is32Bit(){
+    return m_is32Bit;
+}
+
 
 }; // namespace hardware::drivers
\ No newline at end of file
@@ -23,10 +23,15 @@ limitations under the License.
  * 
  */
 #include <hardware/encoders/quadratureencoder.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+#include <cstdio>
 
 
 namespace hardware::encoders{
 
+const uint8_t CQuadratureEncoder::s_windowLength[3] = {4, 16, 32};
 
 
 /**
@@ -35,34 +40,261 @@ namespace hardware::encoders{
  * @param f_period_sec          Period of the task
  * @param f_quadraturecounter   The counter object
  * @param f_resolution          The resolution of the rotation encoder. (Cpr count per revolution)
+ * @param f_mode                Counting mode, read and reset or free running counter
  */
 CQuadratureEncoder::CQuadratureEncoder(   float                           f_period_sec
                                                 ,hardware::drivers::IQuadratureCounter_TIMX*        f_quadraturecounter
-                                                ,uint16_t                        f_resolution)
+                                                ,uint16_t                        f_resolution
+                                                ,ECountingMode                   f_mode)
                                                 :m_quadraturecounter(f_quadraturecounter)
                                                 ,m_taskperiod_s(f_period_sec)
                                                 ,m_resolution(f_resolution)
-                                                ,m_timer(mbed::callback(this,&CQuadratureEncoder::_run))
+                                                ,m_speedScale(1.0f / (static_cast<float>(f_resolution) * f_period_sec))
+                                                ,m_mode(f_mode)
+                                                ,m_lastRaw(f_quadraturecounter->getRawCount())
+                                                ,m_position(0)
+                                                ,m_index(NULL)
+                                                ,m_indexCount(0)
+                                                ,m_indexed(false)
+                                                ,m_indexPosition(0)
+                                                ,m_indexError(0)
+                                                ,m_indexCorrections(0)
+                                                ,m_indexRejected(0)
+                                                ,m_timer(&CQuadratureEncoder::expireTimer, this)
+                                                ,m_timestamp(0)
+                                                ,m_topic()
+                                                ,m_travel(0)
+                                                ,m_history()
+                                                ,m_historyCount(0)
 {
 }
 
 
 /**
- * @brief Start the RosTimer to periodically apply the '_run' function. 
+ * @brief Start the timer in the timer wheel to periodically apply the '_run' function, it's applied from the tick of the wheel.
  * 
+ * @param f_wheel Timer wheel, for example the wheel of the task manager
  */
-void CQuadratureEncoder::startTimer(){
-    m_timer.start(static_cast<int>(m_taskperiod_s*1000));
+void CQuadratureEncoder::startTimer(utils::task::CTimerWheel& f_wheel){
+    uint32_t l_period = f_wheel.toTicks(m_taskperiod_s);
+    f_wheel.arm(m_timer, l_period, l_period);
+}
+
+/**
+ * @brief Expiry callback of the timer, it applies the '_run' function of the owner.
+ * 
+ * @param f_timer Expired timer
+ */
+void CQuadratureEncoder::expireTimer(utils::task::CTimerWheel::CTimer& f_timer){
+    static_cast<CQuadratureEncoder*>(f_timer.getContext())->_run();
 }
 
 
 /**
- * @brief The run function will be applied periodically. 
+ * @brief The run function will be applied periodically by the timer of the timer wheel. 
  * 
  */
 void CQuadratureEncoder::_run(){
-    m_encoderCnt = m_quadraturecounter->getCount();
-    m_quadraturecounter->reset();
+    process(us_ticker_read());
+}
+
+/**
+ * @brief Pipeline stage of the encoder, it measures and publishes the sample.
+ * 
+ * @param f_timestamp Timestamp of the tick in microsecond
+ */
+void CQuadratureEncoder::process(uint32_t f_timestamp){
+    acquire(f_timestamp);
+    publish();
+}
+
+/**
+ * @brief Get the count of the period from the counter and accumulate the position.
+ * 
+ * In the reset mode it reads and resets the counter, the impulses between the two register accesses are lost. In the free running mode 
+ * the count is the wrapped difference between the current and the previous raw value, with the full width of the counter (16 or 32 bits). 
+ * 
+ * @param f_timestamp Timestamp of the measurement in microsecond
+ */
+void CQuadratureEncoder::acquire(uint32_t f_timestamp){
+    if(m_mode == FREE_RUNNING){
+        uint32_t l_raw = m_quadraturecounter->getRawCount();
+        int32_t l_delta = m_quadraturecounter->is32Bit() ? static_cast<int32_t>(l_raw - m_lastRaw) 
+                                                         : static_cast<int16_t>(static_cast<uint16_t>(l_raw - m_lastRaw));
+        m_lastRaw = l_raw;
+        m_position += l_delta;
+        m_travel += l_delta;
+        // The count of the period is saturated to 16 bits, the position isn't affected
+        m_encoderCnt = (l_delta > INT16_MAX) ? INT16_MAX : ((l_delta < INT16_MIN) ? INT16_MIN : static_cast<int16_t>(l_delta));
+        if(m_index != NULL){
+            correctByIndex(l_raw);
+        }
+    }else{
+        m_encoderCnt = m_quadraturecounter->getCount();
+        m_quadraturecounter->reset();
+        m_position += m_encoderCnt;
+        m_travel += m_encoderCnt;
+    }
+    m_history[m_historyCount % s_historySize] = m_travel;
+    m_historyCount++;
+    m_timestamp = f_timestamp;
+}
+
+/**
+ * @brief Speed of a window from the history ring. Before the first full window the recorded periods are applied.
+ * 
+ * @param f_window Window of the estimation
+ * @return Mean rotation speed of the window (rotation per second)
+ */
+float CQuadratureEncoder::getWindowSpeedRps(EWindow f_window) const{
+    uint32_t l_length = s_windowLength[f_window];
+    l_length = (m_historyCount > l_length) ? l_length : ((m_historyCount > 0) ? m_historyCount - 1 : 0);
+    if(l_length == 0){
+        return 0.0f;
+    }
+    uint32_t l_newest = m_historyCount - 1;
+    int64_t l_distance = m_history[l_newest % s_historySize] - m_history[(l_newest - l_length) % s_historySize];
+    return static_cast<float>(l_distance) * m_speedScale / static_cast<float>(l_length);
+}
+
+/**
+ * @brief Acceleration from the second difference of the history over two medium windows.
+ * 
+ * @return Acceleration (rotation per square second)
+ */
+float CQuadratureEncoder::getAccelerationRps2() const{
+    uint32_t l_length = s_windowLength[WINDOW_MEDIUM];
+    l_length = (m_historyCount > 2 * l_length) ? l_length : ((m_historyCount > 0) ? (m_historyCount - 1) / 2 : 0);
+    if(l_length == 0){
+        return 0.0f;
+    }
+    uint32_t l_newest = m_historyCount - 1;
+    int64_t l_second = m_history[l_newest % s_historySize] - 2 * m_history[(l_newest - l_length) % s_historySize]
+                     + m_history[(l_newest - 2 * l_length) % s_historySize];
+    float l_window = static_cast<float>(l_length);
+    return static_cast<float>(l_second) * m_speedScale / (l_window * l_window * m_taskperiod_s);
+}
+
+/**
+ * @brief Attach the capture of the index pulse. It's applied only in the free running mode, where the latched raw value of the 
+ * index and the raw value of the period belong to the same counter without reset.
+ * 
+ * @param f_index The capture of the index pulse, NULL detaches it
+ */
+void CQuadratureEncoder::setIndexCapture(hardware::drivers::CEncoderIndexCapture_TIM4* f_index){
+    m_indexed = false;
+    m_index = (m_mode == FREE_RUNNING) ? f_index : NULL;
+    if(m_index != NULL){
+        m_indexCount = m_index->getLastIndex().m_indexCount;
+    }
+}
+
+/**
+ * @brief Reference the position by the new index pulse.
+ * 
+ * The position of the pulse is the current position plus the wrapped difference of its latched raw value, so it's independent 
+ * of the period, in which the pulse arrived. The first pulse is the reference of the shaft angle. The following pulses should be 
+ * whole revolutions away from it; the deviation is the drift of the lost or the disturbance impulses, it's removed from the 
+ * accumulated position, so the distance stays accurate over long runs. A deviation above the tolerance is a disturbance of the 
+ * index input, the pulse is rejected.
+ * 
+ * @param f_raw Raw value of the counter in the current period
+ */
+void CQuadratureEncoder::correctByIndex(uint32_t f_raw){
+    hardware::drivers::SEncoderIndex l_index = m_index->getLastIndex();
+    if(l_index.m_indexCount == m_indexCount){
+        return;
+    }
+    m_indexCount = l_index.m_indexCount;
+    int64_t l_position = m_position + static_cast<int16_t>(static_cast<uint16_t>(l_index.m_position - static_cast<uint16_t>(f_raw)));
+    if(!m_indexed){
+        m_indexPosition = l_position;
+        m_indexed = true;
+        return;
+    }
+    int64_t l_distance = l_position - m_indexPosition;
+    int64_t l_turns = (l_distance + ((l_distance < 0) ? -(m_resolution / 2) : (m_resolution / 2))) / m_resolution;
+    int32_t l_error = static_cast<int32_t>(l_distance - l_turns * m_resolution);
+    if(std::abs(l_error) > m_resolution / s_indexTolerance){
+        m_indexRejected++;
+        return;
+    }
+    if(l_error != 0){
+        m_position -= l_error;
+        m_indexCorrections++;
+    }
+    m_indexError = l_error;
+    m_indexPosition += l_turns * m_resolution;
+}
+
+/**
+ * @brief Publish the sample of the last measurement. It is written in place in the next slot of the topic, then the subscribers are notified.
+ * 
+ */
+void CQuadratureEncoder::publish(){
+    SEncoderSample& l_sample = m_topic.claim();
+    l_sample.m_timestamp = m_timestamp;
+    l_sample.m_count = getCount();
+    l_sample.m_speedRps = getSpeedRps();
+    l_sample.m_position = m_position;
+    if(m_indexed){
+        int32_t l_angle = static_cast<int32_t>((m_position - m_indexPosition) % m_resolution);
+        l_sample.m_angle = (l_angle < 0) ? l_angle + m_resolution : l_angle;
+    }else{
+        l_sample.m_angle = -1;
+    }
+    m_topic.publish();
+}
+
+/**
+ * @brief Get the last published sample. It can be applied from any thread, it repeats the reading, when the topic reached its slot meanwhile.
+ * 
+ * @return Timestamped sample
+ */
+SEncoderSample CQuadratureEncoder::getSample(){
+    return m_topic.read();
+}
+
+/**
+ * @brief Get the accumulated position since the start, it isn't affected by the filter. 
+ * 
+ * @return Position in impulses, the distance in revolution is the position divided by the resolution
+ */
+int64_t CQuadratureEncoder::getPosition(){
+    return getSample().m_position;
+}
+
+/**
+ * @brief Get the absolute angle of the shaft from the index pulse. 
+ * 
+ * @return Angle in revolution in the range [0, 1), it's negative before the first index pulse
+ */
+float CQuadratureEncoder::getShaftAngle(){
+    int32_t l_angle = getSample().m_angle;
+    return (l_angle < 0) ? -1.0f : static_cast<float>(l_angle) / m_resolution;
+}
+
+/**
+ * @brief Serial callback of the index pulse, it doesn't have parameter. 
+ * 
+ * The response contains the state (1 referenced, 0 waiting for the index pulse), the shaft angle in impulses, the number of the 
+ * corrected revolutions, the deviation of the last index pulse in impulses and the number of the rejected pulses.
+ * 
+ * @param a   input string
+ * @param b   output string
+ */
+void CQuadratureEncoder::serialCallbackIndex(char const * a, char * b){
+    if(m_index == NULL){
+        sprintf(b,"no index;;");
+        return;
+    }
+    core_util_critical_section_enter();
+    bool l_indexed = m_indexed;
+    uint32_t l_corrections = m_indexCorrections;
+    int32_t l_error = m_indexError;
+    uint32_t l_rejected = m_indexRejected;
+    core_util_critical_section_exit();
+    utils::fmt::CWriter(b).dec(l_indexed ? 1 : 0).dec(getSample().m_angle).udec(l_corrections).dec(l_error).udec(l_rejected).chr(';');
 }
 
 /**
@@ -80,7 +312,7 @@ int16_t CQuadratureEncoder::getCount(){
  */
 
 float CQuadratureEncoder::getSpeedRps(){
-    return static_cast<float>(m_encoderCnt)/ m_resolution / m_taskperiod_s;
+    return static_cast<float>(m_encoderCnt) * m_speedScale;
 }
 
 /**
@@ -90,26 +322,29 @@ float CQuadratureEncoder::getSpeedRps(){
  * @param f_quadraturecounter The counter object
  * @param f_resolution The resolution of the rotation encoder. (Cpr count per revolution)
  * @param f_filter The reference to the filter. 
+ * @param f_mode Counting mode, read and reset or free running counter
  */
 CQuadratureEncoderWithFilter::CQuadratureEncoderWithFilter(   float                           f_period_sec
                                                                     ,hardware::drivers::IQuadratureCounter_TIMX*        f_quadraturecounter
                                                                     ,uint16_t                       f_resolution
-                                                                    ,signal::filter::IFilter<float>&       f_filter)
-                                                                    :CQuadratureEncoder(f_period_sec,f_quadraturecounter,f_resolution)
+                                                                    ,signal::filter::IFilter<float>&       f_filter
+                                                                    ,ECountingMode                  f_mode)
+                                                                    :CQuadratureEncoder(f_period_sec,f_quadraturecounter,f_resolution,f_mode)
                                                                     ,m_filter(f_filter)
                                                                     {
 }
 
 /**
- * @brief  The '_run' method aims for getting the value from the counter and reseting it.  In the last step, it filters the measured values. 
- * This method is applied automatically and periodically by the rtos timer, if it was started by the method 'startTimer'.
+ * @brief  The 'process' method aims for getting the value from the counter and reseting it. Then it filters the measured values and publishes the filtered sample. 
+ * This method is applied automatically and periodically by the timer of the timer wheel, if it was started by the method 'startTimer', or by the pipeline.
  * 
+ * @param f_timestamp Timestamp of the tick in microsecond
  */
-void CQuadratureEncoderWithFilter::_run(){
-    CQuadratureEncoder::_run();
+void CQuadratureEncoderWithFilter::process(uint32_t f_timestamp){
+    acquire(f_timestamp);
     float temp = m_encoderCnt;
     m_encoderCntFiltered = static_cast<int16_t>(m_filter(temp));
-
+    publish();
 }
 
 /**
@@ -127,7 +362,7 @@ int16_t CQuadratureEncoderWithFilter::getCount(){
  * @return Filtered rotation speed in rps 
  */
 float CQuadratureEncoderWithFilter::getSpeedRps(){
-    return static_cast<double>(m_encoderCntFiltered)/m_resolution / m_taskperiod_s;
+    return static_cast<float>(m_encoderCntFiltered) * m_speedScale;
 
 }
 
@@ -146,9 +381,111 @@ int16_t CQuadratureEncoderWithFilter::getNonFilteredCount(){
  * @return Non-filtered rotation speed in rps  
  */
 float CQuadratureEncoderWithFilter::getNonFilteredSpeedRps(){
-    return static_cast<double>(m_encoderCntFiltered)/m_resolution / m_taskperiod_s;
+    return static_cast<float>(m_encoderCntFiltered) * m_speedScale;
+
+}
+
 
+/**
+ * @brief Construct a new CQuadratureEncoderMT object
+ * 
+ * @param f_period_sec Period of the task
+ * @param f_quadraturecounter The counter object
+ * @param f_resolution The resolution of the rotation encoder. (Cpr count per revolution)
+ * @param f_capture The edge capture of the encoder channel
+ * @param f_lowSpeedRps Below this speed only the period measurement is used
+ * @param f_highSpeedRps Above this speed only the count measurement is used
+ * @param f_mode Counting mode, read and reset or free running counter
+ */
+CQuadratureEncoderMT::CQuadratureEncoderMT(   float                           f_period_sec
+                                                    ,hardware::drivers::IQuadratureCounter_TIMX*        f_quadraturecounter
+                                                    ,uint16_t                       f_resolution
+                                                    ,hardware::drivers::CEncoderEdgeCapture_TIM4&       f_capture
+                                                    ,float                          f_lowSpeedRps
+                                                    ,float                          f_highSpeedRps
+                                                    ,ECountingMode                  f_mode)
+                                                    :CQuadratureEncoder(f_period_sec,f_quadraturecounter,f_resolution,f_mode)
+                                                    ,m_capture(f_capture)
+                                                    ,m_lowSpeedRps(f_lowSpeedRps)
+                                                    ,m_highSpeedRps(f_highSpeedRps)
+                                                    ,m_prevEdge()
+                                                    ,m_prevEdgeValid(false)
+                                                    ,m_periodSpeedRps(0)
+                                                    ,m_speedRps(0)
+{
+}
+
+/**
+ * @brief Speed of the period measurement. 
+ * 
+ * With new edges it divides the distance between the last edges of the two periods by their time difference. Without new edge 
+ * the speed cannot be higher than the edge distance over the time since the last edge, so the speed decays to zero, when the motor stops.
+ * 
+ * @return Rotation speed in rps 
+ */
+float CQuadratureEncoderMT::estimatePeriodSpeed(){
+    hardware::drivers::SEncoderEdge l_edge = m_capture.getLastEdge();
+    if(!m_prevEdgeValid){ // The first new edge after the activation is the reference of the measurement
+        if(l_edge.m_edgeCount != m_prevEdge.m_edgeCount){
+            m_prevEdge = l_edge;
+            m_prevEdgeValid = true;
+        }
+        m_periodSpeedRps = static_cast<float>(m_encoderCnt) * m_speedScale;
+        return m_periodSpeedRps;
+    }
+    if(l_edge.m_edgeCount != m_prevEdge.m_edgeCount){
+        int16_t l_distance = static_cast<int16_t>(l_edge.m_position - m_prevEdge.m_position);
+        float l_time = static_cast<float>(l_edge.m_cycles - m_prevEdge.m_cycles) / SystemCoreClock;
+        m_prevEdge = l_edge;
+        if(l_time > 0){
+            m_periodSpeedRps = l_distance / l_time / m_resolution;
+        }
+    }else{
+        float l_time = static_cast<float>(hardware::drivers::CEncoderEdgeCapture_TIM4::cycles() - m_prevEdge.m_cycles) / SystemCoreClock;
+        float l_bound = hardware::drivers::CEncoderEdgeCapture_TIM4::s_edgeDistance / l_time / m_resolution;
+        if(std::abs(m_periodSpeedRps) > l_bound){
+            m_periodSpeedRps = (m_periodSpeedRps > 0) ? l_bound : -l_bound;
+        }
+    }
+    return m_periodSpeedRps;
 }
 
+/**
+ * @brief Pipeline stage of the encoder, it measures, estimates the speed by blending the two methods and publishes the sample. 
+ * 
+ * @param f_timestamp Timestamp of the tick in microsecond
+ */
+CONTROL_RAMFUNC void CQuadratureEncoderMT::process(uint32_t f_timestamp){
+    acquire(f_timestamp);
+    float l_countSpeed = static_cast<float>(m_encoderCnt) * m_speedScale;
+    float l_absSpeed = std::abs(l_countSpeed);
+    if(l_absSpeed >= m_highSpeedRps){
+        m_speedRps = l_countSpeed;
+        if(m_capture.isEnabled()){
+            m_capture.disable();
+            m_prevEdgeValid = false;
+        }
+    }else{
+        if(!m_capture.isEnabled()){
+            m_capture.enable();
+            m_prevEdge = m_capture.getLastEdge();
+            m_prevEdgeValid = false;
+        }
+        float l_periodSpeed = estimatePeriodSpeed();
+        float l_weight = (l_absSpeed - m_lowSpeedRps) / (m_highSpeedRps - m_lowSpeedRps);
+        l_weight = (l_weight < 0) ? 0 : l_weight;
+        m_speedRps = l_weight * l_countSpeed + (1 - l_weight) * l_periodSpeed;
+    }
+    publish();
+}
+
+/**
+ * @brief Getter function for the last estimated rotation speed (rotation per second). 
+ * 
+ * @return Rotation speed in rps 
+ */
+float CQuadratureEncoderMT::getSpeedRps(){
+    return m_speedRps;
+}
 
 }; // namespace hardware::encoders 
\ No newline at end of file
@@ -0,0 +1,171 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+ * @file ripplefilter.cpp
+ * @author RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#include <hardware/encoders/ripplefilter.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+#include <cstdio>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Construct a new CRippleFilter object
+ * 
+ * @param f_period              Period of the pipeline in second
+ * @param f_encoder             Encoder of the speed, it runs before the ripple filter in the pipeline
+ * @param f_resolution          The resolution of the rotation encoder. (Cpr count per revolution)
+ * @param f_order               Ripple periods per rotation of the encoder
+ * @param f_quality             Quality factor of the notch filters
+ * @param f_stepSize            Normalized step size of the LMS canceller in interval (0,2)
+ * @param f_mode                Applied filters, combination of the EMode flags
+ */
+CRippleFilter::CRippleFilter(float f_period, CQuadratureEncoder& f_encoder, uint16_t f_resolution, float f_order, float f_quality, float f_stepSize, uint32_t f_mode)
+    :m_encoder(f_encoder)
+    ,m_resolution(f_resolution)
+    ,m_order(f_order)
+    ,m_mode(f_mode)
+    ,m_appliedMode(f_mode)
+    ,m_notches{{1.0f/f_period, f_quality, 0.02f/f_period}, {1.0f/f_period, f_quality, 0.02f/f_period}}
+    ,m_canceller(f_stepSize, 1e-3f)
+    ,m_phase(0)
+    ,m_rawSpeed(0)
+    ,m_speed(0)
+{
+}
+
+/**
+ * @brief It retunes the notch filters by the filtered speed, it integrates the ripple phase and it applies the selected filters. 
+ * It has to be applied after the encoder stage in the same tick. 
+ * 
+ * @param f_timestamp           Timestamp of the tick in microsecond
+ */
+CONTROL_RAMFUNC void CRippleFilter::process(uint32_t f_timestamp){
+    SEncoderSample l_sample = m_encoder.getSample();
+    float l_order = m_order;
+    uint32_t l_mode = m_mode;
+    if (l_mode != m_appliedMode)
+    {
+        for (uint32_t l_idx = 0; l_idx < s_harmonics; ++l_idx)
+        {
+            m_notches[l_idx].clear();
+        }
+        m_canceller.clear();
+        m_appliedMode = l_mode;
+    }
+    m_rawSpeed = l_sample.m_speedRps;
+
+    // Phase of the ripple from the counted impulses, it's kept in one period
+    const float l_2pi = 2.0f * static_cast<float>(M_PI);
+    m_phase += l_2pi * l_order * l_sample.m_count / m_resolution;
+    m_phase -= l_2pi * std::floor(m_phase / l_2pi);
+
+    float l_speed = m_rawSpeed;
+    // The notches are tuned by the filtered speed of the previous period, the ripple of the measurement would modulate their frequency
+    float l_frequency = l_order * std::fabs(m_speed);
+    bool l_isActive = false;
+    for (uint32_t l_idx = 0; l_idx < s_harmonics; ++l_idx)
+    {
+        bool l_isHarmonicActive = m_notches[l_idx].setFrequency((l_idx + 1) * l_frequency);
+        if (0 == l_idx)
+        {
+            // The adaptation is frozen together with the notch of the fundamental
+            l_isActive = l_isHarmonicActive;
+        }
+        if (l_mode & NOTCH)
+        {
+            l_speed = m_notches[l_idx](l_speed);
+        }
+    }
+    if ((l_mode & ADAPTIVE) && l_isActive)
+    {
+        float l_cos = std::cos(m_phase);
+        float l_sin = std::sin(m_phase);
+        CCancellerType::CRegressorType l_reference = {l_cos, l_sin, 2.0f * l_cos * l_cos - 1.0f, 2.0f * l_sin * l_cos};
+        l_speed = m_canceller(l_speed, l_reference);
+    }
+    m_speed = l_speed;
+}
+
+/**
+ * @brief Get the counted impulses in the last period.
+ * 
+ * @return Counted impulses
+ */
+int16_t CRippleFilter::getCount(){
+    return m_encoder.getCount();
+}
+
+/**
+ * @brief Get the rotation speed without the ripple in rotation per second.
+ * 
+ * @return Rotation speed
+ */
+float CRippleFilter::getSpeedRps(){
+    return m_speed;
+}
+
+/**
+ * @brief Get the counted impulses in the last period.
+ * 
+ * @return Counted impulses
+ */
+int16_t CRippleFilter::getNonFilteredCount(){
+    return m_encoder.getCount();
+}
+
+/**
+ * @brief Get the measured rotation speed in rotation per second.
+ * 
+ * @return Rotation speed
+ */
+float CRippleFilter::getNonFilteredSpeedRps(){
+    return m_rawSpeed;
+}
+
+/**
+ * @brief Serial callback of the configuration, the first string has to contains the mode (0 - bypass, 1 - notch, 2 - adaptive, 
+ * 3 - both) and the ripple periods per rotation. The filters are cleared in the next period.
+ * 
+ * @param a                    string to read data from
+ * @param b                    string to write data to
+ */
+void CRippleFilter::serialCallback(char const * a, char * b){
+    int32_t l_mode;
+    float l_order;
+    const char* l_text = a;
+    bool l_valid = utils::fmt::parseInt(l_text,l_mode) && ';' == *l_text++ && utils::fmt::parseFloat(l_text,l_order);
+    if (l_valid && l_mode >= BYPASS && l_mode <= (NOTCH | ADAPTIVE) && l_order > 0.0f)
+    {
+        m_order = l_order;
+        m_mode = l_mode;
+        utils::fmt::CWriter(b).text("ack;;").dec(l_mode).fixed(l_order,3);
+    }
+    else
+    {
+        sprintf(b,"sintax error;;");
+    }
+}
+
+}; // namespace hardware::encoders
@@ -0,0 +1,139 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+ * @file singlechannelencoder.cpp
+ * @author RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#include <hardware/encoders/singlechannelencoder.hpp>
+#include <utils/memory/sections.hpp>
+#include <cmath>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Construct a new CSingleChannelEncoder object
+ * 
+ * @param f_period      Period of the tick in second
+ * @param f_capture     Edge capture of the sensor
+ * @param f_edgesPerRev Rising edges in a rotation of the sensor
+ * @param f_timeout     Without edge over this time the speed is zero, it's limited to 0.6 s by the wrap of the timestamps
+ * @param f_reverseRps  Below this speed the direction follows the command
+ */
+CSingleChannelEncoder::CSingleChannelEncoder(float f_period, hardware::drivers::CEdgeCaptureDma_TIM1& f_capture, uint16_t f_edgesPerRev, float f_timeout, float f_reverseRps)
+    :m_capture(f_capture)
+    ,m_period(f_period)
+    ,m_edgesPerRev(f_edgesPerRev)
+    ,m_timeout((f_timeout < 0.6f) ? f_timeout : 0.6f)
+    ,m_reverseRps(f_reverseRps)
+    ,m_pwm()
+    ,m_direction(1)
+    ,m_edgeValid(false)
+    ,m_lastEdge(0)
+    ,m_count(0)
+    ,m_speedRps(0)
+    ,m_position(0)
+{
+}
+
+/**
+ * @brief Set the commanded pwm, its sign is the direction of the rotation.
+ * 
+ * @param f_pwm Getter of the signed pwm
+ */
+void CSingleChannelEncoder::setCommand(mbed::Callback<float()> f_pwm){
+    m_pwm = f_pwm;
+}
+
+/**
+ * @brief Infer the direction from the command. The sign of the command is applied only near the standstill, the speed of the 
+ * changed direction is the opposite of the already measured low speed.
+ */
+void CSingleChannelEncoder::updateDirection(){
+    float l_pwm = m_pwm ? m_pwm() : 0.0f;
+    int8_t l_direction = (l_pwm > s_deadband) ? 1 : ((l_pwm < -s_deadband) ? -1 : m_direction);
+    if(l_direction != m_direction && std::abs(m_speedRps) <= m_reverseRps){
+        m_direction = l_direction;
+        m_speedRps = -m_speedRps;
+    }
+}
+
+/**
+ * @brief Pipeline stage of the sensor, it counts the new edges and it measures the speed by their period.
+ * 
+ * @param f_timestamp Timestamp of the tick in microsecond
+ */
+CONTROL_RAMFUNC void CSingleChannelEncoder::process(uint32_t){
+    updateDirection();
+    uint16_t l_last = m_lastEdge;
+    uint16_t l_edges = m_capture.read(l_last);
+    m_count = static_cast<int16_t>(m_direction * l_edges);
+    m_position += m_count;
+    if(l_edges > 0){
+        if(m_edgeValid){
+            float l_time = static_cast<float>(static_cast<uint16_t>(l_last - m_lastEdge)) / hardware::drivers::CEdgeCaptureDma_TIM1::s_frequency;
+            if(l_time > 0){
+                m_speedRps = m_direction * l_edges / l_time / m_edgesPerRev;
+            }
+        }
+        m_lastEdge = l_last;
+        m_edgeValid = true;
+    }else if(m_edgeValid){
+        float l_time = static_cast<float>(static_cast<uint16_t>(hardware::drivers::CEdgeCaptureDma_TIM1::now() - m_lastEdge)) / hardware::drivers::CEdgeCaptureDma_TIM1::s_frequency;
+        if(l_time > m_timeout){
+            m_edgeValid = false;
+            m_speedRps = 0;
+        }else{
+            float l_bound = 1.0f / l_time / m_edgesPerRev;
+            if(std::abs(m_speedRps) > l_bound){
+                m_speedRps = m_direction * l_bound;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Getter function for the signed edges in the last period.
+ * 
+ * @return Signed edges
+ */
+int16_t CSingleChannelEncoder::getCount(){
+    return m_count;
+}
+
+/**
+ * @brief Getter function for the last measured rotation speed, the sign is the inferred direction.
+ * 
+ * @return Rotation speed in rps 
+ */
+float CSingleChannelEncoder::getSpeedRps(){
+    return m_speedRps;
+}
+
+/**
+ * @brief Get the accumulated position since the start.
+ * 
+ * @return Position in edges, the distance in revolution is the position divided by the edges of a rotation
+ */
+int64_t CSingleChannelEncoder::getPosition(){
+    return m_position;
+}
+
+}; // namespace hardware::encoders
@@ -0,0 +1,157 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+ * @file speedobserver.cpp
+ * @author RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-11-07
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#include <hardware/encoders/speedobserver.hpp>
+#include <cmath>
+
+namespace hardware::encoders{
+
+/**
+ * @brief Construct a new CSpeedObserver object
+ * 
+ * @param f_period              Period of the pipeline in second
+ * @param f_encoder             Encoder of the position, it runs before the observer in the pipeline
+ * @param f_resolution          The resolution of the rotation encoder. (Cpr count per revolution)
+ * @param f_model               Coefficients of the motor model
+ * @param f_noise               Standard deviations of the process and the measurement noises
+ */
+CSpeedObserver::CSpeedObserver(float f_period, CQuadratureEncoder& f_encoder, uint16_t f_resolution, const SMotorModel& f_model, const SNoise& f_noise)
+    :m_encoder(f_encoder)
+    ,m_resolution(f_resolution)
+    ,m_model(f_model)
+    ,m_kalman(systemModel(f_period,f_model)
+             ,processNoise(f_noise)
+             ,CKalmanFilterType::CMeasurementCovarianceType({f_noise.m_measurement*f_noise.m_measurement})
+             ,processNoise(f_noise))
+    ,m_pwm()
+    ,m_current()
+    ,m_basePosition(0)
+    ,m_initialized(false)
+    ,m_count(0)
+    ,m_speed(0)
+    ,m_acceleration(0)
+{
+}
+
+/**
+ * @brief Set the getters of the model inputs. Without getter the input is zero.
+ * 
+ * @param f_pwm                 Getter of the commanded pwm
+ * @param f_current             Getter of the motor current
+ */
+void CSpeedObserver::setInputs(mbed::Callback<float()> f_pwm, mbed::Callback<float()> f_current){
+    m_pwm = f_pwm;
+    m_current = f_current;
+}
+
+/**
+ * @brief It creates the discrete model: x = [position, speed, disturbance], u = [pwm, current], y = position.
+ * 
+ * @param f_period              Period in second
+ * @param f_model               Coefficients of the motor model
+ * @return                      System model
+ */
+CSpeedObserver::CKalmanFilterType::CSystemModelType CSpeedObserver::systemModel(float f_period, const SMotorModel& f_model){
+    CKalmanFilterType::CSystemModelType::CStateTransitionType l_A({
+        1.0f, f_period,                                   0.0f,
+        0.0f, 1.0f + f_model.m_speedFeedback * f_period,  f_period,
+        0.0f, 0.0f,                                       1.0f });
+    CKalmanFilterType::CSystemModelType::CInputMatrixType l_B({
+        0.0f,                           0.0f,
+        f_model.m_pwmGain * f_period,   f_model.m_currentGain * f_period,
+        0.0f,                           0.0f });
+    CKalmanFilterType::CSystemModelType::CMeasurementMatrixType l_C({1.0f, 0.0f, 0.0f});
+    return CKalmanFilterType::CSystemModelType(l_A, l_B, l_C);
+}
+
+/**
+ * @brief It creates the diagonal process noise covariance.
+ * 
+ * @param f_noise               Standard deviations of the noises
+ * @return                      Covariance matrix
+ */
+CSpeedObserver::CKalmanFilterType::CStateCovarianceType CSpeedObserver::processNoise(const SNoise& f_noise){
+    CKalmanFilterType::CStateCovarianceType l_Q(CKalmanFilterType::CStateCovarianceType::zeros());
+    l_Q[0][0] = f_noise.m_position * f_noise.m_position;
+    l_Q[1][1] = f_noise.m_speed * f_noise.m_speed;
+    l_Q[2][2] = f_noise.m_acceleration * f_noise.m_acceleration;
+    return l_Q;
+}
+
+/**
+ * @brief It applies one prediction and correction with the last sample of the encoder. It has to be applied after the encoder stage in the same tick. 
+ * 
+ * @param f_timestamp           Timestamp of the tick in microsecond
+ */
+void CSpeedObserver::process(uint32_t f_timestamp){
+    SEncoderSample l_sample = m_encoder.getSample();
+    m_count = l_sample.m_count;
+    if (!m_initialized)
+    {
+        m_basePosition = l_sample.m_position;
+        m_initialized = true;
+    }
+    CKalmanFilterType::CControlType l_u({m_pwm ? m_pwm() : 0.0f, m_current ? m_current() : 0.0f});
+    CKalmanFilterType::CMeasurementType l_y({static_cast<float>(l_sample.m_position - m_basePosition) / m_resolution});
+    m_kalman.predict(l_u);
+    m_kalman.updateSequential(l_u, l_y);
+
+    // Move the base position, so the position state stays near zero
+    CKalmanFilterType::CStateType& l_x = m_kalman.state();
+    int32_t l_shift = static_cast<int32_t>(std::floor(l_x[0][0] * m_resolution + 0.5f));
+    m_basePosition += l_shift;
+    l_x[0][0] -= l_shift / m_resolution;
+
+    m_speed = l_x[1][0];
+    m_acceleration = m_model.m_speedFeedback * l_x[1][0] + m_model.m_pwmGain * l_u[0][0] + m_model.m_currentGain * l_u[1][0] + l_x[2][0];
+}
+
+/**
+ * @brief Get the counted impulses in the last period.
+ * 
+ * @return Counted impulses
+ */
+int16_t CSpeedObserver::getCount(){
+    return m_count;
+}
+
+/**
+ * @brief Get the estimated rotation speed in rotation per second.
+ * 
+ * @return Rotation speed
+ */
+float CSpeedObserver::getSpeedRps(){
+    return m_speed;
+}
+
+/**
+ * @brief Get the estimated acceleration in rotation per second squared.
+ * 
+ * @return Acceleration
+ */
+float CSpeedObserver::getAccelerationRps2(){
+    return m_acceleration;
+}
+
+}; // namespace hardware::encoders
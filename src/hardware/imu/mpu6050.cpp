@@ -0,0 +1,273 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    Mpu6050.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the MPU-6050 inertial sensor.
+  ******************************************************************************
+ */
+
+#include <hardware/imu/mpu6050.hpp>
+
+namespace hardware::imu{
+
+    /** @brief  Registers of the sensor */
+    enum ERegister{
+        REG_SMPLRT_DIV      = 0x19,
+        REG_CONFIG          = 0x1A,
+        REG_GYRO_CONFIG     = 0x1B,
+        REG_ACCEL_CONFIG    = 0x1C,
+        REG_FIFO_EN         = 0x23,
+        REG_INT_PIN_CFG     = 0x37,
+        REG_INT_ENABLE      = 0x38,
+        REG_USER_CTRL       = 0x6A,
+        REG_PWR_MGMT_1      = 0x6B,
+        REG_FIFO_COUNTH     = 0x72,
+        REG_FIFO_R_W        = 0x74,
+        REG_WHO_AM_I        = 0x75
+    };
+
+    /** @brief  Size of the sensor FIFO in bytes */
+    static const uint32_t s_fifoSize = 1024;
+    /** @brief  FIFO reset and enable bits of the user control register */
+    static const uint8_t s_fifoReset = 0x44;
+
+    /** \brief  CMpu6050 class constructor
+     *
+     *  @param f_bus           mbed I2C object of the configuration
+     *  @param f_busQueue      transaction queue of the same interface
+     *  @param f_dataReady     pin connected to the interrupt output of the sensor
+     *  @param f_address       7-bit address of the sensor (0x68 or 0x69)
+     */
+    CMpu6050::CMpu6050(I2C& f_bus, hardware::drivers::CI2cBus_I2C1& f_busQueue, PinName f_dataReady, uint8_t f_address)
+        : m_bus(f_bus)
+        , m_busQueue(f_busQueue)
+        , m_dataReady(f_dataReady)
+        , m_address(f_address)
+        , m_period_us(1000)
+        , m_accelScale(0.0f)
+        , m_gyroScale(0.0f)
+        , m_batch(1)
+        , m_ready(0)
+        , m_readyTimestamp(0)
+        , m_pending(false)
+        , m_burstTimestamp(0)
+        , m_fifoSamples(0)
+        , m_burstSamples(0)
+        , m_buffer()
+        , m_queue()
+        , m_overruns(0)
+        , m_errors(0)
+    {
+    }
+
+    /** \brief  Configure the sensor by blocking transfers, it has to be applied in the setup.
+     *
+     *  It resets the sensor, it sets the sample rate, the digital low pass filter and the ranges, it enables the FIFO for the 
+     *  accelerometer and the gyroscope and the data-ready interrupt (active high pulse).
+     *
+     *  @param f_rate_hz       sample rate, the gyroscope output rate (1 kHz with enabled filter) divided by an integer
+     *  @param f_dlpf          configuration of the digital low pass filter (1..6, 3: 44 Hz bandwidth)
+     *  @param f_gyroRange     full scale range of the gyroscope
+     *  @param f_accelRange    full scale range of the accelerometer
+     *  @return                true, when the sensor was identified and configured
+     */
+    bool CMpu6050::configure(uint16_t f_rate_hz, uint8_t f_dlpf, EGyroRange f_gyroRange, EAccelRange f_accelRange)
+    {
+        char l_register = REG_WHO_AM_I;
+        char l_id = 0;
+        if (0 != m_bus.write(m_address << 1, &l_register, 1, true) || 0 != m_bus.read(m_address << 1, &l_id, 1))
+        {
+            return false;
+        }
+        if (l_id != 0x68 && l_id != 0x70)   // MPU-6050, MPU-6500
+        {
+            return false;
+        }
+        if (!writeRegister(REG_PWR_MGMT_1, 0x80))                           // Device reset
+        {
+            return false;
+        }
+        wait_ms(100);
+        uint32_t l_divider = (f_rate_hz > 0 && f_rate_hz <= 1000) ? 1000 / f_rate_hz : 1;
+        m_period_us = 1000 * l_divider;
+        m_accelScale = 9.80665f / static_cast<float>(16384 >> f_accelRange);
+        m_gyroScale = static_cast<float>(M_PI) / 180.0f / (131.0f / static_cast<float>(1 << f_gyroRange));
+        return writeRegister(REG_PWR_MGMT_1, 0x01)                          // Clock from the PLL of the gyroscope
+            && writeRegister(REG_SMPLRT_DIV, l_divider - 1)
+            && writeRegister(REG_CONFIG, f_dlpf & 0x07)
+            && writeRegister(REG_GYRO_CONFIG, f_gyroRange << 3)
+            && writeRegister(REG_ACCEL_CONFIG, f_accelRange << 3)
+            && writeRegister(REG_INT_PIN_CFG, 0x00)                         // Active high, push-pull, 50 us pulse
+            && writeRegister(REG_INT_ENABLE, 0x01)                          // Data-ready interrupt
+            && writeRegister(REG_FIFO_EN, 0x78)                             // Accelerometer and gyroscope axes
+            && writeRegister(REG_USER_CTRL, s_fifoReset);
+    }
+
+    /** \brief  Start the reading of the FIFO, the I2C master has to be started before.
+     *
+     *  @param f_batch         number of the samples between the readings, the samples are read in bursts to reduce the overhead of the transfers
+     */
+    void CMpu6050::start(uint8_t f_batch)
+    {
+        m_batch = (f_batch > 0) ? f_batch : 1;
+        m_ready = 0;
+        m_dataReady.rise(mbed::callback(this,&CMpu6050::dataReadyCallback));
+    }
+
+    /** \brief  Pop the oldest sample, it can be applied only by a single consumer.
+     *
+     *  @param f_sample        destination of the sample
+     *  @return                true, when a sample was available
+     */
+    bool CMpu6050::pop(SImuSample& f_sample)
+    {
+        return m_queue.pop(f_sample);
+    }
+
+    /** \brief  Write a register by blocking transfer
+     *
+     *  @param f_register      register address
+     *  @param f_value         new value
+     *  @return                true, when the sensor acknowledged the transfer
+     */
+    bool CMpu6050::writeRegister(uint8_t f_register, uint8_t f_value)
+    {
+        char l_data[2] = {static_cast<char>(f_register), static_cast<char>(f_value)};
+        return 0 == m_bus.write(m_address << 1, l_data, 2);
+    }
+
+    /** \brief  Data-ready interrupt callback
+     *
+     *  After each batch it submits the reading of the FIFO counter. When the previous reading is still pending after four batches, 
+     *  it's cancelled, so a disturbed bus doesn't stop the reading.
+     */
+    void CMpu6050::dataReadyCallback()
+    {
+        m_readyTimestamp = us_ticker_read();
+        if (++m_ready < m_batch)
+        {
+            return;
+        }
+        if (m_pending)
+        {
+            if (m_ready >= 4u * m_batch)
+            {
+                m_busQueue.cancel(this);
+                m_pending = false;
+                m_errors++;
+                m_ready = 0;
+            }
+            return;
+        }
+        m_ready = 0;
+        m_burstTimestamp = m_readyTimestamp;
+        m_pending = true;
+        if (!m_busQueue.read(this, hardware::drivers::CI2cBus_I2C1::PRIORITY_HIGH, m_address, REG_FIFO_COUNTH, m_buffer, 2, mbed::callback(this,&CMpu6050::countCallback)))
+        {
+            m_pending = false;
+            m_errors++;
+        }
+    }
+
+    /** \brief  Callback of the FIFO counter reading
+     *
+     *  It starts the burst reading of the complete samples, or the reset of the FIFO after an overflow.
+     *
+     *  @param f_success       result of the transfer
+     */
+    void CMpu6050::countCallback(bool f_success)
+    {
+        if (!f_success)
+        {
+            m_errors++;
+            m_pending = false;
+            return;
+        }
+        uint32_t l_count = (static_cast<uint32_t>(m_buffer[0]) << 8) | m_buffer[1];
+        if (l_count >= s_fifoSize - s_sampleSize)
+        {
+            m_overruns += l_count / s_sampleSize;
+            static const uint8_t s_reset = s_fifoReset;
+            if (!m_busQueue.write(this, hardware::drivers::CI2cBus_I2C1::PRIORITY_HIGH, m_address, REG_USER_CTRL, &s_reset, 1, mbed::callback(this,&CMpu6050::resetCallback)))
+            {
+                m_errors++;
+                m_pending = false;
+            }
+            return;
+        }
+        m_fifoSamples = l_count / s_sampleSize;
+        m_burstSamples = (m_fifoSamples < s_maxBurstSamples) ? m_fifoSamples : s_maxBurstSamples;
+        if (m_burstSamples == 0)
+        {
+            m_pending = false;
+            return;
+        }
+        if (!m_busQueue.read(this, hardware::drivers::CI2cBus_I2C1::PRIORITY_HIGH, m_address, REG_FIFO_R_W, m_buffer, m_burstSamples * s_sampleSize, mbed::callback(this,&CMpu6050::burstCallback)))
+        {
+            m_errors++;
+            m_pending = false;
+        }
+    }
+
+    /** \brief  Callback of the burst reading
+     *
+     *  It decodes the big-endian values and it pushes the samples in the queue. The timestamps are computed backward from the 
+     *  last data-ready signal by the sample period, the newest sample in the FIFO corresponds to the signal.
+     *
+     *  @param f_success       result of the transfer
+     */
+    void CMpu6050::burstCallback(bool f_success)
+    {
+        m_pending = false;
+        if (!f_success)
+        {
+            m_errors++;
+            return;
+        }
+        for (uint32_t i = 0; i < m_burstSamples; ++i)
+        {
+            const uint8_t* l_raw = m_buffer + i * s_sampleSize;
+            SImuSample l_sample;
+            l_sample.m_timestamp = m_burstTimestamp - (m_fifoSamples - 1 - i) * m_period_us;
+            for (uint32_t j = 0; j < 3; ++j)
+            {
+                l_sample.m_accel[j] = static_cast<int16_t>((l_raw[2 * j] << 8) | l_raw[2 * j + 1]) * m_accelScale;
+                l_sample.m_gyro[j] = static_cast<int16_t>((l_raw[6 + 2 * j] << 8) | l_raw[6 + 2 * j + 1]) * m_gyroScale;
+            }
+            if (!m_queue.push(l_sample))
+            {
+                m_overruns++;
+            }
+        }
+    }
+
+    /** \brief  Callback of the FIFO reset
+     *
+     *  @param f_success       result of the transfer
+     */
+    void CMpu6050::resetCallback(bool f_success)
+    {
+        m_pending = false;
+        if (!f_success)
+        {
+            m_errors++;
+        }
+    }
+
+}; // namespace hardware::imu
@@ -0,0 +1,214 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    BatteryMonitor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the battery monitor with energy accounting.
+  ******************************************************************************
+ */
+
+#include <hardware/sampling/batterymonitor.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <math.h>
+
+namespace hardware::sampling{
+
+    /** \brief  CBatteryMonitor class constructor
+     *
+     *  The state of charge is estimated from the voltage after five time constants of the filter.
+     *
+     *  @param f_period        period of the pipeline in second
+     *  @param f_voltage       getter of the pack voltage in volt
+     *  @param f_current       getter of the motor current in ampere (mean current of the on-time)
+     *  @param f_duty          getter of the duty cycle of the bridge in [0,1], without getter the full current is applied
+     *  @param f_cells         number of the lithium-polymer cells in series
+     *  @param f_capacity      capacity of the pack in ampere-hour
+     *  @param f_timeConstant  time constant of the low-pass filter of the voltage in second
+     */
+    CBatteryMonitor::CBatteryMonitor(float                                   f_period
+                                    ,FValueGetter                            f_voltage
+                                    ,hardware::drivers::ICurrentGetter&      f_current
+                                    ,FValueGetter                            f_duty
+                                    ,uint8_t                                 f_cells
+                                    ,float                                   f_capacity
+                                    ,float                                   f_timeConstant)
+        : m_period(f_period)
+        , m_voltageGetter(f_voltage)
+        , m_currentGetter(f_current)
+        , m_dutyGetter(f_duty)
+        , m_cells((f_cells > 0) ? f_cells : 1)
+        , m_capacity(f_capacity * 3600.0f)
+        , m_alpha(1.0f - expf(-f_period / f_timeConstant))
+        , m_settleTicks(static_cast<uint32_t>(5.0f * f_timeConstant / f_period) + 1)
+        , m_voltage(0.0f)
+        , m_current(0.0f)
+        , m_power(0.0f)
+        , m_energy(0.0f)
+        , m_energyCompensation(0.0f)
+        , m_charge(0.0f)
+        , m_chargeCompensation(0.0f)
+        , m_initialCharge(1.0f)
+        , m_stateOfCharge(1.0f)
+        , m_estimateRequest(false)
+    {
+    }
+
+    /** \brief  Pipeline stage, it filters the voltage, it calculates the power and it integrates the charge and the energy
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CBatteryMonitor::process(uint32_t)
+    {
+        if (!m_voltageGetter)
+        {
+            return;
+        }
+        float l_voltage = m_voltageGetter();
+        m_voltage = (m_voltage > 0.0f) ? (m_voltage + m_alpha * (l_voltage - m_voltage)) : l_voltage;
+        float l_duty = m_dutyGetter ? fabsf(m_dutyGetter()) : 1.0f;
+        float l_current = fabsf(m_currentGetter.getCurrent()) * ((l_duty < 1.0f) ? l_duty : 1.0f);
+        m_current = l_current;
+        float l_power = l_voltage * l_current;
+        m_power = l_power;
+        float l_energy = m_energy;
+        accumulate(l_energy, m_energyCompensation, l_power * m_period);
+        m_energy = l_energy;
+        accumulate(m_charge, m_chargeCompensation, l_current * m_period);
+
+        if (m_settleTicks > 0)
+        {
+            m_settleTicks--;
+            m_estimateRequest = m_estimateRequest || (0 == m_settleTicks);
+        }
+        if (m_estimateRequest)
+        {
+            m_estimateRequest = false;
+            m_initialCharge = openCircuitCharge(m_voltage / m_cells);
+            m_charge = 0.0f;
+            m_chargeCompensation = 0.0f;
+        }
+        float l_stateOfCharge = m_initialCharge - m_charge / m_capacity;
+        m_stateOfCharge = (l_stateOfCharge > 0.0f) ? l_stateOfCharge : 0.0f;
+    }
+
+    /** \brief  Set the state of charge (e.g. after a charge), the counting of the charge restarts from it
+     *
+     *  @param f_stateOfCharge state of charge in interval [0,1]
+     */
+    void CBatteryMonitor::setStateOfCharge(float f_stateOfCharge)
+    {
+        core_util_critical_section_enter();
+        m_initialCharge = (f_stateOfCharge < 0.0f) ? 0.0f : ((f_stateOfCharge > 1.0f) ? 1.0f : f_stateOfCharge);
+        m_charge = 0.0f;
+        m_chargeCompensation = 0.0f;
+        m_stateOfCharge = m_initialCharge;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Request the estimate of the state of charge from the open-circuit voltage, it's applied in the next tick. The vehicle has
+     *  to stand still, the voltage drop of the load isn't compensated.
+     */
+    void CBatteryMonitor::estimateStateOfCharge()
+    {
+        m_estimateRequest = true;
+    }
+
+    /** \brief  Serial callback method to get the state or to set the state of charge
+     *
+     * @param a                   input received string, 0: state, 1;percent: set the state of charge, 2: estimate from the voltage
+     * @param b                   output reponse message
+     */
+    void CBatteryMonitor::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).fixed(m_voltage,2).fixed(m_current,2).fixed(m_power,1).fixed(m_energy / 3600.0f,3)
+                                  .fixed(m_stateOfCharge * 100.0f,1).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_percent;
+            if (utils::fmt::parseUint(l_text, l_percent) && l_percent <= 100)
+            {
+                setStateOfCharge(static_cast<float>(l_percent) * 0.01f);
+                sprintf(b,"ack;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (2 == l_command)
+        {
+            estimateStateOfCharge();
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  State of charge of a lithium-polymer cell by the open-circuit voltage, linear interpolation of the discharge curve
+     *
+     *  @param f_cellVoltage   open-circuit voltage of a cell in volt
+     *  @return                state of charge in interval [0,1]
+     */
+    float CBatteryMonitor::openCircuitCharge(float f_cellVoltage)
+    {
+        static const float s_curve[][2] = {
+            {3.30f, 0.00f}, {3.50f, 0.05f}, {3.68f, 0.10f}, {3.73f, 0.20f}, {3.77f, 0.30f}, {3.80f, 0.40f},
+            {3.84f, 0.50f}, {3.87f, 0.60f}, {3.93f, 0.70f}, {4.00f, 0.80f}, {4.08f, 0.90f}, {4.20f, 1.00f}
+        };
+        const uint8_t l_count = sizeof(s_curve) / sizeof(s_curve[0]);
+        if (f_cellVoltage <= s_curve[0][0])
+        {
+            return 0.0f;
+        }
+        for (uint8_t i = 1; i < l_count; ++i)
+        {
+            if (f_cellVoltage < s_curve[i][0])
+            {
+                return s_curve[i-1][1] + (s_curve[i][1] - s_curve[i-1][1]) * (f_cellVoltage - s_curve[i-1][0]) / (s_curve[i][0] - s_curve[i-1][0]);
+            }
+        }
+        return 1.0f;
+    }
+
+    /** \brief  Compensated (Kahan) accumulation, the rounding error of the addition is kept and added to the next value
+     *
+     *  @param f_sum           sum
+     *  @param f_compensation  rounding error of the sum
+     *  @param f_value         added value
+     */
+    CONTROL_RAMFUNC void CBatteryMonitor::accumulate(float& f_sum, float& f_compensation, float f_value)
+    {
+        float l_value = f_value - f_compensation;
+        float l_sum = f_sum + l_value;
+        f_compensation = (l_sum - f_sum) - l_value;
+        f_sum = l_sum;
+    }
+
+}; // namespace hardware::sampling
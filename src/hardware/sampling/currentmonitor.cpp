@@ -0,0 +1,144 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    CurrentMonitor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the motor current monitor with overcurrent trip.
+  ******************************************************************************
+ */
+
+#include <hardware/sampling/currentmonitor.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace hardware::sampling{
+
+    /** \brief  CCurrentMonitor class constructor
+     *
+     *  @param f_adc           analog scanner in synchronized mode
+     *  @param f_index         index of the current in the sequence of the scanner
+     *  @param f_scale         current in ampere at full scale
+     *  @param f_filter        filter of the samples, it's applied with the pwm rate
+     *  @param f_driver        motor driver, it's switched off by the trip
+     */
+    CCurrentMonitor::CCurrentMonitor(hardware::drivers::CAdcDmaScanner_ADC1&       f_adc
+                                    ,uint8_t                                       f_index
+                                    ,float                                         f_scale
+                                    ,signal::filter::IFilter<float>&               f_filter
+                                    ,hardware::drivers::CMotorDriverVnh&           f_driver)
+        : m_adc(f_adc)
+        , m_index(f_index)
+        , m_scale(f_scale)
+        , m_filter(f_filter)
+        , m_driver(f_driver)
+        , m_callback()
+        , m_releaseCurrent(0.0f)
+        , m_slot(0)
+        , m_current(0.0f)
+        , m_tripCount(0)
+        , m_reportedCount(0)
+        , m_isStarted(false)
+    {
+    }
+
+    /** \brief  Configure and arm the overcurrent trip, the scanner has to be started.
+     *
+     *  @param f_tripCurrent       current of the trip in ampere, it's compared with each sample
+     *  @param f_releaseCurrent    the bridge is released below this filtered current
+     *  @param f_callback          callback of the trip
+     */
+    void CCurrentMonitor::start(float f_tripCurrent, float f_releaseCurrent, FTripCallback f_callback)
+    {
+        float l_raw = f_tripCurrent / m_scale * hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+        uint16_t l_high = (l_raw >= hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale) ? hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale : static_cast<uint16_t>(l_raw);
+        m_releaseCurrent = f_releaseCurrent;
+        m_callback = f_callback;
+        m_slot = m_adc.getPosition();
+        m_adc.setWatchdog(m_index, l_high, mbed::callback(this, &CCurrentMonitor::tripCallback));
+        m_adc.armWatchdog();
+        m_isStarted = true;
+    }
+
+    /** \brief  Pipeline stage. It filters the samples of the pwm periods since the last tick and it sets the sampling point 
+     *  to the middle of the on-time. It reports the trip and it releases the bridge after the decrease of the current.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CCurrentMonitor::process(uint32_t f_timestamp)
+    {
+        float l_phase = 0.5f * m_driver.getDuty();
+        m_adc.setPhase(l_phase < 0.02f ? 0.02f : (l_phase > 0.98f ? 0.98f : l_phase));
+
+        // The samples of the elapsed pwm periods are converted in a block and filtered by one call
+        uint8_t l_position = m_adc.getPosition();
+        float l_samples[hardware::drivers::CAdcDmaScanner_ADC1::s_maxDepth];
+        uint32_t l_count = 0;
+        while (m_slot != l_position && l_count < hardware::drivers::CAdcDmaScanner_ADC1::s_maxDepth)
+        {
+            l_samples[l_count++] = static_cast<float>(m_adc.getSample(m_slot, m_index)) * m_scale / hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+            m_slot = (m_slot + 1) % m_adc.getDepth();
+        }
+        float l_current = m_current;
+        if (l_count > 0)
+        {
+            m_filter.process(l_samples, l_samples, l_count);
+            l_current = l_samples[l_count - 1];
+        }
+        m_current = l_current;
+
+        if (!m_isStarted)
+        {
+            return;
+        }
+        uint32_t l_tripCount = m_tripCount;
+        if (l_tripCount != m_reportedCount)
+        {
+            m_reportedCount = l_tripCount;
+            if (m_callback)
+            {
+                m_callback();
+            }
+        }
+        if (m_driver.isTripped() && l_current < m_releaseCurrent)
+        {
+            m_driver.release();
+            m_adc.armWatchdog();
+        }
+    }
+
+    /** \brief  Serial callback of the state, the response contains the filtered current (A), the number of the trips 
+     *  and the state of the bridge (1 - switched off).
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CCurrentMonitor::serialCallback(char const * a, char * b)
+    {
+        utils::fmt::CWriter(b).fixed(m_current,3).udec(m_tripCount).udec(m_driver.isTripped() ? 1 : 0).chr(';');
+    }
+
+    /** \brief  Interrupt of the analog watchdog, it switches off the bridge immediately.
+     */
+    void CCurrentMonitor::tripCallback()
+    {
+        m_driver.trip();
+        m_tripCount = m_tripCount + 1;
+    }
+
+}; // namespace hardware::sampling
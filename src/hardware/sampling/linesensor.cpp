@@ -0,0 +1,207 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    LineSensor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the reflective infrared line array.
+  ******************************************************************************
+ */
+
+#include <hardware/sampling/linesensor.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace hardware::sampling{
+
+    /** \brief  CLineSensor class constructor
+     *
+     *  The elements are uncalibrated, the full scale of the ADC is applied.
+     *
+     *  @param f_sampler       reference to the sampler
+     *  @param f_first         index of the first element in the snapshot
+     *  @param f_count         number of the elements, maximum g_maxLineChannels
+     *  @param f_pitch         distance of the elements in meter
+     *  @param f_darkLine      the line reflects less than the background (black line on white ground)
+     */
+    CLineSensor::CLineSensor(CSampler& f_sampler, uint8_t f_first, uint8_t f_count, float f_pitch, bool f_darkLine)
+        : m_sampler(f_sampler)
+        , m_first(f_first)
+        , m_count(f_count < g_maxLineChannels ? f_count : g_maxLineChannels)
+        , m_pitch(f_pitch)
+        , m_darkLine(f_darkLine)
+        , m_isCalibrating(false)
+        , m_reading()
+        , m_sequence(0)
+    {
+        for (uint8_t i = 0; i < g_maxLineChannels; i++)
+        {
+            m_min[i] = 0;
+            m_scale[i] = 1.0f / hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+            m_recordedMin[i] = hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+            m_recordedMax[i] = 0;
+        }
+    }
+
+    /** \brief  Pipeline stage, it normalizes the readings of the snapshot and it estimates the position of the line
+     *
+     *  The snapshot without valid analog conversion isn't processed, the last reading is kept.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CLineSensor::process(uint32_t f_timestamp)
+    {
+        const SSnapshot& l_snapshot = m_sampler.current();
+        if (!l_snapshot.m_analogValid || 0 == m_count)
+        {
+            return;
+        }
+        m_sequence = m_sequence + 1;
+        __DMB();
+        const bool l_isCalibrating = m_isCalibrating;
+        float l_peak = 0.0f;
+        float l_sum = 0.0f;
+        uint8_t l_peakIdx = 0;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            uint16_t l_raw = l_snapshot.m_analog[m_first + i];
+            if (l_isCalibrating)
+            {
+                m_recordedMin[i] = (l_raw < m_recordedMin[i]) ? l_raw : m_recordedMin[i];
+                m_recordedMax[i] = (l_raw > m_recordedMax[i]) ? l_raw : m_recordedMax[i];
+            }
+            float l_value = (l_raw > m_min[i]) ? static_cast<float>(l_raw - m_min[i]) * m_scale[i] : 0.0f;
+            l_value = (l_value < 1.0f) ? l_value : 1.0f;
+            l_value = m_darkLine ? (1.0f - l_value) : l_value;
+            m_reading.m_values[i] = l_value;
+            l_sum += l_value;
+            if (l_value > l_peak)
+            {
+                l_peak = l_value;
+                l_peakIdx = i;
+            }
+        }
+        m_reading.m_timestamp = f_timestamp;
+        m_reading.m_contrast = l_peak - l_sum / m_count;
+        m_reading.m_valid = m_reading.m_contrast >= s_minContrast;
+        if (m_reading.m_valid)
+        {
+            // Vertex of the parabola through the peak and its neighbours, the border elements aren't refined
+            float l_offset = 0.0f;
+            if (l_peakIdx > 0 && l_peakIdx + 1 < m_count)
+            {
+                float l_left = m_reading.m_values[l_peakIdx - 1];
+                float l_right = m_reading.m_values[l_peakIdx + 1];
+                float l_curvature = l_left - 2.0f * l_peak + l_right;
+                l_offset = (l_curvature < 0.0f) ? 0.5f * (l_left - l_right) / l_curvature : 0.0f;
+            }
+            m_reading.m_position = (static_cast<float>(l_peakIdx) + l_offset - 0.5f * static_cast<float>(m_count - 1)) * m_pitch;
+        }
+        __DMB();
+        m_sequence = m_sequence + 1;
+    }
+
+    /** \brief  Get a consistent copy of the last reading
+     *
+     *  It repeats the reading, when the reading was updated meanwhile.
+     *
+     *  @return                reading
+     */
+    SLineReading CLineSensor::getReading()
+    {
+        SLineReading l_reading;
+        uint32_t l_sequence;
+        do
+        {
+            l_sequence = m_sequence;
+            __DMB();
+            l_reading = m_reading;
+            __DMB();
+        } while ((l_sequence & 1) || l_sequence != m_sequence);
+        return l_reading;
+    }
+
+    /** \brief  Start the recording of the ranges, the previous calibration is applied until the end of the recording
+     */
+    void CLineSensor::startCalibration()
+    {
+        core_util_critical_section_enter();
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            m_recordedMin[i] = hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+            m_recordedMax[i] = 0;
+        }
+        m_isCalibrating = true;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Stop the recording and apply the recorded ranges
+     *
+     *  @return                false, when an element doesn't have the minimal range, the previous calibration is kept in this case
+     */
+    bool CLineSensor::finishCalibration()
+    {
+        core_util_critical_section_enter();
+        m_isCalibrating = false;
+        bool l_isValid = true;
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            l_isValid = l_isValid && (m_recordedMax[i] >= m_recordedMin[i] + s_minRange);
+        }
+        for (uint8_t i = 0; i < m_count && l_isValid; i++)
+        {
+            m_min[i] = m_recordedMin[i];
+            m_scale[i] = 1.0f / static_cast<float>(m_recordedMax[i] - m_recordedMin[i]);
+        }
+        core_util_critical_section_exit();
+        return l_isValid;
+    }
+
+    /** \brief  Serial callback method to get the position of the line or to calibrate the elements
+     *
+     * @param a                   input received string, 0: state, 1: start the calibration, 2: apply the calibration
+     * @param b                   output reponse message
+     */
+    void CLineSensor::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            SLineReading l_reading = getReading();
+            utils::fmt::CWriter(b).udec(l_reading.m_valid ? 1 : 0).fixed(l_reading.m_position * 1000.0f,1).fixed(l_reading.m_contrast,2).chr(';');
+        }
+        else if (1 == l_command)
+        {
+            startCalibration();
+            sprintf(b,"ack;;");
+        }
+        else if (2 == l_command)
+        {
+            sprintf(b, finishCalibration() ? "ack;;" : "calibration error;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace hardware::sampling
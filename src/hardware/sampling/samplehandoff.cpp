@@ -0,0 +1,75 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    SampleHandoff.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the handoff of the
+  *          sensor samples to the consumer threads.
+  ******************************************************************************
+ */
+
+#include <hardware/sampling/samplehandoff.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace hardware::sampling{
+
+    /** \brief  CSampleHandoff class constructor
+     *
+     *  @param f_sampler       reference to the sampler
+     *  @param f_encoder       reference to the speed encoder, its stage precedes this one
+     *  @param f_mail          reference to the mail of the blocks
+     *  @param f_decimation    number of the ticks per sample, at least one
+     */
+    CSampleHandoff::CSampleHandoff(CSampler& f_sampler, hardware::encoders::IEncoderGetter& f_encoder, CSampleMail& f_mail, uint32_t f_decimation)
+        : m_sampler(f_sampler)
+        , m_encoder(f_encoder)
+        , m_mail(f_mail)
+        , m_decimation((f_decimation > 0) ? f_decimation : 1)
+        , m_ticks(0)
+    {
+    }
+
+    /** \brief  Pipeline stage, it fills a block with the sample of the tick and it passes the block to the consumer
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CSampleHandoff::process(uint32_t f_timestamp)
+    {
+        if (++m_ticks < m_decimation)
+        {
+            return;
+        }
+        m_ticks = 0;
+        SSampleBlock* l_block = m_mail.claim();
+        if (NULL == l_block)
+        {
+            return;
+        }
+        const SSnapshot& l_snapshot = m_sampler.current();
+        l_block->m_timestamp = f_timestamp;
+        l_block->m_count = m_encoder.getCount();
+        l_block->m_speedRps = m_encoder.getSpeedRps();
+        l_block->m_analogValid = l_snapshot.m_analogValid;
+        for (uint8_t i = 0; i < hardware::drivers::CAdcDmaScanner_ADC1::s_maxChannels; i++)
+        {
+            l_block->m_analog[i] = l_snapshot.m_analog[i];
+        }
+        m_mail.publish(l_block);
+    }
+
+}; // namespace hardware::sampling
@@ -0,0 +1,183 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Sampler.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the batched sampling of the sensors.
+  ******************************************************************************
+ */
+
+#include <hardware/sampling/sampler.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace hardware::sampling{
+
+    /** \brief  CSampler class constructor
+     *
+     *  @param f_adc           reference to the analog scanner
+     *  @param f_counters      list of the latched counters
+     *  @param f_counterCount  number of the counters, maximum g_maxCounters
+     */
+    CSampler::CSampler(hardware::drivers::CAdcDmaScanner_ADC1& f_adc, hardware::drivers::IQuadratureCounter_TIMX** f_counters, uint8_t f_counterCount)
+        : m_adc(f_adc)
+        , m_counters(f_counters)
+        , m_counterCount(f_counterCount < g_maxCounters ? f_counterCount : g_maxCounters)
+        , m_snapshot()
+        , m_sequence(0)
+    {
+        for (uint8_t i = 0; i < m_counterCount; i++)
+        {
+            m_snapshot.m_counters[i] = m_counters[i]->getRawCount();
+        }
+    }
+
+    /** \brief  Start the analog scanner
+     */
+    void CSampler::start()
+    {
+        m_adc.start();
+    }
+
+    /** \brief  Pipeline stage, it takes the snapshot of the tick
+     *
+     *  The conversion runs, while the counters are latched, then it waits the end of the conversion.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CSampler::process(uint32_t f_timestamp)
+    {
+        m_adc.trigger();
+        m_sequence = m_sequence + 1;
+        __DMB();
+        for (uint8_t i = 0; i < m_counterCount; i++)
+        {
+            m_snapshot.m_counters[i] = m_counters[i]->getRawCount();
+        }
+        m_snapshot.m_timestamp = f_timestamp;
+        m_snapshot.m_analogValid = m_adc.wait();
+        for (uint8_t i = 0; i < m_adc.getCount(); i++)
+        {
+            m_snapshot.m_analog[i] = m_adc.getValue(i);
+        }
+        __DMB();
+        m_sequence = m_sequence + 1;
+    }
+
+    /** \brief  Get a consistent copy of the last snapshot
+     *
+     *  It repeats the reading, when the snapshot was updated meanwhile.
+     *
+     *  @return                snapshot
+     */
+    SSnapshot CSampler::getSnapshot()
+    {
+        SSnapshot l_snapshot;
+        uint32_t l_sequence;
+        do
+        {
+            l_sequence = m_sequence;
+            __DMB();
+            l_snapshot = m_snapshot;
+            __DMB();
+        } while ((l_sequence & 1) || l_sequence != m_sequence);
+        return l_snapshot;
+    }
+
+    /** \brief  CLatchedCounter class constructor
+     *
+     *  @param f_sampler       reference to the sampler
+     *  @param f_counter       reference to the underlying counter
+     *  @param f_index         index of the counter in the snapshot
+     */
+    CLatchedCounter::CLatchedCounter(CSampler& f_sampler, hardware::drivers::IQuadratureCounter_TIMX& f_counter, uint8_t f_index)
+        : m_sampler(f_sampler)
+        , m_counter(f_counter)
+        , m_index(f_index)
+    {
+    }
+
+    /** \brief  Lower 16 bits of the latched value */
+    int16_t CLatchedCounter::getCount()
+    {
+        return static_cast<int16_t>(m_sampler.current().m_counters[m_index]);
+    }
+
+    /** \brief  Reset the underlying counter */
+    void CLatchedCounter::reset()
+    {
+        m_counter.reset();
+    }
+
+    /** \brief  Latched raw value */
+    uint32_t CLatchedCounter::getRawCount()
+    {
+        return m_sampler.current().m_counters[m_index];
+    }
+
+    /** \brief  Width of the underlying counter */
+    bool CLatchedCounter::is32Bit()
+    {
+        return m_counter.is32Bit();
+    }
+
+    /** \brief  CSampledCurrent class constructor
+     *
+     *  @param f_sampler       reference to the sampler
+     *  @param f_index         index of the analog input in the snapshot
+     *  @param f_scale         current in ampere at full scale
+     */
+    CSampledCurrent::CSampledCurrent(CSampler& f_sampler, uint8_t f_index, float f_scale)
+        : m_sampler(f_sampler)
+        , m_index(f_index)
+        , m_scale(f_scale)
+    {
+    }
+
+    /** \brief  Get the current of the last snapshot
+     *
+     *  \return    Measured current [A]
+     */
+    float CSampledCurrent::getCurrent()
+    {
+        return static_cast<float>(m_sampler.current().m_analog[m_index]) * m_scale / hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+    }
+
+    /** \brief  CSampledVoltage class constructor
+     *
+     *  @param f_sampler       reference to the sampler
+     *  @param f_index         index of the analog input in the snapshot
+     *  @param f_scale         voltage in volt at full scale, the reference voltage multiplied by the ratio of the divider
+     */
+    CSampledVoltage::CSampledVoltage(CSampler& f_sampler, uint8_t f_index, float f_scale)
+        : m_sampler(f_sampler)
+        , m_index(f_index)
+        , m_scale(f_scale)
+    {
+    }
+
+    /** \brief  Get the voltage of the last snapshot
+     *
+     *  \return    Measured voltage [V]
+     */
+    float CSampledVoltage::getVoltage()
+    {
+        return static_cast<float>(m_sampler.current().m_analog[m_index]) * m_scale / hardware::drivers::CAdcDmaScanner_ADC1::s_fullScale;
+    }
+
+}; // namespace hardware::sampling
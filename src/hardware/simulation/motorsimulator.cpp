@@ -0,0 +1,215 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+ * @file motorsimulator.cpp
+ * @author RBRO/PJ-IU
+ * @brief 
+ * @version 0.1
+ * @date 2019-12-02
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#include <hardware/simulation/motorsimulator.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace hardware::simulation{
+
+/**
+ * @brief Construct a new CMotorSimulator object
+ * 
+ * @param f_period              Period of the pipeline in second
+ * @param f_resolution          The resolution of the simulated encoder. (Cpr count per revolution)
+ * @param f_model               Parameters of the motor model
+ * @param f_substeps            Number of the Euler steps in a period, the step has to be shorter than the electrical time constant (L/R)
+ * @param f_inf_limit           Inferior limit of the pwm
+ * @param f_sup_limit           Superior limit of the pwm
+ */
+CMotorSimulator::CMotorSimulator(float f_period, uint16_t f_resolution, const SMotorModel& f_model, uint8_t f_substeps, float f_inf_limit, float f_sup_limit)
+    :m_resolution(f_resolution)
+    ,m_period(f_period)
+    ,m_supply(f_model.m_supply)
+    ,m_backEmf(f_model.m_backEmf)
+    ,m_inf_limit(f_inf_limit)
+    ,m_sup_limit(f_sup_limit)
+    ,m_model(systemModel(f_period, f_model, f_substeps))
+    ,m_direction(0)
+    ,m_duty(0)
+    ,m_load(0)
+    ,m_count(0)
+    ,m_speed(0)
+    ,m_current(0)
+{
+}
+
+/**
+ * @brief It creates the discrete model: x = [position, speed, current], u = [voltage, load], y = [speed, current]. The Euler 
+ * step of the substep is applied f_substeps times, so A = Ae^n and B = (Ae^(n-1) + ... + Ae + I) * Be.
+ * 
+ * @param f_period              Period in second
+ * @param f_model               Parameters of the motor model
+ * @param f_substeps            Number of the Euler steps in a period
+ * @return                      System model
+ */
+CMotorSimulator::CModelType CMotorSimulator::systemModel(float f_period, const SMotorModel& f_model, uint8_t f_substeps){
+    const float l_pi2 = 6.28318531f;
+    const uint8_t l_substeps = f_substeps > 0 ? f_substeps : 1;
+    const float l_dt = f_period / l_substeps;
+    const float l_torqueConstant = f_model.m_backEmf / l_pi2;
+    CModelType::CStateTransitionType l_Ae({
+        1.0f, l_dt,                                                         0.0f,
+        0.0f, 1.0f - f_model.m_friction * l_dt / (l_pi2 * f_model.m_inertia), l_torqueConstant * l_dt / (l_pi2 * f_model.m_inertia),
+        0.0f, -f_model.m_backEmf * l_dt / f_model.m_inductance,             1.0f - f_model.m_resistance * l_dt / f_model.m_inductance });
+    CModelType::CInputMatrixType l_Be({
+        0.0f,                               0.0f,
+        0.0f,                               -l_dt / (l_pi2 * f_model.m_inertia),
+        l_dt / f_model.m_inductance,        0.0f });
+    CModelType::CStateTransitionType l_A(CModelType::CStateTransitionType::eye());
+    CModelType::CStateTransitionType l_sum(CModelType::CStateTransitionType::zeros());
+    for (uint8_t i = 0; i < l_substeps; ++i)
+    {
+        l_sum += l_A;
+        l_A = l_A * l_Ae;
+    }
+    CModelType::CMeasurementMatrixType l_C({
+        0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 1.0f });
+    return CModelType(l_A, l_sum * l_Be, l_C);
+}
+
+/**
+ * @brief It applies one period of the model with the last command and it counts the impulses of the encoder. 
+ * 
+ * @param f_timestamp           Timestamp of the tick in microsecond
+ */
+void CMotorSimulator::process(uint32_t f_timestamp){
+    // The braking bridge is open in the rest of the period, the averaged terminal voltage is the back-EMF in this part
+    float l_voltage = (0 != m_direction) ? m_direction * m_duty * m_supply : (1.0f - m_duty) * m_backEmf * m_model.state()[1][0];
+    CModelType::CControlType l_u({l_voltage, m_load});
+    CModelType::CMeasurementType l_y = m_model(l_u);
+
+    // Count the passed impulses, the remainder of the position stays in the state
+    CModelType::CStateType& l_x = m_model.state();
+    int32_t l_impulses = static_cast<int32_t>(std::floor(l_x[0][0] * m_resolution));
+    l_x[0][0] -= l_impulses / m_resolution;
+    m_count = static_cast<int16_t>(l_impulses);
+    m_position += l_impulses;
+
+    m_speed = l_y[0][0];
+    m_current = l_y[1][0];
+}
+
+/**
+ * @brief Set the pwm command, the sign gives the direction. 
+ * 
+ * @param f_pwm                 Pwm command
+ */
+void CMotorSimulator::setSpeed(float f_pwm){
+    m_direction = f_pwm >= 0 ? 1 : -1;
+    m_duty = std::min(std::abs(f_pwm), 1.0f);
+}
+
+/**
+ * @brief It brakes the motor, the bridge shorts the motor like the dynamic braking of the driver.
+ * 
+ */
+void CMotorSimulator::brake(){
+    dynamicBrake(1.0f);
+}
+/**
+ * @brief It switches off the bridge, the motor freewheels without current.
+ * 
+ */
+void CMotorSimulator::coast(){
+    dynamicBrake(0.0f);
+}
+/**
+ * @brief Proportional dynamic braking, the motor is shorted in the given part of the period.
+ * 
+ * @param f_duty                Duty cycle of the braking, only the magnitude is applied
+ */
+void CMotorSimulator::dynamicBrake(float f_duty){
+    m_direction = 0;
+    m_duty = std::min(std::abs(f_duty), 1.0f);
+}
+
+/**
+ * @brief It inverts the direction, after the brake it remains braked like the driver (both outputs are high).
+ * 
+ * @param f_pwm                 Pwm command, only the magnitude is applied
+ */
+void CMotorSimulator::inverseDirection(float f_pwm){
+    m_direction = -m_direction;
+    m_duty = std::min(std::abs(f_pwm), 1.0f);
+}
+
+/**
+ * @brief Check the pwm command is in the allowed range.
+ * 
+ * @param f_pwm                 Pwm command
+ * @return true                 The command is in the range
+ * @return false                The command is out of the range
+ */
+bool CMotorSimulator::inRange(float f_pwm){
+    return m_inf_limit<=f_pwm && f_pwm <=m_sup_limit;
+}
+
+/**
+ * @brief Get the magnitude of the simulated current, the current sense of the driver doesn't measure the sign.
+ * 
+ * @return Current in ampere
+ */
+float CMotorSimulator::getCurrent(){
+    return std::abs(m_current);
+}
+
+/**
+ * @brief Get the counted impulses in the last period.
+ * 
+ * @return Counted impulses
+ */
+int16_t CMotorSimulator::getCount(){
+    return m_count;
+}
+
+/**
+ * @brief Get the measured rotation speed by the counted impulses in the last period, like the encoder.
+ * 
+ * @return Rotation speed in rps
+ */
+float CMotorSimulator::getSpeedRps(){
+    return m_count / m_resolution / m_period;
+}
+
+/**
+ * @brief Set the load torque, it acts against the positive direction.
+ * 
+ * @param f_torque              Load torque in N*m
+ */
+void CMotorSimulator::setLoad(float f_torque){
+    m_load = f_torque;
+}
+
+/**
+ * @brief Get the simulated rotation speed without quantization.
+ * 
+ * @return Rotation speed in rps
+ */
+float CMotorSimulator::getModelSpeedRps(){
+    return m_speed;
+}
+
+}; // namespace hardware::simulation
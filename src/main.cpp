@@ -22,23 +22,132 @@
 /* The mbed library */
 #include <mbed.h>
 /* Task manager */
-#include <utils/taskmanager/taskmanager.hpp>
+#include <utils/taskmanager/prioritytaskmanager.hpp>
+
+#include <utils/taskmanager/taskmonitor.hpp>
+#include <utils/taskmanager/schedulability.hpp>
+/* Report of the memory usage */
+#include <utils/memory/memoryreport.hpp>
+/* CPU load and stack headroom monitor */
+#include <utils/taskmanager/loadmonitor.hpp>
+/* Low-power mode of the parked car */
+#include <utils/power/powermanager.hpp>
+/* Clock synchronization with the host */
+#include <utils/clock/clocksync.hpp>
+/* Statistical sampling profiler */
+#include <utils/taskmanager/profiler.hpp>
+/* Deferred work of the serial callbacks */
+#include <utils/taskmanager/workqueue.hpp>
 /* Header file for the blinker functionality */
 #include <examples/blinker.hpp>
 /* Header file for the serial communication functionality */
 #include <utils/serial/serialmonitor.hpp>
+
+#include <hardware/drivers/serialdmareceiver.hpp>
+#include <hardware/drivers/serialdmasender.hpp>
+#include <utils/serial/serialtransmitter.hpp>
+#include <utils/serial/linkbenchmark.hpp>
+#include <utils/serial/baudnegotiator.hpp>
+#include <hardware/drivers/uartbaudrate.hpp>
+/* Telemetry channel */
+#include <utils/telemetry/telemetry.hpp>
+#include <utils/telemetry/derivedsignals.hpp>
+#include <utils/telemetry/sdlogsink.hpp>
+#include <utils/telemetry/flightrecorder.hpp>
+#include <utils/telemetry/commandrecorder.hpp>
+#include <utils/telemetry/tracestream.hpp>
+#include <utils/telemetry/signalscope.hpp>
+#include <utils/publisher/publisher.hpp>
+#include <utils/config/configstore.hpp>
+#include <utils/config/vehicleprofile.hpp>
+#include <utils/update/firmwareupdate.hpp>
 /* Header file for the motion controller functionality */
 #include <brain/robotstatemachine.hpp>
+/* Control loop driven by hardware timer */
+#include <brain/controlloop.hpp>
+#include <brain/loadshedder.hpp>
+/* Safety monitor of the commands and the watchdog */
+#include <brain/safetymonitor.hpp>
+/* Blink codes of the status on the built-in led */
+#include <brain/statusindicator.hpp>
+/* Crash capture of the fatal faults */
+#include <hardware/drivers/crashcapture.hpp>
+/* On-board odometry by the kinematic bicycle model */
+#include <brain/odometry.hpp>
+#include <brain/pathfollower.hpp>
+#include <brain/energygovernor.hpp>
 /* Header file for the sensor task functionality */
 #include <examples/sensors/encoderpublisher.hpp>
 /* Header file  for the controller functionality */
 #include <signal/controllers/motorcontroller.hpp>
+#include <signal/controllers/tractioncontrol.hpp>
+#include <signal/controllers/compensation.hpp>
+#include <signal/controllers/yawratesteering.hpp>
+#include <signal/systemmodels/steeringgeometry.hpp>
+#include <signal/controllers/supplycompensation.hpp>
 /* Quadrature encoder functionality */
 #include <hardware/encoders/quadratureencoder.hpp>
+// The Kalman filter based speed observer
+#include <hardware/encoders/speedobserver.hpp>
+#include <hardware/encoders/ripplefilter.hpp>
+#include <hardware/encoders/singlechannelencoder.hpp>
+#include <hardware/encoders/encodermonitor.hpp>
+/* Batched sampling of the sensors */
+#include <hardware/sampling/sampler.hpp>
+#include <hardware/sampling/currentmonitor.hpp>
+#include <hardware/sampling/linesensor.hpp>
+#include <hardware/sampling/batterymonitor.hpp>
+#include <hardware/sampling/samplehandoff.hpp>
+#include <signal/systemmodels/thermalmodel.hpp>
+#include <signal/systemmodels/motoridentifier.hpp>
+#include <signal/systemmodels/pwmcharacterizer.hpp>
+#include <signal/graph/signalgraph.hpp>
+#include <signal/filter/samplefusion.hpp>
+/* Simulated plant of the motor for the closed-loop tests */
+#include <hardware/simulation/motorsimulator.hpp>
+/* Non-blocking I2C master and the inertial sensor */
+#include <hardware/drivers/i2cdmamaster.hpp>
+#include <hardware/imu/mpu6050.hpp>
+/* Distance sensors of the emergency stop */
+#include <hardware/drivers/echocapture.hpp>
+#include <hardware/distance/ultrasonicranger.hpp>
+#include <hardware/distance/tfluna.hpp>
+/* CAN transport on the external controller */
+#include <hardware/can/mcp2515.hpp>
+#include <utils/can/cantransport.hpp>
+#include <utils/can/canpublisher.hpp>
+#include <utils/can/ticksync.hpp>
+#include <utils/log/eventlog.hpp>
+/* Memory sections of the control path */
+#include <utils/memory/sections.hpp>
+/* Prioritized initialization sequence */
+#include <utils/init/initsequence.hpp>
+/* Number formatting and parsing of the serial commands */
+#include <utils/fmt/format.hpp>
+/* Register table of the parameters and the live signals */
+#include <utils/registers/registertable.hpp>
 
 
+/// Default baud rate of the control link, the host can negotiate a faster rate up to the limit of the ST-Link VCP ('BAUD' key).
+const uint32_t g_rpiBaud = 256000;
+/// Maximum baud rate of the control link
+const uint32_t g_rpiMaxBaud = 2000000;
+/// Default baud rate of the bulk interface
+const uint32_t g_debugBaud = 921600;
+/// Maximum baud rate of the bulk interface, the USART6 is on APB2 (84 MHz)
+const uint32_t g_debugMaxBaud = 4000000;
 /// Serial interface with the another device(like single board computer). It's an built-in class of mbed based on the UART comunication, the inputs have to be transmiter and receiver pins. 
 Serial          g_rpi(USBTX, USBRX);
+/// Create the DMA based sender of the serial interface.
+hardware::drivers::CSerialDmaSender_USART2 g_rpiSender;
+/// Create the buffered transmitter, which is shared by all message producers. The messages are transmitted in background by DMA, without blocking the producers.
+utils::serial::CSerialTransmitter g_rpiTransmitter(g_rpiSender);
+/// Second serial interface for the bulk traffic (telemetry, publishers and diagnostics) on the USART6 pins of the morpho connector, so it doesn't delay the control commands.
+Serial          g_debug(PA_11, PA_12);
+/// Create the DMA based sender of the bulk interface.
+hardware::drivers::CSerialDmaSender_USART6 g_debugSender;
+/// Create the buffered transmitter of the bulk interface, it has its own buffer, so the high-rate telemetry doesn't drop the responses of the control link.
+utils::serial::CSerialTransmitter g_debugTransmitter(g_debugSender);
 /** @brief 
  * This object is used to control the direction and the rotation speed of the wheel. The fist input respresents the pin for the servo motor, it must to generate a PWM signal. 
  * The second input  is the pin for generating PWM signal for the DC-Motor driver. The third and fourth inputs give the direction of the DC Motor, they are digital pins. The last input parameter represent an analog input pin, to measure the electric current.
@@ -46,75 +155,1324 @@ Serial          g_rpi(USBTX, USBRX);
 hardware::drivers::CMotorDriverVnh g_motorVnhDriver(D3, D2, D4, A0);
 hardware::drivers::CSteeringMotor g_steeringDriver(D9);
 
+/// Profile of the vehicle variant, the rates, the geometry and the motor model are derived from it ('make VEHICLE=<name>').
+constexpr const utils::config::SVehicleProfile& g_vehicle = utils::config::s_vehicle;
 /// Base sample time for the task manager. The measurement unit of base sample time is second.
-const float     g_baseTick = 0.0001; // seconds
-/// It's a task for blinking periodically the built-in led on the Nucleo board.
-examples::CBlinker        g_blinker       (0.5    / g_baseTick, LED1);
+constexpr float g_baseTick = g_vehicle.m_baseTick;
+#ifdef WHEEL_SENSOR
+/// It's a task for blinking periodically the built-in led on the Nucleo board, the TIM1 of the status led captures the wheel sensor.
+examples::CBlinker        g_blinker       (g_vehicle.ticks(0.5f), LED1);
+#endif
 
 /// The sample time of the encoder, is measured in second. 
-float           g_period_Encoder = 0.001;
+constexpr float g_period_Encoder = g_vehicle.m_controlPeriod;
+
+/// Analog inputs scanned in each tick: current sense of the motor driver, battery voltage over the 20k/10k resistor divider (A1), 
+/// the eight elements of the infrared line array (A2-A5, PC_2-PC_5).
+PinName g_analogPins[] = {A0, A1, A2, A3, A4, A5, PC_2, PC_3, PC_4, PC_5};
+/// Create the DMA based scanner of the analog inputs.
+hardware::drivers::CAdcDmaScanner_ADC1 g_adcScanner(g_analogPins, sizeof(g_analogPins)/sizeof(PinName));
+/// Counters latched in each tick together with the analog inputs.
+hardware::drivers::IQuadratureCounter_TIMX* g_sampledCounters[] = {hardware::drivers::CQuadratureCounter_TIM4::Instance()};
+/// Create the sampler, it takes one coherent snapshot of the sensors at the beginning of each control tick.
+CONTROL_STATE hardware::sampling::CSampler g_sampler(g_adcScanner, g_sampledCounters, sizeof(g_sampledCounters)/sizeof(hardware::drivers::IQuadratureCounter_TIMX*));
+/// Counter of the motor encoder latched by the sampler.
+hardware::sampling::CLatchedCounter g_motorCounter(g_sampler, *hardware::drivers::CQuadratureCounter_TIM4::Instance(), 0);
+/// Current of the motor from the snapshot, the conversion is the same as by the motor driver.
+hardware::sampling::CSampledCurrent g_motorCurrent(g_sampler, 0, 5 / 0.14);
+/// Battery voltage from the snapshot, the divider scales the 9.9 V full scale to the 3.3 V reference.
+hardware::sampling::CSampledVoltage g_batteryVoltage(g_sampler, 1, 3.3f * 3.0f);
+/// Infrared line array from the snapshot ('LINE' key), eight elements from the third analog input with 8 mm pitch, black line on white ground.
+CONTROL_STATE hardware::sampling::CLineSensor g_lineSensor(g_sampler, 2, 8, 0.008f, true);
+/// Moving average of the current samples over one control period (five pwm periods).
+CONTROL_STATE signal::filter::lti::siso::CMovingAverageFilter<float,5> g_currentFilter;
+/// Create the current monitor, it filters the pwm synchronized samples and it switches off the bridge by the analog watchdog on overcurrent.
+CONTROL_STATE hardware::sampling::CCurrentMonitor g_currentMonitor(g_adcScanner, 0, 5 / 0.14, g_currentFilter, g_motorVnhDriver);
+/// Create the battery monitor ('BMON' key), it integrates the power of the pack voltage and the motor current scaled by the duty cycle.
+CONTROL_STATE hardware::sampling::CBatteryMonitor g_batteryMonitor(g_period_Encoder, mbed::callback(&g_batteryVoltage,&hardware::sampling::CSampledVoltage::getVoltage)
+                                                                  , g_currentMonitor, mbed::callback(&g_motorVnhDriver,&hardware::drivers::CMotorDriverVnh::getDuty)
+                                                                  , g_vehicle.m_batteryCells, g_vehicle.m_batteryCapacity, 0.5f);
 
-/// Create a filter object for filtrating the noise appeared on the rotary encoder.
-signal::filter::lti::siso::CIIRFilter<float,1,2> g_encoderFilter(utils::linalg::CRowVector<float,1>({ -0.77777778})
-                                                        ,utils::linalg::CRowVector<float,2>({0.11111111,0.11111111}));
-/// Create a quadrature encoder object with a filter. It periodically measueres the rotary speed of the motor and applies the given filter. 
-hardware::encoders::CQuadratureEncoderWithFilter g_quadratureEncoderTask(g_period_Encoder,hardware::drivers::CQuadratureCounter_TIM4::Instance(),2048,g_encoderFilter);
+/// Create the edge capture of the encoder channel, it measures the time between the edges at low speed.
+hardware::drivers::CEncoderEdgeCapture_TIM4 g_encoderEdgeCapture;
+/// Create a quadrature encoder object with M/T speed estimation. It periodically measueres the rotary speed of the motor, below 5 rps from the time 
+/// between the edges, above 10 rps from the count of the period and blended between them, so the speed doesn't need the IIR filter and its phase lag. 
+/// The counter runs freely, so no impulse is lost between the periods.
+CONTROL_STATE hardware::encoders::CQuadratureEncoderMT g_quadratureEncoderTask(g_period_Encoder,&g_motorCounter,g_vehicle.m_encoderResolution,g_encoderEdgeCapture,5.0,10.0,hardware::encoders::CQuadratureEncoder::FREE_RUNNING);
+/// Speed of the medium window (16 periods) of the encoder history, it's less noisy than the speed of a period for the 10 ms samples.
+hardware::encoders::CWindowedSpeed g_encoderMediumSpeed(g_quadratureEncoderTask, hardware::encoders::CQuadratureEncoder::WINDOW_MEDIUM);
+/// Mail of the sample blocks, the blocks are handed off from the control loop to the encoder publisher without copy.
+hardware::sampling::CSampleMail g_sampleMail;
+/// Create the handoff stage after the encoder, it passes the speed and the analog results of each 10th tick in a block of the mail.
+CONTROL_STATE hardware::sampling::CSampleHandoff g_sampleHandoff(g_sampler, g_encoderMediumSpeed, g_sampleMail, g_vehicle.ticks(0.01f));
+/// Create the capture of the index pulse of the encoder (D5), it references the shaft angle and it corrects the drift of the position 
+/// once per revolution ('ENCI' key). Without the index output the input is pulled down and the position is only counted.
+hardware::drivers::CEncoderIndexCapture_TIM4 g_encoderIndexCapture;
+
+/// Create the Kalman filter based speed observer. It fuses the position of the encoder with the pwm command and the motor current; 
+/// with the zero motor model it's a constant acceleration model. The noises: position 1e-5 rot, speed 1e-2 rps, acceleration 1 rps^2 per period, 
+/// measurement by the quantization of the encoder (1/2048/sqrt(12) rot). 
+hardware::encoders::CSpeedObserver g_speedObserver(g_period_Encoder,g_quadratureEncoderTask,g_vehicle.m_encoderResolution,{0.0f,0.0f,0.0f},{1e-5f,1e-2f,1.0f,1.41e-4f});
+/// Create the ripple filter of the speed feedback. The first two harmonics of the ripple (one period per rotation) are removed by notch filters 
+/// (quality 2) tuned by the filtered speed and by the LMS canceller (step 0.01) locked to the rotation, instead of low-pass filtering the 
+/// whole band ('RIPL' key: mode, ripple periods per rotation). Below 20 Hz ripple frequency it's bypassed.
+CONTROL_STATE hardware::encoders::CRippleFilter g_rippleFilter(g_period_Encoder,g_quadratureEncoderTask,g_vehicle.m_encoderResolution,1.0f,2.0f,0.01f,hardware::encoders::CRippleFilter::NOTCH | hardware::encoders::CRippleFilter::ADAPTIVE);
+
+#ifdef SIMULATED_PLANT
+/// Create the simulated plant of the motor (1 Ohm, 0.2 mH, 0.0288 V/rps, 1.05e-6 kg*m^2, 1e-5 N*m/rps, 7.2 V supply, about 116 rps at 0.5 pwm) 
+/// with a simulated encoder of 2048 impulses per rotation. The controller and the state machine are closed on the model instead of the hardware.
+hardware::simulation::CMotorSimulator g_motorSimulator(g_period_Encoder,g_vehicle.m_encoderResolution,{g_vehicle.m_resistance,g_vehicle.m_inductance,g_vehicle.m_backEmf,g_vehicle.m_inertia,g_vehicle.m_friction,g_vehicle.m_supply});
+/// Motor command of the control loop
+hardware::drivers::IMotorCommand&     g_motorCommand = g_motorSimulator;
+/// Speed feedback of the control loop
+hardware::encoders::IEncoderGetter&   g_motorEncoder = g_motorSimulator;
+/// Current of the thermal model
+hardware::drivers::ICurrentGetter&    g_motorHeatingCurrent = g_motorSimulator;
+#elif defined(WHEEL_SENSOR)
+/// Create the DMA based edge capture of the single channel wheel sensor (D7), it doesn't have interrupt per edge.
+hardware::drivers::CEdgeCaptureDma_TIM1 g_wheelCapture;
+/// Create the speed measurement of the wheel sensor (8 edges per rotation), the direction is the sign of the command below 0.5 rps, 
+/// without edge over 0.5 s the speed is zero.
+CONTROL_STATE hardware::encoders::CSingleChannelEncoder g_wheelSensor(g_period_Encoder,g_wheelCapture,g_vehicle.m_wheelSensorEdges,0.5f,0.5f);
+/// Motor command of the control loop
+hardware::drivers::IMotorCommand&     g_motorCommand = g_motorVnhDriver;
+/// Speed feedback of the control loop
+hardware::encoders::IEncoderGetter&   g_motorEncoder = g_wheelSensor;
+/// Current of the thermal model
+hardware::drivers::ICurrentGetter&    g_motorHeatingCurrent = g_currentMonitor;
+#else
+/// Motor command of the control loop
+hardware::drivers::IMotorCommand&     g_motorCommand = g_motorVnhDriver;
+/// Speed feedback of the control loop
+hardware::encoders::IEncoderGetter&   g_motorEncoder = g_rippleFilter;
+/// Current of the thermal model
+hardware::drivers::ICurrentGetter&    g_motorHeatingCurrent = g_currentMonitor;
+#endif
+/// Create the health monitor of the encoder. The motor model (7.2 V supply, 1 Ohm, 0.0288 V/rps) is checked above 10 rps with 50% tolerance and 
+/// the count cannot jump more than 64 impulses per period; the degraded encoder switches the controller to open loop ('ENCH' key).
+CONTROL_STATE hardware::encoders::CEncoderMonitor g_encoderMonitor(g_period_Encoder,g_motorEncoder,g_vehicle.m_encoderResolution,{g_vehicle.m_supply,g_vehicle.m_resistance,g_vehicle.m_backEmf,10.0f,0.5f,64});
+/// Create the thermal model of the motor (1 Ohm winding, 15 J/K winding, 60 J/K housing, 2 K/W winding to housing, 8 K/W housing to ambient, 
+/// 25 C ambient), the pwm and current limits of the controller are derated above 90 C winding temperature ('TEMP' key).
+signal::systemmodels::CMotorThermalModel g_thermalModel(g_period_Encoder, g_motorHeatingCurrent, {1.0f, 15.0f, 60.0f, 2.0f, 8.0f}, 25.0f);
 
 ///Create an encoder publisher object to transmite the rotary speed of the dc motor. 
-examples::sensors::CEncoderPublisher   g_encoderPublisher(0.01/g_baseTick,g_quadratureEncoderTask,g_rpi);
+examples::sensors::CEncoderPublisher   g_encoderPublisher(g_vehicle.ticks(0.01f),g_quadratureEncoderTask,g_debugTransmitter);
 
 //Create an object to convert volt to pwm for motor driver
 /// Create a splines based converter object to convert the volt signal to pwm signal
 signal::controllers::CConverterSpline<2,1> l_volt2pwmConverter({-0.22166,0.22166},{std::array<float,2>({0.1041568079746662,-0.08952760561569219}),std::array<float,2>({0.50805,0.0}),std::array<float,2>({0.1041568079746662,0.08952760561569219})});
-//  signal::controllers::siso::CMotorController<double> l_pidController(g_motorPIDTF,g_period_Encoder);
-signal::controllers::siso::CPidController<double> l_pidController( 0.1150,0.81000,0.000222,0.04,g_period_Encoder);
+/// Sample the spline converter in a lookup table for the control loop. The grid step is the break point (0.22166 V), so the break points are 
+/// grid points and the table reproduces the piecewise linear spline exactly; it's extrapolated by the spline slopes outside of the +/-3.99 V range. 
+CONTROL_STATE signal::controllers::CConverterLookupTable<37> l_volt2pwmTable(l_volt2pwmConverter,-18*0.22166f,18*0.22166f);
+/// Scale the pwm of the table by the battery voltage (0.5 s filter), the table was measured at the nominal supply; below 5 V the divider 
+/// isn't considered connected and the table is applied without correction ('BATT' key).
+CONTROL_STATE signal::controllers::CSupplyCompensation g_supplyCompensation(g_period_Encoder,l_volt2pwmTable,g_vehicle.m_supply,5.0f,0.5f);
+//  signal::controllers::siso::CMotorController<float> l_pidController(g_motorPIDTF,g_period_Encoder);
+/// Create the gain-scheduled pid controller with two operating points by the absolute reference speed (0 and 225 rps). Both points start 
+/// with the same tuned parameters (Kp, Ki, Kd, Tf), so it's equivalent to the single pid controller until the points are tuned by the 'PIDS' command. 
+CONTROL_STATE signal::controllers::siso::CGainScheduledPidController<float,2> l_pidController({0.0f,225.0f},{{{0.1150f,0.81000f,0.000222f,0.04f},{0.1150f,0.81000f,0.000222f,0.04f}}},g_period_Encoder);
+/// Create the Smith predictor around the pid controller with the nominal model of the drive (56 rps/V, 0.1 s, backward Euler), 
+/// the dead time of the loop is the calibration parameter 'SMDLY' (periods, at most 8). Zero delay applies the pid controller 
+/// unchanged; the model is changed by the 'SMTH' key.
+CONTROL_STATE signal::controllers::siso::CSmithPredictor<float,2,8> g_smithPredictor(l_pidController, signal::systemmodels::lti::toTransferFunction<float,2>(
+    signal::systemmodels::lti::discretize(signal::systemmodels::lti::SContinuousTransferFunction<2>{{56.0, 0.0}, {1.0, 0.1}}, g_period_Encoder, signal::systemmodels::lti::BACKWARD_EULER)));
 /// Create a controller object based on the predefined PID controller and the quadrature encoder
-signal::controllers::CMotorController g_controller(g_quadratureEncoderTask,l_pidController,&l_volt2pwmConverter);
+CONTROL_STATE signal::controllers::CMotorController g_controller(g_motorEncoder,g_smithPredictor,&g_supplyCompensation);
+/// Create the predictive speed controller with 8 periods horizon: first order model of the drive (56 rps/V static gain, 0.1 s time 
+/// constant), the voltage range of the converter table (3.99 V) and 1500 rps/s acceleration. It's inactive until the 'MPCS' command.
+CONTROL_STATE signal::controllers::CSpeedPredictiveController<8> g_speedPredictive(g_period_Encoder,56.0f,0.1f,3.99f,1500.0f);
+/// Create the position controller of the distance commands, a proportional controller (10 rps per rotation error) applied in each 10th period. 
+/// Below 10 rps reference the motor controller is inactive, so the tolerance of the target is one rotation (about 7 mm).
+signal::controllers::siso::CGainScheduledPidController<float,1> l_positionController({0.0f},{{{10.0f,0.0f,0.0f,1.0f}}},10*g_period_Encoder);
+/// Create the online identification of the drive model from the 56 rps/V, 0.1 s nominal model, the samples are 10 periods long and the 
+/// memory is about 500 samples (5 s). The model is applied to the feed-forward and to the pid controller by the 'RLSA' key ('RLSI' key).
+CONTROL_STATE signal::systemmodels::CMotorIdentifier g_motorIdentifier(g_period_Encoder, g_motorEncoder, 10, 0.998f, {56.0f, 0.1f, 0.0f});
+/// Create the relay autotuner of the speed controller, it calculates the parameters at the current operating point by the Tyreus-Luyben rules ('ATUN' key).
+signal::controllers::CRelayAutotuner g_autotuner(g_period_Encoder);
+/// Create the reference experiment of the speed controller, it scores the step ('EXPS' key) and the sweep ('EXPW' key) responses at the control rate.
+signal::controllers::CStepExperiment g_stepExperiment(g_period_Encoder);
+/// Create the friction and cogging compensation of the speed controller, 64 sectors of the shaft angle by the index pulse for both directions. 
+/// It's learned by crawling at low speed ('FRIC' key), the constant offset of the feed-forward is applied until the calibration.
+CONTROL_STATE signal::controllers::CFrictionCompensation g_frictionCompensation(mbed::callback(static_cast<hardware::encoders::CQuadratureEncoder*>(&g_quadratureEncoderTask),&hardware::encoders::CQuadratureEncoder::getShaftAngle));
+/// Create the characterization of the drive over the pwm frequency and the duty cycle (0.5 s settling, 1 s measuring per point), it's 
+/// placed before the motor driver and any command of the controllers stops it ('PWMC' key). The wheels have to be lifted.
+CONTROL_STATE signal::systemmodels::CPwmCharacterizer g_pwmCharacterizer(g_period_Encoder, g_motorEncoder, g_motorHeatingCurrent, g_motorCommand);
+/// Create the traction control between the controllers and the motor driver (motor: 150 rotation/m, grip limit: 3 m/s^2, slip ratio: 0.2), 
+/// it reduces the pwm in the tick of the detected slip ('TRAC' key). The body speed is integrated by the acceleration of the odometry.
+CONTROL_STATE signal::controllers::CTractionControl g_tractionControl(g_period_Encoder, g_motorEncoder, g_pwmCharacterizer, 1.0f / g_vehicle.m_rotationsPerMeter, g_vehicle.m_gripLimit);
+/// Create the pid controller of the yaw rate error, its output is the correction of the steering angle in degree ('YPID' key).
+CONTROL_STATE signal::controllers::siso::CPidController<float> g_yawRatePid(0.05f,0.5f,0.0f,0.01f,g_period_Encoder);
+/// Create the compensation of the gear backlash of the steering servo, the command is shifted toward the direction of the move after 
+/// 0.3 degree return. The width is the calibration parameter 'STBLSH' (degree), zero forwards the command.
+CONTROL_STATE signal::controllers::CCompensationChain<signal::controllers::CBacklashInverse> g_steeringCompensation(signal::controllers::CBacklashInverse(0.0f, 0.3f));
+/// Steering servo behind the backlash compensation.
+CONTROL_STATE signal::controllers::CCompensatedSteering<decltype(g_steeringCompensation)> g_compensatedSteering(g_steeringDriver, g_steeringCompensation);
+/// Create the steering geometry of the kinematic consumers (odometry, path follower, yaw rate control), the curvature of the steering 
+/// angle and back is looked up in the precomputed tables of the servo range, the calibration of the wheel angle is set by the 'STGM' key.
+CONTROL_STATE signal::systemmodels::CSteeringGeometry g_steeringGeometry(g_vehicle.m_wheelbase);
+/// Create the yaw rate control between the state machine and the steering servo, in the yaw rate mode the steering command is 
+/// the yaw rate in deg/s, which is tracked by the gyroscope of the odometry ('YAWC' key). It starts in the angle mode.
+CONTROL_STATE signal::controllers::CYawRateSteering g_yawRateSteering(g_motorEncoder, g_compensatedSteering, g_yawRatePid, 1.0f / g_vehicle.m_rotationsPerMeter, g_steeringGeometry, g_vehicle.m_maxSteering);
+/// Create the event log of the control path, the events are logged by identifier and raw arguments and they are sent in each 10 ms 
+/// in binary batches on the safety lane, the host formats them by the generated string table.
+utils::log::CEventLog               g_eventLog(g_vehicle.ticks(0.01f), g_rpiTransmitter);
 /// Create the motion controller, which controls the robot states and the robot moves based on the transmitted command over the serial interface. 
-brain::CRobotStateMachine           g_robotstatemachine(g_period_Encoder, g_rpi, g_motorVnhDriver,g_steeringDriver,&g_controller);
-
-/// Map for redirecting messages with the key and the callback functions. If the message key equals to one of the enumerated keys, than it will be applied the paired callback function.
-utils::serial::CSerialMonitor::CSerialSubscriberMap g_serialMonitorSubscribers = {
-    {"MCTL",mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::serialCallbackMove)},
-    {"BRAK",mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::serialCallbackBrake)},
-    {"PIDA",mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::serialCallbackPID)},
-    {"ENPB",mbed::callback(&g_encoderPublisher,&examples::sensors::CEncoderPublisher::serialCallback)},
+brain::CRobotStateMachine           g_robotstatemachine(g_period_Encoder, g_rpiTransmitter, g_eventLog, g_tractionControl,g_yawRateSteering,&g_controller);
+/// Create the safety monitor, it brakes the robot, when no command or heartbeat is received in one second ('HRBT', 'SAFE' keys).
+brain::CSafetyMonitor               g_safetyMonitor(g_robotstatemachine, g_rpiTransmitter, 1.0f);
+#ifndef WHEEL_SENSOR
+/// Create the DMA driven patterns of the built-in led, they don't need cpu.
+hardware::drivers::CStatusLed_TIM1  g_statusLed;
+/// Create the blink codes of the status: fault fast blinking, overload 3, link lost (no command in 1 s) 2, ok 1 flash per 3.2 s, 
+/// the fault and overload events are shown for 10 s.
+brain::CStatusIndicator             g_statusIndicator(g_statusLed, g_robotstatemachine, 1.0f, 10.0f);
+#endif
+
+/// Indices of the calibration parameters in the configuration store, in the order of the parameter table.
+enum EConfigParameter
+{
+    CFG_PID0_KP = 0, CFG_PID0_KI, CFG_PID0_KD, CFG_PID0_TF,
+    CFG_PID1_KP, CFG_PID1_KI, CFG_PID1_KD, CFG_PID1_TF,
+    CFG_V2P_BREAK0, CFG_V2P_BREAK1,
+    CFG_V2P_S0_A, CFG_V2P_S0_B, CFG_V2P_S1_A, CFG_V2P_S1_B, CFG_V2P_S2_A, CFG_V2P_S2_B,
+    CFG_STEER_A0, CFG_STEER_A1, CFG_STEER_A2, CFG_STEER_A3, CFG_STEER_A4,
+    CFG_STEER_D0, CFG_STEER_D1, CFG_STEER_D2, CFG_STEER_D3, CFG_STEER_D4,
+    CFG_STEER_SLEW,
+    CFG_MOTOR_PWM_FREQ,
+    CFG_STEER_BACKLASH,
+    CFG_SMITH_DELAY,
+    CFG_TICK_SYNC_ROLE, CFG_TICK_SYNC_LATENCY,
+    CFG_COUNT
+};
+/// Calibration parameters with the compiled values as defaults. The version has to be increased after each change of the table. 
+/// The steering points are the measured duty cycles at five angles, the defaults are the points of the linear conversion of the servo.
+const utils::config::CConfigStore::SParameter g_configParameters[CFG_COUNT] = {
+    {"PID0KP", 0.1150f}, {"PID0KI", 0.81000f}, {"PID0KD", 0.000222f}, {"PID0TF", 0.04f},
+    {"PID1KP", 0.1150f}, {"PID1KI", 0.81000f}, {"PID1KD", 0.000222f}, {"PID1TF", 0.04f},
+    {"V2PB0", -0.22166f}, {"V2PB1", 0.22166f},
+    {"V2PS0A", 0.1041568079746662f}, {"V2PS0B", -0.08952760561569219f}, {"V2PS1A", 0.50805f}, {"V2PS1B", 0.0f}, {"V2PS2A", 0.1041568079746662f}, {"V2PS2B", 0.08952760561569219f},
+    {"STA0", -23.0f}, {"STA1", -11.5f}, {"STA2", 0.0f}, {"STA3", 11.5f}, {"STA4", 23.0f},
+    {"STD0", 0.0533885f}, {"STD1", 0.06431925f}, {"STD2", 0.07525f}, {"STD3", 0.08618075f}, {"STD4", 0.0971115f},
+    {"STSLEW", 300.0f},
+    {"PWMF", 5000.0f},
+    {"STBLSH", 0.0f},
+    {"SMDLY", 0.0f},
+    {"TSROLE", 0.0f}, {"TSLAT", 0.0f}
+};
+/// Values of the calibration parameters, the image of the last record in the flash.
+float g_configValues[CFG_COUNT];
+/// Sectors 6 and 7 (2 x 128 KByte at the end of the flash) of the configuration store, they mustn't be reached by the program image.
+const hardware::drivers::CInternalFlash::SSector g_configSectors[2] = {{6, 0x08040000, 0x20000}, {7, 0x08060000, 0x20000}};
+/// Create the configuration store, the values are loaded at the startup and changed by the 'CFGS', saved by the 'CFGW' keys.
+utils::config::CConfigStore g_configStore(g_configSectors[0], g_configSectors[1], g_configParameters, g_configValues, CFG_COUNT, 6);
+/// Sectors 0-4 (128 KByte from the start of the flash) of the program, they are overwritten by the installing of the new image.
+const hardware::drivers::CInternalFlash::SSector g_programSectors[5] = {{0, 0x08000000, 0x4000}, {1, 0x08004000, 0x4000}, {2, 0x08008000, 0x4000}, {3, 0x0800C000, 0x4000}, {4, 0x08010000, 0x10000}};
+/// Sector 5 (128 KByte) of the staged image, the update is refused, when the program image reaches it. The last 4 KByte are the area of 
+/// the signal graph configuration, so the staged image is at most 124 KByte.
+const hardware::drivers::CInternalFlash::SSector g_stagingSector = {5, 0x08020000, 0x1F000};
+/// Create the firmware update, the LZ4 compressed blocks of the new image are staged by the binary messages, then it's installed and the board is reset.
+utils::update::CFirmwareUpdate g_firmwareUpdate(g_stagingSector, g_programSectors, 5);
+/// Full sector 5 of the signal graph configuration, the erasing of the firmware update clears the configuration.
+const hardware::drivers::CInternalFlash::SSector g_graphSector = {5, 0x08020000, 0x20000};
+/// Create the store of the signal graph configuration in the last 4 KByte of the sector 5.
+utils::config::CBlobStore g_graphStore(g_graphSector, 0x1F000);
+
+/// Probes of the signal scope, they read the raw values in the TIM9 interrupt: duty cycle of the motor pwm (1/10000), last ADC results 
+/// of the motor current and of the battery voltage, counter of the motor encoder (its steps show the edges).
+int16_t scopeMotorPwm()         { return static_cast<int16_t>(g_motorVnhDriver.getDuty() * 10000.0f); }
+int16_t scopeMotorCurrent()     { return static_cast<int16_t>(g_adcScanner.getValue(0)); }
+int16_t scopeEncoderCount()     { return hardware::drivers::CQuadratureCounter_TIM4::Instance()->getCount(); }
+int16_t scopeBatteryVoltage()   { return static_cast<int16_t>(g_adcScanner.getValue(1)); }
+/// Create the signal scope, it captures the probes at up to 25 kHz around a trigger ('SCOP' key), the frozen capture is dumped 
+/// in binary frames on the bulk interface in each 10 ms.
+utils::telemetry::CSignalScope g_signalScope(g_debugTransmitter, g_vehicle.ticks(0.01f));
+
+/// Overcurrent trip of the current monitor, the bridge is already switched off by the interrupt, the robot brakes and the host is alarmed, the fault triggers the signal scope.
+void motorOvercurrent()
+{
+    g_signalScope.fault();
+    g_robotstatemachine.failsafe();
+    g_rpiTransmitter.printf(utils::serial::CSerialTransmitter::LANE_SAFETY,"@CURR:overcurrent;;\r\n");
+#ifndef WHEEL_SENSOR
+    g_statusIndicator.latchFault();
+#endif
+}
+
+/// Degraded state of the encoder monitor, the motor is controlled in open loop by the feed-forward until the encoder recovers.
+void encoderDegraded(bool f_degraded)
+{
+    g_controller.setOpenLoop(f_degraded);
+    g_rpiTransmitter.printf(utils::serial::CSerialTransmitter::LANE_SAFETY, f_degraded ? "@ENCH:degraded;;\r\n" : "@ENCH:recovered;;\r\n");
+}
+
+/// Write guard of the configuration store, the flash is written only, while the robot doesn't move.
+bool configWriteAllowed() { return brain::CRobotStateMachine::STATE_MOVE != g_robotstatemachine.getState(); }
+/// Write guard of the signal graph store, its area is shared with the staging sector of the firmware update.
+bool graphWriteAllowed() { return configWriteAllowed() && utils::update::CFirmwareUpdate::IDLE == g_firmwareUpdate.getState(); }
+
+/// Declaration of the tick synchronization, it's created after the CAN transport.
+extern utils::can::CTickSync g_tickSync;
+
+/// Apply the calibration parameters to the controllers and to the actuators, before the start of the control loop.
+void applyConfiguration()
+{
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        const float* l_gains = g_configValues + CFG_PID0_KP + 4 * i;
+        l_pidController.setGains(i, {l_gains[0], l_gains[1], l_gains[2], l_gains[3]});
+    }
+    l_volt2pwmConverter.set({g_configValues[CFG_V2P_BREAK0], g_configValues[CFG_V2P_BREAK1]}
+                           ,{std::array<float,2>({g_configValues[CFG_V2P_S0_A], g_configValues[CFG_V2P_S0_B]})
+                            ,std::array<float,2>({g_configValues[CFG_V2P_S1_A], g_configValues[CFG_V2P_S1_B]})
+                            ,std::array<float,2>({g_configValues[CFG_V2P_S2_A], g_configValues[CFG_V2P_S2_B]})});
+    l_volt2pwmTable.sample(l_volt2pwmConverter);
+    /// Calibration table of the servo, with invalid angles (not increasing) the linear conversion remains
+    g_steeringDriver.setCalibration(g_configValues + CFG_STEER_A0, g_configValues + CFG_STEER_D0, 5);
+    /// Slew rate of the servo in degree per second, the state machine sets the angle in each period of the control loop
+    g_steeringDriver.setSlewRate(g_configValues[CFG_STEER_SLEW], g_period_Encoder);
+    /// Gear backlash of the servo in degree, it's compensated before the slew rate limit of the driver
+    g_steeringCompensation.stage<0>().setWidth(g_configValues[CFG_STEER_BACKLASH]);
+    /// Dead time of the speed loop in periods, the out of range value keeps the pid controller without prediction
+    g_smithPredictor.setDelay(static_cast<uint32_t>(g_configValues[CFG_SMITH_DELAY] + 0.5f));
+    /// Frequency of the motor pwm, the out of range value keeps the 5 kHz of the driver
+    g_motorVnhDriver.setPwmFrequency(g_configValues[CFG_MOTOR_PWM_FREQ]);
+    /// Role of the board in the tick synchronization (0 off, 1 master, 2 slave) and the latency of its receive stamp in ns
+    uint32_t l_role = static_cast<uint32_t>(g_configValues[CFG_TICK_SYNC_ROLE] + 0.5f);
+    g_tickSync.setRole((l_role <= utils::can::CTickSync::ROLE_SLAVE) ? static_cast<utils::can::CTickSync::ERole>(l_role) : utils::can::CTickSync::ROLE_OFF);
+    g_tickSync.setLatency(static_cast<int32_t>(g_configValues[CFG_TICK_SYNC_LATENCY]));
+}
+
+/// Change the frequency of the motor pwm, the trigger of the analog scan is moved to the new period. The value is written in the 
+/// configuration image, so it's saved by the 'CFGW' key.
+bool setMotorPwmFrequency(float f_frequency)
+{
+    if (!g_motorVnhDriver.setPwmFrequency(f_frequency))
+    {
+        return false;
+    }
+    g_adcScanner.setPhase(0.25f);
+    g_configValues[CFG_MOTOR_PWM_FREQ] = f_frequency;
+    return true;
+}
+
+/// Guard of the pwm characterization, the drive is swept only in the hard brake state with released bridge.
+bool pwmCharacterizationAllowed()
+{
+    return brain::CRobotStateMachine::STATE_HARD_BRAKE == g_robotstatemachine.getState() && !g_motorVnhDriver.isTripped();
+}
+
+/// Serial callback of the motor pwm frequency ('PWMF' key), 0: frequency in Hz, 1;frequency: set it, while the robot doesn't move.
+void pwmFrequencyCallback(char const * a, char * b)
+{
+    const char* l_text = a;
+    uint32_t l_command, l_frequency;
+    if (!utils::fmt::parseUint(l_text, l_command))
+    {
+        sprintf(b,"sintax error;;");
+    }
+    else if (0 == l_command)
+    {
+        utils::fmt::CWriter(b).fixed(g_motorVnhDriver.getPwmFrequency(),0).chr(';');
+    }
+    else if (1 == l_command && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_frequency))
+    {
+        if (!configWriteAllowed() || signal::systemmodels::CPwmCharacterizer::RUNNING == g_pwmCharacterizer.getState())
+        {
+            sprintf(b,"busy;;");
+        }
+        else
+        {
+            sprintf(b, setMotorPwmFrequency(static_cast<float>(l_frequency)) ? "ack;;" : "sintax error;;");
+        }
+    }
+    else
+    {
+        sprintf(b,"sintax error;;");
+    }
+}
+
+/// I2C interface of the inertial sensor (D14 SDA, D15 SCL), it's applied only for the configuration of the sensor.
+I2C g_imuBus(I2C_SDA, I2C_SCL);
+/// Non-blocking master of the I2C interface, after the configuration it reads the sensor by interrupts and DMA.
+hardware::drivers::CI2cDmaMaster_I2C1 g_imuMaster;
+/// Create the transaction queue of the I2C bus, the inertial and the time-of-flight sensors share the master by it ('I2CQ' key).
+hardware::drivers::CI2cBus_I2C1 g_i2cBus(g_imuMaster);
+/// Create the inertial sensor, its data-ready output is connected to D6 (EXTI line 10, it doesn't share the interrupt of the encoder edges).
+hardware::imu::CMpu6050 g_imu(g_imuBus, g_i2cBus, D6);
+/// Create the attitude filter of the inertial batches (Mahony, Kp: 1, Ki: 0.05), its heading gives the yaw of the odometry ('ATTD' key).
+CONTROL_STATE signal::filter::CMahonyFilter<float> g_attitude(1.0f, 0.05f);
+/// Latest measurements of the distance sensors, they are written by the drivers and read by the control loop.
+hardware::distance::CDistanceSnapshot g_ultrasonicDistance;
+hardware::distance::CDistanceSnapshot g_tofDistance;
+/// Create the capture of the ultrasonic echo (D12), it applies the TIM3 of the steering pwm and the DMA, so the echo doesn't have interrupt.
+hardware::drivers::CEchoCapture_TIM3 g_echoCapture;
+/// Create the ultrasonic distance sensor (trigger D11), it measures in 60 ms cycles up to 3 m, the echo is polled each 5 ms ('USND' key).
+hardware::distance::CUltrasonicRanger g_ultrasonic(g_vehicle.ticks(0.005f), g_echoCapture, D11, g_ultrasonicDistance, 3.0f, 0.06f);
+/// Create the time-of-flight sensor on the I2C bus of the inertial sensor, it's read by DMA at its 100 Hz rate ('TOFD' key).
+hardware::distance::CTfLuna g_tof(g_vehicle.ticks(0.01f), g_i2cBus, g_tofDistance);
+/// Forward distance sensors of the obstacle reflex of the state machine.
+const hardware::distance::CDistanceSnapshot* g_obstacleSensors[] = {&g_ultrasonicDistance, &g_tofDistance};
+
+/// Sequences of the distance measurements given to the fusion buffer
+uint32_t g_fusedUltrasonic = 0;
+uint32_t g_fusedTof = 0;
+/// Poll of a distance snapshot for the fusion buffer, it gives the new measurements with distance (valid or no echo).
+bool fusionDistance(const hardware::distance::CDistanceSnapshot& f_snapshot, uint32_t& f_fused, signal::filter::SFusionSample& f_sample)
+{
+    if (f_snapshot.getSequence() == f_fused)
+    {
+        return false;
+    }
+    hardware::distance::SDistance l_distance = f_snapshot.read(f_fused);
+    f_sample.m_timestamp = l_distance.m_timestamp;
+    f_sample.m_value = l_distance.m_distance;
+    return hardware::distance::DISTANCE_VALID == l_distance.m_status || hardware::distance::DISTANCE_NO_ECHO == l_distance.m_status;
+}
+bool fusionUltrasonic(signal::filter::SFusionSample& f_sample) { return fusionDistance(g_ultrasonicDistance, g_fusedUltrasonic, f_sample); }
+bool fusionTof(signal::filter::SFusionSample& f_sample)        { return fusionDistance(g_tofDistance, g_fusedTof, f_sample); }
+/// Sources of the fusion buffer: encoder speed (rps, pushed by the encoder topic), ultrasonic and time-of-flight distance (m, polled at the tick). 
+/// The extrapolation horizons are about two sample periods.
+enum EFusionSource{ FUSION_ENCODER_SPEED = 0, FUSION_ULTRASONIC = 1, FUSION_TOF = 2, FUSION_SOURCES = 3 };
+const signal::filter::CSampleFusion<FUSION_SOURCES>::SSource g_fusionSources[FUSION_SOURCES] = {
+    {NULL, 2000}, {mbed::callback(fusionUltrasonic), 120000}, {mbed::callback(fusionTof), 20000}
+};
+/// Create the fusion buffer of the multi-rate samples, it's applied after the encoder and it gives the values at the tick timestamp ('FUSE' key).
+CONTROL_STATE signal::filter::CSampleFusion<FUSION_SOURCES> g_sampleFusion(g_fusionSources);
+/// Subscriber of the encoder topic, the speed is the mean of the period, so its timestamp is the middle of the period.
+void fusionEncoder(const hardware::encoders::SEncoderSample& f_sample)
+{
+    g_sampleFusion.write(FUSION_ENCODER_SPEED, {f_sample.m_timestamp - static_cast<uint32_t>(g_period_Encoder * 5e5f), f_sample.m_speedRps});
+}
+
+/// Getter of the accumulated encoder position for the odometry, it's applied from the control loop interrupt.
+#ifdef SIMULATED_PLANT
+int64_t odometryPosition() { return g_motorSimulator.getPosition(); }
+#else
+int64_t odometryPosition() { return g_quadratureEncoderTask.getPosition(); }
+#endif
+/// Create the odometry, it integrates the pose in each tick of the control loop by the kinematic bicycle model (motor: 150 rotation/m, 
+/// encoder: 2048 impulse/rotation, wheelbase: 0.26 m) and it publishes the pose in each 20 ms for the 'ODOM' key, the pose is reset by the 'ODRS' key.
+brain::COdometry                    g_odometry(g_vehicle.ticks(0.02f), g_period_Encoder, mbed::callback(&odometryPosition)
+                                              ,mbed::callback(&g_steeringDriver,&hardware::drivers::CSteeringMotor::getAngle)
+                                              ,g_vehicle.metersPerImpulse(), g_steeringGeometry, g_rpiTransmitter);
+/// Create the lateral controller, it follows the waypoints uploaded by the 'PATH' key with the pose of the odometry (wheelbase: 0.26 m, 
+/// steering limit: 23 degree), the state machine applies it in the move state.
+brain::CPathFollower                g_pathFollower(mbed::callback(&g_odometry,&brain::COdometry::getPose), g_steeringGeometry, g_vehicle.m_maxSteering);
+/// Create the energy governor of the eco driving, it learns the power model in each 50 ms and its speed (max 1 m/s) and acceleration 
+/// (max 1 m/s2) caps keep the energy above the reserve for the remaining time of the run ('ECOD' key), the state machine applies them.
+brain::CEnergyGovernor              g_energyGovernor(g_vehicle.ticks(0.05f), 0.05f, g_batteryMonitor, g_motorEncoder, 1.0f / g_vehicle.m_rotationsPerMeter
+                                                    ,g_vehicle.m_batteryCells, g_vehicle.m_batteryCapacity, 1.0f, 1.0f);
+
+/// Create the telemetry channel, it samples the registered signals at the control rate and it publishes the subscribed ones in binary batches ('TELS', 'TELA', 'TELE' keys).
+utils::telemetry::CTelemetry         g_telemetry(g_debugTransmitter);
+/// SD card on SPI3 (PC10 SCK, PC11 MISO, PC12 MOSI), its chip select is PD2.
+hardware::drivers::CSdCardSpi_SPI3   g_sdCard(PD_2);
+/// Create the recorder of the telemetry on the SD card, the ring is the 1 GiB range after the first MiB (a partition without file system 
+/// at sector 2048). During a recording ('SDLG' key) the batches are written on the card instead of the serial link.
+utils::telemetry::CSdLogSink         g_sdLog(g_vehicle.ticks(0.001f), g_sdCard, 2048, 2097152);
+
+/// Getters of the telemetry signals, they are applied from the sampling interrupt.
+float telemetryEncoderCount()  { return g_quadratureEncoderTask.getCount(); }
+float telemetryEncoderSpeed()  { return g_quadratureEncoderTask.getSpeedRps(); }
+float telemetryPidError()      { return g_controller.getError(); }
+float telemetryControl()       { return g_controller.get(); }
+float telemetryMotorCurrent()  { return g_motorCurrent.getCurrent(); }
+float telemetryObserverSpeed() { return g_speedObserver.getSpeedRps(); }
+float telemetryLongSpeed()     { return g_quadratureEncoderTask.getWindowSpeedRps(hardware::encoders::CQuadratureEncoder::WINDOW_LONG); }
+float telemetryAcceleration()  { return g_quadratureEncoderTask.getAccelerationRps2(); }
+float telemetryLinePosition()  { return g_lineSensor.getReading().m_position * 1000.0f; }
+float telemetryStateOfCharge() { return g_batteryMonitor.getStateOfCharge() * 100.0f; }
+float telemetryBatteryPower()  { return g_batteryMonitor.getPower(); }
+float telemetryReference()     { return g_controller.getRef(); }
+float telemetrySteering()      { return g_steeringDriver.getAngle(); }
+/// Sources of the derived signals: the telemetry signals (0..7, forwarded by the slots without program), the reference speed of the motor 
+/// controller (8), the battery power (9), the line position (10) and the steering angle (11).
+const utils::telemetry::CDerivedSignals::FSignalGetter g_derivedSources[] = {
+    mbed::callback(telemetryEncoderCount), mbed::callback(telemetryEncoderSpeed), mbed::callback(telemetryPidError), mbed::callback(telemetryControl),
+    mbed::callback(telemetryMotorCurrent), mbed::callback(telemetryObserverSpeed), mbed::callback(telemetryLongSpeed), mbed::callback(telemetryAcceleration),
+    mbed::callback(telemetryReference), mbed::callback(telemetryBatteryPower), mbed::callback(telemetryLinePosition), mbed::callback(telemetrySteering)
+};
+/// Create the derived signals of the telemetry slots, the host uploads their stack programs by the 'DSIG' key (e.g. 'ref - measured', 
+/// 'pwm * current', windowed rms), they are evaluated in each tick before the telemetry sampling and only the slots are streamed.
+CONTROL_STATE utils::telemetry::CDerivedSignals g_derivedSignals(g_derivedSources, sizeof(g_derivedSources)/sizeof(g_derivedSources[0]));
+
+/// Published values of the sensors (subscription mask bits 0..7), they are sampled together by the publisher group in each 10 ms and sent in a combined frame.
+auto g_pubEncoderSpeed  = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<3>>("ENCS", 1, telemetryEncoderSpeed);
+auto g_pubObserverSpeed = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<3>>("OBSS", 1, telemetryObserverSpeed);
+auto g_pubMotorCurrent  = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<3>>("CURR", 2, telemetryMotorCurrent);
+auto g_pubSteering      = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<2>>("STER", 5, mbed::callback(&g_steeringDriver,&hardware::drivers::CSteeringMotor::getAngle));
+auto g_pubEncoderCount  = utils::publisher::makePublishedValue<utils::publisher::CIntSerializer>("ENCC", 10, telemetryEncoderCount);
+auto g_pubLinePosition  = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<1>>("LINE", 1, telemetryLinePosition);
+auto g_pubStateOfCharge = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<1>>("BSOC", 100, telemetryStateOfCharge);
+auto g_pubBatteryPower  = utils::publisher::makePublishedValue<utils::publisher::CFloatSerializer<1>>("BPWR", 10, telemetryBatteryPower);
+/// List of the published values, the index is the bit of the subscription mask.
+utils::publisher::IPublishedValue* g_publishedValues[] = {
+    &g_pubEncoderSpeed,
+    &g_pubObserverSpeed,
+    &g_pubMotorCurrent,
+    &g_pubSteering,
+    &g_pubEncoderCount,
+    &g_pubLinePosition,
+    &g_pubStateOfCharge,
+    &g_pubBatteryPower
+};
+/// Create the publisher group on the bulk interface ('PUBS' key with the hexadecimal mask of the values).
+utils::publisher::CPublisherGroup    g_publisher(g_vehicle.ticks(0.01f), g_publishedValues, sizeof(g_publishedValues)/sizeof(utils::publisher::IPublishedValue*), g_debugTransmitter);
+
+/// Crash record in the '.noinit' section, it's filled by the HardFault handler and by the fatal errors before the immediate reset ('CRSH' key).
+NOINIT_STATE hardware::drivers::CCrashCapture::SRecord g_crashRecord;
+/// Memory of the flight recorder in the '.noinit' section, it isn't initialized by the startup, so the history survives the soft resets.
+NOINIT_STATE utils::telemetry::CFlightRecorder::SStorage g_flightStorage;
+/// Trip count of the current monitor at the last record, a new trip triggers the flight recorder.
+uint32_t g_recordedTrips = 0;
+/// Sampler of the flight recorder, it fills the record at the end of the control tick.
+uint8_t flightRecorderSample(utils::serial::SFlightRecord& f_record)
+{
+    typedef utils::telemetry::CFlightRecorder CRecorder;
+    f_record.m_reference = CRecorder::quantize(g_controller.getRef(), 100.0f);
+    f_record.m_speed     = CRecorder::quantize(g_motorEncoder.getSpeedRps(), 100.0f);
+    f_record.m_error     = CRecorder::quantize(g_controller.getError(), 100.0f);
+    f_record.m_pwm       = CRecorder::quantize(g_controller.get(), 10000.0f);
+    f_record.m_steering  = CRecorder::quantize(g_steeringDriver.getAngle(), 100.0f);
+    f_record.m_state     = g_robotstatemachine.getState();
+    f_record.m_flags     = g_motorVnhDriver.isTripped() ? 1 : 0;
+    uint32_t l_trips = g_currentMonitor.getTripCount();
+    if (l_trips != g_recordedTrips)
+    {
+        g_recordedTrips = l_trips;
+        return CRecorder::TRIGGER_OVERCURRENT;
+    }
+    return CRecorder::TRIGGER_NONE;
+}
+/// Create the flight recorder, it records each control tick (about one second of history) and it's frozen by the faults, the frozen 
+/// history is dumped in binary frames on the control link in each 10 ms ('FREC' key: 0 - state, 1 - dump, 2 - rearm, 3 - freeze).
+utils::telemetry::CFlightRecorder    g_flightRecorder(g_flightStorage, g_rpiTransmitter, mbed::callback(flightRecorderSample), g_vehicle.ticks(0.01f));
+/// Fault callback of the state machine, the faults of the speed controller trigger the flight recorder and the signal scope.
+void flightRecorderFault(uint8_t f_fault)
+{
+    g_signalScope.fault();
+    g_flightRecorder.trigger(f_fault == brain::CRobotStateMachine::FAULT_ENCODER ? utils::telemetry::CFlightRecorder::TRIGGER_ENCODER 
+                                                                                 : utils::telemetry::CFlightRecorder::TRIGGER_HIGH_SPEED);
+#ifndef WHEEL_SENSOR
+    g_statusIndicator.latchFault();
+#endif
+}
+
+/// Registers of the live signals (0x00..0x0A, read-only), they are read by the register table in a critical section.
+auto g_regReference     = utils::registers::makeRegister<float>(0x00, mbed::callback(&g_controller,&signal::controllers::CMotorController::getRef));
+auto g_regEncoderSpeed  = utils::registers::makeRegister<float>(0x01, telemetryEncoderSpeed);
+auto g_regObserverSpeed = utils::registers::makeRegister<float>(0x02, telemetryObserverSpeed);
+auto g_regPidError      = utils::registers::makeRegister<float>(0x03, telemetryPidError);
+auto g_regControl       = utils::registers::makeRegister<float>(0x04, telemetryControl);
+auto g_regMotorCurrent  = utils::registers::makeRegister<float>(0x05, telemetryMotorCurrent);
+auto g_regSteering      = utils::registers::makeRegister<float>(0x06, mbed::callback(&g_steeringDriver,&hardware::drivers::CSteeringMotor::getAngle));
+auto g_regTemperature   = utils::registers::makeRegister<float>(0x07, mbed::callback(&g_thermalModel,&signal::systemmodels::CMotorThermalModel::getTemperature));
+auto g_regTractionGain  = utils::registers::makeRegister<float>(0x08, mbed::callback(&g_tractionControl,&signal::controllers::CTractionControl::getGain));
+auto g_regState         = utils::registers::makeRegister<uint32_t>(0x09, mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::getState));
+auto g_regEncoderCount  = utils::registers::makeRegister<int32_t>(0x0A, telemetryEncoderCount);
+/// Registers of the live parameters (0x40..), they are applied in the next control tick.
+auto g_regBrakeDuty     = utils::registers::makeRegister<float>(0x40, mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::getBrakeDuty)
+                                                           , mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::setBrakeDuty), 0.0f, 1.0f);
+/// Registers of the calibration parameters (0x100 + index of EConfigParameter), they are applied at the next boot after saving them ('CFGW' key).
+utils::registers::CArrayRegisters<float> g_regConfig(0x100, g_configValues, CFG_COUNT, true, -1.0e6f, 1.0e6f);
+/// List of the register blocks, it's sorted by the register table.
+utils::registers::IRegister* g_registers[] = {
+    &g_regReference,
+    &g_regEncoderSpeed,
+    &g_regObserverSpeed,
+    &g_regPidError,
+    &g_regControl,
+    &g_regMotorCurrent,
+    &g_regSteering,
+    &g_regTemperature,
+    &g_regTractionGain,
+    &g_regState,
+    &g_regEncoderCount,
+    &g_regBrakeDuty,
+    &g_regConfig
+};
+/// Create the register table, it answers the range reads and writes of the 'REGS' key and of the binary messages, the binary data frames are sent on the control link.
+utils::registers::CRegisterTable     g_registerTable(g_registers, sizeof(g_registers)/sizeof(utils::registers::IRegister*), g_rpiTransmitter);
+
+/// Declaration of the serial monitor of the control link, it's defined after the dispatch tables. 
+extern utils::serial::CSerialMonitor g_serialMonitor;
+/// Declaration of the serial monitor of the bulk interface, it's defined after the dispatch tables. 
+extern utils::serial::CSerialMonitor g_debugMonitor;
+/// Limit the lower lanes of the control link to a part of its bandwidth (31% and 8%), the alarms and the responses aren't limited
+void setRpiRateLimits(uint32_t f_baud)
+{
+    float l_bytesPerSecond = f_baud / 10.0f;
+    g_rpiTransmitter.setRateLimit(utils::serial::CSerialTransmitter::LANE_TELEMETRY, 0.3125f * l_bytesPerSecond, 512.0f);
+    g_rpiTransmitter.setRateLimit(utils::serial::CSerialTransmitter::LANE_DEBUG, 0.078125f * l_bytesPerSecond, 256.0f);
+}
+/// Baud rate setter of the control link, the rate limits of the lanes follow the bandwidth.
+bool setRpiBaud(uint32_t f_baud)
+{
+    if (!hardware::drivers::CUartBaudRate::set(USART2, f_baud))
+    {
+        return false;
+    }
+    setRpiRateLimits(f_baud);
+    return true;
+}
+/// Baud rate setter of the bulk interface
+bool setDebugBaud(uint32_t f_baud)
+{
+    return hardware::drivers::CUartBaudRate::set(USART6, f_baud);
+}
+/// Create the baud rate negotiation of the control link, the new rate is confirmed by a frame of the host or it's reverted.
+utils::serial::CBaudNegotiator       g_rpiBaudNegotiator(g_serialMonitor, g_rpiTransmitter, mbed::callback(setRpiBaud), g_rpiBaud, g_rpiMaxBaud, g_vehicle.ticks(0.01f));
+/// Create the baud rate negotiation of the bulk interface, the high-rate logging uses the faster rate.
+utils::serial::CBaudNegotiator       g_debugBaudNegotiator(g_debugMonitor, g_debugTransmitter, mbed::callback(setDebugBaud), g_debugBaud, g_debugMaxBaud, g_vehicle.ticks(0.01f));
+/// Create the benchmark of the control link, it answers the echo and flood frames ('BNCH' key) and it stamps the actuation in the control tick.
+utils::serial::CLinkBenchmark        g_linkBenchmark(g_serialMonitor, g_rpiTransmitter);
+/// Memory of the command recorder in the '.noinit' section, a command stream captured before a soft reset can be replayed after it.
+NOINIT_STATE utils::telemetry::CCommandRecorder::SStorage g_commandStorage;
+/// Create the command recorder of the control link, it captures the accepted frames with their arrival time and it replays them with the 
+/// original timing in 1 ms resolution ('CREC' key: 0 - state, 1 - capture, 2 - stop, 3 - replay, 4 - dump).
+utils::telemetry::CCommandRecorder   g_commandRecorder(g_commandStorage, g_serialMonitor, g_rpiTransmitter, g_vehicle.ticks(0.001f));
+
+/// Declaration of the task manager, it's defined after the task list, its tick is scaled by the power manager.
+extern utils::task::CPriorityTaskManager g_taskManager;
+/// The car is parked: braking state and zero speed
+bool isParked()
+{
+    uint8_t l_state = g_robotstatemachine.getState();
+    return (brain::CRobotStateMachine::STATE_BRAKE == l_state || brain::CRobotStateMachine::STATE_HARD_BRAKE == l_state)
+        && fabs(g_speedObserver.getSpeedRps()) < 0.05f;
+}
+/// Create the power manager ('POWR' key), the idle thread sleeps and after 2 s parking the 10 kHz tick of the task manager is reduced to 1 kHz.
+utils::power::CPowerManager          g_powerManager(g_taskManager, mbed::callback(isParked), 10, 2000000);
+
+/// Sources of the signal graph: encoder speed (rps), motor current (A), battery voltage (V), reference speed of the motor controller (rps).
+float graphEncoderSpeed()   { return g_motorEncoder.getSpeedRps(); }
+float graphMotorCurrent()   { return g_motorHeatingCurrent.getCurrent(); }
+float graphBatteryVoltage() { return g_supplyCompensation.getVoltage(); }
+float graphReference()      { return g_controller.getRef(); }
+const signal::graph::CSignalGraph::FSourceGetter g_graphSources[] = {
+    mbed::callback(graphEncoderSpeed), mbed::callback(graphMotorCurrent), mbed::callback(graphBatteryVoltage), mbed::callback(graphReference)
+};
+/// Create the signal graph of the stored configuration, it's instantiated at the boot in its static arena and applied in each period 
+/// after the encoder, its outputs are read by the 'SGRF' key. Without configuration it's empty.
+CONTROL_STATE signal::graph::CSignalGraph g_signalGraph(g_period_Encoder, g_graphSources, sizeof(g_graphSources)/sizeof(g_graphSources[0]), g_graphStore);
+
+/// Hardware timer of the control loop
+hardware::drivers::CControlTimer_TIM10 g_controlTimer;
+/// Declaration of the control loop, it's defined after the pipeline, its deadline misses are counted by the load shedding.
+extern brain::CControlLoop g_controlLoop;
+/// Optional stages of the pipeline, they are disabled by the load shedding on overload.
+CONTROL_STATE utils::pipeline::CGatedStage<hardware::encoders::CSpeedObserver> g_speedObserverStage(g_speedObserver);
+CONTROL_STATE utils::pipeline::CGatedStage<signal::systemmodels::CMotorIdentifier> g_motorIdentifierStage(g_motorIdentifier);
+CONTROL_STATE utils::pipeline::CGatedStage<utils::telemetry::CTelemetry> g_telemetryStage(g_telemetry);
+CONTROL_STATE utils::pipeline::CGatedStage<utils::telemetry::CDerivedSignals> g_derivedSignalsStage(g_derivedSignals);
+CONTROL_STATE utils::pipeline::CGatedStage<signal::graph::CSignalGraph> g_signalGraphStage(g_signalGraph);
+/// Optional stages in the order of the shedding, the signal graph and the telemetry sampling are the least important.
+const brain::CLoadShedder::SStage    g_sheddableStages[] = {
+    {"graph",      &g_signalGraphStage},
+    {"telemetry",  &g_telemetryStage},
+    {"derived",    &g_derivedSignalsStage},
+    {"identifier", &g_motorIdentifierStage},
+    {"observer",   &g_speedObserverStage}
 };
+/// Create the load shedding ('SHED' key), 3 missed deadlines in a window of 100 ticks disable the next optional stage, 
+/// 20 windows with ticks below 60 % of the deadline enable the last disabled one. The transitions are reported on the control link.
+CONTROL_STATE brain::CLoadShedder    g_loadShedder(g_vehicle.ticks(0.01f), g_controlLoop, g_sheddableStages, sizeof(g_sheddableStages)/sizeof(brain::CLoadShedder::SStage)
+                                                  , g_rpiTransmitter, 100, 3, 0.6f, 20);
+/// Create the control pipeline, all stages are applied in the same tick with a common timestamp. The stages in order of application: sensor snapshot, 
+/// line array, current monitor, battery monitor, supply compensation, simulated plant (optional), thermal model, encoder speed estimation, sample fusion, ripple filter, speed observer, wheel sensor (optional), motor identification, encoder monitor, signal graph, traction control, pwm characterization, command timeout and watchdog, 
+/// status led (without wheel sensor), state machine with controller and actuators, link benchmark, odometry, derived signals, telemetry sampling, flight recorder, power manager, load shedding. The observer, the identification, the signal graph, the derived signals and the telemetry sampling 
+/// are optional, they are disabled on overload. They are wired at compile time, so the tick is applied without indirect calls between the stages.
+CONTROL_STATE utils::pipeline::CStaticPipeline<
+    hardware::sampling::CSampler,
+    hardware::sampling::CLineSensor,
+    hardware::sampling::CCurrentMonitor,
+    hardware::sampling::CBatteryMonitor,
+    signal::controllers::CSupplyCompensation,
+#ifdef SIMULATED_PLANT
+    hardware::simulation::CMotorSimulator,
+#endif
+    signal::systemmodels::CMotorThermalModel,
+    hardware::encoders::CQuadratureEncoderMT,
+    hardware::sampling::CSampleHandoff,
+    signal::filter::CSampleFusion<FUSION_SOURCES>,
+    hardware::encoders::CRippleFilter,
+    utils::pipeline::CGatedStage<hardware::encoders::CSpeedObserver>,
+#ifdef WHEEL_SENSOR
+    hardware::encoders::CSingleChannelEncoder,
+#endif
+    utils::pipeline::CGatedStage<signal::systemmodels::CMotorIdentifier>,
+#ifndef WHEEL_SENSOR
+    hardware::encoders::CEncoderMonitor,
+#endif
+    utils::pipeline::CGatedStage<signal::graph::CSignalGraph>,
+    signal::controllers::CTractionControl,
+    signal::systemmodels::CPwmCharacterizer,
+    signal::controllers::CYawRateSteering,
+    brain::CSafetyMonitor,
+#ifndef WHEEL_SENSOR
+    brain::CStatusIndicator,
+#endif
+    brain::CRobotStateMachine,
+    utils::serial::CLinkBenchmark,
+    brain::COdometry,
+    utils::pipeline::CGatedStage<utils::telemetry::CDerivedSignals>,
+    utils::pipeline::CGatedStage<utils::telemetry::CTelemetry>,
+    utils::telemetry::CFlightRecorder,
+    utils::power::CPowerManager,
+    brain::CLoadShedder>                 g_controlPipeline(
+    g_sampler,
+    g_lineSensor,
+    g_currentMonitor,
+    g_batteryMonitor,
+    g_supplyCompensation,
+#ifdef SIMULATED_PLANT
+    g_motorSimulator,
+#endif
+    g_thermalModel,
+    g_quadratureEncoderTask,
+    g_sampleHandoff,
+    g_sampleFusion,
+    g_rippleFilter,
+    g_speedObserverStage,
+#ifdef WHEEL_SENSOR
+    g_wheelSensor,
+#endif
+    g_motorIdentifierStage,
+#ifndef WHEEL_SENSOR
+    g_encoderMonitor,
+#endif
+    g_signalGraphStage,
+    g_tractionControl,
+    g_pwmCharacterizer,
+    g_yawRateSteering,
+    g_safetyMonitor,
+#ifndef WHEEL_SENSOR
+    g_statusIndicator,
+#endif
+    g_robotstatemachine,
+    g_linkBenchmark,
+    g_odometry,
+    g_derivedSignalsStage,
+    g_telemetryStage,
+    g_flightRecorder,
+    g_powerManager,
+    g_loadShedder);
+/// Static stack of the control thread, the stages of the pipeline are applied on it.
+MBED_ALIGN(8) unsigned char g_controlStack[brain::CControlLoop::s_defaultStackSize];
+/// Create the control loop, the update interrupt of the timer wakes up the control thread (highest RTOS priority) and it applies one tick 
+/// of the pipeline in each period. So the tick preempts the serial monitor and the task threads, but it doesn't block the peripheral interrupts.
+brain::CControlLoop                  g_controlLoop(g_controlTimer, g_period_Encoder, g_controlPipeline
+                                                  , brain::CControlLoop::THREAD, sizeof(g_controlStack), g_controlStack);
+
+/// Declaration of the task monitor, it's defined after the task list. 
+extern utils::task::CTaskMonitor g_taskMonitor;
+/// Declaration of the schedulability analysis, it's defined after the task list. 
+extern utils::task::CSchedulability g_schedulability;
+/// Declaration of the initialization sequence, it's defined after the setup stages. 
+extern utils::init::CInitSequence g_initSequence;
+/// Declaration of the memory report, it's defined after the task manager. 
+extern utils::memory::CMemoryReport g_memoryReport;
+/// The CAN transport shares the binary subscribers, it's created after them.
+extern utils::can::CCanTransport g_canTransport;
+/// Publisher of the sensor values on the CAN bus
+extern utils::can::CCanPublisher g_canPublisher;
+
+/// Create the load monitor, it measures the CPU utilization of the idle thread and of the control loop interrupt in each second 
+/// and the free stack of the threads of the memory report, they are sent for the 'LOAD' key.
+utils::task::CLoadMonitor g_loadMonitor(g_vehicle.ticks(1.0f)
+                                       ,mbed::callback(&g_controlLoop,&brain::CControlLoop::takeBusyCycles)
+                                       ,mbed::callback(&g_controlLoop,&brain::CControlLoop::getMaxCycles)
+                                       ,g_memoryReport);
 
+/// Create the clock synchronization, it estimates the offset and the drift of the board clock from the pings of the host ('SYNC' key) 
+/// and it enables the timestamp of the outbound messages, the task extends the 64-bit board clock in each second.
+utils::clock::CClockSync g_clockSync(g_vehicle.ticks(1.0f));
+
+/// Create the sampling profiler, it counts the interrupted program counters by the TIM11 interrupt ('PROF' key), the histogram 
+/// is dumped in binary frames on the bulk interface in each 10 ms.
+utils::task::CProfiler g_profiler(g_debugTransmitter, g_vehicle.ticks(0.01f));
+
+/// Delegate of the text messages, the subscriber method is a template parameter, so the monitor calls it directly.
+typedef utils::serial::CSerialMonitor::FCallback FCommand;
+/// Dispatch table for redirecting messages with the key and the callback functions. If the message key equals to one of the enumerated keys, than it will be applied the paired callback function.
+/// The pending motion setpoints (MCTL) are coalesced, only the newest one of a backlog is applied.
+utils::serial::CSerialMonitor::CSerialSubscriberMap::SEntry g_serialMonitorSubscribers[] = {
+    {utils::serial::CSerialMonitor::key("MCTL"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackMove>(&g_robotstatemachine),utils::serial::POLICY_LATEST},
+    {utils::serial::CSerialMonitor::key("BRAK"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackBrake>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("HBRA"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackHardBrake>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("BRKD"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackBrakeDuty>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("OBST"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackObstacle>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("PIDA"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackPID>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("DIST"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackDistance>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("PRFL"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackProfile>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("SCHD"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackSchedule>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("SCLR"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackClearSchedule>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("HRBT"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackHeartbeat>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("SAFE"),FCommand::bind<brain::CSafetyMonitor,&brain::CSafetyMonitor::serialCallbackTimeout>(&g_safetyMonitor)},
+    {utils::serial::CSerialMonitor::key("CURR"),FCommand::bind<hardware::sampling::CCurrentMonitor,&hardware::sampling::CCurrentMonitor::serialCallback>(&g_currentMonitor)},
+    {utils::serial::CSerialMonitor::key("BMON"),FCommand::bind<hardware::sampling::CBatteryMonitor,&hardware::sampling::CBatteryMonitor::serialCallback>(&g_batteryMonitor)},
+    {utils::serial::CSerialMonitor::key("LINE"),FCommand::bind<hardware::sampling::CLineSensor,&hardware::sampling::CLineSensor::serialCallback>(&g_lineSensor)},
+    {utils::serial::CSerialMonitor::key("TEMP"),FCommand::bind<signal::systemmodels::CMotorThermalModel,&signal::systemmodels::CMotorThermalModel::serialCallback>(&g_thermalModel)},
+    {utils::serial::CSerialMonitor::key("TIME"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackTime>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("SYNC"),FCommand::bind<utils::clock::CClockSync,&utils::clock::CClockSync::serialCallback>(&g_clockSync)},
+    {utils::serial::CSerialMonitor::key("BNCH"),FCommand::bind<utils::serial::CLinkBenchmark,&utils::serial::CLinkBenchmark::serialCallback>(&g_linkBenchmark)},
+    {utils::serial::CSerialMonitor::key("BAUD"),FCommand::bind<utils::serial::CBaudNegotiator,&utils::serial::CBaudNegotiator::serialCallback>(&g_rpiBaudNegotiator)},
+    {utils::serial::CSerialMonitor::key("POWR"),FCommand::bind<utils::power::CPowerManager,&utils::power::CPowerManager::serialCallback>(&g_powerManager)},
+    {utils::serial::CSerialMonitor::key("CANB"),FCommand::bind<utils::can::CCanTransport,&utils::can::CCanTransport::serialCallback>(&g_canTransport)},
+    {utils::serial::CSerialMonitor::key("TSYN"),FCommand::bind<utils::can::CTickSync,&utils::can::CTickSync::serialCallback>(&g_tickSync)},
+    {utils::serial::CSerialMonitor::key("ECOD"),FCommand::bind<brain::CEnergyGovernor,&brain::CEnergyGovernor::serialCallback>(&g_energyGovernor)},
+    {utils::serial::CSerialMonitor::key("CANP"),FCommand::bind<utils::can::CCanPublisher,&utils::can::CCanPublisher::serialCallback>(&g_canPublisher)},
+    {utils::serial::CSerialMonitor::key("ATUN"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackAutotune>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("EXPS"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackStepExperiment>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("EXPW"),FCommand::bind<brain::CRobotStateMachine,&brain::CRobotStateMachine::serialCallbackSweepExperiment>(&g_robotstatemachine)},
+    {utils::serial::CSerialMonitor::key("ENCH"),FCommand::bind<hardware::encoders::CEncoderMonitor,&hardware::encoders::CEncoderMonitor::serialCallback>(&g_encoderMonitor)},
+    {utils::serial::CSerialMonitor::key("FRIC"),FCommand::bind<signal::controllers::CFrictionCompensation,&signal::controllers::CFrictionCompensation::serialCallback>(&g_frictionCompensation)},
+    {utils::serial::CSerialMonitor::key("ENCI"),FCommand::bind<hardware::encoders::CQuadratureEncoder,&hardware::encoders::CQuadratureEncoder::serialCallbackIndex>(&g_quadratureEncoderTask)},
+    {utils::serial::CSerialMonitor::key("RIPL"),FCommand::bind<hardware::encoders::CRippleFilter,&hardware::encoders::CRippleFilter::serialCallback>(&g_rippleFilter)},
+    {utils::serial::CSerialMonitor::key("FFWD"),FCommand::bind<signal::controllers::CMotorController,&signal::controllers::CMotorController::serialCallbackFeedForward>(&g_controller)},
+    {utils::serial::CSerialMonitor::key("BATT"),FCommand::bind<signal::controllers::CSupplyCompensation,&signal::controllers::CSupplyCompensation::serialCallback>(&g_supplyCompensation)},
+    {utils::serial::CSerialMonitor::key("RLSI"),FCommand::bind<signal::systemmodels::CMotorIdentifier,&signal::systemmodels::CMotorIdentifier::serialCallback>(&g_motorIdentifier)},
+    {utils::serial::CSerialMonitor::key("RLSA"),FCommand::bind<signal::controllers::CMotorController,&signal::controllers::CMotorController::serialCallbackIdentified>(&g_controller)},
+    {utils::serial::CSerialMonitor::key("MPCS"),FCommand::bind<signal::controllers::CSpeedPredictiveController<8>,&signal::controllers::CSpeedPredictiveController<8>::serialCallback>(&g_speedPredictive)},
+    {utils::serial::CSerialMonitor::key("TRAC"),FCommand::bind<signal::controllers::CTractionControl,&signal::controllers::CTractionControl::serialCallback>(&g_tractionControl)},
+    {utils::serial::CSerialMonitor::key("PWMC"),FCommand::bind<signal::systemmodels::CPwmCharacterizer,&signal::systemmodels::CPwmCharacterizer::serialCallback>(&g_pwmCharacterizer)},
+    {utils::serial::CSerialMonitor::key("PWMF"),FCommand::bind<&pwmFrequencyCallback>()},
+    {utils::serial::CSerialMonitor::key("YAWC"),FCommand::bind<signal::controllers::CYawRateSteering,&signal::controllers::CYawRateSteering::serialCallback>(&g_yawRateSteering)},
+    {utils::serial::CSerialMonitor::key("YPID"),FCommand::bind<signal::controllers::siso::CPidController<float>,&signal::controllers::siso::CPidController<float>::serialCallback>(&g_yawRatePid)},
+    {utils::serial::CSerialMonitor::key("PIDS"),FCommand::bind<signal::controllers::siso::CGainScheduledPidController<float,2>,&signal::controllers::siso::CGainScheduledPidController<float,2>::serialCallback>(&l_pidController)},
+    {utils::serial::CSerialMonitor::key("SMTH"),FCommand::bind<signal::controllers::siso::CSmithPredictor<float,2,8>,&signal::controllers::siso::CSmithPredictor<float,2,8>::serialCallback>(&g_smithPredictor)},
+    {utils::serial::CSerialMonitor::key("SGRF"),FCommand::bind<signal::graph::CSignalGraph,&signal::graph::CSignalGraph::serialCallback>(&g_signalGraph)},
+    {utils::serial::CSerialMonitor::key("ENPB"),FCommand::bind<examples::sensors::CEncoderPublisher,&examples::sensors::CEncoderPublisher::serialCallback>(&g_encoderPublisher)},
+    {utils::serial::CSerialMonitor::key("TSKS"),FCommand::bind<utils::task::CTaskMonitor,&utils::task::CTaskMonitor::serialCallback>(&g_taskMonitor)},
+    {utils::serial::CSerialMonitor::key("SCHD"),FCommand::bind<utils::task::CSchedulability,&utils::task::CSchedulability::serialCallback>(&g_schedulability)},
+    {utils::serial::CSerialMonitor::key("MEMR"),FCommand::bind<utils::memory::CMemoryReport,&utils::memory::CMemoryReport::serialCallback>(&g_memoryReport)},
+    {utils::serial::CSerialMonitor::key("LOAD"),FCommand::bind<utils::task::CLoadMonitor,&utils::task::CLoadMonitor::serialCallback>(&g_loadMonitor)},
+    {utils::serial::CSerialMonitor::key("SHED"),FCommand::bind<brain::CLoadShedder,&brain::CLoadShedder::serialCallback>(&g_loadShedder)},
+    {utils::serial::CSerialMonitor::key("TELS"),FCommand::bind<utils::telemetry::CTelemetry,&utils::telemetry::CTelemetry::serialCallbackSubscribe>(&g_telemetry)},
+    {utils::serial::CSerialMonitor::key("TELA"),FCommand::bind<utils::telemetry::CTelemetry,&utils::telemetry::CTelemetry::serialCallbackAggregate>(&g_telemetry)},
+    {utils::serial::CSerialMonitor::key("TELE"),FCommand::bind<utils::telemetry::CTelemetry,&utils::telemetry::CTelemetry::serialCallbackEncode>(&g_telemetry)},
+    {utils::serial::CSerialMonitor::key("DSIG"),FCommand::bind<utils::telemetry::CDerivedSignals,&utils::telemetry::CDerivedSignals::serialCallback>(&g_derivedSignals)},
+    {utils::serial::CSerialMonitor::key("SDLG"),FCommand::bind<utils::telemetry::CSdLogSink,&utils::telemetry::CSdLogSink::serialCallback>(&g_sdLog)},
+    {utils::serial::CSerialMonitor::key("TRCE"),FCommand::bind<&utils::telemetry::CTraceStream::serialCallback>()},
+    {utils::serial::CSerialMonitor::key("COBS"),FCommand::bind<&utils::serial::CBinaryProtocol::serialCallbackFraming>()},
+    {utils::serial::CSerialMonitor::key("PUBS"),FCommand::bind<utils::publisher::CPublisherGroup,&utils::publisher::CPublisherGroup::serialCallback>(&g_publisher)},
+    {utils::serial::CSerialMonitor::key("FREC"),FCommand::bind<utils::telemetry::CFlightRecorder,&utils::telemetry::CFlightRecorder::serialCallback>(&g_flightRecorder)},
+    {utils::serial::CSerialMonitor::key("CREC"),FCommand::bind<utils::telemetry::CCommandRecorder,&utils::telemetry::CCommandRecorder::serialCallback>(&g_commandRecorder)},
+    {utils::serial::CSerialMonitor::key("CRSH"),FCommand::bind<&hardware::drivers::CCrashCapture::serialCallback>()},
+    {utils::serial::CSerialMonitor::key("ODOM"),FCommand::bind<brain::COdometry,&brain::COdometry::serialCallback>(&g_odometry)},
+    {utils::serial::CSerialMonitor::key("ATTD"),FCommand::bind<signal::filter::CMahonyFilter<float>,&signal::filter::CMahonyFilter<float>::serialCallback>(&g_attitude)},
+    {utils::serial::CSerialMonitor::key("USND"),FCommand::bind<hardware::distance::CUltrasonicRanger,&hardware::distance::CUltrasonicRanger::serialCallback>(&g_ultrasonic)},
+    {utils::serial::CSerialMonitor::key("FUSE"),FCommand::bind<signal::filter::CSampleFusion<FUSION_SOURCES>,&signal::filter::CSampleFusion<FUSION_SOURCES>::serialCallback>(&g_sampleFusion)},
+    {utils::serial::CSerialMonitor::key("I2CQ"),FCommand::bind<hardware::drivers::CI2cBus_I2C1,&hardware::drivers::CI2cBus_I2C1::serialCallback>(&g_i2cBus)},
+    {utils::serial::CSerialMonitor::key("STGM"),FCommand::bind<signal::systemmodels::CSteeringGeometry,&signal::systemmodels::CSteeringGeometry::serialCallback>(&g_steeringGeometry)},
+    {utils::serial::CSerialMonitor::key("TOFD"),FCommand::bind<hardware::distance::CTfLuna,&hardware::distance::CTfLuna::serialCallback>(&g_tof)},
+    {utils::serial::CSerialMonitor::key("ODRS"),FCommand::bind<brain::COdometry,&brain::COdometry::serialCallbackReset>(&g_odometry)},
+    {utils::serial::CSerialMonitor::key("PATH"),FCommand::bind<brain::CPathFollower,&brain::CPathFollower::serialCallback>(&g_pathFollower)},
+    {utils::serial::CSerialMonitor::key("CFGS"),FCommand::bind<utils::config::CConfigStore,&utils::config::CConfigStore::serialCallbackSet>(&g_configStore)},
+    {utils::serial::CSerialMonitor::key("CFGG"),FCommand::bind<utils::config::CConfigStore,&utils::config::CConfigStore::serialCallbackGet>(&g_configStore)},
+    {utils::serial::CSerialMonitor::key("CFGW"),FCommand::bind<utils::config::CConfigStore,&utils::config::CConfigStore::serialCallbackSave>(&g_configStore)},
+    {utils::serial::CSerialMonitor::key("CFGD"),FCommand::bind<utils::config::CConfigStore,&utils::config::CConfigStore::serialCallbackDefault>(&g_configStore)},
+    {utils::serial::CSerialMonitor::key("REGS"),FCommand::bind<utils::registers::CRegisterTable,&utils::registers::CRegisterTable::serialCallback>(&g_registerTable)},
+};
+
+/// Dispatch table of the bulk interface, it accepts only the diagnostic and streaming messages. The responses are transmitted on the link of the request.
+utils::serial::CSerialMonitor::CSerialSubscriberMap::SEntry g_debugMonitorSubscribers[] = {
+    {utils::serial::CSerialMonitor::key("ENPB"),FCommand::bind<examples::sensors::CEncoderPublisher,&examples::sensors::CEncoderPublisher::serialCallback>(&g_encoderPublisher)},
+    {utils::serial::CSerialMonitor::key("TSKS"),FCommand::bind<utils::task::CTaskMonitor,&utils::task::CTaskMonitor::serialCallback>(&g_taskMonitor)},
+    {utils::serial::CSerialMonitor::key("SCHD"),FCommand::bind<utils::task::CSchedulability,&utils::task::CSchedulability::serialCallback>(&g_schedulability)},
+    {utils::serial::CSerialMonitor::key("MEMR"),FCommand::bind<utils::memory::CMemoryReport,&utils::memory::CMemoryReport::serialCallback>(&g_memoryReport)},
+    {utils::serial::CSerialMonitor::key("LOAD"),FCommand::bind<utils::task::CLoadMonitor,&utils::task::CLoadMonitor::serialCallback>(&g_loadMonitor)},
+    {utils::serial::CSerialMonitor::key("TELS"),FCommand::bind<utils::telemetry::CTelemetry,&utils::telemetry::CTelemetry::serialCallbackSubscribe>(&g_telemetry)},
+    {utils::serial::CSerialMonitor::key("TELA"),FCommand::bind<utils::telemetry::CTelemetry,&utils::telemetry::CTelemetry::serialCallbackAggregate>(&g_telemetry)},
+    {utils::serial::CSerialMonitor::key("TELE"),FCommand::bind<utils::telemetry::CTelemetry,&utils::telemetry::CTelemetry::serialCallbackEncode>(&g_telemetry)},
+    {utils::serial::CSerialMonitor::key("DSIG"),FCommand::bind<utils::telemetry::CDerivedSignals,&utils::telemetry::CDerivedSignals::serialCallback>(&g_derivedSignals)},
+    {utils::serial::CSerialMonitor::key("TRCE"),FCommand::bind<&utils::telemetry::CTraceStream::serialCallback>()},
+    {utils::serial::CSerialMonitor::key("COBS"),FCommand::bind<&utils::serial::CBinaryProtocol::serialCallbackFraming>()},
+    {utils::serial::CSerialMonitor::key("PUBS"),FCommand::bind<utils::publisher::CPublisherGroup,&utils::publisher::CPublisherGroup::serialCallback>(&g_publisher)},
+    {utils::serial::CSerialMonitor::key("BOOT"),FCommand::bind<utils::init::CInitSequence,&utils::init::CInitSequence::serialCallback>(&g_initSequence)},
+    {utils::serial::CSerialMonitor::key("SYNC"),FCommand::bind<utils::clock::CClockSync,&utils::clock::CClockSync::serialCallback>(&g_clockSync)},
+    {utils::serial::CSerialMonitor::key("BAUD"),FCommand::bind<utils::serial::CBaudNegotiator,&utils::serial::CBaudNegotiator::serialCallback>(&g_debugBaudNegotiator)},
+    {utils::serial::CSerialMonitor::key("PROF"),FCommand::bind<utils::task::CProfiler,&utils::task::CProfiler::serialCallback>(&g_profiler)},
+    {utils::serial::CSerialMonitor::key("SCOP"),FCommand::bind<utils::telemetry::CSignalScope,&utils::telemetry::CSignalScope::serialCallback>(&g_signalScope)},
+    {utils::serial::CSerialMonitor::key("REGS"),FCommand::bind<utils::registers::CRegisterTable,&utils::registers::CRegisterTable::serialCallback>(&g_registerTable)},
+};
+
+/// Dispatch table for redirecting the binary messages with the message identifier and the callback functions. The payloads are decoded to the typed structures. 
+/// The pending move commands are coalesced like the MCTL frames.
+utils::serial::CSerialMonitor::CBinarySubscriberMap::SEntry g_binarySubscribers[] = {
+    {utils::serial::BIN_MOVE,utils::serial::CBinaryProtocol::bind<brain::CRobotStateMachine,utils::serial::SMovePayload,&brain::CRobotStateMachine::binaryCallbackMove>(&g_robotstatemachine),utils::serial::POLICY_LATEST},
+    {utils::serial::BIN_BRAKE,utils::serial::CBinaryProtocol::bind<brain::CRobotStateMachine,utils::serial::SBrakePayload,&brain::CRobotStateMachine::binaryCallbackBrake>(&g_robotstatemachine)},
+    {utils::serial::BIN_PID_ACTIVATION,utils::serial::CBinaryProtocol::bind<brain::CRobotStateMachine,utils::serial::SActivationPayload,&brain::CRobotStateMachine::binaryCallbackPID>(&g_robotstatemachine)},
+    {utils::serial::BIN_ENCODER_PUBLISH,utils::serial::CBinaryProtocol::bind<examples::sensors::CEncoderPublisher,utils::serial::SActivationPayload,&examples::sensors::CEncoderPublisher::binaryCallback>(&g_encoderPublisher)},
+    {utils::serial::BIN_TELEMETRY_SUBSCRIBE,utils::serial::CBinaryProtocol::bind<utils::telemetry::CTelemetry,utils::serial::STelemetrySubscribePayload,&utils::telemetry::CTelemetry::binaryCallbackSubscribe>(&g_telemetry)},
+    {utils::serial::BIN_PUBLISHER_SUBSCRIBE,utils::serial::CBinaryProtocol::bind<utils::publisher::CPublisherGroup,utils::serial::SPublisherSubscribePayload,&utils::publisher::CPublisherGroup::binaryCallback>(&g_publisher)},
+    {utils::serial::BIN_ODOMETRY_PUBLISH,utils::serial::CBinaryProtocol::bind<brain::COdometry,utils::serial::SActivationPayload,&brain::COdometry::binaryCallback>(&g_odometry)},
+    {utils::serial::BIN_REGISTER_READ,mbed::callback(&g_registerTable,&utils::registers::CRegisterTable::binaryCallbackRead)},
+    {utils::serial::BIN_REGISTER_WRITE,mbed::callback(&g_registerTable,&utils::registers::CRegisterTable::binaryCallbackWrite)},
+    {utils::serial::BIN_UPDATE_BEGIN,utils::serial::CBinaryProtocol::bind<utils::update::CFirmwareUpdate,utils::serial::SUpdateBeginPayload,&utils::update::CFirmwareUpdate::binaryCallbackBegin>(&g_firmwareUpdate)},
+    {utils::serial::BIN_UPDATE_BLOCK,mbed::callback(&g_firmwareUpdate,&utils::update::CFirmwareUpdate::binaryCallbackBlock)},
+    {utils::serial::BIN_EMERGENCY_STOP,mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::binaryCallbackEmergencyStop)},
+    {utils::serial::BIN_UPDATE_END,utils::serial::CBinaryProtocol::bind<utils::update::CFirmwareUpdate,utils::serial::SUpdateEndPayload,&utils::update::CFirmwareUpdate::binaryCallbackEnd>(&g_firmwareUpdate)},
+};
+
+/// SPI interface of the external CAN controller (PB15 MOSI, PB14 MISO, PB13 SCK), the F401 doesn't have a CAN peripheral.
+SPI g_canBus(PB_15, PB_14, PB_13);
+/// Create the driver of the MCP2515 CAN controller, its chip select is PB12, its interrupt output is connected to PB1 (EXTI line 1).
+hardware::can::CMcp2515 g_canController(g_canBus, PB_12, PB_1);
+/// First CAN identifier of the board: the binary messages are received in 0x100..0x17F, the responses are sent in 0x180..0x1FF.
+const uint16_t g_canNodeId = 0x100;
+/// First CAN identifier of the published values, the index of the value is added.
+const uint16_t g_canValueId = 0x200;
+/// Create the CAN transport, the frames of the node are dispatched to the same binary subscribers as the frames of the serial link.
+utils::can::CCanTransport g_canTransport(g_canController, g_binarySubscribers, g_canNodeId);
+/// Create the publisher of the sensor values on the CAN bus ('CANP' key with the hexadecimal mask of the values).
+utils::can::CCanPublisher g_canPublisher(g_vehicle.ticks(0.01f), g_publishedValues, sizeof(g_publishedValues)/sizeof(utils::publisher::IPublishedValue*), g_canTransport, g_canValueId);
+/// Common CAN identifier of the tick synchronization, it's accepted by all boards and it wins the arbitration against the node frames.
+const uint16_t g_canSyncId = 0x080;
+/// Sync period of the control ticks in second, the same on all boards of the vehicle network.
+constexpr float g_tickSyncPeriod = 0.1f;
+/// Create the synchronization of the control ticks ('TSYN' key), the master broadcasts its tick and the slaves trim their control timer, 
+/// so the control loops of the boards are aligned. The role is a calibration parameter.
+utils::can::CTickSync g_tickSync(g_vehicle.ticks(g_tickSyncPeriod), g_tickSyncPeriod, g_period_Encoder, g_canTransport, g_controlTimer, g_canSyncId);
+
+/// Create the DMA based receiver of the serial interface, the received frames are copied in a circular buffer without interrupt for each byte.
+hardware::drivers::CSerialDmaReceiver_USART2 g_rpiReceiver;
 /// Create the serial monitor object, which decodes, redirects the messages and transmites the responses.
-utils::serial::CSerialMonitor g_serialMonitor(g_rpi, g_serialMonitorSubscribers);
+utils::serial::CSerialMonitor g_serialMonitor(g_rpiReceiver, g_rpiTransmitter, g_serialMonitorSubscribers, g_binarySubscribers);
+/// Create the DMA based receiver of the bulk interface.
+hardware::drivers::CSerialDmaReceiver_USART6 g_debugReceiver;
+/// Create the serial monitor of the bulk interface, it's independent of the control link's monitor, with its own buffers.
+utils::serial::CSerialMonitor g_debugMonitor(g_debugReceiver, g_debugTransmitter, g_debugMonitorSubscribers);
+/// Create the queue of the deferred works, the serial callbacks post their expensive part (flash writing) and its result is sent on the control link.
+utils::task::CWorkQueue g_workQueue(g_rpiTransmitter);
 
 //! [Adding a resource]
 /// List of the task, each task will be applied their own periodicity, defined by initializing the objects.
 utils::task::CTask* g_taskList[] = {
+#ifdef WHEEL_SENSOR
     &g_blinker,
+#endif
     &g_serialMonitor,
-    &g_encoderPublisher
+    &g_debugMonitor,
+    &g_encoderPublisher,
+    &g_telemetry,
+    &g_sdLog,
+    &g_publisher,
+    &g_odometry,
+    &g_ultrasonic,
+    &g_tof,
+    &g_loadMonitor,
+    &g_loadShedder,
+    &g_workQueue,
+    &g_firmwareUpdate,
+    &g_flightRecorder,
+    &g_commandRecorder,
+    &g_profiler,
+    &g_signalScope,
+    &g_clockSync,
+    &g_linkBenchmark,
+    &g_rpiBaudNegotiator,
+    &g_debugBaudNegotiator,
+    &g_canTransport,
+    &g_canPublisher,
+    &g_tickSync,
+    &g_energyGovernor,
+    &g_eventLog,
+    &g_schedulability
 }; 
 //! [Adding a resource]
 
+/// Statistics of the tasks' execution, one object for each task of the list.
+utils::task::CTaskStatistics g_taskStatistics[sizeof(g_taskList)/sizeof(utils::task::CTask*)];
+/// Create the task monitor, which measures the execution time and the start jitter of the tasks and publishes them for the 'TSKS' key. 
+utils::task::CTaskMonitor g_taskMonitor(g_taskList, g_taskStatistics, sizeof(g_taskList)/sizeof(utils::task::CTask*));
+/// Create the schedulability analysis, it computes the worst-case response of each task from the measured execution times, the event 
+/// driven tasks are assumed at most once per millisecond. It's applied after the warm-up at boot and for the 'SCHD' key.
+utils::task::CSchedulability g_schedulability(g_taskList, g_taskStatistics, sizeof(g_taskList)/sizeof(utils::task::CTask*), g_baseTick, g_vehicle.ticks(0.001f)
+                                             , g_period_Encoder, mbed::callback(&g_controlLoop,&brain::CControlLoop::getMaxCycles), g_rpiTransmitter);
+
+#ifndef WHEEL_SENSOR
+/// Present fault conditions of the status led: degraded encoder or tripped bridge.
+bool statusFault() { return g_encoderMonitor.isDegraded() || g_motorVnhDriver.isTripped(); }
+/// Overload events of the status led: overruns of the control loop and missed deadlines of the tasks.
+uint32_t statusOverloads()
+{
+    uint32_t l_overloads = g_controlLoop.getOverruns();
+    for (uint32_t i = 0; i < sizeof(g_taskStatistics)/sizeof(utils::task::CTaskStatistics); ++i)
+    {
+        l_overloads += g_taskStatistics[i].getMissed();
+    }
+    return l_overloads;
+}
+#endif
+
+/// Static stacks of the normal and the real-time threads of the task manager, so the threads aren't allocated from the heap.
+MBED_ALIGN(8) unsigned char g_taskStacks[2 * utils::task::CPriorityTaskManager::s_defaultStackSize];
+
 /// Create the task manager, which applies periodically the tasks. It needs the list of task and the time base in seconds. 
-utils::task::CTaskManager g_taskManager(g_taskList, sizeof(g_taskList)/sizeof(utils::task::CTask*), g_baseTick);
+/// Each priority class is applied by its own thread, so the higher classes preempt the lower ones. The tasks with zero period 
+/// (serial monitor) are applied, when their event source notifies them.
+utils::task::CPriorityTaskManager g_taskManager(g_taskList, sizeof(g_taskList)/sizeof(utils::task::CTask*), g_baseTick
+                                               , utils::task::CPriorityTaskManager::s_defaultStackSize, g_taskStacks);
+
+/// Static memory of the subsystems in the memory report, the sizes of their objects
+utils::memory::CMemoryReport::SObject g_memoryObjects[] = {
+    {"serial",      sizeof(g_rpi) + sizeof(g_rpiSender) + sizeof(g_rpiTransmitter) + sizeof(g_rpiReceiver) + sizeof(g_serialMonitor) + sizeof(g_linkBenchmark) + sizeof(g_rpiBaudNegotiator) + sizeof(g_debugBaudNegotiator)
+                    + sizeof(g_debug) + sizeof(g_debugSender) + sizeof(g_debugTransmitter) + sizeof(g_debugReceiver) + sizeof(g_debugMonitor)
+                    + sizeof(g_canBus) + sizeof(g_canController) + sizeof(g_canTransport) + sizeof(g_canPublisher) + sizeof(g_tickSync)},
+    {"actuators",   sizeof(g_motorVnhDriver) + sizeof(g_steeringDriver) + sizeof(g_steeringCompensation) + sizeof(g_compensatedSteering)},
+    {"sensors",     sizeof(g_imuBus) + sizeof(g_imuMaster) + sizeof(g_i2cBus) + sizeof(g_imu) + sizeof(g_attitude) + sizeof(g_adcScanner) + sizeof(g_sampler) + sizeof(g_motorCounter) + sizeof(g_motorCurrent) + sizeof(g_batteryVoltage) + sizeof(g_lineSensor) + sizeof(g_encoderMediumSpeed) + sizeof(g_sampleMail) + sizeof(g_sampleHandoff) + sizeof(g_currentFilter) + sizeof(g_currentMonitor) + sizeof(g_batteryMonitor) + sizeof(g_encoderEdgeCapture) + sizeof(g_encoderIndexCapture) + sizeof(g_sampleFusion) 
+                    + sizeof(g_ultrasonicDistance) + sizeof(g_tofDistance) + sizeof(g_echoCapture) + sizeof(g_ultrasonic) + sizeof(g_tof)
+                    + sizeof(g_quadratureEncoderTask) + sizeof(g_rippleFilter) + sizeof(g_speedObserver) + sizeof(g_encoderMonitor)},
+    {"control",     sizeof(l_volt2pwmConverter) + sizeof(l_volt2pwmTable) + sizeof(g_supplyCompensation) + sizeof(l_pidController) + sizeof(g_smithPredictor) + sizeof(g_controller) + sizeof(l_positionController) 
+                    + sizeof(g_autotuner) + sizeof(g_stepExperiment) + sizeof(g_frictionCompensation) + sizeof(g_motorIdentifier) + sizeof(g_tractionControl) + sizeof(g_pwmCharacterizer) + sizeof(g_yawRatePid) + sizeof(g_steeringGeometry) + sizeof(g_yawRateSteering) + sizeof(g_thermalModel) + sizeof(g_controlTimer) + sizeof(g_controlPipeline) + sizeof(g_controlLoop)
+                    + sizeof(g_speedObserverStage) + sizeof(g_motorIdentifierStage) + sizeof(g_telemetryStage) + sizeof(g_derivedSignalsStage) + sizeof(g_signalGraph) + sizeof(g_signalGraphStage) + sizeof(g_loadShedder)},
+    {"brain",       sizeof(g_robotstatemachine) + sizeof(g_safetyMonitor) + sizeof(g_odometry) + sizeof(g_pathFollower) + sizeof(g_energyGovernor) + sizeof(g_eventLog) + sizeof(g_crashRecord)},
+    {"config",      sizeof(g_configValues) + sizeof(g_configStore) + sizeof(g_graphStore) + sizeof(g_firmwareUpdate) + sizeof(g_registerTable) + sizeof(g_registers) + sizeof(g_regReference) + sizeof(g_regEncoderSpeed) 
+                    + sizeof(g_regObserverSpeed) + sizeof(g_regPidError) + sizeof(g_regControl) + sizeof(g_regMotorCurrent) + sizeof(g_regSteering) + sizeof(g_regTemperature) 
+                    + sizeof(g_regTractionGain) + sizeof(g_regState) + sizeof(g_regEncoderCount) + sizeof(g_regBrakeDuty) + sizeof(g_regConfig)},
+    {"telemetry",   sizeof(g_telemetry) + sizeof(g_derivedSignals) + sizeof(g_derivedSources) + sizeof(g_sdCard) + sizeof(g_sdLog) + sizeof(g_flightRecorder) + sizeof(g_flightStorage) + sizeof(g_commandRecorder) + sizeof(g_commandStorage) + sizeof(g_encoderPublisher) + sizeof(g_publisher) + sizeof(g_publishedValues)
+                    + sizeof(g_pubEncoderSpeed) + sizeof(g_pubObserverSpeed) + sizeof(g_pubMotorCurrent) + sizeof(g_pubSteering) + sizeof(g_pubEncoderCount) + sizeof(g_pubLinePosition) + sizeof(g_pubStateOfCharge) + sizeof(g_pubBatteryPower)},
+    {"tasks",       sizeof(g_taskStatistics) + sizeof(g_taskMonitor) + sizeof(g_schedulability) + sizeof(g_taskManager) + sizeof(g_workQueue) + sizeof(g_profiler) + sizeof(g_signalScope) + sizeof(g_clockSync) + sizeof(g_powerManager)},
+    {"task stacks", sizeof(g_taskStacks) + sizeof(g_controlStack)}
+};
+/// Threads in the memory report, their used stack is measured by the RTOS
+utils::memory::CMemoryReport::SStack g_memoryStacks[] = {
+    {"normal thread",   g_taskManager.getThread(utils::task::NORMAL)},
+    {"realtime thread", g_taskManager.getThread(utils::task::REALTIME)},
+    {"control thread",  g_controlLoop.getThread()}
+};
+/// Create the memory report, it's printed at the beginning of the setup and its summary is sent for the 'MEMR' key.
+utils::memory::CMemoryReport g_memoryReport(g_memoryObjects, sizeof(g_memoryObjects)/sizeof(utils::memory::CMemoryReport::SObject)
+                                           , g_memoryStacks, sizeof(g_memoryStacks)/sizeof(utils::memory::CMemoryReport::SStack));
+
+/// Configuration was loaded from the flash, otherwise the defaults are applied.
+bool g_isConfigLoaded = false;
+
+/**
+ * @brief Initialization stage of the peripherals: calibration, serial interfaces and actuators, it runs before any message is sent.
+ * 
+ * @return true The stage succeeded.
+ */
+bool initPeripherals()
+{
+    /// Attach the crash record first, the faults of the later stages are also captured
+    hardware::drivers::CCrashCapture::attach(g_crashRecord);
+    /// Load the calibration from the flash, the erasing of a full sector stalls the startup, so it's applied before the watchdog
+    g_isConfigLoaded = g_configStore.load();
+    applyConfiguration();
+    /// Instantiate the signal graph of the stored configuration, the full area of the store is compacted by erasing the sector
+    g_graphStore.load();
+    g_signalGraph.load();
+    g_graphStore.setWriteGuard(mbed::callback(graphWriteAllowed));
+    g_configStore.setWriteGuard(mbed::callback(configWriteAllowed));
+    g_configStore.setWorkQueue(&g_workQueue);
+    g_firmwareUpdate.setWriteGuard(mbed::callback(configWriteAllowed));
+    g_rpi.baud(g_rpiBaud);  
+    g_debug.baud(g_debugBaud);
+    setRpiRateLimits(g_rpiBaud);
+    /// The actuators are written directly to the registers in the control loop
+    g_motorVnhDriver.setFastPath(true);
+    g_steeringDriver.setFastPath(true);
+    g_motorVnhDriver.setSynchronized(true);
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the sampled sensors: analog scanner, sampler and current monitor.
+ * 
+ * @return true The stage succeeded.
+ */
+bool initSampling()
+{
+    /// Start the scanner of the analog inputs synchronized to the motor pwm (8 periods in the buffer), after it the AnalogIn of the motor driver mustn't be read
+    g_adcScanner.setSynchronized(8, 0.25f);
+    /// The index pulse is captured from the start, the shaft angle is valid after the first revolution
+    g_encoderIndexCapture.enable();
+    g_quadratureEncoderTask.setIndexCapture(&g_encoderIndexCapture);
+#ifdef WHEEL_SENSOR
+    g_wheelCapture.start();
+#endif
+    g_sampler.start();
+    /// The encoder publisher consumes the sample blocks, it's triggered by each handoff
+    g_encoderPublisher.setHandoff(&g_sampleMail);
+    g_sampleMail.setNotifier(mbed::callback(&g_encoderPublisher, &utils::task::CTask::Notify));
+    /// Overcurrent trip at 10 A sample, the bridge is released below 3 A mean current
+    g_currentMonitor.start(10.0f, 3.0f, mbed::callback(motorOvercurrent));
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the inertial sensor, the car can move without it.
+ * 
+ * @return true The sensor was found and configured.
+ */
+bool initImu()
+{
+    /// Configure the inertial sensor (1 kHz, 44 Hz bandwidth), its FIFO is read in bursts of 10 samples and the odometry integrates the yaw by its samples
+    g_imuBus.frequency(400000);
+    if (!g_imu.configure(1000, 3, hardware::imu::CMpu6050::GYRO_500DPS, hardware::imu::CMpu6050::ACCEL_4G))
+    {
+        g_rpiTransmitter.printf("@IMUS:not found;;\r\n");
+        return false;
+    }
+    g_imuMaster.start();
+    g_imu.start(10);
+    g_odometry.setAttitude(&g_attitude);
+    g_odometry.setImu(mbed::callback(&g_imu,&hardware::imu::CMpu6050::pop));
+    /// The yaw rate mode of the steering is available with the gyroscope
+    g_yawRateSteering.setRateGetter(mbed::callback(&g_odometry,&brain::COdometry::getYawRate));
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the distance sensors, a missing sensor publishes the error status.
+ * 
+ * @return true The captures were started.
+ */
+bool initDistance()
+{
+    /// The steering pwm configured the TIM3, only the channel of the echo is changed
+    g_echoCapture.start();
+    /// The time-of-flight sensor shares the master of the inertial sensor, it's started here without the inertial sensor
+    if (!g_imuMaster.isStarted())
+    {
+        g_imuBus.frequency(400000);
+        g_imuMaster.start();
+    }
+    /// The state machine brakes in the control tick, when an obstacle is too close ('OBST' key)
+    g_robotstatemachine.setObstacleSensors(g_obstacleSensors, sizeof(g_obstacleSensors)/sizeof(const hardware::distance::CDistanceSnapshot*));
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the CAN controller, the car works without the vehicle network.
+ * 
+ * @return true The controller was found and configured.
+ */
+bool initCan()
+{
+    /// Both receive buffers accept the binary messages of the node (0x100..0x17F), the last filter of the second buffer accepts 
+    /// the frames of the tick synchronization (0x080..0x0FF)
+    for (uint8_t l_idx = 0; l_idx < hardware::can::CMcp2515::s_maskCount; l_idx++)
+    {
+        g_canController.setMask(l_idx, 0x780);
+    }
+    for (uint8_t l_idx = 0; l_idx < hardware::can::CMcp2515::s_filterCount - 1; l_idx++)
+    {
+        g_canController.setFilter(l_idx, g_canNodeId);
+    }
+    g_canController.setFilter(hardware::can::CMcp2515::s_filterCount - 1, g_canSyncId);
+    /// 500 kbit/s with the 8 MHz crystal of the common modules
+    if (!g_canController.start(500000, 8000000))
+    {
+        g_rpiTransmitter.printf("@CANB:not found;;\r\n");
+        return false;
+    }
+    g_canTransport.start();
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the controllers: telemetry signals, observer inputs and the extensions of the motor controller.
+ * 
+ * @return true The stage succeeded.
+ */
+bool initControllers()
+{
+    /// The encoder pushes its samples in the fusion buffer from the control tick
+    g_quadratureEncoderTask.getTopic().subscribe(mbed::callback(fusionEncoder));
+    /// Register the telemetry signals (subscription mask bits 0..7), they are the slots of the derived signals, which forward the raw
+    /// signals until a program is uploaded, they are sampled by the control loop
+    g_telemetry.setSink(&g_sdLog);
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<0>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<1>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<2>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<3>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<4>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<5>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<6>));
+    g_telemetry.addSignal(mbed::callback(&g_derivedSignals,&utils::telemetry::CDerivedSignals::getSlot<7>));
+    /// Register the channels of the signal scope (channel mask bits 0..3)
+    g_signalScope.addChannel(scopeMotorPwm);
+    g_signalScope.addChannel(scopeMotorCurrent);
+    g_signalScope.addChannel(scopeEncoderCount);
+    g_signalScope.addChannel(scopeBatteryVoltage);
+    /// Inputs of the speed observer model
+    g_speedObserver.setInputs(mbed::callback(&g_controller,&signal::controllers::CMotorController::get),mbed::callback(&g_motorCurrent,&hardware::sampling::CSampledCurrent::getCurrent));
+    g_encoderMonitor.setInputs(mbed::callback(&g_controller,&signal::controllers::CMotorController::get),mbed::callback(&g_motorCurrent,&hardware::sampling::CSampledCurrent::getCurrent));
+    g_encoderMonitor.setCallback(mbed::callback(encoderDegraded));
+#ifdef WHEEL_SENSOR
+    g_wheelSensor.setCommand(mbed::callback(&g_controller,&signal::controllers::CMotorController::get));
+#endif
+    /// Outer position loop of the motor controller for the distance commands
+    g_controller.setPositionController(&l_positionController,g_vehicle.m_encoderResolution,10,1.0f);
+    /// Relay autotuning of the speed controller
+    g_controller.setAutotuner(&g_autotuner);
+    g_controller.setExperiment(&g_stepExperiment);
+    /// Predictive speed control, it replaces the pid controller while it's activated by the 'MPCS' command
+    g_controller.setPredictiveController(&g_speedPredictive);
+    g_controller.setFrictionCompensation(&g_frictionCompensation);
+    /// Battery voltage of the volt to pwm correction
+    g_supplyCompensation.setInput(mbed::callback(&g_batteryVoltage,&hardware::sampling::CSampledVoltage::getVoltage));
+    /// Online identification of the drive model by the voltage of the speed controller
+    g_motorIdentifier.setInput(mbed::callback(&g_controller,&signal::controllers::CMotorController::getControlVoltage));
+    g_controller.setIdentifier(&g_motorIdentifier);
+    /// The full pwm range is allowed for the cold motor, it's derated linearly to 25 % between 90 C and 120 C winding temperature
+    g_thermalModel.setDerating(90.0f, 120.0f, 0.25f);
+    g_controller.setThermalModel(&g_thermalModel, 1.0f);
+    /// The history of the flight recorder is validated before the control loop, a history found after a reset is kept frozen
+    g_flightRecorder.restore();
+    /// The command log is kept after a soft reset, the accepted frames of the control link are passed to the recorder
+    g_commandRecorder.restore();
+    g_serialMonitor.setCapture(&g_commandRecorder);
+    /// The emergency stop frame of the control link brakes the motor from the receive interrupt
+    g_serialMonitor.setEmergencyStop(mbed::callback(&g_robotstatemachine,&brain::CRobotStateMachine::emergencyStop));
+    g_robotstatemachine.setFaultCallback(mbed::callback(flightRecorderFault));
+#ifndef WHEEL_SENSOR
+    /// The status led shows the blink codes from the start of the control loop
+    g_statusIndicator.setSources(mbed::callback(statusFault), mbed::callback(statusOverloads));
+    g_statusLed.start();
+#endif
+    /// On-board path following, it gives the steering angle of the move state while it's started by the 'PATH' command
+    g_robotstatemachine.setPathFollower(&g_pathFollower);
+    g_robotstatemachine.setEnergyGovernor(&g_energyGovernor);
+    /// The traction control integrates the body speed by the longitudinal acceleration of the inertial sensor
+    g_tractionControl.setAccelerationGetter(mbed::callback(&g_odometry,&brain::COdometry::getAcceleration));
+    g_pwmCharacterizer.setInputs(mbed::callback(&g_batteryMonitor,&hardware::sampling::CBatteryMonitor::getPower)
+                                ,mbed::callback(&g_motorVnhDriver,&hardware::drivers::CMotorDriverVnh::getPwmFrequency)
+                                ,mbed::callback(setMotorPwmFrequency), mbed::callback(pwmCharacterizationAllowed));
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the communication: DMA based receivers and the threads of the task manager.
+ * 
+ * @return true The stage succeeded.
+ */
+bool initCommunication()
+{
+    /// Start the DMA based receivers of the serial interfaces
+    g_rpiReceiver.start();
+    g_debugReceiver.start();
+    /// Set the priority classes and start the threads of the task manager
+#ifdef WHEEL_SENSOR
+    g_blinker.setPriorityClass(utils::task::BACKGROUND);
+#endif
+    g_serialMonitor.setPriorityClass(utils::task::NORMAL);
+    g_debugMonitor.setPriorityClass(utils::task::BACKGROUND);
+    g_encoderPublisher.setPriorityClass(utils::task::REALTIME);
+    g_telemetry.setPriorityClass(utils::task::NORMAL);
+    g_sdLog.setPriorityClass(utils::task::BACKGROUND);
+    g_publisher.setPriorityClass(utils::task::NORMAL);
+    g_odometry.setPriorityClass(utils::task::NORMAL);
+    /// The echo is resolved by the latency of the poll, so it isn't delayed by the background tasks
+    g_ultrasonic.setPriorityClass(utils::task::NORMAL);
+    g_tof.setPriorityClass(utils::task::NORMAL);
+    g_loadMonitor.setPriorityClass(utils::task::NORMAL);
+    g_loadShedder.setPriorityClass(utils::task::BACKGROUND);
+    g_workQueue.setPriorityClass(utils::task::BACKGROUND);
+    g_firmwareUpdate.setPriorityClass(utils::task::BACKGROUND);
+    g_flightRecorder.setPriorityClass(utils::task::BACKGROUND);
+    /// The replay dispatches the frames by the monitor, so it's in the class of the monitor
+    g_commandRecorder.setPriorityClass(utils::task::NORMAL);
+    g_profiler.setPriorityClass(utils::task::BACKGROUND);
+    g_signalScope.setPriorityClass(utils::task::BACKGROUND);
+    g_clockSync.setPriorityClass(utils::task::BACKGROUND);
+    g_linkBenchmark.setPriorityClass(utils::task::NORMAL);
+    g_rpiBaudNegotiator.setPriorityClass(utils::task::NORMAL);
+    g_debugBaudNegotiator.setPriorityClass(utils::task::NORMAL);
+    g_canTransport.setPriorityClass(utils::task::NORMAL);
+    g_canPublisher.setPriorityClass(utils::task::NORMAL);
+    /// The callbacks of the sync frames are applied by the transport, so the task is in the class of the transport
+    g_tickSync.setPriorityClass(utils::task::NORMAL);
+    g_energyGovernor.setPriorityClass(utils::task::BACKGROUND);
+    /// The safety events are in the log, so it's sent before the normal traffic
+    g_eventLog.setPriorityClass(utils::task::REALTIME);
+    g_schedulability.setPriorityClass(utils::task::BACKGROUND);
+    /// Shift the tasks with common multiple periods in separate ticks, so their triggers don't coincide
+    g_taskManager.balancePhases();
+    g_taskManager.start();
+    return true;
+}
+
+/**
+ * @brief Initialization stage of the control: watchdog, control loop and load measurement. The motion commands are applied after it.
+ * 
+ * @return true The stage succeeded.
+ */
+bool initControl()
+{
+    /// Start the watchdog, it's refreshed by the safety monitor in each tick of the control loop
+    g_safetyMonitor.startWatchdog(0.1f);
+    /// A tick longer than 80 % of the period is a missed deadline, the repeated misses shed the optional stages
+    g_controlLoop.setDeadline(0.8f);
+    /// Start the control loop, it replaces the Rtos timers of the quadrature encoder and of the motion controller
+    g_controlLoop.start();
+    /// Start the measurement of the CPU load, the idle hook replaces the sleep of the idle thread
+    g_loadMonitor.start();
+    /// The idle thread sleeps after the start of the load measurement, its hook enters the sleep mode
+    g_powerManager.enable(true);
+    return true;
+}
+
+/**
+ * @brief Report stage: the banner is queued in the transmitter of the control link and the memory report is printed on the debug link.
+ * 
+ * @return true The stage succeeded.
+ */
+bool initReport()
+{
+    static const char s_banner[] = "\r\n\r\n#################\r\n#               #\r\n#   I'm alive   #\r\n#               #\r\n#################\r\n\r\n";
+    g_rpiTransmitter.write(s_banner, sizeof(s_banner) - 1);
+    if (hardware::drivers::CWatchdog_IWDG::wasReset())
+    {
+        g_rpiTransmitter.printf(utils::serial::CSerialTransmitter::LANE_SAFETY,"@SAFE:watchdog reset;;\r\n");
+    }
+    if (hardware::drivers::CCrashCapture::isPending())
+    {
+        char l_crash[200];
+        hardware::drivers::CCrashCapture::format(l_crash, sizeof(l_crash));
+        g_rpiTransmitter.printf(utils::serial::CSerialTransmitter::LANE_SAFETY,"@CRSH:%s;;\r\n", l_crash);
+        hardware::drivers::CCrashCapture::acknowledge();
+    }
+    if (g_flightRecorder.isFrozen())
+    {
+        g_rpiTransmitter.printf("@FREC:post-mortem;%u;%lu;;\r\n", g_flightRecorder.getTrigger(), static_cast<unsigned long>(g_flightRecorder.getCount()));
+    }
+    /// Report the static memory and the heap after the static initialization, the used stacks are sent later for the 'MEMR' key
+    g_memoryReport.print(g_debug);
+    g_debug.printf("Configuration: %s\r\n", g_isConfigLoaded ? "flash" : "defaults");
+    /// Check the schedulability of the task list, when the statistics contain the worst cases of the first seconds
+    g_schedulability.startOneShot(g_vehicle.ticks(5.0f));
+    return true;
+}
+
+/// Stages of the initialization, the phases are applied in order, the banner and the reports follow the start of the control loop.
+utils::init::CInitSequence::SStage g_initStages[] = {
+    {"periph",  utils::init::HARDWARE,      mbed::callback(initPeripherals),    0, false},
+    {"sampling",utils::init::HARDWARE,      mbed::callback(initSampling),       0, false},
+    {"imu",     utils::init::HARDWARE,      mbed::callback(initImu),            0, false},
+    {"distance",utils::init::HARDWARE,      mbed::callback(initDistance),       0, false},
+    {"can",     utils::init::HARDWARE,      mbed::callback(initCan),            0, false},
+    {"ctrl",    utils::init::HARDWARE,      mbed::callback(initControllers),    0, false},
+    {"comm",    utils::init::COMMUNICATION, mbed::callback(initCommunication),  0, false},
+    {"loop",    utils::init::CONTROL,       mbed::callback(initControl),        0, false},
+    {"report",  utils::init::REPORT,        mbed::callback(initReport),         0, false}
+};
+/// Create the initialization sequence, its durations are sent for the 'BOOT' key.
+utils::init::CInitSequence g_initSequence(g_initStages, sizeof(g_initStages)/sizeof(utils::init::CInitSequence::SStage));
 
 /**
- * @brief Setup function for initializing some objects and transmiting a startup message through the serial. 
+ * @brief Setup function for initializing the objects by the init sequence and transmiting a ready message through the serial. 
  * 
  * @return uint32_t Error level codes error's type.
  */
 uint32_t setup()
 {
-    g_rpi.baud(256000);  
-    g_rpi.printf("\r\n\r\n");
-    g_rpi.printf("#################\r\n");
-    g_rpi.printf("#               #\r\n");
-    g_rpi.printf("#   I'm alive   #\r\n");
-    g_rpi.printf("#               #\r\n");
-    g_rpi.printf("#################\r\n");
-    g_rpi.printf("\r\n");
-    /// Start the Rtos timer for the quadrature encoder    
-    g_quadratureEncoderTask.startTimer();
-    /// Start the Rtos timer for the motion controller
-    g_robotstatemachine.startRtosTimer();
+    /// A failed stage (missing sensor) is reported, the platform is started without it
+    g_initSequence.run();
+    g_initSequence.report(g_rpiTransmitter);
     return 0;    
 }
 
@@ -142,5 +1500,6 @@ int main()
         l_errorLevel = loop();
     }
     g_rpi.printf("exiting with code: %d",l_errorLevel);
+    g_debug.printf("exiting with code: %d",l_errorLevel);
     return l_errorLevel;
 }
\ No newline at end of file
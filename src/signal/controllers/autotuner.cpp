@@ -0,0 +1,180 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *   
+  ******************************************************************************
+  * @file    Autotuner.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the relay feedback
+  *          autotuning of the pid controller.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/autotuner.hpp>
+
+namespace signal{
+namespace controllers{
+    /**
+     * @brief Construct a new CRelayAutotuner::CRelayAutotuner object
+     * 
+     * @param f_dt          Sampling time (s)
+     * @param f_rule        [Optional] Tuning rule
+     * @param f_skipCycles  [Optional] Number of the skipped transient cycles
+     * @param f_cycles      [Optional] Number of the measured cycles
+     * @param f_timeout     [Optional] Maximum time without switching of the relay (s)
+     */
+    CRelayAutotuner::CRelayAutotuner(float f_dt, ERule f_rule, uint8_t f_skipCycles, uint8_t f_cycles, float f_timeout)
+        :m_dt(f_dt)
+        ,m_rule(f_rule)
+        ,m_skipCycles(f_skipCycles)
+        ,m_cycles(f_cycles > 0 ? f_cycles : 1)
+        ,m_timeout(static_cast<uint32_t>(f_timeout / f_dt))
+        ,m_bias(0.0f)
+        ,m_amplitude(0.0f)
+        ,m_hysteresis(0.0f)
+        ,m_isHigh(true)
+        ,m_tick(0)
+        ,m_cycle(0)
+        ,m_max(0.0f)
+        ,m_min(0.0f)
+        ,m_sumTicks(0)
+        ,m_sumAmplitude(0.0f)
+        ,m_state(IDLE)
+        ,m_result()
+    {
+    }
+
+    /**
+     * @brief Start the experiment, the loop has to be near to the operating point.
+     * 
+     * @param f_bias        Bias of the control signal, generally the control signal of the operating point
+     * @param f_amplitude   Amplitude of the relay
+     * @param f_hysteresis  Hysteresis of the relay in the unit of the error
+     */
+    void CRelayAutotuner::start(float f_bias, float f_amplitude, float f_hysteresis)
+    {
+        m_bias = f_bias;
+        m_amplitude = std::abs(f_amplitude);
+        m_hysteresis = std::abs(f_hysteresis);
+        m_isHigh = true;
+        m_tick = 0;
+        m_cycle = 0;
+        m_max = 0.0f;
+        m_min = 0.0f;
+        m_sumTicks = 0;
+        m_sumAmplitude = 0.0f;
+        m_state = RUNNING;
+    }
+
+    /**
+     * @brief Stop the experiment without result.
+     * 
+     */
+    void CRelayAutotuner::stop()
+    {
+        m_state = IDLE;
+    }
+
+    /**
+     * @brief Apply one step of the experiment. A cycle ends, when the relay switches to the high output.
+     * 
+     * @param f_error       Error between the reference and the measured value
+     * @return              Control signal of the relay
+     */
+    float CRelayAutotuner::step(float f_error)
+    {
+        if (m_state != RUNNING)
+        {
+            return m_bias;
+        }
+        ++m_tick;
+        if (f_error > m_max)
+        {
+            m_max = f_error;
+        }
+        if (f_error < m_min)
+        {
+            m_min = f_error;
+        }
+        if (m_isHigh && f_error < -m_hysteresis)
+        {
+            m_isHigh = false;
+        }
+        else if (!m_isHigh && f_error > m_hysteresis)
+        {
+            m_isHigh = true;
+            // End of a cycle
+            if (m_cycle >= m_skipCycles)
+            {
+                m_sumTicks += m_tick;
+                m_sumAmplitude += (m_max - m_min) * 0.5f;
+            }
+            ++m_cycle;
+            m_tick = 0;
+            m_max = f_error;
+            m_min = f_error;
+            if (m_cycle >= m_skipCycles + m_cycles)
+            {
+                calculate();
+                return m_bias;
+            }
+        }
+        if (m_tick > m_timeout)
+        {
+            m_state = FAILED;
+            return m_bias;
+        }
+        return m_isHigh ? m_bias + m_amplitude : m_bias - m_amplitude;
+    }
+
+    /**
+     * @brief Calculate the critical point and the pid parameters by the averaged cycles.
+     * 
+     */
+    void CRelayAutotuner::calculate()
+    {
+        float l_amplitude = m_sumAmplitude / m_cycles;
+        if (l_amplitude <= 0.0f)
+        {
+            m_state = FAILED;
+            return;
+        }
+        m_result.m_tu = static_cast<float>(m_sumTicks) / m_cycles * m_dt;
+        m_result.m_ku = 4.0f * m_amplitude / (3.14159265f * l_amplitude);
+        float l_ti, l_td;
+        if (m_rule == ZIEGLER_NICHOLS)
+        {
+            m_result.m_kp = 0.6f * m_result.m_ku;
+            l_ti = 0.5f * m_result.m_tu;
+            l_td = 0.125f * m_result.m_tu;
+        }
+        else
+        {
+            m_result.m_kp = m_result.m_ku / 2.2f;
+            l_ti = 2.2f * m_result.m_tu;
+            l_td = m_result.m_tu / 6.3f;
+        }
+        m_result.m_ki = m_result.m_kp / l_ti;
+        m_result.m_kd = m_result.m_kp * l_td;
+        m_result.m_tf = 0.1f * l_td;
+        if (m_result.m_tf < 4.0f * m_dt)
+        {
+            m_result.m_tf = 4.0f * m_dt;
+        }
+        m_state = FINISHED;
+    }
+}; // namespace controllers
+}; // namespace signal
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *   
+  ******************************************************************************
+  * @file    CurrentController.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the inner current
+  *          control loop.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/currentcontroller.hpp>
+
+namespace signal{
+namespace controllers{
+    /**
+     * @brief Construct a new CCurrentController::CCurrentController object
+     * 
+     * @param f_pid       Reference to the current controller, its output is the duty cycle.
+     * @param f_current   Reference to the current measurement.
+     * @param f_motor     Reference to the motor driver.
+     * @param f_limit     Absolute limit of the duty cycle.
+     * @param f_divider   [Optional] Number of the measurements per controller step.
+     * @param f_timeout   [Optional] Number of the controller steps without new reference before disarming.
+     */
+    CCurrentController::CCurrentController(siso::IController<float>&            f_pid
+                                          ,hardware::drivers::ICurrentGetter&   f_current
+                                          ,hardware::drivers::IMotorCommand&    f_motor
+                                          ,float                                f_limit
+                                          ,uint32_t                             f_divider
+                                          ,uint32_t                             f_timeout)
+        :m_pid(f_pid)
+        ,m_current(f_current)
+        ,m_motor(f_motor)
+        ,m_limit(f_limit)
+        ,m_divider(f_divider > 0 ? f_divider : 1)
+        ,m_timeout(f_timeout)
+        ,m_reference(0.0f)
+        ,m_tick(0)
+        ,m_age(0)
+        ,m_u(0.0f)
+        ,m_saturation(0)
+        ,m_armed(false)
+    {
+    }
+
+    /**
+     * @brief Set the current reference, the controller is armed and it writes the motor driver from the next step.
+     * 
+     * @param f_current The reference in ampere, the sign gives the direction.
+     */
+    void CCurrentController::setReference(float f_current)
+    {
+        m_reference = f_current;
+        m_age = 0;
+        m_armed = true;
+    }
+
+    /**
+     * @brief Disarm the controller, it doesn't write the motor driver and its states are cleared. 
+     * 
+     */
+    void CCurrentController::disarm()
+    {
+        m_armed = false;
+        m_reference = 0.0f;
+        m_u = 0.0f;
+        m_saturation = 0;
+        m_pid.clear();
+    }
+
+    /**
+     * @brief Apply one step of the controller. It's applied after each measurement, the controller is calculated in each divider-th call.
+     * 
+     */
+    void CCurrentController::step()
+    {
+        if (!m_armed || ++m_tick < m_divider)
+        {
+            return;
+        }
+        m_tick = 0;
+        if (++m_age > m_timeout)
+        {
+            disarm();
+            return;
+        }
+        float l_reference = m_reference;
+        // The sign of the measurement is given by the direction of the applied duty cycle
+        float l_direction = (m_u != 0.0f) ? m_u : l_reference;
+        float l_current = std::abs(m_current.getCurrent());
+        float l_measured = (l_direction < 0.0f) ? -l_current : l_current;
+        float l_u = m_pid.calculateControl(l_reference - l_measured);
+        if (l_u > m_limit)
+        {
+            l_u = m_limit;
+            m_saturation = 1;
+        }
+        else if (l_u < -m_limit)
+        {
+            l_u = -m_limit;
+            m_saturation = -1;
+        }
+        else
+        {
+            m_saturation = 0;
+        }
+        m_pid.setSaturation(m_saturation);
+        m_motor.setSpeed(l_u);
+        m_u = l_u;
+    }
+}; // namespace controllers
+}; // namespace signal
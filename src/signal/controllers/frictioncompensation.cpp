@@ -0,0 +1,194 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    FrictionCompensation.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the position indexed
+  *          compensation of the friction and of the cogging.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/frictioncompensation.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace signal{
+namespace controllers{
+
+    /**
+     * @brief Construct a new CFrictionCompensation object, the table is empty, so the constant offset of the controller is applied.
+     *
+     * @param f_angle getter of the shaft angle
+     */
+    CFrictionCompensation::CFrictionCompensation(FAngleGetter f_angle)
+        :m_angle(f_angle)
+        ,m_table()
+        ,m_sums()
+        ,m_counts()
+        ,m_valid()
+        ,m_isCalibrating(false)
+    {
+    }
+
+    /**
+     * @brief Sector of the actual shaft angle.
+     *
+     * @param f_bin sector
+     * @return false, while the shaft angle isn't absolute
+     */
+    CONTROL_RAMFUNC bool CFrictionCompensation::sector(uint8_t& f_bin)
+    {
+        float l_angle = m_angle ? m_angle() : -1.0f;
+        if(l_angle < 0.0f){
+            return false;
+        }
+        uint32_t l_bin = static_cast<uint32_t>(l_angle * s_bins);
+        f_bin = static_cast<uint8_t>((l_bin < s_bins) ? l_bin : (s_bins - 1));
+        return true;
+    }
+
+    /**
+     * @brief Voltage of the compensation in the sector of the shaft.
+     *
+     * @param f_direction direction of the move
+     * @param f_voltage magnitude of the voltage (V), it's unchanged without compensation
+     * @return false, when the table of the direction isn't valid or the shaft angle isn't absolute
+     */
+    CONTROL_RAMFUNC bool CFrictionCompensation::lookup(EDirection f_direction, float& f_voltage)
+    {
+        uint8_t l_bin;
+        if(!m_valid[f_direction] || !sector(l_bin)){
+            return false;
+        }
+        f_voltage = m_table[f_direction][l_bin];
+        return true;
+    }
+
+    /**
+     * @brief Record a sample of the calibration in the sector of the shaft, it's ignored outside of the calibration.
+     *
+     * @param f_direction direction of the move
+     * @param f_voltage magnitude of the static voltage (V)
+     */
+    CONTROL_RAMFUNC void CFrictionCompensation::learn(EDirection f_direction, float f_voltage)
+    {
+        uint8_t l_bin;
+        if(!m_isCalibrating || f_voltage < 0.0f || f_voltage > s_maxVoltage || !sector(l_bin)){
+            return;
+        }
+        if(m_counts[f_direction][l_bin] < 0xFFFF){
+            m_sums[f_direction][l_bin] += f_voltage;
+            m_counts[f_direction][l_bin]++;
+        }
+    }
+
+    /**
+     * @brief Start the calibration, the samples of the previous calibration are dropped and the table is applied until the end.
+     */
+    void CFrictionCompensation::startCalibration()
+    {
+        core_util_critical_section_enter();
+        for(uint8_t d = 0; d < 2; ++d){
+            for(uint8_t i = 0; i < s_bins; ++i){
+                m_sums[d][i] = 0.0f;
+                m_counts[d][i] = 0;
+            }
+        }
+        m_isCalibrating = true;
+        core_util_critical_section_exit();
+    }
+
+    /**
+     * @brief Stop the recording, each direction with enough samples in all sectors replaces its table by the mean voltages.
+     *
+     * @return false, when neither direction was completed, the previous table is kept for it
+     */
+    bool CFrictionCompensation::finishCalibration()
+    {
+        bool l_applied = false;
+        core_util_critical_section_enter();
+        m_isCalibrating = false;
+        for(uint8_t d = 0; d < 2; ++d){
+            bool l_complete = true;
+            for(uint8_t i = 0; i < s_bins; ++i){
+                l_complete = l_complete && (m_counts[d][i] >= s_minSamples);
+            }
+            for(uint8_t i = 0; i < s_bins && l_complete; ++i){
+                m_table[d][i] = m_sums[d][i] / m_counts[d][i];
+            }
+            m_valid[d] = m_valid[d] || l_complete;
+            l_applied = l_applied || l_complete;
+        }
+        core_util_critical_section_exit();
+        return l_applied;
+    }
+
+    /**
+     * @brief Clear the table, the constant offset of the controller is applied again.
+     */
+    void CFrictionCompensation::clear()
+    {
+        core_util_critical_section_enter();
+        m_isCalibrating = false;
+        m_valid[FORWARD] = false;
+        m_valid[BACKWARD] = false;
+        core_util_critical_section_exit();
+    }
+
+    /**
+     * @brief Serial callback method to get the state and the table, to calibrate or to clear it.
+     *
+     * @param a input received string, 0: state, 1: start the calibration, 2: apply the calibration, 3;sector: entries, 4: clear
+     * @param b output reponse message
+     */
+    void CFrictionCompensation::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if(!utils::fmt::parseUint(l_text, l_command)){
+            sprintf(b,"sintax error;;");
+        } else if(0 == l_command){
+            uint16_t l_least = 0xFFFF;
+            for(uint8_t d = 0; d < 2; ++d){
+                for(uint8_t i = 0; i < s_bins; ++i){
+                    l_least = (m_counts[d][i] < l_least) ? m_counts[d][i] : l_least;
+                }
+            }
+            utils::fmt::CWriter(b).udec(m_isCalibrating ? 1 : 0).udec(m_valid[FORWARD] ? 1 : 0).udec(m_valid[BACKWARD] ? 1 : 0).udec(l_least).chr(';');
+        } else if(1 == l_command){
+            startCalibration();
+            sprintf(b,"ack;;");
+        } else if(2 == l_command){
+            sprintf(b, finishCalibration() ? "ack;;" : "calibration error;;");
+        } else if(3 == l_command && ';' == *l_text++){
+            uint32_t l_bin;
+            if(utils::fmt::parseUint(l_text, l_bin) && l_bin < s_bins){
+                utils::fmt::CWriter(b).fixed(m_table[FORWARD][l_bin],3).fixed(m_table[BACKWARD][l_bin],3).chr(';');
+            } else{
+                sprintf(b,"sintax error;;");
+            }
+        } else if(4 == l_command){
+            clear();
+            sprintf(b,"ack;;");
+        } else{
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace controllers
+}; // namespace signal
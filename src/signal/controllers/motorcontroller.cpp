@@ -24,6 +24,8 @@
  */
 
 #include <signal/controllers/motorcontroller.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
 
 namespace signal{
     
@@ -39,13 +41,40 @@ namespace controllers{
      * @param f_sup_ref   [Optional] Superior limit of reference signal.
      */
     CMotorController::CMotorController(hardware::encoders::IEncoderGetter&          f_encoder
-                            ,ControllerType<double>&                    f_pid
+                            ,ControllerType<float>&                     f_pid
                             ,signal::controllers::IConverter*                   f_converter
                             ,float                                      f_inf_ref
                             ,float                                      f_sup_ref)
         :m_encoder(f_encoder)
         ,m_pid(f_pid)
+        ,m_RefRps(0.0f)
+        ,m_u(0.0f)
+        ,m_error(0.0f)
+        ,m_ffGain(0.0f)
+        ,m_ffOffset(0.0f)
         ,m_converter(f_converter)
+        ,m_controllerOutput(0.0f)
+        ,m_appliedVoltage(0.0f)
+        ,m_identifier(NULL)
+        ,m_autotuner(NULL)
+        ,m_experiment(NULL)
+        ,m_friction(NULL)
+        ,m_predictive(NULL)
+        ,m_currentController(NULL)
+        ,m_maxCurrent(0.0f)
+        ,m_thermalModel(NULL)
+        ,m_maxPwm(0.5f)
+        ,m_derating(1.0f)
+        ,m_positionPid(NULL)
+        ,m_resolution(1.0f)
+        ,m_positionDivider(1)
+        ,m_positionTick(0)
+        ,m_positionTolerance(0.0f)
+        ,m_position(0)
+        ,m_positionTarget(0.0f)
+        ,m_maxPositionRps(0.0f)
+        ,m_positionActive(false)
+        ,m_openLoop(false)
         ,m_nrHighPwm(0)
         ,m_maxNrHighPwm(10)
         ,m_control_sup(0.5)
@@ -63,7 +92,7 @@ namespace controllers{
      * 
      * @param f_RefRps The value of the reference signal
      */
-    void CMotorController::setRef(double f_RefRps)
+    void CMotorController::setRef(float f_RefRps)
     {
         m_RefRps=f_RefRps;
     }
@@ -71,7 +100,7 @@ namespace controllers{
     /** \brief  Get the value of reference signal.
      *
      */
-    double CMotorController::getRef()
+    float CMotorController::getRef()
     {
         return m_RefRps;
     }
@@ -79,7 +108,7 @@ namespace controllers{
     /** @brief  Get the value of the control signal calculated last time.
      * 
      */
-    double CMotorController::get()
+    float CMotorController::get()
     {
         return m_u;
     }
@@ -87,7 +116,7 @@ namespace controllers{
     /** @brief  Get the value of the error between the measured and reference signal. 
      *
      */
-    double CMotorController::getError()
+    float CMotorController::getError()
     {
         return m_error;
     }
@@ -98,34 +127,76 @@ namespace controllers{
     void CMotorController::clear()
     {
         m_pid.clear();
+        if(m_predictive != NULL){
+            m_predictive->clear();
+        }
+        disarmCurrentController();
+        m_appliedVoltage = 0.0f;
     }
 
 
     /**
      * @brief It calculates the next value of the control signal, by utilizing the given interfaces.
      * 
+     * With the position controller the reference speed is calculated by the position error in each divider-th period. With the 
+     * current controller the output of the speed controller is the current reference of the inner loop and the control signal is 
+     * the duty cycle applied by the inner loop.
+     * 
      * @return true control works fine
      * @return false appeared an error
      */
-    int8_t CMotorController::control()
+    CONTROL_RAMFUNC int8_t CMotorController::control()
     {
+        m_appliedVoltage = 0.0f;
+        if(m_openLoop){
+            return openLoopControl();
+        }
         // Mesurment speed value
         float  l_MesRps = m_encoder.getSpeedRps();
         bool   l_isAbs = m_encoder.isAbs();
         float  l_ref;
 
+        // Scripted reference of the experiment instead of the reference of the state machine
+        if(m_experiment != NULL && m_experiment->getState() == CStepExperiment::RUNNING){
+            m_RefRps = m_experiment->step((l_isAbs && m_RefRps < 0.0f) ? -std::abs(l_MesRps) : l_MesRps);
+        }
+
+        // Outer position loop
+        if(m_positionActive){
+            int16_t l_count = m_encoder.getCount();
+            m_position += (l_isAbs && m_RefRps < 0.0f) ? -std::abs(l_count) : l_count;
+            if(++m_positionTick >= m_positionDivider){
+                m_positionTick = 0;
+                float l_ref_position = m_positionPid->calculateControl(getPositionError());
+                if(l_ref_position > m_maxPositionRps){
+                    l_ref_position = m_maxPositionRps;
+                } else if(l_ref_position < -m_maxPositionRps){
+                    l_ref_position = -m_maxPositionRps;
+                }
+                m_RefRps = l_ref_position;
+            }
+        }
+
         // Check the measured value and the superior limit for avoid over control state.
         // In this case deactivate the controller. 
         if(std::abs(l_MesRps) > m_mes_abs_sup){
-            m_RefRps = 0.0;
-            m_u = 0.0;
+            m_RefRps = 0.0f;
+            m_u = 0.0f;
+            disarmCurrentController();
+            stopAutotune();
+            stopExperiment();
             return -1;
         }
+        // Direction of the move for the friction compensation, the learned table allows the crawling below the standing limit
+        CFrictionCompensation::EDirection l_direction = (m_RefRps < 0.0f) ? CFrictionCompensation::BACKWARD : CFrictionCompensation::FORWARD;
+        float l_ref_abs_inf = (m_friction != NULL && (m_friction->isValid(l_direction) || m_friction->isCalibrating())) ? CFrictionCompensation::s_minSpeed : m_ref_abs_inf;
         // Check the inferior limits of reference signal and measured signal for standing state.
         // Inactivate the controller to not brake the robot, when it stopped. 
-        if(std::abs(m_RefRps) < m_ref_abs_inf && std::abs(l_MesRps) < m_mes_abs_inf ){
-            m_u = 0.0;
-            m_error = 0.0;
+        if(std::abs(m_RefRps) < l_ref_abs_inf && std::abs(l_MesRps) < m_mes_abs_inf ){
+            m_u = 0.0f;
+            m_error = 0.0f;
+            disarmCurrentController();
+            stopAutotune();
             return 1; 
         }
 
@@ -136,31 +207,473 @@ namespace controllers{
             l_ref = m_RefRps;
         }
         float l_error=l_ref-l_MesRps;
-        float l_v_control = m_pid.calculateControl(l_error);
-        float l_pwm_control = converter(l_v_control);
-        
+        // The operating point of the scheduled controllers is selected by the absolute reference speed
+        m_pid.setSchedulingVariable(std::abs(m_RefRps));
+        float l_v_control;
+        if(m_autotuner != NULL && m_autotuner->getState() == CRelayAutotuner::RUNNING){
+            // Relay experiment instead of the controller, at the end the new parameters are applied
+            l_v_control = m_autotuner->step(l_error);
+            if(m_autotuner->getState() == CRelayAutotuner::FINISHED){
+                const CRelayAutotuner::SResult& l_result = m_autotuner->getResult();
+                m_pid.setParameters(l_result.m_kp,l_result.m_ki,l_result.m_kd,l_result.m_tf);
+            }
+        } else if(m_predictive != NULL && m_currentController == NULL && m_predictive->isActive()){
+            // The predictive controller respects the voltage and acceleration limits, the static gain is part of its model
+            l_v_control = m_predictive->control(l_ref, l_MesRps, m_derating);
+        } else{
+            l_v_control = m_pid.calculateControl(l_error);
+            // Static feed-forward from the reference, the friction offset is the learned voltage of the shaft sector
+            float l_offset = m_ffOffset;
+            if(m_friction != NULL){
+                m_friction->lookup(l_direction, l_offset);
+            }
+            if(l_ref > 0.0f){
+                l_v_control += m_ffGain*l_ref + l_offset;
+            } else if(l_ref < 0.0f){
+                l_v_control += m_ffGain*l_ref - l_offset;
+            }
+            // The calibration records the static part of the voltage: the speed controller and the friction offset
+            if(m_friction != NULL && m_friction->isCalibrating() && 0.0f != l_ref){
+                m_friction->learn(l_direction, (l_ref > 0.0f) ? (l_v_control - m_ffGain*l_ref) : (m_ffGain*l_ref - l_v_control));
+            }
+        }
+        m_controllerOutput = l_v_control;
+        updateLimits();
+        // Sign of the applied control signal for the absolute encoder
+        float l_sign = (m_RefRps<0 && l_isAbs) ? -1.0f : 1.0f;
+
+        if(m_currentController != NULL){
+            // Cascaded control: the output is the current reference of the inner loop
+            float l_current = currentLimit(l_v_control);
+            m_currentController->setReference(l_sign*l_current);
+        } else{
+            float l_pwm_control = converter(l_v_control);
+            // Feed back the saturation to the controller for the anti-windup
+            if(l_pwm_control >= m_control_sup){
+                m_pid.setSaturation(1);
+            } else if(l_pwm_control <= m_control_inf){
+                m_pid.setSaturation(-1);
+            } else{
+                m_pid.setSaturation(0);
+            }
+            m_u=l_sign*l_pwm_control;
+            m_appliedVoltage = (0.0f != m_u) ? l_sign*l_v_control : 0.0f;
+        }
 
         // Verify the number of high control signal and the measued rotation speed. When it's true, than the encoder doesn't measure the correct rotation speed,
         // so the calculated control signal has a too high value. 
         if(m_nrHighPwm>m_maxNrHighPwm && l_MesRps==0){
             m_pid.clear();
-            m_RefRps = 0.0;
-            m_u = 0.0;
+            m_RefRps = 0.0f;
+            m_u = 0.0f;
             m_nrHighPwm = 0;
+            m_appliedVoltage = 0.0f;
+            disarmCurrentController();
+            stopAutotune();
+            stopExperiment();
             return -2;
         }
 
-        m_u=l_pwm_control;
+        if(m_currentController != NULL){
+            m_u=m_currentController->get();
+        }
         m_error=l_error;
-        
-        // Check measured value is oriantated or absolute.
-        if(m_RefRps<0 && l_isAbs)
-        {
-            m_u=m_u*-1.0;
+        return 1;
+    }
+
+    /**
+     * @brief Open-loop control step, while the encoder isn't healthy. 
+     * 
+     * The voltage is the static feed-forward of the reference, so the car keeps moving with the calibrated speed characteristic 
+     * instead of braking; without feed-forward parameters it coasts. The position control needs the encoder, so it's aborted 
+     * as an encoder error. The inner current loop is bypassed, its reference would be given by the speed controller.
+     * 
+     * @return 1 the pwm is applied, -2 the position control was aborted
+     */
+    CONTROL_RAMFUNC int8_t CMotorController::openLoopControl()
+    {
+        m_pid.clear();
+        disarmCurrentController();
+        stopAutotune();
+        stopExperiment();
+        if(m_positionActive){
+            m_positionActive = false;
+            m_RefRps = 0.0f;
+            m_u = 0.0f;
+            return -2;
+        }
+        float l_v_control = 0.0f;
+        if(m_RefRps > 0.0f){
+            l_v_control = m_ffGain*m_RefRps + m_ffOffset;
+        } else if(m_RefRps < 0.0f){
+            l_v_control = m_ffGain*m_RefRps - m_ffOffset;
         }
+        m_controllerOutput = l_v_control;
+        updateLimits();
+        m_u = converter(l_v_control);
+        m_nrHighPwm = 0;
+        m_error = 0.0f;
         return 1;
     }
 
+    /**
+     * @brief Switch between the closed-loop and the open-loop control. The controller is cleared, so the closed loop restarts without the 
+     * integrated error of the open-loop period.
+     * 
+     * @param f_openLoop The encoder isn't healthy, the pwm is given by the feed-forward
+     */
+    void CMotorController::setOpenLoop(bool f_openLoop)
+    {
+        if(f_openLoop != m_openLoop){
+            m_pid.clear();
+            m_openLoop = f_openLoop;
+        }
+    }
+
+    /** @brief  Apply the limits of the current reference and feed back the saturation to the speed controller.
+     *
+     * @param f_current            Output of the speed controller
+     * @return                     Limited current reference
+     */
+    CONTROL_RAMFUNC float CMotorController::currentLimit(float f_current)
+    {
+        float l_maxCurrent = m_derating*m_maxCurrent;
+        if(f_current > l_maxCurrent){
+            m_pid.setSaturation(1);
+            ++m_nrHighPwm;
+            return l_maxCurrent;
+        } else if(f_current < -l_maxCurrent){
+            m_pid.setSaturation(-1);
+            ++m_nrHighPwm;
+            return -l_maxCurrent;
+        }
+        m_pid.setSaturation(0);
+        m_nrHighPwm = 0;
+        return f_current;
+    }
+
+    /** @brief  Disarm the inner current loop, when it's attached.
+     *
+     */
+    void CMotorController::disarmCurrentController()
+    {
+        if(m_currentController != NULL){
+            m_currentController->disarm();
+        }
+    }
+
+    /** @brief  Update the limits of the pwm and of the current reference by the derating factor of the thermal model.
+     */
+    CONTROL_RAMFUNC void CMotorController::updateLimits()
+    {
+        if(m_thermalModel == NULL){
+            return;
+        }
+        m_derating = m_thermalModel->getDerating();
+        m_control_sup = m_derating*m_maxPwm;
+        m_control_inf = -m_derating*m_maxPwm;
+    }
+
+    /** @brief  Attach the thermal model of the motor. The limits of the pwm and of the current reference are multiplied with its 
+     * derating factor in each control step, so the full range is available for the cold motor.
+     *
+     * @param f_thermal            Pointer to the thermal model, NULL to restore the static limits
+     * @param f_maxPwm             Absolute limit of the pwm of the cold motor
+     */
+    void CMotorController::setThermalModel(signal::systemmodels::CMotorThermalModel* f_thermal, float f_maxPwm)
+    {
+        m_thermalModel = f_thermal;
+        m_derating = 1.0f;
+        if(f_thermal == NULL){
+            f_maxPwm = 0.5f;
+        }
+        m_maxPwm = f_maxPwm;
+        m_control_sup = f_maxPwm;
+        m_control_inf = -f_maxPwm;
+    }
+
+    /** @brief  Attach the relay autotuner.
+     *
+     * @param f_autotuner          Pointer to the autotuner, NULL to detach it
+     */
+    void CMotorController::setAutotuner(CRelayAutotuner* f_autotuner)
+    {
+        if(m_autotuner != NULL){
+            m_autotuner->stop();
+        }
+        m_autotuner = f_autotuner;
+    }
+
+    /** @brief  Start the autotuning, the relay oscillates around the last output of the controller, so the motor has to run 
+     * with the reference speed of the operating point.
+     *
+     * @param f_amplitude          Amplitude of the relay in the unit of the controller output (V or A)
+     * @param f_hysteresis         Hysteresis of the relay (rps)
+     * @return                     false, when the autotuner isn't attached or the position control is active
+     */
+    bool CMotorController::startAutotune(float f_amplitude, float f_hysteresis)
+    {
+        if(m_autotuner == NULL || m_positionActive){
+            return false;
+        }
+        m_autotuner->start(m_controllerOutput, f_amplitude, f_hysteresis);
+        return true;
+    }
+
+    /** @brief  Abort a running autotuning, when the controller is deactivated.
+     *
+     */
+    void CMotorController::stopAutotune()
+    {
+        if(m_autotuner != NULL && m_autotuner->getState() == CRelayAutotuner::RUNNING){
+            m_autotuner->stop();
+        }
+    }
+
+    /** @brief  State of the autotuning, IDLE without autotuner.
+     *
+     */
+    CRelayAutotuner::EState CMotorController::getAutotuneState()
+    {
+        return (m_autotuner != NULL) ? m_autotuner->getState() : CRelayAutotuner::IDLE;
+    }
+
+    /** @brief  Result of the last finished autotuning, the autotuner has to be attached.
+     *
+     */
+    const CRelayAutotuner::SResult& CMotorController::getAutotuneResult()
+    {
+        return m_autotuner->getResult();
+    }
+
+    /** @brief  Attach the reference experiment.
+     *
+     * @param f_experiment         Pointer to the experiment, NULL to detach it
+     */
+    void CMotorController::setExperiment(CStepExperiment* f_experiment)
+    {
+        if(m_experiment != NULL){
+            m_experiment->stop();
+        }
+        m_experiment = f_experiment;
+    }
+
+    /** @brief  Start a step experiment, the reference alternates between the base and the base plus the amplitude.
+     *
+     * @param f_base               Base of the reference (rps)
+     * @param f_amplitude          Amplitude of the steps (rps)
+     * @param f_duration           Duration of each level (s)
+     * @param f_count              Number of the scored steps
+     * @return                     false, when the experiment isn't attached, the position control or the autotuning is active, or the levels are out of the range
+     */
+    bool CMotorController::startStepExperiment(float f_base, float f_amplitude, float f_duration, uint16_t f_count)
+    {
+        if(m_experiment == NULL || m_positionActive || getAutotuneState() == CRelayAutotuner::RUNNING 
+           || !inRange(f_base) || !inRange(f_base + f_amplitude)){
+            return false;
+        }
+        return m_experiment->startSteps(f_base, f_amplitude, f_duration, f_count);
+    }
+
+    /** @brief  Start a sweep experiment, the sine around the base sweeps linearly between the frequencies.
+     *
+     * @param f_base               Base of the reference (rps)
+     * @param f_amplitude          Amplitude of the sine (rps)
+     * @param f_duration           Duration of the sweep (s)
+     * @param f_startFrequency     Start frequency (Hz)
+     * @param f_endFrequency       End frequency (Hz)
+     * @return                     false, when the experiment isn't attached, the position control or the autotuning is active, or the levels are out of the range
+     */
+    bool CMotorController::startSweepExperiment(float f_base, float f_amplitude, float f_duration, float f_startFrequency, float f_endFrequency)
+    {
+        if(m_experiment == NULL || m_positionActive || getAutotuneState() == CRelayAutotuner::RUNNING 
+           || !inRange(f_base - std::abs(f_amplitude)) || !inRange(f_base + std::abs(f_amplitude))){
+            return false;
+        }
+        return m_experiment->startSweep(f_base, f_amplitude, f_duration, f_startFrequency, f_endFrequency);
+    }
+
+    /** @brief  Abort a running experiment, when the controller is deactivated or a new command arrives.
+     *
+     */
+    void CMotorController::stopExperiment()
+    {
+        if(m_experiment != NULL){
+            m_experiment->stop();
+        }
+    }
+
+    /** @brief  State of the experiment, IDLE without experiment.
+     *
+     */
+    CStepExperiment::EState CMotorController::getExperimentState()
+    {
+        return (m_experiment != NULL) ? m_experiment->getState() : CStepExperiment::IDLE;
+    }
+
+    /** @brief  Result of the last finished experiment, the experiment has to be attached.
+     *
+     */
+    const CStepExperiment::SResult& CMotorController::getExperimentResult()
+    {
+        return m_experiment->getResult();
+    }
+
+    /** @brief  Attach the inner current loop, the output of the speed controller becomes the current reference.
+     *
+     * @param f_current            Pointer to the current controller, NULL to detach it
+     * @param f_maxCurrent         Absolute limit of the current reference (A)
+     */
+    void CMotorController::setCurrentController(CCurrentController* f_current, float f_maxCurrent)
+    {
+        disarmCurrentController();
+        m_currentController = f_current;
+        m_maxCurrent = f_maxCurrent;
+        m_pid.clear();
+    }
+
+    /** @brief  Attach the outer position loop.
+     *
+     * @param f_pid                Pointer to the position controller, its input is the error in rotation and its output is the reference speed (rps)
+     * @param f_resolution         Resolution of the encoder (impulses per rotation)
+     * @param f_divider            Number of the periods per position controller step
+     * @param f_tolerance          Position error, below which the target is reached (rotation)
+     */
+    void CMotorController::setPositionController(ControllerType<float>* f_pid, float f_resolution, uint32_t f_divider, float f_tolerance)
+    {
+        stopPositionControl();
+        m_positionPid = f_pid;
+        m_resolution = f_resolution;
+        m_positionDivider = f_divider > 0 ? f_divider : 1;
+        m_positionTolerance = f_tolerance;
+    }
+
+    /** @brief  Start the position control to move the given distance from the current position.
+     *
+     * @param f_rotations          Distance in rotation of the motor, the sign gives the direction
+     * @param f_maxRps             Absolute limit of the reference speed (rps)
+     * @return                     false, when the position controller isn't attached or the speed limit is out of the range
+     */
+    bool CMotorController::setPositionTarget(float f_rotations, float f_maxRps)
+    {
+        if(m_positionPid == NULL || !inRange(f_maxRps) || !inRange(-f_maxRps)){
+            return false;
+        }
+        m_positionPid->clear();
+        m_position = 0;
+        m_positionTarget = f_rotations * m_resolution;
+        m_maxPositionRps = std::abs(f_maxRps);
+        m_positionTick = m_positionDivider;
+        m_positionActive = true;
+        return true;
+    }
+
+    /** @brief  Stop the position control, the reference speed is set again by setRef.
+     *
+     */
+    void CMotorController::stopPositionControl()
+    {
+        m_positionActive = false;
+        m_RefRps = 0.0f;
+    }
+
+    /** @brief  Position error in rotation, the target minus the position moved since the start.
+     *
+     */
+    float CMotorController::getPositionError()
+    {
+        return (m_positionTarget - static_cast<float>(m_position)) / m_resolution;
+    }
+
+    /** @brief  The position control is active and the position error is below the tolerance.
+     *
+     */
+    bool CMotorController::isPositionReached()
+    {
+        return m_positionActive && std::abs(getPositionError()) < m_positionTolerance;
+    }
+
+    /** @brief  Set the parameters of the static feed-forward term, which is added to the output of the controller.
+     *
+     * @param f_gain               Gain from the reference (V/rps)
+     * @param f_offset             Offset by the sign of the reference (V)
+     */
+    void CMotorController::setFeedForward(float f_gain, float f_offset)
+    {
+        m_ffGain = f_gain;
+        m_ffOffset = f_offset;
+    }
+
+    /** @brief  Serial callback method for setting the feed-forward parameters. The first string has to contains the parameters
+     * (in order gain, offset).
+     *
+     * @param a                    string to read data from
+     * @param b                    string to write data to
+     */
+    void CMotorController::serialCallbackFeedForward(char const * a, char * b)
+    {
+        float l_values[2];
+        uint32_t l_res = utils::fmt::parseFloats(a,l_values,2);
+        if (2 == l_res)
+        {
+            setFeedForward(l_values[0],l_values[1]);
+            utils::fmt::CWriter(b).text("ack;;").fixed(l_values[0],5).fixed(l_values[1],5);
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** @brief  Apply the feed-forward and the speed controller parameters of a first order model (K/(T*s+1) with friction voltage).
+     *
+     * The feed-forward inverts the static model (gain 1/K, offset by the friction). The proportional-integral parameters are
+     * calculated by the internal model control rules for the given closed-loop time constant (kp = T/(K*Tc), ki = 1/(K*Tc)), they
+     * are applied to the operating point of the scheduled controller, which is the nearest to the current reference speed.
+     *
+     * @param f_model              first order model of the drive
+     * @param f_closedLoopTime     time constant of the closed loop (s)
+     * @return                     false, when the model or the time constant is invalid
+     */
+    bool CMotorController::applyModel(const signal::systemmodels::CMotorIdentifier::SModel& f_model, float f_closedLoopTime)
+    {
+        if(f_model.m_gain <= 0.0f || f_model.m_timeConstant <= 0.0f || f_closedLoopTime <= 0.0f){
+            return false;
+        }
+        float l_ki = 1.0f / (f_model.m_gain * f_closedLoopTime);
+        if(!m_pid.setParameters(f_model.m_timeConstant * l_ki, l_ki, 0.0f, f_closedLoopTime)){
+            return false;
+        }
+        setFeedForward(1.0f / f_model.m_gain, f_model.m_offset);
+        return true;
+    }
+
+    /** @brief  Serial callback method for applying the identified model. The first string has to contain the closed-loop time constant
+     * (s), the response contains the applied proportional and integral factors and the feed-forward parameters.
+     *
+     * @param a                    string to read data from
+     * @param b                    string to write data to
+     */
+    void CMotorController::serialCallbackIdentified(char const * a, char * b)
+    {
+        float l_closedLoopTime;
+        if(1 != utils::fmt::parseFloats(a,&l_closedLoopTime,1)){
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        signal::systemmodels::CMotorIdentifier::SModel l_model;
+        if(m_identifier == NULL || !m_identifier->getModel(l_model)){
+            sprintf(b,"model not identified;;");
+            return;
+        }
+        if(!applyModel(l_model, l_closedLoopTime)){
+            sprintf(b,"invalid parameters;;");
+            return;
+        }
+        float l_ki = 1.0f / (l_model.m_gain * l_closedLoopTime);
+        utils::fmt::CWriter(b).text("ack;;").fixed(l_model.m_timeConstant * l_ki,5).fixed(l_ki,5).fixed(m_ffGain,5).fixed(m_ffOffset,5);
+    }
+
     /** @brief  
      *
      * Apply the converter interface to change the measurment unit.
@@ -168,9 +681,9 @@ namespace controllers{
      * @param f_u                  Input control signal
      * @return                     Converted control signal
      */
-    double CMotorController::converter(double f_u)
+    CONTROL_RAMFUNC float CMotorController::converter(float f_u)
     {
-        double l_pwm=f_u;
+        float l_pwm=f_u;
         // Convert the control signal from V to PWM
         if(m_converter!=NULL){
             l_pwm = (*m_converter)(f_u);
@@ -198,7 +711,7 @@ namespace controllers{
      * @return true means, that the value is in the range
      * @return false means, that the value isn't in the range
      */
-    bool CMotorController::inRange(double f_RefRps){
+    bool CMotorController::inRange(float f_RefRps){
         return m_inf_ref<=f_RefRps && f_RefRps<=m_sup_ref;
     }
 
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *   
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Profiler.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the setpoint profile
+  *          generator.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/profiler.hpp>
+
+namespace signal{
+namespace controllers{
+    /**
+     * @brief Construct a new CSetpointProfiler::CSetpointProfiler object
+     * 
+     * @param f_dt          Sampling time (s)
+     * @param f_maxRate     [Optional] Maximum rate of the output (unit/s), zero without limit
+     * @param f_maxJerk     [Optional] Maximum jerk of the output (unit/s^2), zero without limit
+     */
+    CSetpointProfiler::CSetpointProfiler(float f_dt, float f_maxRate, float f_maxJerk)
+        :m_dt(f_dt)
+        ,m_maxRate(0.0f)
+        ,m_maxJerk(0.0f)
+        ,m_target(0.0f)
+        ,m_value(0.0f)
+        ,m_rate(0.0f)
+        ,m_rateCap(0.0f)
+    {
+        setLimits(f_maxRate, f_maxJerk);
+    }
+
+    /**
+     * @brief Set the limits of the profile, the negative values are handled as absolute values.
+     * 
+     * @param f_maxRate     Maximum rate of the output (unit/s), zero without limit
+     * @param f_maxJerk     Maximum jerk of the output (unit/s^2), zero without limit
+     */
+    void CSetpointProfiler::setLimits(float f_maxRate, float f_maxJerk)
+    {
+        m_maxRate = std::abs(f_maxRate);
+        m_maxJerk = std::abs(f_maxJerk);
+        if(m_maxRate == 0.0f){
+            m_rate = 0.0f;
+        }
+    }
+
+    /**
+     * @brief Set the cap of the rate, the smaller one of the limit and of the cap is applied, so an other owner (e.g. the energy 
+     * governor) can reduce the rate without changing the limit of the user. The rate above the new cap is ramped down by the jerk limit.
+     * 
+     * @param f_rateCap     Cap of the rate (unit/s), zero without cap
+     */
+    void CSetpointProfiler::setRateCap(float f_rateCap)
+    {
+        m_rateCap = std::abs(f_rateCap);
+    }
+
+    /**
+     * @brief Set the target, the output approaches it by the following steps.
+     * 
+     * @param f_target      New target
+     */
+    void CSetpointProfiler::setTarget(float f_target)
+    {
+        m_target = f_target;
+    }
+
+    /**
+     * @brief Set the output and the target to the value, the rate is cleared (e.g. for braking).
+     * 
+     * @param f_value       New output
+     */
+    void CSetpointProfiler::reset(float f_value)
+    {
+        m_target = f_value;
+        m_value = f_value;
+        m_rate = 0.0f;
+    }
+
+    /**
+     * @brief Apply one step of the profile.
+     * 
+     * With jerk limit the rate is accelerated towards the maximum rate, while the output reached by ramping down the rate 
+     * (v + r*|r|/(2*j)) stays before the target, otherwise the rate is decelerated. 
+     * 
+     * @return float        The new output
+     */
+    float CSetpointProfiler::step()
+    {
+        float l_error = m_target - m_value;
+        // The cap reduces the limit of the user, without limit the cap is the limit
+        float l_maxRate = (m_rateCap > 0.0f && (m_maxRate == 0.0f || m_rateCap < m_maxRate)) ? m_rateCap : m_maxRate;
+        if(l_maxRate == 0.0f){
+            m_value = m_target;
+            return m_value;
+        }
+        float l_maxStep = l_maxRate * m_dt;
+        if(m_maxJerk == 0.0f){
+            // Trapezoidal profile
+            if(l_error > l_maxStep){
+                m_rate = l_maxRate;
+            } else if(l_error < -l_maxStep){
+                m_rate = -l_maxRate;
+            } else{
+                m_rate = 0.0f;
+                m_value = m_target;
+                return m_value;
+            }
+            m_value += m_rate * m_dt;
+            return m_value;
+        }
+        // S-curve profile
+        float l_rateStep = m_maxJerk * m_dt;
+        if(std::abs(l_error) <= std::abs(m_rate) * m_dt && std::abs(m_rate) <= l_rateStep){
+            // The target is reached in this step
+            m_rate = 0.0f;
+            m_value = m_target;
+            return m_value;
+        }
+        // Distance covered, while the rate is ramped down to zero
+        float l_stopError = l_error - m_rate * std::abs(m_rate) / (2.0f * m_maxJerk);
+        float l_rateTarget;
+        if(l_stopError > std::abs(m_rate) * m_dt){
+            l_rateTarget = l_maxRate;
+        } else if(l_stopError < -std::abs(m_rate) * m_dt){
+            l_rateTarget = -l_maxRate;
+        } else{
+            l_rateTarget = 0.0f;
+        }
+        if(l_rateTarget > m_rate + l_rateStep){
+            m_rate += l_rateStep;
+        } else if(l_rateTarget < m_rate - l_rateStep){
+            m_rate -= l_rateStep;
+        } else{
+            m_rate = l_rateTarget;
+        }
+        m_value += m_rate * m_dt;
+        return m_value;
+    }
+}; // namespace controllers
+}; // namespace signal
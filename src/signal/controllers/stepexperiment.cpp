@@ -0,0 +1,285 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    StepExperiment.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the scripted reference
+  *          experiments with the control-quality metrics.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/stepexperiment.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace signal{
+namespace controllers{
+
+    const float CStepExperiment::s_settlingBand = 0.02f;
+
+    /**
+     * @brief Construct a new CStepExperiment::CStepExperiment object
+     * 
+     * @param f_dt          Sampling time (s)
+     */
+    CStepExperiment::CStepExperiment(float f_dt)
+        :m_dt(f_dt)
+        ,m_mode(STEPS)
+        ,m_base(0.0f)
+        ,m_amplitude(0.0f)
+        ,m_segmentTicks(1)
+        ,m_leadTicks(1)
+        ,m_segments(0)
+        ,m_segment(0)
+        ,m_tick(0)
+        ,m_to(0.0f)
+        ,m_from(0.0f)
+        ,m_tick10(0)
+        ,m_tick90(0)
+        ,m_peak(0.0f)
+        ,m_settledTick(0)
+        ,m_steadySum(0.0f)
+        ,m_frequency(0.0f)
+        ,m_chirp(0.0f)
+        ,m_phase(0.0f)
+        ,m_riseSum(0.0f)
+        ,m_steadyAbsSum(0.0f)
+        ,m_risen(0)
+        ,m_state(IDLE)
+        ,m_result()
+    {
+    }
+
+    /**
+     * @brief Start a step experiment, the reference alternates between the base and the base plus the amplitude after the lead-in.
+     * 
+     * @param f_base        Base of the reference (rps)
+     * @param f_amplitude   Amplitude of the steps (rps), the sign gives the direction of the first step
+     * @param f_duration    Duration of each level (s), also the duration of the lead-in
+     * @param f_count       Number of the scored steps
+     * @return              false, when the script is empty
+     */
+    bool CStepExperiment::startSteps(float f_base, float f_amplitude, float f_duration, uint16_t f_count)
+    {
+        uint32_t l_ticks = static_cast<uint32_t>(f_duration / m_dt + 0.5f);
+        if (0.0f == f_amplitude || l_ticks < 4 || 0 == f_count)
+        {
+            return false;
+        }
+        m_mode = STEPS;
+        m_segmentTicks = l_ticks;
+        m_leadTicks = l_ticks;
+        m_segments = f_count;
+        m_base = f_base;
+        m_amplitude = f_amplitude;
+        m_frequency = 0.0f;
+        m_chirp = 0.0f;
+        m_segment = 0;
+        m_riseSum = 0.0f;
+        m_steadyAbsSum = 0.0f;
+        m_risen = 0;
+        m_result = SResult();
+        m_to = f_base;
+        beginSegment(f_base);
+        m_state = RUNNING;
+        return true;
+    }
+
+    /**
+     * @brief Start a sweep experiment, the sine around the base sweeps linearly from the start to the end frequency after a lead-in of 
+     * the quarter of the duration.
+     * 
+     * @param f_base            Base of the reference (rps)
+     * @param f_amplitude       Amplitude of the sine (rps)
+     * @param f_duration        Duration of the sweep (s)
+     * @param f_startFrequency  Start frequency (Hz)
+     * @param f_endFrequency    End frequency (Hz), below the half of the sampling rate
+     * @return                  false, when the script is empty or the frequencies are out of range
+     */
+    bool CStepExperiment::startSweep(float f_base, float f_amplitude, float f_duration, float f_startFrequency, float f_endFrequency)
+    {
+        uint32_t l_ticks = static_cast<uint32_t>(f_duration / m_dt + 0.5f);
+        float l_nyquist = 0.5f / m_dt;
+        if (0.0f == f_amplitude || l_ticks < 4 || f_startFrequency < 0.0f || f_endFrequency < 0.0f 
+            || f_startFrequency >= l_nyquist || f_endFrequency >= l_nyquist)
+        {
+            return false;
+        }
+        m_mode = SWEEP;
+        m_segmentTicks = l_ticks;
+        m_leadTicks = l_ticks / 4;
+        m_segments = 1;
+        m_base = f_base;
+        m_amplitude = f_amplitude;
+        m_frequency = f_startFrequency;
+        m_chirp = (f_endFrequency - f_startFrequency) / (l_ticks * m_dt);
+        m_segment = 0;
+        m_riseSum = 0.0f;
+        m_steadyAbsSum = 0.0f;
+        m_risen = 0;
+        m_result = SResult();
+        m_to = f_base;
+        beginSegment(f_base);
+        m_state = RUNNING;
+        return true;
+    }
+
+    /**
+     * @brief Abort the experiment, it's marked as failed, the partial metrics are kept.
+     * 
+     */
+    void CStepExperiment::stop()
+    {
+        if (RUNNING == m_state)
+        {
+            m_state = FAILED;
+        }
+    }
+
+    /**
+     * @brief Apply one control step: it gives the reference of the step and it accumulates the metrics by the measured value. The 
+     * segment is changed after its last period, the new level is applied from the next step.
+     * 
+     * @param f_measured    Measured value of the step (rps)
+     * @return              Reference of the step (rps), the base after the end
+     */
+    CONTROL_RAMFUNC float CStepExperiment::step(float f_measured)
+    {
+        if (RUNNING != m_state)
+        {
+            return m_base;
+        }
+        ++m_tick;
+        float l_ref = m_to;
+        if (m_segment > 0)
+        {
+            if (SWEEP == m_mode)
+            {
+                l_ref = m_base + m_amplitude * sinf(m_phase);
+                m_phase += 6.28318531f * (m_frequency + m_chirp * m_tick * m_dt) * m_dt;
+                if (m_phase > 6.28318531f)
+                {
+                    m_phase -= 6.28318531f;
+                }
+            }
+            float l_error = l_ref - f_measured;
+            m_result.m_iae += std::abs(l_error) * m_dt;
+            m_result.m_ise += l_error * l_error * m_dt;
+            if (STEPS == m_mode)
+            {
+                float l_progress = (f_measured - m_from) / (m_to - m_from);
+                if (0 == m_tick10 && l_progress >= 0.1f)
+                {
+                    m_tick10 = m_tick;
+                }
+                if (0 == m_tick90 && l_progress >= 0.9f)
+                {
+                    m_tick90 = m_tick;
+                }
+                if (l_progress > m_peak)
+                {
+                    m_peak = l_progress;
+                }
+                if (std::abs(l_progress - 1.0f) > s_settlingBand)
+                {
+                    m_settledTick = m_tick;
+                }
+                if (4 * m_tick > 3 * m_segmentTicks)
+                {
+                    m_steadySum += l_error;
+                }
+            }
+        }
+        if (m_tick >= ((m_segment > 0) ? m_segmentTicks : m_leadTicks))
+        {
+            if (m_segment > 0 && STEPS == m_mode)
+            {
+                endSegment();
+            }
+            if (m_segment >= m_segments)
+            {
+                finish();
+            }
+            else
+            {
+                ++m_segment;
+                beginSegment((STEPS == m_mode && (m_segment & 1)) ? m_base + m_amplitude : m_base);
+            }
+        }
+        return l_ref;
+    }
+
+    /**
+     * @brief Start the segment of a new level, the previous level is the start of the step.
+     * 
+     * @param f_reference   Level of the segment
+     */
+    void CStepExperiment::beginSegment(float f_reference)
+    {
+        m_from = m_to;
+        m_to = f_reference;
+        m_tick = 0;
+        m_tick10 = 0;
+        m_tick90 = 0;
+        m_peak = 0.0f;
+        m_settledTick = 0;
+        m_steadySum = 0.0f;
+        m_phase = 0.0f;
+    }
+
+    /**
+     * @brief Score the finished step segment, the step isn't settled, when its last sample is outside of the band.
+     * 
+     */
+    void CStepExperiment::endSegment()
+    {
+        ++m_result.m_steps;
+        if (m_tick10 > 0 && m_tick90 > 0)
+        {
+            m_riseSum += (m_tick90 - m_tick10) * m_dt;
+            ++m_risen;
+        }
+        float l_overshoot = (m_peak - 1.0f) * 100.0f;
+        if (l_overshoot > m_result.m_overshoot)
+        {
+            m_result.m_overshoot = l_overshoot;
+        }
+        if (m_settledTick >= m_segmentTicks)
+        {
+            ++m_result.m_unsettled;
+        }
+        else if (m_settledTick * m_dt > m_result.m_settling)
+        {
+            m_result.m_settling = m_settledTick * m_dt;
+        }
+        uint32_t l_steadyTicks = m_segmentTicks - (3 * m_segmentTicks) / 4;
+        m_steadyAbsSum += std::abs(m_steadySum) / l_steadyTicks;
+    }
+
+    /**
+     * @brief Finish the experiment, the means are calculated by the sums of the steps.
+     * 
+     */
+    void CStepExperiment::finish()
+    {
+        m_result.m_riseTime = (m_risen > 0) ? m_riseSum / m_risen : 0.0f;
+        m_result.m_steadyError = (m_result.m_steps > 0) ? m_steadyAbsSum / m_result.m_steps : 0.0f;
+        m_to = m_base;
+        m_state = FINISHED;
+    }
+}; // namespace controllers
+}; // namespace signal
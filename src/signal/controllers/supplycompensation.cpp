@@ -0,0 +1,126 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    SupplyCompensation.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the compensation of
+  *          the supply voltage in the volt to pwm conversion.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/supplycompensation.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+#include <math.h>
+
+namespace signal
+{
+namespace controllers
+{
+    /** @brief  CSupplyCompensation class constructor, the filter starts from the nominal voltage.
+     *
+     *  @param f_period        period of the pipeline in second
+     *  @param f_source        calibrated converter at the nominal supply voltage
+     *  @param f_nominal       supply voltage of the calibration (V)
+     *  @param f_minValid      below this measured voltage the compensation isn't applied (V)
+     *  @param f_timeConstant  time constant of the low-pass filter of the measured voltage (s)
+     */
+    CSupplyCompensation::CSupplyCompensation(float           f_period
+                                            ,IConverter&     f_source
+                                            ,float           f_nominal
+                                            ,float           f_minValid
+                                            ,float           f_timeConstant)
+        : m_source(f_source)
+        , m_input()
+        , m_nominal(f_nominal)
+        , m_minValid(f_minValid)
+        , m_alpha(1.0f - expf(-f_period / f_timeConstant))
+        , m_voltage(f_nominal)
+        , m_scale(1.0f)
+        , m_enabled(true)
+    {
+    }
+
+    /** @brief  Set the getter of the supply voltage, without getter the calibrated converter is applied.
+     *
+     *  @param f_voltage       getter of the supply voltage (V)
+     */
+    void CSupplyCompensation::setInput(FVoltageGetter f_voltage)
+    {
+        m_input = f_voltage;
+    }
+
+    /** @brief  It filters the measured supply voltage and it updates the scale of the pwm.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CSupplyCompensation::process(uint32_t)
+    {
+        if(!m_input){
+            return;
+        }
+        m_voltage += m_alpha * (m_input() - m_voltage);
+        float l_scale = 1.0f;
+        if(m_enabled && m_voltage > m_minValid){
+            l_scale = m_nominal / m_voltage;
+            if(l_scale > s_maxScale){
+                l_scale = s_maxScale;
+            }
+        }
+        m_scale = l_scale;
+    }
+
+    /** @brief  Convert the control voltage by the calibrated converter and scale the pwm by the supply voltage.
+     *
+     *  @param f_voltage       control voltage (V)
+     *  @return                pwm
+     */
+    CONTROL_RAMFUNC float CSupplyCompensation::operator()(float f_voltage)
+    {
+        return m_source(f_voltage) * m_scale;
+    }
+
+    /** @brief  Enable or disable the compensation, the disabled compensation applies the calibrated converter.
+     *
+     *  @param f_enabled       true - scaled by the supply voltage, false - calibrated converter
+     */
+    void CSupplyCompensation::setEnabled(bool f_enabled)
+    {
+        m_enabled = f_enabled;
+        if(!f_enabled){
+            m_scale = 1.0f;
+        }
+    }
+
+    /** @brief  Serial callback of the compensation. The optional parameter enables (1) or disables (0) the compensation, the response
+     * contains the filtered supply voltage (V), the applied scale and the state.
+     *
+     *  @param a               string to read data from
+     *  @param b               string to write data to
+     */
+    void CSupplyCompensation::serialCallback(char const * a, char * b)
+    {
+        float l_value;
+        if(1 == utils::fmt::parseFloats(a,&l_value,1)){
+            setEnabled(0.0f != l_value);
+        }
+        utils::fmt::CWriter(b).fixed(m_voltage,3).fixed(m_scale,4).dec(m_enabled ? 1 : 0).chr(';');
+    }
+
+}; // namespace controllers
+}; // namespace signal
@@ -0,0 +1,253 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *   
+  ******************************************************************************
+  * @file    TractionControl.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the traction control
+  *          of the motor command.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/tractioncontrol.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+#include <math.h>
+
+namespace signal{
+namespace controllers{
+    /**
+     * @brief Construct a new CTractionControl::CTractionControl object, the pwm reduction is initially activated.
+     * 
+     * @param f_period              Period of the estimation (control loop) in second.
+     * @param f_encoder             Reference to the speed feedback of the wheels (motor rotation per second).
+     * @param f_motor               Reference to the motor driver.
+     * @param f_meterPerRotation    Travelled distance of a motor rotation in meter.
+     * @param f_maxAcceleration     Acceleration limit of the grip in meter per square second.
+     * @param f_threshold           [Optional] Slip ratio of the detection.
+     */
+    CTractionControl::CTractionControl(float                                 f_period
+                                      ,hardware::encoders::IEncoderGetter&   f_encoder
+                                      ,hardware::drivers::IMotorCommand&     f_motor
+                                      ,float                                 f_meterPerRotation
+                                      ,float                                 f_maxAcceleration
+                                      ,float                                 f_threshold)
+        : m_encoder(f_encoder)
+        , m_motor(f_motor)
+        , m_dt(f_period)
+        , m_meterPerRotation(f_meterPerRotation)
+        , m_maxAcceleration(f_maxAcceleration)
+        , m_threshold(f_threshold)
+        , m_acceleration()
+        , m_bodySpeed(0.0f)
+        , m_slip(0.0f)
+        , m_gain(1.0f)
+        , m_events(0)
+        , m_isSlipping(false)
+        , m_isActive(true)
+    {
+    }
+
+    /**
+     * @brief Pipeline stage, it estimates the body speed and the slip ratio, then it updates the gain of the pwm. It has to be applied 
+     * before the controllers of the tick, so the reduction is applied by the commands of the same tick.
+     * 
+     * @param f_timestamp           Timestamp of the tick in microsecond.
+     */
+    CONTROL_RAMFUNC void CTractionControl::process(uint32_t f_timestamp)
+    {
+        float l_wheelSpeed = m_encoder.getSpeedRps() * m_meterPerRotation;
+        float l_target = m_acceleration ? (m_bodySpeed + m_acceleration() * m_dt) : l_wheelSpeed;
+        if (!m_isSlipping)
+        {
+            l_target += s_correction * (l_wheelSpeed - l_target);
+        }
+        float l_step = l_target - m_bodySpeed;
+        float l_maxStep = m_maxAcceleration * m_dt;
+        l_step = (l_step > l_maxStep) ? l_maxStep : ((l_step < -l_maxStep) ? -l_maxStep : l_step);
+        m_bodySpeed += l_step;
+
+        float l_excess = (l_wheelSpeed >= 0.0f) ? (l_wheelSpeed - m_bodySpeed) : (m_bodySpeed - l_wheelSpeed);
+        float l_reference = fabsf(m_bodySpeed);
+        float l_slip = l_excess / ((l_reference > s_minSpeed) ? l_reference : s_minSpeed);
+        m_slip = l_slip;
+        bool l_isSlipping = l_slip > m_threshold;
+        if (l_isSlipping && !m_isSlipping)
+        {
+            m_events = m_events + 1;
+        }
+        m_isSlipping = l_isSlipping;
+
+        float l_gain = m_gain;
+        if (l_isSlipping)
+        {
+            l_gain *= m_threshold / l_slip;
+            l_gain = (l_gain > s_minGain) ? l_gain : s_minGain;
+        }
+        else
+        {
+            l_gain += s_recovery * m_dt;
+            l_gain = (l_gain < 1.0f) ? l_gain : 1.0f;
+        }
+        m_gain = l_gain;
+    }
+
+    /**
+     * @brief Set the pwm of the motor, it's multiplied with the gain of the traction control, when the reduction is activated.
+     * 
+     * @param f_pwm                 Duty cycle with the sign of the direction.
+     */
+    CONTROL_RAMFUNC void CTractionControl::setSpeed(float f_pwm)
+    {
+        m_motor.setSpeed(m_isActive ? f_pwm * m_gain : f_pwm);
+    }
+
+    /**
+     * @brief Brake the motor, it's forwarded without change.
+     */
+    void CTractionControl::brake()
+    {
+        m_motor.brake();
+    }
+
+    /**
+     * @brief Inverse direction braking, it's forwarded without change.
+     * 
+     * @param f_pwm                 Duty cycle of the inverse direction.
+     */
+    void CTractionControl::inverseDirection(float f_pwm)
+    {
+        m_motor.inverseDirection(f_pwm);
+    }
+
+    /**
+     * @brief Coast the motor, it's forwarded without change.
+     */
+    void CTractionControl::coast()
+    {
+        m_motor.coast();
+    }
+
+    /**
+     * @brief Proportional dynamic braking, it's forwarded without change.
+     * 
+     * @param f_duty                Duty cycle of the braking.
+     */
+    void CTractionControl::dynamicBrake(float f_duty)
+    {
+        m_motor.dynamicBrake(f_duty);
+    }
+
+    /**
+     * @brief Check the range of the pwm by the motor driver.
+     * 
+     * @param f_pwm                 Duty cycle.
+     * @return true                 The duty cycle is in the range of the driver.
+     */
+    bool CTractionControl::inRange(float f_pwm)
+    {
+        return m_motor.inRange(f_pwm);
+    }
+
+    /**
+     * @brief Attach the getter of the longitudinal acceleration, after it the body speed is integrated by the acceleration.
+     * 
+     * @param f_acceleration        Getter of the acceleration (m/s^2), it's applied from the control loop.
+     */
+    void CTractionControl::setAccelerationGetter(FAccelerationGetter f_acceleration)
+    {
+        core_util_critical_section_enter();
+        m_acceleration = f_acceleration;
+        core_util_critical_section_exit();
+    }
+
+    /**
+     * @brief Set the parameters of the slip detection.
+     * 
+     * @param f_threshold           Slip ratio of the detection.
+     * @param f_maxAcceleration     Acceleration limit of the grip in meter per square second.
+     * @return true                 The parameters are positive and they are applied.
+     */
+    bool CTractionControl::setParameters(float f_threshold, float f_maxAcceleration)
+    {
+        if (!(f_threshold > 0.0f && f_maxAcceleration > 0.0f))
+        {
+            return false;
+        }
+        core_util_critical_section_enter();
+        m_threshold = f_threshold;
+        m_maxAcceleration = f_maxAcceleration;
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /**
+     * @brief Serial callback method of the traction control
+     * 
+     * The first field is the index of the command:
+     *      - '0': status, it responses the activation, the gain of the pwm, the slip ratio and the number of the detected slips,
+     *      - '1;0|1': deactivate or activate the pwm reduction,
+     *      - '2;threshold;acceleration': set the slip ratio of the detection and the acceleration limit (m/s^2).
+     * 
+     * @param a                     Input received string.
+     * @param b                     Output reponse message.
+     */
+    void CTractionControl::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(m_isActive ? 1 : 0).fixed(m_gain,3).fixed(m_slip,3).udec(m_events).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_active;
+            if (utils::fmt::parseUint(l_text, l_active) && l_active <= 1)
+            {
+                m_isActive = (1 == l_active);
+                sprintf(b,"ack;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            float l_values[2];
+            if (2 != utils::fmt::parseFloats(l_text, l_values, 2))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else
+            {
+                sprintf(b, setParameters(l_values[0], l_values[1]) ? "ack;;" : "invalid parameters;;");
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace controllers
+}; // namespace signal
@@ -0,0 +1,218 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *   
+  ******************************************************************************
+  * @file    YawRateSteering.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the closed-loop
+  *          yaw rate control of the steering.
+  ******************************************************************************
+ */
+
+#include <signal/controllers/yawratesteering.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+#include <math.h>
+
+namespace signal{
+namespace controllers{
+    /**
+     * @brief Construct a new CYawRateSteering::CYawRateSteering object, it starts in the angle mode.
+     * 
+     * @param f_encoder             Reference to the speed feedback of the wheels (motor rotation per second).
+     * @param f_steering            Reference to the steering servo.
+     * @param f_controller          Reference to the controller of the yaw rate error (degree per second to degree).
+     * @param f_meterPerRotation    Travelled distance of a motor rotation in meter.
+     * @param f_geometry            Reference to the steering geometry of the vehicle.
+     * @param f_maxAngle            Limit of the steering angle in degree.
+     * @param f_maxRate             [Optional] Limit of the reference yaw rate in degree per second.
+     */
+    CYawRateSteering::CYawRateSteering(hardware::encoders::IEncoderGetter&     f_encoder
+                                      ,hardware::drivers::ISteeringCommand&    f_steering
+                                      ,siso::IController<float>&               f_controller
+                                      ,float                                   f_meterPerRotation
+                                      ,const systemmodels::CSteeringGeometry&  f_geometry
+                                      ,float                                   f_maxAngle
+                                      ,float                                   f_maxRate)
+        : m_encoder(f_encoder)
+        , m_steering(f_steering)
+        , m_controller(f_controller)
+        , m_meterPerRotation(f_meterPerRotation)
+        , m_geometry(f_geometry)
+        , m_maxAngle(f_maxAngle)
+        , m_maxRate(f_maxRate)
+        , m_rate()
+        , m_mode(MODE_ANGLE)
+        , m_clearRequest(false)
+        , m_isSteered(false)
+        , m_speed(0.0f)
+        , m_measured(0.0f)
+        , m_reference(0.0f)
+        , m_angle(0.0f)
+    {
+    }
+
+    /**
+     * @brief Pipeline stage, it takes the speed of the wheels and the yaw rate for the commands of the tick. The controller is cleared, 
+     * when it wasn't applied in the previous tick, so an old integral doesn't act at the next command.
+     * 
+     * @param f_timestamp           Timestamp of the tick in microsecond.
+     */
+    CONTROL_RAMFUNC void CYawRateSteering::process(uint32_t f_timestamp)
+    {
+        m_speed = m_encoder.getSpeedRps() * m_meterPerRotation;
+        m_measured = m_rate ? -m_rate() * 180.0f / static_cast<float>(M_PI) : 0.0f;
+        if (!m_isSteered || m_clearRequest)
+        {
+            m_controller.clear();
+            m_clearRequest = false;
+        }
+        m_isSteered = false;
+    }
+
+    /**
+     * @brief Set the steering command. In the angle mode it's forwarded to the servo, in the yaw rate mode the servo angle is the 
+     * feedforward of the reference yaw rate and the correction of the controller.
+     * 
+     * @param f_value               Steering angle in degree or yaw rate in degree per second, positive to right.
+     */
+    CONTROL_RAMFUNC void CYawRateSteering::setAngle(float f_value)
+    {
+        if (MODE_ANGLE == m_mode)
+        {
+            m_angle = f_value;
+            m_steering.setAngle(f_value);
+            return;
+        }
+        m_isSteered = true;
+        m_reference = f_value;
+        float l_speed = m_speed;
+        bool l_isMoving = fabsf(l_speed) >= s_minSpeed;
+        float l_feedSpeed = l_isMoving ? l_speed : ((l_speed < 0.0f) ? -s_minSpeed : s_minSpeed);
+        // Curvature of the reference yaw rate, positive to left
+        float l_angle = m_geometry.angle(-f_value * static_cast<float>(M_PI) / 180.0f / l_feedSpeed);
+        if (l_isMoving)
+        {
+            float l_correction = m_controller.calculateControl(f_value - m_measured);
+            l_angle += (l_speed > 0.0f) ? l_correction : -l_correction;
+        }
+        else
+        {
+            m_controller.clear();
+        }
+        int8_t l_saturation = 0;
+        if (l_angle > m_maxAngle)
+        {
+            l_angle = m_maxAngle;
+            l_saturation = (l_speed > 0.0f) ? 1 : -1;
+        }
+        else if (l_angle < -m_maxAngle)
+        {
+            l_angle = -m_maxAngle;
+            l_saturation = (l_speed > 0.0f) ? -1 : 1;
+        }
+        m_controller.setSaturation(l_saturation);
+        m_angle = l_angle;
+        m_steering.setAngle(l_angle);
+    }
+
+    /**
+     * @brief Check the range of the steering command, the servo limits the angles, the yaw rates are limited by the maximal rate.
+     * 
+     * @param f_value               Steering angle in degree or yaw rate in degree per second.
+     */
+    bool CYawRateSteering::inRange(float f_value)
+    {
+        if (MODE_ANGLE == m_mode)
+        {
+            return m_steering.inRange(f_value);
+        }
+        return fabsf(f_value) <= m_maxRate;
+    }
+
+    /**
+     * @brief Attach the getter of the yaw rate, after it the yaw rate mode can be selected.
+     * 
+     * @param f_rate                Getter of the yaw rate (rad/s, counter-clockwise), it's applied from the control loop.
+     */
+    void CYawRateSteering::setRateGetter(FRateGetter f_rate)
+    {
+        core_util_critical_section_enter();
+        m_rate = f_rate;
+        core_util_critical_section_exit();
+    }
+
+    /**
+     * @brief Change the mode of the steering commands. The meaning of the command changes, so the mode is changed only at standstill, 
+     * the controller is cleared at the next tick.
+     * 
+     * @param f_mode                New mode.
+     * @return true                 The mode is applied.
+     */
+    bool CYawRateSteering::setMode(EMode f_mode)
+    {
+        if ((MODE_YAW_RATE == f_mode && !m_rate) || fabsf(m_speed) >= s_minSpeed)
+        {
+            return false;
+        }
+        m_mode = f_mode;
+        m_clearRequest = true;
+        return true;
+    }
+
+    /**
+     * @brief Serial callback method of the yaw rate control
+     * 
+     * The first field is the index of the command:
+     *      - '0': status, it responses the mode, the reference and the measured yaw rate (deg/s) and the servo angle (deg),
+     *      - '1;0|1': select the angle or the yaw rate mode, it's accepted at standstill, the yaw rate mode needs the gyroscope.
+     * 
+     * @param a                     Input received string.
+     * @param b                     Output reponse message.
+     */
+    void CYawRateSteering::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(m_mode).fixed(m_reference,2).fixed(m_measured,2).fixed(m_angle,2).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_mode;
+            if (utils::fmt::parseUint(l_text, l_mode) && l_mode <= MODE_YAW_RATE)
+            {
+                sprintf(b, setMode(static_cast<EMode>(l_mode)) ? "ack;;" : "mode unavailable;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace controllers
+}; // namespace signal
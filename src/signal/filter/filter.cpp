@@ -25,3 +25,13 @@
  */
 
 #include <signal/filter/filter.hpp>
+
+namespace signal::filter::nlti::siso
+{
+    /* Definitions of the comparator pairs of the sorting networks */
+    constexpr uint8_t SSortingNetwork<1>::s_pairs[1][2];
+    constexpr uint8_t SSortingNetwork<2>::s_pairs[1][2];
+    constexpr uint8_t SSortingNetwork<3>::s_pairs[3][2];
+    constexpr uint8_t SSortingNetwork<4>::s_pairs[5][2];
+    constexpr uint8_t SSortingNetwork<5>::s_pairs[9][2];
+}; // namespace signal::filter::nlti::siso
@@ -0,0 +1,500 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    SignalGraph.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the signal graph
+  *          instantiated from a binary configuration.
+  ******************************************************************************
+ */
+
+#include <signal/graph/signalgraph.hpp>
+#include <signal/filter/filter.hpp>
+#include <signal/controllers/sisocontrollers.hpp>
+#include <signal/controllers/converters.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace signal::graph{
+
+    /**
+     * @brief Node of the linear combination of the inputs.
+     */
+    class CGainNode: public CSignalGraph::INode
+    {
+    public:
+        /** @brief Constructor */
+        CGainNode(float f_a, float f_b, float f_c)
+            : m_a(f_a)
+            , m_b(f_b)
+            , m_c(f_c)
+        {
+        }
+        /** @brief Apply the node */
+        virtual void step()
+        {
+            *m_output = m_a * *m_inputs[0] + m_b * *m_inputs[1] + m_c;
+        }
+    private:
+        /** @brief Factors of the inputs and the offset */
+        const float m_a;
+        const float m_b;
+        const float m_c;
+    };
+
+    /**
+     * @brief Node of a filter of the library, the filter is applied by a qualified call.
+     *
+     * @tparam TFilter  type of the filter, it has a 'float operator()(float&)' method
+     */
+    template <class TFilter>
+    class CFilterNode: public CSignalGraph::INode
+    {
+    public:
+        /** @brief Constructor, the arguments are forwarded to the filter */
+        template <class... TArgs>
+        CFilterNode(TArgs&&... f_args)
+            : m_filter(std::forward<TArgs>(f_args)...)
+        {
+        }
+        /** @brief Apply the node */
+        virtual void step()
+        {
+            float l_u = *m_inputs[0];
+            *m_output = m_filter.TFilter::operator()(l_u);
+        }
+    private:
+        /** @brief Wrapped filter */
+        TFilter m_filter;
+    };
+
+    /**
+     * @brief Node of the pid controller, its input is the error.
+     */
+    class CPidNode: public CSignalGraph::INode
+    {
+    public:
+        /** @brief Constructor */
+        CPidNode(float f_kp, float f_ki, float f_kd, float f_tf, float f_dt)
+            : m_pid(f_kp, f_ki, f_kd, f_tf, f_dt)
+        {
+        }
+        /** @brief Apply the node */
+        virtual void step()
+        {
+            *m_output = m_pid.signal::controllers::siso::CPidController<float>::calculateControl(*m_inputs[0]);
+        }
+    private:
+        /** @brief Wrapped controller */
+        signal::controllers::siso::CPidController<float> m_pid;
+    };
+
+    /**
+     * @brief Node of the piecewise linear converter with two breaks.
+     */
+    class CSplineNode: public CSignalGraph::INode
+    {
+    public:
+        /** @brief Type of the converter */
+        using CConverterType = signal::controllers::CConverterSpline<2,1>;
+        /** @brief Constructor */
+        CSplineNode(const CConverterType::CBreakContainerType& f_breaks, const CConverterType::CSplineContainerType& f_splines)
+            : m_converter(f_breaks, f_splines)
+        {
+        }
+        /** @brief Apply the node */
+        virtual void step()
+        {
+            *m_output = m_converter.CConverterType::operator()(*m_inputs[0]);
+        }
+    private:
+        /** @brief Wrapped converter */
+        CConverterType m_converter;
+    };
+
+    /** @brief Node types of the filters */
+    using CBiquadNode       = CFilterNode<signal::filter::lti::siso::CIIRFilter<float,2,3>>;
+    using CMedianNode       = CFilterNode<signal::filter::nlti::siso::CMedianFilter<float,5>>;
+    using CSlewNode         = CFilterNode<signal::filter::nlti::siso::CSlewRateFilter<float>>;
+    using CDeadzoneNode     = CFilterNode<signal::filter::nlti::siso::CDeadzoneFilter<float>>;
+    using CHysteresisNode   = CFilterNode<signal::filter::nlti::siso::CHysteresisFilter<float>>;
+    using CRateNode         = CFilterNode<signal::filter::nlti::siso::CRateFilter<float>>;
+
+    /** \brief  Number of the parameters of a kind
+     *
+     *  @param f_kind          kind of the node
+     *  @return                number of the parameters, negative for an unknown kind
+     */
+    static int32_t parameterCount(uint8_t f_kind)
+    {
+        switch(f_kind){
+            case CSignalGraph::NODE_GAIN:       return 3;
+            case CSignalGraph::NODE_BIQUAD:     return 5;
+            case CSignalGraph::NODE_MEDIAN:     return 0;
+            case CSignalGraph::NODE_PID:        return 4;
+            case CSignalGraph::NODE_SPLINE:     return 8;
+            case CSignalGraph::NODE_SLEW:       return 1;
+            case CSignalGraph::NODE_DEADZONE:   return 1;
+            case CSignalGraph::NODE_HYSTERESIS: return 2;
+            case CSignalGraph::NODE_RATE:       return 0;
+            default:                            return -1;
+        }
+    }
+
+    /** \brief  Size and alignment of the node of a kind in the arena
+     *
+     *  @param f_kind          known kind of the node
+     *  @param f_size          size in byte
+     *  @param f_align         alignment in byte
+     */
+    static void layout(uint8_t f_kind, uint32_t& f_size, uint32_t& f_align)
+    {
+        switch(f_kind){
+            case CSignalGraph::NODE_GAIN:       f_size = sizeof(CGainNode);         f_align = alignof(CGainNode);       break;
+            case CSignalGraph::NODE_BIQUAD:     f_size = sizeof(CBiquadNode);       f_align = alignof(CBiquadNode);     break;
+            case CSignalGraph::NODE_MEDIAN:     f_size = sizeof(CMedianNode);       f_align = alignof(CMedianNode);     break;
+            case CSignalGraph::NODE_PID:        f_size = sizeof(CPidNode);          f_align = alignof(CPidNode);        break;
+            case CSignalGraph::NODE_SPLINE:     f_size = sizeof(CSplineNode);       f_align = alignof(CSplineNode);     break;
+            case CSignalGraph::NODE_SLEW:       f_size = sizeof(CSlewNode);         f_align = alignof(CSlewNode);       break;
+            case CSignalGraph::NODE_DEADZONE:   f_size = sizeof(CDeadzoneNode);     f_align = alignof(CDeadzoneNode);   break;
+            case CSignalGraph::NODE_HYSTERESIS: f_size = sizeof(CHysteresisNode);   f_align = alignof(CHysteresisNode); break;
+            default:                            f_size = sizeof(CRateNode);         f_align = alignof(CRateNode);       break;
+        }
+    }
+
+    /** \brief  Parameter of a node, the configuration isn't aligned
+     *
+     *  @param f_params        parameters in the configuration
+     *  @param f_idx           index of the parameter
+     *  @return                value
+     */
+    static float parameter(const uint8_t* f_params, uint32_t f_idx)
+    {
+        float l_value;
+        memcpy(&l_value, f_params + 4 * f_idx, sizeof(float));
+        return l_value;
+    }
+
+    /** \brief  Value of a hexadecimal digit
+     *
+     *  @param f_char          character
+     *  @return                value, negative for an invalid character
+     */
+    static int32_t hexDigit(char f_char)
+    {
+        if (f_char >= '0' && f_char <= '9') return f_char - '0';
+        if (f_char >= 'a' && f_char <= 'f') return f_char - 'a' + 10;
+        if (f_char >= 'A' && f_char <= 'F') return f_char - 'A' + 10;
+        return -1;
+    }
+
+    /** \brief  CSignalGraph class constructor, the graph is empty until the load.
+     *
+     *  @param f_period        sampling period in second
+     *  @param f_sources       getters of the source signals, the array has to remain valid
+     *  @param f_sourceCount   number of the sources, at most s_maxSources
+     *  @param f_store         store of the configuration
+     */
+    CSignalGraph::CSignalGraph(float f_period, const FSourceGetter* f_sources, uint8_t f_sourceCount, utils::config::CBlobStore& f_store)
+        : m_period(f_period)
+        , m_sources(f_sources)
+        , m_sourceCount((f_sourceCount < s_maxSources) ? f_sourceCount : s_maxSources)
+        , m_store(f_store)
+        , m_nodes()
+        , m_nodeCount(0)
+        , m_signals()
+        , m_zero(0.0f)
+        , m_outputs()
+        , m_outputCount(0)
+        , m_arenaUsed(0)
+        , m_isLoaded(false)
+        , m_upload()
+        , m_arena()
+    {
+    }
+
+    /** \brief  Instantiate the configuration of the store, the store has to be loaded before.
+     *
+     *  @return                true, when the graph is instantiated
+     */
+    bool CSignalGraph::load()
+    {
+        return NULL != m_store.getBlob() && load(m_store.getBlob(), m_store.getLength());
+    }
+
+    /** \brief  Instantiate a configuration, the nodes are constructed in the arena in the order of application. It has to be
+     *  applied before the start of the control loop, a loaded graph isn't replaced.
+     *
+     *  @param f_blob          bytes of the configuration
+     *  @param f_length        length of the configuration
+     *  @return                true, when the graph is instantiated
+     */
+    bool CSignalGraph::load(const uint8_t* f_blob, uint32_t f_length)
+    {
+        SNode l_nodes[s_maxNodes];
+        uint8_t l_order[s_maxNodes];
+        uint8_t l_nodeCount;
+        const uint8_t* l_outputs;
+        uint8_t l_outputCount;
+        uint32_t l_arena;
+        if (m_isLoaded || !parse(f_blob, f_length, l_nodes, l_order, l_nodeCount, l_outputs, l_outputCount, l_arena))
+        {
+            return false;
+        }
+        m_arenaUsed = 0;
+        for (uint8_t i = 0; i < l_nodeCount; ++i)
+        {
+            const SNode& l_node = l_nodes[l_order[i]];
+            INode* l_created = create(l_node);
+            for (uint8_t j = 0; j < 2; ++j)
+            {
+                l_created->m_inputs[j] = (s_unused == l_node.m_inputs[j]) ? &m_zero : &m_signals[l_node.m_inputs[j]];
+            }
+            l_created->m_output = &m_signals[m_sourceCount + l_order[i]];
+            m_nodes[i] = l_created;
+        }
+        memcpy(m_outputs, l_outputs, l_outputCount);
+        m_outputCount = l_outputCount;
+        m_nodeCount = l_nodeCount;
+        m_isLoaded = true;
+        return true;
+    }
+
+    /** \brief  Check a configuration by a dry instantiation: the kinds, the parameters, the connections and the arena.
+     *
+     *  @param f_blob          bytes of the configuration
+     *  @param f_length        length of the configuration
+     *  @return                true, when the configuration can be instantiated
+     */
+    bool CSignalGraph::check(const uint8_t* f_blob, uint32_t f_length) const
+    {
+        SNode l_nodes[s_maxNodes];
+        uint8_t l_order[s_maxNodes];
+        uint8_t l_nodeCount;
+        const uint8_t* l_outputs;
+        uint8_t l_outputCount;
+        uint32_t l_arena;
+        return parse(f_blob, f_length, l_nodes, l_order, l_nodeCount, l_outputs, l_outputCount, l_arena);
+    }
+
+    /** \brief  Parse the configuration, the nodes are sorted topologically by their connections.
+     *
+     *  @param f_blob          bytes of the configuration
+     *  @param f_length        length of the configuration
+     *  @param f_nodes         parsed nodes in their order in the configuration
+     *  @param f_order         indices of the nodes in order of application
+     *  @param f_nodeCount     number of the nodes
+     *  @param f_outputs       signal indices of the outputs in the configuration
+     *  @param f_outputCount   number of the outputs
+     *  @param f_arena         used bytes of the arena
+     *  @return                true, when the configuration is valid
+     */
+    bool CSignalGraph::parse(const uint8_t* f_blob, uint32_t f_length, SNode* f_nodes, uint8_t* f_order, uint8_t& f_nodeCount
+                            ,const uint8_t*& f_outputs, uint8_t& f_outputCount, uint32_t& f_arena) const
+    {
+        if (NULL == f_blob || f_length < 2 || 0 == f_blob[0] || f_blob[0] > s_maxNodes || f_blob[1] > s_maxOutputs)
+        {
+            return false;
+        }
+        f_nodeCount = f_blob[0];
+        f_outputCount = f_blob[1];
+        const uint32_t l_signalCount = m_sourceCount + f_nodeCount;
+        uint32_t l_pos = 2;
+        for (uint8_t i = 0; i < f_nodeCount; ++i)
+        {
+            if (l_pos + 4 > f_length)
+            {
+                return false;
+            }
+            SNode& l_node = f_nodes[i];
+            l_node.m_kind = f_blob[l_pos];
+            l_node.m_inputs[0] = f_blob[l_pos + 1];
+            l_node.m_inputs[1] = f_blob[l_pos + 2];
+            int32_t l_params = parameterCount(l_node.m_kind);
+            if (l_params < 0 || f_blob[l_pos + 3] != l_params || l_pos + 4 + 4 * l_params > f_length
+               || l_node.m_inputs[0] >= l_signalCount || (s_unused != l_node.m_inputs[1] && l_node.m_inputs[1] >= l_signalCount))
+            {
+                return false;
+            }
+            l_node.m_params = f_blob + l_pos + 4;
+            l_pos += 4 + 4 * l_params;
+        }
+        if (l_pos + f_outputCount != f_length)
+        {
+            return false;
+        }
+        f_outputs = f_blob + l_pos;
+        for (uint8_t i = 0; i < f_outputCount; ++i)
+        {
+            if (f_outputs[i] >= l_signalCount)
+            {
+                return false;
+            }
+        }
+        // Topological order, a node is placed after the nodes of its inputs
+        bool l_placed[s_maxNodes] = {};
+        for (uint8_t l_count = 0; l_count < f_nodeCount; ++l_count)
+        {
+            bool l_found = false;
+            for (uint8_t i = 0; i < f_nodeCount && !l_found; ++i)
+            {
+                bool l_ready = !l_placed[i];
+                for (uint8_t j = 0; j < 2 && l_ready; ++j)
+                {
+                    uint8_t l_input = f_nodes[i].m_inputs[j];
+                    l_ready = (s_unused == l_input) || (l_input < m_sourceCount) || l_placed[l_input - m_sourceCount];
+                }
+                if (l_ready)
+                {
+                    l_placed[i] = true;
+                    f_order[l_count] = i;
+                    l_found = true;
+                }
+            }
+            if (!l_found)
+            {
+                // Cycle of the connections
+                return false;
+            }
+        }
+        f_arena = 0;
+        for (uint8_t i = 0; i < f_nodeCount; ++i)
+        {
+            uint32_t l_size, l_align;
+            layout(f_nodes[f_order[i]].m_kind, l_size, l_align);
+            f_arena = (f_arena + l_align - 1) / l_align * l_align + l_size;
+        }
+        return f_arena <= s_arenaSize;
+    }
+
+    /** \brief  Construct a node in the next free area of the arena, the configuration is checked by the parse.
+     *
+     *  @param f_node          parsed node
+     *  @return                constructed node
+     */
+    CSignalGraph::INode* CSignalGraph::create(const SNode& f_node)
+    {
+        uint32_t l_size, l_align;
+        layout(f_node.m_kind, l_size, l_align);
+        m_arenaUsed = (m_arenaUsed + l_align - 1) / l_align * l_align;
+        void* l_memory = m_arena + m_arenaUsed;
+        m_arenaUsed += l_size;
+        const uint8_t* l_p = f_node.m_params;
+        switch(f_node.m_kind){
+            case NODE_GAIN:
+                return new (l_memory) CGainNode(parameter(l_p,0), parameter(l_p,1), parameter(l_p,2));
+            case NODE_BIQUAD:
+            {
+                utils::linalg::CRowVector<float,2> l_a;
+                utils::linalg::CRowVector<float,3> l_b;
+                l_a[0] = {parameter(l_p,3), parameter(l_p,4)};
+                l_b[0] = {parameter(l_p,0), parameter(l_p,1), parameter(l_p,2)};
+                return new (l_memory) CBiquadNode(l_a, l_b);
+            }
+            case NODE_MEDIAN:
+                return new (l_memory) CMedianNode();
+            case NODE_PID:
+                return new (l_memory) CPidNode(parameter(l_p,0), parameter(l_p,1), parameter(l_p,2), parameter(l_p,3), m_period);
+            case NODE_SPLINE:
+                return new (l_memory) CSplineNode({parameter(l_p,0), parameter(l_p,1)}
+                                                 ,{std::array<float,2>({parameter(l_p,2), parameter(l_p,3)})
+                                                  ,std::array<float,2>({parameter(l_p,4), parameter(l_p,5)})
+                                                  ,std::array<float,2>({parameter(l_p,6), parameter(l_p,7)})});
+            case NODE_SLEW:
+                return new (l_memory) CSlewNode(parameter(l_p,0));
+            case NODE_DEADZONE:
+                return new (l_memory) CDeadzoneNode(parameter(l_p,0));
+            case NODE_HYSTERESIS:
+                return new (l_memory) CHysteresisNode(parameter(l_p,0), parameter(l_p,1));
+            default:
+                return new (l_memory) CRateNode(m_period);
+        }
+    }
+
+    /** \brief  Read the sources and apply the nodes in order, each node costs one indirect call.
+     *
+     *  @param f_timestamp     timestamp of the tick
+     */
+    CONTROL_RAMFUNC void CSignalGraph::process(uint32_t)
+    {
+        if (!m_isLoaded)
+        {
+            return;
+        }
+        for (uint8_t i = 0; i < m_sourceCount; ++i)
+        {
+            m_signals[i] = m_sources[i]();
+        }
+        for (uint8_t i = 0; i < m_nodeCount; ++i)
+        {
+            m_nodes[i]->step();
+        }
+    }
+
+    /** \brief  Value of an output in the last tick
+     *
+     *  @param f_idx           index of the output
+     *  @return                value, zero for an unknown output
+     */
+    float CSignalGraph::getOutput(uint8_t f_idx) const
+    {
+        return (f_idx < m_outputCount) ? m_signals[m_outputs[f_idx]] : 0.0f;
+    }
+
+    /** \brief  Serial callback method to get the state and the outputs, to upload and to save a configuration.
+     *
+     *  @param a               input received string, 0: state, 1;output: value, 2;offset;hex: upload, 3;length: check and save
+     *  @param b               output reponse message
+     */
+    void CSignalGraph::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        uint32_t l_value;
+        if (!utils::fmt::parseUint(l_text, l_command)){
+            sprintf(b,"sintax error;;");
+        } else if (0 == l_command){
+            utils::fmt::CWriter(b).udec(m_isLoaded ? 1 : 0).udec(m_nodeCount).udec(m_arenaUsed).udec(m_store.getLength()).chr(';');
+        } else if (1 == l_command && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_value) && l_value < m_outputCount){
+            utils::fmt::CWriter(b).fixed(getOutput(static_cast<uint8_t>(l_value)),4).chr(';');
+        } else if (2 == l_command && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_value) && ';' == *l_text++){
+            uint32_t l_offset = l_value;
+            while (hexDigit(l_text[0]) >= 0 && hexDigit(l_text[1]) >= 0 && l_offset < sizeof(m_upload)){
+                m_upload[l_offset++] = static_cast<uint8_t>(hexDigit(l_text[0]) * 16 + hexDigit(l_text[1]));
+                l_text += 2;
+            }
+            if (hexDigit(l_text[0]) >= 0){
+                sprintf(b,"sintax error;;");
+            } else{
+                utils::fmt::CWriter(b).text("ack;;").udec(l_offset);
+            }
+        } else if (3 == l_command && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_value)){
+            if (l_value > sizeof(m_upload) || !check(m_upload, l_value)){
+                sprintf(b,"invalid configuration;;");
+            } else{
+                sprintf(b, m_store.save(m_upload, l_value) ? "ack;;" : "write error;;");
+            }
+        } else{
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace signal::graph
@@ -0,0 +1,196 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  ******************************************************************************
+  * @file    MotorIdentifier.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the online identification of the motor model.
+  ******************************************************************************
+ */
+
+#include <signal/systemmodels/motoridentifier.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+
+namespace signal::systemmodels{
+
+    /** \brief  CMotorIdentifier class constructor, the estimation starts from the nominal model.
+     *
+     *  @param f_period        period of the pipeline in second
+     *  @param f_encoder       encoder of the motor
+     *  @param f_divider       number of the ticks per sample of the model
+     *  @param f_forgetting    forgetting factor of the estimator, the memory is about 1/(1-lambda) samples
+     *  @param f_nominal       nominal model of the drive, the static gain scales the speed
+     */
+    CMotorIdentifier::CMotorIdentifier(float                                  f_period
+                                      ,hardware::encoders::IEncoderGetter&    f_encoder
+                                      ,uint32_t                               f_divider
+                                      ,float                                  f_forgetting
+                                      ,const SModel&                          f_nominal)
+        : m_encoder(f_encoder)
+        , m_voltage()
+        , m_dt(f_period * f_divider)
+        , m_divider(f_divider)
+        , m_nominal(f_nominal)
+        , m_estimator(parameters(f_nominal), s_initialCovariance, f_forgetting, 3.0f * s_initialCovariance)
+        , m_tick(0)
+        , m_voltageSum(0.0f)
+        , m_isDriven(true)
+        , m_prevSpeed(0.0f)
+        , m_hasPrev(false)
+        , m_model(f_nominal)
+        , m_isValid(false)
+        , m_resetRequest(false)
+    {
+    }
+
+    /** \brief  Set the getter of the control voltage, it's the voltage of the speed controller in the last tick, zero while the motor isn't driven by it.
+     *
+     *  @param f_voltage       getter of the control voltage (V)
+     */
+    void CMotorIdentifier::setInput(mbed::Callback<float()> f_voltage)
+    {
+        m_voltage = f_voltage;
+    }
+
+    /** \brief  Discrete parameters [a, b, c] of the continuous model with the scaled speed.
+     *
+     *  @param f_model         continuous model
+     *  @return                parameters of the estimator
+     */
+    CMotorIdentifier::CEstimatorType::CParametersType CMotorIdentifier::parameters(const SModel& f_model) const
+    {
+        float l_a = std::exp(-m_dt / f_model.m_timeConstant);
+        float l_b = f_model.m_gain / m_nominal.m_gain * (1.0f - l_a);
+        CEstimatorType::CParametersType l_parameters;
+        l_parameters[0][0] = l_a;
+        l_parameters[1][0] = l_b;
+        l_parameters[2][0] = -l_b * f_model.m_offset;
+        return l_parameters;
+    }
+
+    /** \brief  It accumulates the voltage of the sample, at the end of the sample it updates the estimator and the continuous model. The
+     * unsigned encoders are skipped, the direction of the speed is needed by the model.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CMotorIdentifier::process(uint32_t)
+    {
+        if(m_resetRequest){
+            m_resetRequest = false;
+            m_estimator.reset(parameters(m_nominal));
+            m_hasPrev = false;
+            m_tick = 0;
+            m_voltageSum = 0.0f;
+            m_isDriven = true;
+            core_util_critical_section_enter();
+            m_model = m_nominal;
+            m_isValid = false;
+            core_util_critical_section_exit();
+        }
+        float l_voltage = m_voltage ? m_voltage() : 0.0f;
+        m_voltageSum += l_voltage;
+        m_isDriven = m_isDriven && (l_voltage != 0.0f);
+        if(++m_tick < m_divider){
+            return;
+        }
+        float l_speed = m_encoder.getSpeedRps() / m_nominal.m_gain;
+        float l_meanVoltage = m_voltageSum / m_divider;
+        bool l_isApplied = m_hasPrev && m_isDriven && !m_encoder.isAbs() && std::abs(l_meanVoltage) > s_minVoltage;
+        if(l_isApplied){
+            float l_sign = (m_prevSpeed != 0.0f) ? m_prevSpeed : l_meanVoltage;
+            CEstimatorType::CRegressorType l_regressor;
+            l_regressor[0][0] = m_prevSpeed;
+            l_regressor[1][0] = l_meanVoltage;
+            l_regressor[2][0] = (l_sign > 0.0f) ? 1.0f : -1.0f;
+            m_estimator.update(l_regressor, l_speed);
+            publish();
+        }
+        m_prevSpeed = l_speed;
+        m_hasPrev = true;
+        m_tick = 0;
+        m_voltageSum = 0.0f;
+        m_isDriven = true;
+    }
+
+    /** \brief  It converts the estimated discrete parameters to the continuous model. The model is valid with a stable pole, positive gain
+     * and small covariance after the minimum number of samples; the last valid model is kept otherwise.
+     */
+    CONTROL_RAMFUNC void CMotorIdentifier::publish()
+    {
+        const CEstimatorType::CParametersType& l_parameters = m_estimator.parameters();
+        float l_a = l_parameters[0][0];
+        float l_b = l_parameters[1][0];
+        bool l_isValid = l_a > 0.0f && l_a < 1.0f && l_b > 0.0f
+                        && m_estimator.updates() >= s_minUpdates && m_estimator.trace() < s_validTrace;
+        if(!l_isValid){
+            return;
+        }
+        SModel l_model;
+        l_model.m_gain = m_nominal.m_gain * l_b / (1.0f - l_a);
+        l_model.m_timeConstant = -m_dt / std::log(l_a);
+        l_model.m_offset = -l_parameters[2][0] / l_b;
+        core_util_critical_section_enter();
+        m_model = l_model;
+        m_isValid = true;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Get the estimated model
+     *
+     *  @param f_model         estimated model, the nominal model before the first valid estimation
+     *  @return                true, when the model was estimated from the measurements
+     */
+    bool CMotorIdentifier::getModel(SModel& f_model) const
+    {
+        core_util_critical_section_enter();
+        f_model = m_model;
+        bool l_isValid = m_isValid;
+        core_util_critical_section_exit();
+        return l_isValid;
+    }
+
+    /** \brief  Restart the estimation from the nominal model, it's applied in the next tick of the pipeline.
+     */
+    void CMotorIdentifier::reset()
+    {
+        m_resetRequest = true;
+    }
+
+    /** \brief  Serial callback of the estimated model. Without parameter it responds the static gain (rps/V), the time constant (s),
+     * the friction voltage (V), the validity, the number of the samples and the trace of the covariance; the parameter 1 restarts the estimation.
+     *
+     *  @param a               string to read data from
+     *  @param b               string to write data to
+     */
+    void CMotorIdentifier::serialCallback(char const * a, char * b)
+    {
+        float l_value;
+        if(1 == utils::fmt::parseFloats(a,&l_value,1) && 1.0f == l_value){
+            reset();
+            sprintf(b,"ack;;");
+            return;
+        }
+        SModel l_model;
+        bool l_isValid = getModel(l_model);
+        utils::fmt::CWriter(b).fixed(l_model.m_gain,3).fixed(l_model.m_timeConstant,4).fixed(l_model.m_offset,4)
+                              .dec(l_isValid ? 1 : 0).udec(m_estimator.updates()).fixed(m_estimator.trace(),4).chr(';');
+    }
+
+}; // namespace signal::systemmodels
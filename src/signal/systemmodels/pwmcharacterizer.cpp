@@ -0,0 +1,406 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    PwmCharacterizer.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the characterization of the drive over the pwm frequency and the duty cycle.
+  ******************************************************************************
+ */
+
+#include <signal/systemmodels/pwmcharacterizer.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+
+namespace signal::systemmodels{
+
+    /** \brief  CPwmCharacterizer class constructor
+     *
+     *  @param f_period        period of the pipeline in second
+     *  @param f_encoder       encoder of the motor
+     *  @param f_current       current of the motor
+     *  @param f_motor         motor driver
+     *  @param f_settleTime    settling time of a point in second
+     *  @param f_measureTime   measuring time of a point in second
+     */
+    CPwmCharacterizer::CPwmCharacterizer(float                                 f_period
+                                        ,hardware::encoders::IEncoderGetter&   f_encoder
+                                        ,hardware::drivers::ICurrentGetter&    f_current
+                                        ,hardware::drivers::IMotorCommand&     f_motor
+                                        ,float                                 f_settleTime
+                                        ,float                                 f_measureTime)
+        : m_encoder(f_encoder)
+        , m_current(f_current)
+        , m_motor(f_motor)
+        , m_power()
+        , m_frequency()
+        , m_setFrequency()
+        , m_guard()
+        , m_settleTicks(static_cast<uint32_t>(f_settleTime / f_period + 0.5f))
+        , m_measureTicks(static_cast<uint32_t>(f_measureTime / f_period + 0.5f) > 0 ? static_cast<uint32_t>(f_measureTime / f_period + 0.5f) : 1)
+        , m_points()
+        , m_frequencies(0)
+        , m_duties(0)
+        , m_point(0)
+        , m_ticks(0)
+        , m_sumSpeed(0.0f)
+        , m_sumCurrent(0.0f)
+        , m_sumSquare(0.0f)
+        , m_sumPower(0.0f)
+        , m_originalFrequency(0.0f)
+        , m_bestFrequency(0.0f)
+        , m_state(IDLE)
+        , m_stopRequest(false)
+    {
+    }
+
+    /** \brief  Attach the power getter, the frequency interface and the guard, the sweep doesn't start without the frequency interface
+     *
+     *  @param f_power         getter of the battery power in watt, the power isn't recorded without it
+     *  @param f_frequency     getter of the pwm frequency in Hz
+     *  @param f_setFrequency  setter of the pwm frequency
+     *  @param f_guard         guard of the sweep
+     */
+    void CPwmCharacterizer::setInputs(FValueGetter f_power, FValueGetter f_frequency, FFrequencySetter f_setFrequency, FGuard f_guard)
+    {
+        m_power = f_power;
+        m_frequency = f_frequency;
+        m_setFrequency = f_setFrequency;
+        m_guard = f_guard;
+    }
+
+    /** \brief  Start the sweep, the points are applied from the next tick. The frequencies and the duty cycles are equally spaced
+     *  between the limits.
+     *
+     *  @param f_minFrequency  lowest frequency in Hz
+     *  @param f_maxFrequency  highest frequency in Hz
+     *  @param f_frequencies   number of the frequencies, in interval [1, s_maxFrequencies]
+     *  @param f_minDuty       lowest duty cycle
+     *  @param f_maxDuty       highest duty cycle, it has to be in the range of the motor driver
+     *  @param f_duties        number of the duty cycles, in interval [1, s_maxDuties]
+     *  @return                false, when the parameters aren't valid, the guard doesn't allow the sweep or it's running
+     */
+    bool CPwmCharacterizer::start(float f_minFrequency, float f_maxFrequency, uint8_t f_frequencies, float f_minDuty, float f_maxDuty, uint8_t f_duties)
+    {
+        if (RUNNING == m_state || !m_frequency || !m_setFrequency || (m_guard && !m_guard())
+            || 0 == f_frequencies || f_frequencies > s_maxFrequencies || 0 == f_duties || f_duties > s_maxDuties
+            || f_minFrequency <= 0.0f || f_maxFrequency < f_minFrequency || f_minDuty <= 0.0f || f_maxDuty < f_minDuty || !m_motor.inRange(f_maxDuty))
+        {
+            return false;
+        }
+        float l_frequencyStep = (f_frequencies > 1) ? (f_maxFrequency - f_minFrequency) / (f_frequencies - 1) : 0.0f;
+        float l_dutyStep = (f_duties > 1) ? (f_maxDuty - f_minDuty) / (f_duties - 1) : 0.0f;
+        core_util_critical_section_enter();
+        for (uint8_t i = 0; i < f_frequencies; i++)
+        {
+            for (uint8_t j = 0; j < f_duties; j++)
+            {
+                SPoint& l_point = m_points[i * f_duties + j];
+                l_point = SPoint();
+                l_point.m_frequency = f_minFrequency + l_frequencyStep * i;
+                l_point.m_duty = f_minDuty + l_dutyStep * j;
+            }
+        }
+        m_frequencies = f_frequencies;
+        m_duties = f_duties;
+        m_point = 0;
+        m_ticks = 0;
+        m_originalFrequency = m_frequency();
+        m_bestFrequency = 0.0f;
+        m_stopRequest = false;
+        m_state = RUNNING;
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Request the stop of the sweep, the motor is braked and the frequency is restored by the next tick
+     */
+    void CPwmCharacterizer::stop()
+    {
+        m_stopRequest = true;
+    }
+
+    /** \brief  Pipeline stage, it applies the points, it accumulates the measurements and it evaluates the grid at the end
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CPwmCharacterizer::process(uint32_t)
+    {
+        if (RUNNING != m_state)
+        {
+            return;
+        }
+        if (m_stopRequest || (m_guard && !m_guard()))
+        {
+            finish(FAILED);
+            return;
+        }
+        if (0 == m_ticks && !applyPoint())
+        {
+            finish(FAILED);
+            return;
+        }
+        m_ticks++;
+        if (m_ticks <= m_settleTicks)
+        {
+            return;
+        }
+        float l_current = std::abs(m_current.getCurrent());
+        m_sumSpeed += std::abs(m_encoder.getSpeedRps());
+        m_sumCurrent += l_current;
+        m_sumSquare += l_current * l_current;
+        m_sumPower += m_power ? m_power() : 0.0f;
+        if (m_ticks < m_settleTicks + m_measureTicks)
+        {
+            return;
+        }
+        SPoint& l_point = m_points[m_point];
+        float l_count = static_cast<float>(m_measureTicks);
+        l_point.m_speed = m_sumSpeed / l_count;
+        l_point.m_current = m_sumCurrent / l_count;
+        float l_variance = m_sumSquare / l_count - l_point.m_current * l_point.m_current;
+        l_point.m_ripple = (l_variance > 0.0f) ? std::sqrt(l_variance) : 0.0f;
+        l_point.m_power = m_sumPower / l_count;
+        m_ticks = 0;
+        if (m_point + 1 < m_frequencies * m_duties)
+        {
+            m_point = m_point + 1;
+        }
+        else
+        {
+            evaluate();
+            finish(FINISHED);
+        }
+    }
+
+    /** \brief  Apply the active point, the frequency is changed at the first duty cycle of each frequency
+     *
+     *  @return                false, when the frequency isn't applied
+     */
+    bool CPwmCharacterizer::applyPoint()
+    {
+        const SPoint& l_point = m_points[m_point];
+        if (0 == m_point % m_duties && !m_setFrequency(l_point.m_frequency))
+        {
+            return false;
+        }
+        m_sumSpeed = 0.0f;
+        m_sumCurrent = 0.0f;
+        m_sumSquare = 0.0f;
+        m_sumPower = 0.0f;
+        m_motor.setSpeed(l_point.m_duty);
+        return true;
+    }
+
+    /** \brief  Finish the sweep, the motor is braked and the original frequency is restored
+     *
+     *  @param f_state         final state
+     */
+    void CPwmCharacterizer::finish(EState f_state)
+    {
+        m_motor.brake();
+        if (m_originalFrequency > 0.0f)
+        {
+            m_setFrequency(m_originalFrequency);
+        }
+        m_stopRequest = false;
+        m_state = f_state;
+    }
+
+    /** \brief  Select the frequency with the highest mean speed per ampere over its duty cycles, the points below the minimal current
+     *  aren't scored
+     */
+    void CPwmCharacterizer::evaluate()
+    {
+        float l_bestScore = 0.0f;
+        for (uint8_t i = 0; i < m_frequencies; i++)
+        {
+            float l_score = 0.0f;
+            uint8_t l_scored = 0;
+            for (uint8_t j = 0; j < m_duties; j++)
+            {
+                const SPoint& l_point = m_points[i * m_duties + j];
+                if (l_point.m_current >= s_minCurrent)
+                {
+                    l_score += l_point.m_speed / l_point.m_current;
+                    l_scored++;
+                }
+            }
+            l_score = (l_scored > 0) ? l_score / l_scored : 0.0f;
+            if (l_score > l_bestScore)
+            {
+                l_bestScore = l_score;
+                m_bestFrequency = m_points[i * m_duties].m_frequency;
+            }
+        }
+    }
+
+    /** \brief  Apply the best frequency of the last sweep
+     *
+     *  @return                false, when the sweep is running, there isn't result or the frequency isn't applied
+     */
+    bool CPwmCharacterizer::applyBest()
+    {
+        if (RUNNING == m_state || m_bestFrequency <= 0.0f || !m_setFrequency)
+        {
+            return false;
+        }
+        return m_setFrequency(m_bestFrequency);
+    }
+
+    /** \brief  Set the pwm, a running sweep is stopped and the command is forwarded
+     *
+     *  @param f_pwm           pwm duty cycle
+     */
+    CONTROL_RAMFUNC void CPwmCharacterizer::setSpeed(float f_pwm)
+    {
+        if (RUNNING == m_state)
+        {
+            finish(FAILED);
+        }
+        m_motor.setSpeed(f_pwm);
+    }
+
+    /** \brief  Brake the motor, a running sweep is stopped
+     */
+    void CPwmCharacterizer::brake()
+    {
+        if (RUNNING == m_state)
+        {
+            finish(FAILED);
+        }
+        m_motor.brake();
+    }
+
+    /** \brief  Inverse the direction, a running sweep is stopped
+     *
+     *  @param f_pwm           pwm duty cycle
+     */
+    void CPwmCharacterizer::inverseDirection(float f_pwm)
+    {
+        if (RUNNING == m_state)
+        {
+            finish(FAILED);
+        }
+        m_motor.inverseDirection(f_pwm);
+    }
+
+    /** \brief  Coast the motor, a running sweep is stopped
+     */
+    void CPwmCharacterizer::coast()
+    {
+        if (RUNNING == m_state)
+        {
+            finish(FAILED);
+        }
+        m_motor.coast();
+    }
+
+    /** \brief  Proportional dynamic braking, a running sweep is stopped
+     *
+     *  @param f_duty          duty cycle of the braking
+     */
+    CONTROL_RAMFUNC void CPwmCharacterizer::dynamicBrake(float f_duty)
+    {
+        if (RUNNING == m_state)
+        {
+            finish(FAILED);
+        }
+        m_motor.dynamicBrake(f_duty);
+    }
+
+    /** \brief  Check the range of the pwm by the motor driver
+     *
+     *  @param f_pwm           pwm duty cycle
+     *  @return                true, when the value is in the range
+     */
+    bool CPwmCharacterizer::inRange(float f_pwm)
+    {
+        return m_motor.inRange(f_pwm);
+    }
+
+    /** \brief  Serial callback method to get the state and the results, to start or to stop the sweep
+     *
+     * @param a                   input received string, 0: state, 1;fmin;fmax;nf;dmin;dmax;nd: start, 2;index: result of a point,
+     *                            3: apply the best frequency, 4: stop
+     * @param b                   output reponse message
+     */
+    void CPwmCharacterizer::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(static_cast<uint32_t>(m_state)).udec(m_point).udec(m_frequencies * m_duties)
+                                  .fixed(m_bestFrequency,0).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_minFrequency, l_maxFrequency, l_frequencies, l_minDuty, l_maxDuty, l_duties;
+            if (utils::fmt::parseUint(l_text, l_minFrequency) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_maxFrequency) && ';' == *l_text++
+                && utils::fmt::parseUint(l_text, l_frequencies) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_minDuty) && ';' == *l_text++
+                && utils::fmt::parseUint(l_text, l_maxDuty) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_duties)
+                && l_frequencies <= s_maxFrequencies && l_duties <= s_maxDuties)
+            {
+                bool l_started = start(static_cast<float>(l_minFrequency), static_cast<float>(l_maxFrequency), static_cast<uint8_t>(l_frequencies)
+                                      ,static_cast<float>(l_minDuty) * 0.01f, static_cast<float>(l_maxDuty) * 0.01f, static_cast<uint8_t>(l_duties));
+                sprintf(b, l_started ? "ack;;" : "busy;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_index;
+            if (utils::fmt::parseUint(l_text, l_index) && l_index < static_cast<uint32_t>(m_frequencies * m_duties)
+                && (RUNNING != m_state || l_index < m_point))
+            {
+                const SPoint& l_point = m_points[l_index];
+                float l_perAmpere = (l_point.m_current >= s_minCurrent) ? l_point.m_speed / l_point.m_current : 0.0f;
+                float l_perWatt = (l_point.m_power > 0.0f) ? l_point.m_speed / l_point.m_power : 0.0f;
+                utils::fmt::CWriter(b).fixed(l_point.m_frequency,0).fixed(l_point.m_duty * 100.0f,1).fixed(l_point.m_speed,2)
+                                      .fixed(l_point.m_current,3).fixed(l_point.m_ripple,3).fixed(l_point.m_power,2)
+                                      .fixed(l_perAmpere,3).fixed(l_perWatt,3).chr(';');
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (3 == l_command)
+        {
+            sprintf(b, applyBest() ? "ack;;" : "busy;;");
+        }
+        else if (4 == l_command)
+        {
+            stop();
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace signal::systemmodels
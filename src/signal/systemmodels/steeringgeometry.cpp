@@ -0,0 +1,212 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    SteeringGeometry.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the Ackermann steering
+  *          geometry by precomputed lookup tables.
+  ******************************************************************************
+ */
+#include <signal/systemmodels/steeringgeometry.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+#include <cmath>
+
+namespace signal::systemmodels{
+
+    /** \brief  Radian of a degree */
+    static constexpr double s_radian = 3.14159265358979323846 / 180.0;
+
+    /** \brief  Tangent by the power series of the sine and the cosine, it's evaluated by the compiler for the small angles of the table
+     *
+     *  @param f_x                 angle in radian, |x| < 0.5
+     *  @return                    tangent
+     */
+    static constexpr double seriesTan(double f_x)
+    {
+        double l_sin = f_x, l_sinTerm = f_x;
+        double l_cos = 1.0, l_cosTerm = 1.0;
+        for (int l_k = 1; l_k < 12; ++l_k)
+        {
+            l_sinTerm *= -f_x * f_x / ((2 * l_k) * (2 * l_k + 1));
+            l_cosTerm *= -f_x * f_x / ((2 * l_k - 1) * (2 * l_k));
+            l_sin += l_sinTerm;
+            l_cos += l_cosTerm;
+        }
+        return l_sin / l_cos;
+    }
+
+    /** \brief  Arc tangent by its power series, it's evaluated by the compiler for the small values of the table
+     *
+     *  @param f_x                 value, |x| < 0.5
+     *  @return                    arc tangent in radian
+     */
+    static constexpr double seriesAtan(double f_x)
+    {
+        double l_sum = f_x, l_term = f_x;
+        for (int l_k = 1; l_k < 30; ++l_k)
+        {
+            l_term *= -f_x * f_x;
+            l_sum += l_term / (2 * l_k + 1);
+        }
+        return l_sum;
+    }
+
+    /** \brief  Table of the interpolation, sampled uniformly from zero */
+    struct STable{
+        /** \brief sampled values */
+        float m_values[CSteeringGeometry::s_points];
+    };
+
+    /** \brief  Tangent of the largest wheel angle of the table */
+    static constexpr double s_maxTangent = seriesTan(CSteeringGeometry::s_maxAngle * s_radian);
+
+    /** \brief  Table of the tangents of the wheel angles
+     *
+     *  @return                    tangents in [0, s_maxAngle] degree
+     */
+    static constexpr STable tangentTable()
+    {
+        STable l_table{};
+        for (uint32_t l_idx = 0; l_idx < CSteeringGeometry::s_points; ++l_idx)
+        {
+            l_table.m_values[l_idx] = static_cast<float>(seriesTan(CSteeringGeometry::s_maxAngle * s_radian * l_idx / (CSteeringGeometry::s_points - 1)));
+        }
+        return l_table;
+    }
+
+    /** \brief  Table of the wheel angles of the normalized curvatures
+     *
+     *  @return                    arc tangents in degree in [0, s_maxTangent]
+     */
+    static constexpr STable angleTable()
+    {
+        STable l_table{};
+        for (uint32_t l_idx = 0; l_idx < CSteeringGeometry::s_points; ++l_idx)
+        {
+            l_table.m_values[l_idx] = static_cast<float>(seriesAtan(s_maxTangent * l_idx / (CSteeringGeometry::s_points - 1)) / s_radian);
+        }
+        return l_table;
+    }
+
+    /** \brief  Tangents of the wheel angles, in the flash */
+    static constexpr STable s_tangents = tangentTable();
+    /** \brief  Wheel angles of the normalized curvatures, in the flash */
+    static constexpr STable s_angles = angleTable();
+
+    /** \brief  Linear interpolation of a table
+     *
+     *  @param f_table             table
+     *  @param f_position          position in entries, in [0, s_points - 1)
+     *  @return                    interpolated value
+     */
+    static CONTROL_RAMFUNC float interpolate(const STable& f_table, float f_position)
+    {
+        uint32_t l_idx = static_cast<uint32_t>(f_position);
+        float l_fraction = f_position - l_idx;
+        return f_table.m_values[l_idx] + l_fraction * (f_table.m_values[l_idx + 1] - f_table.m_values[l_idx]);
+    }
+
+    /** \brief  Curvature of the path of a servo angle, the wheel angle of the calibration is looked up in the table of the tangents.
+     *
+     *  @param f_angle             servo angle in degree, positive to right
+     *  @return                    curvature in 1/m, positive to left
+     */
+    CONTROL_RAMFUNC float CSteeringGeometry::curvature(float f_angle) const
+    {
+        float l_wheel = m_gain * f_angle + m_offset;
+        float l_abs = fabsf(l_wheel);
+        float l_tangent = (l_abs < s_maxAngle)
+                        ? interpolate(s_tangents, l_abs * ((s_points - 1) / s_maxAngle))
+                        : tanf(l_abs * static_cast<float>(s_radian));
+        return ((l_wheel < 0.0f) ? l_tangent : -l_tangent) * m_invWheelbase;
+    }
+
+    /** \brief  Servo angle of a curvature of the path, the wheel angle is looked up in the table of the arc tangents, then the
+     *  calibration is inverted.
+     *
+     *  @param f_curvature         curvature in 1/m, positive to left
+     *  @return                    servo angle in degree, positive to right
+     */
+    CONTROL_RAMFUNC float CSteeringGeometry::angle(float f_curvature) const
+    {
+        float l_normalized = m_wheelbase * f_curvature;
+        float l_abs = fabsf(l_normalized);
+        float l_wheel = (l_abs < static_cast<float>(s_maxTangent))
+                      ? interpolate(s_angles, l_abs * static_cast<float>((s_points - 1) / s_maxTangent))
+                      : atanf(l_abs) / static_cast<float>(s_radian);
+        return (((l_normalized < 0.0f) ? l_wheel : -l_wheel) - m_offset) / m_gain;
+    }
+
+    /** \brief  Set the calibration of the servo
+     *
+     *  @param f_gain              gain of the servo command, positive
+     *  @param f_offset            offset of the wheel angle in degree
+     *  @return                    true, when the calibration is applied
+     */
+    bool CSteeringGeometry::setCalibration(float f_gain, float f_offset)
+    {
+        if (f_gain <= 0.0f)
+        {
+            return false;
+        }
+        m_gain = f_gain;
+        m_offset = f_offset;
+        return true;
+    }
+
+    /** \brief  Serial callback method
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CSteeringGeometry::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text,l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).fixed(m_gain,4).fixed(m_offset,3).fixed(m_wheelbase,3).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            float l_values[2];
+            if (2 != utils::fmt::parseFloats(l_text, l_values, 2))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (!setCalibration(l_values[0], l_values[1]))
+            {
+                sprintf(b,"invalid parameters;;");
+            }
+            else
+            {
+                sprintf(b,"ack;;");
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace signal::systemmodels
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    ThermalModel.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the thermal model of the motor winding.
+  ******************************************************************************
+ */
+
+#include <signal/systemmodels/thermalmodel.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace signal::systemmodels{
+
+    /** \brief  CMotorThermalModel class constructor, the derating is disabled until setDerating.
+     *
+     *  @param f_period        period of the pipeline in second
+     *  @param f_current       getter of the motor current
+     *  @param f_parameters    parameters of the thermal model
+     *  @param f_ambient       ambient temperature (°C), the initial temperature of the motor
+     */
+    CMotorThermalModel::CMotorThermalModel(float                                   f_period
+                                          ,hardware::drivers::ICurrentGetter&      f_current
+                                          ,const SThermalParameters&               f_parameters
+                                          ,float                                   f_ambient)
+        : m_current(f_current)
+        , m_model(systemModel(f_period, f_parameters))
+        , m_ambient(f_ambient)
+        , m_deratingStart(1000.0f)
+        , m_deratingLimit(1001.0f)
+        , m_deratingFloor(1.0f)
+        , m_rise(0.0f)
+        , m_derating(1.0f)
+    {
+    }
+
+    /** \brief  It creates the discrete model: x = [rise of the winding, rise of the housing], u = [I^2], y = [rise of the winding].
+     *
+     *  @param f_period        period in second
+     *  @param f_parameters    parameters of the thermal model
+     *  @return                system model
+     */
+    CMotorThermalModel::CModelType CMotorThermalModel::systemModel(float f_period, const SThermalParameters& f_parameters)
+    {
+        const double l_windingToHousing = 1.0 / (f_parameters.m_windingCapacity * f_parameters.m_windingResistance);
+        const double l_housingToWinding = 1.0 / (f_parameters.m_housingCapacity * f_parameters.m_windingResistance);
+        const double l_housingToAmbient = 1.0 / (f_parameters.m_housingCapacity * f_parameters.m_housingResistance);
+        const signal::systemmodels::lti::SStateSpace<2,1> l_continuous = {
+            {{-l_windingToHousing,  l_windingToHousing},
+             {l_housingToWinding,   -l_housingToWinding - l_housingToAmbient}},
+            {{f_parameters.m_resistance / f_parameters.m_windingCapacity},
+             {0.0}}};
+        const signal::systemmodels::lti::SStateSpace<2,1> l_discrete = signal::systemmodels::lti::zeroOrderHold(l_continuous, f_period);
+        CModelType::CStateTransitionType l_A(signal::systemmodels::lti::toStateTransition<float>(l_discrete));
+        CModelType::CInputMatrixType l_B(signal::systemmodels::lti::toInputMatrix<float>(l_discrete));
+        CModelType::CMeasurementMatrixType l_C({
+            1.0f, 0.0f });
+        return CModelType(l_A, l_B, l_C);
+    }
+
+    /** \brief  Set the temperatures of the derating.
+     *
+     *  @param f_start         temperature of the winding (°C), where the derating starts
+     *  @param f_limit         temperature of the winding (°C), where the derating reaches the floor, it's above the start
+     *  @param f_floor         derating factor above the limit temperature, between zero and one
+     */
+    void CMotorThermalModel::setDerating(float f_start, float f_limit, float f_floor)
+    {
+        if(f_limit <= f_start || f_floor < 0.0f || f_floor > 1.0f){
+            return;
+        }
+        m_deratingStart = f_start;
+        m_deratingLimit = f_limit;
+        m_deratingFloor = f_floor;
+    }
+
+    /** \brief  Pipeline stage, it updates the temperatures with the copper loss of the last period and the derating factor.
+     *
+     *  @param f_timestamp     timestamp of the tick
+     */
+    void CMotorThermalModel::process(uint32_t f_timestamp)
+    {
+        float l_current = m_current.getCurrent();
+        CModelType::CControlType l_u({l_current*l_current});
+        m_model.updateState(l_u);
+        float l_rise = m_model.state()[0][0];
+        m_rise = l_rise;
+
+        float l_temperature = m_ambient + l_rise;
+        if(l_temperature <= m_deratingStart){
+            m_derating = 1.0f;
+        } else if(l_temperature >= m_deratingLimit){
+            m_derating = m_deratingFloor;
+        } else{
+            float l_ratio = (l_temperature - m_deratingStart) / (m_deratingLimit - m_deratingStart);
+            m_derating = 1.0f - l_ratio * (1.0f - m_deratingFloor);
+        }
+    }
+
+    /** \brief  Estimated temperature of the winding
+     *
+     *  @return                temperature in °C
+     */
+    float CMotorThermalModel::getTemperature()
+    {
+        return m_ambient + m_rise;
+    }
+
+    /** \brief  Estimated temperature of the housing, it's read outside of the control loop.
+     *
+     *  @return                temperature in °C
+     */
+    float CMotorThermalModel::getHousingTemperature()
+    {
+        return m_ambient + m_model.state()[1][0];
+    }
+
+    /** \brief  Serial callback of the state, it responds the temperature of the winding, of the housing and the derating factor.
+     *
+     *  @param a               input string
+     *  @param b               output string
+     */
+    void CMotorThermalModel::serialCallback(char const * a, char * b)
+    {
+        utils::fmt::CWriter(b).fixed(getTemperature(),1).fixed(getHousingTemperature(),1).fixed(static_cast<float>(m_derating),2).chr(';');
+    }
+
+}; // namespace signal::systemmodels
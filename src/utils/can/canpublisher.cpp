@@ -0,0 +1,111 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    CanPublisher.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the publishing of the 
+  *          sensor values on the CAN bus.
+  ******************************************************************************
+ */
+#include <utils/can/canpublisher.hpp>
+
+namespace utils::can{
+
+    /** \brief  CCanPublisher class constructor
+     *
+     *  The values aren't published until the first subscription.
+     *
+     *  @param f_period        period of the publisher, the values are published in its multiples
+     *  @param f_values        list of the values, the index in the list is the bit in the subscription mask
+     *  @param f_valueCount    number of the values, at most 32
+     *  @param f_transport     CAN transport
+     *  @param f_baseId        identifier of the first value
+     */
+    CCanPublisher::CCanPublisher(uint32_t                              f_period
+                                ,utils::publisher::IPublishedValue**   f_values
+                                ,uint8_t                               f_valueCount
+                                ,CCanTransport&                        f_transport
+                                ,uint16_t                              f_baseId)
+        : utils::task::CTask(f_period)
+        , m_values(f_values)
+        , m_valueCount(f_valueCount < 32 ? f_valueCount : 32)
+        , m_transport(f_transport)
+        , m_baseId(f_baseId)
+        , m_mask(0)
+        , m_tick(0)
+    {
+    }
+
+    /** \brief  Subscribe the published values
+     *
+     *  @param f_mask          mask of the values, zero stops the publishing
+     *  @return                true, when the mask contains only registered values
+     */
+    bool CCanPublisher::subscribe(uint32_t f_mask)
+    {
+        if (m_valueCount < 32 && (f_mask >> m_valueCount) != 0)
+        {
+            return false;
+        }
+        m_mask = f_mask;
+        return true;
+    }
+
+    /** \brief  Serial callback of the subscription, the string has to contain the mask of the values in hexadecimal format.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CCanPublisher::serialCallback(char const * a, char * b)
+    {
+        unsigned long l_mask;
+        if (1 == sscanf(a,"%lx",&l_mask) && subscribe(l_mask))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Run method, it queues a frame for each due value, the values longer than a frame are skipped.
+     */
+    void CCanPublisher::_run()
+    {
+        uint32_t l_mask = m_mask;
+        if (0 == l_mask)
+        {
+            return;
+        }
+        for (uint8_t i = 0; i < m_valueCount; ++i)
+        {
+            if ((l_mask & (1u << i)) && 0 == m_tick % m_values[i]->getDivider())
+            {
+                uint8_t l_data[8];
+                int32_t l_length = m_values[i]->binary(l_data, sizeof(l_data));
+                if (l_length >= 0)
+                {
+                    m_transport.publish(m_baseId + i, l_data, l_length);
+                }
+            }
+        }
+        m_tick++;
+    }
+
+}; // namespace utils::can
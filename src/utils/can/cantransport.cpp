@@ -0,0 +1,265 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    CanTransport.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the CAN transport of the 
+  *          binary messages.
+  ******************************************************************************
+ */
+#include <utils/can/cantransport.hpp>
+
+namespace utils::can{
+
+    /** \brief  CCanTransport class constructor
+     *
+     *  @param f_controller        CAN controller, its filters accept the identifiers of the node
+     *  @param f_subscribers       dispatch table of the binary messages
+     *  @param f_baseId            first identifier of the node, the node owns the next s_idRange identifiers
+     */
+    CCanTransport::CCanTransport(ICanController& f_controller, CBinarySubscriberMap f_subscribers, uint16_t f_baseId)
+        : utils::task::CTask(0)
+        , m_controller(f_controller)
+        , m_subscribers(f_subscribers)
+        , m_baseId(f_baseId)
+        , m_queue()
+        , m_pending()
+        , m_hasPending(false)
+        , m_isStarted(false)
+        , m_statistics()
+        , m_errors()
+        , m_stampedId(s_invalidId)
+        , m_stampedReceive()
+        , m_stampedTransmit()
+        , m_irqCycles(0)
+        , m_isIrqFresh(false)
+        , m_isStampPending(false)
+    {
+    }
+
+    /** \brief  Start the transport, it attaches the interrupt of the controller. It's applied after the start of the controller, 
+     *  without it the frames aren't queued and the controller isn't accessed.
+     */
+    void CCanTransport::start()
+    {
+        m_isStarted = true;
+        m_controller.attach(mbed::callback(this,&CCanTransport::interruptCallback));
+        // The frames received before the attachment keep the interrupt active without a new edge
+        Notify();
+    }
+
+    /** \brief  Set the stamped identifier, its frames are passed to the callbacks instead of the dispatch table. It's applied before 
+     *  the start of the transport.
+     *
+     *  @param f_id                standard identifier of the stamped frames, it's accepted by the filters of the controller
+     *  @param f_received          callback of the received frames, it's applied by the task
+     *  @param f_transmitted       callback of the transmitted frames, it's applied by the task
+     */
+    void CCanTransport::setStamped(uint16_t f_id, FStampedReceive f_received, FStampedTransmit f_transmitted)
+    {
+        m_stampedId = f_id;
+        m_stampedReceive = f_received;
+        m_stampedTransmit = f_transmitted;
+    }
+
+    /** \brief  Queue a standard frame, the task loads it in a mailbox
+     *
+     *  It can be applied from any thread and from interrupt context, the producers are serialized by a short critical section.
+     *
+     *  @param f_id                identifier of the frame
+     *  @param f_data              data bytes
+     *  @param f_length            number of the data bytes, at most 8
+     *  @return                    false, when the transport isn't started, the length is invalid or the queue is full
+     */
+    bool CCanTransport::publish(uint16_t f_id, const void* f_data, uint8_t f_length)
+    {
+        SCanFrame l_frame;
+        if (!m_isStarted || f_length > sizeof(l_frame.m_data))
+        {
+            return false;
+        }
+        l_frame.m_id = f_id;
+        l_frame.m_length = f_length;
+        l_frame.m_extended = false;
+        l_frame.m_remote = false;
+        memcpy(l_frame.m_data, f_data, f_length);
+        core_util_critical_section_enter();
+        bool l_queued = m_queue.push(l_frame);
+        if (!l_queued)
+        {
+            m_statistics.m_dropped++;
+        }
+        core_util_critical_section_exit();
+        if (l_queued)
+        {
+            Notify();
+        }
+        return l_queued;
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CCanTransport::serialCallback(char const * a, char * b)
+    {
+        unsigned int l_command, l_id;
+        char l_hex[17];
+        int l_count = sscanf(a,"%u;%x;%16[0-9a-fA-F]",&l_command,&l_id,l_hex);
+        if (l_count == 1 && l_command == 0)
+        {
+            sprintf(b,"ack;;%lu;%lu;%lu;%lu;%lu;%u;%u;%u;%lu;"
+                   ,static_cast<unsigned long>(m_statistics.m_received), static_cast<unsigned long>(m_statistics.m_transmitted)
+                   ,static_cast<unsigned long>(m_statistics.m_dropped), static_cast<unsigned long>(m_statistics.m_rejected)
+                   ,static_cast<unsigned long>(m_statistics.m_errors), m_errors.m_transmit, m_errors.m_receive
+                   ,m_errors.m_busOff ? 1u : 0u, static_cast<unsigned long>(m_errors.m_overflows));
+        }
+        else if (l_count >= 2 && l_command == 1 && l_id <= 0x7FF)
+        {
+            uint8_t l_data[8];
+            uint8_t l_length = 0;
+            if (l_count == 3)
+            {
+                uint32_t l_digits = strlen(l_hex);
+                if (l_digits % 2 != 0)
+                {
+                    sprintf(b,"sintax error;;");
+                    return;
+                }
+                for (; l_length < l_digits / 2; l_length++)
+                {
+                    unsigned int l_byte;
+                    sscanf(l_hex + 2 * l_length, "%2x", &l_byte);
+                    l_data[l_length] = l_byte;
+                }
+            }
+            sprintf(b, publish(l_id, l_data, l_length) ? "ack;;" : "busy;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Run method, it reads the received frames, it clears the events of the controller and it drains the transmit queue.
+     *
+     *  The interrupt output of the controller is level triggered, the callback is applied only by its falling edge, so the servicing 
+     *  is repeated, while the interrupt stays active.
+     */
+    void CCanTransport::_run()
+    {
+        if (!m_isStarted)
+        {
+            return;
+        }
+        core_util_critical_section_enter();
+        uint32_t l_stamp = m_irqCycles;
+        bool l_isFresh = m_isIrqFresh;
+        m_isIrqFresh = false;
+        core_util_critical_section_exit();
+        uint32_t l_round = 0;
+        uint32_t l_frames = 0;
+        do
+        {
+            SCanFrame l_frame;
+            while (l_frames < s_maxFrames && m_controller.receive(l_frame))
+            {
+                dispatch(l_frame, l_stamp, l_isFresh && 0 == l_round && 0 == l_frames);
+                l_frames++;
+            }
+            uint32_t l_events = m_controller.acknowledge();
+            if (l_events & CAN_ERROR)
+            {
+                m_statistics.m_errors++;
+                m_controller.getErrors(m_errors);
+            }
+            if ((l_events & CAN_TRANSMITTED) && m_isStampPending)
+            {
+                m_isStampPending = false;
+                if (m_stampedTransmit)
+                {
+                    m_stampedTransmit(l_stamp, l_isFresh && 0 == l_round && 0 == l_frames && CAN_TRANSMITTED == l_events);
+                }
+            }
+            flush();
+        } while (m_controller.isPending() && ++l_round < s_maxRounds);
+    }
+
+    /** \brief  Interrupt callback of the controller, it stamps the interrupt by the cycle counter and it notifies the task.
+     */
+    void CCanTransport::interruptCallback()
+    {
+        m_irqCycles = utils::task::CTaskStatistics::cycles();
+        m_isIrqFresh = true;
+        Notify();
+    }
+
+    /** \brief  Apply the subscriber of a received frame and queue the status code of the response.
+     *
+     *  @param f_frame             received frame
+     *  @param f_stamp             cycle counter of the interrupt
+     *  @param f_isStampValid      the interrupt belongs to the frame
+     */
+    void CCanTransport::dispatch(const SCanFrame& f_frame, uint32_t f_stamp, bool f_isStampValid)
+    {
+        m_statistics.m_received++;
+        if (!f_frame.m_extended && !f_frame.m_remote && f_frame.m_id == m_stampedId)
+        {
+            if (m_stampedReceive)
+            {
+                m_stampedReceive(f_frame, f_stamp, f_isStampValid);
+            }
+            return;
+        }
+        uint32_t l_id = f_frame.m_id - m_baseId;
+        const utils::serial::CBinaryProtocol::FBinaryCallback* l_callback = NULL;
+        if (!f_frame.m_extended && !f_frame.m_remote && f_frame.m_id >= m_baseId && l_id < utils::serial::CBinaryProtocol::s_responseFlag)
+        {
+            l_callback = m_subscribers.find(l_id);
+        }
+        if (l_callback == NULL)
+        {
+            m_statistics.m_rejected++;
+            return;
+        }
+        uint8_t l_status = (*l_callback)(f_frame.m_data, f_frame.m_length);
+        publish(m_baseId + (l_id | utils::serial::CBinaryProtocol::s_responseFlag), &l_status, sizeof(l_status));
+    }
+
+    /** \brief  Load the queued frames in the free mailboxes, the frame of a busy controller waits for the next freed mailbox.
+     */
+    void CCanTransport::flush()
+    {
+        while (m_hasPending || m_queue.pop(m_pending))
+        {
+            m_hasPending = true;
+            if (!m_controller.send(m_pending))
+            {
+                return;
+            }
+            m_hasPending = false;
+            m_statistics.m_transmitted++;
+            if (!m_pending.m_extended && m_pending.m_id == m_stampedId)
+            {
+                m_isStampPending = true;
+            }
+        }
+    }
+
+}; // namespace utils::can
@@ -0,0 +1,292 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    TickSync.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the synchronization
+  *          of the control ticks of the boards on the CAN bus.
+  ******************************************************************************
+ */
+#include <utils/can/ticksync.hpp>
+#include <utils/fmt/format.hpp>
+#include <cstring>
+
+namespace utils::can{
+
+    /** \brief  CTickSync class constructor, the board doesn't synchronize its tick until the role is set.
+     *
+     *  @param f_period            period of the task in base ticks, it's the sync period
+     *  @param f_syncPeriod        sync period in second, the same on all boards
+     *  @param f_controlPeriod     period of the control ticks in second
+     *  @param f_transport         CAN transport, the sync identifier is stamped by it
+     *  @param f_timer             control timer
+     *  @param f_syncId            common identifier of the sync frames, it's accepted by the filters of all boards
+     */
+    CTickSync::CTickSync(uint32_t f_period, float f_syncPeriod, float f_controlPeriod, CCanTransport& f_transport, hardware::drivers::CControlTimer_TIM10& f_timer, uint16_t f_syncId)
+        : utils::task::CTask(f_period)
+        , m_transport(f_transport)
+        , m_timer(f_timer)
+        , m_syncId(f_syncId)
+        , m_controlPeriod(f_controlPeriod)
+        , m_ticksPerSync(f_syncPeriod / f_controlPeriod)
+        , m_role(ROLE_OFF)
+        , m_latency_ns(0)
+        , m_sequence(0)
+        , m_rxPhase(0)
+        , m_isRxValid(false)
+        , m_integral(0)
+        , m_error_ns(0)
+        , m_isLocked(false)
+        , m_lockCount(0)
+        , m_outlierCount(0)
+        , m_age(0)
+        , m_samples(0)
+        , m_outliers(0)
+    {
+        m_transport.setStamped(f_syncId, mbed::callback(this,&CTickSync::received), mbed::callback(this,&CTickSync::transmitted));
+    }
+
+    /** \brief  Set the role of the board, the trim of the control timer is cleared and the discipline restarts.
+     *
+     *  @param f_role              role of the board
+     */
+    void CTickSync::setRole(ERole f_role)
+    {
+        m_role = f_role;
+        m_isRxValid = false;
+        m_integral = 0;
+        m_isLocked = false;
+        m_lockCount = 0;
+        m_outlierCount = 0;
+        m_age = 0;
+        m_timer.setTrim(0.0f);
+    }
+
+    /** \brief  Set the latency of the receive stamp relative to the transmit stamp, it's the difference of the interrupt paths of
+     *  the master and of the slave, it's measured by an oscilloscope on the outputs of the control ticks.
+     *
+     *  @param f_latency_ns        latency in ns
+     */
+    void CTickSync::setLatency(int32_t f_latency_ns)
+    {
+        m_latency_ns = f_latency_ns;
+    }
+
+    /** \brief  Run method, the master broadcasts the sync frame, when the transmit queue is empty, so its stamp isn't coalesced with
+     *  the other frames. The slave unlocks the tick, when it doesn't receive samples.
+     */
+    void CTickSync::_run()
+    {
+        if (ROLE_MASTER == m_role)
+        {
+            if (m_transport.isIdle())
+            {
+                uint8_t l_data[2] = {s_sync, ++m_sequence};
+                m_transport.publish(m_syncId, l_data, sizeof(l_data));
+            }
+        }
+        else if (ROLE_SLAVE == m_role && ++m_age > s_timeoutPeriods)
+        {
+            m_age = s_timeoutPeriods;
+            m_isLocked = false;
+            m_lockCount = 0;
+        }
+    }
+
+    /** \brief  Callback of the received frames, the slave keeps the phase of the sync frame and it applies the matching follow-up.
+     *
+     *  @param f_frame             received frame
+     *  @param f_cycles            cycle counter of the interrupt
+     *  @param f_isValid           the stamp belongs to the frame
+     */
+    void CTickSync::received(const SCanFrame& f_frame, uint32_t f_cycles, bool f_isValid)
+    {
+        if (ROLE_SLAVE != m_role || f_frame.m_length < 2)
+        {
+            return;
+        }
+        if (s_sync == f_frame.m_data[0])
+        {
+            m_sequence = f_frame.m_data[1];
+            m_rxPhase = phase(f_cycles);
+            m_isRxValid = f_isValid;
+        }
+        else if (s_followUp == f_frame.m_data[0] && 6 == f_frame.m_length && m_isRxValid && f_frame.m_data[1] == m_sequence)
+        {
+            int32_t l_master_ns;
+            memcpy(&l_master_ns, f_frame.m_data + 2, sizeof(l_master_ns));
+            m_isRxValid = false;
+            float l_cyclesPerNs = SystemCoreClock * 1e-9f;
+            discipline(wrap(m_rxPhase - static_cast<int32_t>((l_master_ns + m_latency_ns) * l_cyclesPerNs)));
+        }
+    }
+
+    /** \brief  Callback of the transmitted sync frame, the master sends the phase of the transmission in the follow-up frame.
+     *
+     *  @param f_cycles            cycle counter of the interrupt
+     *  @param f_isValid           the stamp belongs to the transmission
+     */
+    void CTickSync::transmitted(uint32_t f_cycles, bool f_isValid)
+    {
+        if (ROLE_MASTER != m_role || !f_isValid)
+        {
+            return;
+        }
+        int32_t l_phase_ns = static_cast<int32_t>(phase(f_cycles) * (1e9f / SystemCoreClock));
+        uint8_t l_data[6] = {s_followUp, m_sequence};
+        memcpy(l_data + 2, &l_phase_ns, sizeof(l_phase_ns));
+        m_transport.publish(m_syncId, l_data, sizeof(l_data));
+    }
+
+    /** \brief  Apply a phase error on the trim of the control timer
+     *
+     *  The unlocked tick with large error is stepped by a single period, the other errors update the PI loop. The locked tick rejects
+     *  the outliers, the consecutive outliers unlock it.
+     *
+     *  @param f_error             phase error in cycles, positive when the local tick is earlier than the master's tick
+     */
+    void CTickSync::discipline(int32_t f_error)
+    {
+        m_error_ns = static_cast<int32_t>(f_error * (1e9f / SystemCoreClock));
+        int32_t l_abs_ns = (m_error_ns < 0) ? -m_error_ns : m_error_ns;
+        m_age = 0;
+        if (m_isLocked && l_abs_ns > s_outlierError)
+        {
+            m_outliers++;
+            if (++m_outlierCount < s_maxOutliers)
+            {
+                return;
+            }
+            m_isLocked = false;
+            m_lockCount = 0;
+        }
+        m_outlierCount = 0;
+        m_samples++;
+        float l_countPeriod = m_timer.getCountPeriod();
+        if (0.0f == l_countPeriod)
+        {
+            return;
+        }
+        float l_counts = f_error / (SystemCoreClock * l_countPeriod);
+        if (!m_isLocked && l_abs_ns > s_outlierError)
+        {
+            m_timer.step(static_cast<int32_t>((l_counts < 0.0f) ? l_counts - 0.5f : l_counts + 0.5f));
+            m_lockCount = 0;
+            return;
+        }
+        float l_maxTrim = s_maxTrim * m_controlPeriod / l_countPeriod;
+        m_integral += s_ki * l_counts / m_ticksPerSync;
+        m_integral = (m_integral > l_maxTrim) ? l_maxTrim : ((m_integral < -l_maxTrim) ? -l_maxTrim : m_integral);
+        float l_trim = m_integral + s_kp * l_counts / m_ticksPerSync;
+        m_timer.setTrim((l_trim > l_maxTrim) ? l_maxTrim : ((l_trim < -l_maxTrim) ? -l_maxTrim : l_trim));
+        if (l_abs_ns > s_lockError)
+        {
+            m_lockCount = 0;
+        }
+        else if (++m_lockCount >= s_lockSamples)
+        {
+            m_isLocked = true;
+        }
+    }
+
+    /** \brief  Phase of a cycle counter value after the last control tick, the ticks elapsed since the value are removed by the period.
+     *
+     *  @param f_cycles            cycle counter value
+     *  @return                    phase in cycles, in [0, period)
+     */
+    int32_t CTickSync::phase(uint32_t f_cycles) const
+    {
+        int32_t l_period = static_cast<int32_t>(m_controlPeriod * SystemCoreClock + 0.5f);
+        int32_t l_phase = static_cast<int32_t>(f_cycles - m_timer.getTickCycles()) % l_period;
+        return (l_phase < 0) ? l_phase + l_period : l_phase;
+    }
+
+    /** \brief  Wrap a phase difference in the half periods, the nearest ticks are compared.
+     *
+     *  @param f_cycles            phase difference in cycles
+     *  @return                    phase difference in (-period/2, period/2]
+     */
+    int32_t CTickSync::wrap(int32_t f_cycles) const
+    {
+        int32_t l_period = static_cast<int32_t>(m_controlPeriod * SystemCoreClock + 0.5f);
+        int32_t l_wrapped = f_cycles % l_period;
+        if (l_wrapped > l_period / 2)
+        {
+            l_wrapped -= l_period;
+        }
+        else if (l_wrapped <= -l_period / 2)
+        {
+            l_wrapped += l_period;
+        }
+        return l_wrapped;
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CTickSync::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text,l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(m_role).udec(m_isLocked ? 1 : 0).dec(m_error_ns).fixed(m_timer.getTrim(),3).udec(m_samples).udec(m_outliers).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_role;
+            if (!utils::fmt::parseUint(l_text,l_role))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else if (l_role > ROLE_SLAVE)
+            {
+                sprintf(b,"invalid parameters;;");
+            }
+            else
+            {
+                setRole(static_cast<ERole>(l_role));
+                sprintf(b,"ack;;");
+            }
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            int32_t l_latency;
+            if (!utils::fmt::parseInt(l_text,l_latency))
+            {
+                sprintf(b,"sintax error;;");
+            }
+            else
+            {
+                setLatency(l_latency);
+                sprintf(b,"ack;;");
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace utils::can
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    BoardClock.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the monotonic 
+  *          microsecond clock of the board.
+  ******************************************************************************
+ */
+#include <utils/clock/boardclock.hpp>
+
+namespace utils::clock{
+
+    uint32_t CBoardClock::s_last = 0;
+    uint32_t CBoardClock::s_wraps = 0;
+    volatile bool CBoardClock::s_isStamping = false;
+
+    /** \brief  Extended 64-bit time, a wrap is detected, when the ticker is lower than at the previous call. It can be applied 
+     *  from any context.
+     *
+     *  @return                time since the start in microsecond
+     */
+    uint64_t CBoardClock::now()
+    {
+        core_util_critical_section_enter();
+        uint32_t l_now = us_ticker_read();
+        if (l_now < s_last)
+        {
+            s_wraps++;
+        }
+        s_last = l_now;
+        uint64_t l_time = (static_cast<uint64_t>(s_wraps) << 32) | l_now;
+        core_util_critical_section_exit();
+        return l_time;
+    }
+
+}; // namespace utils::clock
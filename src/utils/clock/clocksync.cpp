@@ -0,0 +1,183 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    ClockSync.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the clock synchronization 
+  *          with the host.
+  ******************************************************************************
+ */
+#include <utils/clock/clocksync.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace utils::clock{
+
+    /** \brief  CClockSync class constructor
+     *
+     *  @param f_period            period of the supervision in base ticks
+     */
+    CClockSync::CClockSync(uint32_t f_period)
+        : CTask(f_period)
+        , m_offset(0)
+        , m_reference(0)
+        , m_drift(0)
+        , m_minDelay(0)
+        , m_delay(0)
+        , m_samples(0)
+        , m_pending()
+        , m_hasPending(false)
+        , m_isSynchronized(false)
+    {
+    }
+
+    /** \brief  Apply a ping of the host, it completes the previous exchange with its receive time.
+     *
+     *  @param f_t1                transmit time of the ping in host clock
+     *  @param f_t4                receive time of the previous response in host clock, zero, when it's unknown
+     *  @param f_t2                receive time of the ping in board clock
+     *  @param f_t3                transmit time of the response in board clock
+     */
+    void CClockSync::ping(uint32_t f_t1, uint32_t f_t4, uint32_t& f_t2, uint32_t& f_t3)
+    {
+        f_t2 = CBoardClock::now32();
+        if (m_hasPending && f_t4 != 0)
+        {
+            update(m_pending[0], m_pending[1], m_pending[2], f_t4);
+        }
+        f_t3 = CBoardClock::now32();
+        m_pending[0] = f_t1;
+        m_pending[1] = f_t2;
+        m_pending[2] = f_t3;
+        m_hasPending = true;
+    }
+
+    /** \brief  Update the estimate with a complete exchange
+     *
+     *  The first sample initializes the offset, the next ones correct the offset predicted by the drift.
+     *
+     *  @param f_t1                transmit time of the ping in host clock
+     *  @param f_t2                receive time of the ping in board clock
+     *  @param f_t3                transmit time of the response in board clock
+     *  @param f_t4                receive time of the response in host clock
+     */
+    void CClockSync::update(uint32_t f_t1, uint32_t f_t2, uint32_t f_t3, uint32_t f_t4)
+    {
+        int32_t l_delay = static_cast<int32_t>(f_t4 - f_t1) - static_cast<int32_t>(f_t3 - f_t2);
+        if (l_delay < 0)
+        {
+            return;
+        }
+        m_delay = l_delay;
+        if (m_samples == 0 || static_cast<uint32_t>(l_delay) < m_minDelay)
+        {
+            m_minDelay = l_delay;
+        }
+        else
+        {
+            // The minimum follows slowly the increased delays, so a change of the link isn't rejected forever
+            m_minDelay += (l_delay - m_minDelay) / 64;
+        }
+        if (m_samples > 0 && static_cast<uint32_t>(l_delay) > 2 * m_minDelay + s_delayMargin)
+        {
+            return;
+        }
+        uint32_t l_offset = (f_t2 - f_t1) - static_cast<uint32_t>(l_delay / 2);
+        core_util_critical_section_enter();
+        if (m_samples == 0)
+        {
+            m_offset = l_offset;
+            m_drift = 0;
+        }
+        else
+        {
+            int32_t l_elapsed = static_cast<int32_t>(f_t2 - m_reference);
+            uint32_t l_predicted = m_offset + static_cast<int32_t>(m_drift * l_elapsed);
+            int32_t l_residual = static_cast<int32_t>(l_offset - l_predicted);
+            m_offset = l_predicted + static_cast<int32_t>(s_alpha * l_residual);
+            if (l_elapsed > 0)
+            {
+                m_drift += s_beta * l_residual / l_elapsed;
+            }
+        }
+        m_reference = f_t2;
+        m_samples++;
+        m_isSynchronized = true;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Convert a board time to host time by the estimated offset and drift
+     *
+     *  @param f_board             time in board clock
+     *  @return                    time in host clock
+     */
+    uint32_t CClockSync::toHost(uint32_t f_board) const
+    {
+        core_util_critical_section_enter();
+        uint32_t l_offset = m_offset + static_cast<int32_t>(m_drift * static_cast<int32_t>(f_board - m_reference));
+        core_util_critical_section_exit();
+        return f_board - l_offset;
+    }
+
+    /** \brief  Run method, it extends the 64-bit board clock and it invalidates the old estimate
+     */
+    void CClockSync::_run()
+    {
+        uint32_t l_now = static_cast<uint32_t>(CBoardClock::now());
+        if (m_isSynchronized && l_now - m_reference > s_timeout)
+        {
+            m_isSynchronized = false;
+        }
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input string
+     *  @param b                   output string
+     */
+    void CClockSync::serialCallback(char const * a, char * b)
+    {
+        int l_command;
+        unsigned long l_first = 0, l_second = 0;
+        int32_t l_res = sscanf(a,"%d;%lu;%lu",&l_command,&l_first,&l_second);
+        if (1 > l_res)
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(m_isSynchronized ? 1 : 0).udec(m_offset).fixed(getDrift(),3).udec(m_delay).udec(m_samples).chr(';');
+        }
+        else if (1 == l_command && 3 == l_res)
+        {
+            uint32_t l_t2, l_t3;
+            ping(l_first, l_second, l_t2, l_t3);
+            sprintf(b,"ack;;%lu;%lu;%lu;", l_first, static_cast<unsigned long>(l_t2), static_cast<unsigned long>(l_t3));
+        }
+        else if (2 == l_command && 2 == l_res)
+        {
+            CBoardClock::setStamping(l_first != 0);
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace utils::clock
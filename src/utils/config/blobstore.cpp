@@ -0,0 +1,169 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    BlobStore.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the persisted store
+  *          of a binary configuration.
+  ******************************************************************************
+ */
+
+#include <utils/config/blobstore.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <cstring>
+
+namespace utils::config{
+
+    /** \brief  CBlobStore class constructor, the store is empty until the load.
+     *
+     *  @param f_sector        sector of the area
+     *  @param f_offset        offset of the area in the sector, word aligned, the area lasts until the end of the sector
+     */
+    CBlobStore::CBlobStore(const hardware::drivers::CInternalFlash::SSector& f_sector, uint32_t f_offset)
+        : m_sector(f_sector)
+        , m_offset(f_offset & ~3U)
+        , m_slotCount((f_offset < f_sector.m_size) ? (f_sector.m_size - (f_offset & ~3U)) / (s_slotWords * 4) : 0)
+        , m_free(0)
+        , m_sequence(0)
+        , m_blob(NULL)
+        , m_length(0)
+        , m_isEnabled(false)
+        , m_guard()
+        , m_record()
+    {
+    }
+
+    /** \brief  Load the last valid record. When all slots are used, the sector is erased and the last record is programmed
+     *  in the first slot, so it has to be applied before the start of the watchdog and of the control loop.
+     *
+     *  @return                true, when a configuration is loaded from the flash
+     */
+    bool CBlobStore::load()
+    {
+        m_isEnabled = (m_slotCount > 0) && hardware::drivers::CInternalFlash::isFree(m_sector.m_address);
+        if (!m_isEnabled)
+        {
+            return false;
+        }
+        const uint32_t* l_last = NULL;
+        m_free = m_slotCount;
+        for (uint32_t i = 0; i < m_slotCount; ++i)
+        {
+            const uint32_t* l_record = reinterpret_cast<const uint32_t*>(slotAddress(i));
+            if (hardware::drivers::CInternalFlash::s_erased == l_record[0])
+            {
+                m_free = (m_free < i) ? m_free : i;
+            }
+            else if (isValid(l_record) && (NULL == l_last || static_cast<int32_t>(l_record[2] - m_sequence) > 0))
+            {
+                l_last = l_record;
+                m_sequence = l_record[2];
+            }
+        }
+        if (m_free >= m_slotCount)
+        {
+            // Compaction of the full area, the last record is kept
+            bool l_keep = (NULL != l_last);
+            if (l_keep)
+            {
+                memcpy(m_record, l_last, s_slotWords * 4);
+            }
+            hardware::drivers::CInternalFlash::erase(m_sector);
+            m_free = 0;
+            l_last = NULL;
+            if (l_keep && program())
+            {
+                l_last = reinterpret_cast<const uint32_t*>(slotAddress(0));
+            }
+        }
+        m_blob = (NULL != l_last) ? reinterpret_cast<const uint8_t*>(l_last + s_headerWords) : NULL;
+        m_length = (NULL != l_last) ? l_last[1] : 0;
+        return NULL != m_blob;
+    }
+
+    /** \brief  Save the configuration in the next free slot, the loaded configuration isn't changed, the new one is applied
+     *  by the load at the next reset.
+     *
+     *  @param f_blob          bytes of the configuration
+     *  @param f_length        length of the configuration, at most s_maxLength
+     *  @return                true, when the record is written
+     */
+    bool CBlobStore::save(const uint8_t* f_blob, uint32_t f_length)
+    {
+        if (!m_isEnabled || (m_guard && !m_guard()) || 0 == f_length || f_length > s_maxLength || m_free >= m_slotCount)
+        {
+            return false;
+        }
+        memset(m_record, 0xFF, sizeof(m_record));
+        m_record[0] = s_magic;
+        m_record[1] = f_length;
+        m_record[2] = m_sequence + 1;
+        memcpy(m_record + s_headerWords, f_blob, f_length);
+        m_record[s_slotWords - 1] = checksum(m_record);
+        if (!program())
+        {
+            return false;
+        }
+        m_sequence++;
+        return true;
+    }
+
+    /** \brief  Set the write guard, the saving is refused, while it returns false.
+     *
+     *  @param f_guard         write guard
+     */
+    void CBlobStore::setWriteGuard(FWriteGuard f_guard)
+    {
+        m_guard = f_guard;
+    }
+
+    /** \brief  Program the record buffer in the first free slot. The magic word is programmed first and the checksum last,
+     *  so an interrupted writing leaves an invalid record, the previous one remains the last valid.
+     *
+     *  @return                true, when the record is written
+     */
+    bool CBlobStore::program()
+    {
+        uint32_t l_address = slotAddress(m_free);
+        // The slot is consumed also by a failed writing
+        m_free++;
+        return hardware::drivers::CInternalFlash::program(l_address, m_record, 1)
+            && hardware::drivers::CInternalFlash::program(l_address + 4, m_record + 1, s_slotWords - 1);
+    }
+
+    /** \brief  Validate a slot by the magic word, by the length and by the checksum
+     *
+     *  @param f_record        words of the slot
+     *  @return                true, when the slot contains a valid record
+     */
+    bool CBlobStore::isValid(const uint32_t* f_record) const
+    {
+        return s_magic == f_record[0] && f_record[1] > 0 && f_record[1] <= s_maxLength && f_record[s_slotWords - 1] == checksum(f_record);
+    }
+
+    /** \brief  Checksum of a record, CRC16 of the length, of the sequence number and of the bytes.
+     *
+     *  @param f_record        record with valid header
+     *  @return                checksum
+     */
+    uint32_t CBlobStore::checksum(const uint32_t* f_record) const
+    {
+        return utils::serial::CBinaryProtocol::crc16(reinterpret_cast<const uint8_t*>(f_record + 1), (s_headerWords - 1) * 4 + f_record[1]);
+    }
+
+}; // namespace utils::config
@@ -0,0 +1,381 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    ConfigStore.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the persisted configuration store.
+  ******************************************************************************
+ */
+
+#include <utils/config/configstore.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <cstring>
+
+namespace utils::config{
+
+    /** \brief  CConfigStore class constructor, the default values are applied until the load.
+     *
+     *  @param f_first         first sector of the store
+     *  @param f_second        second sector of the store, with the same size
+     *  @param f_parameters    table of the parameters, it has to remain valid
+     *  @param f_values        values of the parameters, array with f_count elements
+     *  @param f_count         number of the parameters, at most s_maxParameters
+     *  @param f_version       version of the layout, it has to be changed after each change of the parameter table
+     */
+    CConfigStore::CConfigStore(const hardware::drivers::CInternalFlash::SSector&  f_first
+                              ,const hardware::drivers::CInternalFlash::SSector&  f_second
+                              ,const SParameter*                                  f_parameters
+                              ,float*                                             f_values
+                              ,uint8_t                                            f_count
+                              ,uint16_t                                           f_version)
+        : m_sectors{f_first, f_second}
+        , m_parameters(f_parameters)
+        , m_values(f_values)
+        , m_count(f_count < s_maxParameters ? f_count : s_maxParameters)
+        , m_version(f_version)
+        , m_slotWords(s_headerWords + m_count + 1)
+        , m_slotCount(f_first.m_size / (m_slotWords * 4))
+        , m_active(0)
+        , m_free(0)
+        , m_sequence(0)
+        , m_isSpareBlank(false)
+        , m_isEnabled(false)
+        , m_isLoaded(false)
+        , m_guard()
+        , m_workQueue(NULL)
+    {
+        restoreDefaults();
+    }
+
+    /** \brief  Load the values from the last valid record. The sector, which doesn't contain the last record, is erased, 
+     *  so it has to be applied before the start of the watchdog and of the control loop.
+     *
+     *  @return                true, when the values are loaded from the flash
+     */
+    bool CConfigStore::load()
+    {
+        m_isEnabled = hardware::drivers::CInternalFlash::isFree(m_sectors[0].m_address) 
+                   && hardware::drivers::CInternalFlash::isFree(m_sectors[1].m_address);
+        if (!m_isEnabled)
+        {
+            return false;
+        }
+        const uint32_t* l_last[2];
+        uint32_t l_sequence[2];
+        scan(0, l_last[0], l_sequence[0]);
+        scan(1, l_last[1], l_sequence[1]);
+        m_active = (NULL == l_last[0] || (NULL != l_last[1] && static_cast<int32_t>(l_sequence[1] - l_sequence[0]) > 0)) ? 1 : 0;
+        if (NULL == l_last[m_active])
+        {
+            // Without valid record both sectors are reinitialized
+            m_active = 0;
+            m_sequence = 0;
+            if (!isBlank(0))
+            {
+                hardware::drivers::CInternalFlash::erase(m_sectors[0]);
+            }
+        }
+        else
+        {
+            m_sequence = l_sequence[m_active];
+        }
+        uint8_t l_spare = 1 - m_active;
+        if (!isBlank(l_spare))
+        {
+            hardware::drivers::CInternalFlash::erase(m_sectors[l_spare]);
+        }
+        m_isSpareBlank = isBlank(l_spare);
+        // First free slot of the active sector
+        m_free = 0;
+        while (m_free < m_slotCount && hardware::drivers::CInternalFlash::s_erased != *reinterpret_cast<const uint32_t*>(slotAddress(m_active, m_free)))
+        {
+            m_free++;
+        }
+        const uint32_t* l_record = l_last[m_active];
+        m_isLoaded = (NULL != l_record && (l_record[1] & 0xFFFF) == m_version && (l_record[1] >> 16) == m_count);
+        if (m_isLoaded)
+        {
+            memcpy(m_values, l_record + s_headerWords, m_count * sizeof(float));
+        }
+        return m_isLoaded;
+    }
+
+    /** \brief  Save the values in a new record. The magic word is programmed first and the checksum last, 
+     *  so an interrupted writing leaves an invalid record, the previous one remains the last valid.
+     *
+     *  @return                true, when the record is written
+     */
+    bool CConfigStore::save()
+    {
+        if (!m_isEnabled || (m_guard && !m_guard()))
+        {
+            return false;
+        }
+        if (m_free >= m_slotCount)
+        {
+            if (!m_isSpareBlank)
+            {
+                return false;
+            }
+            m_active = 1 - m_active;
+            m_free = 0;
+            m_isSpareBlank = false;
+        }
+        uint32_t l_record[s_headerWords + s_maxParameters + 1];
+        l_record[0] = s_magic;
+        l_record[1] = static_cast<uint32_t>(m_version) | (static_cast<uint32_t>(m_count) << 16);
+        l_record[2] = m_sequence + 1;
+        memcpy(l_record + s_headerWords, m_values, m_count * sizeof(float));
+        l_record[m_slotWords - 1] = checksum(l_record);
+        uint32_t l_address = slotAddress(m_active, m_free);
+        // The slot is consumed also by a failed writing
+        m_free++;
+        if (!hardware::drivers::CInternalFlash::program(l_address, l_record, 1)
+           || !hardware::drivers::CInternalFlash::program(l_address + 4, l_record + 1, m_slotWords - 1))
+        {
+            return false;
+        }
+        m_sequence++;
+        return true;
+    }
+
+    /** \brief  Index of a parameter
+     *
+     *  @param f_key           name of the parameter
+     *  @return                index in the table, negative, when the name is unknown
+     */
+    int32_t CConfigStore::find(const char* f_key) const
+    {
+        for (uint8_t i = 0; i < m_count; ++i)
+        {
+            if (0 == strcmp(m_parameters[i].m_key, f_key))
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /** \brief  Set the value of a parameter, it's saved only by the next 'save'.
+     *
+     *  @param f_key           name of the parameter
+     *  @param f_value         new value
+     *  @return                true, when the parameter exists
+     */
+    bool CConfigStore::set(const char* f_key, float f_value)
+    {
+        int32_t l_idx = find(f_key);
+        if (l_idx < 0)
+        {
+            return false;
+        }
+        m_values[l_idx] = f_value;
+        return true;
+    }
+
+    /** \brief  Restore the default values of the parameter table, they're saved only by the next 'save'.
+     */
+    void CConfigStore::restoreDefaults()
+    {
+        for (uint8_t i = 0; i < m_count; ++i)
+        {
+            m_values[i] = m_parameters[i].m_default;
+        }
+    }
+
+    /** \brief  Set the write guard, the records are written only, when it returns true.
+     *
+     *  @param f_guard         write guard
+     */
+    void CConfigStore::setWriteGuard(FWriteGuard f_guard)
+    {
+        m_guard = f_guard;
+    }
+
+    /** \brief  Set the work queue, the serial callback posts the saving in it instead of writing the flash.
+     *
+     *  @param f_workQueue     work queue, NULL applies the saving in the serial callback
+     */
+    void CConfigStore::setWorkQueue(utils::task::CWorkQueue* f_workQueue)
+    {
+        m_workQueue = f_workQueue;
+    }
+
+    /** \brief  Serial callback to set a value. The string has to contain the name of the parameter and the value ("PID0KP;0.115").
+     *  The values are applied after the next reset.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CConfigStore::serialCallbackSet(char const * a, char * b)
+    {
+        char l_key[s_maxKeyLength + 1];
+        float l_value;
+        uint32_t l_res = sscanf(a,"%15[^;];%f",l_key,&l_value);
+        if (2 == l_res && set(l_key, l_value))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Serial callback to get a value. The string has to contain the name of the parameter, the response contains the actual value.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CConfigStore::serialCallbackGet(char const * a, char * b)
+    {
+        char l_key[s_maxKeyLength + 1];
+        int32_t l_idx = (1 == sscanf(a,"%15[^;]",l_key)) ? find(l_key) : -1;
+        if (l_idx >= 0)
+        {
+            sprintf(b,"%.6g;;",m_values[l_idx]);
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Serial callback to save the values in the flash. With a work queue the request is acknowledged and the saving is posted, 
+     *  its result is sent later with the same key.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CConfigStore::serialCallbackSave(char const * a, char * b)
+    {
+        if (!m_isEnabled)
+        {
+            sprintf(b,"The configuration store isn't available;;");
+        }
+        else if (m_guard && !m_guard())
+        {
+            sprintf(b,"The configuration can't be saved, while the robot moves;;");
+        }
+        else if (m_workQueue == NULL)
+        {
+            saveWork(b);
+        }
+        else if (m_workQueue->post("CFGW", mbed::callback(this,&CConfigStore::saveWork)))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"The work queue is full;;");
+        }
+    }
+
+    /** \brief  Save the values and write the result message. The write guard is checked again, the robot can start between the 
+     *  request and the deferred saving.
+     *
+     *  @param f_result            result message
+     */
+    void CConfigStore::saveWork(char* f_result)
+    {
+        if (m_guard && !m_guard())
+        {
+            sprintf(f_result,"The configuration can't be saved, while the robot moves;;");
+        }
+        else if (save())
+        {
+            sprintf(f_result,"%s;;", m_workQueue == NULL ? "ack" : "saved");
+        }
+        else
+        {
+            sprintf(f_result,"The configuration store is full, it's compacted after reset;;");
+        }
+    }
+
+    /** \brief  Serial callback to restore the default values, they have to be saved to apply them after the next reset.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CConfigStore::serialCallbackDefault(char const * a, char * b)
+    {
+        restoreDefaults();
+        sprintf(b,"ack;;");
+    }
+
+    /** \brief  Scan the records of a sector, until the first free slot.
+     *
+     *  @param f_sector        index of the sector
+     *  @param f_last          last valid record, NULL without valid record
+     *  @param f_sequence      sequence number of the last valid record
+     */
+    void CConfigStore::scan(uint8_t f_sector, const uint32_t*& f_last, uint32_t& f_sequence)
+    {
+        f_last = NULL;
+        f_sequence = 0;
+        for (uint32_t i = 0; i < m_slotCount; ++i)
+        {
+            const uint32_t* l_record = reinterpret_cast<const uint32_t*>(slotAddress(f_sector, i));
+            if (hardware::drivers::CInternalFlash::s_erased == l_record[0])
+            {
+                break;
+            }
+            if (s_magic == l_record[0] && (l_record[1] >> 16) <= s_maxParameters)
+            {
+                uint32_t l_words = s_headerWords + (l_record[1] >> 16) + 1;
+                if (l_words == m_slotWords && l_record[l_words - 1] == checksum(l_record)
+                   && (NULL == f_last || static_cast<int32_t>(l_record[2] - f_sequence) > 0))
+                {
+                    f_last = l_record;
+                    f_sequence = l_record[2];
+                }
+            }
+        }
+    }
+
+    /** \brief  Checksum of a record, CRC16 of the version, of the sequence number and of the values.
+     *
+     *  @param f_record        record with valid header
+     *  @return                checksum
+     */
+    uint32_t CConfigStore::checksum(const uint32_t* f_record) const
+    {
+        uint32_t l_count = f_record[1] >> 16;
+        return utils::serial::CBinaryProtocol::crc16(reinterpret_cast<const uint8_t*>(f_record + 1), (s_headerWords - 1 + l_count) * 4);
+    }
+
+    /** \brief  The sector is erased
+     *
+     *  @param f_sector        index of the sector
+     *  @return                true, when all words of the sector are erased
+     */
+    bool CConfigStore::isBlank(uint8_t f_sector) const
+    {
+        const uint32_t* l_words = reinterpret_cast<const uint32_t*>(m_sectors[f_sector].m_address);
+        for (uint32_t i = 0; i < m_sectors[f_sector].m_size / 4; ++i)
+        {
+            if (hardware::drivers::CInternalFlash::s_erased != l_words[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}; // namespace utils::config
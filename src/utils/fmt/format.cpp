@@ -0,0 +1,326 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    Format.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the definition of the number formatting and 
+  *          parsing routines of the text protocol.
+  ******************************************************************************
+ */
+#include <utils/fmt/format.hpp>
+
+namespace utils::fmt{
+
+    /** @brief  Powers of ten of the decimals */
+    static const uint32_t s_decimalPowers[] = {1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL};
+    /** @brief  Powers of ten of the float parser */
+    static const float s_powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+    /** @brief  Maximum number of the significant digits of a parsed float, the further digits only scale the value */
+    static const uint8_t s_maxDigits = 9;
+
+    /** \brief  Write the digits of an unsigned integer, at least the given number of digits (zero padded)
+     *
+     *  @param f_buffer            first character, the text isn't terminated
+     *  @param f_value             value
+     *  @param f_width             minimum number of the digits
+     *  @return                    number of the written characters
+     */
+    static uint32_t writeDigits(char* f_buffer, uint32_t f_value, uint8_t f_width)
+    {
+        char l_digits[10];
+        uint8_t l_count = 0;
+        do
+        {
+            l_digits[l_count++] = '0' + (f_value % 10);
+            f_value /= 10;
+        }
+        while (f_value != 0 || l_count < f_width);
+        for (uint8_t l_idx = 0; l_idx < l_count; l_idx++)
+        {
+            f_buffer[l_idx] = l_digits[l_count - 1 - l_idx];
+        }
+        return l_count;
+    }
+
+    /** \brief  Format an unsigned integer in decimal
+     *
+     *  @param f_buffer            buffer, the text is null terminated
+     *  @param f_value             value
+     *  @return                    number of the written characters, without the terminating character
+     */
+    uint32_t formatUint(char* f_buffer, uint32_t f_value)
+    {
+        uint32_t l_length = writeDigits(f_buffer, f_value, 1);
+        f_buffer[l_length] = '\0';
+        return l_length;
+    }
+
+    /** \brief  Format a signed integer in decimal
+     *
+     *  @param f_buffer            buffer, the text is null terminated
+     *  @param f_value             value
+     *  @return                    number of the written characters, without the terminating character
+     */
+    uint32_t formatInt(char* f_buffer, int32_t f_value)
+    {
+        if (f_value < 0)
+        {
+            *f_buffer = '-';
+            return 1 + formatUint(f_buffer + 1, 0U - static_cast<uint32_t>(f_value));
+        }
+        return formatUint(f_buffer, static_cast<uint32_t>(f_value));
+    }
+
+    /** \brief  Format an unsigned integer in hexadecimal with upper case digits (e.g. '1F')
+     *
+     *  @param f_buffer            buffer, the text is null terminated
+     *  @param f_value             value
+     *  @return                    number of the written characters, without the terminating character
+     */
+    uint32_t formatHex(char* f_buffer, uint32_t f_value)
+    {
+        static const char s_hex[] = "0123456789ABCDEF";
+        uint8_t l_count = 1;
+        while (l_count < 8 && (f_value >> (4 * l_count)) != 0)
+        {
+            l_count++;
+        }
+        for (uint8_t l_idx = 0; l_idx < l_count; l_idx++)
+        {
+            f_buffer[l_idx] = s_hex[(f_value >> (4 * (l_count - 1 - l_idx))) & 0xF];
+        }
+        f_buffer[l_count] = '\0';
+        return l_count;
+    }
+
+    /** \brief  Format a float with fixed number of decimals as '%.*f', the integer and the fraction part are written by integer arithmetic.
+     *          The not-a-number is written as 'nan' and the magnitudes above s_maxFloat as 'inf'.
+     *
+     *  @param f_buffer            buffer, the text is null terminated
+     *  @param f_value             value
+     *  @param f_decimals          number of the decimals, it's limited to s_maxDecimals
+     *  @return                    number of the written characters, without the terminating character
+     */
+    uint32_t formatFloat(char* f_buffer, float f_value, uint8_t f_decimals)
+    {
+        char* l_end = f_buffer;
+        if (f_value != f_value)
+        {
+            l_end[0] = 'n'; l_end[1] = 'a'; l_end[2] = 'n'; l_end[3] = '\0';
+            return 3;
+        }
+        if (f_value < 0.0f)
+        {
+            *l_end++ = '-';
+            f_value = -f_value;
+        }
+        if (f_value > s_maxFloat)
+        {
+            l_end[0] = 'i'; l_end[1] = 'n'; l_end[2] = 'f'; l_end[3] = '\0';
+            return l_end + 3 - f_buffer;
+        }
+        if (f_decimals > s_maxDecimals)
+        {
+            f_decimals = s_maxDecimals;
+        }
+        uint32_t l_integer = static_cast<uint32_t>(f_value);
+        const uint32_t l_scale = s_decimalPowers[f_decimals];
+        uint32_t l_fraction = static_cast<uint32_t>((f_value - static_cast<float>(l_integer)) * static_cast<float>(l_scale) + 0.5f);
+        // The rounding carries into the integer part (e.g. 0.999 with two decimals)
+        if (l_fraction >= l_scale)
+        {
+            l_fraction -= l_scale;
+            l_integer++;
+        }
+        l_end += writeDigits(l_end, l_integer, 1);
+        if (f_decimals > 0)
+        {
+            *l_end++ = '.';
+            l_end += writeDigits(l_end, l_fraction, f_decimals);
+        }
+        *l_end = '\0';
+        return l_end - f_buffer;
+    }
+
+    /** \brief  Parse the digits of a decimal integer, the overflow is rejected
+     *
+     *  @param f_text              first character, it's moved after the number
+     *  @param f_value             parsed value
+     *  @param f_signed            the sign is allowed and the range is the signed 32-bit range
+     *  @return                    false, when the text doesn't start with an integer or it overflows
+     */
+    static bool parseInteger(const char*& f_text, uint32_t& f_value, bool f_signed)
+    {
+        const char* l_text = f_text;
+        while (*l_text == ' ')
+        {
+            l_text++;
+        }
+        bool l_negative = f_signed && (*l_text == '-');
+        if (l_negative || (f_signed && *l_text == '+'))
+        {
+            l_text++;
+        }
+        if (*l_text < '0' || *l_text > '9')
+        {
+            return false;
+        }
+        const uint32_t l_limit = f_signed ? (l_negative ? 0x80000000UL : 0x7FFFFFFFUL) : 0xFFFFFFFFUL;
+        uint32_t l_value = 0;
+        for (; *l_text >= '0' && *l_text <= '9'; l_text++)
+        {
+            uint32_t l_digit = *l_text - '0';
+            if (l_value > (l_limit - l_digit) / 10)
+            {
+                return false;
+            }
+            l_value = 10 * l_value + l_digit;
+        }
+        f_value = l_negative ? 0U - l_value : l_value;
+        f_text = l_text;
+        return true;
+    }
+
+    /** \brief  Parse an unsigned decimal integer
+     *
+     *  @param f_text              first character, it's moved after the number
+     *  @param f_value             parsed value
+     *  @return                    false, when the text doesn't start with an integer or it overflows
+     */
+    bool parseUint(const char*& f_text, uint32_t& f_value)
+    {
+        return parseInteger(f_text, f_value, false);
+    }
+
+    /** \brief  Parse a signed decimal integer
+     *
+     *  @param f_text              first character, it's moved after the number
+     *  @param f_value             parsed value
+     *  @return                    false, when the text doesn't start with an integer or it overflows
+     */
+    bool parseInt(const char*& f_text, int32_t& f_value)
+    {
+        uint32_t l_value;
+        if (!parseInteger(f_text, l_value, true))
+        {
+            return false;
+        }
+        f_value = static_cast<int32_t>(l_value);
+        return true;
+    }
+
+    /** \brief  Parse a decimal number with optional sign, fraction and exponent (e.g. '-0.25', '1e-3')
+     *
+     *  @param f_text              first character, it's moved after the number
+     *  @param f_value             parsed value
+     *  @return                    false, when the text doesn't start with a number
+     */
+    bool parseFloat(const char*& f_text, float& f_value)
+    {
+        const char* l_text = f_text;
+        while (*l_text == ' ')
+        {
+            l_text++;
+        }
+        bool l_negative = (*l_text == '-');
+        if (l_negative || *l_text == '+')
+        {
+            l_text++;
+        }
+        uint32_t l_mantissa = 0;
+        uint8_t l_digits = 0;
+        int32_t l_exponent = 0;
+        bool l_hasDigit = false;
+        for (; *l_text >= '0' && *l_text <= '9'; l_text++)
+        {
+            l_hasDigit = true;
+            if (l_digits < s_maxDigits)
+            {
+                l_mantissa = 10 * l_mantissa + (*l_text - '0');
+                l_digits += (l_mantissa != 0);
+            }
+            else
+            {
+                l_exponent++;
+            }
+        }
+        if (*l_text == '.')
+        {
+            for (l_text++; *l_text >= '0' && *l_text <= '9'; l_text++)
+            {
+                l_hasDigit = true;
+                if (l_digits < s_maxDigits)
+                {
+                    l_mantissa = 10 * l_mantissa + (*l_text - '0');
+                    l_digits += (l_mantissa != 0);
+                    l_exponent--;
+                }
+            }
+        }
+        if (!l_hasDigit)
+        {
+            return false;
+        }
+        if (*l_text == 'e' || *l_text == 'E')
+        {
+            l_text++;
+            int32_t l_power;
+            if (!parseInt(l_text, l_power) || l_power > 38 || l_power < -45)
+            {
+                return false;
+            }
+            l_exponent += l_power;
+        }
+        float l_value = static_cast<float>(l_mantissa);
+        while (l_exponent > 0)
+        {
+            int32_t l_step = (l_exponent < 9) ? l_exponent : 9;
+            l_value *= s_powers[l_step];
+            l_exponent -= l_step;
+        }
+        while (l_exponent < 0)
+        {
+            int32_t l_step = (-l_exponent < 9) ? -l_exponent : 9;
+            l_value /= s_powers[l_step];
+            l_exponent += l_step;
+        }
+        f_value = l_negative ? -l_value : l_value;
+        f_text = l_text;
+        return true;
+    }
+
+    /** \brief  Parse the floats separated by ';' (e.g. '0.1;2;-3e-2'), it stops at the first malformed value as sscanf
+     *
+     *  @param f_text              text
+     *  @param f_values            parsed values
+     *  @param f_count             number of the expected values
+     *  @return                    number of the parsed values
+     */
+    uint8_t parseFloats(const char* f_text, float* f_values, uint8_t f_count)
+    {
+        for (uint8_t l_idx = 0; l_idx < f_count; l_idx++)
+        {
+            if ((l_idx > 0 && *f_text++ != ';') || !parseFloat(f_text, f_values[l_idx]))
+            {
+                return l_idx;
+            }
+        }
+        return f_count;
+    }
+
+}; // namespace utils::fmt
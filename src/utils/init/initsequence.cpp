@@ -0,0 +1,117 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    InitSequence.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the prioritized 
+  *          initialization sequence of the platform.
+  ******************************************************************************
+ */
+#include <utils/init/initsequence.hpp>
+
+namespace utils::init{
+
+    /** \brief  CInitSequence class constructor
+     *
+     *  @param f_stages            list of the stages
+     *  @param f_nrStages          number of the stages
+     */
+    CInitSequence::CInitSequence(SStage* f_stages, uint32_t f_nrStages)
+        : m_stages(f_stages)
+        , m_nrStages(f_nrStages)
+        , m_total(0)
+        , m_ready(0)
+        , m_failed(0)
+    {
+    }
+
+    /** \brief  Apply the stages phase by phase, inside of a phase in the order of the list. 
+     *
+     *  @return                    true, when all stages succeeded
+     */
+    bool CInitSequence::run()
+    {
+        uint32_t l_start = us_ticker_read();
+        m_failed = 0;
+        for (uint32_t l_phase = HARDWARE; l_phase < PHASE_COUNT; ++l_phase)
+        {
+            for (uint32_t i = 0; i < m_nrStages; ++i)
+            {
+                SStage& l_stage = m_stages[i];
+                if (l_stage.m_phase != l_phase)
+                {
+                    continue;
+                }
+                uint32_t l_stageStart = us_ticker_read();
+                l_stage.m_isFailed = l_stage.m_init ? !l_stage.m_init() : false;
+                l_stage.m_duration = us_ticker_read() - l_stageStart;
+                if (l_stage.m_isFailed)
+                {
+                    m_failed++;
+                }
+            }
+            if (l_phase == CONTROL)
+            {
+                m_ready = us_ticker_read() - l_start;
+            }
+        }
+        m_total = us_ticker_read() - l_start;
+        return m_failed == 0;
+    }
+
+    /** \brief  Send the ready message and the failed stages on the response lane, it doesn't wait for the transmission.
+     *
+     *  @param f_transmitter       transmitter of the message
+     */
+    void CInitSequence::report(utils::serial::CSerialTransmitter& f_transmitter) const
+    {
+        f_transmitter.printf("@BOOT:ready %lu us;;\r\n", static_cast<unsigned long>(m_ready));
+        for (uint32_t i = 0; i < m_nrStages; ++i)
+        {
+            if (m_stages[i].m_isFailed)
+            {
+                f_transmitter.printf("@BOOT:%s failed;;\r\n", m_stages[i].m_name);
+            }
+        }
+    }
+
+    /** \brief  Time from the start of the sequence to the end of the control phase, the motion commands are accepted after it.
+     *
+     *  @return                    time in microseconds
+     */
+    uint32_t CInitSequence::getReadyTime() const
+    {
+        return m_ready;
+    }
+
+    /** \brief  Serial callback method, it returns the times of the sequence and the duration of each stage.
+     *
+     *  @param a                   input string, it's not used
+     *  @param b                   output string
+     */
+    void CInitSequence::serialCallback(char const * a, char * b)
+    {
+        int l_length = sprintf(b,"%lu;%lu;%lu;", static_cast<unsigned long>(m_total), static_cast<unsigned long>(m_ready), static_cast<unsigned long>(m_failed));
+        for (uint32_t i = 0; i < m_nrStages; ++i)
+        {
+            l_length += sprintf(b + l_length,"%s:%lu;", m_stages[i].m_name, static_cast<unsigned long>(m_stages[i].m_duration));
+        }
+        sprintf(b + l_length,";");
+    }
+
+}; // namespace utils::init
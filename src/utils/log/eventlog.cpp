@@ -0,0 +1,139 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    EventLog.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the deferred-format
+  *          binary event log.
+  ******************************************************************************
+ */
+#include <utils/log/eventlog.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/serial/protocolmessages.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace utils::log{
+
+    /** \brief  CEventLog class constructor, all slots are free.
+     *
+     *  @param f_period            period of the task in base ticks
+     *  @param f_serial            serial transmitter of the messages
+     */
+    CEventLog::CEventLog(uint32_t f_period, utils::serial::CSerialTransmitter& f_serial)
+        : utils::task::CTask(f_period)
+        , m_serial(f_serial)
+        , m_head(0)
+        , m_tail(0)
+        , m_dropped(0)
+        , m_totalDropped(0)
+    {
+        for (uint32_t l_idx = 0; l_idx < s_slots; ++l_idx)
+        {
+            m_slots[l_idx].m_sequence.store(l_idx, std::memory_order_relaxed);
+        }
+    }
+
+    /** \brief  Write an event in the next free slot, the slot is reserved by compare-and-swap and published by its sequence number.
+     *
+     *  @param f_id                identifier of the event
+     *  @param f_arguments         raw arguments
+     *  @param f_length            size of the arguments, at most s_maxArguments
+     */
+    CONTROL_RAMFUNC void CEventLog::write(uint16_t f_id, const uint8_t* f_arguments, uint8_t f_length)
+    {
+        uint32_t l_timestamp = us_ticker_read();
+        uint32_t l_head = m_head.load(std::memory_order_relaxed);
+        SSlot* l_slot;
+        for (;;)
+        {
+            l_slot = &m_slots[l_head & s_mask];
+            int32_t l_diff = static_cast<int32_t>(l_slot->m_sequence.load(std::memory_order_acquire) - l_head);
+            if (0 == l_diff)
+            {
+                if (m_head.compare_exchange_weak(l_head, l_head + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (l_diff < 0) // The slot isn't sent yet, the log is full
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                l_head = m_head.load(std::memory_order_relaxed);
+            }
+        }
+        l_slot->m_timestamp = l_timestamp;
+        l_slot->m_id = f_id;
+        l_slot->m_length = f_length;
+        memcpy(l_slot->m_arguments, f_arguments, f_length);
+        l_slot->m_sequence.store(l_head + 1, std::memory_order_release);
+    }
+
+    /** \brief  Run method, it packs the published slots in order in a message, the sending stops at the first unpublished slot
+     *  (its producer was interrupted), the slots of a message, which isn't queued, are sent again in the next period.
+     */
+    void CEventLog::_run()
+    {
+        uint32_t l_dropped = m_dropped.load(std::memory_order_relaxed);
+        uint32_t l_begin = m_tail;
+        if (m_slots[l_begin & s_mask].m_sequence.load(std::memory_order_acquire) != l_begin + 1 && 0 == l_dropped)
+        {
+            return;
+        }
+        uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+        uint32_t l_size = sizeof(utils::serial::SEventLogHeader);
+        uint32_t l_end = l_begin;
+        while (l_end - l_begin < 0xFF)
+        {
+            const SSlot& l_slot = m_slots[l_end & s_mask];
+            if (l_slot.m_sequence.load(std::memory_order_acquire) != l_end + 1
+                || l_size + sizeof(utils::serial::SEventRecord) + l_slot.m_length > sizeof(l_payload))
+            {
+                break;
+            }
+            utils::serial::SEventRecord l_record;
+            l_record.m_timestamp = l_slot.m_timestamp;
+            l_record.m_id = l_slot.m_id;
+            l_record.m_length = l_slot.m_length;
+            memcpy(l_payload + l_size, &l_record, sizeof(l_record));
+            memcpy(l_payload + l_size + sizeof(l_record), l_slot.m_arguments, l_slot.m_length);
+            l_size += sizeof(l_record) + l_slot.m_length;
+            ++l_end;
+        }
+        utils::serial::SEventLogHeader l_header;
+        l_header.m_dropped = static_cast<uint16_t>((l_dropped > 0xFFFF) ? 0xFFFF : l_dropped);
+        l_header.m_count = static_cast<uint8_t>(l_end - l_begin);
+        memcpy(l_payload, &l_header, sizeof(l_header));
+        uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+        uint32_t l_length = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_EVENT_LOG, l_payload, l_size, l_frame);
+        if (!m_serial.write(reinterpret_cast<const char*>(l_frame), l_length, utils::serial::CSerialTransmitter::LANE_SAFETY))
+        {
+            return;
+        }
+        m_dropped.fetch_sub(l_dropped, std::memory_order_relaxed);
+        m_totalDropped += l_dropped;
+        for (; m_tail != l_end; ++m_tail)
+        {
+            m_slots[m_tail & s_mask].m_sequence.store(m_tail + s_slots, std::memory_order_release);
+        }
+    }
+
+}; // namespace utils::log
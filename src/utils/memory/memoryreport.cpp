@@ -0,0 +1,117 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    MemoryReport.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the report of the 
+  *          static memory, heap and stack usage.
+  ******************************************************************************
+ */
+
+#include <utils/memory/memoryreport.hpp>
+#include <malloc.h>
+
+/** @brief  Linker symbols of the static memory */
+extern "C" uint32_t __data_start__;
+extern "C" uint32_t __noinit_end__;
+
+namespace utils::memory{
+
+    /** \brief  CMemoryReport class constructor
+     *
+     *  @param f_objects       list of the subsystems
+     *  @param f_objectCount   number of the subsystems
+     *  @param f_stacks        list of the threads
+     *  @param f_stackCount    number of the threads
+     */
+    CMemoryReport::CMemoryReport(const SObject* f_objects, uint32_t f_objectCount, const SStack* f_stacks, uint32_t f_stackCount)
+        : m_objects(f_objects)
+        , m_objectCount(f_objectCount)
+        , m_stacks(f_stacks)
+        , m_stackCount(f_stackCount)
+    {
+    }
+
+    /** \brief  Print the full report, one message for each subsystem and thread and a summary of the static memory and the heap.
+     *  It's blocking, so it's applied at the boot: '@MEMR:name;bytes;;', '@MEMR:name;used;size;;' and '@MEMR:static;bytes;heap;used;reserved;;'.
+     *
+     *  @param f_serial        serial interface
+     */
+    void CMemoryReport::print(Serial& f_serial)
+    {
+        for (uint32_t i = 0; i < m_objectCount; ++i)
+        {
+            f_serial.printf("@MEMR:%s;%lu;;\r\n", m_objects[i].m_name, static_cast<unsigned long>(m_objects[i].m_size));
+        }
+        for (uint32_t i = 0; i < m_stackCount; ++i)
+        {
+            f_serial.printf("@MEMR:%s;%lu;%lu;;\r\n", m_stacks[i].m_name, static_cast<unsigned long>(m_stacks[i].m_thread->max_stack())
+                                                   , static_cast<unsigned long>(m_stacks[i].m_thread->stack_size()));
+        }
+        f_serial.printf("@MEMR:static;%lu;heap;%lu;%lu;;\r\n", static_cast<unsigned long>(getStaticSize())
+                                              , static_cast<unsigned long>(getHeapUsed()), static_cast<unsigned long>(getHeapReserved()));
+    }
+
+    /** \brief  Serial callback of the summary: static memory, heap in use, heap reserved, used and reserved stack of the threads.
+     *
+     *  @param a               input string, it isn't used
+     *  @param b               output string 'static;heapUsed;heapReserved;stackUsed;stackSize;;'
+     */
+    void CMemoryReport::serialCallback(char const * a, char * b)
+    {
+        uint32_t l_stackUsed = 0;
+        uint32_t l_stackSize = 0;
+        for (uint32_t i = 0; i < m_stackCount; ++i)
+        {
+            l_stackUsed += m_stacks[i].m_thread->max_stack();
+            l_stackSize += m_stacks[i].m_thread->stack_size();
+        }
+        sprintf(b,"%lu;%lu;%lu;%lu;%lu;;", static_cast<unsigned long>(getStaticSize()), static_cast<unsigned long>(getHeapUsed())
+                                         , static_cast<unsigned long>(getHeapReserved()), static_cast<unsigned long>(l_stackUsed)
+                                         , static_cast<unsigned long>(l_stackSize));
+    }
+
+    /** \brief  Size of the static memory, the initialized, the zero initialized and the not initialized data in RAM
+     *
+     *  @return                size in bytes
+     */
+    uint32_t CMemoryReport::getStaticSize()
+    {
+        return static_cast<uint32_t>(reinterpret_cast<uint8_t*>(&__noinit_end__) - reinterpret_cast<uint8_t*>(&__data_start__));
+    }
+
+    /** \brief  Size of the allocated heap blocks
+     *
+     *  @return                size in bytes
+     */
+    uint32_t CMemoryReport::getHeapUsed()
+    {
+        return mallinfo().uordblks;
+    }
+
+    /** \brief  Size of the heap obtained from the system, it's the peak of the heap, because the heap isn't returned
+     *
+     *  @return                size in bytes
+     */
+    uint32_t CMemoryReport::getHeapReserved()
+    {
+        return mallinfo().arena;
+    }
+
+}; // namespace utils::memory
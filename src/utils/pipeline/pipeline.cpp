@@ -0,0 +1,56 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Pipeline.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the sensor-to-actuator pipeline.
+  ******************************************************************************
+ */
+
+#include <utils/pipeline/pipeline.hpp>
+
+namespace utils::pipeline{
+
+    /** \brief  CPipeline class constructor
+     *
+     *  @param f_stages        list of the stages in order of application
+     *  @param f_stageCount    number of the stages
+     */
+    CPipeline::CPipeline(IPipelineStage** f_stages, uint8_t f_stageCount)
+        : m_stages(f_stages)
+        , m_stageCount(f_stageCount)
+        , m_timestamp(0)
+    {
+    }
+
+    /** \brief  Apply the stages
+     *
+     *  It takes the timestamp of the tick and it applies the stages in order.
+     */
+    void CPipeline::tick()
+    {
+        uint32_t l_timestamp = us_ticker_read();
+        m_timestamp = l_timestamp;
+        for (uint8_t i = 0; i < m_stageCount; i++)
+        {
+            m_stages[i]->process(l_timestamp);
+        }
+    }
+
+}; // namespace utils::pipeline
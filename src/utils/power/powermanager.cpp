@@ -0,0 +1,106 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    PowerManager.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the low-power mode of 
+  *          the parked car.
+  ******************************************************************************
+ */
+#include <utils/power/powermanager.hpp>
+
+namespace utils::power{
+
+    /** \brief  CPowerManager class constructor
+     *
+     *  The low-power mode is disabled until the 'enable' call.
+     *
+     *  @param f_taskManager       task manager, its tick is scaled in the parked mode
+     *  @param f_isParked          getter of the parked condition, it's applied in the control loop
+     *  @param f_tickScale         number of the base ticks in an interrupt of the parked mode
+     *  @param f_holdTime          time of the parked condition before the scaling in microsecond
+     */
+    CPowerManager::CPowerManager(utils::task::CTaskManager& f_taskManager, FParkedGetter f_isParked, uint32_t f_tickScale, uint32_t f_holdTime)
+        : m_taskManager(f_taskManager)
+        , m_isParkedGetter(f_isParked)
+        , m_tickScale(f_tickScale)
+        , m_holdTime(f_holdTime)
+        , m_isEnabled(false)
+        , m_isParked(false)
+        , m_activeTime(0)
+    {
+    }
+
+    /** \brief  Enable or disable the low-power mode, the disabling restores the base tick in the next control period.
+     *
+     *  @param f_enable            the idle thread sleeps and the tick of the parked car is scaled
+     */
+    void CPowerManager::enable(bool f_enable)
+    {
+        m_isEnabled = f_enable;
+        utils::task::CLoadMonitor::setSleep(f_enable);
+    }
+
+    /** \brief  Process the tick of the control loop, it scales the tick after the hold time of the parked condition and it restores it immediately.
+     *
+     *  @param f_timestamp         timestamp of the tick in microsecond
+     */
+    void CPowerManager::process(uint32_t f_timestamp)
+    {
+        bool l_parked = m_isEnabled && m_isParkedGetter();
+        if (!l_parked)
+        {
+            m_activeTime = f_timestamp;
+            if (m_isParked)
+            {
+                m_isParked = false;
+                m_taskManager.setTickScale(1);
+            }
+        }
+        else if (!m_isParked && f_timestamp - m_activeTime >= m_holdTime)
+        {
+            m_isParked = true;
+            m_taskManager.setTickScale(m_tickScale);
+        }
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CPowerManager::serialCallback(char const * a, char * b)
+    {
+        unsigned int l_command, l_value;
+        int l_count = sscanf(a,"%u;%u",&l_command,&l_value);
+        if (l_count == 1 && l_command == 0)
+        {
+            sprintf(b,"ack;;%u;%u;%lu;", m_isEnabled ? 1u : 0u, m_isParked ? 1u : 0u, static_cast<unsigned long>(m_taskManager.getTickScale()));
+        }
+        else if (l_count == 2 && l_command == 1 && l_value <= 1)
+        {
+            enable(l_value == 1);
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace utils::power
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Publisher.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the generic sensor publisher.
+  ******************************************************************************
+ */
+
+#include <utils/publisher/publisher.hpp>
+
+namespace utils::publisher{
+
+    /** \brief  Text format of the integer value
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_size          size of the buffer
+     *  @param f_value         value
+     *  @return                number of the written characters, negative when the buffer is too small
+     */
+    int32_t CIntSerializer::text(char* f_buffer, uint32_t f_size, int32_t f_value)
+    {
+        char l_text[utils::fmt::s_intSize];
+        uint32_t l_length = utils::fmt::formatInt(l_text, f_value);
+        if (l_length >= f_size)
+        {
+            return -1;
+        }
+        memcpy(f_buffer, l_text, l_length + 1);
+        return l_length;
+    }
+
+    /** \brief  Binary format of the integer value
+     *
+     *  @param f_buffer        destination buffer
+     *  @param f_size          size of the buffer
+     *  @param f_value         value
+     *  @return                number of the written bytes, negative when the buffer is too small
+     */
+    int32_t CIntSerializer::binary(uint8_t* f_buffer, uint32_t f_size, int32_t f_value)
+    {
+        if (f_size < sizeof(f_value))
+        {
+            return -1;
+        }
+        memcpy(f_buffer, &f_value, sizeof(f_value));
+        return sizeof(f_value);
+    }
+
+    /** \brief  CPublisherGroup class constructor
+     *
+     *  The values aren't published until the first subscription.
+     *
+     *  @param f_period        period of the publisher, the values are published in its multiples
+     *  @param f_values        list of the values, the index in the list is the bit in the subscription mask
+     *  @param f_valueCount    number of the values, at most 32
+     *  @param f_serial        serial transmitter
+     */
+    CPublisherGroup::CPublisherGroup(uint32_t                            f_period
+                                    ,IPublishedValue**                   f_values
+                                    ,uint8_t                             f_valueCount
+                                    ,utils::serial::CSerialTransmitter&  f_serial)
+        : utils::task::CTask(f_period)
+        , m_values(f_values)
+        , m_valueCount(f_valueCount < s_maxValues ? f_valueCount : s_maxValues)
+        , m_mask(0)
+        , m_isBinary(false)
+        , m_tick(0)
+        , m_serial(f_serial)
+    {
+    }
+
+    /** \brief  Subscribe the published values
+     *
+     *  @param f_mask          mask of the values, zero stops the publishing
+     *  @param f_binary        binary frames instead of text frames
+     *  @return                true, when the mask contains only registered values
+     */
+    bool CPublisherGroup::subscribe(uint32_t f_mask, bool f_binary)
+    {
+        if (m_valueCount < 32 && (f_mask >> m_valueCount) != 0)
+        {
+            return false;
+        }
+        m_isBinary = f_binary;
+        m_mask = f_mask;
+        return true;
+    }
+
+    /** \brief  Serial callback of the subscription, the string has to contain the mask of the values in hexadecimal format.
+     *
+     *  @param a                   input received string
+     *  @param b                   output reponse message
+     */
+    void CPublisherGroup::serialCallback(char const * a, char * b)
+    {
+        unsigned long l_mask;
+        if (1 == sscanf(a,"%lx",&l_mask) && subscribe(l_mask, false))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Binary callback of the subscription, after it the values are published in binary frames.
+     *
+     *  @param f_payload           received payload
+     *  @return                    status code of the response
+     */
+    uint8_t CPublisherGroup::binaryCallback(const utils::serial::SPublisherSubscribePayload& f_payload)
+    {
+        return subscribe(f_payload.m_mask, true) ? utils::serial::BIN_ACK : utils::serial::BIN_SYNTAX_ERROR;
+    }
+
+    /** \brief  Run method, it selects the due values and it transmits them in a single frame.
+     */
+    void CPublisherGroup::_run()
+    {
+        uint32_t l_mask = m_mask;
+        if (0 == l_mask)
+        {
+            return;
+        }
+        uint32_t l_due = 0;
+        for (uint8_t i = 0; i < m_valueCount; ++i)
+        {
+            if ((l_mask & (1u << i)) && 0 == m_tick % m_values[i]->getDivider())
+            {
+                l_due |= 1u << i;
+            }
+        }
+        m_tick++;
+        if (0 == l_due)
+        {
+            return;
+        }
+        if (m_isBinary)
+        {
+            publishBinary(l_due);
+        }
+        else
+        {
+            publishText(l_due);
+        }
+    }
+
+    /** \brief  Transmit the values in a text frame, the values which don't fit in the frame are skipped.
+     *
+     *  @param f_mask          mask of the due values
+     */
+    void CPublisherGroup::publishText(uint32_t f_mask)
+    {
+        char l_frame[utils::serial::CSerialTransmitter::s_maxMessageLength];
+        const uint32_t l_end = sizeof(l_frame) - 4;         // ";;\r\n"
+        uint32_t l_length = sprintf(l_frame, "@PUBS:");
+        for (uint8_t i = 0; i < m_valueCount; ++i)
+        {
+            if (0 == (f_mask & (1u << i)) || l_length + 6 >= l_end)
+            {
+                continue;
+            }
+            uint32_t l_start = l_length;
+            l_length += sprintf(l_frame + l_length, "%s%.4s=", (l_start > 6) ? ";" : "", m_values[i]->getKey());
+            int32_t l_value = m_values[i]->text(l_frame + l_length, l_end - l_length);
+            l_length = (l_value >= 0) ? l_length + l_value : l_start;
+        }
+        memcpy(l_frame + l_length, ";;\r\n", 4);
+        m_serial.write(l_frame, l_length + 4, utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+    }
+
+    /** \brief  Transmit the values in a binary frame, the values which don't fit in the payload are skipped.
+     *
+     *  @param f_mask          mask of the due values
+     */
+    void CPublisherGroup::publishBinary(uint32_t f_mask)
+    {
+        uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+        uint32_t l_timestamp = us_ticker_read();
+        memcpy(l_payload, &l_timestamp, sizeof(l_timestamp));
+        uint32_t l_length = sizeof(l_timestamp);
+        for (uint8_t i = 0; i < m_valueCount; ++i)
+        {
+            if (0 == (f_mask & (1u << i)) || l_length + 2 >= sizeof(l_payload))
+            {
+                continue;
+            }
+            int32_t l_value = m_values[i]->binary(l_payload + l_length + 2, sizeof(l_payload) - l_length - 2);
+            if (l_value >= 0)
+            {
+                l_payload[l_length] = i;
+                l_payload[l_length + 1] = static_cast<uint8_t>(l_value);
+                l_length += 2 + l_value;
+            }
+        }
+        uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+        uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_PUBLISH, l_payload, l_length, l_frame);
+        m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+    }
+
+}; // namespace utils::publisher
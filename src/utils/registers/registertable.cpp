@@ -0,0 +1,407 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    RegisterTable.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the register table of 
+  *          the parameters and the live signals.
+  ******************************************************************************
+ */
+
+#include <utils/registers/registertable.hpp>
+#include <utils/serial/commandschema.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace utils::registers{
+
+    /** \brief  CRegisterTable class constructor, the blocks are sorted by their addresses.
+     *
+     *  @param f_registers     blocks of the registers, the array is owned by the user and it's reordered, the blocks mustn't overlap
+     *  @param f_count         number of the blocks
+     *  @param f_serial        serial transmitter of the data frames
+     */
+    CRegisterTable::CRegisterTable(IRegister**                           f_registers
+                                  ,uint8_t                               f_count
+                                  ,utils::serial::CSerialTransmitter&    f_serial)
+        : m_registers(f_registers)
+        , m_count(f_count)
+        , m_size(0)
+        , m_serial(f_serial)
+    {
+        // Insertion sort, the list is short and it's sorted only once
+        for (uint8_t l_idx = 1; l_idx < m_count; ++l_idx)
+        {
+            IRegister* l_register = m_registers[l_idx];
+            uint8_t l_pos = l_idx;
+            while (l_pos > 0 && m_registers[l_pos - 1]->getAddress() > l_register->getAddress())
+            {
+                m_registers[l_pos] = m_registers[l_pos - 1];
+                --l_pos;
+            }
+            m_registers[l_pos] = l_register;
+        }
+        for (uint8_t l_idx = 0; l_idx < m_count; ++l_idx)
+        {
+            m_size += m_registers[l_idx]->getCount();
+        }
+    }
+
+    /** \brief  Find the block of an address by binary search
+     *
+     *  @param f_address       address of the register
+     *  @param f_offset        offset of the register in the found block
+     *  @return                block of the register, NULL for the unmapped address
+     */
+    IRegister* CRegisterTable::find(uint16_t f_address, uint16_t& f_offset) const
+    {
+        uint32_t l_low = 0;
+        uint32_t l_high = m_count;
+        while (l_low < l_high)
+        {
+            uint32_t l_mid = (l_low + l_high) / 2;
+            IRegister* l_register = m_registers[l_mid];
+            if (f_address < l_register->getAddress())
+            {
+                l_high = l_mid;
+            }
+            else if (f_address >= l_register->getAddress() + l_register->getCount())
+            {
+                l_low = l_mid + 1;
+            }
+            else
+            {
+                f_offset = f_address - l_register->getAddress();
+                return l_register;
+            }
+        }
+        return NULL;
+    }
+
+    /** \brief  Read a range of registers in a critical section, so the values belong to the same control tick
+     *
+     *  @param f_address       address of the first register
+     *  @param f_count         number of the registers
+     *  @param f_words         raw words of the values
+     *  @return                BIN_ACK or BIN_VALUE_RANGE, when an address of the range isn't mapped
+     */
+    uint8_t CRegisterTable::read(uint16_t f_address, uint8_t f_count, uint32_t* f_words) const
+    {
+        core_util_critical_section_enter();
+        uint8_t l_status = readRange(f_address, f_count, f_words);
+        core_util_critical_section_exit();
+        return l_status;
+    }
+
+    /** \brief  Write a range of registers, all values are verified before the first one is applied, then they are applied in a 
+     *  critical section, so the control loop observes all of them in the same tick.
+     *
+     *  @param f_address       address of the first register
+     *  @param f_count         number of the registers
+     *  @param f_words         raw words of the values
+     *  @param f_rejected      one-based index of the rejected value, zero for the accepted write
+     *  @return                BIN_ACK, BIN_VALUE_RANGE for the unmapped address or the value out of range, BIN_NOT_AVAILABLE for the read-only register
+     */
+    uint8_t CRegisterTable::write(uint16_t f_address, uint8_t f_count, const uint32_t* f_words, uint8_t& f_rejected)
+    {
+        for (uint8_t l_idx = 0; l_idx < f_count; ++l_idx)
+        {
+            f_rejected = l_idx + 1;
+            uint16_t l_offset;
+            IRegister* l_register = find(f_address + l_idx, l_offset);
+            if (NULL == l_register)
+            {
+                return utils::serial::BIN_VALUE_RANGE;
+            }
+            if (!l_register->isWritable())
+            {
+                return utils::serial::BIN_NOT_AVAILABLE;
+            }
+            if (!l_register->check(l_offset, f_words[l_idx]))
+            {
+                return utils::serial::BIN_VALUE_RANGE;
+            }
+        }
+        f_rejected = 0;
+        core_util_critical_section_enter();
+        for (uint8_t l_idx = 0; l_idx < f_count; ++l_idx)
+        {
+            uint16_t l_offset;
+            IRegister* l_register = find(f_address + l_idx, l_offset);
+            l_register->write(l_offset, f_words[l_idx]);
+        }
+        core_util_critical_section_exit();
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Serial callback of the register access, the commands are listed by the class description.
+     *
+     *  @param a               input string
+     *  @param b               output string
+     */
+    void CRegisterTable::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        uint32_t l_address;
+        uint32_t l_count;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            uint16_t l_low = (m_count > 0) ? m_registers[0]->getAddress() : 0;
+            uint16_t l_high = (m_count > 0) ? m_registers[m_count - 1]->getAddress() + m_registers[m_count - 1]->getCount() - 1 : 0;
+            utils::fmt::CWriter(b).udec(m_size).udec(l_low).udec(l_high).chr(';');
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            writeText(l_text, b);
+        }
+        else if ((1 == l_command || 3 == l_command) && ';' == *l_text++ 
+                 && utils::fmt::parseUint(l_text, l_address) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_count))
+        {
+            if (0 == l_count || l_count > s_maxTextRegisters || l_address + l_count > 0x10000)
+            {
+                sprintf(b,"invalid parameters;;");
+            }
+            else if (1 == l_command)
+            {
+                formatRange(b, l_address, l_count);
+            }
+            else
+            {
+                describeRange(b, l_address, l_count);
+            }
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Binary callback of the range read, the values are sent in a BIN_REGISTER_DATA frame on the transmitter of the table.
+     *
+     *  @param f_payload       SRegisterHeader of the range
+     *  @param f_length        length of the payload
+     *  @return                status code of the response
+     */
+    uint8_t CRegisterTable::binaryCallbackRead(const uint8_t* f_payload, uint8_t f_length)
+    {
+        utils::serial::SRegisterHeader l_header;
+        if (f_length != sizeof(l_header))
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        memcpy(&l_header, f_payload, sizeof(l_header));
+        if (0 == l_header.m_count || l_header.m_count > s_maxRegisters)
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+        uint32_t l_words[s_maxRegisters];
+        uint8_t l_status = read(l_header.m_address, l_header.m_count, l_words);
+        if (utils::serial::BIN_ACK != l_status)
+        {
+            return l_status;
+        }
+        memcpy(l_payload, &l_header, sizeof(l_header));
+        memcpy(l_payload + sizeof(l_header), l_words, l_header.m_count * sizeof(uint32_t));
+        uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+        uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_REGISTER_DATA, l_payload
+                                                                , sizeof(l_header) + l_header.m_count * sizeof(uint32_t), l_frame);
+        if (!m_serial.write(reinterpret_cast<const char*>(l_frame), l_size))
+        {
+            return utils::serial::BIN_QUEUE_FULL;
+        }
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Binary callback of the range write
+     *
+     *  @param f_payload       SRegisterHeader of the range followed by the raw words
+     *  @param f_length        length of the payload
+     *  @return                status code of the response
+     */
+    uint8_t CRegisterTable::binaryCallbackWrite(const uint8_t* f_payload, uint8_t f_length)
+    {
+        utils::serial::SRegisterHeader l_header;
+        if (f_length < sizeof(l_header))
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        memcpy(&l_header, f_payload, sizeof(l_header));
+        if (0 == l_header.m_count || f_length != sizeof(l_header) + l_header.m_count * sizeof(uint32_t))
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        uint32_t l_words[s_maxRegisters];
+        memcpy(l_words, f_payload + sizeof(l_header), l_header.m_count * sizeof(uint32_t));
+        uint8_t l_rejected;
+        return write(l_header.m_address, l_header.m_count, l_words, l_rejected);
+    }
+
+    /** \brief  Read a range of registers without critical section
+     *
+     *  @param f_address       address of the first register
+     *  @param f_count         number of the registers
+     *  @param f_words         raw words of the values
+     *  @return                BIN_ACK or BIN_VALUE_RANGE, when an address of the range isn't mapped
+     */
+    uint8_t CRegisterTable::readRange(uint16_t f_address, uint8_t f_count, uint32_t* f_words) const
+    {
+        uint16_t l_offset = 0;
+        IRegister* l_register = NULL;
+        for (uint8_t l_idx = 0; l_idx < f_count; ++l_idx)
+        {
+            // The next address is in the same block in the most cases, the table is searched only at the end of the block
+            if (NULL == l_register || ++l_offset >= l_register->getCount())
+            {
+                l_register = find(f_address + l_idx, l_offset);
+                if (NULL == l_register)
+                {
+                    return utils::serial::BIN_VALUE_RANGE;
+                }
+            }
+            f_words[l_idx] = l_register->read(l_offset);
+        }
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Format the values of a range: the address followed by the values, the floats have four decimals
+     *
+     *  @param f_response      response of the serial callback
+     *  @param f_address       address of the first register
+     *  @param f_count         number of the registers, at most s_maxTextRegisters
+     */
+    void CRegisterTable::formatRange(char* f_response, uint16_t f_address, uint8_t f_count) const
+    {
+        uint32_t l_words[s_maxTextRegisters];
+        uint8_t l_status = read(f_address, f_count, l_words);
+        if (utils::serial::BIN_ACK != l_status)
+        {
+            utils::serial::CCommandSchema::respond(f_response, l_status);
+            return;
+        }
+        utils::fmt::CWriter l_writer(f_response);
+        l_writer.udec(f_address);
+        for (uint8_t l_idx = 0; l_idx < f_count; ++l_idx)
+        {
+            uint16_t l_offset;
+            IRegister* l_register = find(f_address + l_idx, l_offset);
+            switch (l_register->getType())
+            {
+                case REG_FLOAT:
+                    l_writer.fixed(fromWord<float>(l_words[l_idx]), 4);
+                    break;
+                case REG_INT32:
+                    l_writer.dec(fromWord<int32_t>(l_words[l_idx]));
+                    break;
+                default:
+                    l_writer.udec(l_words[l_idx]);
+                    break;
+            }
+        }
+        l_writer.chr(';');
+    }
+
+    /** \brief  Format the description of a range: the address followed by the type and the access of each register
+     *
+     *  @param f_response      response of the serial callback
+     *  @param f_address       address of the first register
+     *  @param f_count         number of the registers, at most s_maxTextRegisters
+     */
+    void CRegisterTable::describeRange(char* f_response, uint16_t f_address, uint8_t f_count) const
+    {
+        utils::fmt::CWriter l_writer(f_response);
+        l_writer.udec(f_address);
+        for (uint8_t l_idx = 0; l_idx < f_count; ++l_idx)
+        {
+            uint16_t l_offset;
+            IRegister* l_register = find(f_address + l_idx, l_offset);
+            if (NULL == l_register)
+            {
+                utils::serial::CCommandSchema::respond(f_response, utils::serial::BIN_VALUE_RANGE, l_idx + 1);
+                return;
+            }
+            l_writer.udec(l_register->getType()).udec(l_register->isWritable() ? 1 : 0);
+        }
+        l_writer.chr(';');
+    }
+
+    /** \brief  Parse the values of the text write by the types of the registers and apply the write
+     *
+     *  @param f_text          "address;value[;value...]" ended by ";;"
+     *  @param f_response      response of the serial callback, 'ack;;' or 'err;status;value;;'
+     */
+    void CRegisterTable::writeText(char const * f_text, char * f_response)
+    {
+        const char* l_text = f_text;
+        uint32_t l_address;
+        if (!utils::fmt::parseUint(l_text, l_address) || l_address > 0xFFFF)
+        {
+            sprintf(f_response,"sintax error;;");
+            return;
+        }
+        uint32_t l_words[s_maxTextRegisters];
+        uint8_t l_count = 0;
+        while (';' == l_text[0] && ';' != l_text[1] && '\0' != l_text[1])
+        {
+            ++l_text;
+            uint16_t l_offset;
+            IRegister* l_register = (l_count < s_maxTextRegisters) ? find(l_address + l_count, l_offset) : NULL;
+            if (NULL == l_register)
+            {
+                utils::serial::CCommandSchema::respond(f_response, utils::serial::BIN_VALUE_RANGE, l_count + 1);
+                return;
+            }
+            bool l_isParsed;
+            if (REG_FLOAT == l_register->getType())
+            {
+                float l_value;
+                l_isParsed = utils::fmt::parseFloat(l_text, l_value);
+                l_words[l_count] = toWord<float>(l_value);
+            }
+            else if (REG_INT32 == l_register->getType())
+            {
+                int32_t l_value;
+                l_isParsed = utils::fmt::parseInt(l_text, l_value);
+                l_words[l_count] = toWord<int32_t>(l_value);
+            }
+            else
+            {
+                l_isParsed = utils::fmt::parseUint(l_text, l_words[l_count]);
+            }
+            if (!l_isParsed)
+            {
+                utils::serial::CCommandSchema::respond(f_response, utils::serial::BIN_SYNTAX_ERROR, l_count + 1);
+                return;
+            }
+            ++l_count;
+        }
+        if (0 == l_count)
+        {
+            sprintf(f_response,"sintax error;;");
+            return;
+        }
+        uint8_t l_rejected;
+        uint8_t l_status = write(l_address, l_count, l_words, l_rejected);
+        utils::serial::CCommandSchema::respond(f_response, l_status, l_rejected);
+    }
+
+}; // namespace utils::registers
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    BaudNegotiator.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the baud rate negotiation 
+  *          of the serial links.
+  ******************************************************************************
+ */
+#include <utils/serial/baudnegotiator.hpp>
+
+namespace utils::serial{
+
+    /** \brief  CBaudNegotiator class constructor
+     *
+     *  @param f_monitor           monitor of the link
+     *  @param f_serial            transmitter of the link
+     *  @param f_setter            setter of the baud rate
+     *  @param f_baud              default baud rate, it's set by the initialization of the interface
+     *  @param f_maxBaud           maximum baud rate of the link
+     *  @param f_pollPeriod        period of the task during the negotiation in base ticks
+     */
+    CBaudNegotiator::CBaudNegotiator(CSerialMonitor& f_monitor, CSerialTransmitter& f_serial, FBaudSetter f_setter, uint32_t f_baud, uint32_t f_maxBaud, uint32_t f_pollPeriod)
+        : utils::task::CTask(0)
+        , m_monitor(f_monitor)
+        , m_serial(f_serial)
+        , m_setter(f_setter)
+        , m_baud(f_baud)
+        , m_previous(f_baud)
+        , m_requested(f_baud)
+        , m_maxBaud(f_maxBaud)
+        , m_pollPeriod(f_pollPeriod)
+        , m_state(IDLE)
+        , m_frames(0)
+        , m_switchTime(0)
+    {
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input string
+     *  @param b                   output string
+     */
+    void CBaudNegotiator::serialCallback(char const * a, char * b)
+    {
+        int l_command;
+        unsigned long l_baud = 0;
+        int32_t l_res = sscanf(a,"%d;%lu",&l_command,&l_baud);
+        if (1 > l_res)
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        if (0 == l_command)
+        {
+            sprintf(b,"%lu;%lu;%d;;", static_cast<unsigned long>(m_baud), static_cast<unsigned long>(m_maxBaud), (m_state != IDLE) ? 1 : 0);
+        }
+        else if (1 == l_command && 2 == l_res && l_baud >= s_minBaud && l_baud <= m_maxBaud)
+        {
+            if (m_state != IDLE)
+            {
+                sprintf(b,"busy;;");
+                return;
+            }
+            m_requested = l_baud;
+            m_state = SWITCHING;
+            setPeriod(m_pollPeriod);
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Run method, it's periodic only during the negotiation
+     *
+     *  The rate is changed, after the response lane was drained. Then the frame counter of the monitor is checked until the 
+     *  timeout, a new frame confirms the rate.
+     */
+    void CBaudNegotiator::_run()
+    {
+        if (SWITCHING == m_state)
+        {
+            if (m_serial.isPending(CSerialTransmitter::LANE_RESPONSE))
+            {
+                return;
+            }
+            if (!m_setter(m_requested))
+            {
+                finish("reverted");
+                return;
+            }
+            m_previous = m_baud;
+            m_baud = m_requested;
+            m_frames = m_monitor.getStatistics().m_frames;
+            m_switchTime = us_ticker_read();
+            m_state = CONFIRMING;
+        }
+        else if (CONFIRMING == m_state)
+        {
+            if (m_monitor.getStatistics().m_frames != m_frames)
+            {
+                finish("confirmed");
+            }
+            else if (us_ticker_read() - m_switchTime > s_confirmTimeout)
+            {
+                m_setter(m_previous);
+                m_baud = m_previous;
+                finish("reverted");
+            }
+        }
+    }
+
+    /** \brief  Finish the negotiation and report the result with the current rate
+     *
+     *  @param f_result            result of the negotiation
+     */
+    void CBaudNegotiator::finish(const char* f_result)
+    {
+        m_state = IDLE;
+        setPeriod(0);
+        m_serial.printf("@BAUD:%s;%lu;;\r\n", f_result, static_cast<unsigned long>(m_baud));
+    }
+
+}; // namespace utils::serial
@@ -0,0 +1,201 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    BinaryProtocol.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the definition of the binary framed protocol.
+  ******************************************************************************
+ */
+
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/clock/boardclock.hpp>
+
+namespace utils::serial{
+
+    volatile CBinaryProtocol::EFraming CBinaryProtocol::s_framing = CBinaryProtocol::FRAMING_SYNC;
+
+    /** \brief  Compute the CRC16-CCITT checksum (polynomial 0x1021)
+     *
+     *  @param f_data          pointer to the data
+     *  @param f_length        length of the data
+     *  @param f_crc           initial value
+     *  @return                checksum
+     */
+    uint16_t CBinaryProtocol::crc16(const uint8_t* f_data, uint32_t f_length, uint16_t f_crc)
+    {
+        for (uint32_t i = 0; i < f_length; i++)
+        {
+            f_crc ^= static_cast<uint16_t>(f_data[i]) << 8;
+            for (uint8_t j = 0; j < 8; j++)
+            {
+                f_crc = (f_crc & 0x8000) ? static_cast<uint16_t>((f_crc << 1) ^ 0x1021) : static_cast<uint16_t>(f_crc << 1);
+            }
+        }
+        return f_crc;
+    }
+
+    /** \brief  Encode a frame in the selected framing of the published frames
+     *
+     *  @param f_id            message identifier
+     *  @param f_payload       pointer to the payload
+     *  @param f_length        length of the payload, maximum s_maxPayloadSize
+     *  @param f_frame         destination buffer, its size has to be at least s_maxFrameSize
+     *  @return                length of the frame, zero, when the payload is too long
+     */
+    uint32_t CBinaryProtocol::encode(uint8_t f_id, const void* f_payload, uint8_t f_length, uint8_t* f_frame)
+    {
+        return encode(f_id, f_payload, f_length, f_frame, s_framing);
+    }
+
+    /** \brief  Encode a frame, the timestamp is appended to the payload, when the stamping is enabled.
+     *
+     *  The COBS frame is encoded as a sync frame at the end of the buffer, then it's stuffed to the beginning of the buffer, 
+     *  the stuffed bytes never overtake the read position.
+     *
+     *  @param f_id            message identifier
+     *  @param f_payload       pointer to the payload
+     *  @param f_length        length of the payload, maximum s_maxPayloadSize
+     *  @param f_frame         destination buffer, its size has to be at least s_maxFrameSize
+     *  @param f_framing       framing of the frame
+     *  @return                length of the frame, zero, when the payload is too long
+     */
+    uint32_t CBinaryProtocol::encode(uint8_t f_id, const void* f_payload, uint8_t f_length, uint8_t* f_frame, EFraming f_framing)
+    {
+        if (f_framing == FRAMING_COBS)
+        {
+            uint8_t* l_sync = f_frame + (s_maxFrameSize - s_maxSyncFrameSize);
+            uint32_t l_size = encode(f_id, f_payload, f_length, l_sync, FRAMING_SYNC);
+            if (l_size == 0)
+            {
+                return 0;
+            }
+            f_frame[0] = s_delimiter;
+            uint32_t l_stuffed = cobsEncode(l_sync + 1, l_size - 1, f_frame + 1);
+            f_frame[1 + l_stuffed] = s_delimiter;
+            return l_stuffed + 2;
+        }
+        if (f_length > s_maxPayloadSize)
+        {
+            return 0;
+        }
+        uint32_t l_length = f_length;
+        f_frame[0] = s_sync;
+        f_frame[1] = f_id;
+        memcpy(f_frame + s_headerSize, f_payload, f_length);
+        if (utils::clock::CBoardClock::isStamping())
+        {
+            uint32_t l_stamp = utils::clock::CBoardClock::now32();
+            memcpy(f_frame + s_headerSize + l_length, &l_stamp, s_stampSize);
+            l_length += s_stampSize;
+            f_frame[1] |= s_stampFlag;
+        }
+        f_frame[2] = static_cast<uint8_t>(l_length);
+        uint16_t l_crc = crc16(f_frame + 1, s_headerSize - 1 + l_length);
+        f_frame[s_headerSize + l_length] = static_cast<uint8_t>(l_crc & 0xFF);
+        f_frame[s_headerSize + l_length + 1] = static_cast<uint8_t>(l_crc >> 8);
+        return s_headerSize + l_length + s_crcSize;
+    }
+
+    /** \brief  Stuff the bytes by COBS
+     *
+     *  Each zero byte is replaced by the distance to the next zero byte, the first code byte shows the distance to the first zero. 
+     *  A code 0xFF shows 254 bytes without zero. The destination can overlap the source, when it begins at least 
+     *  'f_length / 254 + 1' bytes before it.
+     *
+     *  @param f_data          pointer to the data
+     *  @param f_length        length of the data
+     *  @param f_dest          destination buffer, its size has to be at least 'f_length + f_length / 254 + 1'
+     *  @return                length of the stuffed bytes
+     */
+    uint32_t CBinaryProtocol::cobsEncode(const uint8_t* f_data, uint32_t f_length, uint8_t* f_dest)
+    {
+        uint32_t l_code = 0;
+        uint32_t l_size = 1;
+        uint8_t l_run = 1;
+        for (uint32_t i = 0; i < f_length; i++)
+        {
+            uint8_t l_byte = f_data[i];
+            if (l_byte != 0)
+            {
+                f_dest[l_size++] = l_byte;
+                l_run++;
+            }
+            if (l_byte == 0 || l_run == 0xFF)
+            {
+                f_dest[l_code] = l_run;
+                l_code = l_size++;
+                l_run = 1;
+            }
+        }
+        f_dest[l_code] = l_run;
+        return l_size;
+    }
+
+    /** \brief  Restore the COBS stuffed bytes
+     *
+     *  @param f_data          pointer to the stuffed bytes without the delimiters
+     *  @param f_length        length of the stuffed bytes
+     *  @param f_dest          destination buffer, its size has to be at least f_length, it can be the same as the source
+     *  @return                length of the restored data, zero, when the bytes are invalid (zero code or code over the end)
+     */
+    uint32_t CBinaryProtocol::cobsDecode(const uint8_t* f_data, uint32_t f_length, uint8_t* f_dest)
+    {
+        uint32_t l_size = 0;
+        uint32_t i = 0;
+        while (i < f_length)
+        {
+            uint8_t l_code = f_data[i++];
+            if (l_code == 0 || i + l_code - 1 > f_length)
+            {
+                return 0;
+            }
+            for (uint8_t j = 1; j < l_code; j++)
+            {
+                f_dest[l_size++] = f_data[i++];
+            }
+            if (l_code != 0xFF && i < f_length)
+            {
+                f_dest[l_size++] = 0;
+            }
+        }
+        return l_size;
+    }
+
+    /** \brief  Serial callback of the framing of the published frames
+     *
+     *  The message has the format 'framing', where 0 - sync byte, 1 - COBS, for example '#COBS:1;;'.
+     *
+     *  @param a               input received string
+     *  @param b               output reponse message
+     */
+    void CBinaryProtocol::serialCallbackFraming(char const * a, char * b)
+    {
+        unsigned int l_framing;
+        uint32_t l_res = sscanf(a,"%u",&l_framing);
+        if (l_res == 1 && l_framing <= FRAMING_COBS)
+        {
+            setFraming(static_cast<EFraming>(l_framing));
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace utils::serial
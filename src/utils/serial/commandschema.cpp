@@ -0,0 +1,140 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    CommandSchema.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the parsing and the 
+  *          validation of the text commands.
+  ******************************************************************************
+ */
+#include <utils/serial/commandschema.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace utils::serial{
+
+    /** \brief  CCommandSchema class constructor
+     *
+     *  @param f_fields            fields of the command, the array is owned by the user
+     *  @param f_count             number of the fields
+     */
+    CCommandSchema::CCommandSchema(const SField* f_fields, uint8_t f_count)
+        : m_fields(f_fields)
+        , m_count(f_count)
+    {
+    }
+
+    /** \brief  Parse and validate the content of a command
+     *
+     *  @param f_text              content of the frame, it's ended by ";;"
+     *  @param f_values            parsed values, one for each field
+     *  @param f_field             one-based index of the rejected field, zero for the accepted command
+     *  @return                    BIN_ACK, BIN_SYNTAX_ERROR for the malformed content or BIN_VALUE_RANGE for the value out of range
+     */
+    uint8_t CCommandSchema::parse(const char* f_text, UFieldValue* f_values, uint8_t& f_field) const
+    {
+        const char* l_text = f_text;
+        for (uint8_t l_idx = 0; l_idx < m_count; l_idx++)
+        {
+            f_field = l_idx + 1;
+            if (l_idx > 0 && *l_text++ != ';')
+            {
+                return BIN_SYNTAX_ERROR;
+            }
+            const SField& l_field = m_fields[l_idx];
+            float l_value;
+            if (FIELD_FLOAT == l_field.m_type)
+            {
+                if (!fmt::parseFloat(l_text, f_values[l_idx].m_float))
+                {
+                    return BIN_SYNTAX_ERROR;
+                }
+                l_value = f_values[l_idx].m_float;
+            }
+            else if (FIELD_INT == l_field.m_type)
+            {
+                if (!fmt::parseInt(l_text, f_values[l_idx].m_int))
+                {
+                    return BIN_SYNTAX_ERROR;
+                }
+                l_value = static_cast<float>(f_values[l_idx].m_int);
+            }
+            else
+            {
+                if (!fmt::parseUint(l_text, f_values[l_idx].m_uint))
+                {
+                    return BIN_SYNTAX_ERROR;
+                }
+                l_value = static_cast<float>(f_values[l_idx].m_uint);
+            }
+            if (!(l_field.m_min <= l_value && l_value <= l_field.m_max))
+            {
+                return BIN_VALUE_RANGE;
+            }
+        }
+        // Only the ending of the frame can follow the last field
+        f_field = 0;
+        while (*l_text == ';')
+        {
+            l_text++;
+        }
+        if (*l_text != '\0')
+        {
+            f_field = m_count;
+            return BIN_SYNTAX_ERROR;
+        }
+        return BIN_ACK;
+    }
+
+    /** \brief  Parse the content of a command, the response of the rejected command is written.
+     *
+     *  @param f_text              content of the frame
+     *  @param f_values            parsed values, one for each field
+     *  @param f_response          response of the serial callback
+     *  @return                    true, when the command is accepted and the callback applies its values
+     */
+    bool CCommandSchema::parse(const char* f_text, UFieldValue* f_values, char* f_response) const
+    {
+        uint8_t l_field;
+        uint8_t l_status = parse(f_text, f_values, l_field);
+        if (BIN_ACK != l_status)
+        {
+            respond(f_response, l_status, l_field);
+            return false;
+        }
+        return true;
+    }
+
+    /** \brief  Write the response of the status code, 'ack;;' or 'err;status;field;;'.
+     *
+     *  @param f_response          response of the serial callback
+     *  @param f_status            status code (EBinaryStatus)
+     *  @param f_field             one-based index of the rejected field, zero when it isn't caused by a field
+     */
+    void CCommandSchema::respond(char* f_response, uint8_t f_status, uint8_t f_field)
+    {
+        if (BIN_ACK == f_status)
+        {
+            memcpy(f_response, "ack;;", 6);
+        }
+        else
+        {
+            fmt::CWriter(f_response).text("err;").udec(f_status).udec(f_field).chr(';');
+        }
+    }
+
+}; // namespace utils::serial
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    LinkBenchmark.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the latency and throughput 
+  *          benchmark of the serial link.
+  ******************************************************************************
+ */
+#include <utils/serial/linkbenchmark.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace utils::serial{
+
+    /** \brief  CLinkBenchmark class constructor
+     *
+     *  @param f_monitor           monitor of the benchmarked link, it gives the receive and parse times
+     *  @param f_serial            serial transmitter of the actuation message
+     */
+    CLinkBenchmark::CLinkBenchmark(CSerialMonitor& f_monitor, CSerialTransmitter& f_serial)
+        : utils::task::CTask(0)
+        , m_monitor(f_monitor)
+        , m_serial(f_serial)
+        , m_actuationSequence(0)
+        , m_actuationTime(0)
+        , m_isActuationPending(false)
+        , m_isActuationReady(false)
+        , m_floodCount(0)
+        , m_floodLost(0)
+        , m_floodNext(0)
+        , m_floodFirst(0)
+        , m_floodLast(0)
+    {
+    }
+
+    /** \brief  Pipeline stage, it stamps the pending actuation. The control thread preempts the serial monitor, so the tick, 
+     *  which observes the pending flag, started after the dispatch.
+     *
+     *  @param f_timestamp         timestamp of the tick in microsecond
+     */
+    void CLinkBenchmark::process(uint32_t f_timestamp)
+    {
+        if (m_isActuationPending)
+        {
+            m_actuationTime = us_ticker_read();
+            m_isActuationPending = false;
+            m_isActuationReady = true;
+            Notify();
+        }
+    }
+
+    /** \brief  Count a flood frame, the frame rate is computed from the receive times of the first and of the last frame.
+     *
+     *  @param f_sequence          sequence number of the frame
+     */
+    void CLinkBenchmark::flood(uint32_t f_sequence)
+    {
+        if (m_floodCount == 0)
+        {
+            m_floodFirst = m_monitor.getRxTimestamp();
+        }
+        else if (f_sequence > m_floodNext)
+        {
+            m_floodLost += f_sequence - m_floodNext;
+        }
+        m_floodNext = f_sequence + 1;
+        m_floodLast = m_monitor.getRxTimestamp();
+        m_floodCount++;
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input string
+     *  @param b                   output string
+     */
+    void CLinkBenchmark::serialCallback(char const * a, char * b)
+    {
+        uint32_t l_dispatch = us_ticker_read();
+        int l_command;
+        unsigned long l_sequence = 0;
+        int32_t l_res = sscanf(a,"%d;%lu",&l_command,&l_sequence);
+        if (1 > l_res || (((l_command >= 1 && l_command <= 3) || l_command == 6) && 2 != l_res))
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        switch (l_command)
+        {
+            case 0:
+            {
+                const CSerialMonitor::SStatistics& l_stats = m_monitor.getStatistics();
+                uint32_t l_elapsed = m_floodLast - m_floodFirst;
+                float l_rate = (m_floodCount > 1 && l_elapsed > 0) ? (m_floodCount - 1) * 1e6f / l_elapsed : 0.0f;
+                utils::fmt::CWriter(b).udec(l_stats.m_frames).udec(l_stats.m_invalid).udec(l_stats.m_rxDropped).udec(l_stats.m_parseDropped)
+                                      .udec(m_floodCount).udec(m_floodLost).fixed(l_rate,1).chr(';');
+                break;
+            }
+            case 2:
+                m_actuationSequence = l_sequence;
+                m_isActuationReady = false;
+                m_isActuationPending = true;
+                // fall through
+            case 1:
+                sprintf(b,"ack;;%lu;%lu;%lu;%lu;%lu;", l_sequence, static_cast<unsigned long>(m_monitor.getRxTimestamp())
+                       , static_cast<unsigned long>(m_monitor.getParseTimestamp()), static_cast<unsigned long>(l_dispatch)
+                       , static_cast<unsigned long>(us_ticker_read()));
+                break;
+            case 3:
+                flood(l_sequence);
+                b[0] = '\0';
+                break;
+            case 4:
+                m_floodCount = 0;
+                m_floodLost = 0;
+                m_floodNext = 0;
+                sprintf(b,"ack;;");
+                break;
+            case 5:
+            {
+                const CSerialMonitor::SStatistics& l_stats = m_monitor.getStatistics();
+                ISerialReceiver::SErrors l_errors = m_monitor.getReceiverErrors();
+                utils::fmt::CWriter(b).udec(l_stats.m_rxHighWater).udec(l_stats.m_parseHighWater).udec(l_errors.m_overruns)
+                                      .udec(l_errors.m_framing).udec(l_errors.m_noise).udec(l_errors.m_overflows).udec(l_errors.m_lost)
+                                      .udec(l_stats.m_throttled).udec(m_monitor.getFlowControl()).udec(l_stats.m_superseded)
+                                      .udec(l_stats.m_emergencyStops).chr(';');
+                break;
+            }
+            case 6:
+                if (l_sequence > CSerialMonitor::FLOW_XONXOFF || !m_monitor.setFlowControl(static_cast<CSerialMonitor::EFlowControl>(l_sequence)))
+                {
+                    sprintf(b,"invalid flow control;;");
+                    break;
+                }
+                sprintf(b,"ack;;");
+                break;
+            default:
+                sprintf(b,"sintax error;;");
+                break;
+        }
+    }
+
+    /** \brief  Run method, it sends the stamped actuation
+     */
+    void CLinkBenchmark::_run()
+    {
+        if (m_isActuationReady)
+        {
+            m_isActuationReady = false;
+            m_serial.printf("@BNCH:act;%lu;%lu;;\r\n", static_cast<unsigned long>(m_actuationSequence), static_cast<unsigned long>(m_actuationTime));
+        }
+    }
+
+}; // namespace utils::serial
@@ -30,98 +30,727 @@ namespace utils::serial{
 
     /** @brief  CSerialMonitor class constructor
      *
+     *  The received bytes are collected byte by byte by the receive interrupt of the serial object.
      *
      *  @param f_serialPort               reference to serial object
-     *  @param f_serialSubscriberMap      map with the key and the callback functions
+     *  @param f_transmitter              reference to the transmitter of the responses
+     *  @param f_serialSubscriberMap      dispatch table with the packed keys and the callback functions
+     *  @param f_binarySubscriberMap      dispatch table with the binary message identifiers and the callback functions
      */
     CSerialMonitor::CSerialMonitor(Serial& f_serialPort
-                    ,CSerialSubscriberMap f_serialSubscriberMap)
+                    ,CSerialTransmitter& f_transmitter
+                    ,CSerialSubscriberMap f_serialSubscriberMap
+                    ,CBinarySubscriberMap f_binarySubscriberMap)
             :utils::task::CTask(0)
-            , m_serialPort(f_serialPort)
+            , m_serialPort(&f_serialPort)
+            , m_receiver(NULL)
+            , m_transmitter(f_transmitter)
             , m_RxBuffer()
-            , m_TxBuffer()
             , m_parseBuffer()
-            , m_parseIt(m_parseBuffer.begin())
+            , m_parseLength(0)
             , m_serialSubscriberMap(f_serialSubscriberMap) 
+            , m_binarySubscriberMap(f_binarySubscriberMap)
+            , m_statistics()
+            , m_rxTimestamp(0)
+            , m_frameRxTimestamp(0)
+            , m_parseTimestamp(0)
+            , m_capture(NULL)
+            , m_flow(FLOW_NONE)
+            , m_rts(NULL)
+            , m_isThrottled(false)
+            , m_held()
+            , m_heldCount(0)
+            , m_emergencyFrame()
+            , m_emergencyMatch(0)
+            , m_emergencyStop()
             {
-                m_serialPort.attach(mbed::callback(this,&CSerialMonitor::serialRxCallback), Serial::RxIrq); 
-                m_serialPort.attach(mbed::callback(this,&CSerialMonitor::serialTxCallback), Serial::TxIrq); 
+                CBinaryProtocol::encode(BIN_EMERGENCY_STOP, NULL, 0, m_emergencyFrame, CBinaryProtocol::FRAMING_SYNC);
+                m_serialPort->attach(mbed::callback(this,&CSerialMonitor::serialRxCallback), Serial::RxIrq); 
             }
 
+    /** @brief  CSerialMonitor class constructor
+     *
+     *  The received bytes are collected by the given receiver (for example by DMA), the monitor reads them in blocks, when the receiver signals new bytes.
+     *
+     *  @param f_receiver                 reference to the receiver object
+     *  @param f_transmitter              reference to the transmitter of the responses
+     *  @param f_serialSubscriberMap      dispatch table with the packed keys and the callback functions
+     *  @param f_binarySubscriberMap      dispatch table with the binary message identifiers and the callback functions
+     */
+    CSerialMonitor::CSerialMonitor(ISerialReceiver& f_receiver
+                    ,CSerialTransmitter& f_transmitter
+                    ,CSerialSubscriberMap f_serialSubscriberMap
+                    ,CBinarySubscriberMap f_binarySubscriberMap)
+            :utils::task::CTask(0)
+            , m_serialPort(NULL)
+            , m_receiver(&f_receiver)
+            , m_transmitter(f_transmitter)
+            , m_RxBuffer()
+            , m_parseBuffer()
+            , m_parseLength(0)
+            , m_serialSubscriberMap(f_serialSubscriberMap) 
+            , m_binarySubscriberMap(f_binarySubscriberMap)
+            , m_statistics()
+            , m_rxTimestamp(0)
+            , m_frameRxTimestamp(0)
+            , m_parseTimestamp(0)
+            , m_capture(NULL)
+            , m_flow(FLOW_NONE)
+            , m_rts(NULL)
+            , m_isThrottled(false)
+            , m_held()
+            , m_heldCount(0)
+            , m_emergencyFrame()
+            , m_emergencyMatch(0)
+            , m_emergencyStop()
+            {
+                CBinaryProtocol::encode(BIN_EMERGENCY_STOP, NULL, 0, m_emergencyFrame, CBinaryProtocol::FRAMING_SYNC);
+                m_receiver->attach(mbed::callback(this,&CSerialMonitor::receiverCallback));
+                m_receiver->attachScanner(mbed::callback(this,&CSerialMonitor::scan));
+            }
+
+    /** @brief  Receiver callback, it notifies the monitor about the received bytes
+     *  
+     */
+    void CSerialMonitor::receiverCallback()
+    {
+        m_rxTimestamp = us_ticker_read();
+        checkLevel();
+        Notify();
+    }
+
     /** @brief  Rx callback actions
      *  
+     *  The Rx buffer is a lock-free single-producer single-consumer ring, so the interrupts aren't masked. When the buffer is full, 
+     *  the bytes are read and counted as dropped, so the overflow is measured instead of the overrun of the UART.
      */
     void CSerialMonitor::serialRxCallback()
     {
-        __disable_irq();
-        while ((m_serialPort.readable()) && (!m_RxBuffer.isFull())) {
-            char l_c = m_serialPort.getc();
+        m_rxTimestamp = us_ticker_read();
+        while (m_serialPort->readable()) {
+            char l_c = m_serialPort->getc();
+            scan(&l_c, 1);
+            if (m_RxBuffer.isFull())
+            {
+                m_statistics.m_rxDropped++;
+                continue;
+            }
             m_RxBuffer.push(l_c);
         }
-        __enable_irq();
+        checkLevel();
+        Notify();
         return;
     }
 
-    /** @brief  Tx callback actions
-     *  
+    /** @brief  Monitoring function
+     * 
+     * It has role to monitor the received messaged, it applies periodically or when the receiver notifies it. It drains all received bytes 
+     * in the parse buffer and it decodes all complete frames in the same run, so the latency of a command doesn't depend on the main loop speed. 
+     * The coalesced frames held by the run are dispatched after the draining.
      */
-    void CSerialMonitor::serialTxCallback()
+    void CSerialMonitor::_run()
     {
-        __disable_irq();
-        while ((m_serialPort.writeable()) && (!m_TxBuffer.isEmpty())) {
-            m_serialPort.putc(m_TxBuffer.pop());
+        while (fill() > 0)
+        {
+            parseFrames();
+        }
+        flushHeld();
+        if (m_isThrottled)
+        {
+            throttle(false);
         }
-        __enable_irq();
-        return;
     }
 
-    /** @brief  Monitoring function
+    /** @brief  Search the emergency stop frame in the received bytes
+     * 
+     * The bytes are matched one by one against the frame, the sync byte doesn't repeat in the frame, so a mismatch restarts the 
+     * matching. A complete frame applies the emergency stop callback.
+     * 
+     * @param f_data                      new bytes
+     * @param f_length                    number of the new bytes
+     */
+    void CSerialMonitor::scan(const char* f_data, uint32_t f_length)
+    {
+        for (uint32_t i = 0; i < f_length; i++)
+        {
+            uint8_t l_byte = static_cast<uint8_t>(f_data[i]);
+            if (l_byte != m_emergencyFrame[m_emergencyMatch])
+            {
+                m_emergencyMatch = (l_byte == m_emergencyFrame[0]) ? 1 : 0;
+                continue;
+            }
+            if (++m_emergencyMatch == s_emergencySize)
+            {
+                m_emergencyMatch = 0;
+                m_statistics.m_emergencyStops++;
+                if (m_emergencyStop)
+                {
+                    m_emergencyStop();
+                }
+            }
+        }
+    }
+
+    /** @brief  Measure the received bytes and throttle the sender
+     * 
+     * It's applied by the receive interrupts, it updates the high-water mark. With flow control the sender is throttled, when the 
+     * unread bytes fill half of the buffer, so the remaining half takes the bytes sent until the sender reacts.
+     */
+    void CSerialMonitor::checkLevel()
+    {
+        uint32_t l_level, l_capacity;
+        if (m_receiver != NULL)
+        {
+            l_level = m_receiver->getLevel();
+            l_capacity = m_receiver->getCapacity();
+        }
+        else
+        {
+            l_level = m_RxBuffer.getSize();
+            l_capacity = l_level + m_RxBuffer.getFree();
+        }
+        if (l_level > m_statistics.m_rxHighWater)
+        {
+            m_statistics.m_rxHighWater = l_level;
+        }
+        if (m_flow != FLOW_NONE && !m_isThrottled && 2 * l_level >= l_capacity)
+        {
+            throttle(true);
+        }
+    }
+
+    /** @brief  Throttle or resume the sender
+     * 
+     * The state changes only, when the XON/XOFF character was queued, so a full safety lane is retried by the next call.
+     * 
+     * @param f_stop                      true to throttle, false to resume the sender
+     */
+    void CSerialMonitor::throttle(bool f_stop)
+    {
+        core_util_critical_section_enter();
+        if (m_isThrottled != f_stop)
+        {
+            bool l_done = true;
+            if (m_flow == FLOW_RTS && m_rts != NULL)
+            {
+                m_rts->write(f_stop ? 1 : 0);
+            }
+            else if (m_flow == FLOW_XONXOFF)
+            {
+                char l_c = f_stop ? s_xoff : s_xon;
+                l_done = m_transmitter.write(&l_c, 1, CSerialTransmitter::LANE_SAFETY);
+            }
+            if (l_done)
+            {
+                m_isThrottled = f_stop;
+                m_statistics.m_throttled += f_stop ? 1 : 0;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** @brief  Set the flow control, the throttled sender is resumed by the previous mode
+     * 
+     * @param f_mode                      flow control
+     * @return                            false, when the RTS output isn't set for the RTS flow control
+     */
+    bool CSerialMonitor::setFlowControl(EFlowControl f_mode)
+    {
+        if (f_mode == FLOW_RTS && m_rts == NULL)
+        {
+            return false;
+        }
+        throttle(false);
+        m_flow = f_mode;
+        m_isThrottled = false;
+        if (m_rts != NULL)
+        {
+            m_rts->write(0);
+        }
+        return true;
+    }
+
+    /** @brief  Error counters of the receiver
+     * 
+     * @return                            counters of the block based receiver, zero in receive interrupt mode
+     */
+    ISerialReceiver::SErrors CSerialMonitor::getReceiverErrors() const
+    {
+        if (m_receiver != NULL)
+        {
+            return m_receiver->getErrors();
+        }
+        ISerialReceiver::SErrors l_errors = ISerialReceiver::SErrors();
+        return l_errors;
+    }
+
+    /** @brief  Fill the parse buffer with the received bytes
+     * 
+     * In receive interrupt mode the bytes are read from the Rx buffer, otherwise they are read in blocks from the receiver. 
+     * 
+     * @return number of new bytes
+     */
+    uint32_t CSerialMonitor::fill()
+    {
+        m_frameRxTimestamp = m_rxTimestamp;
+        uint32_t l_free = m_parseBuffer.size() - 1 - m_parseLength;
+        char* l_dest = m_parseBuffer.data() + m_parseLength;
+        uint32_t l_count = 0;
+        if (m_receiver != NULL)
+        {
+            l_count = m_receiver->read(l_dest, l_free);
+        }
+        else
+        {
+            l_count = m_RxBuffer.pop(l_dest, l_free);
+        }
+        m_parseLength += l_count;
+        if (m_parseLength > m_statistics.m_parseHighWater)
+        {
+            m_statistics.m_parseHighWater = m_parseLength;
+        }
+        return l_count;
+    }
+
+    /** @brief  Search the first starting character of a text or binary frame
+     * 
+     * @param f_begin                     begin of the searched range
+     * @param f_end                       end of the searched range
+     * @return                            pointer to the starting character ('#', sync byte or COBS delimiter), NULL when it wasn't found
+     */
+    char* CSerialMonitor::findStart(char* f_begin, char* f_end)
+    {
+        char* l_text = static_cast<char*>(memchr(f_begin, '#', f_end - f_begin));
+        char* l_binary = static_cast<char*>(memchr(f_begin, CBinaryProtocol::s_sync, (l_text != NULL ? l_text : f_end) - f_begin));
+        char* l_first = (l_binary != NULL) ? l_binary : l_text;
+        char* l_cobs = static_cast<char*>(memchr(f_begin, CBinaryProtocol::s_delimiter, (l_first != NULL ? l_first : f_end) - f_begin));
+        return (l_cobs != NULL) ? l_cobs : l_first;
+    }
+
+    /** @brief  Search and decode the complete frames of the parse buffer
+     * 
+     * The bytes before the starting character ('#' or the binary synchronization byte) are dropped. The text frames are delimited by the next '\n' 
+     * character and they are validated by the ";;\r" ending, the binary frames are delimited by their length and validated by their checksum. 
+     * The COBS frames are delimited by the next zero byte, when they are invalid, the parsing continues from the delimiter, because it can be 
+     * the beginning of the next frame. The incomplete frame remains at the beginning of the buffer. When the buffer is full without a complete frame, 
+     * the content is dropped until the next starting character. 
+     */
+    void CSerialMonitor::parseFrames()
+    {
+        char* l_begin = m_parseBuffer.data();
+        char* l_end = l_begin + m_parseLength;
+        while (l_begin < l_end)
+        {
+            char* l_start = findStart(l_begin, l_end);
+            if (l_start == NULL)
+            {
+                l_begin = l_end;
+                break;
+            }
+            if (CBinaryProtocol::s_delimiter == static_cast<uint8_t>(*l_start)) // COBS frame
+            {
+                char* l_stop = static_cast<char*>(memchr(l_start + 1, CBinaryProtocol::s_delimiter, l_end - l_start - 1));
+                if (l_stop == NULL)
+                {
+                    l_begin = l_start;
+                    break;
+                }
+                if (l_stop == l_start + 1) // Consecutive delimiters
+                {
+                    l_begin = l_stop;
+                    continue;
+                }
+                if (!dispatchCobs(l_start + 1, l_stop))
+                {
+                    m_statistics.m_invalid++;
+                    l_begin = l_stop;
+                    continue;
+                }
+                l_begin = l_stop + 1;
+                continue;
+            }
+            if (CBinaryProtocol::s_sync == static_cast<uint8_t>(*l_start)) // Binary frame
+            {
+                uint32_t l_available = l_end - l_start;
+                if (l_available < CBinaryProtocol::s_headerSize)
+                {
+                    l_begin = l_start;
+                    break;
+                }
+                const uint8_t* l_frame = reinterpret_cast<const uint8_t*>(l_start);
+                uint8_t l_length = l_frame[2];
+                uint32_t l_frameSize = CBinaryProtocol::s_headerSize + l_length + CBinaryProtocol::s_crcSize;
+                if (l_length > CBinaryProtocol::s_maxPayloadSize) // Invalid header, search the next frame
+                {
+                    m_statistics.m_invalid++;
+                    l_begin = l_start + 1;
+                    continue;
+                }
+                if (l_available < l_frameSize)
+                {
+                    l_begin = l_start;
+                    break;
+                }
+                uint16_t l_crc = CBinaryProtocol::crc16(l_frame + 1, CBinaryProtocol::s_headerSize - 1 + l_length);
+                uint16_t l_received = l_frame[l_frameSize - 2] | (static_cast<uint16_t>(l_frame[l_frameSize - 1]) << 8);
+                if (l_crc != l_received) // Corrupted frame, search the next frame
+                {
+                    m_statistics.m_invalid++;
+                    l_begin = l_start + 1;
+                    continue;
+                }
+                m_parseTimestamp = us_ticker_read();
+                m_statistics.m_frames++;
+                if (m_capture != NULL)
+                {
+                    m_capture->capture(m_frameRxTimestamp, ICommandCapture::KIND_SYNC, l_frame + 1, 2 + l_length);
+                }
+                submitBinary(l_frame[1], l_frame + CBinaryProtocol::s_headerSize, l_length, CBinaryProtocol::FRAMING_SYNC);
+                l_begin = l_start + l_frameSize;
+                continue;
+            }
+            char* l_stop = static_cast<char*>(memchr(l_start, '\n', l_end - l_start)); // Message ending character
+            if (l_stop == NULL)
+            {
+                l_begin = l_start;
+                break;
+            }
+            char* l_next = findStart(l_start + 1, l_stop);
+            if (l_next != NULL) // A new frame started before the ending of the current one
+            {
+                m_statistics.m_invalid++;
+                l_begin = l_next;
+                continue;
+            }
+            if ((l_stop - l_start >= 4) && (';' == l_stop[-3]) && (';' == l_stop[-2]) && ('\r' == l_stop[-1])) // Check the message ending
+            {
+                *l_stop = '\0';
+                m_parseTimestamp = us_ticker_read();
+                m_statistics.m_frames++;
+                if (m_capture != NULL)
+                {
+                    m_capture->capture(m_frameRxTimestamp, ICommandCapture::KIND_TEXT, reinterpret_cast<const uint8_t*>(l_start), l_stop - l_start);
+                }
+                submit(l_start);
+            }
+            else
+            {
+                m_statistics.m_invalid++;
+            }
+            l_begin = l_stop + 1;
+        }
+        m_parseLength = l_end - l_begin;
+        if (m_parseLength == m_parseBuffer.size() - 1) // Full buffer without a complete frame
+        {
+            char* l_next = findStart(l_begin + 1, l_end);
+            l_begin = (l_next != NULL) ? l_next : l_end;
+            m_statistics.m_parseDropped += l_begin - (l_end - m_parseLength);
+            m_parseLength = l_end - l_begin;
+        }
+        if (m_parseLength > 0 && l_begin != m_parseBuffer.data())
+        {
+            memmove(m_parseBuffer.data(), l_begin, m_parseLength);
+        }
+    }
+
+    /** @brief  Dispatch a received text frame by the policy of its key
+     * 
+     * The short frames of the coalesced keys are held, the other frames are dispatched after the held ones, so they keep their order.
+     * 
+     * @param f_frame                     null terminated frame, started with '#' character and ended with ";;\r"
+     */
+    void CSerialMonitor::submit(char* f_frame)
+    {
+        uint32_t l_length = strlen(f_frame);
+        if (l_length >= 10 && l_length < s_heldSize && ':' == f_frame[5])
+        {
+            const CSerialSubscriberMap::SEntry* l_entry = m_serialSubscriberMap.findEntry(key(f_frame + 1));
+            if (l_entry != NULL && POLICY_LATEST == l_entry->m_policy)
+            {
+                hold(l_entry->m_key, false, f_frame, l_length + 1, CBinaryProtocol::FRAMING_SYNC);
+                return;
+            }
+        }
+        flushHeld();
+        dispatch(f_frame);
+    }
+
+    /** @brief  Dispatch a received binary frame by the policy of its identifier
+     * 
+     * @param f_id                        message identifier
+     * @param f_payload                   pointer to the payload
+     * @param f_length                    length of the payload
+     * @param f_framing                   framing of the request
+     */
+    void CSerialMonitor::submitBinary(uint8_t f_id, const uint8_t* f_payload, uint8_t f_length, CBinaryProtocol::EFraming f_framing)
+    {
+        const CBinarySubscriberMap::SEntry* l_entry = m_binarySubscriberMap.findEntry(f_id);
+        if (l_entry != NULL && POLICY_LATEST == l_entry->m_policy && f_length <= s_heldSize)
+        {
+            hold(f_id, true, reinterpret_cast<const char*>(f_payload), f_length, f_framing);
+            return;
+        }
+        flushHeld();
+        dispatchBinary(f_id, f_payload, f_length, f_framing);
+    }
+
+    /** @brief  Hold a coalesced frame
+     * 
+     * The waiting frame of the same key is answered as superseded and it's removed, the new frame is appended, so the held frames 
+     * keep the order of their newest reception. Without free slot the held frames are dispatched first.
+     * 
+     * @param f_key                       packed key or binary identifier
+     * @param f_binary                    the frame is binary
+     * @param f_data                      text frame with its terminator or binary payload
+     * @param f_length                    length of the data
+     * @param f_framing                   framing of the binary frame
+     */
+    void CSerialMonitor::hold(uint32_t f_key, bool f_binary, const char* f_data, uint32_t f_length, CBinaryProtocol::EFraming f_framing)
+    {
+        for (uint32_t i = 0; i < m_heldCount; i++)
+        {
+            SHeld& l_held = m_held[i];
+            if (l_held.m_key != f_key || l_held.m_binary != f_binary)
+            {
+                continue;
+            }
+            if (f_binary)
+            {
+                uint8_t l_status = BIN_SUPERSEDED;
+                uint8_t l_frame[CBinaryProtocol::s_maxFrameSize];
+                uint32_t l_size = CBinaryProtocol::encode(static_cast<uint8_t>(f_key) | CBinaryProtocol::s_responseFlag, &l_status, sizeof(l_status), l_frame, l_held.m_framing);
+                m_transmitter.write(reinterpret_cast<const char*>(l_frame), l_size);
+            }
+            else
+            {
+                m_transmitter.printf("@%.4s:superseded;;\r\n", l_held.m_data + 1);
+            }
+            m_statistics.m_superseded++;
+            for (uint32_t j = i + 1; j < m_heldCount; j++)
+            {
+                m_held[j - 1] = m_held[j];
+            }
+            m_heldCount--;
+            break;
+        }
+        if (m_heldCount == s_maxHeld)
+        {
+            flushHeld();
+        }
+        SHeld& l_held = m_held[m_heldCount++];
+        l_held.m_key = f_key;
+        l_held.m_binary = f_binary;
+        l_held.m_framing = f_framing;
+        l_held.m_length = static_cast<uint8_t>(f_length);
+        memcpy(l_held.m_data, f_data, f_length);
+    }
+
+    /** @brief  Dispatch the held frames in the order of their reception
+     */
+    void CSerialMonitor::flushHeld()
+    {
+        for (uint32_t i = 0; i < m_heldCount; i++)
+        {
+            SHeld& l_held = m_held[i];
+            if (l_held.m_binary)
+            {
+                dispatchBinary(static_cast<uint8_t>(l_held.m_key), reinterpret_cast<const uint8_t*>(l_held.m_data), l_held.m_length, l_held.m_framing);
+            }
+            else
+            {
+                dispatch(l_held.m_data);
+            }
+        }
+        m_heldCount = 0;
+    }
+
+    /** @brief  Decode a frame and apply its callback function
      * 
-     * It has role to monitor the received messaged, it applies periodically to read the buffer content and to decode it. 
      * Each validted messages are redirectionated to the callback function, by appling these. The callback function requires two input as pointers,
      *  one for message's content and one for response's content. After the appling the callback function, it will send the response to the other device.
+     *  The key is read directly from the frame as a packed integer, the content is the remaining part of the frame without the "\r" ending.
+     * 
+     * @param f_frame                     null terminated frame, started with '#' character and ended with ";;\r"
      */
-    void CSerialMonitor::_run()
+    void CSerialMonitor::dispatch(char* f_frame)
     {
-        if ((!m_RxBuffer.isEmpty()))
+        uint32_t l_length = strlen(f_frame);
+        if (l_length < 10 || ':' != f_frame[5]) // Check the key and the delimiter, "#KEY1:" + content + ";;\r"
+        {
+            return;
+        }
+        if (key("BTCH") == key(f_frame + 1)) // Batch frame decoded by the monitor
+        {
+            f_frame[l_length - 1] = '\0';
+            char l_resp[256];
+            dispatchBatch(f_frame + 6,l_resp);
+            m_transmitter.printf("@BTCH:%s\r\n",l_resp);
+            return;
+        }
+        const FCallback* l_callback = m_serialSubscriberMap.find(key(f_frame + 1)); // Search the key and callback function pair
+        if (l_callback != NULL) // Check the existence of key 
         {
-            char l_c = m_RxBuffer.pop(); // Read the next character from buffer
-            if ('#' == l_c) // Message starting special character
+            f_frame[l_length - 1] = '\0'; // Remove the '\r' character
+            char l_resp[256] = "no response given"; // Initial response message
+            (*l_callback)(f_frame + 6,l_resp); // Apply the attached function
+            if ('\0' != l_resp[0]) // The empty response is suppressed
             {
-                m_parseIt = m_parseBuffer.begin();
-                m_parseIt[0] = l_c;
-                m_parseIt++;
+                m_transmitter.printf("@%.4s:%s\r\n",f_frame + 1,l_resp); // Create the response message
+            }
+        }
+    }
+
+    /** @brief  Apply the sub-commands of a batch frame
+     * 
+     * The content is split at the '|' characters, each sub-command ("KEY:content") is completed with the ";;" ending and it's passed to its callback function. 
+     * The callbacks are applied in a critical section, so the control loop interrupt can't observe a partially applied batch. The responses are 
+     * aggregated in the same order, without their ";;" ending. The unknown keys are answered with "unknown", a malformed batch isn't applied.
+     * 
+     * @param f_content                   content of the frame after the "#BTCH:" header, ended with ";;"
+     * @param f_resp                      aggregated response, at least 256 bytes
+     */
+    void CSerialMonitor::dispatchBatch(char* f_content, char* f_resp)
+    {
+        uint32_t l_length = strlen(f_content);
+        if (l_length < 2 || 0 != strcmp(f_content + l_length - 2, ";;"))
+        {
+            sprintf(f_resp,"sintax error;;");
+            return;
+        }
+        f_content[l_length - 2] = '\0';
+
+        char* l_commands[s_maxBatchCommands];
+        uint32_t l_count = 0;
+        for (char* l_command = f_content; l_command != NULL; )
+        {
+            char* l_next = strchr(l_command, '|');
+            if (l_next != NULL)
+            {
+                *l_next++ = '\0';
+            }
+            if (l_count == s_maxBatchCommands || strlen(l_command) < 5 || ':' != l_command[4] || key("BTCH") == key(l_command))
+            {
+                sprintf(f_resp,"sintax error;;");
                 return;
             }
-            if (m_parseIt != m_parseBuffer.end())
+            l_commands[l_count++] = l_command;
+            l_command = l_next;
+        }
+
+        uint32_t l_used = 0;
+        char l_content[256];
+        char l_subResp[256];
+        core_util_critical_section_enter();
+        for (uint32_t i = 0; i < l_count; ++i)
+        {
+            const FCallback* l_callback = m_serialSubscriberMap.find(key(l_commands[i]));
+            if (l_callback != NULL)
             {
-                if (l_c == '\n') // Message ending character
+                snprintf(l_content,sizeof(l_content),"%s;;",l_commands[i] + 5);
+                strcpy(l_subResp,"no response given");
+                (*l_callback)(l_content,l_subResp);
+                uint32_t l_subLength = strlen(l_subResp);
+                if (l_subLength >= 2 && 0 == strcmp(l_subResp + l_subLength - 2, ";;"))
                 {
-                    if ((';' == m_parseIt[-3]) && (';' == m_parseIt[-2]) && ('\r' == m_parseIt[-1])) // Check the message ending
-                    {
-                        char l_msgID[5];
-                        char l_msg[256];
-
-                        uint32_t res = sscanf(m_parseBuffer.data(),"#%4s:%s;;",l_msgID,l_msg); //Parse the message to key and content
-                        if (res == 2) // Check the parsing
-                        {
-                            auto l_pair = m_serialSubscriberMap.find(l_msgID); // Search the key and callback function pair
-                            if (l_pair != m_serialSubscriberMap.end()) // Check the existence of key 
-                            {
-                                char l_resp[256] = "no response given"; // Initial response message
-                                string s(l_resp);
-                                l_pair->second(l_msg,l_resp); // Apply the attached function
-                                m_serialPort.printf("@%s:%s\r\n",l_msgID,l_resp); // Create the response message
-                            }
-                        }
-                        m_parseIt = m_parseBuffer.begin(); //Go to begining of parse buffer.
-                    }
+                    l_subResp[l_subLength - 2] = '\0';
                 }
-                m_parseIt[0] = l_c;
-                m_parseIt++;
-                return;
             }
+            else
+            {
+                strcpy(l_subResp,"unknown");
+            }
+            int l_written = snprintf(f_resp + l_used, 254 - l_used, "%s%.4s:%s", (i > 0) ? "|" : "", l_commands[i], l_subResp);
+            if (l_written > 0)
+            {
+                l_used += (static_cast<uint32_t>(l_written) < 254 - l_used) ? l_written : 253 - l_used;
+            }
+        }
+        core_util_critical_section_exit();
+        strcpy(f_resp + l_used,";;");
+    }
+
+    /** @brief  Decode a COBS frame and apply its callback function
+     * 
+     * The stuffed bytes are restored in place, they contain the identifier, the length, the payload and the checksum like the frame with sync byte. 
+     * 
+     * @param f_start                     first stuffed byte after the leading delimiter
+     * @param f_stop                      trailing delimiter
+     * @return                            true, when the frame was valid
+     */
+    bool CSerialMonitor::dispatchCobs(char* f_start, char* f_stop)
+    {
+        uint8_t* l_frame = reinterpret_cast<uint8_t*>(f_start);
+        uint32_t l_size = CBinaryProtocol::cobsDecode(l_frame, f_stop - f_start, l_frame);
+        const uint32_t l_overhead = CBinaryProtocol::s_headerSize - 1 + CBinaryProtocol::s_crcSize;
+        if (l_size < l_overhead || l_frame[1] != l_size - l_overhead)
+        {
+            return false;
+        }
+        uint8_t l_length = l_frame[1];
+        uint16_t l_crc = CBinaryProtocol::crc16(l_frame, 2 + l_length);
+        uint16_t l_received = l_frame[l_size - 2] | (static_cast<uint16_t>(l_frame[l_size - 1]) << 8);
+        if (l_crc != l_received)
+        {
+            return false;
+        }
+        m_parseTimestamp = us_ticker_read();
+        m_statistics.m_frames++;
+        if (m_capture != NULL)
+        {
+            m_capture->capture(m_frameRxTimestamp, ICommandCapture::KIND_COBS, l_frame, 2 + l_length);
+        }
+        submitBinary(l_frame[0], l_frame + 2, l_length, CBinaryProtocol::FRAMING_COBS);
+        return true;
+    }
+
+    /** @brief  Dispatch a captured frame, it's applied like a received frame, but it isn't captured again. The content is changed 
+     * by the dispatch, so it has to be a copy of the captured frame.
+     * 
+     * @param f_kind                      kind of the frame
+     * @param f_data                      captured content of the frame, a text frame needs one more byte for its terminator
+     * @param f_size                      number of the captured bytes
+     * @return                            false, when the content is invalid
+     */
+    bool CSerialMonitor::replay(ICommandCapture::EKind f_kind, uint8_t* f_data, uint32_t f_size)
+    {
+        if (ICommandCapture::KIND_TEXT == f_kind)
+        {
+            if (f_size == 0 || '#' != f_data[0])
+            {
+                return false;
+            }
+            f_data[f_size] = '\0';
+            dispatch(reinterpret_cast<char*>(f_data));
+            return true;
+        }
+        if (f_size < 2 || f_data[1] != f_size - 2)
+        {
+            return false;
+        }
+        dispatchBinary(f_data[0], f_data + 2, f_data[1], (ICommandCapture::KIND_COBS == f_kind) ? CBinaryProtocol::FRAMING_COBS : CBinaryProtocol::FRAMING_SYNC);
+        return true;
+    }
+
+    /** @brief  Apply the callback function of a binary frame
+     * 
+     * The response frame has the identifier of the request with the response flag and its payload is the status code returned by the callback. 
+     * The unknown identifiers are ignored. 
+     * 
+     * @param f_id                        message identifier
+     * @param f_payload                   pointer to the payload
+     * @param f_length                    length of the payload
+     * @param f_framing                   framing of the request, the response has the same framing
+     */
+    void CSerialMonitor::dispatchBinary(uint8_t f_id, const uint8_t* f_payload, uint8_t f_length, CBinaryProtocol::EFraming f_framing)
+    {
+        const CBinaryProtocol::FBinaryCallback* l_callback = m_binarySubscriberMap.find(f_id);
+        if (l_callback != NULL)
+        {
+            uint8_t l_status = (*l_callback)(f_payload, f_length);
+            uint8_t l_frame[CBinaryProtocol::s_maxFrameSize];
+            uint32_t l_size = CBinaryProtocol::encode(f_id | CBinaryProtocol::s_responseFlag, &l_status, sizeof(l_status), l_frame, f_framing);
+            m_transmitter.write(reinterpret_cast<const char*>(l_frame), l_size);
         }
     }
 
-}; // namespace serial
\ No newline at end of file
+}; // namespace serial
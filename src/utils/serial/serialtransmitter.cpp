@@ -0,0 +1,344 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    SerialTransmitter.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the buffered serial transmitter.
+  ******************************************************************************
+ */
+
+#include <utils/serial/serialtransmitter.hpp>
+#include <cstdarg>
+#include <cstring>
+#include <utils/clock/boardclock.hpp>
+
+namespace utils::serial{
+
+    /** \brief  CSerialTransmitter class constructor
+     *
+     *  The lanes are drained by the transmit interrupt of the serial object, the interrupt is enabled only while a message is queued.
+     *
+     *  @param f_serialPort    reference to serial object
+     */
+    CSerialTransmitter::CSerialTransmitter(Serial& f_serialPort)
+        : m_serialPort(&f_serialPort)
+        , m_sender(NULL)
+        , m_lanes()
+        , m_lane(0)
+        , m_frameRemaining(0)
+        , m_inFlight(0)
+        , m_active(false)
+        , m_retry()
+        , m_retryPending(false)
+        , m_dropped(0)
+    {
+    }
+
+    /** \brief  CSerialTransmitter class constructor
+     *
+     *  The lanes are drained in contiguous blocks by the given sender.
+     *
+     *  @param f_sender        reference to sender object
+     */
+    CSerialTransmitter::CSerialTransmitter(ISerialSender& f_sender)
+        : m_serialPort(NULL)
+        , m_sender(&f_sender)
+        , m_lanes()
+        , m_lane(0)
+        , m_frameRemaining(0)
+        , m_inFlight(0)
+        , m_active(false)
+        , m_retry()
+        , m_retryPending(false)
+        , m_dropped(0)
+    {
+        m_sender->attach(mbed::callback(this,&CSerialTransmitter::senderCallback));
+    }
+
+    /** \brief  Write a message in the buffer of a lane
+     *
+     *  When the stamping of the board clock is enabled, the text lines (starting with '@', ending with the line terminator) get 
+     *  the board time in microsecond as last field ('|time'), the binary frames are stamped by the encoder of the protocol.
+     *
+     *  @param f_data          pointer to the message
+     *  @param f_length        length of the message
+     *  @param f_lane          priority lane of the message
+     *  @return                true, when the message was written, false, when it was dropped
+     */
+    bool CSerialTransmitter::write(const char* f_data, uint32_t f_length, ELane f_lane)
+    {
+        if (f_length >= 3 && f_length + s_stampLength <= s_maxMessageLength && f_data[0] == '@' && f_data[f_length - 2] == '\r' 
+            && f_data[f_length - 1] == '\n' && utils::clock::CBoardClock::isStamping())
+        {
+            char l_message[s_maxMessageLength];
+            memcpy(l_message, f_data, f_length - 2);
+            uint32_t l_length = f_length - 2;
+            l_length += sprintf(l_message + l_length, "|%lu\r\n", static_cast<unsigned long>(utils::clock::CBoardClock::now32()));
+            return enqueue(l_message, l_length, f_lane);
+        }
+        return enqueue(f_data, f_length, f_lane);
+    }
+
+    /** \brief  Copy a message in the buffer of a lane
+     *
+     *  @param f_data          pointer to the message
+     *  @param f_length        length of the message
+     *  @param f_lane          priority lane of the message
+     *  @return                true, when the message was written, false, when it was dropped
+     */
+    bool CSerialTransmitter::enqueue(const char* f_data, uint32_t f_length, ELane f_lane)
+    {
+        if (f_length == 0)
+        {
+            return true;
+        }
+        core_util_critical_section_enter();
+        SLane& l_lane = m_lanes[f_lane];
+        utils::CRingBuffer<char,s_laneBufferSize>::SSpan l_spans[2];
+        if (f_length > l_lane.m_buffer.getWritable(l_spans) || l_lane.m_frames.isFull())
+        {
+            m_dropped++;
+            l_lane.m_dropped++;
+            core_util_critical_section_exit();
+            return false;
+        }
+        uint32_t l_first = (f_length < l_spans[0].m_length) ? f_length : l_spans[0].m_length;
+        memcpy(l_spans[0].m_data, f_data, l_first);
+        memcpy(l_spans[1].m_data, f_data + l_first, f_length - l_first);
+        l_lane.m_buffer.commit(f_length);
+        l_lane.m_frames.push(static_cast<uint16_t>(f_length));
+        kick();
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Format and write a message in the buffer of the response lane
+     *
+     *  @param f_format        format string as by printf
+     *  @return                true, when the message was written, false, when it was dropped
+     */
+    bool CSerialTransmitter::printf(const char* f_format, ...)
+    {
+        va_list l_args;
+        va_start(l_args, f_format);
+        bool l_written = vprintf(LANE_RESPONSE, f_format, l_args);
+        va_end(l_args);
+        return l_written;
+    }
+
+    /** \brief  Format and write a message in the buffer of a lane
+     *
+     *  @param f_lane          priority lane of the message
+     *  @param f_format        format string as by printf
+     *  @return                true, when the message was written, false, when it was dropped
+     */
+    bool CSerialTransmitter::printf(ELane f_lane, const char* f_format, ...)
+    {
+        va_list l_args;
+        va_start(l_args, f_format);
+        bool l_written = vprintf(f_lane, f_format, l_args);
+        va_end(l_args);
+        return l_written;
+    }
+
+    /** \brief  Set the rate limit of a lane
+     *
+     *  The lane is skipped by the scheduler, while its bucket is empty. A message longer than the available tokens is transmitted 
+     *  and it's paid from the next refills, so the burst doesn't limit the length of the messages.
+     *
+     *  @param f_lane            priority lane
+     *  @param f_bytesPerSecond  average rate in bytes per second, zero removes the limit
+     *  @param f_burst           capacity of the bucket in bytes
+     */
+    void CSerialTransmitter::setRateLimit(ELane f_lane, float f_bytesPerSecond, float f_burst)
+    {
+        core_util_critical_section_enter();
+        SLane& l_lane = m_lanes[f_lane];
+        l_lane.m_rate = f_bytesPerSecond;
+        l_lane.m_burst = f_burst;
+        l_lane.m_tokens = f_burst;
+        l_lane.m_lastRefill = us_ticker_read();
+        kick();
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  A lane has queued messages or its message is under transmission, for example before the change of the baud rate.
+     *
+     *  @param f_lane            priority lane
+     *  @return                  true, when the lane isn't drained yet
+     */
+    bool CSerialTransmitter::isPending(ELane f_lane) const
+    {
+        core_util_critical_section_enter();
+        bool l_isPending = !m_lanes[f_lane].m_frames.isEmpty() || (m_frameRemaining > 0 && m_lane == static_cast<uint32_t>(f_lane));
+        core_util_critical_section_exit();
+        return l_isPending;
+    }
+
+    /** \brief  Format and write a message
+     *
+     *  @param f_lane          priority lane of the message
+     *  @param f_format        format string as by printf
+     *  @param f_args          arguments of the format string
+     *  @return                true, when the message was written, false, when it was dropped
+     */
+    bool CSerialTransmitter::vprintf(ELane f_lane, const char* f_format, va_list f_args)
+    {
+        char l_message[s_maxMessageLength];
+        int l_length = vsnprintf(l_message, sizeof(l_message), f_format, f_args);
+        if (l_length < 0)
+        {
+            return false;
+        }
+        if (static_cast<uint32_t>(l_length) >= sizeof(l_message))
+        {
+            l_length = sizeof(l_message) - 1;
+        }
+        return write(l_message, l_length, f_lane);
+    }
+
+    /** \brief  Select the next message
+     *
+     *  The message under transmission is finished first, then the first queued message of the highest lane with available tokens is selected. 
+     *  When only exhausted lanes have messages, the retry timeout is programmed to the nearest refill.
+     *
+     *  @return                true, when a message is under transmission
+     */
+    bool CSerialTransmitter::select()
+    {
+        if (m_frameRemaining > 0)
+        {
+            return true;
+        }
+        uint32_t l_now = us_ticker_read();
+        uint32_t l_wait_us = 0;
+        for (uint32_t i = 0; i < LANE_COUNT; ++i)
+        {
+            SLane& l_lane = m_lanes[i];
+            if (l_lane.m_frames.isEmpty())
+            {
+                continue;
+            }
+            if (l_lane.m_rate > 0.0f)
+            {
+                l_lane.m_tokens += (l_now - l_lane.m_lastRefill) * 1e-6f * l_lane.m_rate;
+                l_lane.m_lastRefill = l_now;
+                if (l_lane.m_tokens > l_lane.m_burst)
+                {
+                    l_lane.m_tokens = l_lane.m_burst;
+                }
+                if (l_lane.m_tokens <= 0.0f)
+                {
+                    uint32_t l_laneWait_us = static_cast<uint32_t>(-l_lane.m_tokens / l_lane.m_rate * 1e6f) + 1;
+                    if (l_wait_us == 0 || l_laneWait_us < l_wait_us)
+                    {
+                        l_wait_us = l_laneWait_us;
+                    }
+                    continue;
+                }
+            }
+            uint16_t l_length;
+            l_lane.m_frames.pop(l_length);
+            if (l_lane.m_rate > 0.0f)
+            {
+                l_lane.m_tokens -= l_length;
+            }
+            m_lane = i;
+            m_frameRemaining = l_length;
+            return true;
+        }
+        if (l_wait_us > 0 && !m_retryPending)
+        {
+            m_retryPending = true;
+            m_retry.attach_us(mbed::callback(this,&CSerialTransmitter::retryCallback), l_wait_us);
+        }
+        return false;
+    }
+
+    /** \brief  Start the draining of the lanes
+     *
+     *  In interrupt mode it enables the transmit interrupt, in sender mode it starts the transmission of the next contiguous block of the selected message.
+     */
+    void CSerialTransmitter::kick()
+    {
+        if (m_sender != NULL)
+        {
+            if (m_inFlight == 0 && select())
+            {
+                utils::CRingBuffer<char,s_laneBufferSize>::SSpan l_spans[2];
+                m_lanes[m_lane].m_buffer.getReadable(l_spans);
+                m_inFlight = (m_frameRemaining < l_spans[0].m_length) ? m_frameRemaining : l_spans[0].m_length;
+                m_sender->send(l_spans[0].m_data, m_inFlight);
+            }
+        }
+        else if (!m_active && select())
+        {
+            m_active = true;
+            m_serialPort->attach(mbed::callback(this,&CSerialTransmitter::serialTxCallback), Serial::TxIrq);
+        }
+    }
+
+    /** \brief  Transmit interrupt callback
+     *
+     *  It fills the transmitter, it disables the interrupt, when there isn't selectable message.
+     */
+    void CSerialTransmitter::serialTxCallback()
+    {
+        core_util_critical_section_enter();
+        char l_char;
+        while (m_serialPort->writeable())
+        {
+            if (!select() || !m_lanes[m_lane].m_buffer.pop(l_char))
+            {
+                m_active = false;
+                m_serialPort->attach(mbed::Callback<void()>(), Serial::TxIrq);
+                break;
+            }
+            m_serialPort->putc(l_char);
+            m_frameRemaining--;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Sender callback
+     *
+     *  It releases the transmitted block and it starts the next one.
+     */
+    void CSerialTransmitter::senderCallback()
+    {
+        core_util_critical_section_enter();
+        m_lanes[m_lane].m_buffer.consume(m_inFlight);
+        m_frameRemaining -= m_inFlight;
+        m_inFlight = 0;
+        kick();
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Retry timeout callback
+     *
+     *  It restarts the draining, after the tokens of a rate limited lane were refilled.
+     */
+    void CSerialTransmitter::retryCallback()
+    {
+        core_util_critical_section_enter();
+        m_retryPending = false;
+        kick();
+        core_util_critical_section_exit();
+    }
+
+}; // namespace utils::serial
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    LoadMonitor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the CPU load and stack 
+  *          headroom monitor.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/loadmonitor.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace utils::task{
+
+    volatile uint32_t CLoadMonitor::s_idleCycles = 0;
+    uint32_t CLoadMonitor::s_lastIdle = 0;
+    volatile bool CLoadMonitor::s_isSleeping = false;
+
+    /** \brief  CLoadMonitor class constructor
+     *
+     *  @param f_period            period of the measurement window in base ticks
+     *  @param f_isrCycles         getter of the interrupt cycles since its previous call
+     *  @param f_isrMaxCycles      getter of the maximum cycles of one interrupt
+     *  @param f_report            memory report, the first s_maxStacks threads of its list are monitored
+     */
+    CLoadMonitor::CLoadMonitor(uint32_t f_period, FCycleGetter f_isrCycles, FCycleGetter f_isrMaxCycles, utils::memory::CMemoryReport& f_report)
+        : CTask(f_period)
+        , m_isrCycles(f_isrCycles)
+        , m_isrMaxCycles(f_isrMaxCycles)
+        , m_report(f_report)
+        , m_lastCycles(0)
+        , m_lastIdleCycles(0)
+        , m_cpu(0)
+        , m_isr(0)
+        , m_freeStack()
+    {
+    }
+
+    /** \brief  Attach the idle hook and start the measurement. The cycle counter is enabled without reset, it's shared with the other measurements.
+     */
+    void CLoadMonitor::start()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        m_lastCycles = CTaskStatistics::cycles();
+        m_lastIdleCycles = s_idleCycles;
+        s_lastIdle = m_lastCycles;
+        Thread::attach_idle_hook(&CLoadMonitor::idleHook);
+    }
+
+    /** \brief  Enable the sleep of the idle thread, the core waits for the next interrupt in sleep mode, the peripherals keep running.
+     *
+     *  @param f_enable        the idle hook puts the core in sleep mode
+     */
+    void CLoadMonitor::setSleep(bool f_enable)
+    {
+        s_isSleeping = f_enable;
+    }
+
+    /** \brief  Idle hook, it's applied repeatedly by the idle thread
+     *
+     *  The sleep is entered with masked interrupts, the pending interrupt wakes up the core, but it's applied only after the 
+     *  measurement, so its execution isn't counted as idle. The cycle counter runs on the free-running clock in sleep mode.
+     */
+    void CLoadMonitor::idleHook()
+    {
+        uint32_t l_now = CTaskStatistics::cycles();
+        uint32_t l_gap = l_now - s_lastIdle;
+        s_lastIdle = l_now;
+        if (l_gap < s_idleGap)
+        {
+            s_idleCycles += l_gap;
+        }
+        if (s_isSleeping)
+        {
+            core_util_critical_section_enter();
+            __WFI();
+            uint32_t l_wake = CTaskStatistics::cycles();
+            s_idleCycles += l_wake - l_now;
+            s_lastIdle = l_wake;
+            core_util_critical_section_exit();
+        }
+    }
+
+    /** \brief  Periodically applied method, it computes the utilization of the elapsed period and it samples the stacks
+     */
+    void CLoadMonitor::_run()
+    {
+        uint32_t l_now = CTaskStatistics::cycles();
+        uint32_t l_idle = s_idleCycles;
+        uint32_t l_isr = m_isrCycles ? m_isrCycles() : 0;
+        float l_window = static_cast<float>(l_now - m_lastCycles);
+        if (l_window > 0)
+        {
+            float l_idlePercent = (l_idle - m_lastIdleCycles) * 100.0f / l_window;
+            m_cpu = (l_idlePercent < 100.0f) ? 100.0f - l_idlePercent : 0.0f;
+            m_isr = l_isr * 100.0f / l_window;
+        }
+        m_lastCycles = l_now;
+        m_lastIdleCycles = l_idle;
+        for (uint32_t i = 0; i < s_maxStacks; ++i)
+        {
+            Thread* l_thread = m_report.getThread(i);
+            m_freeStack[i] = (NULL != l_thread) ? l_thread->stack_size() - l_thread->max_stack() : 0;
+        }
+    }
+
+    /** \brief  Serial callback method to get the CPU utilization and the stack headroom.
+     *
+     * @param a                   input received string, it isn't used
+     * @param b                   output reponse message
+     */
+    void CLoadMonitor::serialCallback(char const * a, char * b)
+    {
+        uint32_t l_isrMax = m_isrMaxCycles ? m_isrMaxCycles() : 0;
+        utils::fmt::CWriter l_writer(b);
+        l_writer.fixed(m_cpu,1).fixed(m_isr,1).udec(l_isrMax / (SystemCoreClock / 1000000));
+        uint32_t l_stackCount = (m_report.getStackCount() < s_maxStacks) ? m_report.getStackCount() : s_maxStacks;
+        for (uint32_t i = 0; i < l_stackCount; ++i)
+        {
+            l_writer.udec(m_freeStack[i]);
+        }
+        l_writer.chr(';');
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    PriorityTaskManager.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the priority task manager.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/prioritytaskmanager.hpp>
+
+namespace utils::task{
+
+    /** \brief  CPriorityTaskManager class constructor
+     *
+     *  The threads aren't started here, the 'start' method has to be applied after the priority classes of the tasks were set. 
+     *  Until then the triggered tasks are only collected in the ready mask.
+     *
+     *  @param f_taskList      list of tasks
+     *  @param f_taskCount     number of tasks
+     *  @param f_baseFreq      base period of the ticker in seconds
+     *  @param f_stackSize     stack size of the normal and real-time threads in bytes
+     *  @param f_stackMemory   static memory of the two stacks (2*f_stackSize bytes, 8 byte aligned), the stacks are allocated from the heap without it
+     */
+    CPriorityTaskManager::CPriorityTaskManager(utils::task::CTask** f_taskList, uint32_t f_taskCount, float f_baseFreq, uint32_t f_stackSize, unsigned char* f_stackMemory)
+        : CTaskManager(f_taskList, f_taskCount, f_baseFreq, EVENT_DRIVEN)
+        , m_normalThread(osPriorityAboveNormal, f_stackSize, f_stackMemory)
+        , m_realtimeThread(osPriorityHigh, f_stackSize, (NULL != f_stackMemory) ? f_stackMemory + f_stackSize : NULL)
+    {
+        for(uint32_t i = 0; i < g_priorityClassCount; i++)
+        {
+            m_classes[i].m_manager = this;
+            m_classes[i].m_mask = 0;
+            m_classes[i].m_threadId = NULL;
+        }
+    }
+
+    /** \brief  CPriorityTaskManager class destructor
+     *  
+     */
+    CPriorityTaskManager::~CPriorityTaskManager() 
+    {
+        m_normalThread.terminate();
+        m_realtimeThread.terminate();
+    }
+
+    /** \brief  Start the threads of the priority classes
+     *  
+     *  It groups the tasks based on their priority classes and it starts the normal and the real-time threads. 
+     */
+    void CPriorityTaskManager::start()
+    {
+        uint32_t l_masks[g_priorityClassCount] = {0};
+        for(uint32_t i = 0; i < m_taskCount; i++)
+        {
+            l_masks[m_taskList[i]->getPriorityClass()] |= readyBit(i);
+        }
+        core_util_critical_section_enter();
+        for(uint32_t i = 0; i < g_priorityClassCount; i++)
+        {
+            m_classes[i].m_mask = l_masks[i];
+        }
+        core_util_critical_section_exit();
+        m_normalThread.start(mbed::callback(&CPriorityTaskManager::classThread, &m_classes[NORMAL]));
+        m_realtimeThread.start(mbed::callback(&CPriorityTaskManager::classThread, &m_classes[REALTIME]));
+    }
+
+    /** \brief  The main callback method aims to apply the background tasks' run method.
+     *  
+     *  It blocks the calling thread until at least one background task is triggered. 
+     */
+    void CPriorityTaskManager::mainCallback()
+    {
+        SPriorityClass& l_class = m_classes[BACKGROUND];
+        if (l_class.m_threadId == NULL)
+        {
+            l_class.m_threadId = osThreadGetId();
+        }
+        osSignalWait(s_readySignal, osWaitForever);
+        dispatch(takeReady(l_class.m_mask));
+    }
+
+    /** \brief  Mark the tasks in the ready mask and wake up the threads of their priority classes. 
+     *  
+     *  @param f_readyMask     bits of the ready tasks
+     */
+    void CPriorityTaskManager::notify(uint32_t f_readyMask)
+    {
+        core_util_critical_section_enter();
+        m_readyMask |= f_readyMask;
+        core_util_critical_section_exit();
+        for(uint32_t i = 0; i < g_priorityClassCount; i++)
+        {
+            if ((m_classes[i].m_mask & f_readyMask) && m_classes[i].m_threadId != NULL)
+            {
+                osSignalSet(m_classes[i].m_threadId, s_readySignal);
+            }
+        }
+    }
+
+    /** \brief  Thread function of a priority class
+     *  
+     *  It applies the triggered tasks of the class, then it waits for the next signal. 
+     *  
+     *  @param f_class         context of the priority class
+     */
+    void CPriorityTaskManager::classThread(SPriorityClass* f_class)
+    {
+        f_class->m_threadId = osThreadGetId();
+        while (true)
+        {
+            f_class->m_manager->dispatch(f_class->m_manager->takeReady(f_class->m_mask));
+            osSignalWait(s_readySignal, osWaitForever);
+        }
+    }
+
+    /** \brief  Thread of a priority class, it's used by the memory report
+     *
+     *  @param f_class         priority class
+     *  @return                thread of the normal and the real-time class, NULL for the background class applied by the main thread
+     */
+    Thread* CPriorityTaskManager::getThread(EPriorityClass f_class)
+    {
+        switch (f_class)
+        {
+            case NORMAL:    return &m_normalThread;
+            case REALTIME:  return &m_realtimeThread;
+            default:        return NULL;
+        }
+    }
+
+}; // namespace utils::task
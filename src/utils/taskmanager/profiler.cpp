@@ -0,0 +1,192 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    Profiler.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the statistical 
+  *          sampling profiler.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/profiler.hpp>
+#include <hardware/drivers/pcsampler.hpp>
+
+namespace utils::task{
+
+    CProfiler* CProfiler::s_instance = NULL;
+
+    /** \brief  CProfiler class constructor
+     *
+     *  @param f_serial            serial transmitter of the dump
+     *  @param f_dumpPeriod        period of the task during the dump in base ticks
+     */
+    CProfiler::CProfiler(utils::serial::CSerialTransmitter& f_serial, uint32_t f_dumpPeriod)
+        : CTask(0)
+        , m_serial(f_serial)
+        , m_dumpPeriod(f_dumpPeriod)
+        , m_base(FLASH_BASE)
+        , m_shift(s_defaultShift)
+        , m_samples(0)
+        , m_outside(0)
+        , m_buckets()
+        , m_isDumping(false)
+        , m_dumpIdx(0)
+    {
+    }
+
+    /** \brief  Clear the histogram and start the sampling
+     *
+     *  @param f_frequency         sampling frequency in Hz
+     *  @param f_shift             size of the buckets in bits (2..16)
+     *  @param f_base              start address of the histogram
+     *  @return                    false, when a dump is in progress or the parameters are invalid
+     */
+    bool CProfiler::start(float f_frequency, uint32_t f_shift, uint32_t f_base)
+    {
+        if (m_isDumping || f_shift < 2 || f_shift > 16)
+        {
+            return false;
+        }
+        hardware::drivers::CPcSampler_TIM11::stop();
+        m_base = f_base;
+        m_shift = f_shift;
+        m_samples = 0;
+        m_outside = 0;
+        memset(m_buckets, 0, sizeof(m_buckets));
+        s_instance = this;
+        hardware::drivers::CPcSampler_TIM11::attach(&CProfiler::sampleHook);
+        return hardware::drivers::CPcSampler_TIM11::start(f_frequency);
+    }
+
+    /** \brief  Stop the sampling, the histogram is kept
+     */
+    void CProfiler::stop()
+    {
+        hardware::drivers::CPcSampler_TIM11::stop();
+    }
+
+    /** \brief  Stop the sampling and start the dump
+     *
+     *  @return                    false, when a dump is in progress
+     */
+    bool CProfiler::dump()
+    {
+        if (m_isDumping)
+        {
+            return false;
+        }
+        stop();
+        m_dumpIdx = 0;
+        m_isDumping = true;
+        setPeriod(m_dumpPeriod);
+        return true;
+    }
+
+    /** \brief  Hook of the sampler, it's applied from the interrupt with the highest priority, so the counters aren't protected.
+     *
+     *  @param f_pc                sampled program counter
+     */
+    void CProfiler::sampleHook(uint32_t f_pc)
+    {
+        CProfiler* l_profiler = s_instance;
+        l_profiler->m_samples++;
+        uint32_t l_idx = (f_pc - l_profiler->m_base) >> l_profiler->m_shift;
+        if (f_pc < l_profiler->m_base || l_idx >= s_bucketCount)
+        {
+            l_profiler->m_outside++;
+            return;
+        }
+        l_profiler->m_buckets[l_idx]++;
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a                   input string
+     *  @param b                   output string
+     */
+    void CProfiler::serialCallback(char const * a, char * b)
+    {
+        int l_command;
+        float l_frequency = s_defaultFrequency;
+        unsigned int l_shift = s_defaultShift;
+        unsigned long l_base = FLASH_BASE;
+        int32_t l_res = sscanf(a,"%d;%f;%u;%lx",&l_command,&l_frequency,&l_shift,&l_base);
+        if (1 > l_res)
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        switch (l_command)
+        {
+            case 0:
+                sprintf(b,"%d;%lu;%lu;%08lx;%lu;;", hardware::drivers::CPcSampler_TIM11::isRunning() ? 1 : 0, static_cast<unsigned long>(m_samples)
+                       , static_cast<unsigned long>(m_outside), static_cast<unsigned long>(m_base), static_cast<unsigned long>(m_shift));
+                break;
+            case 1:
+                sprintf(b, start(l_frequency, l_shift, static_cast<uint32_t>(l_base)) ? "ack;;" : "sintax error;;");
+                break;
+            case 2:
+                stop();
+                sprintf(b,"ack;;%lu;", static_cast<unsigned long>(m_samples));
+                break;
+            case 3:
+                sprintf(b, dump() ? "ack;;" : "busy;;");
+                break;
+            default:
+                sprintf(b,"sintax error;;");
+                break;
+        }
+    }
+
+    /** \brief  Run method, it sends the histogram in frames. When the lane of the transmitter is full, the frame is sent again 
+     *  in the next period.
+     */
+    void CProfiler::_run()
+    {
+        if (!m_isDumping)
+        {
+            return;
+        }
+        do
+        {
+            uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+            utils::serial::SProfileHeader l_header;
+            uint32_t l_buckets = s_bucketCount - m_dumpIdx;
+            l_buckets = (l_buckets > s_frameBuckets) ? s_frameBuckets : l_buckets;
+            l_header.m_base = m_base;
+            l_header.m_samples = m_samples;
+            l_header.m_outside = m_outside;
+            l_header.m_first = static_cast<uint16_t>(m_dumpIdx);
+            l_header.m_total = static_cast<uint16_t>(s_bucketCount);
+            l_header.m_shift = static_cast<uint8_t>(m_shift);
+            l_header.m_count = static_cast<uint8_t>(l_buckets);
+            memcpy(l_payload, &l_header, sizeof(l_header));
+            memcpy(l_payload + sizeof(l_header), &m_buckets[m_dumpIdx], l_buckets * sizeof(uint32_t));
+            uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+            uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_PROFILE, l_payload
+                                                                    , sizeof(l_header) + l_buckets * sizeof(uint32_t), l_frame);
+            if (!m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_DEBUG))
+            {
+                return;
+            }
+            m_dumpIdx += l_buckets;
+        } while (m_dumpIdx < s_bucketCount);
+        m_isDumping = false;
+        setPeriod(0);
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    Schedulability.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the schedulability
+  *          analysis of the task list.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/schedulability.hpp>
+#include <utils/fmt/format.hpp>
+#include <cmath>
+
+namespace utils::task{
+
+    /** \brief  CSchedulability class constructor
+     *
+     *  The task has zero period, it's triggered once by 'startOneShot' after the warm-up of the statistics and by the serial request.
+     *
+     *  @param f_taskList          list of tasks
+     *  @param f_statisticsList    list of statistics objects, it has the same length as the list of tasks
+     *  @param f_taskCount         number of tasks, the first s_maxTasks tasks are analysed
+     *  @param f_baseTick          base tick of the task manager in seconds
+     *  @param f_sporadicPeriod    minimal inter-arrival time of the event driven tasks in base ticks
+     *  @param f_isrPeriod         period of the control loop in seconds, zero without control loop
+     *  @param f_isrMaxCycles      getter of the maximum cycles of one period of the control loop
+     *  @param f_transmitter       transmitter of the results
+     */
+    CSchedulability::CSchedulability(CTask** f_taskList, CTaskStatistics* f_statisticsList, uint32_t f_taskCount, float f_baseTick, uint32_t f_sporadicPeriod
+                                    , float f_isrPeriod, FCycleGetter f_isrMaxCycles, utils::serial::CSerialTransmitter& f_transmitter)
+        : CTask(0, BACKGROUND)
+        , m_taskList(f_taskList)
+        , m_statisticsList(f_statisticsList)
+        , m_taskCount((f_taskCount < s_maxTasks) ? f_taskCount : s_maxTasks)
+        , m_baseTick_us(f_baseTick * 1e6f)
+        , m_sporadicPeriod((f_sporadicPeriod > 0) ? f_sporadicPeriod : 1)
+        , m_isrPeriod(static_cast<uint32_t>(f_isrPeriod * 1e6f + 0.5f))
+        , m_isrMaxCycles(f_isrMaxCycles)
+        , m_transmitter(f_transmitter)
+        , m_results()
+        , m_isrWcet(0)
+        , m_utilization(0)
+        , m_bound(0)
+        , m_failed(0)
+    {
+    }
+
+    /** \brief  Apply the analysis with the present execution times and periods
+     *
+     *  The first pass collects the execution times and the utilization, the second one computes the response time of each task.
+     *  A result is written in critical section, so the serial callback reads a consistent entry.
+     *
+     *  @return                    number of the unschedulable tasks
+     */
+    uint32_t CSchedulability::analyse()
+    {
+        m_isrWcet = (m_isrPeriod > 0 && m_isrMaxCycles) ? cycles2us(m_isrMaxCycles()) : 0;
+        float l_utilization = (m_isrPeriod > 0) ? static_cast<float>(m_isrWcet) / m_isrPeriod : 0.0f;
+        uint32_t l_count = (m_isrPeriod > 0) ? 1 : 0;
+        for (uint32_t i = 0; i < m_taskCount; ++i)
+        {
+            SResult l_result;
+            uint32_t l_period = m_taskList[i]->getPeriod();
+            l_result.m_period = static_cast<uint32_t>(((l_period > 0) ? l_period : m_sporadicPeriod) * m_baseTick_us + 0.5f);
+            l_result.m_period = (l_result.m_period > 0) ? l_result.m_period : 1;
+            l_result.m_wcet = cycles2us(m_statisticsList[i].getMaxExecution());
+            l_result.m_response = 0;
+            if (!m_taskList[i]->isEnabled())
+            {
+                l_result.m_state = STATE_OFF;
+            }
+            else
+            {
+                l_result.m_state = (m_statisticsList[i].getCount() > 0) ? STATE_OK : STATE_UNMEASURED;
+                l_utilization += static_cast<float>(l_result.m_wcet) / l_result.m_period;
+                l_count++;
+            }
+            core_util_critical_section_enter();
+            m_results[i] = l_result;
+            core_util_critical_section_exit();
+        }
+        m_utilization = 100.0f * l_utilization;
+        m_bound = (l_count > 0) ? 100.0f * l_count * (powf(2.0f, 1.0f / l_count) - 1.0f) : 100.0f;
+
+        uint32_t l_failed = 0;
+        for (uint32_t i = 0; i < m_taskCount; ++i)
+        {
+            if (STATE_OFF == m_results[i].m_state)
+            {
+                continue;
+            }
+            uint32_t l_response = response(i);
+            core_util_critical_section_enter();
+            m_results[i].m_response = l_response;
+            if (STATE_OK == m_results[i].m_state && l_response > m_results[i].m_period)
+            {
+                m_results[i].m_state = STATE_MISS;
+            }
+            core_util_critical_section_exit();
+            if (STATE_MISS == m_results[i].m_state)
+            {
+                l_failed++;
+            }
+        }
+        m_failed = l_failed;
+        return l_failed;
+    }
+
+    /** \brief  Response time of a task by the fixed point iteration. The iteration stops, when the response exceeds the deadline,
+     *  the returned value is larger than the deadline in this case.
+     *
+     *  @param f_idx               index of the task
+     *  @return                    worst-case response time in microseconds
+     */
+    uint32_t CSchedulability::response(uint32_t f_idx) const
+    {
+        const SResult& l_task = m_results[f_idx];
+        EPriorityClass l_class = m_taskList[f_idx]->getPriorityClass();
+        uint64_t l_response = (l_task.m_wcet > 0) ? l_task.m_wcet : 1;
+        while (true)
+        {
+            uint64_t l_next = l_task.m_wcet;
+            if (m_isrPeriod > 0)
+            {
+                l_next += static_cast<uint64_t>(m_isrWcet) * ((l_response + m_isrPeriod - 1) / m_isrPeriod);
+            }
+            for (uint32_t j = 0; j < m_taskCount; ++j)
+            {
+                if (j == f_idx || STATE_OFF == m_results[j].m_state || m_taskList[j]->getPriorityClass() < l_class)
+                {
+                    continue;
+                }
+                l_next += static_cast<uint64_t>(m_results[j].m_wcet) * ((l_response + m_results[j].m_period - 1) / m_results[j].m_period);
+            }
+            if (l_next == l_response || l_next > l_task.m_period)
+            {
+                return (l_next < 0xFFFFFFFFULL) ? static_cast<uint32_t>(l_next) : 0xFFFFFFFFUL;
+            }
+            l_response = l_next;
+        }
+    }
+
+    /** \brief  Run method
+     *
+     *  It applies the analysis and it sends the summary, the unschedulable tasks are reported on the safety lane.
+     */
+    void CSchedulability::_run()
+    {
+        analyse();
+        char l_text[64];
+        utils::fmt::CWriter l_writer(l_text);
+        l_writer.fixed(m_utilization,1).fixed(m_bound,1).udec(m_failed).chr(';');
+        m_transmitter.printf("@SCHD:%s\r\n", l_text);
+        for (uint32_t i = 0; i < m_taskCount; ++i)
+        {
+            if (STATE_MISS == m_results[i].m_state)
+            {
+                m_transmitter.printf(utils::serial::CSerialTransmitter::LANE_SAFETY,"@SCHD:%lu;%lu;%lu;;\r\n", static_cast<unsigned long>(i)
+                                    , static_cast<unsigned long>(m_results[i].m_response), static_cast<unsigned long>(m_results[i].m_period));
+            }
+        }
+    }
+
+    /** \brief  Serial callback method to trigger the analysis or to get the last result of a task.
+     *
+     * @param a                   input received string, index of the task or -1 for a new analysis
+     * @param b                   output reponse message
+     */
+    void CSchedulability::serialCallback(char const * a, char * b)
+    {
+        static const char* s_states[] = {"off", "unmeasured", "ok", "miss"};
+        int l_idx;
+        uint32_t l_res = sscanf(a,"%d",&l_idx);
+        if (1 != l_res || l_idx < -1 || l_idx >= static_cast<int>(m_taskCount))
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        if (-1 == l_idx)
+        {
+            Notify();
+            sprintf(b,"ack;;");
+            return;
+        }
+        core_util_critical_section_enter();
+        SResult l_result = m_results[l_idx];
+        core_util_critical_section_exit();
+        utils::fmt::CWriter l_writer(b);
+        l_writer.udec(l_idx).udec(m_taskList[l_idx]->getPriorityClass()).udec(l_result.m_period).udec(l_result.m_wcet).udec(l_result.m_response)
+                .text(s_states[l_result.m_state]).text(";;");
+    }
+
+    /** \brief  Convert the cycles to microseconds, the fraction is rounded up, so the execution time isn't underestimated
+     *
+     * @param f_cycles            number of cycles
+     * @return                    time in microseconds
+     */
+    uint32_t CSchedulability::cycles2us(uint32_t f_cycles)
+    {
+        uint32_t l_cyclesPerUs = SystemCoreClock / 1000000;
+        return (f_cycles + l_cyclesPerUs - 1) / l_cyclesPerUs;
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    SequenceTask.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the stackless
+  *          sequences and the sequence task.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/sequencetask.hpp>
+
+namespace utils::task{
+
+    /** \brief  Post events to the sequence, it can be applied from interrupt context.
+     *
+     *  @param f_events        bits of the events
+     */
+    void CSequence::post(uint32_t f_events)
+    {
+        core_util_critical_section_enter();
+        m_events |= f_events;
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Take the posted events of the mask, the taken bits are cleared.
+     *
+     *  @param f_mask          bits of the awaited events
+     *  @return                true, when an event of the mask was posted
+     */
+    bool CSequence::take(uint32_t f_mask)
+    {
+        core_util_critical_section_enter();
+        uint32_t l_events = m_events & f_mask;
+        m_events &= ~l_events;
+        core_util_critical_section_exit();
+        return 0 != l_events;
+    }
+
+    /******************************************************************************/
+    /** \brief  CSequenceTask class constructor, the sequence is idle until the start.
+     *
+     *  @param f_period          period of the steps in base ticks, zero for the sequences resumed only by the events
+     *  @param f_priorityClass   priority class of the task
+     */
+    CSequenceTask::CSequenceTask(uint32_t f_period, EPriorityClass f_priorityClass)
+        : CTask(f_period, f_priorityClass)
+        , m_sequence()
+    {
+    }
+
+    /** \brief  Start the sequence from its beginning, the first part is applied in the next run of the task. It's applied from
+     *  thread context.
+     */
+    void CSequenceTask::start()
+    {
+        m_sequence.restart();
+        if (0 == m_period)
+        {
+            Notify();
+        }
+    }
+
+    /** \brief  Post events to the sequence, the task without period is notified, so its scheduler resumes the sequence. It can be
+     *  applied from interrupt context.
+     *
+     *  @param f_events        bits of the events
+     */
+    void CSequenceTask::post(uint32_t f_events)
+    {
+        m_sequence.post(f_events);
+        if (0 == m_period)
+        {
+            Notify();
+        }
+    }
+
+    /** \brief  Run method, it counts the step and it resumes the sequence after its last wait.
+     */
+    void CSequenceTask::_run()
+    {
+        if (!m_sequence.isRunning())
+        {
+            return;
+        }
+        m_sequence.tick();
+        _sequence();
+    }
+
+}; // namespace utils::task
@@ -22,20 +22,32 @@
   ******************************************************************************
  */
 #include <utils/taskmanager/taskmanager.hpp>
+#include <utils/telemetry/tracestream.hpp>
 
 namespace utils::task{
 
+    CTask* volatile CTask::s_running[g_priorityClassCount] = {NULL, NULL, NULL};
+
     /******************************************************************************/
     /** \brief  CTask class constructor
      *
      *  It initializes the period and other private value of the task. 
      *
-     *  @param f_period      execution period
+     *  @param f_period          execution period
+     *  @param f_priorityClass   priority class of the task
      */
-    CTask::CTask(uint32_t f_period) 
+    CTask::CTask(uint32_t f_period, EPriorityClass f_priorityClass) 
         : m_period(f_period)
-        , m_ticks(0)
+        , m_phase(0)
         , m_triggered(false) 
+        , m_priorityClass(f_priorityClass)
+        , m_scheduler(NULL)
+        , m_taskIdx(0)
+        , m_readyBit(0)
+        , m_isEnabled(true)
+        , m_isOneShot(false)
+        , m_statistics(NULL)
+        , m_triggerCycle(0)
     {
     }
 
@@ -49,7 +61,8 @@ namespace utils::task{
     /** \brief  Run method
      *
      *  It applies the '_run' method, which implements the task's functionality. It has to override in the derived class.  
-     *  
+     *  When a statistics object is attached, it measures the start jitter and the execution time. The task is marked as running 
+     *  in its priority class, so a crash can be assigned to it, and its start and end are emitted on the trace stream.
      *  
      */
     void CTask::run()
@@ -57,7 +70,203 @@ namespace utils::task{
         if (m_triggered)
         {
             m_triggered = false;
-            _run();
+            if (!m_isEnabled)
+            {
+                return;
+            }
+            CTask* l_previous = s_running[m_priorityClass];
+            s_running[m_priorityClass] = this;
+            utils::telemetry::CTraceStream::taskStart(m_taskIdx);
+            if (m_statistics != NULL)
+            {
+                uint32_t l_start = CTaskStatistics::cycles();
+                m_statistics->recordJitter(l_start - m_triggerCycle);
+                _run();
+                m_statistics->recordExecution(CTaskStatistics::cycles() - l_start);
+            }
+            else
+            {
+                _run();
+            }
+            utils::telemetry::CTraceStream::taskStop(m_taskIdx);
+            s_running[m_priorityClass] = l_previous;
+        }
+    }
+
+    /** \brief  Notify method
+     *
+     *  It triggers the task and it marks the task in the ready mask of the registered scheduler. It can be applied from interrupt context, 
+     *  for example by a receive interrupt, so the event driven schedulers apply the task without waiting for its period.  
+     */
+    void CTask::Notify()
+    {
+        Trigger();
+        if (m_scheduler != NULL)
+        {
+            m_scheduler->notify(m_readyBit);
+        }
+    }
+
+    /** \brief  Register the scheduler, which applies the task
+     *
+     *  @param f_scheduler     scheduler object
+     *  @param f_taskIdx       index of the task in the list of the scheduler
+     *  @param f_readyBit      bit of the task in the ready mask of the scheduler
+     */
+    void CTask::registerScheduler(CTaskScheduler* f_scheduler, uint32_t f_taskIdx, uint32_t f_readyBit)
+    {
+        m_scheduler = f_scheduler;
+        m_taskIdx = f_taskIdx;
+        m_readyBit = f_readyBit;
+    }
+
+    /** \brief  Change the period of the task
+     *
+     *  The period is counted again, so the task is triggered one full period after the change. The zero period stops the periodic 
+     *  triggering, the task is applied only by its event source. It can be applied from any thread, the static task manager keeps 
+     *  its compile-time periods.
+     *
+     *  @param f_period        new period in base ticks
+     */
+    void CTask::setPeriod(uint32_t f_period)
+    {
+        core_util_critical_section_enter();
+        m_period = f_period;
+        m_isOneShot = false;
+        core_util_critical_section_exit();
+        if (m_scheduler != NULL)
+        {
+            m_scheduler->reschedule(m_taskIdx);
+        }
+    }
+
+    /** \brief  Trigger the task once after the given delay, it enables the task. A running one-shot is restarted with the new delay.
+     *
+     *  @param f_delay         delay in base ticks, at least one tick
+     */
+    void CTask::startOneShot(uint32_t f_delay)
+    {
+        core_util_critical_section_enter();
+        m_period = (f_delay > 0) ? f_delay : 1;
+        m_isOneShot = true;
+        m_isEnabled = true;
+        core_util_critical_section_exit();
+        if (m_scheduler != NULL)
+        {
+            m_scheduler->reschedule(m_taskIdx);
+        }
+    }
+
+    /** \brief  Enable the task, its period is counted again from the enabling.
+     */
+    void CTask::enable()
+    {
+        m_isEnabled = true;
+        if (m_scheduler != NULL)
+        {
+            m_scheduler->reschedule(m_taskIdx);
+        }
+    }
+
+    /** \brief  Disable the task, a pending trigger is dropped by the run method.
+     */
+    void CTask::disable()
+    {
+        m_isEnabled = false;
+    }
+
+    /******************************************************************************/
+    /** \brief  CTaskScheduler class constructor
+     *
+     *  It registers itself to each task of the list. 
+     *
+     *  @param f_taskList      list of tasks
+     *  @param f_taskCount     number of tasks
+     */
+    CTaskScheduler::CTaskScheduler(utils::task::CTask** f_taskList, uint32_t f_taskCount)
+        : m_taskList(f_taskList)
+        , m_taskCount(f_taskCount) 
+        , m_readyMask(0)
+        , m_mainThreadId(NULL)
+    {
+        for(uint32_t i = 0; i < m_taskCount; i++)
+        {
+            m_taskList[i]->registerScheduler(this, i, readyBit(i));
+        }
+    }
+
+    /** \brief  CTaskScheduler class destructor
+     *  
+     */
+    CTaskScheduler::~CTaskScheduler() 
+    {
+    }
+
+    /** \brief  Mark the tasks in the ready mask and wake up the main thread. 
+     *  
+     *  @param f_readyMask     bits of the ready tasks
+     */
+    void CTaskScheduler::notify(uint32_t f_readyMask)
+    {
+        core_util_critical_section_enter();
+        m_readyMask |= f_readyMask;
+        core_util_critical_section_exit();
+        if (m_mainThreadId != NULL)
+        {
+            osSignalSet(m_mainThreadId, s_readySignal);
+        }
+    }
+
+    /** \brief  Apply the new period of a task. The schedulers with fixed periods ignore it, so it's empty.
+     *  
+     *  @param f_taskIdx       index of the task
+     */
+    void CTaskScheduler::reschedule(uint32_t f_taskIdx)
+    {
+    }
+
+    /** \brief  It blocks the calling thread until at least one task is ready. 
+     *  
+     *  The first call registers the calling thread, the triggering side can wake it up from now.
+     *  
+     *  @return bitmask of the ready tasks, it's cleared in the scheduler.
+     */
+    uint32_t CTaskScheduler::waitReady()
+    {
+        if (m_mainThreadId == NULL)
+        {
+            m_mainThreadId = osThreadGetId();
+        }
+        osSignalWait(s_readySignal, osWaitForever);
+        return takeReady(0xFFFFFFFF);
+    }
+
+    /** \brief  Take and clear the ready bits selected by the mask. 
+     *  
+     *  @param f_mask          bits to take
+     *  @return ready bits selected by the mask
+     */
+    uint32_t CTaskScheduler::takeReady(uint32_t f_mask)
+    {
+        core_util_critical_section_enter();
+        uint32_t l_readyMask = m_readyMask & f_mask;
+        m_readyMask &= ~f_mask;
+        core_util_critical_section_exit();
+        return l_readyMask;
+    }
+
+    /** \brief  Apply the run method of the tasks, which are marked in the given mask.
+     *  
+     *  @param f_readyMask     bitmask of the tasks to apply
+     */
+    void CTaskScheduler::dispatch(uint32_t f_readyMask)
+    {
+        for(uint32_t i = 0; i < m_taskCount; i++)
+        {
+            if (f_readyMask & readyBit(i))
+            {
+                m_taskList[i]->run();
+            }
         }
     }
 
@@ -69,11 +278,25 @@ namespace utils::task{
      *  @param f_taskList      list of tasks
      *  @param f_taskCount     number of tasks
      *  @param f_baseFreq      base frequency
+     *  @param f_mode          scheduling mode, polling or event driven
      */
-    CTaskManager::CTaskManager(utils::task::CTask** f_taskList, uint32_t f_taskCount, float f_baseFreq)
-        : m_taskList(f_taskList)
-        , m_taskCount(f_taskCount) 
+    CTaskManager::CTaskManager(utils::task::CTask** f_taskList, uint32_t f_taskCount, float f_baseFreq, ESchedulingMode f_mode)
+        : CTaskScheduler(f_taskList, f_taskCount)
+        , m_mode(f_mode)
+        , m_ticker()
+        , m_baseFreq(f_baseFreq)
+        , m_tickScale(1)
+        , m_wheel(f_baseFreq)
+        , m_expiredMask(0)
     {
+        for(uint32_t i = 0; i < m_taskCount && i < s_maxTaskCount; i++)
+        {
+            m_timers[i].attach(&CTaskManager::expireTask, this);
+            if (m_taskList[i]->getPeriod() > 0 && m_taskList[i]->isEnabled())
+            {
+                m_wheel.arm(m_timers[i], m_taskList[i]->getPeriod());
+            }
+        }
         m_ticker.attach(mbed::callback(this,&utils::task::CTaskManager::timerCallback), f_baseFreq);
     }
 
@@ -85,4 +308,183 @@ namespace utils::task{
         m_ticker.detach();
     }
 
-}; // namespace utils::task
\ No newline at end of file
+    /** \brief  Scale the period of the ticker
+     *  
+     *  The ticker is applied in each 'f_scale' base period and each interrupt advances the timer wheel by 'f_scale' ticks, so the 
+     *  periods are kept with the coarser resolution. The event sources (Notify) aren't affected. It's applied from thread context.
+     *
+     *  @param f_scale         number of the base ticks in an interrupt, one restores the base period
+     */
+    void CTaskManager::setTickScale(uint32_t f_scale)
+    {
+        if (f_scale == 0)
+        {
+            f_scale = 1;
+        }
+        if (f_scale != m_tickScale)
+        {
+            m_tickScale = f_scale;
+            m_ticker.attach(mbed::callback(this,&utils::task::CTaskManager::timerCallback), m_baseFreq * f_scale);
+        }
+    }
+
+    /** \brief  Apply the new period of a task, its timer is restarted with the period, the zero period and the disabled task cancel it.
+     *  It's applied from thread context.
+     *  
+     *  @param f_taskIdx       index of the task
+     */
+    void CTaskManager::reschedule(uint32_t f_taskIdx)
+    {
+        if (f_taskIdx >= s_maxTaskCount)
+        {
+            return;
+        }
+        CTask* l_task = m_taskList[f_taskIdx];
+        core_util_critical_section_enter();
+        uint32_t l_period = l_task->getPeriod();
+        if (l_period > 0 && l_task->isEnabled())
+        {
+            m_wheel.arm(m_timers[f_taskIdx], l_period);
+        }
+        else
+        {
+            m_wheel.cancel(m_timers[f_taskIdx]);
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Restart the timers of the periodic tasks with their phases. Each task is triggered first after its phase and its period, 
+     *  counted from the alignment, so the tasks keep the offsets. A later period change counts the period again without the phase.
+     */
+    void CTaskManager::alignPhases()
+    {
+        core_util_critical_section_enter();
+        for(uint32_t i = 0; i < m_taskCount && i < s_maxTaskCount; i++)
+        {
+            uint32_t l_period = m_taskList[i]->getPeriod();
+            if (l_period > 0 && m_taskList[i]->isEnabled())
+            {
+                m_wheel.arm(m_timers[i], l_period + m_taskList[i]->getPhase() % l_period);
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Distribute the phases of the periodic tasks and align them. 
+     *  
+     *  The tasks are placed from the shortest period, each one gets the phase, which coincides with the fewest placed tasks. The 
+     *  triggers of two tasks coincide, when their phases are equal modulo the greatest common divisor of their periods. The phases 
+     *  are tried up to s_maxPhase ticks, the phases set before are replaced. It's applied from thread context before the start of 
+     *  the tasks, it takes a few milliseconds.
+     *  
+     *  @return                upper bound of the number of the tasks, which are triggered in the same tick
+     */
+    uint32_t CTaskManager::balancePhases()
+    {
+        uint32_t l_count = (m_taskCount < s_maxTaskCount) ? m_taskCount : s_maxTaskCount;
+        bool l_placed[s_maxTaskCount] = {false};
+        uint32_t l_peak = 0;
+        while (true)
+        {
+            uint32_t l_next = l_count;
+            for(uint32_t i = 0; i < l_count; i++)
+            {
+                uint32_t l_period = m_taskList[i]->getPeriod();
+                if (!l_placed[i] && l_period > 0 && m_taskList[i]->isEnabled() 
+                    && (l_next == l_count || l_period < m_taskList[l_next]->getPeriod()))
+                {
+                    l_next = i;
+                }
+            }
+            if (l_next == l_count)
+            {
+                break;
+            }
+            uint32_t l_period = m_taskList[l_next]->getPeriod();
+            uint32_t l_limit = (l_period < s_maxPhase) ? l_period : s_maxPhase;
+            uint32_t l_phase = 0;
+            uint32_t l_best = 0xFFFFFFFF;
+            for(uint32_t l_offset = 0; l_offset < l_limit && l_best > 0; l_offset++)
+            {
+                uint32_t l_coinciding = 0;
+                for(uint32_t j = 0; j < l_count; j++)
+                {
+                    if (l_placed[j])
+                    {
+                        uint32_t l_gcd = gcd(l_period, m_taskList[j]->getPeriod());
+                        if (l_offset % l_gcd == m_taskList[j]->getPhase() % l_gcd)
+                        {
+                            l_coinciding++;
+                        }
+                    }
+                }
+                if (l_coinciding < l_best)
+                {
+                    l_best = l_coinciding;
+                    l_phase = l_offset;
+                }
+            }
+            m_taskList[l_next]->setPhase(l_phase);
+            l_placed[l_next] = true;
+            l_peak = (l_best + 1 > l_peak) ? l_best + 1 : l_peak;
+        }
+        alignPhases();
+        return l_peak;
+    }
+
+    /** \brief  Greatest common divisor
+     *
+     *  @param f_a             first value
+     *  @param f_b             second value
+     *  @return                greatest common divisor
+     */
+    uint32_t CTaskManager::gcd(uint32_t f_a, uint32_t f_b)
+    {
+        while (f_b != 0)
+        {
+            uint32_t l_r = f_a % f_b;
+            f_a = f_b;
+            f_b = l_r;
+        }
+        return f_a;
+    }
+
+    /** \brief  Expiry callback of the task timers, it's applied by the timer wheel in the ticker interrupt. The triggered task is 
+     *  collected in the ready bits of the interrupt, the periodic task is rearmed, the ended one-shot and the disabled task aren't.
+     *  
+     *  @param f_timer         expired timer of a task
+     */
+    void CTaskManager::expireTask(CTimerWheel::CTimer& f_timer)
+    {
+        CTaskManager* l_manager = static_cast<CTaskManager*>(f_timer.getContext());
+        uint32_t l_idx = static_cast<uint32_t>(&f_timer - l_manager->m_timers);
+        CTask* l_task = l_manager->m_taskList[l_idx];
+        if (l_task->elapse())
+        {
+            l_manager->m_expiredMask |= readyBit(l_idx);
+        }
+        uint32_t l_period = l_task->getPeriod();
+        if (l_period > 0 && l_task->isEnabled())
+        {
+            l_manager->m_wheel.arm(f_timer, l_period);
+        }
+    }
+
+    /** \brief  The main callback method aims to apply the subtasks' run method.
+     *  
+     *  In polling mode it applies the run method of each task. In event driven mode it blocks the calling thread until
+     *  the timer callback signals at least one triggered task, then it applies only the triggered tasks. 
+     */
+    void CTaskManager::mainCallback()
+    {
+        if (POLLING == m_mode)
+        {
+            dispatch(0xFFFFFFFF);
+        }
+        else
+        {
+            dispatch(waitReady());
+        }
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    TaskMonitor.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the task monitor.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/taskmonitor.hpp>
+
+namespace utils::task{
+
+    /** \brief  CTaskMonitor class constructor
+     *
+     *  It enables the cycle counter and it attaches a statistics object to each task.
+     *
+     *  @param f_taskList          list of tasks
+     *  @param f_statisticsList    list of statistics objects, it has the same length as the list of tasks
+     *  @param f_taskCount         number of tasks
+     */
+    CTaskMonitor::CTaskMonitor(CTask** f_taskList, CTaskStatistics* f_statisticsList, uint32_t f_taskCount)
+        : m_taskList(f_taskList)
+        , m_statisticsList(f_statisticsList)
+        , m_taskCount(f_taskCount)
+    {
+        CTaskStatistics::enableCycleCounter();
+        for(uint32_t i = 0; i < m_taskCount; i++)
+        {
+            m_taskList[i]->attachStatistics(&m_statisticsList[i]);
+        }
+    }
+
+    /** \brief  Serial callback method to get the statistics of a task or to reset all statistics.
+     *
+     * @param a                   input received string, index of the task or -1 for reset
+     * @param b                   output reponse message
+     */
+    void CTaskMonitor::serialCallback(char const * a, char * b)
+    {
+        int l_idx;
+        uint32_t l_res = sscanf(a,"%d",&l_idx);
+        if (1 != l_res || l_idx < -1 || l_idx >= static_cast<int>(m_taskCount))
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        if (-1 == l_idx)
+        {
+            for(uint32_t i = 0; i < m_taskCount; i++)
+            {
+                m_statisticsList[i].reset();
+            }
+            sprintf(b,"ack;;");
+            return;
+        }
+        const CTaskStatistics& l_stat = m_statisticsList[l_idx];
+        int l_len = sprintf(b,"%d;%lu;%lu;%lu;%lu;%lu;%lu;",l_idx
+                                                    ,static_cast<unsigned long>(l_stat.getCount())
+                                                    ,static_cast<unsigned long>(cycles2us(l_stat.getMinExecution()))
+                                                    ,static_cast<unsigned long>(cycles2us(l_stat.getMaxExecution()))
+                                                    ,static_cast<unsigned long>(cycles2us(l_stat.getMeanExecution()))
+                                                    ,static_cast<unsigned long>(cycles2us(l_stat.getMaxJitter()))
+                                                    ,static_cast<unsigned long>(l_stat.getMissed()));
+        for(uint32_t i = 0; i < CTaskStatistics::s_histogramSize; i++)
+        {
+            l_len += sprintf(b + l_len,(i == 0) ? "%lu" : ",%lu",static_cast<unsigned long>(l_stat.getHistogram(i)));
+        }
+        sprintf(b + l_len,";;");
+    }
+
+    /** \brief  Convert the cycles to microseconds
+     *
+     * @param f_cycles            number of cycles
+     * @return                    time in microseconds
+     */
+    uint32_t CTaskMonitor::cycles2us(uint32_t f_cycles)
+    {
+        return f_cycles / (SystemCoreClock / 1000000);
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    TaskStatistics.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the task execution statistics.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/taskstatistics.hpp>
+
+namespace utils::task{
+
+    /** \brief  CTaskStatistics class constructor
+     *
+     */
+    CTaskStatistics::CTaskStatistics()
+    {
+        reset();
+    }
+
+    /** \brief  Enable the DWT cycle counter
+     *
+     *  It has to be applied once, before the statistics are collected. 
+     */
+    void CTaskStatistics::enableCycleCounter()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /** \brief  Record the start jitter of an execution
+     *
+     *  @param f_cycles        delay between the trigger and the start of the execution in cycles
+     */
+    void CTaskStatistics::recordJitter(uint32_t f_cycles)
+    {
+        if (f_cycles > m_maxJitter)
+        {
+            m_maxJitter = f_cycles;
+        }
+        uint32_t l_us = f_cycles / (SystemCoreClock / 1000000);
+        uint32_t l_bin = 0;
+        while (l_us > 0 && l_bin < s_histogramSize - 1)
+        {
+            l_us >>= 1;
+            l_bin++;
+        }
+        m_histogram[l_bin]++;
+    }
+
+    /** \brief  Record the duration of an execution
+     *
+     *  @param f_cycles        execution time in cycles
+     */
+    void CTaskStatistics::recordExecution(uint32_t f_cycles)
+    {
+        if (m_count == 0 || f_cycles < m_minExecution)
+        {
+            m_minExecution = f_cycles;
+        }
+        if (f_cycles > m_maxExecution)
+        {
+            m_maxExecution = f_cycles;
+        }
+        m_sumExecution += f_cycles;
+        m_count++;
+    }
+
+    /** \brief  Reset the collected values
+     *
+     */
+    void CTaskStatistics::reset()
+    {
+        m_count = 0;
+        m_minExecution = 0;
+        m_maxExecution = 0;
+        m_sumExecution = 0;
+        m_maxJitter = 0;
+        m_missed = 0;
+        for(uint32_t i = 0; i < s_histogramSize; i++)
+        {
+            m_histogram[i] = 0;
+        }
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,227 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    TicklessTaskManager.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the tickless task manager.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/ticklesstaskmanager.hpp>
+
+namespace utils::task{
+
+    /** \brief  CTicklessTaskManager class constructor
+     *
+     *  It inserts the periodic tasks in the deadline heap and it programs the timeout to the first deadline. 
+     *  The periods of the tasks are expressed in base ticks. 
+     *
+     *  @param f_taskList      list of tasks
+     *  @param f_taskCount     number of tasks
+     *  @param f_baseTick      base tick in seconds
+     */
+    CTicklessTaskManager::CTicklessTaskManager(utils::task::CTask** f_taskList, uint32_t f_taskCount, float f_baseTick)
+        : CTaskScheduler(f_taskList, f_taskCount)
+        , m_baseTick_us(static_cast<uint32_t>(f_baseTick * 1000000.0f + 0.5f))
+        , m_heapSize(0)
+    {
+        uint32_t l_now = us_ticker_read();
+        for(uint32_t i = 0; i < m_taskCount && m_heapSize < s_maxTaskCount; i++)
+        {
+            if (m_taskList[i]->getPeriod() > 0)
+            {
+                SDeadline l_entry = {l_now + m_taskList[i]->getPeriod() * m_baseTick_us, i};
+                push(l_entry);
+            }
+        }
+        core_util_critical_section_enter();
+        arm(l_now);
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  CTicklessTaskManager class destructor
+     *  
+     */
+    CTicklessTaskManager::~CTicklessTaskManager() 
+    {
+        m_timeout.detach();
+    }
+
+    /** \brief  The main callback method aims to apply the triggered tasks' run method.
+     *  
+     *  It blocks the calling thread until the timeout or an event source signals at least one ready task.
+     */
+    void CTicklessTaskManager::mainCallback()
+    {
+        dispatch(waitReady());
+    }
+
+    /** \brief  Apply the new period of a task
+     *  
+     *  The entry of the task is replaced by a deadline one period after the current time, the zero period removes it. 
+     *  The timeout is programmed again, when the nearest deadline changed.
+     *  
+     *  @param f_taskIdx       index of the task
+     */
+    void CTicklessTaskManager::reschedule(uint32_t f_taskIdx)
+    {
+        core_util_critical_section_enter();
+        uint32_t l_now = us_ticker_read();
+        remove(f_taskIdx);
+        uint32_t l_period = m_taskList[f_taskIdx]->getPeriod();
+        if (l_period > 0 && m_heapSize < s_maxTaskCount)
+        {
+            SDeadline l_entry = {l_now + l_period * m_baseTick_us, f_taskIdx};
+            push(l_entry);
+        }
+        if (m_heapSize > 0)
+        {
+            arm(l_now);
+        }
+        else
+        {
+            m_timeout.detach();
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Timeout callback
+     *  
+     *  It triggers all due tasks, it computes their next deadline and it programs the timeout to the nearest one. The disabled 
+     *  tasks keep their deadlines without triggering, the elapsed one-shot tasks are removed. 
+     *  When a task is late with more than one period, its next deadline is resynchronized to the current time instead of 
+     *  triggering it repeatedly.
+     */
+    void CTicklessTaskManager::timeoutCallback()
+    {
+        uint32_t l_now = us_ticker_read();
+        uint32_t l_readyMask = 0;
+        while (m_heapSize > 0 && !earlier(l_now, m_heap[0].m_deadline))
+        {
+            SDeadline l_entry = pop();
+            CTask* l_task = m_taskList[l_entry.m_taskIdx];
+            if (l_task->elapse())
+            {
+                l_readyMask |= readyBit(l_entry.m_taskIdx);
+            }
+            if (l_task->getPeriod() == 0)
+            {
+                continue;
+            }
+            uint32_t l_period_us = l_task->getPeriod() * m_baseTick_us;
+            l_entry.m_deadline += l_period_us;
+            if (!earlier(l_now, l_entry.m_deadline))
+            {
+                l_entry.m_deadline = l_now + l_period_us;
+            }
+            push(l_entry);
+        }
+        arm(l_now);
+        if (l_readyMask)
+        {
+            notify(l_readyMask);
+        }
+    }
+
+    /** \brief  Program the timeout to the nearest deadline
+     *  
+     *  @param f_now           current time in microseconds
+     */
+    void CTicklessTaskManager::arm(uint32_t f_now)
+    {
+        if (m_heapSize == 0)
+        {
+            return;
+        }
+        uint32_t l_delta = earlier(f_now, m_heap[0].m_deadline) ? (m_heap[0].m_deadline - f_now) : 0;
+        m_timeout.attach_us(mbed::callback(this,&CTicklessTaskManager::timeoutCallback), l_delta);
+    }
+
+    /** \brief  Insert an entry in the heap
+     *  
+     *  @param f_entry         new entry
+     */
+    void CTicklessTaskManager::push(const SDeadline& f_entry)
+    {
+        uint32_t l_idx = m_heapSize++;
+        while (l_idx > 0)
+        {
+            uint32_t l_parent = (l_idx - 1) / 2;
+            if (!earlier(f_entry.m_deadline, m_heap[l_parent].m_deadline))
+            {
+                break;
+            }
+            m_heap[l_idx] = m_heap[l_parent];
+            l_idx = l_parent;
+        }
+        m_heap[l_idx] = f_entry;
+    }
+
+    /** \brief  Remove the first entry of the heap
+     *  
+     *  @return entry with the nearest deadline
+     */
+    CTicklessTaskManager::SDeadline CTicklessTaskManager::pop()
+    {
+        SDeadline l_first = m_heap[0];
+        SDeadline l_last = m_heap[--m_heapSize];
+        uint32_t l_idx = 0;
+        while (true)
+        {
+            uint32_t l_child = 2 * l_idx + 1;
+            if (l_child >= m_heapSize)
+            {
+                break;
+            }
+            if (l_child + 1 < m_heapSize && earlier(m_heap[l_child + 1].m_deadline, m_heap[l_child].m_deadline))
+            {
+                l_child++;
+            }
+            if (!earlier(m_heap[l_child].m_deadline, l_last.m_deadline))
+            {
+                break;
+            }
+            m_heap[l_idx] = m_heap[l_child];
+            l_idx = l_child;
+        }
+        m_heap[l_idx] = l_last;
+        return l_first;
+    }
+
+    /** \brief  Remove the entry of a task from the heap, the remaining entries are inserted again.
+     *  
+     *  @param f_taskIdx       index of the task
+     */
+    void CTicklessTaskManager::remove(uint32_t f_taskIdx)
+    {
+        SDeadline l_entries[s_maxTaskCount];
+        uint32_t l_count = 0;
+        for (uint32_t i = 0; i < m_heapSize; ++i)
+        {
+            if (m_heap[i].m_taskIdx != f_taskIdx)
+            {
+                l_entries[l_count++] = m_heap[i];
+            }
+        }
+        m_heapSize = 0;
+        for (uint32_t i = 0; i < l_count; ++i)
+        {
+            push(l_entries[i]);
+        }
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    TimerWheel.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the hierarchical
+  *          timer wheel of the software timers.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/timerwheel.hpp>
+
+namespace utils::task{
+
+    /** \brief  CTimerWheel class constructor, the slots are empty.
+     *
+     *  @param f_tick          period of a tick in seconds
+     */
+    CTimerWheel::CTimerWheel(float f_tick)
+        : m_now(0)
+        , m_tick(f_tick)
+    {
+        for (uint32_t l = 0; l < s_levelCount; l++)
+        {
+            for (uint32_t i = 0; i < s_slotCount; i++)
+            {
+                m_slots[l][i] = NULL;
+            }
+        }
+    }
+
+    /** \brief  Arm the timer, an armed timer is restarted with the new delay. It can be applied from any context.
+     *
+     *  @param f_timer         timer
+     *  @param f_delay         number of the ticks until the expiry, it's clamped to [1, s_maxDelay]
+     *  @param f_period        period of the rearming after each expiry in ticks, zero for a single expiry
+     */
+    void CTimerWheel::arm(CTimer& f_timer, uint32_t f_delay, uint32_t f_period)
+    {
+        if (f_delay == 0)
+        {
+            f_delay = 1;
+        }
+        else if (f_delay > s_maxDelay)
+        {
+            f_delay = s_maxDelay;
+        }
+        if (f_period > s_maxDelay)
+        {
+            f_period = s_maxDelay;
+        }
+        core_util_critical_section_enter();
+        if (f_timer.isArmed())
+        {
+            unlink(f_timer);
+        }
+        f_timer.m_expiry = m_now + f_delay - 1;
+        f_timer.m_period = f_period;
+        insert(f_timer);
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Cancel the timer, a timer, which isn't armed, is left unchanged. It can be applied from any context.
+     *
+     *  @param f_timer         timer
+     */
+    void CTimerWheel::cancel(CTimer& f_timer)
+    {
+        core_util_critical_section_enter();
+        if (f_timer.isArmed())
+        {
+            unlink(f_timer);
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Count the ticks and apply the callbacks of the expired timers. It's applied by the single source of the ticks, for
+     *  example the ticker interrupt of the task manager, each tick is resolved separately.
+     *
+     *  @param f_ticks         number of the elapsed ticks
+     */
+    void CTimerWheel::advance(uint32_t f_ticks)
+    {
+        for (uint32_t i = 0; i < f_ticks; i++)
+        {
+            step();
+        }
+    }
+
+    /** \brief  Remaining ticks of the timer until its next expiry
+     *
+     *  @param f_timer         timer
+     *  @return                number of the ticks, zero when the timer isn't armed
+     */
+    uint32_t CTimerWheel::remaining(const CTimer& f_timer) const
+    {
+        core_util_critical_section_enter();
+        uint32_t l_remaining = f_timer.isArmed() ? (f_timer.m_expiry - m_now + 1) : 0;
+        core_util_critical_section_exit();
+        return l_remaining;
+    }
+
+    /** \brief  Convert a time to ticks, it's rounded to the nearest tick
+     *
+     *  @param f_seconds       time in seconds
+     *  @return                number of the ticks, at least one
+     */
+    uint32_t CTimerWheel::toTicks(float f_seconds) const
+    {
+        float l_ticks = f_seconds / m_tick + 0.5f;
+        return (l_ticks < 1.0f) ? 1 : static_cast<uint32_t>(l_ticks);
+    }
+
+    /** \brief  Link the timer in the slot of its expiry. The finest level, whose range covers the distance from the current tick, is
+     *  selected, an already expired timer is linked in the current slot. It has to be applied from critical section.
+     *
+     *  @param f_timer         unlinked timer
+     */
+    void CTimerWheel::insert(CTimer& f_timer)
+    {
+        uint32_t l_distance = f_timer.m_expiry - m_now;
+        CTimer** l_slot;
+        if (static_cast<int32_t>(l_distance) < 0)
+        {
+            l_slot = &m_slots[0][m_now & s_slotMask];
+        }
+        else
+        {
+            uint32_t l_level = 0;
+            while (l_level < s_levelCount - 1 && l_distance >= (1UL << (s_levelBits * (l_level + 1))))
+            {
+                l_level++;
+            }
+            l_slot = &m_slots[l_level][(f_timer.m_expiry >> (s_levelBits * l_level)) & s_slotMask];
+        }
+        f_timer.m_next = *l_slot;
+        if (*l_slot != NULL)
+        {
+            (*l_slot)->m_pprev = &f_timer.m_next;
+        }
+        *l_slot = &f_timer;
+        f_timer.m_pprev = l_slot;
+    }
+
+    /** \brief  Unlink the timer from its list, it has to be applied from critical section.
+     *
+     *  @param f_timer         armed timer
+     */
+    void CTimerWheel::unlink(CTimer& f_timer)
+    {
+        *f_timer.m_pprev = f_timer.m_next;
+        if (f_timer.m_next != NULL)
+        {
+            f_timer.m_next->m_pprev = f_timer.m_pprev;
+        }
+        f_timer.m_next = NULL;
+        f_timer.m_pprev = NULL;
+    }
+
+    /** \brief  Redistribute the current slot of a level to the finer levels, it has to be applied from critical section.
+     *
+     *  @param f_level         level, at least one
+     *  @return                index of the redistributed slot, zero when the level wrapped around too
+     */
+    uint32_t CTimerWheel::cascade(uint32_t f_level)
+    {
+        uint32_t l_idx = (m_now >> (s_levelBits * f_level)) & s_slotMask;
+        CTimer* l_timer = m_slots[f_level][l_idx];
+        m_slots[f_level][l_idx] = NULL;
+        while (l_timer != NULL)
+        {
+            CTimer* l_next = l_timer->m_next;
+            insert(*l_timer);
+            l_timer = l_next;
+        }
+        return l_idx;
+    }
+
+    /** \brief  Apply the current tick. The wrapped levels are cascaded, then the timers of the current slot are taken one by one,
+     *  the periodic timers are rearmed from their expiry, so they don't drift, and the callbacks are applied outside of the critical
+     *  section. The taken list is headed by a local link, so a callback can cancel the other timers of the slot.
+     */
+    void CTimerWheel::step()
+    {
+        core_util_critical_section_enter();
+        uint32_t l_idx = m_now & s_slotMask;
+        if (l_idx == 0)
+        {
+            for (uint32_t l = 1; l < s_levelCount && cascade(l) == 0; l++)
+            {
+            }
+        }
+        m_now = m_now + 1;
+        CTimer* l_expired = m_slots[0][l_idx];
+        m_slots[0][l_idx] = NULL;
+        if (l_expired != NULL)
+        {
+            l_expired->m_pprev = &l_expired;
+        }
+        while (l_expired != NULL)
+        {
+            CTimer* l_timer = l_expired;
+            unlink(*l_timer);
+            if (l_timer->m_period > 0)
+            {
+                l_timer->m_expiry += l_timer->m_period;
+                insert(*l_timer);
+            }
+            core_util_critical_section_exit();
+            if (l_timer->m_expire != NULL)
+            {
+                l_timer->m_expire(*l_timer);
+            }
+            core_util_critical_section_enter();
+        }
+        core_util_critical_section_exit();
+    }
+
+}; // namespace utils::task
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  * @file    WorkQueue.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the deferred work 
+  *          queue of the serial callbacks.
+  ******************************************************************************
+ */
+#include <utils/taskmanager/workqueue.hpp>
+
+namespace utils::task{
+
+    /** \brief  CWorkQueue class constructor
+     *
+     *  The task has zero period, it's applied, when a work is posted. 
+     *
+     *  @param f_transmitter       transmitter of the results
+     */
+    CWorkQueue::CWorkQueue(utils::serial::CSerialTransmitter& f_transmitter)
+        : CTask(0, BACKGROUND)
+        , m_transmitter(f_transmitter)
+        , m_works()
+        , m_head(0)
+        , m_count(0)
+        , m_dropped(0)
+    {
+    }
+
+    /** \brief  Post a work, it's applied later by the task.
+     *
+     *  @param f_key               key of the command (four characters), the result is sent with it
+     *  @param f_work              work function
+     *  @return                    true, when the work was queued, false, when the queue is full
+     */
+    bool CWorkQueue::post(const char* f_key, FWork f_work)
+    {
+        core_util_critical_section_enter();
+        if (m_count == s_queueSize)
+        {
+            m_dropped++;
+            core_util_critical_section_exit();
+            return false;
+        }
+        SWork& l_work = m_works[(m_head + m_count) % s_queueSize];
+        strncpy(l_work.m_key, f_key, 4);
+        l_work.m_key[4] = '\0';
+        l_work.m_work = f_work;
+        m_count++;
+        core_util_critical_section_exit();
+        Notify();
+        return true;
+    }
+
+    /** \brief  Number of the works dropped, because the queue was full
+     *
+     *  @return                    number of dropped works
+     */
+    uint32_t CWorkQueue::getDropped() const
+    {
+        return m_dropped;
+    }
+
+    /** \brief  Run method
+     *
+     *  It applies the pending works in order and it sends their results. The work is applied outside of the critical section, 
+     *  the new works can be posted meanwhile.
+     */
+    void CWorkQueue::_run()
+    {
+        while (m_count > 0)
+        {
+            core_util_critical_section_enter();
+            SWork l_work = m_works[m_head];
+            m_head = (m_head + 1) % s_queueSize;
+            m_count--;
+            core_util_critical_section_exit();
+
+            char l_result[s_resultSize] = "";
+            l_work.m_work(l_result);
+            if (l_result[0] != '\0')
+            {
+                m_transmitter.printf("@%s:%s\r\n", l_work.m_key, l_result);
+            }
+        }
+    }
+
+}; // namespace utils::task
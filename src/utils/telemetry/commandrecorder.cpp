@@ -0,0 +1,307 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    commandrecorder.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the recorder and the replay of the received commands.
+  ******************************************************************************
+ */
+
+#include <utils/telemetry/commandrecorder.hpp>
+#include <string.h>
+
+namespace utils::telemetry{
+
+    /** \brief  CCommandRecorder class constructor, the memory isn't changed until 'restore'.
+     *
+     *  @param f_storage       memory of the log in the '.noinit' section
+     *  @param f_monitor       serial monitor of the captured and replayed frames
+     *  @param f_serial        reference to the serial transmitter of the dump
+     *  @param f_period        period of the task during the replay and the dump in base ticks
+     */
+    CCommandRecorder::CCommandRecorder(SStorage& f_storage, utils::serial::CSerialMonitor& f_monitor, utils::serial::CSerialTransmitter& f_serial, uint32_t f_period)
+        : utils::task::CTask(0)
+        , m_storage(f_storage)
+        , m_monitor(f_monitor)
+        , m_serial(f_serial)
+        , m_period(f_period)
+        , m_state(STATE_IDLE)
+        , m_offset(0)
+        , m_index(0)
+        , m_firstTimestamp(0)
+        , m_replayStart(0)
+        , m_skipped(0)
+    {
+    }
+
+    /** \brief  Validate the memory after the reset, an invalid log is cleared.
+     *
+     *  @return                true, when a log was found
+     */
+    bool CCommandRecorder::restore()
+    {
+        bool l_isValid = m_storage.m_magic == s_magic && m_storage.m_used <= s_capacity && m_storage.m_count <= m_storage.m_used
+                      && m_storage.m_check == check();
+        if (!l_isValid)
+        {
+            format();
+            return false;
+        }
+        return m_storage.m_count > 0;
+    }
+
+    /** \brief  Capture an accepted frame, it's applied by the serial monitor before the dispatch.
+     *
+     *  @param f_timestamp     arrival time of the frame in microsecond
+     *  @param f_kind          kind of the frame
+     *  @param f_data          content of the frame
+     *  @param f_size          size of the content
+     */
+    void CCommandRecorder::capture(uint32_t f_timestamp, EKind f_kind, const uint8_t* f_data, uint32_t f_size)
+    {
+        if (STATE_CAPTURE != m_state)
+        {
+            return;
+        }
+        if (KIND_TEXT == f_kind && f_size >= 5 && utils::serial::CSerialMonitor::key("CREC") == utils::serial::CSerialMonitor::key(reinterpret_cast<const char*>(f_data) + 1))
+        {
+            return;
+        }
+        if (f_size > s_maxFrameSize || m_storage.m_used + sizeof(utils::serial::SCommandEntry) + f_size > s_capacity)
+        {
+            m_skipped++;
+            return;
+        }
+        utils::serial::SCommandEntry l_entry;
+        l_entry.m_timestamp = f_timestamp;
+        l_entry.m_kind = static_cast<uint8_t>(f_kind);
+        l_entry.m_length = static_cast<uint8_t>(f_size);
+        memcpy(m_storage.m_data + m_storage.m_used, &l_entry, sizeof(l_entry));
+        memcpy(m_storage.m_data + m_storage.m_used + sizeof(l_entry), f_data, f_size);
+        m_storage.m_used += sizeof(l_entry) + f_size;
+        m_storage.m_count++;
+        m_storage.m_check = check();
+    }
+
+    /** \brief  Clear the log and start the capture
+     *
+     *  @return                false, when the recorder isn't idle
+     */
+    bool CCommandRecorder::startCapture()
+    {
+        if (STATE_IDLE != m_state)
+        {
+            return false;
+        }
+        format();
+        m_skipped = 0;
+        m_state = STATE_CAPTURE;
+        return true;
+    }
+
+    /** \brief  Start the replay of the log, the first entry is dispatched in the next period of the task.
+     *
+     *  @return                false, when the recorder isn't idle or the log is empty
+     */
+    bool CCommandRecorder::startReplay()
+    {
+        if (STATE_IDLE != m_state || 0 == m_storage.m_count)
+        {
+            return false;
+        }
+        utils::serial::SCommandEntry l_entry;
+        memcpy(&l_entry, m_storage.m_data, sizeof(l_entry));
+        m_firstTimestamp = l_entry.m_timestamp;
+        m_replayStart = us_ticker_read();
+        m_offset = 0;
+        m_index = 0;
+        m_state = STATE_REPLAY;
+        setPeriod(m_period);
+        return true;
+    }
+
+    /** \brief  Start the dump of the log
+     *
+     *  @return                false, when the recorder isn't idle
+     */
+    bool CCommandRecorder::dump()
+    {
+        if (STATE_IDLE != m_state)
+        {
+            return false;
+        }
+        m_offset = 0;
+        m_index = 0;
+        m_state = STATE_DUMP;
+        setPeriod(m_period);
+        return true;
+    }
+
+    /** \brief  Stop the capture, the replay or the dump, the log is kept.
+     */
+    void CCommandRecorder::stop()
+    {
+        m_state = STATE_IDLE;
+        setPeriod(0);
+    }
+
+    /** \brief  Serial callback of the commands: 0 - state ('state;count;used;skipped;;'), 1 - capture, 2 - stop, 3 - replay, 4 - dump.
+     *
+     *  @param a               input string with the command
+     *  @param b               output string
+     */
+    void CCommandRecorder::serialCallback(char const * a, char * b)
+    {
+        int l_command;
+        uint32_t l_res = sscanf(a,"%d",&l_command);
+        if (1 != l_res)
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        switch (l_command)
+        {
+            case 0:
+                sprintf(b,"%d;%lu;%lu;%lu;;", m_state, static_cast<unsigned long>(m_storage.m_count), static_cast<unsigned long>(m_storage.m_used)
+                                             , static_cast<unsigned long>(m_skipped));
+                break;
+            case 1:
+                sprintf(b, startCapture() ? "ack;;" : "busy;;");
+                break;
+            case 2:
+                stop();
+                sprintf(b,"ack;;");
+                break;
+            case 3:
+                sprintf(b, startReplay() ? "ack;;" : "busy;;");
+                break;
+            case 4:
+                if (dump())
+                {
+                    sprintf(b,"ack;;%lu;", static_cast<unsigned long>(m_storage.m_count));
+                }
+                else
+                {
+                    sprintf(b,"busy;;");
+                }
+                break;
+            default:
+                sprintf(b,"sintax error;;");
+                break;
+        }
+    }
+
+    /** \brief  Run method, it's periodic only during the replay and the dump.
+     */
+    void CCommandRecorder::_run()
+    {
+        if (STATE_REPLAY == m_state)
+        {
+            replayEntries();
+        }
+        else if (STATE_DUMP == m_state)
+        {
+            dumpEntries();
+        }
+    }
+
+    /** \brief  Dispatch the entries, whose offset from the first entry elapsed since the start of the replay. The content is copied,
+     *  because the dispatch changes it. The recorder is idle after the last entry.
+     */
+    void CCommandRecorder::replayEntries()
+    {
+        uint32_t l_elapsed = us_ticker_read() - m_replayStart;
+        while (m_index < m_storage.m_count)
+        {
+            utils::serial::SCommandEntry l_entry;
+            memcpy(&l_entry, m_storage.m_data + m_offset, sizeof(l_entry));
+            if (l_entry.m_timestamp - m_firstTimestamp > l_elapsed)
+            {
+                return;
+            }
+            uint8_t l_frame[s_maxFrameSize + 1];
+            memcpy(l_frame, m_storage.m_data + m_offset + sizeof(l_entry), l_entry.m_length);
+            m_monitor.replay(static_cast<EKind>(l_entry.m_kind), l_frame, l_entry.m_length);
+            m_offset += sizeof(l_entry) + l_entry.m_length;
+            m_index++;
+        }
+        stop();
+    }
+
+    /** \brief  Send the entries from the oldest one in frames, each frame contains as many entries as fit in it. When the lane of
+     *  the transmitter is full, the frame is sent again in the next period. An empty log is sent in a frame without entry.
+     */
+    void CCommandRecorder::dumpEntries()
+    {
+        do
+        {
+            uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+            uint32_t l_size = sizeof(utils::serial::SCommandRecordHeader);
+            uint32_t l_offset = m_offset;
+            uint32_t l_count = 0;
+            while (m_index + l_count < m_storage.m_count)
+            {
+                utils::serial::SCommandEntry l_entry;
+                memcpy(&l_entry, m_storage.m_data + l_offset, sizeof(l_entry));
+                uint32_t l_entrySize = sizeof(l_entry) + l_entry.m_length;
+                if (l_size + l_entrySize > sizeof(l_payload))
+                {
+                    break;
+                }
+                memcpy(l_payload + l_size, m_storage.m_data + l_offset, l_entrySize);
+                l_size += l_entrySize;
+                l_offset += l_entrySize;
+                l_count++;
+            }
+            utils::serial::SCommandRecordHeader l_header;
+            l_header.m_first = static_cast<uint16_t>(m_index);
+            l_header.m_total = static_cast<uint16_t>(m_storage.m_count);
+            l_header.m_count = static_cast<uint8_t>(l_count);
+            memcpy(l_payload, &l_header, sizeof(l_header));
+            uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+            uint32_t l_frameSize = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_COMMAND_RECORD, l_payload, l_size, l_frame);
+            if (!m_serial.write(reinterpret_cast<const char*>(l_frame), l_frameSize, utils::serial::CSerialTransmitter::LANE_TELEMETRY))
+            {
+                return;
+            }
+            m_offset = l_offset;
+            m_index += l_count;
+        } while (m_index < m_storage.m_count);
+        stop();
+    }
+
+    /** \brief  Clear the log, the entries aren't erased, only the state is restarted.
+     */
+    void CCommandRecorder::format()
+    {
+        m_storage.m_magic = s_magic;
+        m_storage.m_used = 0;
+        m_storage.m_count = 0;
+        m_storage.m_check = check();
+    }
+
+    /** \brief  Check value of the state, it detects the random content of the memory after the power on.
+     *
+     *  @return                check value
+     */
+    uint32_t CCommandRecorder::check() const
+    {
+        return ~(m_storage.m_magic ^ (m_storage.m_used << 7) ^ (m_storage.m_count << 19));
+    }
+
+}; // namespace utils::telemetry
@@ -0,0 +1,341 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    DerivedSignals.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the derived signal
+  *          expressions of the telemetry.
+  ******************************************************************************
+ */
+#include <utils/telemetry/derivedsignals.hpp>
+#include <utils/fmt/format.hpp>
+#include <utils/memory/sections.hpp>
+#include <string.h>
+#include <math.h>
+
+namespace utils::telemetry{
+
+    /** \brief  Value of a hexadecimal digit
+     *
+     *  @param f_char          character
+     *  @return                value, negative for an invalid character
+     */
+    static int32_t hexDigit(char f_char)
+    {
+        if (f_char >= '0' && f_char <= '9') return f_char - '0';
+        if (f_char >= 'a' && f_char <= 'f') return f_char - 'a' + 10;
+        if (f_char >= 'A' && f_char <= 'F') return f_char - 'A' + 10;
+        return -1;
+    }
+
+    /** \brief  CDerivedSignals class constructor, the slots forward their sources.
+     *
+     *  @param f_sources       getters of the source signals, the array has to remain valid
+     *  @param f_sourceCount   number of the sources, at most s_maxSources
+     */
+    CDerivedSignals::CDerivedSignals(const FSignalGetter* f_sources, uint8_t f_sourceCount)
+        : m_sources(f_sources)
+        , m_sourceCount((f_sourceCount < s_maxSources) ? f_sourceCount : s_maxSources)
+        , m_values()
+        , m_outputs()
+        , m_programs()
+        , m_windows()
+        , m_staged()
+        , m_stagedSlot(-1)
+    {
+    }
+
+    /** \brief  Pipeline stage, it applies the waiting program, it reads the sources, then it evaluates the slots in order.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CDerivedSignals::process(uint32_t f_timestamp)
+    {
+        int8_t l_staged = m_stagedSlot;
+        if (l_staged >= 0)
+        {
+            __DMB();
+            m_programs[l_staged] = m_staged;
+            m_windows[l_staged].m_sum = 0.0f;
+            m_windows[l_staged].m_index = 0;
+            m_windows[l_staged].m_count = 0;
+            __DMB();
+            m_stagedSlot = -1;
+        }
+        for (uint8_t i = 0; i < m_sourceCount; ++i)
+        {
+            m_values[i] = m_sources[i]();
+        }
+        for (uint8_t i = 0; i < s_slots; ++i)
+        {
+            if (0 != m_programs[i].m_length)
+            {
+                m_outputs[i] = evaluate(m_programs[i], m_windows[i]);
+            }
+            else
+            {
+                m_outputs[i] = (i < m_sourceCount) ? m_values[i] : 0.0f;
+            }
+        }
+    }
+
+    /** \brief  Evaluate a verified program, the stack can't overflow or underflow.
+     *
+     *  @param f_program       program
+     *  @param f_window        window of the mean operation
+     *  @return                result
+     */
+    CONTROL_RAMFUNC float CDerivedSignals::evaluate(const SProgram& f_program, SWindow& f_window) const
+    {
+        float l_stack[s_stackDepth];
+        uint8_t l_top = 0;
+        for (uint8_t i = 0; i < f_program.m_length; ++i)
+        {
+            const SInstruction& l_instruction = f_program.m_code[i];
+            switch (l_instruction.m_opcode)
+            {
+                case OP_SOURCE: l_stack[l_top++] = m_values[l_instruction.m_argument]; break;
+                case OP_CONST:  l_stack[l_top++] = f_program.m_constants[l_instruction.m_argument]; break;
+                case OP_SLOT:   l_stack[l_top++] = m_outputs[l_instruction.m_argument]; break;
+                case OP_DUP:    l_stack[l_top] = l_stack[l_top - 1]; ++l_top; break;
+                case OP_ADD:    --l_top; l_stack[l_top - 1] += l_stack[l_top]; break;
+                case OP_SUB:    --l_top; l_stack[l_top - 1] -= l_stack[l_top]; break;
+                case OP_MUL:    --l_top; l_stack[l_top - 1] *= l_stack[l_top]; break;
+                case OP_DIV:
+                    --l_top;
+                    l_stack[l_top - 1] = (0.0f != l_stack[l_top]) ? l_stack[l_top - 1] / l_stack[l_top] : 0.0f;
+                    break;
+                case OP_MIN:
+                    --l_top;
+                    l_stack[l_top - 1] = (l_stack[l_top] < l_stack[l_top - 1]) ? l_stack[l_top] : l_stack[l_top - 1];
+                    break;
+                case OP_MAX:
+                    --l_top;
+                    l_stack[l_top - 1] = (l_stack[l_top] > l_stack[l_top - 1]) ? l_stack[l_top] : l_stack[l_top - 1];
+                    break;
+                case OP_NEG:    l_stack[l_top - 1] = -l_stack[l_top - 1]; break;
+                case OP_ABS:    l_stack[l_top - 1] = fabsf(l_stack[l_top - 1]); break;
+                case OP_SQRT:   l_stack[l_top - 1] = (l_stack[l_top - 1] > 0.0f) ? sqrtf(l_stack[l_top - 1]) : 0.0f; break;
+                case OP_MEAN:
+                {
+                    // Sliding sum, it's recomputed at each wrap, so the rounding errors don't accumulate
+                    float l_value = l_stack[l_top - 1];
+                    if (f_window.m_count == l_instruction.m_argument)
+                    {
+                        f_window.m_sum -= f_window.m_samples[f_window.m_index];
+                    }
+                    else
+                    {
+                        ++f_window.m_count;
+                    }
+                    f_window.m_samples[f_window.m_index] = l_value;
+                    f_window.m_sum += l_value;
+                    if (++f_window.m_index == l_instruction.m_argument)
+                    {
+                        f_window.m_index = 0;
+                        f_window.m_sum = 0.0f;
+                        for (uint8_t j = 0; j < f_window.m_count; ++j)
+                        {
+                            f_window.m_sum += f_window.m_samples[j];
+                        }
+                    }
+                    l_stack[l_top - 1] = f_window.m_sum / f_window.m_count;
+                    break;
+                }
+                default: break;
+            }
+        }
+        return l_stack[0];
+    }
+
+    /** \brief  Verify and decode a program: the opcodes, the indices of the sources, constants and lower slots, the window of the single
+     *  mean operation and the stack depth are checked, a single value remains at the end.
+     *
+     *  @param f_slot          slot of the program
+     *  @param f_code          binary program
+     *  @param f_length        size of the program in byte
+     *  @param f_program       decoded program
+     *  @return                true, when the program is valid
+     */
+    bool CDerivedSignals::verify(uint8_t f_slot, const uint8_t* f_code, uint32_t f_length, SProgram& f_program) const
+    {
+        if (f_length < 1 || f_code[0] > s_maxConstants)
+        {
+            return false;
+        }
+        uint8_t l_constants = f_code[0];
+        uint32_t l_offset = 1 + l_constants * sizeof(float);
+        if (f_length < l_offset || (f_length - l_offset) % 2 != 0 || (f_length - l_offset) / 2 > s_maxInstructions || f_length == l_offset)
+        {
+            return false;
+        }
+        memcpy(f_program.m_constants, f_code + 1, l_constants * sizeof(float));
+        f_program.m_length = static_cast<uint8_t>((f_length - l_offset) / 2);
+        uint8_t l_depth = 0;
+        bool l_hasMean = false;
+        for (uint8_t i = 0; i < f_program.m_length; ++i)
+        {
+            uint8_t l_opcode = f_code[l_offset + 2 * i];
+            uint8_t l_argument = f_code[l_offset + 2 * i + 1];
+            f_program.m_code[i].m_opcode = l_opcode;
+            f_program.m_code[i].m_argument = l_argument;
+            switch (l_opcode)
+            {
+                case OP_SOURCE:
+                case OP_CONST:
+                case OP_SLOT:
+                    if ((OP_SOURCE == l_opcode && l_argument >= m_sourceCount)
+                        || (OP_CONST == l_opcode && l_argument >= l_constants)
+                        || (OP_SLOT == l_opcode && l_argument >= f_slot)
+                        || l_depth >= s_stackDepth)
+                    {
+                        return false;
+                    }
+                    ++l_depth;
+                    break;
+                case OP_DUP:
+                    if (l_depth < 1 || l_depth >= s_stackDepth)
+                    {
+                        return false;
+                    }
+                    ++l_depth;
+                    break;
+                case OP_ADD:
+                case OP_SUB:
+                case OP_MUL:
+                case OP_DIV:
+                case OP_MIN:
+                case OP_MAX:
+                    if (l_depth < 2)
+                    {
+                        return false;
+                    }
+                    --l_depth;
+                    break;
+                case OP_NEG:
+                case OP_ABS:
+                case OP_SQRT:
+                    if (l_depth < 1)
+                    {
+                        return false;
+                    }
+                    break;
+                case OP_MEAN:
+                    if (l_depth < 1 || l_hasMean || l_argument < 1 || l_argument > s_maxWindow)
+                    {
+                        return false;
+                    }
+                    l_hasMean = true;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return 1 == l_depth;
+    }
+
+    /** \brief  Verify a program and request its application by the control loop
+     *
+     *  @param f_slot          slot of the program
+     *  @param f_code          binary program
+     *  @param f_length        size of the program in byte
+     *  @return                true, when the program is valid and no other request is waiting
+     */
+    bool CDerivedSignals::upload(uint8_t f_slot, const uint8_t* f_code, uint32_t f_length)
+    {
+        if (f_slot >= s_slots || m_stagedSlot >= 0 || f_length > s_maxCodeSize || !verify(f_slot, f_code, f_length, m_staged))
+        {
+            return false;
+        }
+        __DMB();
+        m_stagedSlot = static_cast<int8_t>(f_slot);
+        return true;
+    }
+
+    /** \brief  Request the clearing of a program, the slot forwards its source again
+     *
+     *  @param f_slot          slot of the program
+     *  @return                true, when no other request is waiting
+     */
+    bool CDerivedSignals::clear(uint8_t f_slot)
+    {
+        if (f_slot >= s_slots || m_stagedSlot >= 0)
+        {
+            return false;
+        }
+        m_staged.m_length = 0;
+        __DMB();
+        m_stagedSlot = static_cast<int8_t>(f_slot);
+        return true;
+    }
+
+    /** \brief  Value of a slot in the last tick
+     *
+     *  @param f_slot          slot
+     *  @return                value, zero for an unknown slot
+     */
+    float CDerivedSignals::getOutput(uint8_t f_slot) const
+    {
+        return (f_slot < s_slots) ? m_outputs[f_slot] : 0.0f;
+    }
+
+    /** \brief  Serial callback method to get the programs and the values, to upload and to clear a program.
+     *
+     *  @param a               input received string, 0: instructions, 1;slot;hex: upload, 2;slot: clear, 3;slot: value
+     *  @param b               output reponse message
+     */
+    void CDerivedSignals::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        uint32_t l_slot;
+        if (!utils::fmt::parseUint(l_text, l_command)){
+            sprintf(b,"sintax error;;");
+        } else if (0 == l_command){
+            utils::fmt::CWriter l_writer(b);
+            for (uint8_t i = 0; i < s_slots; ++i)
+            {
+                l_writer.udec(m_programs[i].m_length);
+            }
+            l_writer.chr(';');
+        } else if (';' != *l_text++ || !utils::fmt::parseUint(l_text, l_slot) || l_slot >= s_slots){
+            sprintf(b,"sintax error;;");
+        } else if (1 == l_command && ';' == *l_text++){
+            uint8_t l_code[s_maxCodeSize];
+            uint32_t l_length = 0;
+            while (hexDigit(l_text[0]) >= 0 && hexDigit(l_text[1]) >= 0 && l_length < sizeof(l_code)){
+                l_code[l_length++] = static_cast<uint8_t>(hexDigit(l_text[0]) * 16 + hexDigit(l_text[1]));
+                l_text += 2;
+            }
+            if (hexDigit(l_text[0]) >= 0){
+                sprintf(b,"sintax error;;");
+            } else if (m_stagedSlot >= 0){
+                sprintf(b,"busy;;");
+            } else{
+                sprintf(b, upload(static_cast<uint8_t>(l_slot), l_code, l_length) ? "ack;;" : "invalid program;;");
+            }
+        } else if (2 == l_command){
+            sprintf(b, clear(static_cast<uint8_t>(l_slot)) ? "ack;;" : "busy;;");
+        } else if (3 == l_command){
+            utils::fmt::CWriter(b).fixed(getOutput(static_cast<uint8_t>(l_slot)),4).chr(';');
+        } else{
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace utils::telemetry
@@ -0,0 +1,291 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    flightrecorder.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the flight recorder.
+  ******************************************************************************
+ */
+
+#include <utils/telemetry/flightrecorder.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace utils::telemetry{
+
+    /** \brief  CFlightRecorder class constructor, the memory isn't changed until 'restore'.
+     *
+     *  @param f_storage       memory of the records in the '.noinit' section
+     *  @param f_serial        reference to the serial transmitter of the dump
+     *  @param f_sampler       sampler of the records, it's applied in the control tick
+     *  @param f_dumpPeriod    period of the task during the dump in base ticks
+     */
+    CFlightRecorder::CFlightRecorder(SStorage& f_storage, utils::serial::CSerialTransmitter& f_serial, FSampler f_sampler, uint32_t f_dumpPeriod)
+        : utils::task::CTask(0)
+        , m_storage(f_storage)
+        , m_serial(f_serial)
+        , m_sampler(f_sampler)
+        , m_dumpPeriod(f_dumpPeriod)
+        , m_isDumping(false)
+        , m_dumpIdx(0)
+    {
+    }
+
+    /** \brief  Validate the memory after the reset, it has to be applied before the start of the control loop. A valid history 
+     *  is kept frozen (TRIGGER_RESET, when it wasn't triggered before the reset) until the rearm command, otherwise the memory 
+     *  is cleared and the recording starts.
+     *
+     *  @return                true, when a post-mortem history was found
+     */
+    bool CFlightRecorder::restore()
+    {
+        bool l_isValid = m_storage.m_magic == s_magic && m_storage.m_head < s_capacity && m_storage.m_count <= s_capacity
+                      && m_storage.m_remaining <= s_postTrigger && m_storage.m_check == check();
+        if (!l_isValid || m_storage.m_count == 0)
+        {
+            format();
+            return false;
+        }
+        if (!isFrozen())
+        {
+            if (m_storage.m_trigger == TRIGGER_NONE)
+            {
+                m_storage.m_trigger = TRIGGER_RESET;
+            }
+            m_storage.m_isFrozen = 1;
+            m_storage.m_remaining = 0;
+            m_storage.m_check = check();
+        }
+        return true;
+    }
+
+    /** \brief  Record the tick, the record is filled by the sampler. After the trigger the remaining records are counted down, 
+     *  then the records are frozen.
+     *
+     *  @param f_timestamp     timestamp of the tick in microsecond
+     */
+    CONTROL_RAMFUNC void CFlightRecorder::process(uint32_t f_timestamp)
+    {
+        if (m_storage.m_isFrozen || m_storage.m_magic != s_magic)
+        {
+            return;
+        }
+        utils::serial::SFlightRecord& l_record = m_storage.m_records[m_storage.m_head];
+        l_record.m_timestamp = f_timestamp;
+        uint8_t l_trigger = m_sampler ? m_sampler(l_record) : static_cast<uint8_t>(TRIGGER_NONE);
+        m_storage.m_head = (m_storage.m_head + 1 == s_capacity) ? 0 : (m_storage.m_head + 1);
+        if (m_storage.m_count < s_capacity)
+        {
+            m_storage.m_count++;
+        }
+        if (l_trigger != TRIGGER_NONE)
+        {
+            trigger(l_trigger);
+        }
+        // The control tick isn't preempted by the serial commands, so the state is updated without critical section
+        if (m_storage.m_trigger != TRIGGER_NONE)
+        {
+            if (m_storage.m_remaining == 0)
+            {
+                m_storage.m_isFrozen = 1;
+            }
+            else
+            {
+                m_storage.m_remaining--;
+            }
+        }
+        m_storage.m_check = check();
+    }
+
+    /** \brief  Trigger the freezing, it's applied only by the first trigger. The manual trigger freezes the records in the next tick, 
+     *  the others after a quarter of the capacity. It can be applied from any thread.
+     *
+     *  @param f_trigger       code of the trigger (ETrigger)
+     */
+    void CFlightRecorder::trigger(uint8_t f_trigger)
+    {
+        core_util_critical_section_enter();
+        if (m_storage.m_trigger == TRIGGER_NONE && !m_storage.m_isFrozen && m_storage.m_magic == s_magic)
+        {
+            m_storage.m_trigger = f_trigger;
+            m_storage.m_remaining = (f_trigger == TRIGGER_MANUAL) ? 0 : s_postTrigger;
+            m_storage.m_check = check();
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** \brief  Start the dump of the frozen records, a running recorder is frozen by manual trigger.
+     *
+     *  @return                false, when a dump is in progress
+     */
+    bool CFlightRecorder::dump()
+    {
+        if (m_isDumping)
+        {
+            return false;
+        }
+        trigger(TRIGGER_MANUAL);
+        m_dumpIdx = 0;
+        m_isDumping = true;
+        setPeriod(m_dumpPeriod);
+        return true;
+    }
+
+    /** \brief  Clear the records and restart the recording
+     *
+     *  @return                false, when a dump is in progress
+     */
+    bool CFlightRecorder::rearm()
+    {
+        if (m_isDumping)
+        {
+            return false;
+        }
+        core_util_critical_section_enter();
+        format();
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Convert a value to fixed point, the result is rounded and saturated to the range of the int16_t.
+     *
+     *  @param f_value         value
+     *  @param f_scale         units in one 
+     *  @return                fixed point value
+     */
+    int16_t CFlightRecorder::quantize(float f_value, float f_scale)
+    {
+        float l_value = f_value * f_scale;
+        if (l_value >= INT16_MAX)
+        {
+            return INT16_MAX;
+        }
+        if (l_value <= INT16_MIN)
+        {
+            return INT16_MIN;
+        }
+        return static_cast<int16_t>(l_value + (l_value >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    /** \brief  Serial callback of the commands: 0 - state ('frozen;trigger;count;;'), 1 - dump, 2 - rearm, 3 - freeze.
+     *
+     *  @param a               input string with the command
+     *  @param b               output string
+     */
+    void CFlightRecorder::serialCallback(char const * a, char * b)
+    {
+        int l_command;
+        uint32_t l_res = sscanf(a,"%d",&l_command);
+        if (1 != l_res)
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        switch (l_command)
+        {
+            case 0:
+                sprintf(b,"%d;%u;%lu;;", isFrozen() ? 1 : 0, getTrigger(), static_cast<unsigned long>(getCount()));
+                break;
+            case 1:
+                if (dump())
+                {
+                    sprintf(b,"ack;;%lu;", static_cast<unsigned long>(getCount()));
+                }
+                else
+                {
+                    sprintf(b,"busy;;");
+                }
+                break;
+            case 2:
+                sprintf(b, rearm() ? "ack;;" : "busy;;");
+                break;
+            case 3:
+                trigger(TRIGGER_MANUAL);
+                sprintf(b,"ack;;");
+                break;
+            default:
+                sprintf(b,"sintax error;;");
+                break;
+        }
+    }
+
+    /** \brief  Run method, it sends the frozen records from the oldest one in frames. When the lane of the transmitter is full, 
+     *  the frame is sent again in the next period. The last frame is shorter than the others, an empty history is sent in a 
+     *  frame without record.
+     */
+    void CFlightRecorder::_run()
+    {
+        if (!m_isDumping || !isFrozen())
+        {
+            return;
+        }
+        uint32_t l_count = m_storage.m_count;
+        uint32_t l_oldest = (m_storage.m_head + s_capacity - l_count) % s_capacity;
+        do
+        {
+            uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+            utils::serial::SFlightRecordHeader l_header;
+            uint32_t l_records = l_count - m_dumpIdx;
+            l_records = (l_records > s_frameRecords) ? s_frameRecords : l_records;
+            l_header.m_first = static_cast<uint16_t>(m_dumpIdx);
+            l_header.m_total = static_cast<uint16_t>(l_count);
+            l_header.m_trigger = getTrigger();
+            l_header.m_count = static_cast<uint8_t>(l_records);
+            memcpy(l_payload, &l_header, sizeof(l_header));
+            for (uint32_t l_idx = 0; l_idx < l_records; ++l_idx)
+            {
+                memcpy(l_payload + sizeof(l_header) + l_idx * sizeof(utils::serial::SFlightRecord)
+                      , &m_storage.m_records[(l_oldest + m_dumpIdx + l_idx) % s_capacity], sizeof(utils::serial::SFlightRecord));
+            }
+            uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+            uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_FLIGHT_RECORD, l_payload
+                                                                    , sizeof(l_header) + l_records * sizeof(utils::serial::SFlightRecord), l_frame);
+            if (!m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_TELEMETRY))
+            {
+                return;
+            }
+            m_dumpIdx += l_records;
+        } while (m_dumpIdx < l_count);
+        m_isDumping = false;
+        setPeriod(0);
+    }
+
+    /** \brief  Clear the memory, the records aren't erased, only the state is restarted.
+     */
+    void CFlightRecorder::format()
+    {
+        m_storage.m_magic = s_magic;
+        m_storage.m_head = 0;
+        m_storage.m_count = 0;
+        m_storage.m_trigger = TRIGGER_NONE;
+        m_storage.m_remaining = 0;
+        m_storage.m_isFrozen = 0;
+        m_storage.m_check = check();
+    }
+
+    /** \brief  Check value of the state, it detects the random content of the memory after the power on.
+     *
+     *  @return                check value
+     */
+    uint32_t CFlightRecorder::check() const
+    {
+        return ~(m_storage.m_magic ^ (m_storage.m_head << 1) ^ (m_storage.m_count << 12) ^ (m_storage.m_trigger << 23) 
+                 ^ (m_storage.m_remaining << 3) ^ (m_storage.m_isFrozen << 31));
+    }
+
+}; // namespace utils::telemetry
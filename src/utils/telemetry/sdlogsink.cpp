@@ -0,0 +1,279 @@
+/**
+Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+  ******************************************************************************
+  * @file    sdlogsink.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class implementation for the recorder of the telemetry on the SD card.
+  ******************************************************************************
+ */
+
+#include <utils/telemetry/sdlogsink.hpp>
+#include <utils/fmt/format.hpp>
+#include <string.h>
+
+namespace utils::telemetry{
+
+    /** \brief  CSdLogSink class constructor
+     *
+     *  @param f_period        period of the task in base ticks, a sector is written in a few steps
+     *  @param f_card          SD card
+     *  @param f_firstSector   first sector of the ring
+     *  @param f_sectorCount   number of the sectors of the ring
+     */
+    CSdLogSink::CSdLogSink(uint32_t f_period, hardware::drivers::CSdCardSpi_SPI3& f_card, uint32_t f_firstSector, uint32_t f_sectorCount)
+        : utils::task::CTask(f_period)
+        , m_card(f_card)
+        , m_firstSector(f_firstSector)
+        , m_sectorCount(f_sectorCount)
+        , m_sectors()
+        , m_fill(0)
+        , m_fillSize(0)
+        , m_full(false)
+        , m_state(IDLE)
+        , m_position(0)
+        , m_session(0)
+        , m_sequence(0)
+        , m_recording(false)
+        , m_startRequest(false)
+        , m_stopRequest(false)
+        , m_written(0)
+        , m_overruns(0)
+        , m_errors(0)
+    {
+    }
+
+    /** \brief  Start a recording session at the beginning of the ring, it's applied by the next run of the task.
+     *
+     *  @param f_session       number of the session in the headers of the sectors
+     */
+    void CSdLogSink::start(uint16_t f_session)
+    {
+        if (m_recording || m_startRequest)
+        {
+            return;
+        }
+        m_session = f_session;
+        m_stopRequest = false;
+        m_startRequest = true;
+    }
+
+    /** \brief  Stop the recording, the filled sectors are written before the end of the multiple block write.
+     */
+    void CSdLogSink::stop()
+    {
+        m_startRequest = false;
+        m_stopRequest = true;
+    }
+
+    /** \brief  Record a frame, it's copied in the sector buffers. When it doesn't fit, it's dropped. A full sector waits for the 
+     *  writing of the other one, then it's handed over by the task.
+     *
+     *  @param f_frame         encoded frame
+     *  @param f_size          size of the frame
+     *  @return                true during the recording, the frame isn't transmitted on the serial link
+     */
+    bool CSdLogSink::write(const uint8_t* f_frame, uint32_t f_size)
+    {
+        if (!m_recording)
+        {
+            return false;
+        }
+        core_util_critical_section_enter();
+        uint32_t l_free = s_payloadSize - m_fillSize + (m_full ? 0 : s_payloadSize);
+        if (!m_recording || f_size > l_free)
+        {
+            m_overruns++;
+            core_util_critical_section_exit();
+            return true;
+        }
+        while (f_size > 0)
+        {
+            uint32_t l_size = s_payloadSize - m_fillSize;
+            if (l_size > f_size)
+            {
+                l_size = f_size;
+            }
+            memcpy(m_sectors[m_fill].m_data + m_fillSize, f_frame, l_size);
+            m_fillSize += l_size;
+            f_frame += l_size;
+            f_size -= l_size;
+            if (m_fillSize == s_payloadSize && !m_full)
+            {
+                swap();
+            }
+        }
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Hand over the sector under filling to the writing, the unused bytes are cleared. The other sector has to be free.
+     */
+    void CSdLogSink::swap()
+    {
+        SSector& l_sector = m_sectors[m_fill];
+        l_sector.m_header.m_magic = s_magic;
+        l_sector.m_header.m_session = m_session;
+        l_sector.m_header.m_used = static_cast<uint16_t>(m_fillSize);
+        l_sector.m_header.m_sequence = m_sequence++;
+        memset(l_sector.m_data + m_fillSize, 0, s_payloadSize - m_fillSize);
+        m_fill ^= 1;
+        m_fillSize = 0;
+        m_full = true;
+    }
+
+    /** \brief  Abort the recording after an error of the card, the filled sectors are dropped.
+     */
+    void CSdLogSink::abort()
+    {
+        m_errors++;
+        core_util_critical_section_enter();
+        m_recording = false;
+        m_full = false;
+        m_fillSize = 0;
+        core_util_critical_section_exit();
+        m_card.stopWrite();
+        m_stopRequest = false;
+        m_state = IDLE;
+    }
+
+    /** \brief  Run method, it applies the steps of the writing, until a step has to wait the card.
+     */
+    void CSdLogSink::_run()
+    {
+        for (;;)
+        {
+            switch (m_state)
+            {
+                case IDLE:
+                    if (!m_startRequest)
+                    {
+                        m_stopRequest = false;
+                        return;
+                    }
+                    m_startRequest = false;
+                    if ((!m_card.isInitialized() && !m_card.initialize()) || !m_card.startWrite(m_firstSector))
+                    {
+                        m_errors++;
+                        return;
+                    }
+                    core_util_critical_section_enter();
+                    m_fill = 0;
+                    m_fillSize = 0;
+                    m_full = false;
+                    m_sequence = 0;
+                    m_recording = true;
+                    core_util_critical_section_exit();
+                    m_position = 0;
+                    m_state = READY;
+                    break;
+                case READY:
+                    if (m_stopRequest)
+                    {
+                        // The last partial sector is written before the stop
+                        core_util_critical_section_enter();
+                        m_recording = false;
+                        if (!m_full && m_fillSize > 0)
+                        {
+                            swap();
+                        }
+                        core_util_critical_section_exit();
+                    }
+                    if (!m_full)
+                    {
+                        if (m_recording)
+                        {
+                            return;
+                        }
+                        m_stopRequest = false;
+                        if (!m_card.stopWrite())
+                        {
+                            m_errors++;
+                        }
+                        m_state = IDLE;
+                        return;
+                    }
+                    m_card.startSector(reinterpret_cast<const uint8_t*>(&m_sectors[m_fill ^ 1]));
+                    m_state = TRANSFER;
+                    break;
+                case TRANSFER:
+                    if (!m_card.isTransferred())
+                    {
+                        return;
+                    }
+                    if (!m_card.finishSector())
+                    {
+                        abort();
+                        return;
+                    }
+                    m_state = BUSY;
+                    break;
+                case BUSY:
+                    if (!m_card.isReady())
+                    {
+                        return;
+                    }
+                    core_util_critical_section_enter();
+                    m_full = false;
+                    if (m_fillSize == s_payloadSize)
+                    {
+                        swap();
+                    }
+                    core_util_critical_section_exit();
+                    m_written++;
+                    if (++m_position >= m_sectorCount)
+                    {
+                        // End of the ring, the writing continues at its beginning
+                        m_position = 0;
+                        if (!m_card.stopWrite() || !m_card.startWrite(m_firstSector))
+                        {
+                            abort();
+                            return;
+                        }
+                    }
+                    m_state = READY;
+                    break;
+            }
+        }
+    }
+
+    /** \brief  Serial callback of the recording. The parameters '1;session' start a session, '0' stops the recording, the response
+     *  contains the state of the recording, the number of the written sectors, of the dropped frames and of the errors of the card.
+     *
+     *  @param a               string to read data from
+     *  @param b               string to write data to
+     */
+    void CSdLogSink::serialCallback(char const * a, char * b)
+    {
+        float l_values[2];
+        uint8_t l_count = utils::fmt::parseFloats(a, l_values, 2);
+        if (2 == l_count && 1.0f == l_values[0] && l_values[1] >= 0.0f && l_values[1] <= 65535.0f)
+        {
+            start(static_cast<uint16_t>(l_values[1]));
+        }
+        else if (1 == l_count && 0.0f == l_values[0])
+        {
+            stop();
+        }
+        else if (0 != l_count)
+        {
+            sprintf(b,"sintax error;;");
+            return;
+        }
+        utils::fmt::CWriter(b).dec(m_recording ? 1 : 0).udec(m_written).udec(m_overruns).udec(m_errors).chr(';');
+    }
+
+}; // namespace utils::telemetry
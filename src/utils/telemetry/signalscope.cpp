@@ -0,0 +1,394 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    SignalScope.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the on-board signal scope.
+  ******************************************************************************
+ */
+
+#include <utils/telemetry/signalscope.hpp>
+#include <hardware/drivers/scopetimer.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+
+namespace utils::telemetry{
+
+    CSignalScope* CSignalScope::s_instance = NULL;
+
+    /** \brief  CSignalScope class constructor
+     *
+     *  @param f_serial        reference to the serial transmitter of the dump
+     *  @param f_dumpPeriod    period of the task during the dump in base ticks
+     */
+    CSignalScope::CSignalScope(utils::serial::CSerialTransmitter& f_serial, uint32_t f_dumpPeriod)
+        : utils::task::CTask(0)
+        , m_serial(f_serial)
+        , m_dumpPeriod(f_dumpPeriod)
+        , m_probes()
+        , m_probeCount(0)
+        , m_selected()
+        , m_channelCount(0)
+        , m_channelMask(0)
+        , m_mode(TRIGGER_MANUAL)
+        , m_triggerChannel(0)
+        , m_triggerSlot(0)
+        , m_threshold(0)
+        , m_previous(0)
+        , m_frames(0)
+        , m_preTrigger(0)
+        , m_postTrigger(0)
+        , m_remaining(0)
+        , m_head(0)
+        , m_count(0)
+        , m_state(STATE_IDLE)
+        , m_request(CAUSE_NONE)
+        , m_cause(CAUSE_NONE)
+        , m_frequency(0)
+        , m_isDumping(false)
+        , m_dumpIdx(0)
+    {
+    }
+
+    /** \brief  Register a channel, it has to be applied before the first arming
+     *
+     *  @param f_probe         probe of the channel
+     *  @return                index of the channel, -1 when the channels are exhausted
+     */
+    int8_t CSignalScope::addChannel(FProbe f_probe)
+    {
+        if (m_probeCount >= s_maxChannels || f_probe == NULL)
+        {
+            return -1;
+        }
+        m_probes[m_probeCount] = f_probe;
+        return static_cast<int8_t>(m_probeCount++);
+    }
+
+    /** \brief  Set the trigger condition, it's applied by the next arming
+     *
+     *  @param f_mode          trigger condition
+     *  @param f_channel       registered channel of the threshold and edge conditions
+     *  @param f_threshold     threshold in the raw unit of the channel
+     *  @return                false, when the capture is running or the channel isn't registered
+     */
+    bool CSignalScope::setTrigger(ETriggerMode f_mode, uint8_t f_channel, int16_t f_threshold)
+    {
+        if (STATE_ARMED == m_state || STATE_TRIGGERED == m_state || f_mode > TRIGGER_FAULT || f_channel >= m_probeCount)
+        {
+            return false;
+        }
+        m_mode = f_mode;
+        m_triggerChannel = f_channel;
+        m_threshold = f_threshold;
+        return true;
+    }
+
+    /** \brief  Start the capture, the previous capture is discarded
+     *
+     *  The frames are selected by the mask, the trigger channel has to be selected for the threshold and edge conditions. The 
+     *  post-trigger part takes at most all frames except the trigger frame.
+     *
+     *  @param f_frequency     sampling frequency in Hz
+     *  @param f_postTrigger   number of the frames after the trigger
+     *  @param f_channelMask   mask of the selected channels
+     *  @return                false, when a dump is in progress or the parameters can't be applied
+     */
+    bool CSignalScope::arm(float f_frequency, uint32_t f_postTrigger, uint8_t f_channelMask)
+    {
+        if (m_isDumping || f_frequency > s_maxFrequency)
+        {
+            return false;
+        }
+        stop();
+        uint8_t l_count = 0;
+        uint8_t l_slot = 0;
+        for (uint8_t i = 0; i < m_probeCount; i++)
+        {
+            if (f_channelMask & (1U << i))
+            {
+                l_slot = (i == m_triggerChannel) ? l_count : l_slot;
+                m_selected[l_count++] = m_probes[i];
+            }
+        }
+        bool l_hasChannel = (f_channelMask & (1U << m_triggerChannel)) != 0;
+        if (0 == l_count || (!l_hasChannel && TRIGGER_MANUAL != m_mode && TRIGGER_FAULT != m_mode))
+        {
+            return false;
+        }
+        m_channelCount = l_count;
+        m_channelMask = f_channelMask & ((1U << m_probeCount) - 1);
+        m_triggerSlot = l_slot;
+        m_frames = s_bufferSize / l_count;
+        m_postTrigger = (f_postTrigger < m_frames) ? f_postTrigger : (m_frames - 1);
+        m_preTrigger = m_frames - m_postTrigger;
+        m_remaining = 0;
+        m_head = 0;
+        m_count = 0;
+        m_request = CAUSE_NONE;
+        m_cause = CAUSE_NONE;
+        m_state = STATE_ARMED;
+        s_instance = this;
+        hardware::drivers::CScopeTimer_TIM9::attach(&CSignalScope::sampleHook);
+        if (!hardware::drivers::CScopeTimer_TIM9::start(f_frequency))
+        {
+            m_state = STATE_IDLE;
+            return false;
+        }
+        m_frequency = static_cast<uint32_t>(hardware::drivers::CScopeTimer_TIM9::getFrequency() + 0.5f);
+        return true;
+    }
+
+    /** \brief  Trigger the capture, it's applied in the next frame, when the capture is armed. It can be applied from any thread.
+     */
+    void CSignalScope::trigger()
+    {
+        if (STATE_ARMED == m_state)
+        {
+            m_request = CAUSE_MANUAL;
+        }
+    }
+
+    /** \brief  Report a fault, it triggers the armed capture in TRIGGER_FAULT mode. It can be applied from interrupt.
+     */
+    void CSignalScope::fault()
+    {
+        if (STATE_ARMED == m_state && TRIGGER_FAULT == m_mode && CAUSE_NONE == m_request)
+        {
+            m_request = CAUSE_FAULT;
+        }
+    }
+
+    /** \brief  Stop the timer, a running capture is discarded, a frozen capture is kept
+     */
+    void CSignalScope::stop()
+    {
+        hardware::drivers::CScopeTimer_TIM9::stop();
+        if (STATE_FROZEN != m_state)
+        {
+            m_state = STATE_IDLE;
+        }
+    }
+
+    /** \brief  Start the dump of the frozen capture
+     *
+     *  @return                false, when a dump is in progress or the capture isn't frozen
+     */
+    bool CSignalScope::dump()
+    {
+        if (m_isDumping || STATE_FROZEN != m_state)
+        {
+            return false;
+        }
+        m_dumpIdx = 0;
+        m_isDumping = true;
+        setPeriod(m_dumpPeriod);
+        return true;
+    }
+
+    /** \brief  Hook of the scope timer, it's applied from the interrupt with the highest priority, so the state isn't protected.
+     */
+    CONTROL_RAMFUNC void CSignalScope::sampleHook()
+    {
+        s_instance->sample();
+    }
+
+    /** \brief  Record a frame, it checks the trigger in the armed state and it counts down the post-trigger frames after the trigger.
+     *  The threshold and edge conditions are checked only after the pre-trigger part is filled.
+     */
+    CONTROL_RAMFUNC void CSignalScope::sample()
+    {
+        int16_t* l_frame = &m_buffer[m_head * m_channelCount];
+        for (uint8_t i = 0; i < m_channelCount; i++)
+        {
+            l_frame[i] = m_selected[i]();
+        }
+        int16_t l_value = l_frame[m_triggerSlot];
+        m_head = (m_head + 1 == m_frames) ? 0 : (m_head + 1);
+        uint32_t l_count = m_count;
+        l_count = (l_count < m_frames) ? (l_count + 1) : l_count;
+        m_count = l_count;
+        if (STATE_ARMED == m_state)
+        {
+            uint8_t l_cause = m_request;
+            if (CAUSE_NONE == l_cause && l_count >= m_preTrigger && l_count > 1 && isTriggered(l_value))
+            {
+                l_cause = CAUSE_CONDITION;
+            }
+            if (CAUSE_NONE != l_cause)
+            {
+                m_cause = l_cause;
+                m_remaining = m_postTrigger;
+                m_state = STATE_TRIGGERED;
+            }
+        }
+        else if (STATE_TRIGGERED == m_state)
+        {
+            m_remaining--;
+        }
+        if (STATE_TRIGGERED == m_state && 0 == m_remaining)
+        {
+            hardware::drivers::CScopeTimer_TIM9::stop();
+            m_state = STATE_FROZEN;
+        }
+        m_previous = l_value;
+    }
+
+    /** \brief  Check the threshold and edge conditions on the value of the trigger channel
+     *
+     *  @param f_value         value of the trigger channel in the current frame
+     *  @return                true, when the condition is met
+     */
+    CONTROL_RAMFUNC bool CSignalScope::isTriggered(int16_t f_value) const
+    {
+        switch (m_mode)
+        {
+            case TRIGGER_ABOVE:
+                return f_value >= m_threshold;
+            case TRIGGER_BELOW:
+                return f_value <= m_threshold;
+            case TRIGGER_RISING:
+                return m_previous < m_threshold && f_value >= m_threshold;
+            case TRIGGER_FALLING:
+                return m_previous > m_threshold && f_value <= m_threshold;
+            default:
+                return false;
+        }
+    }
+
+    /** \brief  Serial callback of the commands
+     *
+     *  @param a               input string, 0: state, 1;frequency;post;mask: arm, 2;mode;channel;threshold: trigger condition, 
+     *                         3: manual trigger, 4: dump, 5: stop
+     *  @param b               output string
+     */
+    void CSignalScope::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(static_cast<uint32_t>(m_state)).udec(m_cause).udec(m_count).udec(m_frames).udec(m_frequency).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_frequency, l_post;
+            uint32_t l_mask = (1U << m_probeCount) - 1;
+            if (utils::fmt::parseUint(l_text, l_frequency) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_post)
+                && (';' != *l_text || utils::fmt::parseUint(++l_text, l_mask)))
+            {
+                sprintf(b, arm(static_cast<float>(l_frequency), l_post, static_cast<uint8_t>(l_mask)) ? "ack;;" : "busy;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (2 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_mode, l_channel;
+            int32_t l_threshold;
+            if (utils::fmt::parseUint(l_text, l_mode) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_channel) && ';' == *l_text++
+                && utils::fmt::parseInt(l_text, l_threshold) && l_mode <= TRIGGER_FAULT && l_channel < m_probeCount
+                && l_threshold >= INT16_MIN && l_threshold <= INT16_MAX)
+            {
+                sprintf(b, setTrigger(static_cast<ETriggerMode>(l_mode), static_cast<uint8_t>(l_channel), static_cast<int16_t>(l_threshold)) ? "ack;;" : "busy;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (3 == l_command)
+        {
+            trigger();
+            sprintf(b,"ack;;");
+        }
+        else if (4 == l_command)
+        {
+            if (dump())
+            {
+                utils::fmt::CWriter(b).text("ack;;").udec(m_count);
+            }
+            else
+            {
+                sprintf(b,"busy;;");
+            }
+        }
+        else if (5 == l_command)
+        {
+            stop();
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Run method, it sends the frozen frames from the oldest one in messages. When the lane of the transmitter is full, 
+     *  the message is sent again in the next period.
+     */
+    void CSignalScope::_run()
+    {
+        if (!m_isDumping || STATE_FROZEN != m_state)
+        {
+            return;
+        }
+        const uint32_t l_frameRecords = (utils::serial::CBinaryProtocol::s_maxPayloadSize - sizeof(utils::serial::SScopeHeader)) / (sizeof(int16_t) * m_channelCount);
+        uint32_t l_count = m_count;
+        uint32_t l_oldest = (m_head + m_frames - l_count) % m_frames;
+        do
+        {
+            uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+            utils::serial::SScopeHeader l_header;
+            uint32_t l_records = l_count - m_dumpIdx;
+            l_records = (l_records > l_frameRecords) ? l_frameRecords : l_records;
+            l_header.m_first = static_cast<uint16_t>(m_dumpIdx);
+            l_header.m_total = static_cast<uint16_t>(l_count);
+            l_header.m_trigger = static_cast<uint16_t>(l_count - 1 - m_postTrigger);
+            l_header.m_frequency = m_frequency;
+            l_header.m_cause = m_cause;
+            l_header.m_channels = m_channelMask;
+            l_header.m_count = static_cast<uint8_t>(l_records);
+            memcpy(l_payload, &l_header, sizeof(l_header));
+            uint32_t l_frameSize = sizeof(int16_t) * m_channelCount;
+            for (uint32_t l_idx = 0; l_idx < l_records; ++l_idx)
+            {
+                memcpy(l_payload + sizeof(l_header) + l_idx * l_frameSize
+                      , &m_buffer[((l_oldest + m_dumpIdx + l_idx) % m_frames) * m_channelCount], l_frameSize);
+            }
+            uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+            uint32_t l_size = utils::serial::CBinaryProtocol::encode(utils::serial::BIN_SCOPE_CAPTURE, l_payload
+                                                                    , sizeof(l_header) + l_records * l_frameSize, l_frame);
+            if (!m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_TELEMETRY))
+            {
+                return;
+            }
+            m_dumpIdx += l_records;
+        } while (m_dumpIdx < l_count);
+        m_isDumping = false;
+        setPeriod(0);
+    }
+
+}; // namespace utils::telemetry
@@ -0,0 +1,440 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers 
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+  ******************************************************************************
+  ******************************************************************************
+  * @file    Telemetry.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the telemetry channel.
+  ******************************************************************************
+ */
+
+#include <utils/telemetry/telemetry.hpp>
+#include <utils/telemetry/tracestream.hpp>
+
+namespace utils::telemetry{
+
+    /** \brief  CTelemetry class constructor
+     *
+     *  @param f_serial        reference to the serial transmitter
+     */
+    CTelemetry::CTelemetry(utils::serial::CSerialTransmitter& f_serial)
+        : utils::task::CTask(0)
+        , m_serial(f_serial)
+        , m_sink(NULL)
+        , m_signalCount(0)
+        , m_packed(false)
+        , m_sampleSize(0)
+        , m_signalMask(0)
+        , m_subscribedCount(0)
+        , m_decimation(1)
+        , m_windowCount(0)
+        , m_active(0)
+        , m_pending(false)
+        , m_sequence(0)
+        , m_overruns(0)
+        , m_wheel(NULL)
+        , m_timer(&CTelemetry::expireSampling, this)
+    {
+        for (uint8_t i = 0; i < s_maxSignals; i++)
+        {
+            m_aggregation[i] = AGGR_NONE;
+            m_encoding[i] = ENC_RAW;
+            m_scale[i] = 1.0f;
+            m_code[i] = 0;
+        }
+        m_blocks[0].m_header.m_sampleCount = 0;
+        m_blocks[1].m_header.m_sampleCount = 0;
+    }
+
+    /** \brief  Register a signal, it has to be applied before the sampling is started.
+     *
+     *  @param f_getter        getter of the signal
+     *  @return                index of the signal in the subscription mask, -1, when there isn't more place
+     */
+    int8_t CTelemetry::addSignal(FSignalGetter f_getter)
+    {
+        if (m_signalCount >= s_maxSignals)
+        {
+            return -1;
+        }
+        m_signals[m_signalCount] = f_getter;
+        return static_cast<int8_t>(m_signalCount++);
+    }
+
+    /** \brief  Sample the subscribed signals
+     *
+     *  It aggregates the values of the subscribed signals over the decimation window. At the end of the window it stores the 
+     *  aggregated values in the active block, when the block is full, it passes the block to the task. Each raw value is emitted on the
+     *  channel of its signal of the trace stream.
+     */
+    void CTelemetry::sample()
+    {
+        uint8_t l_mask = m_signalMask;
+        if (l_mask == 0)
+        {
+            return;
+        }
+        for (uint8_t i = 0; i < m_signalCount; i++)
+        {
+            if ((l_mask & (1U << i)) == 0)
+            {
+                continue;
+            }
+            float l_value = m_signals[i]();
+            CTraceStream::sample(i, l_value);
+            if (m_windowCount == 0 || m_aggregation[i] == AGGR_NONE)
+            {
+                m_aggregated[i] = l_value;
+            }
+            else if (m_aggregation[i] == AGGR_MIN)
+            {
+                m_aggregated[i] = (l_value < m_aggregated[i]) ? l_value : m_aggregated[i];
+            }
+            else if (m_aggregation[i] == AGGR_MAX)
+            {
+                m_aggregated[i] = (l_value > m_aggregated[i]) ? l_value : m_aggregated[i];
+            }
+            else
+            {
+                m_aggregated[i] += l_value;
+            }
+        }
+        if (++m_windowCount < m_decimation)
+        {
+            return;
+        }
+        m_windowCount = 0;
+
+        uint32_t l_now = us_ticker_read();
+        SBlock& l_block = m_blocks[m_active];
+        if (l_block.m_header.m_sampleCount == 0)
+        {
+            l_block.m_header.m_timestamp = l_now;
+            l_block.m_packed = m_packed;
+            l_block.m_size = 0;
+            if (m_packed)
+            {
+                // The table of the encoding codes precedes the samples
+                for (uint8_t i = 0; i < m_signalCount; i++)
+                {
+                    if (l_mask & (1U << i))
+                    {
+                        l_block.m_data[l_block.m_size++] = m_code[i];
+                        m_previous[i] = 0;
+                    }
+                }
+            }
+        }
+        uint8_t* l_data = &l_block.m_data[l_block.m_size];
+        for (uint8_t i = 0; i < m_signalCount; i++)
+        {
+            if (l_mask & (1U << i))
+            {
+                l_data = encode(i, (m_aggregation[i] == AGGR_MEAN) ? m_aggregated[i] / m_decimation : m_aggregated[i], l_data);
+            }
+        }
+        l_block.m_size = static_cast<uint32_t>(l_data - l_block.m_data);
+        l_block.m_lastTimestamp = l_now;
+        l_block.m_header.m_sampleCount++;
+        if (l_block.m_size + m_sampleSize <= s_blockBytes && l_block.m_header.m_sampleCount < 0xFF)
+        {
+            return;
+        }
+        // The block is full
+        l_block.m_header.m_sequence = m_sequence++;
+        if (m_pending) // The previous block wasn't transmitted, discard the current one
+        {
+            m_overruns++;
+            l_block.m_header.m_sampleCount = 0;
+            return;
+        }
+        l_block.m_header.m_signalCount = m_subscribedCount;
+        l_block.m_header.m_signalMask = l_mask;
+        l_block.m_header.m_interval = (l_block.m_header.m_sampleCount > 1) 
+                ? static_cast<uint16_t>((l_block.m_lastTimestamp - l_block.m_header.m_timestamp) / (l_block.m_header.m_sampleCount - 1)) : 0;
+        m_pending = true;
+        m_active = m_active ^ 1;
+        m_blocks[m_active].m_header.m_sampleCount = 0;
+        Notify();
+    }
+
+    /** \brief  Append the encoded value of a signal to the block
+     *
+     *  The raw values are copied as float. The delta encoded values are quantized, the difference from the previous value is 
+     *  mapped by zigzag to unsigned (0,-1,1,-2.. to 0,1,2,3..) and it's stored as varint, seven bits in each byte, the highest 
+     *  bit shows that more bytes follow.
+     *
+     *  @param f_index         index of the signal
+     *  @param f_value         value of the signal
+     *  @param f_data          write position in the block
+     *  @return                write position after the encoded value
+     */
+    uint8_t* CTelemetry::encode(uint8_t f_index, float f_value, uint8_t* f_data)
+    {
+        if (m_encoding[f_index] == ENC_RAW)
+        {
+            memcpy(f_data, &f_value, sizeof(float));
+            return f_data + sizeof(float);
+        }
+        float l_scaled = f_value * m_scale[f_index];
+        // Saturate to the int32 range, so the difference can be computed without overflow
+        l_scaled = (l_scaled > 1.0e9f) ? 1.0e9f : ((l_scaled < -1.0e9f) ? -1.0e9f : l_scaled);
+        int32_t l_quantized = static_cast<int32_t>(l_scaled + ((l_scaled < 0.0f) ? -0.5f : 0.5f));
+        int32_t l_delta = l_quantized - m_previous[f_index];
+        m_previous[f_index] = l_quantized;
+        uint32_t l_zigzag = (static_cast<uint32_t>(l_delta) << 1) ^ static_cast<uint32_t>(l_delta >> 31);
+        while (l_zigzag >= 0x80U)
+        {
+            *f_data++ = static_cast<uint8_t>(l_zigzag | 0x80U);
+            l_zigzag >>= 7;
+        }
+        *f_data++ = static_cast<uint8_t>(l_zigzag);
+        return f_data;
+    }
+
+    /** \brief  Restart the block under sampling and the aggregation window
+     *
+     *  The samples of the block under sampling are discarded, because their layout belongs to the previous subscription.
+     */
+    void CTelemetry::restart()
+    {
+        uint8_t l_mask = m_signalMask;
+        m_packed = false;
+        m_sampleSize = 0;
+        for (uint8_t i = 0; i < m_signalCount; i++)
+        {
+            if (l_mask & (1U << i))
+            {
+                // A varint of a 32-bit difference takes at most five bytes
+                m_packed = m_packed || (m_encoding[i] != ENC_RAW);
+                m_sampleSize += (m_encoding[i] == ENC_RAW) ? sizeof(float) : 5;
+            }
+        }
+        m_windowCount = 0;
+        m_blocks[m_active].m_header.m_sampleCount = 0;
+    }
+
+    /** \brief  Subscribe the published signals
+     *
+     *  @param f_signalMask    mask of the signals, zero stops the publishing
+     *  @param f_decimation    decimation factor, at least one
+     *  @return                true, when the subscription was accepted
+     */
+    bool CTelemetry::subscribe(uint8_t f_signalMask, uint16_t f_decimation)
+    {
+        if (f_decimation == 0 || (f_signalMask >> m_signalCount) != 0)
+        {
+            return false;
+        }
+        core_util_critical_section_enter();
+        m_signalMask = f_signalMask;
+        m_subscribedCount = static_cast<uint8_t>(__builtin_popcount(f_signalMask));
+        m_decimation = f_decimation;
+        restart();
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Set the aggregation mode of a signal
+     *
+     *  @param f_index         index of the signal
+     *  @param f_aggregation   aggregation mode over the decimation window
+     *  @return                true, when the mode was accepted
+     */
+    bool CTelemetry::setAggregation(uint8_t f_index, EAggregation f_aggregation)
+    {
+        if (f_index >= m_signalCount || f_aggregation > AGGR_MEAN)
+        {
+            return false;
+        }
+        core_util_critical_section_enter();
+        m_aggregation[f_index] = f_aggregation;
+        restart();
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Set the encoding mode of a signal
+     *
+     *  @param f_index         index of the signal
+     *  @param f_encoding      encoding mode in the batch
+     *  @param f_decimals      number of the kept decimals of the delta encoded value, the quantum is 10^-decimals
+     *  @return                true, when the mode was accepted
+     */
+    bool CTelemetry::setEncoding(uint8_t f_index, EEncoding f_encoding, uint8_t f_decimals)
+    {
+        if (f_index >= m_signalCount || f_encoding > ENC_DELTA || f_decimals > s_maxDecimals)
+        {
+            return false;
+        }
+        float l_scale = 1.0f;
+        for (uint8_t i = 0; i < f_decimals; i++)
+        {
+            l_scale *= 10.0f;
+        }
+        core_util_critical_section_enter();
+        m_encoding[f_index] = f_encoding;
+        m_scale[f_index] = l_scale;
+        m_code[f_index] = static_cast<uint8_t>((f_encoding << 4) | ((f_encoding == ENC_RAW) ? 0 : f_decimals));
+        restart();
+        core_util_critical_section_exit();
+        return true;
+    }
+
+    /** \brief  Serial callback of the subscription
+     *
+     *  The message has the format 'mask;decimation', for example '#TELS:3;10;;' publishes the first two signals at tenth of the sampling rate.
+     *
+     *  @param a               input received string
+     *  @param b               output reponse message
+     */
+    void CTelemetry::serialCallbackSubscribe(char const * a, char * b)
+    {
+        unsigned int l_mask, l_decimation;
+        uint32_t l_res = sscanf(a,"%u;%u",&l_mask,&l_decimation);
+        if (l_res == 2 && l_mask <= 0xFF && l_decimation <= 0xFFFF && subscribe(l_mask, l_decimation))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Serial callback of the aggregation mode
+     *
+     *  The message has the format 'index;mode', where the mode is 0 - last value, 1 - minimum, 2 - maximum, 3 - mean.
+     *
+     *  @param a               input received string
+     *  @param b               output reponse message
+     */
+    void CTelemetry::serialCallbackAggregate(char const * a, char * b)
+    {
+        unsigned int l_index, l_mode;
+        uint32_t l_res = sscanf(a,"%u;%u",&l_index,&l_mode);
+        if (l_res == 2 && l_index < s_maxSignals && l_mode <= AGGR_MEAN && setAggregation(l_index, static_cast<EAggregation>(l_mode)))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Serial callback of the encoding mode
+     *
+     *  The message has the format 'index;mode;decimals', where the mode is 0 - float, 1 - delta varint, for example '#TELE:1;1;3;;' sends 
+     *  the second signal as difference in thousandths.
+     *
+     *  @param a               input received string
+     *  @param b               output reponse message
+     */
+    void CTelemetry::serialCallbackEncode(char const * a, char * b)
+    {
+        unsigned int l_index, l_mode, l_decimals;
+        uint32_t l_res = sscanf(a,"%u;%u;%u",&l_index,&l_mode,&l_decimals);
+        if (l_res == 3 && l_index < s_maxSignals && l_mode <= ENC_DELTA && l_decimals <= s_maxDecimals 
+                && setEncoding(l_index, static_cast<EEncoding>(l_mode), l_decimals))
+        {
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+    /** \brief  Binary callback of the subscription, it sets the aggregation modes and the subscription together.
+     *
+     *  @param f_payload       received payload
+     *  @return                status code of the response
+     */
+    uint8_t CTelemetry::binaryCallbackSubscribe(const utils::serial::STelemetrySubscribePayload& f_payload)
+    {
+        if (f_payload.m_decimation == 0 || (f_payload.m_signalMask >> m_signalCount) != 0)
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        for (uint8_t i = 0; i < m_signalCount; i++)
+        {
+            setAggregation(i, static_cast<EAggregation>((f_payload.m_aggregation >> (2 * i)) & 0x3));
+        }
+        subscribe(f_payload.m_signalMask, f_payload.m_decimation);
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Start the periodic sampling by a timer of the timer wheel, the signals are sampled from the tick of the wheel.
+     *
+     *  @param f_wheel         timer wheel, for example the wheel of the task manager
+     *  @param f_period        sampling period in second
+     */
+    void CTelemetry::start(utils::task::CTimerWheel& f_wheel, float f_period)
+    {
+        stop();
+        m_wheel = &f_wheel;
+        uint32_t l_period = f_wheel.toTicks(f_period);
+        f_wheel.arm(m_timer, l_period, l_period);
+    }
+
+    /** \brief  Stop the periodic sampling
+     */
+    void CTelemetry::stop()
+    {
+        if (m_wheel != NULL)
+        {
+            m_wheel->cancel(m_timer);
+        }
+    }
+
+    /** \brief  Expiry callback of the sampling timer, it samples the signals of the owner.
+     *
+     *  @param f_timer         expired timer
+     */
+    void CTelemetry::expireSampling(utils::task::CTimerWheel::CTimer& f_timer)
+    {
+        static_cast<CTelemetry*>(f_timer.getContext())->sample();
+    }
+
+    /** \brief  Run method
+     *
+     *  It encodes the full block in a frame and it writes it to the sink or to the transmitter.
+     */
+    void CTelemetry::_run()
+    {
+        if (!m_pending)
+        {
+            return;
+        }
+        const SBlock& l_block = m_blocks[m_active ^ 1];
+        uint8_t l_payload[utils::serial::CBinaryProtocol::s_maxPayloadSize];
+        memcpy(l_payload, &l_block.m_header, sizeof(utils::serial::STelemetryHeader));
+        memcpy(l_payload + sizeof(utils::serial::STelemetryHeader), l_block.m_data, l_block.m_size);
+        m_pending = false;
+        uint8_t l_frame[utils::serial::CBinaryProtocol::s_maxFrameSize];
+        uint32_t l_size = utils::serial::CBinaryProtocol::encode(l_block.m_packed ? utils::serial::BIN_TELEMETRY_PACKED : utils::serial::BIN_TELEMETRY
+                                                                , l_payload, sizeof(utils::serial::STelemetryHeader) + l_block.m_size, l_frame);
+        if (m_sink != NULL && m_sink->write(l_frame, l_size))
+        {
+            return;
+        }
+        m_serial.write(reinterpret_cast<const char*>(l_frame), l_size, utils::serial::CSerialTransmitter::LANE_TELEMETRY);
+    }
+
+}; // namespace utils::telemetry
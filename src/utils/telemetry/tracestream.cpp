@@ -0,0 +1,255 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    TraceStream.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the execution trace
+  *          on the debug port.
+  ******************************************************************************
+ */
+
+#include <utils/telemetry/tracestream.hpp>
+#include <utils/memory/sections.hpp>
+#include <utils/fmt/format.hpp>
+#include <string.h>
+
+namespace utils::telemetry{
+
+    volatile uint32_t CTraceStream::s_events = 0;
+    volatile CTraceStream::EBackend CTraceStream::s_backend = CTraceStream::BACKEND_OFF;
+    volatile uint32_t CTraceStream::s_dropped = 0;
+    CTraceStream::SRttControlBlock CTraceStream::s_rtt;
+    char CTraceStream::s_rttBuffer[CTraceStream::s_rttSize];
+
+    /** \brief  Start the trace
+     *
+     *  A running trace is stopped first, the counter of the dropped events is cleared.
+     *
+     *  @param f_backend       output of the packets
+     *  @param f_events        mask of the enabled classes (EEvents)
+     *  @param f_swoFrequency  bit rate of the SWO pin in hertz, it has to be the rate of the capture
+     *  @return                false, when the backend can't be started (the SWO pin is used by an other peripheral)
+     */
+    bool CTraceStream::start(EBackend f_backend, uint32_t f_events, uint32_t f_swoFrequency)
+    {
+        stop();
+        if (BACKEND_ITM == f_backend)
+        {
+            if (!startItm(f_swoFrequency))
+            {
+                return false;
+            }
+        }
+        else if (BACKEND_RTT == f_backend)
+        {
+            startRtt();
+        }
+        else
+        {
+            return false;
+        }
+        s_dropped = 0;
+        s_backend = f_backend;
+        __DMB();
+        s_events = f_events & (EVENTS_TASKS | EVENTS_ISR | EVENTS_SAMPLES);
+        return true;
+    }
+
+    /** \brief  Stop the trace, the hooks don't write after it
+     */
+    void CTraceStream::stop()
+    {
+        s_events = 0;
+        __DMB();
+        if (BACKEND_ITM == s_backend)
+        {
+            ITM->TER = 0;
+        }
+        s_backend = BACKEND_OFF;
+    }
+
+    /** \brief  Configure the ITM, the TPIU and the SWO pin
+     *
+     *  The pin PB3 is switched to the TRACESWO function (AF0), when it isn't configured for an other alternate function. The TPIU sends
+     *  the NRZ (UART) encoding, its prescaler is calculated from the core clock.
+     *
+     *  @param f_swoFrequency  bit rate of the SWO pin in hertz
+     *  @return                false, when the pin is used by an other peripheral
+     */
+    bool CTraceStream::startItm(uint32_t f_swoFrequency)
+    {
+        const uint32_t l_pin = 3;
+        uint32_t l_mode = (GPIOB->MODER >> (2 * l_pin)) & 0x3U;
+        uint32_t l_function = (GPIOB->AFR[0] >> (4 * l_pin)) & 0xFU;
+        if ((0x1U == l_mode) || (0x2U == l_mode && 0 != l_function) || 0 == f_swoFrequency)
+        {
+            return false;
+        }
+        GPIOB->AFR[0] &= ~(0xFU << (4 * l_pin));
+        GPIOB->MODER = (GPIOB->MODER & ~(0x3U << (2 * l_pin))) | (0x2U << (2 * l_pin));
+        GPIOB->OSPEEDR |= (0x3U << (2 * l_pin));
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DBGMCU->CR = (DBGMCU->CR & ~DBGMCU_CR_TRACE_MODE) | DBGMCU_CR_TRACE_IOEN;
+        TPI->CSPSR = 1;
+        TPI->SPPR = 2;
+        TPI->ACPR = SystemCoreClock / f_swoFrequency - 1;
+        TPI->FFCR = 0x100;
+        ITM->LAR = 0xC5ACCE55;
+        ITM->TCR = 0;
+        ITM->TPR = 0;
+        ITM->TCR = (1U << ITM_TCR_TraceBusID_Pos) | ITM_TCR_SWOENA_Msk | ITM_TCR_TSENA_Msk | ITM_TCR_ITMENA_Msk;
+        ITM->TER = (1U << PORT_TASK) | (1U << PORT_ISR) | (((1U << s_sampleChannels) - 1) << PORT_SAMPLE);
+        return true;
+    }
+
+    /** \brief  Initialize the RTT control block and enable the cycle counter of the timestamps
+     *
+     *  The identifier is written at the end, so the debugger doesn't find a partial control block.
+     */
+    void CTraceStream::startRtt()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        memset(&s_rtt, 0, sizeof(s_rtt));
+        s_rtt.m_maxUpBuffers = 1;
+        s_rtt.m_maxDownBuffers = 1;
+        s_rtt.m_up.m_name = "Trace";
+        s_rtt.m_up.m_buffer = s_rttBuffer;
+        s_rtt.m_up.m_size = s_rttSize;
+        s_rtt.m_down.m_name = "None";
+        __DMB();
+        memcpy(s_rtt.m_id, "SEGGER RTT", sizeof("SEGGER RTT"));
+    }
+
+    /** \brief  Write a packet by the active backend, it can be applied from interrupt context
+     *
+     *  The ITM packet is dropped, when the FIFO of the port is full, the ready flag and the write are atomic for the interrupts.
+     *
+     *  @param f_port          stimulus port
+     *  @param f_value         payload
+     *  @param f_size          size of the payload in bytes (1, 2 or 4)
+     */
+    CONTROL_RAMFUNC void CTraceStream::emit(uint8_t f_port, uint32_t f_value, uint8_t f_size)
+    {
+        uint32_t l_primask = __get_PRIMASK();
+        __disable_irq();
+        if (BACKEND_RTT == s_backend)
+        {
+            writeRtt(f_port, f_value, f_size);
+        }
+        else if (0 == ITM->PORT[f_port].u32)
+        {
+            s_dropped = s_dropped + 1;
+        }
+        else if (1 == f_size)
+        {
+            ITM->PORT[f_port].u8 = static_cast<uint8_t>(f_value);
+        }
+        else if (2 == f_size)
+        {
+            ITM->PORT[f_port].u16 = static_cast<uint16_t>(f_value);
+        }
+        else
+        {
+            ITM->PORT[f_port].u32 = f_value;
+        }
+        __set_PRIMASK(l_primask);
+    }
+
+    /** \brief  Write the timestamp packet and the event packet in the ring buffer, the interrupts are disabled by the caller
+     *
+     *  Both packets are dropped, when the free space isn't enough. The write offset is published after the data.
+     *
+     *  @param f_port          stimulus port
+     *  @param f_value         payload
+     *  @param f_size          size of the payload in bytes (1, 2 or 4)
+     */
+    CONTROL_RAMFUNC void CTraceStream::writeRtt(uint8_t f_port, uint32_t f_value, uint8_t f_size)
+    {
+        uint32_t l_write = s_rtt.m_up.m_writeOffset;
+        uint32_t l_read = s_rtt.m_up.m_readOffset;
+        uint32_t l_free = (l_read > l_write) ? (l_read - l_write - 1) : (s_rttSize - 1 - l_write + l_read);
+        if (l_free < 6U + f_size)
+        {
+            s_dropped = s_dropped + 1;
+            return;
+        }
+        uint8_t l_packet[10];
+        uint32_t l_stamp = DWT->CYCCNT;
+        l_packet[0] = static_cast<uint8_t>((PORT_TIMESTAMP << 3) | 0x3U);
+        l_packet[1] = static_cast<uint8_t>(l_stamp);
+        l_packet[2] = static_cast<uint8_t>(l_stamp >> 8);
+        l_packet[3] = static_cast<uint8_t>(l_stamp >> 16);
+        l_packet[4] = static_cast<uint8_t>(l_stamp >> 24);
+        l_packet[5] = static_cast<uint8_t>((f_port << 3) | ((4 == f_size) ? 0x3U : f_size));
+        for (uint8_t i = 0; i < f_size; i++)
+        {
+            l_packet[6 + i] = static_cast<uint8_t>(f_value >> (8 * i));
+        }
+        for (uint8_t i = 0; i < 6U + f_size; i++)
+        {
+            s_rttBuffer[l_write] = static_cast<char>(l_packet[i]);
+            l_write = (l_write + 1 < s_rttSize) ? (l_write + 1) : 0;
+        }
+        __DMB();
+        s_rtt.m_up.m_writeOffset = l_write;
+    }
+
+    /** \brief  Serial callback method to get the state, to start or to stop the trace
+     *
+     * @param a                   input received string, 0: state, 1;backend;events: start, 2: stop
+     * @param b                   output reponse message
+     */
+    void CTraceStream::serialCallback(char const * a, char * b)
+    {
+        const char* l_text = a;
+        uint32_t l_command;
+        if (!utils::fmt::parseUint(l_text, l_command))
+        {
+            sprintf(b,"sintax error;;");
+        }
+        else if (0 == l_command)
+        {
+            utils::fmt::CWriter(b).udec(static_cast<uint32_t>(s_backend)).udec(s_events).udec(s_dropped).chr(';');
+        }
+        else if (1 == l_command && ';' == *l_text++)
+        {
+            uint32_t l_backend, l_events;
+            if (utils::fmt::parseUint(l_text, l_backend) && ';' == *l_text++ && utils::fmt::parseUint(l_text, l_events)
+                && (BACKEND_ITM == l_backend || BACKEND_RTT == l_backend))
+            {
+                sprintf(b, start(static_cast<EBackend>(l_backend), l_events) ? "ack;;" : "pin unavailable;;");
+            }
+            else
+            {
+                sprintf(b,"sintax error;;");
+            }
+        }
+        else if (2 == l_command)
+        {
+            stop();
+            sprintf(b,"ack;;");
+        }
+        else
+        {
+            sprintf(b,"sintax error;;");
+        }
+    }
+
+}; // namespace utils::telemetry
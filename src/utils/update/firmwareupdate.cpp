@@ -0,0 +1,512 @@
+/**
+ * Copyright 2019 Bosch Engineering Center Cluj and BFMC organizers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+  ******************************************************************************
+  * @file    FirmwareUpdate.cpp
+  * @author  RBRO/PJ-IU
+  * @version V1.0.0
+  * @date    day-month-2019
+  * @brief   This file contains the class definition for the firmware update
+  *          over the serial link.
+  ******************************************************************************
+ */
+
+#include <utils/update/firmwareupdate.hpp>
+#include <utils/serial/binaryprotocol.hpp>
+#include <utils/memory/sections.hpp>
+
+namespace utils::update{
+
+    /** @brief  Error flags of the flash interface */
+    static const uint32_t s_flashErrors = FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | FLASH_SR_PGSERR;
+    /** @brief  Reload key of the independent watchdog */
+    static const uint32_t s_watchdogReload = 0xAAAA;
+
+    /** \brief  Wait the end of the flash operation from the RAM, the watchdog is refreshed meanwhile. The flags are cleared.
+     *
+     *  @return                true, when the operation is finished without error
+     */
+    CONTROL_RAMFUNC static bool residentWait()
+    {
+        while (FLASH->SR & FLASH_SR_BSY)
+        {
+            IWDG->KR = s_watchdogReload;
+        }
+        uint32_t l_flags = FLASH->SR;
+        FLASH->SR = s_flashErrors | FLASH_SR_EOP;
+        return 0 == (l_flags & s_flashErrors);
+    }
+
+    /** \brief  Erase a sector from the RAM, the flash interface is unlocked and the flags are cleared before.
+     *
+     *  @param f_number        number of the sector
+     *  @return                true, when the sector is erased without error
+     */
+    CONTROL_RAMFUNC static bool residentErase(uint8_t f_number)
+    {
+        if (FLASH->CR & FLASH_CR_LOCK)
+        {
+            FLASH->KEYR = 0x45670123U;
+            FLASH->KEYR = 0xCDEF89ABU;
+        }
+        FLASH->SR = s_flashErrors | FLASH_SR_EOP;
+        FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_SER | ((f_number * FLASH_CR_SNB_0) & FLASH_CR_SNB);
+        FLASH->CR |= FLASH_CR_STRT;
+        bool l_res = residentWait();
+        FLASH->CR = FLASH_CR_LOCK;
+        return l_res;
+    }
+
+    /** \brief  CFirmwareUpdate class constructor
+     *
+     *  The task has zero period, it's notified by the serial callbacks. The staging sector has to be outside of the program image,
+     *  it's checked at the start of each update.
+     *
+     *  @param f_staging       staging sector of the new image
+     *  @param f_program       consecutive sectors of the program, from the start of the flash
+     *  @param f_programCount  number of the program sectors
+     */
+    CFirmwareUpdate::CFirmwareUpdate(const hardware::drivers::CInternalFlash::SSector& f_staging, const hardware::drivers::CInternalFlash::SSector* f_program, uint8_t f_programCount)
+        : utils::task::CTask(0, utils::task::BACKGROUND)
+        , m_staging(f_staging)
+        , m_programSectors()
+        , m_programCount(0)
+        , m_programAddress(0)
+        , m_programSize(0)
+        , m_guard()
+        , m_state(IDLE)
+        , m_size(0)
+        , m_crc(0)
+        , m_received(0)
+        , m_programmed(0)
+        , m_buffers()
+        , m_bases()
+        , m_counts()
+        , m_pending()
+        , m_fillIdx(0)
+        , m_programIdx(0)
+        , m_install(false)
+    {
+        m_programCount = (f_programCount < s_maxProgramSectors) ? f_programCount : s_maxProgramSectors;
+        if (m_programCount > 0)
+        {
+            m_programAddress = f_program[0].m_address;
+        }
+        for (uint8_t i = 0; i < m_programCount; i++)
+        {
+            m_programSectors[i] = f_program[i].m_number;
+            m_programSize += f_program[i].m_size;
+        }
+    }
+
+    /** \brief  Set the write guard, the update is accepted only while it allows the writing of the flash.
+     *
+     *  @param f_guard         write guard
+     */
+    void CFirmwareUpdate::setWriteGuard(FWriteGuard f_guard)
+    {
+        m_guard = f_guard;
+    }
+
+    /** \brief  Binary callback of the start of the update, the stream is reset and the task erases the staging sector.
+     *
+     *  @param f_payload       size and CRC32 of the image
+     *  @return                BIN_ACK, BIN_QUEUE_FULL while the previous update is busy, BIN_VALUE_RANGE for a wrong size or
+     *                         BIN_NOT_AVAILABLE, when the write guard forbids it or the staging sector isn't free
+     */
+    uint8_t CFirmwareUpdate::binaryCallbackBegin(const utils::serial::SUpdateBeginPayload& f_payload)
+    {
+        EState l_state = m_state;
+        if (ERASING == l_state || VERIFYING == l_state || INSTALLING == l_state || m_pending[0] || m_pending[1])
+        {
+            return utils::serial::BIN_QUEUE_FULL;
+        }
+        if (!isAllowed() || !hardware::drivers::CInternalFlash::isFree(m_staging.m_address))
+        {
+            return utils::serial::BIN_NOT_AVAILABLE;
+        }
+        if (0 == f_payload.m_size || f_payload.m_size > m_staging.m_size || f_payload.m_size > m_programSize)
+        {
+            return utils::serial::BIN_VALUE_RANGE;
+        }
+        m_size = f_payload.m_size;
+        m_crc = f_payload.m_crc;
+        m_received = 0;
+        m_programmed = 0;
+        m_fillIdx = 0;
+        m_programIdx = 0;
+        m_bases[0] = 0;
+        m_counts[0] = 0;
+        m_install = false;
+        m_state = ERASING;
+        Notify();
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Binary callback of a block, it's decompressed in the buffer of the reception and checked by its CRC16.
+     *
+     *  The blocks have to be consecutive, the buffer is handed to the task, when the block doesn't fit in it or after the last block.
+     *
+     *  @param f_payload       SUpdateBlockHeader followed by the LZ4 compressed block
+     *  @param f_length        length of the payload
+     *  @return                BIN_ACK, BIN_QUEUE_FULL while the buffers or the staging sector are busy, BIN_SYNTAX_ERROR for a corrupted
+     *                         block, BIN_VALUE_RANGE for a wrong offset or length or BIN_NOT_AVAILABLE without started update
+     */
+    uint8_t CFirmwareUpdate::binaryCallbackBlock(const uint8_t* f_payload, uint8_t f_length)
+    {
+        utils::serial::SUpdateBlockHeader l_header;
+        if (f_length < sizeof(l_header))
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        memcpy(&l_header, f_payload, sizeof(l_header));
+        EState l_state = m_state;
+        if (ERASING == l_state)
+        {
+            return utils::serial::BIN_QUEUE_FULL;
+        }
+        if (RECEIVING != l_state)
+        {
+            return utils::serial::BIN_NOT_AVAILABLE;
+        }
+        uint32_t l_end = l_header.m_offset + l_header.m_length;
+        // The response of the block was lost, the host sends it again
+        if (l_header.m_offset < m_received && l_end <= m_received)
+        {
+            return utils::serial::BIN_ACK;
+        }
+        if (l_header.m_offset != m_received || 0 == l_header.m_length || l_header.m_length > s_maxBlockLength || l_end > m_size
+            || (0 != (l_header.m_length & 3) && l_end != m_size))
+        {
+            return utils::serial::BIN_VALUE_RANGE;
+        }
+        if (m_pending[m_fillIdx])
+        {
+            return utils::serial::BIN_QUEUE_FULL;
+        }
+        if (m_counts[m_fillIdx] + l_header.m_length > s_bufferSize)
+        {
+            submit();
+            if (m_pending[m_fillIdx])
+            {
+                return utils::serial::BIN_QUEUE_FULL;
+            }
+        }
+        uint8_t* l_dest = reinterpret_cast<uint8_t*>(m_buffers[m_fillIdx]) + m_counts[m_fillIdx];
+        int32_t l_length = decompress(f_payload + sizeof(l_header), f_length - sizeof(l_header), l_dest, l_header.m_length);
+        if (l_length != l_header.m_length || utils::serial::CBinaryProtocol::crc16(l_dest, l_header.m_length) != l_header.m_crc)
+        {
+            return utils::serial::BIN_SYNTAX_ERROR;
+        }
+        m_counts[m_fillIdx] += l_header.m_length;
+        m_received = l_end;
+        if (m_received == m_size)
+        {
+            submit();
+        }
+        return utils::serial::BIN_ACK;
+    }
+
+    /** \brief  Binary callback of the end of the update, the verified image is installed on request.
+     *
+     *  @param f_payload       the installing request
+     *  @return                BIN_ACK with the verified image, BIN_QUEUE_FULL until the verification finishes, BIN_VALUE_RANGE before
+     *                         the last block, BIN_UPDATE_FAILED after a failure or BIN_NOT_AVAILABLE without update or write permission
+     */
+    uint8_t CFirmwareUpdate::binaryCallbackEnd(const utils::serial::SUpdateEndPayload& f_payload)
+    {
+        switch (m_state)
+        {
+            case RECEIVING:
+                return (m_received < m_size) ? utils::serial::BIN_VALUE_RANGE : utils::serial::BIN_QUEUE_FULL;
+            case ERASING:
+            case VERIFYING:
+                return utils::serial::BIN_QUEUE_FULL;
+            case READY:
+                if (0 != f_payload.m_apply)
+                {
+                    if (!isAllowed())
+                    {
+                        return utils::serial::BIN_NOT_AVAILABLE;
+                    }
+                    m_install = true;
+                    Notify();
+                }
+                return utils::serial::BIN_ACK;
+            case FAILED:
+                return utils::serial::BIN_UPDATE_FAILED;
+            default:
+                return utils::serial::BIN_NOT_AVAILABLE;
+        }
+    }
+
+    /** \brief  Decompress a LZ4 block (the sequences without the frame format). Each sequence has a token with the lengths of the
+     *  literals and of the match, the extra bytes of the lengths, the literals and the little-endian offset of the match, the
+     *  last sequence has only literals. The overlapping matches are copied byte by byte.
+     *
+     *  @param f_source        compressed block
+     *  @param f_length        length of the compressed block
+     *  @param f_dest          destination buffer
+     *  @param f_capacity      size of the destination
+     *  @return                length of the decompressed block, -1 for a corrupted block or a too small destination
+     */
+    int32_t CFirmwareUpdate::decompress(const uint8_t* f_source, uint32_t f_length, uint8_t* f_dest, uint32_t f_capacity)
+    {
+        uint32_t l_in = 0;
+        uint32_t l_out = 0;
+        while (l_in < f_length)
+        {
+            uint8_t l_token = f_source[l_in++];
+            uint32_t l_literals = l_token >> 4;
+            if (15 == l_literals)
+            {
+                uint8_t l_byte;
+                do
+                {
+                    if (l_in >= f_length)
+                    {
+                        return -1;
+                    }
+                    l_byte = f_source[l_in++];
+                    l_literals += l_byte;
+                } while (255 == l_byte);
+            }
+            if (l_literals > f_length - l_in || l_literals > f_capacity - l_out)
+            {
+                return -1;
+            }
+            memcpy(f_dest + l_out, f_source + l_in, l_literals);
+            l_in += l_literals;
+            l_out += l_literals;
+            if (l_in == f_length)
+            {
+                break;
+            }
+            if (f_length - l_in < 2)
+            {
+                return -1;
+            }
+            uint32_t l_offset = f_source[l_in] | (static_cast<uint32_t>(f_source[l_in + 1]) << 8);
+            l_in += 2;
+            if (0 == l_offset || l_offset > l_out)
+            {
+                return -1;
+            }
+            uint32_t l_match = l_token & 0x0F;
+            if (15 == l_match)
+            {
+                uint8_t l_byte;
+                do
+                {
+                    if (l_in >= f_length)
+                    {
+                        return -1;
+                    }
+                    l_byte = f_source[l_in++];
+                    l_match += l_byte;
+                } while (255 == l_byte);
+            }
+            l_match += 4;
+            if (l_match > f_capacity - l_out)
+            {
+                return -1;
+            }
+            for (uint32_t i = 0; i < l_match; i++, l_out++)
+            {
+                f_dest[l_out] = f_dest[l_out - l_offset];
+            }
+        }
+        return static_cast<int32_t>(l_out);
+    }
+
+    /** \brief  Compute the CRC32 checksum (reflected polynomial 0xEDB88320, like zlib), it can be continued over several areas.
+     *
+     *  @param f_data          data
+     *  @param f_length        length of the data
+     *  @param f_crc           checksum of the previous areas
+     *  @return                checksum
+     */
+    uint32_t CFirmwareUpdate::crc32(const uint8_t* f_data, uint32_t f_length, uint32_t f_crc)
+    {
+        f_crc = ~f_crc;
+        for (uint32_t i = 0; i < f_length; i++)
+        {
+            f_crc ^= f_data[i];
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                f_crc = (f_crc >> 1) ^ (0xEDB88320U & (0U - (f_crc & 1U)));
+            }
+        }
+        return ~f_crc;
+    }
+
+    /** \brief  Run method
+     *
+     *  It erases the staging sector, it programs the pending buffers, it verifies the staged image after the last buffer and it
+     *  installs the verified image on request. After a failure the pending buffers are dropped. The installing waits for the
+     *  transmission of the response.
+     */
+    void CFirmwareUpdate::_run()
+    {
+        if (ERASING == m_state)
+        {
+            m_state = eraseResident(m_staging.m_number) ? RECEIVING : FAILED;
+        }
+        if (RECEIVING == m_state)
+        {
+            if (!programPending())
+            {
+                m_state = FAILED;
+            }
+            else if (m_programmed == m_size)
+            {
+                m_state = VERIFYING;
+                const uint8_t* l_image = reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(m_staging.m_address));
+                m_state = (crc32(l_image, m_size) == m_crc) ? READY : FAILED;
+            }
+        }
+        if (FAILED == m_state)
+        {
+            // The stream is abandoned, the next start doesn't wait for the buffers
+            m_pending[0] = false;
+            m_pending[1] = false;
+        }
+        if (READY == m_state && m_install)
+        {
+            m_state = INSTALLING;
+            wait_ms(20);
+            const uint32_t* l_image = reinterpret_cast<const uint32_t*>(static_cast<uintptr_t>(m_staging.m_address));
+            installResident(m_programSectors, m_programCount, m_programAddress, l_image, (m_size + 3) / 4);
+        }
+    }
+
+    /** \brief  Hand the buffer of the reception to the task, the reception continues in the other buffer.
+     */
+    void CFirmwareUpdate::submit()
+    {
+        if (0 == m_counts[m_fillIdx])
+        {
+            return;
+        }
+        m_pending[m_fillIdx] = true;
+        Notify();
+        m_fillIdx ^= 1;
+        if (!m_pending[m_fillIdx])
+        {
+            m_bases[m_fillIdx] = m_received;
+            m_counts[m_fillIdx] = 0;
+        }
+    }
+
+    /** \brief  Program the pending buffers in their order, the last bytes are completed to a word by the erased value.
+     *
+     *  @return                true, when the buffers are programmed without error
+     */
+    bool CFirmwareUpdate::programPending()
+    {
+        while (m_pending[m_programIdx])
+        {
+            uint8_t* l_bytes = reinterpret_cast<uint8_t*>(m_buffers[m_programIdx]);
+            uint32_t l_count = m_counts[m_programIdx];
+            uint32_t l_words = (l_count + 3) / 4;
+            memset(l_bytes + l_count, 0xFF, l_words * 4 - l_count);
+            if (!hardware::drivers::CInternalFlash::program(m_staging.m_address + m_bases[m_programIdx], m_buffers[m_programIdx], l_words))
+            {
+                return false;
+            }
+            m_programmed += l_count;
+            core_util_critical_section_enter();
+            m_pending[m_programIdx] = false;
+            // The reception waited for this buffer, it continues in it
+            if (m_fillIdx == m_programIdx)
+            {
+                m_bases[m_fillIdx] = m_received;
+                m_counts[m_fillIdx] = 0;
+            }
+            core_util_critical_section_exit();
+            m_programIdx ^= 1;
+        }
+        return true;
+    }
+
+    /** \brief  The write guard allows the update, without guard it's always allowed.
+     *
+     *  @return                true, when the flash can be written
+     */
+    bool CFirmwareUpdate::isAllowed()
+    {
+        return !m_guard || m_guard();
+    }
+
+    /** \brief  Erase a sector from the RAM with disabled interrupts, the code in the flash can't be fetched during the erasing, the
+     *  watchdog is refreshed by the waiting loop. The caches are reset after it.
+     *
+     *  @param f_number        number of the sector
+     *  @return                true, when the sector is erased without error
+     */
+    CONTROL_RAMFUNC bool CFirmwareUpdate::eraseResident(uint8_t f_number)
+    {
+        uint32_t l_primask = __get_PRIMASK();
+        __disable_irq();
+        bool l_res = residentErase(f_number);
+        uint32_t l_acr = FLASH->ACR & ~(FLASH_ACR_ICEN | FLASH_ACR_DCEN);
+        FLASH->ACR = l_acr;
+        FLASH->ACR = l_acr | FLASH_ACR_ICRST | FLASH_ACR_DCRST;
+        FLASH->ACR = l_acr | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+        if (0 == l_primask)
+        {
+            __enable_irq();
+        }
+        return l_res;
+    }
+
+    /** \brief  Install the staged image and reset, it's executed from the RAM with disabled interrupts and it doesn't return.
+     *
+     *  The program sectors are erased, then the words of the image are copied from the staging sector. The routine can't use any
+     *  code in the flash, the reset is requested directly by the AIRCR register.
+     *
+     *  @param f_sectors       numbers of the program sectors
+     *  @param f_count         number of the program sectors
+     *  @param f_address       start address of the program
+     *  @param f_image         staged image
+     *  @param f_words         number of the words of the image
+     */
+    CONTROL_RAMFUNC void CFirmwareUpdate::installResident(const uint8_t* f_sectors, uint8_t f_count, uint32_t f_address, const uint32_t* f_image, uint32_t f_words)
+    {
+        __disable_irq();
+        for (uint8_t i = 0; i < f_count; i++)
+        {
+            residentErase(f_sectors[i]);
+        }
+        FLASH->KEYR = 0x45670123U;
+        FLASH->KEYR = 0xCDEF89ABU;
+        FLASH->SR = s_flashErrors | FLASH_SR_EOP;
+        FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+        volatile uint32_t* l_dest = reinterpret_cast<volatile uint32_t*>(static_cast<uintptr_t>(f_address));
+        for (uint32_t i = 0; i < f_words; i++)
+        {
+            l_dest[i] = f_image[i];
+            residentWait();
+        }
+        FLASH->CR = FLASH_CR_LOCK;
+        __DSB();
+        SCB->AIRCR = (0x5FAUL << SCB_AIRCR_VECTKEY_Pos) | (SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) | SCB_AIRCR_SYSRESETREQ_Msk;
+        __DSB();
+        while (true)
+        {
+        }
+    }
+
+}; // namespace utils::update